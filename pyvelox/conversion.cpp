@@ -15,6 +15,8 @@
  */
 
 #include "conversion.h"
+#include <cstring>
+#include <velox/vector/FlatVector.h>
 #include <velox/vector/arrow/Abi.h>
 #include <velox/vector/arrow/Bridge.h>
 #include "context.h"
@@ -23,6 +25,80 @@ namespace facebook::velox::py {
 
 namespace py = pybind11;
 
+namespace {
+
+// Keeps the Python buffer wrapped by a Velox BufferView alive. The buffer is
+// released with the GIL held when the last copy of the releaser goes away.
+struct PyBufferReleaser {
+  explicit PyBufferReleaser(py::buffer_info&& info)
+      : info_(
+            new py::buffer_info(std::move(info)),
+            [](py::buffer_info* info) {
+              py::gil_scoped_acquire acquire;
+              delete info;
+            }) {}
+
+  void addRef() const {}
+
+  void release() const {}
+
+  std::shared_ptr<py::buffer_info> info_;
+};
+
+template <typename T>
+VectorPtr wrapBuffer(
+    const TypePtr& type,
+    py::buffer_info&& info,
+    memory::MemoryPool* pool) {
+  const auto size = info.shape[0];
+  const auto* data = reinterpret_cast<const uint8_t*>(info.ptr);
+  auto values = BufferView<PyBufferReleaser>::create(
+      data, size * sizeof(T), PyBufferReleaser(std::move(info)));
+  return std::make_shared<FlatVector<T>>(
+      pool, type, nullptr, size, std::move(values), std::vector<BufferPtr>{});
+}
+
+// Wraps the values of a one-dimensional contiguous Python buffer of numbers,
+// e.g. a NumPy array, in a FlatVector without copying them.
+VectorPtr importFromBuffer(py::buffer buffer, memory::MemoryPool* pool) {
+  auto info = buffer.request();
+  if (info.ndim != 1 ||
+      (info.shape[0] > 1 && info.strides[0] != info.itemsize)) {
+    throw py::value_error(
+        "Only one-dimensional contiguous buffers are supported");
+  }
+
+  // Skips the byte order and alignment prefix of the struct format.
+  auto format = info.format;
+  if (!format.empty() && std::strchr("@=<>!", format[0]) != nullptr) {
+    format = format.substr(1);
+  }
+  if (format.size() != 1) {
+    throw py::value_error("Unsupported buffer format: " + info.format);
+  }
+  if (std::strchr("bhilq", format[0]) != nullptr) {
+    switch (info.itemsize) {
+      case 1:
+        return wrapBuffer<int8_t>(TINYINT(), std::move(info), pool);
+      case 2:
+        return wrapBuffer<int16_t>(SMALLINT(), std::move(info), pool);
+      case 4:
+        return wrapBuffer<int32_t>(INTEGER(), std::move(info), pool);
+      case 8:
+        return wrapBuffer<int64_t>(BIGINT(), std::move(info), pool);
+      default:
+        break;
+    }
+  } else if (format[0] == 'f' && info.itemsize == 4) {
+    return wrapBuffer<float>(REAL(), std::move(info), pool);
+  } else if (format[0] == 'd' && info.itemsize == 8) {
+    return wrapBuffer<double>(DOUBLE(), std::move(info), pool);
+  }
+  throw py::value_error("Unsupported buffer format: " + info.format);
+}
+
+} // namespace
+
 void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
   m.def("export_to_arrow", [](VectorPtr& inputVector) {
     auto arrowArray = std::make_unique<ArrowArray>();
@@ -48,5 +124,15 @@ void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
     auto pool_ = PyVeloxContext::getSingletonInstance().pool();
     return importFromArrowAsOwner(*arrowSchema, *arrowArray, pool_);
   });
+
+  m.def(
+      "from_buffer",
+      [](py::buffer buffer) {
+        auto pool = PyVeloxContext::getSingletonInstance().pool();
+        return importFromBuffer(std::move(buffer), pool);
+      },
+      "Wraps a one-dimensional buffer of numbers, e.g. a NumPy array, in a "
+      "flat vector without copying the values. The vector keeps the buffer "
+      "alive.");
 }
 } // namespace facebook::velox::py
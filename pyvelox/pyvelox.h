@@ -376,18 +376,47 @@ static void registerTypedVectors(
             return v->slice(start, length);
           });
 
-  py::class_<
+  using FlatVectorClass = py::class_<
       FlatVector<NativeType>,
       FlatVectorPtr<NativeType>,
-      SimpleVector<NativeType>>(
-      m,
-      ("FlatVector_" + typeName).c_str(),
-      py::module_local(asModuleLocalDefinitions))
-      .def(
-          "__setitem__",
-          [](FlatVectorPtr<NativeType> v, vector_size_t idx, py::handle& obj) {
-            setItemInFlatVector(v, idx, obj);
-          });
+      SimpleVector<NativeType>>;
+  // Flat vectors of numbers expose their values through the buffer protocol,
+  // so that e.g. numpy.asarray() and memoryview() wrap them without copying.
+  // The values at null positions are undefined.
+  constexpr bool kExposesBuffer = std::is_floating_point_v<NativeType> ||
+      (std::is_integral_v<NativeType> && !std::is_same_v<NativeType, bool> &&
+       sizeof(NativeType) <= sizeof(int64_t));
+  auto flatVector = [&]() {
+    if constexpr (kExposesBuffer) {
+      return FlatVectorClass(
+          m,
+          ("FlatVector_" + typeName).c_str(),
+          py::module_local(asModuleLocalDefinitions),
+          py::buffer_protocol());
+    } else {
+      return FlatVectorClass(
+          m,
+          ("FlatVector_" + typeName).c_str(),
+          py::module_local(asModuleLocalDefinitions));
+    }
+  }();
+  flatVector.def(
+      "__setitem__",
+      [](FlatVectorPtr<NativeType> v, vector_size_t idx, py::handle& obj) {
+        setItemInFlatVector(v, idx, obj);
+      });
+  if constexpr (kExposesBuffer) {
+    flatVector.def_buffer([](FlatVector<NativeType>& v) -> py::buffer_info {
+      return py::buffer_info(
+          const_cast<NativeType*>(v.rawValues()),
+          sizeof(NativeType),
+          py::format_descriptor<NativeType>::format(),
+          1,
+          {static_cast<py::ssize_t>(v.size())},
+          {static_cast<py::ssize_t>(sizeof(NativeType))},
+          /*readonly=*/true);
+    });
+  }
 
   py::class_<
       ConstantVector<NativeType>,
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import array
 import pyarrow as pa
 import pyvelox.pyvelox as pv
 import unittest
@@ -392,6 +393,40 @@ class TestVeloxVector(unittest.TestCase):
                 for i in range(0, len(data)):
                     self.assertEqual(velox_vector[i], data[i])
 
+    def test_buffer_protocol(self):
+        vector = pv.from_list([1, 2, 3])
+        view = memoryview(vector)
+        self.assertTrue(view.readonly)
+        self.assertEqual(view.itemsize, 8)
+        self.assertListEqual(view.tolist(), [1, 2, 3])
+
+        vector = pv.from_list([1.5, 2.5])
+        self.assertListEqual(memoryview(vector).tolist(), [1.5, 2.5])
+
+    def test_from_buffer(self):
+        test_cases = [
+            (array.array("b", [1, -2, 3]), pv.TinyintType()),
+            (array.array("h", [1, -2, 3]), pv.SmallintType()),
+            (array.array("i", [11, 26, 31]), pv.IntegerType()),
+            (array.array("q", [11, 26, 31]), pv.BigintType()),
+            (array.array("f", [0.5, 2.5, 3.5]), pv.RealType()),
+            (array.array("d", [0.1, 2.5, 3.9]), pv.DoubleType()),
+        ]
+        for data, expected_type in test_cases:
+            with self.subTest(data=data):
+                vector = pv.from_buffer(data)
+                self.assertEqual(vector.size(), len(data))
+                self.assertEqual(vector.dtype(), expected_type)
+                for i in range(0, len(data)):
+                    self.assertEqual(vector[i], data[i])
+
+        # The vector keeps the buffer alive.
+        vector = pv.from_buffer(array.array("q", [7, 8, 9]))
+        self.assertEqual(vector[2], 9)
+
+        with self.assertRaises(ValueError):
+            pv.from_buffer(array.array("u", "abc"))
+
     def test_row_vector_basic(self):
         vals = [
             pv.from_list([1, 2, 3]),
@@ -18,6 +18,8 @@ import json
 import os
 import pathlib
 import re
+import shutil
+import statistics
 import subprocess
 import sys
 import tempfile
@@ -27,6 +29,13 @@ from collections import defaultdict
 
 _OUTPUT_NUM_COLS = 100
 
+# Hardware counters collected with `perf stat` by `run --perf_counters`.
+_PERF_EVENTS = ["instructions", "cache-misses", "branch-misses"]
+
+# Extension of the file written next to each benchmark json file with the
+# hardware counters and the per benchmark noise of the run.
+_COUNTERS_SUFFIX = ".counters"
+
 
 # Cosmetic helper functions.
 # GitHub Actions does not provide a tty but can still display colors
@@ -86,21 +95,34 @@ def get_retry_name(args, file_name):
     return str(parent_path.parent)
 
 
-def compare_file(args, target_data, baseline_data):
+def read_counters(json_file):
+    """Reads the counters file written by `run` next to 'json_file'. Returns an
+    empty dict if there is none."""
+    path = pathlib.Path(json_file).with_suffix(_COUNTERS_SUFFIX)
+    if not path.is_file():
+        return {}
+    with open(path) as f:
+        return json.load(f)
+
+
+def compare_file(args, target_data, baseline_data, results):
     def preprocess_data(input_map):
         output_map = defaultdict(dict)
+        noise_map = defaultdict(dict)
         for file_name, data in input_map.items():
             retry = get_retry_name(args, file_name)
+            noise = read_counters(file_name).get("noise", {})
             for row in data:
                 # Folly benchmark exports line separators by mistake as an entry on
                 # the json file.
                 if row[1] == "-":
                     continue
                 output_map[(row[0], row[1])][retry] = row[2]
-        return output_map
+                noise_map[(row[0], row[1])][retry] = noise.get(row[1], 0)
+        return output_map, noise_map
 
-    baseline_map = preprocess_data(baseline_data)
-    target_map = preprocess_data(target_data)
+    baseline_map, baseline_noise = preprocess_data(baseline_data)
+    target_map, target_noise = preprocess_data(target_data)
 
     passes = []
     faster = []
@@ -128,6 +150,11 @@ def compare_file(args, target_data, baseline_data):
             else:
                 delta = (1 - (baseline_result / target_result)) * -1
 
+            # Widen the threshold for benchmarks that vary more than it
+            # between the repetitions of a run.
+            noise = max(baseline_noise[handle][retry], target_noise[handle][retry])
+            threshold = max(args.threshold, args.noise_factor * noise)
+
             # Set status message based on the delta and number of retries.
             if not is_last:
                 if delta > 0:
@@ -136,7 +163,7 @@ def compare_file(args, target_data, baseline_data):
                     status = color_yellow("✗ Redo")
 
             # If there are no more retries and this exceeded the threshold.
-            elif abs(delta) > args.threshold:
+            elif abs(delta) > threshold:
                 if delta > 0:
                     status = color_green("🗲 Pass")
                     passes.append((handle[0], handle[1], delta))
@@ -163,9 +190,45 @@ def compare_file(args, target_data, baseline_data):
             )
             print("    {}: {}{}{}".format(status, bm_handle, spacing, suffix))
 
+            if is_last:
+                results.append(
+                    {
+                        "file": os.path.basename(handle[0]),
+                        "benchmark": handle[1],
+                        "baseline_ns": baseline_result,
+                        "contender_ns": target_result,
+                        "delta": delta,
+                        "threshold": threshold,
+                        "failed": delta < 0 and abs(delta) > threshold,
+                    }
+                )
+
     return passes, faster, failures
 
 
+def compare_counters(baseline_file, target_file):
+    """Prints and returns the relative change of the hardware counters recorded
+    for a benchmark binary in both runs."""
+    baseline_perf = read_counters(baseline_file).get("perf", {})
+    target_perf = read_counters(target_file).get("perf", {})
+    output = {}
+    for event in sorted(baseline_perf.keys() & target_perf.keys()):
+        baseline_value = baseline_perf[event]
+        target_value = target_perf[event]
+        change = (target_value - baseline_value) / baseline_value if baseline_value else 0
+        output[event] = {
+            "baseline": baseline_value,
+            "contender": target_value,
+            "change": change,
+        }
+        print(
+            "    {}: {} vs {} {:+.2f}%".format(
+                event, baseline_value, target_value, change * 100
+            )
+        )
+    return output
+
+
 def find_json_files(path: pathlib.Path, recursive=False):
     """Finds json files in a given directory. Supports recursive searchs."""
     pattern = "*.json"
@@ -202,6 +265,8 @@ def compare(args):
     all_passes = []
     all_faster = []
     all_failures = []
+    all_results = []
+    all_counters = {}
 
     # Keep track of benchmarks that exceeded the threshold to they can be saved
     # to the rerun_output file.
@@ -220,7 +285,12 @@ def compare(args):
         target_data = read_json_files(contender_path)
         baseline_data = read_json_files(baseline_map[file_name])
 
-        passes, faster, failures = compare_file(args, target_data, baseline_data)
+        passes, faster, failures = compare_file(
+            args, target_data, baseline_data, all_results
+        )
+        counters = compare_counters(baseline_map[file_name][0], contender_path[0])
+        if counters:
+            all_counters[file_name] = counters
         all_passes += passes
         all_faster += faster
         all_failures += failures
@@ -240,6 +310,20 @@ def compare(args):
             if rerun_log:
                 out_file.write(json.dumps(rerun_log, indent=4))
 
+    # Write the machine readable comparison.
+    if args.json_output:
+        with open(args.json_output, "w") as out_file:
+            json.dump(
+                {
+                    "threshold": args.threshold,
+                    "noise_factor": args.noise_factor,
+                    "results": all_results,
+                    "counters": all_counters,
+                },
+                out_file,
+                indent=4,
+            )
+
     # Print a nice summary of the results:
     print("Summary ({}% threshold):".format(args.threshold * 100))
     if all_passes:
@@ -285,6 +369,109 @@ def _normalize_path(binary_path: str) -> pathlib.Path:
     return path
 
 
+def _read_binary_list(list_file, binary_path):
+    """Reads a list of benchmark binaries and returns (binary, bm_filter)
+    pairs. Each line has a binary path relative to 'binary_path' and optionally
+    a regex of the benchmarks to run from it. Empty lines and lines starting
+    with '#' are ignored."""
+    if binary_path:
+        root = _normalize_path(binary_path)
+    else:
+        root = pathlib.Path(__file__).parent.parent.absolute() / "_build" / "release"
+
+    binaries = []
+    with open(list_file) as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            parts = line.split(maxsplit=1)
+            path = root / parts[0]
+            if not (os.access(path, os.X_OK) and path.is_file()):
+                print(f"WARNING: benchmark binary '{path}' not found. Skipping.")
+                continue
+            binaries.append((path, parts[1] if len(parts) > 1 else None))
+
+    if not binaries:
+        raise ValueError(f"No binaries from '{list_file}' found at '{root}'")
+    print(f"Found {len(binaries)} benchmark binaries")
+    return binaries
+
+
+def _parse_perf_output(perf_file):
+    """Parses the CSV output of `perf stat -x,` into {event: count}. Events
+    the machine does not support are left out."""
+    counters = {}
+    with open(perf_file) as f:
+        for line in f:
+            fields = line.strip().split(",")
+            if len(fields) < 3 or not fields[0].isdigit():
+                continue
+            # Events are reported as e.g. 'instructions:u' for user space.
+            counters[fields[2].split(":")[0]] = int(fields[0])
+    return counters
+
+
+def _relative_spread(values):
+    """Returns the median absolute deviation of 'values' relative to their
+    median."""
+    median = statistics.median(values)
+    if median == 0:
+        return 0
+    return statistics.median([abs(v - median) for v in values]) / median
+
+
+def _run_binary(run_command, out_path, repetitions, perf_counters):
+    """Runs 'run_command' 'repetitions' times. Writes the median time of each
+    benchmark to 'out_path' and the hardware counters and the relative spread
+    of the times of each benchmark next to it."""
+    runs = []
+    perf = defaultdict(list)
+    with tempfile.TemporaryDirectory() as temp_dir:
+        for repetition in range(repetitions):
+            json_path = pathlib.Path(temp_dir) / f"{repetition}.json"
+            command = [run_command[0], "--bm_json_verbose", json_path]
+            command += run_command[1:]
+            if perf_counters:
+                perf_path = pathlib.Path(temp_dir) / f"{repetition}.perf"
+                command = [
+                    "perf",
+                    "stat",
+                    "-x,",
+                    "-o",
+                    perf_path,
+                    "-e",
+                    ",".join(_PERF_EVENTS),
+                    "--",
+                ] + command
+            print(command)
+            subprocess.run(command, check=True)
+            with open(json_path) as f:
+                runs.append(json.load(f))
+            if perf_counters:
+                for event, value in _parse_perf_output(perf_path).items():
+                    perf[event].append(value)
+
+    # Folly benchmarks produce the same rows in the same order in each run.
+    output = []
+    noise = {}
+    for rows in zip(*runs):
+        times = [row[2] for row in rows]
+        output.append([rows[0][0], rows[0][1], statistics.median(times)])
+        if rows[0][1] != "-":
+            noise[rows[0][1]] = _relative_spread(times)
+
+    with open(out_path, "w") as f:
+        json.dump(output, f)
+    counters = {"repetitions": repetitions, "noise": noise}
+    if perf:
+        counters["perf"] = {
+            event: int(statistics.median(values)) for event, values in perf.items()
+        }
+    with open(out_path.with_suffix(_COUNTERS_SUFFIX), "w") as f:
+        json.dump(counters, f, indent=4)
+
+
 def run_all_benchmarks(
     output_dir,
     binary_path=None,
@@ -293,27 +480,32 @@ def run_all_benchmarks(
     bm_max_secs=None,
     bm_max_trials=None,
     bm_estimate_time=False,
+    binary_list=None,
+    repetitions=1,
+    perf_counters=False,
 ):
-    if binary_path:
-        binary_path = _normalize_path(binary_path)
+    if binary_list:
+        binaries = _read_binary_list(binary_list, binary_path)
     else:
-        binary_path = _default_binary_path()
+        if binary_path:
+            binary_path = _normalize_path(binary_path)
+        else:
+            binary_path = _default_binary_path()
+        binaries = [(path, None) for path in _find_binaries(binary_path)]
+
+    if perf_counters and not shutil.which("perf"):
+        raise ValueError("--perf_counters requires 'perf' in the PATH")
 
-    binaries = _find_binaries(binary_path)
     output_dir_path = pathlib.Path(output_dir)
     output_dir_path.mkdir(parents=True, exist_ok=True)
 
-    for binary_path in binaries:
+    for binary_path, binary_bm_filter in binaries:
         if binary_filter and not re.search(binary_filter, binary_path.name):
             continue
 
         out_path = output_dir_path / f"{binary_path.name}.json"
         print(f"Executing and dumping results for '{binary_path}' to '{out_path}':")
-        run_command = [
-            binary_path,
-            "--bm_json_verbose",
-            out_path,
-        ]
+        run_command = [binary_path]
 
         if bm_max_secs:
             run_command.extend(["--bm_max_secs", str(bm_max_secs)])
@@ -321,15 +513,19 @@ def run_all_benchmarks(
         if bm_max_trials:
             run_command.extend(["--bm_max_trials", str(bm_max_trials)])
 
-        if bm_filter:
-            run_command.extend(["--bm_regex", bm_filter])
+        if bm_filter or binary_bm_filter:
+            run_command.extend(["--bm_regex", bm_filter or binary_bm_filter])
 
         if bm_estimate_time:
             run_command.append("--bm_estimate_time")
 
         try:
-            print(run_command)
-            subprocess.run(run_command, check=True)
+            if repetitions > 1 or perf_counters:
+                _run_binary(run_command, out_path, repetitions, perf_counters)
+            else:
+                run_command[1:1] = ["--bm_json_verbose", out_path]
+                print(run_command)
+                subprocess.run(run_command, check=True)
         except subprocess.CalledProcessError as e:
             print(e.stderr.decode("utf-8"))
             raise e
@@ -408,6 +604,9 @@ def run(args):
         "bm_max_secs": args.bm_max_secs,
         "bm_max_trials": args.bm_max_trials,
         "bm_estimate_time": args.bm_estimate_time,
+        "binary_list": args.binary_list,
+        "repetitions": args.repetitions,
+        "perf_counters": args.perf_counters,
     }
 
     # In case we only want to rerun failed benchmarks from rerun_json_input.
@@ -482,6 +681,29 @@ def parse_args():
         action="store_true",
         help="Use folly benchmark --bm_estimate_time flag.",
     )
+    parser_run.add_argument(
+        "--binary_list",
+        default=None,
+        help="File listing the benchmark binaries to run, one per line, as a "
+        "path relative to --binary_path (the release build directory by "
+        "default) optionally followed by a regex of the benchmarks to run. "
+        "See scripts/benchmark-curated.txt.",
+    )
+    parser_run.add_argument(
+        "--repetitions",
+        default=1,
+        type=int,
+        help="Number of times to run each binary. The median time of each "
+        "benchmark is reported and the spread of the times is saved for "
+        "noise aware comparison.",
+    )
+    parser_run.add_argument(
+        "--perf_counters",
+        default=False,
+        action="store_true",
+        help="Record instructions, cache misses and branch mispredicts of "
+        "each binary with `perf stat`.",
+    )
     parser_run.add_argument(
         "--rerun_json_input",
         default=None,
@@ -521,6 +743,20 @@ def parse_args():
         "information about the failed benchmarks (the ones where the variation "
         "exceeded the threshold).",
     )
+    parser_compare.add_argument(
+        "--noise_factor",
+        type=float,
+        default=0,
+        help="Widen the threshold of a benchmark to this many times its "
+        "relative spread between repetitions in either run (see "
+        "run --repetitions). Default 0 (disabled).",
+    )
+    parser_compare.add_argument(
+        "--json_output",
+        default=None,
+        help="File where the comparison of each benchmark and of the hardware "
+        "counters is written as json.",
+    )
     parser_compare.add_argument(
         "--recursive",
         default=False,
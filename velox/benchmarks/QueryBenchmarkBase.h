@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/TpchQueryBuilder.h"
+
+DECLARE_bool(include_custom_stats);
+DECLARE_bool(include_results);
+DECLARE_int32(num_drivers);
+DECLARE_string(data_format);
+DECLARE_int32(num_splits_per_file);
+DECLARE_int32(cache_gb);
+DECLARE_int32(num_repeats);
+DECLARE_int32(num_io_threads);
+DECLARE_string(test_flags_file);
+DECLARE_bool(full_sorted_stats);
+DECLARE_string(ssd_path);
+DECLARE_int32(ssd_cache_gb);
+DECLARE_int32(ssd_checkpoint_interval_gb);
+DECLARE_bool(clear_ram_cache);
+DECLARE_bool(clear_ssd_cache);
+DECLARE_bool(warmup_after_clear);
+DECLARE_int64(max_coalesced_bytes);
+DECLARE_int32(max_coalesced_distance_bytes);
+DECLARE_int32(parquet_prefetch_rowgroups);
+DECLARE_int32(split_preload_per_driver);
+
+namespace facebook::velox {
+
+struct RunStats {
+  std::map<std::string, std::string> flags;
+  int64_t micros{0};
+  int64_t rawInputBytes{0};
+  int64_t userNanos{0};
+  int64_t systemNanos{0};
+  std::string output;
+
+  std::string toString(bool detail);
+};
+
+struct ParameterDim {
+  std::string flag;
+  std::vector<std::string> values;
+};
+
+/// Runs query plans over Hive tables in Parquet or DWRF files. Shared by the
+/// TPC-H and TPC-DS benchmarks so that both use the same flags for drivers,
+/// splits, caching and IO. A subclass implements runMain() to pick the plans
+/// to run.
+class QueryBenchmarkBase {
+ public:
+  virtual ~QueryBenchmarkBase() = default;
+
+  /// Sets up the memory manager, the caches, the function registries and the
+  /// Hive connector according to the flags.
+  void initialize();
+
+  void shutdown();
+
+  /// Runs 'plan' --num_repeats times and returns the cursor and results of the
+  /// last run. Returns a nullptr cursor if the query fails.
+  std::pair<std::unique_ptr<exec::test::TaskCursor>, std::vector<RowVectorPtr>>
+  run(const exec::test::TpchPlan& plan);
+
+  /// Runs the benchmarks or runs a single query and writes its statistics to
+  /// 'out'.
+  virtual void runMain(std::ostream& out, RunStats& runStats) = 0;
+
+  /// Runs runMain() for each combination of the flag values in
+  /// --test_flags_file and prints the results sorted by run time.
+  void runAllCombinations();
+
+ protected:
+  /// Runs 'plan' once and writes its result if --include_results, its
+  /// execution time and its plan with statistics to 'out'. Exits the process
+  /// if the query fails.
+  void runVerbose(
+      const exec::test::TpchPlan& plan,
+      std::ostream& out,
+      RunStats& runStats);
+
+ private:
+  void readCombinations();
+
+  void runCombinations(int32_t level);
+
+  std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> cacheExecutor_;
+  std::shared_ptr<cache::AsyncDataCache> cache_;
+  // Parameter combinations to try. Each element specifies a flag and possible
+  // values. All permutations are tried.
+  std::vector<ParameterDim> parameters_;
+
+  std::vector<RunStats> runStats_;
+};
+
+} // namespace facebook::velox
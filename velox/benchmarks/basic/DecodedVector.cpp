@@ -33,7 +33,14 @@ namespace {
 class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
  public:
   explicit DecodedVectorBenchmark(size_t vectorSize)
-      : FunctionBenchmarkBase(), vectorSize_(vectorSize), rows_(vectorSize) {
+      : FunctionBenchmarkBase(),
+        vectorSize_(vectorSize),
+        rows_(vectorSize),
+        sparseRows_(vectorSize) {
+    for (auto i = 1; i < vectorSize_; i += 2) {
+      sparseRows_.setValid(i, false);
+    }
+    sparseRows_.updateBounds();
     VectorFuzzer::Options opts;
     opts.vectorSize = vectorSize_;
     opts.nullRatio = 0;
@@ -118,6 +125,12 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     DecodedVector decodedVector(*dictionaryNestedVector_, rows_);
   }
 
+  // Measure time to decode a 5-way nested dictionary vector for every other
+  // row.
+  void decodeDictionary5NestedSparse() {
+    DecodedVector decodedVector(*dictionaryNestedVector_, sparseRows_);
+  }
+
  private:
   void decodedRun(const DecodedVector& decodedVector) {
     size_t sum = 0;
@@ -135,6 +148,7 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
   VectorPtr dictionaryNestedVector_;
 
   SelectivityVector rows_;
+  SelectivityVector sparseRows_;
 };
 
 std::unique_ptr<DecodedVectorBenchmark> benchmark;
@@ -185,6 +199,10 @@ BENCHMARK(decodeDictionary5Nested) {
   run([&] { benchmark->decodeDictionary5Nested(); });
 }
 
+BENCHMARK(decodeDictionary5NestedSparse) {
+  run([&] { benchmark->decodeDictionary5NestedSparse(); });
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/benchmarks/QueryBenchmarkBase.h"
+#include "velox/benchmarks/tpcds/TpcdsQueryBuilder.h"
+#include "velox/dwio/common/Options.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+static bool notEmpty(const char* /*flagName*/, const std::string& value) {
+  return !value.empty();
+}
+} // namespace
+
+DEFINE_string(
+    data_path,
+    "",
+    "Root path of TPC-DS data. Data layout must follow Hive-style "
+    "partitioning. Example layout for '-data_path=/data/tpcds10'\n"
+    "       /data/tpcds10/catalog_sales\n"
+    "       /data/tpcds10/customer\n"
+    "       /data/tpcds10/customer_demographics\n"
+    "       /data/tpcds10/date_dim\n"
+    "       /data/tpcds10/item\n"
+    "       /data/tpcds10/promotion\n"
+    "       /data/tpcds10/store\n"
+    "       /data/tpcds10/store_sales\n"
+    "       /data/tpcds10/web_sales\n"
+    "If the above are directories, they contain the data files for "
+    "each table. If they are files, they contain a file system path for each "
+    "data file, one per line. This allows running against cloud storage or "
+    "HDFS");
+
+DEFINE_int32(
+    run_query_verbose,
+    -1,
+    "Run a given query and print execution statistics");
+
+DEFINE_validator(data_path, &notEmpty);
+
+std::shared_ptr<TpcdsQueryBuilder> queryBuilder;
+
+class TpcdsBenchmark : public QueryBenchmarkBase {
+ public:
+  void runMain(std::ostream& out, RunStats& runStats) override {
+    if (FLAGS_run_query_verbose == -1) {
+      folly::runBenchmarks();
+    } else {
+      runVerbose(
+          queryBuilder->getQueryPlan(FLAGS_run_query_verbose), out, runStats);
+    }
+  }
+};
+
+TpcdsBenchmark benchmark;
+
+BENCHMARK(q3) {
+  const auto planContext = queryBuilder->getQueryPlan(3);
+  benchmark.run(planContext);
+}
+
+BENCHMARK(q7) {
+  const auto planContext = queryBuilder->getQueryPlan(7);
+  benchmark.run(planContext);
+}
+
+BENCHMARK(q27) {
+  const auto planContext = queryBuilder->getQueryPlan(27);
+  benchmark.run(planContext);
+}
+
+BENCHMARK(q38) {
+  const auto planContext = queryBuilder->getQueryPlan(38);
+  benchmark.run(planContext);
+}
+
+BENCHMARK(q87) {
+  const auto planContext = queryBuilder->getQueryPlan(87);
+  benchmark.run(planContext);
+}
+
+BENCHMARK(q98) {
+  const auto planContext = queryBuilder->getQueryPlan(98);
+  benchmark.run(planContext);
+}
+
+int main(int argc, char** argv) {
+  std::string kUsage(
+      "This program benchmarks TPC-DS queries. Run 'velox_tpcds_benchmark -helpon=TpcdsBenchmark' for available options.\n");
+  gflags::SetUsageMessage(kUsage);
+  folly::Init init{&argc, &argv, false};
+  benchmark.initialize();
+  queryBuilder =
+      std::make_shared<TpcdsQueryBuilder>(toFileFormat(FLAGS_data_format));
+  queryBuilder->initialize(FLAGS_data_path);
+  if (FLAGS_test_flags_file.empty()) {
+    RunStats ignore;
+    benchmark.runMain(std::cout, ignore);
+  } else {
+    benchmark.runAllCombinations();
+  }
+  benchmark.shutdown();
+  queryBuilder.reset();
+  return 0;
+}
@@ -0,0 +1,874 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/benchmarks/tpcds/TpcdsQueryBuilder.h"
+
+#include "velox/common/base/Fs.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+#include <fstream>
+
+namespace facebook::velox::exec::test {
+
+namespace {
+/// DWRF does not support Date type and Varchar is used.
+/// Return the Date filter expression as per data format.
+std::string formatDateFilter(
+    const std::string& stringDate,
+    const RowTypePtr& rowType,
+    const std::string& lowerBound,
+    const std::string& upperBound) {
+  bool isDwrf = rowType->findChild(stringDate)->isVarchar();
+  auto suffix = isDwrf ? "" : "::DATE";
+  return fmt::format(
+      "{} between {}{} and {}{}",
+      stringDate,
+      lowerBound,
+      suffix,
+      upperBound,
+      suffix);
+}
+} // namespace
+
+void TpcdsQueryBuilder::readFileSchema(
+    const std::string& tableName,
+    const std::string& filePath,
+    const std::vector<std::string>& columns) {
+  dwio::common::ReaderOptions readerOptions{pool_.get()};
+  readerOptions.setFileFormat(format_);
+  auto uniqueReadFile =
+      filesystems::getFileSystem(filePath, nullptr)->openFileForRead(filePath);
+  std::shared_ptr<ReadFile> readFile;
+  readFile.reset(uniqueReadFile.release());
+  auto input = std::make_unique<dwio::common::BufferedInput>(
+      readFile, readerOptions.getMemoryPool());
+  std::unique_ptr<dwio::common::Reader> reader =
+      dwio::common::getReaderFactory(readerOptions.getFileFormat())
+          ->createReader(std::move(input), readerOptions);
+  const auto fileType = reader->rowType();
+  const auto fileColumnNames = fileType->names();
+  // Only the leading columns are mapped. The rest of the columns are ignored.
+  VELOX_CHECK_GE(fileColumnNames.size(), columns.size());
+  std::unordered_map<std::string, std::string> fileColumnNamesMap(
+      columns.size());
+  std::transform(
+      columns.begin(),
+      columns.end(),
+      fileColumnNames.begin(),
+      std::inserter(fileColumnNamesMap, fileColumnNamesMap.begin()),
+      [](std::string a, std::string b) { return std::make_pair(a, b); });
+  auto columnNames = columns;
+  auto types = fileType->children();
+  types.resize(columnNames.size());
+  tableMetadata_[tableName].type =
+      std::make_shared<RowType>(std::move(columnNames), std::move(types));
+  tableMetadata_[tableName].fileColumnNames = std::move(fileColumnNamesMap);
+}
+
+void TpcdsQueryBuilder::initialize(const std::string& dataPath) {
+  for (const auto& [tableName, columns] : kTables_) {
+    const fs::path tablePath{dataPath + "/" + tableName};
+    std::error_code error;
+    bool anyFound = false;
+    for (auto const& dirEntry : fs::directory_iterator{
+             tablePath, std::filesystem::directory_options(), error}) {
+      if (!dirEntry.is_regular_file()) {
+        continue;
+      }
+      // Ignore hidden files.
+      if (dirEntry.path().filename().c_str()[0] == '.') {
+        continue;
+      }
+      if (tableMetadata_[tableName].dataFiles.empty()) {
+        anyFound = true;
+        readFileSchema(tableName, dirEntry.path().string(), columns);
+      }
+      tableMetadata_[tableName].dataFiles.push_back(dirEntry.path());
+    }
+    if (!anyFound && error) {
+      std::ifstream file(tablePath);
+      std::string line;
+      while (std::getline(file, line)) {
+        if (tableMetadata_[tableName].dataFiles.empty()) {
+          readFileSchema(tableName, line, columns);
+        }
+        tableMetadata_[tableName].dataFiles.push_back(line);
+      }
+    }
+  }
+}
+
+TpchPlan TpcdsQueryBuilder::getQueryPlan(int queryId) const {
+  switch (queryId) {
+    case 3:
+      return getQ3Plan();
+    case 7:
+      return getQ7Plan();
+    case 27:
+      return getQ27Plan();
+    case 38:
+      return getQ38Plan();
+    case 87:
+      return getQ87Plan();
+    case 98:
+      return getQ98Plan();
+    default:
+      VELOX_NYI("TPC-DS query {} is not supported yet", queryId);
+  }
+}
+
+TpchPlan TpcdsQueryBuilder::getQ3Plan() const {
+  std::vector<std::string> storeSalesColumns = {
+      "ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"};
+  std::vector<std::string> dateDimColumns = {"d_date_sk", "d_year", "d_moy"};
+  std::vector<std::string> itemColumns = {
+      "i_item_sk", "i_brand_id", "i_brand", "i_manufact_id"};
+
+  const auto storeSalesSelectedRowType =
+      getRowType(kStoreSales, storeSalesColumns);
+  const auto& storeSalesFileColumns = getFileColumnNames(kStoreSales);
+  const auto dateDimSelectedRowType = getRowType(kDateDim, dateDimColumns);
+  const auto& dateDimFileColumns = getFileColumnNames(kDateDim);
+  const auto itemSelectedRowType = getRowType(kItem, itemColumns);
+  const auto& itemFileColumns = getFileColumnNames(kItem);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesPlanNodeId;
+  core::PlanNodeId dateDimPlanNodeId;
+  core::PlanNodeId itemPlanNodeId;
+
+  auto dates = PlanBuilder(planNodeIdGenerator, pool_.get())
+                   .tableScan(
+                       kDateDim,
+                       dateDimSelectedRowType,
+                       dateDimFileColumns,
+                       {"d_moy = 11"})
+                   .capturePlanNodeId(dateDimPlanNodeId)
+                   .planNode();
+
+  auto items = PlanBuilder(planNodeIdGenerator, pool_.get())
+                   .tableScan(
+                       kItem,
+                       itemSelectedRowType,
+                       itemFileColumns,
+                       {"i_manufact_id = 128"})
+                   .capturePlanNodeId(itemPlanNodeId)
+                   .planNode();
+
+  auto plan =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kStoreSales, storeSalesSelectedRowType, storeSalesFileColumns)
+          .capturePlanNodeId(storeSalesPlanNodeId)
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"ss_sold_date_sk",
+               "ss_ext_sales_price",
+               "i_brand_id",
+               "i_brand"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"d_year", "i_brand_id", "i_brand", "ss_ext_sales_price"})
+          .partialAggregation(
+              {"d_year", "i_brand", "i_brand_id"},
+              {"sum(ss_ext_sales_price) AS sum_agg"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(
+              {"d_year",
+               "i_brand_id AS brand_id",
+               "i_brand AS brand",
+               "sum_agg"})
+          .orderBy({"d_year", "sum_agg DESC", "brand_id"}, false)
+          .limit(0, 100, false)
+          .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[storeSalesPlanNodeId] = getTableFilePaths(kStoreSales);
+  context.dataFiles[dateDimPlanNodeId] = getTableFilePaths(kDateDim);
+  context.dataFiles[itemPlanNodeId] = getTableFilePaths(kItem);
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ7Plan() const {
+  std::vector<std::string> storeSalesColumns = {
+      "ss_sold_date_sk",
+      "ss_item_sk",
+      "ss_cdemo_sk",
+      "ss_promo_sk",
+      "ss_quantity",
+      "ss_list_price",
+      "ss_sales_price",
+      "ss_coupon_amt"};
+  std::vector<std::string> demographicsColumns = {
+      "cd_demo_sk", "cd_gender", "cd_marital_status", "cd_education_status"};
+  std::vector<std::string> dateDimColumns = {"d_date_sk", "d_year"};
+  std::vector<std::string> itemColumns = {"i_item_sk", "i_item_id"};
+  std::vector<std::string> promotionColumns = {
+      "p_promo_sk", "p_channel_email", "p_channel_event"};
+
+  const auto storeSalesSelectedRowType =
+      getRowType(kStoreSales, storeSalesColumns);
+  const auto& storeSalesFileColumns = getFileColumnNames(kStoreSales);
+  const auto demographicsSelectedRowType =
+      getRowType(kCustomerDemographics, demographicsColumns);
+  const auto& demographicsFileColumns =
+      getFileColumnNames(kCustomerDemographics);
+  const auto dateDimSelectedRowType = getRowType(kDateDim, dateDimColumns);
+  const auto& dateDimFileColumns = getFileColumnNames(kDateDim);
+  const auto itemSelectedRowType = getRowType(kItem, itemColumns);
+  const auto& itemFileColumns = getFileColumnNames(kItem);
+  const auto promotionSelectedRowType =
+      getRowType(kPromotion, promotionColumns);
+  const auto& promotionFileColumns = getFileColumnNames(kPromotion);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesPlanNodeId;
+  core::PlanNodeId demographicsPlanNodeId;
+  core::PlanNodeId dateDimPlanNodeId;
+  core::PlanNodeId itemPlanNodeId;
+  core::PlanNodeId promotionPlanNodeId;
+
+  auto demographics =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kCustomerDemographics,
+              demographicsSelectedRowType,
+              demographicsFileColumns,
+              {"cd_gender = 'M'",
+               "cd_marital_status = 'S'",
+               "cd_education_status = 'College'"})
+          .capturePlanNodeId(demographicsPlanNodeId)
+          .planNode();
+
+  auto dates = PlanBuilder(planNodeIdGenerator, pool_.get())
+                   .tableScan(
+                       kDateDim,
+                       dateDimSelectedRowType,
+                       dateDimFileColumns,
+                       {"d_year = 2000"})
+                   .capturePlanNodeId(dateDimPlanNodeId)
+                   .planNode();
+
+  auto items =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(kItem, itemSelectedRowType, itemFileColumns)
+          .capturePlanNodeId(itemPlanNodeId)
+          .planNode();
+
+  auto promotions =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kPromotion,
+              promotionSelectedRowType,
+              promotionFileColumns,
+              {},
+              "p_channel_email = 'N' OR p_channel_event = 'N'")
+          .capturePlanNodeId(promotionPlanNodeId)
+          .planNode();
+
+  auto plan =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kStoreSales, storeSalesSelectedRowType, storeSalesFileColumns)
+          .capturePlanNodeId(storeSalesPlanNodeId)
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics,
+              "",
+              {"ss_sold_date_sk",
+               "ss_item_sk",
+               "ss_promo_sk",
+               "ss_quantity",
+               "ss_list_price",
+               "ss_sales_price",
+               "ss_coupon_amt"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_item_sk",
+               "ss_promo_sk",
+               "ss_quantity",
+               "ss_list_price",
+               "ss_sales_price",
+               "ss_coupon_amt"})
+          .hashJoin(
+              {"ss_promo_sk"},
+              {"p_promo_sk"},
+              promotions,
+              "",
+              {"ss_item_sk",
+               "ss_quantity",
+               "ss_list_price",
+               "ss_sales_price",
+               "ss_coupon_amt"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"i_item_id",
+               "ss_quantity",
+               "ss_list_price",
+               "ss_sales_price",
+               "ss_coupon_amt"})
+          .partialAggregation(
+              {"i_item_id"},
+              {"avg(ss_quantity) AS agg1",
+               "avg(ss_list_price) AS agg2",
+               "avg(ss_coupon_amt) AS agg3",
+               "avg(ss_sales_price) AS agg4"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .orderBy({"i_item_id"}, false)
+          .limit(0, 100, false)
+          .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[storeSalesPlanNodeId] = getTableFilePaths(kStoreSales);
+  context.dataFiles[demographicsPlanNodeId] =
+      getTableFilePaths(kCustomerDemographics);
+  context.dataFiles[dateDimPlanNodeId] = getTableFilePaths(kDateDim);
+  context.dataFiles[itemPlanNodeId] = getTableFilePaths(kItem);
+  context.dataFiles[promotionPlanNodeId] = getTableFilePaths(kPromotion);
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ27Plan() const {
+  std::vector<std::string> storeSalesColumns = {
+      "ss_sold_date_sk",
+      "ss_item_sk",
+      "ss_cdemo_sk",
+      "ss_store_sk",
+      "ss_quantity",
+      "ss_list_price",
+      "ss_sales_price",
+      "ss_coupon_amt"};
+  std::vector<std::string> demographicsColumns = {
+      "cd_demo_sk", "cd_gender", "cd_marital_status", "cd_education_status"};
+  std::vector<std::string> dateDimColumns = {"d_date_sk", "d_year"};
+  std::vector<std::string> storeColumns = {"s_store_sk", "s_state"};
+  std::vector<std::string> itemColumns = {"i_item_sk", "i_item_id"};
+
+  const auto storeSalesSelectedRowType =
+      getRowType(kStoreSales, storeSalesColumns);
+  const auto& storeSalesFileColumns = getFileColumnNames(kStoreSales);
+  const auto demographicsSelectedRowType =
+      getRowType(kCustomerDemographics, demographicsColumns);
+  const auto& demographicsFileColumns =
+      getFileColumnNames(kCustomerDemographics);
+  const auto dateDimSelectedRowType = getRowType(kDateDim, dateDimColumns);
+  const auto& dateDimFileColumns = getFileColumnNames(kDateDim);
+  const auto storeSelectedRowType = getRowType(kStore, storeColumns);
+  const auto& storeFileColumns = getFileColumnNames(kStore);
+  const auto itemSelectedRowType = getRowType(kItem, itemColumns);
+  const auto& itemFileColumns = getFileColumnNames(kItem);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesPlanNodeId;
+  core::PlanNodeId demographicsPlanNodeId;
+  core::PlanNodeId dateDimPlanNodeId;
+  core::PlanNodeId storePlanNodeId;
+  core::PlanNodeId itemPlanNodeId;
+
+  auto demographics =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kCustomerDemographics,
+              demographicsSelectedRowType,
+              demographicsFileColumns,
+              {"cd_gender = 'M'",
+               "cd_marital_status = 'S'",
+               "cd_education_status = 'College'"})
+          .capturePlanNodeId(demographicsPlanNodeId)
+          .planNode();
+
+  auto dates = PlanBuilder(planNodeIdGenerator, pool_.get())
+                   .tableScan(
+                       kDateDim,
+                       dateDimSelectedRowType,
+                       dateDimFileColumns,
+                       {"d_year = 2002"})
+                   .capturePlanNodeId(dateDimPlanNodeId)
+                   .planNode();
+
+  auto stores = PlanBuilder(planNodeIdGenerator, pool_.get())
+                    .tableScan(
+                        kStore,
+                        storeSelectedRowType,
+                        storeFileColumns,
+                        {"s_state = 'TN'"})
+                    .capturePlanNodeId(storePlanNodeId)
+                    .planNode();
+
+  auto items =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(kItem, itemSelectedRowType, itemFileColumns)
+          .capturePlanNodeId(itemPlanNodeId)
+          .planNode();
+
+  auto plan =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kStoreSales, storeSalesSelectedRowType, storeSalesFileColumns)
+          .capturePlanNodeId(storeSalesPlanNodeId)
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics,
+              "",
+              {"ss_sold_date_sk",
+               "ss_item_sk",
+               "ss_store_sk",
+               "ss_quantity",
+               "ss_list_price",
+               "ss_sales_price",
+               "ss_coupon_amt"})
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_item_sk",
+               "ss_store_sk",
+               "ss_quantity",
+               "ss_list_price",
+               "ss_sales_price",
+               "ss_coupon_amt"})
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              {"ss_item_sk",
+               "s_state",
+               "ss_quantity",
+               "ss_list_price",
+               "ss_sales_price",
+               "ss_coupon_amt"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"i_item_id",
+               "s_state",
+               "ss_quantity",
+               "ss_list_price",
+               "ss_sales_price",
+               "ss_coupon_amt"})
+          // Rollup of (i_item_id, s_state).
+          .groupId(
+              {"i_item_id", "s_state"},
+              {{"i_item_id", "s_state"}, {"i_item_id"}, {}},
+              {"ss_quantity",
+               "ss_list_price",
+               "ss_sales_price",
+               "ss_coupon_amt"})
+          .partialAggregation(
+              {"i_item_id", "s_state", "group_id"},
+              {"avg(ss_quantity) AS agg1",
+               "avg(ss_list_price) AS agg2",
+               "avg(ss_coupon_amt) AS agg3",
+               "avg(ss_sales_price) AS agg4"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .project(
+              {"i_item_id",
+               "s_state",
+               "if(group_id = 0, 0, 1) AS g_state",
+               "agg1",
+               "agg2",
+               "agg3",
+               "agg4"})
+          .orderBy({"i_item_id", "s_state"}, false)
+          .limit(0, 100, false)
+          .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[storeSalesPlanNodeId] = getTableFilePaths(kStoreSales);
+  context.dataFiles[demographicsPlanNodeId] =
+      getTableFilePaths(kCustomerDemographics);
+  context.dataFiles[dateDimPlanNodeId] = getTableFilePaths(kDateDim);
+  context.dataFiles[storePlanNodeId] = getTableFilePaths(kStore);
+  context.dataFiles[itemPlanNodeId] = getTableFilePaths(kItem);
+  context.dataFileFormat = format_;
+  return context;
+}
+
+void TpcdsQueryBuilder::addCustomerDates(
+    PlanBuilder& builder,
+    const std::string& salesTable,
+    const std::string& prefix,
+    const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+    TpchPlan& context) const {
+  const auto dateKey = fmt::format("{}_sold_date_sk", prefix);
+  // Store sales are by customer, catalog and web sales by billed customer.
+  const auto customerKey = prefix == "ss"
+      ? fmt::format("{}_customer_sk", prefix)
+      : fmt::format("{}_bill_customer_sk", prefix);
+  std::vector<std::string> salesColumns = {dateKey, customerKey};
+  std::vector<std::string> dateDimColumns = {
+      "d_date_sk", "d_date", "d_month_seq"};
+  std::vector<std::string> customerColumns = {
+      "c_customer_sk", "c_first_name", "c_last_name"};
+
+  const auto salesSelectedRowType = getRowType(salesTable, salesColumns);
+  const auto& salesFileColumns = getFileColumnNames(salesTable);
+  const auto dateDimSelectedRowType = getRowType(kDateDim, dateDimColumns);
+  const auto& dateDimFileColumns = getFileColumnNames(kDateDim);
+  const auto customerSelectedRowType = getRowType(kCustomer, customerColumns);
+  const auto& customerFileColumns = getFileColumnNames(kCustomer);
+
+  core::PlanNodeId salesPlanNodeId;
+  core::PlanNodeId dateDimPlanNodeId;
+  core::PlanNodeId customerPlanNodeId;
+
+  auto dates = PlanBuilder(planNodeIdGenerator, pool_.get())
+                   .tableScan(
+                       kDateDim,
+                       dateDimSelectedRowType,
+                       dateDimFileColumns,
+                       {"d_month_seq between 1200 and 1211"})
+                   .capturePlanNodeId(dateDimPlanNodeId)
+                   .planNode();
+
+  auto customers =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(kCustomer, customerSelectedRowType, customerFileColumns)
+          .capturePlanNodeId(customerPlanNodeId)
+          .planNode();
+
+  const std::vector<std::string> distinctKeys = {
+      fmt::format("{}_last_name", prefix),
+      fmt::format("{}_first_name", prefix),
+      fmt::format("{}_date", prefix)};
+  builder.tableScan(salesTable, salesSelectedRowType, salesFileColumns)
+      .capturePlanNodeId(salesPlanNodeId)
+      .hashJoin({dateKey}, {"d_date_sk"}, dates, "", {customerKey, "d_date"})
+      .hashJoin(
+          {customerKey},
+          {"c_customer_sk"},
+          customers,
+          "",
+          {"c_last_name", "c_first_name", "d_date"})
+      .project(
+          {fmt::format("c_last_name AS {}", distinctKeys[0]),
+           fmt::format("c_first_name AS {}", distinctKeys[1]),
+           fmt::format("d_date AS {}", distinctKeys[2])})
+      .partialAggregation(distinctKeys, {})
+      .localPartition(distinctKeys)
+      .finalAggregation();
+
+  context.dataFiles[salesPlanNodeId] = getTableFilePaths(salesTable);
+  context.dataFiles[dateDimPlanNodeId] = getTableFilePaths(kDateDim);
+  context.dataFiles[customerPlanNodeId] = getTableFilePaths(kCustomer);
+}
+
+TpchPlan TpcdsQueryBuilder::getCustomerDatesPlan(
+    core::JoinType joinType) const {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  TpchPlan context;
+
+  PlanBuilder catalog(planNodeIdGenerator, pool_.get());
+  addCustomerDates(catalog, kCatalogSales, "cs", planNodeIdGenerator, context);
+  PlanBuilder web(planNodeIdGenerator, pool_.get());
+  addCustomerDates(web, kWebSales, "ws", planNodeIdGenerator, context);
+
+  PlanBuilder store(planNodeIdGenerator, pool_.get());
+  addCustomerDates(store, kStoreSales, "ss", planNodeIdGenerator, context);
+  const std::vector<std::string> storeKeys = {
+      "ss_last_name", "ss_first_name", "ss_date"};
+  auto plan =
+      store
+          .hashJoin(
+              storeKeys,
+              {"cs_last_name", "cs_first_name", "cs_date"},
+              catalog.planNode(),
+              "",
+              storeKeys,
+              joinType)
+          .hashJoin(
+              storeKeys,
+              {"ws_last_name", "ws_first_name", "ws_date"},
+              web.planNode(),
+              "",
+              storeKeys,
+              joinType)
+          .partialAggregation({}, {"count(0) AS cnt"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .planNode();
+
+  context.plan = std::move(plan);
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ38Plan() const {
+  // INTERSECT of the customers of the 3 channels.
+  return getCustomerDatesPlan(core::JoinType::kLeftSemiFilter);
+}
+
+TpchPlan TpcdsQueryBuilder::getQ87Plan() const {
+  // EXCEPT of the customers of the catalog and web channels from the
+  // customers of the store channel.
+  return getCustomerDatesPlan(core::JoinType::kAnti);
+}
+
+TpchPlan TpcdsQueryBuilder::getQ98Plan() const {
+  std::vector<std::string> storeSalesColumns = {
+      "ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"};
+  std::vector<std::string> dateDimColumns = {"d_date_sk", "d_date"};
+  std::vector<std::string> itemColumns = {
+      "i_item_sk",
+      "i_item_id",
+      "i_item_desc",
+      "i_current_price",
+      "i_class",
+      "i_category"};
+
+  const auto storeSalesSelectedRowType =
+      getRowType(kStoreSales, storeSalesColumns);
+  const auto& storeSalesFileColumns = getFileColumnNames(kStoreSales);
+  const auto dateDimSelectedRowType = getRowType(kDateDim, dateDimColumns);
+  const auto& dateDimFileColumns = getFileColumnNames(kDateDim);
+  const auto itemSelectedRowType = getRowType(kItem, itemColumns);
+  const auto& itemFileColumns = getFileColumnNames(kItem);
+
+  const auto dateFilter = formatDateFilter(
+      "d_date", dateDimSelectedRowType, "'1999-02-22'", "'1999-03-24'");
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId storeSalesPlanNodeId;
+  core::PlanNodeId dateDimPlanNodeId;
+  core::PlanNodeId itemPlanNodeId;
+
+  auto dates = PlanBuilder(planNodeIdGenerator, pool_.get())
+                   .tableScan(
+                       kDateDim,
+                       dateDimSelectedRowType,
+                       dateDimFileColumns,
+                       {dateFilter})
+                   .capturePlanNodeId(dateDimPlanNodeId)
+                   .planNode();
+
+  auto items = PlanBuilder(planNodeIdGenerator, pool_.get())
+                   .tableScan(
+                       kItem,
+                       itemSelectedRowType,
+                       itemFileColumns,
+                       {"i_category IN ('Sports', 'Books', 'Home')"})
+                   .capturePlanNodeId(itemPlanNodeId)
+                   .planNode();
+
+  const std::vector<std::string> itemKeys = {
+      "i_item_id", "i_item_desc", "i_category", "i_class", "i_current_price"};
+  auto plan =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kStoreSales, storeSalesSelectedRowType, storeSalesFileColumns)
+          .capturePlanNodeId(storeSalesPlanNodeId)
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              {"ss_item_sk", "ss_ext_sales_price"})
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              {"i_item_id",
+               "i_item_desc",
+               "i_category",
+               "i_class",
+               "i_current_price",
+               "ss_ext_sales_price"})
+          .partialAggregation(
+              itemKeys, {"sum(ss_ext_sales_price) AS itemrevenue"})
+          // The groups of a class and the window partition of the class end
+          // up in the same driver.
+          .localPartition({"i_class"})
+          .finalAggregation()
+          .window(
+              {"sum(itemrevenue) OVER (PARTITION BY i_class) AS class_revenue"})
+          .project(
+              {"i_item_id",
+               "i_item_desc",
+               "i_category",
+               "i_class",
+               "i_current_price",
+               "itemrevenue",
+               "cast(itemrevenue AS double) * 100.0 / "
+               "cast(class_revenue AS double) AS revenueratio"})
+          .localPartition(std::vector<std::string>{})
+          .orderBy(
+              {"i_category",
+               "i_class",
+               "i_item_id",
+               "i_item_desc",
+               "revenueratio"},
+              false)
+          .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[storeSalesPlanNodeId] = getTableFilePaths(kStoreSales);
+  context.dataFiles[dateDimPlanNodeId] = getTableFilePaths(kDateDim);
+  context.dataFiles[itemPlanNodeId] = getTableFilePaths(kItem);
+  context.dataFileFormat = format_;
+  return context;
+}
+
+// The leading columns of each table in the order of the TPC-DS standard, up
+// to the last column used by the queries.
+const std::unordered_map<std::string, std::vector<std::string>>
+    TpcdsQueryBuilder::kTables_ = {
+        {"store_sales",
+         {"ss_sold_date_sk",
+          "ss_sold_time_sk",
+          "ss_item_sk",
+          "ss_customer_sk",
+          "ss_cdemo_sk",
+          "ss_hdemo_sk",
+          "ss_addr_sk",
+          "ss_store_sk",
+          "ss_promo_sk",
+          "ss_ticket_number",
+          "ss_quantity",
+          "ss_wholesale_cost",
+          "ss_list_price",
+          "ss_sales_price",
+          "ss_ext_discount_amt",
+          "ss_ext_sales_price",
+          "ss_ext_wholesale_cost",
+          "ss_ext_list_price",
+          "ss_ext_tax",
+          "ss_coupon_amt"}},
+        {"catalog_sales",
+         {"cs_sold_date_sk",
+          "cs_sold_time_sk",
+          "cs_ship_date_sk",
+          "cs_bill_customer_sk"}},
+        {"web_sales",
+         {"ws_sold_date_sk",
+          "ws_sold_time_sk",
+          "ws_ship_date_sk",
+          "ws_item_sk",
+          "ws_bill_customer_sk"}},
+        {"date_dim",
+         {"d_date_sk",
+          "d_date_id",
+          "d_date",
+          "d_month_seq",
+          "d_week_seq",
+          "d_quarter_seq",
+          "d_year",
+          "d_dow",
+          "d_moy"}},
+        {"item",
+         {"i_item_sk",
+          "i_item_id",
+          "i_rec_start_date",
+          "i_rec_end_date",
+          "i_item_desc",
+          "i_current_price",
+          "i_wholesale_cost",
+          "i_brand_id",
+          "i_brand",
+          "i_class_id",
+          "i_class",
+          "i_category_id",
+          "i_category",
+          "i_manufact_id"}},
+        {"store",
+         {"s_store_sk",
+          "s_store_id",
+          "s_rec_start_date",
+          "s_rec_end_date",
+          "s_closed_date_sk",
+          "s_store_name",
+          "s_number_employees",
+          "s_floor_space",
+          "s_hours",
+          "s_manager",
+          "s_market_id",
+          "s_geography_class",
+          "s_market_desc",
+          "s_market_manager",
+          "s_division_id",
+          "s_division_name",
+          "s_company_id",
+          "s_company_name",
+          "s_street_number",
+          "s_street_name",
+          "s_street_type",
+          "s_suite_number",
+          "s_city",
+          "s_county",
+          "s_state"}},
+        {"customer",
+         {"c_customer_sk",
+          "c_customer_id",
+          "c_current_cdemo_sk",
+          "c_current_hdemo_sk",
+          "c_current_addr_sk",
+          "c_first_shipto_date_sk",
+          "c_first_sales_date_sk",
+          "c_salutation",
+          "c_first_name",
+          "c_last_name"}},
+        {"customer_demographics",
+         {"cd_demo_sk",
+          "cd_gender",
+          "cd_marital_status",
+          "cd_education_status"}},
+        {"promotion",
+         {"p_promo_sk",
+          "p_promo_id",
+          "p_start_date_sk",
+          "p_end_date_sk",
+          "p_item_sk",
+          "p_cost",
+          "p_response_target",
+          "p_promo_name",
+          "p_channel_dmail",
+          "p_channel_email",
+          "p_channel_catalog",
+          "p_channel_tv",
+          "p_channel_radio",
+          "p_channel_press",
+          "p_channel_event"}}};
+
+} // namespace facebook::velox::exec::test
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/Options.h"
+#include "velox/exec/tests/utils/TpchQueryBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+/// Builds TPC-DS queries using TPC-DS data files located in the specified
+/// directory. The data layout is the same as for TpchQueryBuilder: one
+/// sub-directory or file list per table, named after the table. As with
+/// TPC-H, the column names in the files can vary and are mapped by position
+/// to the standard TPC-DS names, so the columns must be in the order of the
+/// TPC-DS standard. Only the leading columns used by the queries are mapped
+/// and any further columns are ignored.
+///
+/// Covers queries that exercise the operators not used by TPC-H: star joins
+/// over many dimensions (Q3, Q7), rollups (Q27), INTERSECT and EXCEPT of
+/// several fact tables (Q38, Q87) and window aggregates (Q98).
+class TpcdsQueryBuilder {
+ public:
+  explicit TpcdsQueryBuilder(dwio::common::FileFormat format)
+      : format_(format) {}
+
+  /// Reads a data file of each table, initializes the row types and finds the
+  /// data paths of each table.
+  /// @param dataPath path to the data files
+  void initialize(const std::string& dataPath);
+
+  /// Returns the query plan for a given TPC-DS query number.
+  /// @param queryId TPC-DS query number
+  TpchPlan getQueryPlan(int queryId) const;
+
+ private:
+  void readFileSchema(
+      const std::string& tableName,
+      const std::string& filePath,
+      const std::vector<std::string>& columns);
+
+  TpchPlan getQ3Plan() const;
+  TpchPlan getQ7Plan() const;
+  TpchPlan getQ27Plan() const;
+  TpchPlan getQ38Plan() const;
+  TpchPlan getQ87Plan() const;
+  TpchPlan getQ98Plan() const;
+
+  // Shared by Q38 and Q87. Returns the plan of Q38 for 'joinType'
+  // kLeftSemiFilter and of Q87 for kAnti.
+  TpchPlan getCustomerDatesPlan(core::JoinType joinType) const;
+
+  // Adds to 'builder' a plan that produces the distinct (last name, first
+  // name, date) of the customers who bought from 'salesTable' in the months
+  // 1200 to 1211. The output columns are named <prefix>_last_name,
+  // <prefix>_first_name and <prefix>_date. Adds the data files of the scans
+  // to 'context'.
+  void addCustomerDates(
+      PlanBuilder& builder,
+      const std::string& salesTable,
+      const std::string& prefix,
+      const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+      TpchPlan& context) const;
+
+  const std::vector<std::string>& getTableFilePaths(
+      const std::string& tableName) const {
+    return tableMetadata_.at(tableName).dataFiles;
+  }
+
+  std::shared_ptr<const RowType> getRowType(
+      const std::string& tableName,
+      const std::vector<std::string>& columnNames) const {
+    auto columnSelector = std::make_shared<dwio::common::ColumnSelector>(
+        tableMetadata_.at(tableName).type, columnNames);
+    return columnSelector->buildSelectedReordered();
+  }
+
+  const std::unordered_map<std::string, std::string>& getFileColumnNames(
+      const std::string& tableName) const {
+    return tableMetadata_.at(tableName).fileColumnNames;
+  }
+
+  std::unordered_map<std::string, TpchTableMetadata> tableMetadata_;
+  const dwio::common::FileFormat format_;
+  static const std::unordered_map<std::string, std::vector<std::string>>
+      kTables_;
+
+  static constexpr const char* kStoreSales = "store_sales";
+  static constexpr const char* kCatalogSales = "catalog_sales";
+  static constexpr const char* kWebSales = "web_sales";
+  static constexpr const char* kDateDim = "date_dim";
+  static constexpr const char* kItem = "item";
+  static constexpr const char* kStore = "store";
+  static constexpr const char* kCustomer = "customer";
+  static constexpr const char* kCustomerDemographics = "customer_demographics";
+  static constexpr const char* kPromotion = "promotion";
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::memoryManager()->addLeafPool();
+};
+
+} // namespace facebook::velox::exec::test
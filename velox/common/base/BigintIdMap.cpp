@@ -30,6 +30,45 @@ void BigintIdMap::makeTable(int64_t capacity) {
   maxEntries_ = capacity_ - capacity_ / 4;
 }
 
+void BigintIdMap::makeIds(
+    const int64_t* values,
+    int32_t numValues,
+    int64_t* ids) {
+  constexpr int32_t kBatchSize = xsimd::batch<int64_t>::size;
+  int32_t i = 0;
+  for (; i + kBatchSize <= numValues; i += kBatchSize) {
+    makeIds(xsimd::load_unaligned(values + i)).store_unaligned(ids + i);
+  }
+  if (i < numValues) {
+    // Copies the tail to avoid reading past the end of 'values'.
+    const int32_t numTail = numValues - i;
+    int64_t tail[kBatchSize] = {};
+    std::copy(values + i, values + numValues, tail);
+    auto result = makeIds(xsimd::load_unaligned(tail), bits::lowMask(numTail));
+    result.store_unaligned(tail);
+    std::copy(tail, tail + numTail, ids + i);
+  }
+}
+
+void BigintIdMap::findIds(
+    const int64_t* values,
+    int32_t numValues,
+    int64_t* ids) {
+  constexpr int32_t kBatchSize = xsimd::batch<int64_t>::size;
+  int32_t i = 0;
+  for (; i + kBatchSize <= numValues; i += kBatchSize) {
+    findIds(xsimd::load_unaligned(values + i)).store_unaligned(ids + i);
+  }
+  if (i < numValues) {
+    const int32_t numTail = numValues - i;
+    int64_t tail[kBatchSize] = {};
+    std::copy(values + i, values + numValues, tail);
+    auto result = findIds(xsimd::load_unaligned(tail), bits::lowMask(numTail));
+    result.store_unaligned(tail);
+    std::copy(tail, tail + numTail, ids + i);
+  }
+}
+
 void BigintIdMap::resize(int64_t newCapacity) {
   VELOX_CHECK_LE(newCapacity, kMaxCapacity);
 
@@ -217,6 +217,15 @@ class BigintIdMap {
     return xsimd::load_unaligned(reinterpret_cast<int64_t*>(&resultVector));
   }
 
+  /// Sets 'ids[i]' to the id of 'values[i]' for 'numValues' values, assigning
+  /// new ids like makeIds() above. Processes the values a SIMD batch at a
+  /// time.
+  void makeIds(const int64_t* values, int32_t numValues, int64_t* ids);
+
+  /// Sets 'ids[i]' to the id of 'values[i]' for 'numValues' values, or to
+  /// kNotFound if the value has no id.
+  void findIds(const int64_t* values, int32_t numValues, int64_t* ids);
+
  private:
   using A = xsimd::default_arch;
 
@@ -22,6 +22,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/IOUtils.h"
+#include "velox/common/base/SimdUtil.h"
 
 namespace facebook::velox {
 // BloomFilter filter with groups of 64 bits, of which 4 are set. The hash
@@ -61,6 +62,28 @@ class BloomFilter {
     return test(bits_.data(), bits_.size(), value);
   }
 
+  // Adds the 'numHashes' hashed values in 'hashes'. The masks and word
+  // indices are computed a SIMD batch at a time.
+  void insert(const uint64_t* hashes, int32_t numHashes) {
+    auto* bloom = bits_.data();
+    forEachProbe(
+        hashes, numHashes, [&](int32_t /*i*/, uint32_t index, uint64_t mask) {
+          bloom[index] |= mask;
+        });
+  }
+
+  // Sets bit 'i' of 'result' if the value with hash 'hashes[i]' may be in
+  // 'this' and clears it otherwise. 'result' must have space for
+  // 'numHashes' bits.
+  void mayContain(const uint64_t* hashes, int32_t numHashes, uint64_t* result)
+      const {
+    const auto* bloom = bits_.data();
+    forEachProbe(
+        hashes, numHashes, [&](int32_t i, uint32_t index, uint64_t mask) {
+          bits::setBit(result, i, (bloom[index] & mask) == mask);
+        });
+  }
+
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
@@ -113,6 +136,36 @@ class BloomFilter {
     return ((hashCode >> 24) & (bloomSize - 1));
   }
 
+  // Calls 'func(i, index, mask)' with the word index and mask of each of the
+  // 'numHashes' values in 'hashes'.
+  template <typename Func>
+  void forEachProbe(const uint64_t* hashes, int32_t numHashes, Func func)
+      const {
+    using Batch = xsimd::batch<uint64_t>;
+    constexpr int32_t kBatchSize = Batch::size;
+    const uint32_t bloomSize = bits_.size();
+    const Batch low6(63);
+    const Batch one(1);
+    const Batch indexMask(bloomSize - 1);
+    alignas(sizeof(Batch)) uint64_t masks[kBatchSize];
+    alignas(sizeof(Batch)) uint64_t indices[kBatchSize];
+    int32_t i = 0;
+    for (; i + kBatchSize <= numHashes; i += kBatchSize) {
+      const auto hash = Batch::load_unaligned(hashes + i);
+      const auto mask = (one << (hash & low6)) |
+          (one << ((hash >> 6) & low6)) | (one << ((hash >> 12) & low6)) |
+          (one << ((hash >> 18) & low6));
+      mask.store_aligned(masks);
+      ((hash >> 24) & indexMask).store_aligned(indices);
+      for (auto j = 0; j < kBatchSize; ++j) {
+        func(i + j, indices[j], masks[j]);
+      }
+    }
+    for (; i < numHashes; ++i) {
+      func(i, bloomIndex(bloomSize, hashes[i]), bloomMask(hashes[i]));
+    }
+  }
+
   inline static void
   set(uint64_t* bloom, int32_t bloomSize, uint64_t hashCode) {
     auto mask = bloomMask(hashCode);
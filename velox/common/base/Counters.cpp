@@ -25,6 +25,12 @@ void registerVeloxMetrics() {
   // limit if enforced.
   DEFINE_METRIC(kMetricDriverYieldCount, facebook::velox::StatType::COUNT);
 
+  // The distribution of the time a runnable driver waits for an executor
+  // thread in range of [0, 60s] with 600 buckets. It is configured to report
+  // the latency at P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricDriverQueueTimeMs, 100, 0, 60'000, 50, 90, 99, 100);
+
   /// ================== Cache Counters =================
 
   // Tracks hive handle generation latency in range of [0, 100s] and reports
@@ -130,6 +136,20 @@ void registerVeloxMetrics() {
   DEFINE_HISTOGRAM_METRIC(
       kMetricArbitratorArbitrationTimeMs, 30'000, 0, 600'000, 50, 90, 99, 100);
 
+  // The distribution of the number of victim memory pools reclaimed
+  // concurrently by spilling in a single memory arbitration in range of [0,
+  // 64] with 32 buckets. It is configured to report the count at P50, P90,
+  // P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricArbitratorReclaimParallelism, 2, 0, 64, 50, 90, 99, 100);
+
+  // The distribution of the wall time it takes to reclaim memory from the
+  // victim memory pools by spilling in a single memory arbitration in range of
+  // [0, 600s] with 20 buckets. It is configured to report the latency at P50,
+  // P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricArbitratorReclaimTimeMs, 30'000, 0, 600'000, 50, 90, 99, 100);
+
   // Tracks the average of free memory capacity managed by the arbitrator in
   // bytes.
   DEFINE_METRIC(
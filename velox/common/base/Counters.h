@@ -91,12 +91,21 @@ constexpr folly::StringPiece kMetricArbitratorQueueTimeMs{
 constexpr folly::StringPiece kMetricArbitratorArbitrationTimeMs{
     "velox.arbitrator_arbitration_time_ms"};
 
+constexpr folly::StringPiece kMetricArbitratorReclaimParallelism{
+    "velox.arbitrator_reclaim_parallelism"};
+
+constexpr folly::StringPiece kMetricArbitratorReclaimTimeMs{
+    "velox.arbitrator_reclaim_time_ms"};
+
 constexpr folly::StringPiece kMetricArbitratorFreeCapacityBytes{
     "velox.arbitrator_free_capacity_bytes"};
 
 constexpr folly::StringPiece kMetricDriverYieldCount{
     "velox.driver_yield_count"};
 
+constexpr folly::StringPiece kMetricDriverQueueTimeMs{
+    "velox.driver_queue_time_ms"};
+
 constexpr folly::StringPiece kMetricSpilledInputBytes{
     "velox.spill_input_bytes"};
 
@@ -39,6 +39,14 @@ class SelectivityInfo {
     return timeToDropValue() < right.timeToDropValue();
   }
 
+  /// Halves the history so that later batches weigh more than the earlier
+  /// ones.
+  void decay() {
+    numIn_ /= 2;
+    numOut_ /= 2;
+    timeClocks_ /= 2;
+  }
+
   uint64_t numIn() const {
     return numIn_;
   }
@@ -47,6 +55,10 @@ class SelectivityInfo {
     return numOut_;
   }
 
+  uint64_t timeClocks() const {
+    return timeClocks_;
+  }
+
  private:
   uint64_t numIn_ = 0;
   uint64_t numOut_ = 0;
@@ -33,7 +33,9 @@ SpillConfig::SpillConfig(
     uint64_t _maxSpillRunRows,
     uint64_t _writerFlushThresholdSize,
     const std::string& _compressionKind,
-    const std::string& _fileCreateConfig)
+    const std::string& _fileCreateConfig,
+    bool _columnarLayout,
+    bool _readAhead)
     : getSpillDirPathCb(std::move(_getSpillDirPathCb)),
       updateAndCheckSpillLimitCb(std::move(_updateAndCheckSpillLimitCb)),
       fileNamePrefix(std::move(_fileNamePrefix)),
@@ -50,13 +52,19 @@ SpillConfig::SpillConfig(
       maxSpillRunRows(_maxSpillRunRows),
       writerFlushThresholdSize(_writerFlushThresholdSize),
       compressionKind(common::stringToCompressionKind(_compressionKind)),
-      fileCreateConfig(_fileCreateConfig) {
+      fileCreateConfig(_fileCreateConfig),
+      columnarLayout(_columnarLayout),
+      readAhead(_readAhead) {
   VELOX_USER_CHECK_GE(
       spillableReservationGrowthPct,
       minSpillableReservationPct,
       "Spillable memory reservation growth pct should not be lower than minimum available pct");
 }
 
+folly::Executor* SpillConfig::readAheadExecutor() const {
+  return readAhead ? executor : nullptr;
+}
+
 int32_t SpillConfig::spillLevel(uint8_t startBitOffset) const {
   VELOX_CHECK_LE(
       startBitOffset + numPartitionBits,
@@ -60,7 +60,9 @@ struct SpillConfig {
       uint64_t _maxSpillRunRows,
       uint64_t _writerFlushThresholdSize,
       const std::string& _compressionKind,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      bool _columnarLayout = false,
+      bool _readAhead = false);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -73,6 +75,10 @@ struct SpillConfig {
   /// the max hash join spill limit.
   bool exceedSpillLevelLimit(uint8_t startBitOffset) const;
 
+  /// Returns the executor to read ahead the spill files on when merging them,
+  /// or nullptr if the spill files are read synchronously.
+  folly::Executor* readAheadExecutor() const;
+
   /// A callback function that returns the spill directory path. Implementations
   /// can use it to ensure the path exists before returning.
   GetSpillDirectoryPathCB getSpillDirPathCb;
@@ -132,5 +138,13 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// If true, spill files store each column of a batch separately so that a
+  /// restore can read a subset of the columns without reading the others.
+  bool columnarLayout;
+
+  /// If true and 'executor' is set, the merge of spill files reads the next
+  /// buffer of each file on 'executor' while the current one is consumed.
+  bool readAhead;
 };
 } // namespace facebook::velox::common
@@ -90,3 +90,39 @@ TEST_F(BloomFilterTest, merge) {
 
   EXPECT_EQ(bloom.serializedSize(), merge.serializedSize());
 }
+
+TEST_F(BloomFilterTest, batch) {
+  // Not a multiple of the SIMD width so that the tail is covered.
+  constexpr int32_t kSize = 1'003;
+  std::vector<uint64_t> hashes(kSize);
+  std::vector<uint64_t> otherHashes(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    hashes[i] = folly::hasher<int32_t>()(i);
+    otherHashes[i] = folly::hasher<int32_t>()(i + kSize);
+  }
+  BloomFilter bloom;
+  bloom.reset(kSize);
+  bloom.insert(hashes.data(), kSize);
+  BloomFilter expected;
+  expected.reset(kSize);
+  for (auto hash : hashes) {
+    expected.insert(hash);
+  }
+
+  std::string data;
+  data.resize(bloom.serializedSize());
+  bloom.serialize(data.data());
+  std::string expectedData;
+  expectedData.resize(expected.serializedSize());
+  expected.serialize(expectedData.data());
+  EXPECT_EQ(expectedData, data);
+
+  std::vector<uint64_t> result(bits::nwords(kSize));
+  bloom.mayContain(hashes.data(), kSize, result.data());
+  EXPECT_EQ(kSize, bits::countBits(result.data(), 0, kSize));
+  bloom.mayContain(otherHashes.data(), kSize, result.data());
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_EQ(
+        bloom.mayContain(otherHashes[i]), bits::isBitSet(result.data(), i));
+  }
+}
@@ -255,6 +255,30 @@ TEST_F(IdMapTest, zerosAndMasks) {
   expect4(kNotFound, 0, kNotFound, 0, findIds4(mapWithNoZero, mix, 5));
 }
 
+TEST_F(IdMapTest, arrays) {
+  F14IdMap reference(32);
+  BigintIdMap map(8, *pool_);
+  std::vector<int64_t> data;
+  for (auto i = 0; i < 1'001; ++i) {
+    data.push_back((i % 300 + 1) * 0xfeedda7a58ff1e00);
+  }
+  // Sizes not multiple of the batch size exercise the masked tail.
+  for (const int32_t size : {1, 3, 101, 1'001}) {
+    SCOPED_TRACE(fmt::format("size: {}", size));
+    std::vector<int64_t> ids(size);
+    map.makeIds(data.data(), size, ids.data());
+    for (auto i = 0; i < size; ++i) {
+      ASSERT_EQ(ids[i], reference.id(data[i]));
+    }
+
+    std::vector<int64_t> found(size);
+    map.findIds(data.data() + 1, size - 1, found.data());
+    for (auto i = 0; i < size - 1; ++i) {
+      ASSERT_EQ(found[i], reference.findId(data[i + 1]));
+    }
+  }
+}
+
 TEST_F(IdMapTest, collisions) {
   constexpr int64_t kNotFound = BigintIdMap::kNotFound;
   // We check the found and not found stay the same as the table gets filled
@@ -15,6 +15,9 @@
  */
 
 #include "velox/common/caching/AsyncDataCache.h"
+
+#include <folly/executors/InlineExecutor.h>
+
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 
@@ -24,6 +27,12 @@
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 
+DEFINE_bool(
+    velox_cache_frequency_admission,
+    false,
+    "Evict the cache entries which have not been reused and whose keys are "
+    "not looked up often before the others");
+
 namespace facebook::velox::cache {
 
 using memory::MachinePageCount;
@@ -58,7 +67,8 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
     hook(*this);
   }
 
-  if ((ssdFile_ == nullptr) && (shard_->cache()->ssdCache() != nullptr)) {
+  if (!isDerived_ && (ssdFile_ == nullptr) &&
+      (shard_->cache()->ssdCache() != nullptr)) {
     auto* ssdCache = shard_->cache()->ssdCache();
     assert(ssdCache); // for lint only.
     if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_)) {
@@ -99,6 +109,8 @@ memory::MachinePageCount AsyncDataCacheEntry::setPrefetch(bool flag) {
 void AsyncDataCacheEntry::initialize(FileCacheKey key) {
   VELOX_CHECK(isExclusive());
   setSsdFile(nullptr, 0);
+  isDerived_ = false;
+  evictionWeight_ = 1;
   key_ = std::move(key);
   auto* cache = shard_->cache();
   ClockTimer t(shard_->allocClocks());
@@ -158,6 +170,9 @@ CachePin CacheShard::findOrCreate(
   {
     std::lock_guard<std::mutex> l(mutex_);
     ++eventCounter_;
+    const uint64_t keyHash = FLAGS_velox_cache_frequency_admission
+        ? std::hash<RawFileCacheKey>()(key)
+        : 0;
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
       auto* found = it->second;
@@ -178,6 +193,11 @@ CachePin CacheShard::findOrCreate(
         } else {
           ++numHit_;
           hitBytes_ += found->size();
+          // The first read of a prefetched entry is counted with the lookup
+          // which created it.
+          if (FLAGS_velox_cache_frequency_admission) {
+            frequency_.increment(keyHash);
+          }
         }
         ++found->numPins_;
         CachePin pin;
@@ -201,6 +221,13 @@ CachePin CacheShard::findOrCreate(
     // Initialize the members that must be set inside 'mutex_'.
     newEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
     newEntry->promise_ = nullptr;
+    newEntry->accessStats_.reset();
+    if (FLAGS_velox_cache_frequency_admission) {
+      if (entries_.size() > frequency_.capacity()) {
+        frequency_.resize(2 * entries_.size());
+      }
+      frequency_.increment(keyHash);
+    }
     entryToInit = newEntry.get();
     entryMap_[key] = newEntry.get();
     if (emptySlots_.empty()) {
@@ -272,14 +299,7 @@ bool CoalescedLoad::loadOrFuture(folly::SemiFuture<bool>* wait) {
   }
   // Outside of 'mutex_'.
   try {
-    const auto pins = loadData(!wait);
-    for (const auto& pin : pins) {
-      auto* entry = pin.checkedEntry();
-      VELOX_CHECK(entry->key().fileNum.hasValue());
-      VELOX_CHECK(entry->isExclusive());
-      entry->setExclusiveToShared();
-    }
-    setEndState(State::kLoaded);
+    finishLoad(loadData(!wait));
   } catch (std::exception&) {
     try {
       setEndState(State::kCancelled);
@@ -291,6 +311,39 @@ bool CoalescedLoad::loadOrFuture(folly::SemiFuture<bool>* wait) {
   return true;
 }
 
+// static
+void CoalescedLoad::loadAsync(const std::shared_ptr<CoalescedLoad>& load) {
+  {
+    std::lock_guard<std::mutex> l(load->mutex_);
+    if (load->state_ != State::kPlanned) {
+      return;
+    }
+    load->state_ = State::kLoading;
+  }
+  // Outside of 'mutex_'. The continuation runs on the thread that completes
+  // the load.
+  load->loadDataAsync(true)
+      .via(&folly::InlineExecutor::instance())
+      .thenTry([load](folly::Try<std::vector<CachePin>>&& pins) {
+        try {
+          load->finishLoad(pins.value());
+        } catch (const std::exception& e) {
+          LOG(WARNING) << "Asynchronous load failed: " << e.what();
+          load->setEndState(State::kCancelled);
+        }
+      });
+}
+
+void CoalescedLoad::finishLoad(const std::vector<CachePin>& pins) {
+  for (const auto& pin : pins) {
+    auto* entry = pin.checkedEntry();
+    VELOX_CHECK(entry->key().fileNum.hasValue());
+    VELOX_CHECK(entry->isExclusive());
+    entry->setExclusiveToShared();
+  }
+  setEndState(State::kLoaded);
+}
+
 void CoalescedLoad::setEndState(State endState) {
   std::lock_guard<std::mutex> l(mutex_);
   state_ = endState;
@@ -354,39 +407,57 @@ uint64_t CacheShard::evict(
     if (size == 0) {
       return 0;
     }
-    int32_t counter = 0;
-    int32_t numChecked = 0;
-    auto entryIndex = (clockHand_ % size);
-    auto iter = entries_.begin() + entryIndex;
-    while (++counter <= size) {
-      if (++iter == entries_.end()) {
-        iter = entries_.begin();
-        entryIndex = 0;
-      } else {
-        ++entryIndex;
-      }
+    // With frequency admission, the first pass only evicts the entries which
+    // are not admitted for retention and the second pass evicts by score.
+    const int32_t firstPass =
+        FLAGS_velox_cache_frequency_admission && !evictAllUnpinned ? 0 : 1;
+    for (int32_t pass = firstPass;
+         pass < 2 && largeEvicted + tinyEvicted <= bytesToFree;
+         ++pass) {
+      int32_t counter = 0;
+      int32_t numChecked = 0;
+      auto entryIndex = (clockHand_ % size);
+      auto iter = entries_.begin() + entryIndex;
+      while (++counter <= size) {
+        if (++iter == entries_.end()) {
+          iter = entries_.begin();
+          entryIndex = 0;
+        } else {
+          ++entryIndex;
+        }
 
-      ++numEvictChecks_;
-      ++clockHand_;
-      auto candidate = iter->get();
-      if (candidate == nullptr) {
-        continue;
-      }
+        ++numEvictChecks_;
+        ++clockHand_;
+        auto candidate = iter->get();
+        if (candidate == nullptr) {
+          continue;
+        }
 
-      ++numChecked;
-      if (evictionThreshold_ == kNoThreshold ||
-          eventCounter_ > entries_.size() / 4 ||
-          numChecked > entries_.size() / 8) {
-        now = accessTime();
-        calibrateThreshold();
-        numChecked = 0;
-        eventCounter_ = 0;
-      }
+        ++numChecked;
+        if (evictionThreshold_ == kNoThreshold ||
+            eventCounter_ > entries_.size() / 4 ||
+            numChecked > entries_.size() / 8) {
+          now = accessTime();
+          calibrateThreshold();
+          numChecked = 0;
+          eventCounter_ = 0;
+        }
 
-      int32_t score = 0;
-      if (candidate->numPins_ == 0 &&
-          (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+        int32_t score = 0;
+        bool unadmitted = false;
+        if (candidate->numPins_ != 0) {
+          continue;
+        }
+        if (candidate->key_.fileNum.hasValue() && !evictAllUnpinned) {
+          if (pass == 0) {
+            unadmitted = !isAdmitted(*candidate);
+            if (!unadmitted) {
+              continue;
+            }
+          } else if ((score = candidate->score(now)) < evictionThreshold_) {
+            continue;
+          }
+        }
         if (skipSsdSaveable && candidate->ssdSaveable() && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
@@ -411,6 +482,9 @@ uint64_t CacheShard::evict(
         emptySlots_.push_back(entryIndex);
         tryAddFreeEntry(std::move(*iter));
         ++numEvict_;
+        if (unadmitted) {
+          ++numEvictUnadmitted_;
+        }
         if (score > 0) {
           sumEvictScore_ += score;
         }
@@ -456,6 +530,16 @@ void CacheShard::freeAllocations(std::vector<memory::Allocation>& allocations) {
   allocations.clear();
 }
 
+bool CacheShard::isAdmitted(const AsyncDataCacheEntry& entry) const {
+  if (!FLAGS_velox_cache_frequency_admission ||
+      entry.accessStats_.numUses > 1) {
+    return true;
+  }
+  const auto keyHash = std::hash<RawFileCacheKey>()(
+      RawFileCacheKey{entry.key_.fileNum.id(), entry.key_.offset});
+  return frequency_.estimate(keyHash) >= kMinAdmissionCount;
+}
+
 void CacheShard::calibrateThreshold() {
   auto numSamples = std::min<int32_t>(10, entries_.size());
   auto now = accessTime();
@@ -514,6 +598,7 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numWaitExclusive += numWaitExclusive_;
   stats.numAgedOut += numAgedOut_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numEvictUnadmitted += numEvictUnadmitted_;
   stats.allocClocks += allocClocks_;
 }
 
@@ -540,6 +625,40 @@ void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
   }
 }
 
+void CacheShard::addResidency(
+    uint64_t fileNum,
+    uint64_t offset,
+    uint64_t length,
+    CacheResidency& residency) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& entry : entries_) {
+    if (!entry || entry->isExclusive() || !entry->key().fileNum.hasValue() ||
+        entry->key().fileNum.id() != fileNum) {
+      continue;
+    }
+    residency.ramBytes += CacheResidency::overlap(
+        offset, length, entry->offset(), entry->size());
+  }
+}
+
+void CacheShard::appendRegions(
+    AccessTime now,
+    std::vector<CacheRegion>& regions) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& entry : entries_) {
+    if (!entry || entry->isExclusive() || entry->isDerived() ||
+        !entry->key().fileNum.hasValue()) {
+      continue;
+    }
+    regions.push_back(CacheRegion{
+        entry->key().fileNum.id(),
+        entry->offset(),
+        static_cast<uint64_t>(entry->size()),
+        entry->accessStats_.numUses,
+        entry->score(now)});
+  }
+}
+
 bool CacheShard::removeFileEntries(
     const folly::F14FastSet<uint64_t>& filesToRemove,
     folly::F14FastSet<uint64_t>& filesRetained) {
@@ -875,6 +994,43 @@ CacheStats AsyncDataCache::refreshStats() const {
   return stats;
 }
 
+CacheResidency AsyncDataCache::residency(
+    std::string_view fileName,
+    uint64_t offset,
+    uint64_t length) const {
+  CacheResidency residency;
+  const auto fileNum = fileIds().id(fileName);
+  if (fileNum == StringIdMap::kNoId) {
+    return residency;
+  }
+  for (const auto& shard : shards_) {
+    shard->addResidency(fileNum, offset, length, residency);
+  }
+  if (ssdCache_ != nullptr) {
+    ssdCache_->file(fileNum).addResidency(fileNum, offset, length, residency);
+  }
+  return residency;
+}
+
+std::vector<CacheRegion> AsyncDataCache::hotRegions(size_t maxRegions) const {
+  std::vector<CacheRegion> regions;
+  const auto now = accessTime();
+  for (const auto& shard : shards_) {
+    shard->appendRegions(now, regions);
+  }
+  const auto hotter = [](const CacheRegion& left, const CacheRegion& right) {
+    return left.score != right.score ? left.score < right.score
+                                     : left.numUses > right.numUses;
+  };
+  if (regions.size() > maxRegions) {
+    std::nth_element(
+        regions.begin(), regions.begin() + maxRegions, regions.end(), hotter);
+    regions.resize(maxRegions);
+  }
+  std::sort(regions.begin(), regions.end(), hotter);
+  return regions;
+}
+
 void AsyncDataCache::clear() {
   for (auto& shard : shards_) {
     memory::Allocation unused;
@@ -22,18 +22,22 @@
 #include <folly/chrono/Hardware.h>
 #include <folly/container/F14Set.h>
 #include <folly/futures/SharedPromise.h>
+#include <gflags/gflags.h>
 #include "folly/GLog.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/MemoryAllocator.h"
 
+DECLARE_bool(velox_cache_frequency_admission);
+
 namespace facebook::velox::cache {
 
 #define VELOX_CACHE_LOG_PREFIX "[CACHE] "
@@ -191,7 +195,9 @@ class AsyncDataCacheEntry {
   }
 
   int32_t score(AccessTime now) const {
-    return accessStats_.score(now, size_);
+    return std::min<int64_t>(
+        static_cast<int64_t>(accessStats_.score(now, size_)) * evictionWeight_,
+        std::numeric_limits<int32_t>::max());
   }
 
   bool isShared() const {
@@ -254,6 +260,22 @@ class AsyncDataCacheEntry {
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
+  /// Marks 'this' as holding data derived from the file, e.g. decompressed
+  /// pages, instead of bytes of the file. Such entries are not saved to SSD.
+  /// Their score() is multiplied by 'evictionWeight', so that a weight over 1
+  /// evicts them before file data with the same accesses. Must be called
+  /// before setExclusiveToShared().
+  void setDerived(int32_t evictionWeight) {
+    VELOX_CHECK(isExclusive());
+    VELOX_CHECK_GE(evictionWeight, 1);
+    isDerived_ = true;
+    evictionWeight_ = evictionWeight;
+  }
+
+  bool isDerived() const {
+    return isDerived_;
+  }
+
   // Moves the promise out of 'this'. Used in order to handle the
   // promise within the lock of the cache shard, so not within private
   // methods of 'this'.
@@ -309,6 +331,12 @@ class AsyncDataCacheEntry {
   // Group id. Used for deciding if 'this' should be written to SSD.
   uint64_t groupId_{0};
 
+  // True if the data is not bytes of the file. See setDerived().
+  bool isDerived_{false};
+
+  // Multiplier of score().
+  int32_t evictionWeight_{1};
+
   // Tracking id. Used for deciding if this should be written to SSD.
   TrackingId trackingId_;
 
@@ -430,6 +458,13 @@ class CoalescedLoad {
   /// the other thread to be done.
   bool loadOrFuture(folly::SemiFuture<bool>* wait);
 
+  /// Starts a prefetch of 'load' with loadDataAsync() and returns without
+  /// waiting for the data if the load is asynchronous. Does nothing if the
+  /// load is not in planned state. Waiters of loadOrFuture() are resumed when
+  /// the data arrives. A failed load ends in cancelled state, after which the
+  /// readers read the data themselves.
+  static void loadAsync(const std::shared_ptr<CoalescedLoad>& load);
+
   State state() const {
     tsan_lock_guard<std::mutex> l(mutex_);
     return state_;
@@ -456,6 +491,22 @@ class CoalescedLoad {
   // users of the cache.
   virtual std::vector<CachePin> loadData(bool isPrefetch) = 0;
 
+  // Like loadData() but may complete asynchronously. The default calls
+  // loadData() inline.
+  virtual folly::SemiFuture<std::vector<CachePin>> loadDataAsync(
+      bool isPrefetch) {
+    try {
+      return folly::makeSemiFuture(loadData(isPrefetch));
+    } catch (const std::exception& e) {
+      return folly::makeSemiFuture<std::vector<CachePin>>(
+          folly::exception_wrapper(std::current_exception(), e));
+    }
+  }
+
+  // Sets the pins of a finished load to shared state and the load to loaded
+  // state.
+  void finishLoad(const std::vector<CachePin>& pins);
+
   // Sets a final state and resumes waiting threads.
   void setEndState(State endState);
 
@@ -471,6 +522,40 @@ class CoalescedLoad {
   std::vector<int32_t> sizes_;
 };
 
+/// Number of bytes of a file range that are cached in memory and on SSD. A
+/// byte is counted in both if it is cached in both.
+struct CacheResidency {
+  uint64_t ramBytes{0};
+  uint64_t ssdBytes{0};
+
+  /// Returns the number of bytes of [entryOffset, entryOffset + entrySize)
+  /// that fall in [offset, offset + length).
+  static uint64_t overlap(
+      uint64_t offset,
+      uint64_t length,
+      uint64_t entryOffset,
+      uint64_t entrySize) {
+    const uint64_t end =
+        length > std::numeric_limits<uint64_t>::max() - offset
+        ? std::numeric_limits<uint64_t>::max()
+        : offset + length;
+    const uint64_t begin = std::max(offset, entryOffset);
+    const uint64_t entryEnd = std::min(end, entryOffset + entrySize);
+    return entryEnd > begin ? entryEnd - begin : 0;
+  }
+};
+
+/// A cached region of file data with its access history. See
+/// AsyncDataCache::hotRegions().
+struct CacheRegion {
+  uint64_t fileNum;
+  uint64_t offset;
+  uint64_t size;
+  int32_t numUses;
+  /// Retention score at the time of the snapshot. Lower is hotter.
+  int32_t score;
+};
+
 // Struct for CacheShard stats. Stats from all shards are added into
 // this struct to provide a snapshot of state.
 struct CacheStats {
@@ -517,6 +602,9 @@ struct CacheStats {
   // Sum of scores of evicted entries. This serves to infer an average
   // lifetime for entries in cache.
   int64_t sumEvictScore{0};
+  // Number of entries evicted because they were not admitted for retention.
+  // See CacheShard::isAdmitted().
+  int64_t numEvictUnadmitted{0};
 
   // Total size of shared/exclusive pinned entries.
   int64_t sharedPinnedBytes{0};
@@ -578,6 +666,18 @@ class CacheShard {
   // Adds the stats of 'this' to 'stats'.
   void updateStats(CacheStats& stats);
 
+  // Adds the bytes of [offset, offset + length) of file 'fileNum' that are
+  // cached in 'this' to 'residency.ramBytes'.
+  void addResidency(
+      uint64_t fileNum,
+      uint64_t offset,
+      uint64_t length,
+      CacheResidency& residency) const;
+
+  // Appends the shared entries of file data in 'this' to 'regions'. 'now' is
+  // the accessTime() used for scoring.
+  void appendRegions(AccessTime now, std::vector<CacheRegion>& regions) const;
+
   // Appends a batch of non-saved SSD savable entries in 'this' to
   // 'pins'. This may have to be called several times since this keeps
   // limits on the batch to write at one time. The savable entries
@@ -600,9 +700,21 @@ class CacheShard {
  private:
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
+  // The min number of keys 'frequency_' is sized for.
+  static constexpr uint64_t kMinFrequencySketchKeys = 1 << 10;
+  // The min estimated number of recent lookups of the key of an entry for
+  // admitting the entry.
+  static constexpr int32_t kMinAdmissionCount = 2;
 
   void calibrateThreshold();
 
+  // Returns false if 'entry' has at most been read once since it was loaded
+  // and its key is not looked up often enough to retain it. Such entries are
+  // evicted before the others regardless of their score. This keeps one-time
+  // scans from pushing out reused data, as with TinyLFU admission. Always
+  // returns true unless FLAGS_velox_cache_frequency_admission is set.
+  bool isAdmitted(const AsyncDataCacheEntry& entry) const;
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
   // Returns an unused entry if found.
@@ -653,6 +765,11 @@ class CacheShard {
   // Sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{0};
+  // Count of entries evicted because isAdmitted() returned false.
+  uint64_t numEvictUnadmitted_{0};
+  // Approximate counts of the recent lookups of the keys in this shard. These
+  // outlive the evicted entries. Used by isAdmitted().
+  FrequencySketch frequency_{kMinFrequencySketchKeys};
   // Tracker of time spent in allocating/freeing MemoryAllocator space
   // for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
@@ -718,6 +835,23 @@ class AsyncDataCache : public memory::Cache {
   /// SSD cache if used.
   CacheStats refreshStats() const;
 
+  /// Returns how many bytes of [offset, offset + length) of 'fileName' are
+  /// cached in memory and in the SSD cache if used. The file is identified by
+  /// the same name as in the cache keys, e.g. the file path for Hive. Entries
+  /// that are being loaded are not counted. This scans the entries of all
+  /// shards and is meant for scheduling decisions, e.g. assigning splits to
+  /// the workers that have their data cached, not for the read path.
+  CacheResidency residency(
+      std::string_view fileName,
+      uint64_t offset,
+      uint64_t length) const;
+
+  /// Returns up to 'maxRegions' regions of file data cached in memory, hottest
+  /// first by retention score. Entries that are being loaded and entries of
+  /// derived data are skipped. This scans all shards and is meant for
+  /// recording the access history for cache warmup, e.g. by CacheWarmer.
+  std::vector<CacheRegion> hotRegions(size_t maxRegions) const;
+
   /// If 'details' is true, returns the stats of the backing memory allocator
   /// and ssd cache. Otherwise, only returns the cache stats.
   std::string toString(bool details = true) const;
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheWarmer.h"
+
+#include <fstream>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/caching/CacheTTLController.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/SsdCache.h"
+
+namespace facebook::velox::cache {
+
+CacheWarmer::CacheWarmer(
+    AsyncDataCache* cache,
+    folly::Executor* executor,
+    FileOpener fileOpener,
+    IdleCheck isIdle,
+    Options options)
+    : cache_(cache),
+      executor_(executor),
+      fileOpener_(std::move(fileOpener)),
+      isIdle_(std::move(isIdle)),
+      options_(std::move(options)) {
+  VELOX_CHECK_NOT_NULL(cache_);
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_NOT_NULL(fileOpener_);
+  VELOX_CHECK_NOT_NULL(isIdle_);
+  VELOX_CHECK_GT(options_.batchBytes, 0);
+}
+
+// static
+void CacheWarmer::writeAccessLog(
+    const AsyncDataCache& cache,
+    const std::string& path,
+    size_t maxRegions) {
+  const auto regions = cache.hotRegions(maxRegions);
+  std::ofstream log;
+  log.exceptions(std::ofstream::failbit);
+  log.open(path, std::ios_base::out | std::ios_base::trunc);
+  // One region per line. The file name goes last since it may contain spaces.
+  for (const auto& region : regions) {
+    log << region.offset << ' ' << region.size << ' '
+        << fileIds().string(region.fileNum) << '\n';
+  }
+  log.close();
+}
+
+// static
+std::vector<WarmupRegion> CacheWarmer::readAccessLog(const std::string& path) {
+  std::vector<WarmupRegion> regions;
+  std::ifstream log(path);
+  if (!log.is_open()) {
+    VELOX_CACHE_LOG(INFO) << "No cache access log at " << path;
+    return regions;
+  }
+  std::string line;
+  while (std::getline(log, line)) {
+    std::istringstream fields(line);
+    WarmupRegion region;
+    fields >> region.offset >> region.size;
+    VELOX_CHECK(
+        !fields.fail() && fields.get() == ' ',
+        "Malformed cache access log line: {}",
+        line);
+    std::getline(fields, region.fileName);
+    VELOX_CHECK(
+        !region.fileName.empty(), "Malformed cache access log line: {}", line);
+    regions.push_back(std::move(region));
+  }
+  return regions;
+}
+
+folly::SemiFuture<CacheWarmer::Stats> CacheWarmer::start(
+    std::vector<WarmupRegion> regions) {
+  VELOX_CHECK(!started_.exchange(true), "CacheWarmer can be started once");
+  regions_ = std::move(regions);
+  auto future = promise_.getSemiFuture();
+  executor_->add([self = shared_from_this()]() { self->run(); });
+  return future;
+}
+
+void CacheWarmer::run() {
+  while (!cancelled_ && nextRegion_ < regions_.size()) {
+    const auto loadedBytes = stats().loadedBytes;
+    if (loadedBytes >= options_.maxBytes) {
+      break;
+    }
+    if (!isIdle_()) {
+      {
+        std::lock_guard<std::mutex> l(mutex_);
+        ++stats_.numIdleWaits;
+      }
+      folly::futures::sleep(options_.idleRetryInterval)
+          .via(executor_)
+          .thenValue([self = shared_from_this()](auto&& /*unused*/) {
+            self->run();
+          });
+      return;
+    }
+
+    // Takes regions up to the batch size and the remaining budget.
+    const auto budget =
+        std::min(options_.batchBytes, options_.maxBytes - loadedBytes);
+    const auto begin = nextRegion_;
+    uint64_t batchBytes = 0;
+    while (nextRegion_ < regions_.size() && batchBytes < budget) {
+      batchBytes += regions_[nextRegion_++].size;
+    }
+    try {
+      if (!loadBatch(begin, nextRegion_)) {
+        VELOX_CACHE_LOG(INFO) << "Stopping cache warmup, no cache space";
+        break;
+      }
+    } catch (const std::exception& e) {
+      VELOX_CACHE_LOG(WARNING) << "Stopping cache warmup: " << e.what();
+      break;
+    }
+  }
+  finish();
+}
+
+bool CacheWarmer::loadBatch(size_t begin, size_t end) {
+  // Groups the regions by file, keeping the files in the order of their
+  // first region.
+  std::vector<std::string> fileNames;
+  folly::F14FastMap<std::string, std::vector<size_t>> fileRegions;
+  for (auto i = begin; i < end; ++i) {
+    auto& indices = fileRegions[regions_[i].fileName];
+    if (indices.empty()) {
+      fileNames.push_back(regions_[i].fileName);
+    }
+    indices.push_back(i);
+  }
+  for (const auto& fileName : fileNames) {
+    try {
+      loadFile(fileName, fileRegions[fileName]);
+    } catch (const VeloxRuntimeError& e) {
+      if (e.errorCode() == error_code::kNoCacheSpace) {
+        return false;
+      }
+      throw;
+    }
+  }
+  return true;
+}
+
+void CacheWarmer::loadFile(
+    const std::string& fileName,
+    const std::vector<size_t>& indices) {
+  // Reads in ascending offset order for IO coalescing.
+  auto sortedIndices = indices;
+  std::sort(
+      sortedIndices.begin(),
+      sortedIndices.end(),
+      [&](size_t left, size_t right) {
+        return regions_[left].offset < regions_[right].offset;
+      });
+  StringIdLease fileNum(fileIds(), fileName);
+  std::vector<RawFileCacheKey> keys;
+  keys.reserve(sortedIndices.size());
+  for (auto index : sortedIndices) {
+    keys.push_back(RawFileCacheKey{fileNum.id(), regions_[index].offset});
+  }
+
+  auto* ssdFile = cache_->ssdCache() != nullptr
+      ? &cache_->ssdCache()->file(fileNum.id())
+      : nullptr;
+  std::vector<CachePin> storagePins;
+  std::vector<CachePin> ssdLoadPins;
+  std::vector<SsdPin> ssdPins;
+  cache_->makePins(
+      keys,
+      [&](int32_t i) { return regions_[sortedIndices[i]].size; },
+      [&](int32_t i, CachePin pin) {
+        pin.checkedEntry()->setPrefetch(true);
+        if (ssdFile != nullptr) {
+          auto ssdPin = ssdFile->find(keys[i]);
+          if (!ssdPin.empty()) {
+            ssdPins.push_back(std::move(ssdPin));
+            ssdLoadPins.push_back(std::move(pin));
+            return;
+          }
+        }
+        storagePins.push_back(std::move(pin));
+      });
+
+  // Loads 'pins' with 'load' and makes them shared. Returns the number of
+  // bytes loaded. On error the pins are released, which removes their
+  // entries.
+  const auto loadPins = [&](std::vector<CachePin>& pins, auto load) {
+    uint64_t bytes = 0;
+    try {
+      load(pins);
+      for (auto& pin : pins) {
+        bytes += pin.checkedEntry()->size();
+        pin.checkedEntry()->setExclusiveToShared();
+      }
+    } catch (const std::exception& e) {
+      VELOX_CACHE_LOG(WARNING) << "Failed to warm up " << pins.size()
+                               << " regions of " << fileName << ": "
+                               << e.what();
+      std::lock_guard<std::mutex> l(mutex_);
+      stats_.numFailed += pins.size();
+      return;
+    }
+    std::lock_guard<std::mutex> l(mutex_);
+    stats_.numLoaded += pins.size();
+    stats_.loadedBytes += bytes;
+  };
+
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    stats_.numCached += keys.size() - storagePins.size() - ssdLoadPins.size();
+  }
+  if (!ssdLoadPins.empty()) {
+    loadPins(ssdLoadPins, [&](const std::vector<CachePin>& pins) {
+      ssdFile->load(ssdPins, pins);
+    });
+  }
+  if (!storagePins.empty()) {
+    loadPins(storagePins, [&](const std::vector<CachePin>& pins) {
+      auto file = fileOpener_(fileName);
+      VELOX_CHECK_NOT_NULL(file, "Cannot open {}", fileName);
+      readPins(
+          pins,
+          options_.maxCoalesceGap,
+          1000,
+          [&](int32_t i) { return pins[i].checkedEntry()->offset(); },
+          [&](const std::vector<CachePin>& /*pins*/,
+              int32_t /*begin*/,
+              int32_t /*end*/,
+              uint64_t offset,
+              const std::vector<folly::Range<char*>>& buffers) {
+            file->preadv(offset, buffers);
+          });
+    });
+  }
+
+  // Makes the warmed data subject to the cache TTL like data loaded by
+  // queries.
+  if (auto* ttlController = CacheTTLController::getInstance()) {
+    ttlController->addOpenFileInfo(fileNum.id());
+  }
+}
+
+void CacheWarmer::finish() {
+  const auto finalStats = stats();
+  VELOX_CACHE_LOG(INFO) << "Cache warmup finished: loaded "
+                        << finalStats.numLoaded << " regions, "
+                        << finalStats.loadedBytes << " bytes, "
+                        << finalStats.numCached << " already cached, "
+                        << finalStats.numFailed << " failed";
+  promise_.setValue(finalStats);
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/futures/Future.h>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/file/File.h"
+
+namespace facebook::velox::cache {
+
+/// A region of a file to load into the cache by CacheWarmer.
+struct WarmupRegion {
+  std::string fileName;
+  uint64_t offset;
+  uint64_t size;
+
+  bool operator==(const WarmupRegion& other) const {
+    return fileName == other.fileName && offset == other.offset &&
+        size == other.size;
+  }
+};
+
+/// Loads file regions that were recently hot into AsyncDataCache, e.g. after
+/// a restart or when new files of a hot table land. The regions typically
+/// come from an access log written by writeAccessLog() from the cache entries
+/// before the restart. Regions are loaded in the given order, from SSD cache
+/// if they are there and from storage otherwise, up to 'maxBytes' in total.
+/// Loading runs in batches on 'executor' and pauses while 'isIdle' returns
+/// false, so that warmup does not compete with queries for IO. Loaded entries
+/// go through the normal SSD admission and so also warm up the SSD cache.
+class CacheWarmer : public std::enable_shared_from_this<CacheWarmer> {
+ public:
+  struct Options {
+    /// Maximum number of bytes to load in one warmup.
+    uint64_t maxBytes{1UL << 30};
+
+    /// Number of bytes to load between idle checks.
+    uint64_t batchBytes{64UL << 20};
+
+    /// Largest gap between regions of a file that are read in one IO.
+    int32_t maxCoalesceGap{512 << 10};
+
+    /// Time to wait before checking again when not idle.
+    std::chrono::milliseconds idleRetryInterval{1'000};
+  };
+
+  struct Stats {
+    /// Number of regions that were loaded.
+    uint64_t numLoaded{0};
+    /// Number of regions that were already cached or being loaded.
+    uint64_t numCached{0};
+    /// Number of regions that failed to load.
+    uint64_t numFailed{0};
+    /// Bytes loaded into the cache.
+    uint64_t loadedBytes{0};
+    /// Number of times loading was paused because the process was not idle.
+    uint64_t numIdleWaits{0};
+  };
+
+  /// Opens 'fileName' for reading regions to warm up.
+  using FileOpener =
+      std::function<std::shared_ptr<ReadFile>(const std::string& fileName)>;
+
+  /// Returns true if warmup may use IO now.
+  using IdleCheck = std::function<bool()>;
+
+  static std::shared_ptr<CacheWarmer> create(
+      AsyncDataCache* cache,
+      folly::Executor* executor,
+      FileOpener fileOpener,
+      IdleCheck isIdle,
+      Options options = {}) {
+    return std::shared_ptr<CacheWarmer>(new CacheWarmer(
+        cache,
+        executor,
+        std::move(fileOpener),
+        std::move(isIdle),
+        std::move(options)));
+  }
+
+  /// Writes the 'maxRegions' hottest regions cached in memory by 'cache' to
+  /// the local file 'path', hottest first.
+  static void writeAccessLog(
+      const AsyncDataCache& cache,
+      const std::string& path,
+      size_t maxRegions);
+
+  /// Returns the regions in the access log at 'path' in the order they were
+  /// written.
+  static std::vector<WarmupRegion> readAccessLog(const std::string& path);
+
+  /// Starts loading 'regions' in order. The returned future is realized with
+  /// the stats when all regions are processed, the byte budget is used up,
+  /// the cache runs out of space or cancel() is called. May be called once.
+  folly::SemiFuture<Stats> start(std::vector<WarmupRegion> regions);
+
+  /// Stops loading after the current batch.
+  void cancel() {
+    cancelled_ = true;
+  }
+
+  Stats stats() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return stats_;
+  }
+
+ private:
+  CacheWarmer(
+      AsyncDataCache* cache,
+      folly::Executor* executor,
+      FileOpener fileOpener,
+      IdleCheck isIdle,
+      Options options);
+
+  // Loads batches of regions while idle. Schedules itself to run again after
+  // 'idleRetryInterval' if not idle.
+  void run();
+
+  // Loads the regions in [begin, end) of 'regions_'. Returns false if the
+  // cache has no space for more entries.
+  bool loadBatch(size_t begin, size_t end);
+
+  // Loads the regions of 'fileName' at 'indices' in 'regions_'.
+  void loadFile(
+      const std::string& fileName,
+      const std::vector<size_t>& indices);
+
+  void finish();
+
+  AsyncDataCache* const cache_;
+  folly::Executor* const executor_;
+  const FileOpener fileOpener_;
+  const IdleCheck isIdle_;
+  const Options options_;
+
+  std::vector<WarmupRegion> regions_;
+  // Index of the next region in 'regions_' to load.
+  size_t nextRegion_{0};
+  std::atomic_bool started_{false};
+  std::atomic_bool cancelled_{false};
+  folly::Promise<Stats> promise_;
+
+  mutable std::mutex mutex_;
+  Stats stats_;
+};
+
+} // namespace facebook::velox::cache
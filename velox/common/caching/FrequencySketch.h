@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+
+/// Approximate access counts of recently used keys for TinyLFU style cache
+/// admission. This is a count-min sketch of 4-bit counters with 4 counters per
+/// key hash. All the counters are halved after every 10 increments per word of
+/// the table so that the counts reflect the recent history. The memory use is
+/// 8 bytes per expected key. Not thread safe.
+class FrequencySketch {
+ public:
+  /// The largest count a key can have.
+  static constexpr int32_t kMaxCount = 15;
+
+  /// Constructs a sketch for counting about 'numKeys' distinct keys.
+  explicit FrequencySketch(uint64_t numKeys) {
+    resize(numKeys);
+  }
+
+  /// Clears the counts and resizes the sketch to count about 'numKeys'
+  /// distinct keys.
+  void resize(uint64_t numKeys) {
+    table_.assign(bits::nextPowerOfTwo(std::max<uint64_t>(numKeys, 16)), 0);
+    tableMask_ = table_.size() - 1;
+    sampleSize_ = 10 * table_.size();
+    numIncrements_ = 0;
+  }
+
+  /// Returns the number of distinct keys the sketch counts without loss of
+  /// accuracy.
+  uint64_t capacity() const {
+    return table_.size();
+  }
+
+  /// Counts an access to the key with 'hash'.
+  void increment(uint64_t hash) {
+    const int32_t start = (hash & 3) << 2;
+    bool added = false;
+    for (int32_t i = 0; i < 4; ++i) {
+      added |= incrementAt(indexOf(hash, i), start + i);
+    }
+    if (added && ++numIncrements_ >= sampleSize_) {
+      reset();
+    }
+  }
+
+  /// Returns the estimated number of recent accesses to the key with 'hash'.
+  int32_t estimate(uint64_t hash) const {
+    const int32_t start = (hash & 3) << 2;
+    int32_t count = kMaxCount;
+    for (int32_t i = 0; i < 4; ++i) {
+      const auto word = table_[indexOf(hash, i)];
+      count = std::min<int32_t>(count, (word >> ((start + i) << 2)) & 0xf);
+    }
+    return count;
+  }
+
+ private:
+  static constexpr uint64_t kSeeds[] = {
+      0xc3a5c85c97cb3127ULL,
+      0xb492b66fbe98f273ULL,
+      0x9ae16a3b2f90404fULL,
+      0xcbf29ce484222325ULL};
+  // The lowest bit of each counter in a word of 16 counters.
+  static constexpr uint64_t kOneMask = 0x1111111111111111ULL;
+  // Clears the highest bit of each counter after shifting a word by one.
+  static constexpr uint64_t kResetMask = 0x7777777777777777ULL;
+
+  // Returns the index of the word of the 'i'th counter for 'hash'.
+  uint64_t indexOf(uint64_t hash, int32_t i) const {
+    uint64_t index = (hash + kSeeds[i]) * kSeeds[i];
+    index += index >> 32;
+    return index & tableMask_;
+  }
+
+  // Increments the 'counter'th counter of the word at 'index' unless it is at
+  // kMaxCount. Returns true if incremented.
+  bool incrementAt(uint64_t index, int32_t counter) {
+    const int32_t offset = counter << 2;
+    const uint64_t mask = 0xfULL << offset;
+    if ((table_[index] & mask) == mask) {
+      return false;
+    }
+    table_[index] += 1ULL << offset;
+    return true;
+  }
+
+  // Halves all the counters.
+  void reset() {
+    uint64_t numOdd = 0;
+    for (auto& word : table_) {
+      numOdd += __builtin_popcountll(word & kOneMask);
+      word = (word >> 1) & kResetMask;
+    }
+    numIncrements_ = (numIncrements_ - (numOdd >> 2)) >> 1;
+  }
+
+  std::vector<uint64_t> table_;
+  uint64_t tableMask_;
+  // The number of increments after which the counters are halved.
+  uint64_t sampleSize_;
+  // The number of increments since the last halving, adjusted for the
+  // increments lost to halving.
+  uint64_t numIncrements_;
+};
+
+} // namespace facebook::velox::cache
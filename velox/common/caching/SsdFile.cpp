@@ -63,9 +63,23 @@ void disableCow(int32_t fd) {
 #endif // linux
 }
 
+// Appends the range at 'data' of 'size' bytes to 'iovecs'. Extends the last
+// iovec if the range is adjacent to it in memory, e.g. for consecutive runs of
+// an allocation, so that a write covers more bytes with fewer iovecs.
+void addRangeToIovecs(char* data, size_t size, std::vector<iovec>& iovecs) {
+  if (!iovecs.empty() &&
+      static_cast<char*>(iovecs.back().iov_base) + iovecs.back().iov_len ==
+          data) {
+    iovecs.back().iov_len += size;
+    return;
+  }
+  iovecs.push_back({data, size});
+}
+
 void addEntryToIovecs(AsyncDataCacheEntry& entry, std::vector<iovec>& iovecs) {
   if (entry.tinyData() != nullptr) {
-    iovecs.push_back({entry.tinyData(), static_cast<size_t>(entry.size())});
+    addRangeToIovecs(
+        entry.tinyData(), static_cast<size_t>(entry.size()), iovecs);
     return;
   }
   const auto& data = entry.data();
@@ -73,8 +87,10 @@ void addEntryToIovecs(AsyncDataCacheEntry& entry, std::vector<iovec>& iovecs) {
   int64_t bytesLeft = entry.size();
   for (auto i = 0; i < data.numRuns(); ++i) {
     auto run = data.runAt(i);
-    iovecs.push_back(
-        {run.data<char>(), std::min<size_t>(bytesLeft, run.numBytes())});
+    addRangeToIovecs(
+        run.data<char>(),
+        std::min<size_t>(bytesLeft, run.numBytes()),
+        iovecs);
     bytesLeft -= run.numBytes();
     if (bytesLeft <= 0) {
       break;
@@ -437,6 +453,9 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         const auto size = entry->size();
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
+        if (checkpointIntervalBytes_ > 0) {
+          pendingLogEntries_.emplace_back(key, SsdRun(offset, size));
+        }
         entries_[std::move(key)] = SsdRun(offset, size);
         if (FLAGS_ssd_verify_write) {
           verifyWrite(*entry, SsdRun(offset, size));
@@ -544,11 +563,26 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
 }
 
+void SsdFile::addResidency(
+    uint64_t fileNum,
+    uint64_t offset,
+    uint64_t length,
+    CacheResidency& residency) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  for (const auto& [key, run] : entries_) {
+    if (key.fileNum.id() == fileNum) {
+      residency.ssdBytes +=
+          CacheResidency::overlap(offset, length, key.offset, run.size());
+    }
+  }
+}
+
 void SsdFile::clear() {
   std::lock_guard<std::shared_mutex> l(mutex_);
   entries_.clear();
   std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
   std::fill(erasedRegionSizes_.begin(), erasedRegionSizes_.end(), 0);
+  pendingLogEntries_.clear();
   writableRegions_.resize(numRegions_);
   std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
 }
@@ -656,12 +690,29 @@ void SsdFile::deleteCheckpoint(bool keepLog) {
       evictLogFd_ = -1;
     }
   }
+  if (writeLogFd_ >= 0) {
+    if (keepLog) {
+      ::ftruncate(writeLogFd_, 0);
+      ::fsync(writeLogFd_);
+    } else {
+      ::close(writeLogFd_);
+      writeLogFd_ = -1;
+    }
+  }
+  hasCheckpoint_ = false;
+  writeLogBytes_ = 0;
+  pendingLogEntries_.clear();
+  writeLogFileNums_.clear();
 
   checkpointDeleted_ = true;
   const auto logPath = fileName_ + kLogExtension;
   int32_t logRc = 0;
   if (!keepLog) {
     logRc = ::unlink(logPath.c_str());
+    const auto writeLogPath = fileName_ + kWriteLogExtension;
+    if (::unlink(writeLogPath.c_str()) != 0 && errno != ENOENT) {
+      logRc = -1;
+    }
   }
   const auto checkpointPath = fileName_ + kCheckpointExtension;
   const auto checkpointRc = ::unlink(checkpointPath.c_str());
@@ -700,6 +751,21 @@ void SsdFile::checkpoint(bool force) {
     return;
   }
 
+  if (!force && hasCheckpoint_ &&
+      (writeLogBytes_ + pendingLogEntries_.size() * kCheckpointEntryBytes <
+       entries_.size() * kCheckpointEntryBytes)) {
+    bytesAfterCheckpoint_ = 0;
+    try {
+      logWritesLocked();
+    } catch (const std::exception& e) {
+      try {
+        checkpointError(-1, e.what());
+      } catch (const std::exception&) {
+      }
+    }
+    return;
+  }
+
   VELOX_SSD_CACHE_LOG(INFO)
       << "Checkpointing shard " << shardId_ << ", force: " << force
       << " bytesAfterCheckpoint: " << succinctBytes(bytesAfterCheckpoint_)
@@ -795,6 +861,13 @@ void SsdFile::checkpoint(bool force) {
     // log evictions. The latter might lead to data consistent issue.
     checkRc(::ftruncate(evictLogFd_, 0), "Truncate of event log");
     checkRc(::fsync(evictLogFd_), "Sync of evict log");
+    // The write log entries are all in the new checkpoint.
+    checkRc(::ftruncate(writeLogFd_, 0), "Truncate of write log");
+    checkRc(::fsync(writeLogFd_), "Sync of write log");
+    writeLogBytes_ = 0;
+    pendingLogEntries_.clear();
+    writeLogFileNums_.clear();
+    hasCheckpoint_ = true;
   } catch (const std::exception& e) {
     try {
       checkpointError(-1, e.what());
@@ -827,11 +900,27 @@ void SsdFile::initializeCheckpoint() {
         evictLogFd_,
         folly::errnoStr(errno));
   }
+  const auto writeLogPath = fileName_ + kWriteLogExtension;
+  writeLogFd_ =
+      ::open(writeLogPath.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+  if (writeLogFd_ < 0) {
+    ++stats_.openLogErrors;
+    VELOX_FAIL(
+        "Could not open write log {}, rc {}: {}",
+        writeLogPath,
+        writeLogFd_,
+        folly::errnoStr(errno));
+  }
+  if (!hasCheckpoint) {
+    // A write log without the checkpoint it applies to is not usable.
+    ::ftruncate(writeLogFd_, 0);
+  }
 
   try {
     if (hasCheckpoint) {
       state.exceptions(std::ifstream::failbit);
       readCheckpoint(state);
+      hasCheckpoint_ = true;
     }
   } catch (const std::exception& e) {
     ++stats_.readCheckpointErrors;
@@ -920,6 +1009,7 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       entries_[std::move(key)] = run;
     }
   }
+  readWriteLog(evictedMap);
   // The state is successfully read. Install the access frequency scores and
   // evicted regions.
   VELOX_CHECK_EQ(scores.size(), tracker_.regionScores().size());
@@ -937,4 +1027,115 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       writableRegions_.size());
 }
 
+void SsdFile::logWritesLocked() {
+  if (pendingLogEntries_.empty()) {
+    return;
+  }
+  // The logged entries must not be recovered before their data is durable.
+  if (::fsync(fd_) < 0) {
+    VELOX_FAIL("Sync of cache data file failed: {}", folly::errnoStr(errno));
+  }
+  // The write log is a sequence of records of:
+  // {kWriteLogFileMarker, fileId, int32_t length, fileName} or
+  // {fileId, offset, SsdRun}.
+  std::string buffer;
+  buffer.reserve(pendingLogEntries_.size() * kCheckpointEntryBytes);
+  const auto append = [&](const auto& value) {
+    buffer.append(asChar(&value), sizeof(value));
+  };
+  for (const auto& [key, run] : pendingLogEntries_) {
+    const uint64_t fileNum = key.fileNum.id();
+    if (writeLogFileNums_.insert(fileNum).second) {
+      const auto name = fileIds().string(fileNum);
+      append(kWriteLogFileMarker);
+      append(fileNum);
+      append(static_cast<int32_t>(name.size()));
+      buffer.append(name);
+    }
+    append(fileNum);
+    append(key.offset);
+    append(run.bits());
+  }
+  const auto rc =
+      ::pwrite(writeLogFd_, buffer.data(), buffer.size(), writeLogBytes_);
+  if (rc != buffer.size()) {
+    ++stats_.writeCheckpointErrors;
+    VELOX_FAIL("Write of write log with rc {}: {}", rc, folly::errnoStr(errno));
+  }
+  if (::fsync(writeLogFd_) < 0) {
+    VELOX_FAIL("Sync of write log failed: {}", folly::errnoStr(errno));
+  }
+  writeLogBytes_ += buffer.size();
+  pendingLogEntries_.clear();
+}
+
+void SsdFile::readWriteLog(const std::unordered_set<uint32_t>& evictedRegions) {
+  const auto logSize = ::lseek(writeLogFd_, 0, SEEK_END);
+  std::string log(logSize, 0);
+  const auto rc = ::pread(writeLogFd_, log.data(), logSize, 0);
+  VELOX_CHECK_EQ(logSize, rc, "Failed to read write log");
+
+  // Reads 'value' at 'position' and advances 'position'. Returns false if the
+  // log ends before.
+  uint64_t position = 0;
+  const auto read = [&](auto& value) {
+    if (position + sizeof(value) > log.size()) {
+      return false;
+    }
+    memcpy(&value, log.data() + position, sizeof(value));
+    position += sizeof(value);
+    return true;
+  };
+  std::unordered_map<uint64_t, StringIdLease> idMap;
+  uint64_t validBytes = 0;
+  int32_t numEntries = 0;
+  for (;;) {
+    uint64_t fileNum;
+    if (!read(fileNum)) {
+      break;
+    }
+    if (fileNum == kWriteLogFileMarker) {
+      int32_t length;
+      if (!read(fileNum) || !read(length) || length < 0 ||
+          position + length > log.size()) {
+        break;
+      }
+      idMap[fileNum] = StringIdLease(
+          fileIds(), std::string_view(log.data() + position, length));
+      position += length;
+      validBytes = position;
+      continue;
+    }
+    uint64_t offset;
+    uint64_t bits;
+    if (!read(offset) || !read(bits)) {
+      break;
+    }
+    validBytes = position;
+    const auto run = SsdRun(bits);
+    const auto region = regionIndex(run.offset());
+    // A region evicted after the checkpoint may have been rewritten with
+    // entries that are not logged, so none of its entries are trusted.
+    if (evictedRegions.count(region) != 0 ||
+        run.offset() + run.size() > fileSize_) {
+      continue;
+    }
+    auto it = idMap.find(fileNum);
+    VELOX_CHECK(it != idMap.end());
+    entries_[FileCacheKey{it->second, offset}] = run;
+    numRegions_ = std::max<int32_t>(numRegions_, region + 1);
+    ++numEntries;
+  }
+  if (validBytes < logSize) {
+    VELOX_SSD_CACHE_LOG(WARNING)
+        << "Truncating write log of shard " << shardId_ << " from " << logSize
+        << " to " << validBytes << " bytes";
+    ::ftruncate(writeLogFd_, validBytes);
+  }
+  writeLogBytes_ = validBytes;
+  VELOX_SSD_CACHE_LOG(INFO) << "Recovered " << numEntries
+                            << " entries from the write log of shard "
+                            << shardId_;
+}
+
 } // namespace facebook::velox::cache
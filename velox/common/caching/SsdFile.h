@@ -21,6 +21,7 @@
 #include "velox/common/file/File.h"
 
 #include <gflags/gflags.h>
+#include <unordered_set>
 
 DECLARE_bool(ssd_odirect);
 DECLARE_bool(ssd_verify_write);
@@ -245,6 +246,14 @@ class SsdFile {
   // Adds 'stats_' to 'stats'.
   void updateStats(SsdCacheStats& stats) const;
 
+  /// Adds the bytes of [offset, offset + length) of file 'fileNum' that are
+  /// cached in 'this' to 'residency.ssdBytes'.
+  void addResidency(
+      uint64_t fileNum,
+      uint64_t offset,
+      uint64_t length,
+      CacheResidency& residency) const;
+
   // Resets this' to a post-construction empty state. See SsdCache::clear().
   void clear();
 
@@ -262,7 +271,11 @@ class SsdFile {
   // Writes a checkpoint state that can be recovered from. The
   // checkpoint is serialized on 'mutex_'. If 'force' is false,
   // rechecks that at least 'checkpointIntervalBytes_' have been
-  // written since last checkpoint and silently returns if not.
+  // written since last checkpoint and silently returns if not. If
+  // 'force' is false and there is a full checkpoint, only appends the
+  // entries written since the last checkpoint to the write log. The
+  // full checkpoint is rewritten and the write log truncated when the
+  // write log grows to the size of a full checkpoint.
   void checkpoint(bool force = false);
 
   /// Returns true if copy on write is disabled for this file. Used in testing.
@@ -277,6 +290,10 @@ class SsdFile {
   static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
   // Magic number at end of completed checkpoint file.
   static constexpr int64_t kCheckpointEndMarker = 0xcbedf11e;
+  // Magic number starting a {fileId, fileName} record in the write log.
+  static constexpr uint64_t kWriteLogFileMarker = 0xfffffffffffffffd;
+  // Size of a {fileId, offset, SsdRun} triple in a checkpoint or write log.
+  static constexpr uint64_t kCheckpointEntryBytes = 3 * sizeof(uint64_t);
 
   static constexpr int kMaxErasedSizePct = 50;
 
@@ -317,6 +334,16 @@ class SsdFile {
   // deletes the checkpoint and leaves the log truncated open.
   void readCheckpoint(std::ifstream& state);
 
+  // Replays the entries appended to the write log after the last full
+  // checkpoint into 'entries_'. Skips the entries in 'evictedRegions'. Stops
+  // at the first incomplete record and truncates the log after the last
+  // complete one.
+  void readWriteLog(const std::unordered_set<uint32_t>& evictedRegions);
+
+  // Appends 'pendingLogEntries_' to the write log after syncing the cache
+  // file. Caller must hold 'mutex_'.
+  void logWritesLocked();
+
   // Logs an error message, deletes the checkpoint and stop making new
   // checkpoints.
   void checkpointError(int32_t rc, const std::string& error);
@@ -339,6 +366,7 @@ class SsdFile {
 
   static constexpr const char* kLogExtension = ".log";
   static constexpr const char* kCheckpointExtension = ".cpt";
+  static constexpr const char* kWriteLogExtension = ".wlog";
 
   // Name of cache file, used as prefix for checkpoint files.
   const std::string fileName_;
@@ -407,6 +435,23 @@ class SsdFile {
 
   // True if there was an error with checkpoint and the checkpoint was deleted.
   bool checkpointDeleted_{false};
+
+  // True if there is a complete full checkpoint that the write log applies
+  // to.
+  bool hasCheckpoint_{false};
+
+  // fd for logging the entries written after the last full checkpoint.
+  int32_t writeLogFd_{-1};
+
+  // Size of the write log in bytes.
+  uint64_t writeLogBytes_{0};
+
+  // Entries written after the last checkpoint, appended to the write log at
+  // the next incremental checkpoint.
+  std::vector<std::pair<FileCacheKey, SsdRun>> pendingLogEntries_;
+
+  // Ids of the files whose names are in the write log.
+  folly::F14FastSet<uint64_t> writeLogFileNums_;
 };
 
 } // namespace facebook::velox::cache
@@ -16,10 +16,13 @@
 
 #include "velox/common/caching/StringIdMap.h"
 
+#include <mutex>
+#include <shared_mutex>
+
 namespace facebook::velox {
 
 uint64_t StringIdMap::id(std::string_view string) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::shared_lock<folly::SharedMutex> l(mutex_);
   auto it = stringToId_.find(string);
   if (it != stringToId_.end()) {
     return it->second;
@@ -27,8 +30,35 @@ uint64_t StringIdMap::id(std::string_view string) {
   return kNoId;
 }
 
+// static
+bool StringIdMap::tryAddReference(Entry& entry) {
+  auto numInUse = entry.numInUse.load();
+  while (numInUse > 0) {
+    if (entry.numInUse.compare_exchange_weak(numInUse, numInUse + 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void StringIdMap::release(uint64_t id) {
-  std::lock_guard<std::mutex> l(mutex_);
+  {
+    std::shared_lock<folly::SharedMutex> l(mutex_);
+    auto it = idToString_.find(id);
+    if (it == idToString_.end()) {
+      return;
+    }
+    // Drops a use that is not the last one without the exclusive lock.
+    auto& numInUse = it->second.numInUse;
+    auto count = numInUse.load();
+    while (count > 1) {
+      if (numInUse.compare_exchange_weak(count, count - 1)) {
+        return;
+      }
+    }
+  }
+
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   auto it = idToString_.find(id);
   if (it != idToString_.end()) {
     VELOX_CHECK_LT(
@@ -44,7 +74,7 @@ void StringIdMap::release(uint64_t id) {
 }
 
 void StringIdMap::addReference(uint64_t id) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::shared_lock<folly::SharedMutex> l(mutex_);
   auto it = idToString_.find(id);
   VELOX_CHECK(
       it != idToString_.end(),
@@ -55,33 +85,43 @@ void StringIdMap::addReference(uint64_t id) {
 }
 
 uint64_t StringIdMap::makeId(std::string_view string) {
-  std::lock_guard<std::mutex> l(mutex_);
+  {
+    std::shared_lock<folly::SharedMutex> l(mutex_);
+    auto it = stringToId_.find(string);
+    if (it != stringToId_.end()) {
+      auto entry = idToString_.find(it->second);
+      VELOX_CHECK(entry != idToString_.end());
+      // Entries visible under the shared lock are in use.
+      VELOX_CHECK(tryAddReference(entry->second));
+      return it->second;
+    }
+  }
+
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   auto it = stringToId_.find(string);
   if (it != stringToId_.end()) {
+    // Another thread added 'string' between the locks.
     auto entry = idToString_.find(it->second);
     VELOX_CHECK(entry != idToString_.end());
-    if (++entry->second.numInUse == 1) {
-      pinnedSize_ += entry->second.string.size();
-    }
-
+    ++entry->second.numInUse;
     return it->second;
   }
-  Entry entry;
-  entry.string = string;
   // Check that we do not use an id twice. In practice this never
   // happens because the int64 counter would have to wrap around for
   // this. Even if this happened, the time spent in the loop would
   // have a low cap since the number of mappings would in practice
   // be in the 100K range.
+  uint64_t id;
   do {
-    entry.id = ++lastId_;
-  } while (idToString_.find(entry.id) != idToString_.end());
+    id = ++lastId_;
+  } while (idToString_.find(id) != idToString_.end());
+  auto& entry = idToString_[id];
+  entry.string = string;
+  entry.id = id;
   entry.numInUse = 1;
   pinnedSize_ += entry.string.size();
-  auto id = entry.id;
-  idToString_[id] = std::move(entry);
   stringToId_[string] = id;
-  return lastId_;
+  return id;
 }
 
 } // namespace facebook::velox
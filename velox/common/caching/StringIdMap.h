@@ -16,14 +16,21 @@
 
 #pragma once
 
+#include <atomic>
+#include <shared_mutex>
 #include <string_view>
 
+#include <folly/SharedMutex.h>
 #include <folly/container/F14Map.h>
 
 #include "velox/common/base/Exceptions.h"
 
 namespace facebook::velox {
 
+/// Assigns ids to strings, e.g. file names, and counts the uses of each id.
+/// Lookups and the reference counting of existing ids take a shared lock, so
+/// that concurrent readers do not contend. Only assigning a new id and
+/// dropping the last use of an id take the exclusive lock.
 class StringIdMap {
  public:
   static constexpr uint64_t kNoId = ~0UL;
@@ -58,7 +65,7 @@ class StringIdMap {
   // Returns a copy of the string associated with id or empty string if id has
   // no string.
   std::string string(uint64_t id) {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::shared_lock<folly::SharedMutex> l(mutex_);
     auto it = idToString_.find(id);
     return it == idToString_.end() ? "" : it->second.string;
   }
@@ -67,14 +74,21 @@ class StringIdMap {
   struct Entry {
     std::string string;
     uint64_t id;
-    uint32_t numInUse{};
+    // Incremented under a shared lock of 'mutex_'. Only goes to 0 under the
+    // exclusive lock, which also erases the entry.
+    std::atomic<uint32_t> numInUse{};
   };
 
-  std::mutex mutex_;
+  // Increments the use count of an existing 'entry' if it is in use. Called
+  // under a shared lock of 'mutex_'.
+  static bool tryAddReference(Entry& entry);
+
+  folly::SharedMutex mutex_;
   folly::F14FastMap<std::string, uint64_t> stringToId_;
-  folly::F14FastMap<uint64_t, Entry> idToString_;
+  // Node map because the entries hold atomics and are not movable.
+  folly::F14NodeMap<uint64_t, Entry> idToString_;
   uint64_t lastId_{};
-  uint64_t pinnedSize_{};
+  std::atomic<uint64_t> pinnedSize_{};
 };
 
 // Keeps a string-id association live for the duration of this.
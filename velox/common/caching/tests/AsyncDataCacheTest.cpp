@@ -1148,4 +1148,86 @@ DEBUG_ONLY_TEST_F(AsyncDataCacheTest, ttl) {
   EXPECT_EQ(statsTtl.ssdStats->entriesAgedOut, statsT1.ssdStats->entriesCached);
 }
 
+TEST_F(AsyncDataCacheTest, frequencyAdmission) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_cache_frequency_admission = true;
+  constexpr uint64_t kRamBytes = 64UL << 20;
+  constexpr int32_t kSize = 64 << 10;
+  constexpr int32_t kNumHotEntries = 64;
+  constexpr uint64_t kScanOffset = 1UL << 40;
+  initializeCache(kRamBytes);
+
+  const auto load = [&](uint64_t offset) {
+    auto pin = cache_->findOrCreate({filenames_[0].id(), offset}, kSize);
+    ASSERT_FALSE(pin.empty());
+    if (pin.entry()->isExclusive()) {
+      pin.entry()->setExclusiveToShared();
+    }
+  };
+
+  // The hot entries are read a few times each before a scan of four times
+  // the cache capacity which reads each of its entries once.
+  for (int32_t i = 0; i < 3; ++i) {
+    for (int32_t j = 0; j < kNumHotEntries; ++j) {
+      load(j * kSize);
+    }
+  }
+  const int32_t numScanEntries = 4 * kRamBytes / kSize;
+  for (int32_t i = 0; i < numScanEntries; ++i) {
+    load(kScanOffset + i * kSize);
+  }
+
+  // The scan entries are evicted before the hot entries.
+  for (int32_t i = 0; i < kNumHotEntries; ++i) {
+    ASSERT_TRUE(
+        cache_->exists({filenames_[0].id(), static_cast<uint64_t>(i) * kSize}));
+  }
+  const auto stats = cache_->refreshStats();
+  ASSERT_GT(stats.numEvict, 0);
+  ASSERT_EQ(stats.numEvict, stats.numEvictUnadmitted);
+}
+
+TEST_F(AsyncDataCacheTest, residency) {
+  constexpr uint64_t kRamBytes = 64UL << 20;
+  constexpr uint64_t kSsdBytes = 128UL << 20;
+  constexpr uint64_t kSize = 64 << 10;
+  constexpr uint64_t kNumEntries = 10;
+  initializeCache(kRamBytes, kSsdBytes);
+  const std::string fileName = "testing_file_0";
+  for (uint64_t i = 0; i < kNumEntries; ++i) {
+    auto pin = cache_->findOrCreate({filenames_[0].id(), i * kSize}, kSize);
+    ASSERT_TRUE(pin.entry()->isExclusive());
+    // An entry is not resident while it is being loaded.
+    ASSERT_EQ(0UL, cache_->residency(fileName, i * kSize, kSize).ramBytes);
+    pin.entry()->setExclusiveToShared();
+  }
+
+  auto residency = cache_->residency(fileName, 0, kNumEntries * kSize);
+  ASSERT_EQ(kNumEntries * kSize, residency.ramBytes);
+  ASSERT_EQ(0UL, residency.ssdBytes);
+  residency = cache_->residency(fileName, kSize / 2, kSize);
+  ASSERT_EQ(kSize, residency.ramBytes);
+  residency = cache_->residency(
+      fileName,
+      (kNumEntries - 1) * kSize,
+      std::numeric_limits<uint64_t>::max());
+  ASSERT_EQ(kSize, residency.ramBytes);
+  residency = cache_->residency(fileName, kNumEntries * kSize, kSize);
+  ASSERT_EQ(0UL, residency.ramBytes);
+  residency = cache_->residency("unknown_file", 0, kSize);
+  ASSERT_EQ(0UL, residency.ramBytes);
+
+  cache_->ssdCache()->startWrite();
+  cache_->saveToSsd();
+  waitForSsdWriteToFinish(cache_->ssdCache());
+  residency = cache_->residency(fileName, 0, kNumEntries * kSize);
+  ASSERT_EQ(kNumEntries * kSize, residency.ramBytes);
+  ASSERT_EQ(kNumEntries * kSize, residency.ssdBytes);
+
+  cache_->clear();
+  residency = cache_->residency(fileName, 0, kNumEntries * kSize);
+  ASSERT_EQ(0UL, residency.ramBytes);
+  ASSERT_EQ(kNumEntries * kSize, residency.ssdBytes);
+}
+
 // TODO: add concurrent fuzzer test.
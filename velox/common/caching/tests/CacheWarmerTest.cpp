@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheWarmer.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/MmapAllocator.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::memory;
+
+namespace facebook::velox::cache {
+
+class CacheWarmerTest : public ::testing::Test {
+ protected:
+  static constexpr uint64_t kFileSize = 1 << 20;
+  static constexpr uint64_t kRegionSize = 50 << 10;
+
+  void SetUp() override {
+    allocator_ = std::make_shared<MmapAllocator>(
+        MmapAllocator::Options{.capacity = 64L << 20});
+    cache_ = AsyncDataCache::create(allocator_.get());
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+    fileData_.resize(kFileSize);
+    for (uint64_t i = 0; i < kFileSize; ++i) {
+      fileData_[i] = static_cast<char>(i * 7 + i / 1024);
+    }
+  }
+
+  void TearDown() override {
+    executor_->join();
+    cache_->shutdown();
+  }
+
+  // Opens 'fileName' over 'fileData_'. Throws for "missing".
+  CacheWarmer::FileOpener fileOpener() {
+    return [this](const std::string& fileName) -> std::shared_ptr<ReadFile> {
+      ++numOpens_;
+      VELOX_CHECK_NE(fileName, "missing", "No such file");
+      return std::make_shared<InMemoryReadFile>(std::string_view(fileData_));
+    };
+  }
+
+  std::vector<WarmupRegion> makeRegions(
+      const std::string& fileName,
+      int32_t numRegions) {
+    std::vector<WarmupRegion> regions;
+    for (auto i = 0; i < numRegions; ++i) {
+      regions.push_back({fileName, i * 2 * kRegionSize, kRegionSize});
+    }
+    return regions;
+  }
+
+  CacheWarmer::Stats warm(
+      std::vector<WarmupRegion> regions,
+      CacheWarmer::IdleCheck isIdle = []() { return true; },
+      CacheWarmer::Options options = {}) {
+    auto warmer = CacheWarmer::create(
+        cache_.get(),
+        executor_.get(),
+        fileOpener(),
+        std::move(isIdle),
+        std::move(options));
+    return warmer->start(std::move(regions)).get();
+  }
+
+  // Returns the cached bytes of 'region' or std::nullopt if not cached.
+  std::optional<std::string> cachedData(const WarmupRegion& region) {
+    const auto fileNum = fileIds().id(region.fileName);
+    if (fileNum == StringIdMap::kNoId ||
+        !cache_->exists(RawFileCacheKey{fileNum, region.offset})) {
+      return std::nullopt;
+    }
+    auto pin =
+        cache_->findOrCreate({fileNum, region.offset}, region.size, nullptr);
+    auto* entry = pin.checkedEntry();
+    EXPECT_TRUE(entry->isShared());
+    if (entry->tinyData() != nullptr) {
+      return std::string(entry->tinyData(), entry->size());
+    }
+    std::string data;
+    const auto& allocation = entry->data();
+    for (auto i = 0; i < allocation.numRuns(); ++i) {
+      const auto run = allocation.runAt(i);
+      const auto bytes =
+          std::min<uint64_t>(run.numBytes(), entry->size() - data.size());
+      data.append(run.data<char>(), bytes);
+    }
+    return data;
+  }
+
+  std::string fileData(const WarmupRegion& region) const {
+    return fileData_.substr(region.offset, region.size);
+  }
+
+  std::shared_ptr<MemoryAllocator> allocator_;
+  std::shared_ptr<AsyncDataCache> cache_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  std::string fileData_;
+  std::atomic_int32_t numOpens_{0};
+};
+
+TEST_F(CacheWarmerTest, warmup) {
+  auto regions = makeRegions("warmupFile", 4);
+  // The first region is already cached.
+  ASSERT_EQ(1, warm({regions[0]}).numLoaded);
+  ASSERT_EQ(1, numOpens_);
+
+  const auto stats = warm(regions);
+  ASSERT_EQ(3, stats.numLoaded);
+  ASSERT_EQ(1, stats.numCached);
+  ASSERT_EQ(0, stats.numFailed);
+  ASSERT_EQ(3 * kRegionSize, stats.loadedBytes);
+  ASSERT_EQ(0, stats.numIdleWaits);
+  // The regions of the file are read with one open.
+  ASSERT_EQ(2, numOpens_);
+  for (const auto& region : regions) {
+    ASSERT_EQ(fileData(region), cachedData(region));
+  }
+}
+
+TEST_F(CacheWarmerTest, byteBudget) {
+  auto regions = makeRegions("budgetFile", 6);
+  const auto stats = warm(
+      regions,
+      []() { return true; },
+      {.maxBytes = 3 * kRegionSize, .batchBytes = kRegionSize});
+  ASSERT_EQ(3, stats.numLoaded);
+  ASSERT_EQ(3 * kRegionSize, stats.loadedBytes);
+  for (auto i = 0; i < regions.size(); ++i) {
+    ASSERT_EQ(i < 3, cachedData(regions[i]).has_value()) << i;
+  }
+}
+
+TEST_F(CacheWarmerTest, idleWait) {
+  auto regions = makeRegions("idleFile", 4);
+  std::atomic_int32_t numChecks{0};
+  // Busy for the first 2 checks and after the first batch.
+  const auto stats = warm(
+      regions,
+      [&]() {
+        const auto check = numChecks++;
+        return check != 0 && check != 1 && check != 3;
+      },
+      {.batchBytes = 2 * kRegionSize,
+       .idleRetryInterval = std::chrono::milliseconds(10)});
+  ASSERT_EQ(3, stats.numIdleWaits);
+  ASSERT_EQ(4, stats.numLoaded);
+  for (const auto& region : regions) {
+    ASSERT_EQ(fileData(region), cachedData(region));
+  }
+}
+
+TEST_F(CacheWarmerTest, failedRead) {
+  auto regions = makeRegions("missing", 2);
+  auto goodRegions = makeRegions("goodFile", 2);
+  regions.insert(regions.end(), goodRegions.begin(), goodRegions.end());
+  const auto stats = warm(regions);
+  ASSERT_EQ(2, stats.numFailed);
+  ASSERT_EQ(2, stats.numLoaded);
+  for (const auto& region : regions) {
+    ASSERT_EQ(region.fileName != "missing", cachedData(region).has_value());
+  }
+}
+
+TEST_F(CacheWarmerTest, accessLog) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  const auto path = tempDirectory->getPath() + "/accessLog";
+  ASSERT_TRUE(CacheWarmer::readAccessLog(path).empty());
+
+  auto regions = makeRegions("dir/file with spaces", 3);
+  warm(regions);
+  // The last region is the most used.
+  for (auto i = 0; i < 5; ++i) {
+    ASSERT_TRUE(cachedData(regions.back()).has_value());
+  }
+
+  CacheWarmer::writeAccessLog(*cache_, path, 10);
+  auto logged = CacheWarmer::readAccessLog(path);
+  ASSERT_EQ(regions.size(), logged.size());
+  ASSERT_EQ(regions.back(), logged.front());
+  std::sort(
+      logged.begin(), logged.end(), [](const auto& left, const auto& right) {
+        return left.offset < right.offset;
+      });
+  ASSERT_EQ(regions, logged);
+
+  CacheWarmer::writeAccessLog(*cache_, path, 1);
+  logged = CacheWarmer::readAccessLog(path);
+  ASSERT_EQ(1, logged.size());
+  ASSERT_EQ(regions.back(), logged.front());
+
+  // Replaying the log into an empty cache loads the logged regions.
+  cache_->clear();
+  ASSERT_FALSE(cachedData(regions.back()).has_value());
+  ASSERT_EQ(1, warm(logged).numLoaded);
+  ASSERT_EQ(fileData(regions.back()), cachedData(regions.back()));
+}
+
+} // namespace facebook::velox::cache
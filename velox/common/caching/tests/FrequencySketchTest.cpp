@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <folly/hash/Hash.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+namespace {
+uint64_t keyHash(uint64_t key) {
+  return folly::hasher<uint64_t>()(key);
+}
+} // namespace
+
+TEST(FrequencySketchTest, estimate) {
+  FrequencySketch sketch(1'000);
+  ASSERT_EQ(sketch.capacity(), 1'024UL);
+  for (uint64_t key = 0; key < 100; ++key) {
+    ASSERT_EQ(sketch.estimate(keyHash(key)), 0);
+  }
+  for (int32_t i = 0; i < 5; ++i) {
+    sketch.increment(keyHash(1));
+  }
+  sketch.increment(keyHash(2));
+  ASSERT_GE(sketch.estimate(keyHash(1)), 5);
+  ASSERT_GE(sketch.estimate(keyHash(2)), 1);
+  ASSERT_LT(sketch.estimate(keyHash(1)), FrequencySketch::kMaxCount);
+
+  // The counts saturate at kMaxCount.
+  for (int32_t i = 0; i < 100; ++i) {
+    sketch.increment(keyHash(3));
+  }
+  ASSERT_EQ(sketch.estimate(keyHash(3)), FrequencySketch::kMaxCount);
+
+  sketch.resize(2'000);
+  ASSERT_EQ(sketch.capacity(), 2'048UL);
+  ASSERT_EQ(sketch.estimate(keyHash(3)), 0);
+}
+
+TEST(FrequencySketchTest, aging) {
+  FrequencySketch sketch(16);
+  for (int32_t i = 0; i < FrequencySketch::kMaxCount; ++i) {
+    sketch.increment(keyHash(0));
+  }
+  ASSERT_EQ(sketch.estimate(keyHash(0)), FrequencySketch::kMaxCount);
+
+  // Counting many other keys halves the counts, so that keys which are not
+  // accessed any more fade out.
+  for (uint64_t key = 1; key < 1'000; ++key) {
+    sketch.increment(keyHash(key));
+  }
+  ASSERT_LT(sketch.estimate(keyHash(0)), FrequencySketch::kMaxCount);
+}
@@ -22,6 +22,7 @@
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <filesystem>
 
 using namespace facebook::velox;
 using namespace facebook::velox::cache;
@@ -58,7 +59,8 @@ class SsdFileTest : public testing::Test {
   void initializeCache(
       int64_t maxBytes,
       int64_t ssdBytes = 0,
-      bool setNoCowFlag = false) {
+      bool setNoCowFlag = false,
+      int64_t checkpointIntervalBytes = 0) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
     cache_ = AsyncDataCache::create(memory::memoryManager()->allocator());
@@ -66,11 +68,21 @@ class SsdFileTest : public testing::Test {
     fileName_ = StringIdLease(fileIds(), "fileInStorage");
 
     tempDirectory_ = exec::test::TempDirectoryPath::create();
-    ssdFile_ = std::make_unique<SsdFile>(
+    ssdFile_ = createSsdFile(ssdBytes, setNoCowFlag, checkpointIntervalBytes);
+  }
+
+  // Creates an SsdFile on the backing file in 'tempDirectory_'. The file is
+  // restored from the checkpoint of a previous SsdFile on the same path if
+  // 'checkpointIntervalBytes' is non-zero.
+  std::unique_ptr<SsdFile> createSsdFile(
+      int64_t ssdBytes,
+      bool setNoCowFlag,
+      int64_t checkpointIntervalBytes) {
+    return std::make_unique<SsdFile>(
         fmt::format("{}/ssdtest", tempDirectory_->getPath()),
         0, // shardId
         bits::roundUp(ssdBytes, SsdFile::kRegionSize) / SsdFile::kRegionSize,
-        0, // checkpointInternalBytes
+        checkpointIntervalBytes,
         setNoCowFlag);
   }
 
@@ -314,6 +326,45 @@ TEST_F(SsdFileTest, writeAndRead) {
   }
 }
 
+TEST_F(SsdFileTest, incrementalCheckpoint) {
+  constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
+  initializeCache(128 * kMB, kSsdSize, false, kMB);
+  std::vector<TestEntry> allEntries;
+  // The first write makes a full checkpoint. The later ones append to the
+  // write log.
+  for (auto i = 0; i < 4; ++i) {
+    auto pins = makePins(
+        fileName_.id(), i * SsdFile::kRegionSize, 4096, 2048 * 1025, 8 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      ASSERT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+      allEntries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    }
+  }
+  const auto checkpointPath =
+      fmt::format("{}/ssdtest.cpt", tempDirectory_->getPath());
+  const auto writeLogPath =
+      fmt::format("{}/ssdtest.wlog", tempDirectory_->getPath());
+  ASSERT_TRUE(std::filesystem::exists(checkpointPath));
+  ASSERT_GT(std::filesystem::file_size(writeLogPath), 0);
+
+  // The restarted file recovers the entries from both the checkpoint and the
+  // write log.
+  auto restoredFile = createSsdFile(kSsdSize, false, kMB);
+  for (const auto& entry : allEntries) {
+    auto pin =
+        restoredFile->find(RawFileCacheKey{fileName_.id(), entry.key.offset});
+    ASSERT_FALSE(pin.empty());
+    ASSERT_EQ(entry.ssdOffset, pin.run().offset());
+    ASSERT_EQ(entry.size, pin.run().size());
+  }
+
+  // A forced checkpoint compacts the write log into the checkpoint.
+  ssdFile_->checkpoint(true);
+  ASSERT_EQ(0, std::filesystem::file_size(writeLogPath));
+}
+
 #ifdef VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
 TEST_F(SsdFileTest, disabledCow) {
   LOG(ERROR) << "here";
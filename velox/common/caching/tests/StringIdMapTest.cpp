@@ -16,6 +16,8 @@
 
 #include "velox/common/caching/StringIdMap.h"
 
+#include <thread>
+
 #include "gtest/gtest.h"
 
 using namespace facebook::velox;
@@ -53,3 +55,27 @@ TEST(StringIdMapTest, rehash) {
     EXPECT_EQ(ids[i].id(), StringIdLease(map, name).id());
   }
 }
+
+TEST(StringIdMapTest, concurrentLeases) {
+  constexpr int32_t kNumThreads = 8;
+  constexpr int32_t kNumNames = 16;
+  StringIdMap map;
+  std::vector<std::thread> threads;
+  threads.reserve(kNumThreads);
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto j = 0; j < 10'000; ++j) {
+        const auto name = fmt::format("filename_{}", (i + j) % kNumNames);
+        StringIdLease lease(map, name);
+        ASSERT_EQ(map.id(name), lease.id());
+        StringIdLease copy(lease);
+        ASSERT_EQ(map.string(copy.id()), name);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(0, map.pinnedSize());
+  EXPECT_EQ(StringIdMap::kNoId, map.id("filename_0"));
+}
@@ -32,6 +32,13 @@ static const int32_t DEC_64_TABLE[] = {0, 0, 0, -1, 0, 1, 2, 3};
 static const int32_t SIZE_OF_SHORT = 2;
 static const int32_t SIZE_OF_INT = 4;
 static const int32_t SIZE_OF_LONG = 8;
+// Width of the copies of long literals and matches.
+static const int32_t SIZE_OF_WIDE_COPY = 16;
+
+// Copies SIZE_OF_WIDE_COPY bytes. Compiles to a single vector load and store.
+static inline void wideCopy(char* output, const char* input) {
+  memcpy(output, input, SIZE_OF_WIDE_COPY);
+}
 
 static std::string toHex(uint64_t val) {
   std::ostringstream out;
@@ -72,6 +79,9 @@ uint64_t lzoDecompress(
 
   // maximum offset in buffers to which it's safe to write long-at-a-time
   char* const fastOutputLimit = outputLimit - SIZE_OF_LONG;
+  // maximum offsets in buffers to which it's safe to copy 16 bytes at a time
+  char* const wideOutputLimit = outputLimit - SIZE_OF_WIDE_COPY;
+  const char* const wideInputLimit = inputLimit - SIZE_OF_WIDE_COPY;
 
   // LZO can concat two blocks together so, decode until the input data is
   // consumed
@@ -288,7 +298,17 @@ uint64_t lzoDecompress(
         }
         char* matchOutputLimit = output + matchLength;
 
-        if (output > fastOutputLimit) {
+        if (matchOffset >= SIZE_OF_WIDE_COPY &&
+            matchOutputLimit <= wideOutputLimit) {
+          // The source of each 16 byte copy is written before it is read
+          // since the match is at least 16 bytes back. We may over-copy but
+          // there's enough room in output.
+          do {
+            wideCopy(output, matchAddress);
+            matchAddress += SIZE_OF_WIDE_COPY;
+            output += SIZE_OF_WIDE_COPY;
+          } while (output < matchOutputLimit);
+        } else if (output > fastOutputLimit) {
           // slow match copy
           while (output < matchOutputLimit) {
             *(output++) = *(matchAddress++);
@@ -347,7 +367,20 @@ uint64_t lzoDecompress(
 
       // copy literal
       char* literalOutputLimit = output + literalLength;
-      if (literalOutputLimit > fastOutputLimit ||
+      if (literalLength > SIZE_OF_LONG &&
+          literalOutputLimit <= wideOutputLimit &&
+          input + literalLength <= wideInputLimit) {
+        // wide copy. We may over-copy but there's enough room in input and
+        // output to not overrun them
+        do {
+          wideCopy(output, input);
+          input += SIZE_OF_WIDE_COPY;
+          output += SIZE_OF_WIDE_COPY;
+        } while (output < literalOutputLimit);
+        input -= (output - literalOutputLimit);
+        output = literalOutputLimit;
+      } else if (
+          literalOutputLimit > fastOutputLimit ||
           input + literalLength > inputLimit - SIZE_OF_LONG) {
         if (literalOutputLimit > outputLimit) {
           throw MalformedInputException(input - inputAddress);
@@ -15,15 +15,18 @@
  */
 
 #include "velox/common/file/File.h"
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Fs.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
+#include <cstdlib>
 #include <memory>
 #include <stdexcept>
 
 #include <fcntl.h>
 #include <folly/portability/SysUio.h>
+#include <sys/mman.h>
 
 namespace facebook::velox {
 
@@ -101,8 +104,58 @@ uint64_t InMemoryWriteFile::size() const {
   return file_->size();
 }
 
-LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
-  fd_ = open(path_.c_str(), O_RDONLY);
+namespace {
+// Alignment of file offsets, lengths and buffers for O_DIRECT reads. 4KB
+// covers the logical block size of common devices.
+constexpr uint64_t kDirectIoAlignment = 4096;
+// Size of the staging buffer for O_DIRECT reads.
+constexpr uint64_t kDirectIoBufferSize = 1 << 20;
+
+struct DirectIoBuffer {
+  DirectIoBuffer()
+      : data(static_cast<char*>(
+            std::aligned_alloc(kDirectIoAlignment, kDirectIoBufferSize))) {
+    VELOX_CHECK_NOT_NULL(data, "Failed to allocate O_DIRECT read buffer");
+  }
+
+  ~DirectIoBuffer() {
+    std::free(data);
+  }
+
+  char* const data;
+};
+} // namespace
+
+// static
+LocalReadFile::Mode LocalReadFile::toMode(std::string_view name) {
+  if (name == "pread") {
+    return Mode::kPread;
+  }
+  if (name == "mmap") {
+    return Mode::kMmap;
+  }
+  if (name == "direct") {
+    return Mode::kDirect;
+  }
+  VELOX_USER_FAIL("Unknown local file read mode: {}", name);
+}
+
+LocalReadFile::LocalReadFile(std::string_view path, Mode mode)
+    : path_(path), mode_(mode) {
+  int flags = O_RDONLY;
+  if (mode_ == Mode::kDirect) {
+#ifdef O_DIRECT
+    flags |= O_DIRECT;
+#else
+    mode_ = Mode::kPread;
+#endif
+  }
+  fd_ = open(path_.c_str(), flags);
+  if (fd_ < 0 && errno == EINVAL && mode_ == Mode::kDirect) {
+    // The file system does not support O_DIRECT.
+    mode_ = Mode::kPread;
+    fd_ = open(path_.c_str(), O_RDONLY);
+  }
   if (fd_ < 0) {
     if (errno == ENOENT) {
       VELOX_FILE_NOT_FOUND_ERROR("No such file or directory: {}", path);
@@ -123,11 +176,25 @@ LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
       path,
       folly::errnoStr(errno));
   size_ = rc;
+  if (mode_ == Mode::kMmap && size_ > 0) {
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (addr == MAP_FAILED) {
+      const auto error = folly::errnoStr(errno);
+      close(fd_);
+      VELOX_FAIL(
+          "mmap failure in LocalReadFile constructor, {} {}.", path, error);
+    }
+    mapped_ = static_cast<const char*>(addr);
+  }
 }
 
 LocalReadFile::LocalReadFile(int32_t fd) : fd_(fd) {}
 
 LocalReadFile::~LocalReadFile() {
+  if (mapped_ != nullptr && munmap(const_cast<char*>(mapped_), size_) < 0) {
+    LOG(WARNING) << "munmap failure in LocalReadFile destructor: "
+                 << folly::errnoStr(errno);
+  }
   const int ret = close(fd_);
   if (ret < 0) {
     LOG(WARNING) << "close failure in LocalReadFile destructor: " << ret << ", "
@@ -138,6 +205,19 @@ LocalReadFile::~LocalReadFile() {
 void LocalReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
     const {
   bytesRead_ += length;
+  if (mapped_ != nullptr) {
+    VELOX_CHECK_LE(
+        offset + length,
+        size_,
+        "Read past the end of mapped file {}",
+        path_);
+    ::memcpy(pos, mapped_ + offset, length);
+    return;
+  }
+  if (mode_ == Mode::kDirect) {
+    preadDirect(offset, length, pos);
+    return;
+  }
   auto bytesRead = ::pread(fd_, pos, length, offset);
   VELOX_CHECK_EQ(
       bytesRead,
@@ -147,6 +227,31 @@ void LocalReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
       length);
 }
 
+void LocalReadFile::preadDirect(uint64_t offset, uint64_t length, char* pos)
+    const {
+  static thread_local DirectIoBuffer buffer;
+  while (length > 0) {
+    const uint64_t alignedOffset = offset & ~(kDirectIoAlignment - 1);
+    const uint64_t skip = offset - alignedOffset;
+    const uint64_t readSize = std::min(
+        kDirectIoBufferSize, bits::roundUp(skip + length, kDirectIoAlignment));
+    // The last read of the file may return less than 'readSize'.
+    const auto bytesRead = ::pread(fd_, buffer.data, readSize, alignedOffset);
+    VELOX_CHECK_GT(
+        bytesRead,
+        static_cast<ssize_t>(skip),
+        "O_DIRECT read failure in LocalReadFile::preadDirect, {} {} {}.",
+        path_,
+        alignedOffset,
+        folly::errnoStr(errno));
+    const uint64_t copySize = std::min<uint64_t>(length, bytesRead - skip);
+    ::memcpy(pos, buffer.data + skip, copySize);
+    pos += copySize;
+    offset += copySize;
+    length -= copySize;
+  }
+}
+
 std::string_view
 LocalReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
   preadInternal(offset, length, static_cast<char*>(buf));
@@ -156,6 +261,18 @@ LocalReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
 uint64_t LocalReadFile::preadv(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) const {
+  if (mode_ != Mode::kPread) {
+    // Mapped and O_DIRECT reads copy into the buffers and skip the gaps.
+    uint64_t totalBytesRead = 0;
+    for (auto& range : buffers) {
+      if (range.data()) {
+        preadInternal(offset, range.size(), range.data());
+      }
+      offset += range.size();
+      totalBytesRead += range.size();
+    }
+    return totalBytesRead;
+  }
   // Dropped bytes sized so that a typical dropped range of 50K is not
   // too many iovecs.
   static thread_local std::vector<char> droppedBytes(16 * 1024);
@@ -191,6 +308,14 @@ uint64_t LocalReadFile::preadv(
         skipSize -= bytes;
       }
     } else {
+      // Extends the last iovec if 'range' is adjacent to it in memory, e.g.
+      // for consecutive runs of a memory allocation.
+      if (!iovecs.empty() && iovecs.back().iov_base != droppedBytes.data() &&
+          static_cast<char*>(iovecs.back().iov_base) + iovecs.back().iov_len ==
+              range.data()) {
+        iovecs.back().iov_len += range.size();
+        continue;
+      }
       if (iovecs.size() >= IOV_MAX) {
         ssize_t bytesRead{0};
         RETURN_IF_ERROR(readvFunc(), bytesRead);
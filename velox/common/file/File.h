@@ -230,7 +230,24 @@ class InMemoryWriteFile final : public WriteFile {
 /// files match against any filepath starting with '/'.
 class LocalReadFile final : public ReadFile {
  public:
-  explicit LocalReadFile(std::string_view path);
+  /// How the file contents are read.
+  enum class Mode {
+    /// pread(2) through the OS page cache.
+    kPread,
+    /// Maps the whole file read-only and copies out of the mapping. Avoids a
+    /// system call per read for files that are read many times.
+    kMmap,
+    /// Opens the file with O_DIRECT and reads through an aligned staging
+    /// buffer, bypassing the page cache so that data cached in AsyncDataCache
+    /// is not also buffered by the kernel. Falls back to kPread if the file
+    /// system does not support O_DIRECT.
+    kDirect,
+  };
+
+  /// Returns the mode named by 'name', one of 'pread', 'mmap' or 'direct'.
+  static Mode toMode(std::string_view name);
+
+  explicit LocalReadFile(std::string_view path, Mode mode = Mode::kPread);
 
   /// TODO: deprecate this after creating local file all through velox fs
   /// interface.
@@ -264,12 +281,24 @@ class LocalReadFile final : public ReadFile {
     return 10 << 20;
   }
 
+  /// Returns the mode the file is read with. This may differ from the
+  /// requested mode if the latter is not supported for the file.
+  Mode mode() const {
+    return mode_;
+  }
+
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
 
+  // Reads through an aligned thread-local buffer for kDirect mode.
+  void preadDirect(uint64_t offset, uint64_t length, char* pos) const;
+
   std::string path_;
   int32_t fd_;
   long size_;
+  Mode mode_{Mode::kPread};
+  // Start of the read-only mapping of the file in kMmap mode.
+  const char* mapped_{nullptr};
 };
 
 class LocalWriteFile final : public WriteFile {
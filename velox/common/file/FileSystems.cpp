@@ -86,8 +86,9 @@ class LocalFileSystem : public FileSystem {
 
   std::unique_ptr<ReadFile> openFileForRead(
       std::string_view path,
-      const FileOptions& /*unused*/) override {
-    return std::make_unique<LocalReadFile>(extractPath(path));
+      const FileOptions& options) override {
+    return std::make_unique<LocalReadFile>(
+        extractPath(path), readMode(options));
   }
 
   std::unique_ptr<WriteFile> openFileForWrite(
@@ -96,6 +97,14 @@ class LocalFileSystem : public FileSystem {
     return std::make_unique<LocalWriteFile>(extractPath(path));
   }
 
+  static LocalReadFile::Mode readMode(const FileOptions& options) {
+    auto it = options.values.find(std::string(kLocalReadMode));
+    if (it == options.values.end()) {
+      return LocalReadFile::Mode::kPread;
+    }
+    return LocalReadFile::toMode(it->second);
+  }
+
   void remove(std::string_view path) override {
     auto file = extractPath(path);
     int32_t rc = std::remove(std::string(file).c_str());
@@ -113,6 +113,10 @@ void registerFileSystem(
         std::shared_ptr<const Config>,
         std::string_view)> fileSystemGenerator);
 
+/// FileOptions key selecting how the local file system reads files: 'pread'
+/// (default), 'mmap' or 'direct'. See LocalReadFile::Mode.
+constexpr std::string_view kLocalReadMode{"local-read-mode"};
+
 /// Register the local filesystem.
 void registerLocalFileSystem();
 
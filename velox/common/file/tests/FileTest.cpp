@@ -87,6 +87,11 @@ void readData(ReadFile* readFile, bool checkFileSize = true) {
   ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
   ASSERT_EQ(std::string_view(middle, sizeof(middle)), "cccc");
   ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+  char adjacent[10];
+  buffers = {
+      folly::Range<char*>(adjacent, 4), folly::Range<char*>(adjacent + 4, 6)};
+  ASSERT_EQ(10, readFile->preadv(2, buffers));
+  ASSERT_EQ(std::string_view(adjacent, sizeof(adjacent)), "aaabbbbbcc");
 }
 
 // We could templated this test, but that's kinda overkill for how simple it is.
@@ -160,6 +165,37 @@ TEST_P(LocalFileTest, writeAndRead) {
   }
 }
 
+TEST_P(LocalFileTest, readModes) {
+  auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
+  const auto& filename = tempFile->getPath();
+  auto fs = filesystems::getFileSystem(filename, {});
+  fs->remove(filename);
+  {
+    auto writeFile = fs->openFileForWrite(filename);
+    writeData(writeFile.get());
+    writeFile->close();
+  }
+  for (const auto* mode : {"pread", "mmap", "direct"}) {
+    SCOPED_TRACE(mode);
+    filesystems::FileOptions options;
+    options.values[std::string(filesystems::kLocalReadMode)] = mode;
+    auto readFile = fs->openFileForRead(filename, options);
+    readData(readFile.get());
+  }
+
+  // An empty file is not mapped.
+  fs->remove(filename);
+  fs->openFileForWrite(filename)->close();
+  filesystems::FileOptions options;
+  options.values[std::string(filesystems::kLocalReadMode)] = "mmap";
+  ASSERT_EQ(fs->openFileForRead(filename, options)->size(), 0);
+
+  options.values[std::string(filesystems::kLocalReadMode)] = "bogus";
+  VELOX_ASSERT_THROW(
+      fs->openFileForRead(filename, options),
+      "Unknown local file read mode: bogus");
+}
+
 TEST_P(LocalFileTest, viaRegistry) {
   auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
   const auto& filename = tempFile->getPath();
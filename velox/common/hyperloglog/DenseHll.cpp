@@ -15,6 +15,7 @@
  */
 #include "velox/common/hyperloglog/DenseHll.h"
 
+#include <algorithm>
 #include <exception>
 #include <sstream>
 #include "velox/common/base/IOUtils.h"
@@ -143,6 +144,29 @@ void DenseHll::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+void DenseHll::insertHashes(const uint64_t* hashes, int32_t count) {
+  constexpr int32_t kBatchSize = 64;
+  uint32_t indices[kBatchSize];
+  int8_t values[kBatchSize];
+  const int32_t indexBitLength = indexBitLength_;
+  for (int32_t start = 0; start < count; start += kBatchSize) {
+    const int32_t numHashes = std::min(kBatchSize, count - start);
+    const uint64_t* batch = hashes + start;
+    // No dependencies between hashes, the compiler can vectorize this loop.
+    for (int32_t i = 0; i < numHashes; ++i) {
+      indices[i] = computeIndex(batch[i], indexBitLength);
+      values[i] = numberOfLeadingZeros(batch[i], indexBitLength) + 1;
+    }
+    for (int32_t i = 0; i < numHashes; ++i) {
+      // Values not above the baseline can't change any bucket. 'baseline_' is
+      // re-read because an insert may raise it.
+      if (values[i] > baseline_) {
+        insert(indices[i], values[i]);
+      }
+    }
+  }
+}
+
 void DenseHll::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
   auto oldDelta = getDelta(index);
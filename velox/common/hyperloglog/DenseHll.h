@@ -48,6 +48,11 @@ class DenseHll {
 
   void insertHash(uint64_t hash);
 
+  /// Same as calling insertHash for each of the 'count' 'hashes'. Computes
+  /// the buckets and values for a batch of hashes in one pass and only
+  /// updates the buckets whose values may increase.
+  void insertHashes(const uint64_t* hashes, int32_t count);
+
   /// Inserts pre-computed {bucket, value} pair. These value must be compatible
   /// with computeIndex and computeValue methods called with the indexBitLength
   /// value of this HLL. Used by SparseHll.toDense().
@@ -158,6 +158,28 @@ TEST_P(DenseHllTest, highCardinality) {
   ASSERT_EQ(denseHll.cardinality(), DenseHll::cardinality(serialized.data()));
 }
 
+TEST_P(DenseHllTest, insertHashes) {
+  int8_t indexBitLength = GetParam();
+
+  DenseHll expected{indexBitLength, &allocator_};
+  DenseHll denseHll{indexBitLength, &allocator_};
+  std::vector<uint64_t> hashes;
+  for (int i = 0; i < 100'000; i++) {
+    hashes.push_back(hashOne(i));
+    expected.insertHash(hashes.back());
+  }
+
+  // Uneven batch sizes exercise the partial batches.
+  for (int32_t start = 0; start < hashes.size(); start += 1'001) {
+    denseHll.insertHashes(
+        hashes.data() + start,
+        std::min<int32_t>(1'001, hashes.size() - start));
+  }
+
+  ASSERT_EQ(expected.cardinality(), denseHll.cardinality());
+  ASSERT_EQ(serialize(expected), serialize(denseHll));
+}
+
 namespace {
 template <typename T>
 std::vector<T> sequence(T start, T end) {
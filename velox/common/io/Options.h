@@ -65,12 +65,14 @@ class ReaderOptions {
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
+  int64_t maxPrefetchRowGroupBytes_{kDefaultMaxPrefetchRowGroupBytes};
 
  public:
   static constexpr int32_t kDefaultLoadQuantum = 8 << 20; // 8MB
   static constexpr int32_t kDefaultCoalesceDistance = 512 << 10; // 512K
   static constexpr int32_t kDefaultCoalesceBytes = 128 << 20; // 128M
   static constexpr int32_t kDefaultPrefetchRowGroups = 1;
+  static constexpr int64_t kDefaultMaxPrefetchRowGroupBytes = 256 << 20;
 
   explicit ReaderOptions(velox::memory::MemoryPool* pool)
       : memoryPool(pool),
@@ -84,6 +86,7 @@ class ReaderOptions {
     maxCoalesceDistance_ = other.maxCoalesceDistance_;
     maxCoalesceBytes_ = other.maxCoalesceBytes_;
     prefetchRowGroups_ = other.prefetchRowGroups_;
+    maxPrefetchRowGroupBytes_ = other.maxPrefetchRowGroupBytes_;
     loadQuantum_ = other.loadQuantum_;
     return *this;
   }
@@ -146,6 +149,14 @@ class ReaderOptions {
     return *this;
   }
 
+  /**
+   * Modify the maximum bytes of row groups read ahead of the current one.
+   */
+  ReaderOptions& setMaxPrefetchRowGroupBytes(int64_t bytes) {
+    maxPrefetchRowGroupBytes_ = bytes;
+    return *this;
+  }
+
   /**
    * Get the memory allocator.
    */
@@ -176,5 +187,9 @@ class ReaderOptions {
   int64_t prefetchRowGroups() const {
     return prefetchRowGroups_;
   }
+
+  int64_t maxPrefetchRowGroupBytes() const {
+    return maxPrefetchRowGroupBytes_;
+  }
 };
 } // namespace facebook::velox::io
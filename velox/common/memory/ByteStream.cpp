@@ -300,14 +300,40 @@ void ByteOutputStream::seekp(std::streampos position) {
 
 void ByteOutputStream::flush(OutputStream* out) {
   updateEnd();
+  auto* iobufOut = dynamic_cast<IOBufOutputStream*>(out);
+  if (iobufOut != nullptr && !iobufOut->sharesArena(arena_)) {
+    iobufOut = nullptr;
+  }
+  // Ranges that are adjacent in memory, e.g. consecutive pieces of one arena
+  // run, are written together. This makes fewer and larger IOBufs when
+  // flushing by reference.
+  char* runStart = nullptr;
+  int64_t runBytes = 0;
+  const auto writeRun = [&]() {
+    if (runBytes == 0) {
+      return;
+    }
+    if (iobufOut != nullptr && runBytes >= kMinFlushByReferenceBytes) {
+      iobufOut->writeReference(runStart, runBytes);
+    } else {
+      out->write(runStart, runBytes);
+    }
+    runBytes = 0;
+  };
   for (int32_t i = 0; i < ranges_.size(); ++i) {
     int32_t count = i == ranges_.size() - 1 ? lastRangeEnd_ : ranges_[i].size;
     int32_t bytes = isBits_ ? bits::nbytes(count) : count;
     if (isBits_ && isReverseBitOrder_ && !isReversed_) {
       bits::reverseBits(ranges_[i].buffer, bytes);
     }
-    out->write(reinterpret_cast<char*>(ranges_[i].buffer), bytes);
+    auto* buffer = reinterpret_cast<char*>(ranges_[i].buffer);
+    if (runBytes == 0 || buffer != runStart + runBytes) {
+      writeRun();
+      runStart = buffer;
+    }
+    runBytes += bytes;
   }
+  writeRun();
   if (isBits_ && isReverseBitOrder_) {
     isReversed_ = true;
   }
@@ -350,6 +376,12 @@ void ByteOutputStream::extend(int32_t bytes) {
 }
 
 int32_t ByteOutputStream::newRangeSize(int32_t bytes) const {
+  if (growthPercent_ > 0 &&
+      allocatedBytes_ >= memory::AllocationTraits::kPageSize) {
+    const auto growth = std::min<int64_t>(
+        allocatedBytes_ * growthPercent_ / 100, kMaxGrowthBytes);
+    bytes = std::max<int64_t>(bytes, growth);
+  }
   const int32_t newSize = allocatedBytes_ + bytes;
   if (newSize < 128) {
     return 128;
@@ -427,33 +459,80 @@ void freeFunc(void* /*data*/, void* userData) {
 }
 } // namespace
 
+void IOBufOutputStream::writeReference(const char* s, std::streamsize count) {
+  if (count == 0) {
+    return;
+  }
+  VELOX_CHECK_EQ(
+      precedingReferencedBytes_,
+      referencedBytes_,
+      "References must be written at the end");
+  references_.push_back({static_cast<int64_t>(out_->tellp()), s, count});
+  referencedBytes_ += count;
+  precedingReferencedBytes_ = referencedBytes_;
+  if (listener_) {
+    listener_->onWrite(s, count);
+  }
+}
+
 std::unique_ptr<folly::IOBuf> IOBufOutputStream::getIOBuf(
     const std::function<void()>& releaseFn) {
-  // Make an IOBuf for each range. The IOBufs keep shared ownership of
-  // 'arena_'.
+  // Make an IOBuf for each range and each reference. The IOBufs keep shared
+  // ownership of 'arena_'.
   std::unique_ptr<folly::IOBuf> iobuf;
-  auto& ranges = out_->ranges();
-  for (auto& range : ranges) {
-    auto numValues =
-        &range == &ranges.back() ? out_->lastRangeEnd() : range.size;
+  auto appendBuf = [&](const char* data, int64_t size) {
+    if (size == 0) {
+      return;
+    }
     auto userData = newFreeData(arena_, releaseFn);
     auto newBuf = folly::IOBuf::takeOwnership(
-        reinterpret_cast<char*>(range.buffer), numValues, freeFunc, userData);
+        const_cast<char*>(data), size, freeFunc, userData);
     if (iobuf) {
       iobuf->prev()->appendChain(std::move(newBuf));
     } else {
       iobuf = std::move(newBuf);
     }
+  };
+  auto& ranges = out_->ranges();
+  int32_t nextReference = 0;
+  int64_t rangeOffset = 0;
+  for (auto& range : ranges) {
+    const int64_t rangeSize =
+        &range == &ranges.back() ? out_->lastRangeEnd() : range.size;
+    const auto* buffer = reinterpret_cast<const char*>(range.buffer);
+    int64_t begin = 0;
+    while (nextReference < references_.size() &&
+           references_[nextReference].offset <= rangeOffset + rangeSize) {
+      const auto& reference = references_[nextReference++];
+      const int64_t end = reference.offset - rangeOffset;
+      appendBuf(buffer + begin, end - begin);
+      begin = end;
+      appendBuf(reference.data, reference.size);
+    }
+    appendBuf(buffer + begin, rangeSize - begin);
+    rangeOffset += rangeSize;
   }
   return iobuf;
 }
 
 std::streampos IOBufOutputStream::tellp() const {
-  return out_->tellp();
+  return out_->tellp() + precedingReferencedBytes_;
 }
 
 void IOBufOutputStream::seekp(std::streampos pos) {
-  out_->seekp(pos);
+  const int64_t position = pos;
+  int64_t precedingBytes = 0;
+  for (const auto& reference : references_) {
+    const int64_t start = reference.offset + precedingBytes;
+    if (position < start + reference.size) {
+      VELOX_CHECK_LE(
+          position, start, "Cannot seek into bytes added by reference");
+      break;
+    }
+    precedingBytes += reference.size;
+  }
+  precedingReferencedBytes_ = precedingBytes;
+  out_->seekp(position - precedingBytes);
 }
 
 } // namespace facebook::velox
@@ -246,6 +246,17 @@ class ByteOutputStream {
     return ranges_;
   }
 
+  /// Makes each new range at least 'percent' percent of the bytes allocated
+  /// so far, up to kMaxGrowthBytes, once 'this' has a page or more. A stream
+  /// of n bytes then has O(log(n)) ranges instead of O(n / page size). The
+  /// default of 0 sizes new ranges by the bytes requested. Meant for short
+  /// lived streams like serialization buffers, not for the many small
+  /// streams of accumulators where the extra space would add up.
+  void setGrowthPercent(int32_t percent) {
+    VELOX_CHECK_GE(percent, 0);
+    growthPercent_ = percent;
+  }
+
   /// Prepares 'this' for writing. Can be called several times,
   /// e.g. PrestoSerializer resets these. The memory formerly backing
   /// 'ranges_' is not owned and the caller needs to recycle or free
@@ -333,8 +344,17 @@ class ByteOutputStream {
     append(folly::Range(&value, 1));
   }
 
+  /// Writes the contents to 'stream'. If 'stream' is an IOBufOutputStream
+  /// sharing the arena of 'this', ranges of at least kMinFlushByReferenceBytes
+  /// are added by reference instead of copied. 'this' must then stay unchanged
+  /// while the IOBufs of 'stream' are in use.
   void flush(OutputStream* stream);
 
+  static constexpr int32_t kMinFlushByReferenceBytes = 4096;
+
+  /// Largest extra size of a new range from setGrowthPercent().
+  static constexpr int32_t kMaxGrowthBytes = 1 << 20;
+
   /// Returns the next byte that would be written to by a write. This
   /// is used after an append to release the remainder of the reserved
   /// space.
@@ -404,6 +424,9 @@ class ByteOutputStream {
   // The total number of bytes allocated from 'arena_' in 'ranges_'.
   int64_t allocatedBytes_{0};
 
+  // See setGrowthPercent().
+  int32_t growthPercent_{0};
+
   // Pointer to the current element of 'ranges_'.
   ByteRange* current_{nullptr};
 
@@ -475,6 +498,19 @@ class IOBufOutputStream : public OutputStream {
     out_->startWrite(initialSize);
   }
 
+  /// Allocates from 'arena' instead of a new arena. The memory of other
+  /// streams allocated from 'arena' can then be added without copy with
+  /// writeReference().
+  explicit IOBufOutputStream(
+      std::shared_ptr<StreamArena> arena,
+      OutputStreamListener* listener = nullptr,
+      int32_t initialSize = memory::AllocationTraits::kPageSize)
+      : OutputStream(listener),
+        arena_(std::move(arena)),
+        out_(std::make_unique<ByteOutputStream>(arena_.get())) {
+    out_->startWrite(initialSize);
+  }
+
   void write(const char* s, std::streamsize count) override {
     out_->appendStringView(std::string_view(s, count));
     if (listener_) {
@@ -482,8 +518,20 @@ class IOBufOutputStream : public OutputStream {
     }
   }
 
+  /// Returns true if memory owned by 'arena' can be added with
+  /// writeReference().
+  bool sharesArena(const StreamArena* arena) const {
+    return arena == arena_.get();
+  }
+
+  /// Appends 'count' bytes at 's' by reference. 's' must be memory owned by
+  /// the arena of 'this' which stays unchanged as long as the IOBufs from
+  /// getIOBuf() exist. Must be called at the end of the written data.
+  void writeReference(const char* s, std::streamsize count);
+
   std::streampos tellp() const override;
 
+  /// Seeking into bytes added by writeReference() is not supported.
   void seekp(std::streampos pos) override;
 
   /// 'releaseFn' is executed on iobuf destruction if not null.
@@ -491,8 +539,21 @@ class IOBufOutputStream : public OutputStream {
       const std::function<void()>& releaseFn = nullptr);
 
  private:
+  // Bytes added by writeReference(). They come after the first 'offset' bytes
+  // of 'out_' and after the references with a lower index.
+  struct Reference {
+    int64_t offset;
+    const char* data;
+    int64_t size;
+  };
+
   std::shared_ptr<StreamArena> arena_;
   std::unique_ptr<ByteOutputStream> out_;
+  std::vector<Reference> references_;
+  // Sum of the sizes of 'references_'.
+  int64_t referencedBytes_{0};
+  // Sum of the sizes of the references before the write position.
+  int64_t precedingReferencedBytes_{0};
 };
 
 } // namespace facebook::velox
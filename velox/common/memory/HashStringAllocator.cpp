@@ -402,6 +402,13 @@ HashStringAllocator::Header* HashStringAllocator::allocateFromFreeList(
   auto* found = headerOf(item);
   VELOX_CHECK(
       found->isFree() && (!mustHaveSize || found->size() >= preferredSize));
+  if (isFinalSize && freeListIndex == kNumFreeLists - 1) {
+    const int32_t size = std::max(preferredSize, kMinAlloc);
+    const int32_t spaceTaken = size + sizeof(Header);
+    if (found->size() - spaceTaken > kMaxAlloc) {
+      return allocateFromLargestFreeBlock(size);
+    }
+  }
   --numFree_;
   freeBytes_ -= found->size() + sizeof(Header);
   removeFromFreeList(found);
@@ -416,6 +423,27 @@ HashStringAllocator::Header* HashStringAllocator::allocateFromFreeList(
   return found;
 }
 
+HashStringAllocator::Header* HashStringAllocator::allocateFromLargestFreeBlock(
+    int32_t size) {
+  auto& freeList = free_[kNumFreeLists - 1];
+  auto* header = headerOf(freeList.next());
+  const int32_t spaceTaken = size + sizeof(Header);
+  VELOX_DCHECK_GT(header->size() - spaceTaken, kMaxAlloc);
+  // The entry after allocation stays in the largest free list. The size at
+  // the end of the block is changed in place.
+  reinterpret_cast<int32_t*>(header->end())[-1] -= spaceTaken;
+  auto* freeHeader =
+      new (header->begin() + size) Header(header->size() - spaceTaken);
+  freeHeader->setFree();
+  header->clearFree();
+  ::memcpy(freeHeader->begin(), header->begin(), sizeof(CompactDoubleList));
+  freeList.nextMoved(reinterpret_cast<CompactDoubleList*>(freeHeader->begin()));
+  header->setSize(size);
+  freeBytes_ -= spaceTaken;
+  cumulativeBytes_ += size;
+  return header;
+}
+
 void HashStringAllocator::free(Header* header) {
   Header* headerToFree = header;
   do {
@@ -559,26 +587,13 @@ inline bool HashStringAllocator::storeStringFast(
     header = allocateFromFreeList(roundedBytes, true, true, available);
     VELOX_CHECK_NOT_NULL(header);
   } else {
-    auto& freeList = free_[kNumFreeLists - 1];
-    header = headerOf(freeList.next());
+    header = headerOf(free_[kNumFreeLists - 1].next());
     const auto spaceTaken = roundedBytes + sizeof(Header);
     if (spaceTaken > header->size()) {
       return false;
     }
     if (header->size() - spaceTaken > kMaxAlloc) {
-      // The entry after allocation stays in the largest free list.
-      // The size at the end of the block is changed in place.
-      reinterpret_cast<int32_t*>(header->end())[-1] -= spaceTaken;
-      auto* freeHeader = new (header->begin() + roundedBytes)
-          Header(header->size() - spaceTaken);
-      freeHeader->setFree();
-      header->clearFree();
-      ::memcpy(freeHeader->begin(), header->begin(), sizeof(CompactDoubleList));
-      freeList.nextMoved(
-          reinterpret_cast<CompactDoubleList*>(freeHeader->begin()));
-      header->setSize(roundedBytes);
-      freeBytes_ -= spaceTaken;
-      cumulativeBytes_ += roundedBytes;
+      header = allocateFromLargestFreeBlock(roundedBytes);
     } else {
       header =
           allocateFromFreeList(roundedBytes, true, true, kNumFreeLists - 1);
@@ -356,6 +356,13 @@ class HashStringAllocator : public StreamArena {
 
   void removeFromFreeList(Header* header);
 
+  // Allocates 'size' bytes from the start of the first block in the largest
+  // free list. The rest of the block stays free in place without relinking or
+  // coalescing, so that consecutive small allocations are carved from a free
+  // block like from a bump allocator. The block must be larger than 'size'
+  // plus a header plus kMaxAlloc.
+  Header* allocateFromLargestFreeBlock(int32_t size);
+
   // Allocates a block of specified size. If exactSize is false, the block may
   // be smaller or larger. Checks free list before allocating new memory.
   Header* allocate(int32_t size, bool exactSize);
@@ -63,6 +63,7 @@ std::unique_ptr<MemoryArbitrator> createArbitrator(
            std::min(options.arbitratorCapacity, options.allocatorCapacity),
        .memoryPoolTransferCapacity = options.memoryPoolTransferCapacity,
        .memoryReclaimWaitMs = options.memoryReclaimWaitMs,
+       .memoryReclaimThreads = options.memoryReclaimThreads,
        .arbitrationStateCheckCb = options.arbitrationStateCheckCb,
        .checkUsageLeak = options.checkUsageLeak});
 }
@@ -76,6 +77,8 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      smallAllocationCacheEnabled_(options.smallAllocationCacheEnabled),
+      allocationSampleInterval_(options.allocationSampleInterval),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       poolGrowCb_([&](MemoryPool* pool, uint64_t targetBytes) {
         return growPool(pool, targetBytes);
@@ -96,7 +99,10 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
               .trackUsage = options.trackDefaultUsage,
               .debugEnabled = options.debugEnabled,
               .coreOnAllocationFailureEnabled =
-                  options.coreOnAllocationFailureEnabled})},
+                  options.coreOnAllocationFailureEnabled,
+              .smallAllocationCacheEnabled =
+                  options.smallAllocationCacheEnabled,
+              .allocationSampleInterval = options.allocationSampleInterval})},
       spillPool_{addLeafPool("__sys_spilling__")} {
   VELOX_CHECK_NOT_NULL(allocator_);
   VELOX_CHECK_NOT_NULL(arbitrator_);
@@ -192,6 +198,8 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.trackUsage = true;
   options.debugEnabled = debugEnabled_;
   options.coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_;
+  options.smallAllocationCacheEnabled = smallAllocationCacheEnabled_;
+  options.allocationSampleInterval = allocationSampleInterval_;
 
   std::unique_lock guard{mutex_};
   if (pools_.find(poolName) != pools_.end()) {
@@ -309,6 +317,18 @@ std::string MemoryManager::toString(bool detail) const {
   return out.str();
 }
 
+std::string MemoryManager::sampledAllocationSites(size_t maxSites) const {
+  if (allocationSampleInterval_ == 0) {
+    return "";
+  }
+  std::stringstream out;
+  out << defaultRoot_->sampledAllocationSites(maxSites);
+  for (const auto& pool : getAlivePools()) {
+    out << pool->sampledAllocationSites(maxSites);
+  }
+  return out.str();
+}
+
 std::vector<std::shared_ptr<MemoryPool>> MemoryManager::getAlivePools() const {
   std::vector<std::shared_ptr<MemoryPool>> pools;
   std::shared_lock guard{mutex_};
@@ -81,6 +81,16 @@ struct MemoryManagerOptions {
   /// Terminates the process and generates a core file on an allocation failure
   bool coreOnAllocationFailureEnabled{false};
 
+  /// If true, the leaf memory pools cache the small buffers freed through them
+  /// for reuse by later small allocations. See
+  /// MemoryPool::Options::smallAllocationCacheEnabled.
+  bool smallAllocationCacheEnabled{false};
+
+  /// If not zero, the leaf memory pools record the call stack of one in every
+  /// 'allocationSampleInterval' allocations. See
+  /// MemoryPool::Options::allocationSampleInterval.
+  uint32_t allocationSampleInterval{0};
+
   /// ================== 'MemoryAllocator' settings ==================
   /// Specifies the max memory allocation capacity in bytes enforced by
   /// MemoryAllocator, default unlimited.
@@ -163,6 +173,10 @@ struct MemoryManagerOptions {
   /// zero, then there is no timeout. The default is 5 mins.
   uint64_t memoryReclaimWaitMs{300'000};
 
+  /// If greater than zero, the number of threads used by the memory arbitrator
+  /// to reclaim memory from multiple victim memory pools concurrently.
+  uint32_t memoryReclaimThreads{0};
+
   /// Provided by the query system to validate the state after a memory pool
   /// enters arbitration if not null. For instance, Prestissimo provides
   /// callback to check if a memory arbitration request is issued from a driver
@@ -262,6 +276,11 @@ class MemoryManager {
   /// pools.
   std::string toString(bool detail = false) const;
 
+  /// Returns the top 'maxSites' sampled allocation call sites of each root
+  /// memory pool ordered by their estimated peak usage. Returns an empty
+  /// string if MemoryManagerOptions::allocationSampleInterval is not set.
+  std::string sampledAllocationSites(size_t maxSites = 10) const;
+
   /// Returns the memory manger's internal default root memory pool for testing
   /// purpose.
   MemoryPool& testingDefaultRoot() const {
@@ -301,6 +320,8 @@ class MemoryManager {
   const bool checkUsageLeak_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const bool smallAllocationCacheEnabled_;
+  const uint32_t allocationSampleInterval_;
   // The destruction callback set for the allocated root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
   // the pool from 'pools_'.
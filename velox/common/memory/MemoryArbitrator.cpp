@@ -210,6 +210,18 @@ bool MemoryReclaimer::reclaimableBytes(
   return reclaimable;
 }
 
+uint64_t MemoryReclaimer::expectedGrowthBytes(const MemoryPool& pool) const {
+  if (pool.kind() == MemoryPool::Kind::kLeaf) {
+    return 0;
+  }
+  uint64_t expectedGrowthBytes{0};
+  pool.visitChildren([&](MemoryPool* pool) {
+    expectedGrowthBytes += pool->expectedGrowthBytes();
+    return true;
+  });
+  return expectedGrowthBytes;
+}
+
 uint64_t MemoryReclaimer::reclaim(
     MemoryPool* pool,
     uint64_t targetBytes,
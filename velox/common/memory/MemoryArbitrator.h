@@ -68,6 +68,11 @@ class MemoryArbitrator {
     /// timeout.
     uint64_t memoryReclaimWaitMs{0};
 
+    /// If greater than zero, the number of threads used to reclaim memory from
+    /// multiple victim memory pools concurrently by disk spilling. Otherwise,
+    /// the victims are reclaimed one after another by the arbitration thread.
+    uint32_t memoryReclaimThreads{0};
+
     /// Provided by the query system to validate the state after a memory pool
     /// enters arbitration if not null. For instance, Prestissimo provides
     /// callback to check if a memory arbitration request is issued from a
@@ -334,6 +339,14 @@ class MemoryReclaimer {
       const MemoryPool& pool,
       uint64_t& reclaimableBytes) const;
 
+  /// Invoked by the memory arbitrator to get the number of bytes 'pool' is
+  /// expected to allocate soon beyond its current usage, e.g. the hash table
+  /// of a hash join build. The arbitrator includes these in the capacity
+  /// growth of a requestor to avoid stalling in another arbitration soon
+  /// after. The default implementation returns the sum over the child pools
+  /// for a non-leaf pool and zero for a leaf pool.
+  virtual uint64_t expectedGrowthBytes(const MemoryPool& pool) const;
+
   /// Invoked by the memory arbitrator to reclaim from memory 'pool' with
   /// specified 'targetBytes'. It is expected to reclaim at least that amount of
   /// memory bytes but there is no guarantees. If 'targetBytes' is zero, then it
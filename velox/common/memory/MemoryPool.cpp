@@ -25,6 +25,7 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/common/testutil/TestValue.h"
 
+#include <folly/hash/Hash.h>
 #include <re2/re2.h>
 
 DECLARE_bool(velox_suppress_memory_capacity_exceeding_error_message);
@@ -161,6 +162,14 @@ std::string capacityToString(int64_t capacity) {
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     leakCheckDbg();                    \
   }
+#define SAMPLE_RECORD_ALLOC(...)                        \
+  if (FOLLY_UNLIKELY(allocationSampleInterval_ != 0)) { \
+    recordAllocSample(__VA_ARGS__);                     \
+  }
+#define SAMPLE_RECORD_FREE(...)                         \
+  if (FOLLY_UNLIKELY(allocationSampleInterval_ != 0)) { \
+    recordFreeSample(__VA_ARGS__);                      \
+  }
 } // namespace
 
 std::string MemoryPool::Stats::toString() const {
@@ -222,7 +231,9 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       debugEnabled_(options.debugEnabled),
-      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled) {
+      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      smallAllocationCacheEnabled_(options.smallAllocationCacheEnabled),
+      allocationSampleInterval_(options.allocationSampleInterval) {
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
@@ -425,9 +436,15 @@ MemoryPoolImpl::MemoryPoolImpl(
       isRoot() || (destructionCb_ == nullptr && growCapacityCb_ == nullptr),
       "Only root memory pool allows to set destruction and capacity grow callbacks: {}",
       name_);
+  if (smallAllocationCacheEnabled_ && isLeaf() && !debugEnabled_ &&
+      alignment_ <= kMinSmallAllocationCacheSize) {
+    smallAllocationCache_ = std::make_unique<SmallAllocationCacheShard[]>(
+        kNumSmallAllocationCacheShards);
+  }
 }
 
 MemoryPoolImpl::~MemoryPoolImpl() {
+  flushSmallAllocationCache();
   DEBUG_LEAK_CHECK();
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
@@ -484,59 +501,72 @@ MemoryPool::Stats MemoryPoolImpl::statsLocked() const {
 
 void* MemoryPoolImpl::allocate(int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
-  const auto alignedSize = sizeAlign(size);
-  reserve(alignedSize);
-  void* buffer = allocator_->allocateBytes(alignedSize, alignment_);
-  if (FOLLY_UNLIKELY(buffer == nullptr)) {
-    release(alignedSize);
-    handleAllocationFailure(fmt::format(
-        "{} failed with {} from {} {}",
-        __FUNCTION__,
-        succinctBytes(size),
-        toString(),
-        allocator_->getAndClearFailureMessage()));
+  const auto alignedSize = allocationSize(size);
+  void* buffer = allocateFromCache(alignedSize);
+  if (buffer == nullptr) {
+    reserve(alignedSize);
+    buffer = allocator_->allocateBytes(alignedSize, alignment_);
+    if (FOLLY_UNLIKELY(buffer == nullptr)) {
+      release(alignedSize);
+      handleAllocationFailure(fmt::format(
+          "{} failed with {} from {} {}",
+          __FUNCTION__,
+          succinctBytes(size),
+          toString(),
+          allocator_->getAndClearFailureMessage()));
+    }
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  SAMPLE_RECORD_ALLOC(buffer, size);
   return buffer;
 }
 
 void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   const auto size = sizeEach * numEntries;
-  const auto alignedSize = sizeAlign(size);
-  reserve(alignedSize);
-  void* buffer = allocator_->allocateZeroFilled(alignedSize);
-  if (FOLLY_UNLIKELY(buffer == nullptr)) {
-    release(alignedSize);
-    handleAllocationFailure(fmt::format(
-        "{} failed with {} entries and {} each from {} {}",
-        __FUNCTION__,
-        numEntries,
-        succinctBytes(sizeEach),
-        toString(),
-        allocator_->getAndClearFailureMessage()));
+  const auto alignedSize = allocationSize(size);
+  void* buffer = allocateFromCache(alignedSize);
+  if (buffer != nullptr) {
+    ::memset(buffer, 0, size);
+  } else {
+    reserve(alignedSize);
+    buffer = allocator_->allocateZeroFilled(alignedSize);
+    if (FOLLY_UNLIKELY(buffer == nullptr)) {
+      release(alignedSize);
+      handleAllocationFailure(fmt::format(
+          "{} failed with {} entries and {} each from {} {}",
+          __FUNCTION__,
+          numEntries,
+          succinctBytes(sizeEach),
+          toString(),
+          allocator_->getAndClearFailureMessage()));
+    }
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  SAMPLE_RECORD_ALLOC(buffer, size);
   return buffer;
 }
 
 void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
-  const auto alignedNewSize = sizeAlign(newSize);
-  reserve(alignedNewSize);
-
-  void* newP = allocator_->allocateBytes(alignedNewSize, alignment_);
-  if (FOLLY_UNLIKELY(newP == nullptr)) {
-    release(alignedNewSize);
-    handleAllocationFailure(fmt::format(
-        "{} failed with new {} and old {} from {} {}",
-        __FUNCTION__,
-        succinctBytes(newSize),
-        succinctBytes(size),
-        toString(),
-        allocator_->getAndClearFailureMessage()));
+  const auto alignedNewSize = allocationSize(newSize);
+  void* newP = allocateFromCache(alignedNewSize);
+  if (newP == nullptr) {
+    reserve(alignedNewSize);
+    newP = allocator_->allocateBytes(alignedNewSize, alignment_);
+    if (FOLLY_UNLIKELY(newP == nullptr)) {
+      release(alignedNewSize);
+      handleAllocationFailure(fmt::format(
+          "{} failed with new {} and old {} from {} {}",
+          __FUNCTION__,
+          succinctBytes(newSize),
+          succinctBytes(size),
+          toString(),
+          allocator_->getAndClearFailureMessage()));
+    }
   }
   DEBUG_RECORD_ALLOC(newP, newSize);
+  SAMPLE_RECORD_ALLOC(newP, newSize);
   if (p != nullptr) {
     ::memcpy(newP, p, std::min(size, newSize));
     free(p, size);
@@ -546,12 +576,69 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
 
 void MemoryPoolImpl::free(void* p, int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
-  const auto alignedSize = sizeAlign(size);
+  const auto alignedSize = allocationSize(size);
   DEBUG_RECORD_FREE(p, size);
+  SAMPLE_RECORD_FREE(p);
+  if (freeToCache(p, alignedSize)) {
+    return;
+  }
   allocator_->freeBytes(p, alignedSize);
   release(alignedSize);
 }
 
+void* MemoryPoolImpl::allocateFromCache(int64_t allocationSize) {
+  if (smallAllocationCache_ == nullptr ||
+      allocationSize < kMinSmallAllocationCacheSize ||
+      allocationSize > kMaxSmallAllocationCacheSize) {
+    return nullptr;
+  }
+  const auto sizeClass = smallAllocationCacheClass(allocationSize);
+  auto& shard = smallAllocationCache_[smallAllocationCacheShard()];
+  std::lock_guard<std::mutex> l(shard.mutex);
+  auto& numBuffers = shard.numBuffers[sizeClass];
+  if (numBuffers == 0) {
+    return nullptr;
+  }
+  return shard.buffers[sizeClass][--numBuffers];
+}
+
+bool MemoryPoolImpl::freeToCache(void* p, int64_t allocationSize) {
+  if (smallAllocationCache_ == nullptr ||
+      allocationSize < kMinSmallAllocationCacheSize ||
+      allocationSize > kMaxSmallAllocationCacheSize) {
+    return false;
+  }
+  const auto sizeClass = smallAllocationCacheClass(allocationSize);
+  auto& shard = smallAllocationCache_[smallAllocationCacheShard()];
+  std::lock_guard<std::mutex> l(shard.mutex);
+  auto& numBuffers = shard.numBuffers[sizeClass];
+  if (numBuffers == kSmallAllocationCacheClassCapacity) {
+    return false;
+  }
+  shard.buffers[sizeClass][numBuffers++] = p;
+  return true;
+}
+
+void MemoryPoolImpl::flushSmallAllocationCache() {
+  if (smallAllocationCache_ == nullptr) {
+    return;
+  }
+  for (int32_t i = 0; i < kNumSmallAllocationCacheShards; ++i) {
+    auto& shard = smallAllocationCache_[i];
+    std::lock_guard<std::mutex> l(shard.mutex);
+    for (int32_t sizeClass = 0; sizeClass < kNumSmallAllocationCacheClasses;
+         ++sizeClass) {
+      const int64_t bufferSize = kMinSmallAllocationCacheSize << sizeClass;
+      auto& numBuffers = shard.numBuffers[sizeClass];
+      for (int32_t j = 0; j < numBuffers; ++j) {
+        allocator_->freeBytes(shard.buffers[sizeClass][j], bufferSize);
+        release(bufferSize);
+      }
+      numBuffers = 0;
+    }
+  }
+}
+
 void MemoryPoolImpl::allocateNonContiguous(
     MachinePageCount numPages,
     Allocation& out,
@@ -565,6 +652,7 @@ void MemoryPoolImpl::allocateNonContiguous(
       "facebook::velox::common::memory::MemoryPoolImpl::allocateNonContiguous",
       this);
   DEBUG_RECORD_FREE(out);
+  SAMPLE_RECORD_FREE(out);
   if (!allocator_->allocateNonContiguous(
           numPages,
           out,
@@ -585,6 +673,7 @@ void MemoryPoolImpl::allocateNonContiguous(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(out);
+  SAMPLE_RECORD_ALLOC(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -593,6 +682,7 @@ void MemoryPoolImpl::allocateNonContiguous(
 void MemoryPoolImpl::freeNonContiguous(Allocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   DEBUG_RECORD_FREE(allocation);
+  SAMPLE_RECORD_FREE(allocation);
   const int64_t freedBytes = allocator_->freeNonContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(freedBytes);
@@ -616,6 +706,7 @@ void MemoryPoolImpl::allocateContiguous(
   }
   VELOX_CHECK_GT(numPages, 0);
   DEBUG_RECORD_FREE(out);
+  SAMPLE_RECORD_FREE(out);
   if (!allocator_->allocateContiguous(
           numPages,
           nullptr,
@@ -637,6 +728,7 @@ void MemoryPoolImpl::allocateContiguous(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(out);
+  SAMPLE_RECORD_ALLOC(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -646,6 +738,7 @@ void MemoryPoolImpl::freeContiguous(ContiguousAllocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   const int64_t bytesToFree = allocation.size();
   DEBUG_RECORD_FREE(allocation);
+  SAMPLE_RECORD_FREE(allocation);
   allocator_->freeContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(bytesToFree);
@@ -701,7 +794,9 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .debugEnabled = debugEnabled_,
-          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_});
+          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .smallAllocationCacheEnabled = smallAllocationCacheEnabled_,
+          .allocationSampleInterval = allocationSampleInterval_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -821,14 +916,15 @@ bool MemoryPoolImpl::incrementReservationThreadSafe(
   }
   VELOX_MEM_POOL_CAP_EXCEEDED(fmt::format(
       "Exceeded memory pool cap of {} with max {} when requesting {}, memory "
-      "manager cap is {}, requestor '{}' with current usage {}\n{}",
+      "manager cap is {}, requestor '{}' with current usage {}\n{}{}",
       capacityToString(capacity()),
       capacityToString(maxCapacity_),
       succinctBytes(size),
       capacityToString(manager_->capacity()),
       requestor->name(),
       succinctBytes(requestor->currentBytes()),
-      treeMemoryUsage()));
+      treeMemoryUsage(),
+      sampledAllocationSites()));
 }
 
 bool MemoryPoolImpl::maybeIncrementReservation(uint64_t size) {
@@ -856,6 +952,7 @@ bool MemoryPoolImpl::maybeIncrementReservation(uint64_t size) {
 
 void MemoryPoolImpl::release() {
   CHECK_AND_INC_MEM_OP_STATS(Releases);
+  flushSmallAllocationCache();
   release(0, true);
 }
 
@@ -992,6 +1089,13 @@ std::optional<uint64_t> MemoryPoolImpl::reclaimableBytes() const {
   return reclaimableBytes;
 }
 
+uint64_t MemoryPoolImpl::expectedGrowthBytes() const {
+  if (reclaimer() == nullptr) {
+    return 0;
+  }
+  return reclaimer()->expectedGrowthBytes(*this);
+}
+
 uint64_t MemoryPoolImpl::reclaim(
     uint64_t targetBytes,
     uint64_t maxWaitMs,
@@ -1192,6 +1296,121 @@ void MemoryPoolImpl::leakCheckDbg() {
   VELOX_FAIL(buf.str());
 }
 
+void MemoryPoolImpl::recordAllocSample(const void* addr, uint64_t size) {
+  if (addr == nullptr ||
+      (++numSampleCandidates_ % allocationSampleInterval_) != 0) {
+    return;
+  }
+  process::StackTrace callStack;
+  const auto& frames = callStack.getStack();
+  const uint64_t siteKey =
+      folly::hash::hash_range(frames.begin(), frames.end());
+  std::lock_guard<std::mutex> l(sampledAllocMutex_);
+  auto& site = sampledAllocSites_[siteKey];
+  if (site.numSamples++ == 0) {
+    site.poolName = name_;
+    site.callStack = std::move(callStack);
+  }
+  site.liveBytes += size;
+  site.peakBytes = std::max(site.peakBytes, site.liveBytes);
+  const auto addrUint64 = reinterpret_cast<uint64_t>(addr);
+  if (sampledAllocs_.emplace(addrUint64, std::make_pair(size, siteKey))
+          .second) {
+    ++numSampledAllocs_;
+  }
+}
+
+void MemoryPoolImpl::recordAllocSample(const Allocation& allocation) {
+  if (allocation.empty()) {
+    return;
+  }
+  recordAllocSample(allocation.runAt(0).data(), allocation.byteSize());
+}
+
+void MemoryPoolImpl::recordAllocSample(const ContiguousAllocation& allocation) {
+  if (allocation.empty()) {
+    return;
+  }
+  recordAllocSample(allocation.data(), allocation.size());
+}
+
+void MemoryPoolImpl::recordFreeSample(const void* addr) {
+  if (addr == nullptr || numSampledAllocs_ == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(sampledAllocMutex_);
+  auto it = sampledAllocs_.find(reinterpret_cast<uint64_t>(addr));
+  if (it == sampledAllocs_.end()) {
+    return;
+  }
+  const auto [size, siteKey] = it->second;
+  sampledAllocSites_[siteKey].liveBytes -= size;
+  sampledAllocs_.erase(it);
+  --numSampledAllocs_;
+}
+
+void MemoryPoolImpl::recordFreeSample(const Allocation& allocation) {
+  if (allocation.empty()) {
+    return;
+  }
+  recordFreeSample(allocation.runAt(0).data());
+}
+
+void MemoryPoolImpl::recordFreeSample(const ContiguousAllocation& allocation) {
+  if (allocation.empty()) {
+    return;
+  }
+  recordFreeSample(allocation.data());
+}
+
+void MemoryPoolImpl::collectSampledAllocationSites(
+    std::vector<SampledAllocationSite>& sites) const {
+  if (!isLeaf()) {
+    visitChildren([&](MemoryPool* child) {
+      toImpl(child)->collectSampledAllocationSites(sites);
+      return true;
+    });
+    return;
+  }
+  std::lock_guard<std::mutex> l(sampledAllocMutex_);
+  for (const auto& [_, site] : sampledAllocSites_) {
+    sites.push_back(site);
+  }
+}
+
+std::string MemoryPoolImpl::sampledAllocationSites(size_t maxSites) const {
+  if (allocationSampleInterval_ == 0) {
+    return "";
+  }
+  std::vector<SampledAllocationSite> sites;
+  collectSampledAllocationSites(sites);
+  if (sites.empty()) {
+    return "";
+  }
+  std::sort(
+      sites.begin(),
+      sites.end(),
+      [](const SampledAllocationSite& lhs, const SampledAllocationSite& rhs) {
+        return lhs.peakBytes > rhs.peakBytes;
+      });
+  if (sites.size() > maxSites) {
+    sites.resize(maxSites);
+  }
+  std::stringstream out;
+  out << "Top " << sites.size() << " sampled allocation sites of '" << name_
+      << "' by peak usage, sampled 1 in " << allocationSampleInterval_
+      << " allocations:\n";
+  for (const auto& site : sites) {
+    out << "======== " << site.poolName << " peak ~"
+        << succinctBytes(site.peakBytes * allocationSampleInterval_)
+        << " live ~"
+        << succinctBytes(site.liveBytes * allocationSampleInterval_)
+        << " samples " << site.numSamples << " ========\n"
+        << site.callStack.toString();
+  }
+  return out.str();
+}
+
 void MemoryPoolImpl::handleAllocationFailure(
     const std::string& failureMessage) {
   if (coreOnAllocationFailureEnabled_) {
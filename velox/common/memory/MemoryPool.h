@@ -21,8 +21,10 @@
 #include <memory>
 #include <optional>
 #include <queue>
+#include <thread>
 
 #include <fmt/format.h>
+#include <folly/container/F14Map.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
@@ -156,6 +158,20 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// Terminates the process and generates a core file on an allocation
     /// failure
     bool coreOnAllocationFailureEnabled{false};
+
+    /// If true, a leaf memory pool keeps the small buffers freed through it in
+    /// per-thread caches and serves later small allocations from these without
+    /// going through the memory reservation and the allocator. The cached
+    /// buffers stay charged to the pool until it is released or destroyed.
+    /// The setting applies to all the child pools of a root memory pool.
+    bool smallAllocationCacheEnabled{false};
+
+    /// If not zero, a leaf memory pool records the call stack of one in every
+    /// 'allocationSampleInterval' allocations until it is freed. The sampled
+    /// call sites attribute the memory usage, peak and leaks of the pool to the
+    /// code allocating it. See sampledAllocationSites(). The setting applies to
+    /// all the child pools of a root memory pool.
+    uint32_t allocationSampleInterval{0};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -391,6 +407,12 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// reclaimer.
   virtual std::optional<uint64_t> reclaimableBytes() const = 0;
 
+  /// Returns the number of bytes this memory pool expects to allocate soon
+  /// beyond its current usage. The function returns zero if the 'reclaimer'
+  /// is not set. Otherwise, it will invoke the corresponding method of the
+  /// reclaimer.
+  virtual uint64_t expectedGrowthBytes() const = 0;
+
   /// Invoked by the memory arbitrator to reclaim memory from this memory pool
   /// with specified reclaim target bytes. If 'targetBytes' is zero, then it
   /// tries to reclaim all the reclaimable memory from the memory pool. It is
@@ -476,6 +498,12 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// print out the child memory pools with empty memory usage.
   virtual std::string treeMemoryUsage(bool skipEmptyPool = true) const = 0;
 
+  /// Returns up to 'maxSites' call sites of the sampled allocations from the
+  /// leaf memory pools in the subtree rooted at this pool, ordered by their
+  /// estimated peak usage. Returns an empty string if there are no sampled
+  /// allocations. See Options::allocationSampleInterval.
+  virtual std::string sampledAllocationSites(size_t maxSites = 10) const = 0;
+
   /// Indicates if this is a leaf memory pool or not.
   FOLLY_ALWAYS_INLINE bool isLeaf() const {
     return kind_ == Kind::kLeaf;
@@ -527,6 +555,8 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const bool smallAllocationCacheEnabled_;
+  const uint32_t allocationSampleInterval_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -639,6 +669,8 @@ class MemoryPoolImpl : public MemoryPool {
 
   std::optional<uint64_t> reclaimableBytes() const override;
 
+  uint64_t expectedGrowthBytes() const override;
+
   uint64_t reclaim(
       uint64_t targetBytes,
       uint64_t maxWaitMs,
@@ -680,6 +712,8 @@ class MemoryPoolImpl : public MemoryPool {
   ///     op.0.0.0.Values usage 0B peak 0B
   std::string treeMemoryUsage(bool skipEmptyPool = true) const override;
 
+  std::string sampledAllocationSites(size_t maxSites = 10) const override;
+
   Stats stats() const override;
 
   void testingSetCapacity(int64_t bytes);
@@ -755,6 +789,44 @@ class MemoryPoolImpl : public MemoryPool {
     return (remainder == 0) ? size : (size + alignment_ - remainder);
   }
 
+  // Returns the number of bytes to allocate for a buffer of 'size'. Small
+  // sizes are rounded up to their size class in 'smallAllocationCache_' if
+  // set.
+  FOLLY_ALWAYS_INLINE int64_t allocationSize(int64_t size) {
+    if (smallAllocationCache_ == nullptr || size <= 0 ||
+        size > kMaxSmallAllocationCacheSize) {
+      return sizeAlign(size);
+    }
+    return std::max<int64_t>(
+        kMinSmallAllocationCacheSize, bits::nextPowerOfTwo(size));
+  }
+
+  // Returns the size class in 'smallAllocationCache_' of a power of two
+  // 'allocationSize'.
+  static int32_t smallAllocationCacheClass(int64_t allocationSize) {
+    return __builtin_ctzll(allocationSize) -
+        __builtin_ctzll(kMinSmallAllocationCacheSize);
+  }
+
+  // Returns the shard in 'smallAllocationCache_' of the calling thread.
+  static int32_t smallAllocationCacheShard() {
+    const size_t hash =
+        std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return hash & (kNumSmallAllocationCacheShards - 1);
+  }
+
+  // Returns a cached buffer of 'allocationSize' bytes from the shard of the
+  // calling thread, or nullptr if there is none.
+  void* allocateFromCache(int64_t allocationSize);
+
+  // Keeps buffer 'p' of 'allocationSize' bytes in the shard of the calling
+  // thread for reuse. Returns false if the buffer is not cacheable or the
+  // shard is full, in which case the caller frees it.
+  bool freeToCache(void* p, int64_t allocationSize);
+
+  // Frees all the cached buffers and releases their memory reservation.
+  void flushSmallAllocationCache();
+
   // Returns a rounded up delta based on adding 'delta' to 'size'. Adding the
   // rounded delta to 'size' will result in 'size' a quantized size, rounded to
   // the MB or 8MB for larger sizes.
@@ -977,6 +1049,42 @@ class MemoryPoolImpl : public MemoryPool {
   // pool is enabled.
   void leakCheckDbg();
 
+  // Invoked to record the call stack of every 'allocationSampleInterval_'th
+  // buffer allocation if allocation sampling of this memory pool is enabled.
+  void recordAllocSample(const void* addr, uint64_t size);
+
+  // Invoked to record the call stack of every 'allocationSampleInterval_'th
+  // non-contiguous allocation if allocation sampling is enabled.
+  void recordAllocSample(const Allocation& allocation);
+
+  // Invoked to record the call stack of every 'allocationSampleInterval_'th
+  // contiguous allocation if allocation sampling is enabled.
+  void recordAllocSample(const ContiguousAllocation& allocation);
+
+  // Invoked to drop the sampled allocation at 'addr' on free if there is one.
+  void recordFreeSample(const void* addr);
+
+  void recordFreeSample(const Allocation& allocation);
+
+  void recordFreeSample(const ContiguousAllocation& allocation);
+
+  // The usage of one sampled allocation call site from a leaf memory pool.
+  struct SampledAllocationSite {
+    std::string poolName;
+    process::StackTrace callStack;
+    // The number of sampled allocations from this call site.
+    uint64_t numSamples{0};
+    // The sampled bytes allocated and not yet freed from this call site.
+    uint64_t liveBytes{0};
+    // The max of 'liveBytes' over the lifetime of the memory pool.
+    uint64_t peakBytes{0};
+  };
+
+  // Appends the sampled allocation sites of the leaf memory pools in the
+  // subtree rooted at this pool to 'sites'.
+  void collectSampledAllocationSites(
+      std::vector<SampledAllocationSite>& sites) const;
+
   void handleAllocationFailure(const std::string& failureMessage);
 
   MemoryManager* const manager_;
@@ -1043,11 +1151,56 @@ class MemoryPoolImpl : public MemoryPool {
   // NOTE: this only applies for root memory pool.
   std::atomic_uint64_t numCapacityGrowths_{0};
 
+  // The smallest and largest buffer sizes kept in 'smallAllocationCache_'.
+  // The size classes are the powers of two in between.
+  static constexpr int64_t kMinSmallAllocationCacheSize = 64;
+  static constexpr int64_t kMaxSmallAllocationCacheSize = 4096;
+  static constexpr int32_t kNumSmallAllocationCacheClasses = 7;
+  // The max number of buffers cached per size class and shard.
+  static constexpr int32_t kSmallAllocationCacheClassCapacity = 16;
+  static constexpr int32_t kNumSmallAllocationCacheShards = 8;
+
+  // The cached small buffers of the threads hashed to one shard. The buffers
+  // stay charged to the pool while cached.
+  struct alignas(folly::hardware_destructive_interference_size)
+      SmallAllocationCacheShard {
+    std::mutex mutex;
+    std::array<int32_t, kNumSmallAllocationCacheClasses> numBuffers{};
+    std::array<
+        std::array<void*, kSmallAllocationCacheClassCapacity>,
+        kNumSmallAllocationCacheClasses>
+        buffers;
+  };
+
+  // Set for a leaf pool with 'smallAllocationCacheEnabled_' unless in debug
+  // mode, which tracks each allocation and free.
+  std::unique_ptr<SmallAllocationCacheShard[]> smallAllocationCache_;
+
   // Mutex for 'debugAllocRecords_'.
   std::mutex debugAllocMutex_;
 
   // Map from address to 'AllocationRecord'.
   std::unordered_map<uint64_t, AllocationRecord> debugAllocRecords_;
+
+  // The number of allocations counted for sampling if
+  // 'allocationSampleInterval_' is set.
+  std::atomic_uint64_t numSampleCandidates_{0};
+
+  // The number of entries in 'sampledAllocs_'. Checked first to skip the
+  // lookup on free if there are no sampled allocations.
+  std::atomic_uint64_t numSampledAllocs_{0};
+
+  // Mutex for 'sampledAllocs_' and 'sampledAllocSites_'.
+  mutable std::mutex sampledAllocMutex_;
+
+  // Map from address of a sampled allocation to its size and the key of its
+  // call site in 'sampledAllocSites_'.
+  folly::F14FastMap<uint64_t, std::pair<uint64_t, uint64_t>> sampledAllocs_;
+
+  // Map from the hash of the call stack frames to the sampled allocation
+  // site. The sites are kept after their allocations are freed to report
+  // their peak usage.
+  folly::F14FastMap<uint64_t, SampledAllocationSite> sampledAllocSites_;
 };
 
 /// An Allocator backed by a memory pool for STL containers.
@@ -23,6 +23,8 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/Memory.h"
 
+DECLARE_bool(velox_memory_use_hugepages);
+
 namespace facebook::velox::memory {
 MmapAllocator::MmapAllocator(const Options& options)
     : kind_(MemoryAllocator::Kind::kMmap),
@@ -522,9 +524,17 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
       0,
       "Sizeclass {} must have a multiple of 64 capacity",
       unitSize_);
+  // Size classes with units of at least half a huge page hold the large runs
+  // of hash tables and row containers. Their range starts at a huge page
+  // boundary so that pairs of units can be backed by transparent huge pages.
+  const bool hugePages = FLAGS_velox_memory_use_hugepages &&
+      AllocationTraits::pageBytes(unitSize_) * 2 >=
+          AllocationTraits::kHugePageSize;
+  const auto mapBytes =
+      byteSize_ + (hugePages ? AllocationTraits::kHugePageSize : 0);
   void* ptr = mmap(
       nullptr,
-      AllocationTraits::pageBytes(capacity_ * unitSize_),
+      mapBytes,
       PROT_READ | PROT_WRITE,
       MAP_PRIVATE | MAP_ANONYMOUS,
       -1,
@@ -537,6 +547,25 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (hugePages) {
+    // Unmaps the unaligned head and the tail of the mapping.
+    auto* aligned = reinterpret_cast<uint8_t*>(bits::roundUp(
+        reinterpret_cast<uintptr_t>(ptr), AllocationTraits::kHugePageSize));
+    if (aligned > address_) {
+      ::munmap(address_, aligned - address_);
+    }
+    const auto tailBytes = address_ + mapBytes - (aligned + byteSize_);
+    if (tailBytes > 0) {
+      ::munmap(aligned + byteSize_, tailBytes);
+    }
+    address_ = aligned;
+#ifdef linux
+    if (::madvise(address_, byteSize_, MADV_HUGEPAGE) != 0) {
+      VELOX_MEM_LOG(WARNING)
+          << "madvise hugepage errno=" << folly::errnoStr(errno);
+    }
+#endif
+  }
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
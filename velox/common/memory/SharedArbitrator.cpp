@@ -16,11 +16,15 @@
 
 #include "velox/common/memory/SharedArbitrator.h"
 
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/process/TimelineRecorder.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 
@@ -60,7 +64,7 @@ std::string memoryPoolAbortMessage(
         << "' tried to grow " << succinctBytes(growBytes) << "\n";
   }
   out << "Memory usage of the failed memory pool:\n"
-      << victim->treeMemoryUsage();
+      << victim->treeMemoryUsage() << victim->sampledAllocationSites();
   return out.str();
 }
 
@@ -170,6 +174,11 @@ const SharedArbitrator::Candidate& findCandidateWithLargestCapacity(
 
 SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
     : MemoryArbitrator(config), freeCapacity_(capacity_) {
+  if (config.memoryReclaimThreads > 0) {
+    memoryReclaimExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        config.memoryReclaimThreads,
+        std::make_shared<folly::NamedThreadFactory>("MemoryReclaim"));
+  }
   RECORD_METRIC_VALUE(kMetricArbitratorFreeCapacityBytes, freeCapacity_);
   VELOX_CHECK_EQ(kind_, config.kind);
 }
@@ -399,9 +408,13 @@ bool SharedArbitrator::arbitrateMemory(
     uint64_t targetBytes) {
   VELOX_CHECK(!requestor->aborted());
 
+  // NOTE: the requestor also grows by its expected growth which might be
+  // reclaimed from the other candidates before it stalls on allocation.
   const uint64_t growTarget = std::min(
       maxGrowBytes(*requestor),
-      std::max(memoryPoolTransferCapacity_, targetBytes));
+      std::max(
+          memoryPoolTransferCapacity_,
+          targetBytes + requestor->expectedGrowthBytes()));
   uint64_t freedBytes = decrementFreeCapacity(growTarget);
   if (freedBytes >= targetBytes) {
     requestor->grow(freedBytes);
@@ -484,6 +497,9 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesBySpill(
     uint64_t targetBytes) {
   // Sort candidate memory pools based on their reclaimable memory.
   sortCandidatesByReclaimableMemory(candidates);
+  if (memoryReclaimExecutor_ != nullptr) {
+    return reclaimUsedMemoryFromCandidatesInParallel(candidates, targetBytes);
+  }
 
   int64_t freedBytes{0};
   for (const auto& candidate : candidates) {
@@ -503,6 +519,60 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesBySpill(
   return freedBytes;
 }
 
+uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesInParallel(
+    const std::vector<Candidate>& candidates,
+    uint64_t targetBytes) {
+  // NOTE: the reclaim threads run under the arbitration context of this
+  // thread to allow the spilling memory pools to overuse their capacity.
+  const auto* arbitrationCtx = memoryArbitrationContext();
+  const MemoryPool* requestor =
+      arbitrationCtx != nullptr ? arbitrationCtx->requestor : nullptr;
+
+  std::vector<std::shared_ptr<AsyncSource<uint64_t>>> reclaimTasks;
+  int64_t bytesToAssign = targetBytes;
+  for (const auto& candidate : candidates) {
+    if (bytesToAssign <= 0 || !candidate.reclaimable ||
+        candidate.reclaimableBytes == 0) {
+      break;
+    }
+    const uint64_t bytesToReclaim = std::max<uint64_t>(
+        std::min<uint64_t>(bytesToAssign, candidate.reclaimableBytes),
+        memoryPoolTransferCapacity_);
+    bytesToAssign -= bytesToReclaim;
+    reclaimTasks.push_back(std::make_shared<AsyncSource<uint64_t>>(
+        [this, requestor, pool = candidate.pool, bytesToReclaim]() {
+          ScopedMemoryArbitrationContext arbitrationCtx(requestor);
+          return std::make_unique<uint64_t>(
+              reclaim(pool, bytesToReclaim, false));
+        }));
+  }
+  if (reclaimTasks.empty()) {
+    return 0;
+  }
+
+  uint64_t reclaimTimeUs{0};
+  uint64_t freedBytes{0};
+  {
+    MicrosecondTimer reclaimTimer(&reclaimTimeUs);
+    if (reclaimTasks.size() > 1) {
+      for (auto& reclaimTask : reclaimTasks) {
+        memoryReclaimExecutor_->add(
+            [source = reclaimTask]() { source->prepare(); });
+      }
+    }
+    // NOTE: reclaim() doesn't throw and move() runs a task on this thread if
+    // no executor thread has started it yet.
+    for (auto& reclaimTask : reclaimTasks) {
+      freedBytes += *reclaimTask->move();
+    }
+  }
+  RECORD_HISTOGRAM_METRIC_VALUE(
+      kMetricArbitratorReclaimParallelism, reclaimTasks.size());
+  RECORD_HISTOGRAM_METRIC_VALUE(
+      kMetricArbitratorReclaimTimeMs, reclaimTimeUs / 1'000);
+  return freedBytes;
+}
+
 uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesByAbort(
     std::vector<Candidate>& candidates,
     uint64_t targetBytes) {
@@ -716,6 +786,7 @@ SharedArbitrator::ScopedArbitration::~ScopedArbitration() {
       kMemoryArbitrationWallNanos,
       RuntimeCounter(arbitrationTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
   arbitrator_->arbitrationTimeUs_ += arbitrationTimeUs;
+  process::recordThreadEvent("memory", "arbitration", arbitrationTimeUs);
   arbitrator_->finishArbitration();
 }
 
@@ -18,6 +18,8 @@
 
 #include "velox/common/memory/MemoryArbitrator.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/common/memory/Memory.h"
 
@@ -154,6 +156,15 @@ class SharedArbitrator : public memory::MemoryArbitrator {
       std::vector<Candidate>& candidates,
       uint64_t targetBytes);
 
+  // Invoked by reclaimUsedMemoryFromCandidatesBySpill() with
+  // 'memoryReclaimExecutor_' set. Picks the candidates with the most
+  // reclaimable memory which together cover 'targetBytes' and reclaims from
+  // them concurrently on 'memoryReclaimExecutor_'. 'candidates' are sorted by
+  // reclaimable memory.
+  uint64_t reclaimUsedMemoryFromCandidatesInParallel(
+      const std::vector<Candidate>& candidates,
+      uint64_t targetBytes);
+
   // Invoded to reclaim used memroy capacity from 'candidates' by aborting the
   // top memory users' queries.
   uint64_t reclaimUsedMemoryFromCandidatesByAbort(
@@ -199,6 +210,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   void incrementGlobalArbitrationCount();
   void incrementLocalArbitrationCount();
 
+  // Runs the concurrent memory reclaims from multiple victims if set.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> memoryReclaimExecutor_;
+
   mutable std::mutex mutex_;
   uint64_t freeCapacity_{0};
   // Indicates if there is a running arbitration request or not.
@@ -210,14 +224,16 @@ class SharedArbitrator : public memory::MemoryArbitrator {
 
   tsan_atomic<uint64_t> numRequests_{0};
   std::atomic<uint64_t> numSucceeded_{0};
-  tsan_atomic<uint64_t> numAborted_{0};
+  std::atomic<uint64_t> numAborted_{0};
   tsan_atomic<uint64_t> numFailures_{0};
   tsan_atomic<uint64_t> queueTimeUs_{0};
   tsan_atomic<uint64_t> arbitrationTimeUs_{0};
-  tsan_atomic<uint64_t> numShrunkBytes_{0};
-  tsan_atomic<uint64_t> numReclaimedBytes_{0};
-  tsan_atomic<uint64_t> reclaimTimeUs_{0};
-  tsan_atomic<uint64_t> numNonReclaimableAttempts_{0};
+  // NOTE: updated by the concurrent memory reclaims on
+  // 'memoryReclaimExecutor_'.
+  std::atomic<uint64_t> numShrunkBytes_{0};
+  std::atomic<uint64_t> numReclaimedBytes_{0};
+  std::atomic<uint64_t> reclaimTimeUs_{0};
+  std::atomic<uint64_t> numNonReclaimableAttempts_{0};
   tsan_atomic<uint64_t> numReserves_{0};
   tsan_atomic<uint64_t> numReleases_{0};
 };
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MmapAllocator.h"
 
@@ -95,6 +96,57 @@ TEST_F(ByteStreamTest, outputStream) {
   EXPECT_EQ(0, mmapAllocator_->numAllocated());
 }
 
+TEST_F(ByteStreamTest, outputStreamByReference) {
+  auto arena = std::make_shared<StreamArena>(pool_.get());
+  ByteOutputStream data(arena.get());
+  data.startWrite(100'000);
+  std::string dataString(100'000, 'x');
+  for (size_t i = 0; i < dataString.size(); ++i) {
+    dataString[i] = 'a' + i % 26;
+  }
+  data.appendStringView(std::string_view(dataString));
+
+  auto out = std::make_unique<IOBufOutputStream>(arena);
+  std::stringstream referenceSStream;
+  auto reference = std::make_unique<OStreamOutputStream>(&referenceSStream);
+  for (auto* stream : std::vector<OutputStream*>{out.get(), reference.get()}) {
+    stream->write("header", 6);
+    stream->write("00000000", 8);
+    data.flush(stream);
+    stream->write("trailer", 7);
+  }
+  ASSERT_EQ(reference->tellp(), out->tellp());
+  const auto end = out->tellp();
+  VELOX_ASSERT_THROW(
+      out->seekp(6 + 8 + 10), "Cannot seek into bytes added by reference");
+  for (auto* stream : std::vector<OutputStream*>{out.get(), reference.get()}) {
+    stream->seekp(6);
+    stream->write("checksum", 8);
+    stream->seekp(end);
+  }
+  ASSERT_EQ(end, out->tellp());
+
+  auto iobuf = out->getIOBuf();
+  // The ranges of 'data' are in the chain without copy.
+  bool hasDataRange = false;
+  for (auto range : *iobuf) {
+    hasDataRange |= range.data() == data.ranges()[0].buffer;
+  }
+  ASSERT_TRUE(hasDataRange);
+  auto coalesced = iobuf->clone()->coalesce();
+  ASSERT_EQ(
+      referenceSStream.str(),
+      std::string(
+          reinterpret_cast<const char*>(coalesced.data()), coalesced.size()));
+
+  // A stream with another arena copies.
+  IOBufOutputStream copyOut(*pool_);
+  data.flush(&copyOut);
+  for (auto range : *copyOut.getIOBuf()) {
+    ASSERT_NE(range.data(), data.ranges()[0].buffer);
+  }
+}
+
 TEST_F(ByteStreamTest, inputStream) {
   uint8_t* const kFakeBuffer = reinterpret_cast<uint8_t*>(this);
   std::vector<ByteRange> byteRanges;
@@ -252,6 +304,48 @@ TEST_F(ByteStreamTest, newRangeAllocation) {
   }
 }
 
+TEST_F(ByteStreamTest, growthPercent) {
+  std::string value(3000, 'a');
+  for (size_t i = 0; i < value.size(); ++i) {
+    value[i] = 'a' + i % 26;
+  }
+  std::vector<std::string> flushed;
+  std::vector<size_t> numRanges;
+  for (const auto percent : {0, 50}) {
+    auto arena = std::make_shared<StreamArena>(pool_.get());
+    ByteOutputStream stream(arena.get());
+    stream.setGrowthPercent(percent);
+    stream.startWrite(0);
+    for (auto i = 0; i < 1'000; ++i) {
+      stream.appendStringView(value);
+    }
+    const int64_t totalBytes = 1'000 * value.size();
+    ASSERT_GE(stream.testingAllocatedBytes(), totalBytes);
+    numRanges.push_back(stream.ranges().size());
+
+    // The content is the same whether flushed by reference or by copy.
+    IOBufOutputStream byReference(arena);
+    stream.flush(&byReference);
+    auto coalesced = byReference.getIOBuf()->clone()->coalesce();
+    std::stringstream copySStream;
+    OStreamOutputStream copy(&copySStream);
+    stream.flush(&copy);
+    ASSERT_EQ(
+        copySStream.str(),
+        std::string(
+            reinterpret_cast<const char*>(coalesced.data()),
+            coalesced.size()));
+    ASSERT_EQ(copySStream.str().size(), 1'000 * value.size());
+    flushed.push_back(copySStream.str());
+  }
+  ASSERT_EQ(flushed[0], flushed[1]);
+  ASSERT_LT(numRanges[1], numRanges[0]);
+
+  auto arena = newArena();
+  ByteOutputStream stream(arena.get());
+  VELOX_ASSERT_THROW(stream.setGrowthPercent(-1), "");
+}
+
 TEST_F(ByteStreamTest, randomRangeAllocationFromMultiStreamsTest) {
   auto arena = newArena();
   const int numByteStreams = 10;
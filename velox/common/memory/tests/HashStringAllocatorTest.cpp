@@ -157,6 +157,33 @@ TEST_F(HashStringAllocatorTest, allocate) {
   EXPECT_LE(allocator_->retainedSize() - allocator_->freeSpace(), 250);
 }
 
+TEST_F(HashStringAllocatorTest, allocateSmallFromLargestFreeBlock) {
+  // Consecutive small allocations are carved back to back from the start of
+  // the largest free block.
+  std::vector<HSA::Header*> headers;
+  headers.push_back(allocator_->allocate(100));
+  for (auto i = 1; i < 1'000; ++i) {
+    headers.push_back(allocator_->allocate(16 + i % 50));
+    ASSERT_EQ(reinterpret_cast<char*>(headers[i]), headers[i - 1]->end());
+  }
+  allocator_->checkConsistency();
+  const auto freeSpace = allocator_->freeSpace();
+
+  // Freed blocks go to the free lists of their size and are reused first.
+  const auto size = headers[10]->size();
+  allocator_->free(headers[10]);
+  auto* reused = allocator_->allocate(size);
+  ASSERT_EQ(reused, headers[10]);
+  ASSERT_EQ(allocator_->freeSpace(), freeSpace);
+  allocator_->checkConsistency();
+
+  for (auto* header : headers) {
+    allocator_->free(header);
+  }
+  allocator_->checkConsistency();
+  EXPECT_TRUE(allocator_->isEmpty());
+}
+
 TEST_F(HashStringAllocatorTest, allocateLarge) {
   // Verify that allocate() can handle sizes larger than the largest class size
   // supported by memory allocators, that is, 256 pages.
@@ -732,6 +732,29 @@ TEST_P(MemoryAllocatorTest, minSizeClass) {
   instance_->freeNonContiguous(result);
 }
 
+TEST_P(MemoryAllocatorTest, largestSizeClassHugePageAligned) {
+  if (!useMmap_) {
+    return;
+  }
+  const int32_t sizeClass = instance_->sizeClasses().back();
+  ASSERT_GE(
+      AllocationTraits::pageBytes(sizeClass) * 2,
+      AllocationTraits::kHugePageSize);
+  Allocation result;
+  ASSERT_TRUE(instance_->allocateNonContiguous(
+      sizeClass * 4, result, nullptr, sizeClass));
+  // The runs of the largest size class are aligned on multiples of their size
+  // from a huge page boundary.
+  for (auto i = 0; i < result.numRuns(); ++i) {
+    const auto run = result.runAt(i);
+    EXPECT_EQ(
+        0,
+        reinterpret_cast<uintptr_t>(run.data()) %
+            AllocationTraits::pageBytes(sizeClass));
+  }
+  instance_->freeNonContiguous(result);
+}
+
 TEST_P(MemoryAllocatorTest, externalAdvise) {
   if (!useMmap_) {
     return;
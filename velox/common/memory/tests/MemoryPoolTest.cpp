@@ -512,6 +512,104 @@ TEST_P(MemoryPoolTest, allocateZeroFilled) {
   ASSERT_EQ(0, pool->currentBytes());
 }
 
+TEST_P(MemoryPoolTest, smallAllocationCache) {
+  setupMemory(
+      {.smallAllocationCacheEnabled = true,
+       .allocatorCapacity = kDefaultCapacity});
+  auto manager = getMemoryManager();
+  auto root = manager->addRootPool();
+  auto pool = root->addLeafChild("smallAllocationCache", isLeafThreadSafe_);
+
+  // Small sizes are rounded up to a power of two and their buffers stay
+  // charged to the pool after free for reuse by the next allocation.
+  void* buffer = pool->allocate(100);
+  ASSERT_EQ(pool->currentBytes(), 128);
+  ::memset(buffer, 0xff, 100);
+  pool->free(buffer, 100);
+  ASSERT_EQ(pool->currentBytes(), 128);
+  ASSERT_EQ(pool->allocate(120), buffer);
+  pool->free(buffer, 120);
+  auto* zeroFilled =
+      reinterpret_cast<uint8_t*>(pool->allocateZeroFilled(10, 12));
+  ASSERT_EQ(zeroFilled, buffer);
+  for (int32_t i = 0; i < 120; ++i) {
+    ASSERT_EQ(zeroFilled[i], 0);
+  }
+  buffer = pool->reallocate(zeroFilled, 120, 1'000);
+  ASSERT_NE(buffer, zeroFilled);
+  ASSERT_EQ(pool->currentBytes(), 128 + 1024);
+  pool->free(buffer, 1'000);
+
+  // Large sizes are not cached.
+  buffer = pool->allocate(8192);
+  ASSERT_EQ(pool->currentBytes(), 128 + 1024 + 8192);
+  pool->free(buffer, 8192);
+  ASSERT_EQ(pool->currentBytes(), 128 + 1024);
+
+  // Releasing the pool frees the cached buffers.
+  pool->release();
+  ASSERT_EQ(pool->currentBytes(), 0);
+
+  // A size class caches a bounded number of buffers.
+  std::vector<void*> buffers;
+  for (int32_t i = 0; i < 32; ++i) {
+    buffers.push_back(pool->allocate(64));
+  }
+  for (auto* smallBuffer : buffers) {
+    pool->free(smallBuffer, 64);
+  }
+  ASSERT_GT(pool->currentBytes(), 0);
+  ASSERT_LT(pool->currentBytes(), 32 * 64);
+
+  // The pool frees the cached buffers on destruction without reporting a
+  // leak.
+  pool.reset();
+  ASSERT_EQ(root->currentBytes(), 0);
+}
+
+TEST_P(MemoryPoolTest, allocationSampling) {
+  constexpr uint32_t kSampleInterval = 4;
+  setupMemory(
+      {.allocationSampleInterval = kSampleInterval,
+       .allocatorCapacity = kDefaultCapacity});
+  auto manager = getMemoryManager();
+  auto root = manager->addRootPool("allocationSamplingRoot");
+  auto pool = root->addLeafChild("allocationSampling", isLeafThreadSafe_);
+  ASSERT_EQ(root->sampledAllocationSites(), "");
+
+  std::vector<void*> buffers;
+  for (int32_t i = 0; i < 4 * kSampleInterval; ++i) {
+    buffers.push_back(pool->allocate(1024));
+  }
+  Allocation allocation;
+  for (int32_t i = 0; i < kSampleInterval; ++i) {
+    pool->allocateNonContiguous(4, allocation);
+  }
+  const auto sites = root->sampledAllocationSites();
+  ASSERT_NE(sites.find("Top 2 sampled allocation sites"), std::string::npos)
+      << sites;
+  ASSERT_NE(
+      sites.find("allocationSampling peak ~16.00KB live ~16.00KB"),
+      std::string::npos)
+      << sites;
+  ASSERT_EQ(sites, pool->sampledAllocationSites());
+  ASSERT_NE(manager->sampledAllocationSites().find(sites), std::string::npos);
+  ASSERT_EQ(
+      root->sampledAllocationSites(1).find("Top 1 sampled allocation sites"),
+      0);
+
+  // Frees drop the live usage of the sampled allocations but the sites keep
+  // reporting their peak.
+  for (auto* buffer : buffers) {
+    pool->free(buffer, 1024);
+  }
+  pool->freeNonContiguous(allocation);
+  ASSERT_NE(
+      root->sampledAllocationSites().find(
+          "allocationSampling peak ~16.00KB live ~0B"),
+      std::string::npos);
+}
+
 TEST_P(MemoryPoolTest, alignmentCheck) {
   std::vector<uint16_t> alignments = {
       0,
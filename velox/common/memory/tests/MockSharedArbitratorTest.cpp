@@ -163,6 +163,10 @@ class MockMemoryOperator {
       return op_->reclaimableBytes(pool, reclaimableBytes);
     }
 
+    uint64_t expectedGrowthBytes(const MemoryPool& /*unused*/) const override {
+      return op_->expectedGrowthBytes();
+    }
+
     uint64_t reclaim(
         MemoryPool* pool,
         uint64_t targetBytes,
@@ -351,12 +355,21 @@ class MockMemoryOperator {
     return pool_->capacity();
   }
 
+  uint64_t expectedGrowthBytes() const {
+    return expectedGrowthBytes_;
+  }
+
+  void setExpectedGrowthBytes(uint64_t bytes) {
+    expectedGrowthBytes_ = bytes;
+  }
+
   MemoryReclaimer* reclaimer() const;
 
  private:
   mutable std::mutex mu_;
   MemoryPool* pool_{nullptr};
   uint64_t totalBytes_{0};
+  std::atomic<uint64_t> expectedGrowthBytes_{0};
   std::unordered_map<void*, size_t> allocations_;
 };
 
@@ -407,7 +420,8 @@ class MockSharedArbitrationTest : public testing::Test {
       int64_t memoryCapacity = 0,
       uint64_t memoryPoolInitCapacity = kMaxMemory,
       uint64_t memoryPoolTransferCapacity = 0,
-      std::function<void(MemoryPool&)> arbitrationStateCheckCb = nullptr) {
+      std::function<void(MemoryPool&)> arbitrationStateCheckCb = nullptr,
+      uint32_t memoryReclaimThreads = 0) {
     if (memoryPoolInitCapacity == kMaxMemory) {
       memoryPoolInitCapacity = kMemoryPoolInitCapacity;
     }
@@ -422,6 +436,7 @@ class MockSharedArbitrationTest : public testing::Test {
     options.memoryPoolInitCapacity = memoryPoolInitCapacity;
     options.memoryPoolTransferCapacity = memoryPoolTransferCapacity;
     options.arbitrationStateCheckCb = std::move(arbitrationStateCheckCb);
+    options.memoryReclaimThreads = memoryReclaimThreads;
     options.checkUsageLeak = true;
     manager_ = std::make_unique<MemoryManager>(options);
     ASSERT_EQ(manager_->arbitrator()->kind(), arbitratorKind);
@@ -1169,6 +1184,41 @@ TEST_F(MockSharedArbitrationTest, arbitrateWithMemoryReclaim) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, parallelMemoryReclaim) {
+  const uint64_t memCapacity = 256 * MB;
+  setupMemory(memCapacity, kMaxMemory, 0, nullptr, 4);
+
+  // Each victim waits in reclaim for the other one to start.
+  std::atomic_int numReclaims{0};
+  std::atomic_bool concurrentReclaims{false};
+  auto reclaimInjectCb = [&](MemoryPool* /*unused*/, uint64_t /*unused*/) {
+    ++numReclaims;
+    for (int i = 0; i < 5'000 && numReclaims < 2; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1)); // NOLINT
+    }
+    if (numReclaims >= 2) {
+      concurrentReclaims = true;
+    }
+  };
+  const uint64_t victimBytes = 96 * MB;
+  std::vector<MockMemoryOperator*> victimOps;
+  for (int i = 0; i < 2; ++i) {
+    victimOps.push_back(addMemoryOp(nullptr, true, reclaimInjectCb));
+    victimOps.back()->allocate(victimBytes);
+  }
+  auto* requestorOp = addMemoryOp(nullptr, false);
+  requestorOp->allocate(memCapacity - 2 * victimBytes);
+
+  // The request needs memory from both victims.
+  requestorOp->allocate(128 * MB);
+  ASSERT_TRUE(concurrentReclaims);
+  for (auto* victimOp : victimOps) {
+    ASSERT_EQ(victimOp->reclaimer()->stats().numReclaims, 1);
+  }
+  ASSERT_EQ(arbitrator_->stats().numFailures, 0);
+  ASSERT_GE(arbitrator_->stats().numReclaimedBytes, 128 * MB);
+}
+
 TEST_F(MockSharedArbitrationTest, arbitrateBySelfMemoryReclaim) {
   const std::vector<bool> isLeafReclaimables = {true, false};
   for (const auto isLeafReclaimable : isLeafReclaimables) {
@@ -1342,6 +1392,33 @@ TEST_F(MockSharedArbitrationTest, poolCapacityTransferWithFreeCapacity) {
   ASSERT_EQ(arbitrator_->stats().queueTimeUs, 0);
 }
 
+TEST_F(MockSharedArbitrationTest, poolCapacityTransferWithExpectedGrowth) {
+  const uint64_t memCapacity = 512 * MB;
+  const uint64_t minPoolCapacity = 32 * MB;
+  const uint64_t minPoolCapacityTransferSize = 16 * MB;
+  setupMemory(memCapacity, minPoolCapacity, minPoolCapacityTransferSize);
+  auto* memOp = addMemoryOp();
+  memOp->allocate(minPoolCapacity);
+  ASSERT_EQ(memOp->pool()->freeBytes(), 0);
+
+  // The requestor grows by its expected growth on top of the request and
+  // makes the following allocations without arbitration.
+  const uint64_t expectedGrowthBytes = 64 * MB;
+  memOp->setExpectedGrowthBytes(expectedGrowthBytes);
+  const uint64_t allocationSize = 8 * MB;
+  memOp->allocate(allocationSize);
+  ASSERT_EQ(
+      memOp->capacity(),
+      minPoolCapacity + allocationSize + expectedGrowthBytes);
+  memOp->setExpectedGrowthBytes(0);
+  for (int i = 0; i < expectedGrowthBytes / allocationSize; ++i) {
+    memOp->allocate(allocationSize);
+  }
+  ASSERT_EQ(memOp->pool()->freeBytes(), 0);
+  verifyReclaimerStats(memOp->reclaimer()->stats(), 0, 1);
+  ASSERT_EQ(arbitrator_->stats().numRequests, 1);
+}
+
 TEST_F(MockSharedArbitrationTest, poolCapacityTransferSizeWithCapacityShrunk) {
   const int numCandidateOps = 8;
   const uint64_t minPoolCapacity = 64 * MB;
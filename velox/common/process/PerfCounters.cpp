@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/process/PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <array>
+
+namespace facebook::velox::process {
+
+#ifdef __linux__
+namespace {
+
+constexpr int32_t kNumEvents = 4;
+
+// The perf events of the fields of PerfCounters, in order.
+constexpr std::array<uint64_t, kNumEvents> kEvents = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_STALLED_CYCLES_BACKEND};
+
+int openEvent(uint64_t event, int groupFd) {
+  struct perf_event_attr attr = {};
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = event;
+  attr.disabled = groupFd == -1 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+
+// The counters of one thread, read together as one group. The first event that
+// opens is the group leader. Events that fail to open are left out of the
+// group.
+class ThreadCounters {
+ public:
+  ThreadCounters() {
+    for (auto i = 0; i < kNumEvents; ++i) {
+      const auto fd = openEvent(kEvents[i], leaderFd_);
+      if (fd == -1) {
+        continue;
+      }
+      if (leaderFd_ == -1) {
+        leaderFd_ = fd;
+      } else {
+        memberFds_[numEvents_] = fd;
+      }
+      eventIndices_[numEvents_++] = i;
+    }
+    if (leaderFd_ != -1) {
+      ioctl(leaderFd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+  }
+
+  ~ThreadCounters() {
+    for (auto i = 1; i < numEvents_; ++i) {
+      close(memberFds_[i]);
+    }
+    if (leaderFd_ != -1) {
+      close(leaderFd_);
+    }
+  }
+
+  bool read(PerfCounters& counters) const {
+    if (leaderFd_ == -1) {
+      return false;
+    }
+    // The number of events followed by the value of each.
+    std::array<uint64_t, kNumEvents + 1> values;
+    const auto size = (numEvents_ + 1) * sizeof(uint64_t);
+    if (::read(leaderFd_, values.data(), size) != size) {
+      return false;
+    }
+    std::array<uint64_t, kNumEvents> fields = {};
+    for (auto i = 0; i < numEvents_; ++i) {
+      fields[eventIndices_[i]] = values[i + 1];
+    }
+    counters = {fields[0], fields[1], fields[2], fields[3]};
+    return true;
+  }
+
+ private:
+  int leaderFd_{-1};
+  std::array<int, kNumEvents> memberFds_;
+  std::array<int32_t, kNumEvents> eventIndices_;
+  int32_t numEvents_{0};
+};
+
+} // namespace
+
+bool readThreadPerfCounters(PerfCounters& counters) {
+  thread_local ThreadCounters threadCounters;
+  return threadCounters.read(counters);
+}
+#else
+bool readThreadPerfCounters(PerfCounters& /*counters*/) {
+  return false;
+}
+#endif
+
+} // namespace facebook::velox::process
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <fmt/format.h>
+#include <cstdint>
+#include <string>
+
+namespace facebook::velox::process {
+
+/// Hardware event counts of a thread, in user space only.
+struct PerfCounters {
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  /// Misses of the last level cache.
+  uint64_t llcMisses{0};
+  /// Cycles in which the backend of the CPU did not retire instructions, e.g.
+  /// because of waiting for memory.
+  uint64_t backendStallCycles{0};
+
+  PerfCounters operator-(const PerfCounters& other) const {
+    return {
+        cycles - other.cycles,
+        instructions - other.instructions,
+        llcMisses - other.llcMisses,
+        backendStallCycles - other.backendStallCycles};
+  }
+
+  std::string toString() const {
+    return fmt::format(
+        "cycles: {}, instructions: {}, llcMisses: {}, backendStallCycles: {}",
+        cycles,
+        instructions,
+        llcMisses,
+        backendStallCycles);
+  }
+};
+
+/// Reads the counters of the calling thread into 'counters'. The counters are
+/// opened with perf_event_open on the first call on each thread. Returns false
+/// if the counters are not available, e.g. on non-Linux systems or if
+/// /proc/sys/kernel/perf_event_paranoid does not allow them. Events the CPU
+/// does not support read as 0.
+bool readThreadPerfCounters(PerfCounters& counters);
+
+/// Reads the thread's counters at construction and destruction and passes the
+/// difference to 'func' if the counters are available. Must be destroyed on
+/// the thread it is constructed on.
+template <typename F>
+class DeltaPerfCounterTimer {
+ public:
+  explicit DeltaPerfCounterTimer(F&& func)
+      : valid_(readThreadPerfCounters(start_)), func_(std::move(func)) {}
+
+  ~DeltaPerfCounterTimer() {
+    PerfCounters end;
+    if (valid_ && readThreadPerfCounters(end)) {
+      func_(end - start_);
+    }
+  }
+
+ private:
+  PerfCounters start_;
+  const bool valid_;
+  F func_;
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/process/TimelineRecorder.h"
+
+#include <folly/json.h>
+#include <algorithm>
+
+namespace facebook::velox::process {
+
+namespace {
+thread_local TimelineRecorder* threadRecorder{nullptr};
+thread_local int32_t threadTimelineId{0};
+} // namespace
+
+void TimelineRecorder::record(Event event) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (events_.size() >= maxEvents_) {
+    ++numDroppedEvents_;
+    return;
+  }
+  events_.push_back(std::move(event));
+}
+
+void TimelineRecorder::recordEndingNow(
+    const char* category,
+    std::string name,
+    int32_t threadId,
+    uint64_t durationMicros,
+    std::string detail) {
+  const auto now = nowMicros();
+  record(
+      {std::move(name),
+       category,
+       threadId,
+       now - std::min(now, durationMicros),
+       durationMicros,
+       std::move(detail)});
+}
+
+void TimelineRecorder::setThreadName(int32_t threadId, std::string name) {
+  std::lock_guard<std::mutex> l(mutex_);
+  threadNames_.emplace_back(threadId, std::move(name));
+}
+
+std::vector<TimelineRecorder::Event> TimelineRecorder::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return events_;
+}
+
+std::string TimelineRecorder::toChromeTrace(
+    const std::string& processName) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto traceEvents = folly::dynamic::array;
+  traceEvents.push_back(
+      folly::dynamic::object("name", "process_name")("ph", "M")("pid", 0)(
+          "args", folly::dynamic::object("name", processName)));
+  for (const auto& [threadId, name] : threadNames_) {
+    traceEvents.push_back(folly::dynamic::object("name", "thread_name")(
+        "ph", "M")("pid", 0)("tid", threadId)(
+        "args", folly::dynamic::object("name", name)));
+  }
+  for (const auto& event : events_) {
+    auto traceEvent = folly::dynamic::object("name", event.name)(
+        "cat", event.category)("ph", "X")("pid", 0)("tid", event.threadId)(
+        "ts", event.startMicros)("dur", event.durationMicros);
+    if (!event.detail.empty()) {
+      traceEvent["args"] = folly::dynamic::object("detail", event.detail);
+    }
+    traceEvents.push_back(std::move(traceEvent));
+  }
+  folly::dynamic trace = folly::dynamic::object("traceEvents", traceEvents)(
+      "displayTimeUnit", "ms");
+  if (numDroppedEvents_ > 0) {
+    trace["otherData"] = folly::dynamic::object(
+        "droppedEvents", numDroppedEvents_.load());
+  }
+  return folly::toJson(trace);
+}
+
+ScopedTimelineThread::ScopedTimelineThread(
+    TimelineRecorder* recorder,
+    int32_t threadId)
+    : previousRecorder_(threadRecorder), previousThreadId_(threadTimelineId) {
+  threadRecorder = recorder;
+  threadTimelineId = threadId;
+}
+
+ScopedTimelineThread::~ScopedTimelineThread() {
+  threadRecorder = previousRecorder_;
+  threadTimelineId = previousThreadId_;
+}
+
+void recordThreadEvent(
+    const char* category,
+    const char* name,
+    uint64_t durationMicros) {
+  if (threadRecorder == nullptr) {
+    return;
+  }
+  threadRecorder->recordEndingNow(
+      category, name, threadTimelineId, durationMicros);
+}
+
+} // namespace facebook::velox::process
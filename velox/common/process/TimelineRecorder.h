@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::process {
+
+/// Records the timeline of a task as intervals of named activity on numbered
+/// threads, e.g. the drivers of the task, for export in the Chrome trace event
+/// format that chrome://tracing and Perfetto load. Thread safe.
+class TimelineRecorder {
+ public:
+  /// An interval of activity. Times are in microseconds since the epoch.
+  struct Event {
+    std::string name;
+    /// The kind of activity, e.g. 'driver', 'blocked', 'io'.
+    const char* category;
+    int32_t threadId;
+    uint64_t startMicros;
+    uint64_t durationMicros;
+    /// Optional free form detail, e.g. the operator of a blocked interval.
+    std::string detail;
+  };
+
+  /// Keeps at most 'maxEvents' events. Further events are counted in
+  /// numDroppedEvents() and not kept.
+  explicit TimelineRecorder(uint64_t maxEvents = 1'000'000)
+      : maxEvents_(maxEvents) {}
+
+  /// Returns the current time in the clock of the events.
+  static uint64_t nowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+  }
+
+  void record(Event event);
+
+  /// Records an event of 'durationMicros' that ends now.
+  void recordEndingNow(
+      const char* category,
+      std::string name,
+      int32_t threadId,
+      uint64_t durationMicros,
+      std::string detail = "");
+
+  /// Names 'threadId' in the exported trace, e.g. as 'pipeline 1 driver 3'.
+  void setThreadName(int32_t threadId, std::string name);
+
+  std::vector<Event> events() const;
+
+  uint64_t numDroppedEvents() const {
+    return numDroppedEvents_;
+  }
+
+  /// Returns the events as a JSON Chrome trace. The events are complete ('X')
+  /// events of process 'processName', e.g. the task id.
+  std::string toChromeTrace(const std::string& processName) const;
+
+ private:
+  const uint64_t maxEvents_;
+
+  mutable std::mutex mutex_;
+  std::vector<Event> events_;
+  std::vector<std::pair<int32_t, std::string>> threadNames_;
+  std::atomic<uint64_t> numDroppedEvents_{0};
+};
+
+/// Sets the recorder and thread id that recordThreadEvent() adds events to on
+/// the calling thread for the lifetime of 'this'. Set by the Driver while it
+/// is on thread so that code that does not know about drivers, e.g. IO, can
+/// add its waits to the timeline.
+class ScopedTimelineThread {
+ public:
+  ScopedTimelineThread(TimelineRecorder* recorder, int32_t threadId);
+
+  ~ScopedTimelineThread();
+
+ private:
+  TimelineRecorder* const previousRecorder_;
+  const int32_t previousThreadId_;
+};
+
+/// Adds an event of 'durationMicros' ending now to the recorder of the
+/// calling thread. No-op if there is none.
+void recordThreadEvent(
+    const char* category,
+    const char* name,
+    uint64_t durationMicros);
+
+} // namespace facebook::velox::process
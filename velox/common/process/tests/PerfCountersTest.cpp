@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::process {
+namespace {
+
+int64_t sumOfSquares(int64_t n) {
+  volatile int64_t sum = 0;
+  for (int64_t i = 0; i < n; ++i) {
+    sum += i * i;
+  }
+  return sum;
+}
+
+TEST(PerfCountersTest, delta) {
+  PerfCounters start;
+  if (!readThreadPerfCounters(start)) {
+    // Not counted without the permission to open perf events.
+    bool called = false;
+    {
+      DeltaPerfCounterTimer timer(
+          [&](const PerfCounters& /*delta*/) { called = true; });
+    }
+    ASSERT_FALSE(called);
+    GTEST_SKIP() << "Hardware counters are not available";
+  }
+
+  PerfCounters small;
+  {
+    DeltaPerfCounterTimer timer(
+        [&](const PerfCounters& delta) { small = delta; });
+    sumOfSquares(1'000);
+  }
+  PerfCounters large;
+  {
+    DeltaPerfCounterTimer timer(
+        [&](const PerfCounters& delta) { large = delta; });
+    sumOfSquares(1'000'000);
+  }
+  // Virtual machines may not count all events.
+  if (large.instructions == 0) {
+    GTEST_SKIP() << "Instructions are not counted";
+  }
+  ASSERT_GT(large.instructions, 1'000'000);
+  ASSERT_GT(large.instructions, small.instructions);
+
+  PerfCounters end;
+  ASSERT_TRUE(readThreadPerfCounters(end));
+  ASSERT_GE(
+      end.instructions - start.instructions,
+      small.instructions + large.instructions);
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/process/TimelineRecorder.h"
+
+#include <folly/json.h>
+#include <gtest/gtest.h>
+
+namespace facebook::velox::process {
+namespace {
+
+TEST(TimelineRecorderTest, chromeTrace) {
+  TimelineRecorder recorder;
+  recorder.setThreadName(1, "pipeline 0 driver 1");
+  recorder.record({"onThread", "driver", 1, 1'000, 200, "kBlock"});
+  recorder.recordEndingNow("io", "ioWait", 1, 50);
+
+  const auto events = recorder.events();
+  ASSERT_EQ(2, events.size());
+  ASSERT_EQ("ioWait", events[1].name);
+  ASSERT_EQ(50, events[1].durationMicros);
+  ASSERT_LE(events[1].startMicros + 50, TimelineRecorder::nowMicros());
+
+  const auto trace = folly::parseJson(recorder.toChromeTrace("task.0"));
+  const auto& traceEvents = trace["traceEvents"];
+  ASSERT_EQ(4, traceEvents.size());
+  ASSERT_EQ("process_name", traceEvents[0]["name"].asString());
+  ASSERT_EQ("task.0", traceEvents[0]["args"]["name"].asString());
+  ASSERT_EQ("thread_name", traceEvents[1]["name"].asString());
+  ASSERT_EQ(1, traceEvents[1]["tid"].asInt());
+  ASSERT_EQ("pipeline 0 driver 1", traceEvents[1]["args"]["name"].asString());
+
+  const auto& onThread = traceEvents[2];
+  ASSERT_EQ("onThread", onThread["name"].asString());
+  ASSERT_EQ("driver", onThread["cat"].asString());
+  ASSERT_EQ("X", onThread["ph"].asString());
+  ASSERT_EQ(1'000, onThread["ts"].asInt());
+  ASSERT_EQ(200, onThread["dur"].asInt());
+  ASSERT_EQ("kBlock", onThread["args"]["detail"].asString());
+  ASSERT_EQ(0, traceEvents[3].count("args"));
+  ASSERT_EQ(0, trace.count("otherData"));
+}
+
+TEST(TimelineRecorderTest, maxEvents) {
+  TimelineRecorder recorder(2);
+  for (int32_t i = 0; i < 5; ++i) {
+    recorder.recordEndingNow("driver", "queued", 0, i);
+  }
+  ASSERT_EQ(2, recorder.events().size());
+  ASSERT_EQ(3, recorder.numDroppedEvents());
+  const auto trace = folly::parseJson(recorder.toChromeTrace("task.0"));
+  ASSERT_EQ(3, trace["otherData"]["droppedEvents"].asInt());
+}
+
+TEST(TimelineRecorderTest, threadEvents) {
+  // No-op without a recorder on the thread.
+  recordThreadEvent("io", "ioWait", 10);
+
+  TimelineRecorder recorder;
+  TimelineRecorder nested;
+  {
+    ScopedTimelineThread scoped(&recorder, 3);
+    recordThreadEvent("io", "ioWait", 10);
+    {
+      ScopedTimelineThread scopedNested(&nested, 4);
+      recordThreadEvent("memory", "arbitration", 20);
+    }
+    recordThreadEvent("spill", "spillWrite", 30);
+  }
+  recordThreadEvent("io", "ioWait", 10);
+
+  const auto events = recorder.events();
+  ASSERT_EQ(2, events.size());
+  ASSERT_EQ("ioWait", events[0].name);
+  ASSERT_EQ(3, events[0].threadId);
+  ASSERT_EQ("spillWrite", events[1].name);
+  ASSERT_STREQ("spill", events[1].category);
+  ASSERT_EQ(1, nested.events().size());
+  ASSERT_EQ(4, nested.events()[0].threadId);
+}
+
+} // namespace
+} // namespace facebook::velox::process
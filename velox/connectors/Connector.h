@@ -60,6 +60,32 @@ struct ConnectorSplit {
   virtual std::string toString() const {
     return fmt::format("[split: {}]", connectorId);
   }
+
+  /// Returns how many bytes of the data of this split are in 'cache', in
+  /// memory and on SSD. Lets a scheduler embedding Velox assign the split to
+  /// the worker that has most of its data cached. Returns zeros if the
+  /// connector does not know which file ranges the split reads.
+  virtual cache::CacheResidency cacheResidency(
+      const cache::AsyncDataCache& /*cache*/) const {
+    return {};
+  }
+
+  /// Returns the number of bytes of data the split covers or 0 if not known.
+  /// Used for budgeting the bytes of the splits preloading.
+  virtual uint64_t dataBytes() const {
+    return 0;
+  }
+
+  /// Returns a key that identifies the data of this split for caching the
+  /// results of scanning it, see exec::FragmentResultCache. The key must
+  /// change whenever the data may have changed, e.g. by including the
+  /// modification time of the file. Connectors that return a key must
+  /// serialize all the properties of their table and column handles that
+  /// affect the scan results. Returns std::nullopt if the results of the
+  /// split may not be cached.
+  virtual std::optional<std::string> resultCacheKey() const {
+    return std::nullopt;
+  }
 };
 
 class ColumnHandle : public ISerializable {
@@ -161,6 +187,11 @@ class DataSink {
   /// Returns the stats of this data sink.
   virtual Stats stats() const = 0;
 
+  /// Writes out the data buffered by the file writers without closing the
+  /// files. Called by the table writer to bound its memory. The default does
+  /// nothing.
+  virtual void flush() {}
+
   /// Called once after all data has been added via possibly multiple calls to
   /// appendData(). The function returns the metadata of written data in string
   /// form. We don't expect any appendData() calls on a closed data sink object.
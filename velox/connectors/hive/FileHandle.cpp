@@ -19,6 +19,7 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/time/Timer.h"
+#include "velox/connectors/hive/HiveConfig.h"
 
 #include <atomic>
 
@@ -43,8 +44,15 @@ std::shared_ptr<FileHandle> FileHandleGenerator::operator()(
   {
     MicrosecondTimer timer(&elapsedTimeUs);
     fileHandle = std::make_shared<FileHandle>();
+    filesystems::FileOptions options;
+    if (properties_ != nullptr) {
+      if (auto readMode = properties_->get(
+              connector::hive::HiveConfig::kLocalReadMode)) {
+        options.values[std::string(filesystems::kLocalReadMode)] = *readMode;
+      }
+    }
     fileHandle->file = filesystems::getFileSystem(filename, properties_)
-                           ->openFileForRead(filename);
+                           ->openFileForRead(filename, options);
     fileHandle->uuid = StringIdLease(fileIds(), filename);
     fileHandle->groupId = StringIdLease(fileIds(), groupName(filename));
     VLOG(1) << "Generating file handle for: " << filename
@@ -120,6 +120,28 @@ std::optional<uint32_t> HiveConfig::s3MaxConnections() const {
       config_->get<uint32_t>(kS3MaxConnections));
 }
 
+uint32_t HiveConfig::s3UploadPartThreads() const {
+  return config_->get<uint32_t>(kS3UploadPartThreads, 0);
+}
+
+uint32_t HiveConfig::s3MaxInflightUploadParts() const {
+  return config_->get<uint32_t>(kS3MaxInflightUploadParts, 4);
+}
+
+uint64_t HiveConfig::s3ReadPartSize() const {
+  return config_->get<uint64_t>(kS3ReadPartSize, 16UL << 20);
+}
+
+double HiveConfig::s3ReadHedgePercentile() const {
+  const auto percentile = config_->get<double>(kS3ReadHedgePercentile, 0);
+  VELOX_USER_CHECK(
+      percentile >= 0 && percentile < 100,
+      "{} must be in [0, 100): {}",
+      kS3ReadHedgePercentile,
+      percentile);
+  return percentile;
+}
+
 std::string HiveConfig::gcsEndpoint() const {
   return config_->get<std::string>(kGCSEndpoint, std::string(""));
 }
@@ -159,10 +181,35 @@ int32_t HiveConfig::maxCoalescedDistanceBytes() const {
   return config_->get<int32_t>(kMaxCoalescedDistanceBytes, 512 << 10);
 }
 
+std::string HiveConfig::localReadMode() const {
+  return config_->get<std::string>(kLocalReadMode, "pread");
+}
+
 int32_t HiveConfig::prefetchRowGroups() const {
   return config_->get<int32_t>(kPrefetchRowGroups, 1);
 }
 
+int64_t HiveConfig::maxPrefetchRowGroupBytes() const {
+  return config_->get<int64_t>(kMaxPrefetchRowGroupBytes, 256 << 20);
+}
+
+uint32_t HiveConfig::parallelUnitLoadCount(const Config* session) const {
+  return session->get<uint32_t>(
+      kParallelUnitLoadCountSession,
+      config_->get<uint32_t>(kParallelUnitLoadCount, 0));
+}
+
+bool HiveConfig::collectColumnReadStats(const Config* session) const {
+  return session->get<bool>(
+      kCollectColumnReadStatsSession,
+      config_->get<bool>(kCollectColumnReadStats, false));
+}
+
+bool HiveConfig::reuseFileReaders(const Config* session) const {
+  return session->get<bool>(
+      kReuseFileReadersSession, config_->get<bool>(kReuseFileReaders, true));
+}
+
 int32_t HiveConfig::loadQuantum() const {
   return config_->get<int32_t>(kLoadQuantum, 8 << 20);
 }
@@ -209,6 +256,25 @@ uint64_t HiveConfig::sortWriterMaxOutputBytes(const Config* session) const {
       core::CapacityUnit::BYTE);
 }
 
+uint64_t HiveConfig::maxTargetFileSize(const Config* session) const {
+  return toCapacity(
+      session->get<std::string>(
+          kMaxTargetFileSizeSession,
+          config_->get<std::string>(kMaxTargetFileSize, "0B")),
+      core::CapacityUnit::BYTE);
+}
+
+uint32_t HiveConfig::maxOpenWriters(const Config* session) const {
+  return session->get<uint32_t>(
+      kMaxOpenWritersSession, config_->get<uint32_t>(kMaxOpenWriters, 0));
+}
+
+uint32_t HiveConfig::maxParallelWriterCloses(const Config* session) const {
+  return session->get<uint32_t>(
+      kMaxParallelWriterClosesSession,
+      config_->get<uint32_t>(kMaxParallelWriterCloses, 1));
+}
+
 uint64_t HiveConfig::footerEstimatedSize() const {
   return config_->get<uint64_t>(kFooterEstimatedSize, 1UL << 20);
 }
@@ -232,4 +298,37 @@ uint8_t HiveConfig::parquetWriteTimestampUnit(const Config* session) const {
   return unit;
 }
 
+bool HiveConfig::parquetWritePageIndex(const Config* session) const {
+  return session->get<bool>(
+      kParquetWritePageIndexSession,
+      config_->get<bool>(kParquetWritePageIndex, false));
+}
+
+std::vector<std::string> HiveConfig::parquetWriteBloomFilterColumns(
+    const Config* session) const {
+  const auto columns = session->get<std::string>(
+      kParquetWriteBloomFilterColumnsSession,
+      config_->get<std::string>(kParquetWriteBloomFilterColumns, ""));
+  std::vector<std::string> result;
+  if (columns.empty()) {
+    return result;
+  }
+  boost::algorithm::split(result, columns, boost::is_any_of(","));
+  for (auto& column : result) {
+    boost::algorithm::trim(column);
+  }
+  return result;
+}
+
+double HiveConfig::parquetWriteBloomFilterFpp(const Config* session) const {
+  const auto fpp = session->get<double>(
+      kParquetWriteBloomFilterFppSession,
+      config_->get<double>(kParquetWriteBloomFilterFpp, 0.05));
+  VELOX_USER_CHECK(
+      fpp > 0 && fpp < 1,
+      "Invalid Bloom filter false positive probability: {}",
+      fpp);
+  return fpp;
+}
+
 } // namespace facebook::velox::connector::hive
@@ -97,6 +97,27 @@ class HiveConfig {
   /// Maximum concurrent TCP connections for a single http client.
   static constexpr const char* kS3MaxConnections = "hive.s3.max-connections";
 
+  /// Number of threads for uploading the parts of S3 multipart uploads in
+  /// parallel. 0 uploads the parts synchronously on the writing thread.
+  static constexpr const char* kS3UploadPartThreads =
+      "hive.s3.upload-part-threads";
+
+  /// Maximum number of parts of a single S3 file being uploaded in parallel.
+  /// Bounds the memory staged per file to this many 10MB parts.
+  static constexpr const char* kS3MaxInflightUploadParts =
+      "hive.s3.max-inflight-upload-parts";
+
+  /// S3 reads larger than this many bytes are split into GET requests of at
+  /// most this size that are issued in parallel. 0 reads each range with a
+  /// single GET request.
+  static constexpr const char* kS3ReadPartSize = "hive.s3.read-part-size";
+
+  /// A GET request taking longer than this percentile of the recent GET
+  /// latencies of the same bucket is hedged by a duplicate request and the
+  /// first response is used. 0 disables hedging.
+  static constexpr const char* kS3ReadHedgePercentile =
+      "hive.s3.read-hedge-percentile";
+
   /// The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -132,9 +153,38 @@ class HiveConfig {
   static constexpr const char* kMaxCoalescedDistanceBytes =
       "max-coalesced-distance-bytes";
 
+  /// How local files are read: 'pread', 'mmap' or 'direct' (O_DIRECT).
+  static constexpr const char* kLocalReadMode = "local-read-mode";
+
   /// The number of prefetch rowgroups
   static constexpr const char* kPrefetchRowGroups = "prefetch-rowgroups";
 
+  /// The maximum total size in bytes of the prefetched rowgroups.
+  static constexpr const char* kMaxPrefetchRowGroupBytes =
+      "max-prefetch-rowgroup-bytes";
+
+  /// Number of stripes of a DWRF or ORC file that are loaded concurrently on
+  /// the connector executor, starting at the one being read. Loading ahead
+  /// keeps the cores busy on large files that are read as few splits. 0
+  /// loads each stripe when it is reached.
+  static constexpr const char* kParallelUnitLoadCount =
+      "parallel-unit-load-count";
+  static constexpr const char* kParallelUnitLoadCountSession =
+      "parallel_unit_load_count";
+
+  /// Whether the time and bytes of reading each column are reported in the
+  /// runtime stats of the table scan.
+  static constexpr const char* kCollectColumnReadStats =
+      "collect-column-read-stats";
+  static constexpr const char* kCollectColumnReadStatsSession =
+      "collect_column_read_stats";
+
+  /// Whether a split of the same file as the previous split of a table scan
+  /// reuses the file reader of the previous split instead of opening the file
+  /// again.
+  static constexpr const char* kReuseFileReaders = "reuse-file-readers";
+  static constexpr const char* kReuseFileReadersSession = "reuse_file_readers";
+
   /// The total size in bytes for a direct coalesce request.
   static constexpr const char* kLoadQuantum = "load-quantum";
 
@@ -184,6 +234,29 @@ class HiveConfig {
   static constexpr const char* kSortWriterMaxOutputBytesSession =
       "sort_writer_max_output_bytes";
 
+  /// Size in bytes after which a file being written is closed and the rows
+  /// that follow go to a new file. 0 means no limit. Not applied to bucketed
+  /// tables, which have one file per bucket.
+  static constexpr const char* kMaxTargetFileSize = "max-target-file-size";
+  static constexpr const char* kMaxTargetFileSizeSession =
+      "max_target_file_size";
+
+  /// Maximum number of files a table writer keeps open. When the limit is
+  /// reached, the least recently written file is closed and a new file is
+  /// opened if more rows come for its partition. 0 means that the open files
+  /// are only limited by max-partitions-per-writers. Not applied to bucketed
+  /// tables.
+  static constexpr const char* kMaxOpenWriters = "max-open-writers";
+  static constexpr const char* kMaxOpenWritersSession = "max_open_writers";
+
+  /// Maximum number of files a table writer closes concurrently on the
+  /// connector executor when it finishes. 1 closes the files one after the
+  /// other on the driver thread.
+  static constexpr const char* kMaxParallelWriterCloses =
+      "max-parallel-writer-closes";
+  static constexpr const char* kMaxParallelWriterClosesSession =
+      "max_parallel_writer_closes";
+
   static constexpr const char* kS3UseProxyFromEnv =
       "hive.s3.use-proxy-from-env";
 
@@ -193,6 +266,24 @@ class HiveConfig {
   static constexpr const char* kParquetWriteTimestampUnitSession =
       "hive.parquet.writer.timestamp_unit";
 
+  /// Whether to write the ColumnIndex and OffsetIndex into Parquet files.
+  static constexpr const char* kParquetWritePageIndex =
+      "hive.parquet.writer.page-index-enabled";
+  static constexpr const char* kParquetWritePageIndexSession =
+      "hive.parquet.writer.page_index_enabled";
+
+  /// Comma separated names of the columns to write Parquet Bloom filters for.
+  static constexpr const char* kParquetWriteBloomFilterColumns =
+      "hive.parquet.writer.bloom-filter-columns";
+  static constexpr const char* kParquetWriteBloomFilterColumnsSession =
+      "hive.parquet.writer.bloom_filter_columns";
+
+  /// False positive probability the Parquet Bloom filters are sized for.
+  static constexpr const char* kParquetWriteBloomFilterFpp =
+      "hive.parquet.writer.bloom-filter-fpp";
+  static constexpr const char* kParquetWriteBloomFilterFppSession =
+      "hive.parquet.writer.bloom_filter_fpp";
+
   InsertExistingPartitionsBehavior insertExistingPartitionsBehavior(
       const Config* session) const;
 
@@ -224,6 +315,14 @@ class HiveConfig {
 
   std::optional<uint32_t> s3MaxConnections() const;
 
+  uint32_t s3UploadPartThreads() const;
+
+  uint32_t s3MaxInflightUploadParts() const;
+
+  uint64_t s3ReadPartSize() const;
+
+  double s3ReadHedgePercentile() const;
+
   std::string gcsEndpoint() const;
 
   std::string gcsScheme() const;
@@ -242,8 +341,18 @@ class HiveConfig {
 
   int32_t maxCoalescedDistanceBytes() const;
 
+  std::string localReadMode() const;
+
   int32_t prefetchRowGroups() const;
 
+  int64_t maxPrefetchRowGroupBytes() const;
+
+  uint32_t parallelUnitLoadCount(const Config* session) const;
+
+  bool collectColumnReadStats(const Config* session) const;
+
+  bool reuseFileReaders(const Config* session) const;
+
   int32_t loadQuantum() const;
 
   int32_t numCacheFileHandles() const;
@@ -262,6 +371,12 @@ class HiveConfig {
 
   uint64_t sortWriterMaxOutputBytes(const Config* session) const;
 
+  uint64_t maxTargetFileSize(const Config* session) const;
+
+  uint32_t maxOpenWriters(const Config* session) const;
+
+  uint32_t maxParallelWriterCloses(const Config* session) const;
+
   uint64_t footerEstimatedSize() const;
 
   uint64_t filePreloadThreshold() const;
@@ -272,6 +387,16 @@ class HiveConfig {
   /// through Arrow bridge. 0: second, 3: milli, 6: micro, 9: nano.
   uint8_t parquetWriteTimestampUnit(const Config* session) const;
 
+  /// Returns true if the Parquet writer writes the page index.
+  bool parquetWritePageIndex(const Config* session) const;
+
+  /// Returns the columns the Parquet writer writes Bloom filters for.
+  std::vector<std::string> parquetWriteBloomFilterColumns(
+      const Config* session) const;
+
+  /// Returns the false positive probability of Parquet Bloom filters.
+  double parquetWriteBloomFilterFpp(const Config* session) const;
+
   HiveConfig(std::shared_ptr<const Config> config) {
     VELOX_CHECK_NOT_NULL(
         config, "Config is null for HiveConfig initialization");
@@ -106,7 +106,8 @@ std::unique_ptr<DataSink> HiveConnector::createDataSink(
       hiveInsertHandle,
       connectorQueryCtx,
       commitStrategy,
-      hiveConfig_);
+      hiveConfig_,
+      executor_);
 }
 
 std::unique_ptr<core::PartitionFunction> HivePartitionFunctionSpec::create(
@@ -15,13 +15,31 @@
  */
 #pragma once
 
+#include <map>
 #include <optional>
 #include <unordered_map>
 #include "velox/connectors/Connector.h"
 #include "velox/dwio/common/Options.h"
+#include "velox/dwio/common/Statistics.h"
 
 namespace facebook::velox::connector::hive {
 
+/// File level statistics of the data file of a split, known to the
+/// coordinator from the table metadata, e.g. an Iceberg manifest or a Hive
+/// metastore. Used to skip the split without opening the file when no row can
+/// pass the filters.
+struct HiveFileStatistics {
+  /// The number of rows in the file.
+  uint64_t numRows{0};
+
+  /// Statistics by the names of the columns. Columns without statistics are
+  /// not listed.
+  std::unordered_map<
+      std::string,
+      std::shared_ptr<dwio::common::ColumnStatistics>>
+      columns;
+};
+
 struct HiveConnectorSplit : public connector::ConnectorSplit {
   const std::string filePath;
   dwio::common::FileFormat fileFormat;
@@ -43,6 +61,9 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
   /// associated with the HiveSplit.
   std::unordered_map<std::string, std::string> infoColumns;
 
+  /// Optional statistics of the data file. Null if not known.
+  std::shared_ptr<const HiveFileStatistics> fileStatistics;
+
   HiveConnectorSplit(
       const std::string& connectorId,
       const std::string& _filePath,
@@ -56,7 +77,8 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
       const std::shared_ptr<std::string>& _extraFileInfo = {},
       const std::unordered_map<std::string, std::string>& _serdeParameters = {},
       int64_t _splitWeight = 0,
-      const std::unordered_map<std::string, std::string>& _infoColumns = {})
+      const std::unordered_map<std::string, std::string>& _infoColumns = {},
+      std::shared_ptr<const HiveFileStatistics> _fileStatistics = nullptr)
       : ConnectorSplit(connectorId, _splitWeight),
         filePath(_filePath),
         fileFormat(_fileFormat),
@@ -67,7 +89,8 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
         customSplitInfo(_customSplitInfo),
         extraFileInfo(_extraFileInfo),
         serdeParameters(_serdeParameters),
-        infoColumns(_infoColumns) {}
+        infoColumns(_infoColumns),
+        fileStatistics(std::move(_fileStatistics)) {}
 
   std::string toString() const override {
     if (tableBucketNumber.has_value()) {
@@ -81,10 +104,75 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
     return fmt::format("Hive: {} {} - {}", filePath, start, length);
   }
 
+  cache::CacheResidency cacheResidency(
+      const cache::AsyncDataCache& cache) const override {
+    return cache.residency(filePath, start, length);
+  }
+
+  uint64_t dataBytes() const override {
+    return length == std::numeric_limits<uint64_t>::max() ? 0 : length;
+  }
+
+  /// Identifies the split by the file range and the modification time of the
+  /// file from 'infoColumns'. The results are not cached if the modification
+  /// time is not known.
+  std::optional<std::string> resultCacheKey() const override {
+    auto it = infoColumns.find("$file_modified_time");
+    if (it == infoColumns.end()) {
+      return std::nullopt;
+    }
+    std::string key = fmt::format(
+        "{} {} {} {} {}",
+        filePath,
+        start,
+        length,
+        it->second,
+        tableBucketNumber.value_or(-1));
+    // Sort the partition keys for a key that does not depend on the order of
+    // 'partitionKeys'.
+    std::map<std::string, std::optional<std::string>> orderedKeys(
+        partitionKeys.begin(), partitionKeys.end());
+    for (const auto& [name, value] : orderedKeys) {
+      key += fmt::format(" {}={}", name, value.value_or("null"));
+    }
+    return key;
+  }
+
   std::string getFileName() const {
     auto i = filePath.rfind('/');
     return i == std::string::npos ? filePath : filePath.substr(i + 1);
   }
 };
 
+/// A split made of the splits of several small files, which are read
+/// back-to-back by one HiveDataSource. The data source opens the readers of
+/// the files concurrently, so that the footers of all the files are read in
+/// parallel instead of one round trip per file.
+struct HivePackedSplit : public connector::ConnectorSplit {
+  const std::vector<std::shared_ptr<HiveConnectorSplit>> splits;
+
+  HivePackedSplit(
+      const std::string& connectorId,
+      std::vector<std::shared_ptr<HiveConnectorSplit>> _splits,
+      int64_t _splitWeight = 0)
+      : ConnectorSplit(connectorId, _splitWeight), splits(std::move(_splits)) {
+    VELOX_CHECK(!splits.empty(), "Packed split has no files");
+  }
+
+  std::string toString() const override {
+    return fmt::format(
+        "Hive packed: {} files, first {}",
+        splits.size(),
+        splits.front()->toString());
+  }
+
+  uint64_t dataBytes() const override {
+    uint64_t bytes = 0;
+    for (const auto& split : splits) {
+      bytes += split->dataBytes();
+    }
+    return bytes;
+  }
+};
+
 } // namespace facebook::velox::connector::hive
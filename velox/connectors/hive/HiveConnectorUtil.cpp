@@ -481,6 +481,8 @@ void configureReaderOptions(
   readerOptions.setFooterEstimatedSize(hiveConfig->footerEstimatedSize());
   readerOptions.setFilePreloadThreshold(hiveConfig->filePreloadThreshold());
   readerOptions.setPrefetchRowGroups(hiveConfig->prefetchRowGroups());
+  readerOptions.setMaxPrefetchRowGroupBytes(
+      hiveConfig->maxPrefetchRowGroupBytes());
 
   if (readerOptions.getFileFormat() != dwio::common::FileFormat::UNKNOWN) {
     VELOX_CHECK(
@@ -620,6 +622,57 @@ bool testFilters(
   return true;
 }
 
+bool testFiltersBeforeOpen(
+    const common::ScanSpec* scanSpec,
+    const HiveConnectorSplit& split,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle,
+    const RowTypePtr& dataColumns) {
+  const auto* fileStats = split.fileStatistics.get();
+  for (const auto& child : scanSpec->children()) {
+    auto* filter = child->filter();
+    if (!filter || !filter->isDeterministic()) {
+      continue;
+    }
+    const auto& name = child->fieldName();
+    auto keyIter = split.partitionKeys.find(name);
+    if (keyIter != split.partitionKeys.end()) {
+      auto handlesIter = partitionKeysHandle.find(name);
+      VELOX_CHECK(handlesIter != partitionKeysHandle.end());
+      const bool passed = keyIter->second.has_value()
+          ? applyPartitionFilter(
+                handlesIter->second->dataType()->kind(),
+                keyIter->second.value(),
+                filter)
+          : filter->testNull();
+      if (!passed) {
+        VLOG(1) << "Skipping " << split.filePath
+                << " based on partition value and filter for column " << name;
+        return false;
+      }
+      continue;
+    }
+    if (!fileStats || !dataColumns) {
+      continue;
+    }
+    auto statsIter = fileStats->columns.find(name);
+    if (statsIter == fileStats->columns.end() || !statsIter->second ||
+        !dataColumns->containsChild(name)) {
+      continue;
+    }
+    if (!testFilter(
+            filter,
+            statsIter->second.get(),
+            fileStats->numRows,
+            dataColumns->findChild(name))) {
+      VLOG(1) << "Skipping " << split.filePath
+              << " based on file statistics and filter for column " << name;
+      return false;
+    }
+  }
+  return true;
+}
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
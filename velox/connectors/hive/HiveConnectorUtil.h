@@ -91,6 +91,18 @@ bool testFilters(
     const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         partitionKeysHandle);
 
+/// Returns false if no row of 'split' can pass the filters of 'scanSpec'. The
+/// test uses only the partition key values and the optional file statistics
+/// of 'split', so that it can run before the data file is opened. 'dataColumns'
+/// gives the types of the columns with file statistics. Columns not in
+/// 'dataColumns' are not tested.
+bool testFiltersBeforeOpen(
+    const common::ScanSpec* scanSpec,
+    const HiveConnectorSplit& split,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle,
+    const RowTypePtr& dataColumns);
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
@@ -31,6 +31,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <folly/futures/Future.h>
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -345,7 +346,8 @@ HiveDataSink::HiveDataSink(
     std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
     const ConnectorQueryCtx* connectorQueryCtx,
     CommitStrategy commitStrategy,
-    const std::shared_ptr<const HiveConfig>& hiveConfig)
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    folly::Executor* executor)
     : inputType_(std::move(inputType)),
       insertTableHandle_(std::move(insertTableHandle)),
       connectorQueryCtx_(connectorQueryCtx),
@@ -377,7 +379,18 @@ HiveDataSink::HiveDataSink(
                        : nullptr),
       writerFactory_(dwio::common::getWriterFactory(
           insertTableHandle_->tableStorageFormat())),
-      spillConfig_(connectorQueryCtx->spillConfig()) {
+      spillConfig_(connectorQueryCtx->spillConfig()),
+      maxTargetFileSize_(
+          isBucketed() ? 0
+                       : hiveConfig_->maxTargetFileSize(
+                             connectorQueryCtx->sessionProperties())),
+      maxOpenFileWriters_(
+          isBucketed() ? 0
+                       : hiveConfig_->maxOpenWriters(
+                             connectorQueryCtx->sessionProperties())),
+      executor_(executor),
+      maxParallelWriterCloses_(hiveConfig_->maxParallelWriterCloses(
+          connectorQueryCtx->sessionProperties())) {
   VELOX_USER_CHECK(
       !isBucketed() || isPartitioned(), "A bucket table must be partitioned");
   if (isBucketed()) {
@@ -422,6 +435,7 @@ bool HiveDataSink::canReclaim() const {
 
 void HiveDataSink::appendData(RowVectorPtr input) {
   checkRunning();
+  ++numInputs_;
 
   // Write to unpartitioned table.
   if (!isPartitioned()) {
@@ -467,6 +481,52 @@ void HiveDataSink::write(size_t index, RowVectorPtr input) {
 
   writers_[index]->write(dataInput);
   writerInfo_[index]->numWrittenRows += dataInput->size();
+  maybeRollOverFile(index);
+}
+
+void HiveDataSink::maybeRollOverFile(uint32_t index) {
+  if (maxTargetFileSize_ == 0 ||
+      ioStats_[index]->rawBytesWritten() < maxTargetFileSize_) {
+    return;
+  }
+  finishWriter(index);
+}
+
+void HiveDataSink::finishWriter(uint32_t index) {
+  VELOX_CHECK_NOT_NULL(writers_[index]);
+  {
+    WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+    writers_[index]->close();
+  }
+  writers_[index].reset();
+  for (auto it = writerIndexMap_.begin(); it != writerIndexMap_.end(); ++it) {
+    if (it->second == index) {
+      writerIndexMap_.erase(it);
+      return;
+    }
+  }
+  VELOX_UNREACHABLE("Closed writer {} is not open", index);
+}
+
+void HiveDataSink::maybeCloseLeastRecentWriter() {
+  if (maxOpenFileWriters_ == 0 ||
+      writerIndexMap_.size() < maxOpenFileWriters_) {
+    return;
+  }
+  // The writers that have rows in the current input are not closed, so the
+  // limit may be exceeded by the number of partitions of one input.
+  std::optional<uint32_t> leastRecent;
+  for (const auto& [id, index] : writerIndexMap_) {
+    const auto lastInput = writerInfo_[index]->lastInput;
+    if (lastInput < numInputs_ &&
+        (!leastRecent.has_value() ||
+         lastInput < writerInfo_[leastRecent.value()]->lastInput)) {
+      leastRecent = index;
+    }
+  }
+  if (leastRecent.has_value()) {
+    finishWriter(leastRecent.value());
+  }
 }
 
 std::string HiveDataSink::stateString(State state) {
@@ -521,8 +581,13 @@ DataSink::Stats HiveDataSink::stats() const {
 std::shared_ptr<memory::MemoryPool> HiveDataSink::createWriterPool(
     const HiveWriterId& writerId) {
   auto* connectorPool = connectorQueryCtx_->connectorMemoryPool();
-  return connectorPool->addAggregateChild(
-      fmt::format("{}.{}", connectorPool->name(), writerId.toString()));
+  if (maxTargetFileSize_ == 0 && maxOpenFileWriters_ == 0) {
+    return connectorPool->addAggregateChild(
+        fmt::format("{}.{}", connectorPool->name(), writerId.toString()));
+  }
+  // A writer id may have several files, one after the other.
+  return connectorPool->addAggregateChild(fmt::format(
+      "{}.{}.{}", connectorPool->name(), writerId.toString(), writers_.size()));
 }
 
 void HiveDataSink::setMemoryReclaimers(
@@ -598,6 +663,17 @@ std::vector<std::string> HiveDataSink::close() {
   return partitionUpdates;
 }
 
+void HiveDataSink::flush() {
+  checkRunning();
+  for (uint32_t i = 0; i < writers_.size(); ++i) {
+    if (writers_[i] == nullptr) {
+      continue;
+    }
+    WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
+    writers_[i]->flush();
+  }
+}
+
 void HiveDataSink::abort() {
   checkRunning();
   state_ = State::kAborted;
@@ -611,32 +687,84 @@ void HiveDataSink::closeInternal() {
       "facebook::velox::connector::hive::HiveDataSink::closeInternal", this);
 
   if (state_ == State::kClosed) {
-    for (int i = 0; i < writers_.size(); ++i) {
-      WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
-      writers_[i]->close();
-    }
+    closeWriters();
   } else {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->abort();
     }
   }
 }
 
+void HiveDataSink::closeWriter(uint32_t index) {
+  WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+  writers_[index]->close();
+}
+
+void HiveDataSink::closeWriters() {
+  std::vector<uint32_t> openWriters;
+  for (uint32_t i = 0; i < writers_.size(); ++i) {
+    if (writers_[i] != nullptr) {
+      openWriters.push_back(i);
+    }
+  }
+  const auto numGroups =
+      std::min<size_t>(maxParallelWriterCloses_, openWriters.size());
+  if (executor_ == nullptr || numGroups <= 1) {
+    for (const auto index : openWriters) {
+      closeWriter(index);
+    }
+    return;
+  }
+
+  // Group 'i' closes every 'numGroups'th writer from the 'i'th one. Group 0
+  // runs on this thread. All the groups finish before the first error, if
+  // any, is rethrown.
+  auto closeGroup = [&](size_t group) {
+    for (auto i = group; i < openWriters.size(); i += numGroups) {
+      closeWriter(openWriters[i]);
+    }
+  };
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  futures.reserve(numGroups - 1);
+  for (size_t group = 1; group < numGroups; ++group) {
+    futures.push_back(
+        folly::via(executor_, [&closeGroup, group]() { closeGroup(group); })
+            .semi());
+  }
+  std::exception_ptr error;
+  try {
+    closeGroup(0);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  for (auto& result : folly::collectAll(std::move(futures)).get()) {
+    if (result.hasException() && error == nullptr) {
+      error = result.exception().to_exception_ptr();
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
 uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
   auto it = writerIndexMap_.find(id);
-  if (it != writerIndexMap_.end()) {
-    return it->second;
-  }
-  return appendWriter(id);
+  const auto index =
+      it != writerIndexMap_.end() ? it->second : appendWriter(id);
+  writerInfo_[index]->lastInput = numInputs_;
+  return index;
 }
 
 uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
+  maybeCloseLeastRecentWriter();
   // Check max open writers.
   VELOX_USER_CHECK_LE(
-      writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+      writerIndexMap_.size(), maxOpenWriters_, "Exceeded open writer limit");
   VELOX_CHECK_EQ(writers_.size(), writerInfo_.size());
-  VELOX_CHECK_EQ(writerIndexMap_.size(), writerInfo_.size());
 
   std::optional<std::string> partitionName;
   if (isPartitioned()) {
@@ -681,6 +809,12 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
       hiveConfig_->orcWriterMaxDictionaryMemory(connectorSessionProperties));
   options.parquetWriteTimestampUnit =
       hiveConfig_->parquetWriteTimestampUnit(connectorSessionProperties);
+  options.parquetWritePageIndex =
+      hiveConfig_->parquetWritePageIndex(connectorSessionProperties);
+  options.parquetBloomFilterColumns =
+      hiveConfig_->parquetWriteBloomFilterColumns(connectorSessionProperties);
+  options.parquetBloomFilterFpp =
+      hiveConfig_->parquetWriteBloomFilterFpp(connectorSessionProperties);
   options.serdeParameters = std::map<std::string, std::string>(
       insertTableHandle_->serdeParameters().begin(),
       insertTableHandle_->serdeParameters().end());
@@ -369,6 +369,9 @@ struct HiveWriterInfo {
   const std::shared_ptr<memory::MemoryPool> sinkPool;
   const std::shared_ptr<memory::MemoryPool> sortPool;
   int64_t numWrittenRows = 0;
+  /// The sequence number of the last sink input with rows for this writer.
+  /// Used to pick the file to close when too many files are open.
+  uint64_t lastInput{0};
 };
 
 /// Identifies a hive writer.
@@ -419,7 +422,8 @@ class HiveDataSink : public DataSink {
       std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
       const ConnectorQueryCtx* connectorQueryCtx,
       CommitStrategy commitStrategy,
-      const std::shared_ptr<const HiveConfig>& hiveConfig);
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      folly::Executor* executor = nullptr);
 
   static uint32_t maxBucketCount() {
     static const uint32_t kMaxBucketCount = 100'000;
@@ -432,6 +436,8 @@ class HiveDataSink : public DataSink {
 
   std::vector<std::string> close() override;
 
+  void flush() override;
+
   void abort() override;
 
   bool canReclaim() const;
@@ -525,6 +531,25 @@ class HiveDataSink : public DataSink {
   // the newly created writer in 'writers_'.
   uint32_t appendWriter(const HiveWriterId& id);
 
+  // Closes the least recently written file without rows in the current input
+  // if 'maxOpenFileWriters_' files are open.
+  void maybeCloseLeastRecentWriter();
+
+  // Closes the file of the writer at 'index' if it has reached
+  // 'maxTargetFileSize_'. The next rows for the writer go to a new file.
+  void maybeRollOverFile(uint32_t index);
+
+  // Closes the file of the writer at 'index'. The writer stays in 'writers_'
+  // for the stats and the partition updates but gets no more rows.
+  void finishWriter(uint32_t index);
+
+  // Closes the file of the writer at 'index' at the end of the write.
+  void closeWriter(uint32_t index);
+
+  // Closes the files of the open writers at the end of the write. Up to
+  // 'maxParallelWriterCloses_' files are closed concurrently on 'executor_'.
+  void closeWriters();
+
   std::unique_ptr<facebook::velox::dwio::common::Writer>
   maybeCreateBucketSortWriter(
       std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
@@ -568,6 +593,13 @@ class HiveDataSink : public DataSink {
   const std::unique_ptr<core::PartitionFunction> bucketFunction_;
   const std::shared_ptr<dwio::common::WriterFactory> writerFactory_;
   const common::SpillConfig* const spillConfig_;
+  // The file size after which a new file is started. 0 if unlimited.
+  const uint64_t maxTargetFileSize_;
+  // The maximum number of open files. 0 if only limited by 'maxOpenWriters_'.
+  const uint32_t maxOpenFileWriters_;
+  // Used to close the files in parallel. May be nullptr.
+  folly::Executor* const executor_;
+  const uint32_t maxParallelWriterCloses_;
 
   std::vector<column_index_t> sortColumnIndices_;
   std::vector<CompareFlags> sortCompareFlags_;
@@ -576,12 +608,18 @@ class HiveDataSink : public DataSink {
 
   tsan_atomic<bool> nonReclaimableSection_{false};
 
-  // The map from writer id to the writer index in 'writers_' and 'writerInfo_'.
+  // The number of inputs added so far.
+  uint64_t numInputs_{0};
+
+  // The map from writer id to the index in 'writers_' and 'writerInfo_' of the
+  // open writer for the id. 'writers_' also has the closed writers of the
+  // files that are rolled over.
   folly::F14FastMap<HiveWriterId, uint32_t, HiveWriterIdHasher, HiveWriterIdEq>
       writerIndexMap_;
 
-  // Below are structures for partitions from all inputs. writerInfo_ and
-  // writers_ are both indexed by partitionId.
+  // Below are structures for the files of all inputs. writerInfo_ and writers_
+  // are both indexed by the values of 'writerIndexMap_'. The writers of closed
+  // files are null.
   std::vector<std::shared_ptr<HiveWriterInfo>> writerInfo_;
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
   // IO statistics collected for each writer.
@@ -162,6 +162,15 @@ HiveDataSource::HiveDataSource(
   ioStats_ = std::make_shared<io::IoStatistics>();
 }
 
+HiveDataSource::~HiveDataSource() {
+  // The readers being opened in the background refer to this.
+  for (auto& file : packedFiles_) {
+    if (file.opened.valid()) {
+      std::move(file.opened).wait();
+    }
+  }
+}
+
 std::unique_ptr<SplitReader> HiveDataSource::createSplitReader() {
   return SplitReader::create(
       split_,
@@ -180,20 +189,70 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   VELOX_CHECK_NULL(
       split_,
       "Previous split has not been processed yet. Call next to process the split.");
+  if (auto packedSplit = std::dynamic_pointer_cast<HivePackedSplit>(split)) {
+    addPackedSplit(packedSplit);
+    return;
+  }
   split_ = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
   VELOX_CHECK_NOT_NULL(split_, "Wrong type of split");
 
   VLOG(1) << "Adding split " << split_->toString();
 
-  if (splitReader_) {
+  // A split of the same file as the previous one, e.g. the next byte range
+  // of a file that is read as several splits, keeps the file reader.
+  if (splitReader_ &&
+      hiveConfig_->reuseFileReaders(connectorQueryCtx_->sessionProperties()) &&
+      splitReader_->canReuseReader(*split_)) {
+    splitReader_->reuseReaderForSplit(split_);
+    ++runtimeStats_.reusedFileReaders;
+  } else {
     splitReader_.reset();
+    splitReader_ = createSplitReader();
+    // Split reader subclasses may need to use the reader options in
+    // prepareSplit so we initialize it beforehand.
+    splitReader_->configureReaderOptions(randomSkip_);
   }
+  splitReader_->prepareSplit(metadataFilter_, runtimeStats_);
+}
 
-  splitReader_ = createSplitReader();
-  // Split reader subclasses may need to use the reader options in prepareSplit
-  // so we initialize it beforehand.
-  splitReader_->configureReaderOptions(randomSkip_);
+void HiveDataSource::addPackedSplit(
+    const std::shared_ptr<HivePackedSplit>& split) {
+  VLOG(1) << "Adding split " << split->toString();
+  VELOX_CHECK(packedFiles_.empty());
+  splitReader_.reset();
+  for (const auto& file : split->splits) {
+    split_ = file;
+    auto reader = createSplitReader();
+    reader->configureReaderOptions(randomSkip_);
+    // Pruned files are counted in the stats here and not opened.
+    const bool pruned = reader->checkIfSplitIsPruned(runtimeStats_);
+    auto& packedFile = packedFiles_.emplace_back();
+    packedFile.split = file;
+    packedFile.reader = std::move(reader);
+    if (!pruned && executor_ != nullptr && packedFiles_.size() > 1) {
+      packedFile.opened =
+          folly::via(executor_, [rawReader = packedFile.reader.get()]() {
+            rawReader->openReader();
+          }).semi();
+    }
+  }
+  startNextPackedFile();
+}
+
+bool HiveDataSource::startNextPackedFile() {
+  if (packedFiles_.empty()) {
+    return false;
+  }
+  auto file = std::move(packedFiles_.front());
+  packedFiles_.pop_front();
+  if (file.opened.valid()) {
+    // Rethrows the error of opening the file, if any.
+    std::move(file.opened).get();
+  }
+  split_ = std::move(file.split);
+  splitReader_ = std::move(file.reader);
   splitReader_->prepareSplit(metadataFilter_, runtimeStats_);
+  return true;
 }
 
 std::optional<RowVectorPtr> HiveDataSource::next(
@@ -203,6 +262,9 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   VELOX_CHECK_NOT_NULL(splitReader_, "No split reader present");
 
   if (splitReader_->emptySplit()) {
+    if (startNextPackedFile()) {
+      return getEmptyOutput();
+    }
     resetSplit();
     return nullptr;
   }
@@ -266,6 +328,9 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   }
 
   splitReader_->updateRuntimeStats(runtimeStats_);
+  if (startNextPackedFile()) {
+    return getEmptyOutput();
+  }
   resetSplit();
   return nullptr;
 }
@@ -327,6 +392,8 @@ void HiveDataSource::setFromDataSource(
   VELOX_CHECK_NOT_NULL(source, "Bad DataSource type");
 
   split_ = std::move(source->split_);
+  VELOX_CHECK(packedFiles_.empty());
+  packedFiles_ = std::move(source->packedFiles_);
   runtimeStats_.skippedSplits += source->runtimeStats_.skippedSplits;
   runtimeStats_.skippedSplitBytes += source->runtimeStats_.skippedSplitBytes;
   source->scanSpec_->moveAdaptationFrom(*scanSpec_);
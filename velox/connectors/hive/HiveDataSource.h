@@ -15,6 +15,10 @@
  */
 #pragma once
 
+#include <deque>
+
+#include <folly/futures/Future.h>
+
 #include "velox/common/base/RandomUtil.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/connectors/Connector.h"
@@ -46,6 +50,8 @@ class HiveDataSource : public DataSource {
       const ConnectorQueryCtx* connectorQueryCtx,
       const std::shared_ptr<HiveConfig>& hiveConfig);
 
+  ~HiveDataSource() override;
+
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
   std::optional<RowVectorPtr> next(uint64_t size, velox::ContinueFuture& future)
@@ -127,6 +133,25 @@ class HiveDataSource : public DataSource {
   // filterEvalCtx_.selectedIndices and selectedBits are not updated.
   vector_size_t evaluateRemainingFilter(RowVectorPtr& rowVector);
 
+  // A file of a HivePackedSplit that is not read yet. 'opened' is set if the
+  // reader of the file is being created on 'executor_'.
+  struct PackedFile {
+    std::shared_ptr<HiveConnectorSplit> split;
+    std::unique_ptr<SplitReader> reader;
+    folly::SemiFuture<folly::Unit> opened{
+        folly::SemiFuture<folly::Unit>::makeEmpty()};
+  };
+
+  // Prunes the files of 'split' and starts opening the readers of the
+  // remaining files except the first one in the background. Then starts
+  // reading the first file.
+  void addPackedSplit(const std::shared_ptr<HivePackedSplit>& split);
+
+  // Makes the next file of the current packed split the current split. Waits
+  // for its reader to be opened if this is in progress. Returns false if
+  // there are no more files.
+  bool startNextPackedFile();
+
   // Clear split_ after split has been fully processed.  Keep readers around to
   // hold adaptation.
   void resetSplit();
@@ -158,6 +183,9 @@ class HiveDataSource : public DataSource {
   exec::FilterEvalCtx filterEvalCtx_;
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
 
+  // The files of the current HivePackedSplit after the one in 'split_'.
+  std::deque<PackedFile> packedFiles_;
+
   // Remembers the WaveDataSource. Successive calls to toWaveDataSource() will
   // return the same.
   std::shared_ptr<wave::WaveDataSource> waveDataSource_;
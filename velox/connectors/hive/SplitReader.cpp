@@ -23,6 +23,7 @@
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/dwio/common/ParallelUnitLoader.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/type/TimestampConversion.h"
 
@@ -141,7 +142,11 @@ void SplitReader::configureReaderOptions(
 void SplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats) {
-  createReader();
+  if (checkIfSplitIsPruned(runtimeStats)) {
+    return;
+  }
+
+  openReader();
 
   if (checkIfSplitIsEmpty(runtimeStats)) {
     VELOX_CHECK(emptySplit_);
@@ -151,6 +156,27 @@ void SplitReader::prepareSplit(
   createRowReader(metadataFilter);
 }
 
+bool SplitReader::canReuseReader(const HiveConnectorSplit& split) const {
+  if (!baseReader_ || !readerSplit_) {
+    return false;
+  }
+  const auto& extraFileInfo = readerSplit_->extraFileInfo;
+  return split.filePath == readerSplit_->filePath &&
+      split.fileFormat == readerSplit_->fileFormat &&
+      split.serdeParameters == readerSplit_->serdeParameters &&
+      split.customSplitInfo == readerSplit_->customSplitInfo &&
+      (split.extraFileInfo == extraFileInfo ||
+       (split.extraFileInfo && extraFileInfo &&
+        *split.extraFileInfo == *extraFileInfo));
+}
+
+void SplitReader::reuseReaderForSplit(
+    std::shared_ptr<const HiveConnectorSplit> split) {
+  VELOX_CHECK(canReuseReader(*split));
+  hiveSplit_ = std::move(split);
+  emptySplit_ = false;
+}
+
 uint64_t SplitReader::next(uint64_t size, VectorPtr& output) {
   if (!baseReaderOpts_.randomSkip()) {
     return baseRowReader_->next(size, output);
@@ -211,6 +237,12 @@ std::string SplitReader::toString() const {
       static_cast<const void*>(baseRowReader_.get()));
 }
 
+void SplitReader::openReader() {
+  if (!baseReader_ && !emptySplit_) {
+    createReader();
+  }
+}
+
 void SplitReader::createReader() {
   VELOX_CHECK_NE(
       baseReaderOpts_.getFileFormat(), dwio::common::FileFormat::UNKNOWN);
@@ -241,6 +273,7 @@ void SplitReader::createReader() {
 
   baseReader_ = dwio::common::getReaderFactory(baseReaderOpts_.getFileFormat())
                     ->createReader(std::move(baseFileInput), baseReaderOpts_);
+  readerSplit_ = hiveSplit_;
 }
 
 bool SplitReader::checkIfSplitIsEmpty(
@@ -272,18 +305,72 @@ bool SplitReader::checkIfSplitIsEmpty(
   return emptySplit_;
 }
 
+bool SplitReader::checkIfSplitIsPruned(
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  if (emptySplit_) {
+    return true;
+  }
+  const auto& dataColumns = hiveTableHandle_->dataColumns()
+      ? hiveTableHandle_->dataColumns()
+      : readerOutputType_;
+  if (!testFiltersBeforeOpen(
+          scanSpec_.get(), *hiveSplit_, *partitionKeys_, dataColumns)) {
+    ++runtimeStats.skippedSplits;
+    runtimeStats.skippedSplitBytes += hiveSplit_->length;
+    emptySplit_ = true;
+  }
+  return emptySplit_;
+}
+
 void SplitReader::createRowReader(
     std::shared_ptr<common::MetadataFilter> metadataFilter) {
   auto& fileType = baseReader_->rowType();
   auto columnTypes = adaptColumns(fileType, baseReaderOpts_.getFileSchema());
+  // A MAP column of a DWRF file that is read as a ROW returns the values of
+  // the keys named by the ROW fields. The file type is kept for the column
+  // selector and the flat map reader makes the struct.
+  std::vector<std::pair<column_index_t, std::vector<std::string>>>
+      mapsAsStruct;
+  const auto format = baseReaderOpts_.getFileFormat();
+  if (format == dwio::common::FileFormat::DWRF ||
+      format == dwio::common::FileFormat::ORC) {
+    for (column_index_t i = 0; i < fileType->size(); ++i) {
+      if (fileType->childAt(i)->isMap() && columnTypes[i]->isRow()) {
+        mapsAsStruct.emplace_back(i, columnTypes[i]->asRow().names());
+        columnTypes[i] = fileType->childAt(i);
+      }
+    }
+  }
+  auto columnType =
+      ROW(std::vector<std::string>(fileType->names()), std::move(columnTypes));
+  std::unordered_map<uint32_t, std::vector<std::string>> flatMapNodeIdsAsStruct;
+  if (!mapsAsStruct.empty()) {
+    auto typeWithId = dwio::common::TypeWithId::create(columnType);
+    for (auto& [column, keys] : mapsAsStruct) {
+      flatMapNodeIdsAsStruct[typeWithId->childAt(column)->id()] =
+          std::move(keys);
+    }
+  }
 
   configureRowReaderOptions(
       baseRowReaderOpts_,
       hiveTableHandle_->tableParameters(),
       scanSpec_,
       metadataFilter,
-      ROW(std::vector<std::string>(fileType->names()), std::move(columnTypes)),
+      columnType,
       hiveSplit_);
+  baseRowReaderOpts_.setFlatmapNodeIdsAsStruct(
+      std::move(flatMapNodeIdsAsStruct));
+  const auto parallelUnitLoadCount = hiveConfig_->parallelUnitLoadCount(
+      connectorQueryCtx_->sessionProperties());
+  if (parallelUnitLoadCount > 0 && executor_ != nullptr) {
+    baseRowReaderOpts_.setUnitLoaderFactory(
+        std::make_shared<dwio::common::ParallelUnitLoaderFactory>(
+            executor_, parallelUnitLoadCount, nullptr));
+  }
+  baseRowReaderOpts_.setCollectColumnStats(
+      hiveConfig_->collectColumnReadStats(
+          connectorQueryCtx_->sessionProperties()));
   // NOTE: we firstly reset the finished 'baseRowReader_' of previous split
   // before setting up for the next one to avoid doubling the peak memory usage.
   baseRowReader_.reset();
@@ -93,6 +93,29 @@ class SplitReader {
       std::shared_ptr<common::MetadataFilter> metadataFilter,
       dwio::common::RuntimeStatistics& runtimeStats);
 
+  /// Checks if the hiveSplit_ can be skipped before the data file is opened.
+  /// The test is based on the partition key values and the file statistics
+  /// attached to the split. Sets emptySplit_ and returns true if so. Counts
+  /// the split in 'runtimeStats' only once when called again.
+  bool checkIfSplitIsPruned(dwio::common::RuntimeStatistics& runtimeStats);
+
+  /// Creates baseReader_ ahead of prepareSplit() unless the split is already
+  /// known to be empty. Used to read the footers of the files of a packed
+  /// split concurrently. May run on another thread than the other functions
+  /// but not concurrently with them.
+  void openReader();
+
+  /// Returns true if 'split' reads the same file with the same format and
+  /// serde parameters as the split for which baseReader_ was created, so that
+  /// baseReader_ can read 'split' after the current split. Table formats that
+  /// keep per split state outside of the row reader return false.
+  virtual bool canReuseReader(const HiveConnectorSplit& split) const;
+
+  /// Makes 'split' the split of 'this' while keeping baseReader_, its footer
+  /// and its cached stripe metadata. prepareSplit() then makes a new row
+  /// reader for the byte range of 'split'. Requires canReuseReader(*split).
+  void reuseReaderForSplit(std::shared_ptr<const HiveConnectorSplit> split);
+
   virtual uint64_t next(uint64_t size, VectorPtr& output);
 
   void resetFilterCaches();
@@ -138,6 +161,9 @@ class SplitReader {
       const std::optional<std::string>& value) const;
 
   std::shared_ptr<const HiveConnectorSplit> hiveSplit_;
+  // The split for which baseReader_ was created. Kept after resetSplit() to
+  // decide whether the next split can reuse baseReader_.
+  std::shared_ptr<const HiveConnectorSplit> readerSplit_;
   const std::shared_ptr<const HiveTableHandle> hiveTableHandle_;
   const std::unordered_map<
       std::string,
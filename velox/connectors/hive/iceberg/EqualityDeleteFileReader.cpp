@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteCache.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+namespace {
+constexpr uint64_t kDeleteBatchSize = 10'000;
+} // namespace
+
+std::shared_ptr<const EqualityDeleteSet> readEqualityDeleteSet(
+    const IcebergDeleteFile& deleteFile,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::string& connectorId) {
+  VELOX_CHECK(deleteFile.content == FileContent::kEqualityDeletes);
+  auto* cache = IcebergDeleteCache::getInstance();
+  if (cache) {
+    if (auto deleteSet = cache->get<EqualityDeleteSet>(deleteFile.filePath)) {
+      return deleteSet;
+    }
+  }
+
+  // A cached set may outlive the query, so the file is read into vectors of
+  // the pool of the cache.
+  auto* pool = cache ? cache->pool() : connectorQueryCtx->memoryPool();
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      deleteFile.filePath,
+      deleteFile.fileFormat,
+      0,
+      deleteFile.fileSizeInBytes);
+
+  dwio::common::ReaderOptions deleteReaderOpts(pool);
+  configureReaderOptions(
+      deleteReaderOpts,
+      hiveConfig,
+      connectorQueryCtx->sessionProperties(),
+      RowTypePtr(nullptr),
+      deleteSplit);
+
+  auto deleteFileHandle =
+      fileHandleFactory->generate(deleteFile.filePath).second;
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandle,
+      deleteReaderOpts,
+      connectorQueryCtx,
+      ioStats,
+      executor);
+  auto deleteReader =
+      dwio::common::getReaderFactory(deleteReaderOpts.getFileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  // The file schema does not carry the Iceberg field ids, so the delete file
+  // is expected to have just the equality columns.
+  const auto& keyType = deleteReader->rowType();
+  if (!deleteFile.equalityFieldIds.empty()) {
+    VELOX_CHECK_EQ(
+        deleteFile.equalityFieldIds.size(),
+        keyType->size(),
+        "Equality delete file {} has other columns than the equality fields",
+        deleteFile.filePath);
+  }
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  scanSpec->addAllChildFields(*keyType);
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      deleteRowReaderOpts, {}, scanSpec, nullptr, keyType, deleteSplit);
+  auto deleteRowReader = deleteReader->createRowReader(deleteRowReaderOpts);
+
+  auto keys = BaseVector::create<RowVector>(keyType, 0, pool);
+  VectorPtr batch = BaseVector::create(keyType, 0, pool);
+  while (deleteRowReader->next(kDeleteBatchSize, batch) > 0) {
+    if (batch->size() > 0) {
+      keys->append(batch->loadedVector());
+    }
+  }
+
+  auto deleteSet = std::make_shared<const EqualityDeleteSet>(std::move(keys));
+  if (cache) {
+    cache->put(deleteFile.filePath, deleteSet, deleteSet->memoryUsage());
+  }
+  return deleteSet;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
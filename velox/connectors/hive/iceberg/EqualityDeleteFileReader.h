@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <memory>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteSet.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// Returns the EqualityDeleteSet of the rows of the Iceberg equality delete
+/// file 'deleteFile'. The key columns are all the columns of the file, which
+/// are matched to the columns of the data files by name. Returns the set from
+/// the process wide IcebergDeleteCache if there is one and it has the set.
+/// Otherwise reads the file and adds the set to the cache. The memory of a
+/// cached set is allocated from the pool of the cache, else from the pool of
+/// 'connectorQueryCtx'.
+std::shared_ptr<const EqualityDeleteSet> readEqualityDeleteSet(
+    const IcebergDeleteFile& deleteFile,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::string& connectorId);
+
+} // namespace facebook::velox::connector::hive::iceberg
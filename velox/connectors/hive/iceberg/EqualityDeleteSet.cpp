@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteSet.h"
+
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+EqualityDeleteSet::EqualityDeleteSet(RowVectorPtr keys)
+    : keyType_(asRowType(keys->type())), keys_(std::move(keys)) {
+  VELOX_CHECK_GT(keyType_->size(), 0, "Equality deletes need key columns");
+  for (auto& child : keys_->children()) {
+    child = BaseVector::loadedVectorShared(child);
+  }
+  if (keys_->size() == 0) {
+    return;
+  }
+  hasValueIds_ = makeValueIds();
+  if (!hasValueIds_) {
+    hashers_.clear();
+    valueIds_.clear();
+    makeHashTable();
+  }
+}
+
+bool EqualityDeleteSet::makeValueIds() {
+  for (column_index_t i = 0; i < keyType_->size(); ++i) {
+    const auto& type = keyType_->childAt(i);
+    if (!exec::VectorHasher::typeKindSupportsValueIds(type->kind()) ||
+        keys_->childAt(i)->mayHaveNulls()) {
+      return false;
+    }
+    hashers_.push_back(exec::VectorHasher::create(type, i));
+  }
+
+  const auto numRows = keys_->size();
+  SelectivityVector rows(numRows);
+  raw_vector<uint64_t> ids(numRows);
+  // The first pass collects the ranges and distinct values of the keys.
+  for (auto& hasher : hashers_) {
+    hasher->decode(*keys_->childAt(hasher->channel()), rows);
+    hasher->computeValueIds(rows, ids);
+  }
+
+  // No keys are added after the build, so the ranges are not padded.
+  uint64_t multiplier = 1;
+  for (auto& hasher : hashers_) {
+    uint64_t asRange;
+    uint64_t asDistincts;
+    hasher->cardinality(0, asRange, asDistincts);
+    if (asRange == exec::VectorHasher::kRangeTooLarge &&
+        asDistincts == exec::VectorHasher::kRangeTooLarge) {
+      return false;
+    }
+    multiplier = asRange <= asDistincts
+        ? hasher->enableValueRange(multiplier, 0)
+        : hasher->enableValueIds(multiplier, 0);
+    if (multiplier == exec::VectorHasher::kRangeTooLarge) {
+      return false;
+    }
+  }
+
+  for (auto& hasher : hashers_) {
+    const bool ok = hasher->computeValueIds(rows, ids);
+    VELOX_CHECK(ok);
+  }
+  valueIds_.reserve(numRows);
+  valueIds_.insert(ids.begin(), ids.end());
+  return true;
+}
+
+void EqualityDeleteSet::makeHashTable() {
+  std::vector<const BaseVector*> columns;
+  for (const auto& child : keys_->children()) {
+    columns.push_back(child.get());
+  }
+  rowsByHash_.reserve(keys_->size());
+  for (vector_size_t row = 0; row < keys_->size(); ++row) {
+    rowsByHash_.emplace(hashRow(columns, row), row);
+  }
+}
+
+uint64_t EqualityDeleteSet::hashRow(
+    const std::vector<const BaseVector*>& columns,
+    vector_size_t row) const {
+  uint64_t hash = columns[0]->hashValueAt(row);
+  for (auto i = 1; i < columns.size(); ++i) {
+    hash = bits::hashMix(hash, columns[i]->hashValueAt(row));
+  }
+  return hash;
+}
+
+void EqualityDeleteSet::markDeleted(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t numRows,
+    uint64_t* deleted) const {
+  VELOX_CHECK_EQ(keys.size(), keyType_->size());
+  if (keys_->size() == 0 || numRows == 0) {
+    return;
+  }
+
+  if (hasValueIds_) {
+    SelectivityVector rows(numRows);
+    // The set has no null keys, so rows with a null key are not deleted.
+    for (const auto& key : keys) {
+      if (key->mayHaveNulls()) {
+        DecodedVector decoded(*key, rows);
+        rows.applyToSelected([&](vector_size_t row) {
+          if (decoded.isNullAt(row)) {
+            rows.setValid(row, false);
+          }
+        });
+        rows.updateBounds();
+      }
+    }
+    raw_vector<uint64_t> ids(numRows);
+    exec::VectorHasher::ScratchMemory scratch;
+    for (auto& hasher : hashers_) {
+      if (!rows.hasSelections()) {
+        return;
+      }
+      hasher->lookupValueIds(*keys[hasher->channel()], rows, scratch, ids);
+    }
+    rows.applyToSelected([&](vector_size_t row) {
+      if (valueIds_.contains(ids[row])) {
+        bits::setBit(deleted, row);
+      }
+    });
+    return;
+  }
+
+  std::vector<const BaseVector*> columns;
+  for (const auto& key : keys) {
+    columns.push_back(key.get());
+  }
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    auto range = rowsByHash_.equal_range(hashRow(columns, row));
+    for (auto it = range.first; it != range.second; ++it) {
+      bool equal = true;
+      for (auto i = 0; i < columns.size() && equal; ++i) {
+        equal = columns[i]->equalValueAt(
+            keys_->childAt(i).get(), row, it->second);
+      }
+      if (equal) {
+        bits::setBit(deleted, row);
+        break;
+      }
+    }
+  }
+}
+
+int64_t EqualityDeleteSet::memoryUsage() const {
+  // The hash tables are estimated at 2 words per entry for the value ids and 4
+  // words per node for the rows by hash.
+  return keys_->retainedSize() + valueIds_.size() * 2 * sizeof(uint64_t) +
+      rowsByHash_.size() * 4 * sizeof(uint64_t);
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <unordered_map>
+
+#include <folly/container/F14Set.h>
+
+#include "velox/exec/VectorHasher.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// The keys of the rows deleted by an Iceberg equality delete file. A row
+/// of a data file is deleted if its values of the key columns are equal to
+/// the values of any row in the set. Nulls are equal to nulls. The keys are
+/// mapped to normalized keys by VectorHashers if their types and number of
+/// distinct values allow, else they are kept in a hash table of the rows of
+/// 'keys'. Immutable after construction, so that it can be shared by the
+/// readers of any number of splits.
+class EqualityDeleteSet {
+ public:
+  /// Builds the set from the rows of 'keys'. The columns of 'keys' are the key
+  /// columns. 'keys' should be allocated from a pool that outlives the set.
+  explicit EqualityDeleteSet(RowVectorPtr keys);
+
+  /// Returns the names and types of the key columns.
+  const RowTypePtr& keyType() const {
+    return keyType_;
+  }
+
+  /// Sets the bits in 'deleted' for the first 'numRows' rows of 'keys' whose
+  /// values are in the set. 'keys' are the key columns in the order of
+  /// keyType(). Thread safe.
+  void markDeleted(
+      const std::vector<VectorPtr>& keys,
+      vector_size_t numRows,
+      uint64_t* deleted) const;
+
+  /// The number of rows the set was built from.
+  vector_size_t numKeys() const {
+    return keys_->size();
+  }
+
+  /// True if the keys are mapped to normalized keys.
+  bool hasValueIds() const {
+    return hasValueIds_;
+  }
+
+  /// Returns the approximate number of bytes used by the set.
+  int64_t memoryUsage() const;
+
+ private:
+  // Maps the keys to value ids by 'hashers_' and fills 'valueIds_'. Returns
+  // false if some key type, a null key or the number of distinct values does
+  // not allow value ids.
+  bool makeValueIds();
+
+  // Fills 'rowsByHash_' with all the rows of 'keys_'.
+  void makeHashTable();
+
+  uint64_t hashRow(
+      const std::vector<const BaseVector*>& columns,
+      vector_size_t row) const;
+
+  const RowTypePtr keyType_;
+  const RowVectorPtr keys_;
+  bool hasValueIds_{false};
+  std::vector<std::unique_ptr<exec::VectorHasher>> hashers_;
+  folly::F14FastSet<uint64_t> valueIds_;
+  // Rows of 'keys_' by their hash. Used if 'valueIds_' is empty.
+  std::unordered_multimap<uint64_t, vector_size_t> rowsByHash_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/connectors/hive/iceberg/IcebergDeleteCache.h"
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+IcebergDeleteCache::IcebergDeleteCache(int64_t capacity)
+    : capacity_(capacity), pool_(memory::memoryManager()->addLeafPool()) {
+  VELOX_CHECK_GT(capacity_, 0);
+}
+
+// static
+IcebergDeleteCache* IcebergDeleteCache::getInstance() {
+  return *getInstancePtr();
+}
+
+// static
+void IcebergDeleteCache::setInstance(IcebergDeleteCache* cache) {
+  *getInstancePtr() = cache;
+}
+
+// static
+IcebergDeleteCache** IcebergDeleteCache::getInstancePtr() {
+  static IcebergDeleteCache* cache_{nullptr};
+  return &cache_;
+}
+
+std::shared_ptr<const void> IcebergDeleteCache::getInternal(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->value;
+}
+
+void IcebergDeleteCache::put(
+    const std::string& key,
+    std::shared_ptr<const void> value,
+    int64_t bytes) {
+  VELOX_CHECK_NOT_NULL(value);
+  if (bytes > capacity_) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    removeLocked(it->second);
+  }
+  while (bytes_ + bytes > capacity_) {
+    removeLocked(std::prev(lru_.end()));
+  }
+  lru_.push_front({key, std::move(value), bytes});
+  entries_[key] = lru_.begin();
+  bytes_ += bytes;
+}
+
+void IcebergDeleteCache::removeLocked(EntryList::iterator it) {
+  bytes_ -= it->bytes;
+  entries_.erase(it->key);
+  lru_.erase(it);
+}
+
+void IcebergDeleteCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  bytes_ = 0;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// Process wide cache of the decoded contents of Iceberg delete files, e.g.
+/// the EqualityDeleteSet of an equality delete file or the RoaringBitmap of
+/// the positions a positional delete file deletes from one data file. The
+/// splits of the data files a delete file applies to then decode it once per
+/// node. Iceberg files are immutable, so the entries are keyed by paths. Each
+/// kind of delete file makes its own keys, so that a key determines the type
+/// of the entry. The total size of the entries is kept within a capacity in
+/// bytes by evicting the least recently used ones. Thread safe.
+class IcebergDeleteCache {
+ public:
+  explicit IcebergDeleteCache(int64_t capacity);
+
+  /// Returns the process wide cache or nullptr if there is none.
+  static IcebergDeleteCache* getInstance();
+
+  static void setInstance(IcebergDeleteCache* cache);
+
+  /// Returns the entry for 'key' or nullptr if not cached. 'T' must be the
+  /// type the entry was inserted with.
+  template <typename T>
+  std::shared_ptr<const T> get(const std::string& key) {
+    return std::static_pointer_cast<const T>(getInternal(key));
+  }
+
+  /// Adds 'value' of 'bytes' in-memory size for 'key'. Replaces any existing
+  /// entry for 'key'. Values larger than the capacity are not cached.
+  void put(
+      const std::string& key,
+      std::shared_ptr<const void> value,
+      int64_t bytes);
+
+  /// The pool to allocate the memory of cached vectors from. Entries may
+  /// outlive the queries that make them, so they may not use the pools of
+  /// the queries. The cache must outlive the users of its entries.
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  int64_t numEntries() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return entries_.size();
+  }
+
+  int64_t bytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return bytes_;
+  }
+
+  void clear();
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const void> value;
+    int64_t bytes;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  static IcebergDeleteCache** getInstancePtr();
+
+  std::shared_ptr<const void> getInternal(const std::string& key);
+
+  void removeLocked(EntryList::iterator it);
+
+  const int64_t capacity_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  EntryList lru_;
+  folly::F14FastMap<std::string, EntryList::iterator> entries_;
+  int64_t bytes_{0};
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -16,9 +16,11 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/exec/OperatorUtils.h"
 
 using namespace facebook::velox::dwio::common;
 
@@ -53,7 +55,11 @@ IcebergSplitReader::IcebergSplitReader(
 void IcebergSplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats) {
-  createReader();
+  if (checkIfSplitIsPruned(runtimeStats)) {
+    return;
+  }
+
+  openReader();
 
   if (checkIfSplitIsEmpty(runtimeStats)) {
     VELOX_CHECK(emptySplit_);
@@ -67,6 +73,7 @@ void IcebergSplitReader::prepareSplit(
   baseReadOffset_ = 0;
   splitOffset_ = baseRowReader_->nextRowNumber();
   positionalDeleteFileReaders_.clear();
+  equalityDeletes_.clear();
 
   const auto& deleteFiles = icebergSplit->deleteFiles;
   for (const auto& deleteFile : deleteFiles) {
@@ -85,27 +92,65 @@ void IcebergSplitReader::prepareSplit(
                 splitOffset_,
                 hiveSplit_->connectorId));
       }
+    } else if (deleteFile.content == FileContent::kEqualityDeletes) {
+      if (deleteFile.recordCount > 0) {
+        addEqualityDeletes(deleteFile);
+      }
     } else {
       VELOX_NYI();
     }
   }
 }
 
+void IcebergSplitReader::addEqualityDeletes(
+    const IcebergDeleteFile& deleteFile) {
+  auto deleteSet = readEqualityDeleteSet(
+      deleteFile,
+      fileHandleFactory_,
+      connectorQueryCtx_,
+      executor_,
+      hiveConfig_,
+      ioStats_,
+      hiveSplit_->connectorId);
+  const auto& keyType = deleteSet->keyType();
+  std::vector<column_index_t> channels;
+  channels.reserve(keyType->size());
+  for (auto i = 0; i < keyType->size(); ++i) {
+    const auto& name = keyType->nameOf(i);
+    auto channel = readerOutputType_->getChildIdxIfExists(name);
+    VELOX_USER_CHECK(
+        channel.has_value(),
+        "Equality delete column {} of {} is not read by the scan",
+        name,
+        deleteFile.filePath);
+    VELOX_USER_CHECK(
+        readerOutputType_->childAt(*channel)->equivalent(
+            *keyType->childAt(i)),
+        "Equality delete column {} has type {} instead of {}",
+        name,
+        keyType->childAt(i)->toString(),
+        readerOutputType_->childAt(*channel)->toString());
+    channels.push_back(*channel);
+  }
+  equalityDeletes_.push_back({std::move(deleteSet), std::move(channels)});
+}
+
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   Mutation mutation;
   mutation.randomSkip = baseReaderOpts_.randomSkip().get();
   mutation.deletedRows = nullptr;
 
   if (!positionalDeleteFileReaders_.empty()) {
-    auto numBytes = bits::nbytes(size);
-    dwio::common::ensureCapacity<int8_t>(
-        deleteBitmap_, numBytes, connectorQueryCtx_->memoryPool());
-    std::memset((void*)deleteBitmap_->as<int8_t>(), 0L, numBytes);
+    const auto numWords = bits::nwords(size);
+    dwio::common::ensureCapacity<uint64_t>(
+        deleteBitmap_, numWords, connectorQueryCtx_->memoryPool());
+    std::memset(
+        deleteBitmap_->asMutable<uint64_t>(), 0, numWords * sizeof(uint64_t));
 
     for (auto iter = positionalDeleteFileReaders_.begin();
          iter != positionalDeleteFileReaders_.end();) {
       (*iter)->readDeletePositions(
-          baseReadOffset_, size, deleteBitmap_->asMutable<int8_t>());
+          baseReadOffset_, size, deleteBitmap_->asMutable<uint64_t>());
       if ((*iter)->endOfFile()) {
         iter = positionalDeleteFileReaders_.erase(iter);
       } else {
@@ -113,14 +158,60 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
       }
     }
 
-    deleteBitmap_->setSize(numBytes);
+    deleteBitmap_->setSize(numWords * sizeof(uint64_t));
     mutation.deletedRows = deleteBitmap_->as<uint64_t>();
   }
 
-  auto rowsScanned = baseRowReader_->next(size, output, &mutation);
+  if (equalityDeletes_.empty()) {
+    auto rowsScanned = baseRowReader_->next(size, output, &mutation);
+    baseReadOffset_ += rowsScanned;
+    return rowsScanned;
+  }
+
+  // 'output' may be a dictionary made by removeEqualityDeletes(), so the base
+  // row reader reuses its own output instead.
+  if (!baseOutput_) {
+    baseOutput_ = output;
+  }
+  auto rowsScanned = baseRowReader_->next(size, baseOutput_, &mutation);
   baseReadOffset_ += rowsScanned;
+  output = removeEqualityDeletes(baseOutput_);
 
   return rowsScanned;
 }
 
+VectorPtr IcebergSplitReader::removeEqualityDeletes(const VectorPtr& output) {
+  const auto numRows = output->size();
+  if (numRows == 0) {
+    return output;
+  }
+  auto* pool = connectorQueryCtx_->memoryPool();
+  const auto numBytes = bits::nbytes(numRows);
+  dwio::common::ensureCapacity<int8_t>(equalityDeleteBitmap_, numBytes, pool);
+  auto* deleted = equalityDeleteBitmap_->asMutable<uint64_t>();
+  std::memset(deleted, 0, numBytes);
+
+  auto rowVector = std::static_pointer_cast<RowVector>(output);
+  std::vector<VectorPtr> keys;
+  for (const auto& equalityDeletes : equalityDeletes_) {
+    keys.clear();
+    for (auto channel : equalityDeletes.channels) {
+      keys.push_back(
+          BaseVector::loadedVectorShared(rowVector->childAt(channel)));
+    }
+    equalityDeletes.deleteSet->markDeleted(keys, numRows, deleted);
+  }
+
+  const auto numDeleted = bits::countBits(deleted, 0, numRows);
+  if (numDeleted == 0) {
+    return output;
+  }
+  auto indices = allocateIndices(numRows - numDeleted, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numPassed = 0;
+  bits::forEachUnsetBit(
+      deleted, 0, numRows, [&](auto row) { rawIndices[numPassed++] = row; });
+  return exec::wrap(numPassed, std::move(indices), rowVector);
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
@@ -18,6 +18,7 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteSet.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -45,9 +46,27 @@ class IcebergSplitReader : public SplitReader {
       std::shared_ptr<common::MetadataFilter> metadataFilter,
       dwio::common::RuntimeStatistics& runtimeStats) override;
 
+  // The delete files are opened per split.
+  bool canReuseReader(const HiveConnectorSplit& /*split*/) const override {
+    return false;
+  }
+
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
  private:
+  // The rows of an equality delete file, with the channels of their key
+  // columns in the output of the base row reader.
+  struct EqualityDeletes {
+    std::shared_ptr<const EqualityDeleteSet> deleteSet;
+    std::vector<column_index_t> channels;
+  };
+
+  // Adds the equality delete set of 'deleteFile' to 'equalityDeletes_'.
+  void addEqualityDeletes(const IcebergDeleteFile& deleteFile);
+
+  // Returns 'output' without the rows deleted by 'equalityDeletes_'.
+  VectorPtr removeEqualityDeletes(const VectorPtr& output);
+
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
@@ -58,5 +77,12 @@ class IcebergSplitReader : public SplitReader {
   std::list<std::unique_ptr<PositionalDeleteFileReader>>
       positionalDeleteFileReaders_;
   BufferPtr deleteBitmap_;
+
+  std::vector<EqualityDeletes> equalityDeletes_;
+  // The output of the base row reader if there are equality deletes. The
+  // output of next() wraps it in a dictionary of the rows that are not
+  // deleted.
+  VectorPtr baseOutput_;
+  BufferPtr equalityDeleteBitmap_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
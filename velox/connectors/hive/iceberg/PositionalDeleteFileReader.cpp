@@ -18,12 +18,17 @@
 
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/TableHandle.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteCache.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/dwio/common/ReaderFactory.h"
 
 namespace facebook::velox::connector::hive::iceberg {
 
+namespace {
+constexpr uint64_t kDeleteBatchSize = 10'000;
+} // namespace
+
 PositionalDeleteFileReader::PositionalDeleteFileReader(
     const IcebergDeleteFile& deleteFile,
     const std::string& baseFilePath,
@@ -42,23 +47,41 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       connectorQueryCtx_(connectorQueryCtx),
       hiveConfig_(hiveConfig),
       ioStats_(ioStats),
+      connectorId_(connectorId),
       pool_(connectorQueryCtx->memoryPool()),
       filePathColumn_(IcebergMetadataColumn::icebergDeleteFilePathColumn()),
       posColumn_(IcebergMetadataColumn::icebergDeletePosColumn()),
       splitOffset_(splitOffset),
-      deleteSplit_(nullptr),
-      deleteRowReader_(nullptr),
-      deletePositionsOutput_(nullptr),
-      deletePositionsOffset_(0),
+      positions_(nullptr),
       endOfFile_(false) {
   VELOX_CHECK(deleteFile_.content == FileContent::kPositionalDeletes);
 
   if (deleteFile_.recordCount == 0) {
+    endOfFile_ = true;
     return;
   }
 
-  // TODO: check if the lowerbounds and upperbounds in deleteFile overlap with
-  //  this batch. If not, no need to proceed.
+  // A delete file may delete rows from many data files, so the cached bitmaps
+  // are keyed by both files.
+  auto* cache = IcebergDeleteCache::getInstance();
+  const auto cacheKey =
+      fmt::format("{}\n{}", deleteFile_.filePath, baseFilePath_);
+  if (cache) {
+    positions_ = cache->get<RoaringBitmap>(cacheKey);
+  }
+  if (!positions_) {
+    positions_ = readPositions(runtimeStats);
+    if (cache) {
+      cache->put(cacheKey, positions_, positions_->memoryUsage());
+    }
+  }
+  maxPosition_ = positions_->max();
+  endOfFile_ = !maxPosition_.has_value();
+}
+
+std::shared_ptr<const RoaringBitmap> PositionalDeleteFileReader::readPositions(
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  auto positions = std::make_shared<RoaringBitmap>();
 
   // Create the ScanSpec for this delete file
   auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
@@ -76,8 +99,8 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
   RowTypePtr deleteFileSchema =
       ROW(std::move(deleteColumnNames), std::move(deleteColumnTypes));
 
-  deleteSplit_ = std::make_shared<HiveConnectorSplit>(
-      connectorId,
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId_,
       deleteFile_.filePath,
       deleteFile_.fileFormat,
       0,
@@ -91,7 +114,7 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       hiveConfig_,
       connectorQueryCtx_->sessionProperties(),
       deleteFileSchema,
-      deleteSplit_);
+      deleteSplit);
 
   auto deleteFileHandle =
       fileHandleFactory_->generate(deleteFile_.filePath).second;
@@ -107,19 +130,16 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
           ->createReader(std::move(deleteFileInput), deleteReaderOpts);
 
   // Check if the whole delete file split can be skipped. This could happen when
-  // 1) the delete file doesn't contain the base file that is being read; 2) The
-  // delete file does not contain the positions in the current batch for the
-  // base file.
+  // the delete file doesn't contain the base file that is being read.
   if (!testFilters(
           scanSpec.get(),
           deleteReader.get(),
-          deleteSplit_->filePath,
-          deleteSplit_->partitionKeys,
+          deleteSplit->filePath,
+          deleteSplit->partitionKeys,
           {})) {
     ++runtimeStats.skippedSplits;
-    runtimeStats.skippedSplitBytes += deleteSplit_->length;
-    deleteSplit_.reset();
-    return;
+    runtimeStats.skippedSplitBytes += deleteSplit->length;
+    return positions;
   }
 
   dwio::common::RowReaderOptions deleteRowReaderOpts;
@@ -129,75 +149,42 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       scanSpec,
       nullptr,
       deleteFileSchema,
-      deleteSplit_);
-
-  deleteRowReader_.reset();
-  deleteRowReader_ = deleteReader->createRowReader(deleteRowReaderOpts);
+      deleteSplit);
+
+  auto deleteRowReader = deleteReader->createRowReader(deleteRowReaderOpts);
+  VectorPtr deletePositionsOutput = BaseVector::create(
+      ROW({posColumn_->name}, {posColumn_->type}), 0, pool_);
+  while (deleteRowReader->next(kDeleteBatchSize, deletePositionsOutput) > 0) {
+    const auto numDeletedRows = deletePositionsOutput->size();
+    if (numDeletedRows == 0) {
+      continue;
+    }
+    auto deletePositionsVector =
+        deletePositionsOutput->as<RowVector>()->childAt(0)->loadedVector();
+    VELOX_CHECK(
+        !deletePositionsVector->mayHaveNulls(),
+        "Iceberg delete file pos column cannot have nulls");
+    const int64_t* deletePositions =
+        deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
+    for (auto i = 0; i < numDeletedRows; ++i) {
+      positions->add(deletePositions[i]);
+    }
+  }
+  return positions;
 }
 
 void PositionalDeleteFileReader::readDeletePositions(
     uint64_t baseReadOffset,
     uint64_t size,
-    int8_t* deleteBitmap) {
-  // We are going to read to the row number up to the end of the batch. For the
-  // same base file, the deleted rows are in ascending order in the same delete
-  // file
-  int64_t rowNumberUpperBound = splitOffset_ + baseReadOffset + size;
-
-  // Finish unused delete positions from last batch
-  if (deletePositionsOutput_ &&
-      deletePositionsOffset_ < deletePositionsOutput_->size()) {
-    updateDeleteBitmap(
-        std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)
-            ->childAt(0),
-        baseReadOffset,
-        rowNumberUpperBound,
-        deleteBitmap);
-
-    if (readFinishedForBatch(rowNumberUpperBound)) {
-      return;
-    }
-  }
-
-  if (!deleteRowReader_ || !deleteSplit_) {
-    return;
-  }
-
-  // Read the new delete positions for this batch into deletePositionsOutput_
-  // and update the delete bitmap
-
-  auto outputType = posColumn_->type;
-
-  RowTypePtr outputRowType = ROW({posColumn_->name}, {posColumn_->type});
-  if (!deletePositionsOutput_) {
-    deletePositionsOutput_ = BaseVector::create(outputRowType, 0, pool_);
+    uint64_t* deleteBitmap) {
+  // Convert the positions in file into positions relative to the start of the
+  // batch.
+  const uint64_t begin = splitOffset_ + baseReadOffset;
+  if (positions_) {
+    positions_->fill(begin, size, deleteBitmap);
   }
-
-  while (!readFinishedForBatch(rowNumberUpperBound)) {
-    auto rowsScanned = deleteRowReader_->next(size, deletePositionsOutput_);
-    if (rowsScanned > 0) {
-      VELOX_CHECK(
-          !deletePositionsOutput_->mayHaveNulls(),
-          "Iceberg delete file pos column cannot have nulls");
-
-      auto numDeletedRows = deletePositionsOutput_->size();
-      if (numDeletedRows > 0) {
-        deletePositionsOutput_->loadedVector();
-        deletePositionsOffset_ = 0;
-
-        updateDeleteBitmap(
-            std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)
-                ->childAt(0),
-            baseReadOffset,
-            rowNumberUpperBound,
-            deleteBitmap);
-      }
-    } else {
-      // Reaching the end of the file
-      endOfFile_ = true;
-      deleteSplit_.reset();
-      return;
-    }
+  if (!maxPosition_.has_value() || maxPosition_.value() < begin + size) {
+    endOfFile_ = true;
   }
 }
 
@@ -205,39 +192,4 @@ bool PositionalDeleteFileReader::endOfFile() {
   return endOfFile_;
 }
 
-void PositionalDeleteFileReader::updateDeleteBitmap(
-    VectorPtr deletePositionsVector,
-    uint64_t baseReadOffset,
-    int64_t rowNumberUpperBound,
-    int8_t* deleteBitmap) {
-  // Convert the positions in file into positions relative to the start of the
-  // split.
-  const int64_t* deletePositions =
-      deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
-  int64_t offset = baseReadOffset + splitOffset_;
-  while (deletePositionsOffset_ < deletePositionsVector->size() &&
-         deletePositions[deletePositionsOffset_] < rowNumberUpperBound) {
-    bits::setBit(
-        deleteBitmap, deletePositions[deletePositionsOffset_] - offset);
-    deletePositionsOffset_++;
-  }
-}
-
-bool PositionalDeleteFileReader::readFinishedForBatch(
-    int64_t rowNumberUpperBound) {
-  VELOX_CHECK_NOT_NULL(deletePositionsOutput_);
-
-  auto deletePositionsVector =
-      std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)->childAt(0);
-  const int64_t* deletePositions =
-      deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
-
-  if (deletePositionsOutput_->size() != 0 &&
-      deletePositionsOffset_ < deletePositionsVector->size() &&
-      deletePositions[deletePositionsOffset_] >= rowNumberUpperBound) {
-    return true;
-  }
-  return false;
-}
-
 } // namespace facebook::velox::connector::hive::iceberg
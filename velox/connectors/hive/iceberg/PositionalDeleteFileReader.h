@@ -23,6 +23,7 @@
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/RoaringBitmap.h"
 #include "velox/dwio/common/Reader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -33,6 +34,10 @@ struct IcebergMetadataColumn;
 using SubfieldFilters =
     std::unordered_map<common::Subfield, std::unique_ptr<common::Filter>>;
 
+/// Applies the positions a positional delete file deletes from one data file
+/// to the batches read from a split of the data file. The positions are
+/// decoded once into a RoaringBitmap, which is shared through the
+/// IcebergDeleteCache by the readers of all the splits of the data file.
 class PositionalDeleteFileReader {
  public:
   PositionalDeleteFileReader(
@@ -47,21 +52,20 @@ class PositionalDeleteFileReader {
       uint64_t splitOffset,
       const std::string& connectorId);
 
+  /// Sets the bits in 'deleteBitmap' for the deleted rows of the batch of
+  /// 'size' rows at 'baseReadOffset' from the start of the split.
   void readDeletePositions(
       uint64_t baseReadOffset,
       uint64_t size,
-      int8_t* deleteBitmap);
+      uint64_t* deleteBitmap);
 
+  /// Returns true if there are no deleted rows after the last batch.
   bool endOfFile();
 
  private:
-  void updateDeleteBitmap(
-      VectorPtr deletePositionsVector,
-      uint64_t baseReadOffset,
-      int64_t rowNumberUpperBound,
-      int8_t* deleteBitmap);
-
-  bool readFinishedForBatch(int64_t rowNumberUpperBound);
+  // Reads the positions deleted from the base file into a bitmap.
+  std::shared_ptr<const RoaringBitmap> readPositions(
+      dwio::common::RuntimeStatistics& runtimeStats);
 
   const IcebergDeleteFile& deleteFile_;
   const std::string& baseFilePath_;
@@ -70,16 +74,16 @@ class PositionalDeleteFileReader {
   const ConnectorQueryCtx* const connectorQueryCtx_;
   const std::shared_ptr<const HiveConfig> hiveConfig_;
   const std::shared_ptr<io::IoStatistics> ioStats_;
+  const std::string connectorId_;
   memory::MemoryPool* const pool_;
 
   std::shared_ptr<IcebergMetadataColumn> filePathColumn_;
   std::shared_ptr<IcebergMetadataColumn> posColumn_;
   uint64_t splitOffset_;
 
-  std::shared_ptr<HiveConnectorSplit> deleteSplit_;
-  std::unique_ptr<dwio::common::RowReader> deleteRowReader_;
-  VectorPtr deletePositionsOutput_;
-  uint64_t deletePositionsOffset_;
+  std::shared_ptr<const RoaringBitmap> positions_;
+  // The largest deleted position. Null if no rows are deleted.
+  std::optional<uint64_t> maxPosition_;
   bool endOfFile_;
 };
 
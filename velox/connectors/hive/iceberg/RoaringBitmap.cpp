@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/connectors/hive/iceberg/RoaringBitmap.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+RoaringBitmap::Chunk* RoaringBitmap::findChunk(uint64_t key, bool create) {
+  // Positions are mostly added in order, so the last chunk is tried first.
+  if (!chunks_.empty() && chunks_.back().key == key) {
+    return &chunks_.back();
+  }
+  auto it = std::lower_bound(
+      chunks_.begin(), chunks_.end(), key, [](const Chunk& chunk, uint64_t k) {
+        return chunk.key < k;
+      });
+  if (it != chunks_.end() && it->key == key) {
+    return &*it;
+  }
+  if (!create) {
+    return nullptr;
+  }
+  it = chunks_.insert(it, Chunk{});
+  it->key = key;
+  return &*it;
+}
+
+// static
+void RoaringBitmap::toBitmap(Chunk& chunk) {
+  chunk.bitmap.resize(bits::nwords(kChunkSize));
+  for (auto value : chunk.values) {
+    bits::setBit(chunk.bitmap.data(), value);
+  }
+  chunk.values.clear();
+  chunk.values.shrink_to_fit();
+}
+
+void RoaringBitmap::add(uint64_t position) {
+  auto* chunk = findChunk(position >> kChunkBits, true);
+  const uint16_t value = position & (kChunkSize - 1);
+  if (chunk->isBitmap()) {
+    if (bits::isBitSet(chunk->bitmap.data(), value)) {
+      return;
+    }
+    bits::setBit(chunk->bitmap.data(), value);
+  } else {
+    auto& values = chunk->values;
+    if (values.empty() || values.back() < value) {
+      values.push_back(value);
+    } else {
+      auto it = std::lower_bound(values.begin(), values.end(), value);
+      if (*it == value) {
+        return;
+      }
+      values.insert(it, value);
+    }
+    if (values.size() > kMaxArraySize) {
+      toBitmap(*chunk);
+    }
+  }
+  ++chunk->cardinality;
+  ++cardinality_;
+}
+
+bool RoaringBitmap::contains(uint64_t position) const {
+  const auto* chunk = findChunk(position >> kChunkBits);
+  if (!chunk) {
+    return false;
+  }
+  const uint16_t value = position & (kChunkSize - 1);
+  if (chunk->isBitmap()) {
+    return bits::isBitSet(chunk->bitmap.data(), value);
+  }
+  return std::binary_search(chunk->values.begin(), chunk->values.end(), value);
+}
+
+void RoaringBitmap::fill(uint64_t begin, uint64_t size, uint64_t* bits)
+    const {
+  if (size == 0 || chunks_.empty()) {
+    return;
+  }
+  const uint64_t end = begin + size;
+  auto it = std::lower_bound(
+      chunks_.begin(),
+      chunks_.end(),
+      begin >> kChunkBits,
+      [](const Chunk& chunk, uint64_t key) { return chunk.key < key; });
+  for (; it != chunks_.end() && (it->key << kChunkBits) < end; ++it) {
+    const uint64_t chunkBegin = it->key << kChunkBits;
+    // The range of the lower 16 bits to fill from this chunk.
+    const uint32_t first = begin > chunkBegin ? begin - chunkBegin : 0;
+    const uint32_t last = std::min(end - chunkBegin, kChunkSize);
+    // The offset of the chunk in 'bits'. Negative if the chunk starts before
+    // 'begin'.
+    const int64_t offset = static_cast<int64_t>(chunkBegin - begin);
+    if (it->isBitmap()) {
+      bits::forEachSetBit(it->bitmap.data(), first, last, [&](auto value) {
+        bits::setBit(bits, offset + value);
+      });
+    } else {
+      const auto& values = it->values;
+      for (auto value = std::lower_bound(values.begin(), values.end(), first);
+           value != values.end() && *value < last;
+           ++value) {
+        bits::setBit(bits, offset + *value);
+      }
+    }
+  }
+}
+
+std::optional<uint64_t> RoaringBitmap::max() const {
+  if (chunks_.empty()) {
+    return std::nullopt;
+  }
+  const auto& chunk = chunks_.back();
+  const uint64_t chunkBegin = chunk.key << kChunkBits;
+  if (!chunk.isBitmap()) {
+    return chunkBegin + chunk.values.back();
+  }
+  for (auto i = chunk.bitmap.size(); i-- > 0;) {
+    if (chunk.bitmap[i]) {
+      return chunkBegin + i * 64 + 63 - __builtin_clzll(chunk.bitmap[i]);
+    }
+  }
+  VELOX_UNREACHABLE();
+}
+
+int64_t RoaringBitmap::memoryUsage() const {
+  int64_t bytes = sizeof(*this) + chunks_.capacity() * sizeof(Chunk);
+  for (const auto& chunk : chunks_) {
+    bytes += chunk.values.capacity() * sizeof(uint16_t) +
+        chunk.bitmap.capacity() * sizeof(uint64_t);
+  }
+  return bytes;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
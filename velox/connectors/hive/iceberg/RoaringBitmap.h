@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// Compressed set of 64-bit positions in the layout of Roaring bitmaps. The
+/// positions are split into chunks of 64K by their upper 48 bits. A chunk
+/// with few positions keeps the sorted lower 16 bits of its positions and a
+/// dense chunk keeps a bitmap of 64K bits. Used for the row positions deleted
+/// from an Iceberg data file, which are mostly clustered. Not thread safe for
+/// writing. Const methods may be called concurrently.
+class RoaringBitmap {
+ public:
+  /// Adds 'position'. Adding the positions in ascending order is fastest.
+  void add(uint64_t position);
+
+  bool contains(uint64_t position) const;
+
+  /// Sets bit 'i' of 'bits' for each position 'begin + i' in the set, for 'i'
+  /// under 'size'. Other bits are left as they are.
+  void fill(uint64_t begin, uint64_t size, uint64_t* bits) const;
+
+  /// Returns the number of positions.
+  uint64_t cardinality() const {
+    return cardinality_;
+  }
+
+  /// Returns the largest position or std::nullopt if the set is empty.
+  std::optional<uint64_t> max() const;
+
+  /// Returns the number of bytes used by the set.
+  int64_t memoryUsage() const;
+
+ private:
+  // Chunks with more positions than this are kept as bitmaps, which then take
+  // less memory than the array of 16-bit positions.
+  static constexpr uint32_t kMaxArraySize = 4096;
+  static constexpr uint64_t kChunkBits = 16;
+  static constexpr uint64_t kChunkSize = 1UL << kChunkBits;
+
+  struct Chunk {
+    // The upper 48 bits of the positions in the chunk.
+    uint64_t key;
+    uint32_t cardinality{0};
+    // The sorted lower 16 bits of the positions if 'bitmap' is empty.
+    std::vector<uint16_t> values;
+    // kChunkSize bits if the chunk is dense.
+    std::vector<uint64_t> bitmap;
+
+    bool isBitmap() const {
+      return !bitmap.empty();
+    }
+  };
+
+  // Returns the chunk for 'key', adding it if 'create' is true. Returns null
+  // if there is no chunk and 'create' is false.
+  Chunk* findChunk(uint64_t key, bool create);
+
+  const Chunk* findChunk(uint64_t key) const {
+    return const_cast<RoaringBitmap*>(this)->findChunk(key, false);
+  }
+
+  // Switches 'chunk' from values to bitmap.
+  static void toBitmap(Chunk& chunk);
+
+  // Chunks sorted by key.
+  std::vector<Chunk> chunks_;
+  uint64_t cardinality_{0};
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
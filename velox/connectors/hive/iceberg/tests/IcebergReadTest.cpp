@@ -15,7 +15,10 @@
  */
 
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteSet.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteCache.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
@@ -23,6 +26,7 @@
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
+#include <folly/ScopeGuard.h>
 #include <folly/Singleton.h>
 
 using namespace facebook::velox::exec::test;
@@ -119,6 +123,34 @@ class HiveIcebergTest : public HiveConnectorTestBase {
     return deleteRows;
   }
 
+  /// Writes an equality delete file for each of 'deleteKeys', scans the data
+  /// file with all of them and compares the result with 'duckdbSql'.
+  std::shared_ptr<exec::Task> assertEqualityDeletes(
+      const std::vector<std::vector<std::optional<int64_t>>>& deleteKeys,
+      const std::string& duckdbSql) {
+    std::shared_ptr<TempFilePath> dataFilePath = writeDataFile(rowCount);
+
+    std::vector<std::shared_ptr<TempFilePath>> deleteFilePaths;
+    std::vector<IcebergDeleteFile> deleteFiles;
+    for (const auto& keys : deleteKeys) {
+      auto deleteFilePath = TempFilePath::create();
+      writeToFile(
+          deleteFilePath->getPath(),
+          makeRowVector({"c0"}, {makeNullableFlatVector<int64_t>(keys)}));
+      const auto path = deleteFilePath->getPath();
+      deleteFiles.emplace_back(
+          FileContent::kEqualityDeletes,
+          path,
+          fileFomat_,
+          keys.size(),
+          testing::internal::GetFileSize(std::fopen(path.c_str(), "r")),
+          std::vector<int32_t>{1});
+      deleteFilePaths.emplace_back(deleteFilePath);
+    }
+
+    return assertQuery(tableScanNode(), dataFilePath, deleteFiles, duckdbSql);
+  }
+
   const static int rowCount = 20000;
 
  private:
@@ -249,7 +281,7 @@ class HiveIcebergTest : public HiveConnectorTestBase {
 
   std::shared_ptr<exec::Task> assertQuery(
       const core::PlanNodePtr& plan,
-      std::shared_ptr<TempFilePath> dataFilePath,
+      const std::shared_ptr<TempFilePath>& dataFilePath,
       const std::vector<IcebergDeleteFile>& deleteFiles,
       const std::string& duckDbSql) {
     auto icebergSplit = makeIcebergSplit(dataFilePath->getPath(), deleteFiles);
@@ -320,4 +352,99 @@ TEST_F(HiveIcebergTest, baseFileMultiplePositionalDeletes) {
   assertPositionalDeletes({{0}, {9999}, {10000}, {19999}});
 }
 
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  assertEqualityDeletes(
+      {{0, 5, 19999, 30000}},
+      "SELECT * FROM tmp WHERE c0 NOT IN (0, 5, 19999)");
+  // Multiple delete files, one of which deletes nothing.
+  assertEqualityDeletes(
+      {{1, 2}, {3}, {-1}}, "SELECT * FROM tmp WHERE c0 NOT IN (1, 2, 3)");
+  // A null key makes the set use the hash table of the rows.
+  assertEqualityDeletes(
+      {{7, std::nullopt, 10000}},
+      "SELECT * FROM tmp WHERE c0 NOT IN (7, 10000)");
+  auto allRows = makeSequenceRows(rowCount);
+  assertEqualityDeletes(
+      {std::vector<std::optional<int64_t>>(allRows.begin(), allRows.end())},
+      "SELECT * FROM tmp WHERE false");
+}
+
+TEST_F(HiveIcebergTest, equalityDeleteSet) {
+  auto probe = [&](const EqualityDeleteSet& deleteSet,
+                   const std::vector<VectorPtr>& keys) {
+    const auto numRows = keys[0]->size();
+    std::vector<uint64_t> deleted(bits::nwords(numRows));
+    deleteSet.markDeleted(keys, numRows, deleted.data());
+    std::vector<bool> result;
+    for (auto i = 0; i < numRows; ++i) {
+      result.push_back(bits::isBitSet(deleted.data(), i));
+    }
+    return result;
+  };
+
+  // Two keys mapped to value ids.
+  EqualityDeleteSet ids(makeRowVector(
+      {makeFlatVector<int64_t>({1, 2, 1'000'000'000'000}),
+       makeFlatVector<StringView>({"a", "b", "c"})}));
+  ASSERT_TRUE(ids.hasValueIds());
+  ASSERT_EQ(3, ids.numKeys());
+  EXPECT_EQ(
+      std::vector<bool>({true, false, true, false, false}),
+      probe(
+          ids,
+          {makeNullableFlatVector<int64_t>(
+               {1, 1, 1'000'000'000'000, std::nullopt, 3}),
+           makeFlatVector<StringView>({"a", "b", "c", "a", "a"})}));
+
+  // Doubles and null keys use the hash table of the rows. Nulls match nulls.
+  EqualityDeleteSet rows(makeRowVector(
+      {makeNullableFlatVector<double>({1.5, std::nullopt}),
+       makeFlatVector<int32_t>({1, 2})}));
+  ASSERT_FALSE(rows.hasValueIds());
+  EXPECT_EQ(
+      std::vector<bool>({true, true, false, false}),
+      probe(
+          rows,
+          {makeNullableFlatVector<double>({1.5, std::nullopt, std::nullopt, 2}),
+           makeFlatVector<int32_t>({1, 2, 1, 2})}));
+}
+
+TEST_F(HiveIcebergTest, deleteCache) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  IcebergDeleteCache cache(1 << 20);
+  IcebergDeleteCache::setInstance(&cache);
+  SCOPE_EXIT {
+    IcebergDeleteCache::setInstance(nullptr);
+  };
+  assertEqualityDeletes({{4, 8}}, "SELECT * FROM tmp WHERE c0 NOT IN (4, 8)");
+  ASSERT_EQ(1, cache.numEntries());
+  // The positions deleted from the data file are cached apart from the
+  // positions deleted from other data files in the same delete file.
+  assertPositionalDeletes({{0, 1, 2, 3}}, true);
+  ASSERT_EQ(2, cache.numEntries());
+  ASSERT_GT(cache.bytes(), 0);
+  cache.clear();
+  ASSERT_EQ(0, cache.numEntries());
+  ASSERT_EQ(0, cache.bytes());
+
+  // Entries larger than the capacity are not cached and the least recently
+  // used ones are evicted to make space.
+  auto deleteSet = std::make_shared<const EqualityDeleteSet>(
+      makeRowVector({makeFlatVector<int64_t>({1, 2, 3})}));
+  IcebergDeleteCache smallCache(1);
+  smallCache.put("a", deleteSet, 2);
+  ASSERT_EQ(0, smallCache.numEntries());
+  IcebergDeleteCache twoEntries(2);
+  twoEntries.put("a", deleteSet, 1);
+  twoEntries.put("b", deleteSet, 1);
+  ASSERT_EQ(deleteSet, twoEntries.get<EqualityDeleteSet>("a"));
+  twoEntries.put("c", deleteSet, 1);
+  ASSERT_EQ(2, twoEntries.numEntries());
+  ASSERT_EQ(nullptr, twoEntries.get<EqualityDeleteSet>("b"));
+  ASSERT_EQ(deleteSet, twoEntries.get<EqualityDeleteSet>("a"));
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
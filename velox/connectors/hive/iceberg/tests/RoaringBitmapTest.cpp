@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/connectors/hive/iceberg/RoaringBitmap.h"
+
+#include <gtest/gtest.h>
+#include <set>
+
+#include <folly/Random.h>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+namespace {
+
+// Checks 'bitmap' against 'expected' for all positions under 'limit'.
+void checkBitmap(
+    const RoaringBitmap& bitmap,
+    const std::set<uint64_t>& expected,
+    uint64_t limit) {
+  ASSERT_EQ(expected.size(), bitmap.cardinality());
+  if (expected.empty()) {
+    ASSERT_FALSE(bitmap.max().has_value());
+  } else {
+    ASSERT_EQ(*expected.rbegin(), bitmap.max().value());
+  }
+  for (auto position : expected) {
+    ASSERT_TRUE(bitmap.contains(position)) << position;
+  }
+
+  // Fill unaligned ranges of different sizes.
+  for (uint64_t size : {1, 63, 1'000, 70'000}) {
+    std::vector<uint64_t> bits(bits::nwords(size));
+    for (uint64_t begin = 0; begin < limit; begin += size + 17) {
+      std::fill(bits.begin(), bits.end(), 0);
+      bitmap.fill(begin, size, bits.data());
+      for (uint64_t i = 0; i < size; ++i) {
+        ASSERT_EQ(expected.count(begin + i) > 0, bits::isBitSet(bits.data(), i))
+            << begin + i;
+      }
+    }
+  }
+}
+
+TEST(RoaringBitmapTest, empty) {
+  RoaringBitmap bitmap;
+  checkBitmap(bitmap, {}, 1'000);
+  ASSERT_FALSE(bitmap.contains(0));
+}
+
+TEST(RoaringBitmapTest, sparseAndDense) {
+  RoaringBitmap bitmap;
+  std::set<uint64_t> expected;
+  // A dense chunk, a sparse chunk and a chunk far away.
+  for (uint64_t i = 0; i < 65'536; i += 3) {
+    bitmap.add(i);
+    expected.insert(i);
+  }
+  for (uint64_t i = 65'536; i < 2 * 65'536; i += 1'000) {
+    bitmap.add(i);
+    expected.insert(i);
+  }
+  bitmap.add(10 * 65'536 + 5);
+  expected.insert(10 * 65'536 + 5);
+  checkBitmap(bitmap, expected, 11 * 65'536);
+
+  // A dense chunk takes 8KB and a sparse chunk 2 bytes per position.
+  ASSERT_LT(bitmap.memoryUsage(), 10'000);
+
+  // Duplicates are ignored.
+  bitmap.add(3);
+  bitmap.add(65'536);
+  ASSERT_EQ(expected.size(), bitmap.cardinality());
+}
+
+TEST(RoaringBitmapTest, unordered) {
+  folly::Random::DefaultGenerator rng(1);
+  RoaringBitmap bitmap;
+  std::set<uint64_t> expected;
+  for (auto i = 0; i < 20'000; ++i) {
+    const uint64_t position = folly::Random::rand32(200'000, rng);
+    bitmap.add(position);
+    expected.insert(position);
+  }
+  checkBitmap(bitmap, expected, 200'000);
+}
+
+} // namespace
+} // namespace facebook::velox::connector::hive::iceberg
@@ -25,11 +25,21 @@ std::string_view HdfsFileSystem::kScheme("hdfs://");
 
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(const Config* config, const HdfsServiceEndpoint& endpoint) {
     auto builder = hdfsNewBuilder();
     hdfsBuilderSetNameNode(builder, endpoint.host.c_str());
     hdfsBuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
+    if (config != nullptr &&
+        config->get<bool>(kShortCircuitReadEnabled, false)) {
+      // The client falls back to reading through the data node if the block
+      // is not local or the domain socket is not usable.
+      hdfsBuilderConfSetStr(builder, "dfs.client.read.shortcircuit", "true");
+      const auto socketPath = config->get<std::string>(kDomainSocketPath, "");
+      if (!socketPath.empty()) {
+        hdfsBuilderConfSetStr(
+            builder, "dfs.domain.socket.path", socketPath.c_str());
+      }
+    }
     hdfsClient_ = hdfsBuilderConnect(builder);
     hdfsFreeBuilder(builder);
     VELOX_CHECK_NOT_NULL(
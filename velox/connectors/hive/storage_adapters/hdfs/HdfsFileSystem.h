@@ -42,6 +42,16 @@ struct HdfsServiceEndpoint {
  */
 class HdfsFileSystem : public FileSystem {
  public:
+  /// Whether the HDFS client reads the blocks on the local data node directly
+  /// from the block files instead of through the data node.
+  static constexpr const char* kShortCircuitReadEnabled =
+      "hive.hdfs.short-circuit-read-enabled";
+
+  /// The UNIX domain socket shared with the local data node, through which
+  /// the descriptors of the block files are passed for short-circuit reads.
+  static constexpr const char* kDomainSocketPath =
+      "hive.hdfs.domain-socket-path";
+
   explicit HdfsFileSystem(
       const std::shared_ptr<const Config>& config,
       const HdfsServiceEndpoint& endpoint);
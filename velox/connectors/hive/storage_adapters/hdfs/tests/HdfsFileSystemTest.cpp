@@ -209,6 +209,20 @@ TEST_F(HdfsFileSystemTest, fallbackToUseConfig) {
   readData(readFile.get());
 }
 
+TEST_F(HdfsFileSystemTest, shortCircuitRead) {
+  // The mini cluster has no domain socket, so the reads fall back to the data
+  // node.
+  auto memConfig = std::make_shared<const core::MemConfig>(
+      std::unordered_map<std::string, std::string>{
+          {filesystems::HdfsFileSystem::kShortCircuitReadEnabled, "true"},
+          {filesystems::HdfsFileSystem::kDomainSocketPath,
+           "/tmp/velox-hdfs-dn-socket"}});
+  filesystems::HdfsFileSystem hdfsFileSystem(
+      memConfig, filesystems::HdfsServiceEndpoint(localhost, hdfsPort));
+  auto readFile = hdfsFileSystem.openFileForRead(fullDestinationPath);
+  readData(readFile.get());
+}
+
 TEST_F(HdfsFileSystemTest, oneFsInstanceForOneEndpoint) {
   auto hdfsFileSystem1 =
       filesystems::getFileSystem(fullDestinationPath, nullptr);
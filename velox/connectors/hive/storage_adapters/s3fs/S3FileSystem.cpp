@@ -15,7 +15,10 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
+#include "velox/common/base/BitUtil.h"
 #include "velox/common/file/File.h"
+#include "velox/common/io/IoStatistics.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3WriteFile.h"
@@ -24,8 +27,14 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/container/F14Map.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/InlineExecutor.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 
 #include <aws/core/Aws.h>
@@ -40,9 +49,13 @@
 #include <aws/s3/model/CompletedPart.h>
 #include <aws/s3/model/CreateBucketRequest.h>
 #include <aws/s3/model/CreateMultipartUploadRequest.h>
+#include <aws/s3/model/Delete.h>
+#include <aws/s3/model/DeleteObjectsRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/HeadBucketRequest.h>
 #include <aws/s3/model/HeadObjectRequest.h>
+#include <aws/s3/model/ListObjectsV2Request.h>
+#include <aws/s3/model/ObjectIdentifier.h>
 #include <aws/s3/model/UploadPartRequest.h>
 
 namespace facebook::velox {
@@ -73,9 +86,24 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
 // TODO: Implement retry on failure.
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
-    getBucketAndKeyFromS3Path(path, bucket_, key_);
+  /// Reads larger than 'partSize' bytes are split into parallel GET requests
+  /// of at most 'partSize' bytes. 0 reads each range with one request. GET
+  /// requests slower than the threshold of 'latencyTracker' are hedged. No
+  /// requests are hedged if 'latencyTracker' is nullptr. The latency and the
+  /// number of hedged requests of each GET are added to 'ioStats'.
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      uint64_t partSize,
+      std::shared_ptr<S3LatencyTracker> latencyTracker,
+      std::shared_ptr<io::IoStatistics> ioStats)
+      : client_(client),
+        partSize_(partSize),
+        context_(std::make_shared<ReadContext>()) {
+    getBucketAndKeyFromS3Path(path, context_->bucket, context_->key);
+    context_->client = client;
+    context_->latencyTracker = std::move(latencyTracker);
+    context_->ioStats = std::move(ioStats);
   }
 
   // Gets the length of the file.
@@ -93,12 +121,12 @@ class S3ReadFile final : public ReadFile {
     }
 
     Aws::S3::Model::HeadObjectRequest request;
-    request.SetBucket(awsString(bucket_));
-    request.SetKey(awsString(key_));
+    request.SetBucket(awsString(bucket()));
+    request.SetKey(awsString(key()));
 
     auto outcome = client_->HeadObject(request);
     VELOX_CHECK_AWS_OUTCOME(
-        outcome, "Failed to get metadata for S3 object", bucket_, key_);
+        outcome, "Failed to get metadata for S3 object", bucket(), key());
     length_ = outcome.GetResult().GetContentLength();
     VELOX_CHECK_GE(length_, 0);
   }
@@ -119,27 +147,48 @@ class S3ReadFile final : public ReadFile {
   uint64_t preadv(
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const override {
+    return preadvAsync(offset, buffers).get();
+  }
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
     // 'buffers' contains Ranges(data, size)  with some gaps (data = nullptr) in
     // between. This call must populate the ranges (except gap ranges)
     // sequentially starting from 'offset'. AWS S3 GetObject does not support
     // multi-range. AWS S3 also charges by number of read requests and not size.
     // The idea here is to use a single read spanning all the ranges and then
     // populate individual ranges. We pre-allocate a buffer to support this.
-    size_t length = 0;
+    // The GET requests complete on the executor of the AWS client, so the
+    // caller does not hold a thread while the object is being read.
+    auto state = std::make_shared<AsyncReadState>();
+    state->buffers = buffers;
     for (const auto range : buffers) {
-      length += range.size();
+      state->length += range.size();
     }
-    // TODO: allocate from a memory pool
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
+    if (state->length == 0) {
+      return folly::makeSemiFuture<uint64_t>(0);
     }
-    return length;
+    // TODO: allocate from a memory pool
+    state->result.resize(state->length);
+    return readAsync(offset, state->length, state->result.data())
+        .deferValue([state](auto&& /*unused*/) {
+          size_t resultOffset = 0;
+          for (auto range : state->buffers) {
+            if (range.data()) {
+              memcpy(
+                  range.data(),
+                  state->result.data() + resultOffset,
+                  range.size());
+            }
+            resultOffset += range.size();
+          }
+          return state->length;
+        });
+  }
+
+  bool hasPreadvAsync() const override {
+    return true;
   }
 
   uint64_t size() const override {
@@ -157,7 +206,7 @@ class S3ReadFile final : public ReadFile {
   }
 
   std::string getName() const final {
-    return fmt::format("s3://{}/{}", bucket_, key_);
+    return fmt::format("s3://{}/{}", bucket(), key());
   }
 
   uint64_t getNaturalReadSize() const final {
@@ -165,27 +214,215 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
+  // State shared by the GET requests of a file. A hedged request may complete
+  // after the file is destroyed.
+  struct ReadContext {
+    Aws::S3::S3Client* client;
+    std::string bucket;
+    std::string key;
+    std::shared_ptr<S3LatencyTracker> latencyTracker;
+    std::shared_ptr<io::IoStatistics> ioStats;
+  };
+
+  // State of reading one part. When the part is hedged, each GET reads into
+  // its own buffer and the first successful one copies its data to
+  // 'position'. The part fails only if all its GET requests fail.
+  struct PartRead {
+    PartRead(char* _position, uint64_t _length)
+        : position(_position),
+          length(_length),
+          startMicros(getCurrentTimeMicro()) {}
+
+    char* const position;
+    const uint64_t length;
+    const uint64_t startMicros;
+
+    std::mutex mutex;
+    bool done{false};
+    int32_t numPending{0};
+    int32_t numHedged{0};
+    folly::Promise<folly::Unit> promise;
+  };
+
+  // State of a preadvAsync() kept alive until the response arrives.
+  struct AsyncReadState {
+    std::vector<folly::Range<char*>> buffers;
+    uint64_t length{0};
+    // The bytes of all the ranges, including the gaps.
+    std::string result;
+  };
+
+  const std::string& bucket() const {
+    return context_->bucket;
+  }
+
+  const std::string& key() const {
+    return context_->key;
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
-    // Read the desired range of bytes.
-    Aws::S3::Model::GetObjectRequest request;
-    Aws::S3::Model::GetObjectResult result;
+    readAsync(offset, length, position).get();
+  }
+
+  // Reads 'length' bytes at 'offset' into 'position' with one GET request per
+  // part of at most 'partSize_' bytes. 'position' must stay valid until the
+  // returned future is realized, which happens after all the parts are done.
+  folly::SemiFuture<folly::Unit>
+  readAsync(uint64_t offset, uint64_t length, char* position) const {
+    if (partSize_ == 0 || length <= partSize_) {
+      return readPartAsync(offset, length, position);
+    }
+    std::vector<folly::SemiFuture<folly::Unit>> parts;
+    parts.reserve(bits::roundUp(length, partSize_) / partSize_);
+    for (uint64_t partOffset = 0; partOffset < length;
+         partOffset += partSize_) {
+      parts.push_back(readPartAsync(
+          offset + partOffset,
+          std::min(partSize_, length - partOffset),
+          position + partOffset));
+    }
+    // Waits for all the parts even if one fails so that no part writes to
+    // 'position' after the future is realized.
+    return folly::collectAll(std::move(parts))
+        .deferValue([](std::vector<folly::Try<folly::Unit>>&& results) {
+          for (auto& result : results) {
+            result.value();
+          }
+        });
+  }
+
+  folly::SemiFuture<folly::Unit>
+  readPartAsync(uint64_t offset, uint64_t length, char* position) const {
+    auto part = std::make_shared<PartRead>(position, length);
+    auto future = part->promise.getSemiFuture();
+    const auto hedgeMicros = context_->latencyTracker
+        ? context_->latencyTracker->threshold()
+        : 0;
+    if (hedgeMicros == 0) {
+      // An unhedged GET reads straight into 'position'.
+      startGet(context_, part, offset, false);
+      return future;
+    }
+    startGet(context_, part, offset, true);
+    folly::futures::sleep(std::chrono::microseconds(hedgeMicros))
+        .via(&folly::InlineExecutor::instance())
+        .thenValue([context = context_, part, offset](auto&& /*unused*/) {
+          {
+            std::lock_guard<std::mutex> l(part->mutex);
+            if (part->done) {
+              return;
+            }
+            ++part->numHedged;
+          }
+          startGet(context, part, offset, true);
+        });
+    return future;
+  }
+
+  // Issues a GET request for 'part'. If 'ownBuffer' is true, the response is
+  // read into a buffer owned by the request and copied to the part when the
+  // request is the first to succeed.
+  static void startGet(
+      const std::shared_ptr<ReadContext>& context,
+      const std::shared_ptr<PartRead>& part,
+      uint64_t offset,
+      bool ownBuffer) {
+    {
+      std::lock_guard<std::mutex> l(part->mutex);
+      if (part->done) {
+        return;
+      }
+      ++part->numPending;
+    }
+    std::shared_ptr<std::string> buffer;
+    if (ownBuffer) {
+      buffer = std::make_shared<std::string>(part->length, 0);
+    }
+    auto request = makeGetObjectRequest(
+        *context,
+        offset,
+        part->length,
+        buffer ? buffer->data() : part->position);
+    context->client->GetObjectAsync(
+        request,
+        [context, part, buffer, startMicros = getCurrentTimeMicro()](
+            const Aws::S3::S3Client* /*client*/,
+            const Aws::S3::Model::GetObjectRequest& /*request*/,
+            Aws::S3::Model::GetObjectOutcome outcome,
+            const std::shared_ptr<const Aws::Client::AsyncCallerContext>&
+            /*context*/) {
+          finishGet(*context, *part, buffer.get(), startMicros, outcome);
+        });
+  }
+
+  // Completes 'part' with the result of one of its GET requests unless
+  // another request has already completed it.
+  static void finishGet(
+      const ReadContext& context,
+      PartRead& part,
+      const std::string* buffer,
+      uint64_t startMicros,
+      const Aws::S3::Model::GetObjectOutcome& outcome) {
+    int32_t numHedged;
+    {
+      std::lock_guard<std::mutex> l(part.mutex);
+      --part.numPending;
+      if (part.done || (!outcome.IsSuccess() && part.numPending > 0)) {
+        return;
+      }
+      part.done = true;
+      numHedged = part.numHedged;
+      if (outcome.IsSuccess() && buffer != nullptr) {
+        memcpy(part.position, buffer->data(), part.length);
+      }
+    }
+    const auto endMicros = getCurrentTimeMicro();
+    if (context.ioStats != nullptr) {
+      context.ioStats->incOperationCounters(
+          "GetObject",
+          0,
+          0,
+          0,
+          numHedged,
+          (endMicros - part.startMicros) / 1'000,
+          0);
+    }
+    try {
+      VELOX_CHECK_AWS_OUTCOME(
+          outcome, "Failed to get S3 object", context.bucket, context.key);
+    } catch (const std::exception&) {
+      part.promise.setException(
+          folly::exception_wrapper(std::current_exception()));
+      return;
+    }
+    if (context.latencyTracker != nullptr) {
+      context.latencyTracker->record(endMicros - startMicros);
+    }
+    part.promise.setValue();
+  }
 
-    request.SetBucket(awsString(bucket_));
-    request.SetKey(awsString(key_));
+  // Returns a request for reading 'length' bytes at 'offset' into 'position'.
+  static Aws::S3::Model::GetObjectRequest makeGetObjectRequest(
+      const ReadContext& context,
+      uint64_t offset,
+      uint64_t length,
+      char* position) {
+    Aws::S3::Model::GetObjectRequest request;
+    request.SetBucket(awsString(context.bucket));
+    request.SetKey(awsString(context.key));
     std::stringstream ss;
     ss << "bytes=" << offset << "-" << offset + length - 1;
     request.SetRange(awsString(ss.str()));
     request.SetResponseStreamFactory(
         AwsWriteableStreamFactory(position, length));
-    auto outcome = client_->GetObject(request);
-    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
+    return request;
   }
 
   Aws::S3::S3Client* client_;
-  std::string bucket_;
-  std::string key_;
+  const uint64_t partSize_;
+  const std::shared_ptr<ReadContext> context_;
   int64_t length_ = -1;
 };
 
@@ -221,8 +458,13 @@ class S3WriteFile::Impl {
   explicit Impl(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool)
-      : client_(client), pool_(pool) {
+      memory::MemoryPool* pool,
+      folly::Executor* uploadExecutor,
+      int32_t maxInflightParts)
+      : client_(client),
+        pool_(pool),
+        uploadExecutor_(uploadExecutor),
+        maxInflightParts_(std::max<int32_t>(1, maxInflightParts)) {
     VELOX_CHECK_NOT_NULL(client);
     VELOX_CHECK_NOT_NULL(pool);
     getBucketAndKeyFromS3Path(path, bucket_, key_);
@@ -272,6 +514,14 @@ class S3WriteFile::Impl {
     fileSize_ = 0;
   }
 
+  ~Impl() {
+    // Wait for the parts in flight if the file is destroyed without close(),
+    // e.g. on error, since they reference 'this'.
+    for (auto& inflight : inflightParts_) {
+      inflight.wait();
+    }
+  }
+
   // Appends data to the end of the file.
   void append(std::string_view data) {
     VELOX_CHECK(!closed(), "File is closed");
@@ -297,6 +547,9 @@ class S3WriteFile::Impl {
     if (closed()) {
       return;
     }
+    while (!inflightParts_.empty()) {
+      waitForOldestPart();
+    }
     uploadPart({currentPart_->data(), currentPart_->size()}, true);
     VELOX_CHECK_EQ(uploadState_.partNumber, uploadState_.completedParts.size());
     // Complete the multipart upload.
@@ -366,31 +619,62 @@ class S3WriteFile::Impl {
   void uploadPart(const std::string_view part, bool isLast = false) {
     // Only the last part can be less than kPartUploadSize.
     VELOX_CHECK(isLast || (!isLast && (part.size() == kPartUploadSize)));
-    // Upload the part.
-    {
-      Aws::S3::Model::UploadPartRequest request;
-      request.SetBucket(bucket_);
-      request.SetKey(key_);
-      request.SetUploadId(uploadState_.id);
-      request.SetPartNumber(++uploadState_.partNumber);
-      request.SetContentLength(part.size());
-      request.SetBody(
-          std::make_shared<StringViewStream>(part.data(), part.size()));
-      auto outcome = client_->UploadPart(request);
-      VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
-      // Append ETag and part number for this uploaded part.
-      // This will be needed for upload completion in Close().
-      auto result = outcome.GetResult();
-      Aws::S3::Model::CompletedPart part;
-
-      part.SetPartNumber(uploadState_.partNumber);
-      part.SetETag(result.GetETag());
-      uploadState_.completedParts.push_back(std::move(part));
+    const auto partNumber = ++uploadState_.partNumber;
+    if (uploadExecutor_ == nullptr || isLast) {
+      uploadState_.completedParts.push_back(
+          uploadPartData(part.data(), part.size(), partNumber));
+      return;
     }
+    if (inflightParts_.size() >= maxInflightParts_) {
+      waitForOldestPart();
+    }
+    // 'part' may point into 'currentPart_' which is reused for the next part.
+    // Keep a copy for the duration of the upload. The copies in flight are at
+    // most 'maxInflightParts_' * kPartUploadSize bytes.
+    auto data = std::make_shared<std::string>(part);
+    inflightParts_.push_back(folly::via(
+        uploadExecutor_, [this, data = std::move(data), partNumber]() {
+          return uploadPartData(data->data(), data->size(), partNumber);
+        }));
+  }
+
+  // Waits for the earliest started part upload and records its completion.
+  // The parts complete in part number order as required by
+  // CompleteMultipartUpload.
+  void waitForOldestPart() {
+    VELOX_CHECK(!inflightParts_.empty());
+    auto inflight = std::move(inflightParts_.front());
+    inflightParts_.pop_front();
+    uploadState_.completedParts.push_back(std::move(inflight).get());
+  }
+
+  Aws::S3::Model::CompletedPart
+  uploadPartData(const char* data, size_t size, int64_t partNumber) const {
+    Aws::S3::Model::UploadPartRequest request;
+    request.SetBucket(bucket_);
+    request.SetKey(key_);
+    request.SetUploadId(uploadState_.id);
+    request.SetPartNumber(partNumber);
+    request.SetContentLength(size);
+    request.SetBody(std::make_shared<StringViewStream>(data, size));
+    auto outcome = client_->UploadPart(request);
+    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
+    // Return ETag and part number for this uploaded part.
+    // This will be needed for upload completion in Close().
+    auto result = outcome.GetResult();
+    Aws::S3::Model::CompletedPart part;
+    part.SetPartNumber(partNumber);
+    part.SetETag(result.GetETag());
+    return part;
   }
 
   Aws::S3::S3Client* client_;
   memory::MemoryPool* pool_;
+  // Runs the part uploads if set. Otherwise parts are uploaded synchronously.
+  folly::Executor* const uploadExecutor_;
+  const size_t maxInflightParts_;
+  // Uploads of the parts in part number order.
+  std::deque<folly::Future<Aws::S3::Model::CompletedPart>> inflightParts_;
   std::unique_ptr<dwio::common::DataBuffer<char>> currentPart_;
   std::string bucket_;
   std::string key_;
@@ -400,14 +684,24 @@ class S3WriteFile::Impl {
 S3WriteFile::S3WriteFile(
     const std::string& path,
     Aws::S3::S3Client* client,
-    memory::MemoryPool* pool) {
-  impl_ = std::make_shared<Impl>(path, client, pool);
+    memory::MemoryPool* pool,
+    folly::Executor* uploadExecutor,
+    int32_t maxInflightParts) {
+  impl_ = std::make_shared<Impl>(
+      path, client, pool, uploadExecutor, maxInflightParts);
 }
 
 void S3WriteFile::append(std::string_view data) {
   return impl_->append(data);
 }
 
+void S3WriteFile::append(std::unique_ptr<folly::IOBuf> data) {
+  for (auto& range : *data) {
+    impl_->append(
+        {reinterpret_cast<const char*>(range.data()), range.size()});
+  }
+}
+
 void S3WriteFile::flush() {
   impl_->flush();
 }
@@ -569,10 +863,15 @@ class S3FileSystem::Impl {
         clientConfig,
         Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
         hiveConfig_->s3UseVirtualAddressing());
+    if (hiveConfig_->s3UploadPartThreads() > 0) {
+      uploadExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(
+          hiveConfig_->s3UploadPartThreads());
+    }
     ++fileSystemCount;
   }
 
   ~Impl() {
+    uploadExecutor_.reset();
     client_.reset();
     --fileSystemCount;
   }
@@ -651,9 +950,82 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  // Returns the executor for asynchronous part uploads or nullptr if parts
+  // are uploaded synchronously.
+  folly::Executor* uploadExecutor() const {
+    return uploadExecutor_.get();
+  }
+
+  uint32_t maxInflightUploadParts() const {
+    return hiveConfig_->s3MaxInflightUploadParts();
+  }
+
+  uint64_t readPartSize() const {
+    return hiveConfig_->s3ReadPartSize();
+  }
+
+  // Returns the tracker of the GET latencies to 'bucket' or nullptr if GET
+  // requests are not hedged.
+  std::shared_ptr<S3LatencyTracker> latencyTracker(const std::string& bucket) {
+    const auto percentile = hiveConfig_->s3ReadHedgePercentile();
+    if (percentile == 0) {
+      return nullptr;
+    }
+    std::lock_guard<std::mutex> l(latencyTrackersMutex_);
+    auto& tracker = latencyTrackers_[bucket];
+    if (tracker == nullptr) {
+      tracker = std::make_shared<S3LatencyTracker>(percentile);
+    }
+    return tracker;
+  }
+
+  const std::shared_ptr<io::IoStatistics>& ioStats() const {
+    return ioStats_;
+  }
+
+  // Deletes all the objects with keys starting with 'prefix' in 'bucket'.
+  void deleteObjects(const std::string& bucket, const std::string& prefix) {
+    Aws::S3::Model::ListObjectsV2Request listRequest;
+    listRequest.SetBucket(awsString(bucket));
+    listRequest.SetPrefix(awsString(prefix));
+    for (;;) {
+      auto listOutcome = client_->ListObjectsV2(listRequest);
+      VELOX_CHECK_AWS_OUTCOME(
+          listOutcome, "Failed to list S3 objects", bucket, prefix);
+      const auto& listResult = listOutcome.GetResult();
+      // A listing returns at most 1000 keys which is also the limit of a
+      // single DeleteObjects request.
+      if (!listResult.GetContents().empty()) {
+        Aws::S3::Model::Delete toDelete;
+        for (const auto& object : listResult.GetContents()) {
+          toDelete.AddObjects(
+              Aws::S3::Model::ObjectIdentifier().WithKey(object.GetKey()));
+        }
+        toDelete.SetQuiet(true);
+        Aws::S3::Model::DeleteObjectsRequest deleteRequest;
+        deleteRequest.SetBucket(awsString(bucket));
+        deleteRequest.SetDelete(std::move(toDelete));
+        auto deleteOutcome = client_->DeleteObjects(deleteRequest);
+        VELOX_CHECK_AWS_OUTCOME(
+            deleteOutcome, "Failed to delete S3 objects", bucket, prefix);
+      }
+      if (!listResult.GetIsTruncated()) {
+        break;
+      }
+      listRequest.SetContinuationToken(listResult.GetNextContinuationToken());
+    }
+  }
+
  private:
   std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> uploadExecutor_;
+  const std::shared_ptr<io::IoStatistics> ioStats_{
+      std::make_shared<io::IoStatistics>()};
+
+  std::mutex latencyTrackersMutex_;
+  folly::F14FastMap<std::string, std::shared_ptr<S3LatencyTracker>>
+      latencyTrackers_;
 };
 
 S3FileSystem::S3FileSystem(std::shared_ptr<const Config> config)
@@ -665,11 +1037,23 @@ std::string S3FileSystem::getLogLevelName() const {
   return impl_->getLogLevelName();
 }
 
+const io::IoStatistics& S3FileSystem::ioStats() const {
+  return *impl_->ioStats();
+}
+
 std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  std::string bucket;
+  std::string key;
+  getBucketAndKeyFromS3Path(file, bucket, key);
+  auto s3file = std::make_unique<S3ReadFile>(
+      file,
+      impl_->s3Client(),
+      impl_->readPartSize(),
+      impl_->latencyTracker(bucket),
+      impl_->ioStats());
   s3file->initialize(options);
   return s3file;
 }
@@ -678,11 +1062,30 @@ std::unique_ptr<WriteFile> S3FileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file =
-      std::make_unique<S3WriteFile>(file, impl_->s3Client(), options.pool);
+  auto s3file = std::make_unique<S3WriteFile>(
+      file,
+      impl_->s3Client(),
+      options.pool,
+      impl_->uploadExecutor(),
+      impl_->maxInflightUploadParts());
   return s3file;
 }
 
+void S3FileSystem::mkdir(std::string_view /*path*/) {
+  // Object stores have no directories. Objects are created with their full
+  // key on write.
+}
+
+void S3FileSystem::rmdir(std::string_view path) {
+  std::string bucket;
+  std::string key;
+  getBucketAndKeyFromS3Path(s3Path(path), bucket, key);
+  if (!key.empty() && key.back() != '/') {
+    key.push_back('/');
+  }
+  impl_->deleteObjects(bucket, key);
+}
+
 std::string S3FileSystem::name() const {
   return "S3";
 }
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/io/IoStatistics.h"
 #include "velox/connectors/hive/HiveConfig.h"
 
 namespace facebook::velox::filesystems {
@@ -62,16 +63,19 @@ class S3FileSystem : public FileSystem {
     VELOX_UNSUPPORTED("list for S3 not implemented");
   }
 
-  void mkdir(std::string_view path) override {
-    VELOX_UNSUPPORTED("mkdir for S3 not implemented");
-  }
+  /// No-op since S3 has no directories.
+  void mkdir(std::string_view path) override;
 
-  void rmdir(std::string_view path) override {
-    VELOX_UNSUPPORTED("rmdir for S3 not implemented");
-  }
+  /// Deletes all the objects under 'path'.
+  void rmdir(std::string_view path) override;
 
   std::string getLogLevelName() const;
 
+  /// Returns the statistics of the requests to S3. The wall time and the
+  /// number of hedged requests of GET requests are under the "GetObject"
+  /// operation.
+  const io::IoStatistics& ioStats() const;
+
  protected:
   class Impl;
   std::shared_ptr<Impl> impl_;
@@ -21,6 +21,8 @@
 
 #include "folly/IPAddress.h"
 
+#include <algorithm>
+
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 
 namespace facebook::velox {
@@ -148,4 +150,27 @@ std::optional<folly::Uri> S3ProxyConfigurationBuilder::build() {
   return proxyUri;
 }
 
+void S3LatencyTracker::record(uint64_t micros) {
+  std::vector<uint64_t> samples;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (samples_.size() < kMaxSamples) {
+      samples_.push_back(micros);
+    } else {
+      samples_[nextSample_] = micros;
+      nextSample_ = (nextSample_ + 1) % kMaxSamples;
+    }
+    ++numRecorded_;
+    if (samples_.size() < kMinSamples ||
+        numRecorded_ % kRecomputeInterval != 0) {
+      return;
+    }
+    samples = samples_;
+  }
+  const auto index = std::min<size_t>(
+      samples.size() - 1, samples.size() * percentile_ / 100);
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+  threshold_ = samples[index];
+}
+
 } // namespace facebook::velox
@@ -28,6 +28,9 @@
 #include "velox/common/base/Exceptions.h"
 
 #include <fmt/format.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 namespace facebook::velox {
 
@@ -203,6 +206,42 @@ class S3ProxyConfigurationBuilder {
   bool useSsl_;
 };
 
+/// Keeps the latencies of the recent GET requests to a bucket for deciding
+/// when a request is slow enough to be hedged. Thread safe.
+class S3LatencyTracker {
+ public:
+  /// The number of most recent latencies the percentile is computed from.
+  static constexpr int32_t kMaxSamples = 1024;
+  /// The number of latencies needed before threshold() returns a value.
+  static constexpr int32_t kMinSamples = 32;
+
+  explicit S3LatencyTracker(double percentile) : percentile_(percentile) {
+    VELOX_CHECK(percentile > 0 && percentile < 100);
+  }
+
+  /// Records the latency of a successful GET request.
+  void record(uint64_t micros);
+
+  /// Returns the configured percentile of the recorded latencies in
+  /// microseconds or 0 if fewer than kMinSamples latencies are recorded.
+  uint64_t threshold() const {
+    return threshold_;
+  }
+
+ private:
+  // The number of recorded latencies between recomputing 'threshold_'.
+  static constexpr int32_t kRecomputeInterval = 16;
+
+  const double percentile_;
+
+  std::mutex mutex_;
+  // Ring buffer of the last kMaxSamples latencies.
+  std::vector<uint64_t> samples_;
+  int32_t nextSample_{0};
+  uint64_t numRecorded_{0};
+  std::atomic<uint64_t> threshold_{0};
+};
+
 } // namespace facebook::velox
 
 template <>
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/common/file/File.h"
 #include "velox/common/memory/MemoryPool.h"
 
@@ -42,20 +44,26 @@ namespace facebook::velox::filesystems {
 /// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
 /// https://github.com/apache/arrow/blob/main/cpp/src/arrow/filesystem/s3fs.cc
 /// S3WriteFile is not thread-safe.
-/// UploadPart is currently synchronous during append and flush.
-/// TODO: Evaluate and add option for asynchronous part uploads.
+/// UploadPart is synchronous during append unless 'uploadExecutor' is set. In
+/// that case up to 'maxInflightParts' parts are uploaded in parallel on
+/// 'uploadExecutor' and append only blocks when that many are in flight. The
+/// last part is uploaded synchronously on close.
 /// TODO: Implement retry on failure.
 class S3WriteFile : public WriteFile {
  public:
   S3WriteFile(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* uploadExecutor = nullptr,
+      int32_t maxInflightParts = 0);
 
   /// Appends data to the end of the file.
   /// Uploads a part on reaching part size limit.
   void append(std::string_view data) override;
 
+  void append(std::unique_ptr<folly::IOBuf> data) override;
+
   /// No-op. Append handles the flush.
   void flush() override;
 
@@ -60,6 +60,29 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, readParts) {
+  const char* bucketName = "data-parts";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // Splits the 1MB reads into 5 parallel GET requests and hedges the slowest
+  // tenth of them.
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-part-size", "200000"},
+       {"hive.s3.read-hedge-percentile", "90"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  readData(readFile.get());
+  const auto stats = s3fs.ioStats().operationStats();
+  ASSERT_EQ(1, stats.count("GetObject"));
+  ASSERT_LT(10, stats.at("GetObject").requestCount);
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     const std::unordered_map<std::string, std::string> config(
@@ -254,6 +277,54 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   ASSERT_EQ(readFile->pread(contentSize * 250'000, contentSize), dataContent);
 }
 
+TEST_F(S3FileSystemTest, parallelUploadAndRmdir) {
+  const auto bucketName = "paralleldata";
+  const auto directory = "spill";
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.upload-part-threads", "3"},
+       {"hive.s3.max-inflight-upload-parts", "2"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto pool = memory::memoryManager()->addLeafPool("S3FileSystemTest");
+  const auto s3Directory = s3URI(bucketName, directory);
+  s3fs.mkdir(s3Directory);
+
+  // 8 parts of 10MiB + a small last part. Each part has a different byte.
+  constexpr int64_t kPartSize = 10 * 1024 * 1024;
+  const std::vector<std::string> files = {"file1", "file2"};
+  for (const auto& file : files) {
+    auto writeFile = s3fs.openFileForWrite(
+        s3Directory + "/" + file, {{}, pool.get(), std::nullopt});
+    auto s3WriteFile = dynamic_cast<filesystems::S3WriteFile*>(writeFile.get());
+    for (int i = 0; i < 8; ++i) {
+      const std::string part(kPartSize, 'a' + i);
+      writeFile->append(part);
+    }
+    writeFile->append("tail");
+    writeFile->close();
+    EXPECT_EQ(s3WriteFile->numPartsUploaded(), 9);
+  }
+
+  for (const auto& file : files) {
+    auto readFile = s3fs.openFileForRead(s3Directory + "/" + file);
+    ASSERT_EQ(readFile->size(), 8 * kPartSize + 4);
+    for (int i = 0; i < 8; ++i) {
+      ASSERT_EQ(readFile->pread(i * kPartSize, 2), std::string(2, 'a' + i));
+      ASSERT_EQ(
+          readFile->pread((i + 1) * kPartSize - 2, 2),
+          std::string(2, 'a' + i));
+    }
+    ASSERT_EQ(readFile->pread(8 * kPartSize, 4), "tail");
+  }
+
+  s3fs.rmdir(s3Directory);
+  for (const auto& file : files) {
+    VELOX_ASSERT_RUNTIME_THROW_CODE(
+        s3fs.openFileForRead(s3Directory + "/" + file),
+        error_code::kFileNotFound,
+        "Failed to get metadata for S3 object");
+  }
+}
+
 TEST_F(S3FileSystemTest, invalidConnectionSettings) {
   auto hiveConfig =
       minioServer_->hiveConfig({{"hive.s3.connect-timeout", "400"}});
@@ -94,6 +94,15 @@ class S3Test : public testing::Test, public ::test::VectorTestBase {
     ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
     ASSERT_EQ(std::string_view(middle, sizeof(middle)), "cccc");
     ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+
+    std::fill(head, head + sizeof(head), 0);
+    std::fill(middle, middle + sizeof(middle), 0);
+    std::fill(tail, tail + sizeof(tail), 0);
+    ASSERT_TRUE(readFile->hasPreadvAsync());
+    ASSERT_EQ(15 + kOneMB, readFile->preadvAsync(0, buffers).get());
+    ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+    ASSERT_EQ(std::string_view(middle, sizeof(middle)), "cccc");
+    ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
   }
 
   std::unique_ptr<MinioServer> minioServer_;
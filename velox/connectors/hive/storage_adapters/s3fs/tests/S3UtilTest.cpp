@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 
 #include "gtest/gtest.h"
@@ -241,6 +242,24 @@ TEST_P(S3UtilProxyTest, proxyBuilderMixProxyLowerCase) {
       proxyConfig.value().password(), (useSsl ? "lctestpw2" : "lctestpw1"));
 }
 
+TEST(S3UtilTest, latencyTracker) {
+  S3LatencyTracker tracker(90);
+  for (auto i = 1; i < S3LatencyTracker::kMinSamples; ++i) {
+    tracker.record(i * 10);
+  }
+  EXPECT_EQ(0, tracker.threshold());
+  tracker.record(S3LatencyTracker::kMinSamples * 10);
+  EXPECT_EQ(290, tracker.threshold());
+
+  // The oldest latencies are replaced once kMaxSamples are recorded.
+  for (auto i = 0; i < S3LatencyTracker::kMaxSamples; ++i) {
+    tracker.record(1'000 + i);
+  }
+  EXPECT_EQ(1'921, tracker.threshold());
+  VELOX_ASSERT_THROW(S3LatencyTracker(0), "");
+  VELOX_ASSERT_THROW(S3LatencyTracker(100), "");
+}
+
 INSTANTIATE_TEST_SUITE_P(
     S3UtilTest,
     S3UtilProxyTest,
@@ -49,6 +49,7 @@ TEST(HiveConfigTest, defaultConfig) {
 
   ASSERT_EQ(hiveConfig->maxCoalescedBytes(), 128 << 20);
   ASSERT_EQ(hiveConfig->maxCoalescedDistanceBytes(), 512 << 10);
+  ASSERT_EQ(hiveConfig->localReadMode(), "pread");
   ASSERT_EQ(hiveConfig->numCacheFileHandles(), 20'000);
   ASSERT_EQ(hiveConfig->isFileHandleCacheEnabled(), true);
   ASSERT_EQ(
@@ -60,7 +61,17 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_EQ(hiveConfig->sortWriterMaxOutputRows(emptySession.get()), 1024);
   ASSERT_EQ(
       hiveConfig->sortWriterMaxOutputBytes(emptySession.get()), 10UL << 20);
+  ASSERT_EQ(hiveConfig->maxTargetFileSize(emptySession.get()), 0);
+  ASSERT_EQ(hiveConfig->maxOpenWriters(emptySession.get()), 0);
+  ASSERT_EQ(hiveConfig->maxParallelWriterCloses(emptySession.get()), 1);
+  ASSERT_EQ(hiveConfig->parallelUnitLoadCount(emptySession.get()), 0);
+  ASSERT_FALSE(hiveConfig->collectColumnReadStats(emptySession.get()));
+  ASSERT_TRUE(hiveConfig->reuseFileReaders(emptySession.get()));
   ASSERT_EQ(hiveConfig->isPartitionPathAsLowerCase(emptySession.get()), true);
+  ASSERT_FALSE(hiveConfig->parquetWritePageIndex(emptySession.get()));
+  ASSERT_TRUE(
+      hiveConfig->parquetWriteBloomFilterColumns(emptySession.get()).empty());
+  ASSERT_EQ(hiveConfig->parquetWriteBloomFilterFpp(emptySession.get()), 0.05);
 }
 
 TEST(HiveConfigTest, overrideConfig) {
@@ -84,12 +95,16 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kFileColumnNamesReadAsLowerCase, "true"},
       {HiveConfig::kMaxCoalescedBytes, "100"},
       {HiveConfig::kMaxCoalescedDistanceBytes, "100"},
+      {HiveConfig::kLocalReadMode, "mmap"},
       {HiveConfig::kNumCacheFileHandles, "100"},
       {HiveConfig::kEnableFileHandleCache, "false"},
       {HiveConfig::kOrcWriterMaxStripeSize, "100MB"},
       {HiveConfig::kOrcWriterMaxDictionaryMemory, "100MB"},
       {HiveConfig::kSortWriterMaxOutputRows, "100"},
-      {HiveConfig::kSortWriterMaxOutputBytes, "100MB"}};
+      {HiveConfig::kSortWriterMaxOutputBytes, "100MB"},
+      {HiveConfig::kParquetWritePageIndex, "true"},
+      {HiveConfig::kParquetWriteBloomFilterColumns, "a, b"},
+      {HiveConfig::kParquetWriteBloomFilterFpp, "0.01"}};
   HiveConfig* hiveConfig =
       new HiveConfig(std::make_shared<MemConfig>(configFromFile));
   auto emptySession = std::make_unique<MemConfig>();
@@ -116,6 +131,7 @@ TEST(HiveConfigTest, overrideConfig) {
       hiveConfig->isFileColumnNamesReadAsLowerCase(emptySession.get()), true);
   ASSERT_EQ(hiveConfig->maxCoalescedBytes(), 100);
   ASSERT_EQ(hiveConfig->maxCoalescedDistanceBytes(), 100);
+  ASSERT_EQ(hiveConfig->localReadMode(), "mmap");
   ASSERT_EQ(hiveConfig->numCacheFileHandles(), 100);
   ASSERT_EQ(hiveConfig->isFileHandleCacheEnabled(), false);
   ASSERT_EQ(
@@ -127,6 +143,11 @@ TEST(HiveConfigTest, overrideConfig) {
   ASSERT_EQ(hiveConfig->sortWriterMaxOutputRows(emptySession.get()), 100);
   ASSERT_EQ(
       hiveConfig->sortWriterMaxOutputBytes(emptySession.get()), 100UL << 20);
+  ASSERT_TRUE(hiveConfig->parquetWritePageIndex(emptySession.get()));
+  ASSERT_EQ(
+      hiveConfig->parquetWriteBloomFilterColumns(emptySession.get()),
+      std::vector<std::string>({"a", "b"}));
+  ASSERT_EQ(hiveConfig->parquetWriteBloomFilterFpp(emptySession.get()), 0.01);
 }
 
 TEST(HiveConfigTest, overrideSession) {
@@ -139,8 +160,16 @@ TEST(HiveConfigTest, overrideSession) {
       {HiveConfig::kOrcWriterMaxDictionaryMemorySession, "22MB"},
       {HiveConfig::kSortWriterMaxOutputRowsSession, "20"},
       {HiveConfig::kSortWriterMaxOutputBytesSession, "20MB"},
+      {HiveConfig::kMaxTargetFileSizeSession, "1GB"},
+      {HiveConfig::kMaxOpenWritersSession, "10"},
+      {HiveConfig::kMaxParallelWriterClosesSession, "8"},
+      {HiveConfig::kParallelUnitLoadCountSession, "4"},
+      {HiveConfig::kCollectColumnReadStatsSession, "true"},
+      {HiveConfig::kReuseFileReadersSession, "false"},
       {HiveConfig::kPartitionPathAsLowerCaseSession, "false"},
-      {HiveConfig::kIgnoreMissingFilesSession, "true"}};
+      {HiveConfig::kIgnoreMissingFilesSession, "true"},
+      {HiveConfig::kParquetWritePageIndexSession, "true"},
+      {HiveConfig::kParquetWriteBloomFilterColumnsSession, "c"}};
   const auto session = std::make_unique<MemConfig>(sessionOverride);
   ASSERT_EQ(
       hiveConfig->insertExistingPartitionsBehavior(session.get()),
@@ -165,6 +194,7 @@ TEST(HiveConfigTest, overrideSession) {
 
   ASSERT_EQ(hiveConfig->maxCoalescedBytes(), 128 << 20);
   ASSERT_EQ(hiveConfig->maxCoalescedDistanceBytes(), 512 << 10);
+  ASSERT_EQ(hiveConfig->localReadMode(), "pread");
   ASSERT_EQ(hiveConfig->numCacheFileHandles(), 20'000);
   ASSERT_EQ(hiveConfig->isFileHandleCacheEnabled(), true);
   ASSERT_EQ(
@@ -174,6 +204,16 @@ TEST(HiveConfigTest, overrideSession) {
       22L * 1024L * 1024L);
   ASSERT_EQ(hiveConfig->sortWriterMaxOutputRows(session.get()), 20);
   ASSERT_EQ(hiveConfig->sortWriterMaxOutputBytes(session.get()), 20UL << 20);
+  ASSERT_EQ(hiveConfig->maxTargetFileSize(session.get()), 1UL << 30);
+  ASSERT_EQ(hiveConfig->maxOpenWriters(session.get()), 10);
+  ASSERT_EQ(hiveConfig->maxParallelWriterCloses(session.get()), 8);
+  ASSERT_EQ(hiveConfig->parallelUnitLoadCount(session.get()), 4);
+  ASSERT_TRUE(hiveConfig->collectColumnReadStats(session.get()));
+  ASSERT_FALSE(hiveConfig->reuseFileReaders(session.get()));
   ASSERT_EQ(hiveConfig->isPartitionPathAsLowerCase(session.get()), false);
   ASSERT_EQ(hiveConfig->ignoreMissingFiles(session.get()), true);
+  ASSERT_TRUE(hiveConfig->parquetWritePageIndex(session.get()));
+  ASSERT_EQ(
+      hiveConfig->parquetWriteBloomFilterColumns(session.get()),
+      std::vector<std::string>({"c"}));
 }
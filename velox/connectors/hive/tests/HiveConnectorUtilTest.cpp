@@ -119,6 +119,9 @@ TEST_F(HiveConnectorUtilTest, configureReaderOptions) {
       readerOptions.getFilePreloadThreshold(),
       hiveConfig->filePreloadThreshold());
   EXPECT_EQ(readerOptions.prefetchRowGroups(), hiveConfig->prefetchRowGroups());
+  EXPECT_EQ(
+      readerOptions.maxPrefetchRowGroupBytes(),
+      hiveConfig->maxPrefetchRowGroupBytes());
 
   // Modify field delimiter and change the file format.
   clearDynamicParameters(FileFormat::TEXT);
@@ -185,6 +188,7 @@ TEST_F(HiveConnectorUtilTest, configureReaderOptions) {
   customHiveConfigProps[hive::HiveConfig::kFooterEstimatedSize] = "1111";
   customHiveConfigProps[hive::HiveConfig::kFilePreloadThreshold] = "9999";
   customHiveConfigProps[hive::HiveConfig::kPrefetchRowGroups] = "10";
+  customHiveConfigProps[hive::HiveConfig::kMaxPrefetchRowGroupBytes] = "12345";
   hiveConfig = std::make_shared<hive::HiveConfig>(
       std::make_shared<core::MemConfig>(customHiveConfigProps));
   performConfigure();
@@ -206,6 +210,9 @@ TEST_F(HiveConnectorUtilTest, configureReaderOptions) {
       readerOptions.getFilePreloadThreshold(),
       hiveConfig->filePreloadThreshold());
   EXPECT_EQ(readerOptions.prefetchRowGroups(), hiveConfig->prefetchRowGroups());
+  EXPECT_EQ(
+      readerOptions.maxPrefetchRowGroupBytes(),
+      hiveConfig->maxPrefetchRowGroupBytes());
 }
 
 TEST_F(HiveConnectorUtilTest, configureRowReaderOptions) {
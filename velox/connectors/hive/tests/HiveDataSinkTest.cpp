@@ -150,7 +150,8 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
       const std::vector<std::string>& partitionedBy = {},
       const std::shared_ptr<connector::hive::HiveBucketProperty>&
-          bucketProperty = nullptr) {
+          bucketProperty = nullptr,
+      folly::Executor* executor = nullptr) {
     return std::make_shared<HiveDataSink>(
         rowType,
         createHiveInsertTableHandle(
@@ -161,7 +162,8 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
             bucketProperty),
         connectorQueryCtx_.get(),
         CommitStrategy::kNoCommit,
-        connectorConfig_);
+        connectorConfig_,
+        executor);
   }
 
   std::vector<std::string> listFiles(const std::string& dirPath) {
@@ -506,6 +508,124 @@ TEST_F(HiveDataSinkTest, basic) {
   verifyWrittenData(outputDirectory->getPath());
 }
 
+TEST_F(HiveDataSinkTest, rollOverFiles) {
+  connectorConfig_ =
+      std::make_shared<HiveConfig>(std::make_shared<core::MemConfig>(
+          std::unordered_map<std::string, std::string>{
+              {HiveConfig::kMaxTargetFileSize, "1B"}}));
+  const auto outputDirectory = TempDirectoryPath::create();
+  auto dataSink = createDataSink(rowType_, outputDirectory->getPath());
+  const int numBatches = 5;
+  const auto vectors = createVectors(500, numBatches);
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+  const auto partitions = dataSink->close();
+  ASSERT_EQ(partitions.size(), numBatches);
+  ASSERT_EQ(dataSink->stats().numWrittenFiles, numBatches);
+
+  const auto filePaths = listFiles(outputDirectory->getPath());
+  ASSERT_EQ(filePaths.size(), numBatches);
+  std::vector<std::shared_ptr<ConnectorSplit>> splits;
+  for (const auto& filePath : filePaths) {
+    splits.push_back(makeHiveConnectorSplit(filePath));
+  }
+  createDuckDbTable(vectors);
+  HiveConnectorTestBase::assertQuery(
+      PlanBuilder().tableScan(rowType_).planNode(),
+      splits,
+      "SELECT * FROM tmp");
+}
+
+TEST_F(HiveDataSinkTest, maxOpenWriters) {
+  const auto rowType = ROW({"c0", "p0"}, {BIGINT(), BIGINT()});
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 6; ++i) {
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+         makeConstant<int64_t>(i % 3, 100)}));
+  }
+  createDuckDbTable(vectors);
+
+  // Each input is for one partition. With one open writer every input closes
+  // the file of the previous partition.
+  for (const auto& [maxOpenWriters, numFiles] :
+       std::vector<std::pair<int32_t, int32_t>>{{0, 3}, {1, 6}, {3, 3}}) {
+    SCOPED_TRACE(fmt::format("maxOpenWriters: {}", maxOpenWriters));
+    connectorConfig_ =
+        std::make_shared<HiveConfig>(std::make_shared<core::MemConfig>(
+            std::unordered_map<std::string, std::string>{
+                {HiveConfig::kMaxOpenWriters,
+                 std::to_string(maxOpenWriters)}}));
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        {"p0"});
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    ASSERT_EQ(dataSink->close().size(), numFiles);
+
+    const auto filePaths = listFiles(outputDirectory->getPath());
+    ASSERT_EQ(filePaths.size(), numFiles);
+    std::vector<std::shared_ptr<ConnectorSplit>> splits;
+    for (const auto& filePath : filePaths) {
+      splits.push_back(makeHiveConnectorSplit(filePath));
+    }
+    HiveConnectorTestBase::assertQuery(
+        PlanBuilder().tableScan(ROW({"c0"}, {BIGINT()})).planNode(),
+        splits,
+        "SELECT c0 FROM tmp");
+  }
+}
+
+TEST_F(HiveDataSinkTest, parallelClose) {
+  const auto rowType = ROW({"c0", "p0"}, {BIGINT(), BIGINT()});
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row % 10; })}));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto maxParallelCloses : {1, 4, 20}) {
+    SCOPED_TRACE(fmt::format("maxParallelCloses: {}", maxParallelCloses));
+    connectorConfig_ =
+        std::make_shared<HiveConfig>(std::make_shared<core::MemConfig>(
+            std::unordered_map<std::string, std::string>{
+                {HiveConfig::kMaxParallelWriterCloses,
+                 std::to_string(maxParallelCloses)}}));
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        {"p0"},
+        nullptr,
+        spillExecutor_.get());
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    ASSERT_EQ(dataSink->close().size(), 10);
+
+    const auto filePaths = listFiles(outputDirectory->getPath());
+    ASSERT_EQ(filePaths.size(), 10);
+    std::vector<std::shared_ptr<ConnectorSplit>> splits;
+    for (const auto& filePath : filePaths) {
+      splits.push_back(makeHiveConnectorSplit(filePath));
+    }
+    HiveConnectorTestBase::assertQuery(
+        PlanBuilder().tableScan(ROW({"c0"}, {BIGINT()})).planNode(),
+        splits,
+        "SELECT c0 FROM tmp");
+  }
+}
+
 TEST_F(HiveDataSinkTest, close) {
   for (bool empty : {true, false}) {
     SCOPED_TRACE(fmt::format("Data sink is empty: {}", empty));
@@ -224,13 +224,6 @@ void addSortingKeys(
 } // namespace
 
 bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
-  // TODO: Add spilling for aggregations over distinct inputs.
-  // https://github.com/facebookincubator/velox/issues/7454
-  for (const auto& aggregate : aggregates_) {
-    if (aggregate.distinct) {
-      return false;
-    }
-  }
   // TODO: add spilling for pre-grouped aggregation later:
   // https://github.com/facebookincubator/velox/issues/3264
   return (isFinal() || isSingle()) && preGroupedKeys().empty() &&
@@ -1057,11 +1050,15 @@ void HashJoinNode::addDetails(std::stringstream& stream) const {
   if (nullAware_) {
     stream << ", null aware";
   }
+  if (useHashTableCache_) {
+    stream << ", hash table cache";
+  }
 }
 
 folly::dynamic HashJoinNode::serialize() const {
   auto obj = serializeBase();
   obj["nullAware"] = nullAware_;
+  obj["useHashTableCache"] = useHashTableCache_;
   return obj;
 }
 
@@ -1081,6 +1078,10 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
 
   auto outputType = deserializeRowType(obj["outputType"]);
 
+  const bool useHashTableCache = obj.count("useHashTableCache")
+      ? obj["useHashTableCache"].asBool()
+      : false;
+
   return std::make_shared<HashJoinNode>(
       deserializePlanNodeId(obj),
       joinTypeFromName(obj["joinType"].asString()),
@@ -1090,7 +1091,8 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
       filter,
       sources[0],
       sources[1],
-      outputType);
+      outputType,
+      useHashTableCache);
 }
 
 folly::dynamic MergeJoinNode::serialize() const {
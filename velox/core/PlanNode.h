@@ -1575,7 +1575,8 @@ class HashJoinNode : public AbstractJoinNode {
       TypedExprPtr filter,
       PlanNodePtr left,
       PlanNodePtr right,
-      RowTypePtr outputType)
+      RowTypePtr outputType,
+      bool useHashTableCache = false)
       : AbstractJoinNode(
             id,
             joinType,
@@ -1585,7 +1586,15 @@ class HashJoinNode : public AbstractJoinNode {
             std::move(left),
             std::move(right),
             std::move(outputType)),
-        nullAware_{nullAware} {
+        nullAware_{nullAware},
+        useHashTableCache_{useHashTableCache} {
+    if (useHashTableCache) {
+      VELOX_USER_CHECK(
+          !nullAware && !isRightJoin() && !isFullJoin() &&
+              !isRightSemiFilterJoin() && !isRightSemiProjectJoin(),
+          "Hash table cache is not supported for {} join",
+          joinTypeName(joinType));
+    }
     if (nullAware) {
       VELOX_USER_CHECK(
           isNullAwareSupported(joinType),
@@ -1611,13 +1620,22 @@ class HashJoinNode : public AbstractJoinNode {
     // the build-side rows for filter evaluation which is not supported under
     // spilling.
     return !(isAntiJoin() && nullAware_ && filter() != nullptr) &&
-        queryConfig.joinSpillEnabled();
+        !useHashTableCache_ && queryConfig.joinSpillEnabled();
   }
 
   bool isNullAware() const {
     return nullAware_;
   }
 
+  /// Returns true if the tasks of a query on the same node share one build
+  /// side hash table for this join. Only valid if each task has the same build
+  /// side input, e.g. for a broadcast join. The shared table is read only, so
+  /// this is not supported for joins that record probed build rows. Disables
+  /// spilling.
+  bool useHashTableCache() const {
+    return useHashTableCache_;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -1626,6 +1644,7 @@ class HashJoinNode : public AbstractJoinNode {
   void addDetails(std::stringstream& stream) const override;
 
   const bool nullAware_;
+  const bool useHashTableCache_;
 };
 
 /// Represents inner/outer/semi/anti merge joins. Translates to an
@@ -2286,6 +2305,10 @@ class MarkDistinctNode : public PlanNode {
     return distinctKeys_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.markDistinctSpillEnabled();
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -101,11 +101,43 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// Whether to evaluate trees of arithmetic and comparison functions over
+  /// flat BIGINT and DOUBLE columns in one pass without materializing a vector
+  /// for each function call. False by default.
+  static constexpr const char* kExprFusionEnabled = "expression.fusion_enabled";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to count cycles, instructions, last level cache misses and
+  /// backend stall cycles of the addInput and getOutput calls of individual
+  /// operators with hardware counters. Adds the counts to the runtime stats of
+  /// the operators. False by default. Has no effect if the counters are not
+  /// available, e.g. on non-Linux systems.
+  static constexpr const char* kOperatorTrackPerfCounters =
+      "track_operator_perf_counters";
+
+  /// Whether to record the timeline of the drivers of a task for export in the
+  /// Chrome trace event format with exec::Task::exportTrace(). False by
+  /// default.
+  static constexpr const char* kTaskTraceEnabled = "task_trace_enabled";
+
+  /// The maximum number of events the timeline of a task keeps. Events past
+  /// the limit are dropped and counted.
+  static constexpr const char* kTaskTraceMaxEvents = "task_trace_max_events";
+
+  /// The directory to capture the input of the operators of
+  /// kOperatorTraceNodeIds to for offline replay. Capture is disabled if
+  /// empty, the default.
+  static constexpr const char* kOperatorTraceDir = "operator_trace_dir";
+
+  /// Comma separated ids of the plan nodes whose operators capture their
+  /// input to kOperatorTraceDir.
+  static constexpr const char* kOperatorTraceNodeIds =
+      "operator_trace_node_ids";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -142,6 +174,36 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// Number of first input rows of a partial aggregation to sample the number
+  /// of distinct grouping keys on. If the estimated percentage of distinct keys
+  /// equals or exceeds 'abandon_partial_aggregation_min_pct', the partial
+  /// aggregation is abandoned right after the sample. 0 disables sampling.
+  static constexpr const char* kAbandonPartialAggregationSampleRows =
+      "abandon_partial_aggregation_sample_rows";
+
+  /// Number of first input rows of a partial aggregation on which to check if
+  /// the input is clustered on the grouping keys, i.e. all the rows of a group
+  /// are next to each other. If it is, the aggregation outputs each group as
+  /// soon as the next one starts, as if all the grouping keys were
+  /// pre-grouped. 0 disables the check.
+  static constexpr const char* kPartialAggregationClusteredInputDetectionRows =
+      "partial_aggregation_clustered_input_detection_rows";
+
+  /// If true, operators record the outcome of their adaptive choices in a
+  /// process wide store keyed by a fingerprint of the plan. Later runs of the
+  /// same plan start in the recorded mode. Currently a partial aggregation
+  /// that was abandoned by an earlier run is abandoned from its first input.
+  static constexpr const char* kAdaptiveStatsStoreEnabled =
+      "adaptive_stats_store_enabled";
+
+  /// Number of input rows per tile when a grouping aggregation with many
+  /// aggregates updates the accumulators of a batch. Each tile of rows is
+  /// passed to all the aggregates before the next one, so that the group rows
+  /// of the tile stay in cache while the aggregates update them. 0 passes the
+  /// whole batch to each aggregate in turn.
+  static constexpr const char* kAggregationUpdateTileRows =
+      "aggregation_update_tile_rows";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -151,6 +213,18 @@ class QueryConfig {
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
+  /// If true, PartitionedOutput writes VARCHAR and VARBINARY columns of a page
+  /// as dictionary or RLE blocks when these are smaller than flat blocks.
+  static constexpr const char* kPartitionedOutputDictionaryEncoding =
+      "partitioned_output_dictionary_encoding";
+
+  /// Minimum bytes saved per microsecond of CPU spent compressing
+  /// PartitionedOutput pages. Compression that saves less is skipped for a
+  /// growing number of subsequent pages. 0 disables the check.
+  static constexpr const char*
+      kPartitionedOutputMinCompressionSavedBytesPerMicro =
+          "partitioned_output_min_compression_saved_bytes_per_micro";
+
   static constexpr const char* kMaxOutputBufferSize = "max_output_buffer_size";
 
   /// Preferred size of batches in bytes to be returned by operators from
@@ -195,9 +269,23 @@ class QueryConfig {
   static constexpr const char* kAggregationSpillEnabled =
       "aggregation_spill_enabled";
 
+  /// If true, a spilling aggregation stops using its hash table after the
+  /// first spill. The following input rows are stored one accumulator per
+  /// row without grouping and are sorted and aggregated when the spill runs
+  /// are merged. Only applies if "aggregation_spill_enabled" is set.
+  static constexpr const char* kAggregationSpillSortInput =
+      "aggregation_spill_sort_input";
+
   /// Join spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kJoinSpillEnabled = "join_spill_enabled";
 
+  /// If true, a hash join build that is asked to free memory spills only the
+  /// partitions with the most data, enough to reach the amount requested. The
+  /// other partitions stay in memory and are probed without spilling the
+  /// probe input. Only applies if "join_spill_enabled" is set.
+  static constexpr const char* kJoinPartialSpillEnabled =
+      "join_partial_spill_enabled";
+
   /// OrderBy spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kOrderBySpillEnabled = "order_by_spill_enabled";
 
@@ -216,6 +304,10 @@ class QueryConfig {
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
 
+  /// MarkDistinct spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMarkDistinctSpillEnabled =
+      "mark_distinct_spill_enabled";
+
   /// The max row numbers to fill and spill for each spill run. This is used to
   /// cap the memory used for spilling. If it is zero, then there is no limit
   /// and spilling might run out of memory.
@@ -257,6 +349,15 @@ class QueryConfig {
   static constexpr const char* kSpillFileCreateConfig =
       "spill_file_create_config";
 
+  /// If true, spill files store each column of a spilled batch as a separate
+  /// serialized stream so that the restore can read a subset of the columns.
+  static constexpr const char* kSpillColumnarLayout = "spill_columnar_layout";
+
+  /// If true, the merge of spill files reads the next buffer of each file on
+  /// the spill executor while the current buffer is consumed. This doubles the
+  /// read buffer memory of each merged file.
+  static constexpr const char* kSpillReadAhead = "spill_read_ahead";
+
   /// Default offset spill start partition bit.
   static constexpr const char* kSpillStartPartitionBit =
       "spiller_start_partition_bit";
@@ -280,6 +381,12 @@ class QueryConfig {
   static constexpr const char* kWriterFlushThresholdBytes =
       "writer_flush_threshold_bytes";
 
+  /// Maximum memory in bytes the file writers of a table writer operator
+  /// buffer before the operator flushes them. Keeps the writer memory bounded
+  /// without memory arbitration. 0 means no limit.
+  static constexpr const char* kTableWriterMaxBufferedBytes =
+      "table_writer_max_buffered_bytes";
+
   /// If true, array_agg() aggregation function will ignore nulls in the input.
   static constexpr const char* kPrestoArrayAggIgnoreNulls =
       "presto.array_agg.ignore_nulls";
@@ -321,6 +428,20 @@ class QueryConfig {
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The maximum size in bytes of a Bloom filter built over a hash join key
+  /// for dynamic filter pushdown. Bloom filters are built for integer keys that
+  /// have too many distinct values for an exact dynamic filter. 0 disables
+  /// Bloom filter dynamic filters.
+  static constexpr const char* kHashProbeBloomFilterPushdownMaxSize =
+      "hash_probe_bloom_filter_pushdown_max_size";
+
+  /// If true, a nested loop join with a join condition that bounds an integer
+  /// probe column by build columns, e.g. 'p BETWEEN b.lo AND b.hi', indexes
+  /// the build side by the bounds and evaluates the condition only for the
+  /// build rows in range instead of for all pairs of rows.
+  static constexpr const char* kNestedLoopJoinRangeIndexEnabled =
+      "nested_loop_join_range_index_enabled";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -344,16 +465,108 @@ class QueryConfig {
   static constexpr const char* kMaxSharedSubexprResultsCached =
       "max_shared_subexpr_results_cached";
 
+  /// For a given deterministic expression over a dictionary encoded input, the
+  /// maximum number of distinct dictionary base vectors we keep memoized
+  /// results for across batches. More than one helps when batches over a few
+  /// dictionaries alternate, e.g. after a local exchange of several scans.
+  /// Each entry holds on to a base vector and the results computed for it.
+  static constexpr const char* kMaxDictionaryMemoEntries =
+      "max_dictionary_memo_entries";
+
   /// Maximum number of splits to preload. Set to 0 to disable preloading.
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// Maximum bytes of the splits of a task that are preloading or preloaded
+  /// and not yet read. Within this cap, the bytes in flight follow the
+  /// measured rate at which the drivers read splits and the time a preload
+  /// takes. Set to 0 to limit the preloads only by
+  /// max_split_preload_per_driver.
+  static constexpr const char* kMaxSplitPreloadBytes =
+      "max_split_preload_bytes";
+
+  /// If true, the table scans cache their results by split in the process
+  /// wide exec::FragmentResultCache and serve the results of splits scanned
+  /// before from the cache. Only the splits of connectors that identify their
+  /// data, e.g. Hive splits with a file modification time, are cached.
+  static constexpr const char* kFragmentResultCacheEnabled =
+      "fragment_result_cache_enabled";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
   /// limit.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// If true and the query executor supports priorities, a driver that yields
+  /// after using up 'driver_cpu_time_slice_limit_ms' is rescheduled with low
+  /// priority and a driver resumed after being blocked for longer than a time
+  /// slice is rescheduled with high priority. The other drivers are scheduled
+  /// with the default priority. This lets short running drivers bypass
+  /// the long running ones.
+  static constexpr const char* kDriverSchedulingPrioritiesEnabled =
+      "driver_scheduling_priorities_enabled";
+
+  /// Relative share of executor threads of the query when other queries
+  /// compete for them. The drivers of the query run for
+  /// 'driver_cpu_time_slice_limit_ms' times this weight before yielding, so
+  /// that a query with weight 2 gets about twice the thread time of a query
+  /// with weight 1. Has no effect if there is no time slice limit.
+  static constexpr const char* kQueryCpuShareWeight = "query_cpu_share_weight";
+
+  /// If true, a task in grouped execution starts another split group only if
+  /// the query memory pool has room for it, as estimated from the memory use
+  /// of the running split groups. At least one split group is always run.
+  /// The concurrency given to Task::start() stays the upper bound.
+  static constexpr const char* kAdaptiveSplitGroupConcurrency =
+      "adaptive_split_group_concurrency";
+
+  /// Maximum number of bytes of the sort keys of a row that are encoded in the
+  /// prefix used by prefix sort. Keys past this limit are compared with
+  /// regular row comparisons when the prefixes are equal.
+  static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
+      "prefixsort_normalized_key_max_bytes";
+
+  /// Minimum number of rows to sort with prefix sort. Fewer rows are sorted
+  /// with std::sort since building the prefixes does not pay off.
+  static constexpr const char* kPrefixSortMinRows = "prefixsort_min_rows";
+
+  /// Minimum number of rows for prefix sort to sort the prefixes with radix
+  /// sort instead of quick sort. 0 disables radix sort.
+  static constexpr const char* kPrefixSortRadixSortMinRows =
+      "prefixsort_radix_sort_min_rows";
+
+  /// If true, the drivers of a partial OrderBy that feeds a LocalMerge sample
+  /// their sort keys and range partition their rows among each other, so that
+  /// each driver sorts a disjoint key range. The LocalMerge then concatenates
+  /// the sorted runs instead of merging them. Only applies if OrderBy
+  /// spilling is disabled.
+  static constexpr const char* kParallelOrderByEnabled =
+      "parallel_order_by_enabled";
+
+  /// If true, TopN pushes a range filter on its first sort key to the upstream
+  /// operators of its pipeline once it has accumulated the requested number of
+  /// rows. The filter passes only the values that can still enter the top
+  /// rows and is tightened as better rows arrive. A table scan uses it to drop
+  /// rows and to skip files, stripes and row groups by their statistics.
+  static constexpr const char* kTopNDynamicFilterEnabled =
+      "topn_dynamic_filter_enabled";
+
+  /// If true, FilterProject evaluates the conjuncts of its filter that compare
+  /// an integer column with a constant while the column is loaded, if the
+  /// column is not used anywhere else. The column values are then never
+  /// materialized and the other conjuncts are evaluated only on the passing
+  /// rows.
+  static constexpr const char* kFilterPushdownIntoLoadEnabled =
+      "filter_pushdown_into_load_enabled";
+
+  /// If true, operators start expensive setup, e.g. compiling their
+  /// expressions, on the query executor as soon as they are created, and join
+  /// the result on first use. This hides the setup of drivers that wait for a
+  /// thread behind the work of running drivers.
+  static constexpr const char* kSpeculativePreparationEnabled =
+      "speculative_preparation_enabled";
+
   uint64_t queryMaxMemoryPerNode() const {
     return toCapacity(
         get<std::string>(kQueryMaxMemoryPerNode, "0B"), CapacityUnit::BYTE);
@@ -377,6 +590,22 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int32_t abandonPartialAggregationSampleRows() const {
+    return get<int32_t>(kAbandonPartialAggregationSampleRows, 0);
+  }
+
+  int32_t partialAggregationClusteredInputDetectionRows() const {
+    return get<int32_t>(kPartialAggregationClusteredInputDetectionRows, 0);
+  }
+
+  bool adaptiveStatsStoreEnabled() const {
+    return get<bool>(kAdaptiveStatsStoreEnabled, false);
+  }
+
+  int32_t aggregationUpdateTileRows() const {
+    return get<int32_t>(kAggregationUpdateTileRows, 0);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -406,6 +635,14 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  bool partitionedOutputDictionaryEncoding() const {
+    return get<bool>(kPartitionedOutputDictionaryEncoding, false);
+  }
+
+  int64_t partitionedOutputMinCompressionSavedBytesPerMicro() const {
+    return get<int64_t>(kPartitionedOutputMinCompressionSavedBytesPerMicro, 0);
+  }
+
   /// Returns the maximum size in bytes for the task's buffered output.
   ///
   /// The producer Drivers are blocked when the buffered size exceeds
@@ -497,12 +734,20 @@ class QueryConfig {
     return get<bool>(kAggregationSpillEnabled, true);
   }
 
+  bool aggregationSpillSortInput() const {
+    return get<bool>(kAggregationSpillSortInput, false);
+  }
+
   /// Returns 'is join spilling enabled' flag. Must also check the
   /// spillEnabled()!
   bool joinSpillEnabled() const {
     return get<bool>(kJoinSpillEnabled, true);
   }
 
+  bool joinPartialSpillEnabled() const {
+    return get<bool>(kJoinPartialSpillEnabled, false);
+  }
+
   /// Returns 'is orderby spilling enabled' flag. Must also check the
   /// spillEnabled()!
   bool orderBySpillEnabled() const {
@@ -533,6 +778,12 @@ class QueryConfig {
     return get<bool>(kTopNRowNumberSpillEnabled, true);
   }
 
+  /// Returns true if spilling is enabled for MarkDistinct operator. Must also
+  /// check the spillEnabled()!
+  bool markDistinctSpillEnabled() const {
+    return get<bool>(kMarkDistinctSpillEnabled, true);
+  }
+
   int32_t maxSpillLevel() const {
     return get<int32_t>(kMaxSpillLevel, 1);
   }
@@ -574,6 +825,10 @@ class QueryConfig {
     return get<uint64_t>(kWriterFlushThresholdBytes, 96L << 20);
   }
 
+  uint64_t tableWriterMaxBufferedBytes() const {
+    return get<uint64_t>(kTableWriterMaxBufferedBytes, 0);
+  }
+
   uint64_t maxSpillFileSize() const {
     constexpr uint64_t kDefaultMaxFileSize = 0;
     return get<uint64_t>(kMaxSpillFileSize, kDefaultMaxFileSize);
@@ -592,6 +847,14 @@ class QueryConfig {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
 
+  bool spillColumnarLayout() const {
+    return get<bool>(kSpillColumnarLayout, false);
+  }
+
+  bool spillReadAhead() const {
+    return get<bool>(kSpillReadAhead, false);
+  }
+
   /// Returns the minimal available spillable memory reservation in percentage
   /// of the current memory usage. Suppose the current memory usage size of M,
   /// available memory reservation size of N and min reservation percentage of
@@ -657,10 +920,34 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  bool exprFusionEnabled() const {
+    return get<bool>(kExprFusionEnabled, false);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorTrackPerfCounters() const {
+    return get<bool>(kOperatorTrackPerfCounters, false);
+  }
+
+  bool taskTraceEnabled() const {
+    return get<bool>(kTaskTraceEnabled, false);
+  }
+
+  uint64_t taskTraceMaxEvents() const {
+    return get<uint64_t>(kTaskTraceMaxEvents, 1'000'000);
+  }
+
+  std::string operatorTraceDir() const {
+    return get<std::string>(kOperatorTraceDir, "");
+  }
+
+  std::string operatorTraceNodeIds() const {
+    return get<std::string>(kOperatorTraceNodeIds, "");
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -678,6 +965,14 @@ class QueryConfig {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint64_t hashProbeBloomFilterPushdownMaxSize() const {
+    return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
+  }
+
+  bool nestedLoopJoinRangeIndexEnabled() const {
+    return get<bool>(kNestedLoopJoinRangeIndexEnabled, true);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -702,14 +997,66 @@ class QueryConfig {
     return get<uint32_t>(kMaxSharedSubexprResultsCached, 10);
   }
 
+  uint32_t maxDictionaryMemoEntries() const {
+    return get<uint32_t>(kMaxDictionaryMemoEntries, 1);
+  }
+
   int32_t maxSplitPreloadPerDriver() const {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  uint64_t maxSplitPreloadBytes() const {
+    return get<uint64_t>(kMaxSplitPreloadBytes, 0);
+  }
+
+  bool fragmentResultCacheEnabled() const {
+    return get<bool>(kFragmentResultCacheEnabled, false);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  bool driverSchedulingPrioritiesEnabled() const {
+    return get<bool>(kDriverSchedulingPrioritiesEnabled, false);
+  }
+
+  uint32_t queryCpuShareWeight() const {
+    return get<uint32_t>(kQueryCpuShareWeight, 1);
+  }
+
+  bool adaptiveSplitGroupConcurrency() const {
+    return get<bool>(kAdaptiveSplitGroupConcurrency, false);
+  }
+
+  uint32_t prefixSortNormalizedKeyMaxBytes() const {
+    return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
+  }
+
+  uint32_t prefixSortMinRows() const {
+    return get<uint32_t>(kPrefixSortMinRows, 130);
+  }
+
+  uint32_t prefixSortRadixSortMinRows() const {
+    return get<uint32_t>(kPrefixSortRadixSortMinRows, 65536);
+  }
+
+  bool parallelOrderByEnabled() const {
+    return get<bool>(kParallelOrderByEnabled, false);
+  }
+
+  bool topNDynamicFilterEnabled() const {
+    return get<bool>(kTopNDynamicFilterEnabled, true);
+  }
+
+  bool filterPushdownIntoLoadEnabled() const {
+    return get<bool>(kFilterPushdownIntoLoadEnabled, false);
+  }
+
+  bool speculativePreparationEnabled() const {
+    return get<bool>(kSpeculativePreparationEnabled, false);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
@@ -719,6 +1066,11 @@ class QueryConfig {
     return std::optional<T>(config_->get<T>(key));
   }
 
+  /// Returns a copy of all the config properties.
+  std::unordered_map<std::string, std::string> valuesCopy() const {
+    return config_->valuesCopy();
+  }
+
   /// Test-only method to override the current query config properties.
   /// It is not thread safe.
   void testingOverrideConfigUnsafe(
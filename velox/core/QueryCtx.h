@@ -133,6 +133,18 @@ class QueryCtx {
   /// exceeds the max spill bytes limit.
   void updateSpilledBytesAndCheckLimit(uint64_t bytes);
 
+  /// Adds 'micros' to the time the drivers of this query have waited for an
+  /// executor thread while runnable.
+  void addDriverQueuedTime(uint64_t micros) {
+    driverQueuedMicros_ += micros;
+  }
+
+  /// Returns the total time the drivers of this query have waited for an
+  /// executor thread while runnable.
+  uint64_t driverQueuedTimeMicros() const {
+    return driverQueuedMicros_;
+  }
+
  private:
   static Config* getEmptyConfig() {
     static const std::unique_ptr<Config> kEmptyConfig =
@@ -160,6 +172,7 @@ class QueryCtx {
   folly::Executor::KeepAlive<> executorKeepalive_;
   QueryConfig queryConfig_;
   std::atomic<uint64_t> numSpilledBytes_{0};
+  std::atomic<uint64_t> driverQueuedMicros_{0};
 };
 
 // Represents the state of one thread of query execution.
@@ -17,6 +17,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <folly/Likely.h>
+#include <folly/Range.h>
 #include <optional>
 
 #include "velox/common/base/Exceptions.h"
@@ -663,6 +664,7 @@ class UDFHolder {
   DECLARE_METHOD_RESOLVER(callNullable_method_resolver, callNullable);
   DECLARE_METHOD_RESOLVER(callNullFree_method_resolver, callNullFree);
   DECLARE_METHOD_RESOLVER(callAscii_method_resolver, callAscii);
+  DECLARE_METHOD_RESOLVER(callBatch_method_resolver, callBatch);
   DECLARE_METHOD_RESOLVER(initialize_method_resolver, initialize);
 
   // Check which flavor of the call() method is provided by the UDF object. UDFs
@@ -678,6 +680,7 @@ class UDFHolder {
   // Optionally, UDFs can also provide the following methods:
   //
   // - bool|void callAscii(...)
+  // - void callBatch(...)
   // - void initialize(...)
 
   // call():
@@ -762,6 +765,15 @@ class UDFHolder {
         (udf_has_callAscii_return_void && udf_has_call_return_bool)),
       "The return type for callAscii() must match the return type for call().");
 
+  // callBatch(): Takes the results and the arguments of consecutive rows as
+  // ranges of flat values.
+  static constexpr bool udf_has_callBatch = util::has_method<
+      Fun,
+      callBatch_method_resolver,
+      void,
+      folly::Range<exec_return_type*>,
+      folly::Range<const exec_arg_type<TArgs>*>...>::value;
+
   // initialize():
   static constexpr bool udf_has_initialize = util::has_method<
       Fun,
@@ -816,6 +828,12 @@ class UDFHolder {
   static constexpr bool is_default_contains_nulls_behavior =
       !udf_has_call && !udf_has_callNullable;
   static constexpr bool has_ascii = udf_has_callAscii;
+
+  static_assert(
+      !udf_has_callBatch ||
+          (is_default_null_behavior && !can_produce_null_output),
+      "callBatch() requires default null behavior and call methods that "
+      "return void.");
   static constexpr bool is_default_ascii_behavior =
       udf_is_default_ascii_behavior<Fun>();
 
@@ -907,6 +925,17 @@ class UDFHolder {
     }
   }
 
+  FOLLY_ALWAYS_INLINE void callBatch(
+      folly::Range<exec_return_type*> out,
+      folly::Range<const exec_arg_type<TArgs>*>... args) {
+    if constexpr (udf_has_callBatch) {
+      instance_.callBatch(out, args...);
+    } else {
+      VELOX_UNREACHABLE(
+          "callBatch should never be called if the UDF does not implement callBatch.");
+    }
+  }
+
   FOLLY_ALWAYS_INLINE bool callNullFree(
       exec_return_type& out,
       const exec_no_nulls_arg_type<TArgs>&... args) {
@@ -169,11 +169,69 @@ int32_t decode1To24(
   return i;
 }
 
+// Decodes bit fields of 25-32 bits. A field at an odd bit offset may span 5
+// bytes, so each of the 8 fields is loaded with a 64 bit gather and shifted
+// in 64 bit lanes before narrowing to the width of T.
+template <uint8_t width, typename T>
+int32_t decode25To32(
+    const uint64_t* bits,
+    int32_t bitOffset,
+    const int* rows,
+    int32_t numRows,
+    T* result) {
+  static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+  constexpr __m256si kWidthSplat = {
+      width, width, width, width, width, width, width, width};
+  // Selects the low halves of 4 64 bit lanes into the low 128 bits.
+  constexpr __m256si kNarrow = {0, 2, 4, 6, 0, 2, 4, 6};
+  const auto masks = _mm256_set1_epi64x(bits::lowMask(width));
+  const auto* base = reinterpret_cast<const long long*>(bits);
+  int32_t i = 0;
+  for (; i + 8 <= numRows; i += 8) {
+    auto indices =
+        *reinterpret_cast<const __m256si_u*>(rows + i) * kWidthSplat +
+        bitOffset;
+    auto byteIndices = as256i(indices >> 3);
+    auto shifts = as256i(indices & 7);
+    auto low = _mm256_i32gather_epi64(
+        base, _mm256_castsi256_si128(byteIndices), 1);
+    auto high = _mm256_i32gather_epi64(
+        base, _mm256_extracti128_si256(byteIndices, 1), 1);
+    low = _mm256_and_si256(
+        _mm256_srlv_epi64(
+            low, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(shifts))),
+        masks);
+    high = _mm256_and_si256(
+        _mm256_srlv_epi64(
+            high, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(shifts, 1))),
+        masks);
+    if constexpr (sizeof(T) == 8) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), low);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i + 4), high);
+    } else {
+      low = _mm256_permutevar8x32_epi32(low, as256i(kNarrow));
+      high = _mm256_permutevar8x32_epi32(high, as256i(kNarrow));
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(result + i),
+          _mm256_inserti128_si256(low, _mm256_castsi256_si128(high), 1));
+    }
+  }
+  return i;
+}
+
 #define WIDTH_CASE(width)                                                      \
   case width:                                                                  \
     i = decode1To24<width>(bits, bitOffset, rows.data(), numSafeRows, result); \
     break;
 
+#define WIDE_WIDTH_CASE(width)                                        \
+  case width:                                                         \
+    if constexpr (sizeof(T) == 4 || sizeof(T) == 8) {                 \
+      i = decode25To32<width>(                                        \
+          bits, bitOffset, rows.data(), numSafeRows, result);         \
+    }                                                                 \
+    break;
+
 } // namespace
 
 #endif
@@ -263,6 +321,14 @@ void unpack(
     WIDTH_CASE(22);
     WIDTH_CASE(23);
     WIDTH_CASE(24);
+    WIDE_WIDTH_CASE(25);
+    WIDE_WIDTH_CASE(26);
+    WIDE_WIDTH_CASE(27);
+    WIDE_WIDTH_CASE(28);
+    WIDE_WIDTH_CASE(29);
+    WIDE_WIDTH_CASE(30);
+    WIDE_WIDTH_CASE(31);
+    WIDE_WIDTH_CASE(32);
     default:
       break;
   }
@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "folly/io/Cursor.h"
+#include "velox/common/process/TimelineRecorder.h"
 #include "velox/dwio/common/BufferedInput.h"
 
 DEFINE_bool(wsVRLoad, false, "Use WS VRead API to load");
@@ -90,6 +91,7 @@ void BufferedInput::readToBuffer(
   if (auto* stats = input_->getStats()) {
     stats->read().increment(allocated.size());
     stats->queryThreadIoLatency().increment(usec);
+    process::recordThreadEvent("io", "read", usec);
   }
 }
 
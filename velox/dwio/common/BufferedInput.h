@@ -142,6 +142,12 @@ class BufferedInput {
     return nullptr;
   }
 
+  /// Returns the number that identifies the file in the caches of the process,
+  /// or std::nullopt if the file has no such number.
+  virtual std::optional<uint64_t> fileNum() const {
+    return std::nullopt;
+  }
+
   virtual uint64_t nextFetchSize() const;
 
  protected:
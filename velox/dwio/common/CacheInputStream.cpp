@@ -16,6 +16,7 @@
 
 #include <folly/executors/QueuedImmediateExecutor.h>
 
+#include "velox/common/process/TimelineRecorder.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
@@ -135,6 +136,13 @@ size_t CacheInputStream::positionSize() {
   return 1;
 }
 
+cache::AsyncDataCache* CacheInputStream::cacheKey(
+    uint64_t position,
+    cache::RawFileCacheKey& key) const {
+  key = {fileNum_, region_.offset + position};
+  return cache_;
+}
+
 void CacheInputStream::setRemainingBytes(uint64_t remainingBytes) {
   VELOX_CHECK_GE(region_.length, position_ + remainingBytes);
   window_ = Region{static_cast<uint64_t>(position_), remainingBytes};
@@ -198,6 +206,7 @@ void CacheInputStream::loadSync(Region region) {
         std::move(wait).via(&exec).wait();
       }
       ioStats_->queryThreadIoLatency().increment(usec);
+      process::recordThreadEvent("io", "ioWait", usec);
       continue;
     }
     auto entry = pin_.checkedEntry();
@@ -217,6 +226,7 @@ void CacheInputStream::loadSync(Region region) {
       }
       ioStats_->read().increment(region.length);
       ioStats_->queryThreadIoLatency().increment(usec);
+      process::recordThreadEvent("io", "read", usec);
       ioStats_->incTotalScanTime(usec * 1'000);
       entry->setExclusiveToShared();
     } else {
@@ -281,6 +291,7 @@ bool CacheInputStream::loadFromSsd(
   pin_ = std::move(pins[0]);
   ioStats_->ssdRead().increment(region.length);
   ioStats_->queryThreadIoLatency().increment(usec);
+  process::recordThreadEvent("io", "ssdRead", usec);
   entry.setExclusiveToShared();
   return true;
 }
@@ -306,6 +317,7 @@ void CacheInputStream::loadPosition() {
         }
       }
       ioStats_->queryThreadIoLatency().increment(usec);
+      process::recordThreadEvent("io", "ioWait", usec);
     }
     auto loadRegion = region_;
     // Quantize position to previous multiple of 'loadQuantum_'.
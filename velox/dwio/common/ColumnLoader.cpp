@@ -17,6 +17,7 @@
 #include "velox/dwio/common/ColumnLoader.h"
 
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -78,9 +79,16 @@ void ColumnLoader::loadInternal(
     effectiveRows = RowSet(selectedRows);
   }
 
+  auto* stats = structReader_->childReadStatistics(*fieldReader_->scanSpec());
   structReader_->advanceFieldReader(fieldReader_, offset);
   fieldReader_->scanSpec()->setValueHook(hook);
-  fieldReader_->read(offset, effectiveRows, incomingNulls);
+  {
+    std::optional<MicrosecondTimer> readTimer;
+    if (stats) {
+      readTimer.emplace(&stats->readMicros);
+    }
+    fieldReader_->read(offset, effectiveRows, incomingNulls);
+  }
   if (fieldReader_->fileType().type()->kind() == TypeKind::ROW) {
     // 'fieldReader_' may itself produce LazyVectors. For this it must have its
     // result row numbers set.
@@ -88,7 +96,18 @@ void ColumnLoader::loadInternal(
         ->setLoadableRows(effectiveRows);
   }
   if (!hook) {
-    fieldReader_->getValues(effectiveRows, result);
+    {
+      std::optional<MicrosecondTimer> getValuesTimer;
+      if (stats) {
+        getValuesTimer.emplace(&stats->getValuesMicros);
+      }
+      fieldReader_->getValues(effectiveRows, result);
+    }
+    const auto bytes = (*result)->estimateFlatSize();
+    structReader_->addLazyLoadedBytes(bytes);
+    if (stats) {
+      stats->outputBytes += bytes;
+    }
     if (((rows.back() + 1) < resultSize) || rows.size() != outputRows.size()) {
       // We read sparsely. The values that were read should appear
       // at the indices in the result vector that were given by
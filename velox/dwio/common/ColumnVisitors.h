@@ -150,6 +150,10 @@ class ColumnVisitor {
   using DataType = T;
   static constexpr bool dense = isDense;
   static constexpr bool kHasBulkPath = true;
+  // True if the filter applies to the decoded values, so that a decoder may
+  // drop a whole run whose value range fails the filter with
+  // skipFailedRun().
+  static constexpr bool kCanSkipFailedRuns = false;
   ColumnVisitor(
       TFilter& filter,
       SelectiveColumnReader* reader,
@@ -1390,6 +1394,8 @@ class DirectRleColumnVisitor
             rows,
             values) {}
 
+  static constexpr bool kCanSkipFailedRuns = true;
+
   // Use for replacing all rows with non-null rows for fast path with
   // processRun and processRle.
   void setRows(folly::Range<const int32_t*> newRows) {
@@ -1397,6 +1403,13 @@ class DirectRleColumnVisitor
     super::numRows_ = newRows.size();
   }
 
+  // Skips the next 'numRows' rows of the fast path without decoding them.
+  // Used when the filter fails on the range of values of the run they fall
+  // in.
+  void skipFailedRun(int32_t numRows) {
+    super::rowIndex_ += numRows;
+  }
+
   // Processes 'numInput' T's in 'input'. Sets 'values' and
   // 'numValues'' to the resulting values. 'scatterRows' may be
   // non-null if there is no filter and the decoded values should be
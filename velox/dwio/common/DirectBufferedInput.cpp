@@ -179,7 +179,13 @@ void DirectBufferedInput::makeLoads(
         ++numNewLoads;
         readRegion(ranges, shouldPrefetch);
       });
-  if (shouldPrefetch && executor_) {
+  if (shouldPrefetch && input_->hasReadAsync()) {
+    // The file reads asynchronously. Starts the loads without taking a thread
+    // of 'executor_' for the duration of each read.
+    for (auto& load : coalescedLoads_) {
+      CoalescedLoad::loadAsync(load);
+    }
+  } else if (shouldPrefetch && executor_) {
     for (auto i = 0; i < coalescedLoads_.size(); ++i) {
       auto& load = coalescedLoads_[i];
       if (load->state() == CoalescedLoad::State::kPlanned) {
@@ -238,11 +244,13 @@ void appendRanges(
 }
 } // namespace
 
-std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool isPrefetch) {
+std::vector<folly::Range<char*>> DirectCoalescedLoad::makeBuffers(
+    int64_t& size,
+    int64_t& overread) {
   std::vector<folly::Range<char*>> buffers;
   int64_t lastEnd = requests_[0].region.offset;
-  int64_t size = 0;
-  int64_t overread = 0;
+  size = 0;
+  overread = 0;
   for (auto& request : requests_) {
     auto& region = request.region;
     if (region.offset > lastEnd) {
@@ -272,15 +280,53 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool isPrefetch) {
     lastEnd = region.offset + request.loadSize;
     size += std::min<int32_t>(loadQuantum_, region.length);
   }
-  input_->read(buffers, requests_[0].region.offset, LogType::FILE);
+  return buffers;
+}
+
+void DirectCoalescedLoad::recordLoad(
+    int64_t size,
+    int64_t overread,
+    bool isPrefetch) {
   ioStats_->read().increment(size);
   ioStats_->incRawOverreadBytes(overread);
   if (isPrefetch) {
     ioStats_->prefetch().increment(size);
   }
+}
+
+std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool isPrefetch) {
+  int64_t size;
+  int64_t overread;
+  const auto buffers = makeBuffers(size, overread);
+  input_->read(buffers, requests_[0].region.offset, LogType::FILE);
+  recordLoad(size, overread, isPrefetch);
   return {};
 }
 
+folly::SemiFuture<std::vector<cache::CachePin>>
+DirectCoalescedLoad::loadDataAsync(bool isPrefetch) {
+  if (!input_->hasReadAsync()) {
+    return CoalescedLoad::loadDataAsync(isPrefetch);
+  }
+  try {
+    int64_t size;
+    int64_t overread;
+    // Kept alive until the read completes.
+    auto buffers = std::make_shared<std::vector<folly::Range<char*>>>(
+        makeBuffers(size, overread));
+    return input_
+        ->readAsync(*buffers, requests_[0].region.offset, LogType::FILE)
+        .deferValue([this, buffers, size, overread, isPrefetch](
+                        uint64_t /*bytes*/) {
+          recordLoad(size, overread, isPrefetch);
+          return std::vector<cache::CachePin>{};
+        });
+  } catch (const std::exception& e) {
+    return folly::makeSemiFuture<std::vector<cache::CachePin>>(
+        folly::exception_wrapper(std::current_exception(), e));
+  }
+}
+
 int32_t DirectCoalescedLoad::getData(
     int64_t offset,
 
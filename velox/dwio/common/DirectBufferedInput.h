@@ -73,6 +73,12 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
   // data is retrieved with getData().
   std::vector<cache::CachePin> loadData(bool isPrefetch) override;
 
+  // Like loadData() but reads with ReadFileInputStream::readAsync() if the
+  // file has a native asynchronous read. The returned future then completes
+  // on a thread of the file's client.
+  folly::SemiFuture<std::vector<cache::CachePin>> loadDataAsync(
+      bool isPrefetch) override;
+
   // Returns the buffer for 'region' in either 'data' or 'tinyData'. 'region'
   // must match a region given to SelectiveBufferedInput::enqueue().
   int32_t
@@ -91,6 +97,16 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
   }
 
  private:
+  // Allocates memory for 'requests_' and returns the ranges to read into,
+  // starting at the offset of the first request. Sets 'size' to the loaded
+  // bytes and 'overread' to the bytes of the gaps between requests.
+  std::vector<folly::Range<char*>> makeBuffers(
+      int64_t& size,
+      int64_t& overread);
+
+  // Records the IO of a finished load in 'ioStats_'.
+  void recordLoad(int64_t size, int64_t overread, bool isPrefetch);
+
   const std::shared_ptr<IoStatistics> ioStats_;
   const uint64_t groupId_;
   const std::shared_ptr<ReadFileInputStream> input_;
@@ -172,6 +188,10 @@ class DirectBufferedInput : public BufferedInput {
     return executor_;
   }
 
+  std::optional<uint64_t> fileNum() const override {
+    return fileNum_;
+  }
+
   uint64_t nextFetchSize() const override {
     VELOX_NYI();
   }
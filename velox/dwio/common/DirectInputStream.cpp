@@ -16,6 +16,7 @@
 
 #include <folly/executors/QueuedImmediateExecutor.h>
 
+#include "velox/common/process/TimelineRecorder.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/time/Timer.h"
 #include "velox/dwio/common/DirectBufferedInput.h"
@@ -154,6 +155,7 @@ void DirectInputStream::loadSync() {
   }
   ioStats_->read().increment(loadedRegion_.length);
   ioStats_->queryThreadIoLatency().increment(usecs);
+  process::recordThreadEvent("io", "read", usecs);
   ioStats_->incTotalScanTime(usecs * 1'000);
 }
 
@@ -175,6 +177,7 @@ void DirectInputStream::loadPosition() {
         loadedRegion_.length = load->getData(region_.offset, data_, tinyData_);
       }
       ioStats_->queryThreadIoLatency().increment(usecs);
+      process::recordThreadEvent("io", "ioWait", usecs);
     } else {
       // Standalone stream, not part of coalesced load.
       loadedRegion_.offset = 0;
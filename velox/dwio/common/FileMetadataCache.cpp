@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+namespace facebook::velox::dwio::common {
+
+// static
+FileMetadataCache* FileMetadataCache::getInstance() {
+  return *getInstancePtr();
+}
+
+// static
+void FileMetadataCache::setInstance(FileMetadataCache* cache) {
+  *getInstancePtr() = cache;
+}
+
+// static
+FileMetadataCache** FileMetadataCache::getInstancePtr() {
+  static FileMetadataCache* cache_{nullptr};
+  return &cache_;
+}
+
+std::shared_ptr<const void> FileMetadataCache::getInternal(const Key& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numLookups_;
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  ++numHits_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->metadata;
+}
+
+void FileMetadataCache::put(
+    const Key& key,
+    std::shared_ptr<const void> metadata,
+    int64_t bytes) {
+  VELOX_CHECK_NOT_NULL(metadata);
+  if (bytes > capacity_) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    removeLocked(it->second);
+  }
+  while (bytes_ + bytes > capacity_) {
+    removeLocked(std::prev(lru_.end()));
+    ++numEvictions_;
+  }
+  lru_.push_front({key, std::move(metadata), bytes});
+  entries_[key] = lru_.begin();
+  bytes_ += bytes;
+}
+
+void FileMetadataCache::removeLocked(EntryList::iterator it) {
+  bytes_ -= it->bytes;
+  entries_.erase(it->key);
+  lru_.erase(it);
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  bytes_ = 0;
+}
+
+FileMetadataCache::Stats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numEntries = entries_.size();
+  stats.bytes = bytes_;
+  stats.numLookups = numLookups_;
+  stats.numHits = numHits_;
+  stats.numEvictions = numEvictions_;
+  return stats;
+}
+
+} // namespace facebook::velox::dwio::common
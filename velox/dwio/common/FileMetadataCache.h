@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/Options.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Process wide cache of the parsed metadata of files, e.g. DWRF footers or
+/// Parquet FileMetaData, shared by the readers of the splits of the same file.
+/// Entries are keyed by the file number the data caches use for the file,
+/// i.e. the id of its FileHandle, together with the file size and format. The
+/// total size of the entries is kept within a capacity in bytes by evicting
+/// the least recently used ones. Thread safe.
+class FileMetadataCache {
+ public:
+  struct Key {
+    uint64_t fileNum;
+    uint64_t fileSize;
+    FileFormat format;
+
+    bool operator==(const Key& other) const {
+      return fileNum == other.fileNum && fileSize == other.fileSize &&
+          format == other.format;
+    }
+  };
+
+  struct Stats {
+    int64_t numEntries{0};
+    int64_t bytes{0};
+    int64_t numLookups{0};
+    int64_t numHits{0};
+    int64_t numEvictions{0};
+  };
+
+  explicit FileMetadataCache(int64_t capacity) : capacity_(capacity) {
+    VELOX_CHECK_GT(capacity_, 0);
+  }
+
+  /// Returns the process wide cache or nullptr if there is none.
+  static FileMetadataCache* getInstance();
+
+  static void setInstance(FileMetadataCache* cache);
+
+  /// Returns the metadata for 'key' or nullptr if not cached. 'T' must be the
+  /// type the metadata was inserted with, which is determined by the format
+  /// in 'key'.
+  template <typename T>
+  std::shared_ptr<const T> get(const Key& key) {
+    return std::static_pointer_cast<const T>(getInternal(key));
+  }
+
+  /// Adds 'metadata' of 'bytes' in-memory size for 'key'. Replaces any
+  /// existing entry for 'key'. Metadata larger than the capacity is not
+  /// cached.
+  void put(const Key& key, std::shared_ptr<const void> metadata, int64_t bytes);
+
+  /// Drops all the entries. Readers keep the metadata they have already got.
+  void clear();
+
+  Stats stats() const;
+
+ private:
+  struct KeyHasher {
+    size_t operator()(const Key& key) const {
+      return folly::hash::hash_combine(
+          key.fileNum, key.fileSize, static_cast<int32_t>(key.format));
+    }
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<const void> metadata;
+    int64_t bytes;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  std::shared_ptr<const void> getInternal(const Key& key);
+
+  // Removes 'it' from 'entries_' and 'lru_'.
+  void removeLocked(EntryList::iterator it);
+
+  static FileMetadataCache** getInstancePtr();
+
+  const int64_t capacity_;
+
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  EntryList lru_;
+  folly::F14FastMap<Key, EntryList::iterator, KeyHasher> entries_;
+  int64_t bytes_{0};
+  int64_t numLookups_{0};
+  int64_t numHits_{0};
+  int64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::dwio::common
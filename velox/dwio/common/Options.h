@@ -147,6 +147,7 @@ class RowReaderOptions {
   bool eagerFirstStripeLoad = true;
   uint64_t skipRows_ = 0;
   std::shared_ptr<UnitLoaderFactory> unitLoaderFactory_;
+  bool collectColumnStats_ = false;
 
  public:
   RowReaderOptions() noexcept
@@ -396,6 +397,16 @@ class RowReaderOptions {
     return unitLoaderFactory_;
   }
 
+  // Request that the time and bytes of reading each top level column are
+  // reported in RuntimeStatistics.
+  void setCollectColumnStats(bool value) {
+    collectColumnStats_ = value;
+  }
+
+  bool collectColumnStats() const {
+    return collectColumnStats_;
+  }
+
   const std::shared_ptr<folly::Executor>& getDecodingExecutor() const {
     return decodingExecutor_;
   }
@@ -605,6 +616,9 @@ struct WriterOptions {
   std::optional<uint64_t> maxDictionaryMemory{std::nullopt};
   std::map<std::string, std::string> serdeParameters;
   std::optional<uint8_t> parquetWriteTimestampUnit;
+  std::optional<bool> parquetWritePageIndex;
+  std::vector<std::string> parquetBloomFilterColumns;
+  std::optional<double> parquetBloomFilterFpp;
 };
 
 } // namespace facebook::velox::dwio::common
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/dwio/common/ParallelUnitLoader.h"
+
+#include <algorithm>
+
+#include <folly/futures/Future.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/UnitLoaderTools.h"
+
+using facebook::velox::dwio::common::unit_loader_tools::measureBlockedOnIo;
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+class ParallelUnitLoader : public UnitLoader {
+ public:
+  ParallelUnitLoader(
+      std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+      folly::Executor* executor,
+      uint32_t maxConcurrentLoads,
+      std::function<void(uint64_t)> blockedOnIoMsCallback)
+      : loadUnits_{std::move(loadUnits)},
+        executor_{executor},
+        maxConcurrentLoads_{maxConcurrentLoads},
+        blockedOnIoMsCallback_{std::move(blockedOnIoMsCallback)},
+        loads_(loadUnits_.size()),
+        loaded_(loadUnits_.size(), false) {
+    for (auto& load : loads_) {
+      load = folly::Future<folly::Unit>::makeEmpty();
+    }
+  }
+
+  ~ParallelUnitLoader() override {
+    // The pending loads reference 'loadUnits_'.
+    for (auto& load : loads_) {
+      if (load.valid()) {
+        load.wait();
+      }
+    }
+  }
+
+  LoadUnit& getLoadedUnit(uint32_t unit) override {
+    VELOX_CHECK(unit < loadUnits_.size(), "Unit out of range");
+
+    scheduleLoads(unit);
+    if (!loaded_[unit]) {
+      auto measure = measureBlockedOnIo(blockedOnIoMsCallback_);
+      // Rethrows the error of a failed load.
+      std::move(loads_[unit]).get();
+      loaded_[unit] = true;
+    }
+
+    // The units before 'unit' are done being read.
+    for (uint32_t i = 0; i < unit; ++i) {
+      if (loaded_[i]) {
+        loadUnits_[i]->unload();
+        loaded_[i] = false;
+      }
+    }
+    return *loadUnits_[unit];
+  }
+
+  void onRead(
+      uint32_t /* unit */,
+      uint64_t /* rowOffsetInUnit */,
+      uint64_t /* rowCount */) override {}
+
+ private:
+  // Starts the loads of the units from 'unit' to 'unit' +
+  // 'maxConcurrentLoads_' that are neither loaded nor being loaded.
+  void scheduleLoads(uint32_t unit) {
+    const auto end = std::min<size_t>(
+        loadUnits_.size(), static_cast<size_t>(unit) + maxConcurrentLoads_);
+    for (auto i = unit; i < end; ++i) {
+      if (loaded_[i] || loads_[i].valid()) {
+        continue;
+      }
+      auto* loadUnit = loadUnits_[i].get();
+      loads_[i] = folly::via(executor_, [loadUnit]() { loadUnit->load(); });
+    }
+  }
+
+  std::vector<std::unique_ptr<LoadUnit>> loadUnits_;
+  folly::Executor* const executor_;
+  const uint32_t maxConcurrentLoads_;
+  std::function<void(uint64_t)> blockedOnIoMsCallback_;
+  // The pending load of each unit. Empty if the unit is not being loaded.
+  std::vector<folly::Future<folly::Unit>> loads_;
+  // True for the units that are loaded and not unloaded since.
+  std::vector<bool> loaded_;
+};
+
+} // namespace
+
+ParallelUnitLoaderFactory::ParallelUnitLoaderFactory(
+    folly::Executor* executor,
+    uint32_t maxConcurrentLoads,
+    std::function<void(uint64_t)> blockedOnIoMsCallback)
+    : executor_{executor},
+      maxConcurrentLoads_{maxConcurrentLoads},
+      blockedOnIoMsCallback_{std::move(blockedOnIoMsCallback)} {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GT(maxConcurrentLoads_, 0);
+}
+
+std::unique_ptr<UnitLoader> ParallelUnitLoaderFactory::create(
+    std::vector<std::unique_ptr<LoadUnit>> loadUnits) {
+  return std::make_unique<ParallelUnitLoader>(
+      std::move(loadUnits),
+      executor_,
+      maxConcurrentLoads_,
+      blockedOnIoMsCallback_);
+}
+
+} // namespace facebook::velox::dwio::common
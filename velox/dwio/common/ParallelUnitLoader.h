@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <functional>
+
+#include <folly/Executor.h>
+
+#include "velox/dwio/common/UnitLoader.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Creates unit loaders that load up to 'maxConcurrentLoads' units starting at
+/// the requested one concurrently on 'executor'. The units are still handed
+/// out in the order requested, so a reader reading the units one after the
+/// other finds the next ones already loaded. At most 'maxConcurrentLoads'
+/// units ahead of the current one are loaded at any time, which bounds the
+/// memory held by the loaded units.
+class ParallelUnitLoaderFactory
+    : public velox::dwio::common::UnitLoaderFactory {
+ public:
+  ParallelUnitLoaderFactory(
+      folly::Executor* executor,
+      uint32_t maxConcurrentLoads,
+      std::function<void(uint64_t)> blockedOnIoMsCallback);
+
+  ~ParallelUnitLoaderFactory() override = default;
+
+  std::unique_ptr<velox::dwio::common::UnitLoader> create(
+      std::vector<std::unique_ptr<velox::dwio::common::LoadUnit>> loadUnits)
+      override;
+
+ private:
+  folly::Executor* const executor_;
+  const uint32_t maxConcurrentLoads_;
+  std::function<void(uint64_t)> blockedOnIoMsCallback_;
+};
+
+} // namespace facebook::velox::dwio::common
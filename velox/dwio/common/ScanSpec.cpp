@@ -43,12 +43,13 @@ uint64_t ScanSpec::newRead() {
   if (!numReads_) {
     reorder();
   } else if (enableFilterReorder_) {
+    const auto prior = priorTimeToDropValue();
     for (auto i = 1; i < children_.size(); ++i) {
       if (!children_[i]->filter_) {
         break;
       }
-      if (children_[i - 1]->selectivity_.timeToDropValue() >
-          children_[i]->selectivity_.timeToDropValue()) {
+      if (children_[i - 1]->timeToDropValue(prior) >
+          children_[i]->timeToDropValue(prior)) {
         reorder();
         break;
       }
@@ -57,23 +58,51 @@ uint64_t ScanSpec::newRead() {
   return numReads_++;
 }
 
+float ScanSpec::priorTimeToDropValue() const {
+  uint64_t numIn = 0;
+  uint64_t timeClocks = 0;
+  for (const auto& child : children_) {
+    if (child->filter_ && child->selectivity_.numIn()) {
+      numIn += child->selectivity_.numIn();
+      timeClocks += child->selectivity_.timeClocks();
+    }
+  }
+  if (!numIn) {
+    return 0;
+  }
+  // A filter without history is assumed to cost as much per value as the
+  // measured filters and to drop half of its input.
+  return 2 * timeClocks / static_cast<float>(numIn);
+}
+
+float ScanSpec::timeToDropValue(float prior) const {
+  return selectivity_.numIn() ? selectivity_.timeToDropValue() : prior;
+}
+
 void ScanSpec::reorder() {
   if (children_.empty()) {
     return;
   }
   // Make sure 'stableChildren_' is initialized.
   stableChildren();
+  // Filters added after the scan has started, e.g. dynamic filters from a
+  // join, have no history. They are ranked with a prior derived from the
+  // filters that have one.
+  const auto prior = priorTimeToDropValue();
   std::sort(
       children_.begin(),
       children_.end(),
-      [this](
+      [this, prior](
           const std::shared_ptr<ScanSpec>& left,
           const std::shared_ptr<ScanSpec>& right) {
         if (left->hasFilter() && right->hasFilter()) {
           if (enableFilterReorder_ &&
               (left->selectivity_.numIn() || right->selectivity_.numIn())) {
-            return left->selectivity_.timeToDropValue() <
-                right->selectivity_.timeToDropValue();
+            const auto leftTime = left->timeToDropValue(prior);
+            const auto rightTime = right->timeToDropValue(prior);
+            if (leftTime != rightTime) {
+              return leftTime < rightTime;
+            }
           }
           // Integer filters are before other filters if there is no
           // history data.
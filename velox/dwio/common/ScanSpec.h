@@ -325,6 +325,15 @@ class ScanSpec {
  private:
   void reorder();
 
+  // Returns the time to drop a value assumed for a child filter without
+  // history. This is derived from the measured cost per value of the child
+  // filters with history. Returns 0 if no child filter has history.
+  float priorTimeToDropValue() const;
+
+  // Returns the measured time to drop a value of the filter of 'this' or
+  // 'prior' if the filter has no history.
+  float timeToDropValue(float prior) const;
+
   // Serializes stableChildren().
   std::mutex mutex_;
 
@@ -22,6 +22,11 @@
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/wrap/zero-copy-stream-wrapper.h"
 
+namespace facebook::velox::cache {
+class AsyncDataCache;
+struct RawFileCacheKey;
+} // namespace facebook::velox::cache
+
 namespace facebook::velox::dwio::common {
 
 void printBuffer(std::ostream& out, const char* buffer, uint64_t length);
@@ -63,6 +68,16 @@ class SeekableInputStream : public google::protobuf::io::ZeroCopyInputStream {
     return SkipInt64(count);
   }
 
+  /// Returns the cache 'this' reads through and sets 'key' to the cache key
+  /// of the byte at 'position' of 'this' in the file. Returns nullptr if
+  /// 'this' does not read through AsyncDataCache. Used for caching data
+  /// derived from the stream, e.g. decompressed pages.
+  virtual cache::AsyncDataCache* cacheKey(
+      uint64_t /*position*/,
+      cache::RawFileCacheKey& /*key*/) const {
+    return nullptr;
+  }
+
   void readFully(char* buffer, size_t bufferSize);
 };
 
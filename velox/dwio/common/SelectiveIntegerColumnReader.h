@@ -169,6 +169,14 @@ void SelectiveIntegerColumnReader::processFilter(
           velox::common::NegatedBigintValuesUsingBitmask,
           isDense>(filter, rows, extractValues);
       break;
+    case velox::common::FilterKind::kBigintValuesUsingBloomFilter:
+      readHelper<Reader, velox::common::BigintValuesUsingBloomFilter, isDense>(
+          filter, rows, extractValues);
+      break;
+    case velox::common::FilterKind::kBigintMultiRange:
+      readHelper<Reader, velox::common::BigintMultiRange, isDense>(
+          filter, rows, extractValues);
+      break;
     default:
       readHelper<Reader, velox::common::Filter, isDense>(
           filter, rows, extractValues);
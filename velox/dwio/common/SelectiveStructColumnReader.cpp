@@ -17,6 +17,7 @@
 #include "velox/dwio/common/SelectiveStructColumnReader.h"
 
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/ColumnLoader.h"
 
 namespace facebook::velox::dwio::common {
@@ -172,6 +173,10 @@ void SelectiveStructColumnReaderBase::read(
       continue;
     }
     advanceFieldReader(reader, offset);
+    std::optional<MicrosecondTimer> readTimer;
+    if (auto* stats = childReadStatistics(*childSpec)) {
+      readTimer.emplace(&stats->readMicros);
+    }
     if (childSpec->hasFilter()) {
       {
         SelectivityTimer timer(childSpec->selectivity(), activeRows.size());
@@ -384,7 +389,17 @@ void SelectiveStructColumnReaderBase::getValues(
     }
     if (childSpec->extractValues() || childSpec->hasFilter() ||
         !children_[index]->isTopLevel()) {
-      children_[index]->getValues(rows, &childResult);
+      auto* stats = childReadStatistics(*childSpec);
+      {
+        std::optional<MicrosecondTimer> getValuesTimer;
+        if (stats) {
+          getValuesTimer.emplace(&stats->getValuesMicros);
+        }
+        children_[index]->getValues(rows, &childResult);
+      }
+      if (stats) {
+        stats->outputBytes += childResult->estimateFlatSize();
+      }
       continue;
     }
     // LazyVector result.
@@ -50,6 +50,31 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     return lazyVectorReadOffset_;
   }
 
+  /// Returns the estimated flat size in bytes of the values loaded into the
+  /// LazyVectors made by 'this' so far.
+  uint64_t lazyLoadedBytes() const {
+    return lazyLoadedBytes_;
+  }
+
+  void addLazyLoadedBytes(uint64_t bytes) {
+    lazyLoadedBytes_ += bytes;
+  }
+
+  /// Makes 'this' record the time and bytes of reading each of its children
+  /// in 'stats'. Used on the root reader to collect per column statistics.
+  void setColumnReadStatistics(ColumnReaderStatistics* stats) {
+    columnReadStats_ = stats;
+  }
+
+  /// Returns the statistics to record reading the child for 'childSpec' in,
+  /// or nullptr if these are not collected.
+  ColumnReadStatistics* childReadStatistics(
+      const velox::common::ScanSpec& childSpec) {
+    return columnReadStats_
+        ? &columnReadStats_->columnStats[childSpec.fieldName()]
+        : nullptr;
+  }
+
   /// Advance field reader to the row group closest to specified offset by
   /// calling seekToRowGroup.
   virtual void advanceFieldReader(
@@ -136,6 +161,13 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
 
   vector_size_t lazyVectorReadOffset_;
 
+  // Sum of the estimated flat sizes of the loaded LazyVectors.
+  uint64_t lazyLoadedBytes_{0};
+
+  // Per column statistics of reading the children. Not owned. nullptr if not
+  // collected.
+  ColumnReaderStatistics* columnReadStats_{nullptr};
+
   // Dense set of rows to read in next().
   raw_vector<vector_size_t> rows_;
 
@@ -519,10 +519,44 @@ class Statistics {
   virtual uint32_t getNumberOfColumns() const = 0;
 };
 
+/// Time and bytes spent reading one top level column. The streams of a
+/// column are decompressed and, if not prefetched, read from storage when
+/// first accessed, so this time includes decompression and IO waits.
+struct ColumnReadStatistics {
+  // Time in read(), which decodes and filters the values.
+  uint64_t readMicros{0};
+
+  // Time in getValues(), which copies the decoded values into the result.
+  uint64_t getValuesMicros{0};
+
+  // Estimated flat size of the values returned for the column.
+  uint64_t outputBytes{0};
+
+  void merge(const ColumnReadStatistics& other) {
+    readMicros += other.readMicros;
+    getValuesMicros += other.getValuesMicros;
+    outputBytes += other.outputBytes;
+  }
+};
+
 struct ColumnReaderStatistics {
   // Number of rows returned by string dictionary reader that is flattened
   // instead of keeping dictionary encoding.
   int64_t flattenStringDictionaryValues{0};
+
+  // Number of data pages skipped because the page index shows that no value
+  // on the page can pass the filter.
+  int64_t pagesSkippedByIndex{0};
+
+  // Read statistics of each top level column, keyed by column name. Only
+  // collected if RowReaderOptions::collectColumnStats() is set.
+  std::unordered_map<std::string, ColumnReadStatistics> columnStats;
+
+  void mergeColumnStats(const ColumnReaderStatistics& other) {
+    for (const auto& [name, stats] : other.columnStats) {
+      columnStats[name].merge(stats);
+    }
+  }
 };
 
 struct RuntimeStatistics {
@@ -535,16 +569,38 @@ struct RuntimeStatistics {
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides{0};
 
+  // Number of splits read with the file reader of the previous split of the
+  // same file.
+  int64_t reusedFileReaders{0};
+
   ColumnReaderStatistics columnReaderStatistics;
 
   std::unordered_map<std::string, RuntimeCounter> toMap() {
-    return {
+    std::unordered_map<std::string, RuntimeCounter> result{
         {"skippedSplits", RuntimeCounter(skippedSplits)},
         {"skippedSplitBytes",
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
         {"skippedStrides", RuntimeCounter(skippedStrides)},
+        {"reusedFileReaders", RuntimeCounter(reusedFileReaders)},
         {"flattenStringDictionaryValues",
-         RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)}};
+         RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)},
+        {"pagesSkippedByIndex",
+         RuntimeCounter(columnReaderStatistics.pagesSkippedByIndex)}};
+    for (const auto& [name, stats] : columnReaderStatistics.columnStats) {
+      const auto prefix = "column." + name;
+      result.emplace(
+          prefix + ".readNanos",
+          RuntimeCounter(
+              stats.readMicros * 1'000, RuntimeCounter::Unit::kNanos));
+      result.emplace(
+          prefix + ".getValuesNanos",
+          RuntimeCounter(
+              stats.getValuesMicros * 1'000, RuntimeCounter::Unit::kNanos));
+      result.emplace(
+          prefix + ".outputBytes",
+          RuntimeCounter(stats.outputBytes, RuntimeCounter::Unit::kBytes));
+    }
+    return result;
   }
 };
 
@@ -35,6 +35,23 @@ using memory::MemoryPool;
 
 namespace {
 
+// ZSTD_compress() and ZSTD_decompress() create and free a context on every
+// call, which costs more than compressing or decompressing a small page. The
+// contexts below are reused by all the streams of a thread.
+ZSTD_CCtx* threadZstdCompressContext() {
+  thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{
+      ZSTD_createCCtx(), &ZSTD_freeCCtx};
+  DWIO_ENSURE_NOT_NULL(context, "Failed to create ZSTD compression context");
+  return context.get();
+}
+
+ZSTD_DCtx* threadZstdDecompressContext() {
+  thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{
+      ZSTD_createDCtx(), &ZSTD_freeDCtx};
+  DWIO_ENSURE_NOT_NULL(context, "Failed to create ZSTD decompression context");
+  return context.get();
+}
+
 class ZstdCompressor : public Compressor {
  public:
   explicit ZstdCompressor(int32_t level) : Compressor{level} {}
@@ -44,7 +61,8 @@ class ZstdCompressor : public Compressor {
 
 uint64_t
 ZstdCompressor::compress(const void* src, void* dest, uint64_t length) {
-  auto ret = ZSTD_compress(dest, length, src, length, level_);
+  auto ret = ZSTD_compressCCtx(
+      threadZstdCompressContext(), dest, length, src, length, level_);
   if (ZSTD_isError(ret)) {
     // it's fine to hit dest size too small
     if (ZSTD_getErrorCode(ret) == ZSTD_ErrorCode::ZSTD_error_dstSize_tooSmall) {
@@ -391,9 +409,10 @@ uint64_t Lz4Decompressor::decompressInternal(
   return static_cast<uint64_t>(result);
 }
 
-// NOTE: We do not keep `ZSTD_DCtx' around on purpose, because if we keep it
-// around, in flat map column reader we have hundreds of thousands of
-// decompressors at same time and causing OOM.
+// NOTE: We do not keep a `ZSTD_DCtx' per decompressor on purpose, because in
+// flat map column reader we have hundreds of thousands of decompressors at
+// same time and that causes OOM. The decompressors of a thread share one
+// context instead.
 class ZstdDecompressor : public Decompressor {
  public:
   explicit ZstdDecompressor(
@@ -417,7 +436,8 @@ uint64_t ZstdDecompressor::decompress(
     uint64_t srcLength,
     char* dest,
     uint64_t destLength) {
-  auto ret = ZSTD_decompress(dest, destLength, src, srcLength);
+  auto ret = ZSTD_decompressDCtx(
+      threadZstdDecompressContext(), dest, destLength, src, srcLength);
   DWIO_ENSURE(
       !ZSTD_isError(ret),
       "ZSTD returned an error: ",
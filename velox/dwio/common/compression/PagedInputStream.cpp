@@ -16,6 +16,19 @@
 
 #include "velox/dwio/common/compression/PagedInputStream.h"
 
+DEFINE_bool(
+    velox_cache_decompressed_pages,
+    false,
+    "Keep the decompressed pages of files read through AsyncDataCache in the "
+    "cache, so that repeat reads do not decompress them again");
+
+DEFINE_int32(
+    velox_cache_decompressed_page_eviction_weight,
+    2,
+    "Multiplier of the eviction score of cached decompressed pages. These "
+    "take more memory than the compressed data, so a weight over 1 evicts "
+    "them first");
+
 namespace facebook::velox::dwio::common::compression {
 
 void PagedInputStream::prepareOutputBuffer(uint64_t uncompressedLength) {
@@ -25,6 +38,101 @@ void PagedInputStream::prepareOutputBuffer(uint64_t uncompressedLength) {
   }
 }
 
+const char* PagedInputStream::decompressToBuffer(
+    const char* input,
+    uint64_t decompressedLength) {
+  prepareOutputBuffer(decompressedLength);
+  outputBufferLength_ = decompressor_->decompress(
+      input,
+      remainingLength_,
+      outputBuffer_->data(),
+      outputBuffer_->capacity());
+  return outputBuffer_->data();
+}
+
+void PagedInputStream::initPageCache() {
+  // Decrypted data is not cached.
+  if (FLAGS_velox_cache_decompressed_pages && decompressor_ && !decrypter_) {
+    pageCache_ = input_->cacheKey(0, pageCacheKey_);
+  }
+}
+
+namespace {
+// Calls 'func' with the address and size of each part of the data of 'entry'.
+template <typename Func>
+void forEachRange(cache::AsyncDataCacheEntry& entry, Func func) {
+  if (entry.tinyData()) {
+    func(entry.tinyData(), entry.size());
+    return;
+  }
+  auto& allocation = entry.data();
+  uint64_t offset = 0;
+  for (int32_t i = 0; i < allocation.numRuns() && offset < entry.size(); ++i) {
+    auto run = allocation.runAt(i);
+    const auto bytes = std::min<uint64_t>(
+        run.numPages() * memory::AllocationTraits::kPageSize,
+        entry.size() - offset);
+    func(run.data<char>(), bytes);
+    offset += bytes;
+  }
+}
+} // namespace
+
+const char* PagedInputStream::cachedPage(
+    const char* input,
+    uint64_t decompressedLength) {
+  const cache::RawFileCacheKey key{
+      pageCacheKey_.fileNum,
+      kDecompressedPageOffset | (pageCacheKey_.offset + lastHeaderOffset_)};
+  cache::CachePin pin;
+  try {
+    pin = pageCache_->findOrCreate(key, decompressedLength);
+  } catch (const VeloxRuntimeError& e) {
+    if (e.errorCode() != error_code::kNoCacheSpace) {
+      throw;
+    }
+    return nullptr;
+  }
+  if (pin.empty()) {
+    // Another stream is decompressing the same page.
+    return nullptr;
+  }
+  auto* entry = pin.checkedEntry();
+  if (entry->isExclusive()) {
+    const char* output = decompressToBuffer(input, decompressedLength);
+    if (outputBufferLength_ != entry->size()) {
+      // Dropping the exclusive pin removes the entry.
+      return output;
+    }
+    uint64_t offset = 0;
+    forEachRange(*entry, [&](char* range, uint64_t size) {
+      ::memcpy(range, output + offset, size);
+      offset += size;
+    });
+    entry->setDerived(FLAGS_velox_cache_decompressed_page_eviction_weight);
+    entry->setExclusiveToShared();
+    return output;
+  }
+
+  outputBufferLength_ = entry->size();
+  if (entry->tinyData()) {
+    pagePin_ = std::move(pin);
+    return entry->tinyData();
+  }
+  if (entry->data().numRuns() == 1) {
+    pagePin_ = std::move(pin);
+    return entry->data().runAt(0).data<char>();
+  }
+  // A page in several runs is copied to be returned as one window.
+  prepareOutputBuffer(entry->size());
+  uint64_t offset = 0;
+  forEachRange(*entry, [&](char* range, uint64_t size) {
+    ::memcpy(outputBuffer_->data() + offset, range, size);
+    offset += size;
+  });
+  return outputBuffer_->data();
+}
+
 void PagedInputStream::readBuffer(bool failOnEof) {
   int32_t length;
   if (!input_->Next(
@@ -181,21 +289,22 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
     DWIO_ENSURE_NOT_NULL(input);
     auto [decompressedLength, exact] =
         decompressor_->getDecompressedLength(input, remainingLength_);
+    pagePin_.clear();
     if (!data && exact && decompressedLength <= pendingSkip_) {
       *size = decompressedLength;
       outputBufferPtr_ = nullptr;
     } else {
-      prepareOutputBuffer(decompressedLength);
-      outputBufferLength_ = decompressor_->decompress(
-          input,
-          remainingLength_,
-          outputBuffer_->data(),
-          outputBuffer_->capacity());
+      // The cache needs the exact size of the page up front.
+      const char* output =
+          pageCache_ && exact ? cachedPage(input, decompressedLength) : nullptr;
+      if (output == nullptr) {
+        output = decompressToBuffer(input, decompressedLength);
+      }
       if (data) {
-        *data = outputBuffer_->data();
+        *data = output;
       }
       *size = static_cast<int32_t>(outputBufferLength_);
-      outputBufferPtr_ = outputBuffer_->data() + outputBufferLength_;
+      outputBufferPtr_ = output + outputBufferLength_;
     }
     // release decryption buffer
     decryptionBuffer_ = nullptr;
@@ -266,6 +375,7 @@ bool PagedInputStream::SkipInt64(int64_t count) {
 }
 
 void PagedInputStream::clearDecompressionState() {
+  pagePin_.clear();
   state_ = State::HEADER;
   outputBufferLength_ = 0;
   remainingLength_ = 0;
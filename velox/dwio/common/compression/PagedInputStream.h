@@ -16,9 +16,13 @@
 
 #pragma once
 
+#include "velox/common/caching/AsyncDataCache.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
 
+DECLARE_bool(velox_cache_decompressed_pages);
+DECLARE_int32(velox_cache_decompressed_page_eviction_weight);
+
 namespace facebook::velox::dwio::common::compression {
 
 class PagedInputStream : public dwio::common::SeekableInputStream {
@@ -48,6 +52,7 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
       state_ = State::START;
       remainingLength_ = compressedLength;
     }
+    initPageCache();
   }
 
   bool Next(const void** data, int32_t* size) override;
@@ -106,6 +111,12 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
 
   void prepareOutputBuffer(uint64_t uncompressedLength);
 
+  // Decompresses the chunk at 'input' into 'outputBuffer_'. Sets
+  // 'outputBufferLength_' and returns the start of the decompressed data.
+  const char* decompressToBuffer(
+      const char* input,
+      uint64_t decompressedLength);
+
   void readBuffer(bool failOnEof);
 
   uint32_t readByte(bool failOnEof);
@@ -178,8 +189,31 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
   int64_t pendingSkip_{0};
 
  private:
+  // Offsets of decompressed pages in the cache have this bit set so that
+  // they do not collide with the keys of the file data.
+  static constexpr uint64_t kDecompressedPageOffset = 1ULL << 62;
+
   bool skipAllPending();
 
+  // Sets 'pageCache_' if the decompressed pages are to be cached.
+  void initPageCache();
+
+  // Returns the decompressed page for the chunk at 'input' from
+  // 'pageCache_'. If the page is not cached, decompresses the chunk and adds
+  // the page to the cache. Sets 'outputBufferLength_'. The returned data is
+  // either in 'outputBuffer_' or pinned by 'pagePin_'. Returns nullptr if the
+  // cache cannot be used for the chunk.
+  const char* cachedPage(const char* input, uint64_t decompressedLength);
+
+  // Cache for the decompressed pages. nullptr if these are not cached.
+  cache::AsyncDataCache* pageCache_{nullptr};
+
+  // Cache key of the start of 'input_' in the file.
+  cache::RawFileCacheKey pageCacheKey_{0, 0};
+
+  // Pins the cached page the last output of Next() points to.
+  cache::CachePin pagePin_;
+
   // Stream Debug Info
   const std::string streamDebugInfo_;
 };
@@ -458,14 +458,26 @@ BENCHMARK_UNPACK_FULLROWS_CASE_32(8)
 BENCHMARK_UNPACK_FULLROWS_CASE_32(9)
 BENCHMARK_UNPACK_FULLROWS_CASE_32(10)
 BENCHMARK_UNPACK_FULLROWS_CASE_32(11)
+BENCHMARK_UNPACK_FULLROWS_CASE_32(12)
 BENCHMARK_UNPACK_FULLROWS_CASE_32(13)
+BENCHMARK_UNPACK_FULLROWS_CASE_32(14)
 BENCHMARK_UNPACK_FULLROWS_CASE_32(15)
+BENCHMARK_UNPACK_FULLROWS_CASE_32(16)
 BENCHMARK_UNPACK_FULLROWS_CASE_32(17)
+BENCHMARK_UNPACK_FULLROWS_CASE_32(18)
 BENCHMARK_UNPACK_FULLROWS_CASE_32(19)
+BENCHMARK_UNPACK_FULLROWS_CASE_32(20)
 BENCHMARK_UNPACK_FULLROWS_CASE_32(21)
+BENCHMARK_UNPACK_FULLROWS_CASE_32(22)
+BENCHMARK_UNPACK_FULLROWS_CASE_32(23)
 BENCHMARK_UNPACK_FULLROWS_CASE_32(24)
+BENCHMARK_UNPACK_FULLROWS_CASE_32(25)
+BENCHMARK_UNPACK_FULLROWS_CASE_32(26)
+BENCHMARK_UNPACK_FULLROWS_CASE_32(27)
 BENCHMARK_UNPACK_FULLROWS_CASE_32(28)
+BENCHMARK_UNPACK_FULLROWS_CASE_32(29)
 BENCHMARK_UNPACK_FULLROWS_CASE_32(30)
+BENCHMARK_UNPACK_FULLROWS_CASE_32(31)
 BENCHMARK_UNPACK_FULLROWS_CASE_32(32)
 
 BENCHMARK_DRAW_LINE();
@@ -490,14 +502,36 @@ BENCHMARK_DRAW_LINE();
 
 BENCHMARK_UNPACK_ODDROWS_CASE_32(1)
 BENCHMARK_UNPACK_ODDROWS_CASE_32(2)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(3)
 BENCHMARK_UNPACK_ODDROWS_CASE_32(4)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(5)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(6)
 BENCHMARK_UNPACK_ODDROWS_CASE_32(7)
 BENCHMARK_UNPACK_ODDROWS_CASE_32(8)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(9)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(10)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(11)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(12)
 BENCHMARK_UNPACK_ODDROWS_CASE_32(13)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(14)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(15)
 BENCHMARK_UNPACK_ODDROWS_CASE_32(16)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(17)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(18)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(19)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(20)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(21)
 BENCHMARK_UNPACK_ODDROWS_CASE_32(22)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(23)
 BENCHMARK_UNPACK_ODDROWS_CASE_32(24)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(25)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(26)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(27)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(28)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(29)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(30)
 BENCHMARK_UNPACK_ODDROWS_CASE_32(31)
+BENCHMARK_UNPACK_ODDROWS_CASE_32(32)
 
 void populateBitPacked() {
   bitPackedData.resize(33);
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwio::common;
+
+TEST(FileMetadataCacheTest, getAndPut) {
+  FileMetadataCache cache(100);
+  const FileMetadataCache::Key key{1, 1'000, FileFormat::DWRF};
+  EXPECT_EQ(nullptr, cache.get<int64_t>(key));
+  cache.put(key, std::make_shared<int64_t>(11), 40);
+  EXPECT_EQ(11, *cache.get<int64_t>(key));
+
+  // A different size or format of the same file is a miss.
+  EXPECT_EQ(nullptr, cache.get<int64_t>({1, 2'000, FileFormat::DWRF}));
+  EXPECT_EQ(nullptr, cache.get<int64_t>({1, 1'000, FileFormat::PARQUET}));
+
+  // Replacing an entry does not count its old size.
+  cache.put(key, std::make_shared<int64_t>(12), 50);
+  EXPECT_EQ(12, *cache.get<int64_t>(key));
+  auto stats = cache.stats();
+  EXPECT_EQ(1, stats.numEntries);
+  EXPECT_EQ(50, stats.bytes);
+  EXPECT_EQ(5, stats.numLookups);
+  EXPECT_EQ(2, stats.numHits);
+
+  // Metadata larger than the capacity is not cached.
+  cache.put({2, 1'000, FileFormat::DWRF}, std::make_shared<int64_t>(2), 101);
+  EXPECT_EQ(nullptr, cache.get<int64_t>({2, 1'000, FileFormat::DWRF}));
+}
+
+TEST(FileMetadataCacheTest, evict) {
+  FileMetadataCache cache(100);
+  for (uint64_t i = 0; i < 4; ++i) {
+    cache.put({i, 1'000, FileFormat::DWRF}, std::make_shared<int64_t>(i), 30);
+    // Keeps the first entry the most recently used.
+    EXPECT_EQ(0, *cache.get<int64_t>({0, 1'000, FileFormat::DWRF}));
+  }
+  EXPECT_EQ(nullptr, cache.get<int64_t>({1, 1'000, FileFormat::DWRF}));
+  EXPECT_EQ(2, *cache.get<int64_t>({2, 1'000, FileFormat::DWRF}));
+  EXPECT_EQ(3, *cache.get<int64_t>({3, 1'000, FileFormat::DWRF}));
+  auto stats = cache.stats();
+  EXPECT_EQ(3, stats.numEntries);
+  EXPECT_EQ(90, stats.bytes);
+  EXPECT_EQ(1, stats.numEvictions);
+
+  // Metadata got from the cache outlives its entry.
+  auto metadata = cache.get<int64_t>({2, 1'000, FileFormat::DWRF});
+  cache.clear();
+  EXPECT_EQ(0, cache.stats().numEntries);
+  EXPECT_EQ(2, *metadata);
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <cstring>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::dwrf {
+
+namespace {
+// Constants of the 64-bit Murmur3 variant used by ORC writers.
+constexpr uint64_t kMurmurC1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t kMurmurC2 = 0x4cf5ad432745937fULL;
+constexpr uint64_t kMurmurM = 5;
+constexpr uint64_t kMurmurN1 = 0x52dce729;
+constexpr uint64_t kMurmurSeed = 104729;
+
+inline uint64_t loadWord(const void* data) {
+  uint64_t word;
+  memcpy(&word, data, sizeof(word));
+  return word;
+}
+
+inline uint64_t rotateLeft(uint64_t value, int32_t shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+inline uint64_t mixBlock(uint64_t k) {
+  k *= kMurmurC1;
+  k = rotateLeft(k, 31);
+  return k * kMurmurC2;
+}
+
+inline uint64_t finalMix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+} // namespace
+
+BloomFilter::BloomFilter(const proto::BloomFilter& proto)
+    : numHashFunctions_(proto.numhashfunctions()) {
+  if (proto.has_utf8bitset()) {
+    const auto& bytes = proto.utf8bitset();
+    bitset_.resize(bytes.size() / sizeof(uint64_t));
+    for (auto i = 0; i < bitset_.size(); ++i) {
+      bitset_[i] = loadWord(bytes.data() + i * sizeof(uint64_t));
+    }
+  } else {
+    bitset_.assign(proto.bitset().begin(), proto.bitset().end());
+  }
+}
+
+BloomFilter::BloomFilter(int64_t numBits, int32_t numHashFunctions)
+    : bitset_(bits::nwords(numBits)), numHashFunctions_(numHashFunctions) {}
+
+void BloomFilter::addHash(uint64_t hash) {
+  if (bitset_.empty()) {
+    return;
+  }
+  forEachPosition(hash, [&](int64_t position) {
+    bits::setBit(bitset_.data(), position);
+    return true;
+  });
+}
+
+bool BloomFilter::testHash(uint64_t hash) const {
+  if (bitset_.empty() || numHashFunctions_ <= 0) {
+    return true;
+  }
+  return forEachPosition(hash, [&](int64_t position) {
+    return bits::isBitSet(bitset_.data(), position);
+  });
+}
+
+void BloomFilter::serialize(proto::BloomFilter& proto) const {
+  proto.set_numhashfunctions(numHashFunctions_);
+  proto.set_utf8bitset(
+      reinterpret_cast<const char*>(bitset_.data()),
+      bitset_.size() * sizeof(uint64_t));
+}
+
+// static
+uint64_t BloomFilter::hash(int64_t value) {
+  auto key = static_cast<uint64_t>(value);
+  key = ~key + (key << 21);
+  key ^= key >> 24;
+  key = (key + (key << 3)) + (key << 8);
+  key ^= key >> 14;
+  key = (key + (key << 2)) + (key << 4);
+  key ^= key >> 28;
+  key += key << 31;
+  return key;
+}
+
+// static
+uint64_t BloomFilter::hash(std::string_view value) {
+  const auto* data = reinterpret_cast<const uint8_t*>(value.data());
+  const auto length = value.size();
+  uint64_t h = kMurmurSeed;
+  const auto numBlocks = length / 8;
+  for (auto i = 0; i < numBlocks; ++i) {
+    h ^= mixBlock(loadWord(data + i * sizeof(uint64_t)));
+    h = rotateLeft(h, 27) * kMurmurM + kMurmurN1;
+  }
+  const auto* tail = data + numBlocks * 8;
+  const auto tailSize = length - numBlocks * 8;
+  if (tailSize > 0) {
+    uint64_t k = 0;
+    for (int32_t i = tailSize - 1; i >= 0; --i) {
+      k ^= static_cast<uint64_t>(tail[i]) << (i * 8);
+    }
+    h ^= mixBlock(k);
+  }
+  h ^= length;
+  return finalMix(h);
+}
+
+} // namespace facebook::velox::dwrf
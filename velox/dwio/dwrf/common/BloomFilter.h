@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+
+namespace facebook::velox::dwrf {
+
+/// Bloom filter of one row group as found in the BLOOM_FILTER_UTF8 index
+/// stream. Hashing and bit layout follow the ORC specification: integers are
+/// hashed with Thomas Wang's 64-bit integer hash and strings with 64-bit
+/// Murmur3 of their UTF-8 bytes. The two 32-bit halves of the hash are
+/// combined into 'numHashFunctions' bit positions.
+class BloomFilter {
+ public:
+  /// Reads the filter from 'proto'. Takes the bits from 'utf8bitset' if set and
+  /// from 'bitset' otherwise.
+  explicit BloomFilter(const proto::BloomFilter& proto);
+
+  /// Makes an empty filter of at least 'numBits' for writing.
+  BloomFilter(int64_t numBits, int32_t numHashFunctions);
+
+  void addHash(uint64_t hash);
+
+  /// Writes the filter into 'proto' in the BLOOM_FILTER_UTF8 layout.
+  void serialize(proto::BloomFilter& proto) const;
+
+  /// Returns false if no value with 'hash' was added. False positives are
+  /// possible. Returns true if the filter is empty or malformed.
+  bool testHash(uint64_t hash) const;
+
+  static uint64_t hash(int64_t value);
+
+  static uint64_t hash(std::string_view value);
+
+ private:
+  // Calls 'func' with the bit position of each hash function for 'hash'. Stops
+  // and returns false if 'func' returns false.
+  template <typename Func>
+  bool forEachPosition(uint64_t hash, Func func) const {
+    const int64_t numBits = bitset_.size() * 64;
+    // The writers compute the positions in Java int arithmetic.
+    const auto hash1 = static_cast<uint32_t>(hash);
+    const auto hash2 = static_cast<uint32_t>(hash >> 32);
+    for (int32_t i = 1; i <= numHashFunctions_; ++i) {
+      auto combined =
+          static_cast<int32_t>(hash1 + static_cast<uint32_t>(i) * hash2);
+      if (combined < 0) {
+        combined = ~combined;
+      }
+      if (!func(combined % numBits)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<uint64_t> bitset_;
+  const int32_t numHashFunctions_;
+};
+
+} // namespace facebook::velox::dwrf
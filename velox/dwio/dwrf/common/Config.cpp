@@ -105,6 +105,10 @@ Config::Entry<uint32_t> Config::ENTROPY_STRING_THRESHOLD{
     "hive.exec.orc.entropy.string.threshold",
     20};
 
+Config::Entry<float> Config::DICTIONARY_STRING_SIZE_REDUCTION_THRESHOLD{
+    "hive.exec.orc.dictionary.string.size.reduction.threshold",
+    0.0f};
+
 Config::Entry<uint32_t> Config::STRING_STATS_LIMIT(
     "hive.orc.string.stats.limit",
     64);
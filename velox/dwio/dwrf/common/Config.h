@@ -51,6 +51,7 @@ class Config : public common::ConfigBase<Config> {
   static Entry<uint32_t> ENTROPY_STRING_MIN_SAMPLES;
   static Entry<float> ENTROPY_STRING_DICT_SAMPLE_FRACTION;
   static Entry<uint32_t> ENTROPY_STRING_THRESHOLD;
+  static Entry<float> DICTIONARY_STRING_SIZE_REDUCTION_THRESHOLD;
   static Entry<uint32_t> STRING_STATS_LIMIT;
   static Entry<bool> FLATTEN_MAP;
   static Entry<bool> MAP_FLAT_DISABLE_DICT_ENCODING;
@@ -143,7 +143,8 @@ RleDecoderV2<isSigned>::RleDecoderV2(
       patchMask(0),
       actualGap(0),
       unpacked(pool, 0),
-      unpackedPatch(pool, 0) {
+      unpackedPatch(pool, 0),
+      decoded(pool, 0) {
   // PASS
 }
 
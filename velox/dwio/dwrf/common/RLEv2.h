@@ -19,6 +19,7 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/Adaptor.h"
 #include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/common/DecoderUtil.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -62,6 +63,10 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     skipPending();
+    if (dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+      fastPath<hasNulls>(nulls, visitor);
+      return;
+    }
     int32_t current = visitor.start();
     this->template skip<hasNulls>(current, 0, nulls);
 
@@ -100,6 +105,243 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
  private:
+  // The maximum number of values in a run.
+  static constexpr int32_t kMaxRunLength = 512;
+
+  template <bool hasNulls, typename Visitor>
+  void fastPath(const uint64_t* nulls, Visitor& visitor) {
+    constexpr bool hasFilter =
+        !std::is_same_v<typename Visitor::FilterType, common::AlwaysTrue>;
+    constexpr bool hasHook =
+        !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
+    if (hasNulls) {
+      raw_vector<int32_t>* innerVector = nullptr;
+      auto outerVector = &visitor.outerNonNullRows();
+      if (Visitor::dense) {
+        dwio::common::nonNullRowsFromDense(nulls, numRows, *outerVector);
+        if (outerVector->empty()) {
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            folly::Range<const int32_t*>(rows, outerVector->size()),
+            outerVector->data(),
+            visitor);
+      } else {
+        innerVector = &visitor.innerNonNullRows();
+        int32_t tailSkip = -1;
+        auto anyNulls = dwio::common::
+            nonNullRowsFromSparse<hasFilter, !hasFilter && !hasHook>(
+                nulls,
+                rowsAsRange,
+                *innerVector,
+                *outerVector,
+                (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
+                tailSkip);
+        if (anyNulls) {
+          visitor.setHasNulls();
+        }
+        if (innerVector->empty()) {
+          this->template skip<false>(tailSkip, 0, nullptr);
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkScan<hasFilter, hasHook, true>(
+            *innerVector, outerVector->data(), visitor);
+        this->template skip<false>(tailSkip, 0, nullptr);
+      }
+    } else {
+      bulkScan<hasFilter, hasHook, false>(rowsAsRange, nullptr, visitor);
+    }
+  }
+
+  // Returns 1. how many of 'rows' are in the current run 2. the
+  // distance in rows from the current row to the first row after the
+  // last in rows that falls in the current run.
+  template <bool dense>
+  std::pair<int32_t, std::int32_t> findNumInRun(
+      const int32_t* rows,
+      int32_t rowIndex,
+      int32_t numRows,
+      int32_t currentRow) const {
+    DCHECK_LT(rowIndex, numRows);
+    const int32_t remainingValues = runLength - runRead;
+    if (dense) {
+      auto left = std::min<int32_t>(remainingValues, numRows - rowIndex);
+      return std::make_pair(left, left);
+    }
+    if (rows[rowIndex] - currentRow >= remainingValues) {
+      return std::make_pair(0, 0);
+    }
+    if (rows[numRows - 1] - currentRow < remainingValues) {
+      return std::pair(numRows - rowIndex, rows[numRows - 1] - currentRow + 1);
+    }
+    auto range = folly::Range<const int32_t*>(
+        rows + rowIndex,
+        std::min<int32_t>(remainingValues, numRows - rowIndex));
+    auto endOfRun = currentRow + remainingValues;
+    auto bound = std::lower_bound(range.begin(), range.end(), endOfRun);
+    return std::make_pair(bound - range.begin(), bound[-1] - currentRow + 1);
+  }
+
+  // True if the values of the current run are 'firstValue' plus a fixed
+  // multiple of 'deltaBase'. These runs are given to the visitor as a value
+  // and a delta without decoding.
+  bool isFixedDeltaRun() const {
+    return type == SHORT_REPEAT || (type == DELTA && bitSize == 0);
+  }
+
+  // Reads the header of the next run without decoding any values.
+  void startRun() {
+    resetRun();
+    int64_t dummy;
+    switch (type) {
+      case SHORT_REPEAT:
+        nextShortRepeats(&dummy, 0, 0, nullptr);
+        break;
+      case DIRECT:
+        nextDirect(&dummy, 0, 0, nullptr);
+        break;
+      case PATCHED_BASE:
+        nextPatched(&dummy, 0, 0, nullptr);
+        break;
+      case DELTA:
+        nextDelta(&dummy, 0, 0, nullptr);
+        break;
+      default:
+        DWIO_RAISE("unknown encoding");
+    }
+  }
+
+  // Skips 'numValues' values of the current run.
+  void skipInRun(uint64_t numValues) {
+    DCHECK_LE(numValues, runLength - runRead);
+    if (numValues == 0) {
+      return;
+    }
+    if (type == SHORT_REPEAT) {
+      runRead += numValues;
+    } else if (type == DELTA && bitSize == 0) {
+      runRead += numValues;
+      prevValue = firstValue + (runRead - 1) * deltaBase;
+    } else {
+      doNext(decodedValues(), numValues, nullptr);
+    }
+  }
+
+  int64_t* decodedValues() {
+    if (decoded.size() < kMaxRunLength) {
+      decoded.resize(kMaxRunLength);
+    }
+    return decoded.data();
+  }
+
+  // Decodes the next 'numAdvanced' values of the current run and copies the
+  // values at the 'numInRun' rows starting at rows[rowIndex] to 'output'.
+  template <bool dense, typename T>
+  void decodeRun(
+      const int32_t* rows,
+      int32_t rowIndex,
+      int32_t numInRun,
+      int32_t numAdvanced,
+      int32_t currentRow,
+      T* output) {
+    if constexpr (dense && std::is_same_v<T, int64_t>) {
+      doNext(output, numAdvanced, nullptr);
+    } else {
+      auto* data = decodedValues();
+      doNext(data, numAdvanced, nullptr);
+      if (dense) {
+        for (auto i = 0; i < numInRun; ++i) {
+          output[i] = data[i];
+        }
+      } else {
+        for (auto i = 0; i < numInRun; ++i) {
+          output[i] = data[rows[rowIndex + i] - currentRow];
+        }
+      }
+    }
+  }
+
+  template <bool hasFilter, bool hasHook, bool scatter, typename Visitor>
+  void bulkScan(
+      folly::Range<const int32_t*> nonNullRows,
+      const int32_t* scatterRows,
+      Visitor& visitor) {
+    auto numAllRows = visitor.numRows();
+    visitor.setRows(nonNullRows);
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowIndex = 0;
+    int32_t currentRow = 0;
+    auto values = visitor.rawValues(numRows);
+    auto filterHits = hasFilter ? visitor.outputRows(numRows) : nullptr;
+    int32_t numValues = 0;
+    for (;;) {
+      if (runRead == runLength) {
+        startRun();
+      }
+      auto [numInRun, numAdvanced] =
+          findNumInRun<Visitor::dense>(rows, rowIndex, numRows, currentRow);
+      if (numInRun) {
+        if (isFixedDeltaRun()) {
+          const int64_t delta = type == SHORT_REPEAT ? 0 : deltaBase;
+          const int64_t value = firstValue + runRead * delta;
+          bool skipRun = false;
+          if constexpr (Visitor::kCanSkipFailedRuns && hasFilter) {
+            // The values of the run are monotonic, so the run fails as a
+            // whole if the range from its first to last value fails.
+            const int64_t last = value + (numAdvanced - 1) * delta;
+            skipRun = !visitor.filter().testInt64Range(
+                std::min(value, last), std::max(value, last), false);
+            if (skipRun) {
+              visitor.skipFailedRun(numInRun);
+            }
+          }
+          if (!skipRun) {
+            visitor.template processRle<hasFilter, hasHook, scatter>(
+                value,
+                delta,
+                numInRun,
+                currentRow,
+                scatterRows,
+                filterHits,
+                values,
+                numValues);
+          }
+          skipInRun(numAdvanced);
+        } else {
+          decodeRun<Visitor::dense>(
+              rows,
+              rowIndex,
+              numInRun,
+              numAdvanced,
+              currentRow,
+              values + numValues);
+          visitor.template processRun<hasFilter, hasHook, scatter>(
+              values + numValues,
+              numInRun,
+              scatterRows,
+              filterHits,
+              values,
+              numValues);
+        }
+        currentRow += numAdvanced;
+        rowIndex += numInRun;
+        if (visitor.atEnd()) {
+          visitor.setNumValues(hasFilter ? numValues : numAllRows);
+          return;
+        }
+      }
+      // The next row of interest is after the current run.
+      currentRow += runLength - runRead;
+      skipInRun(runLength - runRead);
+    }
+  }
+
   // Used by PATCHED_BASE
   void adjustGapAndPatch() {
     curGap = static_cast<uint64_t>(unpackedPatch[patchIdx]) >> patchBitSize;
@@ -238,6 +480,7 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   EncodingType type;
   dwio::common::DataBuffer<int64_t> unpacked; // Used by PATCHED_BASE
   dwio::common::DataBuffer<int64_t> unpackedPatch; // Used by PATCHED_BASE
+  dwio::common::DataBuffer<int64_t> decoded; // Used by bulkScan
 };
 
 } // namespace facebook::velox::dwrf
@@ -17,6 +17,7 @@
 #include "velox/dwio/dwrf/reader/DwrfData.h"
 
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 
 namespace facebook::velox::dwrf {
 
@@ -24,7 +25,8 @@ DwrfData::DwrfData(
     std::shared_ptr<const dwio::common::TypeWithId> fileType,
     StripeStreams& stripe,
     const StreamLabels& streamLabels,
-    FlatMapContext flatMapContext)
+    FlatMapContext flatMapContext,
+    bool readBloomFilters)
     : memoryPool_(stripe.getMemoryPool()),
       fileType_(std::move(fileType)),
       flatMapContext_(std::move(flatMapContext)),
@@ -48,6 +50,14 @@ DwrfData::DwrfData(
       encodingKey.forKind(proto::Stream_Kind_ROW_INDEX),
       streamLabels.label(),
       false);
+  // Like the row index, the bloom filters come from the stripe metadata cache
+  // if the index streams of the stripe are cached.
+  if (readBloomFilters) {
+    bloomFilterStream_ = stripe.getStream(
+        encodingKey.forKind(proto::Stream_Kind_BLOOM_FILTER_UTF8),
+        streamLabels.label(),
+        false);
+  }
 }
 
 uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
@@ -137,6 +147,93 @@ void DwrfData::readNulls(
   }
 }
 
+namespace {
+// Returns the hashes of the values 'filter' can pass if 'filter' passes a
+// discrete set of values of 'type' and no nulls. Returns std::nullopt
+// otherwise.
+std::optional<std::vector<uint64_t>> pointLookupHashes(
+    const common::Filter& filter,
+    const Type& type) {
+  if (filter.testNull()) {
+    return std::nullopt;
+  }
+  std::vector<uint64_t> hashes;
+  const auto kind = type.kind();
+  const bool isInteger = kind == TypeKind::TINYINT ||
+      kind == TypeKind::SMALLINT || kind == TypeKind::INTEGER ||
+      kind == TypeKind::BIGINT;
+  const bool isString =
+      kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY;
+  std::vector<int64_t> intValues;
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto* range = static_cast<const common::BigintRange*>(&filter);
+      if (!range->isSingleValue()) {
+        return std::nullopt;
+      }
+      intValues.push_back(range->lower());
+      break;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      intValues =
+          static_cast<const common::BigintValuesUsingHashTable*>(&filter)
+              ->values();
+      break;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      intValues =
+          static_cast<const common::BigintValuesUsingBitmask*>(&filter)
+              ->values();
+      break;
+    case common::FilterKind::kBytesRange: {
+      auto* range = static_cast<const common::BytesRange*>(&filter);
+      if (!isString || !range->isSingleValue()) {
+        return std::nullopt;
+      }
+      hashes.push_back(BloomFilter::hash(std::string_view(range->lower())));
+      return hashes;
+    }
+    case common::FilterKind::kBytesValues: {
+      if (!isString) {
+        return std::nullopt;
+      }
+      for (const auto& value :
+           static_cast<const common::BytesValues*>(&filter)->values()) {
+        hashes.push_back(BloomFilter::hash(std::string_view(value)));
+      }
+      return hashes;
+    }
+    default:
+      return std::nullopt;
+  }
+  if (!isInteger) {
+    return std::nullopt;
+  }
+  for (auto value : intValues) {
+    hashes.push_back(BloomFilter::hash(value));
+  }
+  return hashes;
+}
+} // namespace
+
+bool DwrfData::bloomFilterMatches(
+    int32_t index,
+    const std::vector<uint64_t>& hashes) {
+  if (bloomFilterStream_) {
+    bloomFilters_ = ProtoUtils::readProto<proto::BloomFilterIndex>(
+        std::move(bloomFilterStream_));
+  }
+  if (!bloomFilters_ || index >= bloomFilters_->bloomfilter_size()) {
+    return true;
+  }
+  BloomFilter bloomFilter(bloomFilters_->bloomfilter(index));
+  for (auto hash : hashes) {
+    if (bloomFilter.testHash(hash)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void DwrfData::filterRowGroups(
     const common::ScanSpec& scanSpec,
     uint64_t rowGroupSize,
@@ -158,6 +255,10 @@ void DwrfData::filterRowGroups(
     result.metadataFilterResults.emplace_back(
         scanSpec.metadataFilterNodeAt(i), std::vector<uint64_t>(nwords));
   }
+  std::optional<std::vector<uint64_t>> bloomFilterHashes;
+  if (filter && (bloomFilterStream_ || bloomFilters_)) {
+    bloomFilterHashes = pointLookupHashes(*filter, *fileType_->type());
+  }
   for (auto i = 0; i < index_->entry_size(); i++) {
     const auto& entry = index_->entry(i);
     auto columnStats =
@@ -169,6 +270,12 @@ void DwrfData::filterRowGroups(
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
+    if (bloomFilterHashes && !bloomFilterMatches(i, *bloomFilterHashes)) {
+      VLOG(1) << "Drop stride " << i << " on bloom filter of "
+              << scanSpec.toString();
+      bits::setBit(result.filterResult.data(), i);
+      continue;
+    }
     for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
       auto* metadataFilter = scanSpec.metadataFilterAt(j);
       if (!testFilter(
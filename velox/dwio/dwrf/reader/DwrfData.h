@@ -37,7 +37,8 @@ class DwrfData : public dwio::common::FormatData {
       std::shared_ptr<const dwio::common::TypeWithId> fileType,
       StripeStreams& stripe,
       const StreamLabels& streamLabels,
-      FlatMapContext flatMapContext);
+      FlatMapContext flatMapContext,
+      bool readBloomFilters = false);
 
   void readNulls(
       vector_size_t numValues,
@@ -94,6 +95,10 @@ class DwrfData : public dwio::common::FormatData {
   }
 
  private:
+  // Returns false if the bloom filter of row group 'index' shows that no value
+  // with one of 'hashes' is in the row group.
+  bool bloomFilterMatches(int32_t index, const std::vector<uint64_t>& hashes);
+
   static std::vector<uint64_t> toPositionsInner(
       const proto::RowIndexEntry& entry) {
     return std::vector<uint64_t>(
@@ -106,6 +111,10 @@ class DwrfData : public dwio::common::FormatData {
   std::unique_ptr<ByteRleDecoder> notNullDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> indexStream_;
   std::unique_ptr<proto::RowIndex> index_;
+  // Bloom filters of the row groups. The stream is only opened if the column
+  // has a filter when the reader is made and is decoded on first use.
+  std::unique_ptr<dwio::common::SeekableInputStream> bloomFilterStream_;
+  std::unique_ptr<proto::BloomFilterIndex> bloomFilters_;
   int64_t stripeRows_;
   // Number of rows in a row group. Last row group may have fewer rows.
   uint32_t rowsPerRowGroup_;
@@ -133,9 +142,13 @@ class DwrfParams : public dwio::common::FormatParams {
 
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
-      const common::ScanSpec& /*scanSpec*/) override {
+      const common::ScanSpec& scanSpec) override {
     return std::make_unique<DwrfData>(
-        type, stripeStreams_, streamLabels_, flatMapContext_);
+        type,
+        stripeStreams_,
+        streamLabels_,
+        flatMapContext_,
+        scanSpec.filter() != nullptr);
   }
 
   StripeStreams& stripeStreams() {
@@ -31,6 +31,46 @@ using dwio::common::FileFormat;
 using dwio::common::ReaderOptions;
 using dwio::common::RowReaderOptions;
 
+namespace {
+
+// A stripe of a DwrfRowReader as a unit of a UnitLoader.
+class StripeLoadUnit : public dwio::common::LoadUnit {
+ public:
+  StripeLoadUnit(
+      std::function<void()> load,
+      std::function<void()> unload,
+      uint64_t numRows,
+      uint64_t ioSize)
+      : load_{std::move(load)},
+        unload_{std::move(unload)},
+        numRows_{numRows},
+        ioSize_{ioSize} {}
+
+  void load() override {
+    load_();
+  }
+
+  void unload() override {
+    unload_();
+  }
+
+  uint64_t getNumRows() override {
+    return numRows_;
+  }
+
+  uint64_t getIoSize() override {
+    return ioSize_;
+  }
+
+ private:
+  const std::function<void()> load_;
+  const std::function<void()> unload_;
+  const uint64_t numRows_;
+  const uint64_t ioSize_;
+};
+
+} // namespace
+
 DwrfRowReader::DwrfRowReader(
     const std::shared_ptr<ReaderBase>& reader,
     const RowReaderOptions& opts)
@@ -111,6 +151,21 @@ DwrfRowReader::DwrfRowReader(
   }
   stripeLoadStatuses_ = folly::Synchronized(
       std::vector<FetchStatus>(numberOfStripes, FetchStatus::NOT_STARTED));
+
+  if (options_.getUnitLoaderFactory() && !isEmptyFile()) {
+    std::vector<std::unique_ptr<dwio::common::LoadUnit>> units;
+    units.reserve(stripeCeiling_ - firstStripe_);
+    for (auto stripe = firstStripe_; stripe < stripeCeiling_; ++stripe) {
+      auto stripeInfo = fileFooter.stripes(stripe);
+      units.push_back(std::make_unique<StripeLoadUnit>(
+          [this, stripe]() { fetch(stripe); },
+          [this, stripe]() { prefetchedStripeStates_.wlock()->erase(stripe); },
+          stripeInfo.numberOfRows(),
+          stripeInfo.indexLength() + stripeInfo.dataLength() +
+              stripeInfo.footerLength()));
+    }
+    unitLoader_ = options_.getUnitLoaderFactory()->create(std::move(units));
+  }
 }
 
 uint64_t DwrfRowReader::seekToRow(uint64_t rowNumber) {
@@ -440,12 +495,18 @@ uint64_t DwrfRowReader::next(
   strideIndex_ = strideSize > 0 ? currentRowInStripe_ / strideSize : 0;
   readNext(rowsToRead, mutation, result);
   currentRowInStripe_ += rowsToRead;
+  // The LazyVectors of the previous result have been loaded by now if they
+  // ever are.
+  numRowsBeforeLastResult_ = numResultRows_;
+  numResultRows_ += result->size();
+  resultBytes_ += result->estimateFlatSize();
   return rowsToRead;
 }
 
 void DwrfRowReader::resetFilterCaches() {
   if (selectiveColumnReader_) {
     selectiveColumnReader_->resetFilterCaches();
+    stringDictionaryFilterCache_->clear();
     recomputeStridesToSkip_ = true;
   }
 
@@ -505,7 +566,9 @@ DwrfRowReader::FetchResult DwrfRowReader::fetch(uint32_t stripeIndex) {
 
   bool preload = options_.getPreloadStripe();
   auto state = std::make_shared<StripeReadState>(
-      readerBaseShared(), fetchStripe(stripeIndex, preload));
+      readerBaseShared(),
+      fetchStripe(stripeIndex, preload),
+      stringDictionaryFilterCache_);
 
   stripeState.stripeReadState = state;
 
@@ -538,6 +601,11 @@ DwrfRowReader::FetchResult DwrfRowReader::fetch(uint32_t stripeIndex) {
         flatMapContext,
         true); // isRoot
     stripeState.selectiveColumnReader->setIsTopLevel();
+    if (options_.collectColumnStats()) {
+      dynamic_cast<dwio::common::SelectiveStructColumnReaderBase&>(
+          *stripeState.selectiveColumnReader)
+          .setColumnReadStatistics(&columnReaderStatistics_);
+    }
   } else {
     stripeState.columnReader = ColumnReader::build( // enqueue streams
         requestedType,
@@ -590,6 +658,11 @@ DwrfRowReader::FetchResult DwrfRowReader::prefetch(uint32_t stripeToFetch) {
 
 // Guarantee stripe we are currently on is available and loaded
 void DwrfRowReader::safeFetchNextStripe() {
+  if (unitLoader_) {
+    // Returns after the stripe is fetched. Starts fetching the stripes after
+    // it, depending on the loader.
+    unitLoader_->getLoadedUnit(currentStripe_ - firstStripe_);
+  }
   auto startTime = std::chrono::high_resolution_clock::now();
   auto fetchResult = fetch(currentStripe_);
   // If result is fetched by this thread or in progress in another thread,
@@ -626,6 +699,7 @@ void DwrfRowReader::startNextStripe() {
     return;
   }
   columnReader_.reset();
+  retiredLazyLoadedBytes_ += lazyLoadedBytes();
   selectiveColumnReader_.reset();
   safeFetchNextStripe();
   prefetchedStripeStates_.withWLock([&](auto& prefetchedStripeStates) {
@@ -740,7 +814,22 @@ std::optional<size_t> DwrfRowReader::estimatedRowSizeHelper(
   }
 }
 
+uint64_t DwrfRowReader::lazyLoadedBytes() const {
+  auto* structReader =
+      dynamic_cast<const dwio::common::SelectiveStructColumnReaderBase*>(
+          selectiveColumnReader_.get());
+  return retiredLazyLoadedBytes_ +
+      (structReader ? structReader->lazyLoadedBytes() : 0);
+}
+
 std::optional<size_t> DwrfRowReader::estimatedRowSize() const {
+  if (numRowsBeforeLastResult_ > 0) {
+    // The size of the rows read so far. The columns loaded lazily are only
+    // counted for the results before the last one since the last result may
+    // not be loaded yet.
+    return resultBytes_ / numResultRows_ +
+        lazyLoadedBytes() / numRowsBeforeLastResult_;
+  }
   auto& reader = getReader();
   auto& fileFooter = reader.getFooter();
 
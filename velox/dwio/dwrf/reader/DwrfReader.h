@@ -81,7 +81,9 @@ class DwrfRowReader : public StrideIndexProvider,
   // Estimate the space used by the reader
   size_t estimatedReaderMemory() const;
 
-  // Estimate the row size for projected columns
+  // Estimate the row size for projected columns. This is the measured size of
+  // the results after the first two non-empty ones, else an estimate from the
+  // file statistics.
   std::optional<size_t> estimatedRowSize() const override;
 
   // Returns number of rows read. Guaranteed to be less then or equal to size.
@@ -95,6 +97,7 @@ class DwrfRowReader : public StrideIndexProvider,
     stats.skippedStrides += skippedStrides_;
     stats.columnReaderStatistics.flattenStringDictionaryValues +=
         columnReaderStatistics_.flattenStringDictionaryValues;
+    stats.columnReaderStatistics.mergeColumnStats(columnReaderStatistics_);
   }
 
   void resetFilterCaches() override;
@@ -147,6 +150,10 @@ class DwrfRowReader : public StrideIndexProvider,
   uint64_t rowsInCurrentStripe_;
   uint64_t strideIndex_;
   std::shared_ptr<StripeDictionaryCache> stripeDictionaryCache_;
+  // Filter results of string dictionaries reused by later stripes.
+  const std::shared_ptr<StringDictionaryFilterCache>
+      stringDictionaryFilterCache_{
+          std::make_shared<StringDictionaryFilterCache>()};
   dwio::common::RowReaderOptions options_;
   std::shared_ptr<folly::Executor> executor_;
   std::function<void(uint64_t)> decodingTimeUsCallback_;
@@ -202,6 +209,21 @@ class DwrfRowReader : public StrideIndexProvider,
 
   bool atEnd_{false};
 
+  // Number of rows in the results of next().
+  uint64_t numResultRows_{0};
+  // Value of 'numResultRows_' before the last call to next().
+  uint64_t numRowsBeforeLastResult_{0};
+  // Sum of the estimated flat sizes of the results of next() when returned.
+  // Does not include the columns that are loaded lazily.
+  uint64_t resultBytes_{0};
+  // Bytes loaded into LazyVectors by the column readers of previous stripes.
+  uint64_t retiredLazyLoadedBytes_{0};
+
+  // Fetches the stripes if RowReaderOptions has a unit loader factory.
+  // Declared last so that it is destroyed first, after waiting for the
+  // fetches in progress.
+  std::unique_ptr<dwio::common::UnitLoader> unitLoader_;
+
   // internal methods
 
   std::optional<size_t> estimatedRowSizeHelper(
@@ -219,6 +241,10 @@ class DwrfRowReader : public StrideIndexProvider,
 
   void checkSkipStrides(uint64_t strideSize);
 
+  // Returns the estimated flat size of the values loaded into the LazyVectors
+  // of the results of next().
+  uint64_t lazyLoadedBytes() const;
+
   void readNext(
       uint64_t rowsToRead,
       const dwio::common::Mutation*,
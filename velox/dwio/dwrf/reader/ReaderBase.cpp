@@ -19,6 +19,7 @@
 #include <fmt/format.h>
 
 #include "velox/common/process/TraceContext.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/Mutation.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -97,20 +98,89 @@ ReaderBase::ReaderBase(
     bool fileColumnNamesReadAsLowerCase,
     std::shared_ptr<random::RandomSkipTracker> randomSkip)
     : pool_{pool},
-      arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
       footerEstimatedSize_(footerEstimatedSize),
       filePreloadThreshold_(filePreloadThreshold),
       input_(std::move(input)),
       randomSkip_(std::move(randomSkip)) {
   process::TraceContext trace("ReaderBase::ReaderBase");
-  // read last bytes into buffer to get PostScript
   // If file is small, load the entire file.
   // TODO: make a config
   fileLength_ = input_->getReadFile()->size();
   DWIO_ENSURE(fileLength_ > 0, "ORC file is empty");
+  const bool preloadFile = fileLength_ <= filePreloadThreshold_;
+
+  // The splits of a file share its parsed tail through the metadata cache.
+  auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+  std::optional<dwio::common::FileMetadataCache::Key> cacheKey;
+  if (metadataCache != nullptr && input_->fileNum().has_value()) {
+    cacheKey = dwio::common::FileMetadataCache::Key{
+        input_->fileNum().value(), fileLength_, fileFormat};
+    tail_ = metadataCache->get<FileTail>(*cacheKey);
+  }
+  if (tail_ == nullptr) {
+    tail_ = readTail(fileFormat, preloadFile);
+    if (cacheKey.has_value()) {
+      metadataCache->put(*cacheKey, tail_, tail_->memoryUsage());
+    }
+  } else if (preloadFile) {
+    input_->enqueue({0, fileLength_, "footer"});
+    input_->load(LogType::FILE);
+  }
+  postScript_ = tail_->postScript.get();
+  footer_ = tail_->footer.get();
+  psLength_ = tail_->psLength;
+
+  const uint64_t footerSize = postScript_->footerLength();
+  const uint64_t cacheSize =
+      postScript_->hasCacheSize() ? postScript_->cacheSize() : 0;
+  const uint64_t tailSize = 1 + psLength_ + footerSize + cacheSize;
+
+  schema_ = std::dynamic_pointer_cast<const RowType>(
+      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
+  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
 
-  auto preloadFile = fileLength_ <= filePreloadThreshold_;
+  // load stripe index/footer cache
+  if (cacheSize > 0) {
+    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
+    if (input_->shouldPrefetchStripes()) {
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(),
+          *footer_,
+          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
+      input_->load(LogType::FOOTER);
+    } else {
+      auto cacheBuffer =
+          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
+      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
+          ->readFully(cacheBuffer->data(), cacheSize);
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
+    }
+  }
+  if (!cache_ && input_->shouldPrefetchStripes()) {
+    auto numStripes = getFooter().stripesSize();
+    for (auto i = 0; i < numStripes; i++) {
+      const auto stripe = getFooter().stripes(i);
+      input_->enqueue(
+          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
+           stripe.footerLength(),
+           "stripe_footer"});
+    }
+    if (numStripes) {
+      input_->load(LogType::FOOTER);
+    }
+  }
+  // initialize file decrypter
+  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+}
+
+std::shared_ptr<const FileTail> ReaderBase::readTail(
+    FileFormat fileFormat,
+    bool preloadFile) {
+  auto tail = std::make_shared<FileTail>();
+  tail->arena = std::make_unique<google::protobuf::Arena>();
+  // read last bytes into buffer to get PostScript
   uint64_t readSize =
       preloadFile ? fileLength_ : std::min(fileLength_, footerEstimatedSize_);
   DWIO_ENSURE_GE(readSize, 4, "File size too small");
@@ -125,27 +195,31 @@ ReaderBase::ReaderBase(
     auto lastByteStream = input_->read(fileLength_ - 1, 1, LogType::FOOTER);
     DWIO_ENSURE(lastByteStream->Next(&buf, &ignored), "failed to read");
     // Make sure 'lastByteStream' is live while dereferencing 'buf'.
-    psLength_ = *static_cast<const char*>(buf) & 0xff;
+    tail->psLength = *static_cast<const char*>(buf) & 0xff;
   }
+  const uint64_t psLength = tail->psLength;
   DWIO_ENSURE_LE(
-      psLength_ + 4, // 1 byte for post script len, 3 byte "ORC" header.
+      psLength + 4, // 1 byte for post script len, 3 byte "ORC" header.
       fileLength_,
       "Corrupted file, Post script size is invalid");
 
   if (fileFormat == FileFormat::DWRF) {
     auto postScript = ProtoUtils::readProto<proto::PostScript>(
-        input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+        input_->read(fileLength_ - psLength - 1, psLength, LogType::FOOTER));
+    tail->postScript = std::make_unique<PostScript>(std::move(postScript));
   } else {
     auto postScript = ProtoUtils::readProto<proto::orc::PostScript>(
-        input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+        input_->read(fileLength_ - psLength - 1, psLength, LogType::FOOTER));
+    tail->postScript = std::make_unique<PostScript>(std::move(postScript));
   }
+  const auto& postScript = *tail->postScript;
+  // createDecompressedStream() decompresses the footer as set in the
+  // postscript.
+  postScript_ = &postScript;
 
-  uint64_t footerSize = postScript_->footerLength();
-  uint64_t cacheSize =
-      postScript_->hasCacheSize() ? postScript_->cacheSize() : 0;
-  uint64_t tailSize = 1 + psLength_ + footerSize + cacheSize;
+  uint64_t footerSize = postScript.footerLength();
+  uint64_t cacheSize = postScript.hasCacheSize() ? postScript.cacheSize() : 0;
+  uint64_t tailSize = 1 + psLength + footerSize + cacheSize;
 
   // There are cases in warehouse, where RC/text files are stored
   // in ORC partition. This causes the Reader to SIGSEGV. The following
@@ -157,11 +231,11 @@ ReaderBase::ReaderBase(
   DWIO_ENSURE_LE(tailSize, fileLength_, "Corrupted file, tail size is invalid");
 
   DWIO_ENSURE(
-      (format() == DwrfFormat::kDwrf)
-          ? proto::CompressionKind_IsValid(postScript_->compression())
-          : proto::orc::CompressionKind_IsValid(postScript_->compression()),
+      (postScript.format() == DwrfFormat::kDwrf)
+          ? proto::CompressionKind_IsValid(postScript.compression())
+          : proto::orc::CompressionKind_IsValid(postScript.compression()),
       "Corrupted File, invalid compression kind ",
-      postScript_->compression());
+      postScript.compression());
 
   if (tailSize > readSize) {
     input_->enqueue({fileLength_ - tailSize, tailSize, "footer"});
@@ -169,60 +243,23 @@ ReaderBase::ReaderBase(
   }
 
   auto footerStream = input_->read(
-      fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
+      fileLength_ - psLength - footerSize - 1, footerSize, LogType::FOOTER);
   if (fileFormat == FileFormat::DWRF) {
-    auto footer =
-        google::protobuf::Arena::CreateMessage<proto::Footer>(arena_.get());
+    auto footer = google::protobuf::Arena::CreateMessage<proto::Footer>(
+        tail->arena.get());
     ProtoUtils::readProtoInto<proto::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    tail->footer = std::make_unique<FooterWrapper>(footer);
   } else {
     auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
-        arena_.get());
+        tail->arena.get());
     ProtoUtils::readProtoInto<proto::orc::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    tail->footer = std::make_unique<FooterWrapper>(footer);
   }
-
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
-  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
-
-  // load stripe index/footer cache
-  if (cacheSize > 0) {
-    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
-    if (input_->shouldPrefetchStripes()) {
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(),
-          *footer_,
-          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
-      input_->load(LogType::FOOTER);
-    } else {
-      auto cacheBuffer =
-          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
-      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
-          ->readFully(cacheBuffer->data(), cacheSize);
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
-    }
-  }
-  if (!cache_ && input_->shouldPrefetchStripes()) {
-    auto numStripes = getFooter().stripesSize();
-    for (auto i = 0; i < numStripes; i++) {
-      const auto stripe = getFooter().stripes(i);
-      input_->enqueue(
-          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
-           stripe.footerLength(),
-           "stripe_footer"});
-    }
-    if (numStripes) {
-      input_->load(LogType::FOOTER);
-    }
-  }
-  // initialize file decrypter
-  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+  return tail;
 }
 
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
@@ -58,6 +58,24 @@ class FooterStatisticsImpl : public dwio::common::Statistics {
   }
 };
 
+/// The parsed postscript and footer of a DWRF or ORC file. Immutable once
+/// built, so that the readers of the splits of a file can share it through the
+/// dwio::common::FileMetadataCache.
+struct FileTail {
+  // Owns the footer proto wrapped by 'footer'. nullptr if the footer is owned
+  // by the creator of the ReaderBase.
+  std::unique_ptr<google::protobuf::Arena> arena;
+  std::unique_ptr<PostScript> postScript;
+  std::unique_ptr<FooterWrapper> footer;
+  uint64_t psLength{0};
+
+  /// Returns the approximate memory used by 'this'.
+  int64_t memoryUsage() const {
+    return sizeof(FileTail) + psLength +
+        (arena != nullptr ? arena->SpaceAllocated() : 0);
+  }
+};
+
 class ReaderBase {
  public:
   // create reader base from buffered input
@@ -88,8 +106,9 @@ class ReaderBase {
       std::unique_ptr<StripeMetadataCache> cache,
       std::unique_ptr<encryption::DecryptionHandler> handler = nullptr)
       : pool_{pool},
-        postScript_{std::move(ps)},
-        footer_{std::make_unique<FooterWrapper>(footer)},
+        tail_{makeTail(std::move(ps), footer)},
+        postScript_{tail_->postScript.get()},
+        footer_{tail_->footer.get()},
         cache_{std::move(cache)},
         handler_{std::move(handler)},
         input_{std::move(input)},
@@ -225,7 +244,7 @@ class ReaderBase {
   }
 
   google::protobuf::Arena* arena() const {
-    return arena_.get();
+    return tail_ != nullptr ? tail_->arena.get() : nullptr;
   }
 
   DwrfFormat format() const {
@@ -237,15 +256,30 @@ class ReaderBase {
   }
 
  private:
+  static std::shared_ptr<const FileTail> makeTail(
+      std::unique_ptr<PostScript> ps,
+      const proto::Footer* footer) {
+    auto tail = std::make_shared<FileTail>();
+    tail->postScript = std::move(ps);
+    tail->footer = std::make_unique<FooterWrapper>(footer);
+    return tail;
+  }
+
+  // Reads and parses the postscript and the footer of the file.
+  std::shared_ptr<const FileTail> readTail(
+      dwio::common::FileFormat fileFormat,
+      bool preloadFile);
+
   static std::shared_ptr<const Type> convertType(
       const FooterWrapper& footer,
       uint32_t index = 0,
       bool fileColumnNamesReadAsLowerCase = false);
 
   memory::MemoryPool& pool_;
-  std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
-  std::unique_ptr<FooterWrapper> footer_ = nullptr;
+  std::shared_ptr<const FileTail> tail_;
+  // The postscript and footer in 'tail_'.
+  const PostScript* postScript_{nullptr};
+  const FooterWrapper* footer_{nullptr};
   std::unique_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
   std::shared_ptr<dwio::common::encryption::DecrypterFactory> decryptorFactory_;
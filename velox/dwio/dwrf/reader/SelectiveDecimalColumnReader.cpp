@@ -67,16 +67,18 @@ void SelectiveDecimalColumnReader<DataT>::seekToRowGroup(uint32_t index) {
 
 template <typename DataT>
 template <bool kDense>
-void SelectiveDecimalColumnReader<DataT>::readHelper(RowSet rows) {
+void SelectiveDecimalColumnReader<DataT>::readHelper(
+    common::Filter* filter,
+    RowSet rows) {
   vector_size_t numRows = rows.back() + 1;
   ExtractToReader extractValues(this);
-  common::AlwaysTrue filter;
+  common::AlwaysTrue alwaysTrue;
   DirectRleColumnVisitor<
       int64_t,
       common::AlwaysTrue,
       decltype(extractValues),
       kDense>
-      visitor(filter, this, rows, extractValues);
+      visitor(alwaysTrue, this, rows, extractValues);
 
   // decode scale stream
   if (version_ == velox::dwrf::RleVersion_1) {
@@ -92,32 +94,160 @@ void SelectiveDecimalColumnReader<DataT>::readHelper(RowSet rows) {
       scaleBuffer_->asMutable<char>(),
       rawValues_,
       numValues_ * sizeof(int64_t));
+  const auto* rawNulls =
+      resultNulls() ? resultNulls()->template as<uint64_t>() : nullptr;
+  const bool rescale = needsRescale(rawNulls);
 
   // reset numValues_ before reading values
   numValues_ = 0;
   valueSize_ = sizeof(DataT);
   ensureValuesCapacity<DataT>(numRows);
 
-  // decode value stream
-  facebook::velox::dwio::common::
-      ColumnVisitor<DataT, common::AlwaysTrue, decltype(extractValues), kDense>
-          valueVisitor(filter, this, rows, extractValues);
-  decodeWithVisitor<DirectDecoder<true>>(valueDecoder_.get(), valueVisitor);
+  // Values at the scale of the type are filtered while decoding, like
+  // integers. Others are rescaled before filtering.
+  if (filter && !rescale) {
+    processFilter<kDense>(filter, rows);
+  } else {
+    facebook::velox::dwio::common::ColumnVisitor<
+        DataT,
+        common::AlwaysTrue,
+        decltype(extractValues),
+        kDense>
+        valueVisitor(alwaysTrue, this, rows, extractValues);
+    decodeWithVisitor<DirectDecoder<true>>(valueDecoder_.get(), valueVisitor);
+    if (rescale) {
+      auto* values = values_->asMutable<DataT>();
+      DecimalUtil::fillDecimals<DataT>(
+          values,
+          rawNulls,
+          values,
+          scaleBuffer_->as<int64_t>(),
+          numValues_,
+          scale_);
+    }
+    if (filter) {
+      filterValues(*filter, rows, rawNulls);
+    }
+  }
   readOffset_ += numRows;
 }
 
+template <typename DataT>
+bool SelectiveDecimalColumnReader<DataT>::needsRescale(
+    const uint64_t* nulls) const {
+  const auto* scales = scaleBuffer_->as<int64_t>();
+  for (vector_size_t i = 0; i < numValues_; ++i) {
+    if (scales[i] != scale_ && (!nulls || !bits::isBitNull(nulls, i))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename DataT>
+template <typename TFilter, bool kDense>
+void SelectiveDecimalColumnReader<DataT>::readWithFilter(
+    common::Filter* filter,
+    RowSet rows) {
+  decodeWithVisitor<DirectDecoder<true>>(
+      valueDecoder_.get(),
+      facebook::velox::dwio::common::
+          ColumnVisitor<DataT, TFilter, ExtractToReader, kDense>(
+              *static_cast<TFilter*>(filter),
+              this,
+              rows,
+              ExtractToReader(this)));
+}
+
+template <typename DataT>
+template <bool kDense>
+void SelectiveDecimalColumnReader<DataT>::processFilter(
+    common::Filter* filter,
+    RowSet rows) {
+  if constexpr (std::is_same_v<DataT, int64_t>) {
+    switch (filter->kind()) {
+      case common::FilterKind::kBigintRange:
+        readWithFilter<common::BigintRange, kDense>(filter, rows);
+        return;
+      case common::FilterKind::kNegatedBigintRange:
+        readWithFilter<common::NegatedBigintRange, kDense>(filter, rows);
+        return;
+      case common::FilterKind::kBigintValuesUsingHashTable:
+        readWithFilter<common::BigintValuesUsingHashTable, kDense>(
+            filter, rows);
+        return;
+      case common::FilterKind::kBigintValuesUsingBitmask:
+        readWithFilter<common::BigintValuesUsingBitmask, kDense>(filter, rows);
+        return;
+      default:
+        break;
+    }
+  } else {
+    switch (filter->kind()) {
+      case common::FilterKind::kHugeintRange:
+        readWithFilter<common::HugeintRange, kDense>(filter, rows);
+        return;
+      case common::FilterKind::kHugeintValuesUsingHashTable:
+        readWithFilter<common::HugeintValuesUsingHashTable, kDense>(
+            filter, rows);
+        return;
+      default:
+        break;
+    }
+  }
+  readWithFilter<common::Filter, kDense>(filter, rows);
+}
+
+template <typename DataT>
+void SelectiveDecimalColumnReader<DataT>::filterValues(
+    const common::Filter& filter,
+    RowSet rows,
+    const uint64_t* rawNulls) {
+  auto* values = values_->asMutable<DataT>();
+  returnReaderNulls_ = false;
+  anyNulls_ = false;
+  allNull_ = true;
+  vector_size_t numPassed = 0;
+  for (vector_size_t i = 0; i < numValues_; ++i) {
+    if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      if (filter.testNull()) {
+        bits::setNull(rawResultNulls_, numPassed);
+        addOutputRow(rows[i]);
+        anyNulls_ = true;
+        ++numPassed;
+      }
+    } else if (common::applyFilter(filter, values[i])) {
+      if (rawNulls) {
+        bits::setNull(rawResultNulls_, numPassed, false);
+      }
+      values[numPassed] = values[i];
+      addOutputRow(rows[i]);
+      allNull_ = false;
+      ++numPassed;
+    }
+  }
+  numValues_ = numPassed;
+}
+
 template <typename DataT>
 void SelectiveDecimalColumnReader<DataT>::read(
     vector_size_t offset,
     RowSet rows,
     const uint64_t* incomingNulls) {
-  VELOX_CHECK(!scanSpec_->filter());
   prepareRead<int64_t>(offset, rows, incomingNulls);
+  auto* filter = scanSpec_->filter();
+  if (filter && (!resultNulls_ || !resultNulls_->unique() ||
+                 resultNulls_->capacity() * 8 < rows.size())) {
+    // Filtering after decoding compacts the nulls into a dedicated
+    // 'resultNulls_'.
+    resultNulls_ = AlignedBuffer::allocate<bool>(rows.size(), &memoryPool_);
+    rawResultNulls_ = resultNulls_->asMutable<uint64_t>();
+  }
   bool isDense = rows.back() == rows.size() - 1;
   if (isDense) {
-    readHelper<true>(rows);
+    readHelper<true>(filter, rows);
   } else {
-    readHelper<false>(rows);
+    readHelper<false>(filter, rows);
   }
 }
 
@@ -125,14 +255,6 @@ template <typename DataT>
 void SelectiveDecimalColumnReader<DataT>::getValues(
     RowSet rows,
     VectorPtr* result) {
-  auto nullsPtr =
-      resultNulls() ? resultNulls()->template as<uint64_t>() : nullptr;
-  auto scales = scaleBuffer_->as<int64_t>();
-  auto values = values_->asMutable<DataT>();
-
-  DecimalUtil::fillDecimals<DataT>(
-      values, nullsPtr, values, scales, numValues_, scale_);
-
   rawValues_ = values_->asMutable<char>();
   getIntValues(rows, requestedType_, result);
 }
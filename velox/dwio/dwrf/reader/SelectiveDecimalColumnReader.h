@@ -42,7 +42,25 @@ class SelectiveDecimalColumnReader : public SelectiveColumnReader {
 
  private:
   template <bool kDense>
-  void readHelper(RowSet rows);
+  void readHelper(common::Filter* filter, RowSet rows);
+
+  // Returns true if a non-null value in the first 'numValues_' of
+  // 'scaleBuffer_' has a scale other than 'scale_'.
+  bool needsRescale(const uint64_t* nulls) const;
+
+  // Decodes the values and applies 'filter' to them in the same pass.
+  template <bool kDense>
+  void processFilter(common::Filter* filter, RowSet rows);
+
+  template <typename TFilter, bool kDense>
+  void readWithFilter(common::Filter* filter, RowSet rows);
+
+  // Applies 'filter' to the decoded and rescaled values and compacts the
+  // passing values and nulls.
+  void filterValues(
+      const common::Filter& filter,
+      RowSet rows,
+      const uint64_t* rawNulls);
 
   std::unique_ptr<IntDecoder<true>> valueDecoder_;
   std::unique_ptr<IntDecoder<true>> scaleDecoder_;
@@ -93,6 +93,12 @@ std::unique_ptr<SelectiveColumnReader> SelectiveDwrfReader::build(
         return createSelectiveFlatMapColumnReader(
             requestedType, fileType, params, scanSpec);
       }
+      VELOX_USER_CHECK_EQ(
+          stripe.getRowReaderOptions().getMapColumnIdAsStruct().count(
+              requestedType->id()),
+          0,
+          "Map column {} is read as a struct but is not flat map encoded",
+          fileType->id());
       return std::make_unique<SelectiveMapColumnReader>(
           requestedType, fileType, params, scanSpec);
     case TypeKind::REAL:
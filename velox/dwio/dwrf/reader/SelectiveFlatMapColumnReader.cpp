@@ -16,6 +16,8 @@
 
 #include "velox/dwio/dwrf/reader/SelectiveFlatMapColumnReader.h"
 
+#include <folly/Conv.h>
+
 #include "velox/dwio/common/FlatMapHelper.h"
 #include "velox/dwio/dwrf/reader/SelectiveDwrfReader.h"
 #include "velox/dwio/dwrf/reader/SelectiveStructColumnReader.h"
@@ -109,10 +111,11 @@ std::vector<KeyNode<T>> getKeyNodes(
       childSpecs;
   if (asStruct) {
     for (auto& c : scanSpec.children()) {
+      // The struct fields are named by the keys they project.
       if constexpr (std::is_same_v<T, StringView>) {
         childSpecs[KeyValue<T>(StringView(c->fieldName()))] = c.get();
-      } else {
-        childSpecs[KeyValue<T>(c->subscript())] = c.get();
+      } else if (auto key = folly::tryTo<T>(c->fieldName()); key.hasValue()) {
+        childSpecs[KeyValue<T>(key.value())] = c.get();
       }
     }
   }
@@ -190,9 +193,10 @@ class SelectiveFlatMapAsStructReader : public SelectiveStructColumnReaderBase {
             scanSpec),
         keyNodes_(
             getKeyNodes<T>(requestedType, fileType, params, scanSpec, true)) {
-    VELOX_CHECK(
-        !keyNodes_.empty(),
-        "For struct encoding, keys to project must be configured");
+    // Keys that are not in the stripe read as null.
+    for (auto& childSpec : scanSpec.children()) {
+      childSpec->setSubscript(kConstantChildSpecSubscript);
+    }
     children_.resize(keyNodes_.size());
     for (int i = 0; i < keyNodes_.size(); ++i) {
       keyNodes_[i].reader->scanSpec()->setSubscript(i);
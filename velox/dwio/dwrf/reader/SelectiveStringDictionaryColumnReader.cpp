@@ -29,14 +29,16 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
     : SelectiveColumnReader(fileType->type(), fileType, params, scanSpec),
       lastStrideIndex_(-1),
       provider_(params.stripeStreams().getStrideIndexProvider()),
-      statistics_(params.runtimeStatistics()) {
+      statistics_(params.runtimeStatistics()),
+      encodingKey_{fileType_->id(), params.flatMapContext().sequence},
+      dictionaryFilterCache_{
+          params.stripeStreams().getStringDictionaryFilterCache()} {
   auto& stripe = params.stripeStreams();
-  EncodingKey encodingKey{fileType_->id(), params.flatMapContext().sequence};
-  version_ = convertRleVersion(stripe.getEncoding(encodingKey).kind());
+  version_ = convertRleVersion(stripe.getEncoding(encodingKey_).kind());
   scanState_.dictionary.numValues =
-      stripe.getEncoding(encodingKey).dictionarysize();
+      stripe.getEncoding(encodingKey_).dictionarysize();
 
-  const auto dataId = encodingKey.forKind(proto::Stream_Kind_DATA);
+  const auto dataId = encodingKey_.forKind(proto::Stream_Kind_DATA);
   bool dictVInts = stripe.getUseVInts(dataId);
   dictIndex_ = createRleDecoder</*isSigned*/ false>(
       stripe.getStream(dataId, params.streamLabels().label(), true),
@@ -45,7 +47,7 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
       dictVInts,
       dwio::common::INT_BYTE_SIZE);
 
-  const auto lenId = encodingKey.forKind(proto::Stream_Kind_LENGTH);
+  const auto lenId = encodingKey_.forKind(proto::Stream_Kind_LENGTH);
   bool lenVInts = stripe.getUseVInts(lenId);
   lengthDecoder_ = createRleDecoder</*isSigned*/ false>(
       stripe.getStream(lenId, params.streamLabels().label(), false),
@@ -55,28 +57,28 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
       dwio::common::INT_BYTE_SIZE);
 
   blobStream_ = stripe.getStream(
-      encodingKey.forKind(proto::Stream_Kind_DICTIONARY_DATA),
+      encodingKey_.forKind(proto::Stream_Kind_DICTIONARY_DATA),
       params.streamLabels().label(),
       false);
 
   // handle in dictionary stream
   std::unique_ptr<SeekableInputStream> inDictStream = stripe.getStream(
-      encodingKey.forKind(proto::Stream_Kind_IN_DICTIONARY),
+      encodingKey_.forKind(proto::Stream_Kind_IN_DICTIONARY),
       params.streamLabels().label(),
       false);
   if (inDictStream) {
     inDictionaryReader_ =
-        createBooleanRleDecoder(std::move(inDictStream), encodingKey);
+        createBooleanRleDecoder(std::move(inDictStream), encodingKey_);
 
     // stride dictionary only exists if in dictionary exists
     strideDictStream_ = stripe.getStream(
-        encodingKey.forKind(proto::Stream_Kind_STRIDE_DICTIONARY),
+        encodingKey_.forKind(proto::Stream_Kind_STRIDE_DICTIONARY),
         params.streamLabels().label(),
         true);
     DWIO_ENSURE_NOT_NULL(strideDictStream_, "Stride dictionary is missing");
 
     const auto strideDictLenId =
-        encodingKey.forKind(proto::Stream_Kind_STRIDE_DICTIONARY_LENGTH);
+        encodingKey_.forKind(proto::Stream_Kind_STRIDE_DICTIONARY_LENGTH);
     bool strideLenVInt = stripe.getUseVInts(strideDictLenId);
     strideDictLengthDecoder_ = createRleDecoder</*isSigned*/ false>(
         stripe.getStream(strideDictLenId, params.streamLabels().label(), true),
@@ -88,6 +90,19 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
   scanState_.updateRawState();
 }
 
+SelectiveStringDictionaryColumnReader::
+    ~SelectiveStringDictionaryColumnReader() {
+  if (dictionaryFilterCache_ && initialized_ && scanSpec_->hasFilter() &&
+      scanState_.dictionary.numValues > 0 &&
+      scanState_.filterCache.size() >= scanState_.dictionary.numValues) {
+    dictionaryFilterCache_->put(
+        encodingKey_,
+        scanSpec_->filter(),
+        scanState_.dictionary,
+        std::move(scanState_.filterCache));
+  }
+}
+
 uint64_t SelectiveStringDictionaryColumnReader::skip(uint64_t numValues) {
   numValues = SelectiveColumnReader::skip(numValues);
   dictIndex_->skip(numValues);
@@ -333,7 +348,13 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
 
   loadDictionary(*blobStream_, *lengthDecoder_, scanState_.dictionary);
 
-  if (scanSpec_->hasFilter()) {
+  if (scanSpec_->hasFilter() &&
+      !(dictionaryFilterCache_ &&
+        dictionaryFilterCache_->get(
+            encodingKey_,
+            scanSpec_->filter(),
+            scanState_.dictionary,
+            scanState_.filterCache))) {
     scanState_.filterCache.resize(scanState_.dictionary.numValues);
     simd::memset(
         scanState_.filterCache.data(),
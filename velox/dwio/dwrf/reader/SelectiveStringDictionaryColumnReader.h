@@ -32,6 +32,8 @@ class SelectiveStringDictionaryColumnReader
       DwrfParams& params,
       common::ScanSpec& scanSpec);
 
+  ~SelectiveStringDictionaryColumnReader() override;
+
   void seekToRowGroup(uint32_t index) override {
     SelectiveColumnReader::seekToRowGroup(index);
     auto positionsProvider = formatData_->as<DwrfData>().seekToRowGroup(index);
@@ -105,6 +107,11 @@ class SelectiveStringDictionaryColumnReader
   std::unique_ptr<dwio::common::SeekableInputStream> blobStream_;
   bool initialized_{false};
   vector_size_t numRowsScanned_;
+
+  // Filter results of the stripe dictionary are passed through this to the
+  // reader of the next stripe. May be null.
+  const EncodingKey encodingKey_;
+  const std::shared_ptr<StringDictionaryFilterCache> dictionaryFilterCache_;
 };
 
 template <typename TVisitor>
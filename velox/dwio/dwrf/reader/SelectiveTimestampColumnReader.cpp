@@ -174,6 +174,9 @@ void SelectiveTimestampColumnReader::readHelper(
       processNulls(false, rows, rawNulls);
       break;
     case common::FilterKind::kTimestampRange:
+      processFilter(
+          static_cast<const common::TimestampRange*>(filter), rows, rawNulls);
+      break;
     case common::FilterKind::kMultiRange:
       processFilter(filter, rows, rawNulls);
       break;
@@ -213,8 +216,9 @@ void SelectiveTimestampColumnReader::processNulls(
   }
 }
 
+template <typename TFilter>
 void SelectiveTimestampColumnReader::processFilter(
-    const common::Filter* filter,
+    const TFilter* filter,
     const RowSet rows,
     const uint64_t* rawNulls) {
   auto rawTs = values_->asMutable<Timestamp>();
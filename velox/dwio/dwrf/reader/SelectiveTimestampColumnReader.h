@@ -46,8 +46,12 @@ class SelectiveTimestampColumnReader
 
   void
   processNulls(const bool isNull, const RowSet rows, const uint64_t* rawNulls);
+  // Applies 'filter' to the merged timestamps. 'TFilter' is the concrete
+  // filter class for the common filter kinds so the per row test is not a
+  // virtual call.
+  template <typename TFilter>
   void processFilter(
-      const common::Filter* filter,
+      const TFilter* filter,
       const RowSet rows,
       const uint64_t* rawNulls);
 
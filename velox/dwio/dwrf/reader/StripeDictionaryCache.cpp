@@ -16,6 +16,8 @@
 
 #include "velox/dwio/dwrf/reader/StripeDictionaryCache.h"
 
+#include "velox/dwio/common/SelectiveColumnReader.h"
+
 namespace facebook::velox::dwrf {
 StripeDictionaryCache::DictionaryEntry::DictionaryEntry(
     folly::Function<BufferPtr(velox::memory::MemoryPool*)>&& dictGen)
@@ -45,4 +47,71 @@ BufferPtr StripeDictionaryCache::getIntDictionary(const EncodingKey& ek) {
   return intDictionaryFactories_.at(ek)->getDictionaryBuffer(pool_);
 }
 
+namespace {
+bool sameDictionary(
+    const BufferPtr& values,
+    const BufferPtr& strings,
+    int32_t numValues,
+    const dwio::common::DictionaryValues& dictionary) {
+  if (numValues != dictionary.numValues ||
+      strings->size() != dictionary.strings->size()) {
+    return false;
+  }
+  auto* views = values->as<StringView>();
+  auto* otherViews = dictionary.values->as<StringView>();
+  for (auto i = 0; i < numValues; ++i) {
+    if (views[i].size() != otherViews[i].size()) {
+      return false;
+    }
+  }
+  return memcmp(
+             strings->as<char>(),
+             dictionary.strings->as<char>(),
+             strings->size()) == 0;
+}
+} // namespace
+
+bool StringDictionaryFilterCache::get(
+    const EncodingKey& ek,
+    const common::Filter* filter,
+    const dwio::common::DictionaryValues& dictionary,
+    raw_vector<uint8_t>& filterCache) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(ek);
+  if (it == entries_.end()) {
+    return false;
+  }
+  auto& entry = it->second;
+  const bool found = entry.filter == filter &&
+      sameDictionary(entry.values, entry.strings, entry.numValues, dictionary);
+  if (found) {
+    filterCache = std::move(entry.filterCache);
+  }
+  entries_.erase(it);
+  return found;
+}
+
+void StringDictionaryFilterCache::put(
+    const EncodingKey& ek,
+    const common::Filter* filter,
+    const dwio::common::DictionaryValues& dictionary,
+    raw_vector<uint8_t>&& filterCache) {
+  VELOX_DCHECK_GE(filterCache.size(), dictionary.numValues);
+  filterCache.resize(dictionary.numValues);
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.insert_or_assign(
+      ek,
+      Entry{
+          filter,
+          dictionary.values,
+          dictionary.strings,
+          dictionary.numValues,
+          std::move(filterCache)});
+}
+
+void StringDictionaryFilterCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+}
+
 } // namespace facebook::velox::dwrf
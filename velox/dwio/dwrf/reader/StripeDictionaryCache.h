@@ -16,14 +16,25 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <folly/Function.h>
 
 #include "folly/synchronization/CallOnce.h"
 #include "velox/common/base/GTestMacros.h"
+#include "velox/common/base/RawVector.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/vector/BaseVector.h"
 
+namespace facebook::velox::common {
+class Filter;
+}
+
+namespace facebook::velox::dwio::common {
+struct DictionaryValues;
+}
+
 namespace facebook::velox::dwrf {
 class StripeDictionaryCache {
   // This could be potentially made an interface to be shared for
@@ -63,4 +74,47 @@ class StripeDictionaryCache {
   VELOX_FRIEND_TEST(StripeDictionaryCacheTest, RegisterDictionary);
 };
 
+/// Filter results for the string dictionary entries of the last stripe of
+/// each column, kept by a row reader for the following stripes. Dictionaries
+/// are per stripe, but low cardinality columns often have the same dictionary
+/// in every stripe. A stripe with the same dictionary and filter as the
+/// previous one then starts from its filter results instead of testing each
+/// entry again.
+class StringDictionaryFilterCache {
+ public:
+  /// Moves the filter results for 'dictionary' of 'ek' into 'filterCache' if
+  /// the last stripe put results for the same 'filter' and an equal
+  /// dictionary. Returns true if found.
+  bool get(
+      const EncodingKey& ek,
+      const common::Filter* filter,
+      const dwio::common::DictionaryValues& dictionary,
+      raw_vector<uint8_t>& filterCache);
+
+  /// Keeps 'filterCache' with the results of 'filter' for the first
+  /// 'dictionary.numValues' entries. Replaces the results of earlier stripes.
+  void put(
+      const EncodingKey& ek,
+      const common::Filter* filter,
+      const dwio::common::DictionaryValues& dictionary,
+      raw_vector<uint8_t>&& filterCache);
+
+  /// Drops all results. Called when filters change.
+  void clear();
+
+ private:
+  struct Entry {
+    const common::Filter* filter;
+    BufferPtr values;
+    BufferPtr strings;
+    int32_t numValues;
+    raw_vector<uint8_t> filterCache;
+  };
+
+  // Readers of consecutive stripes may be destroyed and read on different
+  // threads.
+  std::mutex mutex_;
+  std::unordered_map<EncodingKey, Entry, EncodingKeyHash> entries_;
+};
+
 } // namespace facebook::velox::dwrf
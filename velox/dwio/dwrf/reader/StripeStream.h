@@ -138,6 +138,13 @@ class StripeStreams {
 
   virtual std::shared_ptr<StripeDictionaryCache> getStripeDictionaryCache() = 0;
 
+  /// Returns the filter results of string dictionaries kept across stripes,
+  /// or nullptr if these are not kept.
+  virtual std::shared_ptr<StringDictionaryFilterCache>
+  getStringDictionaryFilterCache() const {
+    return nullptr;
+  }
+
   /**
    * visit all streams of given node and execute visitor logic
    * return number of streams visited
@@ -205,12 +212,18 @@ class StripeStreamsBase : public StripeStreams {
 struct StripeReadState {
   std::shared_ptr<ReaderBase> readerBase;
   std::unique_ptr<const StripeMetadata> stripeMetadata;
+  // Filter results of string dictionaries shared by the stripes of a row
+  // reader. May be null.
+  std::shared_ptr<StringDictionaryFilterCache> stringDictionaryFilterCache;
 
   StripeReadState(
       std::shared_ptr<ReaderBase> readerBase,
-      std::unique_ptr<const StripeMetadata> stripeMetadata)
+      std::unique_ptr<const StripeMetadata> stripeMetadata,
+      std::shared_ptr<StringDictionaryFilterCache> stringDictionaryFilterCache =
+          nullptr)
       : readerBase{std::move(readerBase)},
-        stripeMetadata{std::move(stripeMetadata)} {}
+        stripeMetadata{std::move(stripeMetadata)},
+        stringDictionaryFilterCache{std::move(stringDictionaryFilterCache)} {}
 };
 
 /**
@@ -321,6 +334,11 @@ class StripeStreamsImpl : public StripeStreamsBase {
     return provider_;
   }
 
+  std::shared_ptr<StringDictionaryFilterCache> getStringDictionaryFilterCache()
+      const override {
+    return readState_->stringDictionaryFilterCache;
+  }
+
   int64_t stripeRows() const override {
     VELOX_CHECK_NE(stripeNumberOfRows_, kUnknownStripeRows);
     return stripeNumberOfRows_;
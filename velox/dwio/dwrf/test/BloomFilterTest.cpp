@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwrf;
+
+TEST(BloomFilterTest, integers) {
+  BloomFilter filter(1024, 3);
+  for (int64_t i = 0; i < 50; ++i) {
+    filter.addHash(BloomFilter::hash(i * 7));
+  }
+  // Negative values hash to negative combined positions.
+  filter.addHash(BloomFilter::hash(-1));
+  for (int64_t i = 0; i < 50; ++i) {
+    EXPECT_TRUE(filter.testHash(BloomFilter::hash(i * 7)));
+  }
+  EXPECT_TRUE(filter.testHash(BloomFilter::hash(-1)));
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 10'000; ++i) {
+    numFalsePositives += filter.testHash(BloomFilter::hash(1'000'000 + i));
+  }
+  // 51 values in 1K bits with 3 hash functions pass about 0.3% of others.
+  EXPECT_LT(numFalsePositives, 200);
+}
+
+TEST(BloomFilterTest, strings) {
+  BloomFilter filter(512, 4);
+  std::vector<std::string> values = {
+      "apple", "banana", "", "a string longer than sixteen bytes"};
+  for (const auto& value : values) {
+    filter.addHash(BloomFilter::hash(std::string_view(value)));
+  }
+  for (const auto& value : values) {
+    EXPECT_TRUE(filter.testHash(BloomFilter::hash(std::string_view(value))));
+  }
+  EXPECT_FALSE(filter.testHash(BloomFilter::hash("durian")));
+  EXPECT_NE(BloomFilter::hash("ab"), BloomFilter::hash("ba"));
+}
+
+TEST(BloomFilterTest, fromProto) {
+  BloomFilter filter(256, 3);
+  filter.addHash(BloomFilter::hash(123));
+  proto::BloomFilter utf8Proto;
+  filter.serialize(utf8Proto);
+  EXPECT_EQ(3, utf8Proto.numhashfunctions());
+  EXPECT_EQ(256 / 8, utf8Proto.utf8bitset().size());
+
+  BloomFilter utf8Filter(utf8Proto);
+  EXPECT_TRUE(utf8Filter.testHash(BloomFilter::hash(123)));
+  EXPECT_FALSE(utf8Filter.testHash(BloomFilter::hash(124)));
+
+  // The same bits as repeated fixed64.
+  proto::BloomFilter longsProto;
+  longsProto.set_numhashfunctions(3);
+  const auto* words =
+      reinterpret_cast<const uint64_t*>(utf8Proto.utf8bitset().data());
+  for (auto i = 0; i < 4; ++i) {
+    longsProto.add_bitset(words[i]);
+  }
+  BloomFilter longsFilter(longsProto);
+  EXPECT_TRUE(longsFilter.testHash(BloomFilter::hash(123)));
+  EXPECT_FALSE(longsFilter.testHash(BloomFilter::hash(124)));
+
+  // An empty filter passes everything.
+  BloomFilter emptyFilter{proto::BloomFilter()};
+  EXPECT_TRUE(emptyFilter.testHash(BloomFilter::hash(124)));
+}
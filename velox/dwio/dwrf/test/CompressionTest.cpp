@@ -17,6 +17,9 @@
 #include "velox/dwio/dwrf/common/Compression.h"
 #include "velox/common/base/VeloxException.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/dwio/common/compression/PagedInputStream.h"
 #include "velox/dwio/common/encryption/TestProvider.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
@@ -36,6 +39,7 @@ using namespace facebook::velox::dwio::common::encryption::test;
 using namespace facebook::velox::dwrf;
 using namespace facebook::velox::memory;
 using facebook::velox::VeloxException;
+using facebook::velox::cache::AsyncDataCache;
 
 const int32_t DEFAULT_MEM_STREAM_SIZE = 1024 * 1024 * 2; // 2M
 
@@ -475,3 +479,100 @@ TEST(CompressionOptionsTest, testCompressionOptions) {
   EXPECT_EQ(options.format.zstd.compressionLevel, 7);
   EXPECT_EQ(options.compressionThreshold, 256);
 }
+
+namespace {
+// Reads a memory range as if it were at the start of file 'fileNum' cached in
+// 'cache'.
+class CachedArrayInputStream : public SeekableArrayInputStream {
+ public:
+  CachedArrayInputStream(
+      const char* data,
+      uint64_t length,
+      AsyncDataCache* cache,
+      uint64_t fileNum)
+      : SeekableArrayInputStream(data, length),
+        cache_(cache),
+        fileNum_(fileNum) {}
+
+  AsyncDataCache* cacheKey(
+      uint64_t position,
+      facebook::velox::cache::RawFileCacheKey& key) const override {
+    key = {fileNum_, position};
+    return cache_;
+  }
+
+ private:
+  AsyncDataCache* const cache_;
+  const uint64_t fileNum_;
+};
+} // namespace
+
+class DecompressedPageCacheTest : public Test {
+ protected:
+  static void SetUpTestCase() {
+    MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    cache_ = AsyncDataCache::create(memoryManager()->allocator());
+  }
+
+  void TearDown() override {
+    FLAGS_velox_cache_decompressed_pages = false;
+    cache_->shutdown();
+  }
+
+  std::shared_ptr<MemoryPool> pool_ = memoryManager()->addLeafPool();
+  std::shared_ptr<AsyncDataCache> cache_;
+};
+
+TEST_F(DecompressedPageCacheTest, repeatedReads) {
+  FLAGS_velox_cache_decompressed_pages = true;
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool_.get()});
+  constexpr uint64_t kBlock = 64 << 10;
+  constexpr size_t kSize = 256 << 10;
+  std::vector<char> data(kSize);
+  generateRandomData(data.data(), kSize, true);
+  compressAndVerify(
+      CompressionKind_ZSTD,
+      memSink,
+      kBlock,
+      *pool_,
+      data.data(),
+      kSize,
+      nullptr);
+  facebook::velox::StringIdLease fileId(
+      facebook::velox::fileIds(), "decompressedPageCacheTest");
+
+  int64_t numPages = 0;
+  for (int32_t i = 0; i < 2; ++i) {
+    auto stream = createDecompressor(
+        CompressionKind_ZSTD,
+        std::make_unique<CachedArrayInputStream>(
+            memSink.data(), memSink.size(), cache_.get(), fileId.id()),
+        kBlock,
+        *pool_,
+        "DecompressedPageCacheTest");
+    const char* buffer;
+    int32_t size;
+    size_t pos = 0;
+    while (stream->Next(reinterpret_cast<const void**>(&buffer), &size)) {
+      ASSERT_LE(pos + size, kSize);
+      ASSERT_EQ(0, memcmp(data.data() + pos, buffer, size));
+      pos += size;
+    }
+    ASSERT_EQ(kSize, pos);
+
+    const auto stats = cache_->refreshStats();
+    if (i == 0) {
+      // Every page is decompressed and added to the cache.
+      numPages = stats.numNew;
+      ASSERT_GE(numPages, kSize / kBlock);
+      ASSERT_EQ(0, stats.numHit);
+    } else {
+      // Every page comes from the cache.
+      ASSERT_EQ(numPages, stats.numNew);
+      ASSERT_EQ(numPages, stats.numHit);
+    }
+  }
+}
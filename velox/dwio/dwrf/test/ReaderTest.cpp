@@ -2644,6 +2644,49 @@ createWriterReader(
 
 } // namespace
 
+TEST_F(TestReader, estimatedSizeFromResults) {
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(1'000, folly::identity),
+      makeFlatVector<std::string>(
+          1'000, [](auto row) { return std::string(200, 'a' + row % 26); }),
+  });
+  auto [writer, reader] = createWriterReader({batch}, pool());
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*batch->type());
+  spec->childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(0, 1'000, false));
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+
+  // The string column is lazy. The estimate counts it only once it is
+  // loaded.
+  auto readBatches = [&](bool loadStrings) {
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    const auto statsEstimate = rowReader->estimatedRowSize();
+    ASSERT_TRUE(statsEstimate.has_value());
+    VectorPtr result = BaseVector::create(batch->type(), 0, pool());
+    std::optional<size_t> rowSize;
+    for (auto i = 0; i < 3; ++i) {
+      ASSERT_EQ(rowReader->next(100, result), 100);
+      rowSize = rowReader->estimatedRowSize();
+      if (i == 0) {
+        ASSERT_EQ(rowSize, statsEstimate);
+      }
+      if (loadStrings) {
+        result->as<RowVector>()->childAt(1)->loadedVector();
+      }
+    }
+    ASSERT_TRUE(rowSize.has_value());
+    if (loadStrings) {
+      ASSERT_GT(rowSize.value(), 200);
+    } else {
+      ASSERT_LT(rowSize.value(), 50);
+    }
+  };
+  readBatches(true);
+  readBatches(false);
+}
+
 TEST_F(TestReader, appendRowNumberColumn) {
   std::vector<std::vector<int32_t>> integerValues{
       {0, 1, 2, 3, 4},
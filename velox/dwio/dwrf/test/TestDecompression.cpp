@@ -388,6 +388,33 @@ TEST_F(DecompressionTest, testLzoLong) {
   ASSERT_TRUE(!result->Next(&ptr, &length));
 }
 
+TEST_F(DecompressionTest, testLzoWideMatch) {
+  // A 32 byte literal followed by a 64 byte match at offset 32, which repeats
+  // the literal twice with overlapping 16 byte copies.
+  std::vector<unsigned char> buffer = {80, 0, 0, 17 + 32};
+  for (auto i = 0; i < 32; ++i) {
+    buffer.push_back('A' + i);
+  }
+  // Match length 64 = 2 + 31 + 31, offset 32 = (31 << 2 >> 2) + 1.
+  const std::vector<unsigned char> tail = {32, 31, 31 << 2, 0, 17, 0, 0};
+  buffer.insert(buffer.end(), tail.begin(), tail.end());
+  ASSERT_EQ(buffer.size(), 3 + (80 >> 1));
+
+  std::unique_ptr<SeekableInputStream> result = createTestDecompressor(
+      CompressionKind_LZO,
+      std::unique_ptr<SeekableInputStream>(
+          new SeekableArrayInputStream(buffer.data(), buffer.size())),
+      128 * 1024);
+  const void* ptr;
+  int32_t length;
+  ASSERT_EQ(true, result->Next(&ptr, &length));
+  ASSERT_EQ(96, length);
+  for (auto i = 0; i < length; ++i) {
+    ASSERT_EQ('A' + i % 32, static_cast<const char*>(ptr)[i]);
+  }
+  ASSERT_TRUE(!result->Next(&ptr, &length));
+}
+
 TEST_F(DecompressionTest, testLz4Empty) {
   const unsigned char buffer[] = {0};
   std::unique_ptr<SeekableInputStream> result = createTestDecompressor(
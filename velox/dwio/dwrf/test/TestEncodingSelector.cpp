@@ -44,6 +44,10 @@ TEST_F(EntropyEncodingSelectorTests, Ctor) {
       EntropyEncodingSelector(*pool, 0.5f, 0.5f, 0, slightlyOver, 0));
   EXPECT_ANY_THROW(
       EntropyEncodingSelector(*pool, 0.5f, 0.5f, 0, slightlyUnder, 0));
+  EXPECT_ANY_THROW(
+      EntropyEncodingSelector(*pool, 0.5f, 0.5f, 0, 0.01, 0, slightlyOver));
+  EXPECT_ANY_THROW(
+      EntropyEncodingSelector(*pool, 0.5f, 0.5f, 0, 0.01, 0, slightlyUnder));
 }
 
 class EntropyEncodingSelectorTest {
@@ -218,4 +222,27 @@ TEST_F(EntropyEncodingSelectorTests, Sampling) {
   }
 }
 
+TEST_F(EntropyEncodingSelectorTests, SizeReduction) {
+  auto pool = memoryManager()->addLeafPool();
+  auto useDictionary = [&](const std::vector<std::string>& values,
+                           float sizeReductionThreshold) {
+    StringDictionaryEncoder dictEncoder{*pool, *pool};
+    for (const auto& value : values) {
+      dictEncoder.addKey(value, 0);
+    }
+    EntropyEncodingSelector selector{
+        *pool, 1.0f, 0.0f, 0, 0.0f, 0, sizeReductionThreshold};
+    return selector.useDictionary(dictEncoder, values.size());
+  };
+
+  // Short repeated values are as large with a dictionary as without.
+  const std::vector<std::string> shortValues{"a", "b", "a", "b"};
+  EXPECT_TRUE(useDictionary(shortValues, 0.0f));
+  EXPECT_FALSE(useDictionary(shortValues, 0.1f));
+
+  const std::vector<std::string> longValues(10, "a long repeated value");
+  EXPECT_TRUE(useDictionary(longValues, 0.5f));
+  EXPECT_FALSE(useDictionary(longValues, 0.9f));
+}
+
 } // namespace facebook::velox::dwrf
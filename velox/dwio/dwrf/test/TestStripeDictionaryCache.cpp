@@ -18,8 +18,10 @@
 #include <gtest/gtest.h>
 
 #include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/SelectiveColumnReader.h"
 #include "velox/dwio/dwrf/reader/StripeDictionaryCache.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
+#include "velox/type/Filter.h"
 
 using namespace ::testing;
 
@@ -55,6 +57,27 @@ void verifyRange(BufferPtr bufferPtr, int64_t begin, int64_t end) {
   EXPECT_THAT(actualRange, ElementsAreArray(expectedRange));
 }
 
+dwio::common::DictionaryValues makeStringDictionary(
+    const std::vector<std::string>& values,
+    memory::MemoryPool* pool) {
+  dwio::common::DictionaryValues dictionary;
+  dictionary.numValues = values.size();
+  dictionary.values = AlignedBuffer::allocate<StringView>(values.size(), pool);
+  int32_t numBytes = 0;
+  for (const auto& value : values) {
+    numBytes += value.size();
+  }
+  dictionary.strings = AlignedBuffer::allocate<char>(numBytes, pool);
+  auto* views = dictionary.values->asMutable<StringView>();
+  auto* strings = dictionary.strings->asMutable<char>();
+  for (auto i = 0; i < values.size(); ++i) {
+    memcpy(strings, values[i].data(), values[i].size());
+    views[i] = StringView(strings, values[i].size());
+    strings += values[i].size();
+  }
+  return dictionary;
+}
+
 class StripeDictionaryCacheTest : public testing::Test {
  protected:
   static void SetUpTestCase() {
@@ -133,4 +156,52 @@ TEST_F(StripeDictionaryCacheTest, GetDictionaryBuffer) {
     EXPECT_ANY_THROW(cache.getIntDictionary({2, 0}));
   }
 }
+
+TEST_F(StripeDictionaryCacheTest, StringDictionaryFilterResults) {
+  StringDictionaryFilterCache cache;
+  auto filter = std::make_unique<common::BytesValues>(
+      std::vector<std::string>{"b"}, false);
+  auto dictionary = makeStringDictionary({"a", "b", "cd"}, pool_.get());
+  raw_vector<uint8_t> results;
+  EXPECT_FALSE(cache.get({1, 0}, filter.get(), dictionary, results));
+
+  auto putResults = [&](const dwio::common::DictionaryValues& values) {
+    // Results for a stride dictionary after the stripe dictionary are not
+    // kept.
+    raw_vector<uint8_t> filterCache;
+    filterCache.resize(values.numValues + 1);
+    for (auto i = 0; i < filterCache.size(); ++i) {
+      filterCache[i] = i + 1;
+    }
+    cache.put({1, 0}, filter.get(), values, std::move(filterCache));
+  };
+
+  // The results are found for an equal dictionary once.
+  putResults(dictionary);
+  auto sameDictionary = makeStringDictionary({"a", "b", "cd"}, pool_.get());
+  EXPECT_FALSE(cache.get({2, 0}, filter.get(), sameDictionary, results));
+  EXPECT_TRUE(cache.get({1, 0}, filter.get(), sameDictionary, results));
+  ASSERT_EQ(3, results.size());
+  EXPECT_EQ(1, results[0]);
+  EXPECT_EQ(3, results[2]);
+  EXPECT_FALSE(cache.get({1, 0}, filter.get(), sameDictionary, results));
+
+  // Same bytes in different values.
+  putResults(dictionary);
+  EXPECT_FALSE(cache.get(
+      {1, 0},
+      filter.get(),
+      makeStringDictionary({"ab", "c", "d"}, pool_.get()),
+      results));
+
+  // Different filter.
+  putResults(dictionary);
+  auto otherFilter = std::make_unique<common::BytesValues>(
+      std::vector<std::string>{"b"}, false);
+  EXPECT_FALSE(cache.get({1, 0}, otherFilter.get(), dictionary, results));
+
+  putResults(dictionary);
+  cache.clear();
+  EXPECT_FALSE(cache.get({1, 0}, filter.get(), dictionary, results));
+}
 } // namespace facebook::velox::dwrf
@@ -18,6 +18,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "folly/Random.h"
+#include "folly/executors/CPUThreadPoolExecutor.h"
 #include "velox/common/base/tests/GTestUtils.h"
 
 using namespace ::testing;
@@ -511,3 +512,35 @@ TEST_F(WriterSinkTest, SetModeOutOfOrder) {
   sink.addBuffer(*pool, data.data(), 10);
   ASSERT_EQ(sink.getChecksum()->getDigest(false), 977966233);
 }
+
+TEST_F(WriterSinkTest, backgroundWrite) {
+  auto pool = memoryManager()->addLeafPool();
+  std::string file;
+  WriteFileSink out{
+      std::make_unique<facebook::velox::InMemoryWriteFile>(&file), "test"};
+  ASSERT_FALSE(out.isBuffered());
+  Config config;
+  config.set(Config::CHECKSUM_ALGORITHM, proto::ChecksumAlgorithm::NULL_);
+  config.set(Config::STRIPE_CACHE_MODE, StripeCacheMode::NA);
+  folly::CPUThreadPoolExecutor executor(1);
+  WriterSink sink{out, *pool, config, &executor};
+  sink.init(*pool);
+  constexpr int32_t kNumFlushes = 10;
+  for (auto i = 0; i < kNumFlushes; ++i) {
+    sink.addBuffer(*pool, data.data(), data.size());
+    ASSERT_EQ(sink.size(), ORC_MAGIC_LEN + (i + 1) * data.size());
+    sink.flush();
+    ASSERT_EQ(sink.size(), ORC_MAGIC_LEN + (i + 1) * data.size());
+  }
+  sink.waitForWrite();
+  ASSERT_EQ(out.size(), ORC_MAGIC_LEN + kNumFlushes * data.size());
+  ASSERT_EQ(file.size(), out.size());
+  for (auto i = 0; i < kNumFlushes; ++i) {
+    ASSERT_EQ(
+        0,
+        std::memcmp(
+            file.data() + ORC_MAGIC_LEN + i * data.size(),
+            data.data(),
+            data.size()));
+  }
+}
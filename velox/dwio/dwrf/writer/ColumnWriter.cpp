@@ -806,7 +806,8 @@ class StringColumnWriter : public BaseColumnWriter {
             getConfig(Config::ENTROPY_KEY_STRING_SIZE_THRESHOLD),
             getConfig(Config::ENTROPY_STRING_MIN_SAMPLES),
             getConfig(Config::ENTROPY_STRING_DICT_SAMPLE_FRACTION),
-            getConfig(Config::ENTROPY_STRING_THRESHOLD)},
+            getConfig(Config::ENTROPY_STRING_THRESHOLD),
+            getConfig(Config::DICTIONARY_STRING_SIZE_REDUCTION_THRESHOLD)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
         useDictionaryEncoding_{useDictionaryEncoding()},
         strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
@@ -31,19 +31,23 @@ class EntropyEncodingSelector {
       const float entropyKeySizeThreshold,
       const size_t entropyMinSamples,
       const float entropyDictSampleFraction,
-      const size_t entropyThreshold)
+      const size_t entropyThreshold,
+      const float sizeReductionThreshold = 0.0f)
       : pool_{pool},
         dictionaryKeySizeThreshold_{dictionaryKeySizeThreshold},
         entropyKeySizeThreshold_{entropyKeySizeThreshold},
         entropyMinSamples_{entropyMinSamples},
         entropyDictSampleFraction_{entropyDictSampleFraction},
-        entropyThreshold_{entropyThreshold} {
+        entropyThreshold_{entropyThreshold},
+        sizeReductionThreshold_{sizeReductionThreshold} {
     DWIO_ENSURE_GE(1.0f, dictionaryKeySizeThreshold_);
     DWIO_ENSURE_LE(0.0f, dictionaryKeySizeThreshold_);
     DWIO_ENSURE_GE(1.0f, entropyKeySizeThreshold_);
     DWIO_ENSURE_LE(0.0f, entropyKeySizeThreshold_);
     DWIO_ENSURE_GE(1.0f, entropyDictSampleFraction_);
     DWIO_ENSURE_LE(0.0f, entropyDictSampleFraction_);
+    DWIO_ENSURE_GE(1.0f, sizeReductionThreshold_);
+    DWIO_ENSURE_LE(0.0f, sizeReductionThreshold_);
   }
 
   // NOTE: some inclusiveness of inequality in this method is flipped to grant
@@ -67,6 +71,16 @@ class EntropyEncodingSelector {
       return false;
     }
 
+    // Dictionary encoding costs more CPU than direct encoding. Keep it only if
+    // it is estimated to save at least 'sizeReductionThreshold_' of the direct
+    // encoded size.
+    if (sizeReductionThreshold_ > 0.0f &&
+        estimatedDictionarySize(dictEncoder, valueCount) >
+            (1.0f - sizeReductionThreshold_) *
+                estimatedDirectSize(dictEncoder, valueCount)) {
+      return false;
+    }
+
     // If the number of repeated values is small enough, consider using the
     // entropy heuristic If the number of repeated values is high, even in the
     // presence of low entropy, dictionary encoding can provide benefits beyond
@@ -77,6 +91,41 @@ class EntropyEncodingSelector {
   }
 
  private:
+  // Number of bytes of 'value' as a varint.
+  static uint64_t varintSize(uint64_t value) {
+    uint64_t size = 1;
+    while (value >= 0x80) {
+      value >>= 7;
+      ++size;
+    }
+    return size;
+  }
+
+  // Estimates the uncompressed size of the DATA and LENGTH streams with direct
+  // encoding. Lengths are assumed to take one byte per value.
+  static uint64_t estimatedDirectSize(
+      const StringDictionaryEncoder& dictEncoder,
+      uint64_t valueCount) {
+    uint64_t size = valueCount;
+    for (uint32_t i = 0; i < dictEncoder.size(); ++i) {
+      size += dictEncoder.getKey(i).size() * dictEncoder.getCount(i);
+    }
+    return size;
+  }
+
+  // Estimates the uncompressed size of the DICTIONARY_DATA, LENGTH and DATA
+  // streams with dictionary encoding. Each index takes the varint size of the
+  // largest index.
+  static uint64_t estimatedDictionarySize(
+      const StringDictionaryEncoder& dictEncoder,
+      uint64_t valueCount) {
+    uint64_t size = dictEncoder.size();
+    for (uint32_t i = 0; i < dictEncoder.size(); ++i) {
+      size += dictEncoder.getKey(i).size();
+    }
+    return size + valueCount * varintSize(dictEncoder.size());
+  }
+
   bool useDictionaryEncodingEntropyHeuristic(
       const StringDictionaryEncoder& dictEncoder) const {
     std::unordered_set<char> charSet;
@@ -157,6 +206,7 @@ class EntropyEncodingSelector {
   const size_t entropyMinSamples_;
   const float entropyDictSampleFraction_;
   const size_t entropyThreshold_;
+  const float sizeReductionThreshold_;
 };
 
 } // namespace facebook::velox::dwrf
@@ -70,7 +70,8 @@ Writer::Writer(
                                     *options.encryptionSpec,
                                     options.encrypterFactory.get())
                               : nullptr);
-  writerBase_->initContext(options.config, pool, std::move(handler));
+  writerBase_->initContext(
+      options.config, pool, std::move(handler), options.sinkWriteExecutor);
 
   auto& context = writerBase_->getContext();
   VELOX_CHECK_EQ(
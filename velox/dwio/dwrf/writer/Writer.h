@@ -47,6 +47,9 @@ struct WriterOptions {
   std::shared_ptr<encryption::EncryptionSpecification> encryptionSpec;
   std::shared_ptr<dwio::common::encryption::EncrypterFactory> encrypterFactory;
   int64_t memoryBudget = std::numeric_limits<int64_t>::max();
+  /// If set, stripes are written to the sink on this executor while the next
+  /// stripe is encoded.
+  folly::Executor* sinkWriteExecutor{nullptr};
   std::function<std::unique_ptr<ColumnWriter>(
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
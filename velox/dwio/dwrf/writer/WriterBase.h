@@ -34,6 +34,7 @@ class WriterBase {
   virtual void close() {
     if (writerSink_) {
       writerSink_->flush();
+      writerSink_->waitForWrite();
     }
     sink_->close();
   }
@@ -74,13 +75,15 @@ class WriterBase {
   void initContext(
       const std::shared_ptr<const Config>& config,
       std::shared_ptr<velox::memory::MemoryPool> pool,
-      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr) {
+      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr,
+      folly::Executor* sinkExecutor = nullptr) {
     context_ = std::make_unique<WriterContext>(
         config, std::move(pool), sink_->metricsLog(), std::move(handler));
     writerSink_ = std::make_unique<WriterSink>(
         *sink_,
         context_->getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
-        context_->getConfigs());
+        context_->getConfigs(),
+        sinkExecutor);
   }
 
   void initBuffers();
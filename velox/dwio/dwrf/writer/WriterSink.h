@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <folly/container/Array.h>
+#include <folly/futures/Future.h>
 
 #include "velox/dwio/common/DataBufferHolder.h"
 #include "velox/dwio/dwrf/common/Checksum.h"
@@ -39,8 +41,10 @@ class WriterSink {
   WriterSink(
       dwio::common::FileSink& sink,
       memory::MemoryPool& pool,
-      const Config& configs)
+      const Config& configs,
+      folly::Executor* executor = nullptr)
       : sink_{&sink},
+        executor_{executor},
         checksum_{
             ChecksumFactory::create(configs.get(Config::CHECKSUM_ALGORITHM))},
         cacheMode_{configs.get(Config::STRIPE_CACHE_MODE)},
@@ -53,6 +57,11 @@ class WriterSink {
         exceedsLimit_{false} {}
 
   ~WriterSink() {
+    try {
+      waitForWrite();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed background write in writer sink: " << e.what();
+    }
     if (!buffers_.empty() || size_ != 0) {
       LOG(WARNING) << "Unflushed data in writer sink: " << succinctBytes(size_)
                    << ", " << buffers_.size() << " buffers";
@@ -60,7 +69,7 @@ class WriterSink {
   }
 
   uint64_t size() const {
-    return sink_->size() + size_;
+    return (pendingWrite_.valid() ? pendingWriteEnd_ : sink_->size()) + size_;
   }
 
   void init(memory::MemoryPool& pool);
@@ -81,12 +90,39 @@ class WriterSink {
     other.clear();
   }
 
+  /// Writes the buffered data to the file sink. If 'executor_' is set, the
+  /// write runs on it and overlaps with encoding the next stripe. The buffers
+  /// of at most one write are in flight, so a flush waits for the previous
+  /// one.
   void flush() {
-    sink_->write(buffers_);
+    waitForWrite();
+    if (executor_ == nullptr || buffers_.empty()) {
+      sink_->write(buffers_);
+      buffers_.clear();
+      size_ = 0;
+      return;
+    }
+    pendingWriteEnd_ = sink_->size() + size_;
+    pendingWrite_ = folly::via(
+                        executor_,
+                        [this, buffers = std::move(buffers_)]() mutable {
+                          sink_->write(buffers);
+                        })
+                        .semi();
     buffers_.clear();
     size_ = 0;
   }
 
+  /// Waits for the background write started by flush(), if any. Throws the
+  /// error of the write if it failed.
+  void waitForWrite() {
+    if (pendingWrite_.valid()) {
+      auto pendingWrite = std::move(pendingWrite_);
+      pendingWrite_ = folly::SemiFuture<folly::Unit>::makeEmpty();
+      std::move(pendingWrite).get();
+    }
+  }
+
   Checksum* getChecksum() {
     return checksum_.get();
   }
@@ -166,6 +202,7 @@ class WriterSink {
   }
 
   dwio::common::FileSink* const sink_;
+  folly::Executor* const executor_;
   const std::unique_ptr<Checksum> checksum_;
   const StripeCacheMode cacheMode_;
   const bool shouldBuffer_;
@@ -182,6 +219,12 @@ class WriterSink {
   bool exceedsLimit_;
 
   std::vector<dwio::common::DataBuffer<char>> buffers_;
+
+  // The background write of the previous flush and the size of the file sink
+  // once it completes.
+  folly::SemiFuture<folly::Unit> pendingWrite_{
+      folly::SemiFuture<folly::Unit>::makeEmpty()};
+  uint64_t pendingWriteEnd_{0};
 };
 
 } // namespace facebook::velox::dwrf
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/common/BloomFilter.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include <cmath>
+
+namespace facebook::velox::parquet {
+
+namespace {
+// Salt values from the Parquet specification used for setting one bit in each
+// word of a block.
+constexpr uint32_t kSalt[SplitBlockBloomFilter::kWordsPerBlock] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+inline uint32_t bitInWord(uint32_t key, int32_t word) {
+  return 1U << ((key * kSalt[word]) >> 27);
+}
+} // namespace
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(BufferPtr bitset)
+    : bitset_(std::move(bitset)),
+      numBlocks_(bitset_->size() / kBytesPerBlock) {
+  VELOX_CHECK_GT(numBlocks_, 0);
+  VELOX_CHECK_EQ(bitset_->size() % kBytesPerBlock, 0);
+}
+
+// static
+std::unique_ptr<SplitBlockBloomFilter> SplitBlockBloomFilter::create(
+    int32_t numBytes,
+    memory::MemoryPool& pool) {
+  auto bitset = AlignedBuffer::allocate<char>(numBytes, &pool, 0);
+  return std::make_unique<SplitBlockBloomFilter>(std::move(bitset));
+}
+
+bool SplitBlockBloomFilter::findHash(uint64_t hash) const {
+  const auto* words =
+      bitset_->as<uint32_t>() + blockOffset(hash, numBlocks_);
+  const uint32_t key = hash;
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    if ((words[i] & bitInWord(key, i)) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SplitBlockBloomFilter::insertHash(uint64_t hash) {
+  insertHash(hash, bitset_->asMutable<char>(), bitset_->size());
+}
+
+// static
+void SplitBlockBloomFilter::insertHash(
+    uint64_t hash,
+    char* bitset,
+    int32_t numBytes) {
+  auto* words = reinterpret_cast<uint32_t*>(bitset) +
+      blockOffset(hash, numBytes / kBytesPerBlock);
+  const uint32_t key = hash;
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    words[i] |= bitInWord(key, i);
+  }
+}
+
+// static
+int32_t SplitBlockBloomFilter::optimalNumBytes(
+    int64_t numDistinct,
+    double fpp,
+    int32_t maxBytes) {
+  VELOX_CHECK(fpp > 0 && fpp < 1, "Invalid false positive probability");
+  VELOX_CHECK_GE(maxBytes, kBytesPerBlock);
+  // Bits per value for a filter where each value sets one bit in each of the
+  // kWordsPerBlock words of a block.
+  const double numBits = -8.0 * std::max<int64_t>(numDistinct, 1) /
+      std::log(1 - std::pow(fpp, 1.0 / kWordsPerBlock));
+  int32_t numBytes = kBytesPerBlock;
+  while (numBytes < numBits / 8 && numBytes <= maxBytes / 2) {
+    numBytes *= 2;
+  }
+  return numBytes;
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(int32_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(float value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(double value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/buffer/Buffer.h"
+
+#include <string_view>
+
+namespace facebook::velox::parquet {
+
+/// Split block Bloom filter as specified by the Parquet format. The bitset is
+/// divided into blocks of 8 32-bit words. A value sets one bit in each word of
+/// one block. Values are hashed with 64-bit xxHash of their plain encoding.
+class SplitBlockBloomFilter {
+ public:
+  static constexpr int32_t kBytesPerBlock = 32;
+  static constexpr int32_t kWordsPerBlock = 8;
+
+  /// Makes a filter over the bitset in 'bitset'. The size of 'bitset' must be
+  /// a multiple of kBytesPerBlock.
+  explicit SplitBlockBloomFilter(BufferPtr bitset);
+
+  /// Makes an empty filter of 'numBytes' for writing.
+  static std::unique_ptr<SplitBlockBloomFilter> create(
+      int32_t numBytes,
+      memory::MemoryPool& pool);
+
+  /// Returns false if no value with 'hash' was inserted. False positives are
+  /// possible.
+  bool findHash(uint64_t hash) const;
+
+  void insertHash(uint64_t hash);
+
+  /// Sets the bits for 'hash' in the 'numBytes' of 'bitset'. For writers that
+  /// own the memory of the filter.
+  static void insertHash(uint64_t hash, char* bitset, int32_t numBytes);
+
+  /// Returns the size of a filter for 'numDistinct' values with a false
+  /// positive probability of at most 'fpp'. The size is a power of 2 between
+  /// kBytesPerBlock and 'maxBytes'.
+  static int32_t optimalNumBytes(
+      int64_t numDistinct,
+      double fpp,
+      int32_t maxBytes);
+
+  const char* data() const {
+    return bitset_->as<char>();
+  }
+
+  int32_t numBytes() const {
+    return bitset_->size();
+  }
+
+  static uint64_t hash(int32_t value);
+
+  static uint64_t hash(int64_t value);
+
+  static uint64_t hash(float value);
+
+  static uint64_t hash(double value);
+
+  static uint64_t hash(std::string_view value);
+
+ private:
+  // Returns the index of the first word of the block that 'hash' maps to.
+  static uint64_t blockOffset(uint64_t hash, uint64_t numBlocks) {
+    return ((hash >> 32) * numBlocks >> 32) * kWordsPerBlock;
+  }
+
+  BufferPtr bitset_;
+  const uint64_t numBlocks_;
+};
+
+} // namespace facebook::velox::parquet
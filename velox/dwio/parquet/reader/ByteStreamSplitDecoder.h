@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::parquet {
+
+/// Decoder for BYTE_STREAM_SPLIT. For N values of K bytes the page holds K
+/// streams of N bytes, stream k having byte k of each value.
+class ByteStreamSplitDecoder {
+ public:
+  ByteStreamSplitDecoder(const char* start, const char* end, int32_t valueWidth)
+      : bufferStart_(start),
+        valueWidth_(valueWidth),
+        numValues_((end - start) / valueWidth) {
+    VELOX_CHECK_EQ(
+        (end - start) % valueWidth,
+        0,
+        "BYTE_STREAM_SPLIT data size is not a multiple of the value width");
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_DCHECK_LE(index_ + numValues, numValues_);
+    index_ += numValues;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip =
+            visitor.process(readValue<typename Visitor::DataType>(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  /// Returns the next value, gathering its bytes from the streams.
+  template <typename T>
+  T readValue() {
+    VELOX_DCHECK_EQ(sizeof(T), valueWidth_);
+    VELOX_DCHECK_LT(index_, numValues_);
+    T value;
+    auto bytes = reinterpret_cast<char*>(&value);
+    for (auto i = 0; i < sizeof(T); ++i) {
+      bytes[i] = bufferStart_[i * numValues_ + index_];
+    }
+    ++index_;
+    return value;
+  }
+
+ private:
+  const char* const bufferStart_;
+  const int32_t valueWidth_;
+  const int64_t numValues_;
+  int64_t index_{0};
+};
+
+} // namespace facebook::velox::parquet
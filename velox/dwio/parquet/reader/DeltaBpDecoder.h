@@ -43,6 +43,26 @@ class DeltaBpDecoder {
     }
   }
 
+  /// Returns the number of values in the encoded data.
+  uint64_t numValues() const {
+    return totalValueCount_;
+  }
+
+  /// Returns the next value.
+  int64_t next() {
+    return readLong();
+  }
+
+  /// Returns the first byte after the encoded data. Must be called after all
+  /// values have been read. The last miniblock is padded to its full size and
+  /// the miniblocks after it in the same block are not stored.
+  const char* bufferEnd() const {
+    if (firstBlockInitialized_ && valuesRemainingCurrentMiniBlock_ > 0) {
+      return bufferStart_ + bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
+    }
+    return bufferStart_;
+  }
+
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     int32_t current = visitor.start();
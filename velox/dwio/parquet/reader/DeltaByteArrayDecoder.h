@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/RawVector.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+#include <folly/Range.h>
+
+namespace facebook::velox::parquet {
+
+/// Decoder for DELTA_LENGTH_BYTE_ARRAY. The lengths of all values are
+/// DELTA_BINARY_PACKED, followed by the concatenated value bytes. The values
+/// are returned as ranges of the page data.
+class DeltaLengthByteArrayDecoder {
+ public:
+  explicit DeltaLengthByteArrayDecoder(const char* start) {
+    DeltaBpDecoder lengthDecoder(start);
+    lengths_.resize(lengthDecoder.numValues());
+    for (auto i = 0; i < lengths_.size(); ++i) {
+      lengths_[i] = lengthDecoder.next();
+      VELOX_CHECK_GE(
+          lengths_[i], 0, "Negative length in DELTA_LENGTH_BYTE_ARRAY");
+    }
+    bufferStart_ = lengthDecoder.bufferEnd();
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_DCHECK_LE(lengthIndex_ + numValues, lengths_.size());
+    for (auto i = 0; i < numValues; ++i) {
+      bufferStart_ += lengths_[lengthIndex_++];
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  /// Returns the next value. The range is valid as long as the page data.
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(lengthIndex_, lengths_.size());
+    auto length = lengths_[lengthIndex_++];
+    bufferStart_ += length;
+    return folly::StringPiece(bufferStart_ - length, length);
+  }
+
+ private:
+  const char* bufferStart_;
+  raw_vector<int32_t> lengths_;
+  int32_t lengthIndex_{0};
+};
+
+/// Decoder for DELTA_BYTE_ARRAY, also known as incremental encoding. Each
+/// value is stored as the length of the prefix it shares with the previous
+/// value and the remaining suffix. The prefix lengths are DELTA_BINARY_PACKED
+/// and the suffixes are DELTA_LENGTH_BYTE_ARRAY. Values are reconstructed in a
+/// buffer owned by 'this' that is valid until the next value is read.
+class DeltaByteArrayDecoder {
+ public:
+  explicit DeltaByteArrayDecoder(const char* start) {
+    DeltaBpDecoder prefixDecoder(start);
+    prefixLengths_.resize(prefixDecoder.numValues());
+    for (auto i = 0; i < prefixLengths_.size(); ++i) {
+      prefixLengths_[i] = prefixDecoder.next();
+    }
+    suffixDecoder_ = std::make_unique<DeltaLengthByteArrayDecoder>(
+        prefixDecoder.bufferEnd());
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    // Skipped values are the prefixes of the next ones and must be decoded.
+    for (auto i = 0; i < numValues; ++i) {
+      readString();
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  /// Returns the next value. The range is valid until the next call.
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(prefixIndex_, prefixLengths_.size());
+    auto prefixLength = prefixLengths_[prefixIndex_++];
+    VELOX_CHECK_LE(
+        prefixLength,
+        lastValue_.size(),
+        "DELTA_BYTE_ARRAY prefix longer than previous value");
+    auto suffix = suffixDecoder_->readString();
+    lastValue_.resize(prefixLength);
+    lastValue_.append(suffix.data(), suffix.size());
+    return folly::StringPiece(lastValue_);
+  }
+
+ private:
+  raw_vector<int32_t> prefixLengths_;
+  int32_t prefixIndex_{0};
+  std::unique_ptr<DeltaLengthByteArrayDecoder> suffixDecoder_;
+  std::string lastValue_;
+};
+
+} // namespace facebook::velox::parquet
@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 
 namespace facebook::velox::parquet {
@@ -241,6 +242,43 @@ int64_t ColumnChunkMetaDataPtr::totalUncompressedSize() const {
   return thriftColumnChunkPtr(ptr_)->meta_data.total_uncompressed_size;
 }
 
+bool ColumnChunkMetaDataPtr::hasPageIndex() const {
+  auto chunk = thriftColumnChunkPtr(ptr_);
+  return chunk->__isset.column_index_offset &&
+      chunk->__isset.column_index_length &&
+      chunk->__isset.offset_index_offset &&
+      chunk->__isset.offset_index_length && chunk->column_index_length > 0 &&
+      chunk->offset_index_length > 0;
+}
+
+int64_t ColumnChunkMetaDataPtr::columnIndexOffset() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::columnIndexLength() const {
+  return thriftColumnChunkPtr(ptr_)->column_index_length;
+}
+
+int64_t ColumnChunkMetaDataPtr::offsetIndexOffset() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::offsetIndexLength() const {
+  return thriftColumnChunkPtr(ptr_)->offset_index_length;
+}
+
+bool ColumnChunkMetaDataPtr::hasBloomFilterOffset() const {
+  return hasMetadata() &&
+      thriftColumnChunkPtr(ptr_)->meta_data.__isset.bloom_filter_offset;
+}
+
+int64_t ColumnChunkMetaDataPtr::bloomFilterOffset() const {
+  VELOX_CHECK(hasBloomFilterOffset());
+  return thriftColumnChunkPtr(ptr_)->meta_data.bloom_filter_offset;
+}
+
 FOLLY_ALWAYS_INLINE const thrift::RowGroup* thriftRowGroupPtr(
     const void* metadata) {
   return reinterpret_cast<const thrift::RowGroup*>(metadata);
@@ -65,6 +65,31 @@ class ColumnChunkMetaDataPtr {
   /// This information is optional and may be 0 if omitted.
   int64_t totalUncompressedSize() const;
 
+  /// Check the presence of both the ColumnIndex and the OffsetIndex for the
+  /// ColumnChunk.
+  bool hasPageIndex() const;
+
+  /// File offset of the ColumnIndex. Must check for its presence using
+  /// hasPageIndex().
+  int64_t columnIndexOffset() const;
+
+  /// Size of the ColumnIndex in bytes.
+  int32_t columnIndexLength() const;
+
+  /// File offset of the OffsetIndex. Must check for its presence using
+  /// hasPageIndex().
+  int64_t offsetIndexOffset() const;
+
+  /// Size of the OffsetIndex in bytes.
+  int32_t offsetIndexLength() const;
+
+  /// Check the presence of the Bloom filter offset in ColumnChunk metadata.
+  bool hasBloomFilterOffset() const;
+
+  /// File offset of the Bloom filter header, followed by the bitset. Must
+  /// check for its presence using hasBloomFilterOffset().
+  int64_t bloomFilterOffset() const;
+
  private:
   const void* ptr_;
 };
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> // @manual
+
+namespace facebook::velox::parquet {
+
+namespace {
+template <typename T>
+T readThrift(dwio::common::SeekableInputStream& stream) {
+  const void* buffer;
+  int32_t size;
+  VELOX_CHECK(stream.Next(&buffer, &size), "Empty page index stream");
+  auto bufferStart = reinterpret_cast<const char*>(buffer);
+  auto bufferEnd = bufferStart + size;
+  auto transport = std::make_shared<thrift::ThriftStreamingTransport>(
+      &stream, bufferStart, bufferEnd);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T result;
+  result.read(&protocol);
+  return result;
+}
+} // namespace
+
+PageIndex::PageIndex(
+    thrift::ColumnIndex columnIndex,
+    thrift::OffsetIndex offsetIndex,
+    int64_t numRowsInRowGroup)
+    : columnIndex_(std::move(columnIndex)),
+      offsetIndex_(std::move(offsetIndex)),
+      numRowsInRowGroup_(numRowsInRowGroup) {
+  VELOX_CHECK_EQ(
+      columnIndex_.null_pages.size(), offsetIndex_.page_locations.size());
+  VELOX_CHECK_EQ(
+      columnIndex_.min_values.size(), offsetIndex_.page_locations.size());
+  VELOX_CHECK_EQ(
+      columnIndex_.max_values.size(), offsetIndex_.page_locations.size());
+}
+
+// static
+std::unique_ptr<PageIndex> PageIndex::read(
+    dwio::common::SeekableInputStream& columnIndexStream,
+    dwio::common::SeekableInputStream& offsetIndexStream,
+    int64_t numRowsInRowGroup) {
+  return std::make_unique<PageIndex>(
+      readThrift<thrift::ColumnIndex>(columnIndexStream),
+      readThrift<thrift::OffsetIndex>(offsetIndexStream),
+      numRowsInRowGroup);
+}
+
+int64_t PageIndex::numRowsInPage(int32_t page) const {
+  auto end = page + 1 < numPages() ? firstRowOfPage(page + 1)
+                                   : numRowsInRowGroup_;
+  return end - firstRowOfPage(page);
+}
+
+bool PageIndex::pageMatches(
+    int32_t page,
+    common::Filter* filter,
+    const TypePtr& type) const {
+  auto numRows = numRowsInPage(page);
+  if (columnIndex_.null_pages[page]) {
+    return filter->testNull();
+  }
+  thrift::Statistics stats;
+  stats.__set_min_value(columnIndex_.min_values[page]);
+  stats.__set_max_value(columnIndex_.max_values[page]);
+  if (columnIndex_.__isset.null_counts) {
+    stats.__set_null_count(columnIndex_.null_counts[page]);
+  }
+  auto columnStats = buildColumnStatisticsFromThrift(stats, *type, numRows);
+  return common::testFilter(filter, columnStats.get(), numRows, type);
+}
+
+std::vector<uint64_t> PageIndex::pagesToSkip(
+    common::Filter* filter,
+    const TypePtr& type) const {
+  std::vector<uint64_t> result;
+  for (auto i = 0; i < numPages(); ++i) {
+    if (!pageMatches(i, filter, type)) {
+      if (result.empty()) {
+        result.resize(bits::nwords(numPages()));
+      }
+      bits::setBit(result.data(), i);
+    }
+  }
+  return result;
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/common/Statistics.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// Builds ColumnStatistics of 'type' from Parquet thrift statistics. Defined
+/// in Metadata.cpp.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& columnChunkStats,
+    const velox::Type& type,
+    uint64_t numRowsInRowGroup);
+
+/// Page level index of a ColumnChunk, made of the ColumnIndex (per page
+/// min/max and null info) and the OffsetIndex (per page location and first
+/// row). Used for skipping data pages that cannot have values passing a
+/// filter.
+class PageIndex {
+ public:
+  PageIndex(
+      thrift::ColumnIndex columnIndex,
+      thrift::OffsetIndex offsetIndex,
+      int64_t numRowsInRowGroup);
+
+  /// Reads a ColumnIndex and an OffsetIndex from the thrift serialized
+  /// data in 'columnIndexStream' and 'offsetIndexStream'.
+  static std::unique_ptr<PageIndex> read(
+      dwio::common::SeekableInputStream& columnIndexStream,
+      dwio::common::SeekableInputStream& offsetIndexStream,
+      int64_t numRowsInRowGroup);
+
+  int32_t numPages() const {
+    return offsetIndex_.page_locations.size();
+  }
+
+  /// Row number of the first row of 'page' from the start of the row group.
+  int64_t firstRowOfPage(int32_t page) const {
+    return offsetIndex_.page_locations[page].first_row_index;
+  }
+
+  /// Number of top level rows in 'page'.
+  int64_t numRowsInPage(int32_t page) const;
+
+  /// Returns a bit mask with a bit set for each data page where no value can
+  /// pass 'filter' according to the page statistics. Returns an empty vector
+  /// if no page can be skipped.
+  std::vector<uint64_t> pagesToSkip(
+      common::Filter* filter,
+      const TypePtr& type) const;
+
+ private:
+  // True if 'filter' may be true for some row in 'page'.
+  bool pageMatches(int32_t page, common::Filter* filter, const TypePtr& type)
+      const;
+
+  const thrift::ColumnIndex columnIndex_;
+  const thrift::OffsetIndex offsetIndex_;
+  const int64_t numRowsInRowGroup_;
+};
+
+} // namespace facebook::velox::parquet
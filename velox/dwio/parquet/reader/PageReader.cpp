@@ -31,6 +31,7 @@ using thrift::PageHeader;
 void PageReader::seekToPage(int64_t row) {
   defineDecoder_.reset();
   repeatDecoder_.reset();
+  pageSkippedByIndex_ = false;
   // 'rowOfPage_' is the row number of the first row of the next page.
   rowOfPage_ += numRowsInPage_;
   for (;;) {
@@ -46,9 +47,15 @@ void PageReader::seekToPage(int64_t row) {
 
     switch (pageHeader.type) {
       case thrift::PageType::DATA_PAGE:
+        if (row != kRepDefOnly && skipPageByIndex(pageHeader)) {
+          break;
+        }
         prepareDataPageV1(pageHeader, row);
         break;
       case thrift::PageType::DATA_PAGE_V2:
+        if (row != kRepDefOnly && skipPageByIndex(pageHeader)) {
+          break;
+        }
         prepareDataPageV2(pageHeader, row);
         break;
       case thrift::PageType::DICTIONARY_PAGE:
@@ -189,6 +196,27 @@ void PageReader::updateRowInfoAfterPageSkipped() {
   }
 }
 
+bool PageReader::skipPageByIndex(const PageHeader& pageHeader) {
+  auto pageOrdinal = numDataPagesSeen_++;
+  pageSkippedByIndex_ = false;
+  if (pagesToSkip_.empty() ||
+      !bits::isBitSet(pagesToSkip_.data(), pageOrdinal)) {
+    return false;
+  }
+  VELOX_DCHECK(isTopLevel_);
+  numRepDefsInPage_ = pageHeader.type == thrift::PageType::DATA_PAGE
+      ? pageHeader.data_page_header.num_values
+      : pageHeader.data_page_header_v2.num_values;
+  setPageRowInfo(false);
+  dwio::common::skipBytes(
+      pageHeader.compressed_page_size,
+      inputStream_.get(),
+      bufferStart_,
+      bufferEnd_);
+  pageSkippedByIndex_ = true;
+  return true;
+}
+
 void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
   VELOX_CHECK(
       pageHeader.type == thrift::PageType::DATA_PAGE &&
@@ -521,6 +549,7 @@ void PageReader::preloadRepDefs() {
   // Reset the input to start of column chunk.
   std::vector<uint64_t> rewind = {0};
   pageStart_ = 0;
+  numDataPagesSeen_ = 0;
   dwio::common::PositionProvider position(rewind);
   inputStream_->seekToPosition(position);
   bufferStart_ = bufferEnd_ = nullptr;
@@ -646,6 +675,35 @@ void PageReader::makeDecoder() {
               "DELTA_BINARY_PACKED decoder only supports INT32 and INT64");
       }
       break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      if (parquetType != thrift::Type::BYTE_ARRAY) {
+        VELOX_UNSUPPORTED(
+            "DELTA_LENGTH_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      }
+      deltaLengthByteArrayDecoder_ =
+          std::make_unique<DeltaLengthByteArrayDecoder>(pageData_);
+      break;
+    case Encoding::DELTA_BYTE_ARRAY:
+      if (parquetType != thrift::Type::BYTE_ARRAY) {
+        VELOX_UNSUPPORTED("DELTA_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      }
+      deltaByteArrayDecoder_ =
+          std::make_unique<DeltaByteArrayDecoder>(pageData_);
+      break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      switch (parquetType) {
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE:
+          byteStreamSplitDecoder_ = std::make_unique<ByteStreamSplitDecoder>(
+              pageData_,
+              pageData_ + encodedDataSize_,
+              parquetTypeBytes(parquetType));
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT decoder only supports FLOAT and DOUBLE");
+      }
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
@@ -665,6 +723,10 @@ void PageReader::skip(int64_t numRows) {
     toSkip -= rowOfPage_ - firstUnvisited_;
   }
   firstUnvisited_ += numRows;
+  if (pageSkippedByIndex_) {
+    // No decoders are set up for a page skipped by the page index.
+    return;
+  }
 
   // Skip nulls
   toSkip = skipNulls(toSkip);
@@ -672,6 +734,14 @@ void PageReader::skip(int64_t numRows) {
   // Skip the decoder
   if (isDictionary()) {
     dictionaryIdDecoder_->skip(toSkip);
+  } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
+    deltaBpDecoder_->skip(toSkip);
+  } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    deltaLengthByteArrayDecoder_->skip(toSkip);
+  } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+    deltaByteArrayDecoder_->skip(toSkip);
+  } else if (encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT) {
+    byteStreamSplitDecoder_->skip(toSkip);
   } else if (directDecoder_) {
     directDecoder_->skip(toSkip);
   } else if (stringDecoder_) {
@@ -790,11 +860,29 @@ bool PageReader::rowsForPage(
   int32_t numToVisit;
   // Check if the first row to go to is in the current page. If not, seek to the
   // page that contains the row.
-  auto rowZero = visitBase_ + visitorRows_[currentVisitorRow_];
-  if (rowZero >= rowOfPage_ + numRowsInPage_) {
-    seekToPage(rowZero);
-    if (hasChunkRepDefs_) {
-      numLeafNullsConsumed_ = rowOfPage_;
+  for (;;) {
+    auto rowZero = visitBase_ + visitorRows_[currentVisitorRow_];
+    if (rowZero >= rowOfPage_ + numRowsInPage_) {
+      seekToPage(rowZero);
+      if (hasChunkRepDefs_) {
+        numLeafNullsConsumed_ = rowOfPage_;
+      }
+    }
+    if (!pageSkippedByIndex_) {
+      break;
+    }
+    // No row on a page skipped by the page index can pass the filter.
+    // Consume the rows to visit that fall on this page without decoding.
+    VELOX_CHECK(hasFilter, "Page skipped by index read without filter");
+    int32_t firstOnNextPage = rowOfPage_ + numRowsInPage_ - visitBase_;
+    auto it = std::lower_bound(
+        visitorRows_ + currentVisitorRow_,
+        visitorRows_ + numVisitorRows_,
+        firstOnNextPage);
+    currentVisitorRow_ = it - visitorRows_;
+    firstUnvisited_ = visitBase_ + visitorRows_[currentVisitorRow_ - 1] + 1;
+    if (currentVisitorRow_ == numVisitorRows_) {
+      return false;
     }
   }
   auto& scanState = reader.scanState();
@@ -22,7 +22,9 @@
 #include "velox/dwio/common/SelectiveColumnReader.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -112,6 +114,11 @@ class PageReader {
   // Returns the current string dictionary as a FlatVector<StringView>.
   const VectorPtr& dictionaryValues(const TypePtr& type);
 
+  // True if dictionaryValues() has been made for the current dictionary.
+  bool hasDictionaryValues() const {
+    return dictionaryValues_ != nullptr;
+  }
+
   // True if the current page holds dictionary indices.
   bool isDictionary() const {
     return encoding_ == thrift::Encoding::PLAIN_DICTIONARY ||
@@ -137,6 +144,14 @@ class PageReader {
   // bufferEnd_ to the corresponding positions.
   thrift::PageHeader readPageHeader();
 
+  /// Sets the data pages that have no rows passing the filter of the column
+  /// according to the page index. Bit i corresponds to the i'th data page of
+  /// the ColumnChunk. Only applies to top level columns.
+  void setPagesToSkip(std::vector<uint64_t> pagesToSkip) {
+    VELOX_CHECK(isTopLevel_ || pagesToSkip.empty());
+    pagesToSkip_ = std::move(pagesToSkip);
+  }
+
  private:
   // Indicates that we only want the repdefs for the next page. Used when
   // prereading repdefs with seekToPage.
@@ -188,6 +203,11 @@ class PageReader {
   // next page.
   void updateRowInfoAfterPageSkipped();
 
+  // Called on each data page header. If the page is in 'pagesToSkip_', sets
+  // the row info for the page and skips its data without decompressing it.
+  // Returns true if the page was skipped.
+  bool skipPageByIndex(const thrift::PageHeader& pageHeader);
+
   void prepareDataPageV1(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDataPageV2(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDictionary(const thrift::PageHeader& pageHeader);
@@ -268,6 +288,9 @@ class PageReader {
       } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
         nullsFromFastPath = false;
         deltaBpDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT) {
+        nullsFromFastPath = false;
+        byteStreamSplitDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         directDecoder_->readWithVisitor<true>(
             nulls, visitor, nullsFromFastPath);
@@ -278,6 +301,8 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
         deltaBpDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::BYTE_STREAM_SPLIT) {
+        byteStreamSplitDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         directDecoder_->readWithVisitor<false>(
             nulls, visitor, !this->type_->type()->isShortDecimal());
@@ -297,6 +322,12 @@ class PageReader {
         nullsFromFastPath = dwio::common::useFastPath<Visitor, true>(visitor);
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaLengthByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         nullsFromFastPath = false;
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
@@ -305,6 +336,10 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        deltaLengthByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        deltaByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -431,6 +466,17 @@ class PageReader {
   // Number of bytes starting at pageData_ for current encoded data.
   int32_t encodedDataSize_{0};
 
+  // Bit mask of data pages that the page index shows not to have any value
+  // passing the filter. Empty if no page is to be skipped.
+  std::vector<uint64_t> pagesToSkip_;
+
+  // Number of data page headers read from the ColumnChunk.
+  int32_t numDataPagesSeen_{0};
+
+  // True if the current page is skipped because of 'pagesToSkip_'. No decoder
+  // is set up for the page in this case.
+  bool pageSkippedByIndex_{false};
+
   // Below members Keep state between calls to readWithVisitor().
 
   // Original rows in Visitor.
@@ -479,6 +525,9 @@ class PageReader {
   std::unique_ptr<StringDecoder> stringDecoder_;
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrayDecoder_;
+  std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrayDecoder_;
+  std::unique_ptr<ByteStreamSplitDecoder> byteStreamSplitDecoder_;
   // Add decoders for other encodings here.
 };
 
@@ -17,15 +17,99 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> // @manual
 
 namespace facebook::velox::parquet {
 
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
-    const common::ScanSpec& /*scanSpec*/) {
-  return std::make_unique<ParquetData>(type, metaData_, pool());
+    const common::ScanSpec& scanSpec) {
+  return std::make_unique<ParquetData>(
+      type, metaData_, pool(), &scanSpec, &runtimeStatistics(), input_);
+}
+
+namespace {
+// Upper bound for the size of a thrift encoded BloomFilterHeader.
+constexpr uint64_t kMaxBloomFilterHeaderSize = 64;
+
+template <typename T>
+void addIntegerHash(int64_t value, std::vector<uint64_t>& hashes) {
+  if (value >= std::numeric_limits<T>::min() &&
+      value <= std::numeric_limits<T>::max()) {
+    hashes.push_back(SplitBlockBloomFilter::hash(static_cast<T>(value)));
+  }
 }
 
+// Returns the hashes of the values 'filter' can pass if 'filter' passes a
+// discrete set of values of physical type 'parquetType'. Returns std::nullopt
+// otherwise.
+std::optional<std::vector<uint64_t>> pointLookupHashes(
+    const common::Filter& filter,
+    thrift::Type::type parquetType) {
+  std::vector<int64_t> intValues;
+  std::vector<uint64_t> hashes;
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto* range = static_cast<const common::BigintRange*>(&filter);
+      if (!range->isSingleValue()) {
+        return std::nullopt;
+      }
+      intValues.push_back(range->lower());
+      break;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      intValues =
+          static_cast<const common::BigintValuesUsingHashTable*>(&filter)
+              ->values();
+      break;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      intValues =
+          static_cast<const common::BigintValuesUsingBitmask*>(&filter)
+              ->values();
+      break;
+    case common::FilterKind::kBytesRange: {
+      auto* range = static_cast<const common::BytesRange*>(&filter);
+      if (!range->isSingleValue() ||
+          parquetType != thrift::Type::BYTE_ARRAY) {
+        return std::nullopt;
+      }
+      hashes.push_back(SplitBlockBloomFilter::hash(range->lower()));
+      return hashes;
+    }
+    case common::FilterKind::kBytesValues: {
+      if (parquetType != thrift::Type::BYTE_ARRAY) {
+        return std::nullopt;
+      }
+      const auto& values =
+          static_cast<const common::BytesValues*>(&filter)->values();
+      for (const auto& value : values) {
+        hashes.push_back(SplitBlockBloomFilter::hash(value));
+      }
+      return hashes;
+    }
+    default:
+      return std::nullopt;
+  }
+  switch (parquetType) {
+    case thrift::Type::INT32:
+      for (auto value : intValues) {
+        addIntegerHash<int32_t>(value, hashes);
+      }
+      return hashes;
+    case thrift::Type::INT64:
+      for (auto value : intValues) {
+        addIntegerHash<int64_t>(value, hashes);
+      }
+      return hashes;
+    default:
+      return std::nullopt;
+  }
+}
+} // namespace
+
 void ParquetData::filterRowGroups(
     const common::ScanSpec& scanSpec,
     uint64_t /*rowsPerRowGroup*/,
@@ -75,9 +159,74 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   if (columnChunk.hasStatistics()) {
     auto columnStats =
         columnChunk.getColumnStatistics(type, rowGroup.numRows());
-    return testFilter(filter, columnStats.get(), rowGroup.numRows(), type);
+    if (!testFilter(filter, columnStats.get(), rowGroup.numRows(), type)) {
+      return false;
+    }
   }
-  return true;
+  return bloomFilterMatches(rowGroupId, filter);
+}
+
+bool ParquetData::bloomFilterMatches(
+    uint32_t rowGroupId,
+    common::Filter* filter) {
+  auto columnChunk =
+      fileMetaDataPtr_.rowGroup(rowGroupId).columnChunk(type_->column());
+  if (!input_ || !columnChunk.hasBloomFilterOffset() || filter->testNull() ||
+      !type_->parquetType_.has_value() || type_->type()->isDecimal()) {
+    return true;
+  }
+  auto hashes = pointLookupHashes(*filter, type_->parquetType_.value());
+  if (!hashes.has_value()) {
+    return true;
+  }
+  auto bloomFilter = readBloomFilter(columnChunk.bloomFilterOffset());
+  if (!bloomFilter) {
+    return true;
+  }
+  for (auto hash : hashes.value()) {
+    if (bloomFilter->findHash(hash)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::unique_ptr<SplitBlockBloomFilter> ParquetData::readBloomFilter(
+    int64_t offset) {
+  const uint64_t fileSize = input_->getReadFile()->size();
+  if (offset <= 0 || static_cast<uint64_t>(offset) >= fileSize) {
+    return nullptr;
+  }
+  // The header size is not known before parsing it. Read a range that is
+  // sure to cover it and then read the bitset that follows.
+  auto headerStream = input_->read(
+      offset,
+      std::min(kMaxBloomFilterHeaderSize, fileSize - offset),
+      dwio::common::LogType::STRIPE_INDEX);
+  const void* buffer;
+  int32_t size;
+  VELOX_CHECK(headerStream->Next(&buffer, &size));
+  const char* bufferStart = reinterpret_cast<const char*>(buffer);
+  const char* bufferEnd = bufferStart + size;
+  auto transport = std::make_shared<thrift::ThriftStreamingTransport>(
+      headerStream.get(), bufferStart, bufferEnd);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  auto headerSize = header.read(&protocol);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED || header.numBytes <= 0 ||
+      header.numBytes % SplitBlockBloomFilter::kBytesPerBlock != 0 ||
+      offset + headerSize + header.numBytes > fileSize) {
+    return nullptr;
+  }
+  auto bitset = AlignedBuffer::allocate<char>(header.numBytes, &pool_);
+  auto bitsetStream = input_->read(
+      offset + headerSize,
+      header.numBytes,
+      dwio::common::LogType::STRIPE_INDEX);
+  bitsetStream->readFully(bitset->asMutable<char>(), header.numBytes);
+  return std::make_unique<SplitBlockBloomFilter>(std::move(bitset));
 }
 
 void ParquetData::enqueueRowGroup(
@@ -104,6 +253,45 @@ void ParquetData::enqueueRowGroup(
 
   auto id = dwio::common::StreamIdentifier(type_->column());
   streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+
+  if (usePageIndex(chunk)) {
+    columnIndexStreams_.resize(fileMetaDataPtr_.numRowGroups());
+    offsetIndexStreams_.resize(fileMetaDataPtr_.numRowGroups());
+    columnIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.columnIndexOffset()),
+         static_cast<uint64_t>(chunk.columnIndexLength())},
+        &id);
+    offsetIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.offsetIndexOffset()),
+         static_cast<uint64_t>(chunk.offsetIndexLength())},
+        &id);
+  }
+}
+
+bool ParquetData::usePageIndex(const ColumnChunkMetaDataPtr& chunk) const {
+  // Pages can be skipped only for top level columns since rows of nested
+  // columns are not known before reading the repdefs. A reader that reads
+  // only nulls does not go through the visitor that handles skipped pages.
+  return scanSpec_ && scanSpec_->filter() && !scanSpec_->readsNullsOnly() &&
+      maxRepeat_ == 0 && maxDefine_ <= 1 && chunk.hasPageIndex();
+}
+
+std::vector<uint64_t> ParquetData::pagesToSkip(uint32_t index) {
+  if (index >= columnIndexStreams_.size() || !columnIndexStreams_[index]) {
+    return {};
+  }
+  auto columnIndexStream = std::move(columnIndexStreams_[index]);
+  auto offsetIndexStream = std::move(offsetIndexStreams_[index]);
+  auto pageIndex = PageIndex::read(
+      *columnIndexStream,
+      *offsetIndexStream,
+      fileMetaDataPtr_.rowGroup(index).numRows());
+  auto result = pageIndex->pagesToSkip(scanSpec_->filter(), type_->type());
+  if (stats_ && !result.empty()) {
+    stats_->pagesSkippedByIndex +=
+        bits::countBits(result.data(), 0, pageIndex->numPages());
+  }
+  return result;
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
@@ -111,12 +299,14 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
   VELOX_CHECK_LT(index, streams_.size());
   VELOX_CHECK(streams_[index], "Stream not enqueued for column");
   auto metadata = fileMetaDataPtr_.rowGroup(index).columnChunk(type_->column());
+  rowsInRowGroup_ = fileMetaDataPtr_.rowGroup(index).numRows();
   reader_ = std::make_unique<PageReader>(
       std::move(streams_[index]),
       pool_,
       type_,
       metadata.compression(),
       metadata.totalCompressedSize());
+  reader_->setPagesToSkip(pagesToSkip(index));
   return dwio::common::PositionProvider(empty);
 }
 
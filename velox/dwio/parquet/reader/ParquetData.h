@@ -17,7 +17,9 @@
 #pragma once
 
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/parquet/common/BloomFilter.h"
 #include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 
 namespace facebook::velox::common {
@@ -32,17 +34,21 @@ namespace facebook::velox::parquet {
 
 class ParquetParams : public dwio::common::FormatParams {
  public:
+  /// 'input' is used for reading file level index structures like Bloom
+  /// filters. These are not read if 'input' is nullptr.
   ParquetParams(
       memory::MemoryPool& pool,
       dwio::common::ColumnReaderStatistics& stats,
-      const FileMetaDataPtr metaData)
-      : FormatParams(pool, stats), metaData_(metaData) {}
+      const FileMetaDataPtr metaData,
+      dwio::common::BufferedInput* input = nullptr)
+      : FormatParams(pool, stats), metaData_(metaData), input_(input) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
 
  private:
   const FileMetaDataPtr metaData_;
+  dwio::common::BufferedInput* const input_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -51,10 +57,16 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const FileMetaDataPtr fileMetadataPtr,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      const common::ScanSpec* scanSpec = nullptr,
+      dwio::common::ColumnReaderStatistics* stats = nullptr,
+      dwio::common::BufferedInput* input = nullptr)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         fileMetaDataPtr_(fileMetadataPtr),
+        scanSpec_(scanSpec),
+        stats_(stats),
+        input_(input),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1) {}
@@ -167,10 +179,19 @@ class ParquetData : public dwio::common::FormatData {
     return reader_->dictionaryValues(type);
   }
 
+  bool hasDictionaryValues() const {
+    return reader_->hasDictionaryValues();
+  }
+
   void clearDictionary() {
     reader_->clearDictionary();
   }
 
+  /// Returns the number of rows in the current row group.
+  int64_t rowsInRowGroup() const {
+    return rowsInRowGroup_;
+  }
+
   bool hasDictionary() const {
     return reader_->isDictionary();
   }
@@ -191,14 +212,44 @@ class ParquetData : public dwio::common::FormatData {
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  /// False if 'filter' is a point lookup and none of its values is in the
+  /// Bloom filter of the column in 'rowGroupId'. True if there is no Bloom
+  /// filter or 'filter' is not a point lookup.
+  bool bloomFilterMatches(uint32_t rowGroupId, common::Filter* filter);
+
+  /// Reads the Bloom filter header and bitset at 'offset'.
+  std::unique_ptr<SplitBlockBloomFilter> readBloomFilter(int64_t offset);
+
+  /// True if the page index of the column chunk is to be read for skipping
+  /// pages that do not match the filter in 'scanSpec_'.
+  bool usePageIndex(const ColumnChunkMetaDataPtr& chunk) const;
+
+  /// Returns the data pages of 'index'th row group that have no hits for the
+  /// filter in 'scanSpec_' according to the page index, if the page index
+  /// was enqueued.
+  std::vector<uint64_t> pagesToSkip(uint32_t index);
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const FileMetaDataPtr fileMetaDataPtr_;
+  // ScanSpec of the column. Used for page index based skipping. May be
+  // nullptr.
+  const common::ScanSpec* const scanSpec_;
+  dwio::common::ColumnReaderStatistics* const stats_;
+  // Input for reading Bloom filters. May be nullptr.
+  dwio::common::BufferedInput* const input_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
 
+  // Streams for the ColumnIndex and OffsetIndex of this column in each of
+  // 'rowGroups_'. Only set if the page index is used.
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      columnIndexStreams_;
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      offsetIndexStreams_;
+
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
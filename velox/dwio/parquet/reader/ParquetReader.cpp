@@ -18,6 +18,7 @@
 
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -68,7 +69,10 @@ class ReaderBase {
   }
 
   /// Ensures that streams are enqueued and loading for the row group at
-  /// 'currentGroup'. May start loading one or more subsequent groups.
+  /// 'currentGroup'. May start loading up to prefetchRowGroups() subsequent
+  /// groups in the background. The read-ahead is limited to
+  /// maxPrefetchRowGroupBytes() and to half of the free capacity of the memory
+  /// pool.
   void scheduleRowGroups(
       const std::vector<uint32_t>& groups,
       int32_t currentGroup,
@@ -80,6 +84,12 @@ class ReaderBase {
       int32_t rowGroupIndex,
       const dwio::common::TypeWithId& type) const;
 
+  /// Returns the compressed size for columns in 'type' and its children in
+  /// row group.
+  int64_t rowGroupCompressedSize(
+      int32_t rowGroupIndex,
+      const dwio::common::TypeWithId& type) const;
+
   /// Checks whether the specific row group has been loaded and
   /// the data still exists in the buffered inputs.
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
@@ -112,7 +122,8 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // Shared with the other readers of the file through the FileMetadataCache.
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -144,6 +155,23 @@ void ReaderBase::loadFileMetaData() {
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
 
+  // The splits of a file share its parsed footer through the metadata cache.
+  auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+  std::optional<dwio::common::FileMetadataCache::Key> cacheKey;
+  if (metadataCache != nullptr && input_->fileNum().has_value()) {
+    cacheKey = dwio::common::FileMetadataCache::Key{
+        input_->fileNum().value(),
+        fileLength_,
+        dwio::common::FileFormat::PARQUET};
+    fileMetaData_ = metadataCache->get<thrift::FileMetaData>(*cacheKey);
+    if (fileMetaData_ != nullptr) {
+      if (preloadFile) {
+        input_->loadCompleteFile();
+      }
+      return;
+    }
+  }
+
   std::unique_ptr<dwio::common::SeekableInputStream> stream;
   if (preloadFile) {
     stream = input_->loadCompleteFile();
@@ -186,8 +214,16 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  fileMetaData_ = std::move(fileMetaData);
+  if (cacheKey.has_value()) {
+    // Thrift objects do not report their size. The parsed metadata is
+    // estimated to take a few times the size of its compact encoding.
+    constexpr int64_t kMemoryPerFooterByte = 4;
+    metadataCache->put(
+        *cacheKey, fileMetaData_, kMemoryPerFooterByte * footerLength);
+  }
 }
 
 void ReaderBase::initializeSchema() {
@@ -615,9 +651,23 @@ void ReaderBase::scheduleRowGroups(
   auto numRowGroupsToLoad = std::min(
       options_.prefetchRowGroups() + 1,
       static_cast<int64_t>(rowGroupIds.size() - currentGroup));
+  const int64_t maxPrefetchBytes = std::min<int64_t>(
+      options_.maxPrefetchRowGroupBytes(), pool_.freeBytes() / 2);
+  int64_t prefetchBytes = 0;
   for (auto i = 0; i < numRowGroupsToLoad; i++) {
     auto thisGroup = rowGroupIds[currentGroup + i];
-    if (!inputs_[thisGroup]) {
+    if (i > 0) {
+      // The groups after the current one stay in memory until they are read.
+      // Stop the read-ahead at the first group that does not fit the budget.
+      // It is loaded when it becomes the current group.
+      for (auto* child : reader.children()) {
+        prefetchBytes += rowGroupCompressedSize(thisGroup, child->fileType());
+      }
+      if (prefetchBytes > maxPrefetchBytes) {
+        break;
+      }
+    }
+    if (inputs_.count(thisGroup) == 0) {
       inputs_[thisGroup] = reader.loadRowGroup(thisGroup, input_);
     }
   }
@@ -642,6 +692,21 @@ int64_t ReaderBase::rowGroupUncompressedSize(
   return sum;
 }
 
+int64_t ReaderBase::rowGroupCompressedSize(
+    int32_t rowGroupIndex,
+    const dwio::common::TypeWithId& type) const {
+  if (type.column() != ParquetTypeWithId::kNonLeaf) {
+    return fileMetaData_->row_groups[rowGroupIndex]
+        .columns[type.column()]
+        .meta_data.total_compressed_size;
+  }
+  int64_t sum = 0;
+  for (auto child : type.getChildren()) {
+    sum += rowGroupCompressedSize(rowGroupIndex, *child);
+  }
+  return sum;
+}
+
 bool ReaderBase::isRowGroupBuffered(int32_t rowGroupIndex) const {
   return inputs_.count(rowGroupIndex) != 0;
 }
@@ -680,7 +745,10 @@ class ParquetRowReader::Impl {
       return; // TODO
     }
     ParquetParams params(
-        pool_, columnReaderStats_, readerBase_->fileMetaData());
+        pool_,
+        columnReaderStats_,
+        readerBase_->fileMetaData(),
+        &readerBase_->bufferedInput());
     auto columnSelector = std::make_shared<ColumnSelector>(
         ColumnSelector::apply(options_.getSelector(), readerBase_->schema()));
     columnReader_ = ParquetColumnReader::build(
@@ -688,6 +756,12 @@ class ParquetRowReader::Impl {
         readerBase_->schemaWithId(), // Id is schema id
         params,
         *options_.getScanSpec());
+    columnReader_->setIsTopLevel();
+    if (options_.collectColumnStats()) {
+      dynamic_cast<dwio::common::SelectiveStructColumnReaderBase&>(
+          *columnReader_)
+          .setColumnReadStatistics(&columnReaderStats_);
+    }
 
     filterRowGroups();
     if (!rowGroupIds_.empty()) {
@@ -776,6 +850,9 @@ class ParquetRowReader::Impl {
 
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += rowGroups_.size() - rowGroupIds_.size();
+    stats.columnReaderStatistics.pagesSkippedByIndex +=
+        columnReaderStats_.pagesSkippedByIndex;
+    stats.columnReaderStatistics.mergeColumnStats(columnReaderStats_);
   }
 
   void resetFilterCaches() {
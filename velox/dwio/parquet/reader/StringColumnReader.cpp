@@ -130,14 +130,28 @@ void StringColumnReader::read(
     }
   }
   readOffset_ += rows.back() + 1;
+  numRowsScanned_ = rows.back() + 1;
 }
 
 void StringColumnReader::getValues(RowSet rows, VectorPtr* result) {
   if (scanState_.dictionary.values) {
-    auto dictionaryValues =
-        formatData_->as<ParquetData>().dictionaryValues(fileType_->type());
+    auto& parquetData = formatData_->as<ParquetData>();
     compactScalarValues<int32_t, int32_t>(rows, false);
-
+    // A dictionary result is worthwhile if the dictionary is not larger than
+    // the values the row group would produce at this selectivity. Once the
+    // base vector is made, keep using it so that consecutive batches share
+    // the same dictionary.
+    VELOX_CHECK_GT(numRowsScanned_, 0);
+    double selectivity = 1.0 * rows.size() / numRowsScanned_;
+    auto flatSize = std::max<double>(
+        selectivity * parquetData.rowsInRowGroup(), rows.size());
+    if (scanSpec_->makeFlat() ||
+        (!parquetData.hasDictionaryValues() &&
+         flatSize < scanState_.dictionary.numValues)) {
+      makeFlat(result);
+      return;
+    }
+    auto dictionaryValues = parquetData.dictionaryValues(fileType_->type());
     *result = std::make_shared<DictionaryVector<StringView>>(
         &memoryPool_, resultNulls(), numValues_, dictionaryValues, values_);
     return;
@@ -148,6 +162,29 @@ void StringColumnReader::getValues(RowSet rows, VectorPtr* result) {
   getFlatValues<StringView, StringView>(rows, result, fileType_->type());
 }
 
+void StringColumnReader::makeFlat(VectorPtr* result) {
+  auto* indices = reinterpret_cast<const vector_size_t*>(rawValues_);
+  auto values = AlignedBuffer::allocate<StringView>(numValues_, &memoryPool_);
+  auto* stringViews = values->asMutable<StringView>();
+  auto* dictionary = scanState_.dictionary.values->as<StringView>();
+  auto nulls = resultNulls();
+  auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+  for (vector_size_t i = 0; i < numValues_; ++i) {
+    if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      stringViews[i] = {};
+      continue;
+    }
+    stringViews[i] = dictionary[indices[i]];
+  }
+  *result = std::make_shared<FlatVector<StringView>>(
+      &memoryPool_,
+      fileType_->type(),
+      std::move(nulls),
+      numValues_,
+      std::move(values),
+      std::vector<BufferPtr>{scanState_.dictionary.strings});
+}
+
 void StringColumnReader::dedictionarize() {
   if (scanSpec_->keepValues()) {
     auto dict = formatData_->as<ParquetData>()
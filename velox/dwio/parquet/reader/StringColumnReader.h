@@ -56,6 +56,13 @@ class StringColumnReader : public dwio::common::SelectiveColumnReader {
 
   folly::StringPiece readValue(int32_t length);
 
+  // Makes a flat result from the dictionary indices in 'values_'.
+  void makeFlat(VectorPtr* result);
+
+  // Number of rows covered by the last read(), including the ones that did
+  // not pass the filter.
+  vector_size_t numRowsScanned_{0};
+
   template <bool hasNulls, typename Visitor>
   void decode(const uint64_t* nulls, Visitor visitor);
 
@@ -140,6 +140,15 @@ void StructColumnReader::enqueueRowGroup(
   }
 }
 
+void StructColumnReader::setIsTopLevel() {
+  isTopLevel_ = true;
+  for (auto* child : children_) {
+    if (!child->fileType().type()->isPrimitiveType()) {
+      child->dwio::common::SelectiveColumnReader::setIsTopLevel();
+    }
+  }
+}
+
 void StructColumnReader::seekToRowGroup(uint32_t index) {
   SelectiveStructColumnReader::seekToRowGroup(index);
   BufferPtr noBuffer;
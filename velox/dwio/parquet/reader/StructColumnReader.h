@@ -42,6 +42,12 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
 
   void seekToRowGroup(uint32_t index) override;
 
+  /// Only the columns of the root struct that are lists, maps or structs are
+  /// loaded as LazyVectors. These are then decoded only for the rows that are
+  /// accessed after the filters of the scan and of its consumers. Members of
+  /// nested structs are read by their parent.
+  void setIsTopLevel() override;
+
   /// Creates the streams for 'rowGroup'. Checks whether row 'rowGroup'
   /// has been buffered in 'input'. If true, return the input. Or else creates
   /// the streams in a new input and loads.
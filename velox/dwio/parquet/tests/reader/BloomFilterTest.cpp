@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/common/BloomFilter.h"
+#include "velox/common/memory/Memory.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+class BloomFilterTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+};
+
+TEST_F(BloomFilterTest, integers) {
+  auto filter = SplitBlockBloomFilter::create(1024, *pool_);
+  for (int64_t i = 0; i < 100; ++i) {
+    filter->insertHash(SplitBlockBloomFilter::hash(i * 7));
+  }
+  for (int64_t i = 0; i < 100; ++i) {
+    EXPECT_TRUE(filter->findHash(SplitBlockBloomFilter::hash(i * 7)));
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 10'000; ++i) {
+    numFalsePositives +=
+        filter->findHash(SplitBlockBloomFilter::hash(1'000'000 + i));
+  }
+  // 100 values in 8K bits has a false positive rate well under 1%.
+  EXPECT_LT(numFalsePositives, 100);
+
+  // The same number hashes differently as int32_t and int64_t, as in the
+  // plain encoding of the two physical types.
+  EXPECT_NE(
+      SplitBlockBloomFilter::hash(static_cast<int32_t>(7)),
+      SplitBlockBloomFilter::hash(static_cast<int64_t>(7)));
+}
+
+TEST_F(BloomFilterTest, strings) {
+  auto filter = SplitBlockBloomFilter::create(256, *pool_);
+  std::vector<std::string> values = {"apple", "banana", "", "cherry"};
+  for (const auto& value : values) {
+    filter->insertHash(SplitBlockBloomFilter::hash(std::string_view(value)));
+  }
+  for (const auto& value : values) {
+    EXPECT_TRUE(
+        filter->findHash(SplitBlockBloomFilter::hash(std::string_view(value))));
+  }
+  EXPECT_FALSE(filter->findHash(SplitBlockBloomFilter::hash("durian")));
+}
+
+TEST_F(BloomFilterTest, fromBitset) {
+  auto filter = SplitBlockBloomFilter::create(64, *pool_);
+  filter->insertHash(SplitBlockBloomFilter::hash(123L));
+  auto copy = AlignedBuffer::allocate<char>(filter->numBytes(), pool_.get());
+  memcpy(copy->asMutable<char>(), filter->data(), filter->numBytes());
+  SplitBlockBloomFilter readFilter(copy);
+  EXPECT_TRUE(readFilter.findHash(SplitBlockBloomFilter::hash(123L)));
+  EXPECT_FALSE(readFilter.findHash(SplitBlockBloomFilter::hash(124L)));
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include <gtest/gtest.h>
+#include <thrift/protocol/TCompactProtocol.h> // @manual
+#include <thrift/transport/TBufferTransports.h> // @manual
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+namespace {
+
+std::string encodeInt64(int64_t value) {
+  return std::string(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Makes a page index of 'numPages' pages of 'rowsPerPage' rows each. Page i
+// has values in [i * rowsPerPage, (i + 1) * rowsPerPage).
+std::pair<thrift::ColumnIndex, thrift::OffsetIndex> makeIndex(
+    int32_t numPages,
+    int64_t rowsPerPage) {
+  thrift::ColumnIndex columnIndex;
+  thrift::OffsetIndex offsetIndex;
+  std::vector<bool> nullPages;
+  std::vector<std::string> minValues;
+  std::vector<std::string> maxValues;
+  std::vector<int64_t> nullCounts;
+  std::vector<thrift::PageLocation> locations;
+  for (auto i = 0; i < numPages; ++i) {
+    nullPages.push_back(false);
+    minValues.push_back(encodeInt64(i * rowsPerPage));
+    maxValues.push_back(encodeInt64((i + 1) * rowsPerPage - 1));
+    nullCounts.push_back(0);
+    thrift::PageLocation location;
+    location.__set_offset(i * 1000);
+    location.__set_compressed_page_size(1000);
+    location.__set_first_row_index(i * rowsPerPage);
+    locations.push_back(location);
+  }
+  columnIndex.__set_null_pages(nullPages);
+  columnIndex.__set_min_values(minValues);
+  columnIndex.__set_max_values(maxValues);
+  columnIndex.__set_null_counts(nullCounts);
+  columnIndex.__set_boundary_order(thrift::BoundaryOrder::ASCENDING);
+  offsetIndex.__set_page_locations(locations);
+  return {columnIndex, offsetIndex};
+}
+
+template <typename T>
+std::string serialize(const T& object) {
+  auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocolT<
+      apache::thrift::transport::TMemoryBuffer>
+      protocol(buffer);
+  object.write(&protocol);
+  return buffer->getBufferAsString();
+}
+
+std::vector<int32_t> skippedPages(
+    const std::vector<uint64_t>& pages,
+    int32_t n) {
+  std::vector<int32_t> result;
+  if (pages.empty()) {
+    return result;
+  }
+  for (auto i = 0; i < n; ++i) {
+    if (bits::isBitSet(pages.data(), i)) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST(PageIndexTest, rowsInPage) {
+  auto [columnIndex, offsetIndex] = makeIndex(3, 100);
+  PageIndex index(columnIndex, offsetIndex, 250);
+  EXPECT_EQ(3, index.numPages());
+  EXPECT_EQ(0, index.firstRowOfPage(0));
+  EXPECT_EQ(200, index.firstRowOfPage(2));
+  EXPECT_EQ(100, index.numRowsInPage(1));
+  EXPECT_EQ(50, index.numRowsInPage(2));
+}
+
+TEST(PageIndexTest, rangeFilter) {
+  auto [columnIndex, offsetIndex] = makeIndex(4, 100);
+  PageIndex index(columnIndex, offsetIndex, 400);
+
+  common::BigintRange inSecondPage(150, 160, false);
+  EXPECT_EQ(
+      std::vector<int32_t>({0, 2, 3}),
+      skippedPages(index.pagesToSkip(&inSecondPage, BIGINT()), 4));
+
+  common::BigintRange acrossPages(150, 250, false);
+  EXPECT_EQ(
+      std::vector<int32_t>({0, 3}),
+      skippedPages(index.pagesToSkip(&acrossPages, BIGINT()), 4));
+
+  common::BigintRange allPages(-10, 1000, false);
+  EXPECT_TRUE(index.pagesToSkip(&allPages, BIGINT()).empty());
+}
+
+TEST(PageIndexTest, nulls) {
+  auto [columnIndex, offsetIndex] = makeIndex(3, 100);
+  columnIndex.null_pages[1] = true;
+  columnIndex.min_values[1] = "";
+  columnIndex.max_values[1] = "";
+  columnIndex.null_counts[1] = 100;
+  columnIndex.null_counts[2] = 10;
+  PageIndex index(columnIndex, offsetIndex, 300);
+
+  // A filter that does not pass nulls skips the all null page.
+  common::BigintRange range(0, 1000, false);
+  EXPECT_EQ(
+      std::vector<int32_t>({1}),
+      skippedPages(index.pagesToSkip(&range, BIGINT()), 3));
+
+  // A filter passing nulls must read pages that have nulls.
+  common::BigintRange rangeWithNulls(1000, 2000, true);
+  EXPECT_EQ(
+      std::vector<int32_t>({0}),
+      skippedPages(index.pagesToSkip(&rangeWithNulls, BIGINT()), 3));
+
+  common::IsNull isNull;
+  EXPECT_EQ(
+      std::vector<int32_t>({0}),
+      skippedPages(index.pagesToSkip(&isNull, BIGINT()), 3));
+}
+
+TEST(PageIndexTest, read) {
+  auto [columnIndex, offsetIndex] = makeIndex(3, 100);
+  auto columnIndexData = serialize(columnIndex);
+  auto offsetIndexData = serialize(offsetIndex);
+  dwio::common::SeekableArrayInputStream columnIndexStream(
+      columnIndexData.data(), columnIndexData.size());
+  dwio::common::SeekableArrayInputStream offsetIndexStream(
+      offsetIndexData.data(), offsetIndexData.size());
+  auto index = PageIndex::read(columnIndexStream, offsetIndexStream, 300);
+  EXPECT_EQ(3, index->numPages());
+  EXPECT_EQ(100, index->firstRowOfPage(1));
+
+  common::BigintRange inLastPage(290, 310, false);
+  EXPECT_EQ(
+      std::vector<int32_t>({0, 1}),
+      skippedPages(index->pagesToSkip(&inLastPage, BIGINT()), 3));
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+namespace {
+
+// DELTA_BINARY_PACKED header for one block of 128 values in 4 miniblocks of
+// 32, followed by 'numValues' and the zigzag encoded first value.
+std::string deltaHeader(uint8_t numValues, uint8_t zigzagFirstValue) {
+  return std::string{'\x80', '\x01', '\x04', static_cast<char>(numValues)} +
+      static_cast<char>(zigzagFirstValue);
+}
+
+// Block with zigzag encoded 'minDelta' and a first miniblock of 'bitWidth'
+// bits with 'packed' as its leading bytes.
+std::string deltaBlock(
+    uint8_t zigzagMinDelta,
+    uint8_t bitWidth,
+    const std::string& packed) {
+  std::string block{
+      static_cast<char>(zigzagMinDelta),
+      static_cast<char>(bitWidth),
+      '\0',
+      '\0',
+      '\0'};
+  std::string miniBlock(bitWidth * 32 / 8, '\0');
+  miniBlock.replace(0, packed.size(), packed);
+  return block + miniBlock;
+}
+
+// Pads 'data' so that the 8 byte loads of bit unpacking stay in bounds.
+std::string padded(std::string data) {
+  return data + std::string(8, '\0');
+}
+
+} // namespace
+
+TEST(ParquetDecoderTest, deltaLengthByteArray) {
+  // Lengths 3, 5, 2: deltas 2, -3, min delta -3, relative deltas 5, 0.
+  auto data = padded(
+      deltaHeader(3, 6) + deltaBlock(5, 3, std::string{'\x05'}) +
+      "abchelloxy");
+  DeltaLengthByteArrayDecoder decoder(data.data());
+  EXPECT_EQ("abc", decoder.readString());
+  EXPECT_EQ("hello", decoder.readString());
+  EXPECT_EQ("xy", decoder.readString());
+
+  DeltaLengthByteArrayDecoder skipping(data.data());
+  skipping.skip(2);
+  EXPECT_EQ("xy", skipping.readString());
+}
+
+TEST(ParquetDecoderTest, deltaByteArray) {
+  // "apple", "applesauce", "apricot": prefixes 0, 5, 2 and suffixes "apple",
+  // "sauce", "ricot". Prefix deltas 5, -3, min delta -3, relative deltas 8,
+  // 0. Suffix lengths are all 5 with zero deltas.
+  auto data = padded(
+      deltaHeader(3, 0) + deltaBlock(5, 4, std::string{'\x08'}) +
+      deltaHeader(3, 10) + deltaBlock(0, 0, "") + "applesaucericot");
+  DeltaByteArrayDecoder decoder(data.data());
+  EXPECT_EQ("apple", decoder.readString());
+  EXPECT_EQ("applesauce", decoder.readString());
+  EXPECT_EQ("apricot", decoder.readString());
+
+  DeltaByteArrayDecoder skipping(data.data());
+  skipping.skip(1);
+  EXPECT_EQ("applesauce", skipping.readString());
+  skipping.skip(1);
+}
+
+TEST(ParquetDecoderTest, deltaByteArrayBadPrefix) {
+  // The first value cannot have a prefix.
+  auto data = padded(
+      deltaHeader(1, 2) + deltaHeader(1, 2) + std::string("ab"));
+  DeltaByteArrayDecoder decoder(data.data());
+  EXPECT_THROW(decoder.readString(), VeloxException);
+}
+
+TEST(ParquetDecoderTest, byteStreamSplit) {
+  std::vector<double> values = {1.5, -2.25, 1e100, 0};
+  constexpr int32_t kWidth = sizeof(double);
+  std::string data(values.size() * kWidth, '\0');
+  for (auto i = 0; i < values.size(); ++i) {
+    auto bytes = reinterpret_cast<const char*>(&values[i]);
+    for (auto k = 0; k < kWidth; ++k) {
+      data[k * values.size() + i] = bytes[k];
+    }
+  }
+  ByteStreamSplitDecoder decoder(
+      data.data(), data.data() + data.size(), kWidth);
+  EXPECT_EQ(1.5, decoder.readValue<double>());
+  decoder.skip(1);
+  EXPECT_EQ(1e100, decoder.readValue<double>());
+  EXPECT_EQ(0, decoder.readValue<double>());
+
+  EXPECT_THROW(
+      ByteStreamSplitDecoder(data.data(), data.data() + 7, kWidth),
+      VeloxException);
+}
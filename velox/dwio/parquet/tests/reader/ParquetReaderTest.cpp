@@ -648,6 +648,172 @@ TEST_F(ParquetReaderTest, parseMapKeyValueAsMap) {
   assertReadWithReaderAndExpected(fileSchema, *rowReader, expected, *leafPool_);
 }
 
+TEST_F(ParquetReaderTest, lazyNestedColumns) {
+  constexpr int32_t kNumRows = 1'000;
+  auto rowType = ROW(
+      {"id", "payload", "tags"},
+      {BIGINT(), MAP(BIGINT(), BIGINT()), ARRAY(BIGINT())});
+  auto data = makeRowVector(
+      {"id", "payload", "tags"},
+      {makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+       makeMapVector<int64_t, int64_t>(
+           kNumRows,
+           [](auto row) { return row % 5; },
+           [](auto index) { return index; },
+           [](auto index) { return index * 2; }),
+       makeArrayVector<int64_t>(
+           kNumRows,
+           [](auto row) { return row % 3; },
+           [](auto index) { return index; })});
+
+  auto filePath = fmt::format("{}/lazy_nested.parquet", tempPath_->getPath());
+  auto writer = createWriter(
+      createSink(filePath),
+      [&]() {
+        return std::make_unique<LambdaFlushPolicy>(
+            kRowsInRowGroup, kBytesInRowGroup, [&]() { return false; });
+      },
+      rowType);
+  writer->write(data);
+  writer->close();
+
+  facebook::velox::dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReader(filePath, readerOptions);
+  auto scanSpec = makeScanSpec(rowType);
+  scanSpec->childByName("id")->setFilter(exec::between(100, 199));
+  auto rowReaderOpts = getReaderOpts(rowType);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+  ASSERT_EQ(rowReader->next(kNumRows, result), kNumRows);
+  auto rowVector = result->as<RowVector>();
+  ASSERT_EQ(rowVector->size(), 100);
+  EXPECT_FALSE(rowVector->childAt(0)->isLazy());
+  ASSERT_TRUE(rowVector->childAt(1)->isLazy());
+  ASSERT_TRUE(rowVector->childAt(2)->isLazy());
+
+  // Load only some of the rows that passed the filter.
+  std::vector<vector_size_t> rows = {0, 37, 99};
+  auto lazyPayload = rowVector->childAt(1)->as<LazyVector>();
+  lazyPayload->load(rows, nullptr);
+  auto payload = lazyPayload->loadedVectorShared();
+  for (auto row : rows) {
+    ASSERT_TRUE(payload->equalValueAt(data->childAt(1).get(), row, row + 100))
+        << payload->toString(row);
+  }
+  auto tags = rowVector->childAt(2)->loadedVector();
+  for (auto row = 0; row < rowVector->size(); ++row) {
+    ASSERT_TRUE(tags->equalValueAt(data->childAt(2).get(), row, row + 100))
+        << tags->toString(row);
+  }
+}
+
+TEST_F(ParquetReaderTest, dictionaryEncodedStrings) {
+  constexpr int32_t kNumRows = 1'000;
+  std::vector<std::string> names;
+  for (auto i = 0; i < 10; ++i) {
+    names.push_back(fmt::format("a long string value {}", i));
+  }
+  auto rowType = ROW({"id", "name"}, {BIGINT(), VARCHAR()});
+  auto data = makeRowVector(
+      {"id", "name"},
+      {makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+       makeFlatVector<StringView>(kNumRows, [&](auto row) {
+         return StringView(names[row % names.size()]);
+       })});
+
+  auto filePath = fmt::format("{}/dict_strings.parquet", tempPath_->getPath());
+  auto writer = createWriter(
+      createSink(filePath),
+      [&]() {
+        return std::make_unique<LambdaFlushPolicy>(
+            kRowsInRowGroup, kBytesInRowGroup, [&]() { return false; });
+      },
+      rowType);
+  writer->write(data);
+  writer->close();
+
+  auto read = [&](bool makeFlat, int64_t maxId) {
+    facebook::velox::dwio::common::ReaderOptions readerOptions{
+        leafPool_.get()};
+    auto reader = createReader(filePath, readerOptions);
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName("id")->setFilter(exec::lessThanOrEqual(maxId));
+    scanSpec->childByName("name")->setMakeFlat(makeFlat);
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+    EXPECT_EQ(rowReader->next(kNumRows, result), kNumRows);
+    auto names = result->as<RowVector>()->childAt(1)->loadedVector();
+    for (auto row = 0; row < result->size(); ++row) {
+      EXPECT_TRUE(names->equalValueAt(data->childAt(1).get(), row, row));
+    }
+    return names->encoding();
+  };
+
+  EXPECT_EQ(VectorEncoding::Simple::DICTIONARY, read(false, kNumRows));
+  EXPECT_EQ(VectorEncoding::Simple::FLAT, read(true, kNumRows));
+  // Fewer values pass than there are in the dictionary.
+  EXPECT_EQ(VectorEncoding::Simple::FLAT, read(false, 5));
+}
+
+TEST_F(ParquetReaderTest, writePageIndexAndBloomFilter) {
+  constexpr int32_t kNumRows = 1'000;
+  constexpr int32_t kRowsPerGroup = 250;
+  auto rowType = ROW({"id", "name"}, {BIGINT(), VARCHAR()});
+  auto data = makeRowVector(
+      {"id", "name"},
+      {makeFlatVector<int64_t>(kNumRows, [](auto row) { return row * 2; }),
+       makeFlatVector<std::string>(
+           kNumRows, [](auto row) { return fmt::format("name {}", row); })});
+
+  auto filePath = fmt::format("{}/bloom.parquet", tempPath_->getPath());
+  facebook::velox::parquet::WriterOptions options;
+  options.memoryPool = rootPool_.get();
+  options.flushPolicyFactory = [&]() {
+    return std::make_unique<LambdaFlushPolicy>(
+        kRowsPerGroup, kBytesInRowGroup, [&]() { return false; });
+  };
+  options.enablePageIndex = true;
+  options.bloomFilterColumns = {"id"};
+  options.bloomFilterFpp = 0.01;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      createSink(filePath), options, rowType);
+  writer->write(data);
+  writer->close();
+
+  facebook::velox::dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReader(filePath, readerOptions);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), kNumRows / kRowsPerGroup);
+  for (auto i = 0; i < reader->fileMetaData().numRowGroups(); ++i) {
+    auto rowGroup = reader->fileMetaData().rowGroup(i);
+    EXPECT_TRUE(rowGroup.columnChunk(0).hasPageIndex());
+    EXPECT_TRUE(rowGroup.columnChunk(1).hasPageIndex());
+    EXPECT_TRUE(rowGroup.columnChunk(0).hasBloomFilterOffset());
+    EXPECT_FALSE(rowGroup.columnChunk(1).hasBloomFilterOffset());
+  }
+
+  auto countRows = [&](int64_t id) {
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->childByName("id")->setFilter(exec::equal(id));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+    int64_t numRows = 0;
+    while (rowReader->next(kNumRows, result)) {
+      numRows += result->size();
+    }
+    return numRows;
+  };
+  EXPECT_EQ(countRows(10), 1);
+  // Odd values are within the min/max of the first row group but are not in
+  // its Bloom filter.
+  EXPECT_EQ(countRows(11), 0);
+}
+
 TEST_F(ParquetReaderTest, readSampleBigintRangeFilter) {
   // Read sample.parquet with the int filter "a BETWEEN 16 AND 20".
   FilterMap filters;
@@ -1004,6 +1170,38 @@ TEST_F(ParquetReaderTest, prefetchRowGroups) {
   }
 }
 
+TEST_F(ParquetReaderTest, prefetchRowGroupsWithinBudget) {
+  auto rowType = ROW({"id"}, {BIGINT()});
+  const std::string sample(getExampleFilePath("multiple_row_groups.parquet"));
+  const int numRowGroups = 4;
+
+  facebook::velox::dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  readerOptions.setFilePreloadThreshold(0);
+  readerOptions.setPrefetchRowGroups(numRowGroups);
+  // Too small for any row group to be read ahead.
+  readerOptions.setMaxPrefetchRowGroupBytes(1);
+
+  auto reader = createReader(sample, readerOptions);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto parquetRowReader = dynamic_cast<ParquetRowReader*>(rowReader.get());
+
+  constexpr int kBatchSize = 1000;
+  auto result = BaseVector::create(rowType, kBatchSize, pool_.get());
+  uint64_t numRows = 0;
+  for (int i = 0; i < numRowGroups; i++) {
+    // The current row group is always loaded, the next ones are not.
+    EXPECT_TRUE(parquetRowReader->isRowGroupBuffered(i));
+    if (i < numRowGroups - 1) {
+      EXPECT_FALSE(parquetRowReader->isRowGroupBuffered(i + 1));
+    }
+    numRows += parquetRowReader->next(kBatchSize, result);
+    parquetRowReader->nextRowNumber();
+  }
+  EXPECT_EQ(numRows, reader->numberOfRows().value());
+}
+
 TEST_F(ParquetReaderTest, testEmptyRowGroups) {
   // empty_row_groups.parquet contains empty row groups
   const std::string sample(getExampleFilePath("empty_row_groups.parquet"));
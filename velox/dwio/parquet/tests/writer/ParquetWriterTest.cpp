@@ -135,6 +135,47 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, arrowMemoryInWriterPool) {
+  const int64_t kRows = 10'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+      makeFlatVector<StringView>(
+          kRows, [](auto row) { return StringView::makeInline("abc"); }),
+  });
+  auto schema = asRowType(data->type());
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.compression = CompressionKind::CompressionKind_SNAPPY;
+
+  auto writerPool = rootPool_->addAggregateChild("arrowMemoryInWriterPool");
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, writerPool, schema);
+  writer->write(data);
+  writer->flush();
+
+  memory::MemoryPool* arrowPool = nullptr;
+  writerPool->visitChildren([&](memory::MemoryPool* child) {
+    if (child->name() == ".arrow") {
+      arrowPool = child;
+    }
+    return true;
+  });
+  ASSERT_NE(arrowPool, nullptr);
+  EXPECT_GT(arrowPool->peakBytes(), 0);
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), kRows);
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+}
+
 DEBUG_ONLY_TEST_F(ParquetWriterTest, unitFromWriterOptions) {
   SCOPED_TESTVALUE_SET(
       "facebook::velox::parquet::Writer::write",
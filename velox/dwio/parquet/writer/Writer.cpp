@@ -17,6 +17,7 @@
 #include "velox/dwio/parquet/writer/Writer.h"
 #include <arrow/c/bridge.h>
 #include <arrow/io/interfaces.h>
+#include <arrow/memory_pool.h>
 #include <arrow/table.h>
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
@@ -94,6 +95,89 @@ class ArrowDataBufferSink : public ::arrow::io::OutputStream {
   int64_t bytesFlushed_ = 0;
 };
 
+// Arrow memory pool that allocates from a Velox leaf memory pool so that the
+// memory used by the Arrow writer for encoding and compression is accounted
+// for in the writer's pool. Failures to allocate throw as they do for any
+// other allocation from 'pool'.
+class ArrowMemoryPool : public ::arrow::MemoryPool {
+ public:
+  explicit ArrowMemoryPool(memory::MemoryPool& pool) : pool_(pool) {}
+
+  ::arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t** out)
+      override {
+    VELOX_CHECK_LE(alignment, pool_.alignment());
+    if (size == 0) {
+      *out = zeroSizeArea();
+      return ::arrow::Status::OK();
+    }
+    *out = reinterpret_cast<uint8_t*>(pool_.allocate(size));
+    totalBytesAllocated_ += size;
+    ++numAllocations_;
+    return ::arrow::Status::OK();
+  }
+
+  ::arrow::Status Reallocate(
+      int64_t oldSize,
+      int64_t newSize,
+      int64_t alignment,
+      uint8_t** ptr) override {
+    VELOX_CHECK_LE(alignment, pool_.alignment());
+    if (*ptr == zeroSizeArea()) {
+      return Allocate(newSize, alignment, ptr);
+    }
+    if (newSize == 0) {
+      Free(*ptr, oldSize, alignment);
+      *ptr = zeroSizeArea();
+      return ::arrow::Status::OK();
+    }
+    *ptr = reinterpret_cast<uint8_t*>(pool_.reallocate(*ptr, oldSize, newSize));
+    if (newSize > oldSize) {
+      totalBytesAllocated_ += newSize - oldSize;
+    }
+    ++numAllocations_;
+    return ::arrow::Status::OK();
+  }
+
+  void Free(uint8_t* buffer, int64_t size, int64_t /*alignment*/) override {
+    if (buffer == zeroSizeArea()) {
+      return;
+    }
+    pool_.free(buffer, size);
+  }
+
+  int64_t bytes_allocated() const override {
+    return pool_.currentBytes();
+  }
+
+  int64_t max_memory() const override {
+    return pool_.peakBytes();
+  }
+
+  int64_t total_bytes_allocated() const override {
+    return totalBytesAllocated_;
+  }
+
+  int64_t num_allocations() const override {
+    return numAllocations_;
+  }
+
+  std::string backend_name() const override {
+    return "velox";
+  }
+
+ private:
+  // Arrow represents empty buffers with a non-null pointer that is never
+  // freed.
+  static uint8_t* zeroSizeArea() {
+    alignas(memory::MemoryAllocator::kMaxAlignment) static uint8_t area[1];
+    return area;
+  }
+
+  memory::MemoryPool& pool_;
+  std::atomic<int64_t> totalBytesAllocated_{0};
+  std::atomic<int64_t> numAllocations_{0};
+};
+
 struct ArrowContext {
   std::unique_ptr<FileWriter> writer;
   std::shared_ptr<::arrow::Schema> schema;
@@ -143,6 +227,13 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
+  for (const auto& column : options.bloomFilterColumns) {
+    properties = properties->enable_bloom_filter(column);
+  }
+  properties = properties->bloom_filter_fpp(options.bloomFilterFpp);
   return properties->build();
 }
 
@@ -221,6 +312,8 @@ Writer::Writer(
     RowTypePtr schema)
     : pool_(std::move(pool)),
       generalPool_{pool_->addLeafChild(".general")},
+      arrowPool_{pool_->addLeafChild(".arrow")},
+      arrowMemoryPool_{std::make_unique<ArrowMemoryPool>(*arrowPool_)},
       stream_(std::make_shared<ArrowDataBufferSink>(
           std::move(sink),
           *generalPool_,
@@ -253,6 +346,8 @@ Writer::Writer(
               folly::to<std::string>(folly::Random::rand64()))),
           std::move(schema)} {}
 
+Writer::~Writer() = default;
+
 void Writer::flush() {
   if (arrowContext_->stagingRows > 0) {
     if (!arrowContext_->writer) {
@@ -261,7 +356,7 @@ void Writer::flush() {
           arrowContext_->writer,
           FileWriter::Open(
               *arrowContext_->schema.get(),
-              ::arrow::default_memory_pool(),
+              arrowMemoryPool_.get(),
               stream_,
               arrowContext_->properties,
               arrowProperties));
@@ -393,6 +488,13 @@ parquet::WriterOptions getParquetOptions(
     parquetOptions.parquetWriteTimestampUnit =
         options.parquetWriteTimestampUnit.value();
   }
+  if (options.parquetWritePageIndex.has_value()) {
+    parquetOptions.enablePageIndex = options.parquetWritePageIndex.value();
+  }
+  parquetOptions.bloomFilterColumns = options.parquetBloomFilterColumns;
+  if (options.parquetBloomFilterFpp.has_value()) {
+    parquetOptions.bloomFilterFpp = options.parquetBloomFilterFpp.value();
+  }
   return parquetOptions;
 }
 
@@ -411,6 +513,7 @@ void Writer::setMemoryReclaimers() {
   // TODO https://github.com/facebookincubator/velox/issues/8190
   pool_->setReclaimer(exec::MemoryReclaimer::create());
   generalPool_->setReclaimer(exec::MemoryReclaimer::create());
+  arrowPool_->setReclaimer(exec::MemoryReclaimer::create());
 }
 
 std::unique_ptr<dwio::common::Writer> ParquetWriterFactory::createWriter(
@@ -34,6 +34,8 @@ using facebook::velox::parquet::arrow::util::CodecOptions;
 
 class ArrowDataBufferSink;
 
+class ArrowMemoryPool;
+
 struct ArrowContext;
 
 class DefaultFlushPolicy : public dwio::common::FlushPolicy {
@@ -105,6 +107,13 @@ struct WriterOptions {
       columnCompressionsMap;
   uint8_t parquetWriteTimestampUnit =
       static_cast<uint8_t>(TimestampUnit::kNano);
+  // Writes the ColumnIndex and OffsetIndex of all columns.
+  bool enablePageIndex = false;
+  // Columns to write split block Bloom filters for. Nested columns are
+  // named by their dot separated Parquet path.
+  std::vector<std::string> bloomFilterColumns;
+  // False positive probability the Bloom filters are sized for.
+  double bloomFilterFpp = 0.05;
 };
 
 // Writes Velox vectors into  a DataSink using Arrow Parquet writer.
@@ -126,7 +135,7 @@ class Writer : public dwio::common::Writer {
       const WriterOptions& options,
       RowTypePtr schema);
 
-  ~Writer() override = default;
+  ~Writer() override;
 
   static bool isCodecAvailable(common::CompressionKind compression);
 
@@ -152,6 +161,9 @@ class Writer : public dwio::common::Writer {
   // Pool for 'stream_'.
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<memory::MemoryPool> generalPool_;
+  // Pool for the allocations of the Arrow writer.
+  std::shared_ptr<memory::MemoryPool> arrowPool_;
+  std::unique_ptr<ArrowMemoryPool> arrowMemoryPool_;
 
   // Temporary Arrow stream for capturing the output.
   std::shared_ptr<ArrowDataBufferSink> stream_;
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/arrow/BloomFilterBuilder.h"
+
+#include "arrow/array.h"
+#include "arrow/util/checked_cast.h"
+#include "velox/dwio/parquet/writer/arrow/Exception.h"
+#include "velox/dwio/parquet/writer/arrow/Metadata.h"
+#include "velox/dwio/parquet/writer/arrow/Properties.h"
+#include "velox/dwio/parquet/writer/arrow/Schema.h"
+#include "velox/dwio/parquet/writer/arrow/ThriftInternal.h"
+
+namespace facebook::velox::parquet::arrow {
+
+ColumnBloomFilter::ColumnBloomFilter(double fpp, int32_t max_bytes)
+    : fpp_(fpp), max_bytes_(max_bytes) {
+  if (fpp <= 0 || fpp >= 1) {
+    throw ParquetException("Bloom filter fpp must be in (0, 1)");
+  }
+  if (max_bytes < SplitBlockBloomFilter::kBytesPerBlock) {
+    throw ParquetException("Bloom filter max bytes is too small");
+  }
+}
+
+// static
+bool ColumnBloomFilter::IsSupported(Type::type physical_type) {
+  switch (physical_type) {
+    case Type::INT32:
+    case Type::INT64:
+    case Type::FLOAT:
+    case Type::DOUBLE:
+    case Type::BYTE_ARRAY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void ColumnBloomFilter::InsertHash(uint64_t hash) {
+  if (!bitset_.empty()) {
+    SplitBlockBloomFilter::insertHash(
+        hash, reinterpret_cast<char*>(bitset_.data()), max_bytes_);
+    return;
+  }
+  hashes_.insert(hash);
+  if (hashes_.size() * sizeof(uint64_t) > static_cast<size_t>(max_bytes_)) {
+    bitset_.resize(max_bytes_ / sizeof(uint32_t));
+    for (auto value : hashes_) {
+      SplitBlockBloomFilter::insertHash(
+          value, reinterpret_cast<char*>(bitset_.data()), max_bytes_);
+    }
+    hashes_.clear();
+  }
+}
+
+namespace {
+template <typename ArrayType>
+void InsertBinary(const ::arrow::Array& values, ColumnBloomFilter* filter) {
+  const auto& binary =
+      ::arrow::internal::checked_cast<const ArrayType&>(values);
+  for (int64_t i = 0; i < binary.length(); ++i) {
+    if (binary.IsValid(i)) {
+      auto view = binary.GetView(i);
+      filter->InsertHash(SplitBlockBloomFilter::hash(
+          std::string_view(view.data(), view.size())));
+    }
+  }
+}
+} // namespace
+
+void ColumnBloomFilter::Insert(const ::arrow::Array& values) {
+  switch (values.type_id()) {
+    case ::arrow::Type::BINARY:
+    case ::arrow::Type::STRING:
+      InsertBinary<::arrow::BinaryArray>(values, this);
+      break;
+    case ::arrow::Type::LARGE_BINARY:
+    case ::arrow::Type::LARGE_STRING:
+      InsertBinary<::arrow::LargeBinaryArray>(values, this);
+      break;
+    default:
+      throw ParquetException(
+          "Bloom filter not supported for ", values.type()->ToString());
+  }
+}
+
+void ColumnBloomFilter::WriteTo(::arrow::io::OutputStream* sink) const {
+  int32_t num_bytes = max_bytes_;
+  std::vector<uint32_t> sized_bitset;
+  const std::vector<uint32_t>* bitset = &bitset_;
+  if (bitset_.empty()) {
+    num_bytes = SplitBlockBloomFilter::optimalNumBytes(
+        hashes_.size(), fpp_, max_bytes_);
+    sized_bitset.resize(num_bytes / sizeof(uint32_t));
+    for (auto hash : hashes_) {
+      SplitBlockBloomFilter::insertHash(
+          hash, reinterpret_cast<char*>(sized_bitset.data()), num_bytes);
+    }
+    bitset = &sized_bitset;
+  }
+
+  format::BloomFilterHeader header;
+  header.__set_numBytes(num_bytes);
+  format::BloomFilterAlgorithm algorithm;
+  algorithm.__set_BLOCK(format::SplitBlockAlgorithm());
+  header.__set_algorithm(algorithm);
+  format::BloomFilterHash hash;
+  hash.__set_XXHASH(format::XxHash());
+  header.__set_hash(hash);
+  format::BloomFilterCompression compression;
+  compression.__set_UNCOMPRESSED(format::Uncompressed());
+  header.__set_compression(compression);
+  ThriftSerializer{}.Serialize(&header, sink);
+  PARQUET_THROW_NOT_OK(sink->Write(bitset->data(), num_bytes));
+}
+
+namespace {
+
+class BloomFilterBuilderImpl final : public BloomFilterBuilder {
+ public:
+  BloomFilterBuilderImpl(
+      const SchemaDescriptor* schema,
+      const WriterProperties* properties)
+      : schema_(schema), properties_(properties) {}
+
+  void AppendRowGroup() override {
+    bloom_filters_.emplace_back(schema_->num_columns());
+  }
+
+  ColumnBloomFilter* GetOrCreateBloomFilter(int32_t column_ordinal) override {
+    if (column_ordinal < 0 || column_ordinal >= schema_->num_columns()) {
+      throw ParquetException("Invalid column ordinal: ", column_ordinal);
+    }
+    if (bloom_filters_.empty()) {
+      throw ParquetException("No row group appended to BloomFilterBuilder.");
+    }
+    const auto* descr = schema_->Column(column_ordinal);
+    if (!properties_->bloom_filter_enabled(descr->path()) ||
+        !ColumnBloomFilter::IsSupported(descr->physical_type())) {
+      return nullptr;
+    }
+    auto& filter = bloom_filters_.back()[column_ordinal];
+    if (filter == nullptr) {
+      filter = std::make_unique<ColumnBloomFilter>(
+          properties_->bloom_filter_fpp(descr->path()),
+          properties_->max_bloom_filter_bytes(descr->path()));
+    }
+    return filter.get();
+  }
+
+  void WriteTo(::arrow::io::OutputStream* sink, BloomFilterLocation* location)
+      const override {
+    location->bloom_filter_offset.clear();
+    for (size_t row_group = 0; row_group < bloom_filters_.size();
+         ++row_group) {
+      const auto& filters = bloom_filters_[row_group];
+      std::vector<std::optional<int64_t>> offsets(filters.size());
+      bool has_filter = false;
+      for (size_t column = 0; column < filters.size(); ++column) {
+        if (filters[column] == nullptr) {
+          continue;
+        }
+        PARQUET_ASSIGN_OR_THROW(int64_t offset, sink->Tell());
+        filters[column]->WriteTo(sink);
+        offsets[column] = offset;
+        has_filter = true;
+      }
+      if (has_filter) {
+        location->bloom_filter_offset.emplace(row_group, std::move(offsets));
+      }
+    }
+  }
+
+ private:
+  const SchemaDescriptor* schema_;
+  const WriterProperties* properties_;
+  std::vector<std::vector<std::unique_ptr<ColumnBloomFilter>>> bloom_filters_;
+};
+
+} // namespace
+
+std::unique_ptr<BloomFilterBuilder> BloomFilterBuilder::Make(
+    const SchemaDescriptor* schema,
+    const WriterProperties* properties) {
+  return std::make_unique<BloomFilterBuilderImpl>(schema, properties);
+}
+
+} // namespace facebook::velox::parquet::arrow
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "arrow/io/interfaces.h"
+#include "arrow/util/bit_util.h"
+#include "velox/dwio/parquet/common/BloomFilter.h"
+#include "velox/dwio/parquet/writer/arrow/Types.h"
+
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace arrow {
+class Array;
+} // namespace arrow
+
+namespace facebook::velox::parquet::arrow {
+
+struct BloomFilterLocation;
+class SchemaDescriptor;
+class WriterProperties;
+
+/// \brief Collects the values written to a column chunk for its split block
+/// Bloom filter.
+///
+/// Distinct hashes are kept until the filter is written so that it can be
+/// sized for them. Once keeping the hashes would take more memory than a
+/// filter of the maximum size, the hashes are inserted into such a filter
+/// instead.
+class PARQUET_EXPORT ColumnBloomFilter {
+ public:
+  ColumnBloomFilter(double fpp, int32_t max_bytes);
+
+  /// \brief Returns true if Bloom filters are written for columns of
+  /// `physical_type`.
+  static bool IsSupported(Type::type physical_type);
+
+  void InsertHash(uint64_t hash);
+
+  template <typename T>
+  void Insert(const T* values, int64_t num_values) {
+    for (int64_t i = 0; i < num_values; ++i) {
+      InsertHash(Hash(values[i]));
+    }
+  }
+
+  template <typename T>
+  void InsertSpaced(
+      const T* values,
+      int64_t num_spaced_values,
+      const uint8_t* valid_bits,
+      int64_t valid_bits_offset) {
+    for (int64_t i = 0; i < num_spaced_values; ++i) {
+      if (::arrow::bit_util::GetBit(valid_bits, valid_bits_offset + i)) {
+        InsertHash(Hash(values[i]));
+      }
+    }
+  }
+
+  /// \brief Inserts the non-null values of a binary or string array.
+  void Insert(const ::arrow::Array& values);
+
+  /// \brief Serializes the BloomFilterHeader and the bitset to `sink`.
+  void WriteTo(::arrow::io::OutputStream* sink) const;
+
+ private:
+  template <typename T>
+  static uint64_t Hash(const T& value) {
+    return SplitBlockBloomFilter::hash(value);
+  }
+
+  static uint64_t Hash(const ByteArray& value) {
+    return SplitBlockBloomFilter::hash(
+        std::string_view(reinterpret_cast<const char*>(value.ptr), value.len));
+  }
+
+  const double fpp_;
+  const int32_t max_bytes_;
+  std::unordered_set<uint64_t> hashes_;
+  // Filter of 'max_bytes_' once 'hashes_' has grown too large.
+  std::vector<uint32_t> bitset_;
+};
+
+/// \brief Interface for collecting the Bloom filters of a parquet file.
+class PARQUET_EXPORT BloomFilterBuilder {
+ public:
+  /// \brief API convenience to create a BloomFilterBuilder.
+  static std::unique_ptr<BloomFilterBuilder> Make(
+      const SchemaDescriptor* schema,
+      const WriterProperties* properties);
+
+  virtual ~BloomFilterBuilder() = default;
+
+  /// \brief Start a new row group to host all Bloom filters of its column
+  /// chunks.
+  virtual void AppendRowGroup() = 0;
+
+  /// \brief Get the ColumnBloomFilter of a column in the current row group.
+  ///
+  /// \return nullptr if no Bloom filter is written for the column.
+  virtual ColumnBloomFilter* GetOrCreateBloomFilter(int32_t column_ordinal) = 0;
+
+  /// \brief Serialize all Bloom filters with the same order of row groups and
+  /// columns and report their locations to `location`.
+  virtual void WriteTo(
+      ::arrow::io::OutputStream* sink,
+      BloomFilterLocation* location) const = 0;
+};
+
+} // namespace facebook::velox::parquet::arrow
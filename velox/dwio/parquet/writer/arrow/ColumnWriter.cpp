@@ -43,6 +43,7 @@
 #include "arrow/util/rle_encoding.h"
 #include "arrow/util/type_traits.h"
 
+#include "velox/dwio/parquet/writer/arrow/BloomFilterBuilder.h"
 #include "velox/dwio/parquet/writer/arrow/ColumnPage.h"
 #include "velox/dwio/parquet/writer/arrow/Encoding.h"
 #include "velox/dwio/parquet/writer/arrow/Encryption.h"
@@ -1455,18 +1456,26 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
  public:
   using T = typename DType::c_type;
 
+  // True if the values of this type are inserted into Bloom filters. See
+  // ColumnBloomFilter::IsSupported().
+  static constexpr bool kSupportsBloomFilter = std::is_same_v<T, int32_t> ||
+      std::is_same_v<T, int64_t> || std::is_same_v<T, float> ||
+      std::is_same_v<T, double> || std::is_same_v<T, ByteArray>;
+
   TypedColumnWriterImpl(
       ColumnChunkMetaDataBuilder* metadata,
       std::unique_ptr<PageWriter> pager,
       const bool use_dictionary,
       Encoding::type encoding,
-      const WriterProperties* properties)
+      const WriterProperties* properties,
+      ColumnBloomFilter* bloom_filter)
       : ColumnWriterImpl(
             metadata,
             std::move(pager),
             use_dictionary,
             encoding,
-            properties) {
+            properties),
+        bloom_filter_(bloom_filter) {
     current_encoder_ = MakeEncoder(
         DType::type_num,
         encoding,
@@ -1751,6 +1760,8 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
   DictEncoder<DType>* current_dict_encoder_;
   std::shared_ptr<TypedStats> page_statistics_;
   std::shared_ptr<TypedStats> chunk_statistics_;
+  // Receives the values written if not null.
+  ColumnBloomFilter* const bloom_filter_;
   bool pages_change_on_record_boundaries_;
 
   // If writing a sequence of ::arrow::DictionaryArray to the writer, we keep
@@ -1954,6 +1965,11 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
     if (page_statistics_ != nullptr) {
       page_statistics_->Update(values, num_values, num_nulls);
     }
+    if constexpr (kSupportsBloomFilter) {
+      if (bloom_filter_ != nullptr) {
+        bloom_filter_->Insert(values, num_values);
+      }
+    }
   }
 
   /// \brief Write values with spaces and update page statistics accordingly.
@@ -1990,6 +2006,16 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
     } else {
       current_value_encoder_->Put(values, static_cast<int>(num_values));
     }
+    if constexpr (kSupportsBloomFilter) {
+      if (bloom_filter_ != nullptr) {
+        if (num_values != num_spaced_values) {
+          bloom_filter_->InsertSpaced(
+              values, num_spaced_values, valid_bits, valid_bits_offset);
+        } else {
+          bloom_filter_->Insert(values, num_values);
+        }
+      }
+    }
     if (page_statistics_ != nullptr) {
       page_statistics_->UpdateSpaced(
           values,
@@ -2039,7 +2065,7 @@ Status TypedColumnWriterImpl<DType>::WriteArrowDictionary(
   };
 
   if (!IsDictionaryEncoding(current_encoder_->encoding()) ||
-      !DictionaryDirectWriteSupported(array)) {
+      !DictionaryDirectWriteSupported(array) || bloom_filter_ != nullptr) {
     // No longer dictionary-encoding for whatever reason, maybe we never were
     // or we decided to stop. Note that WriteArrow can be invoked multiple
     // times with both dense and dictionary-encoded versions of the same data
@@ -2726,6 +2752,9 @@ Status TypedColumnWriterImpl<ByteArrayType>::WriteArrowDense(
         MaybeReplaceValidity(data_slice, null_count, ctx->memory_pool));
 
     current_encoder_->Put(*data_slice);
+    if (bloom_filter_ != nullptr) {
+      bloom_filter_->Insert(*data_slice);
+    }
     // Null values in ancestors count as nulls.
     const int64_t non_null = data_slice->length() - data_slice->null_count();
     if (page_statistics_ != nullptr) {
@@ -2883,7 +2912,8 @@ Status TypedColumnWriterImpl<FLBAType>::WriteArrowDense(
 std::shared_ptr<ColumnWriter> ColumnWriter::Make(
     ColumnChunkMetaDataBuilder* metadata,
     std::unique_ptr<PageWriter> pager,
-    const WriterProperties* properties) {
+    const WriterProperties* properties,
+    ColumnBloomFilter* bloom_filter) {
   const ColumnDescriptor* descr = metadata->descr();
   const bool use_dictionary = properties->dictionary_enabled(descr->path()) &&
       descr->physical_type() != Type::BOOLEAN;
@@ -2905,28 +2935,68 @@ std::shared_ptr<ColumnWriter> ColumnWriter::Make(
   switch (descr->physical_type()) {
     case Type::BOOLEAN:
       return std::make_shared<TypedColumnWriterImpl<BooleanType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::INT32:
       return std::make_shared<TypedColumnWriterImpl<Int32Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::INT64:
       return std::make_shared<TypedColumnWriterImpl<Int64Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::INT96:
       return std::make_shared<TypedColumnWriterImpl<Int96Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::FLOAT:
       return std::make_shared<TypedColumnWriterImpl<FloatType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::DOUBLE:
       return std::make_shared<TypedColumnWriterImpl<DoubleType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::BYTE_ARRAY:
       return std::make_shared<TypedColumnWriterImpl<ByteArrayType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::FIXED_LEN_BYTE_ARRAY:
       return std::make_shared<TypedColumnWriterImpl<FLBAType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     default:
       ParquetException::NYI("type reader not implemented");
   }
@@ -48,6 +48,7 @@ class CodecOptions;
 } // namespace util
 
 struct ArrowWriteContext;
+class ColumnBloomFilter;
 class ColumnChunkMetaDataBuilder;
 class ColumnDescriptor;
 class ColumnIndexBuilder;
@@ -163,10 +164,13 @@ class PARQUET_EXPORT ColumnWriter {
  public:
   virtual ~ColumnWriter() = default;
 
+  /// \brief Creates a writer for a column chunk. If `bloom_filter` is not
+  /// null, the values of the column chunk are inserted into it.
   static std::shared_ptr<ColumnWriter> Make(
       ColumnChunkMetaDataBuilder*,
       std::unique_ptr<PageWriter>,
-      const WriterProperties* properties);
+      const WriterProperties* properties,
+      ColumnBloomFilter* bloom_filter = NULLPTR);
 
   /// \brief Closes the ColumnWriter, commits any buffered values to pages.
   /// \return Total size of the column in bytes
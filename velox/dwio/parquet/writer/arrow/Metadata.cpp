@@ -2147,6 +2147,22 @@ class FileMetaDataBuilder::FileMetaDataBuilderImpl {
     }
   }
 
+  void SetBloomFilterLocation(const BloomFilterLocation& location) {
+    for (const auto& [row_group_ordinal, offsets] :
+         location.bloom_filter_offset) {
+      auto& row_group_metadata = row_groups_.at(row_group_ordinal);
+      for (size_t i = 0; i < offsets.size(); ++i) {
+        if (i >= row_group_metadata.columns.size()) {
+          throw ParquetException("Cannot find metadata for column ordinal ", i);
+        }
+        if (offsets[i].has_value()) {
+          row_group_metadata.columns[i].meta_data.__set_bloom_filter_offset(
+              offsets[i].value());
+        }
+      }
+    }
+  }
+
   std::unique_ptr<FileMetaData> Finish(
       const std::shared_ptr<const KeyValueMetadata>& key_value_metadata) {
     int64_t total_rows = 0;
@@ -2300,6 +2316,11 @@ void FileMetaDataBuilder::SetPageIndexLocation(
   impl_->SetPageIndexLocation(location);
 }
 
+void FileMetaDataBuilder::SetBloomFilterLocation(
+    const BloomFilterLocation& location) {
+  impl_->SetBloomFilterLocation(location);
+}
+
 std::unique_ptr<FileMetaData> FileMetaDataBuilder::Finish(
     const std::shared_ptr<const KeyValueMetadata>& key_value_metadata) {
   return impl_->Finish(key_value_metadata);
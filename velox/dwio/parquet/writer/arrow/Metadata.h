@@ -561,6 +561,14 @@ struct PageIndexLocation {
   FileIndexLocation offset_index_location;
 };
 
+/// \brief Public struct for location to all Bloom filters in a parquet file.
+struct BloomFilterLocation {
+  /// File offsets of the Bloom filters by row group ordinal and then by column
+  /// ordinal. If a column does not have a Bloom filter, its value is set to
+  /// std::nullopt.
+  std::map<size_t, std::vector<std::optional<int64_t>>> bloom_filter_offset;
+};
+
 class PARQUET_EXPORT FileMetaDataBuilder {
  public:
   ARROW_DEPRECATED(
@@ -583,6 +591,9 @@ class PARQUET_EXPORT FileMetaDataBuilder {
   // Update location to all page indexes in the parquet file
   void SetPageIndexLocation(const PageIndexLocation& location);
 
+  // Update location to all Bloom filters in the parquet file
+  void SetBloomFilterLocation(const BloomFilterLocation& location);
+
   // Complete the Thrift structure
   std::unique_ptr<FileMetaData> Finish(
       const std::shared_ptr<const KeyValueMetadata>& key_value_metadata =
@@ -219,6 +219,9 @@ static const char DEFAULT_CREATED_BY[] = CREATED_BY_VERSION;
 static constexpr Compression::type DEFAULT_COMPRESSION_TYPE =
     Compression::UNCOMPRESSED;
 static constexpr bool DEFAULT_IS_PAGE_INDEX_ENABLED = false;
+static constexpr bool DEFAULT_IS_BLOOM_FILTER_ENABLED = false;
+static constexpr double DEFAULT_BLOOM_FILTER_FPP = 0.05;
+static constexpr int32_t DEFAULT_MAX_BLOOM_FILTER_BYTES = 1024 * 1024;
 
 class PARQUET_EXPORT ColumnProperties {
  public:
@@ -271,6 +274,18 @@ class PARQUET_EXPORT ColumnProperties {
     page_index_enabled_ = page_index_enabled;
   }
 
+  void set_bloom_filter_enabled(bool bloom_filter_enabled) {
+    bloom_filter_enabled_ = bloom_filter_enabled;
+  }
+
+  void set_bloom_filter_fpp(double fpp) {
+    bloom_filter_fpp_ = fpp;
+  }
+
+  void set_max_bloom_filter_bytes(int32_t max_bytes) {
+    max_bloom_filter_bytes_ = max_bytes;
+  }
+
   Encoding::type encoding() const {
     return encoding_;
   }
@@ -303,6 +318,18 @@ class PARQUET_EXPORT ColumnProperties {
     return page_index_enabled_;
   }
 
+  bool bloom_filter_enabled() const {
+    return bloom_filter_enabled_;
+  }
+
+  double bloom_filter_fpp() const {
+    return bloom_filter_fpp_;
+  }
+
+  int32_t max_bloom_filter_bytes() const {
+    return max_bloom_filter_bytes_;
+  }
+
  private:
   Encoding::type encoding_;
   Compression::type codec_;
@@ -311,6 +338,9 @@ class PARQUET_EXPORT ColumnProperties {
   size_t max_stats_size_;
   std::shared_ptr<CodecOptions> codec_options_;
   bool page_index_enabled_;
+  bool bloom_filter_enabled_{DEFAULT_IS_BLOOM_FILTER_ENABLED};
+  double bloom_filter_fpp_{DEFAULT_BLOOM_FILTER_FPP};
+  int32_t max_bloom_filter_bytes_{DEFAULT_MAX_BLOOM_FILTER_BYTES};
 };
 
 class PARQUET_EXPORT WriterProperties {
@@ -733,6 +763,47 @@ class PARQUET_EXPORT WriterProperties {
       return this->disable_write_page_index(path->ToDotString());
     }
 
+    /// Enable writing split block Bloom filters for all columns. Default
+    /// disabled. Filters are written for INT32, INT64, FLOAT, DOUBLE and
+    /// BYTE_ARRAY columns and are sized for the distinct values of each
+    /// column chunk.
+    Builder* enable_bloom_filter() {
+      default_column_properties_.set_bloom_filter_enabled(true);
+      return this;
+    }
+
+    /// Disable writing Bloom filters for all columns. Default disabled.
+    Builder* disable_bloom_filter() {
+      default_column_properties_.set_bloom_filter_enabled(false);
+      return this;
+    }
+
+    /// Enable writing a Bloom filter for column specified by `path`. Default
+    /// disabled.
+    Builder* enable_bloom_filter(const std::string& path) {
+      bloom_filter_enabled_[path] = true;
+      return this;
+    }
+
+    /// Disable writing a Bloom filter for column specified by `path`.
+    Builder* disable_bloom_filter(const std::string& path) {
+      bloom_filter_enabled_[path] = false;
+      return this;
+    }
+
+    /// Specify the false positive probability the Bloom filters are sized
+    /// for. Default 0.05.
+    Builder* bloom_filter_fpp(double fpp) {
+      default_column_properties_.set_bloom_filter_fpp(fpp);
+      return this;
+    }
+
+    /// Specify the maximum size in bytes of a Bloom filter. Default 1MB.
+    Builder* max_bloom_filter_bytes(int32_t max_bytes) {
+      default_column_properties_.set_max_bloom_filter_bytes(max_bytes);
+      return this;
+    }
+
     /// \brief Build the WriterProperties with the builder parameters.
     /// \return The WriterProperties defined by the builder.
     std::shared_ptr<WriterProperties> build() {
@@ -757,6 +828,8 @@ class PARQUET_EXPORT WriterProperties {
         get(item.first).set_statistics_enabled(item.second);
       for (const auto& item : page_index_enabled_)
         get(item.first).set_page_index_enabled(item.second);
+      for (const auto& item : bloom_filter_enabled_)
+        get(item.first).set_bloom_filter_enabled(item.second);
 
       return std::shared_ptr<WriterProperties>(new WriterProperties(
           pool_,
@@ -801,6 +874,7 @@ class PARQUET_EXPORT WriterProperties {
     std::unordered_map<std::string, bool> dictionary_enabled_;
     std::unordered_map<std::string, bool> statistics_enabled_;
     std::unordered_map<std::string, bool> page_index_enabled_;
+    std::unordered_map<std::string, bool> bloom_filter_enabled_;
   };
 
   inline MemoryPool* memory_pool() const {
@@ -922,6 +996,33 @@ class PARQUET_EXPORT WriterProperties {
     return false;
   }
 
+  bool bloom_filter_enabled(
+      const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).bloom_filter_enabled();
+  }
+
+  bool bloom_filter_enabled() const {
+    if (default_column_properties_.bloom_filter_enabled()) {
+      return true;
+    }
+    for (const auto& item : column_properties_) {
+      if (item.second.bloom_filter_enabled()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  double bloom_filter_fpp(
+      const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).bloom_filter_fpp();
+  }
+
+  int32_t max_bloom_filter_bytes(
+      const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).max_bloom_filter_bytes();
+  }
+
   inline FileEncryptionProperties* file_encryption_properties() const {
     return file_encryption_properties_.get();
   }
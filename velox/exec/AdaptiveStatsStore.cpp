@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/AdaptiveStatsStore.h"
+
+#include <folly/hash/Hash.h>
+
+namespace facebook::velox::exec {
+
+// static
+AdaptiveStatsStore* AdaptiveStatsStore::getInstance() {
+  static AdaptiveStatsStore instance;
+  return &instance;
+}
+
+// static
+uint64_t AdaptiveStatsStore::fingerprint(const core::PlanNode& node) {
+  return folly::hasher<std::string>()(node.toString(true, true));
+}
+
+std::optional<AdaptiveStatsStore::NodeStats> AdaptiveStatsStore::lookup(
+    uint64_t fingerprint) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(fingerprint);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  const auto stats = it->second.stats;
+  if (++it->second.numLookups >= kMaxLookups) {
+    entries_.erase(it);
+  }
+  return stats;
+}
+
+void AdaptiveStatsStore::record(uint64_t fingerprint, const NodeStats& stats) {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.set(fingerprint, Entry{stats});
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/EvictingCacheMap.h>
+
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::exec {
+
+/// Process wide store of statistics observed by operators. Used by later
+/// runs of the same plan, e.g. dashboards issuing the same queries
+/// periodically, to start adaptive operators in the mode earlier runs ended
+/// up in instead of relearning it in every task. Entries are keyed by a
+/// fingerprint of the plan node and its sources and are evicted in LRU order.
+/// Thread safe.
+class AdaptiveStatsStore {
+ public:
+  /// The most entries kept.
+  static constexpr size_t kMaxEntries = 10'000;
+
+  /// The number of lookups an entry serves before it is dropped, so that the
+  /// adaptive choices are relearned when the data changes.
+  static constexpr int32_t kMaxLookups = 100;
+
+  /// Statistics recorded by one operator of a plan node.
+  struct NodeStats {
+    uint64_t numInputRows{0};
+    uint64_t numOutputRows{0};
+    /// True if a partial aggregation abandoned aggregating and passed its
+    /// input through.
+    bool abandonedPartialAggregation{false};
+  };
+
+  static AdaptiveStatsStore* getInstance();
+
+  /// Returns the fingerprint of 'node' and its sources. This is the same for
+  /// the same plan in different queries.
+  static uint64_t fingerprint(const core::PlanNode& node);
+
+  /// Returns the stats last recorded for 'fingerprint', if any.
+  std::optional<NodeStats> lookup(uint64_t fingerprint);
+
+  /// Records 'stats' for 'fingerprint', replacing any earlier stats.
+  void record(uint64_t fingerprint, const NodeStats& stats);
+
+  size_t numEntries() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return entries_.size();
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> l(mutex_);
+    entries_.clear();
+  }
+
+ private:
+  struct Entry {
+    NodeStats stats;
+    int32_t numLookups{0};
+  };
+
+  mutable std::mutex mutex_;
+  folly::EvictingCacheMap<uint64_t, Entry> entries_{kMaxEntries};
+};
+} // namespace facebook::velox::exec
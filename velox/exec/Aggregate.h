@@ -242,6 +242,26 @@ class Aggregate {
   virtual void
   extractAccumulators(char** groups, int32_t numGroups, VectorPtr* result) = 0;
 
+  /// Returns true if extractSpillParts() is supported. Requires that the
+  /// intermediate results of a group can be merged in any number of parts.
+  virtual bool supportsSpillParts() const {
+    return false;
+  }
+
+  /// Extracts the accumulator of 'group' for spilling as a sequence of
+  /// intermediate results of about 'maxBytes' each, so that spilling a very
+  /// large accumulator does not materialize it at once. Sets row 0 of 'result'
+  /// to each part in turn and calls 'flush' after each. Calls 'flush' at least
+  /// once. The parts are merged with addSingleGroupIntermediateResults() when
+  /// the spill is read. Does not change the accumulator.
+  virtual void extractSpillParts(
+      char* /*group*/,
+      int64_t /*maxBytes*/,
+      VectorPtr& /*result*/,
+      const std::function<void()>& /*flush*/) {
+    VELOX_NYI("extractSpillParts not supported");
+  }
+
   /// Produces an accumulator initialized from a single value for each
   /// row in 'rows'. The raw arguments of the aggregate are in 'args',
   /// which have the same meaning as in addRawInput. The result is
@@ -227,9 +227,7 @@ void AggregateCompanionAdapter::ExtractFunction::apply(
   char** groups = allocateGroups(allocationPool, rows, offset);
 
   // Perform per-row aggregation.
-  std::vector<vector_size_t> allSelectedRange;
-  rows.applyToSelected([&](auto row) { allSelectedRange.push_back(row); });
-  fn_->initializeNewGroups(groups, allSelectedRange);
+  fn_->initializeNewGroups(groups, rows.selectedRows());
   fn_->enableValidateIntermediateInputs();
   fn_->addIntermediateResults(groups, rows, args, false);
 
@@ -28,7 +28,9 @@ namespace {
 // A generic way to compute any aggregation used as a window function.
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
-// to frameEnd boundaries at that row using singleGroup.
+// to frameEnd boundaries at that row using singleGroup. Long sliding frames of
+// aggregates with fixed size accumulators are computed from a segment tree of
+// intermediate results over the partition.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -100,6 +102,22 @@ class AggregateWindowFunction : public exec::WindowFunction {
     // the aggregate to the final result.
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
 
+    // Sliding frames are aggregated over a segment tree of intermediate
+    // results if the accumulators are small and can be merged cheaply.
+    if (aggregate_->isFixedSize() &&
+        !aggregate_->accumulatorUsesExternalMemory()) {
+      intermediateType_ = exec::Aggregate::intermediateType(name, argTypes_);
+      groupRowStride_ = bits::roundUp(
+          singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+      treeArgVectors_.reserve(args.size());
+      for (auto i = 0; i < args.size(); ++i) {
+        treeArgVectors_.push_back(
+            argIndices_[i] == kConstantChannel
+                ? argVectors_[i]
+                : BaseVector::create(argTypes_[i], 0, pool_));
+      }
+    }
+
     computeDefaultAggregateValue(resultType);
   }
 
@@ -116,6 +134,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTree_ = nullptr;
   }
 
   void apply(
@@ -268,21 +287,166 @@ class AggregateWindowFunction : public exec::WindowFunction {
     }
   }
 
-  void computeAggregate(
-      SelectivityVector rows,
+  // Adds the rows between 'startFrame' and 'endFrame' of 'argVectors_' to the
+  // single group.
+  void addRawInput(
+      SelectivityVector& rows,
       vector_size_t startFrame,
       vector_size_t endFrame) {
+    if (startFrame >= endFrame) {
+      return;
+    }
     rows.clearAll();
     rows.setValidRange(startFrame, endFrame, true);
     rows.updateBounds();
 
-    BaseVector::prepareForReuse(aggregateResultVector_, 1);
-
     aggregate_->addSingleGroupRawInput(
         rawSingleGroupRow_, rows, argVectors_, false);
+  }
+
+  void extractAggregate() {
+    BaseVector::prepareForReuse(aggregateResultVector_, 1);
     aggregate_->extractValues(&rawSingleGroupRow_, 1, &aggregateResultVector_);
   }
 
+  void computeAggregate(
+      SelectivityVector rows,
+      vector_size_t startFrame,
+      vector_size_t endFrame) {
+    addRawInput(rows, startFrame, endFrame);
+    extractAggregate();
+  }
+
+  // Returns true if the frame between 'frameStart' and 'frameEnd' (exclusive)
+  // is aggregated over the segment tree. Short frames are cheaper to
+  // aggregate from the raw input.
+  bool useSegmentTree(vector_size_t frameStart, vector_size_t frameEnd) const {
+    return intermediateType_ != nullptr &&
+        frameEnd - frameStart >= kMinSegmentTreeFrameRows;
+  }
+
+  // Initializes 'numGroups' accumulators in 'groupsBuffer_' and sets their
+  // addresses in 'groups_'.
+  void initializeGroups(vector_size_t numGroups) {
+    const auto numBytes = numGroups * groupRowStride_;
+    if (groupsBuffer_ == nullptr || groupsBuffer_->capacity() < numBytes) {
+      groupsBuffer_ = AlignedBuffer::allocate<char>(numBytes, pool_);
+    }
+    auto* rawGroups = groupsBuffer_->asMutable<char>();
+    std::memset(rawGroups, 0, numBytes);
+    groups_.resize(numGroups);
+    std::vector<vector_size_t> indices(numGroups);
+    for (auto i = 0; i < numGroups; ++i) {
+      groups_[i] = rawGroups + i * groupRowStride_;
+      indices[i] = i;
+    }
+    aggregate_->clear();
+    aggregate_->initializeNewGroups(groups_.data(), indices);
+  }
+
+  // Extracts the intermediate results of the first 'numGroups' of 'groups_'
+  // into 'segmentTree_' from 'offset' on and frees the accumulators.
+  void extractGroups(vector_size_t numGroups, vector_size_t offset) {
+    BaseVector::prepareForReuse(groupResults_, numGroups);
+    aggregate_->extractAccumulators(groups_.data(), numGroups, &groupResults_);
+    segmentTree_->copy(groupResults_.get(), offset, 0, numGroups);
+    aggregate_->destroy(folly::Range(groups_.data(), numGroups));
+  }
+
+  // Builds a segment tree over the partition. The leaves are the intermediate
+  // results of blocks of 'kSegmentTreeLeafRows' rows. The tree is stored
+  // as an array: the n leaves are at [n, 2n) and node i merges nodes 2i and
+  // 2i + 1.
+  void buildSegmentTree() {
+    VELOX_CHECK(!partition_->isPartial());
+    const auto numRows = partition_->numRows();
+    numLeaves_ = bits::divRoundUp(numRows, kSegmentTreeLeafRows);
+    segmentTree_ = BaseVector::create(intermediateType_, 2 * numLeaves_, pool_);
+    if (groupResults_ == nullptr) {
+      groupResults_ = BaseVector::create(intermediateType_, 0, pool_);
+    }
+
+    for (auto i = 0; i < argIndices_.size(); ++i) {
+      treeArgVectors_[i]->resize(numRows);
+      if (argIndices_[i] != kConstantChannel) {
+        partition_->extractColumn(
+            argIndices_[i], 0, numRows, 0, treeArgVectors_[i]);
+      }
+    }
+
+    initializeGroups(numLeaves_);
+    std::vector<char*> rowGroups(numRows);
+    for (auto row = 0; row < numRows; ++row) {
+      rowGroups[row] = groups_[row / kSegmentTreeLeafRows];
+    }
+    aggregate_->addRawInput(
+        rowGroups.data(), SelectivityVector(numRows), treeArgVectors_, false);
+    extractGroups(numLeaves_, numLeaves_);
+
+    // The children of nodes [begin, end) are [2 * begin, 2 * end), which are
+    // all at or after 'end'. So each range of nodes is merged from the nodes
+    // built before it.
+    rowGroups.resize(2 * numLeaves_);
+    SelectivityVector nodes(2 * numLeaves_, false);
+    for (auto end = numLeaves_; end > 1;) {
+      const auto begin = (end + 1) / 2;
+      initializeGroups(end - begin);
+      for (auto node = 2 * begin; node < 2 * end; ++node) {
+        rowGroups[node] = groups_[node / 2 - begin];
+      }
+      nodes.clearAll();
+      nodes.setValidRange(2 * begin, 2 * end, true);
+      nodes.updateBounds();
+      aggregate_->addIntermediateResults(
+          rowGroups.data(), nodes, {segmentTree_}, false);
+      extractGroups(end - begin, begin);
+      end = begin;
+    }
+    treeNodes_.resizeFill(2 * numLeaves_, false);
+  }
+
+  // Adds the frame between 'frameStart' and 'frameEnd' (exclusive) to the
+  // single group. The rows before the first and after the last full leaf
+  // block of the frame are added from 'argVectors_', which start at
+  // 'minFrame'. The full leaf blocks are merged from O(log n) nodes of the
+  // segment tree.
+  void addSegmentTreeFrame(
+      SelectivityVector& rows,
+      vector_size_t minFrame,
+      vector_size_t frameStart,
+      vector_size_t frameEnd) {
+    const auto firstLeaf = bits::divRoundUp(frameStart, kSegmentTreeLeafRows);
+    const auto endLeaf = frameEnd / kSegmentTreeLeafRows;
+    VELOX_DCHECK_LT(firstLeaf, endLeaf);
+    addRawInput(
+        rows,
+        frameStart - minFrame,
+        firstLeaf * kSegmentTreeLeafRows - minFrame);
+    addRawInput(
+        rows, endLeaf * kSegmentTreeLeafRows - minFrame, frameEnd - minFrame);
+
+    frameNodes_.clear();
+    for (auto left = firstLeaf + numLeaves_, right = endLeaf + numLeaves_;
+         left < right;
+         left /= 2, right /= 2) {
+      if (left & 1) {
+        frameNodes_.push_back(left++);
+      }
+      if (right & 1) {
+        frameNodes_.push_back(--right);
+      }
+    }
+    for (auto node : frameNodes_) {
+      treeNodes_.setValid(node, true);
+    }
+    treeNodes_.updateBounds();
+    aggregate_->addSingleGroupIntermediateResults(
+        rawSingleGroupRow_, treeNodes_, {segmentTree_}, false);
+    for (auto node : frameNodes_) {
+      treeNodes_.setValid(node, false);
+    }
+  }
+
   void incrementalAggregation(
       const SelectivityVector& validRows,
       vector_size_t startFrame,
@@ -325,19 +489,30 @@ class AggregateWindowFunction : public exec::WindowFunction {
     static auto kSingleGroup = std::vector<vector_size_t>{0};
 
     validRows.applyToSelected([&](auto i) {
-      // This is a very naive algorithm.
-      // It evaluates the entire aggregation for each row by iterating over
-      // input rows from frameStart to frameEnd in the SelectivityVector.
-      // TODO : Try to re-use previous computations by advancing and retracting
-      // the aggregation based on the frame changes with each row. This would
-      // require adding new APIs to the Aggregate framework.
+      // Evaluates the entire aggregation for each row. Short frames iterate
+      // over input rows from frameStart to frameEnd in the SelectivityVector.
+      // Long frames merge the intermediate results of the segment tree nodes
+      // covering most of the frame, so that the work per row is
+      // O(log(partition size)) instead of O(frame size).
+      const auto frameStart = frameStartsVector[i];
+      const auto frameEnd = frameEndsVector[i] + 1;
+      const bool segmentTree = useSegmentTree(frameStart, frameEnd);
+      if (segmentTree && segmentTree_ == nullptr) {
+        // Building the tree clears the aggregate, so it is done before the
+        // single group is initialized.
+        buildSegmentTree();
+      }
+
       aggregate_->clear();
       aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
       aggregateInitialized_ = true;
 
-      auto frameStartIndex = frameStartsVector[i] - minFrame;
-      auto frameEndIndex = frameEndsVector[i] - minFrame + 1;
-      computeAggregate(rows, frameStartIndex, frameEndIndex);
+      if (segmentTree) {
+        addSegmentTreeFrame(rows, minFrame, frameStart, frameEnd);
+      } else {
+        addRawInput(rows, frameStart - minFrame, frameEnd - minFrame);
+      }
+      extractAggregate();
       result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
     });
 
@@ -393,6 +568,36 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
   VectorPtr emptyResult_;
+
+  // Number of rows aggregated into a leaf of the segment tree.
+  static constexpr vector_size_t kSegmentTreeLeafRows = 32;
+
+  // Frames with fewer rows are aggregated from the raw input.
+  static constexpr vector_size_t kMinSegmentTreeFrameRows =
+      4 * kSegmentTreeLeafRows;
+
+  // Intermediate type of the aggregate. Null if the segment tree is not used.
+  TypePtr intermediateType_;
+
+  // Size of an accumulator row in 'groupsBuffer_'.
+  vector_size_t groupRowStride_{0};
+
+  // Accumulators used to build the segment tree and their addresses.
+  BufferPtr groupsBuffer_;
+  std::vector<char*> groups_;
+  VectorPtr groupResults_;
+
+  // Argument vectors for all the rows of the partition.
+  std::vector<VectorPtr> treeArgVectors_;
+
+  // Intermediate results of the nodes of the segment tree over the current
+  // partition. Built for the first frame that uses it.
+  VectorPtr segmentTree_;
+  vector_size_t numLeaves_{0};
+
+  // The nodes of 'segmentTree_' merged for a frame.
+  std::vector<vector_size_t> frameNodes_;
+  SelectivityVector treeNodes_;
 };
 
 } // namespace
@@ -426,7 +631,10 @@ void registerAggregateWindowFunction(const std::string& name) {
               pool,
               stringAllocator,
               config);
-        });
+        },
+        // Frames from UNBOUNDED PRECEDING to CURRENT ROW are aggregated
+        // incrementally, reading only the rows added to the frame.
+        {.supportsStreaming = true, .ignoresFrame = false});
   }
 }
 } // namespace facebook::velox::exec
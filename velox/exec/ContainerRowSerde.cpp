@@ -15,6 +15,9 @@
  */
 
 #include "velox/exec/ContainerRowSerde.h"
+
+#include <folly/small_vector.h>
+
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/FlatVector.h"
 
@@ -249,9 +252,13 @@ void deserializeOne<TypeKind::VARBINARY>(
   deserializeString(in, index, result);
 }
 
-std::vector<uint64_t> readNulls(ByteInputStream& in, int32_t size) {
+// Null flags of up to 256 children or elements are kept inline, so that
+// comparing and hashing typical keys does not allocate.
+using NullWords = folly::small_vector<uint64_t, 4>;
+
+NullWords readNulls(ByteInputStream& in, int32_t size) {
   auto n = bits::nwords(size);
-  std::vector<uint64_t> nulls(n);
+  NullWords nulls(n);
   for (auto i = 0; i < n; ++i) {
     nulls[i] = in.read<uint64_t>();
   }
@@ -348,6 +355,117 @@ void deserializeSwitch(
       deserializeOne, result.typeKind(), in, index, result);
 }
 
+// Returns true if values of 'kind' are equal if and only if their bytes are
+// equal. Runs of non-null elements of these kinds are compared a batch at a
+// time with memcmp instead of value by value.
+bool isBatchComparable(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Number of values read from a stream per batch by compareRunAsc().
+constexpr int32_t kCompareBatchSize = 64;
+
+// Reads 'size' values from 'left' and compares them in order with 'right'.
+// Returns the ascending comparison of the first pair that differs or 0. Stops
+// reading at the batch with the first difference.
+template <typename T>
+int32_t compareRunAsc(ByteInputStream& left, const T* right, int32_t size) {
+  T leftValues[kCompareBatchSize];
+  for (int32_t i = 0; i < size; i += kCompareBatchSize) {
+    const auto numValues = std::min(kCompareBatchSize, size - i);
+    left.readBytes(leftValues, numValues * sizeof(T));
+    if (memcmp(leftValues, right + i, numValues * sizeof(T)) == 0) {
+      continue;
+    }
+    for (auto j = 0; j < numValues; ++j) {
+      if (leftValues[j] != right[i + j]) {
+        return SimpleVector<T>::comparePrimitiveAsc(
+            leftValues[j], right[i + j]);
+      }
+    }
+  }
+  return 0;
+}
+
+template <typename T>
+int32_t
+compareRunAsc(ByteInputStream& left, ByteInputStream& right, int32_t size) {
+  T rightValues[kCompareBatchSize];
+  for (int32_t i = 0; i < size; i += kCompareBatchSize) {
+    const auto numValues = std::min(kCompareBatchSize, size - i);
+    right.readBytes(rightValues, numValues * sizeof(T));
+    if (auto result = compareRunAsc<T>(left, rightValues, numValues)) {
+      return result;
+    }
+  }
+  return 0;
+}
+
+template <typename T>
+int32_t compareRunAsc(
+    ByteInputStream& left,
+    const BaseVector& right,
+    vector_size_t offset,
+    int32_t size) {
+  return compareRunAsc<T>(
+      left, right.asUnchecked<FlatVector<T>>()->rawValues() + offset, size);
+}
+
+// Compares 'size' values from 'left' with the values of flat 'right' starting
+// at 'offset'. The type of 'right' must be batch comparable.
+int32_t compareRunSwitch(
+    ByteInputStream& left,
+    const BaseVector& right,
+    vector_size_t offset,
+    int32_t size) {
+  switch (right.typeKind()) {
+    case TypeKind::TINYINT:
+      return compareRunAsc<int8_t>(left, right, offset, size);
+    case TypeKind::SMALLINT:
+      return compareRunAsc<int16_t>(left, right, offset, size);
+    case TypeKind::INTEGER:
+      return compareRunAsc<int32_t>(left, right, offset, size);
+    case TypeKind::BIGINT:
+      return compareRunAsc<int64_t>(left, right, offset, size);
+    case TypeKind::HUGEINT:
+      return compareRunAsc<int128_t>(left, right, offset, size);
+    default:
+      VELOX_UNREACHABLE("{}", right.type()->toString());
+  }
+}
+
+// Compares 'size' values of 'type' from 'left' and 'right'. 'type' must be
+// batch comparable.
+int32_t compareRunSwitch(
+    ByteInputStream& left,
+    ByteInputStream& right,
+    const Type* type,
+    int32_t size) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+      return compareRunAsc<int8_t>(left, right, size);
+    case TypeKind::SMALLINT:
+      return compareRunAsc<int16_t>(left, right, size);
+    case TypeKind::INTEGER:
+      return compareRunAsc<int32_t>(left, right, size);
+    case TypeKind::BIGINT:
+      return compareRunAsc<int64_t>(left, right, size);
+    case TypeKind::HUGEINT:
+      return compareRunAsc<int128_t>(left, right, size);
+    default:
+      VELOX_UNREACHABLE("{}", type->toString());
+  }
+}
+
 // Comparison of serialization and vector.
 std::optional<int32_t> compareSwitch(
     ByteInputStream& stream,
@@ -461,6 +579,17 @@ std::optional<int32_t> compareArrays(
   }
   auto compareSize = std::min(leftSize, rightSize);
   auto leftNulls = readNulls(left, leftSize);
+  const auto* rightNulls = elements.rawNulls();
+  if (compareSize > 0 && isBatchComparable(elements.typeKind()) &&
+      elements.isFlatEncoding() &&
+      bits::isAllSet(leftNulls.data(), 0, compareSize, false) &&
+      (rightNulls == nullptr ||
+       bits::isAllSet(rightNulls, offset, offset + compareSize))) {
+    if (auto result = compareRunSwitch(left, elements, offset, compareSize)) {
+      return flags.ascending ? result : -result;
+    }
+    return flags.ascending ? (leftSize - rightSize) : (rightSize - leftSize);
+  }
   auto wrappedElements = elements.wrappedVector();
   for (auto i = 0; i < compareSize; ++i) {
     bool leftNull = bits::isBitSet(leftNulls.data(), i);
@@ -641,6 +770,15 @@ std::optional<int32_t> compareArrays(
   auto compareSize = std::min(leftSize, rightSize);
   auto leftNulls = readNulls(left, leftSize);
   auto rightNulls = readNulls(right, rightSize);
+  if (compareSize > 0 && isBatchComparable(elementType->kind()) &&
+      bits::isAllSet(leftNulls.data(), 0, compareSize, false) &&
+      bits::isAllSet(rightNulls.data(), 0, compareSize, false)) {
+    if (auto result =
+            compareRunSwitch(left, right, elementType, compareSize)) {
+      return flags.ascending ? result : -result;
+    }
+    return flags.ascending ? (leftSize - rightSize) : (rightSize - leftSize);
+  }
   for (auto i = 0; i < compareSize; ++i) {
     bool leftNull = bits::isBitSet(leftNulls.data(), i);
     bool rightNull = bits::isBitSet(rightNulls.data(), i);
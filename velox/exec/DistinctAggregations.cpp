@@ -43,9 +43,9 @@ class TypedDistinctAggregations : public DistinctAggregations {
         sizeof(AccumulatorType),
         false, // usesExternalMemory
         1, // alignment
-        nullptr,
-        [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
-          VELOX_UNREACHABLE();
+        ARRAY(inputType_),
+        [this](folly::Range<char**> groups, VectorPtr& result) {
+          extractForSpill(groups, result);
         },
         [this](folly::Range<char**> groups) {
           for (auto* group : groups) {
@@ -89,6 +89,22 @@ class TypedDistinctAggregations : public DistinctAggregations {
     inputForAccumulator_.reset();
   }
 
+  void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) override {
+    // Null for the parts after the first of a row spilled in parts.
+    if (input->isNullAt(index)) {
+      return;
+    }
+    auto* arrayVector = input->as<ArrayVector>();
+    decodedSpillInput_.decode(*arrayVector->elements());
+
+    auto* accumulator = reinterpret_cast<AccumulatorType*>(group + offset_);
+    RowSizeTracker<char, uint32_t> tracker(group[rowSizeOffset_], *allocator_);
+    accumulator->addValues(*arrayVector, index, decodedSpillInput_, allocator_);
+  }
+
   void extractValues(folly::Range<char**> groups, const RowVectorPtr& result)
       override {
     SelectivityVector rows;
@@ -154,6 +170,40 @@ class TypedDistinctAggregations : public DistinctAggregations {
     return aggregates_[0]->inputs.size() == 1;
   }
 
+  // Stores the distinct values of each of 'groups' in the corresponding row of
+  // 'result', an array vector of 'inputType_'.
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const {
+    auto* arrayVector = result->as<ArrayVector>();
+    arrayVector->resize(groups.size());
+
+    auto* rawOffsets =
+        arrayVector->mutableOffsets(groups.size())->asMutable<vector_size_t>();
+    auto* rawSizes =
+        arrayVector->mutableSizes(groups.size())->asMutable<vector_size_t>();
+
+    vector_size_t offset = 0;
+    for (auto i = 0; i < groups.size(); ++i) {
+      auto* accumulator =
+          reinterpret_cast<AccumulatorType*>(groups[i] + offset_);
+      rawSizes[i] = accumulator->size();
+      rawOffsets[i] = offset;
+      offset += accumulator->size();
+    }
+
+    auto& elements = arrayVector->elements();
+    elements->resize(offset);
+    offset = 0;
+    for (auto* group : groups) {
+      auto* accumulator = reinterpret_cast<AccumulatorType*>(group + offset_);
+      if constexpr (std::is_same_v<T, ComplexType>) {
+        offset += accumulator->extractValues(*elements, offset);
+      } else {
+        offset += accumulator->extractValues(
+            *(elements->template as<FlatVector<T>>()), offset);
+      }
+    }
+  }
+
   void decodeInput(const RowVectorPtr& input, const SelectivityVector& rows) {
     inputForAccumulator_ = makeInputForAccumulator(input);
     decodedInput_.decode(*inputForAccumulator_, rows);
@@ -203,6 +253,7 @@ class TypedDistinctAggregations : public DistinctAggregations {
 
   DecodedVector decodedInput_;
   VectorPtr inputForAccumulator_;
+  DecodedVector decodedSpillInput_;
 };
 
 } // namespace
@@ -86,6 +86,14 @@ class DistinctAggregations {
       const RowVectorPtr& input,
       const SelectivityVector& rows) = 0;
 
+  /// Adds the distinct values spilled for a group at row 'index' of 'input' to
+  /// 'group'. 'input' is an array of the distinct values per group produced
+  /// by the spill extract function of accumulator().
+  virtual void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) = 0;
+
   /// Computes aggregations and stores results in the specified 'result' vector.
   virtual void extractValues(
       folly::Range<char**> groups,
@@ -170,7 +170,9 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.maxSpillRunRows(),
       queryConfig.writerFlushThresholdBytes(),
       queryConfig.spillCompressionKind(),
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      queryConfig.spillColumnarLayout(),
+      queryConfig.spillReadAhead());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -207,6 +209,8 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(
               state->sinceMicros_, state->reason_);
+          driver->recordBlockedTime(
+              *state->operator_, state->reason_, state->sinceMicros_);
         }
         VELOX_CHECK(!driver->state().suspended());
         VELOX_CHECK(driver->state().hasBlockingFuture);
@@ -215,7 +219,13 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
           // The thread will be enqueued at resume.
           return;
         }
-        Driver::enqueue(state->driver_);
+        const uint64_t nowMicros =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now().time_since_epoch())
+                .count();
+        Driver::enqueue(
+            state->driver_,
+            driver->resumePriority(nowMicros - state->sinceMicros_));
       })
       .thenError(
           folly::tag_t<std::exception>{}, [state](std::exception const& e) {
@@ -258,7 +268,7 @@ std::ostream& operator<<(std::ostream& out, const StopReason& reason) {
 }
 
 // static
-void Driver::enqueue(std::shared_ptr<Driver> driver) {
+void Driver::enqueue(std::shared_ptr<Driver> driver, int8_t priority) {
   process::ScopedThreadDebugInfo scopedInfo(
       driver->driverCtx()->threadDebugInfo);
   // This is expected to be called inside the Driver's Tasks's mutex.
@@ -266,8 +276,42 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  if (priority != folly::Executor::MID_PRI &&
+      driver->schedulingPrioritiesEnabled_ &&
+      executor->getNumPriorities() > 1) {
+    executor->addWithPriority([driver]() { Driver::run(driver); }, priority);
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
+}
+
+void Driver::recordBlockedTime(
+    const Operator& op,
+    BlockingReason reason,
+    uint64_t sinceMicros) const {
+  if (timeline_ == nullptr) {
+    return;
+  }
+  const uint64_t nowMicros =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::high_resolution_clock::now().time_since_epoch())
+          .count();
+  timeline_->recordEndingNow(
+      "blocked",
+      blockingReasonToString(reason),
+      timelineThreadId_,
+      nowMicros - std::min(nowMicros, sinceMicros),
+      op.operatorType());
+}
+
+int8_t Driver::resumePriority(uint64_t blockedMicros) const {
+  // A driver blocked for longer than a time slice has likely been waiting
+  // behind running drivers, e.g. for the output of another pipeline.
+  if (cpuSliceMs_ > 0 && blockedMicros >= cpuSliceMs_ * 1'000) {
+    return folly::Executor::HI_PRI;
+  }
+  return folly::Executor::MID_PRI;
 }
 
 void Driver::init(
@@ -275,11 +319,27 @@ void Driver::init(
     std::vector<std::unique_ptr<Operator>> operators) {
   VELOX_CHECK_NULL(ctx_);
   ctx_ = std::move(ctx);
-  cpuSliceMs_ = ctx_->queryConfig().driverCpuTimeSliceLimitMs();
+  const auto cpuShareWeight = ctx_->queryConfig().queryCpuShareWeight();
+  VELOX_USER_CHECK_GT(
+      cpuShareWeight, 0, "query_cpu_share_weight must be positive");
+  cpuSliceMs_ = ctx_->queryConfig().driverCpuTimeSliceLimitMs() *
+      static_cast<size_t>(cpuShareWeight);
+  schedulingPrioritiesEnabled_ =
+      ctx_->queryConfig().driverSchedulingPrioritiesEnabled();
   VELOX_CHECK(operators_.empty());
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  trackOperatorPerfCounters_ =
+      ctx_->queryConfig().operatorTrackPerfCounters();
+  timeline_ = ctx_->task->timelineRecorder();
+  if (timeline_ != nullptr) {
+    timelineThreadId_ = ctx_->pipelineId * 10'000 + ctx_->driverId;
+    timeline_->setThreadName(
+        timelineThreadId_,
+        fmt::format(
+            "pipeline {} driver {}", ctx_->pipelineId, ctx_->driverId));
+  }
 }
 
 void Driver::initializeOperators() {
@@ -411,6 +471,20 @@ size_t OpCallStatusRaw::callDuration() const {
       : fmt::format("null::{}", operatorMethod);
 }
 
+// static
+void Driver::addPerfCounters(Operator& op, const process::PerfCounters& delta) {
+  auto lockedStats = op.stats().wlock();
+  lockedStats->addRuntimeStat(
+      OperatorStats::kPerfCycles, RuntimeCounter(delta.cycles));
+  lockedStats->addRuntimeStat(
+      OperatorStats::kPerfInstructions, RuntimeCounter(delta.instructions));
+  lockedStats->addRuntimeStat(
+      OperatorStats::kPerfLlcMisses, RuntimeCounter(delta.llcMisses));
+  lockedStats->addRuntimeStat(
+      OperatorStats::kPerfBackendStallCycles,
+      RuntimeCounter(delta.backendStallCycles));
+}
+
 CpuWallTiming Driver::processLazyTiming(
     Operator& op,
     const CpuWallTiming& timing) {
@@ -470,6 +544,10 @@ StopReason Driver::runInternal(
     RowVectorPtr& result) {
   const auto now = getCurrentTimeMicro();
   const auto queuedTime = (now - queueTimeStartMicros_) * 1'000;
+  if (timeline_ != nullptr && queueTimeStartMicros_ != 0) {
+    timeline_->recordEndingNow(
+        "driver", "queued", timelineThreadId_, now - queueTimeStartMicros_);
+  }
   // Update the next operator's queueTime.
   StopReason stop =
       closed_ ? StopReason::kTerminate : task()->enter(state_, now);
@@ -498,6 +576,9 @@ StopReason Driver::runInternal(
         "queuedWallNanos",
         RuntimeCounter(queuedTime, RuntimeCounter::Unit::kNanos));
   }
+  task()->queryCtx()->addDriverQueuedTime(queuedTime / 1'000);
+  RECORD_HISTOGRAM_METRIC_VALUE(
+      kMetricDriverQueueTimeMs, queuedTime / 1'000'000);
 
   CancelGuard guard(task().get(), &state_, [&](StopReason reason) {
     // This is run on error or cancel exit.
@@ -588,6 +669,10 @@ StopReason Driver::runInternal(
                     processLazyTiming(*op, deltaTiming);
                     op->stats().wlock()->getOutputTiming.add(deltaTiming);
                   });
+              auto perfTimer = createDeltaPerfCounterTimer(
+                  [op](const process::PerfCounters& delta) {
+                    addPerfCounters(*op, delta);
+                  });
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::getOutput", op);
               CALL_OPERATOR(
@@ -619,6 +704,10 @@ StopReason Driver::runInternal(
                     auto selfDelta = processLazyTiming(*nextOp, timing);
                     nextOp->stats().wlock()->addInputTiming.add(selfDelta);
                   });
+              auto perfTimer = createDeltaPerfCounterTimer(
+                  [nextOp](const process::PerfCounters& delta) {
+                    addPerfCounters(*nextOp, delta);
+                  });
               {
                 auto lockedStats = nextOp->stats().wlock();
                 lockedStats->addInputVector(
@@ -628,6 +717,7 @@ StopReason Driver::runInternal(
                   "facebook::velox::exec::Driver::runInternal::addInput",
                   nextOp);
 
+              nextOp->traceInput(intermediateResult);
               CALL_OPERATOR(
                   nextOp->addInput(intermediateResult),
                   nextOp,
@@ -697,6 +787,10 @@ StopReason Driver::runInternal(
                   auto selfDelta = processLazyTiming(*op, timing);
                   op->stats().wlock()->getOutputTiming.add(selfDelta);
                 });
+            auto perfTimer = createDeltaPerfCounterTimer(
+                [op](const process::PerfCounters& delta) {
+                  addPerfCounters(*op, delta);
+                });
             CALL_OPERATOR(
                 result = op->getOutput(),
                 op,
@@ -772,7 +866,24 @@ void Driver::run(std::shared_ptr<Driver> self) {
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
-  auto reason = self->runInternal(self, blockingState, nullResult);
+  const auto onThreadStartMicros = self->timeline_ != nullptr
+      ? process::TimelineRecorder::nowMicros()
+      : 0;
+  StopReason reason;
+  {
+    process::ScopedTimelineThread scopedTimeline(
+        self->timeline_, self->timelineThreadId_);
+    reason = self->runInternal(self, blockingState, nullResult);
+  }
+  if (self->timeline_ != nullptr) {
+    self->timeline_->record(
+        {"onThread",
+         "driver",
+         self->timelineThreadId_,
+         onThreadStartMicros,
+         process::TimelineRecorder::nowMicros() - onThreadStartMicros,
+         stopReasonString(reason)});
+  }
 
   // When Driver runs on an executor, the last operator (sink) must not produce
   // any results.
@@ -799,8 +910,9 @@ void Driver::run(std::shared_ptr<Driver> self) {
       return;
 
     case StopReason::kYield:
-      // Go to the end of the queue.
-      enqueue(self);
+      // Go to the end of the queue. The driver has used up its time slice and
+      // goes behind the drivers that have not.
+      enqueue(self, folly::Executor::LO_PRI);
       return;
 
     case StopReason::kPause:
@@ -20,6 +20,8 @@
 #include <memory>
 
 #include "velox/common/future/VeloxPromise.h"
+#include "velox/common/process/PerfCounters.h"
+#include "velox/common/process/TimelineRecorder.h"
 #include "velox/common/process/ThreadDebugInfo.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/connectors/Connector.h"
@@ -342,7 +344,23 @@ struct OpCallStatus {
 
 class Driver : public std::enable_shared_from_this<Driver> {
  public:
-  static void enqueue(std::shared_ptr<Driver> instance);
+  /// Adds 'instance' to the query executor. 'priority' is passed to the
+  /// executor if 'driver_scheduling_priorities_enabled' is set and the
+  /// executor supports priorities. Otherwise it is ignored.
+  static void enqueue(
+      std::shared_ptr<Driver> instance,
+      int8_t priority = folly::Executor::MID_PRI);
+
+  /// Returns the priority to enqueue 'this' with when it is resumed after
+  /// being blocked for 'blockedMicros'.
+  int8_t resumePriority(uint64_t blockedMicros) const;
+
+  /// Adds the interval 'op' has been blocked for 'reason' since 'sinceMicros'
+  /// to the timeline of the task if QueryConfig::taskTraceEnabled() is set.
+  void recordBlockedTime(
+      const Operator& op,
+      BlockingReason reason,
+      uint64_t sinceMicros) const;
 
   /// Run the pipeline until it produces a batch of data or gets blocked.
   /// Return the data produced or nullptr if pipeline finished processing and
@@ -489,6 +507,21 @@ class Driver : public std::enable_shared_from_this<Driver> {
         : nullptr;
   }
 
+  // If 'trackOperatorPerfCounters_' is true, returns initialized timer object
+  // to count hardware events of an operation. Returns null otherwise. The
+  // delta PerfCounters object would be passed to 'func' upon destruction of
+  // the timer.
+  template <typename F>
+  std::unique_ptr<process::DeltaPerfCounterTimer<F>>
+  createDeltaPerfCounterTimer(F&& func) {
+    return trackOperatorPerfCounters_
+        ? std::make_unique<process::DeltaPerfCounterTimer<F>>(std::move(func))
+        : nullptr;
+  }
+
+  // Adds 'delta' to the runtime stats of 'op'.
+  static void addPerfCounters(Operator& op, const process::PerfCounters& delta);
+
   // Adjusts 'timing' by removing the lazy load wall and CPU times
   // accrued since last time timing information was recorded for
   // 'op'. The accrued lazy load times are credited to the source
@@ -502,6 +535,9 @@ class Driver : public std::enable_shared_from_this<Driver> {
   // If not zero, specifies the driver cpu time slice.
   size_t cpuSliceMs_{0};
 
+  // True if 'driver_scheduling_priorities_enabled' is set.
+  bool schedulingPrioritiesEnabled_{false};
+
   bool operatorsInitialized_{false};
 
   std::atomic_bool closed_{false};
@@ -524,6 +560,14 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  bool trackOperatorPerfCounters_{false};
+
+  // The timeline of the task if QueryConfig::taskTraceEnabled() is set.
+  process::TimelineRecorder* timeline_{nullptr};
+
+  // The thread id of 'this' in 'timeline_'.
+  int32_t timelineThreadId_{0};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
@@ -15,6 +15,8 @@
  */
 #include "velox/exec/ExchangeClient.h"
 
+#include "velox/common/time/Timer.h"
+
 namespace facebook::velox::exec {
 
 void ExchangeClient::addRemoteTaskId(const std::string& taskId) {
@@ -138,6 +140,7 @@ ExchangeClient::next(uint32_t maxBytes, bool* atEnd, ContinueFuture* future) {
 void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
   auto self = shared_from_this();
   for (auto& spec : requestSpecs) {
+    spec.startMicros = getCurrentTimeMicro();
     auto future = folly::SemiFuture<ExchangeSource::Response>::makeEmpty();
     if (spec.maxBytes == 0) {
       future = spec.source->requestDataSizes(kRequestDataSizesMaxWait);
@@ -154,6 +157,12 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
             if (self->closed_) {
               return;
             }
+            if (spec.maxBytes > 0 && response.bytes > 0) {
+              self->updateThroughputLocked(
+                  spec.source.get(),
+                  response.bytes,
+                  getCurrentTimeMicro() - spec.startMicros);
+            }
             if (!response.atEnd) {
               if (!response.remainingBytes.empty()) {
                 for (auto bytes : response.remainingBytes) {
@@ -194,22 +203,25 @@ ExchangeClient::pickSourcesToRequestLocked() {
       maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
   while (availableSpace > 0 && !producingSources_.empty()) {
     auto& source = producingSources_.front().source;
+    const int64_t credit = sourceCreditLocked(source.get());
     int64_t requestBytes = 0;
     for (auto bytes : producingSources_.front().remainingBytes) {
-      availableSpace -= bytes;
-      if (availableSpace < 0) {
+      // The first page is requested even if it is larger than the credit.
+      if (requestBytes + bytes > availableSpace ||
+          (requestBytes > 0 && requestBytes + bytes > credit)) {
         break;
       }
       requestBytes += bytes;
     }
     if (requestBytes == 0) {
-      VELOX_CHECK_LT(availableSpace, 0);
+      // The first page does not fit in the available space.
       break;
     }
     VELOX_CHECK(source->shouldRequestLocked());
     requestSpecs.push_back({std::move(source), requestBytes});
     producingSources_.pop();
     totalPendingBytes_ += requestBytes;
+    availableSpace -= requestBytes;
   }
   if (queue_->totalBytes() == 0 && totalPendingBytes_ == 0 &&
       !producingSources_.empty()) {
@@ -227,6 +239,33 @@ ExchangeClient::pickSourcesToRequestLocked() {
   return requestSpecs;
 }
 
+int64_t ExchangeClient::sourceCreditLocked(
+    const ExchangeSource* source) const {
+  const int64_t evenShare =
+      maxQueuedBytes_ / std::max<size_t>(1, sources_.size());
+  auto it = sourceBytesPerMicro_.find(source);
+  if (it == sourceBytesPerMicro_.end() || totalBytesPerMicro_ <= 0) {
+    return evenShare;
+  }
+  return std::max<int64_t>(
+      evenShare, maxQueuedBytes_ * (it->second / totalBytesPerMicro_));
+}
+
+void ExchangeClient::updateThroughputLocked(
+    const ExchangeSource* source,
+    int64_t bytes,
+    uint64_t elapsedMicros) {
+  const double bytesPerMicro =
+      static_cast<double>(bytes) / std::max<uint64_t>(1, elapsedMicros);
+  auto [it, inserted] = sourceBytesPerMicro_.emplace(source, bytesPerMicro);
+  if (!inserted) {
+    totalBytesPerMicro_ -= it->second;
+    // Weighs the latest response the same as all the earlier ones together.
+    it->second = (it->second + bytesPerMicro) / 2;
+  }
+  totalBytesPerMicro_ += it->second;
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
@@ -104,6 +104,10 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
     // How much bytes to request from this source.  0 bytes means request data
     // sizes only.
     int64_t maxBytes;
+
+    // Time of the request in microseconds. Used to measure the throughput of
+    // 'source'.
+    uint64_t startMicros{0};
   };
 
   struct ProducingSource {
@@ -113,6 +117,21 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
 
   std::vector<RequestSpec> pickSourcesToRequestLocked();
 
+  // Returns the most bytes to request from 'source' in one data request
+  // unless its next page alone is larger. A source gets the share of
+  // 'maxQueuedBytes_' that its recent throughput has in the throughput of all
+  // measured sources, but no less than an even split of 'maxQueuedBytes_'
+  // between all sources. Fast sources thus get deeper pipelines and slow
+  // sources do not hold queue space they do not fill.
+  int64_t sourceCreditLocked(const ExchangeSource* source) const;
+
+  // Records that a data request to 'source' returned 'bytes' in
+  // 'elapsedMicros'.
+  void updateThroughputLocked(
+      const ExchangeSource* source,
+      int64_t bytes,
+      uint64_t elapsedMicros);
+
   void request(std::vector<RequestSpec>&& requestSpecs);
 
   // Handy for ad-hoc logging.
@@ -135,6 +154,12 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   std::queue<ProducingSource> producingSources_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
+
+  // Moving average of the bytes per microsecond received from each source
+  // with at least one completed data request.
+  folly::F14FastMap<const ExchangeSource*, double> sourceBytesPerMicro_;
+  // Sum of the values in 'sourceBytesPerMicro_'.
+  double totalBytesPerMicro_{0};
 };
 
 } // namespace facebook::velox::exec
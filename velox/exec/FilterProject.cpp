@@ -15,6 +15,7 @@
  */
 #include "velox/exec/FilterProject.h"
 #include "velox/core/Expressions.h"
+#include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
 
@@ -38,6 +39,110 @@ bool checkAddIdentityProjection(
 
   return false;
 }
+
+void flattenAnd(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& conjuncts) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call != nullptr && call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenAnd(input, conjuncts);
+    }
+  } else {
+    conjuncts.push_back(expr);
+  }
+}
+
+// Counts the references to each input column in 'expr'.
+void countFieldReferences(
+    const core::TypedExprPtr& expr,
+    std::unordered_map<std::string, int32_t>& counts) {
+  if (auto field = core::TypedExprs::asFieldAccess(expr)) {
+    if (field->isInputColumn()) {
+      ++counts[field->name()];
+    }
+  }
+  if (auto lambda = core::TypedExprs::asLambda(expr)) {
+    countFieldReferences(lambda->body(), counts);
+  }
+  for (const auto& input : expr->inputs()) {
+    countFieldReferences(input, counts);
+  }
+}
+
+bool isIntegerType(const TypePtr& type) {
+  return *type == *BIGINT() || *type == *INTEGER() || *type == *SMALLINT() ||
+      *type == *TINYINT();
+}
+
+// Returns the comparison with the operands swapped.
+std::optional<std::string> swapComparison(const std::string& op) {
+  static const std::unordered_map<std::string, std::string> kSwapped = {
+      {"eq", "eq"},
+      {"neq", "neq"},
+      {"lt", "gt"},
+      {"lte", "gte"},
+      {"gt", "lt"},
+      {"gte", "lte"},
+  };
+  auto it = kSwapped.find(op);
+  if (it == kSwapped.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+// Sets the bit of the row of each value that passes a comparison with a
+// constant. Null values do not pass.
+template <typename T, typename TCompare>
+class ComparisonHook final : public ValueHook {
+ public:
+  ComparisonHook(TCompare compare, const vector_size_t* rows, uint64_t* bits)
+      : compare_(std::move(compare)), rows_(rows), bits_(bits) {}
+
+  void addValue(vector_size_t index, const void* value) override {
+    if (compare_(*reinterpret_cast<const T*>(value))) {
+      bits::setBit(bits_, rows_[index]);
+    }
+  }
+
+ private:
+  const TCompare compare_;
+  // The row of each index passed to addValue().
+  const vector_size_t* const rows_;
+  uint64_t* const bits_;
+};
+
+// Clears the rows of 'rows' for which 'compare' of the value of 'column' is
+// false or the value is null.
+template <typename T, typename TCompare>
+void applyComparison(
+    TCompare compare,
+    const VectorPtr& column,
+    bool mayLoadToHook,
+    SelectivityVector& rows,
+    std::vector<vector_size_t>& rowNumbers) {
+  auto* rawBits = rows.asMutableRange().bits();
+  if (mayLoadToHook && column->isLazy() &&
+      !column->asUnchecked<LazyVector>()->isLoaded()) {
+    rowNumbers.resize(rows.countSelected());
+    auto* rawRowNumbers = rowNumbers.data();
+    vector_size_t numRows = 0;
+    rows.applyToSelected([&](auto row) { rawRowNumbers[numRows++] = row; });
+    bits::fillBits(rawBits, rows.begin(), rows.end(), false);
+    ComparisonHook<T, TCompare> hook(compare, rawRowNumbers, rawBits);
+    column->asUnchecked<LazyVector>()->load(
+        RowSet(rawRowNumbers, numRows), &hook);
+  } else {
+    DecodedVector decoded(*column, rows);
+    rows.applyToSelected([&](auto row) {
+      if (decoded.isNullAt(row) || !compare(decoded.valueAt<T>(row))) {
+        bits::clearBit(rawBits, row);
+      }
+    });
+  }
+  rows.updateBounds();
+}
 } // namespace
 
 FilterProject::FilterProject(
@@ -53,10 +158,64 @@ FilterProject::FilterProject(
           "FilterProject"),
       hasFilter_(filter != nullptr),
       project_(project),
-      filter_(filter) {}
+      filter_(filter) {
+  if (driverCtx->queryConfig().speculativePreparationEnabled()) {
+    // Creates the ExecCtx here so that the compilation on the executor does
+    // not race with other users creating it.
+    operatorCtx_->execCtx();
+    speculativeExprs_ = std::make_shared<AsyncSource<ExprSet>>(
+        [this]() { return makeExprs(); });
+    operatorCtx_->task()->prepareSpeculatively(speculativeExprs_);
+  }
+}
+
+FilterProject::~FilterProject() {
+  closeSpeculativeExprs();
+}
+
+void FilterProject::closeSpeculativeExprs() {
+  if (speculativeExprs_ != nullptr) {
+    speculativeExprs_->close();
+    speculativeExprs_.reset();
+  }
+}
 
 void FilterProject::initialize() {
   Operator::initialize();
+  if (speculativeExprs_ != nullptr) {
+    exprs_ = speculativeExprs_->move();
+    const auto& timing = speculativeExprs_->prepareTiming();
+    if (timing.count > 0) {
+      addRuntimeStat(
+          "speculativePreparationWallNanos",
+          RuntimeCounter(timing.wallNanos, RuntimeCounter::Unit::kNanos));
+    }
+    speculativeExprs_.reset();
+  } else {
+    exprs_ = makeExprs();
+  }
+  VELOX_CHECK_NOT_NULL(exprs_);
+
+  if (numExprs_ > 0 && !identityProjections_.empty()) {
+    const auto inputType = project_ ? project_->sources()[0]->outputType()
+                                    : filter_->sources()[0]->outputType();
+    std::unordered_set<uint32_t> distinctFieldIndices;
+    for (auto field : exprs_->distinctFields()) {
+      auto fieldIndex = inputType->getChildIdx(field->name());
+      distinctFieldIndices.insert(fieldIndex);
+    }
+    for (auto identityField : identityProjections_) {
+      if (distinctFieldIndices.find(identityField.inputChannel) !=
+          distinctFieldIndices.end()) {
+        multiplyReferencedFieldIndices_.push_back(identityField.inputChannel);
+      }
+    }
+  }
+  filter_.reset();
+  project_.reset();
+}
+
+std::unique_ptr<ExprSet> FilterProject::makeExprs() {
   std::vector<core::TypedExprPtr> allExprs;
   if (hasFilter_) {
     VELOX_CHECK_NOT_NULL(filter_);
@@ -79,26 +238,167 @@ void FilterProject::initialize() {
     }
     isIdentityProjection_ = true;
   }
+  if (hasFilter_ &&
+      operatorCtx_->driverCtx()
+          ->queryConfig()
+          .filterPushdownIntoLoadEnabled()) {
+    allExprs[0] = pushDownConjuncts(
+        allExprs,
+        project_ ? project_->sources()[0]->outputType()
+                 : filter_->sources()[0]->outputType());
+  }
   numExprs_ = allExprs.size();
-  exprs_ = makeExprSetFromFlag(std::move(allExprs), operatorCtx_->execCtx());
+  return makeExprSetFromFlag(std::move(allExprs), operatorCtx_->execCtx());
+}
 
-  if (numExprs_ > 0 && !identityProjections_.empty()) {
-    const auto inputType = project_ ? project_->sources()[0]->outputType()
-                                    : filter_->sources()[0]->outputType();
-    std::unordered_set<uint32_t> distinctFieldIndices;
-    for (auto field : exprs_->distinctFields()) {
-      auto fieldIndex = inputType->getChildIdx(field->name());
-      distinctFieldIndices.insert(fieldIndex);
+core::TypedExprPtr FilterProject::pushDownConjuncts(
+    const std::vector<core::TypedExprPtr>& exprs,
+    const RowTypePtr& inputType) {
+  std::unordered_map<std::string, int32_t> numReferences;
+  for (const auto& expr : exprs) {
+    countFieldReferences(expr, numReferences);
+  }
+  for (const auto& projection : identityProjections_) {
+    ++numReferences[inputType->nameOf(projection.inputChannel)];
+  }
+
+  std::vector<core::TypedExprPtr> conjuncts;
+  flattenAnd(exprs[0], conjuncts);
+  std::vector<core::TypedExprPtr> remaining;
+  for (const auto& conjunct : conjuncts) {
+    auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(conjunct);
+    if (call == nullptr || call->inputs().size() != 2) {
+      remaining.push_back(conjunct);
+      continue;
     }
-    for (auto identityField : identityProjections_) {
-      if (distinctFieldIndices.find(identityField.inputChannel) !=
-          distinctFieldIndices.end()) {
-        multiplyReferencedFieldIndices_.push_back(identityField.inputChannel);
+    // Strips the catalog and schema prefix of the function name, if any.
+    auto op = call->name().substr(call->name().rfind('.') + 1);
+    auto field = core::TypedExprs::asFieldAccess(call->inputs()[0]);
+    auto constant = core::TypedExprs::asConstant(call->inputs()[1]);
+    if (field == nullptr) {
+      field = core::TypedExprs::asFieldAccess(call->inputs()[1]);
+      constant = core::TypedExprs::asConstant(call->inputs()[0]);
+      if (auto swapped = swapComparison(op)) {
+        op = swapped.value();
       }
     }
+    if (field == nullptr || constant == nullptr || !field->isInputColumn() ||
+        !swapComparison(op).has_value() || !isIntegerType(field->type()) ||
+        *constant->type() != *field->type() || constant->hasValueVector() ||
+        constant->value().isNull() || numReferences[field->name()] != 1) {
+      remaining.push_back(conjunct);
+      continue;
+    }
+    int64_t value;
+    switch (field->type()->kind()) {
+      case TypeKind::BIGINT:
+        value = constant->value().value<int64_t>();
+        break;
+      case TypeKind::INTEGER:
+        value = constant->value().value<int32_t>();
+        break;
+      case TypeKind::SMALLINT:
+        value = constant->value().value<int16_t>();
+        break;
+      default:
+        value = constant->value().value<int8_t>();
+        break;
+    }
+    static const std::unordered_map<std::string, PushedConjunct::Op> kOps = {
+        {"eq", PushedConjunct::Op::kEq},
+        {"neq", PushedConjunct::Op::kNeq},
+        {"lt", PushedConjunct::Op::kLt},
+        {"lte", PushedConjunct::Op::kLte},
+        {"gt", PushedConjunct::Op::kGt},
+        {"gte", PushedConjunct::Op::kGte},
+    };
+    pushedConjuncts_.push_back(
+        {inputType->getChildIdx(field->name()), kOps.at(op), value});
+  }
+
+  if (remaining.empty()) {
+    return std::make_shared<core::ConstantTypedExpr>(BOOLEAN(), variant(true));
+  }
+  if (remaining.size() == 1) {
+    return remaining[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(remaining), "and");
+}
+
+void FilterProject::applyPushedConjuncts(SelectivityVector& rows) {
+  if (!mayPushdownLoad_.has_value()) {
+    // The same condition as for loading LazyVectors into aggregates.
+    mayPushdownLoad_ = operatorCtx_->driver()->mayPushdownAggregation(this);
+  }
+  for (const auto& conjunct : pushedConjuncts_) {
+    if (!rows.hasSelections()) {
+      return;
+    }
+    const auto& column = input_->childAt(conjunct.channel);
+    auto apply = [&](auto compare) {
+      switch (column->typeKind()) {
+        case TypeKind::BIGINT:
+          applyComparison<int64_t>(
+              compare, column, *mayPushdownLoad_, rows, pushedRowNumbers_);
+          break;
+        case TypeKind::INTEGER:
+          applyComparison<int32_t>(
+              compare, column, *mayPushdownLoad_, rows, pushedRowNumbers_);
+          break;
+        case TypeKind::SMALLINT:
+          applyComparison<int16_t>(
+              compare, column, *mayPushdownLoad_, rows, pushedRowNumbers_);
+          break;
+        case TypeKind::TINYINT:
+          applyComparison<int8_t>(
+              compare, column, *mayPushdownLoad_, rows, pushedRowNumbers_);
+          break;
+        default:
+          VELOX_UNREACHABLE();
+      }
+    };
+    const auto constant = conjunct.constant;
+    switch (conjunct.op) {
+      case PushedConjunct::Op::kEq:
+        apply([constant](auto value) { return value == constant; });
+        break;
+      case PushedConjunct::Op::kNeq:
+        apply([constant](auto value) { return value != constant; });
+        break;
+      case PushedConjunct::Op::kLt:
+        apply([constant](auto value) { return value < constant; });
+        break;
+      case PushedConjunct::Op::kLte:
+        apply([constant](auto value) { return value <= constant; });
+        break;
+      case PushedConjunct::Op::kGt:
+        apply([constant](auto value) { return value > constant; });
+        break;
+      case PushedConjunct::Op::kGte:
+        apply([constant](auto value) { return value >= constant; });
+        break;
+    }
   }
-  filter_.reset();
-  project_.reset();
+}
+
+vector_size_t FilterProject::processPushedFilterResults(
+    const VectorPtr& filterResult,
+    const SelectivityVector& rows) {
+  const auto size = rows.size();
+  auto& decoded = filterEvalCtx_.decodedResult;
+  decoded.decode(*filterResult, rows);
+  auto* rawSelected = filterEvalCtx_.getRawSelectedIndices(size, pool());
+  auto* rawSelectedBits = filterEvalCtx_.getRawSelectedBits(size, pool());
+  memset(rawSelectedBits, 0, bits::nbytes(size));
+  vector_size_t passed = 0;
+  rows.applyToSelected([&](auto row) {
+    if (!decoded.isNullAt(row) && decoded.valueAt<bool>(row)) {
+      rawSelected[passed++] = row;
+      bits::setBit(rawSelectedBits, row);
+    }
+  });
+  return passed;
 }
 
 void FilterProject::addInput(RowVectorPtr input) {
@@ -185,6 +485,15 @@ vector_size_t FilterProject::filter(
     EvalCtx& evalCtx,
     const SelectivityVector& allRows) {
   std::vector<VectorPtr> results;
+  if (!pushedConjuncts_.empty()) {
+    pushedRows_ = allRows;
+    applyPushedConjuncts(pushedRows_);
+    if (!pushedRows_.hasSelections()) {
+      return 0;
+    }
+    exprs_->eval(0, 1, true, pushedRows_, evalCtx, results);
+    return processPushedFilterResults(results[0], pushedRows_);
+  }
   exprs_->eval(0, 1, true, allRows, evalCtx, results);
   return processFilterResults(results[0], allRows, filterEvalCtx_, pool());
 }
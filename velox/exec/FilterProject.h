@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
@@ -29,6 +30,8 @@ class FilterProject : public Operator {
       const std::shared_ptr<const core::FilterNode>& filter,
       const std::shared_ptr<const core::ProjectNode>& project);
 
+  ~FilterProject() override;
+
   bool isFilter() const override {
     return true;
   }
@@ -53,6 +56,7 @@ class FilterProject : public Operator {
 
   void close() override {
     Operator::close();
+    closeSpeculativeExprs();
     if (exprs_ != nullptr) {
       exprs_->clear();
     } else {
@@ -68,6 +72,9 @@ class FilterProject : public Operator {
   };
 
   Export exprsAndProjection() const {
+    VELOX_CHECK(
+        pushedConjuncts_.empty(),
+        "Cannot export a filter with conjuncts pushed into loading");
     return Export{exprs_.get(), hasFilter_, &resultProjections_};
   }
 
@@ -79,6 +86,14 @@ class FilterProject : public Operator {
   // should return nullptr.
   bool allInputProcessed();
 
+  // Plans the identity and result projections and compiles the filter and
+  // the other projections. Runs on the query executor if speculative
+  // preparation is enabled.
+  std::unique_ptr<ExprSet> makeExprs();
+
+  // Closes 'speculativeExprs_' if initialize() has not joined it.
+  void closeSpeculativeExprs();
+
   // Evaluate filter on all rows. Return number of rows that passed the filter.
   // Populate filterEvalCtx_.selectedBits and selectedIndices with the indices
   // of the passing rows if only some rows pass the filter. If all or no rows
@@ -86,6 +101,36 @@ class FilterProject : public Operator {
   // updated.
   vector_size_t filter(EvalCtx& evalCtx, const SelectivityVector& allRows);
 
+  // A conjunct of the filter that compares an integer column with a constant,
+  // where the column is referenced by no other expression or identity
+  // projection. Evaluated before the other conjuncts.
+  struct PushedConjunct {
+    // The comparison with the column on the left.
+    enum class Op { kEq, kNeq, kLt, kLte, kGt, kGte };
+
+    column_index_t channel;
+    Op op;
+    int64_t constant;
+  };
+
+  // Moves the conjuncts of the top level AND of the filter 'exprs[0]' that
+  // qualify into 'pushedConjuncts_'. 'exprs' are the filter and the
+  // projections. Returns the filter of the other conjuncts.
+  core::TypedExprPtr pushDownConjuncts(
+      const std::vector<core::TypedExprPtr>& exprs,
+      const RowTypePtr& inputType);
+
+  // Clears the rows of 'rows' that fail 'pushedConjuncts_'. If the column of a
+  // conjunct is a LazyVector that is not loaded, loads it into a ValueHook
+  // that sets the passing rows.
+  void applyPushedConjuncts(SelectivityVector& rows);
+
+  // Sets 'filterEvalCtx_' to the rows of 'rows' for which 'filterResult' is
+  // true and returns their count.
+  vector_size_t processPushedFilterResults(
+      const VectorPtr& filterResult,
+      const SelectivityVector& rows);
+
   // Evaluate projections on the specified rows and return the results.
   // pre-condition: !isIdentityProjection_
   std::vector<VectorPtr> project(
@@ -104,6 +149,10 @@ class FilterProject : public Operator {
   std::unique_ptr<ExprSet> exprs_;
   int32_t numExprs_;
 
+  // Compiles 'exprs_' ahead of initialize() if speculative preparation is
+  // enabled. Joined and reset in initialize().
+  std::shared_ptr<AsyncSource<ExprSet>> speculativeExprs_;
+
   FilterEvalCtx filterEvalCtx_;
 
   vector_size_t numProcessedInputRows_{0};
@@ -117,5 +166,17 @@ class FilterProject : public Operator {
   // will load c1 only for rows where f(c0) is true. However, c1 identity
   // projection needs all rows.
   std::vector<column_index_t> multiplyReferencedFieldIndices_;
+
+  std::vector<PushedConjunct> pushedConjuncts_;
+
+  // True if the LazyVectors of the input come from the source of the pipeline
+  // and can be loaded into a ValueHook. Set on first use.
+  std::optional<bool> mayPushdownLoad_;
+
+  // The rows passing 'pushedConjuncts_'.
+  SelectivityVector pushedRows_;
+
+  // Row numbers to load into the ValueHook of a pushed conjunct.
+  std::vector<vector_size_t> pushedRowNumbers_;
 };
 } // namespace facebook::velox::exec
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/FragmentResultCache.h"
+
+#include <map>
+#include <sstream>
+
+#include <folly/json.h>
+
+DEFINE_int64(
+    velox_fragment_result_cache_bytes,
+    512 << 20,
+    "Capacity of the process wide cache of table scan results by split, used "
+    "by queries with fragment_result_cache_enabled");
+
+namespace facebook::velox::exec {
+namespace {
+// Serializes 'obj' with the keys of objects in sorted order so that equal
+// handles serialize the same.
+std::string toSortedJson(const folly::dynamic& obj) {
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  return folly::json::serialize(obj, opts);
+}
+} // namespace
+
+// static
+FragmentResultCache* FragmentResultCache::getInstance() {
+  static FragmentResultCache instance(FLAGS_velox_fragment_result_cache_bytes);
+  return &instance;
+}
+
+FragmentResultCache::FragmentResultCache(uint64_t capacity)
+    : capacity_(capacity),
+      pool_(memory::memoryManager()->addLeafPool("FragmentResultCache")) {}
+
+// static
+std::string FragmentResultCache::fingerprint(const core::TableScanNode& node) {
+  std::map<std::string, std::string> assignments;
+  for (const auto& [name, handle] : node.assignments()) {
+    assignments[name] = toSortedJson(handle->serialize());
+  }
+  std::stringstream out;
+  out << node.outputType()->toString() << " "
+      << toSortedJson(node.tableHandle()->serialize());
+  for (const auto& [name, handle] : assignments) {
+    out << " " << name << ": " << handle;
+  }
+  return out.str();
+}
+
+std::shared_ptr<const FragmentResultCache::Batches> FragmentResultCache::find(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    ++numMisses_;
+    return nullptr;
+  }
+  ++numHits_;
+  lru_.splice(lru_.begin(), lru_, it->second.lruPosition);
+  return it->second.batches;
+}
+
+RowVectorPtr FragmentResultCache::copy(const RowVectorPtr& batch) {
+  batch->loadedVector();
+  auto result = BaseVector::create<RowVector>(
+      batch->type(), batch->size(), pool_.get());
+  result->copy(batch.get(), 0, 0, batch->size());
+  return result;
+}
+
+void FragmentResultCache::insert(
+    const std::string& key,
+    Batches batches,
+    uint64_t bytes) {
+  if (bytes > capacity_) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (entries_.count(key) > 0) {
+    return;
+  }
+  makeSpaceLocked(bytes);
+  lru_.push_front(key);
+  entries_[key] = Entry{
+      std::make_shared<const Batches>(std::move(batches)),
+      bytes,
+      lru_.begin()};
+  cachedBytes_ += bytes;
+}
+
+void FragmentResultCache::makeSpaceLocked(uint64_t bytes) {
+  while (!lru_.empty() && cachedBytes_ + bytes > capacity_) {
+    auto it = entries_.find(lru_.back());
+    VELOX_CHECK(it != entries_.end());
+    cachedBytes_ -= it->second.bytes;
+    entries_.erase(it);
+    lru_.pop_back();
+    ++numEvictions_;
+  }
+}
+
+FragmentResultCache::Stats FragmentResultCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numHits = numHits_;
+  stats.numMisses = numMisses_;
+  stats.numEvictions = numEvictions_;
+  stats.numEntries = entries_.size();
+  stats.cachedBytes = cachedBytes_;
+  return stats;
+}
+
+void FragmentResultCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  cachedBytes_ = 0;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+
+#include <folly/container/F14Map.h>
+#include <gflags/gflags.h>
+
+#include "velox/core/PlanNode.h"
+#include "velox/vector/ComplexVector.h"
+
+DECLARE_int64(velox_fragment_result_cache_bytes);
+
+namespace facebook::velox::exec {
+
+/// Process wide cache of the results of table scans by split. Used by the
+/// TableScan operator when the query config
+/// fragment_result_cache_enabled is set, e.g. for dashboards that run the
+/// same leaf fragments over unchanged files. The key is the fingerprint of
+/// the TableScanNode, covering the table, the pushed down filters and the
+/// columns, plus the identity of the split, see
+/// ConnectorSplit::resultCacheKey(). A hit serves the batches produced by the
+/// first scan of the split without reading the file. The batches are copies
+/// in memory owned by the cache, least recently used first evicted when the
+/// cache exceeds its capacity.
+class FragmentResultCache {
+ public:
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numEvictions{0};
+    uint64_t numEntries{0};
+    uint64_t cachedBytes{0};
+  };
+
+  using Batches = std::vector<RowVectorPtr>;
+
+  /// Returns the process wide cache with a capacity of
+  /// FLAGS_velox_fragment_result_cache_bytes.
+  static FragmentResultCache* getInstance();
+
+  explicit FragmentResultCache(uint64_t capacity);
+
+  /// Returns the part of the cache key that identifies the output of 'node'.
+  /// Equal for scans of the same columns of a table with the same filters,
+  /// regardless of the plan node id. Scans that differ only in the order of
+  /// their filters or assignments may get different fingerprints, which costs
+  /// a cache miss but never a wrong hit.
+  static std::string fingerprint(const core::TableScanNode& node);
+
+  /// Returns the batches cached for 'key' or nullptr if there are none.
+  /// Counts a hit or a miss.
+  std::shared_ptr<const Batches> find(const std::string& key);
+
+  /// Returns a copy of 'batch' allocated from the memory of the cache. Loads
+  /// the lazy vectors of 'batch'.
+  RowVectorPtr copy(const RowVectorPtr& batch);
+
+  /// Caches 'batches' produced by copy() under 'key'. 'bytes' is the memory
+  /// retained by 'batches'. Evicts the least recently used entries to stay
+  /// within capacity. Does nothing if 'bytes' alone exceed the capacity or if
+  /// 'key' is already cached, e.g. by a concurrent scan of the same split.
+  void insert(const std::string& key, Batches batches, uint64_t bytes);
+
+  uint64_t capacity() const {
+    return capacity_;
+  }
+
+  Stats stats() const;
+
+  /// Drops all the entries. Batches handed out by find() are freed when the
+  /// last user drops them.
+  void clear();
+
+ private:
+  struct Entry {
+    std::shared_ptr<const Batches> batches;
+    uint64_t bytes;
+    // Position of the key in 'lru_'.
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  // Evicts the least recently used entries until 'bytes' more fit.
+  void makeSpaceLocked(uint64_t bytes);
+
+  const uint64_t capacity_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, Entry> entries_;
+  // The keys of 'entries_', most recently used first.
+  std::list<std::string> lru_;
+  uint64_t cachedBytes_{0};
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::exec
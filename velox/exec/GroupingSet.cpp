@@ -15,6 +15,7 @@
  */
 #include "velox/exec/GroupingSet.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -22,6 +23,10 @@ using facebook::velox::common::testutil::TestValue;
 namespace facebook::velox::exec {
 
 namespace {
+// Minimum number of aggregates for updating the accumulators one tile of
+// input rows at a time. See QueryConfig::kAggregationUpdateTileRows.
+constexpr int32_t kMinAggregatesForTiledUpdate = 8;
+
 bool allAreSinglyReferenced(
     const std::vector<column_index_t>& argList,
     const std::unordered_map<column_index_t, int>& channelUseCount) {
@@ -70,6 +75,12 @@ GroupingSet::GroupingSet(
       stringAllocator_(operatorCtx->pool()),
       rows_(operatorCtx->pool()),
       isAdaptive_(queryConfig_.hashAdaptivityEnabled()),
+      sortSpillInput_(
+          queryConfig_.aggregationSpillSortInput() && !aggregates_.empty()),
+      updateTileRows_(
+          aggregates_.size() >= kMinAggregatesForTiledUpdate
+              ? queryConfig_.aggregationUpdateTileRows()
+              : 0),
       pool_(*operatorCtx->pool()),
       spillStats_(spillStats) {
   VELOX_CHECK_NOT_NULL(nonReclaimableSection_);
@@ -116,27 +127,6 @@ GroupingSet::~GroupingSet() {
   }
 }
 
-std::unique_ptr<GroupingSet> GroupingSet::createForMarkDistinct(
-    const RowTypePtr& inputType,
-    std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-    OperatorCtx* operatorCtx,
-    tsan_atomic<bool>* nonReclaimableSection) {
-  return std::make_unique<GroupingSet>(
-      inputType,
-      std::move(hashers),
-      /*preGroupedKeys*/ std::vector<column_index_t>{},
-      /*aggregates*/ std::vector<AggregateInfo>{},
-      /*ignoreNullKeys*/ false,
-      /*isPartial*/ false,
-      /*isRawInput*/ false,
-      /*globalGroupingSets*/ std::vector<vector_size_t>{},
-      /*groupIdColumn*/ std::nullopt,
-      /*spillConfig*/ nullptr,
-      nonReclaimableSection,
-      operatorCtx,
-      /*spillStats_*/ nullptr);
-};
-
 namespace {
 bool equalKeys(
     const std::vector<column_index_t>& keys,
@@ -194,6 +184,10 @@ void GroupingSet::noMoreInput() {
     addRemainingInput();
   }
 
+  if (lookup_ != nullptr) {
+    lookup_->clearPrefixHashes();
+  }
+
   // Spill the remaining in-memory state to disk if spilling has been triggered
   // on this grouping set. This is to simplify query OOM prevention when
   // producing output as we don't support to spill during that stage as for now.
@@ -212,6 +206,22 @@ bool GroupingSet::hasOutput() {
   return noMoreInput_ || remainingInput_;
 }
 
+void GroupingSet::setInputClustered() {
+  VELOX_CHECK(isPartial_);
+  VELOX_CHECK(!isGlobal_);
+  VELOX_CHECK(preGroupedKeyChannels_.empty());
+  VELOX_CHECK_NULL(remainingInput_);
+  preGroupedKeyChannels_ = keyChannels_;
+}
+
+void GroupingSet::setInputFromGroupId() {
+  VELOX_CHECK(!isGlobal_);
+  inputFromGroupId_ = true;
+  if (lookup_ != nullptr) {
+    lookup_->reusePrefixHashes = true;
+  }
+}
+
 void GroupingSet::addInputForActiveRows(
     const RowVectorPtr& input,
     bool mayPushdown) {
@@ -224,6 +234,11 @@ void GroupingSet::addInputForActiveRows(
   TestValue::adjust(
       "facebook::velox::exec::GroupingSet::addInputForActiveRows", this);
 
+  if (sortSpillInput_ && hasSpilled()) {
+    addInputWithoutGrouping(input, mayPushdown);
+    return;
+  }
+
   table_->prepareForGroupProbe(
       *lookup_,
       input,
@@ -237,10 +252,53 @@ void GroupingSet::addInputForActiveRows(
   }
 
   table_->groupProbe(*lookup_);
+  updateAggregates(
+      input, lookup_->hits.data(), lookup_->newGroups, mayPushdown);
+}
+
+void GroupingSet::addInputWithoutGrouping(
+    const RowVectorPtr& input,
+    bool mayPushdown) {
+  const auto& hashers = table_->hashers();
+  for (auto& hasher : hashers) {
+    hasher->decode(
+        *input->childAt(hasher->channel())->loadedVector(), activeRows_);
+  }
+  if (ignoreNullKeys_) {
+    deselectRowsWithNulls(hashers, activeRows_);
+    if (!activeRows_.hasSelections()) {
+      return;
+    }
+  }
+
+  // Each row gets a group of its own. The groups with equal keys are
+  // aggregated when merging the sorted spill runs.
+  auto* rows = table_->rows();
+  ungroupedRows_.resize(input->size());
+  ungroupedRowNumbers_.clear();
+  activeRows_.applyToSelected([&](vector_size_t row) {
+    auto* group = rows->newRow();
+    for (auto i = 0; i < hashers.size(); ++i) {
+      rows->store(hashers[i]->decodedVector(), row, group, i);
+    }
+    ungroupedRows_[row] = group;
+    ungroupedRowNumbers_.push_back(row);
+  });
+  updateAggregates(
+      input, ungroupedRows_.data(), ungroupedRowNumbers_, mayPushdown);
+}
+
+void GroupingSet::updateAggregates(
+    const RowVectorPtr& input,
+    char** groups,
+    const std::vector<vector_size_t>& newGroups,
+    bool mayPushdown) {
   masks_.addInput(input, activeRows_);
 
-  auto* groups = lookup_->hits.data();
-  const auto& newGroups = lookup_->newGroups;
+  // Tiles only if the active rows span more than one tile.
+  const bool tiled = updateTileRows_ > 0 &&
+      activeRows_.end() - activeRows_.begin() > updateTileRows_;
+  tiledAggregates_.clear();
 
   for (auto i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
@@ -276,12 +334,24 @@ void GroupingSet::addInputForActiveRows(
     // this.
     const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
         mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
+    if (tiled && !canPushdown) {
+      // Loads any lazy inputs before the first tile. Loading these for the
+      // rows of one tile would leave the rows of the other tiles unloaded.
+      for (const auto& vector : tempVectors_) {
+        vector->loadedVector();
+      }
+      tiledAggregates_.push_back(i);
+      continue;
+    }
     if (isRawInput_) {
       function->addRawInput(groups, rows, tempVectors_, canPushdown);
     } else {
       function->addIntermediateResults(groups, rows, tempVectors_, canPushdown);
     }
   }
+  if (!tiledAggregates_.empty()) {
+    updateTiledAggregates(input, groups);
+  }
   tempVectors_.clear();
 
   if (sortedAggregations_) {
@@ -399,6 +469,7 @@ void GroupingSet::createHashTable() {
   }
 
   lookup_ = std::make_unique<HashLookup>(table_->hashers());
+  lookup_->reusePrefixHashes = inputFromGroupId_;
   if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
     table_->forceGenericHashMode();
   }
@@ -675,6 +746,32 @@ void GroupingSet::destroyGlobalAggregations() {
   }
 }
 
+void GroupingSet::updateTiledAggregates(
+    const RowVectorPtr& input,
+    char** groups) {
+  for (auto begin = activeRows_.begin(); begin < activeRows_.end();
+       begin += updateTileRows_) {
+    const auto end = std::min(begin + updateTileRows_, activeRows_.end());
+    for (auto i : tiledAggregates_) {
+      tileRows_ = getSelectivityVector(i);
+      tileRows_.setValidRange(0, begin, false);
+      tileRows_.setValidRange(end, tileRows_.size(), false);
+      tileRows_.updateBounds();
+      if (!tileRows_.hasSelections()) {
+        continue;
+      }
+      populateTempVectors(i, input);
+      auto& function = aggregates_[i].function;
+      if (isRawInput_) {
+        function->addRawInput(groups, tileRows_, tempVectors_, false);
+      } else {
+        function->addIntermediateResults(
+            groups, tileRows_, tempVectors_, false);
+      }
+    }
+  }
+}
+
 void GroupingSet::populateTempVectors(
     int32_t aggregateIndex,
     const RowVectorPtr& input) {
@@ -825,7 +922,9 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
     return;
   }
 
-  const auto numDistinct = table_->numDistinct();
+  // Counts the rows of the container since the rows added without grouping
+  // are not distinct entries of the hash table.
+  const auto numDistinct = table_->rows()->numRows();
   if (numDistinct == 0) {
     // Table is empty. Nothing to spill.
     return;
@@ -849,7 +948,9 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
   const auto minReservationBytes =
       currentUsage * spillConfig_->minSpillableReservationPct / 100;
   const auto availableReservationBytes = pool_.availableReservation();
-  const auto tableIncrementBytes = table_->hashTableSizeIncrease(input->size());
+  const auto tableIncrementBytes = sortSpillInput_ && hasSpilled()
+      ? 0
+      : table_->hashTableSizeIncrease(input->size());
   const auto incrementBytes =
       rows->sizeIncrement(input->size(), outOfLineBytes ? flatBytes * 2 : 0) +
       tableIncrementBytes;
@@ -947,7 +1048,7 @@ void GroupingSet::spill() {
   // NOTE: if the disk spilling is triggered by the memory arbitrator, then it
   // is possible that the grouping set hasn't processed any input data yet.
   // Correspondingly, 'table_' will not be initialized at that point.
-  if (table_ == nullptr || table_->numDistinct() == 0) {
+  if (table_ == nullptr || table_->rows()->numRows() == 0) {
     return;
   }
 
@@ -973,7 +1074,9 @@ void GroupingSet::spill() {
   if (sortedAggregations_) {
     sortedAggregations_->clear();
   }
-  table_->clear();
+  // The hash table is not used anymore if the input is added without
+  // grouping from now on.
+  table_->clear(/*freeTable=*/sortSpillInput_);
 }
 
 void GroupingSet::spill(const RowContainerIterator& rowIterator) {
@@ -1030,7 +1133,8 @@ bool GroupingSet::getOutputWithSpill(
 
     VELOX_CHECK_NULL(merge_);
     auto spillPartition = spiller_->finishSpill();
-    merge_ = spillPartition.createOrderedReader(&pool_, spillStats_);
+    merge_ = spillPartition.createOrderedReader(
+        &pool_, spillStats_, spillConfig_->readAheadExecutor());
   }
   VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
   if (merge_ == nullptr) {
@@ -1134,7 +1238,7 @@ void GroupingSet::initializeRow(SpillMergeStream& stream, char* row) {
   }
   vector_size_t zero = 0;
   for (auto& aggregate : aggregates_) {
-    if (!aggregate.sortingKeys.empty()) {
+    if (!aggregate.sortingKeys.empty() || aggregate.distinct) {
       continue;
     }
     aggregate.function->initializeNewGroups(
@@ -1145,6 +1249,14 @@ void GroupingSet::initializeRow(SpillMergeStream& stream, char* row) {
     sortedAggregations_->initializeNewGroups(
         &row, folly::Range<const vector_size_t*>(&zero, 1));
   }
+
+  // Also initializes the accumulators of the distinct aggregates.
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->initializeNewGroups(
+          &row, folly::Range<const vector_size_t*>(&zero, 1));
+    }
+  }
 }
 
 void GroupingSet::extractSpillResult(const RowVectorPtr& result) {
@@ -1166,7 +1278,8 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   mergeSelection_.setValid(input.currentIndex(), true);
   mergeSelection_.updateBounds();
   for (auto i = 0; i < aggregates_.size(); ++i) {
-    if (!aggregates_[i].sortingKeys.empty()) {
+    // The distinct aggregates are computed from the spilled distinct values.
+    if (!aggregates_[i].sortingKeys.empty() || aggregates_[i].distinct) {
       continue;
     }
     mergeArgs_[0] = input.current().childAt(i + keyChannels_.size());
@@ -1175,15 +1288,27 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   }
   mergeSelection_.setValid(input.currentIndex(), false);
 
+  // The sorted and distinct accumulators follow the aggregates in the spill
+  // type. See accumulators().
+  auto channel = keyChannels_.size() + aggregates_.size();
   if (sortedAggregations_ != nullptr) {
-    const auto& vector =
-        input.current().childAt(aggregates_.size() + keyChannels_.size());
+    const auto& vector = input.current().childAt(channel++);
     sortedAggregations_->addSingleGroupSpillInput(
         row, vector, input.currentIndex());
   }
+
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      const auto& vector = input.current().childAt(channel++);
+      aggregation->addSingleGroupSpillInput(row, vector, input.currentIndex());
+    }
+  }
 }
 
 void GroupingSet::abandonPartialAggregation() {
+  if (table_ == nullptr) {
+    createHashTable();
+  }
   abandonedPartialAggregation_ = true;
   allSupportToIntermediate_ = true;
   for (auto& aggregate : aggregates_) {
@@ -45,13 +45,6 @@ class GroupingSet {
 
   ~GroupingSet();
 
-  // Used by MarkDistinct operator to identify rows with unique values.
-  static std::unique_ptr<GroupingSet> createForMarkDistinct(
-      const RowTypePtr& inputType,
-      std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-      OperatorCtx* operatorCtx,
-      tsan_atomic<bool>* nonReclaimableSection);
-
   void addInput(const RowVectorPtr& input, bool mayPushdown);
 
   void noMoreInput();
@@ -64,6 +57,12 @@ class GroupingSet {
   /// have changed.
   bool hasOutput();
 
+  /// Invoked by partial aggregation when the input is found to be clustered on
+  /// all the grouping keys. From then on, the groups become available for
+  /// output as soon as the next group starts, as if all the grouping keys were
+  /// pre-grouped.
+  void setInputClustered();
+
   /// Called if partial aggregation has reached memory limit or if hasOutput()
   /// returns true. 'maxOutputRows' and 'maxOutputBytes' specify the max number
   /// of rows/bytes to return in 'result' respectively. The function stops
@@ -74,6 +73,12 @@ class GroupingSet {
       RowContainerIterator& iterator,
       RowVectorPtr& result);
 
+  /// Invoked when the input comes from a GroupId operator, which produces one
+  /// batch per grouping set from each of its input batches. The consecutive
+  /// batches share the vectors of the grouping keys the sets have in common,
+  /// so the hashes of a shared prefix of the keys are computed once.
+  void setInputFromGroupId();
+
   uint64_t allocatedBytes() const;
 
   /// Resets the hash table inside the grouping set when partial aggregation
@@ -182,6 +187,25 @@ class GroupingSet {
 
   void createHashTable();
 
+  // Adds the active rows of 'input' to the RowContainer of 'table_' with one
+  // group per row, without probing the hash table. Used after the first
+  // spill if 'sortSpillInput_' is set. The rows are sorted on their keys when
+  // spilled and the groups with equal keys are aggregated when merging the
+  // spill runs.
+  void addInputWithoutGrouping(const RowVectorPtr& input, bool mayPushdown);
+
+  // Initializes the accumulators of 'newGroups' and adds the active rows of
+  // 'input' to 'groups', which has the group of each row of 'input'.
+  void updateAggregates(
+      const RowVectorPtr& input,
+      char** groups,
+      const std::vector<vector_size_t>& newGroups,
+      bool mayPushdown);
+
+  // Adds the active rows of 'input' to the accumulators of
+  // 'tiledAggregates_' one tile of 'updateTileRows_' rows at a time.
+  void updateTiledAggregates(const RowVectorPtr& input, char** groups);
+
   void populateTempVectors(int32_t aggregateIndex, const RowVectorPtr& input);
 
   // If the given aggregation has mask, the method returns reference to the
@@ -265,8 +289,9 @@ class GroupingSet {
 
   std::vector<column_index_t> keyChannels_;
 
-  /// A subset of grouping keys on which the input is clustered.
-  const std::vector<column_index_t> preGroupedKeyChannels_;
+  /// A subset of grouping keys on which the input is clustered. Set to all the
+  /// grouping keys by setInputClustered().
+  std::vector<column_index_t> preGroupedKeyChannels_;
 
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
   const bool isGlobal_;
@@ -287,6 +312,8 @@ class GroupingSet {
   const std::vector<vector_size_t> globalGroupingSets_;
   // Column for groupId for a GROUPING SET.
   std::optional<column_index_t> groupIdChannel_;
+  // True if the input comes from a GroupId operator. See setInputFromGroupId().
+  bool inputFromGroupId_{false};
 
   const common::SpillConfig* const spillConfig_;
 
@@ -312,6 +339,26 @@ class GroupingSet {
   memory::AllocationPool rows_;
   const bool isAdaptive_;
 
+  // True if input is added without grouping after the first spill. See
+  // addInputWithoutGrouping().
+  const bool sortSpillInput_;
+
+  // Rows per tile for updating many aggregates. See
+  // QueryConfig::kAggregationUpdateTileRows. 0 if not tiling.
+  const int32_t updateTileRows_;
+
+  // Indices into 'aggregates_' of the aggregates updated by
+  // updateTiledAggregates() for the current input.
+  std::vector<int32_t> tiledAggregates_;
+
+  // The rows of the current tile for the aggregate being updated.
+  SelectivityVector tileRows_;
+
+  // The group of each input row and the rows with a group added by
+  // addInputWithoutGrouping().
+  raw_vector<char*> ungroupedRows_;
+  std::vector<vector_size_t> ungroupedRowNumbers_;
+
   bool noMoreInput_{false};
 
   // In case of partial streaming aggregation, the input vector passed to
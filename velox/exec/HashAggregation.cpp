@@ -15,6 +15,10 @@
  */
 #include "velox/exec/HashAggregation.h"
 #include <optional>
+
+#include <folly/hash/Hash.h>
+
+#include "velox/exec/AdaptiveStatsStore.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
@@ -45,8 +49,23 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      abandonPartialAggregationSampleRows_(
+          isPartialOutput_ && !isGlobal_
+              ? driverCtx->queryConfig().abandonPartialAggregationSampleRows()
+              : 0),
+      clusteredInputDetectionRows_(
+          isPartialOutput_ && !isDistinct_ && !isGlobal_ &&
+                  aggregationNode->preGroupedKeys().empty()
+              ? driverCtx->queryConfig()
+                    .partialAggregationClusteredInputDetectionRows()
+              : 0),
       maxPartialAggregationMemoryUsage_(
-          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
+          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {
+  if (isPartialOutput_ && !isGlobal_ &&
+      driverCtx->queryConfig().adaptiveStatsStoreEnabled()) {
+    statsFingerprint_ = AdaptiveStatsStore::fingerprint(*aggregationNode);
+  }
+}
 
 void HashAggregation::initialize() {
   Operator::initialize();
@@ -87,6 +106,22 @@ void HashAggregation::initialize() {
     }
   }
 
+  if (abandonPartialAggregationSampleRows_ > 0 ||
+      clusteredInputDetectionRows_ > 0) {
+    for (const auto& hasher : hashers) {
+      groupingKeyChannels_.push_back(hasher->channel());
+    }
+  }
+  detectingClusteredInput_ = clusteredInputDetectionRows_ > 0;
+
+  if (abandonPartialAggregationSampleRows_ > 0) {
+    // 2^11 buckets give a standard error of ~2.3%.
+    constexpr int8_t kSampleHllIndexBitLength = 11;
+    sampleAllocator_ = std::make_unique<HashStringAllocator>(pool());
+    sampleHll_ = std::make_unique<common::hll::DenseHll>(
+        kSampleHllIndexBitLength, sampleAllocator_.get());
+  }
+
   std::optional<column_index_t> groupIdChannel;
   if (aggregationNode_->groupId().has_value()) {
     groupIdChannel = outputType_->getChildIdxIfExists(
@@ -108,8 +143,28 @@ void HashAggregation::initialize() {
       &nonReclaimableSection_,
       operatorCtx_.get(),
       &spillStats_);
+  if (!isGlobal_ &&
+      std::dynamic_pointer_cast<const core::GroupIdNode>(
+          aggregationNode_->sources()[0]) != nullptr) {
+    groupingSet_->setInputFromGroupId();
+  }
 
   aggregationNode_.reset();
+
+  if (statsFingerprint_.has_value()) {
+    const auto stats =
+        AdaptiveStatsStore::getInstance()->lookup(statsFingerprint_.value());
+    if (stats.has_value() && stats->abandonedPartialAggregation) {
+      // An earlier run of the same plan found the aggregation non-reducing.
+      // Pass the input through from the start and do not record the outcome
+      // of this run, which did not decide anything.
+      statsFingerprint_.reset();
+      sampleHll_.reset();
+      sampleAllocator_.reset();
+      abandonPartialAggregation();
+      addRuntimeStat("abandonedPartialAggregationFromStats", RuntimeCounter(1));
+    }
+  }
 }
 
 bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
@@ -118,18 +173,138 @@ bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
       100 * numOutput / numInputRows_ >= abandonPartialAggregationMinPct_;
 }
 
+bool HashAggregation::sampleGroupingKeys(const RowVector& input) {
+  VELOX_CHECK_NOT_NULL(sampleHll_);
+  const auto numRows = input.size();
+  sampleHashes_.resize(numRows);
+  for (auto i = 0; i < groupingKeyChannels_.size(); ++i) {
+    const auto* key = input.childAt(groupingKeyChannels_[i])->loadedVector();
+    for (vector_size_t row = 0; row < numRows; ++row) {
+      const auto hash = key->hashValueAt(row);
+      sampleHashes_[row] =
+          i == 0 ? hash : bits::hashMix(sampleHashes_[row], hash);
+    }
+  }
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    sampleHll_->insertHash(folly::hash::twang_mix64(sampleHashes_[row]));
+  }
+  numSampledRows_ += numRows;
+  if (numSampledRows_ < abandonPartialAggregationSampleRows_) {
+    return false;
+  }
+
+  const int64_t estimatedDistinctPct =
+      std::min<int64_t>(100, 100 * sampleHll_->cardinality() / numSampledRows_);
+  sampleHll_.reset();
+  sampleAllocator_.reset();
+  sampleHashes_ = raw_vector<uint64_t>();
+  addRuntimeStat(
+      "partialAggregationSampledRows", RuntimeCounter(numSampledRows_));
+  addRuntimeStat(
+      "partialAggregationEstimatedDistinctPct",
+      RuntimeCounter(estimatedDistinctPct));
+  return estimatedDistinctPct >= abandonPartialAggregationMinPct_;
+}
+
+void HashAggregation::abandonPartialAggregation() {
+  groupingSet_->abandonPartialAggregation();
+  stopClusteredInputDetection();
+  pool()->release();
+  addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
+  abandonedPartialAggregation_ = true;
+}
+
+void HashAggregation::countGroupingKeyRuns(const RowVectorPtr& input) {
+  const auto numRows = input->size();
+  if (numRows == 0) {
+    return;
+  }
+  std::vector<const BaseVector*> keys;
+  keys.reserve(groupingKeyChannels_.size());
+  for (auto channel : groupingKeyChannels_) {
+    keys.push_back(input->childAt(channel)->loadedVector());
+  }
+  auto sameKeys = [&](vector_size_t row) {
+    for (const auto* key : keys) {
+      if (!key->equalValueAt(key, row - 1, row)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  bool continuesLastRun = !lastGroupingKeys_.empty();
+  for (auto i = 0; i < keys.size() && continuesLastRun; ++i) {
+    continuesLastRun = lastGroupingKeys_[i]->equalValueAt(keys[i], 0, 0);
+  }
+  if (!continuesLastRun) {
+    ++numGroupingKeyRuns_;
+  }
+  for (vector_size_t row = 1; row < numRows; ++row) {
+    if (!sameKeys(row)) {
+      ++numGroupingKeyRuns_;
+    }
+  }
+
+  lastGroupingKeys_.resize(keys.size());
+  for (auto i = 0; i < keys.size(); ++i) {
+    auto& lastKey = lastGroupingKeys_[i];
+    if (lastKey == nullptr) {
+      lastKey = BaseVector::create(keys[i]->type(), 1, pool());
+    }
+    lastKey->copy(keys[i], 0, numRows - 1, 1);
+  }
+}
+
+void HashAggregation::detectClusteredInput(const RowVectorPtr& input) {
+  numDetectionRows_ += input->size();
+  // Each run of equal keys is a distinct group if the input is clustered.
+  // Null keys that are ignored make for runs without a group.
+  if (numGroupingKeyRuns_ > groupingSet_->numDistinct()) {
+    stopClusteredInputDetection();
+    return;
+  }
+  if (numDetectionRows_ < clusteredInputDetectionRows_) {
+    return;
+  }
+  addRuntimeStat(
+      "clusteredInputDetectedRows", RuntimeCounter(numDetectionRows_));
+  stopClusteredInputDetection();
+  groupingSet_->setInputClustered();
+}
+
+void HashAggregation::stopClusteredInputDetection() {
+  detectingClusteredInput_ = false;
+  lastGroupingKeys_.clear();
+}
+
 void HashAggregation::addInput(RowVectorPtr input) {
   if (!pushdownChecked_) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
     pushdownChecked_ = true;
   }
+  if (sampleHll_ != nullptr && sampleGroupingKeys(*input)) {
+    if (groupingSet_->numDistinct() == 0 && !groupingSet_->hasSpilled()) {
+      // The sample is the first input. Pass it through without building a
+      // table.
+      abandonPartialAggregation();
+    } else {
+      abandonPartialAggregationOnFlush_ = true;
+    }
+  }
   if (abandonedPartialAggregation_) {
     input_ = input;
     numInputRows_ += input->size();
     return;
   }
+  if (detectingClusteredInput_) {
+    countGroupingKeyRuns(input);
+  }
   groupingSet_->addInput(input, mayPushdown_);
   numInputRows_ += input->size();
+  if (detectingClusteredInput_) {
+    detectClusteredInput(input);
+  }
 
   updateRuntimeStats();
 
@@ -137,7 +312,8 @@ void HashAggregation::addInput(RowVectorPtr input) {
   // aggregation as the final aggregator will handle it the same way as the
   // partial aggregator. Hence, we have to use more memory anyway.
   const bool abandonPartialEarly = isPartialOutput_ && !isGlobal_ &&
-      abandonPartialAggregationEarly(groupingSet_->numDistinct());
+      (abandonPartialAggregationOnFlush_ ||
+       abandonPartialAggregationEarly(groupingSet_->numDistinct()));
   if (isPartialOutput_ && !isGlobal_ &&
       (abandonPartialEarly ||
        groupingSet_->isPartialFull(maxPartialAggregationMemoryUsage_))) {
@@ -188,6 +364,12 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+  runtimeStats[BaseHashTable::kPeakTableBytes] = RuntimeMetric(
+      hashTableStats.peakTableBytes, RuntimeCounter::Unit::kBytes);
+  if (hashTableStats.numRehashes != 0) {
+    runtimeStats[BaseHashTable::kRehashWallNanos] = RuntimeMetric(
+        hashTableStats.rehashWallNanos, RuntimeCounter::Unit::kNanos);
+  }
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
@@ -217,6 +399,8 @@ void HashAggregation::resetPartialOutputIfNeed() {
         "partialAggregationPct", RuntimeCounter(aggregationPct));
   }
   groupingSet_->resetTable();
+  // The groups counted while detecting clustered input are gone.
+  stopClusteredInputDetection();
   partialFull_ = false;
   if (!finished_) {
     maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
@@ -232,14 +416,12 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
   VELOX_DCHECK(isPartialOutput_);
   // If size is at max and there still is not enough reduction, abandon partial
   // aggregation.
-  if (abandonPartialAggregationEarly(numOutputRows_) ||
+  if (abandonPartialAggregationOnFlush_ ||
+      abandonPartialAggregationEarly(numOutputRows_) ||
       (aggregationPct > kPartialMinFinalPct &&
        maxPartialAggregationMemoryUsage_ >=
            maxExtendedPartialAggregationMemoryUsage_)) {
-    groupingSet_->abandonPartialAggregation();
-    pool()->release();
-    addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
-    abandonedPartialAggregation_ = true;
+    abandonPartialAggregation();
     return;
   }
   const int64_t extendedPartialAggregationMemoryUsage = std::min(
@@ -435,6 +617,17 @@ void HashAggregation::reclaim(
 }
 
 void HashAggregation::close() {
+  if (statsFingerprint_.has_value() && noMoreInput_) {
+    AdaptiveStatsStore::NodeStats nodeStats;
+    {
+      const auto lockedStats = stats_.rlock();
+      nodeStats.numInputRows = lockedStats->inputPositions;
+      nodeStats.numOutputRows = lockedStats->outputPositions;
+    }
+    nodeStats.abandonedPartialAggregation = abandonedPartialAggregation_;
+    AdaptiveStatsStore::getInstance()->record(
+        statsFingerprint_.value(), nodeStats);
+  }
   Operator::close();
 
   output_ = nullptr;
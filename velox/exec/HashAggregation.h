@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/hyperloglog/DenseHll.h"
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
 
@@ -70,6 +71,28 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Adds the grouping keys of 'input' to 'sampleHll_'. Returns true if this
+  // completes the sample and the estimated percentage of distinct keys is at
+  // least 'abandonPartialAggregationMinPct_'. Frees the sample state after the
+  // decision and reports it in runtime stats.
+  bool sampleGroupingKeys(const RowVector& input);
+
+  // Switches to pass-through. The table must be empty.
+  void abandonPartialAggregation();
+
+  // Counts the runs of equal grouping keys in 'input', continuing the last run
+  // of the previous input. Invoked before adding 'input' to 'groupingSet_'.
+  void countGroupingKeyRuns(const RowVectorPtr& input);
+
+  // Invoked after adding 'input' counted by countGroupingKeyRuns(). Stops the
+  // detection if a group has more than one run. Switches 'groupingSet_' to
+  // streaming if each group has a single run after
+  // 'clusteredInputDetectionRows_'.
+  void detectClusteredInput(const RowVectorPtr& input);
+
+  // Ends clustered input detection and frees its state.
+  void stopClusteredInputDetection();
+
   RowVectorPtr getDistinctOutput();
 
   void updateEstimatedOutputRowSize();
@@ -86,6 +109,12 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // Number of first input rows to estimate the number of distinct grouping
+  // keys on. 0 if not sampling.
+  const int32_t abandonPartialAggregationSampleRows_;
+  // Number of first input rows to check for clustering on the grouping keys.
+  // 0 if not checking.
+  const int32_t clusteredInputDetectionRows_;
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
@@ -100,6 +129,31 @@ class HashAggregation : public Operator {
   bool finished_ = false;
   // True if partial aggregation has been found to be non-reducing.
   bool abandonedPartialAggregation_{false};
+  // True if the sample found the partial aggregation non-reducing after rows
+  // were added to the table. The aggregation is abandoned on the next flush.
+  bool abandonPartialAggregationOnFlush_{false};
+  // Fingerprint of the plan node in AdaptiveStatsStore. Set if the outcome of
+  // this run is recorded there.
+  std::optional<uint64_t> statsFingerprint_;
+
+  // Channels of the grouping keys in the input.
+  std::vector<column_index_t> groupingKeyChannels_;
+  // Estimates the number of distinct grouping keys while sampling. nullptr
+  // when not sampling.
+  std::unique_ptr<HashStringAllocator> sampleAllocator_;
+  std::unique_ptr<common::hll::DenseHll> sampleHll_;
+  int64_t numSampledRows_{0};
+  // Reusable buffer for the hashes of the sampled rows.
+  raw_vector<uint64_t> sampleHashes_;
+
+  // True while checking if the input is clustered on the grouping keys.
+  bool detectingClusteredInput_{false};
+  // Number of input rows and runs of equal grouping keys seen while detecting.
+  int64_t numDetectionRows_{0};
+  int64_t numGroupingKeyRuns_{0};
+  // Single row copies of the grouping keys of the last input row while
+  // detecting. Used to check if the last run continues in the next input.
+  std::vector<VectorPtr> lastGroupingKeys_;
 
   RowContainerIterator resultIterator_;
   bool pushdownChecked_ = false;
@@ -45,6 +45,33 @@ BlockingReason fromStateToBlockingReason(HashBuild::State state) {
       VELOX_UNREACHABLE(HashBuild::stateName(state));
   }
 }
+
+bool isBloomFilterKeyType(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int64_t integerKeyAt(const char* row, int32_t offset, TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return RowContainer::valueAt<int8_t>(row, offset);
+    case TypeKind::SMALLINT:
+      return RowContainer::valueAt<int16_t>(row, offset);
+    case TypeKind::INTEGER:
+      return RowContainer::valueAt<int32_t>(row, offset);
+    case TypeKind::BIGINT:
+      return RowContainer::valueAt<int64_t>(row, offset);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
 } // namespace
 
 HashBuild::HashBuild(
@@ -67,6 +94,8 @@ HashBuild::HashBuild(
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
+      partialSpillEnabled_(
+          driverCtx->queryConfig().joinPartialSpillEnabled()),
       keyChannelMap_(joinNode_->rightKeys().size()) {
   VELOX_CHECK(pool()->trackUsage());
   VELOX_CHECK_NOT_NULL(joinBridge_);
@@ -74,47 +103,38 @@ HashBuild::HashBuild(
   joinBridge_->addBuilder();
 
   auto inputType = joinNode_->sources()[1]->outputType();
+  tableType_ = hashJoinTableType(joinNode_);
 
   const auto numKeys = joinNode_->rightKeys().size();
   keyChannels_.reserve(numKeys);
-  std::vector<std::string> names;
-  names.reserve(inputType->size());
-  std::vector<TypePtr> types;
-  types.reserve(inputType->size());
-
   for (int i = 0; i < numKeys; ++i) {
     auto& key = joinNode_->rightKeys()[i];
     auto channel = exprToChannel(key.get(), inputType);
     keyChannelMap_[channel] = i;
     keyChannels_.emplace_back(channel);
-    names.emplace_back(inputType->nameOf(channel));
-    types.emplace_back(inputType->childAt(channel));
-  }
-
-  // Identify the non-key build side columns and make a decoder for each.
-  const int32_t numDependents = inputType->size() - numKeys;
-  if (numDependents > 0) {
-    // Number of join keys (numKeys) may be less then number of input columns
-    // (inputType->size()). In this case numDependents is negative and cannot be
-    // used to call 'reserve'. This happens when we join different probe side
-    // keys with the same build side key: SELECT * FROM t LEFT JOIN u ON t.k1 =
-    // u.k AND t.k2 = u.k.
-    dependentChannels_.reserve(numDependents);
-    decoders_.reserve(numDependents);
-  }
-  for (auto i = 0; i < inputType->size(); ++i) {
-    if (keyChannelMap_.find(i) == keyChannelMap_.end()) {
-      dependentChannels_.emplace_back(i);
-      decoders_.emplace_back(std::make_unique<DecodedVector>());
-      names.emplace_back(inputType->nameOf(i));
-      types.emplace_back(inputType->childAt(i));
-    }
   }
 
-  tableType_ = ROW(std::move(names), std::move(types));
+  // Identify the non-key build side columns stored in the table and make a
+  // decoder for each. The table has no columns for the build side input that
+  // is neither in the join output nor in the filter.
+  const auto numDependents = tableType_->size() - numKeys;
+  dependentChannels_.reserve(numDependents);
+  decoders_.reserve(numDependents);
+  for (auto i = numKeys; i < tableType_->size(); ++i) {
+    dependentChannels_.emplace_back(
+        inputType->getChildIdx(tableType_->nameOf(i)));
+    decoders_.emplace_back(std::make_unique<DecodedVector>());
+  }
+
   setupTable();
   setupSpiller();
   stateCleared_ = false;
+
+  if (joinNode_->useHashTableCache()) {
+    hashTableCacheEntry_ = HashTableCache::getInstance()->acquire(
+        operatorCtx_->task()->queryCtx()->queryId(), planNodeId(), taskId());
+    useCachedTable_ = !hashTableCacheEntry_->isBuilder(taskId());
+  }
 }
 
 void HashBuild::initialize() {
@@ -190,7 +210,7 @@ void HashBuild::setupTable() {
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
-void HashBuild::setupSpiller(SpillPartition* spillPartition) {
+void HashBuild::setupSpiller(SpillPartition* spillPartition, bool skewed) {
   VELOX_CHECK_NULL(spiller_);
   VELOX_CHECK_NULL(spillInputReader_);
 
@@ -227,6 +247,17 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
       exceededMaxSpillLevelLimit_ = true;
       return;
     }
+    // Spilling a skewed partition again only moves its rows into one
+    // partition of the next level. Keep it in memory instead.
+    if (skewed) {
+      FB_LOG_EVERY_MS(WARNING, 1'000)
+          << "Disable spilling of skewed spill partition "
+          << spillPartition->id() << " for memory pool: " << pool()->name();
+      stats_.wlock()->addRuntimeStat(
+          kSkewedSpillPartitions, RuntimeCounter(1));
+      exceededMaxSpillLevelLimit_ = true;
+      return;
+    }
     exceededMaxSpillLevelLimit_ = false;
   }
 
@@ -313,6 +344,10 @@ void HashBuild::removeInputRowsForAntiJoinFilter() {
 
 void HashBuild::addInput(RowVectorPtr input) {
   checkRunning();
+  if (useCachedTable_) {
+    // Another task builds the table from the same input.
+    return;
+  }
   ensureInputFits(input);
 
   TestValue::adjust("facebook::velox::exec::HashBuild::addInput", this);
@@ -423,6 +458,9 @@ void HashBuild::addInput(RowVectorPtr input) {
       }
     }
   });
+  // The hash table over the stored rows is allocated after all the input is
+  // received.
+  expectedMemoryGrowth_ = table_->estimateHashTableSize(rows->numRows());
 }
 
 void HashBuild::ensureInputFits(RowVectorPtr& input) {
@@ -643,8 +681,9 @@ bool HashBuild::finishHashBuild() {
   checkRunning();
 
   // Release the unused memory reservation before building the merged join
-  // table.
+  // table. The last driver reserves the memory for the table explicitly.
   pool()->release();
+  expectedMemoryGrowth_ = 0;
 
   std::vector<ContinuePromise> promises;
   std::vector<std::shared_ptr<Driver>> peers;
@@ -670,6 +709,13 @@ bool HashBuild::finishHashBuild() {
     }
   });
 
+  if (useCachedTable_) {
+    // The probe side waits on 'joinBridge_' for the table built by another
+    // task.
+    hashTableCacheEntry_->addWaiter(joinBridge_);
+    return true;
+  }
+
   if (joinHasNullKeys_ && isAntiJoin(joinType_) && nullAware_ &&
       !joinNode_->filter()) {
     joinBridge_->setAntiJoinHasNullKeys();
@@ -751,9 +797,22 @@ bool HashBuild::finishHashBuild() {
       BaseHashTable::kBuildWallNanos,
       RuntimeCounter(timing.wallNanos, RuntimeCounter::Unit::kNanos));
 
+  if (spillPartitions.empty()) {
+    buildKeyBloomFilters();
+  }
+
   addRuntimeStats();
+  std::shared_ptr<BaseHashTable> table = std::move(table_);
+  if (hashTableCacheEntry_ != nullptr) {
+    std::vector<std::shared_ptr<memory::MemoryPool>> pools;
+    pools.push_back(pool()->shared_from_this());
+    for (auto* build : otherBuilds) {
+      pools.push_back(build->pool()->shared_from_this());
+    }
+    hashTableCacheEntry_->setTable(table, std::move(pools), joinHasNullKeys_);
+  }
   joinBridge_->setHashTable(
-      std::move(table_), std::move(spillPartitions), joinHasNullKeys_);
+      std::move(table), std::move(spillPartitions), joinHasNullKeys_);
   if (spillEnabled()) {
     stateCleared_ = true;
   }
@@ -769,6 +828,74 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+void HashBuild::buildKeyBloomFilters() {
+  const auto maxSize = operatorCtx_->driverCtx()
+                           ->queryConfig()
+                           .hashProbeBloomFilterPushdownMaxSize();
+  // Matches the join types for which HashProbe pushes down dynamic filters.
+  if (maxSize == 0 || isInputFromSpill() ||
+      !(isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
+        isRightSemiFilterJoin(joinType_) ||
+        isRightSemiProjectJoin(joinType_))) {
+    return;
+  }
+
+  const auto allRows = table_->allRows();
+  uint64_t numRows = 0;
+  for (auto* rows : allRows) {
+    numRows += rows->numRows();
+  }
+  // BloomFilter uses 2 bytes per value.
+  if (numRows == 0 || 2 * bits::nextPowerOfTwo(numRows) > maxSize) {
+    return;
+  }
+
+  const auto& hashers = table_->hashers();
+  const bool isHashMode =
+      table_->hashMode() == BaseHashTable::HashMode::kHash;
+  std::vector<std::unique_ptr<common::Filter>> filters(hashers.size());
+  std::vector<char*> rowPointers(1'024);
+  bool hasFilter = false;
+  for (auto i = 0; i < hashers.size(); ++i) {
+    const auto kind = hashers[i]->typeKind();
+    // Keys with an exact dynamic filter do not need a Bloom filter.
+    if (!isBloomFilterKeyType(kind) ||
+        (!isHashMode && hashers[i]->getFilter(false) != nullptr)) {
+      continue;
+    }
+    auto bloomFilter = std::make_shared<BloomFilter<>>();
+    bloomFilter->reset(numRows);
+    auto min = std::numeric_limits<int64_t>::max();
+    auto max = std::numeric_limits<int64_t>::min();
+    for (auto* rows : allRows) {
+      const auto column = rows->columnAt(i);
+      RowContainerIterator iter;
+      while (auto numListed = rows->listRows(
+                 &iter, rowPointers.size(), rowPointers.data())) {
+        for (auto j = 0; j < numListed; ++j) {
+          if (RowContainer::isNullAt(rowPointers[j], column)) {
+            continue;
+          }
+          const auto value =
+              integerKeyAt(rowPointers[j], column.offset(), kind);
+          bloomFilter->insert(folly::hasher<int64_t>()(value));
+          min = std::min(min, value);
+          max = std::max(max, value);
+        }
+      }
+    }
+    if (min > max) {
+      continue;
+    }
+    filters[i] = std::make_unique<common::BigintValuesUsingBloomFilter>(
+        min, max, std::move(bloomFilter), false);
+    hasFilter = true;
+  }
+  if (hasFilter) {
+    table_->setKeyBloomFilters(std::move(filters));
+  }
+}
+
 void HashBuild::ensureTableFits(uint64_t numRows) {
   // NOTE: we don't need memory reservation if all the partitions have been
   // spilled as nothing need to be built.
@@ -876,7 +1003,7 @@ void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
       keyChannels_.size());
 
   setupTable();
-  setupSpiller(spillInput.spillPartition.get());
+  setupSpiller(spillInput.spillPartition.get(), spillInput.skewed);
   stateCleared_ = false;
 
   // Start to process spill input.
@@ -931,6 +1058,12 @@ void HashBuild::addRuntimeStats() {
     lockedStats->runtimeStats[BaseHashTable::kNumTombstones] =
         RuntimeMetric(hashTableStats.numTombstones);
   }
+  lockedStats->runtimeStats[BaseHashTable::kPeakTableBytes] = RuntimeMetric(
+      hashTableStats.peakTableBytes, RuntimeCounter::Unit::kBytes);
+  if (hashTableStats.numRehashes != 0) {
+    lockedStats->runtimeStats[BaseHashTable::kRehashWallNanos] = RuntimeMetric(
+        hashTableStats.rehashWallNanos, RuntimeCounter::Unit::kNanos);
+  }
 
   // Add max spilling level stats if spilling has been triggered.
   if (spiller_ != nullptr && spiller_->isAnySpilled()) {
@@ -1050,8 +1183,39 @@ bool HashBuild::canReclaim() const {
   return canSpill() && !operatorCtx_->task()->hasMixedExecutionGroup();
 }
 
+// static
+SpillPartitionNumSet HashBuild::partitionsToSpill(
+    const std::vector<HashBuild*>& buildOps,
+    uint64_t targetBytes) {
+  std::vector<uint64_t> partitionBytes;
+  for (auto* buildOp : buildOps) {
+    const auto opBytes = buildOp->spiller_->partitionBytes();
+    partitionBytes.resize(opBytes.size(), 0);
+    for (auto i = 0; i < opBytes.size(); ++i) {
+      partitionBytes[i] += opBytes[i];
+    }
+  }
+  std::vector<uint32_t> partitions(partitionBytes.size());
+  std::iota(partitions.begin(), partitions.end(), 0);
+  std::sort(partitions.begin(), partitions.end(), [&](auto left, auto right) {
+    return partitionBytes[left] > partitionBytes[right];
+  });
+
+  SpillPartitionNumSet result;
+  uint64_t spillBytes{0};
+  for (auto partition : partitions) {
+    if (partitionBytes[partition] == 0 ||
+        (targetBytes > 0 && spillBytes >= targetBytes)) {
+      break;
+    }
+    result.insert(partition);
+    spillBytes += partitionBytes[partition];
+  }
+  return result;
+}
+
 void HashBuild::reclaim(
-    uint64_t /*unused*/,
+    uint64_t targetBytes,
     memory::MemoryReclaimer::Stats& stats) {
   VELOX_CHECK(canReclaim());
   auto* driver = operatorCtx_->driver();
@@ -1109,15 +1273,36 @@ void HashBuild::reclaim(
     explicit SpillResult(std::exception_ptr _error) : error(_error) {}
   };
 
+  std::vector<HashBuild*> buildOps;
+  buildOps.reserve(operators.size());
+  for (auto* op : operators) {
+    buildOps.push_back(static_cast<HashBuild*>(op));
+  }
+  // All the peers spill the same partitions as the probe side spills its
+  // input by the partitions of the merged table.
+  std::optional<SpillPartitionNumSet> spillPartitions;
+  if (partialSpillEnabled_) {
+    spillPartitions = partitionsToSpill(buildOps, targetBytes);
+  }
+
   std::vector<std::shared_ptr<AsyncSource<SpillResult>>> spillTasks;
   auto* spillExecutor = spillConfig()->executor;
-  for (auto* op : operators) {
-    HashBuild* buildOp = static_cast<HashBuild*>(op);
+  for (auto* buildOp : buildOps) {
     spillTasks.push_back(
-        std::make_shared<AsyncSource<SpillResult>>([buildOp]() {
+        std::make_shared<AsyncSource<SpillResult>>([buildOp,
+                                                    &spillPartitions]() {
           try {
-            buildOp->spiller_->spill();
-            buildOp->table_->clear();
+            if (spillPartitions.has_value()) {
+              // Erases the spilled rows and keeps the other partitions in
+              // memory. Their free rows are reused by the following input.
+              buildOp->spiller_->spill(spillPartitions.value());
+            } else {
+              buildOp->spiller_->spill();
+            }
+            if (buildOp->spiller_->isAllSpilled() ||
+                buildOp->table_->rows()->numRows() == 0) {
+              buildOp->table_->clear();
+            }
             // Release the minimum reserved memory.
             buildOp->pool()->release();
             return std::make_unique<SpillResult>(nullptr);
@@ -1128,7 +1313,7 @@ void HashBuild::reclaim(
             return std::make_unique<SpillResult>(std::current_exception());
           }
         }));
-    if ((operators.size() > 1) && (spillExecutor != nullptr)) {
+    if ((buildOps.size() > 1) && (spillExecutor != nullptr)) {
       spillExecutor->add([source = spillTasks.back()]() { source->prepare(); });
     }
   }
@@ -1179,5 +1364,9 @@ void HashBuild::close() {
     spiller_.reset();
     table_.reset();
   }
+  if (hashTableCacheEntry_ != nullptr) {
+    HashTableCache::getInstance()->release(hashTableCacheEntry_, taskId());
+    hashTableCacheEntry_.reset();
+  }
 }
 } // namespace facebook::velox::exec
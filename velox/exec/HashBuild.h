@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spill.h"
 #include "velox/exec/Spiller.h"
@@ -58,6 +59,11 @@ class HashBuild final : public Operator {
   };
   static std::string stateName(State state);
 
+  /// The number of restored skewed spill partition shards which are not
+  /// spilled again, see HashJoinBridge::kSkewedSpillPartitionRatio.
+  static inline const std::string kSkewedSpillPartitions{
+      "skewedSpillPartitions"};
+
   HashBuild(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -105,6 +111,12 @@ class HashBuild final : public Operator {
   // merged from all the other drivers.
   bool finishHashBuild();
 
+  // Invoked by the last build driver after the join table is built to build
+  // Bloom filters over the integer join keys that have no exact dynamic filter.
+  // The Bloom filters are pushed down by the probe side as dynamic filters.
+  // Disabled if the query config caps their size at 0.
+  void buildKeyBloomFilters();
+
   // Invoked after the hash table has been built. It waits for any spill data to
   // process after the probe side has finished processing the previously built
   // hash table. If disk spilling is not enabled or there is no more spill data,
@@ -117,6 +129,14 @@ class HashBuild final : public Operator {
     return canReclaim();
   }
 
+  // Returns the spill partitions with the most rows in the row containers of
+  // 'buildOps' whose total size reaches 'targetBytes', or all the non-empty
+  // partitions if 'targetBytes' is 0. Used by reclaim() to spill the same
+  // partitions from all the peers if 'partialSpillEnabled_' is set.
+  static SpillPartitionNumSet partitionsToSpill(
+      const std::vector<HashBuild*>& buildOps,
+      uint64_t targetBytes);
+
   // Indicates if the input is read from spill data or not.
   bool isInputFromSpill() const;
 
@@ -129,8 +149,12 @@ class HashBuild final : public Operator {
   // is not null, then the input is from the spilled data instead of from build
   // source. The function will need to setup a spill input reader to read input
   // from the spilled data for restoring. If the spilled data can't still fit
-  // in memory, then we will recursively spill part(s) of its data on disk.
-  void setupSpiller(SpillPartition* spillPartition = nullptr);
+  // in memory, then we will recursively spill part(s) of its data on disk
+  // unless the restored partition is 'skewed'. The rows of a skewed partition
+  // share a few keys, so spilling it again would not split it.
+  void setupSpiller(
+      SpillPartition* spillPartition = nullptr,
+      bool skewed = false);
 
   // Invoked when either there is no more input from the build source or from
   // the spill input reader during the restoring.
@@ -225,6 +249,10 @@ class HashBuild final : public Operator {
 
   bool exceededMaxSpillLevelLimit_{false};
 
+  // True if reclaim() spills only the partitions needed to reach the target
+  // bytes instead of all of them.
+  const bool partialSpillEnabled_;
+
   State state_{State::kRunning};
 
   // The row type used for hash table build and disk spilling.
@@ -311,6 +339,13 @@ class HashBuild final : public Operator {
 
   // Maps key channel in 'input_' to channel in key.
   folly::F14FastMap<column_index_t, column_index_t> keyChannelMap_;
+
+  // The shared table of this join if the join node uses the hash table cache.
+  std::shared_ptr<HashTableCache::Entry> hashTableCacheEntry_;
+
+  // True if another task builds the shared table. The input is then dropped
+  // and the shared table is set on 'joinBridge_' when it is built.
+  bool useCachedTable_{false};
 };
 
 inline std::ostream& operator<<(std::ostream& os, HashBuild::State state) {
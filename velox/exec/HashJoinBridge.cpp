@@ -16,10 +16,29 @@
 
 #include "velox/exec/HashJoinBridge.h"
 
+#include "velox/common/base/SuccinctPrinter.h"
+
 namespace facebook::velox::exec {
 namespace {
 static const char* kSpillProbedFlagColumnName = "__probedFlag";
+
+// Adds the names of the fields referenced by 'expr' to 'names'.
+void collectFieldNames(
+    const core::TypedExprPtr& expr,
+    std::unordered_set<std::string>& names) {
+  if (auto field =
+          std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(expr)) {
+    names.insert(field->name());
+  } else if (
+      auto lambda =
+          std::dynamic_pointer_cast<const core::LambdaTypedExpr>(expr)) {
+    collectFieldNames(lambda->body(), names);
+  }
+  for (const auto& input : expr->inputs()) {
+    collectFieldNames(input, names);
+  }
 }
+} // namespace
 
 void HashJoinBridge::start() {
   std::lock_guard<std::mutex> l(mutex_);
@@ -34,7 +53,7 @@ void HashJoinBridge::addBuilder() {
 }
 
 void HashJoinBridge::setHashTable(
-    std::unique_ptr<BaseHashTable> table,
+    std::shared_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
     bool hasNullKeys) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
@@ -48,24 +67,39 @@ void HashJoinBridge::setHashTable(
     VELOX_CHECK(!buildResult_.has_value());
     VELOX_CHECK(restoringSpillShards_.empty());
 
+    bool restoredPartitionSkewed{false};
     if (restoringSpillPartitionId_.has_value()) {
       for (const auto& id : spillPartitionIdSet) {
         VELOX_DCHECK_LT(
             restoringSpillPartitionId_->partitionBitOffset(),
             id.partitionBitOffset());
       }
+      restoredPartitionSkewed =
+          skewedSpillPartitionIds_.erase(restoringSpillPartitionId_.value()) >
+          0;
     }
 
     for (auto& partitionEntry : spillPartitionSet) {
       const auto id = partitionEntry.first;
       VELOX_CHECK_EQ(spillPartitionSets_.count(id), 0);
+      if (restoringSpillPartitionId_.has_value() &&
+          partitionEntry.second->size() >=
+              restoringSpillPartitionBytes_ * kSkewedSpillPartitionRatio) {
+        LOG(WARNING) << "Skewed spill partition " << id << " with "
+                     << succinctBytes(partitionEntry.second->size())
+                     << " spilled from restored partition "
+                     << restoringSpillPartitionId_.value() << " with "
+                     << succinctBytes(restoringSpillPartitionBytes_);
+        skewedSpillPartitionIds_.insert(id);
+      }
       spillPartitionSets_.emplace(id, std::move(partitionEntry.second));
     }
     buildResult_ = HashBuildResult(
         std::move(table),
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
-        hasNullKeys);
+        hasNullKeys,
+        restoredPartitionSkewed);
     restoringSpillPartitionId_.reset();
     promises = std::move(promises_);
   }
@@ -100,6 +134,7 @@ void HashJoinBridge::setAntiJoinHasNullKeys() {
     buildResult_ = HashBuildResult{};
     restoringSpillPartitionId_.reset();
     spillPartitions.swap(spillPartitionSets_);
+    skewedSpillPartitionIds_.clear();
     promises = std::move(promises_);
   }
   notify(std::move(promises));
@@ -143,6 +178,8 @@ bool HashJoinBridge::probeFinished() {
     if (!spillPartitionSets_.empty()) {
       hasSpillInput = true;
       restoringSpillPartitionId_ = spillPartitionSets_.begin()->first;
+      restoringSpillPartitionBytes_ =
+          spillPartitionSets_.begin()->second->size();
       restoringSpillShards_ =
           spillPartitionSets_.begin()->second->split(numBuilders_);
       VELOX_CHECK_EQ(restoringSpillShards_.size(), numBuilders_);
@@ -182,7 +219,9 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
   VELOX_CHECK(!restoringSpillShards_.empty());
   auto spillShard = std::move(restoringSpillShards_.back());
   restoringSpillShards_.pop_back();
-  return SpillInput(std::move(spillShard));
+  return SpillInput(
+      std::move(spillShard),
+      skewedSpillPartitionIds_.count(restoringSpillPartitionId_.value()) > 0);
 }
 
 bool isLeftNullAwareJoinWithFilter(
@@ -238,6 +277,35 @@ bool needRightSideJoin(core::JoinType joinType) {
       isRightSemiFilterJoin(joinType) || isRightSemiProjectJoin(joinType);
 }
 
+RowTypePtr hashJoinTableType(
+    const std::shared_ptr<const core::HashJoinNode>& joinNode) {
+  const auto& buildType = joinNode->sources()[1]->outputType();
+  std::unordered_set<std::string> usedNames;
+  for (const auto& name : joinNode->outputType()->names()) {
+    usedNames.insert(name);
+  }
+  if (joinNode->filter() != nullptr) {
+    collectFieldNames(joinNode->filter(), usedNames);
+  }
+
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::unordered_set<column_index_t> keyChannels;
+  for (const auto& key : joinNode->rightKeys()) {
+    const auto channel = buildType->getChildIdx(key->name());
+    names.emplace_back(buildType->nameOf(channel));
+    types.emplace_back(buildType->childAt(channel));
+    keyChannels.insert(channel);
+  }
+  for (auto i = 0; i < buildType->size(); ++i) {
+    if (keyChannels.count(i) == 0 && usedNames.count(buildType->nameOf(i))) {
+      names.emplace_back(buildType->nameOf(i));
+      types.emplace_back(buildType->childAt(i));
+    }
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
 RowTypePtr hashJoinTableSpillType(
     const RowTypePtr& tableType,
     core::JoinType joinType) {
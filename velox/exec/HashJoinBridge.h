@@ -32,6 +32,12 @@ class HashJoinBridgeTestHelper;
 /// the same name.
 class HashJoinBridge : public JoinBridge {
  public:
+  /// A partition spilled while restoring a spilled partition is skewed if it
+  /// holds at least this fraction of the bytes of the restored partition. The
+  /// rows of such a partition mostly share a few join keys which further hash
+  /// partitioning can not split.
+  static constexpr double kSkewedSpillPartitionRatio{0.9};
+
   void start() override;
 
   /// Invoked by HashBuild operator ctor to add to this bridge by incrementing
@@ -41,9 +47,10 @@ class HashJoinBridge : public JoinBridge {
 
   /// Invoked by the build operator to set the built hash table.
   /// 'spillPartitionSet' contains the spilled partitions while building
-  /// 'table' which only applies if the disk spilling is enabled.
+  /// 'table' which only applies if the disk spilling is enabled. 'table' may
+  /// be shared with the join bridges of other tasks, see HashTableCache.
   void setHashTable(
-      std::unique_ptr<BaseHashTable> table,
+      std::shared_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
       bool hasNullKeys);
 
@@ -66,11 +73,13 @@ class HashJoinBridge : public JoinBridge {
         std::shared_ptr<BaseHashTable> _table,
         std::optional<SpillPartitionId> _restoredPartitionId,
         SpillPartitionIdSet _spillPartitionIds,
-        bool _hasNullKeys)
+        bool _hasNullKeys,
+        bool _restoredPartitionSkewed = false)
         : hasNullKeys(_hasNullKeys),
           table(std::move(_table)),
           restoredPartitionId(std::move(_restoredPartitionId)),
-          spillPartitionIds(std::move(_spillPartitionIds)) {}
+          spillPartitionIds(std::move(_spillPartitionIds)),
+          restoredPartitionSkewed(_restoredPartitionSkewed) {}
 
     HashBuildResult() : hasNullKeys(true) {}
 
@@ -78,6 +87,9 @@ class HashJoinBridge : public JoinBridge {
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
     SpillPartitionIdSet spillPartitionIds;
+    /// True if 'restoredPartitionId' is a skewed partition, see
+    /// kSkewedSpillPartitionRatio.
+    bool restoredPartitionSkewed{false};
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -95,13 +107,16 @@ class HashJoinBridge : public JoinBridge {
 
   /// Contains the spill input for one HashBuild operator: a shard of previously
   /// spilled partition data. 'spillPartition' is null if there is no more spill
-  /// data to restore.
+  /// data to restore. 'skewed' is true if the partition is skewed, see
+  /// kSkewedSpillPartitionRatio.
   struct SpillInput {
     explicit SpillInput(
-        std::unique_ptr<SpillPartition> spillPartition = nullptr)
-        : spillPartition(std::move(spillPartition)) {}
+        std::unique_ptr<SpillPartition> spillPartition = nullptr,
+        bool skewed = false)
+        : spillPartition(std::move(spillPartition)), skewed(skewed) {}
 
     std::unique_ptr<SpillPartition> spillPartition;
+    bool skewed;
   };
 
   /// Invoked by HashBuild operator to get one of previously spilled partition
@@ -131,6 +146,13 @@ class HashJoinBridge : public JoinBridge {
   // of spill files and will be processed by one of the HashBuild operator.
   std::vector<std::unique_ptr<SpillPartition>> restoringSpillShards_;
 
+  // The byte size of the restoring spill partition.
+  uint64_t restoringSpillPartitionBytes_{0};
+
+  // The ids of the skewed partitions in 'spillPartitionSets_' and of the
+  // restoring one if it is skewed.
+  SpillPartitionIdSet skewedSpillPartitionIds_;
+
   // The spill partitions remaining to restore. This set is populated using
   // information provided by the HashBuild operators if spilling is enabled.
   // This set can grow if HashBuild operator cannot load full partition in
@@ -172,6 +194,13 @@ bool isHashProbeMemoryPool(const memory::MemoryPool& pool);
 
 bool needRightSideJoin(core::JoinType joinType);
 
+/// Returns the type of the hash table rows built for 'joinNode'. The build
+/// side keys come first, followed by the other build side columns in the
+/// join output or filter. The build side columns used by neither are not
+/// stored in the table.
+RowTypePtr hashJoinTableType(
+    const std::shared_ptr<const core::HashJoinNode>& joinNode);
+
 /// Returns the type used to spill a given hash table type. The function
 /// might attach a boolean column at the end of 'tableType' if 'joinType' needs
 /// right side join processing. It is used by the hash join table spilling
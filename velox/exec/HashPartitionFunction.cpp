@@ -22,7 +22,9 @@ HashPartitionFunction::HashPartitionFunction(
     const RowTypePtr& inputType,
     const std::vector<column_index_t>& keyChannels,
     const std::vector<VectorPtr>& constValues)
-    : numPartitions_{numPartitions} {
+    : numPartitions_{numPartitions},
+      modMultiplier_{
+          numPartitions > 0 ? ~__uint128_t(0) / numPartitions + 1 : 0} {
   init(inputType, keyChannels, constValues);
 }
 
@@ -32,6 +34,7 @@ HashPartitionFunction::HashPartitionFunction(
     const std::vector<column_index_t>& keyChannels,
     const std::vector<VectorPtr>& constValues)
     : numPartitions_{hashBitRange.numPartitions()},
+      modMultiplier_{0},
       hashBitRange_(hashBitRange) {
   VELOX_CHECK_GT(hashBitRange.numPartitions(), 0);
   VELOX_CHECK(!keyChannels.empty());
@@ -85,7 +88,7 @@ std::optional<uint32_t> HashPartitionFunction::partition(
     }
   } else {
     for (auto i = 0; i < size; ++i) {
-      partitions[i] = hashes_[i] % numPartitions_;
+      partitions[i] = fastMod(hashes_[i]);
     }
   }
 
@@ -57,7 +57,21 @@ class HashPartitionFunction : public core::PartitionFunction {
       const std::vector<column_index_t>& keyChannels,
       const std::vector<VectorPtr>& constValues);
 
+  // Returns 'hash % numPartitions_' using multiplications by
+  // 'modMultiplier_' instead of a division. See Lemire et al., "Faster
+  // Remainder by Direct Computation", 2019.
+  uint32_t fastMod(uint64_t hash) const {
+    const __uint128_t lowBits = modMultiplier_ * hash;
+    const __uint128_t bottomHalf =
+        ((lowBits & ~uint64_t(0)) * uint64_t(numPartitions_)) >> 64;
+    const __uint128_t topHalf = (lowBits >> 64) * uint64_t(numPartitions_);
+    return (bottomHalf + topHalf) >> 64;
+  }
+
   const int numPartitions_;
+  // ceil(2^128 / numPartitions_). Wraps to 0 for a single partition, for
+  // which fastMod() returns 0 as it should.
+  const __uint128_t modMultiplier_;
   const std::optional<HashBitRange> hashBitRange_ = std::nullopt;
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
 
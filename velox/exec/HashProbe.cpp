@@ -31,32 +31,6 @@ namespace {
 // Batch size used when iterating the row container.
 constexpr int kBatchSize = 1024;
 
-// Returns the type for the hash table row. Build side keys first,
-// then dependent build side columns.
-RowTypePtr makeTableType(
-    const RowType* type,
-    const std::vector<std::shared_ptr<const core::FieldAccessTypedExpr>>&
-        keys) {
-  std::vector<std::string> names;
-  std::vector<TypePtr> types;
-  std::unordered_set<column_index_t> keyChannels(keys.size());
-  names.reserve(type->size());
-  types.reserve(type->size());
-  for (const auto& key : keys) {
-    auto channel = type->getChildIdx(key->name());
-    names.emplace_back(type->nameOf(channel));
-    types.emplace_back(type->childAt(channel));
-    keyChannels.insert(channel);
-  }
-  for (auto i = 0; i < type->size(); ++i) {
-    if (keyChannels.find(i) == keyChannels.end()) {
-      names.emplace_back(type->nameOf(i));
-      types.emplace_back(type->childAt(i));
-    }
-  }
-  return ROW(std::move(names), std::move(types));
-}
-
 // Copy values from 'rows' of 'table' according to 'projections' in
 // 'result'. Reuses 'result' children where possible.
 void extractColumns(
@@ -131,6 +105,9 @@ HashProbe::HashProbe(
       joinBridge_(operatorCtx_->task()->getHashJoinBridgeLocked(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
+      dedupProbeRows_(
+          isLeftSemiFilterJoin(joinType_) ||
+          isLeftSemiProjectJoin(joinType_) || isAntiJoin(joinType_)),
       filterResult_(1),
       outputTableRows_(outputBatchSize_) {
   VELOX_CHECK_NOT_NULL(joinBridge_);
@@ -150,8 +127,7 @@ void HashProbe::initialize() {
 
   VELOX_CHECK_NULL(lookup_);
   lookup_ = std::make_unique<HashLookup>(hashers_);
-  auto buildType = joinNode_->sources()[1]->outputType();
-  auto tableType = makeTableType(buildType.get(), joinNode_->rightKeys());
+  auto tableType = hashJoinTableType(joinNode_);
   if (joinNode_->filter()) {
     initializeFilter(joinNode_->filter(), probeType_, tableType);
   }
@@ -311,7 +287,9 @@ void HashProbe::asyncWaitForHashTable() {
 
   maybeSetupSpillInputReader(hashBuildResult->restoredPartitionId);
   maybeSetupInputSpiller(hashBuildResult->spillPartitionIds);
-  prepareTableSpill(hashBuildResult->restoredPartitionId);
+  prepareTableSpill(
+      hashBuildResult->restoredPartitionId,
+      hashBuildResult->restoredPartitionSkewed);
 
   if (table_->numDistinct() == 0) {
     if (skipProbeOnEmptyBuild()) {
@@ -329,8 +307,9 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       table_->hasKeyBloomFilters()) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
     // push down.
@@ -348,10 +327,19 @@ void HashProbe::asyncWaitForHashTable() {
     const auto nullAllowed = isRightSemiProjectJoin(joinType_) && nullAware_;
 
     for (auto i = 0; i < keyChannels_.size(); ++i) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(nullAllowed)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
-        }
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      std::unique_ptr<common::Filter> filter;
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        filter = buildHashers[i]->getFilter(nullAllowed);
+      }
+      // Fall back to a Bloom filter for keys with too many distinct values.
+      if (filter == nullptr && table_->keyBloomFilter(i) != nullptr) {
+        filter = table_->keyBloomFilter(i)->clone(nullAllowed);
+      }
+      if (filter != nullptr) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
       }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
@@ -533,9 +521,12 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down filter when the
   // following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, i.e. not a Bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      dynamicFilters_.begin()->second->kind() !=
+          common::FilterKind::kBigintValuesUsingBloomFilter) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -642,7 +633,7 @@ void HashProbe::addInput(RowVectorPtr input) {
     hits.resize(numInput);
     std::fill(hits.data(), hits.data() + numInput, nullptr);
     if (!lookup_->rows.empty()) {
-      table_->joinProbe(*lookup_);
+      joinProbe();
     }
 
     // Update lookup_->rows to include all input rows, not just
@@ -656,11 +647,81 @@ void HashProbe::addInput(RowVectorPtr input) {
       return;
     }
     lookup_->hits.resize(lookup_->rows.back() + 1);
-    table_->joinProbe(*lookup_);
+    joinProbe();
   }
   results_.reset(*lookup_);
 }
 
+void HashProbe::joinProbe() {
+  if (dedupProbeRows_ && removeDuplicateProbeRows()) {
+    table_->joinProbe(*lookup_);
+    restoreDuplicateProbeRows();
+    return;
+  }
+  table_->joinProbe(*lookup_);
+}
+
+bool HashProbe::removeDuplicateProbeRows() {
+  auto& rows = lookup_->rows;
+  if (rows.size() < 2) {
+    return false;
+  }
+  // In array and normalized key modes the hashes are the value IDs of the
+  // keys, so equal hashes imply equal keys. In hash mode, rows with the same
+  // decoded index in all keys have equal keys. There are none if any key is
+  // flat.
+  const bool valueIds = table_->hashMode() != BaseHashTable::HashMode::kHash;
+  if (!valueIds) {
+    for (auto& hasher : lookup_->hashers) {
+      if (hasher->decodedVector().isIdentityMapping()) {
+        return false;
+      }
+    }
+  }
+  const auto* hashes = lookup_->hashes.data();
+  auto sameKeys = [&](vector_size_t row, vector_size_t other) {
+    if (valueIds) {
+      return hashes[row] == hashes[other];
+    }
+    for (auto& hasher : lookup_->hashers) {
+      const auto& decoded = hasher->decodedVector();
+      if (decoded.index(row) != decoded.index(other)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  duplicateProbeRows_.clear();
+  uniqueProbeRows_.clear();
+  vector_size_t previous = rows[0];
+  uniqueProbeRows_.push_back(previous);
+  for (size_t i = 1; i < rows.size(); ++i) {
+    const auto row = rows[i];
+    if (sameKeys(row, previous)) {
+      duplicateProbeRows_.emplace_back(row, previous);
+    } else {
+      uniqueProbeRows_.push_back(row);
+      previous = row;
+    }
+  }
+  if (duplicateProbeRows_.empty()) {
+    return false;
+  }
+  std::swap(rows, uniqueProbeRows_);
+  return true;
+}
+
+void HashProbe::restoreDuplicateProbeRows() {
+  std::swap(lookup_->rows, uniqueProbeRows_);
+  auto* hits = lookup_->hits.data();
+  for (const auto& [row, probedRow] : duplicateProbeRows_) {
+    hits[row] = hits[probedRow];
+  }
+  addRuntimeStat(
+      "numDedupedProbeRows", RuntimeCounter(duplicateProbeRows_.size()));
+}
+
 void HashProbe::prepareOutput(vector_size_t size) {
   // Try to re-use memory for the output vectors that contain build-side data.
   // We expect output vectors containing probe-side data to be null (reset in
@@ -1806,7 +1867,8 @@ std::unique_ptr<Spiller> HashProbe::spillTable(RowContainer* subTableRows) {
 }
 
 void HashProbe::prepareTableSpill(
-    const std::optional<SpillPartitionId>& restoredPartitionId) {
+    const std::optional<SpillPartitionId>& restoredPartitionId,
+    bool restoredPartitionSkewed) {
   if (!spillEnabled()) {
     return;
   }
@@ -1827,6 +1889,10 @@ void HashProbe::prepareTableSpill(
       ++spillStats_.wlock()->spillMaxLevelExceededCount;
       return;
     }
+    if (restoredPartitionSkewed) {
+      exceededMaxSpillLevelLimit_ = true;
+      return;
+    }
   }
   exceededMaxSpillLevelLimit_ = false;
 
@@ -1838,31 +1904,8 @@ void HashProbe::prepareTableSpill(
     return;
   }
 
-  const auto& tableInputType = joinNode_->sources()[1]->outputType();
-  std::vector<std::string> names;
-  names.reserve(tableInputType->size());
-  std::vector<TypePtr> types;
-  types.reserve(tableInputType->size());
-  const auto numKeys = joinNode_->rightKeys().size();
-
-  // Identify the non-key build side columns.
-  folly::F14FastMap<column_index_t, column_index_t> keyChannelMap;
-  for (int i = 0; i < numKeys; ++i) {
-    const auto& key = joinNode_->rightKeys()[i];
-    const auto channel = exprToChannel(key.get(), tableInputType);
-    keyChannelMap[channel] = i;
-    names.emplace_back(tableInputType->nameOf(channel));
-    types.emplace_back(tableInputType->childAt(channel));
-  }
-  const auto numDependents = tableInputType->size() - numKeys;
-  for (auto i = 0; i < tableInputType->size(); ++i) {
-    if (keyChannelMap.find(i) == keyChannelMap.end()) {
-      names.emplace_back(tableInputType->nameOf(i));
-      types.emplace_back(tableInputType->childAt(i));
-    }
-  }
-  tableSpillType_ = hashJoinTableSpillType(
-      ROW(std::move(names), std::move(types)), joinType_);
+  tableSpillType_ =
+      hashJoinTableSpillType(hashJoinTableType(joinNode_), joinType_);
 }
 
 void HashProbe::close() {
@@ -183,9 +183,12 @@ class HashProbe : public Operator {
       const std::optional<SpillPartitionId>& restoredSpillPartitionId);
 
   // Prepares the table spill by checking the spill level limit, setting spill
-  // partition bits and table spill type.
+  // partition bits and table spill type. The table is not spilled if it is
+  // built from a skewed spill partition, see
+  // HashJoinBridge::kSkewedSpillPartitionRatio.
   void prepareTableSpill(
-      const std::optional<SpillPartitionId>& restoredPartitionId);
+      const std::optional<SpillPartitionId>& restoredPartitionId,
+      bool restoredPartitionSkewed);
 
   bool spillEnabled() const;
 
@@ -254,6 +257,22 @@ class HashProbe : public Operator {
   /// Decode join key inputs and populate 'nonNullInputRows_'.
   void decodeAndDetectNonNullKeys();
 
+  // Probes 'table_' with 'lookup_'. For semi and anti joins, probe rows whose
+  // keys equal the keys of the preceding row are not probed and get the hit of
+  // that row instead.
+  void joinProbe();
+
+  // Moves the rows of 'lookup_->rows' whose keys equal the keys of the
+  // preceding probed row to 'duplicateProbeRows_'. Returns false and leaves
+  // 'lookup_->rows' unchanged if there are no such rows. Keys are compared by
+  // value IDs in array and normalized key hash modes and by dictionary indices
+  // in hash mode.
+  bool removeDuplicateProbeRows();
+
+  // Restores 'lookup_->rows' and copies the hits of the probed rows to the
+  // rows removed by removeDuplicateProbeRows().
+  void restoreDuplicateProbeRows();
+
   // Invoked when there is no more input from either upstream task or spill
   // input. If there is remaining spilled data, then the last finished probe
   // operator is responsible for notifying the hash build operators to build the
@@ -332,6 +351,17 @@ class HashProbe : public Operator {
 
   std::unique_ptr<HashLookup> lookup_;
 
+  // True if equal consecutive probe keys are probed once. Set for semi and
+  // anti joins which typically filter on skewed keys.
+  const bool dedupProbeRows_;
+
+  // Scratch for removeDuplicateProbeRows(). Holds the original
+  // 'lookup_->rows' while the deduplicated rows are probed.
+  std::vector<vector_size_t> uniqueProbeRows_;
+
+  // Pairs of a probe row not probed and the earlier row with the same keys.
+  std::vector<std::pair<vector_size_t, vector_size_t>> duplicateProbeRows_;
+
   // Channel of probe keys in 'input_'.
   std::vector<column_index_t> keyChannels_;
 
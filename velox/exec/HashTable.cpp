@@ -508,7 +508,18 @@ void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
   auto rows = lookup.rows.data();
   constexpr int32_t kKeyOffset =
       -static_cast<int32_t>(sizeof(normalized_key_t));
+  // Prefetch the buckets ahead of the 4 interleaved probes as in joinProbe().
+  constexpr int32_t kPrefetchDistance = 16;
   for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
+    if (probeIndex + kPrefetchDistance + 4 <= numProbes) {
+      for (auto i = probeIndex + kPrefetchDistance;
+           i < probeIndex + kPrefetchDistance + 4;
+           ++i) {
+        __builtin_prefetch(
+            reinterpret_cast<char*>(table_) +
+            bucketOffset(lookup.hashes[rows[i]]));
+      }
+    }
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
     row = rows[probeIndex + 1];
@@ -603,7 +614,20 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   ProbeState state2;
   ProbeState state3;
   ProbeState state4;
+  // The 4 interleaved probes keep only 4 bucket loads in flight, which does
+  // not cover the DRAM latency when the table is much larger than the cache.
+  // Prefetch the buckets of the rows kPrefetchDistance positions ahead.
+  constexpr int32_t kPrefetchDistance = 16;
   for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
+    if (probeIndex + kPrefetchDistance + 4 <= numProbes) {
+      for (auto i = probeIndex + kPrefetchDistance;
+           i < probeIndex + kPrefetchDistance + 4;
+           ++i) {
+        __builtin_prefetch(
+            reinterpret_cast<char*>(table_) +
+            bucketOffset(lookup.hashes[rows[i]]));
+      }
+    }
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
     row = rows[probeIndex + 1];
@@ -677,29 +701,45 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
   constexpr int32_t groupSize = 64;
-  ProbeState states[groupSize];
+  // The states of the group being probed and of the next group. preProbe()
+  // prefetches the buckets of the next group while the full probes of the
+  // current group wait on their row loads.
+  ProbeState states[2][groupSize];
   const uint64_t* keys = lookup.normalizedKeys.data();
   const uint64_t* hashes = lookup.hashes.data();
   char** hits = lookup.hits.data();
   constexpr int32_t kKeyOffset =
       -static_cast<int32_t>(sizeof(normalized_key_t));
-  for (; probeIndex + groupSize <= numProbes; probeIndex += groupSize) {
+  auto preProbeGroup = [&](ProbeState* group, int32_t start) {
     for (int32_t i = 0; i < groupSize; ++i) {
-      int32_t row = rows[probeIndex + i];
-      states[i].preProbe(*this, hashes[row], row);
+      int32_t row = rows[start + i];
+      group[i].preProbe(*this, hashes[row], row);
     }
+  };
+  int32_t current = 0;
+  if (groupSize <= numProbes) {
+    preProbeGroup(states[current], 0);
+  }
+  for (; probeIndex + groupSize <= numProbes; probeIndex += groupSize) {
+    ProbeState* group = states[current];
     for (int32_t i = 0; i < groupSize; ++i) {
-      states[i].firstProbe(*this, kKeyOffset);
+      group[i].firstProbe(*this, kKeyOffset);
+    }
+    const int32_t nextIndex = probeIndex + groupSize;
+    if (nextIndex + groupSize <= numProbes) {
+      preProbeGroup(states[1 - current], nextIndex);
     }
     for (int32_t i = 0; i < groupSize; ++i) {
-      hits[states[i].row()] = states[i].joinNormalizedKeyFullProbe(*this, keys);
+      hits[group[i].row()] = group[i].joinNormalizedKeyFullProbe(*this, keys);
     }
+    current = 1 - current;
   }
+  ProbeState& state = states[0][0];
   for (; probeIndex < numProbes; ++probeIndex) {
     int32_t row = rows[probeIndex];
-    states[0].preProbe(*this, lookup.hashes[row], row);
-    states[0].firstProbe(*this, 0);
-    hits[row] = states[0].joinNormalizedKeyFullProbe(*this, keys);
+    state.preProbe(*this, hashes[row], row);
+    state.firstProbe(*this, kKeyOffset);
+    hits[row] = state.joinNormalizedKeyFullProbe(*this, keys);
   }
 }
 
@@ -721,6 +761,8 @@ void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
   const auto numPages =
       memory::AllocationTraits::numPages(size * tableSlotSize());
   rows_->pool()->allocateContiguous(numPages, tableAllocation_);
+  peakTableBytes_ =
+      std::max<int64_t>(peakTableBytes_, tableAllocation_.size());
   table_ = tableAllocation_.data<char*>();
   memset(table_, 0, capacity_ * sizeof(char*));
 }
@@ -1237,30 +1279,35 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::rehash(bool initNormalizedKeys) {
   ++numRehashes_;
   constexpr int32_t kHashBatchSize = 1024;
-  if (canApplyParallelJoinBuild()) {
-    parallelJoinBuild();
-    return;
-  }
-  raw_vector<uint64_t> hashes;
-  hashes.resize(kHashBatchSize);
-  char* groups[kHashBatchSize];
-  // A join build can have multiple payload tables. Loop over 'this'
-  // and the possible other tables and put all the data in the table
-  // of 'this'.
-  for (int32_t i = 0; i <= otherTables_.size(); ++i) {
-    RowContainerIterator iterator;
-    int32_t numGroups;
-    do {
-      numGroups = (i == 0 ? this : otherTables_[i - 1].get())
-                      ->rows()
-                      ->listRows(&iterator, kHashBatchSize, groups);
-      if (!insertBatch(
-              groups, numGroups, hashes, initNormalizedKeys || i != 0)) {
-        VELOX_CHECK_NE(hashMode_, HashMode::kHash);
-        setHashMode(HashMode::kHash, 0);
-        return;
-      }
-    } while (numGroups > 0);
+  bool inserted{true};
+  {
+    CpuWallTimer timer(rehashTiming_);
+    if (canApplyParallelJoinBuild()) {
+      parallelJoinBuild();
+      return;
+    }
+    raw_vector<uint64_t> hashes;
+    hashes.resize(kHashBatchSize);
+    char* groups[kHashBatchSize];
+    // A join build can have multiple payload tables. Loop over 'this'
+    // and the possible other tables and put all the data in the table
+    // of 'this'.
+    for (int32_t i = 0; inserted && i <= otherTables_.size(); ++i) {
+      RowContainerIterator iterator;
+      int32_t numGroups;
+      do {
+        numGroups = (i == 0 ? this : otherTables_[i - 1].get())
+                        ->rows()
+                        ->listRows(&iterator, kHashBatchSize, groups);
+        inserted = insertBatch(
+            groups, numGroups, hashes, initNormalizedKeys || i != 0);
+      } while (inserted && numGroups > 0);
+    }
+  }
+  if (!inserted) {
+    // Switching to kHash rehashes again, which is timed on its own.
+    VELOX_CHECK_NE(hashMode_, HashMode::kHash);
+    setHashMode(HashMode::kHash, 0);
   }
 }
 
@@ -1272,6 +1319,8 @@ void HashTable<ignoreNullKeys>::setHashMode(HashMode mode, int32_t numNew) {
     const auto bytes = capacity_ * tableSlotSize();
     const auto numPages = memory::AllocationTraits::numPages(bytes);
     rows_->pool()->allocateContiguous(numPages, tableAllocation_);
+    peakTableBytes_ =
+        std::max<int64_t>(peakTableBytes_, tableAllocation_.size());
     table_ = tableAllocation_.data<char*>();
     memset(table_, 0, bytes);
     hashMode_ = HashMode::kArray;
@@ -2039,6 +2088,53 @@ std::string BaseHashTable::RowsIterator::toString() const {
       rowContainerIterator_.toString());
 }
 
+namespace {
+// Hashes the keys of 'rows' of 'input' into 'lookup.hashes' in
+// BaseHashTable::HashMode::kHash. Starts from the kept hashes of the longest
+// prefix of keys whose vectors are the same as in the previous input and keeps
+// the hashes of the other prefixes for the next input. The last key is not
+// kept since inputs with all the same keys are not expected.
+void hashWithPrefixReuse(
+    HashLookup& lookup,
+    const RowVectorPtr& input,
+    const SelectivityVector& rows) {
+  const auto& hashers = lookup.hashers;
+  const auto numKeys = hashers.size();
+  VELOX_DCHECK(!hashers.empty());
+  const auto numRows = rows.end();
+  lookup.prefixKeys.resize(numKeys - 1);
+  lookup.prefixHashes.resize(numKeys - 1);
+
+  column_index_t numReused = 0;
+  if (rows == lookup.prefixRows) {
+    while (numReused < numKeys - 1 &&
+           lookup.prefixKeys[numReused] ==
+               input->childAt(hashers[numReused]->channel())) {
+      ++numReused;
+    }
+  }
+  if (numReused > 0) {
+    std::copy_n(
+        lookup.prefixHashes[numReused - 1].data(),
+        numRows,
+        lookup.hashes.data());
+  } else {
+    // The kept prefixes are for other rows.
+    lookup.prefixRows = rows;
+  }
+
+  for (auto i = numReused; i < numKeys; ++i) {
+    hashers[i]->hash(rows, i > 0, lookup.hashes);
+    if (i < numKeys - 1) {
+      lookup.prefixKeys[i] = input->childAt(hashers[i]->channel());
+      auto& prefixHashes = lookup.prefixHashes[i];
+      prefixHashes.resize(numRows);
+      std::copy_n(lookup.hashes.data(), numRows, prefixHashes.data());
+    }
+  }
+}
+} // namespace
+
 void BaseHashTable::prepareForGroupProbe(
     HashLookup& lookup,
     const RowVectorPtr& input,
@@ -2062,14 +2158,18 @@ void BaseHashTable::prepareForGroupProbe(
 
   bool rehash = false;
   const auto mode = hashMode();
-  for (auto i = 0; i < hashers.size(); ++i) {
-    auto& hasher = hashers[i];
-    if (mode != BaseHashTable::HashMode::kHash) {
-      if (!hasher->computeValueIds(rows, lookup.hashes)) {
-        rehash = true;
+  if (mode == BaseHashTable::HashMode::kHash && lookup.reusePrefixHashes) {
+    hashWithPrefixReuse(lookup, input, rows);
+  } else {
+    for (auto i = 0; i < hashers.size(); ++i) {
+      auto& hasher = hashers[i];
+      if (mode != BaseHashTable::HashMode::kHash) {
+        if (!hasher->computeValueIds(rows, lookup.hashes)) {
+          rehash = true;
+        }
+      } else {
+        hasher->hash(rows, i > 0, lookup.hashes);
       }
-    } else {
-      hasher->hash(rows, i > 0, lookup.hashes);
     }
   }
 
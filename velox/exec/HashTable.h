@@ -95,6 +95,30 @@ struct HashLookup {
   /// If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   /// Populated by groupProbe and joinProbe.
   raw_vector<uint64_t> normalizedKeys;
+
+  /// If true, prepareForGroupProbe keeps the hashes of the leading keys of
+  /// the input and reuses them for the next input if its leading key vectors
+  /// and rows are the same. This is the case for the consecutive batches
+  /// GroupId produces for the grouping sets of one input batch. Applies only
+  /// in BaseHashTable::HashMode::kHash.
+  bool reusePrefixHashes{false};
+
+  /// The key vectors of the input 'prefixHashes' are for. The references make
+  /// sure that an equal vector in the next input has the same values.
+  std::vector<VectorPtr> prefixKeys;
+
+  /// 'prefixHashes[i]' has the hashes of the first i + 1 keys for
+  /// 'prefixRows'. Index is the row number.
+  std::vector<raw_vector<uint64_t>> prefixHashes;
+
+  SelectivityVector prefixRows;
+
+  /// Drops the kept key vectors and hashes.
+  void clearPrefixHashes() {
+    prefixKeys.clear();
+    prefixHashes.clear();
+    prefixRows.resize(0);
+  }
 };
 
 struct HashTableStats {
@@ -103,6 +127,11 @@ struct HashTableStats {
   int64_t numDistinct{0};
   /// Counts the number of tombstone table slots.
   int64_t numTombstones{0};
+  /// Wall time spent re-inserting rows into grown or re-moded tables.
+  uint64_t rehashWallNanos{0};
+  /// Largest table allocation in bytes. A rehash frees the old table before
+  /// allocating the new one, so this is also the peak memory of the table.
+  int64_t peakTableBytes{0};
 };
 
 class BaseHashTable {
@@ -129,6 +158,9 @@ class BaseHashTable {
   static inline const std::string kNumRehashes{"hashtable.numRehashes"};
   static inline const std::string kNumDistinct{"hashtable.numDistinct"};
   static inline const std::string kNumTombstones{"hashtable.numTombstones"};
+  static inline const std::string kRehashWallNanos{
+      "hashtable.rehashWallNanos"};
+  static inline const std::string kPeakTableBytes{"hashtable.peakTableBytes"};
 
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
@@ -344,6 +376,25 @@ class BaseHashTable {
   /// join use.
   virtual std::vector<RowContainer*> allRows() const = 0;
 
+  /// Sets Bloom filters over the key columns for use as dynamic filters when
+  /// the keys have too many distinct values for an exact filter. 'filters' has
+  /// one entry per key, nullptr for keys without a Bloom filter.
+  void setKeyBloomFilters(
+      std::vector<std::unique_ptr<common::Filter>> filters) {
+    VELOX_CHECK_EQ(filters.size(), hashers_.size());
+    keyBloomFilters_ = std::move(filters);
+  }
+
+  bool hasKeyBloomFilters() const {
+    return !keyBloomFilters_.empty();
+  }
+
+  /// Returns the Bloom filter over the 'key'th key column or nullptr if there
+  /// is none.
+  const common::Filter* keyBloomFilter(column_index_t key) const {
+    return keyBloomFilters_.empty() ? nullptr : keyBloomFilters_[key].get();
+  }
+
   /// Static functions for processing internals. Public because used in
   /// structs that define probe and insert algorithms.
 
@@ -407,6 +458,8 @@ class BaseHashTable {
 
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
   std::unique_ptr<RowContainer> rows_;
+  // Bloom filters over the keys set by the hash join build. Empty if none.
+  std::vector<std::unique_ptr<common::Filter>> keyBloomFilters_;
 
   // Time spent in build outside of the calling thread.
   CpuWallTiming offThreadBuildTiming_;
@@ -546,7 +599,12 @@ class HashTable : public BaseHashTable {
 
   HashTableStats stats() const override {
     return HashTableStats{
-        capacity_, numRehashes_, numDistinct_, numTombstones_};
+        capacity_,
+        numRehashes_,
+        numDistinct_,
+        numTombstones_,
+        rehashTiming_.wallNanos,
+        peakTableBytes_};
   }
 
   bool hasDuplicateKeys() const override {
@@ -967,6 +1025,11 @@ class HashTable : public BaseHashTable {
   int64_t numTombstones_{0};
   // Counts the number of rehash() calls.
   int64_t numRehashes_{0};
+  // Time spent in rehash(), not counting the rehash after a fallback to
+  // kHash mode twice.
+  CpuWallTiming rehashTiming_;
+  // Largest size of 'tableAllocation_' in bytes.
+  int64_t peakTableBytes_{0};
   HashMode hashMode_ = HashMode::kArray;
   // Owns the memory of multiple build side hash join tables that are
   // combined into a single probe hash table.
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/HashTableCache.h"
+
+namespace facebook::velox::exec {
+namespace {
+// Keeps the memory pools of a shared table alive until the table is freed.
+struct TableWithPools {
+  std::vector<std::shared_ptr<memory::MemoryPool>> pools;
+  // Declared after 'pools' to be destroyed first.
+  std::shared_ptr<BaseHashTable> table;
+};
+} // namespace
+
+void HashTableCache::Entry::setTable(
+    std::shared_ptr<BaseHashTable> table,
+    std::vector<std::shared_ptr<memory::MemoryPool>> pools,
+    bool hasNullKeys) {
+  VELOX_CHECK_NOT_NULL(table);
+  // The users of the table may outlive the building task and this entry.
+  auto holder = std::make_shared<TableWithPools>();
+  holder->pools = std::move(pools);
+  holder->table = std::move(table);
+  table = std::shared_ptr<BaseHashTable>(holder, holder->table.get());
+
+  std::vector<std::weak_ptr<HashJoinBridge>> waiters;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK_NULL(table_, "Hash table of {} is already set", key_);
+    VELOX_CHECK(!cancelled_, "Hash table build of {} is cancelled", key_);
+    table_ = table;
+    hasNullKeys_ = hasNullKeys;
+    waiters = std::move(waiters_);
+  }
+  for (auto& waiter : waiters) {
+    if (auto bridge = waiter.lock()) {
+      bridge->setHashTable(table, {}, hasNullKeys);
+    }
+  }
+}
+
+void HashTableCache::Entry::addWaiter(std::weak_ptr<HashJoinBridge> bridge) {
+  std::shared_ptr<BaseHashTable> table;
+  bool hasNullKeys;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!cancelled_ && table_ == nullptr) {
+      waiters_.push_back(std::move(bridge));
+      return;
+    }
+    table = table_;
+    hasNullKeys = hasNullKeys_;
+  }
+  auto lockedBridge = bridge.lock();
+  if (lockedBridge == nullptr) {
+    return;
+  }
+  if (table == nullptr) {
+    lockedBridge->cancel();
+  } else {
+    lockedBridge->setHashTable(std::move(table), {}, hasNullKeys);
+  }
+}
+
+void HashTableCache::Entry::cancel() {
+  std::vector<std::weak_ptr<HashJoinBridge>> waiters;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (table_ != nullptr || cancelled_) {
+      return;
+    }
+    cancelled_ = true;
+    waiters = std::move(waiters_);
+  }
+  for (auto& waiter : waiters) {
+    if (auto bridge = waiter.lock()) {
+      bridge->cancel();
+    }
+  }
+}
+
+// static
+HashTableCache* HashTableCache::getInstance() {
+  static HashTableCache instance;
+  return &instance;
+}
+
+std::shared_ptr<HashTableCache::Entry> HashTableCache::acquire(
+    const std::string& queryId,
+    const core::PlanNodeId& planNodeId,
+    const std::string& taskId) {
+  auto key = fmt::format("{}:{}", queryId, planNodeId);
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& cached = entries_[key];
+  if (cached.entry == nullptr) {
+    cached.entry = std::make_shared<Entry>(key, taskId);
+  }
+  ++cached.numUsers;
+  return cached.entry;
+}
+
+void HashTableCache::release(
+    const std::shared_ptr<Entry>& entry,
+    const std::string& taskId) {
+  VELOX_CHECK_NOT_NULL(entry);
+  if (entry->isBuilder(taskId)) {
+    entry->cancel();
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(entry->key());
+  VELOX_CHECK(
+      it != entries_.end() && it->second.entry == entry,
+      "Releasing unknown hash table cache entry {}",
+      entry->key());
+  if (--it->second.numUsers == 0) {
+    entries_.erase(it);
+  }
+}
+} // namespace facebook::velox::exec
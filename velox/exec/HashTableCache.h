@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/HashJoinBridge.h"
+
+namespace facebook::velox::exec {
+
+/// Process wide registry of hash join tables shared by the tasks of a query.
+/// Used for joins with core::HashJoinNode::useHashTableCache() set, where every
+/// task has the same build side input, e.g. broadcast joins. The first task to
+/// reach the join builds the table. The other tasks drop their build input and
+/// get the built table through their HashJoinBridge. The table memory is
+/// charged to the memory pools of the building task only.
+class HashTableCache {
+ public:
+  /// The shared table of one join of one query.
+  class Entry {
+   public:
+    Entry(std::string key, std::string builderTaskId)
+        : key_(std::move(key)), builderTaskId_(std::move(builderTaskId)) {}
+
+    const std::string& key() const {
+      return key_;
+    }
+
+    /// Returns true if 'taskId' builds the table.
+    bool isBuilder(const std::string& taskId) const {
+      return taskId == builderTaskId_;
+    }
+
+    /// Invoked by the building task with the built 'table'. 'pools' are the
+    /// memory pools the table is allocated from. These are kept alive for as
+    /// long as the table is used by any task, which may be after the building
+    /// task has finished. Hands the table to the join bridges added by
+    /// addWaiter().
+    void setTable(
+        std::shared_ptr<BaseHashTable> table,
+        std::vector<std::shared_ptr<memory::MemoryPool>> pools,
+        bool hasNullKeys);
+
+    /// Sets the table on 'bridge' when it is built or right away if it already
+    /// is. Cancels 'bridge' if the build has failed.
+    void addWaiter(std::weak_ptr<HashJoinBridge> bridge);
+
+    /// Invoked if the building task stops before setting the table. Cancels
+    /// the waiting join bridges.
+    void cancel();
+
+    bool hasTable() const {
+      std::lock_guard<std::mutex> l(mutex_);
+      return table_ != nullptr;
+    }
+
+   private:
+    const std::string key_;
+    const std::string builderTaskId_;
+
+    mutable std::mutex mutex_;
+    // Owns the memory pools passed to setTable().
+    std::shared_ptr<BaseHashTable> table_;
+    bool hasNullKeys_{false};
+    bool cancelled_{false};
+    std::vector<std::weak_ptr<HashJoinBridge>> waiters_;
+  };
+
+  static HashTableCache* getInstance();
+
+  /// Returns the entry for the join 'planNodeId' of 'queryId' and registers a
+  /// user of it. Creates the entry with 'taskId' as the building task if there
+  /// is none. Each call must be matched by a call to release().
+  std::shared_ptr<Entry> acquire(
+      const std::string& queryId,
+      const core::PlanNodeId& planNodeId,
+      const std::string& taskId);
+
+  /// Unregisters a user from 'taskId' of 'entry'. Cancels the entry if the
+  /// building task releases it before setting the table. Drops the entry from
+  /// the cache after the last user releases it.
+  void release(const std::shared_ptr<Entry>& entry, const std::string& taskId);
+
+  size_t numEntries() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  struct CachedEntry {
+    std::shared_ptr<Entry> entry;
+    int32_t numUsers{0};
+  };
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, CachedEntry> entries_;
+};
+} // namespace facebook::velox::exec
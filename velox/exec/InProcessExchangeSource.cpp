@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/InProcessExchangeSource.h"
+
+#include <folly/executors/InlineExecutor.h>
+#include <folly/futures/Future.h>
+
+#include "velox/exec/OutputBufferManager.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+// Owner of a buffer allocated by copyToPool(). Returned to 'pool' when the
+// IOBuf wrapping the buffer is destroyed.
+struct PoolBuffer {
+  std::shared_ptr<memory::MemoryPool> pool;
+  uint64_t size;
+};
+
+void freePoolBuffer(void* buffer, void* userData) {
+  auto* owner = static_cast<PoolBuffer*>(userData);
+  owner->pool->free(buffer, owner->size);
+  delete owner;
+}
+
+std::shared_ptr<OutputBufferManager> outputBufferManager() {
+  auto buffers = OutputBufferManager::getInstance().lock();
+  VELOX_CHECK_NOT_NULL(buffers, "invalid OutputBufferManager");
+  return buffers;
+}
+} // namespace
+
+InProcessExchangeSource::InProcessExchangeSource(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool)
+    : ExchangeSource(taskId, destination, std::move(queue), pool),
+      producerTaskId_(taskId.substr(kScheme.size())) {
+  VELOX_CHECK(
+      taskId.compare(0, kScheme.size(), kScheme) == 0,
+      "Invalid in-process exchange task ID: {}",
+      taskId);
+}
+
+// static
+std::shared_ptr<ExchangeSource> InProcessExchangeSource::create(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  if (taskId.compare(0, kScheme.size(), kScheme) != 0) {
+    return nullptr;
+  }
+  return std::make_shared<InProcessExchangeSource>(
+      taskId, destination, std::move(queue), pool);
+}
+
+bool InProcessExchangeSource::shouldRequestLocked() {
+  if (atEnd_) {
+    return false;
+  }
+  return !requestPending_.exchange(true);
+}
+
+folly::SemiFuture<ExchangeSource::Response> InProcessExchangeSource::request(
+    uint32_t maxBytes,
+    std::chrono::microseconds maxWait) {
+  VELOX_CHECK(requestPending_);
+  auto buffers = outputBufferManager();
+
+  auto promise = VeloxPromise<Response>("InProcessExchangeSource::request");
+  auto future = promise.getSemiFuture();
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    promise_ = std::move(promise);
+  }
+
+  // Shared by the data callback and the timeout. The callbacks may outlive
+  // 'this' so they hold a shared reference to it.
+  auto done = std::make_shared<std::atomic_bool>(false);
+  auto self =
+      std::static_pointer_cast<InProcessExchangeSource>(shared_from_this());
+  const auto requestedSequence = sequence_;
+
+  folly::futures::sleep(maxWait)
+      .via(&folly::InlineExecutor::instance())
+      .thenValue([self, done, requestedSequence](auto&& /*unused*/) {
+        self->processData(done, requestedSequence, {}, requestedSequence, {});
+      });
+
+  // If the producer buffer does not exist yet, the timeout above responds
+  // with no data and ExchangeClient retries.
+  buffers->getData(
+      producerTaskId_,
+      destination_,
+      maxBytes,
+      requestedSequence,
+      [self, done, requestedSequence](
+          std::vector<std::unique_ptr<folly::IOBuf>> data,
+          int64_t sequence,
+          std::vector<int64_t> remainingBytes) {
+        self->processData(
+            done,
+            requestedSequence,
+            std::move(data),
+            sequence,
+            std::move(remainingBytes));
+      });
+  return future;
+}
+
+folly::SemiFuture<ExchangeSource::Response>
+InProcessExchangeSource::requestDataSizes(std::chrono::microseconds maxWait) {
+  return request(0, maxWait);
+}
+
+void InProcessExchangeSource::processData(
+    const std::shared_ptr<std::atomic_bool>& done,
+    int64_t requestedSequence,
+    std::vector<std::unique_ptr<folly::IOBuf>> data,
+    int64_t sequence,
+    std::vector<int64_t> remainingBytes) {
+  if (done->exchange(true)) {
+    return;
+  }
+
+  if (requestedSequence > sequence && !data.empty()) {
+    const int64_t numExtra = requestedSequence - sequence;
+    VELOX_CHECK_LT(numExtra, data.size());
+    data.erase(data.begin(), data.begin() + numExtra);
+    sequence = requestedSequence;
+  }
+  if (data.empty()) {
+    sequence = requestedSequence;
+  }
+
+  std::vector<std::unique_ptr<SerializedPage>> pages;
+  bool atEnd = false;
+  int64_t totalBytes = 0;
+  try {
+    for (auto& inputPage : data) {
+      if (inputPage == nullptr) {
+        atEnd = true;
+        // Keep looping, there could be extra end markers.
+        continue;
+      }
+      auto page = copyToPool(*inputPage);
+      inputPage.reset();
+      totalBytes += page->length();
+      pages.push_back(std::make_unique<SerializedPage>(std::move(page)));
+    }
+  } catch (const std::exception& e) {
+    queue_->setError(e.what());
+    checkSetRequestPromise();
+    return;
+  }
+  numPages_ += pages.size();
+  totalBytes_ += totalBytes;
+
+  int64_t ackSequence;
+  VeloxPromise<Response> requestPromise;
+  {
+    std::vector<ContinuePromise> queuePromises;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      requestPending_ = false;
+      requestPromise = std::move(promise_);
+      for (auto& page : pages) {
+        queue_->enqueueLocked(std::move(page), queuePromises);
+      }
+      if (atEnd) {
+        queue_->enqueueLocked(nullptr, queuePromises);
+        atEnd_ = true;
+      }
+      if (!data.empty()) {
+        ackSequence = sequence_ = sequence + pages.size();
+      }
+    }
+    for (auto& promise : queuePromises) {
+      promise.setValue();
+    }
+  }
+
+  // Outside of queue mutex. The pages have been copied, so the producer can
+  // release them right away.
+  if (auto buffers = OutputBufferManager::getInstance().lock()) {
+    if (atEnd_) {
+      buffers->deleteResults(producerTaskId_, destination_);
+    } else if (!data.empty()) {
+      buffers->acknowledge(producerTaskId_, destination_, ackSequence);
+    }
+  }
+
+  if (requestPromise.valid() && !requestPromise.isFulfilled()) {
+    requestPromise.setValue(Response{totalBytes, atEnd_, remainingBytes});
+  }
+}
+
+std::unique_ptr<folly::IOBuf> InProcessExchangeSource::copyToPool(
+    const folly::IOBuf& iobuf) const {
+  const auto size = iobuf.computeChainDataLength();
+  if (size == 0) {
+    return folly::IOBuf::create(0);
+  }
+  auto* buffer = static_cast<uint8_t*>(pool_->allocate(size));
+  uint64_t offset = 0;
+  for (const auto& range : iobuf) {
+    std::memcpy(buffer + offset, range.data(), range.size());
+    offset += range.size();
+  }
+  return folly::IOBuf::takeOwnership(
+      buffer, size, freePoolBuffer, new PoolBuffer{pool_, size});
+}
+
+void InProcessExchangeSource::checkSetRequestPromise() {
+  VeloxPromise<Response> promise;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    requestPending_ = false;
+    promise = std::move(promise_);
+  }
+  if (promise.valid() && !promise.isFulfilled()) {
+    promise.setValue(Response{0, false, {}});
+  }
+}
+
+void InProcessExchangeSource::close() {
+  checkSetRequestPromise();
+  if (auto buffers = OutputBufferManager::getInstance().lock()) {
+    buffers->deleteResults(producerTaskId_, destination_);
+  }
+}
+
+folly::F14FastMap<std::string, RuntimeMetric>
+InProcessExchangeSource::metrics() const {
+  return {
+      {"inProcessExchangeSource.numPages", RuntimeMetric(numPages_)},
+      {"inProcessExchangeSource.totalBytes",
+       RuntimeMetric(totalBytes_, RuntimeCounter::Unit::kBytes)},
+  };
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/ExchangeSource.h"
+
+namespace facebook::velox::exec {
+
+/// ExchangeSource that fetches pages directly from the OutputBufferManager of
+/// the current process. Used when the producer and the consumer tasks run on
+/// the same worker, so that pages skip the HTTP round trip. A remote task id
+/// of the form 'inproc://<producer task id>' selects this source.
+///
+/// Pages are copied once into memory allocated from the consumer's pool, so
+/// that the queued data is accounted against the consuming query and the
+/// producer can release its buffer as soon as the pages are acknowledged.
+/// Flow control is provided by ExchangeClient through 'maxBytes' and the
+/// remaining bytes reported by the producer buffer.
+class InProcessExchangeSource : public ExchangeSource {
+ public:
+  static constexpr std::string_view kScheme{"inproc://"};
+
+  InProcessExchangeSource(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  /// Factory to pass to ExchangeSource::registerFactory(). Returns nullptr if
+  /// 'taskId' does not start with kScheme.
+  static std::shared_ptr<ExchangeSource> create(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  bool supportsMetrics() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override;
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds maxWait) override;
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds maxWait) override;
+
+  void close() override;
+
+  folly::F14FastMap<std::string, RuntimeMetric> metrics() const override;
+
+ private:
+  // Copies the possibly chained 'iobuf' into a single buffer allocated from
+  // 'pool_'. The returned IOBuf frees the buffer back to 'pool_' when
+  // destroyed.
+  std::unique_ptr<folly::IOBuf> copyToPool(const folly::IOBuf& iobuf) const;
+
+  // Handles the result of getData() or the expiry of the request timeout.
+  // 'done' is shared between the two so that only the first has an effect.
+  void processData(
+      const std::shared_ptr<std::atomic_bool>& done,
+      int64_t requestedSequence,
+      std::vector<std::unique_ptr<folly::IOBuf>> data,
+      int64_t sequence,
+      std::vector<int64_t> remainingBytes);
+
+  // Fulfills the pending request promise, if any, with an empty response.
+  void checkSetRequestPromise();
+
+  // ID of the producer task in OutputBufferManager, i.e. 'taskId_' without
+  // kScheme.
+  const std::string producerTaskId_;
+
+  VeloxPromise<Response> promise_{VeloxPromise<Response>::makeEmpty()};
+
+  std::atomic<int64_t> numPages_{0};
+  std::atomic<int64_t> totalBytes_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -29,28 +29,34 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  hasPromises_ = true;
+  // A consumer may have made room since the increase above.
+  if (bufferedBytes_ < maxBufferSize_) {
+    hasPromises_ = !promises_.empty();
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
   std::vector<ContinuePromise> promises;
-  {
-    std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
+  if (bufferedBytes_.fetch_sub(removed) - removed >= maxBufferSize_ ||
+      !hasPromises_) {
+    return promises;
+  }
 
-    if (bufferedBytes_ < maxBufferSize_) {
-      promises = std::move(promises_);
-    }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (bufferedBytes_ < maxBufferSize_) {
+    promises = std::move(promises_);
+    hasPromises_ = false;
   }
   return promises;
 }
@@ -78,7 +84,7 @@ void LocalExchangeQueue::noMoreProducers() {
 BlockingReason LocalExchangeQueue::enqueue(
     RowVectorPtr input,
     ContinueFuture* future) {
-  auto inputBytes = input->estimateFlatSize();
+  const auto inputBytes = input->estimateFlatSize();
 
   std::vector<ContinuePromise> consumerPromises;
   bool blockedOnConsumer = false;
@@ -86,7 +92,7 @@ BlockingReason LocalExchangeQueue::enqueue(
     if (closed_) {
       return true;
     }
-    queue.push(std::move(input));
+    queue.push({std::move(input), inputBytes});
     consumerPromises = std::move(consumerPromises_);
 
     if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
@@ -125,7 +131,7 @@ BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
-  std::vector<ContinuePromise> memoryPromises;
+  int64_t dataBytes{0};
   auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
     if (queue.empty()) {
@@ -139,20 +145,21 @@ BlockingReason LocalExchangeQueue::next(
       return BlockingReason::kWaitForProducer;
     }
 
-    *data = queue.front();
+    *data = std::move(queue.front().vector);
+    dataBytes = queue.front().bytes;
     queue.pop();
 
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
-
     return BlockingReason::kNotBlocked;
   });
-  notify(memoryPromises);
+  if (*data != nullptr) {
+    auto memoryPromises = memoryManager_->decreaseMemoryUsage(dataBytes);
+    notify(memoryPromises);
+  }
   return blockingReason;
 }
 
 bool LocalExchangeQueue::isFinishedLocked(
-    const std::queue<RowVectorPtr>& queue) const {
+    const std::queue<QueuedVector>& queue) const {
   if (closed_) {
     return true;
   }
@@ -174,7 +181,7 @@ void LocalExchangeQueue::close() {
   queue_.withWLock([&](auto& queue) {
     uint64_t freedBytes = 0;
     while (!queue.empty()) {
-      freedBytes += queue.front()->estimateFlatSize();
+      freedBytes += queue.front().bytes;
       queue.pop();
     }
 
@@ -21,7 +21,8 @@
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. The size is updated without locking. The mutex is only
+/// taken when the size is at or over the limit or producers are waiting.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -38,8 +39,13 @@ class LocalExchangeMemoryManager {
 
  private:
   const int64_t maxBufferSize_;
+  std::atomic<int64_t> bufferedBytes_{0};
+  // True if 'promises_' may be non-empty. Set before checking 'bufferedBytes_'
+  // under 'mutex_' by producers, checked after updating 'bufferedBytes_' by
+  // consumers, so that either the producer sees the decrease or the consumer
+  // sees the waiting producer.
+  std::atomic<bool> hasPromises_{false};
   std::mutex mutex_;
-  int64_t bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -89,11 +95,18 @@ class LocalExchangeQueue {
   void close();
 
  private:
-  bool isFinishedLocked(const std::queue<RowVectorPtr>& queue) const;
+  // A vector and its size as accounted in 'memoryManager_'. The size is
+  // computed once by the producer outside of the queue lock.
+  struct QueuedVector {
+    RowVectorPtr vector;
+    int64_t bytes;
+  };
+
+  bool isFinishedLocked(const std::queue<QueuedVector>& queue) const;
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
-  folly::Synchronized<std::queue<RowVectorPtr>> queue_;
+  folly::Synchronized<std::queue<QueuedVector>> queue_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
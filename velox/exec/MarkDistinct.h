@@ -16,11 +16,20 @@
 
 #pragma once
 
-#include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
 
+/// Appends a boolean column that is true for the first row of each distinct
+/// combination of the distinct keys. Keeps the distinct keys seen so far in a
+/// group-by hash table, which uses the same array, normalized key and hash
+/// modes as RowNumber. Under memory pressure, spills the table by hash
+/// partition and from then on spills the input by the same partitions. After
+/// all input is received, restores one partition of the table at a time and
+/// marks the spilled input of that partition. The output order is not the
+/// input order after spilling.
 class MarkDistinct : public Operator {
  public:
   MarkDistinct(
@@ -29,7 +38,7 @@ class MarkDistinct : public Operator {
       const std::shared_ptr<const core::MarkDistinctNode>& planNode);
 
   bool preservesOrder() const override {
-    return true;
+    return !spillEnabled();
   }
 
   bool needsInput() const override {
@@ -38,6 +47,8 @@ class MarkDistinct : public Operator {
 
   void addInput(RowVectorPtr input) override;
 
+  void noMoreInput() override;
+
   RowVectorPtr getOutput() override;
 
   BlockingReason isBlocked(ContinueFuture* /*future*/) override {
@@ -46,8 +57,53 @@ class MarkDistinct : public Operator {
 
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
-  // TODO: Document spilling configuration in spilling.rst.
-  std::unique_ptr<GroupingSet> groupingSet_;
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  // Probes the rows of 'input_' into 'table_'. The new groups of 'lookup_'
+  // are the rows to mark distinct.
+  void probeInput(int8_t spillInputStartPartitionBit);
+
+  void ensureInputFits(const RowVectorPtr& input);
+
+  void spill();
+
+  SpillPartitionNumSet spillHashTable();
+
+  void setupInputSpiller(const SpillPartitionNumSet& spillPartitionSet);
+
+  void spillInput(const RowVectorPtr& input, memory::MemoryPool* pool);
+
+  // Restores the table of the next spilled partition and reads the first
+  // batch of its spilled input into 'input_'.
+  void restoreNextSpillPartition();
+
+  // Distinct keys seen so far.
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+
+  RowTypePtr inputType_;
+
+  // The spill partition bits used by both hash table content spill and input
+  // data spill.
+  HashBitRange spillPartitionBits_;
+
+  SpillPartitionSet spillHashTablePartitionSet_;
+
+  // Spiller for input received after spilling has been triggered.
+  std::unique_ptr<Spiller> inputSpiller_;
+
+  // Used to restore previously spilled input.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
+
+  SpillPartitionSet spillInputPartitionSet_;
+
+  // Used to calculate the spill partition numbers of the inputs.
+  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
 };
 } // namespace facebook::velox::exec
@@ -16,6 +16,7 @@
 
 #include "velox/exec/Merge.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/OrderBy.h"
 #include "velox/exec/Task.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -53,6 +54,20 @@ Merge::Merge(
             sortingOrders[i].isAscending(),
             false});
   }
+
+  std::vector<TypePtr> keyTypes;
+  std::vector<CompareFlags> compareFlags;
+  for (const auto& [channel, flags] : sortingKeys_) {
+    keyTypes.push_back(outputType_->childAt(channel));
+    compareFlags.push_back(flags);
+  }
+  auto layout = PrefixSortLayout::makeSortLayout(
+      keyTypes,
+      compareFlags,
+      driverCtx->queryConfig().prefixSortNormalizedKeyMaxBytes());
+  if (!layout.noNormalizedKeys) {
+    prefixSortLayout_.emplace(std::move(layout));
+  }
 }
 
 void Merge::initializeTreeOfLosers() {
@@ -60,7 +75,10 @@ void Merge::initializeTreeOfLosers() {
   sourceCursors.reserve(sources_.size());
   for (auto& source : sources_) {
     sourceCursors.push_back(std::make_unique<SourceStream>(
-        source.get(), sortingKeys_, outputBatchSize_));
+        source.get(),
+        sortingKeys_,
+        prefixSortLayout_.has_value() ? &prefixSortLayout_.value() : nullptr,
+        outputBatchSize_));
   }
 
   // Save the pointers to cursors before moving these into the TreeOfLosers.
@@ -88,8 +106,9 @@ BlockingReason Merge::isBlocked(ContinueFuture* future) {
     return BlockingReason::kNotBlocked;
   }
 
-  // No merging is needed if there is only one source.
-  if (streams_.empty() && sources_.size() > 1) {
+  // No merging is needed if there is only one source or the sources are
+  // concatenated.
+  if (streams_.empty() && sources_.size() > 1 && !concatenateSources_) {
     initializeTreeOfLosers();
   }
 
@@ -118,17 +137,8 @@ RowVectorPtr Merge::getOutput() {
   }
 
   // No merging is needed if there is only one source.
-  if (sources_.size() == 1) {
-    ContinueFuture future;
-    RowVectorPtr data;
-    auto reason = sources_[0]->next(data, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      sourceBlockingFutures_.emplace_back(std::move(future));
-      return nullptr;
-    }
-
-    finished_ = data == nullptr;
-    return data;
+  if (sources_.size() == 1 || concatenateSources_) {
+    return nextConcatenated();
   }
 
   if (!output_) {
@@ -181,6 +191,24 @@ RowVectorPtr Merge::getOutput() {
   }
 }
 
+RowVectorPtr Merge::nextConcatenated() {
+  while (currentSource_ < sources_.size()) {
+    ContinueFuture future;
+    RowVectorPtr data;
+    auto reason = sources_[currentSource_]->next(data, &future);
+    if (reason != BlockingReason::kNotBlocked) {
+      sourceBlockingFutures_.emplace_back(std::move(future));
+      return nullptr;
+    }
+    if (data != nullptr) {
+      return data;
+    }
+    ++currentSource_;
+  }
+  finished_ = true;
+  return nullptr;
+}
+
 void Merge::close() {
   for (auto& source : sources_) {
     source->close();
@@ -189,7 +217,18 @@ void Merge::close() {
 
 bool SourceStream::operator<(const MergeStream& other) const {
   const auto& otherCursor = static_cast<const SourceStream&>(other);
-  for (auto i = 0; i < sortingKeys_.size(); ++i) {
+  uint32_t firstKey = 0;
+  if (prefixSortLayout_ != nullptr) {
+    if (auto result = comparePrefixes(otherCursor)) {
+      return result < 0;
+    }
+    if (!prefixSortLayout_->hasNonNormalizedKey) {
+      return false;
+    }
+    // Equal prefixes of a string key may come from different strings.
+    firstKey = prefixSortLayout_->numNormalizedKeys;
+  }
+  for (auto i = firstKey; i < sortingKeys_.size(); ++i) {
     const auto& [_, compareFlags] = sortingKeys_[i];
     VELOX_DCHECK(
         compareFlags.nullAsValue(), "not supported null handling mode");
@@ -263,10 +302,71 @@ bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
     for (const auto& key : sortingKeys_) {
       keyColumns_.push_back(data_->childAt(key.first).get());
     }
+    if (prefixSortLayout_ != nullptr) {
+      encodePrefixes();
+    }
   }
   return false;
 }
 
+template <typename T>
+void SourceStream::encodePrefixColumn(
+    const prefixsort::PrefixSortEncoder& encoder,
+    uint32_t offset) {
+  auto* prefix = reinterpret_cast<char*>(prefixes_.data()) + offset;
+  const auto rowBytes = numPrefixWords_ * sizeof(uint64_t);
+  for (auto row = 0; row < data_->size(); ++row, prefix += rowBytes) {
+    std::optional<T> value;
+    if (!decodedKey_.isNullAt(row)) {
+      value = decodedKey_.valueAt<T>(row);
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      encoder.encodeStringPrefix(value, prefix);
+    } else {
+      encoder.encode(value, prefix);
+    }
+  }
+}
+
+void SourceStream::encodePrefixes() {
+  const auto numRows = data_->size();
+  // Zeros the padding after the last key.
+  prefixes_.assign(numRows * numPrefixWords_, 0);
+  const auto& encoders = prefixSortLayout_->encoders;
+  for (auto i = 0; i < encoders.size(); ++i) {
+    decodedKey_.decode(*keyColumns_[i]);
+    const auto offset = prefixSortLayout_->prefixOffsets[i];
+    switch (keyColumns_[i]->typeKind()) {
+      case TypeKind::INTEGER:
+        encodePrefixColumn<int32_t>(encoders[i], offset);
+        break;
+      case TypeKind::BIGINT:
+        encodePrefixColumn<int64_t>(encoders[i], offset);
+        break;
+      case TypeKind::REAL:
+        encodePrefixColumn<float>(encoders[i], offset);
+        break;
+      case TypeKind::DOUBLE:
+        encodePrefixColumn<double>(encoders[i], offset);
+        break;
+      case TypeKind::TIMESTAMP:
+        encodePrefixColumn<Timestamp>(encoders[i], offset);
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        encodePrefixColumn<StringView>(encoders[i], offset);
+        break;
+      default:
+        VELOX_UNREACHABLE(
+            "Unexpected prefix key type: {}",
+            keyColumns_[i]->type()->toString());
+    }
+  }
+  for (auto& word : prefixes_) {
+    word = __builtin_bswap64(word);
+  }
+}
+
 LocalMerge::LocalMerge(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -283,6 +383,15 @@ LocalMerge::LocalMerge(
       operatorCtx_->driverCtx()->driverId,
       0,
       "LocalMerge needs to run single-threaded");
+  // The drivers of a range sort output consecutive key ranges in the order of
+  // their partition ids, which is the order of the merge sources.
+  if (localMergeNode->sources().size() == 1) {
+    if (auto orderBy = std::dynamic_pointer_cast<const core::OrderByNode>(
+            localMergeNode->sources()[0])) {
+      concatenateSources_ = OrderBy::isRangeSort(
+          *orderBy, operatorCtx_->driverCtx()->queryConfig());
+    }
+  }
 }
 
 BlockingReason LocalMerge::addMergeSources(ContinueFuture* /* future */) {
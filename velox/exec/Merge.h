@@ -17,6 +17,7 @@
 
 #include "velox/exec/Exchange.h"
 #include "velox/exec/MergeSource.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/TreeOfLosers.h"
 
 namespace facebook::velox::exec {
@@ -55,14 +56,29 @@ class Merge : public SourceOperator {
 
   std::vector<std::shared_ptr<MergeSource>> sources_;
 
+  /// True if the sources hold consecutive key ranges in source order. The
+  /// sources are then read one after the other without merging.
+  bool concatenateSources_{false};
+
  private:
   void initializeTreeOfLosers();
 
+  /// Returns the next batch of the sources read one after the other.
+  RowVectorPtr nextConcatenated();
+
+  /// Index in 'sources_' of the source read by nextConcatenated().
+  size_t currentSource_{0};
+
   /// Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
 
   std::vector<std::pair<column_index_t, CompareFlags>> sortingKeys_;
 
+  /// Layout of the normalized prefix of the leading sorting keys the streams
+  /// compare before the key columns. Not set if the first key can't be
+  /// normalized.
+  std::optional<PrefixSortLayout> prefixSortLayout_;
+
   /// A list of cursors over batches of ordered source data. One per source.
   /// Aligned with 'sources'.
   std::vector<SourceStream*> streams_;
@@ -84,12 +100,20 @@ class Merge : public SourceOperator {
 
 class SourceStream final : public MergeStream {
  public:
+  /// 'prefixSortLayout' is the layout of the normalized prefix of the
+  /// leading keys, or nullptr if the keys are compared one by one.
   SourceStream(
       MergeSource* source,
       const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+      const PrefixSortLayout* prefixSortLayout,
       uint32_t outputBatchSize)
       : source_{source},
         sortingKeys_{sortingKeys},
+        prefixSortLayout_{prefixSortLayout},
+        numPrefixWords_{
+            prefixSortLayout == nullptr
+                ? 0
+                : prefixSortLayout->normalizedBufferSize / sizeof(uint64_t)},
         outputRows_(outputBatchSize, false),
         sourceRows_(outputBatchSize) {
     keyColumns_.reserve(sortingKeys.size());
@@ -136,10 +160,43 @@ class SourceStream final : public MergeStream {
  private:
   bool fetchMoreData(std::vector<ContinueFuture>& futures);
 
+  // Fills 'prefixes_' with the normalized prefix of each row of 'data_'.
+  void encodePrefixes();
+
+  template <typename T>
+  void encodePrefixColumn(
+      const prefixsort::PrefixSortEncoder& encoder,
+      uint32_t offset);
+
+  // Returns < 0, 0 or > 0 if the prefix of the current row is less than,
+  // equal to or greater than the prefix of the current row of 'other'.
+  int32_t comparePrefixes(const SourceStream& other) const {
+    const auto* left = prefixes_.data() + currentSourceRow_ * numPrefixWords_;
+    const auto* right =
+        other.prefixes_.data() + other.currentSourceRow_ * numPrefixWords_;
+    for (uint32_t i = 0; i < numPrefixWords_; ++i) {
+      if (left[i] != right[i]) {
+        return left[i] < right[i] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
   MergeSource* source_;
 
   const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys_;
 
+  const PrefixSortLayout* const prefixSortLayout_;
+
+  // Number of 64-bit words in the prefix of a row.
+  const uint32_t numPrefixWords_;
+
+  // 'numPrefixWords_' words per row of 'data_'. The words are byte swapped so
+  // that comparing them as integers compares the encoded bytes in order.
+  std::vector<uint64_t> prefixes_;
+
+  DecodedVector decodedKey_;
+
   /// Ordered source rows.
   RowVectorPtr data_;
 
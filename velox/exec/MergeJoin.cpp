@@ -191,6 +191,81 @@ int32_t MergeJoin::compare(
   return 0;
 }
 
+namespace {
+// Returns the first index in [begin, end) of sorted 'values' with a value not
+// less than, or if 'upper' is true greater than, 'value'. Gallops from 'begin'
+// in growing steps and binary searches the last step, so that a short skip
+// costs about as much as a linear scan and a long one is logarithmic.
+template <typename T, bool upper>
+vector_size_t
+gallop(const T* values, vector_size_t begin, vector_size_t end, T value) {
+  auto before = [value](T other) {
+    return upper ? other <= value : other < value;
+  };
+  if (begin >= end || !before(values[begin])) {
+    return begin;
+  }
+  // 'values[low]' is before 'value', the result is in (low, high].
+  vector_size_t low = begin;
+  vector_size_t high = end;
+  for (vector_size_t step = 1;; step *= 2) {
+    if (step >= end - low) {
+      break;
+    }
+    if (!before(values[low + step])) {
+      high = low + step;
+      break;
+    }
+    low += step;
+  }
+  return std::partition_point(values + low + 1, values + high, before) -
+      values;
+}
+
+template <typename T>
+std::optional<vector_size_t> findFlatKey(
+    const BaseVector& keys,
+    vector_size_t begin,
+    const BaseVector& valueKeys,
+    vector_size_t valueIndex,
+    bool upper) {
+  const auto* values = keys.asUnchecked<FlatVector<T>>()->rawValues();
+  const auto value =
+      valueKeys.asUnchecked<FlatVector<T>>()->valueAtFast(valueIndex);
+  return upper ? gallop<T, true>(values, begin, keys.size(), value)
+               : gallop<T, false>(values, begin, keys.size(), value);
+}
+} // namespace
+
+// static
+std::optional<vector_size_t> MergeJoin::findKey(
+    const RowVectorPtr& batch,
+    column_index_t key,
+    vector_size_t begin,
+    const RowVectorPtr& valueBatch,
+    column_index_t valueKey,
+    vector_size_t valueIndex,
+    bool upper) {
+  const auto& keys = *batch->childAt(key)->loadedVector();
+  const auto& valueKeys = *valueBatch->childAt(valueKey)->loadedVector();
+  if (!keys.isFlatEncoding() || !valueKeys.isFlatEncoding() ||
+      keys.mayHaveNulls() || valueKeys.mayHaveNulls()) {
+    return std::nullopt;
+  }
+  switch (keys.typeKind()) {
+    case TypeKind::BIGINT:
+      return findFlatKey<int64_t>(keys, begin, valueKeys, valueIndex, upper);
+    case TypeKind::INTEGER:
+      return findFlatKey<int32_t>(keys, begin, valueKeys, valueIndex, upper);
+    case TypeKind::SMALLINT:
+      return findFlatKey<int16_t>(keys, begin, valueKeys, valueIndex, upper);
+    case TypeKind::TINYINT:
+      return findFlatKey<int8_t>(keys, begin, valueKeys, valueIndex, upper);
+    default:
+      return std::nullopt;
+  }
+}
+
 bool MergeJoin::findEndOfMatch(
     Match& match,
     const RowVectorPtr& input,
@@ -205,6 +280,11 @@ bool MergeJoin::findEndOfMatch(
   auto numInput = input->size();
 
   vector_size_t endIndex = 0;
+  if (keys.size() == 1) {
+    endIndex =
+        findKey(input, keys[0], 0, prevInput, keys[0], prevIndex, true)
+            .value_or(0);
+  }
   while (endIndex < numInput &&
          compare(keys, input, endIndex, keys, prevInput, prevIndex) == 0) {
     ++endIndex;
@@ -593,6 +673,24 @@ RowVectorPtr MergeJoin::doGetOutput() {
 
   for (;;) {
     // Catch up input_ with rightInput_.
+    if (compareResult < 0 && !isLeftJoin(joinType_) && numKeys_ == 1) {
+      // An inner join skips all the rows before the right key at once.
+      if (auto next = findKey(
+              input_,
+              leftKeys_[0],
+              index_ + 1,
+              rightInput_,
+              rightKeys_[0],
+              rightIndex_,
+              false)) {
+        index_ = next.value();
+        if (index_ == input_->size()) {
+          input_ = nullptr;
+          return nullptr;
+        }
+        compareResult = compare();
+      }
+    }
     while (compareResult < 0) {
       if (isLeftJoin(joinType_)) {
         prepareOutput();
@@ -614,6 +712,23 @@ RowVectorPtr MergeJoin::doGetOutput() {
     }
 
     // Catch up rightInput_ with input_.
+    if (compareResult > 0 && numKeys_ == 1) {
+      if (auto next = findKey(
+              rightInput_,
+              rightKeys_[0],
+              rightIndex_ + 1,
+              input_,
+              leftKeys_[0],
+              index_,
+              false)) {
+        rightIndex_ = next.value();
+        if (rightIndex_ == rightInput_->size()) {
+          rightInput_ = nullptr;
+          return nullptr;
+        }
+        compareResult = compare();
+      }
+    }
     while (compareResult > 0) {
       rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
       if (rightIndex_ == rightInput_->size()) {
@@ -628,6 +743,17 @@ RowVectorPtr MergeJoin::doGetOutput() {
       // Found a match. Identify all rows on the left and right that have the
       // matching keys.
       vector_size_t endIndex = index_ + 1;
+      if (numKeys_ == 1) {
+        endIndex = findKey(
+                       input_,
+                       leftKeys_[0],
+                       endIndex,
+                       input_,
+                       leftKeys_[0],
+                       index_,
+                       true)
+                       .value_or(endIndex);
+      }
       while (endIndex < input_->size() && compareLeft(endIndex) == 0) {
         ++endIndex;
       }
@@ -640,6 +766,17 @@ RowVectorPtr MergeJoin::doGetOutput() {
           {input_}, index_, endIndex, endIndex < input_->size(), std::nullopt};
 
       vector_size_t endRightIndex = rightIndex_ + 1;
+      if (numKeys_ == 1) {
+        endRightIndex = findKey(
+                            rightInput_,
+                            rightKeys_[0],
+                            endRightIndex,
+                            rightInput_,
+                            rightKeys_[0],
+                            rightIndex_,
+                            true)
+                            .value_or(endRightIndex);
+      }
       while (endRightIndex < rightInput_->size() &&
              compareRight(endRightIndex) == 0) {
         ++endRightIndex;
@@ -63,6 +63,19 @@ class MergeJoin : public Operator {
       const RowVectorPtr& otherBatch,
       vector_size_t otherIndex);
 
+  // Returns the first row at or after 'begin' in 'batch' whose single join
+  // 'key' is not less than, or if 'upper' is true greater than, the key of row
+  // 'valueIndex' in 'valueBatch'. Returns std::nullopt unless both keys are
+  // flat integers without nulls. The caller then compares row by row.
+  static std::optional<vector_size_t> findKey(
+      const RowVectorPtr& batch,
+      column_index_t key,
+      vector_size_t begin,
+      const RowVectorPtr& valueBatch,
+      column_index_t valueKey,
+      vector_size_t valueIndex,
+      bool upper);
+
   // Compare rows on the left and right at index_ and rightIndex_ respectively.
   int32_t compare() const {
     return compare(
@@ -72,6 +72,14 @@ void NestedLoopJoinProbe::initialize() {
         joinNode_->joinCondition(),
         joinNode_->sources()[0]->outputType(),
         joinNode_->sources()[1]->outputType());
+    if (operatorCtx_->driverCtx()
+            ->queryConfig()
+            .nestedLoopJoinRangeIndexEnabled()) {
+      rangeJoinBounds_ = RangeJoinBounds::extract(
+          joinNode_->joinCondition(),
+          joinNode_->sources()[0]->outputType(),
+          joinNode_->sources()[1]->outputType());
+    }
   }
 
   joinNode_.reset();
@@ -104,6 +112,13 @@ BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
         }
       }
 
+      if (rangeJoinBounds_.has_value()) {
+        for (const auto& buildVector : buildVectors_.value()) {
+          rangeJoinIndices_.push_back(std::make_unique<RangeJoinIndex>(
+              rangeJoinBounds_.value(), *buildVector));
+        }
+      }
+
       setState(ProbeOperatorState::kRunning);
       return BlockingReason::kNotBlocked;
     }
@@ -117,6 +132,7 @@ void NestedLoopJoinProbe::close() {
     joinCondition_->clear();
   }
   buildVectors_.reset();
+  rangeJoinIndices_.clear();
   Operator::close();
 }
 
@@ -132,6 +148,10 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
   if (needsProbeMismatch(joinType_)) {
     probeMatched_.resizeFill(input_->size(), false);
   }
+  if (rangeJoinBounds_.has_value()) {
+    decodedRangeJoinProbe_.decode(
+        *input_->childAt(rangeJoinBounds_->probeChannel));
+  }
 }
 
 RowVectorPtr NestedLoopJoinProbe::getOutput() {
@@ -178,7 +198,9 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
       break;
     }
 
-    const vector_size_t probeCnt = getNumProbeRows();
+    const vector_size_t probeCnt = rangeJoinBounds_.has_value()
+        ? addRangeJoinPairs()
+        : getNumProbeRows();
     output = doMatch(probeCnt);
     if (advanceProbeRows(probeCnt)) {
       if (!needsProbeMismatch(joinType_)) {
@@ -408,6 +430,71 @@ RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
       pool(), outputType, nullptr, numOutputRows, std::move(projectedChildren));
 }
 
+vector_size_t NestedLoopJoinProbe::addRangeJoinPairs() {
+  VELOX_CHECK_NOT_NULL(input_);
+  VELOX_CHECK(!hasProbedAllBuildData());
+
+  const auto& index = *rangeJoinIndices_[buildIndex_];
+  const auto inputSize = input_->size();
+  // Each probe row adds at most index.size() pairs.
+  const vector_size_t maxPairs = outputBatchSize_ + index.size();
+  auto* rawProbeIndices =
+      initializeRowNumberMapping(probeIndices_, maxPairs, pool()).data();
+  auto* rawBuildIndices =
+      initializeRowNumberMapping(buildIndices_, maxPairs, pool()).data();
+  // 'buildIndices_' no longer holds the indices of a cross product.
+  numPrevProbedRows_ = 0;
+
+  numRangeJoinPairs_ = 0;
+  vector_size_t probeCnt = 0;
+  while (probeRow_ + probeCnt < inputSize &&
+         numRangeJoinPairs_ < outputBatchSize_) {
+    const auto row = probeRow_ + probeCnt++;
+    if (decodedRangeJoinProbe_.isNullAt(row)) {
+      continue;
+    }
+    index.forEachMatch(
+        RangeJoinIndex::valueAt(decodedRangeJoinProbe_, row),
+        [&](vector_size_t buildRow) {
+          rawProbeIndices[numRangeJoinPairs_] = row;
+          rawBuildIndices[numRangeJoinPairs_++] = buildRow;
+        });
+  }
+  stats_.wlock()->addRuntimeStat(
+      "rangeJoinPairs", RuntimeCounter(numRangeJoinPairs_));
+  return probeCnt;
+}
+
+RowVectorPtr NestedLoopJoinProbe::getRangeJoinPairs(
+    const RowTypePtr& outputType,
+    const std::vector<IdentityProjection>& probeProjections,
+    const std::vector<IdentityProjection>& buildProjections) {
+  if (numRangeJoinPairs_ == 0) {
+    return nullptr;
+  }
+
+  std::vector<VectorPtr> projectedChildren(outputType->size());
+  projectChildren(
+      projectedChildren,
+      input_,
+      probeProjections,
+      numRangeJoinPairs_,
+      probeIndices_);
+  projectChildren(
+      projectedChildren,
+      buildVectors_.value()[buildIndex_],
+      buildProjections,
+      numRangeJoinPairs_,
+      buildIndices_);
+
+  return std::make_shared<RowVector>(
+      pool(),
+      outputType,
+      nullptr,
+      numRangeJoinPairs_,
+      std::move(projectedChildren));
+}
+
 bool NestedLoopJoinProbe::advanceProbeRows(vector_size_t probeCnt) {
   probeRow_ += probeCnt;
   if (probeRow_ < input_->size()) {
@@ -431,11 +518,18 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
         probeCnt, outputType_, identityProjections_, buildProjections_);
   }
 
-  auto filterInput = getCrossProduct(
-      probeCnt,
-      filterInputType_,
-      filterProbeProjections_,
-      filterBuildProjections_);
+  auto filterInput = rangeJoinBounds_.has_value()
+      ? getRangeJoinPairs(
+            filterInputType_, filterProbeProjections_, filterBuildProjections_)
+      : getCrossProduct(
+            probeCnt,
+            filterInputType_,
+            filterProbeProjections_,
+            filterBuildProjections_);
+  if (filterInput == nullptr) {
+    // No build row is in range of the probe rows.
+    return nullptr;
+  }
 
   if (filterInputRows_.size() != filterInput->size()) {
     filterInputRows_.resizeFill(filterInput->size(), true);
@@ -18,6 +18,7 @@
 #include "velox/exec/NestedLoopJoinBuild.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/ProbeOperatorState.h"
+#include "velox/exec/RangeJoinIndex.h"
 
 namespace facebook::velox::exec {
 class NestedLoopJoinProbe : public Operator {
@@ -77,6 +78,19 @@ class NestedLoopJoinProbe : public Operator {
       const std::vector<IdentityProjection>& probeProjections,
       const std::vector<IdentityProjection>& buildProjections);
 
+  // Adds the pairs of the next probe rows and the rows of the build side vector
+  // at 'buildIndex_' that are in range of them by 'rangeJoinIndices_' to
+  // 'probeIndices_' and 'buildIndices_'. Stops after the output batch size of
+  // pairs. Returns the number of probe rows consumed.
+  vector_size_t addRangeJoinPairs();
+
+  // Projects the pairs of rows added by addRangeJoinPairs() like
+  // getCrossProduct(). Returns nullptr if there are none.
+  RowVectorPtr getRangeJoinPairs(
+      const RowTypePtr& outputType,
+      const std::vector<IdentityProjection>& probeProjections,
+      const std::vector<IdentityProjection>& buildProjections);
+
   // Evaluates joinCondition against the output of getCrossProduct(probeCnt),
   // returns the result that passed joinCondition, updates probeMatched_,
   // buildMatched_ accordingly.
@@ -147,6 +161,15 @@ class NestedLoopJoinProbe : public Operator {
   BufferPtr probeOutMapping_;
   BufferPtr probeIndices_;
 
+  // Set if the join condition bounds a probe column by build columns. The
+  // condition is then evaluated only for the pairs of rows in range.
+  std::optional<RangeJoinBounds> rangeJoinBounds_;
+  // The bounded probe column of 'input_'.
+  DecodedVector decodedRangeJoinProbe_;
+  // The number of pairs in 'probeIndices_' and 'buildIndices_' added by
+  // addRangeJoinPairs().
+  vector_size_t numRangeJoinPairs_{0};
+
   // Build side state
   std::optional<std::vector<RowVectorPtr>> buildVectors_;
   bool buildSideEmpty_{false};
@@ -155,6 +178,8 @@ class NestedLoopJoinProbe : public Operator {
   size_t buildIndex_{0};
   std::vector<IdentityProjection> buildProjections_;
   BufferPtr buildIndices_;
+  // The index of each vector of 'buildVectors_' by 'rangeJoinBounds_'.
+  std::vector<std::unique_ptr<RangeJoinIndex>> rangeJoinIndices_;
 
   // Represents whether probe build rows have been matched.
   std::vector<SelectivityVector> buildMatched_;
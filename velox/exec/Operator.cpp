@@ -147,6 +147,15 @@ void Operator::initialize() {
       pool()->name());
   initialized_ = true;
   maybeSetReclaimer();
+  const auto traceDir =
+      operatorCtx_->task()->operatorTraceDirectory(planNodeId());
+  if (!traceDir.empty()) {
+    inputTracer_ = std::make_unique<OperatorTraceWriter>(
+        traceDir,
+        operatorType(),
+        operatorCtx_->driverCtx()->pipelineId,
+        operatorCtx_->driverCtx()->driverId);
+  }
 }
 
 // static
@@ -604,6 +613,16 @@ bool Operator::MemoryReclaimer::reclaimableBytes(
   return op_->reclaimableBytes(reclaimableBytes);
 }
 
+uint64_t Operator::MemoryReclaimer::expectedGrowthBytes(
+    const memory::MemoryPool& pool) const {
+  std::shared_ptr<Driver> driver = ensureDriver();
+  if (FOLLY_UNLIKELY(driver == nullptr)) {
+    return 0;
+  }
+  VELOX_CHECK_EQ(pool.name(), op_->pool()->name());
+  return op_->expectedMemoryGrowth();
+}
+
 uint64_t Operator::MemoryReclaimer::reclaim(
     memory::MemoryPool* pool,
     uint64_t targetBytes,
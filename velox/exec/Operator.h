@@ -20,6 +20,7 @@
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/JoinBridge.h"
+#include "velox/exec/OperatorTrace.h"
 #include "velox/exec/Spiller.h"
 #include "velox/type/Filter.h"
 
@@ -159,6 +160,15 @@ struct OperatorStats {
 
   std::unordered_map<std::string, RuntimeMetric> runtimeStats;
 
+  /// Names of the runtime stats with the hardware counters of addInput and
+  /// getOutput calls. Recorded if
+  /// core::QueryConfig::operatorTrackPerfCounters() is set.
+  static constexpr const char* kPerfCycles = "perfCycles";
+  static constexpr const char* kPerfInstructions = "perfInstructions";
+  static constexpr const char* kPerfLlcMisses = "perfLlcMisses";
+  static constexpr const char* kPerfBackendStallCycles =
+      "perfBackendStallCycles";
+
   int numDrivers = 0;
 
   OperatorStats() {}
@@ -367,6 +377,15 @@ class Operator : public BaseRuntimeStatWriter {
   /// @param input Non-empty input vector.
   virtual void addInput(RowVectorPtr input) = 0;
 
+  /// Writes 'input' to the trace of the plan node of 'this' if
+  /// QueryConfig::operatorTraceNodeIds() lists it. Called by the Driver
+  /// before addInput().
+  void traceInput(const RowVectorPtr& input) {
+    if (FOLLY_UNLIKELY(inputTracer_ != nullptr)) {
+      inputTracer_->write(input);
+    }
+  }
+
   /// Informs 'this' that addInput will no longer be called. This means
   /// that any partial state kept by 'this' should be returned by
   /// the next call(s) to getOutput. Not used if operator is a source operator,
@@ -441,6 +460,10 @@ class Operator : public BaseRuntimeStatWriter {
     input_ = nullptr;
     results_.clear();
     recordSpillStats();
+    if (inputTracer_ != nullptr) {
+      inputTracer_->finish();
+      inputTracer_.reset();
+    }
     // Release the unused memory reservation on close.
     operatorCtx_->pool()->release();
   }
@@ -512,6 +535,14 @@ class Operator : public BaseRuntimeStatWriter {
       uint64_t targetBytes,
       memory::MemoryReclaimer::Stats& stats) {}
 
+  /// Returns the number of bytes this operator expects to allocate soon
+  /// beyond its current usage as set in 'expectedMemoryGrowth_'. Used by the
+  /// memory arbitrator to grow the query capacity ahead of the
+  /// allocation. May be called from a thread other than the driver's.
+  uint64_t expectedMemoryGrowth() const {
+    return expectedMemoryGrowth_;
+  }
+
   const core::PlanNodeId& planNodeId() const {
     return operatorCtx_->planNodeId();
   }
@@ -654,6 +685,9 @@ class Operator : public BaseRuntimeStatWriter {
         const memory::MemoryPool& pool,
         uint64_t& reclaimableBytes) const override;
 
+    uint64_t expectedGrowthBytes(
+        const memory::MemoryPool& pool) const override;
+
     uint64_t reclaim(
         memory::MemoryPool* pool,
         uint64_t targetBytes,
@@ -738,6 +772,10 @@ class Operator : public BaseRuntimeStatWriter {
   /// This only applies to a reclaimable operator.
   tsan_atomic<bool> nonReclaimableSection_{false};
 
+  /// The number of bytes this operator expects to allocate soon. See
+  /// expectedMemoryGrowth().
+  std::atomic_uint64_t expectedMemoryGrowth_{0};
+
   /// Holds the last data from addInput until it is processed. Reset after the
   /// input is processed.
   RowVectorPtr input_;
@@ -755,6 +793,9 @@ class Operator : public BaseRuntimeStatWriter {
 
   std::unordered_map<column_index_t, std::shared_ptr<common::Filter>>
       dynamicFilters_;
+
+  // Writes the input to the trace directory if the plan node is traced.
+  std::unique_ptr<OperatorTraceWriter> inputTracer_;
 };
 
 /// Given a row type returns indices for the specified subset of columns.
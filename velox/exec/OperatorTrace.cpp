@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/OperatorTrace.h"
+
+#include <folly/json.h>
+#include <algorithm>
+#include <sstream>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/vector/VectorSaver.h"
+
+namespace facebook::velox::exec {
+namespace {
+const char* const kSummaryFileName = "summary.json";
+const char* const kDataFileSuffix = ".data";
+
+std::string fileName(const std::string& path) {
+  const auto pos = path.rfind('/');
+  return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+bool endsWith(const std::string& value, const std::string& suffix) {
+  return value.size() >= suffix.size() &&
+      value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+std::string readFile(const std::string& path) {
+  auto file = filesystems::getFileSystem(path, nullptr)->openFileForRead(path);
+  return file->pread(0, file->size());
+}
+
+RowVectorPtr loadLazyColumns(const RowVectorPtr& input) {
+  const auto& children = input->children();
+  if (std::none_of(children.begin(), children.end(), [](const auto& child) {
+        return isLazyNotLoaded(*child);
+      })) {
+    return input;
+  }
+  std::vector<VectorPtr> loadedChildren;
+  loadedChildren.reserve(children.size());
+  for (const auto& child : children) {
+    loadedChildren.push_back(BaseVector::loadedVectorShared(child));
+  }
+  return std::make_shared<RowVector>(
+      input->pool(),
+      input->type(),
+      input->nulls(),
+      input->size(),
+      std::move(loadedChildren));
+}
+
+// Returns the index of the source of the plan node that gives the input of
+// the operator that wrote the trace file 'name'.
+int32_t sourceIndex(const std::string& name) {
+  const auto operatorType = name.substr(0, name.find('.'));
+  return endsWith(operatorType, "Build") ? 1 : 0;
+}
+} // namespace
+
+std::string operatorTraceDirectory(
+    const std::string& traceDir,
+    const std::string& taskId,
+    const core::PlanNodeId& planNodeId) {
+  return fmt::format("{}/{}/{}", traceDir, taskId, planNodeId);
+}
+
+void writeOperatorTraceSummary(
+    const std::string& nodeDir,
+    const core::PlanNode& planNode,
+    const std::unordered_map<std::string, std::string>& queryConfig) {
+  auto fs = filesystems::getFileSystem(nodeDir, nullptr);
+  fs->mkdir(nodeDir);
+
+  folly::dynamic sourceTypes = folly::dynamic::array;
+  for (const auto& source : planNode.sources()) {
+    sourceTypes.push_back(source->outputType()->serialize());
+  }
+  folly::dynamic config = folly::dynamic::object;
+  for (const auto& [key, value] : queryConfig) {
+    config[key] = value;
+  }
+  folly::dynamic summary =
+      folly::dynamic::object("plan", planNode.serialize())(
+          "sourceTypes", std::move(sourceTypes))("config", std::move(config));
+
+  auto file =
+      fs->openFileForWrite(fmt::format("{}/{}", nodeDir, kSummaryFileName));
+  file->append(folly::toJson(summary));
+  file->close();
+}
+
+OperatorTraceWriter::OperatorTraceWriter(
+    const std::string& nodeDir,
+    const std::string& operatorType,
+    int32_t pipelineId,
+    int32_t driverId)
+    : filePath_(fmt::format(
+          "{}/{}.{}.{}{}",
+          nodeDir,
+          operatorType,
+          pipelineId,
+          driverId,
+          kDataFileSuffix)) {}
+
+void OperatorTraceWriter::write(const RowVectorPtr& input) {
+  VELOX_CHECK(!finished_, "Writing to finished trace file {}", filePath_);
+  if (file_ == nullptr) {
+    file_ = filesystems::getFileSystem(filePath_, nullptr)
+                ->openFileForWrite(filePath_);
+  }
+  std::ostringstream out;
+  saveVector(*loadLazyColumns(input), out);
+  file_->append(out.str());
+}
+
+void OperatorTraceWriter::finish() {
+  if (finished_) {
+    return;
+  }
+  finished_ = true;
+  if (file_ != nullptr) {
+    file_->close();
+    file_.reset();
+  }
+}
+
+std::vector<RowVectorPtr> readOperatorTraceInput(
+    const std::string& filePath,
+    memory::MemoryPool* pool) {
+  std::istringstream in(readFile(filePath));
+  std::vector<RowVectorPtr> vectors;
+  while (in.peek() != std::istringstream::traits_type::eof()) {
+    vectors.push_back(
+        std::dynamic_pointer_cast<RowVector>(restoreVector(in, pool)));
+    VELOX_CHECK_NOT_NULL(vectors.back(), "Corrupt trace file {}", filePath);
+  }
+  return vectors;
+}
+
+OperatorTrace readOperatorTrace(
+    const std::string& nodeDir,
+    memory::MemoryPool* pool) {
+  auto summary = folly::parseJson(
+      readFile(fmt::format("{}/{}", nodeDir, kSummaryFileName)));
+
+  OperatorTrace trace;
+  for (const auto& [key, value] : summary["config"].items()) {
+    trace.queryConfig[key.asString()] = value.asString();
+  }
+
+  const auto& sourceTypes = summary["sourceTypes"];
+  std::vector<std::vector<RowVectorPtr>> sourceInputs(sourceTypes.size());
+  auto files = filesystems::getFileSystem(nodeDir, nullptr)->list(nodeDir);
+  std::sort(files.begin(), files.end());
+  for (const auto& file : files) {
+    const auto name = fileName(file);
+    if (!endsWith(name, kDataFileSuffix)) {
+      continue;
+    }
+    const auto index = sourceIndex(name);
+    VELOX_CHECK_LT(
+        index, sourceInputs.size(), "No source for trace file {}", file);
+    for (auto& input : readOperatorTraceInput(file, pool)) {
+      trace.numInputRows += input->size();
+      sourceInputs[index].push_back(std::move(input));
+    }
+  }
+
+  auto& plan = summary["plan"];
+  for (auto i = 0; i < sourceInputs.size(); ++i) {
+    auto& inputs = sourceInputs[i];
+    if (inputs.empty()) {
+      // ValuesNode gets its type from the first vector.
+      const auto type = asRowType(
+          ISerializable::deserialize<Type>(sourceTypes[i], pool));
+      inputs.push_back(BaseVector::create<RowVector>(type, 0, pool));
+    }
+    const auto valuesId =
+        fmt::format("{}.replay.{}", plan["id"].asString(), i);
+    plan["sources"][i] =
+        core::ValuesNode(valuesId, std::move(inputs)).serialize();
+  }
+  trace.plan = ISerializable::deserialize<core::PlanNode>(plan, pool);
+  return trace;
+}
+
+} // namespace facebook::velox::exec
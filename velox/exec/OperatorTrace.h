@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/file/File.h"
+#include "velox/core/PlanNode.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// Operator input capture for offline replay. With
+/// QueryConfig::operatorTraceDir() and operatorTraceNodeIds() set, a Task
+/// writes for each traced plan node a directory
+/// '<trace dir>/<task id>/<plan node id>' on any registered file system with:
+///
+///   summary.json: The serialized plan node, the output types of its sources
+///   and the query config.
+///
+///   <operator type>.<pipeline id>.<driver id>.data: The input vectors of
+///   each operator of the plan node, saved with saveVector().
+///
+/// readOperatorTrace() turns the directory into a plan that runs the plan
+/// node on the captured input.
+
+/// Returns the directory of the trace of 'planNodeId' of 'taskId'.
+std::string operatorTraceDirectory(
+    const std::string& traceDir,
+    const std::string& taskId,
+    const core::PlanNodeId& planNodeId);
+
+/// Writes the summary of 'planNode' run with 'queryConfig' to 'nodeDir'.
+/// Creates 'nodeDir' if it does not exist.
+void writeOperatorTraceSummary(
+    const std::string& nodeDir,
+    const core::PlanNode& planNode,
+    const std::unordered_map<std::string, std::string>& queryConfig);
+
+/// Appends the input vectors of one operator to a trace file. The file is
+/// created on the first write so that operators that get no input, e.g. the
+/// source operators, leave no file behind. Not thread safe.
+class OperatorTraceWriter {
+ public:
+  /// Writes to '<nodeDir>/<operatorType>.<pipelineId>.<driverId>.data'.
+  OperatorTraceWriter(
+      const std::string& nodeDir,
+      const std::string& operatorType,
+      int32_t pipelineId,
+      int32_t driverId);
+
+  /// Appends 'input'. Loads the lazy columns of 'input' so that the trace has
+  /// their values.
+  void write(const RowVectorPtr& input);
+
+  /// Flushes and closes the file. No more writes are allowed.
+  void finish();
+
+  const std::string& filePath() const {
+    return filePath_;
+  }
+
+ private:
+  const std::string filePath_;
+  std::unique_ptr<WriteFile> file_;
+  bool finished_{false};
+};
+
+/// Returns the vectors in a file written by OperatorTraceWriter.
+std::vector<RowVectorPtr> readOperatorTraceInput(
+    const std::string& filePath,
+    memory::MemoryPool* pool);
+
+/// The plan node of a trace with the captured input.
+struct OperatorTrace {
+  /// The traced plan node with its sources replaced by ValuesNodes of the
+  /// captured input. The input of the operators named *Build, e.g. HashBuild,
+  /// goes to the second source, the input of the other operators to the first.
+  core::PlanNodePtr plan;
+
+  std::unordered_map<std::string, std::string> queryConfig;
+
+  /// The number of captured input rows.
+  uint64_t numInputRows{0};
+};
+
+/// Reads the trace in 'nodeDir'. Requires the serde of the plan nodes, types,
+/// expressions and functions of the traced plan node to be registered.
+OperatorTrace readOperatorTrace(
+    const std::string& nodeDir,
+    memory::MemoryPool* pool);
+
+} // namespace facebook::velox::exec
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/OrderBy.h"
+
+#include <folly/ScopeGuard.h>
+
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/vector/FlatVector.h"
@@ -42,7 +45,8 @@ OrderBy::OrderBy(
           "OrderBy",
           orderByNode->canSpill(driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
-              : std::nullopt) {
+              : std::nullopt),
+      rangeSort_(isRangeSort(*orderByNode, driverCtx->queryConfig())) {
   maxOutputRows_ = outputBatchRows(std::nullopt);
   VELOX_CHECK(pool()->trackUsage());
   std::vector<column_index_t> sortColumnIndices;
@@ -59,7 +63,7 @@ OrderBy::OrderBy(
     sortCompareFlags.push_back(
         fromSortOrderToCompareFlags(orderByNode->sortingOrders()[i]));
   }
-  sortBuffer_ = std::make_unique<SortBuffer>(
+  sortBuffer_ = std::make_shared<SortBuffer>(
       outputType_,
       sortColumnIndices,
       sortCompareFlags,
@@ -89,15 +93,127 @@ void OrderBy::reclaim(
 
 void OrderBy::noMoreInput() {
   Operator::noMoreInput();
+  if (rangeSort_) {
+    samples_ = sortBuffer_->sampleRows(kRangeSortSamplesPerDriver);
+    if (waitForPeers([this](const std::vector<OrderBy*>& orderBys) {
+          makeRanges(orderBys);
+        })) {
+      rangeSortStep_ = RangeSortStep::kPartition;
+    }
+    return;
+  }
   sortBuffer_->noMoreInput();
   maxOutputRows_ = outputBatchRows(sortBuffer_->estimateOutputRowSize());
 }
 
+bool OrderBy::waitForPeers(
+    const std::function<void(const std::vector<OrderBy*>&)>& func) {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return false;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    // Realize the promises so that the other Drivers (which were not the last
+    // to arrive) can continue from the barrier.
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  if (func == nullptr) {
+    return true;
+  }
+  std::vector<OrderBy*> orderBys{this};
+  orderBys.reserve(peers.size() + 1);
+  for (auto& peer : peers) {
+    auto* orderBy = dynamic_cast<OrderBy*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(orderBy);
+    orderBys.push_back(orderBy);
+  }
+  func(orderBys);
+  return true;
+}
+
+void OrderBy::makeRanges(const std::vector<OrderBy*>& orderBys) {
+  const auto numDrivers = orderBys.size();
+  auto state = std::make_shared<RangeSortState>();
+  state->sortBuffers.resize(numDrivers);
+  state->rows.resize(numDrivers);
+
+  std::vector<char*> samples;
+  for (auto* orderBy : orderBys) {
+    const auto partition = orderBy->operatorCtx_->driverCtx()->partitionId;
+    VELOX_CHECK_LT(partition, numDrivers);
+    VELOX_CHECK_NULL(state->sortBuffers[partition]);
+    state->sortBuffers[partition] = orderBy->sortBuffer_;
+    samples.insert(
+        samples.end(), orderBy->samples_.begin(), orderBy->samples_.end());
+    orderBy->samples_.clear();
+  }
+
+  // The rows of all the sort buffers have the same layout and compare with
+  // any of them.
+  std::sort(
+      samples.begin(),
+      samples.end(),
+      [this](const char* left, const char* right) {
+        return sortBuffer_->lessThan(left, right);
+      });
+  if (!samples.empty()) {
+    for (auto i = 1; i < numDrivers; ++i) {
+      state->boundaries.push_back(samples[i * samples.size() / numDrivers]);
+    }
+  }
+
+  for (auto* orderBy : orderBys) {
+    orderBy->rangeSortState_ = state;
+  }
+}
+
+bool OrderBy::advanceRangeSort() {
+  const auto partition = operatorCtx_->driverCtx()->partitionId;
+  if (rangeSortStep_ == RangeSortStep::kWaitForRanges) {
+    // 'future_' is realized after the last driver has made the ranges.
+    rangeSortStep_ = RangeSortStep::kPartition;
+  }
+  if (rangeSortStep_ == RangeSortStep::kPartition) {
+    rangeSortState_->rows[partition] =
+        sortBuffer_->partitionRows(rangeSortState_->boundaries);
+    rangeSortStep_ = RangeSortStep::kWaitForPartitions;
+    if (!waitForPeers()) {
+      return false;
+    }
+  }
+  VELOX_CHECK(rangeSortStep_ == RangeSortStep::kWaitForPartitions);
+
+  std::vector<char*> rows;
+  for (const auto& driverRows : rangeSortState_->rows) {
+    // There is a single range if no driver has rows.
+    if (partition < driverRows.size()) {
+      const auto& rangeRows = driverRows[partition];
+      rows.insert(rows.end(), rangeRows.begin(), rangeRows.end());
+    }
+  }
+  sortBuffer_->noMoreInput(std::move(rows));
+  maxOutputRows_ = outputBatchRows(sortBuffer_->estimateOutputRowSize());
+  rangeSortStep_ = RangeSortStep::kOutput;
+  return true;
+}
+
 RowVectorPtr OrderBy::getOutput() {
   if (finished_ || !noMoreInput_) {
     return nullptr;
   }
 
+  if (rangeSort_ && rangeSortStep_ != RangeSortStep::kOutput &&
+      !advanceRangeSort()) {
+    return nullptr;
+  }
+
   RowVectorPtr output = sortBuffer_->getOutput(maxOutputRows_);
   finished_ = (output == nullptr);
   return output;
@@ -106,5 +222,6 @@ RowVectorPtr OrderBy::getOutput() {
 void OrderBy::close() {
   Operator::close();
   sortBuffer_.reset();
+  rangeSortState_.reset();
 }
 } // namespace facebook::velox::exec
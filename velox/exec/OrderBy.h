@@ -39,6 +39,18 @@ class OrderBy : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::OrderByNode>& orderByNode);
 
+  /// Returns true if the drivers of 'orderByNode' range partition their input
+  /// among each other and sort disjoint key ranges. The driver with partition
+  /// id i then outputs rows that sort before the rows of the driver with
+  /// partition id i + 1, so that a LocalMerge over 'orderByNode' only needs to
+  /// concatenate the sorted runs of the drivers.
+  static bool isRangeSort(
+      const core::OrderByNode& orderByNode,
+      const core::QueryConfig& queryConfig) {
+    return orderByNode.isPartial() && queryConfig.parallelOrderByEnabled() &&
+        !orderByNode.canSpill(queryConfig);
+  }
+
   bool needsInput() const override {
     return !finished_;
   }
@@ -49,7 +61,11 @@ class OrderBy : public Operator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+  BlockingReason isBlocked(ContinueFuture* future) override {
+    if (future_.valid()) {
+      *future = std::move(future_);
+      return BlockingReason::kWaitForProducer;
+    }
     return BlockingReason::kNotBlocked;
   }
 
@@ -63,8 +79,60 @@ class OrderBy : public Operator {
   void close() override;
 
  private:
-  std::unique_ptr<SortBuffer> sortBuffer_;
+  // Number of rows each driver of a range sort contributes to the samples
+  // that the key ranges are picked from.
+  static constexpr vector_size_t kRangeSortSamplesPerDriver = 1024;
+
+  // The steps of a range sort after the input is complete.
+  enum class RangeSortStep {
+    // Waits for all drivers to sample their rows.
+    kWaitForRanges,
+    // Splits the rows of this driver into the key ranges of all drivers.
+    kPartition,
+    // Waits for all drivers to split their rows.
+    kWaitForPartitions,
+    // Outputs the sorted rows of all drivers in the key range of this driver.
+    kOutput,
+  };
+
+  // State shared by the drivers of a range sort. Created by the last driver
+  // to finish its input.
+  struct RangeSortState {
+    // Sorted sample rows that delimit the key ranges of the drivers. Empty if
+    // no driver has rows.
+    std::vector<char*> boundaries;
+    // The sort buffers of all drivers. Keeps the rows alive until all the
+    // drivers have produced their output.
+    std::vector<std::shared_ptr<SortBuffer>> sortBuffers;
+    // 'rows[i][j]' are the rows of the driver with partition id i in the key
+    // range of the driver with partition id j.
+    std::vector<std::vector<std::vector<char*>>> rows;
+  };
+
+  // Advances the range sort. Returns true once the rows in the key range of
+  // this driver are sorted.
+  bool advanceRangeSort();
+
+  // Waits at a barrier for the peer drivers. Returns false if this driver
+  // needs to wait on 'future_'. Otherwise, this is the last driver to arrive
+  // which runs 'func' with the OrderBy operators of all the drivers before the
+  // others continue.
+  bool waitForPeers(const std::function<void(const std::vector<OrderBy*>&)>&
+                        func = nullptr);
+
+  // Picks the key ranges of the drivers from their sample rows and shares the
+  // state of the range sort with 'orderBys'.
+  void makeRanges(const std::vector<OrderBy*>& orderBys);
+
+  const bool rangeSort_;
+  std::shared_ptr<SortBuffer> sortBuffer_;
   bool finished_ = false;
   uint32_t maxOutputRows_;
+
+  // Sample of the rows of 'sortBuffer_' for a range sort.
+  std::vector<char*> samples_;
+  std::shared_ptr<RangeSortState> rangeSortState_;
+  RangeSortStep rangeSortStep_{RangeSortStep::kWaitForRanges};
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
 };
 } // namespace facebook::velox::exec
@@ -52,12 +52,17 @@ BlockingReason Destination::advance(
 
   // Serialize
   if (!current_) {
-    current_ = std::make_unique<VectorStreamGroup>(pool_);
+    current_ = std::make_shared<VectorStreamGroup>(pool_);
     auto rowType = asRowType(output->type());
     serializer::presto::PrestoVectorSerde::PrestoOptions options;
     options.compressionKind =
         OutputBufferManager::getInstance().lock()->compressionKind();
+    compressed_ =
+        options.compressionKind != common::CompressionKind_NONE;
     options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
+    options.dictionaryEncodeStrings = dictionaryEncodeStrings_;
+    options.minCompressionSavedBytesPerMicro =
+        minCompressionSavedBytesPerMicro_;
     current_->createStreamTree(rowType, rowsInCurrent_, &options);
   }
   current_->append(
@@ -83,16 +88,28 @@ BlockingReason Destination::flush(
   // Upper limit of message size with no columns.
   constexpr int32_t kMinMessageSize = 128;
   auto listener = bufferManager.newListener();
-  IOBufOutputStream stream(
-      *current_->pool(),
-      listener.get(),
-      std::max<int64_t>(kMinMessageSize, current_->size()));
+  // Without compression, the serialized column data is added to the page by
+  // reference. The page then keeps 'current_' alive and the next flush
+  // serializes into a new VectorStreamGroup.
+  std::unique_ptr<IOBufOutputStream> stream;
+  if (compressed_) {
+    stream = std::make_unique<IOBufOutputStream>(
+        *current_->pool(),
+        listener.get(),
+        std::max<int64_t>(kMinMessageSize, current_->size()));
+  } else {
+    stream = std::make_unique<IOBufOutputStream>(current_, listener.get());
+  }
   const int64_t flushedRows = rowsInCurrent_;
 
-  current_->flush(&stream);
-  current_->clear();
+  current_->flush(stream.get());
+  if (compressed_) {
+    current_->clear();
+  } else {
+    current_.reset();
+  }
 
-  const int64_t flushedBytes = stream.tellp();
+  const int64_t flushedBytes = stream->tellp();
 
   bytesInCurrent_ = 0;
   rowsInCurrent_ = 0;
@@ -102,7 +119,7 @@ BlockingReason Destination::flush(
       taskId_,
       destination_,
       std::make_unique<SerializedPage>(
-          stream.getIOBuf(bufferReleaseFn), nullptr, flushedRows),
+          stream->getIOBuf(bufferReleaseFn), nullptr, flushedRows),
       future);
 
   recordEnqueued_(flushedBytes, flushedRows);
@@ -155,7 +172,12 @@ PartitionedOutput::PartitionedOutput(
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
                             .maxPartitionedOutputBufferSize()),
-      eagerFlush_(eagerFlush) {
+      eagerFlush_(eagerFlush),
+      dictionaryEncodeStrings_(
+          ctx->queryConfig().partitionedOutputDictionaryEncoding()),
+      minCompressionSavedBytesPerMicro_(
+          ctx->queryConfig()
+              .partitionedOutputMinCompressionSavedBytesPerMicro()) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -197,7 +219,13 @@ void PartitionedOutput::initializeDestinations() {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(std::make_unique<detail::Destination>(
-          taskId, i, pool(), eagerFlush_, [&](uint64_t bytes, uint64_t rows) {
+          taskId,
+          i,
+          pool(),
+          eagerFlush_,
+          dictionaryEncodeStrings_,
+          minCompressionSavedBytesPerMicro_,
+          [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
           }));
@@ -279,14 +307,27 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
         destinations_[singlePartition.value()]->addRows(
             IndexRange{0, numInput});
       } else {
-        for (vector_size_t i = 0; i < numInput; ++i) {
-          destinations_[partitions_[i]]->addRow(i);
-        }
+        scatterRows(numInput);
       }
     }
   }
 }
 
+void PartitionedOutput::scatterRows(vector_size_t numInput) {
+  // Counting sort of the rows by destination.
+  partitionCounts_.assign(numDestinations_, 0);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    ++partitionCounts_[partitions_[i]];
+  }
+  partitionRows_.resize(numDestinations_);
+  for (auto i = 0; i < numDestinations_; ++i) {
+    partitionRows_[i] = destinations_[i]->appendRows(partitionCounts_[i]);
+  }
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    *partitionRows_[partitions_[i]]++ = i;
+  }
+}
+
 void PartitionedOutput::collectNullRows() {
   auto size = input_->size();
   rows_.resize(size);
@@ -32,11 +32,15 @@ class Destination {
       int destination,
       memory::MemoryPool* pool,
       bool eagerFlush,
+      bool dictionaryEncodeStrings,
+      int64_t minCompressionSavedBytesPerMicro,
       std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
       : taskId_(taskId),
         destination_(destination),
         pool_(pool),
         eagerFlush_(eagerFlush),
+        dictionaryEncodeStrings_(dictionaryEncodeStrings),
+        minCompressionSavedBytesPerMicro_(minCompressionSavedBytesPerMicro),
         recordEnqueued_(std::move(recordEnqueued)) {
     setTargetSizePct();
   }
@@ -51,6 +55,14 @@ class Destination {
     rows_.push_back(row);
   }
 
+  /// Appends 'numRows' rows and returns a pointer to them for the caller to
+  /// fill in.
+  vector_size_t* appendRows(vector_size_t numRows) {
+    const auto size = rows_.size();
+    rows_.resize(size + numRows);
+    return rows_.data() + size;
+  }
+
   void addRows(const IndexRange& rows) {
     for (auto i = 0; i < rows.size; ++i) {
       rows_.push_back(rows.begin + i);
@@ -106,6 +118,10 @@ class Destination {
   const int destination_;
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
+  // Writes string columns as dictionary or RLE blocks when smaller.
+  const bool dictionaryEncodeStrings_;
+  // Minimum compression savings per microsecond of compression CPU.
+  const int64_t minCompressionSavedBytesPerMicro_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
 
   // Bytes serialized in 'current_'
@@ -118,8 +134,12 @@ class Destination {
   vector_size_t rowIdx_{0};
 
   // The current stream where the input is serialized to. This is cleared on
-  // every flush() call.
-  std::unique_ptr<VectorStreamGroup> current_;
+  // every flush() call. Without compression, the flushed page references the
+  // serialized data in 'current_' instead of a copy and takes ownership of
+  // 'current_'.
+  std::shared_ptr<VectorStreamGroup> current_;
+  // True if 'current_' compresses the serialized data.
+  bool compressed_{false};
   bool finished_{false};
 
   // Flush accumulated data to buffer manager after reaching this
@@ -205,6 +225,12 @@ class PartitionedOutput : public Operator {
   /// Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  /// Adds each of the first 'numInput' rows to the destination in
+  /// 'partitions_'. Counts the rows per destination first so that each
+  /// destination grows its rows once and the rows are then written in one
+  /// pass.
+  void scatterRows(vector_size_t numInput);
+
   // If compression in serde is enabled, this is the minimum compression that
   // must be achieved before starting to skip compression. Used for testing.
   inline static float minCompressionRatio_ = 0.8;
@@ -219,6 +245,8 @@ class PartitionedOutput : public Operator {
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  const bool dictionaryEncodeStrings_;
+  const int64_t minCompressionSavedBytesPerMicro_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -233,6 +261,10 @@ class PartitionedOutput : public Operator {
   SelectivityVector rows_;
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
+  // Number of rows of the input for each destination.
+  std::vector<vector_size_t> partitionCounts_;
+  // Next row to fill in for each destination.
+  std::vector<vector_size_t*> partitionRows_;
   std::vector<DecodedVector> decodedVectors_;
   Scratch scratch_;
 };
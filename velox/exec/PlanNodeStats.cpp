@@ -107,6 +107,22 @@ std::string PlanNodeStats::toString(bool includeInputStats) const {
     out << ", Splits: " << numSplits;
   }
 
+  const auto cycles = customStats.find(OperatorStats::kPerfCycles);
+  const auto instructions = customStats.find(OperatorStats::kPerfInstructions);
+  if (cycles != customStats.end() && instructions != customStats.end() &&
+      cycles->second.sum > 0) {
+    out << fmt::format(
+        ", IPC: {:.2f}",
+        static_cast<double>(instructions->second.sum) / cycles->second.sum);
+  }
+  const auto llcMisses = customStats.find(OperatorStats::kPerfLlcMisses);
+  const auto rows = std::max<vector_size_t>(inputRows, outputRows);
+  if (llcMisses != customStats.end() && rows > 0) {
+    out << fmt::format(
+        ", LLC misses per row: {:.2f}",
+        static_cast<double>(llcMisses->second.sum) / rows);
+  }
+
   if (spilledRows > 0) {
     out << ", Spilled: " << spilledRows << " rows ("
         << succinctBytes(spilledBytes) << ", " << spilledFiles << " files)";
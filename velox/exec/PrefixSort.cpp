@@ -43,6 +43,21 @@ FOLLY_ALWAYS_INLINE void encodeRowColumn(
       value, prefix + prefixSortLayout.prefixOffsets[index]);
 }
 
+FOLLY_ALWAYS_INLINE void encodeStringRowColumn(
+    const PrefixSortLayout& prefixSortLayout,
+    const uint32_t index,
+    const RowColumn& rowColumn,
+    char* const row,
+    char* const prefix) {
+  std::optional<StringView> value;
+  if (!RowContainer::isNullAt(
+          row, rowColumn.nullByte(), rowColumn.nullMask())) {
+    value = *(reinterpret_cast<StringView*>(row + rowColumn.offset()));
+  }
+  prefixSortLayout.encoders[index].encodeStringPrefix(
+      value, prefix + prefixSortLayout.prefixOffsets[index]);
+}
+
 FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
     TypeKind typeKind,
     const PrefixSortLayout& prefixSortLayout,
@@ -72,6 +87,11 @@ FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
           prefixSortLayout, index, rowColumn, row, prefix);
       return;
     }
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      encodeStringRowColumn(prefixSortLayout, index, rowColumn, row, prefix);
+      return;
+    }
     default:
       VELOX_UNSUPPORTED(
           "prefix-sort does not support type kind: {}",
@@ -123,7 +143,9 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
   std::vector<PrefixSortEncoder> encoders;
 
   // Calculate encoders and prefix-offsets, and stop the loop if a key that
-  // cannot be normalized is encountered.
+  // cannot be normalized is encountered. A string key is stored as a prefix
+  // of its leading bytes. It is not counted as normalized since rows with
+  // equal prefixes are compared from it on, so the loop stops after it.
   for (auto i = 0; i < numKeys; ++i) {
     if (normalizedKeySize > maxNormalizedKeySize) {
       break;
@@ -136,9 +158,17 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
           {compareFlags[i].ascending, compareFlags[i].nullsFirst});
       normalizedKeySize += encodedSize.value();
       numNormalizedKeys++;
-    } else {
-      break;
+      continue;
+    }
+    std::optional<uint32_t> prefixSize =
+        PrefixSortEncoder::encodedPrefixSize(types[i]->kind());
+    if (prefixSize.has_value()) {
+      prefixOffsets.push_back(normalizedKeySize);
+      encoders.push_back(
+          {compareFlags[i].ascending, compareFlags[i].nullsFirst});
+      normalizedKeySize += prefixSize.value();
     }
+    break;
   }
   auto padding = alignmentPadding(normalizedKeySize, kAlignment);
   normalizedKeySize += padding;
@@ -148,7 +178,7 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
       numNormalizedKeys,
       numKeys,
       compareFlags,
-      numNormalizedKeys == 0,
+      encoders.empty(),
       numNormalizedKeys < numKeys,
       std::move(prefixOffsets),
       std::move(encoders),
@@ -186,10 +216,14 @@ PrefixSort::PrefixSort(
     const std::vector<CompareFlags>& keyCompareFlags,
     const PrefixSortConfig& config,
     const PrefixSortLayout& sortLayout)
-    : pool_(pool), sortLayout_(sortLayout), rowContainer_(rowContainer) {}
+    : pool_(pool),
+      sortLayout_(sortLayout),
+      rowContainer_(rowContainer),
+      radixSortMinRows_(config.radixSortMinRows),
+      executor_(config.executor) {}
 
 void PrefixSort::extractRowToPrefix(char* row, char* prefix) {
-  for (auto i = 0; i < sortLayout_.numNormalizedKeys; i++) {
+  for (auto i = 0; i < sortLayout_.encoders.size(); i++) {
     extractRowColumnToPrefix(
         rowContainer_->keyTypes()[i]->kind(),
         sortLayout_,
@@ -236,12 +270,22 @@ void PrefixSort::sortInternal(std::vector<char*>& rows) {
     PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
     const auto start = prefixes;
     const auto end = prefixes + numRows * entrySize;
+    const auto keyBytes = sortLayout_.normalizedBufferSize;
+    const bool useRadixSort = radixSortMinRows_ > 0 &&
+        numRows >= radixSortMinRows_ && keyBytes <= kMaxRadixSortKeyBytes;
+    const auto sortWith = [&](auto compare) {
+      if (useRadixSort) {
+        sortRunner.radixSort(start, end, keyBytes, compare, executor_);
+      } else {
+        sortRunner.quickSort(start, end, compare);
+      }
+    };
     if (sortLayout_.hasNonNormalizedKey) {
-      sortRunner.quickSort(start, end, [&](char* a, char* b) {
+      sortWith([&](char* a, char* b) {
         return comparePartNormalizedKeys(a, b);
       });
     } else {
-      sortRunner.quickSort(start, end, [&](char* a, char* b) {
+      sortWith([&](char* a, char* b) {
         return compareAllNormalizedKeys(a, b);
       });
     }
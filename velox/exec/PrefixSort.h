@@ -42,8 +42,15 @@ FOLLY_ALWAYS_INLINE void stdSort(
 }; // namespace detail
 
 struct PrefixSortConfig {
-  PrefixSortConfig(uint32_t maxNormalizedKeySize, uint32_t threshold = 130)
-      : maxNormalizedKeySize(maxNormalizedKeySize), threshold(threshold) {}
+  PrefixSortConfig(
+      uint32_t maxNormalizedKeySize,
+      uint32_t threshold = 130,
+      uint32_t radixSortMinRows = 65536,
+      folly::Executor* executor = nullptr)
+      : maxNormalizedKeySize(maxNormalizedKeySize),
+        threshold(threshold),
+        radixSortMinRows(radixSortMinRows),
+        executor(executor) {}
 
   /// Max number of bytes can store normalized keys in prefix-sort buffer per
   /// entry.
@@ -53,12 +60,21 @@ struct PrefixSortConfig {
   /// The threshold is set to 100 according to the benchmark test results by
   /// default.
   const int64_t threshold;
+
+  /// Minimum number of rows to sort the prefixes with radix sort instead of
+  /// quick sort. 0 disables radix sort. Radix sort is also skipped for
+  /// prefixes wider than PrefixSort::kMaxRadixSortKeyBytes.
+  const uint32_t radixSortMinRows;
+
+  /// If not null, radix sort sorts the buckets of the first key byte in
+  /// parallel on this executor.
+  folly::Executor* const executor;
 };
 
 /// The layout of prefix-sort buffer, a prefix entry includes:
 /// 1. normalized keys
-/// 2. non-normalized data ptr for semi-normalized types such as
-/// string_view`s ptr, it will be filled when support Varchar.
+/// 2. the leading bytes of the first string key after the normalized keys, if
+/// any.
 /// 3. the row address ptr point to RowContainer`s rows is added at the end of
 /// prefix.
 struct PrefixSortLayout {
@@ -70,6 +86,8 @@ struct PrefixSortLayout {
   /// sort buffer, it is called a normalized key.
   const uint32_t normalizedBufferSize;
 
+  /// Number of keys fully encoded in the prefix. A string key is encoded by
+  /// its leading bytes and is not counted.
   const uint32_t numNormalizedKeys;
 
   /// The num of sort keys include normalized and non-normalized.
@@ -78,8 +96,8 @@ struct PrefixSortLayout {
   /// CompareFlags of all sort keys.
   const std::vector<CompareFlags> compareFlags;
 
-  /// Whether the sort keys contains normalized key.
-  /// It equals to 'numNormalizedKeys == 0', a little faster.
+  /// Whether the prefix is empty, i.e. neither the first key is normalized
+  /// nor it is a string.
   const bool noNormalizedKeys;
 
   /// Whether the sort keys contains non-normalized key.
@@ -89,7 +107,8 @@ struct PrefixSortLayout {
   /// extracting columns
   const std::vector<uint32_t> prefixOffsets;
 
-  /// The encoders for normalized keys.
+  /// The encoders for normalized keys, followed by the encoder of the string
+  /// prefix key if any.
   const std::vector<prefixsort::PrefixSortEncoder> encoders;
 
   /// Align the buffer size to 8 so that long compare can replace byte compare
@@ -134,6 +153,10 @@ class PrefixSort {
   ///
   /// @param rows The result of RowContainer::listRows(), assuming that the
   /// caller (SortBuffer etc.) has already got the result.
+  /// Radix sort moves whole entries on each pass, so it loses to quick sort
+  /// when the prefixes are wide.
+  static constexpr uint32_t kMaxRadixSortKeyBytes = 64;
+
   FOLLY_ALWAYS_INLINE static void sort(
       std::vector<char*>& rows,
       memory::MemoryPool* pool,
@@ -175,5 +198,7 @@ class PrefixSort {
   memory::MemoryPool* const pool_;
   const PrefixSortLayout sortLayout_;
   RowContainer* const rowContainer_;
+  const uint32_t radixSortMinRows_;
+  folly::Executor* const executor_;
 };
 } // namespace facebook::velox::exec
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/RangeJoinIndex.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::exec {
+namespace {
+bool isSupportedKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the input column accessed by 'expr' or nullptr.
+const core::FieldAccessTypedExpr* asInputColumn(
+    const core::TypedExprPtr& expr) {
+  auto field = dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  return field != nullptr && field->isInputColumn() ? field : nullptr;
+}
+
+// Adds the top level conjuncts of 'expr' to 'conjuncts'.
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<const core::CallTypedExpr*>& conjuncts) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr) {
+    return;
+  }
+  if (call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(call);
+}
+
+// A comparison of a probe column with a build column, normalized to 'probe
+// <op> build'.
+struct Comparison {
+  column_index_t probeChannel;
+  column_index_t buildChannel;
+  // True if the build column bounds the probe column from below.
+  bool isLower;
+  bool inclusive;
+};
+
+std::optional<Comparison> toComparison(
+    const core::CallTypedExpr& call,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  const auto& name = call.name();
+  if (call.inputs().size() != 2 ||
+      (name != "lt" && name != "lte" && name != "gt" && name != "gte")) {
+    return std::nullopt;
+  }
+  auto left = asInputColumn(call.inputs()[0]);
+  auto right = asInputColumn(call.inputs()[1]);
+  if (left == nullptr || right == nullptr) {
+    return std::nullopt;
+  }
+  bool isLower = name == "gt" || name == "gte";
+  const bool inclusive = name == "gte" || name == "lte";
+  auto probeChannel = probeType->getChildIdxIfExists(left->name());
+  auto buildChannel = buildType->getChildIdxIfExists(right->name());
+  if (!probeChannel.has_value() || !buildChannel.has_value()) {
+    // 'build <op> probe' is 'probe <reversed op> build'.
+    probeChannel = probeType->getChildIdxIfExists(right->name());
+    buildChannel = buildType->getChildIdxIfExists(left->name());
+    isLower = !isLower;
+  }
+  if (!probeChannel.has_value() || !buildChannel.has_value()) {
+    return std::nullopt;
+  }
+  return Comparison{
+      probeChannel.value(), buildChannel.value(), isLower, inclusive};
+}
+
+// Adds the comparisons in 'call' to 'comparisons'.
+void addComparisons(
+    const core::CallTypedExpr& call,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType,
+    std::vector<Comparison>& comparisons) {
+  if (call.name() == "between" && call.inputs().size() == 3) {
+    auto value = asInputColumn(call.inputs()[0]);
+    auto lower = asInputColumn(call.inputs()[1]);
+    auto upper = asInputColumn(call.inputs()[2]);
+    if (value == nullptr || lower == nullptr || upper == nullptr) {
+      return;
+    }
+    auto probeChannel = probeType->getChildIdxIfExists(value->name());
+    auto lowerChannel = buildType->getChildIdxIfExists(lower->name());
+    auto upperChannel = buildType->getChildIdxIfExists(upper->name());
+    if (probeChannel.has_value() && lowerChannel.has_value()) {
+      comparisons.push_back(
+          {probeChannel.value(), lowerChannel.value(), true, true});
+    }
+    if (probeChannel.has_value() && upperChannel.has_value()) {
+      comparisons.push_back(
+          {probeChannel.value(), upperChannel.value(), false, true});
+    }
+    return;
+  }
+  if (auto comparison = toComparison(call, probeType, buildType)) {
+    comparisons.push_back(comparison.value());
+  }
+}
+} // namespace
+
+// static
+std::optional<RangeJoinBounds> RangeJoinBounds::extract(
+    const core::TypedExprPtr& condition,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  std::vector<const core::CallTypedExpr*> conjuncts;
+  flattenConjuncts(condition, conjuncts);
+  std::vector<Comparison> comparisons;
+  for (const auto* conjunct : conjuncts) {
+    addComparisons(*conjunct, probeType, buildType, comparisons);
+  }
+
+  std::optional<RangeJoinBounds> bounds;
+  for (const auto& comparison : comparisons) {
+    const auto kind = probeType->childAt(comparison.probeChannel)->kind();
+    if (!isSupportedKind(kind) ||
+        buildType->childAt(comparison.buildChannel)->kind() != kind) {
+      continue;
+    }
+    if (!bounds.has_value()) {
+      bounds = RangeJoinBounds{comparison.probeChannel};
+    } else if (bounds->probeChannel != comparison.probeChannel) {
+      continue;
+    }
+    if (comparison.isLower && !bounds->lowerChannel.has_value()) {
+      bounds->lowerChannel = comparison.buildChannel;
+      bounds->lowerInclusive = comparison.inclusive;
+    } else if (!comparison.isLower && !bounds->upperChannel.has_value()) {
+      bounds->upperChannel = comparison.buildChannel;
+      bounds->upperInclusive = comparison.inclusive;
+    }
+  }
+  return bounds;
+}
+
+// static
+int64_t RangeJoinIndex::valueAt(
+    const DecodedVector& decoded,
+    vector_size_t row) {
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::TINYINT:
+      return decoded.valueAt<int8_t>(row);
+    case TypeKind::SMALLINT:
+      return decoded.valueAt<int16_t>(row);
+    case TypeKind::INTEGER:
+      return decoded.valueAt<int32_t>(row);
+    case TypeKind::BIGINT:
+      return decoded.valueAt<int64_t>(row);
+    default:
+      VELOX_UNREACHABLE(
+          "Unsupported range join type: {}", decoded.base()->type());
+  }
+}
+
+RangeJoinIndex::RangeJoinIndex(
+    const RangeJoinBounds& bounds,
+    const RowVector& build)
+    : hasLower_(bounds.lowerChannel.has_value()),
+      lowerInclusive_(bounds.lowerInclusive),
+      hasUpper_(bounds.upperChannel.has_value()),
+      upperInclusive_(bounds.upperInclusive) {
+  VELOX_CHECK(hasLower_ || hasUpper_);
+  const auto numRows = build.size();
+  SelectivityVector allRows(numRows);
+  DecodedVector lower;
+  DecodedVector upper;
+  if (hasLower_) {
+    lower.decode(*build.childAt(bounds.lowerChannel.value()), allRows);
+  }
+  if (hasUpper_) {
+    upper.decode(*build.childAt(bounds.upperChannel.value()), allRows);
+  }
+
+  std::vector<vector_size_t> rows;
+  rows.reserve(numRows);
+  for (auto row = 0; row < numRows; ++row) {
+    if ((hasLower_ && lower.isNullAt(row)) ||
+        (hasUpper_ && upper.isNullAt(row))) {
+      continue;
+    }
+    rows.push_back(row);
+  }
+
+  const auto& sortKeys = hasLower_ ? lower : upper;
+  std::vector<int64_t> unsortedKeys(numRows);
+  for (auto row : rows) {
+    unsortedKeys[row] = valueAt(sortKeys, row);
+  }
+  std::sort(rows.begin(), rows.end(), [&](auto left, auto right) {
+    return unsortedKeys[left] < unsortedKeys[right];
+  });
+  keys_.reserve(rows.size());
+  for (auto row : rows) {
+    keys_.push_back(unsortedKeys[row]);
+  }
+  rows_ = std::move(rows);
+
+  if (!hasLower_ || !hasUpper_) {
+    return;
+  }
+  treeSize_ = bits::nextPowerOfTwo(std::max<uint64_t>(rows_.size(), 1));
+  maxUppers_.resize(2 * treeSize_, std::numeric_limits<int64_t>::min());
+  for (auto i = 0; i < rows_.size(); ++i) {
+    maxUppers_[treeSize_ + i] = valueAt(upper, rows_[i]);
+  }
+  for (auto node = treeSize_ - 1; node > 0; --node) {
+    maxUppers_[node] =
+        std::max(maxUppers_[2 * node], maxUppers_[2 * node + 1]);
+  }
+}
+
+} // namespace facebook::velox::exec
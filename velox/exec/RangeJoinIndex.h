@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/Expressions.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::exec {
+
+/// A probe side column bounded by build side columns in a conjunct of a
+/// nested loop join condition, e.g. 'p BETWEEN b.lo AND b.hi', 'p >= b.lo'
+/// or 'b.hi > p'. Only integer and date columns are supported.
+struct RangeJoinBounds {
+  column_index_t probeChannel;
+
+  /// The build side column that bounds the probe column from below. The
+  /// bound is inclusive if 'lowerInclusive' is true.
+  std::optional<column_index_t> lowerChannel;
+  bool lowerInclusive{true};
+
+  /// The build side column that bounds the probe column from above.
+  std::optional<column_index_t> upperChannel;
+  bool upperInclusive{true};
+
+  /// Returns the bounds of a probe column in the top level conjuncts of
+  /// 'condition' or std::nullopt if there are none.
+  static std::optional<RangeJoinBounds> extract(
+      const core::TypedExprPtr& condition,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+};
+
+/// Index of the rows of a build side vector of a nested loop join by the
+/// bounds of a range join condition. Finds the build rows whose bounds
+/// contain a probe value in O(log(n) + m) for m matches instead of checking
+/// all n rows. The build rows are sorted by the lower bound. A tree of the
+/// maximum upper bounds over the sorted rows skips the rows that end before
+/// the probe value. If there is no lower bound, the rows are sorted by the
+/// upper bound instead. Rows with a null bound are left out since they never
+/// satisfy the condition.
+class RangeJoinIndex {
+ public:
+  RangeJoinIndex(const RangeJoinBounds& bounds, const RowVector& build);
+
+  /// Returns the value of the integer column 'decoded' at 'row' widened to
+  /// int64_t. The row must not be null.
+  static int64_t valueAt(const DecodedVector& decoded, vector_size_t row);
+
+  /// Calls 'func(buildRow)' for every build row whose bounds contain 'value'.
+  template <typename Func>
+  void forEachMatch(int64_t value, Func func) const {
+    if (hasLower_) {
+      if (!lowerInclusive_ && value == std::numeric_limits<int64_t>::min()) {
+        return;
+      }
+      // The sorted rows with lower <= 'lowerValue'.
+      const int64_t lowerValue = lowerInclusive_ ? value : value - 1;
+      const int32_t end =
+          std::upper_bound(keys_.begin(), keys_.end(), lowerValue) -
+          keys_.begin();
+      if (!hasUpper_) {
+        for (int32_t i = 0; i < end; ++i) {
+          func(rows_[i]);
+        }
+        return;
+      }
+      int64_t upperValue;
+      if (!upperBoundValue(value, upperValue)) {
+        return;
+      }
+      forEachUpperAtLeast(1, 0, treeSize_, end, upperValue, func);
+      return;
+    }
+
+    // The rows are sorted by the upper bound.
+    int64_t upperValue;
+    if (!upperBoundValue(value, upperValue)) {
+      return;
+    }
+    const size_t begin =
+        std::lower_bound(keys_.begin(), keys_.end(), upperValue) -
+        keys_.begin();
+    for (auto i = begin; i < keys_.size(); ++i) {
+      func(rows_[i]);
+    }
+  }
+
+  /// Returns the number of indexed rows.
+  vector_size_t size() const {
+    return rows_.size();
+  }
+
+ private:
+  // Sets 'upperValue' to the least upper bound that contains 'value'.
+  // Returns false if none does.
+  bool upperBoundValue(int64_t value, int64_t& upperValue) const {
+    if (upperInclusive_) {
+      upperValue = value;
+      return true;
+    }
+    if (value == std::numeric_limits<int64_t>::max()) {
+      return false;
+    }
+    upperValue = value + 1;
+    return true;
+  }
+
+  // Calls 'func' for the rows in [0, 'end') of the sorted rows under 'node'
+  // of 'maxUppers_' with an upper bound of at least 'upperValue'. 'node'
+  // covers the sorted rows in ['nodeBegin', 'nodeEnd').
+  template <typename Func>
+  void forEachUpperAtLeast(
+      int32_t node,
+      int32_t nodeBegin,
+      int32_t nodeEnd,
+      int32_t end,
+      int64_t upperValue,
+      Func& func) const {
+    if (nodeBegin >= end || maxUppers_[node] < upperValue) {
+      return;
+    }
+    if (nodeEnd - nodeBegin == 1) {
+      func(rows_[nodeBegin]);
+      return;
+    }
+    const auto middle = (nodeBegin + nodeEnd) / 2;
+    forEachUpperAtLeast(2 * node, nodeBegin, middle, end, upperValue, func);
+    forEachUpperAtLeast(2 * node + 1, middle, nodeEnd, end, upperValue, func);
+  }
+
+  const bool hasLower_;
+  const bool lowerInclusive_;
+  const bool hasUpper_;
+  const bool upperInclusive_;
+
+  // The sort keys of the indexed rows in ascending order, i.e. the lower
+  // bounds or, if there are none, the upper bounds.
+  std::vector<int64_t> keys_;
+  // The build rows in the order of 'keys_'.
+  std::vector<vector_size_t> rows_;
+  // The number of leaves of the tree in 'maxUppers_', a power of two.
+  int32_t treeSize_{0};
+  // Implicit binary tree of the maximum upper bounds of the sorted rows if
+  // there are lower and upper bounds. Node 1 is the root, the children of node
+  // i are 2 * i and 2 * i + 1 and the leaves start at 'treeSize_'.
+  std::vector<int64_t> maxUppers_;
+};
+
+} // namespace facebook::velox::exec
@@ -63,7 +63,9 @@ Accumulator::Accumulator(Aggregate* aggregate, TypePtr spillType)
           }},
       destroyFunction_{[aggregate](folly::Range<char**> groups) {
         aggregate->destroy(groups);
-      }} {
+      }},
+      spillPartsAggregate_{
+          aggregate->supportsSpillParts() ? aggregate : nullptr} {
   VELOX_CHECK_NOT_NULL(aggregate);
 }
 
@@ -114,6 +116,19 @@ void Accumulator::extractForSpill(
   spillExtractFunction_(groups, result);
 }
 
+bool Accumulator::supportsSpillParts() const {
+  return spillPartsAggregate_ != nullptr;
+}
+
+void Accumulator::extractSpillParts(
+    char* group,
+    int64_t maxBytes,
+    VectorPtr& result,
+    const std::function<void()>& flush) const {
+  VELOX_CHECK(supportsSpillParts());
+  spillPartsAggregate_->extractSpillParts(group, maxBytes, result, flush);
+}
+
 // static
 int32_t RowContainer::combineAlignments(int32_t a, int32_t b) {
   VELOX_CHECK_EQ(__builtin_popcount(a), 1, "Alignment can only be power of 2");
@@ -536,6 +551,27 @@ void RowContainer::store(
   }
 }
 
+void RowContainer::store(
+    const DecodedVector& decoded,
+    folly::Range<char**> rows,
+    int32_t column) {
+  VELOX_DCHECK_LE(rows.size(), decoded.size());
+  const bool isKey = column < keyTypes_.size();
+  VELOX_DCHECK(isKey || accumulators_.empty());
+  const bool nullable = !isKey || nullableKeys_;
+  const auto rowColumn = rowColumns_[column];
+  VELOX_DYNAMIC_TYPE_DISPATCH_ALL(
+      storeBatch,
+      typeKinds_[column],
+      decoded,
+      rows,
+      isKey,
+      nullable,
+      rowColumn.offset(),
+      rowColumn.nullByte(),
+      rowColumn.nullMask());
+}
+
 ByteInputStream RowContainer::prepareRead(const char* row, int32_t offset) {
   const auto& view = reinterpret_cast<const std::string_view*>(row + offset);
   // We set 'stream' to range over the ranges that start at the Header
@@ -1158,6 +1194,37 @@ std::string RowContainer::toString() const {
   return out.str();
 }
 
+void RowContainer::extractColumns(
+    const char* const* rows,
+    int32_t numRows,
+    const std::vector<column_index_t>& columnIndices,
+    const std::vector<VectorPtr>& results) {
+  VELOX_CHECK_EQ(columnIndices.size(), results.size());
+  // The fixed width parts of the rows of a tile fit in the L2 cache.
+  const int32_t tileSize = std::max<int32_t>(
+      kMinExtractTileRows, kExtractTileBytes / std::max(1, fixedRowSize_));
+  if (columnIndices.size() <= 1 || numRows <= tileSize) {
+    for (auto i = 0; i < columnIndices.size(); ++i) {
+      extractColumn(rows, numRows, columnIndices[i], results[i]);
+    }
+    return;
+  }
+  for (const auto& result : results) {
+    result->resize(numRows);
+  }
+  for (int32_t start = 0; start < numRows; start += tileSize) {
+    const auto numTileRows = std::min(tileSize, numRows - start);
+    for (auto i = 0; i < columnIndices.size(); ++i) {
+      extractColumnNoResize(
+          rows + start,
+          numTileRows,
+          columnAt(columnIndices[i]),
+          start,
+          results[i]);
+    }
+  }
+}
+
 std::string RowContainer::toString(const char* row) const {
   auto types = types_;
   auto rowType = ROW(std::move(types));
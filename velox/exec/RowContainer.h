@@ -55,6 +55,17 @@ class Accumulator {
 
   void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const;
 
+  /// Returns true if the accumulator of a single group can be spilled in
+  /// parts with extractSpillParts().
+  bool supportsSpillParts() const;
+
+  /// See Aggregate::extractSpillParts().
+  void extractSpillParts(
+      char* group,
+      int64_t maxBytes,
+      VectorPtr& result,
+      const std::function<void()>& flush) const;
+
   void destroy(folly::Range<char**> groups);
 
  private:
@@ -65,6 +76,8 @@ class Accumulator {
   const TypePtr spillType_;
   std::function<void(folly::Range<char**>, VectorPtr&)> spillExtractFunction_;
   std::function<void(folly::Range<char**> groups)> destroyFunction_;
+  // Set if the accumulator of an aggregate spills in parts.
+  Aggregate* const spillPartsAggregate_{nullptr};
 };
 
 using normalized_key_t = uint64_t;
@@ -302,6 +315,14 @@ class RowContainer {
       char* row,
       int32_t columnIndex);
 
+  /// Stores the 'i'th value in 'decoded' into 'rows[i]' at 'columnIndex' for
+  /// all the 'rows'. Same as calling store() for each row but the type
+  /// dispatch and null handling are decided once for the batch.
+  void store(
+      const DecodedVector& decoded,
+      folly::Range<char**> rows,
+      int32_t columnIndex);
+
   HashStringAllocator& stringAllocator() {
     return *stringAllocator_;
   }
@@ -399,6 +420,17 @@ class RowContainer {
     extractColumn(rows, numRows, columnAt(columnIndex), resultOffset, result);
   }
 
+  /// Copies the values at 'columnIndices[i]' into 'results[i]' for the
+  /// 'numRows' rows pointed to by 'rows'. The columns are extracted together a
+  /// tile of rows at a time, so that the rows stay in cache from one column
+  /// to the next. This matters when 'rows' are in an order unrelated to their
+  /// placement in memory, e.g. after sorting.
+  void extractColumns(
+      const char* const* rows,
+      int32_t numRows,
+      const std::vector<column_index_t>& columnIndices,
+      const std::vector<VectorPtr>& results);
+
   /// Copies the values at 'columnIndex' at positions in the 'rowNumbers' array
   /// for the rows pointed to by 'rows'. The values are copied into the 'result'
   /// vector at the offset pointed by 'resultOffset'. If an entry in 'rows'
@@ -805,6 +837,20 @@ class RowContainer {
   int32_t
   storeVariableSizeAt(const char* data, char* row, column_index_t column);
 
+  // Bytes of fixed width row data extracted by extractColumns() for all the
+  // columns before moving to the next rows.
+  static constexpr int32_t kExtractTileBytes = 256 << 10;
+  static constexpr int32_t kMinExtractTileRows = 64;
+
+  // Same as extractColumn() but expects 'result' to be large enough and does
+  // not resize it. Used for extracting a column piecewise.
+  static void extractColumnNoResize(
+      const char* const* rows,
+      int32_t numRows,
+      RowColumn column,
+      int32_t resultOffset,
+      const VectorPtr& result);
+
   template <TypeKind Kind>
   static void extractColumnTyped(
       const char* const* rows,
@@ -812,13 +858,26 @@ class RowContainer {
       int32_t numRows,
       RowColumn column,
       int32_t resultOffset,
-      const VectorPtr& result) {
+      const VectorPtr& result,
+      bool resizeResult) {
     if (rowNumbers.size() > 0) {
       extractColumnTypedInternal<true, Kind>(
-          rows, rowNumbers, rowNumbers.size(), column, resultOffset, result);
+          rows,
+          rowNumbers,
+          rowNumbers.size(),
+          column,
+          resultOffset,
+          result,
+          resizeResult);
     } else {
       extractColumnTypedInternal<false, Kind>(
-          rows, rowNumbers, numRows, column, resultOffset, result);
+          rows,
+          rowNumbers,
+          numRows,
+          column,
+          resultOffset,
+          result,
+          resizeResult);
     }
   }
 
@@ -829,9 +888,14 @@ class RowContainer {
       int32_t numRows,
       RowColumn column,
       int32_t resultOffset,
-      const VectorPtr& result) {
+      const VectorPtr& result,
+      bool resizeResult) {
     // Resize the result vector before all copies.
-    result->resize(numRows + resultOffset);
+    if (resizeResult) {
+      result->resize(numRows + resultOffset);
+    } else {
+      VELOX_DCHECK_GE(result->size(), numRows + resultOffset);
+    }
 
     if (Kind == TypeKind::ROW || Kind == TypeKind::ARRAY ||
         Kind == TypeKind::MAP) {
@@ -909,6 +973,37 @@ class RowContainer {
     }
   }
 
+  // Number of rows ahead of the stored row whose destination is prefetched.
+  static constexpr int32_t kStorePrefetchDistance = 16;
+
+  template <TypeKind Kind>
+  void storeBatch(
+      const DecodedVector& decoded,
+      folly::Range<char**> rows,
+      bool isKey,
+      bool nullable,
+      int32_t offset,
+      int32_t nullByte,
+      uint8_t nullMask) {
+    const auto numRows = rows.size();
+    if (!nullable || !decoded.mayHaveNulls()) {
+      for (auto i = 0; i < numRows; ++i) {
+        if (i + kStorePrefetchDistance < numRows) {
+          __builtin_prefetch(rows[i + kStorePrefetchDistance] + offset, 1);
+        }
+        storeNoNulls<Kind>(decoded, i, isKey, rows[i], offset);
+      }
+      return;
+    }
+    for (auto i = 0; i < numRows; ++i) {
+      if (i + kStorePrefetchDistance < numRows) {
+        __builtin_prefetch(rows[i + kStorePrefetchDistance] + offset, 1);
+      }
+      storeWithNulls<Kind>(
+          decoded, i, isKey, rows[i], offset, nullByte, nullMask);
+    }
+  }
+
   template <bool useRowNumbers, typename T>
   static void extractValuesWithNulls(
       const char* const* rows,
@@ -926,6 +1021,8 @@ class RowContainer {
     auto nulls = nullBuffer->asMutable<uint64_t>();
     BufferPtr valuesBuffer = result->mutableValues(maxRows);
     auto values = valuesBuffer->asMutableRange<T>();
+    [[maybe_unused]] const char* lastStringRow = nullptr;
+    [[maybe_unused]] vector_size_t lastStringIndex = 0;
     for (int32_t i = 0; i < numRows; ++i) {
       const char* row;
       if constexpr (useRowNumbers) {
@@ -940,7 +1037,8 @@ class RowContainer {
       } else {
         bits::setNull(nulls, resultIndex, false);
         if constexpr (std::is_same_v<T, StringView>) {
-          extractString(valueAt<StringView>(row, offset), result, resultIndex);
+          extractString<useRowNumbers>(
+              row, offset, result, resultIndex, lastStringRow, lastStringIndex);
         } else {
           values[resultIndex] = valueAt<T>(row, offset);
         }
@@ -960,6 +1058,8 @@ class RowContainer {
     VELOX_DCHECK_LE(maxRows, result->size());
     BufferPtr valuesBuffer = result->mutableValues(maxRows);
     auto values = valuesBuffer->asMutableRange<T>();
+    [[maybe_unused]] const char* lastStringRow = nullptr;
+    [[maybe_unused]] vector_size_t lastStringIndex = 0;
     for (int32_t i = 0; i < numRows; ++i) {
       const char* row;
       if constexpr (useRowNumbers) {
@@ -974,7 +1074,8 @@ class RowContainer {
       } else {
         result->setNull(resultIndex, false);
         if constexpr (std::is_same_v<T, StringView>) {
-          extractString(valueAt<StringView>(row, offset), result, resultIndex);
+          extractString<useRowNumbers>(
+              row, offset, result, resultIndex, lastStringRow, lastStringIndex);
         } else {
           values[resultIndex] = valueAt<T>(row, offset);
         }
@@ -982,6 +1083,29 @@ class RowContainer {
     }
   }
 
+  // Extracts the string at 'offset' in 'row' into 'result' at 'index'. With
+  // row numbers, a row may repeat, e.g. for first_value() over frames that
+  // start at the start of the partition. If 'row' is 'lastRow', the string
+  // extracted at 'lastIndex' is reused instead of copied again.
+  template <bool useRowNumbers>
+  static void extractString(
+      const char* row,
+      int32_t offset,
+      FlatVector<StringView>* result,
+      vector_size_t index,
+      const char*& lastRow,
+      vector_size_t& lastIndex) {
+    if constexpr (useRowNumbers) {
+      if (row == lastRow) {
+        result->setNoCopy(index, result->valueAtFast(lastIndex));
+        return;
+      }
+      lastRow = row;
+      lastIndex = index;
+    }
+    extractString(valueAt<StringView>(row, offset), result, index);
+  }
+
   static ByteInputStream prepareRead(const char* row, int32_t offset);
 
   template <TypeKind Kind>
@@ -1022,8 +1146,18 @@ class RowContainer {
       return compareComplexType(row, offset, decoded, index) == 0;
     }
     if constexpr (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
-      return compareStringAsc(
-                 valueAt<StringView>(row, offset), decoded, index) == 0;
+      const auto rowValue = valueAt<StringView>(row, offset);
+      const auto value = decoded.valueAt<StringView>(index);
+      // Strings of up to 12 bytes are inlined in the StringView and compare
+      // as two integers, one of them with the size. Longer strings may not be
+      // contiguous in the container and need a copy, unless sizes differ.
+      if (rowValue.isInline()) {
+        return rowValue == value;
+      }
+      if (rowValue.size() != value.size()) {
+        return false;
+      }
+      return compareStringAsc(rowValue, decoded, index) == 0;
     }
 
     using T = typename KindToFlatVector<Kind>::HashRowType;
@@ -1403,7 +1537,8 @@ inline void RowContainer::extractColumnTyped<TypeKind::OPAQUE>(
     int32_t /*numRows*/,
     RowColumn /*column*/,
     int32_t /*resultOffset*/,
-    const VectorPtr& /*result*/) {
+    const VectorPtr& /*result*/,
+    bool /*resizeResult*/) {
   VELOX_UNSUPPORTED("RowContainer doesn't support values of type OPAQUE");
 }
 
@@ -1421,7 +1556,26 @@ inline void RowContainer::extractColumn(
       numRows,
       column,
       resultOffset,
-      result);
+      result,
+      true);
+}
+
+inline void RowContainer::extractColumnNoResize(
+    const char* const* rows,
+    int32_t numRows,
+    RowColumn column,
+    int32_t resultOffset,
+    const VectorPtr& result) {
+  VELOX_DYNAMIC_TYPE_DISPATCH_ALL(
+      extractColumnTyped,
+      result->typeKind(),
+      rows,
+      {},
+      numRows,
+      column,
+      resultOffset,
+      result,
+      false);
 }
 
 inline void RowContainer::extractColumn(
@@ -1438,7 +1592,8 @@ inline void RowContainer::extractColumn(
       rowNumbers.size(),
       column,
       resultOffset,
-      result);
+      result,
+      true);
 }
 
 inline void RowContainer::extractNulls(
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/WindowBuild.h"
+
+namespace facebook::velox::exec {
+
+/// The RowsStreamingWindowBuild is used when the input data is already sorted
+/// by {partition keys + order by keys} and all window functions can be
+/// computed while the rows of a partition arrive, e.g. ranking functions and
+/// aggregates over frames from UNBOUNDED PRECEDING to CURRENT ROW. Unlike
+/// StreamingWindowBuild, it hands out partial WindowPartitions that grow with
+/// the input, so that the Window operator produces output without holding
+/// whole partitions. The processed rows are freed by the Window operator.
+class RowsStreamingWindowBuild : public WindowBuild {
+ public:
+  RowsStreamingWindowBuild(
+      const std::shared_ptr<const core::WindowNode>& windowNode,
+      velox::memory::MemoryPool* pool,
+      const common::SpillConfig* spillConfig,
+      tsan_atomic<bool>* nonReclaimableSection);
+
+  void addInput(RowVectorPtr input) override;
+
+  void spill() override {
+    VELOX_UNREACHABLE();
+  }
+
+  std::optional<common::SpillStats> spilledStats() const override {
+    return std::nullopt;
+  }
+
+  void noMoreInput() override;
+
+  bool hasNextPartition() override {
+    return !windowPartitions_.empty();
+  }
+
+  std::shared_ptr<WindowPartition> nextPartition() override;
+
+  bool needsInput() override {
+    // Consumes input rows unless there are complete partitions that are not
+    // handed out yet.
+    return windowPartitions_.empty() ||
+        (windowPartitions_.size() == 1 &&
+         windowPartitions_.front() == inputPartition_);
+  }
+
+ private:
+  // Adds 'inputRows_' to 'inputPartition_'. Completes the partition if
+  // 'finished' is true.
+  void addPartitionInputs(bool finished);
+
+  // Holds input rows of 'inputPartition_' from the current input.
+  std::vector<char*> inputRows_;
+
+  // The partition that receives the input rows. Null before the first input
+  // row and after noMoreInput().
+  std::shared_ptr<WindowPartition> inputPartition_;
+
+  // Partitions that are not handed out by nextPartition() yet, in input
+  // order.
+  std::deque<std::shared_ptr<WindowPartition>> windowPartitions_;
+
+  // Used to compare rows based on partitionKeys.
+  char* previousRow_ = nullptr;
+};
+
+} // namespace facebook::velox::exec
@@ -88,9 +88,10 @@ void SortBuffer::addInput(const VectorPtr& input) {
   for (const auto& columnProjection : columnMap_) {
     DecodedVector decoded(
         *inputRow->childAt(columnProjection.outputChannel), allRows);
-    for (int i = 0; i < input->size(); ++i) {
-      data_->store(decoded, i, rows[i], columnProjection.inputChannel);
-    }
+    data_->store(
+        decoded,
+        folly::Range(rows.data(), rows.size()),
+        columnProjection.inputChannel);
   }
   numInputRows_ += allRows.size();
 }
@@ -109,21 +110,12 @@ void SortBuffer::noMoreInput() {
     updateEstimatedOutputRowSize();
     // Sort the pointers to the rows in RowContainer (data_) instead of sorting
     // the rows.
-    sortedRows_.resize(numInputRows_);
-    RowContainerIterator iter;
-    data_->listRows(&iter, numInputRows_, sortedRows_.data());
+    sortedRows_ = listRows();
     std::sort(
         sortedRows_.begin(),
         sortedRows_.end(),
         [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < sortCompareFlags_.size();
-               ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, sortCompareFlags_[index])) {
-              return result < 0;
-            }
-          }
-          return false;
+          return lessThan(leftRow, rightRow);
         });
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
@@ -139,6 +131,56 @@ void SortBuffer::noMoreInput() {
   pool_->release();
 }
 
+void SortBuffer::noMoreInput(std::vector<char*> rows) {
+  VELOX_CHECK(!noMoreInput_);
+  VELOX_CHECK_NULL(spiller_);
+  noMoreInput_ = true;
+
+  updateEstimatedOutputRowSize();
+  numInputRows_ = rows.size();
+  sortedRows_ = std::move(rows);
+  std::sort(
+      sortedRows_.begin(),
+      sortedRows_.end(),
+      [this](const char* leftRow, const char* rightRow) {
+        return lessThan(leftRow, rightRow);
+      });
+  pool_->release();
+}
+
+std::vector<char*> SortBuffer::sampleRows(vector_size_t maxSamples) {
+  VELOX_CHECK(!noMoreInput_);
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK_GT(maxSamples, 0);
+  auto rows = listRows();
+  if (rows.size() <= maxSamples) {
+    return rows;
+  }
+  std::vector<char*> samples(maxSamples);
+  for (auto i = 0; i < maxSamples; ++i) {
+    samples[i] = rows[i * rows.size() / maxSamples];
+  }
+  return samples;
+}
+
+std::vector<std::vector<char*>> SortBuffer::partitionRows(
+    const std::vector<char*>& boundaries) {
+  VELOX_CHECK(!noMoreInput_);
+  VELOX_CHECK_NULL(spiller_);
+  std::vector<std::vector<char*>> ranges(boundaries.size() + 1);
+  for (auto* row : listRows()) {
+    const auto it = std::lower_bound(
+        boundaries.begin(),
+        boundaries.end(),
+        row,
+        [this](const char* boundary, const char* value) {
+          return lessThan(boundary, value);
+        });
+    ranges[it - boundaries.begin()].push_back(row);
+  }
+  return ranges;
+}
+
 RowVectorPtr SortBuffer::getOutput(uint32_t maxOutputRows) {
   VELOX_CHECK(noMoreInput_);
 
@@ -251,6 +293,13 @@ void SortBuffer::updateEstimatedOutputRowSize() {
   }
 }
 
+std::vector<char*> SortBuffer::listRows() {
+  std::vector<char*> rows(data_->numRows());
+  RowContainerIterator iter;
+  data_->listRows(&iter, rows.size(), rows.data());
+  return rows;
+}
+
 void SortBuffer::spillInput() {
   if (spiller_ == nullptr) {
     VELOX_CHECK(!noMoreInput_);
@@ -324,13 +373,16 @@ void SortBuffer::prepareOutput(uint32_t maxOutputRows) {
 
 void SortBuffer::getOutputWithoutSpill() {
   VELOX_DCHECK_EQ(numInputRows_, sortedRows_.size());
+  std::vector<column_index_t> columns;
+  std::vector<VectorPtr> results;
+  columns.reserve(columnMap_.size());
+  results.reserve(columnMap_.size());
   for (const auto& columnProjection : columnMap_) {
-    data_->extractColumn(
-        sortedRows_.data() + numOutputRows_,
-        output_->size(),
-        columnProjection.inputChannel,
-        output_->childAt(columnProjection.outputChannel));
+    columns.push_back(columnProjection.inputChannel);
+    results.push_back(output_->childAt(columnProjection.outputChannel));
   }
+  data_->extractColumns(
+      sortedRows_.data() + numOutputRows_, output_->size(), columns, results);
   numOutputRows_ += output_->size();
 }
 
@@ -382,7 +434,8 @@ void SortBuffer::getOutputWithSpill() {
 void SortBuffer::finishSpill() {
   VELOX_CHECK_NULL(spillMerger_);
   auto spillPartition = spiller_->finishSpill();
-  spillMerger_ = spillPartition.createOrderedReader(pool(), spillStats_);
+  spillMerger_ = spillPartition.createOrderedReader(
+      pool(), spillStats_, spillConfig_->readAheadExecutor());
 }
 
 } // namespace facebook::velox::exec
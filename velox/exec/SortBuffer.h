@@ -47,6 +47,35 @@ class SortBuffer {
   ///  processing for the output.
   void noMoreInput();
 
+  /// Returns up to 'maxSamples' of the stored rows evenly spaced in storage
+  /// order. Used by a parallel OrderBy to pick the key ranges of its drivers.
+  std::vector<char*> sampleRows(vector_size_t maxSamples);
+
+  /// Splits the stored rows into 'boundaries.size() + 1' key ranges. Range i
+  /// has the rows that sort after boundaries[i - 1] and not after
+  /// boundaries[i]. 'boundaries' must be sorted and may be rows of other sort
+  /// buffers with the same input type and sort keys.
+  std::vector<std::vector<char*>> partitionRows(
+      const std::vector<char*>& boundaries);
+
+  /// Used by a parallel OrderBy instead of noMoreInput(). Sorts 'rows' in
+  /// memory and returns them from getOutput(). 'rows' may come from other sort
+  /// buffers with the same input type and sort keys. These must stay alive
+  /// until all the output is produced.
+  void noMoreInput(std::vector<char*> rows);
+
+  /// Returns true if 'left' sorts before 'right'. The rows may come from other
+  /// sort buffers with the same input type and sort keys.
+  bool lessThan(const char* left, const char* right) const {
+    for (vector_size_t index = 0; index < sortCompareFlags_.size(); ++index) {
+      if (auto result =
+              data_->compare(left, right, index, sortCompareFlags_[index])) {
+        return result < 0;
+      }
+    }
+    return false;
+  }
+
   /// Returns the sorted output rows in batch.
   RowVectorPtr getOutput(uint32_t maxOutputRows);
 
@@ -68,6 +97,8 @@ class SortBuffer {
   // Ensures there is sufficient memory reserved to process 'input'.
   void ensureInputFits(const VectorPtr& input);
   void updateEstimatedOutputRowSize();
+  // Returns all the rows of 'data_' in storage order.
+  std::vector<char*> listRows();
   // Invoked to initialize or reset the reusable output buffer to get output.
   void prepareOutput(uint32_t maxOutputRows);
   void getOutputWithoutSpill();
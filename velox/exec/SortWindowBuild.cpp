@@ -44,19 +44,21 @@ SortWindowBuild::SortWindowBuild(
     velox::memory::MemoryPool* pool,
     const common::SpillConfig* spillConfig,
     tsan_atomic<bool>* nonReclaimableSection,
-    folly::Synchronized<common::SpillStats>* spillStats)
+    folly::Synchronized<common::SpillStats>* spillStats,
+    const PrefixSortConfig& prefixSortConfig,
+    bool supportsRowsStreaming,
+    vector_size_t restoreBatchRows)
     : WindowBuild(node, pool, spillConfig, nonReclaimableSection),
       numPartitionKeys_{node->partitionKeys().size()},
       spillCompareFlags_{
           makeSpillCompareFlags(numPartitionKeys_, node->sortingOrders())},
+      prefixSortConfig_{prefixSortConfig},
+      streamRestoredPartitions_{supportsRowsStreaming},
+      restoreBatchRows_{restoreBatchRows},
       pool_(pool),
       spillStats_(spillStats) {
   VELOX_CHECK_NOT_NULL(pool_);
-  allKeyInfo_.reserve(partitionKeyInfo_.size() + sortKeyInfo_.size());
-  allKeyInfo_.insert(
-      allKeyInfo_.cend(), partitionKeyInfo_.begin(), partitionKeyInfo_.end());
-  allKeyInfo_.insert(
-      allKeyInfo_.cend(), sortKeyInfo_.begin(), sortKeyInfo_.end());
+  VELOX_CHECK_GT(restoreBatchRows_, 0);
   partitionStartRows_.resize(0);
 }
 
@@ -67,13 +69,16 @@ void SortWindowBuild::addInput(RowVectorPtr input) {
 
   ensureInputFits(input);
 
-  // Add all the rows into the RowContainer.
+  // Add all the rows into the RowContainer a column at a time.
+  newRows_.resize(input->size());
   for (auto row = 0; row < input->size(); ++row) {
-    char* newRow = data_->newRow();
-
-    for (auto col = 0; col < input->childrenSize(); ++col) {
-      data_->store(decodedInputVectors_[col], row, newRow, col);
-    }
+    newRows_[row] = data_->newRow();
+  }
+  for (auto col = 0; col < input->childrenSize(); ++col) {
+    data_->store(
+        decodedInputVectors_[col],
+        folly::Range(newRows_.data(), newRows_.size()),
+        col);
   }
   numRows_ += input->size();
 }
@@ -209,20 +214,16 @@ void SortWindowBuild::computePartitionStartRows() {
 }
 
 void SortWindowBuild::sortPartitions() {
-  // This is a very inefficient but easy implementation to order the input rows
-  // by partition keys + sort keys.
+  // Order the input rows by partition keys + sort keys. These are the key
+  // columns of 'data_', so the rows are sorted by their prefix-encoded keys.
   // Sort the pointers to the rows in RowContainer (data_) instead of sorting
   // the rows.
   sortedRows_.resize(numRows_);
   RowContainerIterator iter;
   data_->listRows(&iter, numRows_, sortedRows_.data());
 
-  std::sort(
-      sortedRows_.begin(),
-      sortedRows_.end(),
-      [this](const char* leftRow, const char* rightRow) {
-        return compareRowsWithKeys(leftRow, rightRow, allKeyInfo_);
-      });
+  PrefixSort::sort(
+      sortedRows_, pool_, data_.get(), spillCompareFlags_, prefixSortConfig_);
 
   computePartitionStartRows();
 }
@@ -239,7 +240,8 @@ void SortWindowBuild::noMoreInput() {
 
     VELOX_CHECK_NULL(merge_);
     auto spillPartition = spiller_->finishSpill();
-    merge_ = spillPartition.createOrderedReader(pool_, spillStats_);
+    merge_ = spillPartition.createOrderedReader(
+        pool_, spillStats_, spillConfig_->readAheadExecutor());
   } else {
     // At this point we have seen all the input rows. The operator is
     // being prepared to output rows now.
@@ -250,6 +252,24 @@ void SortWindowBuild::noMoreInput() {
   }
 }
 
+bool SortWindowBuild::isNewPartition(
+    const char* row,
+    SpillMergeStream& next) const {
+  const auto compareFlags =
+      CompareFlags::equality(CompareFlags::NullHandlingMode::kNullAsValue);
+  for (auto i = 0; i < numPartitionKeys_; ++i) {
+    if (data_->compare(
+            row,
+            data_->columnAt(i),
+            next.decoded(i),
+            next.currentIndex(),
+            compareFlags)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void SortWindowBuild::loadNextPartitionFromSpill() {
   sortedRows_.clear();
   data_->clear();
@@ -260,25 +280,32 @@ void SortWindowBuild::loadNextPartitionFromSpill() {
       break;
     }
 
-    bool newPartition = false;
-    if (!sortedRows_.empty()) {
-      CompareFlags compareFlags =
-          CompareFlags::equality(CompareFlags::NullHandlingMode::kNullAsValue);
-
-      for (auto i = 0; i < numPartitionKeys_; ++i) {
-        if (data_->compare(
-                sortedRows_.back(),
-                data_->columnAt(i),
-                next->decoded(i),
-                next->currentIndex(),
-                compareFlags)) {
-          newPartition = true;
-          break;
-        }
-      }
+    if (!sortedRows_.empty() && isNewPartition(sortedRows_.back(), *next)) {
+      break;
     }
 
-    if (newPartition) {
+    auto* newRow = data_->newRow();
+    for (auto i = 0; i < inputChannels_.size(); ++i) {
+      data_->store(next->decoded(i), next->currentIndex(), newRow, i);
+    }
+    sortedRows_.push_back(newRow);
+    next->pop();
+  }
+}
+
+void SortWindowBuild::loadRestorePartitionRows() {
+  VELOX_CHECK_NOT_NULL(restorePartition_);
+  VELOX_CHECK(!restorePartition_->isComplete());
+
+  // Reuses 'sortedRows_' for the rows read in this batch.
+  sortedRows_.clear();
+  while (sortedRows_.size() < restoreBatchRows_) {
+    auto next = merge_->next();
+    if (next == nullptr) {
+      break;
+    }
+    if (lastRestoredRow_ != nullptr &&
+        isNewPartition(lastRestoredRow_, *next)) {
       break;
     }
 
@@ -287,15 +314,37 @@ void SortWindowBuild::loadNextPartitionFromSpill() {
       data_->store(next->decoded(i), next->currentIndex(), newRow, i);
     }
     sortedRows_.push_back(newRow);
+    lastRestoredRow_ = newRow;
     next->pop();
   }
+  // A full batch may be followed by more rows of the partition.
+  const bool partitionEnd = sortedRows_.size() < restoreBatchRows_;
+
+  if (!sortedRows_.empty()) {
+    restorePartition_->addRows(sortedRows_);
+  }
+  if (partitionEnd) {
+    restorePartition_->setComplete();
+  }
 }
 
-std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
+bool SortWindowBuild::loadMoreRows() {
+  if (restorePartition_ == nullptr || restorePartition_->isComplete()) {
+    return false;
+  }
+  loadRestorePartitionRows();
+  return true;
+}
+
+std::shared_ptr<WindowPartition> SortWindowBuild::nextPartition() {
+  if (restorePartition_ != nullptr) {
+    return restorePartition_;
+  }
+
   if (merge_ != nullptr) {
     VELOX_CHECK(!sortedRows_.empty(), "No window partitions available")
     auto partition = folly::Range(sortedRows_.data(), sortedRows_.size());
-    return std::make_unique<WindowPartition>(
+    return std::make_shared<WindowPartition>(
         data_.get(), partition, inversedInputChannels_, sortKeyInfo_);
   }
 
@@ -313,11 +362,26 @@ std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
   auto partition = folly::Range(
       sortedRows_.data() + partitionStartRows_[currentPartition_],
       partitionSize);
-  return std::make_unique<WindowPartition>(
+  return std::make_shared<WindowPartition>(
       data_.get(), partition, inversedInputChannels_, sortKeyInfo_);
 }
 
 bool SortWindowBuild::hasNextPartition() {
+  if (merge_ != nullptr && streamRestoredPartitions_) {
+    // The previous partition is complete and its rows are erased by the
+    // Window operator.
+    data_->clear();
+    lastRestoredRow_ = nullptr;
+    restorePartition_ = std::make_shared<WindowPartition>(
+        data_.get(), inversedInputChannels_, sortKeyInfo_);
+    loadRestorePartitionRows();
+    if (restorePartition_->numRows() == 0) {
+      restorePartition_ = nullptr;
+      return false;
+    }
+    return true;
+  }
+
   if (merge_ != nullptr) {
     loadNextPartitionFromSpill();
     return !sortedRows_.empty();
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/Spiller.h"
 #include "velox/exec/WindowBuild.h"
 
@@ -24,6 +25,12 @@ namespace facebook::velox::exec {
 // Sorts input data of the Window by {partition keys, sort keys}
 // to identify window partitions. This sort fully orders
 // rows as needed for window function computation.
+//
+// After spilling, the partitions are restored one at a time from the sorted
+// spill runs. If all window functions can be computed while the rows of a
+// partition arrive, the restored partitions are partial and receive at most
+// 'restoreBatchRows' rows at a time, so that a single wide partition is not
+// held in memory as a whole.
 class SortWindowBuild : public WindowBuild {
  public:
   SortWindowBuild(
@@ -31,7 +38,10 @@ class SortWindowBuild : public WindowBuild {
       velox::memory::MemoryPool* pool,
       const common::SpillConfig* spillConfig,
       tsan_atomic<bool>* nonReclaimableSection,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      const PrefixSortConfig& prefixSortConfig,
+      bool supportsRowsStreaming = false,
+      vector_size_t restoreBatchRows = 1'024);
 
   bool needsInput() override {
     // No partitions are available yet, so can consume input rows.
@@ -53,7 +63,9 @@ class SortWindowBuild : public WindowBuild {
 
   bool hasNextPartition() override;
 
-  std::unique_ptr<WindowPartition> nextPartition() override;
+  std::shared_ptr<WindowPartition> nextPartition() override;
+
+  bool loadMoreRows() override;
 
  private:
   void ensureInputFits(const RowVectorPtr& input);
@@ -76,30 +88,45 @@ class SortWindowBuild : public WindowBuild {
   // Reads next partition from spilled data into 'data_' and 'sortedRows_'.
   void loadNextPartitionFromSpill();
 
+  // Returns true if the next row of 'merge_' belongs to another partition than
+  // 'row'.
+  bool isNewPartition(const char* row, SpillMergeStream& next) const;
+
+  // Reads up to 'restoreBatchRows_' rows of the partition being restored from
+  // spilled data into 'restorePartition_'. Completes the partition when its
+  // last row is read.
+  void loadRestorePartitionRows();
+
   const size_t numPartitionKeys_;
 
   // Compare flags for partition and sorting keys. Compare flags for partition
   // keys are set to default values. Compare flags for sorting keys match
   // sorting order specified in the plan node.
   //
-  // Used to sort 'data_' while spilling.
+  // Used to sort 'data_' while spilling and with prefix sort.
   const std::vector<CompareFlags> spillCompareFlags_;
 
+  const PrefixSortConfig prefixSortConfig_;
+
+  // True if the partitions restored from spilled data are streamed to the
+  // window functions as partial partitions.
+  const bool streamRestoredPartitions_;
+
+  // Maximum number of rows read at a time into a streamed partition.
+  const vector_size_t restoreBatchRows_;
+
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
-  // allKeyInfo_ is a combination of (partitionKeyInfo_ and sortKeyInfo_).
-  // It is used to perform a full sorting of the input rows to be able to
-  // separate partitions and sort the rows in it. The rows are output in
-  // this order by the operator.
-  std::vector<std::pair<column_index_t, core::SortOrder>> allKeyInfo_;
-
   // Vector of pointers to each input row in the data_ RowContainer.
   // The rows are sorted by partitionKeys + sortKeys. This total
   // ordering can be used to split partitions (with the correct
   // order by) for the processing.
   std::vector<char*> sortedRows_;
 
+  // Reusable buffer for the rows of an input batch in addInput().
+  std::vector<char*> newRows_;
+
   // This is a vector that gives the index of the start row
   // (in sortedRows_) of each partition in the RowContainer data_.
   // This auxiliary structure helps demarcate partitions.
@@ -114,6 +141,15 @@ class SortWindowBuild : public WindowBuild {
 
   // Used to sort-merge spilled data.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
+
+  // The partial partition streamed from spilled data. Null if
+  // 'streamRestoredPartitions_' is false or before the first partition is
+  // restored.
+  std::shared_ptr<WindowPartition> restorePartition_;
+
+  // Last row of 'restorePartition_'. It stays in 'data_' until the partition
+  // is complete and is used to find the end of the partition.
+  char* lastRestoredRow_{nullptr};
 };
 
 } // namespace facebook::velox::exec
@@ -259,6 +259,10 @@ void SortedAggregations::addSingleGroupSpillInput(
     char* group,
     const VectorPtr& input,
     vector_size_t index) {
+  // Null for the parts after the first of a row spilled in parts.
+  if (input->isNullAt(index)) {
+    return;
+  }
   auto* arrayVector = input->as<ArrayVector>();
   auto* elementsVector = arrayVector->elements()->asFlatVector<StringView>();
 
@@ -76,7 +76,8 @@ SpillState::SpillState(
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    bool columnarLayout)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -87,6 +88,7 @@ SpillState::SpillState(
       writeBufferSize_(writeBufferSize),
       compressionKind_(compressionKind),
       fileCreateConfig_(fileCreateConfig),
+      columnarLayout_(columnarLayout),
       pool_(pool),
       stats_(stats),
       partitionWriters_(maxPartitions_) {}
@@ -126,6 +128,7 @@ uint64_t SpillState::appendToPartition(
         numSortKeys_,
         sortCompareFlags_,
         compressionKind_,
+        columnarLayout_,
         fmt::format("{}/{}-spill-{}", spillDir, fileNamePrefix_, partition),
         targetFileSize_,
         writeBufferSize_,
@@ -241,13 +244,14 @@ std::string SpillPartition::toString() const {
 std::unique_ptr<UnorderedStreamReader<BatchStream>>
 SpillPartition::createUnorderedReader(
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    const std::vector<column_index_t>& columns) {
   VELOX_CHECK_NOT_NULL(pool);
   std::vector<std::unique_ptr<BatchStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
     streams.push_back(FileSpillBatchStream::create(
-        SpillReadFile::create(fileInfo, pool, spillStats)));
+        SpillReadFile::create(fileInfo, pool, spillStats, columns)));
   }
   files_.clear();
   return std::make_unique<UnorderedStreamReader<BatchStream>>(
@@ -257,12 +261,13 @@ SpillPartition::createUnorderedReader(
 std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReader(
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* readAheadExecutor) {
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillMergeStream::create(
-        SpillReadFile::create(fileInfo, pool, spillStats)));
+    streams.push_back(FileSpillMergeStream::create(SpillReadFile::create(
+        fileInfo, pool, spillStats, {}, readAheadExecutor)));
   }
   files_.clear();
   // Check if the partition is empty or not.
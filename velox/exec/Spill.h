@@ -291,18 +291,22 @@ class SpillPartition {
   /// Invoked to create an unordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
   /// 'spillStats' is provided to collect the spill stats when reading data from
-  /// spilled files.
+  /// spilled files. If 'columns' is not empty, the reader produces only these
+  /// columns of the spilled data. See SpillReadFile::create().
   std::unique_ptr<UnorderedStreamReader<BatchStream>> createUnorderedReader(
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      const std::vector<column_index_t>& columns = {});
 
   /// Invoked to create an ordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
   /// 'spillStats' is provided to collect the spill stats when reading data from
-  /// spilled files.
+  /// spilled files. If 'readAheadExecutor' is set, the next buffer of each
+  /// file is read on it while the current one is merged.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* readAheadExecutor = nullptr);
 
   std::string toString() const;
 
@@ -326,7 +330,8 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'columnarLayout' is true, the spill files are written in the
+  /// columnar layout described in SpillWriter.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -339,7 +344,8 @@ class SpillState {
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      bool columnarLayout = false);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -434,6 +440,7 @@ class SpillState {
   const uint64_t writeBufferSize_;
   const common::CompressionKind compressionKind_;
   const std::string fileCreateConfig_;
+  const bool columnarLayout_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
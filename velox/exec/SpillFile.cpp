@@ -17,6 +17,7 @@
 #include "velox/exec/SpillFile.h"
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/process/TimelineRecorder.h"
 
 namespace facebook::velox::exec {
 namespace {
@@ -26,19 +27,109 @@ namespace {
 // nanosecond precision, we use this serde option to ensure the serializer
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
+
+// Returns single column row types for the columns of 'type'.
+std::vector<RowTypePtr> makeColumnTypes(const RowTypePtr& type) {
+  std::vector<RowTypePtr> columnTypes;
+  columnTypes.reserve(type->size());
+  for (auto i = 0; i < type->size(); ++i) {
+    columnTypes.push_back(ROW({type->nameOf(i)}, {type->childAt(i)}));
+  }
+  return columnTypes;
+}
+
+// Returns the row type of 'columns' of 'type' or 'type' if 'columns' is empty.
+RowTypePtr projectType(
+    const RowTypePtr& type,
+    const std::vector<column_index_t>& columns) {
+  if (columns.empty()) {
+    return type;
+  }
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (const auto column : columns) {
+    VELOX_CHECK_LT(column, type->size(), "Spill read column out of range");
+    names.push_back(type->nameOf(column));
+    types.push_back(type->childAt(column));
+  }
+  return ROW(std::move(names), std::move(types));
+}
 } // namespace
 
+SpillInputStream::~SpillInputStream() {
+  if (readAhead_ != nullptr) {
+    readAhead_->close();
+  }
+}
+
 void SpillInputStream::next(bool /*throwIfPastEnd*/) {
-  const int32_t readBytes = std::min(size_ - offset_, buffer_->capacity());
+  const int32_t readBytes = readSize(offset_);
   VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
-  setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
-  uint64_t readTimeUs{0};
-  {
-    MicrosecondTimer timer{&readTimeUs};
-    file_->pread(offset_, readBytes, buffer_->asMutable<char>());
+  if (finishReadAhead()) {
+    std::swap(buffer_, readAheadBuffer_);
+  } else {
+    uint64_t readTimeUs{0};
+    {
+      MicrosecondTimer timer{&readTimeUs};
+      file_->pread(offset_, readBytes, buffer_->asMutable<char>());
+    }
+    updateSpillStats(readBytes, readTimeUs);
   }
-  updateSpillStats(readBytes, readTimeUs);
+  setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
   offset_ += readBytes;
+  startReadAhead();
+}
+
+void SpillInputStream::startReadAhead() {
+  if (executor_ == nullptr || offset_ >= size_) {
+    return;
+  }
+  VELOX_CHECK_NULL(readAhead_);
+  readAheadOffset_ = offset_;
+  readAhead_ = std::make_shared<AsyncSource<uint64_t>>(
+      [file = file_.get(),
+       buffer = readAheadBuffer_,
+       offset = offset_,
+       readBytes = readSize(offset_)]() {
+        uint64_t readTimeUs{0};
+        {
+          MicrosecondTimer timer{&readTimeUs};
+          file->pread(offset, readBytes, buffer->asMutable<char>());
+        }
+        return std::make_unique<uint64_t>(readTimeUs);
+      });
+  executor_->add([readAhead = readAhead_]() { readAhead->prepare(); });
+}
+
+bool SpillInputStream::finishReadAhead() {
+  if (readAhead_ == nullptr) {
+    return false;
+  }
+  auto readAhead = std::move(readAhead_);
+  // Moves the result even if it is not used so that the read has completed
+  // before 'readAheadBuffer_' is reused.
+  const auto readTimeUs = readAhead->move();
+  if (readAheadOffset_ != offset_) {
+    // A skip has moved past the data read ahead.
+    return false;
+  }
+  updateSpillStats(readSize(readAheadOffset_), *readTimeUs);
+  return true;
+}
+
+void SpillInputStream::skipBytes(uint64_t size) {
+  const auto& range = ranges()[0];
+  const uint64_t buffered = range.size - range.position;
+  if (size <= buffered) {
+    skip(static_cast<int32_t>(size));
+    return;
+  }
+  skip(static_cast<int32_t>(buffered));
+  offset_ += size - buffered;
+  VELOX_CHECK_LE(offset_, size_, "Skipping past end of spill file");
+  if (offset_ < size_) {
+    next(true);
+  }
 }
 
 void SpillInputStream::updateSpillStats(uint64_t readBytes, uint64_t readTimeUs)
@@ -53,15 +144,17 @@ void SpillInputStream::updateSpillStats(uint64_t readBytes, uint64_t readTimeUs)
 std::unique_ptr<SpillWriteFile> SpillWriteFile::create(
     uint32_t id,
     const std::string& pathPrefix,
-    const std::string& fileCreateConfig) {
+    const std::string& fileCreateConfig,
+    memory::MemoryPool* pool) {
   return std::unique_ptr<SpillWriteFile>(
-      new SpillWriteFile(id, pathPrefix, fileCreateConfig));
+      new SpillWriteFile(id, pathPrefix, fileCreateConfig, pool));
 }
 
 SpillWriteFile::SpillWriteFile(
     uint32_t id,
     const std::string& pathPrefix,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    memory::MemoryPool* pool)
     : id_(id), path_(fmt::format("{}-{}", pathPrefix, ordinalCounter_++)) {
   auto fs = filesystems::getFileSystem(path_, nullptr);
   file_ = fs->openFileForWrite(
@@ -69,7 +162,7 @@ SpillWriteFile::SpillWriteFile(
       filesystems::FileOptions{
           {{filesystems::FileOptions::kFileCreateConfig.toString(),
             fileCreateConfig}},
-          nullptr,
+          pool,
           std::nullopt});
 }
 
@@ -98,6 +191,7 @@ SpillWriter::SpillWriter(
     const uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
+    bool columnarLayout,
     const std::string& pathPrefix,
     uint64_t targetFileSize,
     uint64_t writeBufferSize,
@@ -109,6 +203,7 @@ SpillWriter::SpillWriter(
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
+      columnarLayout_(columnarLayout),
       pathPrefix_(pathPrefix),
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
@@ -120,6 +215,9 @@ SpillWriter::SpillWriter(
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortKeys_);
+  if (columnarLayout_) {
+    columnTypes_ = makeColumnTypes(type_);
+  }
 }
 
 SpillWriteFile* SpillWriter::ensureFile() {
@@ -130,7 +228,8 @@ SpillWriteFile* SpillWriter::ensureFile() {
     currentFile_ = SpillWriteFile::create(
         nextFileId_++,
         fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
-        fileCreateConfig_);
+        fileCreateConfig_,
+        pool_);
   }
   return currentFile_.get();
 }
@@ -148,7 +247,8 @@ void SpillWriter::closeFile() {
       .size = currentFile_->size(),
       .numSortKeys = numSortKeys_,
       .sortFlags = sortCompareFlags_,
-      .compressionKind = compressionKind_});
+      .compressionKind = compressionKind_,
+      .columnar = columnarLayout_});
   currentFile_.reset();
 }
 
@@ -156,26 +256,65 @@ size_t SpillWriter::numFinishedFiles() const {
   return finishedFiles_.size();
 }
 
+uint64_t SpillWriter::bufferedSize() const {
+  if (!columnarLayout_) {
+    return batch_ == nullptr ? 0 : batch_->size();
+  }
+  uint64_t size{0};
+  for (const auto& batch : columnBatches_) {
+    size += batch->size();
+  }
+  return size;
+}
+
+std::unique_ptr<folly::IOBuf> SpillWriter::flushColumns() {
+  std::vector<uint64_t> columnSizes;
+  columnSizes.reserve(columnBatches_.size());
+  std::vector<std::unique_ptr<folly::IOBuf>> columnBuffers;
+  columnBuffers.reserve(columnBatches_.size());
+  for (auto& batch : columnBatches_) {
+    IOBufOutputStream out(
+        *pool_, nullptr, std::max<int64_t>(4 * 1024, batch->size()));
+    batch->flush(&out);
+    columnBuffers.push_back(out.getIOBuf());
+    columnSizes.push_back(columnBuffers.back()->computeChainDataLength());
+  }
+  columnBatches_.clear();
+
+  auto iobuf = folly::IOBuf::copyBuffer(
+      columnSizes.data(), columnSizes.size() * sizeof(uint64_t));
+  for (auto& buffer : columnBuffers) {
+    iobuf->prependChain(std::move(buffer));
+  }
+  return iobuf;
+}
+
 uint64_t SpillWriter::flush() {
-  if (batch_ == nullptr) {
+  if (batch_ == nullptr && columnBatches_.empty()) {
     return 0;
   }
 
   auto* file = ensureFile();
   VELOX_CHECK_NOT_NULL(file);
 
-  IOBufOutputStream out(
-      *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
+  std::unique_ptr<folly::IOBuf> iobuf;
   uint64_t flushTimeUs{0};
-  {
+  if (columnarLayout_) {
     MicrosecondTimer timer(&flushTimeUs);
-    batch_->flush(&out);
+    iobuf = flushColumns();
+  } else {
+    IOBufOutputStream out(
+        *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
+    {
+      MicrosecondTimer timer(&flushTimeUs);
+      batch_->flush(&out);
+    }
+    batch_.reset();
+    iobuf = out.getIOBuf();
   }
-  batch_.reset();
 
   uint64_t writeTimeUs{0};
   uint64_t writtenBytes{0};
-  auto iobuf = out.getIOBuf();
   {
     MicrosecondTimer timer(&writeTimeUs);
     writtenBytes = file->write(std::move(iobuf));
@@ -193,19 +332,37 @@ uint64_t SpillWriter::write(
   uint64_t timeUs{0};
   {
     MicrosecondTimer timer(&timeUs);
-    if (batch_ == nullptr) {
-      serializer::presto::PrestoVectorSerde::PrestoOptions options = {
-          kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
-      batch_ = std::make_unique<VectorStreamGroup>(pool_);
-      batch_->createStreamTree(
-          std::static_pointer_cast<const RowType>(rows->type()),
-          1'000,
-          &options);
+    serializer::presto::PrestoVectorSerde::PrestoOptions options = {
+        kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
+    if (columnarLayout_) {
+      if (columnBatches_.empty()) {
+        for (const auto& columnType : columnTypes_) {
+          columnBatches_.push_back(std::make_unique<VectorStreamGroup>(pool_));
+          columnBatches_.back()->createStreamTree(columnType, 1'000, &options);
+        }
+      }
+      for (auto i = 0; i < columnTypes_.size(); ++i) {
+        auto column = std::make_shared<RowVector>(
+            pool_,
+            columnTypes_[i],
+            nullptr,
+            rows->size(),
+            std::vector<VectorPtr>{rows->childAt(i)});
+        columnBatches_[i]->append(column, indices);
+      }
+    } else {
+      if (batch_ == nullptr) {
+        batch_ = std::make_unique<VectorStreamGroup>(pool_);
+        batch_->createStreamTree(
+            std::static_pointer_cast<const RowType>(rows->type()),
+            1'000,
+            &options);
+      }
+      batch_->append(rows, indices);
     }
-    batch_->append(rows, indices);
   }
   updateAppendStats(rows->size(), timeUs);
-  if (batch_->size() < writeBufferSize_) {
+  if (bufferedSize() < writeBufferSize_) {
     return 0;
   }
   return flush();
@@ -231,6 +388,8 @@ void SpillWriter::updateWriteStats(
   ++statsLocked->spillWrites;
   common::updateGlobalSpillWriteStats(
       spilledBytes, flushTimeUs, fileWriteTimeUs);
+  process::recordThreadEvent("spill", "spillFlush", flushTimeUs);
+  process::recordThreadEvent("spill", "spillWrite", fileWriteTimeUs);
 }
 
 void SpillWriter::updateSpilledFileStats(uint64_t fileSize) {
@@ -284,7 +443,9 @@ std::vector<uint32_t> SpillWriter::testingSpilledFileIds() const {
 std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats) {
+    folly::Synchronized<common::SpillStats>* stats,
+    const std::vector<column_index_t>& columns,
+    folly::Executor* readAheadExecutor) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
@@ -293,6 +454,9 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.numSortKeys,
       fileInfo.sortFlags,
       fileInfo.compressionKind,
+      fileInfo.columnar,
+      columns,
+      readAheadExecutor,
       pool,
       stats));
 }
@@ -305,6 +469,9 @@ SpillReadFile::SpillReadFile(
     uint32_t numSortKeys,
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
+    bool columnar,
+    const std::vector<column_index_t>& columns,
+    folly::Executor* readAheadExecutor,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats)
     : id_(id),
@@ -314,6 +481,9 @@ SpillReadFile::SpillReadFile(
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
       compressionKind_(compressionKind),
+      columnar_(columnar),
+      columns_(columns),
+      outputType_(projectType(type_, columns_)),
       readOptions_{
           kDefaultUseLosslessTimestamp,
           compressionKind_,
@@ -324,10 +494,24 @@ SpillReadFile::SpillReadFile(
       (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
-  auto buffer = AlignedBuffer::allocate<char>(
-      std::min<uint64_t>(size_, kMaxReadBufferSize), pool_);
+  const auto bufferSize = std::min<uint64_t>(size_, kMaxReadBufferSize);
+  auto buffer = AlignedBuffer::allocate<char>(bufferSize, pool_);
+  // There is nothing to read ahead if the file fits in one buffer.
+  BufferPtr readAheadBuffer;
+  if (readAheadExecutor != nullptr && size_ > bufferSize) {
+    readAheadBuffer = AlignedBuffer::allocate<char>(bufferSize, pool_);
+  } else {
+    readAheadExecutor = nullptr;
+  }
   input_ = std::make_unique<SpillInputStream>(
-      std::move(file), std::move(buffer), stats_);
+      std::move(file),
+      std::move(buffer),
+      stats_,
+      readAheadExecutor,
+      std::move(readAheadBuffer));
+  if (columnar_) {
+    columnTypes_ = makeColumnTypes(type_);
+  }
 }
 
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
@@ -338,12 +522,70 @@ bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
   uint64_t timeUs{0};
   {
     MicrosecondTimer timer{&timeUs};
-    VectorStreamGroup::read(
-        input_.get(), pool_, type_, &rowVector, &readOptions_);
+    if (columnar_) {
+      readColumns(rowVector);
+    } else if (columns_.empty()) {
+      VectorStreamGroup::read(
+          input_.get(), pool_, type_, &rowVector, &readOptions_);
+    } else {
+      // 'rowVector' has the projected type and cannot be reused for reading.
+      rowVector = nullptr;
+      VectorStreamGroup::read(
+          input_.get(), pool_, type_, &rowVector, &readOptions_);
+      projectColumns(rowVector);
+    }
   }
   stats_->wlock()->spillDeserializationTimeUs += timeUs;
   common::updateGlobalSpillDeserializationTimeUs(timeUs);
 
   return true;
 }
+
+void SpillReadFile::readColumns(RowVectorPtr& rowVector) {
+  std::vector<uint64_t> columnSizes(columnTypes_.size());
+  for (auto& size : columnSizes) {
+    size = input_->read<uint64_t>();
+  }
+  std::vector<VectorPtr> children(outputType_->size());
+  for (column_index_t column = 0; column < columnTypes_.size(); ++column) {
+    bool selected = columns_.empty();
+    for (const auto projected : columns_) {
+      selected |= (projected == column);
+    }
+    if (!selected) {
+      input_->skipBytes(columnSizes[column]);
+      continue;
+    }
+    RowVectorPtr columnVector;
+    VectorStreamGroup::read(
+        input_.get(),
+        pool_,
+        columnTypes_[column],
+        &columnVector,
+        &readOptions_);
+    if (columns_.empty()) {
+      children[column] = columnVector->childAt(0);
+      continue;
+    }
+    for (auto i = 0; i < columns_.size(); ++i) {
+      if (columns_[i] == column) {
+        children[i] = columnVector->childAt(0);
+      }
+    }
+  }
+  VELOX_CHECK(!children.empty());
+  const auto numRows = children[0]->size();
+  rowVector = std::make_shared<RowVector>(
+      pool_, outputType_, nullptr, numRows, std::move(children));
+}
+
+void SpillReadFile::projectColumns(RowVectorPtr& rowVector) const {
+  std::vector<VectorPtr> children;
+  children.reserve(columns_.size());
+  for (const auto column : columns_) {
+    children.push_back(rowVector->childAt(column));
+  }
+  rowVector = std::make_shared<RowVector>(
+      pool_, outputType_, nullptr, rowVector->size(), std::move(children));
+}
 } // namespace facebook::velox::exec
@@ -18,6 +18,7 @@
 
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
@@ -36,10 +37,13 @@ namespace facebook::velox::exec {
 /// file.
 class SpillWriteFile {
  public:
+  /// 'pool' is used by file systems which stage the written data in memory,
+  /// e.g. object stores.
   static std::unique_ptr<SpillWriteFile> create(
       uint32_t id,
       const std::string& pathPrefix,
-      const std::string& fileCreateConfig);
+      const std::string& fileCreateConfig,
+      memory::MemoryPool* pool);
 
   uint32_t id() const {
     return id_;
@@ -67,7 +71,8 @@ class SpillWriteFile {
   SpillWriteFile(
       uint32_t id,
       const std::string& pathPrefix,
-      const std::string& fileCreateConfig);
+      const std::string& fileCreateConfig,
+      memory::MemoryPool* pool);
 
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
@@ -89,6 +94,8 @@ struct SpillFileInfo {
   uint32_t numSortKeys;
   std::vector<CompareFlags> sortFlags;
   common::CompressionKind compressionKind;
+  /// True if the file is in the columnar layout. See SpillWriter.
+  bool columnar{false};
 };
 
 using SpillFiles = std::vector<SpillFileInfo>;
@@ -107,6 +114,12 @@ class SpillWriter {
   /// constructing the result data read from 'this'. 'stats' is used to collect
   /// the spill write stats.
   ///
+  /// If 'columnarLayout' is false, each flushed batch is a single serialized
+  /// PrestoPage of all the columns. Otherwise, each flushed batch starts with
+  /// the byte sizes of its columns as uint64_t, followed by one serialized and
+  /// separately compressed PrestoPage per column. A reader can then skip the
+  /// columns it does not need without reading them.
+  ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
   SpillWriter(
@@ -114,6 +127,7 @@ class SpillWriter {
       const uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
+      bool columnarLayout,
       const std::string& pathPrefix,
       uint64_t targetFileSize,
       uint64_t writeBufferSize,
@@ -161,10 +175,16 @@ class SpillWriter {
   // Closes the current open spill file pointed by 'currentFile_'.
   void closeFile();
 
-  // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // Writes data from 'batch_' or 'columnBatches_' to the current output file.
+  // Returns the actual written size.
   uint64_t flush();
 
+  // Returns the serialized size of the buffered data.
+  uint64_t bufferedSize() const;
+
+  // Serializes 'columnBatches_' in the columnar layout and clears them.
+  std::unique_ptr<folly::IOBuf> flushColumns();
+
   // Invoked to increment the number of spilled files and the file size.
   void updateSpilledFileStats(uint64_t fileSize);
 
@@ -181,6 +201,7 @@ class SpillWriter {
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const common::CompressionKind compressionKind_;
+  const bool columnarLayout_;
   const std::string pathPrefix_;
   const uint64_t targetFileSize_;
   const uint64_t writeBufferSize_;
@@ -195,6 +216,10 @@ class SpillWriter {
   bool finished_{false};
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
+  // Single column row types of the columns of 'type_' if 'columnarLayout_'.
+  std::vector<RowTypePtr> columnTypes_;
+  // The buffered data of each column if 'columnarLayout_'.
+  std::vector<std::unique_ptr<VectorStreamGroup>> columnBatches_;
   std::unique_ptr<SpillWriteFile> currentFile_;
   SpillFiles finishedFiles_;
 };
@@ -206,31 +231,65 @@ class SpillWriter {
 /// remainingSize() APIs do not work properly.
 class SpillInputStream : public ByteInputStream {
  public:
-  /// Reads from 'input' using 'buffer' for buffering reads.
+  /// Reads from 'input' using 'buffer' for buffering reads. If 'executor' is
+  /// set, the data after 'buffer' is read into 'readAheadBuffer' on
+  /// 'executor' while 'buffer' is consumed. 'readAheadBuffer' must then have
+  /// the same capacity as 'buffer'.
   SpillInputStream(
       std::unique_ptr<ReadFile>&& file,
       BufferPtr buffer,
-      folly::Synchronized<common::SpillStats>* stats)
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* executor = nullptr,
+      BufferPtr readAheadBuffer = nullptr)
       : file_(std::move(file)),
         size_(file_->size()),
         buffer_(std::move(buffer)),
-        stats_(stats) {
+        stats_(stats),
+        executor_(executor),
+        readAheadBuffer_(std::move(readAheadBuffer)) {
+    VELOX_CHECK_EQ(executor_ == nullptr, readAheadBuffer_ == nullptr);
     next(true);
   }
 
+  ~SpillInputStream() override;
+
   /// True if all of the file has been read into vectors.
   bool atEnd() const override {
     return offset_ >= size_ && ranges()[0].position >= ranges()[0].size;
   }
 
+  /// Skips the next 'size' bytes. Only reads from the file after the skipped
+  /// bytes if these extend past the buffered data.
+  void skipBytes(uint64_t size);
+
  private:
   void updateSpillStats(uint64_t readBytes, uint64_t readTimeUs) const;
   void next(bool throwIfPastEnd) override;
 
+  // Returns the number of bytes to read into a buffer at 'offset'.
+  uint64_t readSize(uint64_t offset) const {
+    return std::min(size_ - offset, buffer_->capacity());
+  }
+
+  // Starts reading the data at 'offset_' into 'readAheadBuffer_' on
+  // 'executor_' if there is any left.
+  void startReadAhead();
+
+  // Waits for the read started by startReadAhead() if any. Returns true if it
+  // has read the data at 'offset_'.
+  bool finishReadAhead();
+
   const std::unique_ptr<ReadFile> file_;
   const uint64_t size_;
-  const BufferPtr buffer_;
+  BufferPtr buffer_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const executor_;
+  // Holds the data after 'buffer_' when the read ahead completes.
+  BufferPtr readAheadBuffer_;
+  // The read into 'readAheadBuffer_' at 'readAheadOffset_'. Produces the read
+  // time in microseconds.
+  std::shared_ptr<AsyncSource<uint64_t>> readAhead_;
+  uint64_t readAheadOffset_{0};
 
   // Offset of first byte not in 'buffer_'
   uint64_t offset_ = 0;
@@ -245,10 +304,17 @@ class SpillInputStream : public ByteInputStream {
 /// rmdir() call.
 class SpillReadFile {
  public:
+  /// Creates a reader of the file described by 'fileInfo'. If 'columns' is
+  /// not empty, the batches read have only these columns of the spilled
+  /// type in the given order. The data of the other columns is not read if
+  /// the file is in the columnar layout. If 'readAheadExecutor' is set, the
+  /// file is read ahead on it. See SpillInputStream.
   static std::unique_ptr<SpillReadFile> create(
       const SpillFileInfo& fileInfo,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      const std::vector<column_index_t>& columns = {},
+      folly::Executor* readAheadExecutor = nullptr);
 
   uint32_t id() const {
     return id_;
@@ -282,9 +348,18 @@ class SpillReadFile {
       uint32_t numSortKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
+      bool columnar,
+      const std::vector<column_index_t>& columns,
+      folly::Executor* readAheadExecutor,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats);
 
+  // Reads the next batch of a file in the columnar layout into 'rowVector'.
+  void readColumns(RowVectorPtr& rowVector);
+
+  // Replaces 'rowVector' by a vector of the 'columns_' of it.
+  void projectColumns(RowVectorPtr& rowVector) const;
+
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
   const uint32_t id_;
@@ -296,6 +371,13 @@ class SpillReadFile {
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const common::CompressionKind compressionKind_;
+  const bool columnar_;
+  // The columns to read. All columns if empty.
+  const std::vector<column_index_t> columns_;
+  // The type of the batches returned by nextBatch().
+  const RowTypePtr outputType_;
+  // Single column row types of the columns of 'type_' if 'columnar_'.
+  std::vector<RowTypePtr> columnTypes_;
   const serializer::presto::PrestoVectorSerde::PrestoOptions readOptions_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
@@ -17,6 +17,7 @@
 #include "velox/exec/Spiller.h"
 #include <folly/ScopeGuard.h>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/process/TimelineRecorder.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/HashJoinBridge.h"
@@ -58,6 +59,7 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->columnarLayout,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kOrderByInput || type_ == Type::kAggregateInput,
@@ -90,6 +92,7 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->columnarLayout,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kAggregateOutput || type_ == Type::kOrderByOutput,
@@ -122,6 +125,7 @@ Spiller::Spiller(
           spillConfig->executor,
           0,
           spillConfig->fileCreateConfig,
+          spillConfig->columnarLayout,
           spillStats) {
   VELOX_CHECK_EQ(
       type_,
@@ -155,6 +159,7 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->columnarLayout,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kHashJoinBuild);
   VELOX_CHECK(isHashJoinTableSpillType(rowType_, joinType));
@@ -184,6 +189,7 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->columnarLayout,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kRowNumber);
 }
@@ -205,6 +211,7 @@ Spiller::Spiller(
     folly::Executor* executor,
     uint64_t maxSpillRunRows,
     const std::string& fileCreateConfig,
+    bool columnarLayout,
     folly::Synchronized<common::SpillStats>* spillStats)
     : type_(type),
       container_(container),
@@ -226,7 +233,8 @@ Spiller::Spiller(
           compressionKind,
           memory::spillMemoryPool(),
           spillStats,
-          fileCreateConfig) {
+          fileCreateConfig,
+          columnarLayout) {
   TestValue::adjust(
       "facebook::velox::exec::Spiller", const_cast<HashBitRange*>(&bits_));
 
@@ -265,6 +273,63 @@ void Spiller::extractSpill(folly::Range<char**> rows, RowVectorPtr& resultPtr) {
   }
 }
 
+bool Spiller::spillRowInParts(
+    int32_t partition,
+    char* row,
+    int64_t maxBytes,
+    RowVectorPtr& spillVector,
+    int64_t& totalBytes) {
+  if (type_ != Type::kAggregateInput && type_ != Type::kAggregateOutput) {
+    return false;
+  }
+  const auto& accumulators = container_->accumulators();
+  int32_t partsIndex = -1;
+  for (auto i = 0; i < accumulators.size(); ++i) {
+    if (accumulators[i].supportsSpillParts()) {
+      partsIndex = i;
+      break;
+    }
+  }
+  if (partsIndex < 0) {
+    return false;
+  }
+
+  if (spillVector == nullptr) {
+    spillVector =
+        BaseVector::create<RowVector>(rowType_, 1, memory::spillMemoryPool());
+  } else {
+    spillVector->prepareForReuse();
+    spillVector->resize(1);
+  }
+  const auto& types = container_->columnTypes();
+  for (auto i = 0; i < types.size(); ++i) {
+    container_->extractColumn(&row, 1, i, spillVector->childAt(i));
+  }
+  for (auto i = 0; i < accumulators.size(); ++i) {
+    if (i != partsIndex) {
+      accumulators[i].extractForSpill(
+          folly::Range(&row, 1), spillVector->childAt(types.size() + i));
+    }
+  }
+
+  bool firstPart = true;
+  accumulators[partsIndex].extractSpillParts(
+      row, maxBytes, spillVector->childAt(types.size() + partsIndex), [&]() {
+        totalBytes += state_.appendToPartition(partition, spillVector);
+        if (firstPart) {
+          firstPart = false;
+          // The other accumulators are merged from the first part only.
+          for (auto i = 0; i < accumulators.size(); ++i) {
+            if (i != partsIndex) {
+              spillVector->childAt(types.size() + i)->setNull(0, true);
+            }
+          }
+        }
+      });
+  VELOX_CHECK(!firstPart, "extractSpillParts must produce at least one part");
+  return true;
+}
+
 int64_t Spiller::extractSpillVector(
     SpillRows& rows,
     int32_t maxRows,
@@ -278,7 +343,13 @@ int64_t Spiller::extractSpillVector(
   int32_t numRows = 0;
   int64_t bytes = 0;
   for (; numRows < limit; ++numRows) {
-    bytes += container_->rowSize(rows[nextBatchIndex + numRows]);
+    const auto rowSize = container_->rowSize(rows[nextBatchIndex + numRows]);
+    if (numRows > 0 && rowSize > maxBytes) {
+      // A row over the limit goes in a batch of its own, which may spill it
+      // in parts. See spillRowInParts().
+      break;
+    }
+    bytes += rowSize;
     if (bytes > maxBytes) {
       // Increment because the row that went over the limit is part
       // of the result. We must spill at least one row.
@@ -413,9 +484,21 @@ std::unique_ptr<Spiller::SpillStatus> Spiller::writeSpill(int32_t partition) {
     int64_t totalBytes = 0;
     size_t written = 0;
     while (written < run.rows.size()) {
-      extractSpillVector(
-          run.rows, kTargetBatchRows, kTargetBatchBytes, spillVector, written);
-      totalBytes += state_.appendToPartition(partition, spillVector);
+      auto* row = run.rows[written];
+      if (container_->rowSize(row) > kTargetBatchBytes &&
+          spillRowInParts(
+              partition, row, kTargetBatchBytes, spillVector, totalBytes)) {
+        // A row too large for one batch has been spilled in parts.
+        ++written;
+      } else {
+        extractSpillVector(
+            run.rows,
+            kTargetBatchRows,
+            kTargetBatchBytes,
+            spillVector,
+            written);
+        totalBytes += state_.appendToPartition(partition, spillVector);
+      }
       if (totalBytes > state_.targetFileSize()) {
         VELOX_CHECK(!needSort());
         state_.finishFile(partition);
@@ -430,19 +513,19 @@ std::unique_ptr<Spiller::SpillStatus> Spiller::writeSpill(int32_t partition) {
   }
 }
 
-void Spiller::runSpill(bool lastRun) {
+void Spiller::runSpill(bool lastRun, bool eraseRows) {
   ++spillStats_->wlock()->spillRuns;
   VELOX_CHECK(type_ != Spiller::Type::kOrderByOutput || lastRun);
 
   std::vector<std::shared_ptr<AsyncSource<SpillStatus>>> writes;
   for (auto partition = 0; partition < spillRuns_.size(); ++partition) {
+    if (spillRuns_[partition].rows.empty()) {
+      continue;
+    }
     VELOX_CHECK(
         state_.isPartitionSpilled(partition),
         "Partition {} is not marked as spilled",
         partition);
-    if (spillRuns_[partition].rows.empty()) {
-      continue;
-    }
     writes.push_back(std::make_shared<AsyncSource<SpillStatus>>(
         [partition, this]() { return writeSpill(partition); }));
     if (executor_) {
@@ -474,6 +557,10 @@ void Spiller::runSpill(bool lastRun) {
     auto partition = result->partition;
     auto& run = spillRuns_[partition];
     VELOX_CHECK_EQ(numWritten, run.rows.size());
+    if (eraseRows) {
+      container_->eraseRows(
+          folly::Range<char**>(run.rows.data(), run.rows.size()));
+    }
     run.clear();
     // When a sorted run ends, we start with a new file next time.
     if (needSort()) {
@@ -495,11 +582,13 @@ void Spiller::runSpill(bool lastRun) {
 void Spiller::updateSpillFillTime(uint64_t timeUs) {
   spillStats_->wlock()->spillFillTimeUs += timeUs;
   common::updateGlobalSpillFillTime(timeUs);
+  process::recordThreadEvent("spill", "spillFill", timeUs);
 }
 
 void Spiller::updateSpillSortTime(uint64_t timeUs) {
   spillStats_->wlock()->spillSortTimeUs += timeUs;
   common::updateGlobalSpillSortTime(timeUs);
+  process::recordThreadEvent("spill", "spillSort", timeUs);
 }
 
 bool Spiller::needSort() const {
@@ -550,6 +639,53 @@ void Spiller::spill(std::vector<char*>& rows) {
   checkEmptySpillRuns();
 }
 
+void Spiller::spill(const SpillPartitionNumSet& partitions) {
+  CHECK_NOT_FINALIZED();
+  VELOX_CHECK_EQ(type_, Type::kHashJoinBuild);
+  if (partitions.empty()) {
+    return;
+  }
+  for (const auto partition : partitions) {
+    VELOX_CHECK_LT(partition, state_.maxPartitions());
+    if (!state_.isPartitionSpilled(partition)) {
+      state_.setPartitionSpilled(partition);
+    }
+  }
+
+  RowContainerIterator rowIter;
+  bool lastRun{false};
+  do {
+    lastRun = fillSpillRuns(&rowIter, &partitions);
+    runSpill(lastRun, /*eraseRows=*/true);
+  } while (!lastRun);
+
+  checkEmptySpillRuns();
+}
+
+std::vector<uint64_t> Spiller::partitionBytes() const {
+  std::vector<uint64_t> bytes(state_.maxPartitions(), 0);
+  constexpr int32_t kHashBatchSize = 4096;
+  std::vector<uint64_t> hashes(kHashBatchSize);
+  std::vector<uint32_t> partitions(kHashBatchSize);
+  std::vector<char*> rows(kHashBatchSize);
+  RowContainerIterator iter;
+  for (;;) {
+    const auto numRows = container_->listRows(
+        &iter, rows.size(), RowContainer::kUnlimited, rows.data());
+    if (numRows == 0) {
+      break;
+    }
+    computePartitions(
+        folly::Range<char**>(rows.data(), numRows),
+        hashes.data(),
+        partitions.data());
+    for (auto i = 0; i < numRows; ++i) {
+      bytes[partitions[i]] += container_->rowSize(rows[i]);
+    }
+  }
+  return bytes;
+}
+
 void Spiller::checkEmptySpillRuns() const {
   for (const auto& spillRun : spillRuns_) {
     VELOX_CHECK(spillRun.rows.empty());
@@ -615,7 +751,9 @@ void Spiller::finalizeSpill() {
   finalized_ = true;
 }
 
-bool Spiller::fillSpillRuns(RowContainerIterator* iterator) {
+bool Spiller::fillSpillRuns(
+    RowContainerIterator* iterator,
+    const SpillPartitionNumSet* partitions) {
   checkEmptySpillRuns();
 
   bool lastRun{false};
@@ -626,8 +764,8 @@ bool Spiller::fillSpillRuns(RowContainerIterator* iterator) {
     // Number of rows to hash and divide into spill partitions at a time.
     constexpr int32_t kHashBatchSize = 4096;
     std::vector<uint64_t> hashes(kHashBatchSize);
+    std::vector<uint32_t> rowPartitions(kHashBatchSize);
     std::vector<char*> rows(kHashBatchSize);
-    const bool isSinglePartition = bits_.numPartitions() == 1;
 
     uint64_t totalRows{0};
     for (;;) {
@@ -638,23 +776,18 @@ bool Spiller::fillSpillRuns(RowContainerIterator* iterator) {
         break;
       }
 
-      // Calculate hashes for this batch of spill candidates.
-      auto rowSet = folly::Range<char**>(rows.data(), numRows);
-
-      if (!isSinglePartition) {
-        for (auto i = 0; i < container_->keyTypes().size(); ++i) {
-          container_->hash(i, rowSet, i > 0, hashes.data());
-        }
-      }
+      // Calculate the partitions for this batch of spill candidates.
+      computePartitions(
+          folly::Range<char**>(rows.data(), numRows),
+          hashes.data(),
+          rowPartitions.data());
 
       // Put each in its run.
       for (auto i = 0; i < numRows; ++i) {
-        // TODO: consider to cache the hash bits in row container so we only
-        // need to calculate them once.
-        const auto partition = isSinglePartition
-            ? 0
-            : bits_.partition(hashes[i], state_.maxPartitions());
-        VELOX_DCHECK_GE(partition, 0);
+        const auto partition = rowPartitions[i];
+        if (partitions != nullptr && partitions->count(partition) == 0) {
+          continue;
+        }
         spillRuns_[partition].rows.push_back(rows[i]);
         spillRuns_[partition].numBytes += container_->rowSize(rows[i]);
       }
@@ -670,6 +803,24 @@ bool Spiller::fillSpillRuns(RowContainerIterator* iterator) {
   return lastRun;
 }
 
+void Spiller::computePartitions(
+    folly::Range<char**> rows,
+    uint64_t* hashes,
+    uint32_t* partitions) const {
+  if (bits_.numPartitions() == 1) {
+    std::fill(partitions, partitions + rows.size(), 0);
+    return;
+  }
+  for (auto i = 0; i < container_->keyTypes().size(); ++i) {
+    container_->hash(i, rows, i > 0, hashes);
+  }
+  for (auto i = 0; i < rows.size(); ++i) {
+    // TODO: consider to cache the hash bits in row container so we only
+    // need to calculate them once.
+    partitions[i] = bits_.partition(hashes[i], state_.maxPartitions());
+  }
+}
+
 void Spiller::fillSpillRun(std::vector<char*>& rows) {
   VELOX_CHECK_EQ(bits_.numPartitions(), 1);
   checkEmptySpillRuns();
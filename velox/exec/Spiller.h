@@ -118,6 +118,17 @@ class Spiller {
   /// container. The caller needs to erase them from the row container.
   void spill(std::vector<char*>& rows);
 
+  /// Invoked to spill the rows of 'partitions' and mark them as spilling. This
+  /// is used by 'kHashJoinBuild' spiller type to spill only some of the
+  /// partitions of a hash join build. Unlike the other spill calls, the
+  /// spilled rows are erased from the row container. The rows of the other
+  /// partitions stay in memory.
+  void spill(const SpillPartitionNumSet& partitions);
+
+  /// Returns the byte size of the rows in the row container for each spill
+  /// partition.
+  std::vector<uint64_t> partitionBytes() const;
+
   /// Append 'spillVector' into the spill file of given 'partition'. It is now
   /// only used by the spilling operator which doesn't need data sort, such as
   /// hash join build and hash join probe.
@@ -210,6 +221,7 @@ class Spiller {
       folly::Executor* executor,
       uint64_t maxSpillRunRows,
       const std::string& fileCreateConfig,
+      bool columnarLayout,
       folly::Synchronized<common::SpillStats>* spillStats);
 
   // Invoked to spill. If 'startRowIter' is not null, then we only spill rows
@@ -221,6 +233,19 @@ class Spiller {
   // RowContainerSpillMergeStream.
   void extractSpill(folly::Range<char**> rows, RowVectorPtr& result);
 
+  // Spills 'row' of 'partition' as several spill vectors of one row each if
+  // an accumulator of the row supports spilling in parts. The first such
+  // accumulator is extracted in parts of about 'maxBytes'. The other columns
+  // are written with the first part and are null in the others. Returns false
+  // without writing anything if no accumulator supports spilling in parts.
+  // Adds the bytes written to 'totalBytes'.
+  bool spillRowInParts(
+      int32_t partition,
+      char* row,
+      int64_t maxBytes,
+      RowVectorPtr& spillVector,
+      int64_t& totalBytes);
+
   // Returns a mergeable stream that goes over unspilled in-memory
   // rows for the spill partition  'partition'. finishSpill()
   // first and 'partition' must specify a partition that has started spilling.
@@ -283,16 +308,27 @@ class Spiller {
 
   // Prepares spill runs for the spillable data from all the hash partitions.
   // If 'startRowIter' is not null, we prepare runs starting from the offset
-  // pointed by 'startRowIter'.
+  // pointed by 'startRowIter'. If 'partitions' is not null, only the rows of
+  // 'partitions' are added to the runs.
   // The function returns true if it is the last spill run.
-  bool fillSpillRuns(RowContainerIterator* startRowIter = nullptr);
+  bool fillSpillRuns(
+      RowContainerIterator* startRowIter = nullptr,
+      const SpillPartitionNumSet* partitions = nullptr);
+
+  // Sets 'partitions' to the spill partition of each of 'rows'. 'hashes' is
+  // scratch space for at least 'rows.size()' hashes.
+  void computePartitions(
+      folly::Range<char**> rows,
+      uint64_t* hashes,
+      uint32_t* partitions) const;
 
   // Prepares spill run of a single partition for the spillable data from the
   // rows.
   void fillSpillRun(std::vector<char*>& rows);
 
-  // Writes out all the rows collected in spillRuns_.
-  void runSpill(bool lastRun);
+  // Writes out all the rows collected in spillRuns_. Erases the written rows
+  // from the row container if 'eraseRows' is true.
+  void runSpill(bool lastRun, bool eraseRows = false);
 
   // Sorts 'run' if not already sorted.
   void ensureSorted(SpillRun& run);
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SplitPreloadBudget.h"
+
+#include <algorithm>
+
+namespace facebook::velox::exec {
+namespace {
+double average(double average, double value, double newWeight) {
+  return average == 0 ? value : average + newWeight * (value - average);
+}
+} // namespace
+
+void SplitPreloadBudget::consumed(
+    uint64_t bytes,
+    bool preloaded,
+    std::optional<uint64_t> preloadMicros,
+    uint64_t nowMicros) {
+  if (preloaded) {
+    inFlightBytes_ -= std::min(inFlightBytes_, bytes);
+  }
+  if (preloadMicros.has_value()) {
+    preloadMicros_ =
+        average(preloadMicros_, preloadMicros.value(), kNewWeight);
+  }
+  if (windowStartMicros_ == 0) {
+    windowStartMicros_ = nowMicros;
+    return;
+  }
+  windowBytes_ += bytes;
+  const auto elapsed = nowMicros - windowStartMicros_;
+  if (elapsed < kRateWindowMicros) {
+    return;
+  }
+  bytesPerMicro_ = average(
+      bytesPerMicro_, static_cast<double>(windowBytes_) / elapsed, kNewWeight);
+  windowStartMicros_ = nowMicros;
+  windowBytes_ = 0;
+}
+
+uint64_t SplitPreloadBudget::limit() const {
+  if (bytesPerMicro_ == 0 || preloadMicros_ == 0) {
+    return maxBytes_;
+  }
+  return std::min<double>(maxBytes_, 2 * bytesPerMicro_ * preloadMicros_);
+}
+
+} // namespace facebook::velox::exec
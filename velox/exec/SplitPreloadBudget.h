@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+namespace facebook::velox::exec {
+
+/// Limits the bytes of the splits a Task preloads ahead of the drivers that
+/// read them. To have a preloaded split ready whenever a driver asks for one,
+/// the bytes in flight must cover what the drivers read while a preload is in
+/// progress, i.e. the rate at which the drivers take split bytes times the
+/// latency of a preload. The limit is twice that, capped by 'maxBytes'. Before
+/// both are measured the limit is 'maxBytes'. A preload can always start when
+/// none is in flight. Not thread safe.
+class SplitPreloadBudget {
+ public:
+  explicit SplitPreloadBudget(uint64_t maxBytes) : maxBytes_(maxBytes) {}
+
+  /// Returns true if the preload of a split of 'bytes' can start.
+  bool canStart(uint64_t bytes) const {
+    return inFlightBytes_ == 0 || inFlightBytes_ + bytes <= limit();
+  }
+
+  /// Records the start of the preload of a split of 'bytes'.
+  void started(uint64_t bytes) {
+    inFlightBytes_ += bytes;
+  }
+
+  /// Records that a driver took a split of 'bytes' at 'nowMicros'. If the
+  /// split was preloading, 'preloaded' is true and 'preloadMicros' is the wall
+  /// time of the preload if it has finished.
+  void consumed(
+      uint64_t bytes,
+      bool preloaded,
+      std::optional<uint64_t> preloadMicros,
+      uint64_t nowMicros);
+
+  /// Returns the current limit of the bytes in flight.
+  uint64_t limit() const;
+
+  uint64_t inFlightBytes() const {
+    return inFlightBytes_;
+  }
+
+ private:
+  // Minimum duration of a window for measuring the consumption rate.
+  static constexpr uint64_t kRateWindowMicros = 100'000;
+  // Weight of the latest measurement in the moving averages.
+  static constexpr double kNewWeight = 0.2;
+
+  const uint64_t maxBytes_;
+
+  uint64_t inFlightBytes_{0};
+
+  // Moving average of the split bytes taken by the drivers per microsecond.
+  // 0 until measured.
+  double bytesPerMicro_{0};
+  // Moving average of the wall time of a preload. 0 until measured.
+  double preloadMicros_{0};
+
+  // Start and bytes of the current window for measuring 'bytesPerMicro_'.
+  uint64_t windowStartMicros_{0};
+  uint64_t windowBytes_{0};
+};
+
+} // namespace facebook::velox::exec
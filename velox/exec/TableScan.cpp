@@ -47,7 +47,11 @@ TableScan::TableScan(
       readBatchSize_(driverCtx_->queryConfig().preferredOutputBatchRows()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
       getOutputTimeLimitMs_(
-          driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()) {
+          driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()),
+      resultCacheFingerprint_(
+          driverCtx_->queryConfig().fragmentResultCacheEnabled()
+              ? FragmentResultCache::fingerprint(*tableScanNode)
+              : "") {
   connector_ = connector::getConnector(tableHandle_->connectorId());
 }
 
@@ -158,6 +162,10 @@ RowVectorPtr TableScan::getOutput() {
           connectorSplit->connectorId,
           "Got splits with different connector IDs");
 
+      if (startCachedSplit(*connectorSplit)) {
+        continue;
+      }
+
       if (dataSource_ == nullptr) {
         curStatus_ = "getOutput: creating dataSource_";
         connectorQueryCtx_ = operatorCtx_->createConnectorQueryCtx(
@@ -219,6 +227,20 @@ RowVectorPtr TableScan::getOutput() {
           : outputBatchRows(estimatedRowSize);
     }
 
+    if (cachedBatches_ != nullptr) {
+      if (nextCachedBatch_ < cachedBatches_->size()) {
+        const auto& batch = (*cachedBatches_)[nextCachedBatch_++];
+        stats_.wlock()->addInputVector(
+            batch->estimateFlatSize(), batch->size());
+        return batch;
+      }
+      cachedBatches_.reset();
+      curStatus_ = "getOutput: task->splitFinished";
+      driverCtx_->task->splitFinished(true, currentSplitWeight_);
+      needNewSplit_ = true;
+      continue;
+    }
+
     const auto ioTimeStartMicros = getCurrentTimeMicro();
     // Check for  cancellation since scans that filter everything out will not
     // hit the check in Driver.
@@ -270,6 +292,16 @@ RowVectorPtr TableScan::getOutput() {
               {maxFilteringRatio_,
                1.0 * data->size() / readBatchSize,
                1.0 / kMaxSelectiveBatchSizeMultiplier});
+          // The data source may refine its estimate from the rows it has
+          // produced.
+          const auto estimatedRowSize = dataSource_->estimatedRowSize();
+          if (estimatedRowSize != connector::DataSource::kUnknownRowSize) {
+            readBatchSize_ = outputBatchRows(estimatedRowSize);
+          }
+          if (resultCacheKey_.has_value()) {
+            lockedStats.unlock();
+            addToResultCache(data);
+          }
           return data;
         }
         continue;
@@ -291,12 +323,59 @@ RowVectorPtr TableScan::getOutput() {
       }
     }
 
+    if (resultCacheKey_.has_value()) {
+      curStatus_ = "getOutput: caching split results";
+      FragmentResultCache::getInstance()->insert(
+          resultCacheKey_.value(), std::move(resultBatches_), resultBytes_);
+      abandonResultCache();
+    }
+
     curStatus_ = "getOutput: task->splitFinished";
     driverCtx_->task->splitFinished(true, currentSplitWeight_);
     needNewSplit_ = true;
   }
 }
 
+bool TableScan::startCachedSplit(connector::ConnectorSplit& split) {
+  abandonResultCache();
+  // Dynamic filters depend on the other side of a join, not on the split.
+  if (resultCacheFingerprint_.empty() || !dynamicFilters_.empty()) {
+    return false;
+  }
+  const auto splitKey = split.resultCacheKey();
+  if (!splitKey.has_value()) {
+    return false;
+  }
+  auto key = fmt::format("{} {}", resultCacheFingerprint_, splitKey.value());
+  cachedBatches_ = FragmentResultCache::getInstance()->find(key);
+  if (cachedBatches_ == nullptr) {
+    stats_.wlock()->addRuntimeStat(
+        "fragmentResultCacheMisses", RuntimeCounter(1));
+    resultCacheKey_ = std::move(key);
+    return false;
+  }
+  if (split.dataSource != nullptr) {
+    // The split has started preloading before it was found in the cache.
+    split.dataSource->close();
+  }
+  nextCachedBatch_ = 0;
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat("fragmentResultCacheHits", RuntimeCounter(1));
+  ++lockedStats->numSplits;
+  return true;
+}
+
+void TableScan::addToResultCache(const RowVectorPtr& data) {
+  auto* cache = FragmentResultCache::getInstance();
+  auto copy = cache->copy(data);
+  resultBytes_ += copy->retainedSize();
+  if (resultBytes_ > cache->capacity()) {
+    abandonResultCache();
+    return;
+  }
+  resultBatches_.push_back(std::move(copy));
+}
+
 void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
   // The AsyncSource returns a unique_ptr to the shared_ptr of the
   // DataSource. The callback may outlive the Task, hence it captures
@@ -371,7 +450,14 @@ void TableScan::addDynamicFilter(
   if (dataSource_) {
     dataSource_->addDynamicFilter(outputChannel, filter);
   }
-  dynamicFilters_.emplace(outputChannel, filter);
+  // The rest of the current split is filtered by 'filter'.
+  abandonResultCache();
+  // Filters on the same channel, e.g. the tightening thresholds of a TopN,
+  // all apply to the splits to come.
+  auto [it, inserted] = dynamicFilters_.emplace(outputChannel, filter);
+  if (!inserted) {
+    it->second = it->second->mergeWith(filter.get());
+  }
 }
 
 } // namespace facebook::velox::exec
@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/core/PlanNode.h"
+#include "velox/exec/FragmentResultCache.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
@@ -76,6 +77,23 @@ class TableScan : public SourceOperator {
   // done, it will be made when needed.
   void preload(std::shared_ptr<connector::ConnectorSplit> split);
 
+  // Looks up the results of 'split' in the FragmentResultCache. Returns true
+  // and sets 'cachedBatches_' if they are cached. Otherwise sets
+  // 'resultCacheKey_' if the results of 'split' are to be cached.
+  bool startCachedSplit(connector::ConnectorSplit& split);
+
+  // Adds a copy of 'data' to the results of the current split for the
+  // FragmentResultCache. Stops collecting if the results do not fit in the
+  // cache.
+  void addToResultCache(const RowVectorPtr& data);
+
+  // Stops collecting the results of the current split for the cache.
+  void abandonResultCache() {
+    resultCacheKey_.reset();
+    resultBatches_.clear();
+    resultBytes_ = 0;
+  }
+
   // Process-wide IO wait time.
   inline static std::atomic<uint64_t> ioWaitNanos_;
 
@@ -123,6 +141,21 @@ class TableScan : public SourceOperator {
 
   double maxFilteringRatio_{0};
 
+  // The fingerprint of the scan in the FragmentResultCache. Empty if the
+  // results are not cached.
+  const std::string resultCacheFingerprint_;
+
+  // The cached results of the current split and the index of the next batch
+  // to return. Null if the current split is read from its data source.
+  std::shared_ptr<const FragmentResultCache::Batches> cachedBatches_;
+  size_t nextCachedBatch_{0};
+
+  // The cache key of the current split if its results are being collected
+  // in 'resultBatches_' for the cache. 'resultBytes_' is their retained size.
+  std::optional<std::string> resultCacheKey_;
+  FragmentResultCache::Batches resultBatches_;
+  uint64_t resultBytes_{0};
+
   // String shown in ExceptionContext inside DataSource and LazyVector loading.
   std::string debugString_;
 
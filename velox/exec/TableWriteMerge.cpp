@@ -95,10 +95,11 @@ void TableWriteMerge::addInput(RowVectorPtr input) {
   }
   lastCommitContext_ = commitContext;
 
-  // Adds fragments to the buffer. Fragments will be emitted as soon as possible
-  // to avoid using extra memory.
+  // Adds fragments to the buffer. The fragments of many table writers are
+  // emitted together in batches of up to 'outputBatchRows()'.
   auto fragmentVector = input->childAt(TableWriteTraits::kFragmentChannel);
   if (containsNonNullRows(fragmentVector)) {
+    numFragmentRows_ += fragmentVector->size();
     fragmentVectors_.push(fragmentVector);
   }
 }
@@ -112,8 +113,11 @@ void TableWriteMerge::noMoreInput() {
 }
 
 RowVectorPtr TableWriteMerge::getOutput() {
-  // Passes through fragment pages first to avoid using extra memory.
-  if (!fragmentVectors_.empty()) {
+  // Passes through full batches of fragments first to avoid using extra
+  // memory.
+  if (!fragmentVectors_.empty() &&
+      (noMoreInput_ ||
+       numFragmentRows_ >= static_cast<vector_size_t>(outputBatchRows()))) {
     return createFragmentsOutput();
   }
 
@@ -138,7 +142,27 @@ RowVectorPtr TableWriteMerge::createFragmentsOutput() {
 
   auto outputFragmentVector = fragmentVectors_.front();
   fragmentVectors_.pop();
+  const vector_size_t maxOutputRows = outputBatchRows();
+  if (!fragmentVectors_.empty() &&
+      outputFragmentVector->size() + fragmentVectors_.front()->size() <=
+          maxOutputRows) {
+    // Copies the following fragment vectors that fit in the batch.
+    auto batch = BaseVector::create(
+        outputFragmentVector->type(), outputFragmentVector->size(), pool());
+    batch->copy(
+        outputFragmentVector.get(), 0, 0, outputFragmentVector->size());
+    while (!fragmentVectors_.empty() &&
+           batch->size() + fragmentVectors_.front()->size() <= maxOutputRows) {
+      const auto& fragments = fragmentVectors_.front();
+      const auto offset = batch->size();
+      batch->resize(offset + fragments->size());
+      batch->copy(fragments.get(), offset, 0, fragments->size());
+      fragmentVectors_.pop();
+    }
+    outputFragmentVector = std::move(batch);
+  }
   const int numOutputRows = outputFragmentVector->size();
+  numFragmentRows_ -= numOutputRows;
   std::vector<VectorPtr> outputColumns(outputType_->size());
   for (int outputChannel = 0; outputChannel < outputType_->size();
        ++outputChannel) {
@@ -70,6 +70,8 @@ class TableWriteMerge : public Operator {
   // The sum of written rows.
   int64_t numRows_{0};
   std::queue<VectorPtr> fragmentVectors_;
+  // The number of rows in 'fragmentVectors_'.
+  vector_size_t numFragmentRows_{0};
   folly::dynamic lastCommitContext_;
 };
 } // namespace facebook::velox::exec
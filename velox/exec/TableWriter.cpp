@@ -43,7 +43,9 @@ TableWriter::TableWriter(
           tableWriteNode->insertTableHandle()->connectorId())),
       insertTableHandle_(
           tableWriteNode->insertTableHandle()->connectorInsertTableHandle()),
-      commitStrategy_(tableWriteNode->commitStrategy()) {
+      commitStrategy_(tableWriteNode->commitStrategy()),
+      maxBufferedBytes_(
+          driverCtx_->queryConfig().tableWriterMaxBufferedBytes()) {
   setConnectorMemoryReclaimer();
   if (tableWriteNode->outputType()->size() == 1) {
     VELOX_USER_CHECK_NULL(tableWriteNode->aggregationNode());
@@ -107,6 +109,23 @@ void TableWriter::abortDataSink() {
   }
 }
 
+void TableWriter::maybeFlushDataSink() {
+  if (maxBufferedBytes_ == 0) {
+    return;
+  }
+  const int64_t bufferedBytes = connectorPool_->currentBytes();
+  if (bufferedBytes <= static_cast<int64_t>(maxBufferedBytes_)) {
+    return;
+  }
+  dataSink_->flush();
+  addRuntimeStat("numWriterFlushes", RuntimeCounter(1));
+  addRuntimeStat(
+      "writerFlushedBytes",
+      RuntimeCounter(
+          std::max<int64_t>(0, bufferedBytes - connectorPool_->currentBytes()),
+          RuntimeCounter::Unit::kBytes));
+}
+
 std::vector<std::string> TableWriter::closeDataSink() {
   // We only expect closeDataSink called once.
   VELOX_CHECK(!closed_);
@@ -136,6 +155,7 @@ void TableWriter::addInput(RowVectorPtr input) {
 
   dataSink_->appendData(mappedInput);
   numWrittenRows_ += input->size();
+  maybeFlushDataSink();
   updateStats(dataSink_->stats());
 
   if (aggregation_ != nullptr) {
@@ -187,6 +187,11 @@ class TableWriter : public Operator {
 
   void abortDataSink();
 
+  // Flushes the file writers of 'dataSink_' if the memory they buffer exceeds
+  // 'maxBufferedBytes_'. This keeps the memory of a long running write bounded
+  // as the buffered data goes out to the files while the scan keeps producing.
+  void maybeFlushDataSink();
+
   void updateStats(const connector::DataSink::Stats& stats);
 
   std::string createTableCommitContext(bool lastOutput);
@@ -198,6 +203,9 @@ class TableWriter : public Operator {
   const std::shared_ptr<connector::ConnectorInsertTableHandle>
       insertTableHandle_;
   const connector::CommitStrategy commitStrategy_;
+  // Maximum bytes buffered by the file writers before they are flushed. 0
+  // means no limit.
+  const uint64_t maxBufferedBytes_;
 
   std::unique_ptr<Operator> aggregation_;
   std::shared_ptr<connector::Connector> connector_;
@@ -16,6 +16,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <folly/String.h>
 #include <string>
 
 #include "velox/common/base/Counters.h"
@@ -29,6 +30,7 @@
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/Merge.h"
 #include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/exec/OperatorTrace.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
@@ -276,7 +278,51 @@ Task::Task(
       consumerSupplier_(std::move(consumerSupplier)),
       onError_(onError),
       splitsStates_(buildSplitStates(planFragment_.planNode)),
-      bufferManager_(OutputBufferManager::getInstance()) {}
+      bufferManager_(OutputBufferManager::getInstance()),
+      hasSplitPreloadBudget_(
+          queryCtx_->queryConfig().maxSplitPreloadBytes() > 0),
+      splitPreloadBudget_(queryCtx_->queryConfig().maxSplitPreloadBytes()),
+      timelineRecorder_(
+          queryCtx_->queryConfig().taskTraceEnabled()
+              ? std::make_unique<process::TimelineRecorder>(
+                    queryCtx_->queryConfig().taskTraceMaxEvents())
+              : nullptr) {
+  initOperatorTrace();
+}
+
+void Task::initOperatorTrace() {
+  const auto& queryConfig = queryCtx_->queryConfig();
+  const auto traceDir = queryConfig.operatorTraceDir();
+  if (traceDir.empty()) {
+    return;
+  }
+  std::vector<folly::StringPiece> nodeIds;
+  folly::split(',', queryConfig.operatorTraceNodeIds(), nodeIds, true);
+  for (const auto& nodeIdPiece : nodeIds) {
+    const auto nodeId = folly::trimWhitespace(nodeIdPiece).str();
+    const auto* node = core::PlanNode::findFirstNode(
+        planFragment_.planNode.get(),
+        [&](const core::PlanNode* node) { return node->id() == nodeId; });
+    // The plan node may be in the plan fragment of another stage.
+    if (node == nullptr) {
+      continue;
+    }
+    writeOperatorTraceSummary(
+        exec::operatorTraceDirectory(traceDir, taskId_, nodeId),
+        *node,
+        queryConfig.valuesCopy());
+    traceNodeIds_.insert(nodeId);
+  }
+  operatorTraceDir_ = traceDir;
+}
+
+std::string Task::operatorTraceDirectory(
+    const core::PlanNodeId& planNodeId) const {
+  if (traceNodeIds_.count(planNodeId) == 0) {
+    return "";
+  }
+  return exec::operatorTraceDirectory(operatorTraceDir_, taskId_, planNodeId);
+}
 
 Task::~Task() {
   // TODO(spershin): Temporary code designed to reveal what causes SIGABRT in
@@ -1117,7 +1163,7 @@ void Task::ensureSplitGroupsAreBeingProcessedLocked() {
   }
 
   while (numRunningSplitGroups_ < concurrentSplitGroups_ and
-         not queuedSplitGroups_.empty()) {
+         not queuedSplitGroups_.empty() and hasMemoryForSplitGroupLocked()) {
     const uint32_t splitGroupId = queuedSplitGroups_.front();
     queuedSplitGroups_.pop();
 
@@ -1143,6 +1189,23 @@ void Task::ensureSplitGroupsAreBeingProcessedLocked() {
   }
 }
 
+bool Task::hasMemoryForSplitGroupLocked() {
+  if (numRunningSplitGroups_ == 0 ||
+      !queryCtx_->queryConfig().adaptiveSplitGroupConcurrency()) {
+    return true;
+  }
+  // The memory of the running split groups is sampled each time a split group
+  // could start, i.e. when one is queued or finishes.
+  splitGroupBytesEstimate_ = std::max<uint64_t>(
+      splitGroupBytesEstimate_,
+      pool_->reservedBytes() / numRunningSplitGroups_);
+  auto* queryPool = queryCtx_->pool();
+  const int64_t headroom =
+      queryPool->maxCapacity() - queryPool->reservedBytes();
+  return headroom > 0 &&
+      static_cast<uint64_t>(headroom) >= splitGroupBytesEstimate_;
+}
+
 void Task::setMaxSplitSequenceId(
     const core::PlanNodeId& planNodeId,
     long maxSequenceId) {
@@ -1443,10 +1506,21 @@ exec::Split Task::getSplitLocked(
     const ConnectorSplitPreloadFunc& preload) {
   int32_t readySplitIndex = -1;
   if (maxPreloadSplits > 0) {
+    // Preloads start in the order the splits are taken, so once the budget is
+    // used up no later split starts preloading.
+    bool budgetExhausted = false;
     for (auto i = 0; i < splitsStore.splits.size() && i < maxPreloadSplits;
          ++i) {
       auto& connectorSplit = splitsStore.splits[i].connectorSplit;
       if (!connectorSplit->dataSource) {
+        if (hasSplitPreloadBudget_) {
+          budgetExhausted = budgetExhausted ||
+              !splitPreloadBudget_.canStart(connectorSplit->dataBytes());
+          if (budgetExhausted) {
+            continue;
+          }
+          splitPreloadBudget_.started(connectorSplit->dataBytes());
+        }
         // Initializes split->dataSource.
         preload(connectorSplit);
         preloadingSplits_.emplace(connectorSplit);
@@ -1463,6 +1537,18 @@ exec::Split Task::getSplitLocked(
   VELOX_CHECK(!splitsStore.splits.empty());
   auto split = std::move(splitsStore.splits[readySplitIndex]);
   splitsStore.splits.erase(splitsStore.splits.begin() + readySplitIndex);
+  if (hasSplitPreloadBudget_ && split.connectorSplit) {
+    const auto& dataSource = split.connectorSplit->dataSource;
+    std::optional<uint64_t> preloadMicros;
+    if (dataSource && dataSource->hasValue()) {
+      preloadMicros = dataSource->prepareTiming().wallNanos / 1'000;
+    }
+    splitPreloadBudget_.consumed(
+        split.connectorSplit->dataBytes(),
+        dataSource != nullptr,
+        preloadMicros,
+        getCurrentTimeMicro());
+  }
 
   --taskStats_.numQueuedSplits;
   ++taskStats_.numRunningSplits;
@@ -2011,6 +2097,13 @@ void Task::addDriverStats(int pipelineId, DriverStats stats) {
   taskStats_.pipelineStats[pipelineId].driverStats.push_back(std::move(stats));
 }
 
+std::string Task::exportTrace() const {
+  if (timelineRecorder_ == nullptr) {
+    return "";
+  }
+  return timelineRecorder_->toChromeTrace(taskId_);
+}
+
 TaskStats Task::taskStats() const {
   std::lock_guard<std::timed_mutex> l(mutex_);
 
@@ -2245,6 +2338,7 @@ folly::dynamic Task::toJson() const {
   obj["groupedPartitionedOutput"] = groupedPartitionedOutput_;
   obj["concurrentSplitGroups"] = concurrentSplitGroups_;
   obj["numRunningSplitGroups"] = numRunningSplitGroups_;
+  obj["splitGroupBytesEstimate"] = splitGroupBytesEstimate_;
   obj["numDriversUngrouped"] = numDriversUngrouped_;
   obj["partitionedOutputConsumed"] = partitionedOutputConsumed_;
   obj["noMoreOutputBuffers"] = noMoreOutputBuffers_;
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #pragma once
+#include "velox/common/base/AsyncSource.h"
+#include "velox/common/process/TimelineRecorder.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
@@ -21,6 +23,7 @@
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/Split.h"
+#include "velox/exec/SplitPreloadBudget.h"
 #include "velox/exec/TaskStats.h"
 #include "velox/exec/TaskStructs.h"
 #include "velox/vector/ComplexVector.h"
@@ -264,6 +267,19 @@ class Task : public std::enable_shared_from_this<Task> {
   /// structure.
   TaskStats taskStats() const;
 
+  /// Returns the recorder of the timeline of the drivers or nullptr if
+  /// QueryConfig::taskTraceEnabled() is not set.
+  process::TimelineRecorder* timelineRecorder() const {
+    return timelineRecorder_.get();
+  }
+
+  /// Returns the timeline of the drivers as a JSON trace in the Chrome trace
+  /// event format, loadable in chrome://tracing and Perfetto. Each driver is a
+  /// thread of the trace with intervals of being queued, on thread and
+  /// blocked, and the IO, memory arbitration and spill waits while on thread.
+  /// Returns an empty string if QueryConfig::taskTraceEnabled() is not set.
+  std::string exportTrace() const;
+
   /// Information about an operator call that helps debugging stuck calls.
   struct OpCallInfo {
     size_t durationMs;
@@ -563,6 +579,26 @@ class Task : public std::enable_shared_from_this<Task> {
     return terminateRequested_;
   }
 
+  /// Starts making the item of 'source' on the query executor so that
+  /// expensive operator setup is hidden behind other work. The consumer joins
+  /// the item with AsyncSource::move() on first use and makes it on its own
+  /// thread if the executor has not started it yet. A consumer that never
+  /// joins the item must close() 'source'. Does nothing if
+  /// kSpeculativePreparationEnabled is false or the query has no executor to
+  /// run it on.
+  template <typename Item>
+  void prepareSpeculatively(std::shared_ptr<AsyncSource<Item>> source) {
+    if (!queryCtx_->queryConfig().speculativePreparationEnabled()) {
+      return;
+    }
+    auto* executor = queryCtx_->executor();
+    if (executor == nullptr ||
+        dynamic_cast<const folly::InlineLikeExecutor*>(executor) != nullptr) {
+      return;
+    }
+    executor->add([source = std::move(source)]() { source->prepare(); });
+  }
+
   /// Requests the Task to stop activity.  The returned future is
   /// realized when all running threads have stopped running. Activity
   /// can be resumed with resume() after the future is realized.
@@ -621,6 +657,10 @@ class Task : public std::enable_shared_from_this<Task> {
     return spillDirectory_;
   }
 
+  /// Returns the directory the operators of 'planNodeId' write their input to
+  /// or an empty string if 'planNodeId' is not traced. See OperatorTrace.h.
+  std::string operatorTraceDirectory(const core::PlanNodeId& planNodeId) const;
+
   /// Returns the spill directory path. Ensures that the spill directory is
   /// created before returning. Is thread safe. Returns an empty string if
   /// either the spill directory is not specified during task creation or the
@@ -645,6 +685,14 @@ class Task : public std::enable_shared_from_this<Task> {
     terminate(TaskState::kFinished).wait();
   }
 
+  /// Sets the estimated memory of a split group used with
+  /// QueryConfig::kAdaptiveSplitGroupConcurrency. Later estimates can only
+  /// raise it.
+  void testingSetSplitGroupBytesEstimate(uint64_t bytes) {
+    std::lock_guard l(mutex_);
+    splitGroupBytesEstimate_ = bytes;
+  }
+
  private:
   Task(
       const std::string& taskId,
@@ -830,11 +878,20 @@ class Task : public std::enable_shared_from_this<Task> {
   // structure, which stores inter-operator state (local exchange, bridges).
   void createSplitGroupStateLocked(uint32_t splitGroupId);
 
+  // Writes the trace summaries of the plan nodes of
+  // QueryConfig::operatorTraceNodeIds() that are in the plan.
+  void initOperatorTrace();
+
   // Checks if we have splits in a split group that haven't been processed yet
   // and have capacity in terms of number of concurrent split groups being
   // processed. If yes, creates split group state and Drivers and runs them.
   void ensureSplitGroupsAreBeingProcessedLocked();
 
+  // Returns true if the query memory pool has room for another split group
+  // or if adaptive split group concurrency is off. Always true if no split
+  // group is running.
+  bool hasMemoryForSplitGroupLocked();
+
   void driverClosedLocked();
 
   // Returns true if Task is in kRunning state, but all output drivers finished
@@ -1048,6 +1105,10 @@ class Task : public std::enable_shared_from_this<Task> {
   /// How many splits groups we are processing at the moment. Used to control
   /// split group concurrency. Ungrouped Split Group is not included here.
   uint32_t numRunningSplitGroups_{0};
+  /// Largest memory use per running split group seen so far, sampled as the
+  /// task memory divided by the number of running split groups. Used with
+  /// QueryConfig::kAdaptiveSplitGroupConcurrency.
+  uint64_t splitGroupBytesEstimate_{0};
   /// Split groups for which we have received at least one split - meaning our
   /// task is to process these. This set only grows. Used to deduplicate split
   /// groups for different nodes and to determine how many split groups we to
@@ -1108,6 +1169,12 @@ class Task : public std::enable_shared_from_this<Task> {
   // Base spill directory for this task.
   std::string spillDirectory_;
 
+  // QueryConfig::operatorTraceDir() if any of 'traceNodeIds_' is in the plan.
+  std::string operatorTraceDir_;
+
+  // The plan nodes of QueryConfig::operatorTraceNodeIds() in the plan.
+  std::unordered_set<core::PlanNodeId> traceNodeIds_;
+
   // Mutex to ensure only the first caller thread of 'getOrCreateSpillDirectory'
   // creates the directory.
   mutable std::mutex spillDirCreateMutex_;
@@ -1118,6 +1185,15 @@ class Task : public std::enable_shared_from_this<Task> {
   // Stores unconsumed preloading splits to ensure they are closed promptly.
   folly::F14FastSet<std::shared_ptr<connector::ConnectorSplit>>
       preloadingSplits_;
+
+  // Limits the bytes of the splits preloading if
+  // QueryConfig::maxSplitPreloadBytes() is set.
+  const bool hasSplitPreloadBudget_;
+  SplitPreloadBudget splitPreloadBudget_;
+
+  // Records the timeline of the drivers if QueryConfig::taskTraceEnabled() is
+  // set.
+  const std::unique_ptr<process::TimelineRecorder> timelineRecorder_;
 };
 
 /// Listener invoked on task completion.
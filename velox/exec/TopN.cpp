@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <folly/container/F14Map.h>
+#include <numeric>
 
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/TopN.h"
@@ -31,6 +32,9 @@ TopN::TopN(
           topNNode->id(),
           "TopN"),
       count_(topNNode->count()),
+      firstSortOrder_(topNNode->sortingOrders()[0]),
+      thresholdFilterEnabled_(
+          driverCtx->queryConfig().topNDynamicFilterEnabled()),
       data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
       comparator_(
           outputType_,
@@ -58,6 +62,9 @@ TopN::TopN(
 }
 
 void TopN::addInput(RowVectorPtr input) {
+  if (!thresholdFilterInitialized_) {
+    initializeThresholdFilter();
+  }
   for (const auto col : sortingKeyColumns_) {
     decodedVectors_[col].decode(*input->childAt(col));
   }
@@ -104,6 +111,88 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+  updateThresholdFilter();
+}
+
+void TopN::initializeThresholdFilter() {
+  thresholdFilterInitialized_ = true;
+  if (!thresholdFilterEnabled_) {
+    return;
+  }
+  const auto channel = sortingKeyColumns_[0];
+  switch (outputType_->childAt(channel)->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::TIMESTAMP:
+      break;
+    default:
+      return;
+  }
+  const auto channels =
+      operatorCtx_->driverCtx()->driver->canPushdownFilters(this, {channel});
+  if (channels.count(channel) != 0) {
+    thresholdFilterChannel_ = channel;
+  }
+}
+
+void TopN::updateThresholdFilter() {
+  if (!thresholdFilterChannel_.has_value() || topRows_.size() < count_) {
+    return;
+  }
+  const char* topRow = topRows_.top();
+  const auto column = data_->columnAt(*thresholdFilterChannel_);
+  if (RowContainer::isNullAt(topRow, column)) {
+    // The rows that may still enter the top rows have any first key.
+    return;
+  }
+
+  const auto channel = thresholdFilterChannel_.value();
+  const bool ascending = firstSortOrder_.isAscending();
+  // Null keys pass if they sort before the non-null keys.
+  const bool nullAllowed = firstSortOrder_.isNullsFirst();
+  const auto offset = column.offset();
+  std::unique_ptr<common::Filter> filter;
+  int64_t threshold;
+  const auto kind = outputType_->childAt(channel)->kind();
+  if (kind == TypeKind::TIMESTAMP) {
+    const auto value = RowContainer::valueAt<Timestamp>(topRow, offset);
+    threshold = value.toMicros();
+    if (threshold_ == threshold) {
+      return;
+    }
+    filter = std::make_unique<common::TimestampRange>(
+        ascending ? Timestamp::min() : value,
+        ascending ? value : Timestamp::max(),
+        nullAllowed);
+  } else {
+    switch (kind) {
+      case TypeKind::TINYINT:
+        threshold = RowContainer::valueAt<int8_t>(topRow, offset);
+        break;
+      case TypeKind::SMALLINT:
+        threshold = RowContainer::valueAt<int16_t>(topRow, offset);
+        break;
+      case TypeKind::INTEGER:
+        threshold = RowContainer::valueAt<int32_t>(topRow, offset);
+        break;
+      default:
+        threshold = RowContainer::valueAt<int64_t>(topRow, offset);
+        break;
+    }
+    if (threshold_ == threshold) {
+      return;
+    }
+    filter = std::make_unique<common::BigintRange>(
+        ascending ? std::numeric_limits<int64_t>::min() : threshold,
+        ascending ? threshold : std::numeric_limits<int64_t>::max(),
+        nullAllowed);
+  }
+  // Rows that tie with the worst top row on the first key may still enter on
+  // the other keys, so the filter includes the threshold.
+  threshold_ = threshold;
+  dynamicFilters_[channel] = std::move(filter);
 }
 
 RowVectorPtr TopN::getOutput() {
@@ -118,13 +207,13 @@ RowVectorPtr TopN::getOutput() {
   auto result = BaseVector::create<RowVector>(
       outputType_, numRowsToReturn, operatorCtx_->pool());
 
-  for (auto i = 0; i < outputType_->size(); ++i) {
-    data_->extractColumn(
-        rows_.data() + numRowsReturned_,
-        numRowsToReturn,
-        i,
-        result->childAt(i));
-  }
+  std::vector<column_index_t> columns(outputType_->size());
+  std::iota(columns.begin(), columns.end(), 0);
+  data_->extractColumns(
+      rows_.data() + numRowsReturned_,
+      numRowsToReturn,
+      columns,
+      result->children());
   numRowsReturned_ += numRowsToReturn;
   finished_ = (numRowsReturned_ == rows_.size());
   return result;
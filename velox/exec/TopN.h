@@ -44,7 +44,18 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Decides on the first input whether to push down a filter on the first
+  // sort key. Requires an integer or timestamp key that an upstream operator
+  // accepts filters on.
+  void initializeThresholdFilter();
+
+  // Pushes down a filter that passes the values of the first sort key that
+  // may still enter 'topRows_' if the worst of the top rows has changed.
+  void updateThresholdFilter();
+
   const int32_t count_;
+  const core::SortOrder firstSortOrder_;
+  const bool thresholdFilterEnabled_;
 
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
@@ -68,5 +79,13 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // True after initializeThresholdFilter().
+  bool thresholdFilterInitialized_{false};
+  // The channel of the first sort key if a filter on it is pushed down.
+  std::optional<column_index_t> thresholdFilterChannel_;
+  // The first sort key of the worst top row at the last filter pushdown.
+  // Timestamps are in microseconds.
+  std::optional<int64_t> threshold_;
 };
 } // namespace facebook::velox::exec
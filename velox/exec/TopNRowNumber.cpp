@@ -287,7 +287,8 @@ void TopNRowNumber::noMoreInput() {
 
     VELOX_CHECK_NULL(merge_);
     auto spillPartition = spiller_->finishSpill();
-    merge_ = spillPartition.createOrderedReader(pool(), &spillStats_);
+    merge_ = spillPartition.createOrderedReader(
+        pool(), &spillStats_, spillConfig()->readAheadExecutor());
   } else {
     outputRows_.resize(outputBatchSize_);
   }
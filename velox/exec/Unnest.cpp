@@ -114,73 +114,97 @@ RowVectorPtr Unnest::getOutput() {
   }
 
   const auto size = input_->size();
-  const auto maxOutputSize = outputBatchRows();
-
-  // Limit the number of input rows to keep output batch size within
-  // 'maxOutputSize' if possible. Process each input row fully. Do not break
-  // single row's output into multiple batches.
-  vector_size_t numInput = 0;
-  vector_size_t numElements = 0;
-  for (auto row = nextInputRow_; row < size; ++row) {
-    numElements += rawMaxSizes_[row];
-    ++numInput;
-
-    if (numElements >= maxOutputSize) {
-      break;
-    }
-  }
-
-  if (numElements == 0) {
-    // All arrays/maps are null or empty.
+  const auto range = nextRowRange();
+  if (range.numElements == 0) {
+    // All remaining arrays/maps are null or empty.
     input_ = nullptr;
     nextInputRow_ = 0;
+    nextInputRowOffset_ = 0;
     return nullptr;
   }
 
-  auto output = generateOutput(nextInputRow_, numInput, numElements);
+  auto output = generateOutput(range);
 
-  nextInputRow_ += numInput;
+  const auto lastRow = range.start + range.size - 1;
+  if (range.lastRowEnd < rawMaxSizes_[lastRow]) {
+    // The rest of the last row goes in the next batch.
+    nextInputRow_ = lastRow;
+    nextInputRowOffset_ = range.lastRowEnd;
+  } else {
+    nextInputRow_ = lastRow + 1;
+    nextInputRowOffset_ = 0;
+  }
 
   if (nextInputRow_ >= size) {
     input_ = nullptr;
     nextInputRow_ = 0;
+    nextInputRowOffset_ = 0;
   }
 
   return output;
 }
 
+Unnest::RowRange Unnest::nextRowRange() const {
+  const auto size = input_->size();
+  const vector_size_t maxOutputSize = outputBatchRows();
+
+  // Take the input rows until the elements fill a batch. Split the elements
+  // of the row that does not fit whole.
+  RowRange range{nextInputRow_, 0, nextInputRowOffset_, 0, 0};
+  for (auto row = nextInputRow_; row < size; ++row) {
+    const auto begin = row == nextInputRow_ ? nextInputRowOffset_ : 0;
+    const auto numRemaining = rawMaxSizes_[row] - begin;
+    ++range.size;
+    if (range.numElements + numRemaining >= maxOutputSize) {
+      range.lastRowEnd = begin + maxOutputSize - range.numElements;
+      range.numElements = maxOutputSize;
+      break;
+    }
+    range.numElements += numRemaining;
+    range.lastRowEnd = rawMaxSizes_[row];
+  }
+  return range;
+}
+
 void Unnest::generateRepeatedColumns(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements,
+    const RowRange& range,
     std::vector<VectorPtr>& outputs) {
+  if (range.size == 1) {
+    // All the output rows come from one input row.
+    for (const auto& projection : identityProjections_) {
+      outputs.at(projection.outputChannel) = BaseVector::wrapInConstant(
+          range.numElements,
+          range.start,
+          input_->childAt(projection.inputChannel));
+    }
+    return;
+  }
+
   // Create "indices" buffer to repeat rows as many times as there are elements
   // in the array (or map) in unnestDecoded.
-  auto repeatedIndices = allocateIndices(numElements, pool());
+  auto repeatedIndices = allocateIndices(range.numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
-  vector_size_t index = 0;
-  for (auto row = start; row < start + size; ++row) {
-    for (auto i = 0; i < rawMaxSizes_[row]; i++) {
-      rawRepeatedIndices[index++] = row;
-    }
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    std::fill(rawRepeatedIndices, rawRepeatedIndices + end - begin, row);
+    rawRepeatedIndices += end - begin;
+  });
 
   // Wrap "replicated" columns in a dictionary using 'repeatedIndices'.
   for (const auto& projection : identityProjections_) {
     outputs.at(projection.outputChannel) = wrapChild(
-        numElements, repeatedIndices, input_->childAt(projection.inputChannel));
+        range.numElements,
+        repeatedIndices,
+        input_->childAt(projection.inputChannel));
   }
 }
 
 const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
     column_index_t channel,
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
-  BufferPtr elementIndices = allocateIndices(numElements, pool());
+    const RowRange& range) {
+  BufferPtr elementIndices = allocateIndices(range.numElements, pool());
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
-  auto nulls = allocateNulls(numElements, pool());
+  auto nulls = allocateNulls(range.numElements, pool());
   auto rawNulls = nulls->asMutable<uint64_t>();
 
   auto& currentDecoded = unnestDecoded_[channel];
@@ -191,107 +215,115 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
   bool identityMapping = true;
-  for (auto row = start; row < start + size; ++row) {
-    auto maxSize = rawMaxSizes_[row];
+  vector_size_t firstElement = 0;
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    if (begin == end) {
+      return;
+    }
 
     if (!currentDecoded.isNullAt(row)) {
-      auto offset = currentOffsets[currentIndices[row]];
-      auto unnestSize = currentSizes[currentIndices[row]];
+      const auto offset = currentOffsets[currentIndices[row]];
+      const auto unnestSize = currentSizes[currentIndices[row]];
 
-      if (index != offset || unnestSize < maxSize) {
+      if (index == 0) {
+        firstElement = offset + begin;
+      }
+      if (offset + begin != firstElement + index || unnestSize < end) {
         identityMapping = false;
       }
 
-      for (auto i = 0; i < unnestSize; i++) {
+      for (auto i = begin; i < std::min(end, unnestSize); i++) {
         rawElementIndices[index++] = offset + i;
       }
 
-      for (auto i = unnestSize; i < maxSize; ++i) {
+      for (auto i = std::max(begin, unnestSize); i < end; ++i) {
         bits::setNull(rawNulls, index++, true);
       }
-    } else if (maxSize > 0) {
+    } else {
       identityMapping = false;
 
-      for (auto i = 0; i < maxSize; ++i) {
+      for (auto i = begin; i < end; ++i) {
         bits::setNull(rawNulls, index++, true);
       }
     }
+  });
+  return {elementIndices, nulls, identityMapping, firstElement};
+}
+
+VectorPtr Unnest::wrapElements(
+    const UnnestChannelEncoding& encoding,
+    vector_size_t numElements,
+    const VectorPtr& elements) const {
+  if (!encoding.identityMapping) {
+    return wrapChild(numElements, encoding.indices, elements, encoding.nulls);
+  }
+  if (encoding.firstElement == 0) {
+    return elements;
   }
-  return {elementIndices, nulls, identityMapping};
+  return elements->slice(encoding.firstElement, numElements);
 }
 
-VectorPtr Unnest::generateOrdinalityVector(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
-  auto ordinalityVector =
-      BaseVector::create<FlatVector<int64_t>>(BIGINT(), numElements, pool());
+VectorPtr Unnest::generateOrdinalityVector(const RowRange& range) {
+  auto ordinalityVector = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), range.numElements, pool());
 
   // Set the ordinality at each result row to be the index of the element in
   // the original array (or map) plus one.
   auto rawOrdinality = ordinalityVector->mutableRawValues();
-  for (auto row = start; row < start + size; ++row) {
-    auto maxSize = rawMaxSizes_[row];
-    std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-    rawOrdinality += maxSize;
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto /*row*/, auto begin, auto end) {
+    std::iota(
+        rawOrdinality,
+        rawOrdinality + end - begin,
+        static_cast<int64_t>(begin) + 1);
+    rawOrdinality += end - begin;
+  });
 
   return ordinalityVector;
 }
 
-RowVectorPtr Unnest::generateOutput(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
+RowVectorPtr Unnest::generateOutput(const RowRange& range) {
   std::vector<VectorPtr> outputs(outputType_->size());
-  generateRepeatedColumns(start, size, numElements, outputs);
+  generateRepeatedColumns(range, outputs);
 
   // Create unnest columns.
   vector_size_t outputsIndex = identityProjections_.size();
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     auto& currentDecoded = unnestDecoded_[channel];
-    auto unnestChannelEncoding =
-        generateEncodingForChannel(channel, start, size, numElements);
+    const auto unnestChannelEncoding =
+        generateEncodingForChannel(channel, range);
 
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
       // Construct unnest column using Array elements wrapped using above
       // created dictionary.
       auto unnestBaseArray = currentDecoded.base()->as<ArrayVector>();
-      outputs[outputsIndex++] = unnestChannelEncoding.identityMapping
-          ? unnestBaseArray->elements()
-          : wrapChild(
-                numElements,
-                unnestChannelEncoding.indices,
-                unnestBaseArray->elements(),
-                unnestChannelEncoding.nulls);
+      outputs[outputsIndex++] = wrapElements(
+          unnestChannelEncoding,
+          range.numElements,
+          unnestBaseArray->elements());
     } else {
       // Construct two unnest columns for Map keys and values vectors wrapped
       // using above created dictionary.
       auto unnestBaseMap = currentDecoded.base()->as<MapVector>();
-      outputs[outputsIndex++] = unnestChannelEncoding.identityMapping
-          ? unnestBaseMap->mapKeys()
-          : wrapChild(
-                numElements,
-                unnestChannelEncoding.indices,
-                unnestBaseMap->mapKeys(),
-                unnestChannelEncoding.nulls);
-      outputs[outputsIndex++] = unnestChannelEncoding.identityMapping
-          ? unnestBaseMap->mapValues()
-          : wrapChild(
-                numElements,
-                unnestChannelEncoding.indices,
-                unnestBaseMap->mapValues(),
-                unnestChannelEncoding.nulls);
+      outputs[outputsIndex++] = wrapElements(
+          unnestChannelEncoding, range.numElements, unnestBaseMap->mapKeys());
+      outputs[outputsIndex++] = wrapElements(
+          unnestChannelEncoding,
+          range.numElements,
+          unnestBaseMap->mapValues());
     }
   }
 
   if (withOrdinality_) {
     // Ordinality column is always at the end.
-    outputs.back() = generateOrdinalityVector(start, size, numElements);
+    outputs.back() = generateOrdinalityVector(range);
   }
 
   return std::make_shared<RowVector>(
-      pool(), outputType_, BufferPtr(nullptr), numElements, std::move(outputs));
+      pool(),
+      outputType_,
+      BufferPtr(nullptr),
+      range.numElements,
+      std::move(outputs));
 }
 
 bool Unnest::isFinished() {
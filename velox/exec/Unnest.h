@@ -39,43 +39,71 @@ class Unnest : public Operator {
   bool isFinished() override;
 
  private:
-  // Generate output for 'size' input rows starting from 'start' input row.
-  //
-  // @param start First input row to include in the output.
-  // @param size Number of input rows to include in the output.
-  // @param outputSize Pre-computed number of output rows.
-  RowVectorPtr generateOutput(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t outputSize);
+  // The input rows for one output batch. The elements of the first and the
+  // last row may be split across batches, so that a batch does not exceed
+  // the preferred output size even for huge arrays or maps.
+  struct RowRange {
+    // First input row.
+    vector_size_t start;
+    // Number of input rows.
+    vector_size_t size;
+    // The first element of the first row that goes in the batch.
+    vector_size_t firstRowStart;
+    // One past the last element of the last row that goes in the batch.
+    vector_size_t lastRowEnd;
+    // Number of output rows.
+    vector_size_t numElements;
+
+    // Calls 'func(row, begin, end)' for each input row with the range of its
+    // elements that goes in the batch.
+    template <typename F>
+    void forEachRow(const vector_size_t* maxSizes, F func) const {
+      for (auto row = start; row < start + size; ++row) {
+        const auto begin = row == start ? firstRowStart : 0;
+        const auto end = row == start + size - 1 ? lastRowEnd : maxSizes[row];
+        func(row, begin, end);
+      }
+    }
+  };
+
+  // Returns the input rows of the next output batch starting at
+  // 'nextInputRow_' and 'nextInputRowOffset_'. The batch has at most
+  // outputBatchRows() rows.
+  RowRange nextRowRange() const;
+
+  // Generates the output for 'range'.
+  RowVectorPtr generateOutput(const RowRange& range);
 
   // Invoked by generateOutput function above to generate the repeated output
   // columns.
   void generateRepeatedColumns(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements,
+      const RowRange& range,
       std::vector<VectorPtr>& outputs);
 
   struct UnnestChannelEncoding {
     BufferPtr indices;
     BufferPtr nulls;
+    // True if the elements of the batch are a contiguous run of the base
+    // elements starting at 'firstElement' without nulls added.
     bool identityMapping;
+    vector_size_t firstElement;
   };
 
   // Invoked by generateOutput above to generate the encoding for the unnested
   // Array or Map.
   const UnnestChannelEncoding generateEncodingForChannel(
       column_index_t channel,
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements);
+      const RowRange& range);
+
+  // Returns 'elements' wrapped in 'encoding' or the slice of 'elements' if
+  // the mapping is an identity.
+  VectorPtr wrapElements(
+      const UnnestChannelEncoding& encoding,
+      vector_size_t numElements,
+      const VectorPtr& elements) const;
 
   // Invoked by generateOutput for the ordinality column.
-  VectorPtr generateOrdinalityVector(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements);
+  VectorPtr generateOrdinalityVector(const RowRange& range);
 
   const bool withOrdinality_;
   std::vector<column_index_t> unnestChannels_;
@@ -92,5 +120,8 @@ class Unnest : public Operator {
 
   // Next 'input_' row to process in getOutput().
   vector_size_t nextInputRow_{0};
+
+  // The number of elements of 'nextInputRow_' produced by earlier batches.
+  vector_size_t nextInputRowOffset_{0};
 };
 } // namespace facebook::velox::exec
@@ -77,6 +77,18 @@ void VectorHasher::hashValues(
     rows.applyToSelected([&](vector_size_t row) {
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
+  } else if (isDictionaryTracked()) {
+    rows.applyToSelected([&](vector_size_t row) {
+      if (decoded_.isNullAt(row)) {
+        result[row] = mix ? bits::hashMix(result[row], kNullHash) : kNullHash;
+        return;
+      }
+      uint64_t& hash = dictionaryHashes_[decoded_.index(row)];
+      if (hash == kNullHash) {
+        hash = hashOne<Kind>(decoded_, row);
+      }
+      result[row] = mix ? bits::hashMix(result[row], hash) : hash;
+    });
   } else if (
       !decoded_.isIdentityMapping() &&
       rows.countSelected() > decoded_.base()->size()) {
@@ -242,8 +254,13 @@ template <typename T, bool mayHaveNulls>
 bool VectorHasher::makeValueIdsDecoded(
     const SelectivityVector& rows,
     uint64_t* result) {
-  cachedHashes_.resize(decoded_.base()->size());
-  std::fill(cachedHashes_.begin(), cachedHashes_.end(), 0);
+  // The ids of the entries of a tracked dictionary are kept across batches.
+  const bool reuseIds = isDictionaryTracked();
+  auto& ids = reuseIds ? dictionaryValueIds_ : cachedHashes_;
+  if (!reuseIds) {
+    cachedHashes_.resize(decoded_.base()->size());
+    std::fill(cachedHashes_.begin(), cachedHashes_.end(), 0);
+  }
 
   auto indices = decoded_.indices();
   auto values = decoded_.data<T>();
@@ -261,7 +278,7 @@ bool VectorHasher::makeValueIdsDecoded(
     }
 
     auto baseIndex = indices[row];
-    uint64_t& id = cachedHashes_[baseIndex];
+    uint64_t& id = ids[baseIndex];
 
     if (success) {
       if (id == 0) {
@@ -282,9 +299,14 @@ bool VectorHasher::makeValueIdsDecoded(
       }
     }
 
-    return success || numCachedHashes < cachedHashes_.size();
+    return success || numCachedHashes < ids.size();
   });
 
+  if (!success && reuseIds) {
+    // Drops the kUnmappable markers. The ids change after the caller
+    // switches to a mapping that covers the new values.
+    resetDictionaryValueIds();
+  }
   return success;
 }
 
@@ -520,6 +542,20 @@ void VectorHasher::lookupValueIds(
       result.data());
 }
 
+void VectorHasher::trackDictionary(const BaseVector& vector) {
+  if (vector.encoding() != VectorEncoding::Simple::DICTIONARY ||
+      !vector.valueVector()->isFlatEncoding() ||
+      vector.valueVector() == dictionary_) {
+    return;
+  }
+  dictionary_ = vector.valueVector();
+  const auto size = dictionary_->size();
+  dictionaryHashes_.resize(size);
+  std::fill(dictionaryHashes_.begin(), dictionaryHashes_.end(), kNullHash);
+  dictionaryValueIds_.resize(size);
+  resetDictionaryValueIds();
+}
+
 void VectorHasher::hash(
     const SelectivityVector& rows,
     bool mix,
@@ -625,6 +661,7 @@ void VectorHasher::setDistinctOverflow() {
   uniqueValues_.clear();
   uniqueValuesStorage_.clear();
   distinctStringsBytes_ = 0;
+  resetDictionaryValueIds();
 }
 
 void VectorHasher::setRangeOverflow() {
@@ -776,6 +813,7 @@ uint64_t VectorHasher::enableValueIds(uint64_t multiplier, int32_t reservePct) {
   multiplier_ = multiplier;
   rangeSize_ = addIdReserve(uniqueValues_.size(), reservePct) + 1;
   isRange_ = false;
+  resetDictionaryValueIds();
   uint64_t result;
   if (__builtin_mul_overflow(multiplier_, rangeSize_, &result)) {
     return kRangeTooLarge;
@@ -791,6 +829,7 @@ uint64_t VectorHasher::enableValueRange(
   VELOX_CHECK(hasRange_);
   extendRange(type_->kind(), reservePct, min_, max_);
   isRange_ = true;
+  resetDictionaryValueIds();
   // No overflow because max range is under 63 bits.
   if (typeKind_ == TypeKind::BOOLEAN) {
     rangeSize_ = 3;
@@ -812,6 +851,7 @@ void VectorHasher::copyStatsFrom(const VectorHasher& other) {
   min_ = other.min_;
   max_ = other.max_;
   uniqueValues_ = other.uniqueValues_;
+  resetDictionaryValueIds();
 }
 
 void VectorHasher::merge(const VectorHasher& other) {
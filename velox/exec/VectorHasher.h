@@ -171,6 +171,9 @@ class VectorHasher {
         type_->toString(),
         vector.type()->toString());
     decoded_.decode(vector, rows);
+    if (typeKind_ == TypeKind::VARCHAR || typeKind_ == TypeKind::VARBINARY) {
+      trackDictionary(vector);
+    }
   }
 
   DecodedVector& decodedVector() {
@@ -247,6 +250,7 @@ class VectorHasher {
   void resetStats() {
     uniqueValues_.clear();
     uniqueValuesStorage_.clear();
+    resetDictionaryValueIds();
   }
 
   // Sets 'this' to range mode and adds 'reservePct' values to the
@@ -534,6 +538,21 @@ class VectorHasher {
   template <TypeKind Kind>
   void hashValues(const SelectivityVector& rows, bool mix, uint64_t* result);
 
+  // Keeps the dictionary of 'vector' if it is a single level dictionary over
+  // a flat vector and it differs from 'dictionary_'.
+  void trackDictionary(const BaseVector& vector);
+
+  // True if the last decoded vector is a dictionary over 'dictionary_'.
+  bool isDictionaryTracked() const {
+    return dictionary_ != nullptr && decoded_.base() == dictionary_.get();
+  }
+
+  // Forgets the value ids of the entries of 'dictionary_'. Called when the
+  // mapping of values to ids changes.
+  void resetDictionaryValueIds() {
+    std::fill(dictionaryValueIds_.begin(), dictionaryValueIds_.end(), 0);
+  }
+
   const column_index_t channel_;
   const TypePtr type_;
   const TypeKind typeKind_;
@@ -541,6 +560,15 @@ class VectorHasher {
   DecodedVector decoded_;
   raw_vector<uint64_t> cachedHashes_;
 
+  // The base of the last decoded dictionary encoded string vector with the
+  // hashes and value ids of its entries computed so far. Readers return
+  // consecutive batches of a dictionary encoded column over the same
+  // dictionary, so that each distinct string is hashed once per dictionary
+  // instead of once per batch. kNullHash and 0 mark entries not computed yet.
+  VectorPtr dictionary_;
+  raw_vector<uint64_t> dictionaryHashes_;
+  raw_vector<uint64_t> dictionaryValueIds_;
+
   // Single precomputed hash for constant partition keys.
   uint64_t precomputedHash_{0};
 
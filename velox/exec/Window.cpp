@@ -15,12 +15,44 @@
  */
 #include "velox/exec/Window.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/RowsStreamingWindowBuild.h"
 #include "velox/exec/SortWindowBuild.h"
 #include "velox/exec/StreamingWindowBuild.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 
+namespace {
+// Returns true if all window functions of 'windowNode' can be computed while
+// the rows of a partition arrive. Functions that depend on their frame are
+// streamed for frames from UNBOUNDED PRECEDING to CURRENT ROW only. The other
+// functions are only computed on frames that do not read any other rows than
+// the processed ones.
+bool supportsRowsStreaming(const core::WindowNode& windowNode) {
+  for (const auto& function : windowNode.windowFunctions()) {
+    const auto metadata =
+        getWindowFunctionMetadata(function.functionCall->name());
+    if (!metadata.has_value() || !metadata->supportsStreaming) {
+      return false;
+    }
+    const auto& frame = function.frame;
+    if (metadata->ignoresFrame) {
+      // Bounds of k RANGE frames are searched in the rows of the partition.
+      if (frame.type == core::WindowNode::WindowType::kRange &&
+          (frame.startValue != nullptr || frame.endValue != nullptr)) {
+        return false;
+      }
+      continue;
+    }
+    if (frame.startType != core::WindowNode::BoundType::kUnboundedPreceding ||
+        frame.endType != core::WindowNode::BoundType::kCurrentRow) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 Window::Window(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -41,11 +73,28 @@ Window::Window(
   auto* spillConfig =
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
   if (windowNode->inputsSorted()) {
-    windowBuild_ = std::make_unique<StreamingWindowBuild>(
-        windowNode, pool(), spillConfig, &nonReclaimableSection_);
+    if (supportsRowsStreaming(*windowNode)) {
+      windowBuild_ = std::make_unique<RowsStreamingWindowBuild>(
+          windowNode, pool(), spillConfig, &nonReclaimableSection_);
+    } else {
+      windowBuild_ = std::make_unique<StreamingWindowBuild>(
+          windowNode, pool(), spillConfig, &nonReclaimableSection_);
+    }
   } else {
+    const auto& queryConfig = driverCtx->queryConfig();
     windowBuild_ = std::make_unique<SortWindowBuild>(
-        windowNode, pool(), spillConfig, &nonReclaimableSection_, &spillStats_);
+        windowNode,
+        pool(),
+        spillConfig,
+        &nonReclaimableSection_,
+        &spillStats_,
+        PrefixSortConfig{
+            queryConfig.prefixSortNormalizedKeyMaxBytes(),
+            queryConfig.prefixSortMinRows(),
+            queryConfig.prefixSortRadixSortMinRows(),
+            driverCtx->task->queryCtx()->executor()},
+        supportsRowsStreaming(*windowNode),
+        queryConfig.preferredOutputBatchRows());
   }
 }
 
@@ -562,6 +611,9 @@ void Window::callApplyForPartitionRows(
   vector_size_t numRows = endRow - startRow;
   numProcessedRows_ += numRows;
   partitionOffset_ += numRows;
+  if (currentPartition_->isPartial()) {
+    currentPartition_->removeProcessedRows(partitionOffset_);
+  }
 }
 
 vector_size_t Window::callApplyLoop(
@@ -576,17 +628,28 @@ vector_size_t Window::callApplyLoop(
   VELOX_DCHECK_NOT_NULL(currentPartition_);
   while (numOutputRowsLeft > 0) {
     auto rowsForCurrentPartition =
-        currentPartition_->numRows() - partitionOffset_;
+        currentPartition_->numRowsForProcessing(partitionOffset_);
     if (rowsForCurrentPartition <= numOutputRowsLeft) {
       // Current partition can fit completely in the output buffer.
       // So output all its rows.
-      callApplyForPartitionRows(
-          partitionOffset_,
-          partitionOffset_ + rowsForCurrentPartition,
-          resultIndex,
-          result);
-      resultIndex += rowsForCurrentPartition;
-      numOutputRowsLeft -= rowsForCurrentPartition;
+      if (rowsForCurrentPartition > 0) {
+        callApplyForPartitionRows(
+            partitionOffset_,
+            partitionOffset_ + rowsForCurrentPartition,
+            resultIndex,
+            result);
+        resultIndex += rowsForCurrentPartition;
+        numOutputRowsLeft -= rowsForCurrentPartition;
+      }
+      if (!currentPartition_->isComplete()) {
+        // The build may restore more rows of the partition from spilled data.
+        if (noMoreInput_ && windowBuild_->loadMoreRows()) {
+          continue;
+        }
+        // The rest of the rows of the partial partition are not available
+        // yet. So break until the next getOutput call.
+        break;
+      }
       callResetPartition();
       if (!currentPartition_) {
         // The WindowBuild doesn't have any more partitions to process right
@@ -635,6 +698,9 @@ RowVectorPtr Window::getOutput() {
 
   // Compute the output values of window functions.
   auto numResultRows = callApplyLoop(numOutputRows, result);
+  if (numResultRows == 0) {
+    return nullptr;
+  }
   return numResultRows < numOutputRows
       ? std::dynamic_pointer_cast<RowVector>(result->slice(0, numResultRows))
       : result;
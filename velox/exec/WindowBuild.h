@@ -67,8 +67,17 @@ class WindowBuild {
   // to pass along to the WindowFunction. The WindowPartition has APIs to access
   // the underlying columns of Window partition data.
   // Check hasNextPartition() before invoking this function. This function fails
-  // if called when no partition is available.
-  virtual std::unique_ptr<WindowPartition> nextPartition() = 0;
+  // if called when no partition is available. The partition may be partial,
+  // in which case the WindowBuild keeps adding rows to it.
+  virtual std::shared_ptr<WindowPartition> nextPartition() = 0;
+
+  // Adds more rows to the partial partition returned last by nextPartition()
+  // without new input, e.g. from spilled data. Called by the Window operator
+  // after noMoreInput() when it has processed the available rows of the
+  // partition. Returns false if the build has no rows to add.
+  virtual bool loadMoreRows() {
+    return false;
+  }
 
   // Returns the average size of input rows in bytes stored in the
   // data container of the WindowBuild.
@@ -143,22 +143,44 @@ using WindowFunctionFactory = std::function<std::unique_ptr<WindowFunction>(
     HashStringAllocator* stringAllocator,
     const core::QueryConfig& config)>;
 
+/// Describes how a window function processes the rows of a partition.
+struct WindowFunctionMetadata {
+  /// True if the function can compute the results of a partition while its
+  /// rows are still arriving. Each apply() call then reads only the rows of
+  /// that call and the frames of these rows, and does not depend on the
+  /// number of rows in the partition. The Window operator streams such
+  /// functions over sorted input without holding whole partitions.
+  bool supportsStreaming{false};
+
+  /// True if the result of a row does not depend on its frame, e.g. for
+  /// ranking functions. Streaming functions that depend on the frame are
+  /// streamed only for frames from UNBOUNDED PRECEDING to CURRENT ROW.
+  bool ignoresFrame{false};
+};
+
 /// Register a window function with the specified name and signatures.
 /// Registering a function with the same name a second time overrides the first
 /// registration.
 bool registerWindowFunction(
     const std::string& name,
     std::vector<FunctionSignaturePtr> signatures,
-    WindowFunctionFactory factory);
+    WindowFunctionFactory factory,
+    WindowFunctionMetadata metadata = {});
 
 /// Returns signatures of the window function with the specified name.
 /// Returns empty std::optional if function with that name is not found.
 std::optional<std::vector<FunctionSignaturePtr>> getWindowFunctionSignatures(
     const std::string& name);
 
+/// Returns the metadata of the window function with the specified name.
+/// Returns empty std::optional if function with that name is not found.
+std::optional<WindowFunctionMetadata> getWindowFunctionMetadata(
+    const std::string& name);
+
 struct WindowFunctionEntry {
   std::vector<FunctionSignaturePtr> signatures;
   WindowFunctionFactory factory;
+  WindowFunctionMetadata metadata;
 };
 
 using WindowFunctionMap = std::unordered_map<std::string, WindowFunctionEntry>;
@@ -31,11 +31,52 @@ WindowPartition::WindowPartition(
   }
 }
 
+WindowPartition::WindowPartition(
+    RowContainer* data,
+    const std::vector<column_index_t>& inputMapping,
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
+    : data_(data),
+      inputMapping_(inputMapping),
+      sortKeyInfo_(sortKeyInfo),
+      partial_(true),
+      complete_(false) {
+  for (int i = 0; i < inputMapping_.size(); i++) {
+    columns_.emplace_back(data_->columnAt(inputMapping_[i]));
+  }
+}
+
+void WindowPartition::addRows(const std::vector<char*>& rows) {
+  VELOX_CHECK(partial_ && !complete_);
+  for (auto* row : rows) {
+    // Sorted rows that are not peers of the previous row start a peer group.
+    if (rows_.empty() || compareRowsWithSortKeys(rows_.back(), row)) {
+      lastPeerGroupStart_ = startRow_ + rows_.size();
+    }
+    rows_.push_back(row);
+  }
+  partition_ = folly::Range(rows_.data(), rows_.size());
+}
+
+void WindowPartition::removeProcessedRows(vector_size_t endRow) {
+  VELOX_CHECK(partial_);
+  const vector_size_t numRowsToKeep = complete_ ? 0 : 1;
+  const auto numRemovedRows = std::min<vector_size_t>(
+      endRow - startRow_, rows_.size() - numRowsToKeep);
+  if (numRemovedRows <= 0) {
+    return;
+  }
+  data_->eraseRows(folly::Range<char**>(rows_.data(), numRemovedRows));
+  rows_.erase(rows_.begin(), rows_.begin() + numRemovedRows);
+  startRow_ += numRemovedRows;
+  partition_ = folly::Range(rows_.data(), rows_.size());
+}
+
 void WindowPartition::extractColumn(
     int32_t columnIndex,
     folly::Range<const vector_size_t*> rowNumbers,
     vector_size_t resultOffset,
     const VectorPtr& result) const {
+  VELOX_DCHECK_EQ(startRow_, 0);
   RowContainer::extractColumn(
       partition_.data(),
       rowNumbers,
@@ -51,7 +92,7 @@ void WindowPartition::extractColumn(
     vector_size_t resultOffset,
     const VectorPtr& result) const {
   RowContainer::extractColumn(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       resultOffset,
@@ -64,7 +105,7 @@ void WindowPartition::extractNulls(
     vector_size_t numRows,
     const BufferPtr& nullsBuffer) const {
   RowContainer::extractNulls(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       nullsBuffer);
@@ -146,7 +187,7 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
   auto lastPartitionRow = numRows() - 1;
   auto peerStart = prevPeerStart;
   auto peerEnd = prevPeerEnd;
-  for (auto i = start, j = 0; i < end; i++, j++) {
+  for (auto i = start, j = 0; i < end;) {
     // When traversing input partition rows, the peers are the rows
     // with the same values for the ORDER BY clause. These rows
     // are equal in some ways and affect the results of ranking functions.
@@ -162,15 +203,21 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
       peerStart = i;
       peerEnd = i;
       while (peerEnd <= lastPartitionRow) {
-        if (peerCompare(partition_[peerStart], partition_[peerEnd])) {
+        if (peerCompare(
+                partition_[peerStart - startRow_],
+                partition_[peerEnd - startRow_])) {
           break;
         }
         peerEnd++;
       }
     }
 
-    rawPeerStarts[j] = peerStart;
-    rawPeerEnds[j] = peerEnd - 1;
+    // Fill in the rows of the peer group up to 'end' at once.
+    const auto numPeers = std::min(end, peerEnd) - i;
+    std::fill_n(rawPeerStarts + j, numPeers, peerStart);
+    std::fill_n(rawPeerEnds + j, numPeers, peerEnd - 1);
+    i += numPeers;
+    j += numPeers;
   }
   return {peerStart, peerEnd};
 }
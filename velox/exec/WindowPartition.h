@@ -42,11 +42,53 @@ class WindowPartition {
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
           sortKeyInfo);
 
-  /// Returns the number of rows in the current WindowPartition.
+  /// Constructs a partial WindowPartition for streaming the rows of a
+  /// partition as they arrive. The rows are added with addRows() until
+  /// setComplete() is called. The processed rows are freed with
+  /// removeProcessedRows(). Row numbers stay relative to the first row of the
+  /// partition after rows are removed.
+  WindowPartition(
+      RowContainer* data,
+      const std::vector<column_index_t>& inputMapping,
+      const std::vector<std::pair<column_index_t, core::SortOrder>>&
+          sortKeyInfo);
+
+  /// Returns the number of rows in the current WindowPartition. For a partial
+  /// partition, this is the number of rows added so far, including the
+  /// removed ones.
   vector_size_t numRows() const {
-    return partition_.size();
+    return startRow_ + partition_.size();
   }
 
+  bool isPartial() const {
+    return partial_;
+  }
+
+  bool isComplete() const {
+    return complete_;
+  }
+
+  /// Returns the number of rows from 'partitionOffset' on that can be
+  /// processed. For a partial partition these are the rows before the last
+  /// peer group, whose end is not known yet.
+  vector_size_t numRowsForProcessing(vector_size_t partitionOffset) const {
+    return (complete_ ? numRows() : lastPeerGroupStart_) - partitionOffset;
+  }
+
+  /// Appends 'rows' of 'data' to a partial partition.
+  void addRows(const std::vector<char*>& rows);
+
+  /// Marks a partial partition as having all its rows.
+  void setComplete() {
+    VELOX_CHECK(partial_);
+    complete_ = true;
+  }
+
+  /// Erases the rows before 'endRow' of a partial partition from 'data'. Keeps
+  /// the last row while the partition is not complete to find the peer group
+  /// of the next added row.
+  void removeProcessedRows(vector_size_t endRow);
+
   /// Copies the values at 'columnIndex' into 'result' (starting at
   /// 'resultOffset') for the rows at positions in the 'rowNumbers'
   /// array from the partition input data.
@@ -169,7 +211,7 @@ class WindowPartition {
   // folly::Range is for the partition rows iterator provided by the
   // Window operator. The pointers are to rows from a RowContainer owned
   // by the operator. We can assume these are valid values for the lifetime
-  // of WindowPartition.
+  // of WindowPartition. Points to 'rows_' for a partial partition.
   folly::Range<char**> partition_;
 
   // Mapping from window input column -> index in data_. This is required
@@ -189,5 +231,21 @@ class WindowPartition {
   // corresponding indexes of their input arguments into this vector.
   // They will request for column vector values at the respective index.
   std::vector<exec::RowColumn> columns_;
+
+  // True if the rows are added with addRows().
+  const bool partial_{false};
+
+  // False until a partial partition has all its rows.
+  bool complete_{true};
+
+  // The rows of a partial partition that are not removed yet.
+  std::vector<char*> rows_;
+
+  // Number of removed rows of a partial partition. The row at 'startRow_' is
+  // the first in 'partition_'.
+  vector_size_t startRow_{0};
+
+  // First row of the last peer group of a partial partition.
+  vector_size_t lastPeerGroupStart_{0};
 };
 } // namespace facebook::velox::exec
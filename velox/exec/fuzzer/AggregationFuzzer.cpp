@@ -115,6 +115,10 @@ class AggregationFuzzer : public AggregationFuzzerBase {
 
   void verifyAggregation(const std::vector<PlanWithSplits>& plans);
 
+  // Runs an aggregation of a random signature over pathological inputs at
+  // two sizes and reports super-linear growth of time or memory.
+  void verifyAggregationScaling();
+
   // Use the result of the first plan in the plans as the expected result to
   // compare or verify it with the results of other equivalent plans.
   bool compareEquivalentPlanResults(
@@ -315,6 +319,37 @@ bool supportsDistinctInputs(const CallableSignature& signature) {
   return true;
 }
 
+void AggregationFuzzer::verifyAggregationScaling() {
+  ++stats_.numPerfRuns;
+  auto signatureWithStats = pickSignature();
+  signatureWithStats.second.numRuns++;
+  const auto& signature = signatureWithStats.first;
+  stats_.functionNames.insert(signature.name);
+
+  std::vector<TypePtr> argTypes = signature.args;
+  std::vector<std::string> argNames = makeNames(argTypes.size());
+  const auto call = makeFunctionCall(signature.name, argNames);
+  std::vector<std::string> groupingKeys;
+  if (!vectorFuzzer_.coinToss(0.1)) {
+    groupingKeys = generateKeys("g", argNames, argTypes);
+  }
+
+  const auto shape = pickInputShape();
+  const auto input = generateAdversarialInput(argNames, argTypes, shape);
+  const bool scales = verifyScaling(
+      [&](const std::vector<RowVectorPtr>& data) {
+        return PlanBuilder()
+            .values(data)
+            .singleAggregation(groupingKeys, {call})
+            .planNode();
+      },
+      input,
+      shape);
+  if (!scales) {
+    ++stats_.numPerfAnomalies;
+  }
+}
+
 void AggregationFuzzer::go() {
   VELOX_CHECK(
       FLAGS_steps > 0 || FLAGS_duration_sec > 0,
@@ -327,8 +362,11 @@ void AggregationFuzzer::go() {
     LOG(INFO) << "==============================> Started iteration "
               << iteration << " (seed: " << currentSeed_ << ")";
 
-    // 10% of times test distinct aggregation.
-    if (vectorFuzzer_.coinToss(0.1)) {
+    if (FLAGS_perf_fuzzing_ratio > 0 &&
+        vectorFuzzer_.coinToss(FLAGS_perf_fuzzing_ratio)) {
+      verifyAggregationScaling();
+    } else if (vectorFuzzer_.coinToss(0.1)) {
+      // 10% of times test distinct aggregation.
       ++stats_.numDistinct;
 
       std::vector<TypePtr> types;
@@ -16,12 +16,14 @@
 #include "velox/exec/fuzzer/AggregationFuzzerBase.h"
 
 #include <boost/random/uniform_int_distribution.hpp>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/VeloxException.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/dwio/dwrf/reader/DwrfReader.h"
 #include "velox/dwio/dwrf/writer/Writer.h"
 #include "velox/exec/fuzzer/DuckQueryRunner.h"
+#include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/fuzzer/PrestoQueryRunner.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/expression/SignatureBinder.h"
@@ -85,8 +87,43 @@ DEFINE_bool(
     "up after failures. Therefore, results are not compared when this is "
     "enabled. Note that this option only works in debug builds.");
 
+DEFINE_double(
+    perf_fuzzing_ratio,
+    0,
+    "Chance of running an iteration in performance fuzzing mode. These "
+    "iterations generate inputs of pathological shapes, run the plan over the "
+    "input at two sizes under a memory limit, and report plans whose time or "
+    "memory grows super-linearly with the input. Results are not verified.");
+
+DEFINE_int32(
+    perf_fuzzing_scale,
+    4,
+    "The ratio of the larger to the smaller input in performance fuzzing "
+    "mode.");
+
+DEFINE_double(
+    perf_fuzzing_max_growth,
+    2,
+    "Performance fuzzing mode reports plans whose time or peak memory grows "
+    "more than this many times faster than the input.");
+
+DEFINE_int32(
+    perf_fuzzing_memory_limit_mb,
+    256,
+    "The query memory limit in performance fuzzing mode. Spilling is enabled.");
+
 namespace facebook::velox::exec::test {
 
+namespace {
+// Runs shorter than this or using less memory than this are too noisy to
+// compare in performance fuzzing mode.
+constexpr uint64_t kMinMeasurableNanos = 50'000'000;
+constexpr int64_t kMinMeasurableBytes = 1 << 20;
+
+// Levels of dictionary wrapping for InputShape::kNestedDictionary.
+constexpr int32_t kDictionaryNestingDepth = 5;
+} // namespace
+
 int32_t AggregationFuzzerBase::randInt(int32_t min, int32_t max) {
   return boost::random::uniform_int_distribution<int32_t>(min, max)(rng_);
 }
@@ -333,6 +370,186 @@ std::vector<RowVectorPtr> AggregationFuzzerBase::generateInputDataWithRowNumber(
   return input;
 }
 
+// static
+std::string AggregationFuzzerBase::inputShapeName(InputShape shape) {
+  switch (shape) {
+    case InputShape::kSkewed:
+      return "skewed";
+    case InputShape::kNestedDictionary:
+      return "nested dictionary";
+    case InputShape::kLongStrings:
+      return "long strings";
+    case InputShape::kHugeContainers:
+      return "huge containers";
+    case InputShape::kNullRuns:
+      return "null runs";
+  }
+  VELOX_UNREACHABLE();
+}
+
+std::vector<RowVectorPtr> AggregationFuzzerBase::generateAdversarialInput(
+    const std::vector<std::string>& names,
+    const std::vector<TypePtr>& types,
+    InputShape shape) {
+  const auto savedOptions = vectorFuzzer_.getOptions();
+  auto options = savedOptions;
+  if (shape == InputShape::kLongStrings) {
+    options.stringLength = 10'000;
+    options.stringVariableLength = false;
+  } else if (shape == InputShape::kHugeContainers) {
+    options.containerLength = 1'000;
+    options.containerVariableLength = false;
+    options.complexElementsMaxSize = 1'000'000;
+  }
+  vectorFuzzer_.setOptions(options);
+
+  const vector_size_t size = options.vectorSize;
+  auto inputType = ROW(
+      std::vector<std::string>(names), std::vector<TypePtr>(types));
+  std::vector<RowVectorPtr> input;
+  for (auto i = 0; i < FLAGS_num_batches; ++i) {
+    std::vector<VectorPtr> children;
+    for (const auto& type : types) {
+      VectorPtr child;
+      switch (shape) {
+        case InputShape::kSkewed: {
+          // 90% of the rows get the first of 4 distinct values.
+          auto base = vectorFuzzer_.fuzzFlat(type, 4);
+          auto indices = allocateIndices(size, pool_.get());
+          auto* rawIndices = indices->asMutable<vector_size_t>();
+          for (auto row = 0; row < size; ++row) {
+            rawIndices[row] = vectorFuzzer_.coinToss(0.9) ? 0 : randInt(1, 3);
+          }
+          child = BaseVector::wrapInDictionary(
+              nullptr, std::move(indices), size, std::move(base));
+          break;
+        }
+        case InputShape::kNestedDictionary:
+          child = vectorFuzzer_.fuzzFlat(type, size);
+          for (auto level = 0; level < kDictionaryNestingDepth; ++level) {
+            child = vectorFuzzer_.fuzzDictionary(child, size);
+          }
+          break;
+        case InputShape::kNullRuns:
+          if (i % 2 == 1) {
+            child = BaseVector::createNullConstant(type, size, pool_.get());
+          } else {
+            child = vectorFuzzer_.fuzzFlat(type, size);
+            for (auto row = size / 4; row < size * 3 / 4; ++row) {
+              child->setNull(row, true);
+            }
+          }
+          break;
+        default:
+          child = vectorFuzzer_.fuzz(type, size);
+          break;
+      }
+      children.push_back(std::move(child));
+    }
+    input.push_back(std::make_shared<RowVector>(
+        pool_.get(), inputType, nullptr, size, std::move(children)));
+  }
+
+  vectorFuzzer_.setOptions(savedOptions);
+  return input;
+}
+
+std::optional<AggregationFuzzerBase::PerfResult>
+AggregationFuzzerBase::executeForPerf(const core::PlanNodePtr& plan) {
+  if (perfExecutor_ == nullptr) {
+    perfExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        std::thread::hardware_concurrency());
+  }
+  auto queryPool = memory::memoryManager()->addRootPool(
+      "",
+      static_cast<int64_t>(FLAGS_perf_fuzzing_memory_limit_mb) << 20,
+      exec::MemoryReclaimer::create());
+  auto queryCtx = std::make_shared<core::QueryCtx>(
+      perfExecutor_.get(),
+      core::QueryConfig({}),
+      std::unordered_map<std::string, std::shared_ptr<Config>>{},
+      cache::AsyncDataCache::getInstance(),
+      queryPool);
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+
+  AssertQueryBuilder builder(plan);
+  builder.queryCtx(queryCtx)
+      .configs(queryConfigs_)
+      .spillDirectory(spillDirectory->getPath())
+      .config(core::QueryConfig::kSpillEnabled, "true")
+      .config(core::QueryConfig::kAggregationSpillEnabled, "true")
+      .config(core::QueryConfig::kOrderBySpillEnabled, "true")
+      .config(core::QueryConfig::kWindowSpillEnabled, "true")
+      .maxDrivers(2);
+
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    builder.copyResults(pool_.get());
+  } catch (const VeloxException& e) {
+    LOG(WARNING) << "Plan failed in performance fuzzing mode: " << e.what();
+    return std::nullopt;
+  }
+  const auto wallNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+  return PerfResult{static_cast<uint64_t>(wallNanos), queryPool->peakBytes()};
+}
+
+bool AggregationFuzzerBase::verifyScaling(
+    const std::function<core::PlanNodePtr(const std::vector<RowVectorPtr>&)>&
+        makePlan,
+    const std::vector<RowVectorPtr>& input,
+    InputShape shape) {
+  const auto scale = FLAGS_perf_fuzzing_scale;
+  std::vector<RowVectorPtr> scaledInput;
+  scaledInput.reserve(input.size() * scale);
+  for (auto i = 0; i < scale; ++i) {
+    scaledInput.insert(scaledInput.end(), input.begin(), input.end());
+  }
+  auto plan = makePlan(input);
+  auto scaledPlan = makePlan(scaledInput);
+  LOG(INFO) << "Performance fuzzing " << inputShapeName(shape)
+            << " input with query plan: " << std::endl
+            << plan->toString(true, true);
+
+  const auto result = executeForPerf(plan);
+  if (!result.has_value()) {
+    return true;
+  }
+  const auto scaledResult = executeForPerf(scaledPlan);
+  std::string anomaly;
+  if (!scaledResult.has_value()) {
+    anomaly = fmt::format("fails on {}x input", scale);
+  } else {
+    const double maxGrowth = scale * FLAGS_perf_fuzzing_max_growth;
+    const double timeGrowth = static_cast<double>(scaledResult->wallNanos) /
+        std::max<uint64_t>(result->wallNanos, 1);
+    const double memoryGrowth = static_cast<double>(scaledResult->peakBytes) /
+        std::max<int64_t>(result->peakBytes, 1);
+    if ((scaledResult->wallNanos >= kMinMeasurableNanos &&
+         timeGrowth > maxGrowth) ||
+        (scaledResult->peakBytes >= kMinMeasurableBytes &&
+         memoryGrowth > maxGrowth)) {
+      anomaly = fmt::format(
+          "takes {:.1f}x time and {:.1f}x peak memory on {}x input",
+          timeGrowth,
+          memoryGrowth,
+          scale);
+    }
+  }
+  if (anomaly.empty()) {
+    return true;
+  }
+
+  LOG(ERROR) << "Super-linear growth: plan over " << inputShapeName(shape)
+             << " input " << anomaly << ": " << std::endl
+             << scaledPlan->toString(true, true);
+  if (!reproPersistPath_.empty()) {
+    persistReproInfo({{scaledPlan, {}}}, reproPersistPath_);
+  }
+  return false;
+}
+
 // static
 exec::Split AggregationFuzzerBase::makeSplit(const std::string& filePath) {
   return exec::Split{std::make_shared<connector::hive::HiveConnectorSplit>(
@@ -656,6 +873,9 @@ void AggregationFuzzerBase::Stats::print(size_t numIterations) const {
       << " / " << printPercentageStat(numReferenceQueryFailed, numIterations);
   LOG(INFO) << "Total failed functions: "
             << printPercentageStat(numFailed, numIterations);
+  LOG(INFO) << "Total performance fuzzing iterations (super-linear growth): "
+            << printPercentageStat(numPerfRuns, numIterations) << " ("
+            << numPerfAnomalies << ")";
 }
 
 std::string printPercentageStat(size_t n, size_t total) {
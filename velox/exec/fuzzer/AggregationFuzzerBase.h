@@ -45,6 +45,8 @@ DECLARE_bool(persist_and_run_once);
 
 DECLARE_bool(log_signature_stats);
 
+DECLARE_double(perf_fuzzing_ratio);
+
 namespace facebook::velox::exec::test {
 
 using facebook::velox::test::CallableSignature;
@@ -107,6 +109,22 @@ class AggregationFuzzerBase {
     kReferenceQueryUnsupported
   };
 
+  /// Pathological input shapes generated in performance fuzzing mode.
+  enum class InputShape {
+    /// Most rows share one value.
+    kSkewed,
+    /// Several levels of dictionary wrapping.
+    kNestedDictionary,
+    /// Long fixed length strings.
+    kLongStrings,
+    /// Arrays and maps with many elements.
+    kHugeContainers,
+    /// Long runs of nulls and all-null batches.
+    kNullRuns,
+  };
+
+  static std::string inputShapeName(InputShape shape);
+
  protected:
   static inline const std::string kHiveConnectorId = "test-hive";
 
@@ -135,6 +153,13 @@ class AggregationFuzzerBase {
     // Number of iterations where aggregation failed.
     size_t numFailed{0};
 
+    // Number of iterations in performance fuzzing mode.
+    size_t numPerfRuns{0};
+
+    // Number of iterations in performance fuzzing mode where time or memory
+    // grew super-linearly with the input.
+    size_t numPerfAnomalies{0};
+
     void print(size_t numIterations) const;
 
     void updateReferenceQueryStats(
@@ -214,6 +239,29 @@ class AggregationFuzzerBase {
       std::vector<TypePtr> types,
       const CallableSignature& signature);
 
+  InputShape pickInputShape() {
+    return static_cast<InputShape>(
+        randInt(0, static_cast<int32_t>(InputShape::kNullRuns)));
+  }
+
+  // Generates FLAGS_num_batches batches of the given columns with the
+  // pathological 'shape'.
+  std::vector<RowVectorPtr> generateAdversarialInput(
+      const std::vector<std::string>& names,
+      const std::vector<TypePtr>& types,
+      InputShape shape);
+
+  // Runs the plan made by 'makePlan' over 'input' and over 'input' repeated
+  // FLAGS_perf_fuzzing_scale times under a memory limit with spilling
+  // enabled. Returns false and logs the plan if time or peak memory grows more
+  // than FLAGS_perf_fuzzing_max_growth times faster than the input, or if the
+  // plan fails only on the larger input.
+  bool verifyScaling(
+      const std::function<core::PlanNodePtr(const std::vector<RowVectorPtr>&)>&
+          makePlan,
+      const std::vector<RowVectorPtr>& input,
+      InputShape shape);
+
   std::pair<std::optional<MaterializedRowMultiset>, ReferenceQueryErrorCode>
   computeReferenceResults(
       const core::PlanNodePtr& plan,
@@ -263,6 +311,15 @@ class AggregationFuzzerBase {
 
   void printSignatureStats();
 
+  struct PerfResult {
+    uint64_t wallNanos;
+    int64_t peakBytes;
+  };
+
+  // Runs 'plan' under the performance fuzzing memory limit. Returns
+  // std::nullopt if the plan fails.
+  std::optional<PerfResult> executeForPerf(const core::PlanNodePtr& plan);
+
   const std::unordered_map<std::string, std::shared_ptr<ResultVerifier>>
       customVerificationFunctions_;
   const std::unordered_map<std::string, std::shared_ptr<InputGenerator>>
@@ -289,6 +346,9 @@ class AggregationFuzzerBase {
       memory::memoryManager()->addRootPool()};
   std::shared_ptr<memory::MemoryPool> pool_{rootPool_->addLeafChild("leaf")};
   VectorFuzzer vectorFuzzer_;
+
+  // Runs the plans of performance fuzzing mode. Created on first use.
+  std::unique_ptr<folly::Executor> perfExecutor_;
 };
 
 // Returns true if the elapsed time is greater than or equal to
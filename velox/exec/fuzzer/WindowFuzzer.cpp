@@ -245,6 +245,19 @@ void WindowFuzzer::go() {
     }
     const auto partitionKeys = generateSortingKeys("p", argNames, argTypes);
     const auto [frameClause, isRowsFrame] = generateFrameClause();
+    if (FLAGS_perf_fuzzing_ratio > 0 &&
+        vectorFuzzer_.coinToss(FLAGS_perf_fuzzing_ratio)) {
+      verifyWindowScaling(
+          partitionKeys,
+          sortingKeysAndOrders,
+          frameClause,
+          call,
+          argNames,
+          argTypes);
+      reSeed();
+      ++iteration;
+      continue;
+    }
     const auto input =
         generateInputDataWithRowNumber(argNames, argTypes, signature);
     // If the function is order-dependent or uses "rows" frame, sort all input
@@ -375,6 +388,31 @@ void initializeVerifier(
 }
 } // namespace
 
+void WindowFuzzer::verifyWindowScaling(
+    const std::vector<std::string>& partitionKeys,
+    const std::vector<SortingKeyAndOrder>& sortingKeysAndOrders,
+    const std::string& frameClause,
+    const std::string& functionCall,
+    const std::vector<std::string>& names,
+    const std::vector<TypePtr>& types) {
+  ++stats_.numPerfRuns;
+  const auto frame = getFrame(partitionKeys, sortingKeysAndOrders, frameClause);
+  const auto shape = pickInputShape();
+  const auto input = generateAdversarialInput(names, types, shape);
+  const bool scales = verifyScaling(
+      [&](const std::vector<RowVectorPtr>& data) {
+        return PlanBuilder()
+            .values(data)
+            .window({fmt::format("{} over ({})", functionCall, frame)})
+            .planNode();
+      },
+      input,
+      shape);
+  if (!scales) {
+    ++stats_.numPerfAnomalies;
+  }
+}
+
 bool WindowFuzzer::verifyWindow(
     const std::vector<std::string>& partitionKeys,
     const std::vector<SortingKeyAndOrder>& sortingKeysAndOrders,
@@ -112,6 +112,16 @@ class WindowFuzzer : public AggregationFuzzerBase {
       std::vector<std::string>& names,
       std::vector<TypePtr>& types);
 
+  // Runs the window function over pathological inputs at two sizes and
+  // reports super-linear growth of time or memory.
+  void verifyWindowScaling(
+      const std::vector<std::string>& partitionKeys,
+      const std::vector<SortingKeyAndOrder>& sortingKeysAndOrders,
+      const std::string& frameClause,
+      const std::string& functionCall,
+      const std::vector<std::string>& names,
+      const std::vector<TypePtr>& types);
+
   // Return 'true' if query plans failed.
   bool verifyWindow(
       const std::vector<std::string>& partitionKeys,
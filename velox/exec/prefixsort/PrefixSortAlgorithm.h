@@ -15,10 +15,17 @@
  */
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
+#include <folly/Executor.h>
+#include <folly/Portability.h>
+#include <folly/ScopeGuard.h>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 
@@ -151,6 +158,13 @@ class PrefixSortRunner {
   static const int kSmallSort = 7;
   static const int kMediumSort = 40;
 
+  // Within radixSort, ranges with fewer than kRadixSortMinRows entries are
+  // not partitioned further but sorted with quickSort. Buckets of the first
+  // key byte with at least kParallelRadixSortMinRows entries are sorted on
+  // the executor if one is given.
+  static const int kRadixSortMinRows = 256;
+  static const int kParallelRadixSortMinRows = 16 << 10;
+
   template <typename TCompare>
   void quickSort(char* start, char* end, TCompare compare) const {
     quickSort(
@@ -159,6 +173,97 @@ class PrefixSortRunner {
         compare);
   }
 
+  /// Sorts prefix data in range [start, end) with an in-place most
+  /// significant digit radix sort (American flag sort) over the first
+  /// 'keyBytes' bytes of each entry. The key bytes must be laid out as
+  /// PrefixSort does, i.e. as 8-byte words that compare as uint64_t, so that
+  /// on little-endian the most significant byte of a word comes last. Ranges
+  /// that are equal in all 'keyBytes' bytes or smaller than kRadixSortMinRows
+  /// are finished with quickSort using 'compare', which must order entries
+  /// consistently with the key bytes and may look past them to break ties.
+  /// If 'executor' is not null, the large buckets of the first key byte are
+  /// sorted in parallel on it.
+  template <typename TCompare>
+  void radixSort(
+      char* start,
+      char* end,
+      uint32_t keyBytes,
+      TCompare compare,
+      folly::Executor* executor = nullptr) const {
+    VELOX_CHECK(end >= start, "Invalid sort range.");
+    VELOX_CHECK_EQ(keyBytes % sizeof(uint64_t), 0);
+    VELOX_CHECK_LE(keyBytes, entrySize_);
+    const uint64_t len = (end - start) / entrySize_;
+    if (executor == nullptr || len < kParallelRadixSortMinRows) {
+      radixSortRange(start, len, 0, keyBytes, compare);
+      return;
+    }
+
+    // Partition by the first key byte that differs on this thread, then sort
+    // the buckets in parallel. Each task has its own swap buffer.
+    uint32_t byteIndex = 0;
+    std::array<uint64_t, 257> bounds;
+    for (; byteIndex < keyBytes; ++byteIndex) {
+      if (partition(start, len, byteIndex, bounds)) {
+        break;
+      }
+    }
+    if (byteIndex == keyBytes) {
+      quickSort(start, start + len * entrySize_, compare);
+      return;
+    }
+    std::vector<std::shared_ptr<AsyncSource<bool>>> steps;
+    // The tasks reference 'compare' and the sorted data, so they must all be
+    // synced before returning, also when unwinding.
+    auto sync = folly::makeGuard([&]() {
+      for (auto& step : steps) {
+        try {
+          step->move();
+        } catch (const std::exception&) {
+        }
+      }
+    });
+    for (auto bucket = 0; bucket < 256; ++bucket) {
+      const auto size = bounds[bucket + 1] - bounds[bucket];
+      if (size < kParallelRadixSortMinRows) {
+        continue;
+      }
+      char* bucketStart = start + bounds[bucket] * entrySize_;
+      steps.push_back(std::make_shared<AsyncSource<bool>>(
+          [this, bucketStart, size, byteIndex, keyBytes, &compare]() {
+            std::vector<char> swapBuffer(entrySize_);
+            PrefixSortRunner runner(entrySize_, swapBuffer.data());
+            runner.radixSortRange(
+                bucketStart, size, byteIndex + 1, keyBytes, compare);
+            return std::make_unique<bool>(true);
+          }));
+      executor->add([step = steps.back()]() { step->prepare(); });
+    }
+    for (auto bucket = 0; bucket < 256; ++bucket) {
+      const auto size = bounds[bucket + 1] - bounds[bucket];
+      if (size > 1 && size < kParallelRadixSortMinRows) {
+        radixSortRange(
+            start + bounds[bucket] * entrySize_,
+            size,
+            byteIndex + 1,
+            keyBytes,
+            compare);
+      }
+    }
+    sync.dismiss();
+    std::exception_ptr error;
+    for (auto& step : steps) {
+      try {
+        step->move();
+      } catch (const std::exception&) {
+        error = std::current_exception();
+      }
+    }
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+
   /// For testing only.
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE static char* testingMedian3(
@@ -224,6 +329,89 @@ class PrefixSortRunner {
                                                     : a);
   }
 
+  // Returns byte 'byteIndex' of the key of 'entry' in most significant first
+  // order. See radixSort() for the layout of the key.
+  FOLLY_ALWAYS_INLINE static uint8_t keyByte(
+      const char* entry,
+      uint32_t byteIndex) {
+    return static_cast<uint8_t>(
+        entry[(byteIndex & ~7) + (folly::kIsLittleEndian ? 7 - (byteIndex & 7)
+                                                         : byteIndex & 7)]);
+  }
+
+  // Permutes the 'len' entries at 'start' into buckets by key byte
+  // 'byteIndex'. Bucket 'i' is [bounds[i], bounds[i + 1]) after the call.
+  // Returns false without moving anything if all entries are in the same
+  // bucket.
+  bool partition(
+      char* start,
+      uint64_t len,
+      uint32_t byteIndex,
+      std::array<uint64_t, 257>& bounds) const {
+    std::array<uint64_t, 256> counts{};
+    for (uint64_t i = 0; i < len; ++i) {
+      ++counts[keyByte(start + i * entrySize_, byteIndex)];
+    }
+    std::array<uint64_t, 256> heads;
+    bounds[0] = 0;
+    for (auto i = 0; i < 256; ++i) {
+      if (counts[i] == len) {
+        return false;
+      }
+      heads[i] = bounds[i];
+      bounds[i + 1] = bounds[i] + counts[i];
+    }
+    // Moves each entry straight into its bucket, following the cycles of the
+    // permutation.
+    for (auto bucket = 0; bucket < 256; ++bucket) {
+      while (heads[bucket] < bounds[bucket + 1]) {
+        char* entry = start + heads[bucket] * entrySize_;
+        const auto target = keyByte(entry, byteIndex);
+        if (target == bucket) {
+          ++heads[bucket];
+        } else {
+          swap(
+              detail::PrefixSortIterator(entry, entrySize_),
+              detail::PrefixSortIterator(
+                  start + heads[target]++ * entrySize_, entrySize_));
+        }
+      }
+    }
+    return true;
+  }
+
+  // Sorts the 'len' entries at 'start', which are equal in the key bytes
+  // before 'byteIndex'.
+  template <typename TCompare>
+  void radixSortRange(
+      char* start,
+      uint64_t len,
+      uint32_t byteIndex,
+      uint32_t keyBytes,
+      TCompare compare) const {
+    std::array<uint64_t, 257> bounds;
+    for (; byteIndex < keyBytes && len >= kRadixSortMinRows; ++byteIndex) {
+      if (!partition(start, len, byteIndex, bounds)) {
+        continue;
+      }
+      for (auto bucket = 0; bucket < 256; ++bucket) {
+        const auto size = bounds[bucket + 1] - bounds[bucket];
+        if (size > 1) {
+          radixSortRange(
+              start + bounds[bucket] * entrySize_,
+              size,
+              byteIndex + 1,
+              keyBytes,
+              compare);
+        }
+      }
+      return;
+    }
+    if (len > 1) {
+      quickSort(start, start + len * entrySize_, compare);
+    }
+  }
+
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE void insertSort(
       const detail::PrefixSortIterator& start,
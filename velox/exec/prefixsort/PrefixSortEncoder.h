@@ -22,6 +22,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
+#include "velox/type/StringView.h"
 #include "velox/type/Timestamp.h"
 #include "velox/type/Type.h"
 
@@ -34,7 +35,8 @@ class PrefixSortEncoder {
       : ascending_(ascending), nullsFirst_(nullsFirst){};
 
   /// Encode native primitive types(such as uint64_t, int64_t, uint32_t,
-  /// int32_t, float, double, Timestamp). TODO: Add support for strings.
+  /// int32_t, float, double, Timestamp). Strings are encoded by
+  /// encodeStringPrefix().
   /// 1. The first byte of the encoded result is null byte. The value is 0 if
   ///    (nulls first and value is null) or (nulls last and value is not null).
   ///    Otherwise, the value is 1.
@@ -53,6 +55,30 @@ class PrefixSortEncoder {
     }
   }
 
+  /// Encodes the first 'kStringPrefixSize' bytes of a string. The null byte
+  /// is set as in encode(). The bytes follow as is, zero padded to
+  /// 'kStringPrefixSize' and inverted for descending order. Strings with the
+  /// same leading bytes get the same encoding, so they must be compared in
+  /// full to break the tie.
+  FOLLY_ALWAYS_INLINE void encodeStringPrefix(
+      std::optional<StringView> value,
+      char* dest) const {
+    if (!value.has_value()) {
+      dest[0] = nullsFirst_ ? 0 : 1;
+      simd::memset(dest + 1, 0, kStringPrefixSize);
+      return;
+    }
+    dest[0] = nullsFirst_ ? 1 : 0;
+    const auto size = std::min<uint32_t>(value->size(), kStringPrefixSize);
+    std::memcpy(dest + 1, value->data(), size);
+    simd::memset(dest + 1 + size, 0, kStringPrefixSize - size);
+    if (!ascending_) {
+      for (auto i = 1; i <= kStringPrefixSize; ++i) {
+        dest[i] = ~dest[i];
+      }
+    }
+  }
+
   /// @tparam T Type of value. Supported type are: uint64_t, int64_t, uint32_t,
   /// int32_t, float, double, Timestamp. TODO Add support for int16_t, uint16_t.
   template <typename T>
@@ -66,6 +92,23 @@ class PrefixSortEncoder {
     return nullsFirst_;
   }
 
+  /// Number of leading bytes of a string key stored in the prefix.
+  static constexpr uint32_t kStringPrefixSize = 12;
+
+  /// @return The size of the string prefix encoded by encodeStringPrefix()
+  ///         for VARCHAR and VARBINARY. For other types, returns
+  ///         'std::nullopt'.
+  FOLLY_ALWAYS_INLINE static std::optional<uint32_t> encodedPrefixSize(
+      TypeKind typeKind) {
+    switch (typeKind) {
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        return 1 + kStringPrefixSize;
+      default:
+        return std::nullopt;
+    }
+  }
+
   /// @return For supported types, returns the encoded size, assume nullable.
   ///         For not supported types, returns 'std::nullopt'.
   FOLLY_ALWAYS_INLINE static std::optional<uint32_t> encodedSize(
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include "velox/buffer/Buffer.h"
 #include "velox/exec/prefixsort/PrefixSortAlgorithm.h"
@@ -44,6 +45,25 @@ class PrefixSortAlgorithmBenchmark {
         });
   }
 
+  // Sorts 'vec' as uint64_t keys, which is the key layout radixSort expects.
+  void runRadixSort(std::vector<int64_t> vec, folly::Executor* executor) {
+    char* start = (char*)vec.data();
+    uint32_t entrySize = sizeof(int64_t);
+    auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool_.get());
+    auto sortRunner =
+        prefixsort::PrefixSortRunner(entrySize, swapBuffer->asMutable<char>());
+    sortRunner.radixSort(
+        start,
+        start + entrySize * vec.size(),
+        entrySize,
+        [&](char* a, char* b) {
+          const auto left = *reinterpret_cast<uint64_t*>(a);
+          const auto right = *reinterpret_cast<uint64_t*>(b);
+          return left < right ? -1 : left == right ? 0 : 1;
+        },
+        executor);
+  }
+
   std::vector<int64_t> generateTestVector(int32_t size) {
     std::vector<int64_t> randomTestVec(size);
     std::generate(randomTestVec.begin(), randomTestVec.end(), [&]() {
@@ -60,6 +80,7 @@ class PrefixSortAlgorithmBenchmark {
 };
 
 std::unique_ptr<PrefixSortAlgorithmBenchmark> bm;
+std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
 
 std::vector<int64_t> data10k;
 std::vector<int64_t> data100k;
@@ -82,6 +103,32 @@ BENCHMARK(PrefixSort_algorithm_10000k) {
   bm->runQuickSort(data10000k);
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(PrefixSort_radix_10k) {
+  bm->runRadixSort(data10k, nullptr);
+}
+
+BENCHMARK(PrefixSort_radix_100k) {
+  bm->runRadixSort(data100k, nullptr);
+}
+
+BENCHMARK(PrefixSort_radix_1000k) {
+  bm->runRadixSort(data1000k, nullptr);
+}
+
+BENCHMARK(PrefixSort_radix_10000k) {
+  bm->runRadixSort(data10000k, nullptr);
+}
+
+BENCHMARK(PrefixSort_parallel_radix_1000k) {
+  bm->runRadixSort(data1000k, executor.get());
+}
+
+BENCHMARK(PrefixSort_parallel_radix_10000k) {
+  bm->runRadixSort(data10000k, executor.get());
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -89,6 +136,7 @@ int main(int argc, char** argv) {
   memory::MemoryManager::initialize({});
   bm = std::make_unique<PrefixSortAlgorithmBenchmark>();
   bm->seed(FLAGS_sort_data_seed);
+  executor = std::make_unique<folly::CPUThreadPoolExecutor>(8);
   data10k = bm->generateTestVector(10'000);
   data100k = bm->generateTestVector(100'000);
   data1000k = bm->generateTestVector(1'000'000);
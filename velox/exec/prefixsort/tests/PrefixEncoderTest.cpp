@@ -337,6 +337,36 @@ TEST_F(PrefixEncoderTest, compare) {
   testCompare<Timestamp>();
 }
 
+TEST_F(PrefixEncoderTest, encodeStringPrefix) {
+  constexpr auto kSize = 1 + PrefixSortEncoder::kStringPrefixSize;
+  ASSERT_EQ(PrefixSortEncoder::encodedPrefixSize(TypeKind::VARCHAR), kSize);
+  ASSERT_EQ(PrefixSortEncoder::encodedPrefixSize(TypeKind::VARBINARY), kSize);
+  ASSERT_FALSE(PrefixSortEncoder::encodedPrefixSize(TypeKind::BIGINT));
+
+  char encoded[kSize];
+  const PrefixSortEncoder ascEncoder(true, true);
+  ascEncoder.encodeStringPrefix(StringView("abc"), encoded);
+  char expected[kSize] = {1, 'a', 'b', 'c'};
+  ASSERT_EQ(std::memcmp(encoded, expected, kSize), 0);
+
+  // Only the leading bytes of a long string are encoded.
+  ascEncoder.encodeStringPrefix(StringView("abcdefghijklmnop"), encoded);
+  std::memcpy(expected + 1, "abcdefghijkl", kSize - 1);
+  ASSERT_EQ(std::memcmp(encoded, expected, kSize), 0);
+
+  const PrefixSortEncoder descEncoder(false, false);
+  descEncoder.encodeStringPrefix(StringView("abc"), encoded);
+  ASSERT_EQ(encoded[0], 0);
+  ASSERT_EQ(encoded[1], (char)~'a');
+  ASSERT_EQ(encoded[3], (char)~'c');
+  ASSERT_EQ(encoded[4], (char)~0);
+
+  ascEncoder.encodeStringPrefix(std::nullopt, encoded);
+  ASSERT_EQ(encoded[0], 0);
+  descEncoder.encodeStringPrefix(std::nullopt, encoded);
+  ASSERT_EQ(encoded[0], 1);
+}
+
 TEST_F(PrefixEncoderTest, fuzzyInteger) {
   testFuzz<TypeKind::INTEGER>();
 }
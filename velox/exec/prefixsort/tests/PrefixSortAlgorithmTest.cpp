@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
@@ -55,6 +56,46 @@ class PrefixSortAlgorithmTest : public testing::Test,
     ASSERT_EQ(data1, data2);
   }
 
+  // Sorts entries of two uint64_t words with radixSort, using only the first
+  // word as radix key and the second word to break ties. 'generate' returns
+  // the first word of each entry.
+  void testRadixSort(
+      size_t size,
+      const std::function<uint64_t()>& generate,
+      folly::Executor* executor = nullptr) {
+    std::vector<std::pair<uint64_t, uint64_t>> data1(size);
+    for (auto& entry : data1) {
+      entry = {generate(), folly::Random::rand64()};
+    }
+    std::vector<std::pair<uint64_t, uint64_t>> data2 = data1;
+
+    {
+      char* start = (char*)data1.data();
+      const uint32_t entrySize = 2 * sizeof(uint64_t);
+      char* end = start + entrySize * data1.size();
+      auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool());
+      PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
+      sortRunner.radixSort(
+          start,
+          end,
+          sizeof(uint64_t),
+          [&](char* a, char* b) {
+            const auto* left = reinterpret_cast<uint64_t*>(a);
+            const auto* right = reinterpret_cast<uint64_t*>(b);
+            for (auto i = 0; i < 2; ++i) {
+              if (left[i] != right[i]) {
+                return left[i] < right[i] ? -1 : 1;
+              }
+            }
+            return 0;
+          },
+          executor);
+    }
+
+    std::sort(data2.begin(), data2.end());
+    ASSERT_EQ(data1, data2);
+  }
+
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance({});
@@ -70,6 +111,42 @@ TEST_F(PrefixSortAlgorithmTest, quickSort) {
   testQuickSort(PrefixSortRunner::kMediumSort + 1000);
 }
 
+TEST_F(PrefixSortAlgorithmTest, radixSort) {
+  const auto random = []() { return folly::Random::rand64(); };
+  testRadixSort(0, random);
+  testRadixSort(1, random);
+  testRadixSort(PrefixSortRunner::kRadixSortMinRows - 1, random);
+  testRadixSort(PrefixSortRunner::kRadixSortMinRows, random);
+  testRadixSort(100'000, random);
+  // Few distinct keys leave large buckets that are equal in all key bytes.
+  testRadixSort(100'000, []() { return folly::Random::rand64() % 10; });
+  // All keys equal.
+  testRadixSort(10'000, []() { return 1234; });
+  // Keys that share their leading bytes.
+  testRadixSort(100'000, []() {
+    return (uint64_t(1) << 63) | folly::Random::rand32(1 << 20);
+  });
+}
+
+TEST_F(PrefixSortAlgorithmTest, parallelRadixSort) {
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  const auto random = []() { return folly::Random::rand64(); };
+  // Below the parallel threshold.
+  testRadixSort(
+      PrefixSortRunner::kParallelRadixSortMinRows - 1, random, executor.get());
+  // Random keys make buckets too small to sort in parallel.
+  testRadixSort(400'000, random, executor.get());
+  // 16 distinct values in the 5th key byte give buckets that are sorted in
+  // parallel.
+  testRadixSort(
+      400'000,
+      []() {
+        return (folly::Random::rand64() % 16) << 24 |
+            folly::Random::rand32(1 << 24);
+      },
+      executor.get());
+}
+
 TEST_F(PrefixSortAlgorithmTest, testingMedian3) {
   // Generate 3 elements randomly as input data.
   std::vector<int64_t> data1(3);
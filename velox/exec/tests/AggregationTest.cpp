@@ -23,6 +23,7 @@
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
+#include "velox/exec/AdaptiveStatsStore.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/PlanNodeStats.h"
@@ -936,6 +937,188 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, partialAggregationSampledAbandon) {
+  // Unique keys in the 1st batch, few keys in the 2nd.
+  std::vector<RowVectorPtr> unique = {
+      makeRowVector(
+          {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })}),
+      makeRowVector(
+          {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 10; })}),
+  };
+  // Few keys in both batches.
+  std::vector<RowVectorPtr> repeated = {
+      makeRowVector(
+          {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 10; })}),
+      makeRowVector(
+          {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 10; })}),
+  };
+
+  for (const auto& [vectors, expectAbandon] :
+       {std::make_pair(unique, true), std::make_pair(repeated, false)}) {
+    SCOPED_TRACE(fmt::format("expectAbandon: {}", expectAbandon));
+    createDuckDbTable(vectors);
+    core::PlanNodeId partialAggId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kAbandonPartialAggregationSampleRows, 1'000)
+            .config(QueryConfig::kAbandonPartialAggregationMinPct, 80)
+            .config("max_drivers_per_task", 1)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"count(1)"})
+                      .capturePlanNodeId(partialAggId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults("SELECT c0, count(1) FROM tmp GROUP BY c0");
+
+    auto runtimeStats =
+        toPlanStats(task->taskStats()).at(partialAggId).customStats;
+    EXPECT_EQ(1'000, runtimeStats.at("partialAggregationSampledRows").sum);
+    const auto estimatedPct =
+        runtimeStats.at("partialAggregationEstimatedDistinctPct").sum;
+    if (expectAbandon) {
+      EXPECT_GE(estimatedPct, 80);
+      EXPECT_EQ(1, runtimeStats.at("abandonedPartialAggregation").count);
+      // The 1st batch is passed through without adding it to a table.
+      EXPECT_EQ(0, runtimeStats.count("flushRowCount"));
+    } else {
+      EXPECT_LT(estimatedPct, 80);
+      EXPECT_EQ(0, runtimeStats.count("abandonedPartialAggregation"));
+    }
+  }
+}
+
+TEST_F(AggregationTest, partialAggregationAbandonFromStatsStore) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [i](auto row) { return i * 1'000 + row; })}));
+  }
+  createDuckDbTable(vectors);
+  AdaptiveStatsStore::getInstance()->clear();
+
+  core::PlanNodeId partialAggId;
+  const auto plan = PlanBuilder()
+                        .values(vectors)
+                        .partialAggregation({"c0"}, {"count(1)"})
+                        .capturePlanNodeId(partialAggId)
+                        .finalAggregation()
+                        .planNode();
+  auto runQuery = [&](bool storeEnabled) {
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kAbandonPartialAggregationMinRows, 1'500)
+            .config(QueryConfig::kAbandonPartialAggregationMinPct, 50)
+            .config(QueryConfig::kAdaptiveStatsStoreEnabled, storeEnabled)
+            .config("max_drivers_per_task", 1)
+            .plan(plan)
+            .assertResults("SELECT c0, count(1) FROM tmp GROUP BY c0");
+    return toPlanStats(task->taskStats()).at(partialAggId).customStats;
+  };
+
+  // The 1st run abandons after seeing enough input and records it.
+  auto runtimeStats = runQuery(true);
+  EXPECT_EQ(1, runtimeStats.at("abandonedPartialAggregation").count);
+  EXPECT_GT(runtimeStats.count("flushRowCount"), 0);
+  EXPECT_EQ(0, runtimeStats.count("abandonedPartialAggregationFromStats"));
+  EXPECT_EQ(1, AdaptiveStatsStore::getInstance()->numEntries());
+
+  // The 2nd run abandons from the start without building a table.
+  runtimeStats = runQuery(true);
+  EXPECT_EQ(1, runtimeStats.at("abandonedPartialAggregationFromStats").count);
+  EXPECT_EQ(0, runtimeStats.count("flushRowCount"));
+
+  // The store is not consulted if disabled.
+  runtimeStats = runQuery(false);
+  EXPECT_EQ(0, runtimeStats.count("abandonedPartialAggregationFromStats"));
+  AdaptiveStatsStore::getInstance()->clear();
+}
+
+TEST_F(AggregationTest, partialAggregationClusteredInput) {
+  // Runs of 10 rows per key, continuing across batches.
+  std::vector<RowVectorPtr> clustered;
+  // The keys of the 1st batch repeat in the others.
+  std::vector<RowVectorPtr> interleaved;
+  for (auto i = 0; i < 5; ++i) {
+    clustered.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [i](auto row) { return (i * 1'000 + row + 5) / 10; })}));
+    interleaved.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [](auto row) { return row / 10; })}));
+  }
+
+  for (const auto& [vectors, expectClustered] :
+       {std::make_pair(clustered, true), std::make_pair(interleaved, false)}) {
+    SCOPED_TRACE(fmt::format("expectClustered: {}", expectClustered));
+    createDuckDbTable(vectors);
+    core::PlanNodeId partialAggId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(
+                QueryConfig::kPartialAggregationClusteredInputDetectionRows,
+                2'000)
+            .config("max_drivers_per_task", 1)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"count(1)", "sum(c0)"})
+                      .capturePlanNodeId(partialAggId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults("SELECT c0, count(1), sum(c0) FROM tmp GROUP BY c0");
+
+    const auto planStats = toPlanStats(task->taskStats()).at(partialAggId);
+    if (expectClustered) {
+      EXPECT_EQ(
+          2'000,
+          planStats.customStats.at("clusteredInputDetectedRows").sum);
+      // The groups are output with each batch after the detection.
+      EXPECT_GT(planStats.outputVectors, 3);
+    } else {
+      EXPECT_EQ(0, planStats.customStats.count("clusteredInputDetectedRows"));
+      EXPECT_EQ(1, planStats.outputVectors);
+    }
+  }
+}
+
+TEST_F(AggregationTest, tiledAggregateUpdate) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 97; }),
+         makeFlatVector<int64_t>(
+             1'000, [](auto row) { return row; }, nullEvery(7)),
+         makeFlatVector<double>(1'000, [](auto row) { return row * 0.1; }),
+         makeFlatVector<bool>(1'000, [](auto row) { return row % 3 == 0; })}));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::string> aggregates = {
+      "sum(c1)",
+      "count(c1)",
+      "min(c1)",
+      "max(c1)",
+      "avg(c1)",
+      "sum(c2)",
+      "count(c2)",
+      "min(c2)",
+      "max(c2)",
+      "sum(c1)"};
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c0"}, aggregates, {"", "c3"})
+                  .planNode();
+  const std::string sql =
+      "SELECT c0, sum(c1), count(c1) FILTER (WHERE c3), min(c1), max(c1), "
+      "avg(c1), sum(c2), count(c2), min(c2), max(c2), sum(c1) "
+      "FROM tmp GROUP BY c0";
+  // Tiles that do not divide the batch size and a tile larger than the batch.
+  for (const auto tileRows : {0, 1, 300, 2'000}) {
+    SCOPED_TRACE(fmt::format("tileRows: {}", tileRows));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationUpdateTileRows, tileRows)
+        .assertResults(sql);
+  }
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -1147,6 +1330,41 @@ TEST_F(AggregationTest, spillAll) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, spillSortInput) {
+  std::vector<RowVectorPtr> inputs;
+  for (auto i = 0; i < 10; ++i) {
+    inputs.push_back(makeRowVector({
+        makeFlatVector<int64_t>(100, [](auto row) { return row % 10; }),
+        makeFlatVector<int64_t>(100, [&](auto row) { return row + i; }),
+    }));
+  }
+  createDuckDbTable(inputs);
+
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .singleAggregation({"c0"}, {"sum(c1)", "max(c1)"})
+                  .planNode();
+
+  for (bool sortInput : {false, true}) {
+    SCOPED_TRACE(fmt::format("sortInput: {}", sortInput));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(tempDirectory->getPath())
+            .config(QueryConfig::kSpillEnabled, true)
+            .config(QueryConfig::kAggregationSpillEnabled, true)
+            .config(QueryConfig::kAggregationSpillSortInput, sortInput)
+            .assertResults("SELECT c0, sum(c1), max(c1) FROM tmp GROUP BY c0");
+
+    // Each batch spills the rows of the previous one. After the first spill
+    // the rows are not grouped anymore if 'sortInput' is set.
+    const auto stats = task->taskStats().pipelineStats[0].operatorStats[1];
+    ASSERT_EQ(stats.spilledRows, sortInput ? 10 + 9 * 100 : 10 * 10);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
 // Verify number of memory allocations in the HashAggregation operator.
 TEST_F(AggregationTest, memoryAllocations) {
   vector_size_t size = 1'024;
@@ -1812,24 +2030,35 @@ TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
   createDuckDbTable(vectors);
   auto spillDirectory = exec::test::TempDirectoryPath::create();
   core::PlanNodeId aggrNodeId;
-  TestScopedSpillInjection scopedSpillInjection(100);
-  auto task =
-      AssertQueryBuilder(duckDbQueryRunner_)
-          .spillDirectory(spillDirectory->getPath())
-          .config(QueryConfig::kSpillEnabled, true)
-          .config(QueryConfig::kAggregationSpillEnabled, true)
-          .plan(PlanBuilder()
-                    .values(vectors)
-                    .singleAggregation({"c1"}, {"count(DISTINCT c0)"}, {})
-                    .capturePlanNodeId(aggrNodeId)
-                    .planNode())
-          .assertResults("SELECT c1, count(DISTINCT c0) FROM tmp GROUP BY c1");
-  // Verify that spilling is not triggered.
-  const auto& queryConfig = task->queryCtx()->queryConfig();
-  ASSERT_TRUE(queryConfig.spillEnabled());
-  ASSERT_TRUE(queryConfig.aggregationSpillEnabled());
-  ASSERT_EQ(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
-  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+
+  auto testPlan = [&](const std::vector<std::string>& aggregates,
+                      const std::string& sql) {
+    SCOPED_TRACE(sql);
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->getPath())
+                    .config(QueryConfig::kSpillEnabled, true)
+                    .config(QueryConfig::kAggregationSpillEnabled, true)
+                    .plan(PlanBuilder()
+                              .values(vectors)
+                              .singleAggregation({"c1"}, aggregates, {})
+                              .capturePlanNodeId(aggrNodeId)
+                              .planNode())
+                    .assertResults(sql);
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    checkSpillStats(taskStats.at(aggrNodeId), true);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  };
+
+  testPlan(
+      {"count(DISTINCT c0)"},
+      "SELECT c1, count(DISTINCT c0) FROM tmp GROUP BY c1");
+  // Distinct strings next to distinct and non-distinct aggregates over
+  // other columns.
+  testPlan(
+      {"count(DISTINCT c6)", "sum(c2)", "count(DISTINCT c3)"},
+      "SELECT c1, count(DISTINCT c6), sum(c2), count(DISTINCT c3) "
+      "FROM tmp GROUP BY c1");
 }
 
 TEST_F(AggregationTest, spillingForAggrsWithSorting) {
@@ -181,6 +181,48 @@ class ContainerRowSerdeTest : public testing::Test,
     }
   }
 
+  // Compares arrays of long equal runs of T, which take the batched path,
+  // with each other and checks the results against BaseVector::compare().
+  template <typename T>
+  void testCompareIntegerArrays() {
+    std::vector<std::vector<T>> arrays;
+    for (auto i = 0; i < 40; ++i) {
+      // Arrays share the first values up to a random length, so differences
+      // fall inside and across compare batches.
+      std::vector<T> array(folly::Random::rand32(200));
+      const auto prefixSize = folly::Random::rand32(array.size() + 1);
+      for (auto j = 0; j < array.size(); ++j) {
+        array[j] = j < prefixSize ? j : folly::Random::rand32(3);
+      }
+      arrays.push_back(std::move(array));
+    }
+    auto vector = makeArrayVector<T>(arrays);
+    auto positions = serializeWithPositions(vector);
+    DecodedVector decodedVector(*vector);
+
+    for (auto ascending : {true, false}) {
+      CompareFlags flags{true, ascending};
+      for (auto i = 0; i < arrays.size(); ++i) {
+        for (auto j = 0; j < arrays.size(); ++j) {
+          const auto expected =
+              vector->compare(vector.get(), i, j, flags).value();
+          auto left = HashStringAllocator::prepareRead(positions[i].header);
+          auto result =
+              ContainerRowSerde::compare(left, decodedVector, j, flags);
+          ASSERT_EQ(expected > 0, result > 0) << i << " " << j;
+          ASSERT_EQ(expected < 0, result < 0) << i << " " << j;
+
+          left = HashStringAllocator::prepareRead(positions[i].header);
+          auto right = HashStringAllocator::prepareRead(positions[j].header);
+          result = ContainerRowSerde::compare(
+              left, right, vector->type().get(), flags);
+          ASSERT_EQ(expected > 0, result > 0) << i << " " << j;
+          ASSERT_EQ(expected < 0, result < 0) << i << " " << j;
+        }
+      }
+    }
+  }
+
   void assertNotEqualVectors(
       const VectorPtr& actual,
       const VectorPtr& expected) {
@@ -232,6 +274,13 @@ TEST_F(ContainerRowSerdeTest, arrayOfBigint) {
   testRoundTrip(data);
 }
 
+TEST_F(ContainerRowSerdeTest, compareIntegerArrays) {
+  testCompareIntegerArrays<int8_t>();
+  testCompareIntegerArrays<int32_t>();
+  testCompareIntegerArrays<int64_t>();
+  testCompareIntegerArrays<int128_t>();
+}
+
 TEST_F(ContainerRowSerdeTest, arrayOfString) {
   auto data = makeArrayVector<std::string>({
       {"a", "b", "Longer string ...."},
@@ -1517,6 +1517,120 @@ DEBUG_ONLY_TEST_F(DriverTest, driverCpuTimeSlicingCheck) {
   }
 }
 
+DEBUG_ONLY_TEST_F(DriverTest, cpuShareWeight) {
+  const int numBatches = 3;
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < numBatches; ++i) {
+    batches.push_back(
+        makeRowVector({"c0"}, {makeFlatVector<int32_t>({1, 2, 3})}));
+  }
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Values::getOutput",
+      std::function<void(const exec::Values*)>([&](const exec::Values*) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); // NOLINT
+      }));
+
+  for (const auto weight : {1, 1'000}) {
+    SCOPED_TRACE(fmt::format("weight: {}", weight));
+    auto fragment = PlanBuilder().values(batches).planFragment();
+    std::unordered_map<std::string, std::string> queryConfig{
+        {core::QueryConfig::kDriverCpuTimeSliceLimitMs, "10"},
+        {core::QueryConfig::kQueryCpuShareWeight, std::to_string(weight)}};
+    auto queryCtx = std::make_shared<core::QueryCtx>(
+        driverExecutor_.get(), std::move(queryConfig));
+    const uint64_t oldYieldCount = Driver::yieldCount();
+    auto task = Task::create(
+        "t0",
+        fragment,
+        0,
+        queryCtx,
+        [](RowVectorPtr /*unused*/, ContinueFuture* /*unused*/) {
+          return exec::BlockingReason::kNotBlocked;
+        });
+    task->start(1, 1);
+    ASSERT_TRUE(waitForTaskCompletion(task.get(), 600'000'000));
+    // The time slice is 10s with weight 1'000.
+    if (weight == 1) {
+      ASSERT_GE(Driver::yieldCount(), oldYieldCount + numBatches);
+    } else {
+      ASSERT_EQ(Driver::yieldCount(), oldYieldCount);
+    }
+  }
+}
+
+DEBUG_ONLY_TEST_F(DriverTest, schedulingPriorities) {
+  // Runs the drivers on 'driverExecutor_' and records the priorities they are
+  // added with.
+  class PriorityExecutor : public folly::Executor {
+   public:
+    explicit PriorityExecutor(folly::Executor* executor)
+        : executor_(executor) {}
+
+    void add(folly::Func func) override {
+      executor_->add(std::move(func));
+    }
+
+    void addWithPriority(folly::Func func, int8_t priority) override {
+      priorities_.wlock()->push_back(priority);
+      executor_->add(std::move(func));
+    }
+
+    uint8_t getNumPriorities() const override {
+      return 3;
+    }
+
+    std::vector<int8_t> priorities() const {
+      return priorities_.copy();
+    }
+
+   private:
+    folly::Executor* const executor_;
+    folly::Synchronized<std::vector<int8_t>> priorities_;
+  };
+
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < 3; ++i) {
+    batches.push_back(
+        makeRowVector({"c0"}, {makeFlatVector<int32_t>({1, 2, 3})}));
+  }
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Values::getOutput",
+      std::function<void(const exec::Values*)>([&](const exec::Values*) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+      }));
+
+  for (const auto enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled: {}", enabled));
+    PriorityExecutor executor(driverExecutor_.get());
+    auto fragment = PlanBuilder().values(batches).planFragment();
+    std::unordered_map<std::string, std::string> queryConfig{
+        {core::QueryConfig::kDriverCpuTimeSliceLimitMs, "1"},
+        {core::QueryConfig::kDriverSchedulingPrioritiesEnabled,
+         enabled ? "true" : "false"}};
+    auto task = Task::create(
+        "t0",
+        fragment,
+        0,
+        std::make_shared<core::QueryCtx>(&executor, std::move(queryConfig)),
+        [](RowVectorPtr /*unused*/, ContinueFuture* /*unused*/) {
+          return exec::BlockingReason::kNotBlocked;
+        });
+    task->start(1, 1);
+    ASSERT_TRUE(waitForTaskCompletion(task.get(), 600'000'000));
+
+    // The drivers that yield are rescheduled with low priority.
+    const auto priorities = executor.priorities();
+    if (enabled) {
+      ASSERT_GE(priorities.size(), batches.size());
+      for (auto priority : priorities) {
+        ASSERT_EQ(priority, folly::Executor::LO_PRI);
+      }
+    } else {
+      ASSERT_TRUE(priorities.empty());
+    }
+  }
+}
+
 class OpCallStatusTest : public OperatorTestBase {};
 
 // Test that the opCallStatus is returned properly and formats the call as
@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/InProcessExchangeSource.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
@@ -285,6 +286,71 @@ TEST_F(ExchangeClientTest, largeSinglePage) {
   client->close();
 }
 
+TEST_F(ExchangeClientTest, inProcessExchangeSource) {
+  ExchangeSource::registerFactory(InProcessExchangeSource::create);
+
+  auto data = {
+      makeRowVector({makeFlatVector<int32_t>({1, 2, 3})}),
+      makeRowVector({makeFlatVector<int32_t>({1, 2, 3, 4, 5})}),
+      makeRowVector({makeFlatVector<int32_t>({1, 2})}),
+  };
+  auto plan = test::PlanBuilder()
+                  .values(data)
+                  .partitionedOutput({"c0"}, 4)
+                  .planNode();
+  auto task = makeTask("producer", plan);
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 4, 1);
+
+  auto consumerPool = rootPool_->addLeafChild("consumer");
+  auto client = std::make_shared<ExchangeClient>(
+      "consumer",
+      2,
+      ExchangeClient::kDefaultMaxQueuedBytes,
+      consumerPool.get(),
+      executor());
+  client->addRemoteTaskId(
+      fmt::format("{}{}", InProcessExchangeSource::kScheme, task->taskId()));
+  client->noMoreRemoteTasks();
+
+  uint64_t totalBytes = 0;
+  for (auto vector : data) {
+    totalBytes += enqueue(task->taskId(), 2, vector);
+  }
+  bufferManager_->noMoreData(task->taskId());
+
+  {
+    auto pages = fetchPages(*client, 3);
+    uint64_t receivedBytes = 0;
+    for (const auto& page : pages) {
+      receivedBytes += page->size();
+    }
+    ASSERT_EQ(totalBytes, receivedBytes);
+    // The received pages live in memory of the consumer pool.
+    ASSERT_GE(consumerPool->currentBytes(), totalBytes);
+  }
+  ASSERT_EQ(0, consumerPool->currentBytes());
+
+  bool atEnd;
+  ContinueFuture future;
+  auto pages = client->next(1, &atEnd, &future);
+  if (!atEnd) {
+    auto& exec = folly::QueuedImmediateExecutor::instance();
+    std::move(future).via(&exec).wait();
+    pages = client->next(1, &atEnd, &future);
+  }
+  ASSERT_TRUE(pages.empty());
+  ASSERT_TRUE(atEnd);
+
+  const auto stats = client->stats();
+  ASSERT_EQ(3, stats.at("inProcessExchangeSource.numPages").sum);
+  ASSERT_EQ(totalBytes, stats.at("inProcessExchangeSource.totalBytes").sum);
+
+  task->requestCancel();
+  bufferManager_->removeTask(task->taskId());
+  client->close();
+}
+
 TEST_F(ExchangeClientTest, multiPageFetch) {
   auto client =
       std::make_shared<ExchangeClient>("test", 17, 1 << 20, pool(), executor());
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/FragmentResultCache.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class FragmentResultCacheTest : public testing::Test,
+                                public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Returns one cached batch of 'size' rows and its retained size.
+  std::pair<FragmentResultCache::Batches, uint64_t> makeBatches(
+      FragmentResultCache& cache,
+      vector_size_t size) {
+    auto copy = cache.copy(makeRowVector(
+        {makeFlatVector<int64_t>(size, [](auto row) { return row; })}));
+    const auto bytes = copy->retainedSize();
+    return {{copy}, bytes};
+  }
+};
+
+TEST_F(FragmentResultCacheTest, findAndEvict) {
+  FragmentResultCache cache(1 << 20);
+  ASSERT_EQ(nullptr, cache.find("a"));
+
+  auto [batches, bytes] = makeBatches(cache, 1'000);
+  auto* rawBatch = batches[0].get();
+  cache.insert("a", std::move(batches), bytes);
+  auto found = cache.find("a");
+  ASSERT_NE(nullptr, found);
+  ASSERT_EQ(rawBatch, (*found)[0].get());
+  ASSERT_EQ(1'000, (*found)[0]->size());
+
+  // A second insert of the same key keeps the first results.
+  auto [otherBatches, otherBytes] = makeBatches(cache, 10);
+  cache.insert("a", std::move(otherBatches), otherBytes);
+  ASSERT_EQ(rawBatch, (*cache.find("a"))[0].get());
+
+  // Results larger than the cache are not cached.
+  auto [largeBatches, largeBytes] = makeBatches(cache, 200'000);
+  ASSERT_GT(largeBytes, cache.capacity());
+  cache.insert("large", std::move(largeBatches), largeBytes);
+  ASSERT_EQ(nullptr, cache.find("large"));
+
+  // Fill the cache after using "a" last. "a" is evicted last.
+  int32_t numInserted = 0;
+  while (cache.stats().numEvictions == 0) {
+    auto [moreBatches, moreBytes] = makeBatches(cache, 1'000);
+    cache.insert(
+        fmt::format("b{}", numInserted++), std::move(moreBatches), moreBytes);
+    ASSERT_LE(cache.stats().cachedBytes, cache.capacity());
+    if (cache.stats().numEvictions == 0) {
+      ASSERT_NE(nullptr, cache.find("a"));
+    }
+  }
+  ASSERT_EQ(nullptr, cache.find("b0"));
+  ASSERT_NE(nullptr, cache.find("a"));
+
+  // Results handed out stay valid after the cache drops them.
+  cache.clear();
+  ASSERT_EQ(0, cache.stats().numEntries);
+  ASSERT_EQ(0, cache.stats().cachedBytes);
+  ASSERT_EQ(1'000, (*found)[0]->size());
+}
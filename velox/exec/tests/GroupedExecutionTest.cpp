@@ -717,6 +717,56 @@ TEST_F(GroupedExecutionTest, groupedExecution) {
   EXPECT_EQ(numRead, numSplits * 10'000);
 }
 
+TEST_F(GroupedExecutionTest, adaptiveSplitGroupConcurrency) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+
+  CursorParameters params;
+  params.planNode = tableScanNode(ROW({}, {}));
+  params.maxDrivers = 2;
+  params.executionStrategy = core::ExecutionStrategy::kGrouped;
+  params.groupedExecutionLeafNodeIds.emplace(params.planNode->id());
+  params.numSplitGroups = 3;
+  params.numConcurrentSplitGroups = 2;
+  params.queryConfigs[core::QueryConfig::kAdaptiveSplitGroupConcurrency] =
+      "true";
+
+  auto cursor = TaskCursor::create(params);
+  auto task = cursor->task();
+  // Pretend that a split group needs more memory than the query can get.
+  task->testingSetSplitGroupBytesEstimate(
+      std::numeric_limits<uint64_t>::max());
+  cursor->start();
+
+  task->addSplit("0", makeHiveSplitWithGroup(filePath->getPath(), 8));
+  task->addSplit("0", makeHiveSplitWithGroup(filePath->getPath(), 5));
+  // Only one split group runs, although the concurrency is 2.
+  EXPECT_EQ(2, task->numRunningDrivers());
+
+  task->noMoreSplitsForGroup("0", 8);
+  waitForFinishedDrivers(task, 2);
+  EXPECT_EQ(2, task->numRunningDrivers());
+  EXPECT_EQ(std::unordered_set<int32_t>({8}), getCompletedSplitGroups(task));
+
+  // With room for more split groups, the next one runs concurrently.
+  task->testingSetSplitGroupBytesEstimate(0);
+  task->addSplit("0", makeHiveSplitWithGroup(filePath->getPath(), 1));
+  EXPECT_EQ(4, task->numRunningDrivers());
+
+  task->noMoreSplitsForGroup("0", 5);
+  task->noMoreSplitsForGroup("0", 1);
+  task->noMoreSplits("0");
+  int32_t numRead = 0;
+  while (cursor->moveNext()) {
+    numRead += cursor->current()->size();
+  }
+  EXPECT_EQ(exec::TaskState::kFinished, task->state());
+  EXPECT_EQ(
+      std::unordered_set<int32_t>({1, 5, 8}), getCompletedSplitGroups(task));
+  EXPECT_EQ(numRead, 3 * 10'000);
+}
+
 TEST_F(GroupedExecutionTest, allGroupSplitsReceivedBeforeTaskStart) {
   // Create source file - we will read from it in 6 splits.
   const size_t numSplits{6};
@@ -391,6 +391,67 @@ TEST_P(HashJoinBridgeTest, withSpill) {
   }
 }
 
+TEST_P(HashJoinBridgeTest, skewedSpillPartition) {
+  const auto makePartitionSet =
+      [&](uint8_t partitionBitOffset,
+          const std::vector<int32_t>& numFilesPerPartition) {
+        SpillPartitionSet partitionSet;
+        for (int32_t i = 0; i < numFilesPerPartition.size(); ++i) {
+          const SpillPartitionId id(partitionBitOffset, i);
+          partitionSet.emplace(
+              id,
+              std::make_unique<SpillPartition>(
+                  id, makeFakeSpillFiles(numFilesPerPartition[i])));
+        }
+        return partitionSet;
+      };
+  // Restores the next spill partition on all the builders and returns true
+  // if it is skewed.
+  const auto restoreNext = [&](HashJoinBridge& joinBridge) {
+    auto futures = createEmptyFutures(numBuilders_);
+    bool skewed{false};
+    for (int32_t i = 0; i < numBuilders_; ++i) {
+      auto input = joinBridge.spillInputOrFuture(&futures[i]);
+      EXPECT_TRUE(input.has_value());
+      EXPECT_NE(input->spillPartition, nullptr);
+      skewed = input->skewed;
+    }
+    return skewed;
+  };
+
+  auto future = ContinueFuture::makeEmpty();
+  auto joinBridge = createJoinBridge();
+  for (int32_t i = 0; i < numBuilders_; ++i) {
+    joinBridge->addBuilder();
+  }
+  joinBridge->start();
+  joinBridge->setHashTable(
+      createFakeHashTable(), makePartitionSet(0, {10, 10}), false);
+  ASSERT_FALSE(joinBridge->tableOrFuture(&future)->restoredPartitionSkewed);
+
+  // Restores [0,0] and spills almost all of it into [2,0].
+  ASSERT_TRUE(joinBridge->probeFinished());
+  ASSERT_FALSE(restoreNext(*joinBridge));
+  joinBridge->setHashTable(
+      createFakeHashTable(), makePartitionSet(2, {9, 1}), false);
+  ASSERT_FALSE(joinBridge->tableOrFuture(&future)->restoredPartitionSkewed);
+
+  // [2,0] is skewed.
+  ASSERT_TRUE(joinBridge->probeFinished());
+  ASSERT_TRUE(restoreNext(*joinBridge));
+  joinBridge->setHashTable(createFakeHashTable(), {}, false);
+  ASSERT_TRUE(joinBridge->tableOrFuture(&future)->restoredPartitionSkewed);
+
+  // [2,1] and [0,1] are not.
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_TRUE(joinBridge->probeFinished());
+    ASSERT_FALSE(restoreNext(*joinBridge));
+    joinBridge->setHashTable(createFakeHashTable(), {}, false);
+    ASSERT_FALSE(joinBridge->tableOrFuture(&future)->restoredPartitionSkewed);
+  }
+  ASSERT_FALSE(joinBridge->probeFinished());
+}
+
 TEST_P(HashJoinBridgeTest, multiThreading) {
   for (int32_t iter = 0; iter < 10; ++iter) {
     std::vector<std::thread> builderThreads;
@@ -3323,6 +3323,54 @@ TEST_F(HashJoinTest, duplicateJoinKeys) {
   }
 }
 
+TEST_F(HashJoinTest, unusedBuildColumns) {
+  auto probeVectors = makeBatches(3, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"t0", "t1"},
+        {
+            makeFlatVector<int64_t>(100, [](auto row) { return row % 23; }),
+            makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+        });
+  });
+  auto buildVectors = makeBatches(3, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"u0", "u1", "u2", "u3"},
+        {
+            makeFlatVector<int64_t>(50, [](auto row) { return row % 31; }),
+            makeFlatVector<int64_t>(50, [](auto row) { return row * 2; }),
+            makeFlatVector<int32_t>(50, [](auto row) { return row; }),
+            makeFlatVector<int64_t>(50, [](auto row) { return row * 3; }),
+        });
+  });
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .hashJoin(
+                      {"t0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "t1 > u3",
+                      {"t0", "t1", "u1"})
+                  .planNode();
+
+  // 'u2' is neither in the output nor in the filter and is not stored in the
+  // table.
+  auto joinNode = std::dynamic_pointer_cast<const core::HashJoinNode>(plan);
+  ASSERT_EQ(
+      hashJoinTableType(joinNode)->toString(),
+      "ROW<u0:BIGINT,u1:BIGINT,u3:BIGINT>");
+
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .planNode(plan)
+      .referenceQuery("SELECT t0, t1, u1 FROM t, u WHERE t0 = u0 AND t1 > u3")
+      .run();
+}
+
 TEST_F(HashJoinTest, semiProject) {
   // Some keys have multiple rows: 2, 3, 5.
   auto probeVectors = makeBatches(3, [&](int32_t /*unused*/) {
@@ -3439,6 +3487,72 @@ TEST_F(HashJoinTest, semiProject) {
       .run();
 }
 
+TEST_F(HashJoinTest, semiAndAntiJoinDuplicateProbeKeys) {
+  // Two keys with a large combined range so that the table is in hash mode.
+  // Runs of 10 consecutive probe rows share a dictionary index and therefore
+  // their keys.
+  constexpr int64_t kStep = 1'000'000'007;
+  auto indices = makeIndices(1'000, [](auto row) { return row / 10; });
+  auto probeVectors = makeBatches(3, [&](int32_t /*unused*/) {
+    return makeRowVector({
+        wrapInDictionary(
+            indices,
+            1'000,
+            makeFlatVector<int64_t>(100, [](auto row) { return row * kStep; })),
+        wrapInDictionary(
+            indices,
+            1'000,
+            makeFlatVector<int64_t>(
+                100, [](auto row) { return -row * kStep; })),
+    });
+  });
+  auto buildVectors = makeBatches(1, [&](int32_t /*unused*/) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(50, [](auto row) { return 2 * row * kStep; }),
+        makeFlatVector<int64_t>(50, [](auto row) { return -2 * row * kStep; }),
+    });
+  });
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto& [joinType, referenceQuery] :
+       std::vector<std::pair<core::JoinType, std::string>>{
+           {core::JoinType::kLeftSemiFilter,
+            "SELECT * FROM t WHERE EXISTS "
+            "(SELECT * FROM u WHERE t.c0 = u.c0 AND t.c1 = u.c1)"},
+           {core::JoinType::kAnti,
+            "SELECT * FROM t WHERE NOT EXISTS "
+            "(SELECT * FROM u WHERE t.c0 = u.c0 AND t.c1 = u.c1)"}}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId joinNodeId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .hashJoin(
+                        {"c0", "c1"},
+                        {"u0", "u1"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .project({"c0 AS u0", "c1 AS u1"})
+                            .planNode(),
+                        "",
+                        {"c0", "c1"},
+                        joinType)
+                    .capturePlanNodeId(joinNodeId)
+                    .planNode();
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(plan)
+        .referenceQuery(referenceQuery)
+        .injectSpill(false)
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+          const auto probeStats =
+              toPlanStats(task->taskStats()).at(joinNodeId).customStats;
+          ASSERT_GT(probeStats.at("numDedupedProbeRows").sum, 0);
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, semiProjectWithNullKeys) {
   // Some keys have multiple rows: 2, 3, 5.
   auto probeVectors = makeBatches(3, [&](int32_t /*unused*/) {
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/VectorHasher.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 using namespace facebook::velox;
@@ -170,3 +171,26 @@ TEST_F(HashPartitionFunctionTest, noKeyAndBitRange) {
   ASSERT_TRUE(singlePartition.has_value());
   EXPECT_EQ(singlePartition.value(), 0u);
 }
+
+TEST_F(HashPartitionFunctionTest, modulo) {
+  const int numRows = 10'000;
+  auto vector = makeRowVector({makeFlatVector<int64_t>(
+      numRows, [](auto row) { return row * 7'919 - 1'000'000; })});
+  auto rowType = asRowType(vector->type());
+
+  SelectivityVector rows(numRows);
+  raw_vector<uint64_t> hashes(numRows);
+  auto hasher = VectorHasher::create(BIGINT(), 0);
+  hasher->decode(*vector->childAt(0), rows);
+  hasher->hash(rows, false, hashes);
+
+  for (int numPartitions : {1, 2, 3, 7, 100, 1'000, 4'096, 65'521}) {
+    SCOPED_TRACE(fmt::format("numPartitions: {}", numPartitions));
+    std::vector<uint32_t> partitions(numRows);
+    HashPartitionFunction function(numPartitions, rowType, {0});
+    function.partition(*vector, partitions);
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(hashes[i] % numPartitions, partitions[i]) << i;
+    }
+  }
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/HashTableCache.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class HashTableCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  std::unique_ptr<BaseHashTable> createTable() {
+    std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+    keyHashers.emplace_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+    return HashTable<true>::createForJoin(
+        std::move(keyHashers), {}, true, false, 1'000, pool_.get());
+  }
+
+  std::shared_ptr<HashJoinBridge> createJoinBridge() {
+    auto bridge = std::make_shared<HashJoinBridge>();
+    bridge->addBuilder();
+    bridge->start();
+    return bridge;
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+  HashTableCache* const cache_{HashTableCache::getInstance()};
+};
+
+TEST_F(HashTableCacheTest, acquireAndRelease) {
+  auto entry = cache_->acquire("query", "0", "task.0");
+  ASSERT_TRUE(entry->isBuilder("task.0"));
+  ASSERT_EQ(entry, cache_->acquire("query", "0", "task.0"));
+  auto otherEntry = cache_->acquire("query", "0", "task.1");
+  ASSERT_EQ(entry, otherEntry);
+  ASSERT_FALSE(otherEntry->isBuilder("task.1"));
+
+  auto otherJoin = cache_->acquire("query", "1", "task.1");
+  ASSERT_NE(entry, otherJoin);
+  ASSERT_TRUE(otherJoin->isBuilder("task.1"));
+  ASSERT_EQ(2, cache_->numEntries());
+
+  cache_->release(otherJoin, "task.1");
+  ASSERT_EQ(1, cache_->numEntries());
+  entry->setTable(createTable(), {pool_}, false);
+  cache_->release(entry, "task.0");
+  cache_->release(entry, "task.0");
+  ASSERT_EQ(1, cache_->numEntries());
+  ASSERT_TRUE(entry->hasTable());
+  cache_->release(entry, "task.1");
+  ASSERT_EQ(0, cache_->numEntries());
+  VELOX_ASSERT_THROW(
+      cache_->release(entry, "task.1"),
+      "Releasing unknown hash table cache entry");
+}
+
+TEST_F(HashTableCacheTest, shareTable) {
+  auto entry = cache_->acquire("query", "0", "task.0");
+  auto waitingEntry = cache_->acquire("query", "0", "task.1");
+  auto waitingBridge = createJoinBridge();
+  waitingEntry->addWaiter(waitingBridge);
+
+  auto future = ContinueFuture::makeEmpty();
+  ASSERT_FALSE(waitingBridge->tableOrFuture(&future).has_value());
+
+  auto table = createTable();
+  auto* rawTable = table.get();
+  entry->setTable(std::move(table), {pool_}, false);
+  future.wait();
+  auto result = waitingBridge->tableOrFuture(&future);
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(rawTable, result->table.get());
+
+  // A bridge added after the build gets the table right away.
+  auto lateBridge = createJoinBridge();
+  waitingEntry->addWaiter(lateBridge);
+  result = lateBridge->tableOrFuture(&future);
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(rawTable, result->table.get());
+
+  VELOX_ASSERT_THROW(
+      entry->setTable(createTable(), {pool_}, false), "is already set");
+
+  // The table outlives the cache entry.
+  cache_->release(entry, "task.0");
+  cache_->release(waitingEntry, "task.1");
+  ASSERT_EQ(0, cache_->numEntries());
+  entry.reset();
+  waitingEntry.reset();
+  ASSERT_EQ(rawTable, result->table.get());
+  ASSERT_EQ(0, result->table->numDistinct());
+}
+
+TEST_F(HashTableCacheTest, builderFailure) {
+  auto entry = cache_->acquire("query", "0", "task.0");
+  auto waitingEntry = cache_->acquire("query", "0", "task.1");
+  auto waitingBridge = createJoinBridge();
+  waitingEntry->addWaiter(waitingBridge);
+
+  // The builder releases the entry without setting the table.
+  cache_->release(entry, "task.0");
+  auto future = ContinueFuture::makeEmpty();
+  VELOX_ASSERT_THROW(
+      waitingBridge->tableOrFuture(&future),
+      "Getting hash table after join is aborted");
+
+  auto lateBridge = createJoinBridge();
+  waitingEntry->addWaiter(lateBridge);
+  VELOX_ASSERT_THROW(
+      lateBridge->tableOrFuture(&future),
+      "Getting hash table after join is aborted");
+  VELOX_ASSERT_THROW(
+      entry->setTable(createTable(), {pool_}, false), "is cancelled");
+  cache_->release(waitingEntry, "task.1");
+  ASSERT_EQ(0, cache_->numEntries());
+}
@@ -644,6 +644,89 @@ TEST_P(HashTableTest, clear) {
   }
 }
 
+TEST_P(HashTableTest, reusePrefixHashes) {
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+  hashers.push_back(std::make_unique<VectorHasher>(VARCHAR(), 1));
+  hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 2));
+  auto table = HashTable<false>::createForAggregation(
+      std::move(hashers), {}, pool());
+  table->forceGenericHashMode();
+
+  HashLookup lookup(table->hashers());
+  HashLookup reusingLookup(table->hashers());
+  reusingLookup.reusePrefixHashes = true;
+
+  constexpr vector_size_t kSize = 1'000;
+  auto makeInput = [&](int32_t seed) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(kSize, [&](auto row) { return row + seed; }),
+        makeFlatVector<std::string>(
+            kSize,
+            [&](auto row) { return fmt::format("{}-{}", row % 17, seed); }),
+        makeFlatVector<int64_t>(kSize, [&](auto row) { return row % 7; }),
+    });
+  };
+  auto nullBigint = BaseVector::createNullConstant(BIGINT(), kSize, pool());
+  auto nullVarchar = BaseVector::createNullConstant(VARCHAR(), kSize, pool());
+
+  // The batches of a ROLLUP over two input batches.
+  std::vector<RowVectorPtr> batches;
+  for (auto seed : {0, 1}) {
+    auto input = makeInput(seed);
+    const auto& keys = input->children();
+    batches.push_back(input);
+    batches.push_back(makeRowVector({keys[0], keys[1], nullBigint}));
+    batches.push_back(makeRowVector({keys[0], nullVarchar, nullBigint}));
+    batches.push_back(makeRowVector({nullBigint, nullVarchar, nullBigint}));
+  }
+
+  SelectivityVector rows(kSize);
+  for (auto i = 0; i < batches.size(); ++i) {
+    SCOPED_TRACE(fmt::format("batch {}", i));
+    table->prepareForGroupProbe(
+        lookup,
+        batches[i],
+        rows,
+        false,
+        BaseHashTable::kNoSpillInputStartPartitionBit);
+    table->prepareForGroupProbe(
+        reusingLookup,
+        batches[i],
+        rows,
+        false,
+        BaseHashTable::kNoSpillInputStartPartitionBit);
+    for (auto row = 0; row < kSize; ++row) {
+      ASSERT_EQ(lookup.hashes[row], reusingLookup.hashes[row]);
+    }
+    ASSERT_EQ(batches[i]->childAt(0), reusingLookup.prefixKeys[0]);
+    ASSERT_EQ(batches[i]->childAt(1), reusingLookup.prefixKeys[1]);
+  }
+
+  // Other rows do not reuse the hashes of the previous input.
+  rows.setValid(3, false);
+  rows.updateBounds();
+  table->prepareForGroupProbe(
+      lookup,
+      batches[0],
+      rows,
+      false,
+      BaseHashTable::kNoSpillInputStartPartitionBit);
+  table->prepareForGroupProbe(
+      reusingLookup,
+      batches[0],
+      rows,
+      false,
+      BaseHashTable::kNoSpillInputStartPartitionBit);
+  rows.applyToSelected([&](auto row) {
+    ASSERT_EQ(lookup.hashes[row], reusingLookup.hashes[row]);
+  });
+  ASSERT_EQ(rows, reusingLookup.prefixRows);
+
+  reusingLookup.clearPrefixHashes();
+  ASSERT_TRUE(reusingLookup.prefixKeys.empty());
+}
+
 // Test a specific code path in HashTable::decodeHashMode where
 // rangesWithReserve overflows, distinctsWithReserve fits and bestWithReserve =
 // rangesWithReserve.
@@ -772,6 +855,10 @@ TEST_P(HashTableTest, arrayProbeNormalizedKey) {
   }
 
   ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kNormalizedKey);
+  const auto stats = table->stats();
+  ASSERT_GT(stats.numRehashes, 0);
+  ASSERT_GT(stats.rehashWallNanos, 0);
+  ASSERT_GE(stats.peakTableBytes, stats.capacity * sizeof(char*));
 }
 
 TEST_P(HashTableTest, regularHashingTableSize) {
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/LocalPartition.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -228,6 +229,31 @@ TEST_F(LocalPartitionTest, maxBufferSizeGather) {
   verifyExchangeSourceOperatorStats(task, 2100, 21);
 }
 
+TEST_F(LocalPartitionTest, memoryManager) {
+  LocalExchangeMemoryManager memoryManager(100);
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  ASSERT_FALSE(memoryManager.increaseMemoryUsage(&future, 60));
+  ASSERT_FALSE(future.valid());
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(10).empty());
+
+  // Reaching the limit blocks the producer until the usage goes below it.
+  ASSERT_TRUE(memoryManager.increaseMemoryUsage(&future, 50));
+  ASSERT_TRUE(future.valid());
+  ASSERT_FALSE(future.isReady());
+  ContinueFuture otherFuture = ContinueFuture::makeEmpty();
+  ASSERT_TRUE(memoryManager.increaseMemoryUsage(&otherFuture, 10));
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(10).empty());
+
+  auto promises = memoryManager.decreaseMemoryUsage(20);
+  ASSERT_EQ(promises.size(), 2);
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  ASSERT_TRUE(future.isReady());
+  ASSERT_TRUE(otherFuture.isReady());
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(80).empty());
+}
+
 TEST_F(LocalPartitionTest, maxBufferSizePartition) {
   std::vector<RowVectorPtr> vectors;
   for (auto i = 0; i < 21; i++) {
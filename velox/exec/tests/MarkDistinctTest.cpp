@@ -14,9 +14,12 @@
  * limitations under the License.
  */
 
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::test;
@@ -141,3 +144,54 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, spill) {
+  filesystems::registerLocalFileSystem();
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 8; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row) % 1'500; }),
+        makeFlatVector<int32_t>(1'000, [&](auto row) { return row % 7; }),
+        makeFlatVector<std::string>(
+            1'000, [&](auto row) { return fmt::format("{}", row % 11); }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId markDistinctId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .markDistinct("c1_distinct", {"c0", "c1"})
+                  .capturePlanNodeId(markDistinctId)
+                  .markDistinct("c2_distinct", {"c0", "c2"})
+                  .singleAggregation(
+                      {"c0"},
+                      {"sum(c1)", "count(c2)"},
+                      {"c1_distinct", "c2_distinct"})
+                  .planNode();
+
+  for (const auto spillEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("spillEnabled {}", spillEnabled));
+    const auto spillDirectory = TempDirectoryPath::create();
+    exec::TestScopedSpillInjection scopedSpillInjection(spillEnabled ? 100 : 0);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->getPath())
+            .config(core::QueryConfig::kSpillEnabled, true)
+            .config(core::QueryConfig::kMarkDistinctSpillEnabled, spillEnabled)
+            .config(core::QueryConfig::kSpillNumPartitionBits, 2)
+            .assertResults(
+                "SELECT c0, sum(distinct c1), count(distinct c2) "
+                "FROM tmp GROUP BY 1");
+
+    const auto stats = toPlanStats(task->taskStats()).at(markDistinctId);
+    if (spillEnabled) {
+      ASSERT_GT(stats.spilledBytes, 0);
+      ASSERT_GT(stats.spilledRows, 0);
+      ASSERT_EQ(stats.spilledPartitions, 8);
+    } else {
+      ASSERT_EQ(stats.spilledBytes, 0);
+    }
+  }
+}
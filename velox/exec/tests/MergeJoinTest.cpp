@@ -201,6 +201,17 @@ TEST_F(MergeJoinTest, duplicateMatch) {
       [](auto row) { return row / 2; }, [](auto row) { return row / 3; });
 }
 
+TEST_F(MergeJoinTest, longSkipsAndRuns) {
+  // Long stretches of non-matching rows on either side.
+  testJoin<int64_t>(
+      [](auto row) { return row * 100; }, [](auto row) { return row; });
+  testJoin<int64_t>(
+      [](auto row) { return row; }, [](auto row) { return row * 100 + 50; });
+  // Long runs of equal keys.
+  testJoin<int16_t>(
+      [](auto row) { return row / 50; }, [](auto row) { return row / 30; });
+}
+
 TEST_F(MergeJoinTest, allRowsMatch) {
   std::vector<VectorPtr> leftKeys = {
       makeFlatVector<int32_t>(2, [](auto /* row */) { return 5; }),
@@ -152,6 +152,34 @@ TEST_F(MergeTest, localMerge) {
   testTwoKeys(vectors, "c3", "c0");
 }
 
+/// Verifies merging on keys compared by their normalized prefix. The strings
+/// share their leading bytes beyond the encoded string prefix.
+TEST_F(MergeTest, normalizedKeys) {
+  vector_size_t batchSize = 500;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    auto c0 = makeFlatVector<double>(
+        batchSize,
+        [&](auto row) { return (row % 7 - 3) * 0.5; },
+        nullEvery(13));
+    auto c1 = makeFlatVector<std::string>(
+        batchSize,
+        [&](auto row) {
+          return fmt::format("common prefix {}", (row + i) % 37);
+        },
+        nullEvery(17));
+    auto c2 = makeFlatVector<int32_t>(
+        batchSize, [&](auto row) { return row % 5 - i; }, nullEvery(11));
+    vectors.push_back(makeRowVector({c0, c1, c2}));
+  }
+  createDuckDbTable(vectors);
+
+  testSingleKey(vectors, "c1");
+  testTwoKeys(vectors, "c0", "c1");
+  testTwoKeys(vectors, "c2", "c0");
+  testTwoKeys(vectors, "c1", "c2");
+}
+
 /// Verifies an edge case where output batch fills up when one of the sources
 /// has only one row left.
 TEST_F(MergeTest, offByOne) {
@@ -2055,6 +2055,7 @@ TEST_F(MultiFragmentTest, compression) {
           producerStats.customStats.at("compressedBytes").sum,
           producerStats.customStats.at("compressionInputBytes").sum);
       EXPECT_EQ(0, producerStats.customStats.at("compressionSkippedBytes").sum);
+      EXPECT_LT(0, producerStats.customStats.at("compressionCpuNanos").sum);
     } else {
       EXPECT_LT(0, producerStats.customStats.at("compressionSkippedBytes").sum);
     }
@@ -2062,6 +2063,12 @@ TEST_F(MultiFragmentTest, compression) {
 
   test(0.7, false);
   test(0.0000001, true);
+
+  // Compression that saves too few bytes for its CPU time is skipped as well.
+  configSettings_
+      [core::QueryConfig::kPartitionedOutputMinCompressionSavedBytesPerMicro] =
+          "1000000000";
+  test(0.7, true);
 }
 
 } // namespace
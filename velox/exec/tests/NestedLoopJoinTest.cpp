@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/VectorTestUtil.h"
@@ -421,3 +423,60 @@ TEST_F(NestedLoopJoinTest, allTypes) {
       "SELECT t0, u0 FROM t {0} JOIN u ON t.t0 {1} u0 AND t1 {1} u1 AND t2 {1} u2 AND t3 {1} u3 AND t4 {1} u4 AND t5 {1} u5 AND t6 {1} u6");
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
+
+TEST_F(NestedLoopJoinTest, rangeJoin) {
+  std::vector<RowVectorPtr> probeVectors = {makeRowVector(
+      {"t0"},
+      {makeFlatVector<int64_t>(
+          1'000, [](auto row) { return row; }, nullEvery(97))})};
+  // Intervals of up to 7 values starting every 10 values.
+  std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(
+           100, [](auto row) { return 10 * row; }, nullEvery(23)),
+       makeFlatVector<int64_t>(
+           100, [](auto row) { return 10 * row + row % 7; }, nullEvery(31))})};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  const std::vector<std::string> conditions = {
+      "t0 BETWEEN u0 AND u1",
+      "t0 >= u0 AND t0 < u1",
+      "u0 < t0 AND u1 >= t0",
+      "t0 > u0 AND t0 - u0 < 15",
+      "u1 > t0 AND t0 + u0 > 900",
+  };
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  for (const auto& condition : conditions) {
+    for (const auto joinType : joinTypes_) {
+      SCOPED_TRACE(
+          fmt::format("{} JOIN ON {}", joinTypeName(joinType), condition));
+      core::PlanNodeId joinId;
+      auto plan = PlanBuilder(planNodeIdGenerator)
+                      .values(probeVectors)
+                      .nestedLoopJoin(
+                          PlanBuilder(planNodeIdGenerator)
+                              .values(buildVectors)
+                              .planNode(),
+                          condition,
+                          {"t0", "u0", "u1"},
+                          joinType)
+                      .capturePlanNodeId(joinId)
+                      .planNode();
+      const auto sql = fmt::format(
+          "SELECT t0, u0, u1 FROM t {} JOIN u ON {}",
+          joinTypeName(joinType),
+          condition);
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_).assertResults(sql);
+      // The condition is evaluated for fewer pairs than the 100K pairs of
+      // rows.
+      const auto stats = toPlanStats(task->taskStats()).at(joinId);
+      ASSERT_LT(stats.customStats.at("rangeJoinPairs").sum, 60'000);
+
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kNestedLoopJoinRangeIndexEnabled, false)
+          .assertResults(sql);
+    }
+  }
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/SharedArbitrator.h"
+#include "velox/common/time/Timer.h"
+#include "velox/core/QueryConfig.h"
+#include "velox/exec/OperatorTrace.h"
+#include "velox/exec/PartitionFunction.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+
+DEFINE_string(
+    trace_node_dir,
+    "",
+    "The directory of the trace of one plan node of one task, i.e. "
+    "<operator_trace_dir>/<task id>/<plan node id>.");
+
+DEFINE_int32(iterations, 10, "Number of times to run the traced plan node");
+
+DEFINE_int32(max_drivers, 1, "Number of drivers to run the plan node with");
+
+DEFINE_int64(
+    query_memory_capacity_mb,
+    0,
+    "Memory capacity of the replayed query in MB. 0 means unlimited.");
+
+DEFINE_string(
+    spill_dir,
+    "",
+    "Directory to spill to. Enables spilling if set, e.g. to replay with a "
+    "small query_memory_capacity_mb.");
+
+DEFINE_bool(print_stats, false, "Print the plan with stats of each run");
+
+using namespace facebook::velox;
+
+namespace {
+
+// Returns the config to replay the trace with. Drops the trace configs so that
+// the replay does not trace itself.
+std::unordered_map<std::string, std::string> replayConfig(
+    std::unordered_map<std::string, std::string> config) {
+  config.erase(core::QueryConfig::kOperatorTraceDir);
+  config.erase(core::QueryConfig::kOperatorTraceNodeIds);
+  const auto spill = FLAGS_spill_dir.empty() ? "false" : "true";
+  for (const auto* key :
+       {core::QueryConfig::kSpillEnabled,
+        core::QueryConfig::kAggregationSpillEnabled,
+        core::QueryConfig::kJoinSpillEnabled,
+        core::QueryConfig::kOrderBySpillEnabled,
+        core::QueryConfig::kWindowSpillEnabled}) {
+    config[key] = spill;
+  }
+  return config;
+}
+
+void replay() {
+  VELOX_USER_CHECK(!FLAGS_trace_node_dir.empty(), "--trace_node_dir not set");
+  auto pool = memory::memoryManager()->addLeafPool("replayer");
+  const auto trace = exec::readOperatorTrace(FLAGS_trace_node_dir, pool.get());
+  const auto config = replayConfig(trace.queryConfig);
+  LOG(INFO) << "Replaying " << trace.numInputRows << " input rows of:\n"
+            << trace.plan->toString(true, false);
+
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(
+      std::max<int32_t>(FLAGS_max_drivers, 1));
+  const int64_t capacity = FLAGS_query_memory_capacity_mb == 0
+      ? memory::kMaxMemory
+      : FLAGS_query_memory_capacity_mb << 20;
+  std::vector<uint64_t> runMicros;
+  for (auto i = 0; i < FLAGS_iterations; ++i) {
+    exec::test::CursorParameters params;
+    params.planNode = trace.plan;
+    params.maxDrivers = FLAGS_max_drivers;
+    params.copyResult = false;
+    params.spillDirectory = FLAGS_spill_dir;
+    params.queryCtx = std::make_shared<core::QueryCtx>(
+        executor.get(),
+        core::QueryConfig(config),
+        std::unordered_map<std::string, std::shared_ptr<Config>>{},
+        cache::AsyncDataCache::getInstance(),
+        memory::memoryManager()->addRootPool(
+            fmt::format("replay_{}", i), capacity));
+
+    uint64_t micros{0};
+    uint64_t numOutputRows{0};
+    std::shared_ptr<exec::Task> task;
+    {
+      MicrosecondTimer timer(&micros);
+      auto [cursor, results] =
+          exec::test::readCursor(params, [](exec::Task*) {});
+      for (const auto& result : results) {
+        numOutputRows += result->size();
+      }
+      task = cursor->task();
+    }
+    runMicros.push_back(micros);
+    const auto stats = task->taskStats();
+    uint64_t spilledBytes{0};
+    for (const auto& pipelineStats : stats.pipelineStats) {
+      for (const auto& operatorStats : pipelineStats.operatorStats) {
+        spilledBytes += operatorStats.spilledBytes;
+      }
+    }
+    LOG(INFO) << "Run " << i << ": " << succinctMicros(micros) << ", "
+              << numOutputRows << " output rows, spilled "
+              << succinctBytes(spilledBytes);
+    if (FLAGS_print_stats) {
+      LOG(INFO) << exec::printPlanWithStats(*trace.plan, stats, true);
+    }
+  }
+  if (!runMicros.empty()) {
+    std::sort(runMicros.begin(), runMicros.end());
+    LOG(INFO) << "Min " << succinctMicros(runMicros.front()) << ", median "
+              << succinctMicros(runMicros[runMicros.size() / 2]) << ", max "
+              << succinctMicros(runMicros.back());
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::SharedArbitrator::registerFactory();
+  memory::MemoryManagerOptions options;
+  options.arbitratorKind = "SHARED";
+  memory::MemoryManager::initialize(options);
+  filesystems::registerLocalFileSystem();
+
+  Type::registerSerDe();
+  common::Filter::registerSerDe();
+  core::ITypedExpr::registerSerDe();
+  core::PlanNode::registerSerDe();
+  exec::registerPartitionFunctionSerDe();
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  window::prestosql::registerAllWindowFunctions();
+
+  replay();
+  return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/OperatorTrace.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/PartitionFunction.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+namespace facebook::velox::exec::test {
+namespace {
+
+class OperatorTraceTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    filesystems::registerLocalFileSystem();
+    Type::registerSerDe();
+    core::ITypedExpr::registerSerDe();
+    core::PlanNode::registerSerDe();
+    registerPartitionFunctionSerDe();
+  }
+
+  // Runs 'plan' with the input of 'tracedNodeId' captured. Returns the result
+  // and the trace.
+  std::pair<RowVectorPtr, OperatorTrace> runTraced(
+      const core::PlanNodePtr& plan,
+      const core::PlanNodeId& tracedNodeId) {
+    std::shared_ptr<Task> task;
+    auto result =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kOperatorTraceDir, traceDir_->getPath())
+            .config(core::QueryConfig::kOperatorTraceNodeIds, tracedNodeId)
+            .copyResults(pool(), task);
+    nodeDir_ = operatorTraceDirectory(
+        traceDir_->getPath(), task->taskId(), tracedNodeId);
+    return {result, readOperatorTrace(nodeDir_, pool())};
+  }
+
+  std::vector<std::string> traceFileNames() const {
+    std::vector<std::string> names;
+    for (const auto& path :
+         filesystems::getFileSystem(nodeDir_, nullptr)->list(nodeDir_)) {
+      names.push_back(path.substr(path.rfind('/') + 1));
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+  }
+
+  const std::shared_ptr<TempDirectoryPath> traceDir_ =
+      TempDirectoryPath::create();
+  std::string nodeDir_;
+};
+
+TEST_F(OperatorTraceTest, aggregation) {
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 17; }),
+      makeFlatVector<int64_t>(1'000, folly::identity),
+  });
+  core::PlanNodeId aggregationId;
+  const auto plan = PlanBuilder()
+                        .values({data, data})
+                        .filter("c1 % 3 = 0")
+                        .singleAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                        .capturePlanNodeId(aggregationId)
+                        .planNode();
+  const auto [expected, trace] = runTraced(plan, aggregationId);
+
+  ASSERT_EQ(2 * 334, trace.numInputRows);
+  ASSERT_EQ(aggregationId, trace.plan->id());
+  ASSERT_EQ(
+      aggregationId,
+      trace.queryConfig.at(core::QueryConfig::kOperatorTraceNodeIds));
+  ASSERT_EQ(
+      std::vector<std::string>({"Aggregation.0.0.data", "summary.json"}),
+      traceFileNames());
+  AssertQueryBuilder(trace.plan).assertResults(expected);
+}
+
+TEST_F(OperatorTraceTest, hashJoin) {
+  const auto probe = makeRowVector(
+      {"t0", "t1"},
+      {
+          makeFlatVector<int64_t>(1'000, [](auto row) { return row % 50; }),
+          makeFlatVector<int64_t>(1'000, folly::identity),
+      });
+  const auto build = makeRowVector(
+      {"u0", "u1"},
+      {
+          makeFlatVector<int64_t>(30, folly::identity),
+          makeFlatVector<int64_t>(30, [](auto row) { return row * 10; }),
+      });
+  core::PlanNodeId joinId;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  const auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values({probe})
+          .hashJoin(
+              {"t0"},
+              {"u0"},
+              PlanBuilder(planNodeIdGenerator).values({build}).planNode(),
+              "",
+              {"t1", "u1"})
+          .capturePlanNodeId(joinId)
+          .planNode();
+  const auto [expected, trace] = runTraced(plan, joinId);
+
+  ASSERT_EQ(1'030, trace.numInputRows);
+  ASSERT_EQ(
+      std::vector<std::string>(
+          {"HashBuild.1.0.data", "HashProbe.0.0.data", "summary.json"}),
+      traceFileNames());
+  AssertQueryBuilder(trace.plan).assertResults(expected);
+}
+
+TEST_F(OperatorTraceTest, notTraced) {
+  const auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  const auto plan =
+      PlanBuilder().values({data}).project({"c0 + 1"}).planNode();
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kOperatorTraceDir, traceDir_->getPath())
+      .config(core::QueryConfig::kOperatorTraceNodeIds, "unknown")
+      .copyResults(pool(), task);
+  ASSERT_EQ("", task->operatorTraceDirectory(plan->id()));
+  ASSERT_FALSE(filesystems::getFileSystem(traceDir_->getPath(), nullptr)
+                   ->exists(fmt::format(
+                       "{}/{}", traceDir_->getPath(), task->taskId())));
+}
+
+} // namespace
+} // namespace facebook::velox::exec::test
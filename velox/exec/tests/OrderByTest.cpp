@@ -401,6 +401,62 @@ TEST_F(OrderByTest, varfields) {
   testSingleKey(vectors, "c2");
 }
 
+TEST_F(OrderByTest, parallelSort) {
+  vector_size_t batchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](vector_size_t row) { return (batchSize * i + row) % 1'234; },
+        nullEvery(7));
+    auto c1 = makeFlatVector<StringView>(
+        batchSize,
+        [&](vector_size_t row) {
+          return StringView::makeInline(std::to_string(row % 17));
+        },
+        nullEvery(13));
+    vectors.push_back(makeRowVector({c0, c1}));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::vector<std::string>> keys = {
+      {"c0 NULLS LAST"},
+      {"c0 DESC NULLS FIRST"},
+      {"c1 NULLS FIRST", "c0 DESC NULLS LAST"}};
+  const std::vector<std::vector<uint32_t>> keyIndices = {{0}, {0}, {1, 0}};
+  const std::vector<std::string> filters = {"", "c0 < 0"};
+  for (const auto& filter : filters) {
+    for (auto i = 0; i < keys.size(); ++i) {
+      const auto sql = fmt::format(
+          "SELECT * FROM (SELECT * FROM tmp UNION ALL SELECT * FROM tmp "
+          "UNION ALL SELECT * FROM tmp UNION ALL SELECT * FROM tmp) {} "
+          "ORDER BY {}",
+          filter.empty() ? "" : "WHERE " + filter,
+          folly::join(", ", keys[i]));
+      SCOPED_TRACE(sql);
+
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      auto source = PlanBuilder(planNodeIdGenerator).values(vectors, true);
+      if (!filter.empty()) {
+        source.filter(filter);
+      }
+      auto plan = PlanBuilder(planNodeIdGenerator)
+                      .localMerge(
+                          keys[i], {source.orderBy(keys[i], true).planNode()})
+                      .planNode();
+
+      auto queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+      queryCtx->testingOverrideConfigUnsafe(
+          {{core::QueryConfig::kParallelOrderByEnabled, "true"}});
+      CursorParameters params;
+      params.planNode = plan;
+      params.queryCtx = queryCtx;
+      params.maxDrivers = 4;
+      assertQueryOrdered(params, sql, keyIndices[i]);
+    }
+  }
+}
+
 TEST_F(OrderByTest, unknown) {
   vector_size_t size = 1'000;
   auto vector = makeRowVector({
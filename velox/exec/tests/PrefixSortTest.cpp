@@ -217,6 +217,30 @@ TEST_F(PrefixSortTest, multipleKeys) {
   }
 }
 
+TEST_F(PrefixSortTest, stringPrefix) {
+  // Strings that tie on the stored prefix, differ only in length or in
+  // trailing zero bytes are ordered by the full compare.
+  const auto data = makeRowVector({
+      makeNullableFlatVector<int32_t>({1, 1, 1, 1, 1, 1, 2, 2, std::nullopt}),
+      makeNullableFlatVector<std::string_view>(
+          {"abcdefghijklmnop",
+           "abcdefghijklmno",
+           "abcdefghijkl",
+           std::string_view("abcdefghijkl\0", 13),
+           "abc",
+           std::string_view("abc\0", 4),
+           std::nullopt,
+           "",
+           "zzz"}),
+      makeNullableFlatVector<int64_t>({3, 2, 1, 3, 2, 1, 3, 2, 1}),
+  });
+
+  testPrefixSort({kAsc, kAsc, kAsc}, data);
+  testPrefixSort({kDesc, kDesc, kDesc}, data);
+  testPrefixSort({kAsc, kDesc, kAsc}, data);
+  testPrefixSort({kDesc, kAsc, kDesc}, data);
+}
+
 TEST_F(PrefixSortTest, fuzz) {
   std::vector<TypePtr> keyTypes = {
       INTEGER(),
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -163,6 +164,8 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"        hashtable.capacity\\s+sum: 200, count: 1, min: 200, max: 200"},
        {"        hashtable.numDistinct\\s+sum: 100, count: 1, min: 100, max: 100"},
        {"        hashtable.numRehashes\\s+sum: 1, count: 1, min: 1, max: 1"},
+       {"        hashtable.peakTableBytes\\s+sum: .+, count: 1, min: .+, max: .+"},
+       {"        hashtable.rehashWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"        queuedWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"        rangeKey0\\s+sum: 200, count: 1, min: 200, max: 200"},
        {"        runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
@@ -197,6 +200,7 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"          numRamRead          [ ]* sum: 40, count: 1, min: 40, max: 40"},
        {"          numStorageRead      [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          overreadBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
+       {"          pagesSkippedByIndex[ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          prefetchBytes       [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          preloadedSplits[ ]+sum: .+, count: .+, min: .+, max: .+",
         true},
@@ -275,6 +279,8 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"      hashtable.numDistinct\\s+sum: 835, count: 1, min: 835, max: 835"},
          {"      hashtable.numRehashes\\s+sum: 1, count: 1, min: 1, max: 1"},
          {"      hashtable.numTombstones\\s+sum: 0, count: 1, min: 0, max: 0"},
+         {"      hashtable.peakTableBytes\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"      hashtable.rehashWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      loadedToValueHook\\s+sum: 50000, count: 5, min: 10000, max: 10000"},
          {"      runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
@@ -292,6 +298,7 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        numRamRead       [ ]* sum: 6, count: 1, min: 6, max: 6"},
          {"        numStorageRead   [ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        overreadBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
+         {"        pagesSkippedByIndex[ ]* sum: 0, count: 1, min: 0, max: 0"},
 
          {"        prefetchBytes    [ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        preloadedSplits[ ]+sum: .+, count: .+, min: .+, max: .+",
@@ -311,3 +318,36 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        totalScanTime    [ ]* sum: .+, count: .+, min: .+, max: .+"}});
   }
 }
+
+TEST_F(PrintPlanWithStatsTest, perfCounters) {
+  auto vectors = makeVectors(ROW({"c0"}, {BIGINT()}), 10, 1'000);
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0 * 2 AS c1", "c0 + 1 AS c2"})
+                  .planNode();
+  std::shared_ptr<exec::Task> task;
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kOperatorTrackPerfCounters, "true")
+      .copyResults(pool(), task);
+  ensureTaskCompletion(task.get());
+
+  const auto& projectStats =
+      task->taskStats().pipelineStats[0].operatorStats[1].runtimeStats;
+  process::PerfCounters counters;
+  if (!process::readThreadPerfCounters(counters)) {
+    ASSERT_EQ(projectStats.count(exec::OperatorStats::kPerfCycles), 0);
+    GTEST_SKIP() << "Hardware counters are not available";
+  }
+  for (const auto* name :
+       {exec::OperatorStats::kPerfCycles,
+        exec::OperatorStats::kPerfInstructions,
+        exec::OperatorStats::kPerfLlcMisses,
+        exec::OperatorStats::kPerfBackendStallCycles}) {
+    ASSERT_EQ(projectStats.count(name), 1) << name;
+  }
+  if (projectStats.at(exec::OperatorStats::kPerfCycles).sum > 0) {
+    ASSERT_NE(
+        printPlanWithStats(*plan, task->taskStats()).find("IPC: "),
+        std::string::npos);
+  }
+}
@@ -1347,6 +1347,119 @@ TEST_F(RowContainerTest, equalAndCompareRowTypeDouble) {
   testEqualAndCompareRowContainerTypeFloat<double>(ROW({colName}, {DOUBLE()}));
 }
 
+TEST_F(RowContainerTest, equalsString) {
+  // Inline and out of line strings, including ones with equal sizes and
+  // prefixes.
+  auto lhs = makeFlatVector<StringView>(
+      {"", "abc", "abcdefghijkl", "abcdefghijkl", "abcdefghijklm", "abcd",
+       "abcdefghijklmnopqrstuvwxyz", "abcdefghijklmnopqrstuvwxyz",
+       "abcdefghijklmnopqrstuvwxy"});
+  auto rhs = makeFlatVector<StringView>(
+      {"", "abd", "abcdefghijkl", "abcdefghijkm", "abcdefghijklm", "abcde",
+       "abcdefghijklmnopqrstuvwxyz", "abcdefghijklmnopqrstuvwxyZ",
+       "abcdefghijklmnopqrstuvwxyz"});
+  std::vector<bool> expected{
+      true, false, true, false, true, false, true, false, false};
+  testRowContainerEqualsAPI<false>(VARCHAR(), lhs, rhs, expected);
+  testRowContainerEqualsAPI<true>(VARCHAR(), lhs, rhs, expected);
+}
+
+TEST_F(RowContainerTest, extractRepeatedStrings) {
+  auto input = makeNullableFlatVector<StringView>(
+      {"abcdefghijklmnopqrstuvwxyz",
+       std::nullopt,
+       "ABCDEFGHIJKLMNOPQRSTUVWXYZ"});
+  auto rowContainer = std::make_unique<RowContainer>(
+      std::vector<TypePtr>{VARCHAR()}, pool_.get());
+  DecodedVector decoded(*input);
+  auto rows = store(*rowContainer, decoded, input->size());
+
+  // Consecutive repeats of a row share the string extracted for the first.
+  std::vector<vector_size_t> rowNumbers{0, 0, -1, 0, 1, 2, 2, 0};
+  auto result = BaseVector::create(VARCHAR(), rowNumbers.size(), pool_.get());
+  rowContainer->extractColumn(
+      rows.data(),
+      folly::Range(rowNumbers.data(), rowNumbers.size()),
+      0,
+      0,
+      result);
+  assertEqualVectors(
+      makeNullableFlatVector<StringView>(
+          {"abcdefghijklmnopqrstuvwxyz",
+           "abcdefghijklmnopqrstuvwxyz",
+           std::nullopt,
+           "abcdefghijklmnopqrstuvwxyz",
+           std::nullopt,
+           "ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+           "ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+           "abcdefghijklmnopqrstuvwxyz"}),
+      result);
+  auto* flatResult = result->asFlatVector<StringView>();
+  EXPECT_EQ(flatResult->valueAt(0).data(), flatResult->valueAt(1).data());
+  EXPECT_EQ(flatResult->valueAt(0).data(), flatResult->valueAt(3).data());
+  EXPECT_EQ(flatResult->valueAt(5).data(), flatResult->valueAt(6).data());
+}
+
+TEST_F(RowContainerTest, storeBatch) {
+  constexpr int32_t kNumRows = 1'000;
+  auto rowType = ROW(
+      {{"key", BIGINT()},
+       {"string_val", VARCHAR()},
+       {"array_val", ARRAY(INTEGER())},
+       {"bool_val", BOOLEAN()}});
+  auto batch = makeDataset(rowType, kNumRows, [](RowVectorPtr /*rows*/) {});
+  std::vector<TypePtr> dependentTypes(
+      rowType->children().begin() + 1, rowType->children().end());
+  auto rowContainer = std::make_unique<RowContainer>(
+      std::vector<TypePtr>{BIGINT()}, dependentTypes, pool_.get());
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = rowContainer->newRow();
+  }
+  for (auto column = 0; column < rowType->size(); ++column) {
+    DecodedVector decoded(*batch->childAt(column));
+    rowContainer->store(
+        decoded, folly::Range(rows.data(), rows.size()), column);
+  }
+  for (auto column = 0; column < rowType->size(); ++column) {
+    auto result =
+        BaseVector::create(rowType->childAt(column), kNumRows, pool_.get());
+    rowContainer->extractColumn(rows.data(), kNumRows, column, result);
+    assertEqualVectors(batch->childAt(column), result);
+  }
+}
+
+TEST_F(RowContainerTest, extractColumns) {
+  // Enough rows for several tiles of extractColumns().
+  constexpr int32_t kNumRows = 10'000;
+  auto rowType = ROW(
+      {{"int_val", INTEGER()},
+       {"string_val", VARCHAR()},
+       {"array_val", ARRAY(BIGINT())},
+       {"double_val", DOUBLE()}});
+  auto batch = makeDataset(rowType, kNumRows, [](RowVectorPtr /*rows*/) {});
+  auto rowContainer =
+      std::make_unique<RowContainer>(rowType->children(), pool_.get());
+  auto rows = store(*rowContainer, batch);
+  std::mt19937 rng(1);
+  std::shuffle(rows.begin(), rows.end(), rng);
+
+  // Extracts the columns in a different order than they are stored.
+  std::vector<column_index_t> columns{3, 1, 0, 2};
+  std::vector<VectorPtr> results;
+  for (auto column : columns) {
+    results.push_back(
+        BaseVector::create(rowType->childAt(column), 1, pool_.get()));
+  }
+  rowContainer->extractColumns(rows.data(), kNumRows, columns, results);
+  for (auto i = 0; i < columns.size(); ++i) {
+    auto expected =
+        BaseVector::create(rowType->childAt(columns[i]), 0, pool_.get());
+    rowContainer->extractColumn(rows.data(), kNumRows, columns[i], expected);
+    assertEqualVectors(expected, results[i]);
+  }
+}
+
 TEST_F(RowContainerTest, partition) {
   // We assign an arbitrary partition number to each row and iterate over the
   // rows a partition at a time.
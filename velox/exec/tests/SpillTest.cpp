@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -516,6 +517,131 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, columnarLayout) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  constexpr int32_t kNumBatches = 4;
+  constexpr int32_t kNumRows = 10'000;
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(kNumRows, [&](auto row) { return i + row; }),
+        makeFlatVector<std::string>(
+            kNumRows,
+            [&](auto row) { return std::string(200, 'a' + (row % 26)); }),
+        makeFlatVector<double>(
+            kNumRows, [&](auto row) { return row * 0.5; }, nullEvery(7)),
+    }));
+  }
+
+  const auto spill = [&]() {
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "columnar",
+        1,
+        0,
+        {},
+        kGB,
+        0,
+        compressionKind_,
+        pool(),
+        &spillStats_,
+        "",
+        true);
+    state.setPartitionSpilled(0);
+    for (const auto& batch : batches) {
+      state.appendToPartition(0, batch);
+    }
+    state.finishFile(0);
+    auto files = state.finish(0);
+    for (const auto& file : files) {
+      EXPECT_TRUE(file.columnar);
+    }
+    return files;
+  };
+
+  // Reads back all the columns.
+  SpillPartition allColumns(SpillPartitionId{0, 0}, spill());
+  auto reader = allColumns.createUnorderedReader(pool(), &spillStats_);
+  RowVectorPtr output;
+  for (const auto& batch : batches) {
+    ASSERT_TRUE(reader->nextBatch(output));
+    facebook::velox::test::assertEqualVectors(batch, output);
+  }
+  ASSERT_FALSE(reader->nextBatch(output));
+
+  // Reads back the last and the first columns. The string column is skipped
+  // without reading it.
+  auto files = spill();
+  uint64_t fileBytes{0};
+  for (const auto& file : files) {
+    fileBytes += file.size;
+  }
+  SpillPartition someColumns(SpillPartitionId{0, 0}, std::move(files));
+  const auto readBytes = spillStats_.rlock()->spillReadBytes;
+  reader = someColumns.createUnorderedReader(pool(), &spillStats_, {2, 0});
+  for (const auto& batch : batches) {
+    ASSERT_TRUE(reader->nextBatch(output));
+    ASSERT_EQ(2, output->childrenSize());
+    facebook::velox::test::assertEqualVectors(
+        batch->childAt(2), output->childAt(0));
+    facebook::velox::test::assertEqualVectors(
+        batch->childAt(0), output->childAt(1));
+  }
+  ASSERT_FALSE(reader->nextBatch(output));
+  if (compressionKind_ == common::CompressionKind_NONE) {
+    ASSERT_LT(spillStats_.rlock()->spillReadBytes - readBytes, fileBytes);
+  }
+}
+
+TEST_P(SpillTest, readAhead) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  constexpr int32_t kNumFiles = 3;
+  // Each file is larger than the read buffer size of 1MB without compression.
+  constexpr int32_t kNumRows = 300'000;
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb_,
+      "readAhead",
+      1,
+      1,
+      {},
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_);
+  state.setPartitionSpilled(0);
+  // File 'i' has the values that are 'i' modulo 'kNumFiles'.
+  for (auto i = 0; i < kNumFiles; ++i) {
+    state.appendToPartition(
+        0, makeRowVector({makeFlatVector<int64_t>(kNumRows, [&](auto row) {
+          return row * kNumFiles + i;
+        })}));
+    state.finishFile(0);
+  }
+  auto files = state.finish(0);
+  ASSERT_EQ(kNumFiles, files.size());
+  uint64_t fileBytes{0};
+  for (const auto& file : files) {
+    fileBytes += file.size;
+  }
+
+  const auto readBytes = spillStats_.rlock()->spillReadBytes;
+  SpillPartition partition(SpillPartitionId{0, 0}, std::move(files));
+  auto merge =
+      partition.createOrderedReader(pool(), &spillStats_, executor.get());
+  for (int64_t i = 0; i < kNumRows * kNumFiles; ++i) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(i, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+  ASSERT_EQ(fileBytes, spillStats_.rlock()->spillReadBytes - readBytes);
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
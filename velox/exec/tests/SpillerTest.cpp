@@ -1243,6 +1243,33 @@ TEST_P(HashJoinBuildOnly, spillPartition) {
   VELOX_ASSERT_THROW(spiller_->spill(RowContainerIterator{}), "");
 }
 
+TEST_P(HashJoinBuildOnly, spillSomePartitions) {
+  setupSpillData(numKeys_, 1'000, 1, nullptr, {});
+  std::vector<std::vector<RowVectorPtr>> vectorsByPartition(numPartitions_);
+  HashPartitionFunction spillHashFunction(hashBits_, rowType_, keyChannels_);
+  splitByPartition(rowVector_, spillHashFunction, vectorsByPartition);
+  setupSpiller(100'000, 0, false);
+
+  int64_t numPartitionRows{0};
+  for (const auto& vector : vectorsByPartition[0]) {
+    numPartitionRows += vector->size();
+  }
+  ASSERT_EQ(spiller_->partitionBytes().size(), numPartitions_);
+  ASSERT_EQ(spiller_->partitionBytes()[0] > 0, numPartitionRows > 0);
+
+  // The spilled rows are erased from the container, the others stay.
+  spiller_->spill(SpillPartitionNumSet{0});
+  ASSERT_TRUE(spiller_->isSpilled(0));
+  ASSERT_EQ(spiller_->isAllSpilled(), numPartitions_ == 1);
+  ASSERT_EQ(rowContainer_->numRows(), 1'000 - numPartitionRows);
+  ASSERT_EQ(spiller_->partitionBytes()[0], 0);
+
+  spiller_->spill();
+  ASSERT_TRUE(spiller_->isAllSpilled());
+  rowContainer_->clear();
+  verifyNonSortedSpillData(allPartitionNumSet(), vectorsByPartition);
+}
+
 TEST_P(HashJoinBuildOnly, writeBufferSize) {
   std::vector<uint64_t> writeBufferSizes = {0, 4'000'000'000};
   for (const auto writeBufferSize : writeBufferSizes) {
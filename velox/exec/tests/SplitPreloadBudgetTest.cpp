@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/SplitPreloadBudget.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::exec;
+
+TEST(SplitPreloadBudgetTest, basic) {
+  SplitPreloadBudget budget(1'000);
+  EXPECT_EQ(1'000, budget.limit());
+  // A preload can start with nothing in flight even if it exceeds the limit.
+  EXPECT_TRUE(budget.canStart(2'000));
+  budget.started(600);
+  EXPECT_TRUE(budget.canStart(400));
+  EXPECT_FALSE(budget.canStart(401));
+  budget.started(400);
+
+  // The first split taken starts the window for measuring the rate.
+  budget.consumed(600, true, 1'000, 1'000'000);
+  EXPECT_EQ(400, budget.inFlightBytes());
+  EXPECT_EQ(1'000, budget.limit());
+
+  // 10K bytes in 100ms is 0.1 bytes per microsecond. The limit is twice the
+  // bytes taken during a 1ms preload.
+  budget.consumed(10'000, false, std::nullopt, 1'100'000);
+  EXPECT_EQ(400, budget.inFlightBytes());
+  EXPECT_EQ(200, budget.limit());
+  EXPECT_FALSE(budget.canStart(1));
+
+  // A slower preload raises the limit.
+  budget.consumed(400, true, 3'000, 1'150'000);
+  EXPECT_EQ(0, budget.inFlightBytes());
+  EXPECT_EQ(280, budget.limit());
+  EXPECT_TRUE(budget.canStart(5'000));
+}
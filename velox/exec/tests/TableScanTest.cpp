@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/TableScan.h"
+#include <folly/ScopeGuard.h>
 #include <folly/synchronization/Baton.h>
 #include <folly/synchronization/Latch.h>
 #include <atomic>
@@ -26,8 +27,10 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnector.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/FragmentResultCache.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -359,6 +362,209 @@ TEST_F(TableScanTest, partitionKeyAlias) {
   assertQuery(op, split, "SELECT c0, '2021-12-02' FROM tmp");
 }
 
+TEST_F(TableScanTest, pruneSplitsBeforeOpen) {
+  auto vector = makeRowVector(
+      {makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), {vector});
+  createDuckDbTable({vector});
+  // The splits on the missing file must be skipped without opening it.
+  const auto missingPath = filePath->getPath() + ".missing";
+
+  ColumnHandleMap assignments = {
+      {"c0", regularColumn("c0", BIGINT())},
+      {"ds", partitionKey("ds", VARCHAR())}};
+  auto op = PlanBuilder()
+                .startTableScan()
+                .outputType(ROW({"c0", "ds"}, {BIGINT(), VARCHAR()}))
+                .assignments(assignments)
+                .subfieldFilter("ds = '2021-12-02'")
+                .endTableScan()
+                .planNode();
+  auto task = assertQuery(
+      op,
+      {HiveConnectorSplitBuilder(filePath->getPath())
+           .partitionKey("ds", "2021-12-02")
+           .build(),
+       HiveConnectorSplitBuilder(missingPath)
+           .partitionKey("ds", "2021-12-01")
+           .build(),
+       HiveConnectorSplitBuilder(missingPath)
+           .partitionKey("ds", std::nullopt)
+           .build()},
+      "SELECT c0, '2021-12-02' FROM tmp");
+  EXPECT_EQ(2, getSkippedSplitsStat(task));
+
+  auto makeStats = [](int64_t min, int64_t max) {
+    auto stats = std::make_shared<HiveFileStatistics>();
+    stats->numRows = 100;
+    stats->columns["c0"] =
+        std::make_shared<dwio::common::IntegerColumnStatistics>(
+            100, false, std::nullopt, std::nullopt, min, max, std::nullopt);
+    return stats;
+  };
+  op = PlanBuilder()
+           .startTableScan()
+           .outputType(ROW({"c0"}, {BIGINT()}))
+           .subfieldFilter("c0 < 50")
+           .endTableScan()
+           .planNode();
+  task = assertQuery(
+      op,
+      {HiveConnectorSplitBuilder(filePath->getPath())
+           .fileStatistics(makeStats(0, 99))
+           .build(),
+       HiveConnectorSplitBuilder(missingPath)
+           .fileStatistics(makeStats(1'000, 2'000))
+           .build()},
+      "SELECT c0 FROM tmp WHERE c0 < 50");
+  EXPECT_EQ(1, getSkippedSplitsStat(task));
+}
+
+TEST_F(TableScanTest, packedSplits) {
+  auto vectors = makeVectors(6, 100);
+  auto filePaths = makeFilePaths(vectors.size());
+  for (auto i = 0; i < vectors.size(); ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto makePackedSplit = [&](int32_t begin, int32_t end) {
+    std::vector<std::shared_ptr<HiveConnectorSplit>> files;
+    for (auto i = begin; i < end; ++i) {
+      files.push_back(
+          HiveConnectorSplitBuilder(filePaths[i]->getPath()).build());
+    }
+    return std::make_shared<HivePackedSplit>(
+        kHiveConnectorId, std::move(files));
+  };
+  auto op = tableScanNode();
+  assertQuery(
+      op,
+      {makePackedSplit(0, 3), makePackedSplit(3, 5), makePackedSplit(5, 6)},
+      "SELECT * FROM tmp");
+
+  // A file pruned by its statistics inside a packed split is not opened.
+  auto stats = std::make_shared<HiveFileStatistics>();
+  stats->numRows = 100;
+  stats->columns["c0"] =
+      std::make_shared<dwio::common::IntegerColumnStatistics>(
+          100, false, std::nullopt, std::nullopt, 1'000, 2'000, std::nullopt);
+  std::vector<std::shared_ptr<HiveConnectorSplit>> files = {
+      HiveConnectorSplitBuilder(filePaths[0]->getPath()).build(),
+      HiveConnectorSplitBuilder(filePaths[0]->getPath() + ".missing")
+          .fileStatistics(stats)
+          .build(),
+      HiveConnectorSplitBuilder(filePaths[1]->getPath()).build()};
+  createDuckDbTable({vectors[0], vectors[1]});
+  op = PlanBuilder(pool_.get())
+           .tableScan(rowType_, {"c0 < 1000"})
+           .planNode();
+  auto task = assertQuery(
+      op,
+      {std::make_shared<HivePackedSplit>(kHiveConnectorId, files)},
+      "SELECT * FROM tmp WHERE c0 < 1000");
+  EXPECT_EQ(1, getSkippedSplitsStat(task));
+}
+
+TEST_F(TableScanTest, parallelUnitLoad) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  auto writeConfig = std::make_shared<dwrf::Config>();
+  writeConfig->set<uint64_t>(dwrf::Config::STRIPE_SIZE, 1 << 10);
+  writeToFile(filePath->getPath(), vectors, writeConfig);
+  createDuckDbTable(vectors);
+
+  auto assertParallelUnitLoad = [&](const core::PlanNodePtr& plan,
+                                    const std::string& duckDbSql) {
+    for (auto count : {1, 3, 20}) {
+      SCOPED_TRACE(fmt::format("parallel_unit_load_count: {}", count));
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .connectorSessionProperty(
+              kHiveConnectorId,
+              connector::hive::HiveConfig::kParallelUnitLoadCountSession,
+              std::to_string(count))
+          .split(makeHiveConnectorSplit(filePath->getPath()))
+          .assertResults(duckDbSql);
+    }
+  };
+  assertParallelUnitLoad(tableScanNode(), "SELECT * FROM tmp");
+  assertParallelUnitLoad(
+      PlanBuilder(pool_.get()).tableScan(rowType_, {"c1 > 0"}).planNode(),
+      "SELECT * FROM tmp WHERE c1 > 0");
+}
+
+TEST_F(TableScanTest, columnReadStats) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+  auto plan =
+      PlanBuilder(pool_.get())
+          .tableScan(ROW({"c0", "c1"}, {BIGINT(), INTEGER()}), {"c1 > 0"})
+          .planNode();
+
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .split(makeHiveConnectorSplit(filePath->getPath()))
+                  .assertResults("SELECT c0, c1 FROM tmp WHERE c1 > 0");
+  ASSERT_EQ(getTableScanRuntimeStats(task).count("column.c0.readNanos"), 0);
+
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .connectorSessionProperty(
+                 kHiveConnectorId,
+                 connector::hive::HiveConfig::kCollectColumnReadStatsSession,
+                 "true")
+             .split(makeHiveConnectorSplit(filePath->getPath()))
+             .assertResults("SELECT c0, c1 FROM tmp WHERE c1 > 0");
+  auto stats = getTableScanRuntimeStats(task);
+  for (const auto& column : {"c0", "c1"}) {
+    SCOPED_TRACE(column);
+    const auto prefix = fmt::format("column.{}.", column);
+    ASSERT_EQ(stats.count(prefix + "readNanos"), 1);
+    ASSERT_EQ(stats.count(prefix + "getValuesNanos"), 1);
+    ASSERT_GT(stats.at(prefix + "outputBytes").sum, 0);
+  }
+  ASSERT_EQ(stats.count("column.c2.readNanos"), 0);
+}
+
+TEST_F(TableScanTest, flatMapAsStruct) {
+  auto vector = makeRowVector({makeMapVector<int32_t, int64_t>(
+      100,
+      [](auto row) { return 1 + row % 2; },
+      [](auto row, auto index) { return index == 0 ? 1 : 3; },
+      [](auto row, auto index) { return row * 10 + index; })});
+  auto filePath = TempFilePath::create();
+  auto writeConfig = std::make_shared<dwrf::Config>();
+  writeConfig->set(dwrf::Config::FLATTEN_MAP, true);
+  writeConfig->set<const std::vector<uint32_t>>(
+      dwrf::Config::MAP_FLAT_COLS, {0});
+  writeToFile(filePath->getPath(), {vector}, writeConfig);
+
+  // The ROW fields select the keys to read. Key 7 is not in the file.
+  auto outputType =
+      ROW({"c0"}, {ROW({"3", "1", "7"}, {BIGINT(), BIGINT(), BIGINT()})});
+  auto expected = makeRowVector({makeRowVector(
+      {"3", "1", "7"},
+      {makeFlatVector<int64_t>(
+           100,
+           [](auto row) { return row * 10 + 1; },
+           [](auto row) { return row % 2 == 0; }),
+       makeFlatVector<int64_t>(100, [](auto row) { return row * 10; }),
+       makeNullConstant(TypeKind::BIGINT, 100)})});
+  AssertQueryBuilder(PlanBuilder().tableScan(outputType).planNode())
+      .split(makeHiveConnectorSplit(filePath->getPath()))
+      .assertResults(expected);
+
+  // A map that is not flat map encoded can not be read as a struct.
+  auto mapPath = TempFilePath::create();
+  writeToFile(mapPath->getPath(), {vector});
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(PlanBuilder().tableScan(outputType).planNode())
+          .split(makeHiveConnectorSplit(mapPath->getPath()))
+          .copyResults(pool()),
+      "is read as a struct but is not flat map encoded");
+}
+
 TEST_F(TableScanTest, columnPruning) {
   auto vectors = makeVectors(10, 1'000);
   auto filePath = TempFilePath::create();
@@ -1374,6 +1580,79 @@ TEST_F(TableScanTest, multipleSplits) {
   }
 }
 
+TEST_F(TableScanTest, preloadBudget) {
+  auto filePaths = makeFilePaths(20);
+  auto vectors = makeVectors(20, 100);
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    const auto& path = filePaths[i]->getPath();
+    writeToFile(path, vectors[i]);
+    splits.push_back(makeHiveConnectorSplit(path, 0, fs::file_size(path)));
+  }
+  createDuckDbTable(vectors);
+
+  // A budget smaller than any split lets one split preload at a time.
+  auto task = AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+                  .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "4")
+                  .config(core::QueryConfig::kMaxSplitPreloadBytes, "1")
+                  .splits(splits)
+                  .assertResults("SELECT * FROM tmp");
+  auto stats = getTableScanRuntimeStats(task);
+  ASSERT_GT(stats.at("preloadedSplits").sum, 1);
+}
+
+TEST_F(TableScanTest, fragmentResultCache) {
+  auto filePaths = makeFilePaths(5);
+  auto vectors = makeVectors(5, 100);
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    const auto& path = filePaths[i]->getPath();
+    writeToFile(path, vectors[i]);
+    splits.push_back(HiveConnectorSplitBuilder(path)
+                         .infoColumn("$file_modified_time", "1")
+                         .build());
+  }
+  createDuckDbTable(vectors);
+  auto* cache = FragmentResultCache::getInstance();
+  cache->clear();
+
+  auto runScan = [&](const core::PlanNodePtr& plan, const std::string& sql) {
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kFragmentResultCacheEnabled, true)
+            .splits(splits)
+            .assertResults(sql);
+    return getTableScanRuntimeStats(task);
+  };
+
+  auto stats = runScan(tableScanNode(), "SELECT * FROM tmp");
+  ASSERT_EQ(5, stats.at("fragmentResultCacheMisses").sum);
+  ASSERT_EQ(0, stats.count("fragmentResultCacheHits"));
+  ASSERT_EQ(5, cache->stats().numEntries);
+
+  // A plan with other node ids hits the cache.
+  stats = runScan(tableScanNode(), "SELECT * FROM tmp");
+  ASSERT_EQ(5, stats.at("fragmentResultCacheHits").sum);
+  ASSERT_EQ(0, stats.count("fragmentResultCacheMisses"));
+
+  // Different filters do not.
+  auto plan =
+      PlanBuilder(pool_.get()).tableScan(rowType_, {"c0 > 0"}).planNode();
+  stats = runScan(plan, "SELECT * FROM tmp WHERE c0 > 0");
+  ASSERT_EQ(5, stats.at("fragmentResultCacheMisses").sum);
+  stats = runScan(plan, "SELECT * FROM tmp WHERE c0 > 0");
+  ASSERT_EQ(5, stats.at("fragmentResultCacheHits").sum);
+
+  // A file with a new modification time is read again.
+  splits[0] = HiveConnectorSplitBuilder(filePaths[0]->getPath())
+                  .infoColumn("$file_modified_time", "2")
+                  .build();
+  stats = runScan(tableScanNode(), "SELECT * FROM tmp");
+  ASSERT_EQ(1, stats.at("fragmentResultCacheMisses").sum);
+  ASSERT_EQ(4, stats.at("fragmentResultCacheHits").sum);
+  cache->clear();
+}
+
 TEST_F(TableScanTest, preloadingSplitClose) {
   auto filePaths = makeFilePaths(100);
   auto vectors = makeVectors(100, 100);
@@ -1579,6 +1858,66 @@ DEBUG_ONLY_TEST_F(TableScanTest, tableScanSplitsAndWeights) {
   EXPECT_EQ(numAcquiredSplits, numSplits);
 }
 
+TEST_F(TableScanTest, topNDynamicFilter) {
+  // Files with decreasing c0 ranges. After the first file, TopN over c0 DESC
+  // pushes down a threshold above the max c0 of all the other files.
+  const vector_size_t size = 1'000;
+  const size_t numFiles{10};
+  auto filePaths = makeFilePaths(numFiles);
+  std::vector<RowVectorPtr> vectors;
+  for (size_t i = 0; i < numFiles; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            size, [&](auto row) { return (numFiles - i) * size + row; }),
+        makeFlatVector<int32_t>(size, [](auto row) { return row % 7; }),
+    }));
+    writeToFile(filePaths[i]->getPath(), {vectors.back()});
+  }
+  createDuckDbTable(vectors);
+
+  auto rowType = asRowType(vectors[0]->type());
+  core::PlanNodeId topNId;
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(rowType)
+                  .topN({"c0 DESC"}, 10, false)
+                  .capturePlanNodeId(topNId)
+                  .planNode();
+  for (const bool enabled : {true, false}) {
+    SCOPED_TRACE(fmt::format("enabled: {}", enabled));
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(
+                        core::QueryConfig::kTopNDynamicFilterEnabled,
+                        enabled ? "true" : "false")
+                    .config(core::QueryConfig::kMaxSplitPreloadPerDriver, "0")
+                    .splits(makeHiveConnectorSplits(filePaths))
+                    .assertResults(
+                        "SELECT * FROM tmp ORDER BY c0 DESC LIMIT 10");
+    if (enabled) {
+      EXPECT_EQ(getSkippedSplitsStat(task), numFiles - 1);
+      EXPECT_LT(
+          0,
+          toPlanStats(task->taskStats())
+              .at(topNId)
+              .customStats.at("dynamicFiltersProduced")
+              .sum);
+    } else {
+      EXPECT_EQ(getSkippedSplitsStat(task), 0);
+    }
+  }
+
+  // The filter passes nulls that sort first and rows that tie with the
+  // threshold on the first key.
+  plan = PlanBuilder(pool_.get())
+             .tableScan(rowType)
+             .topN({"c1 NULLS FIRST", "c0"}, 20, false)
+             .planNode();
+  assertQuery(
+      plan,
+      filePaths,
+      "SELECT * FROM tmp ORDER BY c1 NULLS FIRST, c0 LIMIT 20",
+      0);
+}
+
 TEST_F(TableScanTest, splitOffsetAndLength) {
   auto vectors = makeVectors(10, 1'000);
   auto filePath = TempFilePath::create();
@@ -1598,6 +1937,68 @@ TEST_F(TableScanTest, splitOffsetAndLength) {
       "SELECT * FROM tmp LIMIT 0");
 }
 
+TEST_F(TableScanTest, fileMetadataCache) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  dwio::common::FileMetadataCache metadataCache(1 << 20);
+  dwio::common::FileMetadataCache::setInstance(&metadataCache);
+  SCOPE_EXIT {
+    dwio::common::FileMetadataCache::setInstance(nullptr);
+  };
+  // Each split opens the file so that the footer is looked up per split.
+  AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+      .connectorSessionProperty(
+          kHiveConnectorId,
+          connector::hive::HiveConfig::kReuseFileReadersSession,
+          "false")
+      .splits(makeHiveConnectorSplits(
+          filePath->getPath(), 4, dwio::common::FileFormat::DWRF))
+      .assertResults("SELECT * FROM tmp");
+
+  // The footer is parsed by the first split and shared by the others.
+  const auto stats = metadataCache.stats();
+  ASSERT_EQ(1, stats.numEntries);
+  ASSERT_GT(stats.bytes, 0);
+  ASSERT_GE(stats.numHits, 1);
+  ASSERT_EQ(stats.numLookups, stats.numHits + 1);
+}
+
+TEST_F(TableScanTest, reuseFileReaders) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  auto otherFilePath = TempFilePath::create();
+  writeToFile(otherFilePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  auto makeSplits = [&]() {
+    // 4 splits of one file, then 4 splits of the other file.
+    auto splits = makeHiveConnectorSplits(
+        filePath->getPath(), 4, dwio::common::FileFormat::DWRF);
+    auto otherSplits = makeHiveConnectorSplits(
+        otherFilePath->getPath(), 4, dwio::common::FileFormat::DWRF);
+    splits.insert(splits.end(), otherSplits.begin(), otherSplits.end());
+    return splits;
+  };
+  auto assertReusedFileReaders = [&](bool reuse, int64_t expected) {
+    auto task =
+        AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+            .connectorSessionProperty(
+                kHiveConnectorId,
+                connector::hive::HiveConfig::kReuseFileReadersSession,
+                reuse ? "true" : "false")
+            .splits(makeSplits())
+            .assertResults("SELECT * FROM tmp UNION ALL SELECT * FROM tmp");
+    ASSERT_EQ(
+        getTableScanRuntimeStats(task)["reusedFileReaders"].sum, expected);
+  };
+  assertReusedFileReaders(true, 6);
+  assertReusedFileReaders(false, 0);
+}
+
 TEST_F(TableScanTest, fileNotFound) {
   auto split = HiveConnectorSplitBuilder("/path/to/nowhere.orc").build();
   auto assertMissingFile = [&](bool ignoreMissingFiles) {
@@ -3228,6 +3629,52 @@ TEST_F(TableScanTest, bitwiseAggregationPushdown) {
       "SELECT c5, bit_or(c0), bit_or(c1), bit_or(c2), bit_or(c6) FROM tmp group by c5");
 }
 
+TEST_F(TableScanTest, filterPushdownIntoLoad) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  auto loadedToValueHook = [](const std::shared_ptr<Task>& task) {
+    auto stats =
+        task->taskStats().pipelineStats[0].operatorStats[1].runtimeStats;
+    auto it = stats.find("loadedToValueHook");
+    return it != stats.end() ? it->second.sum : 0;
+  };
+
+  // 'c0 > 0' is evaluated while loading c0. The other conjunct references a
+  // column which is also projected and is evaluated afterwards.
+  auto plan = PlanBuilder()
+                  .tableScan(rowType_)
+                  .filter("c0 > 0 AND c1 % 3 = 0")
+                  .project({"c1", "c5"})
+                  .planNode();
+  const auto duckDbSql = "SELECT c1, c5 FROM tmp WHERE c0 > 0 AND c1 % 3 = 0";
+
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kFilterPushdownIntoLoadEnabled, true)
+          .splits(makeHiveConnectorSplits({filePath}))
+          .assertResults(duckDbSql);
+  EXPECT_EQ(10'000, loadedToValueHook(task));
+
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .splits(makeHiveConnectorSplits({filePath}))
+             .assertResults(duckDbSql);
+  EXPECT_EQ(0, loadedToValueHook(task));
+
+  // The only conjunct is pushed.
+  plan = PlanBuilder()
+             .tableScan(rowType_)
+             .filter("c0 >= 0")
+             .project({"c5"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kFilterPushdownIntoLoadEnabled, true)
+      .splits(makeHiveConnectorSplits({filePath}))
+      .assertResults("SELECT c5 FROM tmp WHERE c0 >= 0");
+}
+
 TEST_F(TableScanTest, structLazy) {
   vector_size_t size = 1'000;
   auto rowVector = makeRowVector(
@@ -2313,6 +2313,53 @@ TEST_P(UnpartitionedTableWriterTest, runtimeStatsCheck) {
   }
 }
 
+TEST_P(UnpartitionedTableWriterTest, maxBufferedBytes) {
+  auto rowType = ROW({"c0", "c1"}, {VARCHAR(), BIGINT()});
+
+  VectorFuzzer::Options options;
+  options.nullRatio = 0.0;
+  options.vectorSize = 16;
+  options.stringLength = 64L << 10;
+  VectorFuzzer fuzzer(options, pool());
+
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < 10; ++i) {
+    vectors.push_back(fuzzer.fuzzInputRow(rowType));
+  }
+  createDuckDbTable(vectors);
+
+  for (const uint64_t maxBufferedBytes : {0UL, 1UL}) {
+    SCOPED_TRACE(fmt::format("maxBufferedBytes: {}", maxBufferedBytes));
+    auto outputDirectory = TempDirectoryPath::create();
+    auto plan = createInsertPlan(
+        PlanBuilder().values(vectors),
+        rowType,
+        outputDirectory->getPath(),
+        {},
+        nullptr,
+        compressionKind_,
+        1,
+        connector::hive::LocationHandle::TableType::kNew);
+    const auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(QueryConfig::kTaskWriterCount, std::to_string(1))
+            .config(
+                QueryConfig::kTableWriterMaxBufferedBytes,
+                std::to_string(maxBufferedBytes))
+            .assertResults("SELECT count(*) FROM tmp");
+    auto stats = task->taskStats().pipelineStats.front().operatorStats;
+    if (maxBufferedBytes == 0) {
+      ASSERT_EQ(stats[1].runtimeStats.count("numWriterFlushes"), 0);
+    } else {
+      ASSERT_EQ(stats[1].runtimeStats["numWriterFlushes"].sum, vectors.size());
+    }
+    assertQuery(
+        PlanBuilder().tableScan(rowType).planNode(),
+        makeHiveConnectorSplits(outputDirectory),
+        "SELECT * FROM tmp");
+  }
+}
+
 TEST_P(UnpartitionedTableWriterTest, immutableSettings) {
   struct {
     connector::hive::LocationHandle::TableType dataType;
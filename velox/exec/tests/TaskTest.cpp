@@ -15,7 +15,8 @@
  */
 
 #include "velox/exec/Task.h"
-#include "folly/experimental/EventCount.h"
+#include "folly/json.h"
+#include <folly/json.h>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/common/memory/MemoryArbitrator.h"
@@ -25,6 +26,7 @@
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Values.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/Cursor.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -1946,4 +1948,38 @@ DEBUG_ONLY_TEST_F(TaskTest, driverEnqueAfterFailedAndPausedTask) {
   task.reset();
   waitForAllTasksToBeDeleted();
 }
+
+TEST_F(TaskTest, exportTrace) {
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, folly::identity),
+  });
+  const auto plan = PlanBuilder()
+                        .values({data, data})
+                        .project({"c0 * 2 AS c1"})
+                        .planNode();
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan).maxDrivers(2).copyResults(pool(), task);
+  ASSERT_EQ(nullptr, task->timelineRecorder());
+  ASSERT_EQ("", task->exportTrace());
+
+  AssertQueryBuilder(plan)
+      .maxDrivers(2)
+      .config(core::QueryConfig::kTaskTraceEnabled, "true")
+      .copyResults(pool(), task);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  const auto trace = folly::parseJson(task->exportTrace());
+  std::unordered_set<std::string> threadNames;
+  int32_t numOnThread = 0;
+  for (const auto& event : trace["traceEvents"]) {
+    if (event["name"].asString() == "thread_name") {
+      threadNames.insert(event["args"]["name"].asString());
+    } else if (event["name"].asString() == "onThread") {
+      ++numOnThread;
+      ASSERT_EQ("driver", event["cat"].asString());
+    }
+  }
+  ASSERT_EQ(1, threadNames.count("pipeline 0 driver 0"));
+  ASSERT_EQ(1, threadNames.count("pipeline 0 driver 1"));
+  ASSERT_GE(numOnThread, 2);
+}
 } // namespace facebook::velox::exec::test
@@ -424,7 +424,7 @@ TEST_F(UnnestTest, batchSize) {
       makeFlatVector<int64_t>(10'000 * 3, [](auto row) { return 1 + row % 3; }),
   });
 
-  // 17 rows per output allows to unnest 6 input rows at a time.
+  // 17 rows per output splits every sixth input row across two outputs.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "17")
@@ -432,10 +432,10 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(1 + 10'000 / 6, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(1 + 30'000 / 17, stats.at(unnestId).outputVectors);
   }
 
-  // 2 rows per output allows to unnest 1 input row at a time.
+  // 2 rows per output splits every other input row.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "2")
@@ -443,7 +443,7 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(10'000, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(15'000, stats.at(unnestId).outputVectors);
   }
 
   // 100K rows per output allows to unnest all at once.
@@ -458,3 +458,49 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(1, stats.at(unnestId).outputVectors);
   }
 }
+
+TEST_F(UnnestTest, splitLargeArrays) {
+  // Two rows with 10 elements each, then an empty array, a null and an array
+  // with 7 elements.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5}),
+      makeNullableArrayVector<int32_t>({
+          std::vector<std::optional<int32_t>>{
+              0, 1, 2, 3, 4, 5, 6, 7, 8, 9},
+          std::vector<std::optional<int32_t>>{
+              10, 11, 12, 13, 14, 15, 16, 17, 18, 19},
+          std::vector<std::optional<int32_t>>{},
+          std::nullopt,
+          std::vector<std::optional<int32_t>>{20, 21, 22, 23, 24, 25, 26},
+      }),
+  });
+
+  core::PlanNodeId unnestId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .unnest({"c0"}, {"c1"}, "ordinal")
+                  .capturePlanNodeId(unnestId)
+                  .planNode();
+
+  std::vector<int64_t> replicated;
+  std::vector<int32_t> elements;
+  std::vector<int64_t> ordinals;
+  for (auto i = 0; i < 27; ++i) {
+    replicated.push_back(i < 10 ? 1 : (i < 20 ? 2 : 5));
+    elements.push_back(i);
+    ordinals.push_back(1 + (i < 20 ? i % 10 : i - 20));
+  }
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(replicated),
+      makeFlatVector<int32_t>(elements),
+      makeFlatVector<int64_t>(ordinals),
+  });
+
+  // The arrays are split across outputs of at most 4 rows.
+  auto task = AssertQueryBuilder(plan)
+                  .config(core::QueryConfig::kPreferredOutputBatchRows, "4")
+                  .assertResults({expected});
+  auto stats = exec::toPlanStats(task->taskStats());
+  ASSERT_EQ(27, stats.at(unnestId).outputRows);
+  ASSERT_EQ(7, stats.at(unnestId).outputVectors);
+}
@@ -332,6 +332,58 @@ TEST_F(VectorHasherTest, dictionary) {
   }
 }
 
+// Tests that hashes and value ids of the entries of a dictionary are reused by
+// the following batches over the same dictionary.
+TEST_F(VectorHasherTest, stringDictionaryAcrossBatches) {
+  auto base = makeFlatVector<StringView>(
+      {"apple", "orange", "grapefruit", "banana", "star fruit"});
+  auto first = makeDictionary(100, base);
+  auto second = BaseVector::wrapInDictionary(
+      BufferPtr(nullptr),
+      makeIndices(100, [](auto row) { return (row * 3) % 5; }),
+      100,
+      base);
+  auto stringAt = [&](const VectorPtr& vector, auto row) {
+    return vector->as<SimpleVector<StringView>>()->valueAt(row);
+  };
+
+  auto hasher = exec::VectorHasher::create(VARCHAR(), 0);
+  raw_vector<uint64_t> result(100);
+  for (const auto& vector : {first, second, first}) {
+    hasher->decode(*vector, allRows_);
+    hasher->hash(allRows_, false, result);
+    for (auto i = 0; i < 100; ++i) {
+      ASSERT_EQ(folly::hasher<StringView>()(stringAt(vector, i)), result[i]);
+    }
+  }
+
+  hasher->decode(*first, allRows_);
+  ASSERT_FALSE(hasher->computeValueIds(allRows_, result));
+  hasher->enableValueIds(1, 0);
+  std::unordered_map<std::string, uint64_t> ids;
+  for (const auto& vector : {first, second}) {
+    hasher->decode(*vector, allRows_);
+    ASSERT_TRUE(hasher->computeValueIds(allRows_, result));
+    for (auto i = 0; i < 100; ++i) {
+      auto it = ids.emplace(std::string(stringAt(vector, i)), result[i]).first;
+      ASSERT_EQ(it->second, result[i]) << "at " << i;
+    }
+  }
+  ASSERT_EQ(5, ids.size());
+
+  // New values in a batch over the same dictionary fail the mapping. The ids
+  // of the dictionary change after switching to a mapping that covers them.
+  auto other = makeFlatVector<StringView>({"pine", "birch"});
+  SelectivityVector otherRows(2);
+  hasher->decode(*other, otherRows);
+  ASSERT_FALSE(hasher->computeValueIds(otherRows, result));
+  hasher->enableValueIds(1, 0);
+  hasher->decode(*second, allRows_);
+  ASSERT_TRUE(hasher->computeValueIds(allRows_, result));
+  std::unordered_set<uint64_t> distinctIds(result.begin(), result.end());
+  ASSERT_EQ(5, distinctIds.size());
+}
+
 // Tests how strings are mapped to uint64_t (if they fit) and to
 // consecutive ids of distinct values for the general case.
 TEST_F(VectorHasherTest, stringIds) {
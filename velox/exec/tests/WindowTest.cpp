@@ -79,6 +79,130 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+TEST_F(WindowTest, spillRowsStreaming) {
+  const vector_size_t size = 10'000;
+  // Few wide partitions with peer groups that span restore batches.
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 13; }),
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 3; }),
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 30; }),
+      });
+  createDuckDbTable({data});
+
+  const std::vector<std::string> functions = {
+      "row_number() over (partition by p order by s)",
+      "rank() over (partition by p order by s)",
+      "sum(d) over (partition by p order by s)",
+  };
+  for (const auto& batchRows : {"7", "100", "10000"}) {
+    SCOPED_TRACE(fmt::format("batchRows: {}", batchRows));
+    core::PlanNodeId windowId;
+    auto plan = PlanBuilder()
+                    .values(split(data, 10))
+                    .window(functions)
+                    .capturePlanNodeId(windowId)
+                    .planNode();
+
+    auto spillDirectory = TempDirectoryPath::create();
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, batchRows)
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kWindowSpillEnabled, "true")
+            .spillDirectory(spillDirectory->getPath())
+            .assertResults(fmt::format(
+                "SELECT *, {} FROM tmp", folly::join(", ", functions)));
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    ASSERT_GT(taskStats.at(windowId).spilledRows, 0);
+  }
+}
+
+TEST_F(WindowTest, prefixSort) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key with values sharing the bytes stored in the prefix.
+          makeFlatVector<std::string>(
+              size,
+              [](auto row) {
+                return fmt::format("partition key {}", row % 17);
+              }),
+          // Sorting key with nulls.
+          makeFlatVector<int32_t>(
+              size,
+              [](auto row) { return row % 31; },
+              nullEvery(7)),
+      });
+
+  createDuckDbTable({data});
+
+  for (const auto& maxKeyBytes : {"0", "8", "128"}) {
+    SCOPED_TRACE(fmt::format("maxKeyBytes: {}", maxKeyBytes));
+    auto plan =
+        PlanBuilder()
+            .values(split(data, 10))
+            .window(
+                {"rank() over (partition by p order by s desc nulls first)"})
+            .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPrefixSortMinRows, "0")
+        .config(
+            core::QueryConfig::kPrefixSortNormalizedKeyMaxBytes, maxKeyBytes)
+        .assertResults(
+            "SELECT *, rank() over (partition by p order by s desc nulls first) FROM tmp");
+  }
+}
+
+TEST_F(WindowTest, rowsStreaming) {
+  const vector_size_t size = 50'000;
+  // Input sorted on partition and sorting keys with large partitions that
+  // span many input batches.
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 13; }),
+          makeFlatVector<int16_t>(size, [](auto row) { return row / 20'000; }),
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 3; }),
+      });
+  createDuckDbTable({data});
+
+  const std::vector<std::string> streamingFunctions = {
+      "row_number() over (partition by p order by s)",
+      "rank() over (partition by p order by s)",
+      "dense_rank() over (partition by p order by s)",
+      "sum(d) over (partition by p order by s rows between unbounded preceding and current row)",
+      "sum(d) over (partition by p order by s)",
+  };
+  auto runQuery = [&](const std::vector<std::string>& functions) {
+    core::PlanNodeId windowId;
+    auto plan = PlanBuilder()
+                    .values(split(data, 500))
+                    .streamingWindow(functions)
+                    .capturePlanNodeId(windowId)
+                    .planNode();
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .assertResults(fmt::format(
+                        "SELECT *, {} FROM tmp", folly::join(", ", functions)));
+    return exec::toPlanStats(task->taskStats()).at(windowId).peakMemoryBytes;
+  };
+
+  const auto streamingPeakBytes = runQuery(streamingFunctions);
+
+  // percent_rank() needs the number of rows of the partition, so the whole
+  // partition is held in memory before computing any of the functions.
+  auto functions = streamingFunctions;
+  functions.push_back("percent_rank() over (partition by p order by s)");
+  const auto partitionPeakBytes = runQuery(functions);
+  ASSERT_LT(streamingPeakBytes, partitionPeakBytes);
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
@@ -252,6 +252,13 @@ class HiveConnectorSplitBuilder {
     return *this;
   }
 
+  HiveConnectorSplitBuilder& fileStatistics(
+      std::shared_ptr<const connector::hive::HiveFileStatistics>
+          fileStatistics) {
+    fileStatistics_ = std::move(fileStatistics);
+    return *this;
+  }
+
   HiveConnectorSplitBuilder& connectorId(const std::string& connectorId) {
     connectorId_ = connectorId;
     return *this;
@@ -273,7 +280,8 @@ class HiveConnectorSplitBuilder {
         extraFileInfo,
         serdeParameters,
         splitWeight_,
-        infoColumns_);
+        infoColumns_,
+        fileStatistics_);
   }
 
  private:
@@ -287,6 +295,7 @@ class HiveConnectorSplitBuilder {
   std::shared_ptr<std::string> extraFileInfo_ = {};
   std::unordered_map<std::string, std::string> serdeParameters_ = {};
   std::unordered_map<std::string, std::string> infoColumns_ = {};
+  std::shared_ptr<const connector::hive::HiveFileStatistics> fileStatistics_;
   std::string connectorId_ = kHiveConnectorId;
   int64_t splitWeight_{0};
 };
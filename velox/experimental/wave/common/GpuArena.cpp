@@ -20,6 +20,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/experimental/wave/common/Exception.h"
+#include "velox/experimental/wave/common/GpuMemoryManager.h"
 
 namespace facebook::velox::wave {
 
@@ -275,16 +276,43 @@ GpuArena::Buffers::Buffers() {
   memset(&buffers[0], 0, sizeof(buffers));
 }
 
-GpuArena::GpuArena(uint64_t singleArenaCapacity, GpuAllocator* allocator)
-    : singleArenaCapacity_(singleArenaCapacity), allocator_(allocator) {
-  auto arena = std::make_shared<GpuSlab>(
-      allocator_->allocate(singleArenaCapacity),
-      singleArenaCapacity,
-      allocator_);
+GpuArena::GpuArena(
+    uint64_t singleArenaCapacity,
+    GpuAllocator* allocator,
+    std::shared_ptr<GpuMemoryPool> pool)
+    : singleArenaCapacity_(singleArenaCapacity),
+      allocator_(allocator),
+      pool_(std::move(pool)) {
+  auto arena = newSlab();
   arenas_.emplace(reinterpret_cast<uint64_t>(arena->address()), arena);
   currentArena_ = arena;
 }
 
+GpuArena::~GpuArena() {
+  if (pool_) {
+    pool_->release(arenas_.size() * singleArenaCapacity_);
+  }
+}
+
+std::shared_ptr<GpuSlab> GpuArena::newSlab() {
+  if (!pool_) {
+    return std::make_shared<GpuSlab>(
+        allocator_->allocate(singleArenaCapacity_),
+        singleArenaCapacity_,
+        allocator_);
+  }
+  pool_->reserve(singleArenaCapacity_);
+  try {
+    return std::make_shared<GpuSlab>(
+        allocator_->allocate(singleArenaCapacity_),
+        singleArenaCapacity_,
+        allocator_);
+  } catch (const std::exception&) {
+    pool_->release(singleArenaCapacity_);
+    throw;
+  }
+}
+
 WaveBufferPtr GpuArena::getBuffer(void* ptr, size_t size) {
   auto result = firstFreeBuffer_;
   if (!result) {
@@ -325,10 +353,7 @@ WaveBufferPtr GpuArena::allocateBytes(uint64_t bytes) {
   // If first allocation fails we create a new GpuSlab for another attempt. If
   // it ever fails again then it means requested bytes is larger than a single
   // GpuSlab's capacity. No further attempts will happen.
-  auto newArena = std::make_shared<GpuSlab>(
-      allocator_->allocate(singleArenaCapacity_),
-      singleArenaCapacity_,
-      allocator_);
+  auto newArena = newSlab();
   arenas_.emplace(reinterpret_cast<uint64_t>(newArena->address()), newArena);
   currentArena_ = newArena;
   result = currentArena_->allocate(bytes);
@@ -355,6 +380,9 @@ void GpuArena::free(Buffer* buffer) {
   iter->second->free(buffer->ptr_, buffer->size_);
   if (iter->second->empty() && iter->second != currentArena_) {
     arenas_.erase(iter);
+    if (pool_) {
+      pool_->release(singleArenaCapacity_);
+    }
   }
   buffer->ptr_ = firstFreeBuffer_;
   buffer->size_ = 0;
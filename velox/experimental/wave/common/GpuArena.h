@@ -29,6 +29,8 @@
 
 namespace facebook::velox::wave {
 
+class GpuMemoryPool;
+
 /// A contiguous range slab of device or universal memory for
 /// backing small allocations. The caller is responsible for
 /// serializing access across threads.
@@ -116,10 +118,17 @@ class GpuSlab {
 
 /// A class that manages a set of GpuSlabs. It is able to adapt itself by
 /// growing the number of its managed GpuSlab's when extreme memory
-/// fragmentation happens.
+/// fragmentation happens. If a GpuMemoryPool is given, the capacity of each
+/// GpuSlab is reserved from it before the slab is allocated and released when
+/// the slab is freed.
 class GpuArena {
  public:
-  GpuArena(uint64_t singleArenaCapacity, GpuAllocator* allocator);
+  GpuArena(
+      uint64_t singleArenaCapacity,
+      GpuAllocator* allocator,
+      std::shared_ptr<GpuMemoryPool> pool = nullptr);
+
+  ~GpuArena();
 
   WaveBufferPtr allocateBytes(uint64_t bytes);
 
@@ -141,6 +150,11 @@ class GpuArena {
     return arenas_;
   }
 
+  /// The pool the slabs of 'this' are reserved from. nullptr if none.
+  const std::shared_ptr<GpuMemoryPool>& pool() const {
+    return pool_;
+  }
+
  private:
   // A preallocated array of Buffer handles for memory of 'this'.
   struct Buffers {
@@ -152,6 +166,9 @@ class GpuArena {
   // 'ptr' and 'size'.
   WaveBufferPtr getBuffer(void* ptr, size_t size);
 
+  // Reserves from 'pool_' and allocates a new GpuSlab.
+  std::shared_ptr<GpuSlab> newSlab();
+
   // Serializes all activity in 'this'.
   std::mutex mutex_;
 
@@ -167,6 +184,8 @@ class GpuArena {
 
   GpuAllocator* const allocator_;
 
+  const std::shared_ptr<GpuMemoryPool> pool_;
+
   // A sorted list of GpuSlab by its initial address
   std::map<uint64_t, std::shared_ptr<GpuSlab>> arenas_;
 
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/experimental/wave/common/GpuMemoryManager.h"
+
+#include <gflags/gflags.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+
+DEFINE_int64(
+    velox_wave_device_memory_bytes,
+    facebook::velox::memory::kMaxMemory,
+    "Device memory shared by the queries running on GPU");
+
+namespace facebook::velox::wave {
+
+GpuMemoryPool::GpuMemoryPool(
+    GpuMemoryManager* manager,
+    std::string name,
+    int64_t capacity)
+    : manager_(manager), name_(std::move(name)), capacity_(capacity) {}
+
+GpuMemoryPool::~GpuMemoryPool() {
+  if (reservedBytes_ > 0) {
+    LOG(WARNING) << "Device memory pool " << name_ << " destroyed with "
+                 << succinctBytes(reservedBytes_) << " reserved";
+    manager_->release(reservedBytes_);
+  }
+}
+
+bool GpuMemoryPool::tryReserve(int64_t bytes) {
+  auto reserved = reservedBytes_.fetch_add(bytes) + bytes;
+  if (!manager_->reserve(bytes, reserved <= capacity_)) {
+    reservedBytes_ -= bytes;
+    return false;
+  }
+  auto peak = peakBytes_.load();
+  while (reserved > peak && !peakBytes_.compare_exchange_weak(peak, reserved)) {
+  }
+  return true;
+}
+
+void GpuMemoryPool::reserve(int64_t bytes) {
+  if (!tryReserve(bytes)) {
+    VELOX_MEM_POOL_CAP_EXCEEDED(fmt::format(
+        "Exceeded device memory of {}. Requested: {}, reserved: {}, "
+        "capacity: {}, device reserved: {}, device capacity: {}",
+        name_,
+        succinctBytes(bytes),
+        succinctBytes(reservedBytes_),
+        succinctBytes(capacity_),
+        succinctBytes(manager_->reservedBytes()),
+        succinctBytes(manager_->capacity())));
+  }
+}
+
+void GpuMemoryPool::release(int64_t bytes) {
+  VELOX_CHECK_GE(reservedBytes_, bytes);
+  reservedBytes_ -= bytes;
+  manager_->release(bytes);
+}
+
+// static
+GpuMemoryManager* GpuMemoryManager::getInstance() {
+  static GpuMemoryManager instance(FLAGS_velox_wave_device_memory_bytes);
+  return &instance;
+}
+
+std::shared_ptr<GpuMemoryPool> GpuMemoryManager::pool(
+    const std::string& name,
+    int64_t capacity) {
+  std::lock_guard<std::mutex> l(mutex_);
+  // Drop the entries of the pools that are gone.
+  for (auto it = pools_.begin(); it != pools_.end();) {
+    if (it->second.expired()) {
+      it = pools_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto& weak = pools_[name];
+  if (auto existing = weak.lock()) {
+    return existing;
+  }
+  auto pool = std::make_shared<GpuMemoryPool>(this, name, capacity);
+  weak = pool;
+  return pool;
+}
+
+size_t GpuMemoryManager::numPools() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  size_t count = 0;
+  for (auto& [name, pool] : pools_) {
+    if (!pool.expired()) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+bool GpuMemoryManager::reserve(int64_t bytes, bool withinPoolCapacity) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numRequests_;
+  if (!withinPoolCapacity || reservedBytes_ + bytes > capacity_) {
+    ++numFailures_;
+    return false;
+  }
+  reservedBytes_ += bytes;
+  return true;
+}
+
+void GpuMemoryManager::release(int64_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK_GE(reservedBytes_, bytes);
+  reservedBytes_ -= bytes;
+  ++numReleases_;
+}
+
+memory::MemoryArbitrator::Stats GpuMemoryManager::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  memory::MemoryArbitrator::Stats stats;
+  stats.numRequests = numRequests_;
+  stats.numSucceeded = numRequests_ - numFailures_;
+  stats.numFailures = numFailures_;
+  stats.maxCapacityBytes = capacity_;
+  stats.freeCapacityBytes = capacity_ - reservedBytes_;
+  stats.numReserves = numRequests_ - numFailures_;
+  stats.numReleases = numReleases_;
+  return stats;
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/common/memory/MemoryPool.h"
+
+namespace facebook::velox::wave {
+
+class GpuMemoryManager;
+
+/// Device memory reservation of one query. The GpuArenas of the query reserve
+/// the capacity of their slabs from this before allocating them, so that the
+/// device memory of a query is capped and concurrent queries on the same
+/// device do not exhaust device memory. Thread safe.
+class GpuMemoryPool {
+ public:
+  GpuMemoryPool(GpuMemoryManager* manager, std::string name, int64_t capacity);
+
+  ~GpuMemoryPool();
+
+  const std::string& name() const {
+    return name_;
+  }
+
+  int64_t capacity() const {
+    return capacity_;
+  }
+
+  int64_t reservedBytes() const {
+    return reservedBytes_;
+  }
+
+  int64_t peakBytes() const {
+    return peakBytes_;
+  }
+
+  /// Reserves 'bytes' of device memory. Returns false if this would exceed the
+  /// capacity of 'this' or of the device.
+  bool tryReserve(int64_t bytes);
+
+  /// Same as tryReserve() but throws a memory cap exceeded error on failure.
+  void reserve(int64_t bytes);
+
+  /// Releases 'bytes' reserved by reserve() or tryReserve().
+  void release(int64_t bytes);
+
+ private:
+  GpuMemoryManager* const manager_;
+  const std::string name_;
+  const int64_t capacity_;
+  std::atomic<int64_t> reservedBytes_{0};
+  std::atomic<int64_t> peakBytes_{0};
+};
+
+/// Process wide accounting of device memory. Hands out a GpuMemoryPool per
+/// query and keeps the total of their reservations under the capacity of the
+/// device. Reports through the same MemoryArbitrator::Stats as the host side
+/// memory arbitration.
+class GpuMemoryManager {
+ public:
+  explicit GpuMemoryManager(int64_t capacity) : capacity_(capacity) {}
+
+  /// Returns the manager with the capacity from
+  /// --velox_wave_device_memory_bytes.
+  static GpuMemoryManager* getInstance();
+
+  /// Returns the pool with 'name', e.g. a query id, and makes one with
+  /// 'capacity' if there is none. The pool is dropped after the last user
+  /// releases it.
+  std::shared_ptr<GpuMemoryPool> pool(
+      const std::string& name,
+      int64_t capacity = memory::kMaxMemory);
+
+  int64_t capacity() const {
+    return capacity_;
+  }
+
+  int64_t reservedBytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return reservedBytes_;
+  }
+
+  size_t numPools() const;
+
+  memory::MemoryArbitrator::Stats stats() const;
+
+ private:
+  friend class GpuMemoryPool;
+
+  // Reserves 'bytes' against 'capacity_'. Returns false if the capacity is
+  // exceeded or if the reservation is over the capacity of the requesting
+  // pool, as given by 'withinPoolCapacity'.
+  bool reserve(int64_t bytes, bool withinPoolCapacity);
+
+  void release(int64_t bytes);
+
+  const int64_t capacity_;
+
+  mutable std::mutex mutex_;
+  int64_t reservedBytes_{0};
+  uint64_t numRequests_{0};
+  uint64_t numFailures_{0};
+  uint64_t numReleases_{0};
+  folly::F14FastMap<std::string, std::weak_ptr<GpuMemoryPool>> pools_;
+};
+
+} // namespace facebook::velox::wave
@@ -18,6 +18,8 @@
 #include <folly/Random.h>
 #include <gtest/gtest.h>
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/experimental/wave/common/GpuMemoryManager.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::wave;
@@ -155,3 +157,54 @@ TEST_F(GpuArenaTest, buffers) {
   buffers.clear();
   EXPECT_EQ(1, arena->slabs().size());
 }
+
+TEST_F(GpuArenaTest, memoryPool) {
+  GpuMemoryManager manager(3 << 20);
+  auto pool = manager.pool("query", 2 << 20);
+  EXPECT_EQ(pool, manager.pool("query"));
+  auto otherPool = manager.pool("other");
+  EXPECT_EQ(2, manager.numPools());
+  {
+    auto arena = std::make_unique<GpuArena>(1 << 20, allocator_.get(), pool);
+    EXPECT_EQ(1 << 20, pool->reservedBytes());
+    std::vector<WaveBufferPtr> buffers;
+    for (auto i = 0; i < 1500; ++i) {
+      buffers.push_back(arena->allocate<char>(1024));
+    }
+    EXPECT_EQ(2 << 20, pool->reservedBytes());
+    // A third slab is over the capacity of the pool.
+    VELOX_ASSERT_THROW(
+        [&]() {
+          for (auto i = 0; i < 1000; ++i) {
+            buffers.push_back(arena->allocate<char>(1024));
+          }
+        }(),
+        "Exceeded device memory of query");
+
+    // A slab of another pool is over the capacity of the device.
+    auto other =
+        std::make_unique<GpuArena>(1 << 20, allocator_.get(), otherPool);
+    EXPECT_EQ(3 << 20, manager.reservedBytes());
+    VELOX_ASSERT_THROW(
+        std::make_unique<GpuArena>(1 << 20, allocator_.get(), otherPool),
+        "Exceeded device memory of other");
+    other.reset();
+    EXPECT_EQ(0, otherPool->reservedBytes());
+    buffers.clear();
+    EXPECT_EQ(1 << 20, pool->reservedBytes());
+  }
+  EXPECT_EQ(0, pool->reservedBytes());
+  EXPECT_EQ(2 << 20, pool->peakBytes());
+  EXPECT_EQ(0, manager.reservedBytes());
+
+  auto stats = manager.stats();
+  EXPECT_EQ(2, stats.numFailures);
+  EXPECT_EQ(stats.numRequests - 2, stats.numSucceeded);
+  EXPECT_EQ(stats.numSucceeded, stats.numReleases);
+  EXPECT_EQ(3 << 20, stats.maxCapacityBytes);
+  EXPECT_EQ(3 << 20, stats.freeCapacityBytes);
+
+  pool.reset();
+  otherPool.reset();
+  EXPECT_EQ(0, manager.numPools());
+}
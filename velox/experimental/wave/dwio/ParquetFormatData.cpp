@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/experimental/wave/dwio/ParquetFormatData.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/common/compression/Compression.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+int32_t valueBytes(const ParquetColumnChunk* chunk) {
+  if (!chunk) {
+    return 0;
+  }
+  switch (chunk->kind) {
+    case WaveTypeKind::INTEGER:
+    case WaveTypeKind::REAL:
+      return 4;
+    case WaveTypeKind::BIGINT:
+    case WaveTypeKind::DOUBLE:
+      return 8;
+    default:
+      VELOX_NYI(
+          "Unsupported type for Parquet decoding on device: {}",
+          static_cast<int32_t>(chunk->kind));
+  }
+}
+
+// Same as the options of the Parquet reader on host.
+dwio::common::compression::CompressionOptions decompressionOptions(
+    common::CompressionKind kind) {
+  dwio::common::compression::CompressionOptions options;
+  if (kind == common::CompressionKind_ZLIB ||
+      kind == common::CompressionKind_GZIP) {
+    options.format.zlib.windowBits =
+        dwio::common::compression::Compressor::PARQUET_ZLIB_WINDOW_BITS;
+  } else if (
+      kind == common::CompressionKind_LZ4 ||
+      kind == common::CompressionKind_LZO) {
+    options.format.lz4_lzo.isHadoopFrameFormat = true;
+  }
+  return options;
+}
+} // namespace
+
+std::vector<RleBpRun> scanRleBpRuns(
+    const char* data,
+    int32_t size,
+    int32_t bitWidth,
+    int32_t numValues) {
+  std::vector<RleBpRun> runs;
+  const int32_t repeatedBytes = bits::nbytes(bitWidth);
+  int32_t offset = 0;
+  int32_t row = 0;
+  while (row < numValues) {
+    uint32_t header = 0;
+    for (auto shift = 0;; shift += 7) {
+      VELOX_CHECK_LT(offset, size, "Truncated RLE/bit-packed run header");
+      VELOX_CHECK_LT(shift, 32, "Bad RLE/bit-packed run header");
+      auto byte = static_cast<uint8_t>(data[offset++]);
+      header |= static_cast<uint32_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        break;
+      }
+    }
+    RleBpRun run;
+    run.firstRow = row;
+    run.offset = offset;
+    run.isRle = !(header & 1);
+    if (run.isRle) {
+      row += header >> 1;
+      offset += repeatedBytes;
+      VELOX_CHECK_LE(offset, size, "RLE run past end of data");
+    } else {
+      // Writers may leave out the padding of the last group of 8 values.
+      int32_t numGroups = header >> 1;
+      row += numGroups * 8;
+      offset = std::min<int64_t>(
+          size, offset + static_cast<int64_t>(numGroups) * bitWidth);
+    }
+    runs.push_back(run);
+  }
+  return runs;
+}
+
+ParquetFormatData::ParquetFormatData(
+    OperandId operand,
+    int32_t totalRows,
+    const ParquetColumnChunk* chunk,
+    memory::MemoryPool& pool)
+    : operand_(operand),
+      totalRows_(totalRows),
+      chunk_(chunk),
+      pool_(pool),
+      valueBytes_(valueBytes(chunk)) {}
+
+const char* ParquetFormatData::decompress(
+    const ParquetPage& page,
+    BufferPtr& decompressed) {
+  if (chunk_->codec == common::CompressionKind_NONE) {
+    return page.data;
+  }
+  auto decompressor = dwio::common::compression::createDecompressor(
+      chunk_->codec,
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          page.data, page.compressedSize, 0),
+      page.uncompressedSize,
+      pool_,
+      decompressionOptions(chunk_->codec),
+      "Wave Parquet page",
+      nullptr,
+      true,
+      page.compressedSize);
+  decompressed = AlignedBuffer::allocate<char>(page.uncompressedSize, &pool_);
+  decompressor->readFully(
+      decompressed->asMutable<char>(), page.uncompressedSize);
+  return decompressed->as<char>();
+}
+
+void ParquetFormatData::preparePages() {
+  if (chunk_->dictionary.has_value()) {
+    dictionary_ = decompress(*chunk_->dictionary, decompressedDictionary_);
+    dictionarySize_ = chunk_->dictionary->uncompressedSize;
+  }
+  int32_t row = 0;
+  for (auto& parquetPage : chunk_->pages) {
+    Page page;
+    page.encoding = parquetPage.encoding;
+    page.firstRow = row;
+    page.numValues = parquetPage.numValues;
+    page.data = decompress(parquetPage, page.decompressed);
+    page.size = parquetPage.uncompressedSize;
+    if (page.encoding == ParquetEncoding::kRleDictionary) {
+      VELOX_CHECK_NOT_NULL(
+          dictionary_, "Dictionary encoded page without a dictionary");
+      VELOX_CHECK_GT(page.size, 0);
+      page.bitWidth = static_cast<uint8_t>(page.data[0]);
+      VELOX_CHECK_LE(page.bitWidth, 32);
+      page.runs = scanRleBpRuns(
+          page.data + 1, page.size - 1, page.bitWidth, page.numValues);
+    } else {
+      VELOX_CHECK_GE(
+          page.size, static_cast<int64_t>(page.numValues) * valueBytes_);
+    }
+    row += page.numValues;
+    pages_.push_back(std::move(page));
+  }
+  VELOX_CHECK_EQ(row, totalRows_);
+}
+
+BufferId ParquetFormatData::stage(
+    const void* data,
+    int32_t size,
+    void*& device,
+    SplitStaging& staging) {
+  Staging transfer;
+  transfer.hostData = data;
+  transfer.size = size;
+  auto id = staging.add(transfer);
+  staging.registerPointer(id, &device);
+  return id;
+}
+
+void ParquetFormatData::startOp(
+    ColumnOp& op,
+    const ColumnOp* previousFilter,
+    ResultStaging& deviceStaging,
+    ResultStaging& resultStaging,
+    SplitStaging& splitStaging,
+    DecodePrograms& program,
+    ReadStream& stream) {
+  VELOX_CHECK_NOT_NULL(chunk_);
+  BufferId dictionaryId = kNoBufferId;
+  std::vector<BufferId> dataIds;
+  std::vector<BufferId> runIds;
+  if (!staged_) {
+    staged_ = true;
+    preparePages();
+    if (dictionary_) {
+      dictionaryId = stage(
+          dictionary_, dictionarySize_, deviceDictionary_, splitStaging);
+    }
+    for (auto& page : pages_) {
+      dataIds.push_back(
+          stage(page.data, page.size, page.deviceData, splitStaging));
+      runIds.push_back(
+          page.runs.empty() ? kNoBufferId
+                            : stage(
+                                  page.runs.data(),
+                                  page.runs.size() * sizeof(RleBpRun),
+                                  page.deviceRuns,
+                                  splitStaging));
+    }
+  }
+  if (queued_) {
+    return;
+  }
+  queued_ = true;
+  VELOX_CHECK_NOT_NULL(op.waveVector);
+  op.waveVector->resize(op.rows.size(), false);
+  const int32_t begin = currentRow_;
+  const int32_t end = currentRow_ + op.rows.back() + 1;
+  for (auto i = 0; i < pages_.size(); ++i) {
+    auto& page = pages_[i];
+    const int32_t pageEnd = page.firstRow + page.numValues;
+    if (pageEnd <= begin || page.firstRow >= end) {
+      continue;
+    }
+    auto dataId = dataIds.empty() ? kNoBufferId : dataIds[i];
+    auto runId = runIds.empty() ? kNoBufferId : runIds[i];
+    // The positions in the step are relative to the start of the page, so the
+    // result is offset by the start of the page relative to the batch.
+    auto* result = op.waveVector->values<char>() +
+        static_cast<int64_t>(page.firstRow - begin) * valueBytes_;
+    auto step = std::make_unique<GpuDecode>();
+    if (page.encoding == ParquetEncoding::kPlain) {
+      step->step = DecodeStep::kTrivial;
+      auto& trivial = step->data.trivial;
+      trivial.dataType = chunk_->kind;
+      trivial.begin = std::max(begin, page.firstRow) - page.firstRow;
+      trivial.end = std::min(end, pageEnd) - page.firstRow;
+      trivial.scatter = nullptr;
+      trivial.result = result;
+      setDevicePointer(trivial.input, page.deviceData, dataId, 0, splitStaging);
+    } else {
+      step->step = DecodeStep::kRleBitpack;
+      auto& rle = step->data.rleBitpack;
+      rle.dataType = chunk_->kind;
+      rle.numRuns = page.runs.size();
+      rle.bitWidth = page.bitWidth;
+      rle.begin = std::max(begin, page.firstRow) - page.firstRow;
+      rle.end = std::min(end, pageEnd) - page.firstRow;
+      rle.result = result;
+      // The runs start after the bit width byte.
+      setDevicePointer(rle.input, page.deviceData, dataId, 1, splitStaging);
+      setDevicePointer(rle.runs, page.deviceRuns, runId, 0, splitStaging);
+      setDevicePointer(
+          rle.alphabet, deviceDictionary_, dictionaryId, 0, splitStaging);
+    }
+    std::vector<std::unique_ptr<GpuDecode>> steps;
+    steps.push_back(std::move(step));
+    program.programs.push_back(std::move(steps));
+  }
+  op.isFinal = true;
+}
+
+std::unique_ptr<FormatData> ParquetFormatParams::toFormatData(
+    const std::shared_ptr<const dwio::common::TypeWithId>& type,
+    const velox::common::ScanSpec& scanSpec,
+    OperandId operand) {
+  const ParquetColumnChunk* chunk = nullptr;
+  if (type->id() != 0) {
+    auto it = rowGroup_->columns.find(type->id());
+    VELOX_CHECK(
+        it != rowGroup_->columns.end(),
+        "No column chunk for column {}",
+        type->id());
+    chunk = &it->second;
+  }
+  return std::make_unique<ParquetFormatData>(
+      operand, rowGroup_->numRows, chunk, pool());
+}
+
+} // namespace facebook::velox::wave
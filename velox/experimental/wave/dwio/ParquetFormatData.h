@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+
+#include "velox/common/compression/Compression.h"
+#include "velox/experimental/wave/dwio/FormatData.h"
+
+namespace facebook::velox::wave {
+
+/// Encoding of the values of a Parquet data page.
+enum class ParquetEncoding { kPlain, kRleDictionary };
+
+/// A data page of a Parquet column chunk in host memory. 'data' is the values
+/// section of the page. Only columns without definition and repetition levels
+/// are decoded on device, so there is no levels section.
+struct ParquetPage {
+  ParquetEncoding encoding;
+  const char* data;
+  // Size of 'data' in the file.
+  int32_t compressedSize;
+  // Size of 'data' after decompression. Equal to 'compressedSize' if the chunk
+  // is not compressed.
+  int32_t uncompressedSize;
+  int32_t numValues;
+};
+
+/// The pages of a column chunk of a fixed width type. The dictionary page is
+/// plain encoded and applies to the kRleDictionary pages.
+struct ParquetColumnChunk {
+  WaveTypeKind kind;
+  common::CompressionKind codec{common::CompressionKind_NONE};
+  std::optional<ParquetPage> dictionary;
+  std::vector<ParquetPage> pages;
+};
+
+/// The column chunks of a row group, keyed on the id of the column in the file
+/// schema.
+struct ParquetRowGroup {
+  int32_t numRows{0};
+  std::unordered_map<uint32_t, ParquetColumnChunk> columns;
+};
+
+/// Decodes a Parquet column chunk on device. The pages are decompressed on the
+/// host and staged to device on the first startOp(). Plain pages are decoded
+/// with kTrivial and dictionary pages with kRleBitpack, one thread block per
+/// page.
+class ParquetFormatData : public FormatData {
+ public:
+  ParquetFormatData(
+      OperandId operand,
+      int32_t totalRows,
+      const ParquetColumnChunk* chunk,
+      memory::MemoryPool& pool);
+
+  bool hasNulls() const override {
+    return false;
+  }
+
+  int32_t totalRows() const override {
+    return totalRows_;
+  }
+
+  void newBatch(int32_t startRow) override {
+    currentRow_ = startRow;
+    queued_ = false;
+  }
+
+  void startOp(
+      ColumnOp& op,
+      const ColumnOp* previousFilter,
+      ResultStaging& deviceStaging,
+      ResultStaging& resultStaging,
+      SplitStaging& staging,
+      DecodePrograms& program,
+      ReadStream& stream) override;
+
+ private:
+  // A page decompressed and ready for staging.
+  struct Page {
+    ParquetEncoding encoding;
+    // Row number of the first value of the page in the column chunk.
+    int32_t firstRow;
+    int32_t numValues;
+    // The uncompressed values, either in the file or in 'decompressed'.
+    const char* data;
+    int32_t size;
+    BufferPtr decompressed;
+    // Bit width and runs of the dictionary indices for kRleDictionary.
+    int32_t bitWidth{0};
+    std::vector<RleBpRun> runs;
+    // The device side copy of 'data' and 'runs', set after the staged
+    // transfer is done.
+    void* deviceData{nullptr};
+    void* deviceRuns{nullptr};
+  };
+
+  // Fills 'pages_' and 'dictionary_' from 'chunk_'.
+  void preparePages();
+
+  // Returns the uncompressed values of 'page'. Sets 'decompressed' to the
+  // buffer with the values if 'page' is compressed.
+  const char* decompress(const ParquetPage& page, BufferPtr& decompressed);
+
+  // Adds the transfer of 'size' bytes at 'data' to 'staging'. Sets 'device'
+  // to the device side address once the transfer is done.
+  BufferId
+  stage(const void* data, int32_t size, void*& device, SplitStaging& staging);
+
+  // Sets 'pointer' to 'offset' bytes past the device side copy of the staged
+  // 'device'. 'id' is the id of the transfer if it is not done yet.
+  template <typename T>
+  void setDevicePointer(
+      T& pointer,
+      void* const& device,
+      BufferId id,
+      int64_t offset,
+      SplitStaging& staging) {
+    if (id != kNoBufferId) {
+      pointer = reinterpret_cast<T>(offset);
+      staging.registerPointer(id, &pointer);
+    } else {
+      pointer = reinterpret_cast<T>(reinterpret_cast<char*>(device) + offset);
+    }
+  }
+
+  const OperandId operand_;
+  const int32_t totalRows_;
+  const ParquetColumnChunk* const chunk_;
+  memory::MemoryPool& pool_;
+  // Bytes per value of 'chunk_'.
+  const int32_t valueBytes_;
+
+  std::vector<Page> pages_;
+  // The dictionary values for kRleDictionary pages.
+  const char* dictionary_{nullptr};
+  int32_t dictionarySize_{0};
+  BufferPtr decompressedDictionary_;
+  void* deviceDictionary_{nullptr};
+
+  bool staged_{false};
+  bool queued_{false};
+  int32_t currentRow_{0};
+};
+
+class ParquetFormatParams : public FormatParams {
+ public:
+  ParquetFormatParams(
+      memory::MemoryPool& pool,
+      dwio::common::ColumnReaderStatistics& stats,
+      const ParquetRowGroup* rowGroup)
+      : FormatParams(pool, stats), rowGroup_(rowGroup) {}
+
+  std::unique_ptr<FormatData> toFormatData(
+      const std::shared_ptr<const dwio::common::TypeWithId>& type,
+      const velox::common::ScanSpec& scanSpec,
+      OperandId operand) override;
+
+  const ParquetRowGroup* rowGroup() const {
+    return rowGroup_;
+  }
+
+ private:
+  const ParquetRowGroup* rowGroup_;
+};
+
+/// Returns the runs of 'numValues' values in the Parquet RLE/bit-packed hybrid
+/// encoding at 'data'. The offsets of the runs are relative to 'data'. Only
+/// reads the run headers, the values are decoded on device.
+std::vector<RleBpRun> scanRleBpRuns(
+    const char* data,
+    int32_t size,
+    int32_t bitWidth,
+    int32_t numValues);
+
+} // namespace facebook::velox::wave
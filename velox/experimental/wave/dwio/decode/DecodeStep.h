@@ -38,6 +38,7 @@ enum class DecodeStep {
   kRleTotalLength,
   kRleBool,
   kRle,
+  kRleBitpack,
   kDictionary,
   kDictionaryOnBitpack,
   kVarint,
@@ -57,6 +58,17 @@ enum class DecodeStep {
   kUnsupported,
 };
 
+/// A run of values in the hybrid RLE/bit-packed encoding of Parquet.
+struct RleBpRun {
+  // Position of the first value of the run.
+  int32_t firstRow;
+  // Byte offset of the repeated value or the bit-packed values from the start
+  // of the encoded data.
+  int32_t offset;
+  // True for a repeated value, false for bit-packed groups of 8 values.
+  bool isRle;
+};
+
 /// Describes a decoding loop's input and result disposition.
 struct GpuDecode {
   // The operation to perform. Decides which branch of the union to use.
@@ -177,6 +189,27 @@ struct GpuDecode {
     const void* result;
   };
 
+  struct RleBitpack {
+    // Type of the alphabet and result.
+    WaveTypeKind dataType;
+    // Encoded runs, without the bit width or length prefix.
+    const char* input;
+    // Start of each run in 'input', ascending by firstRow.
+    const RleBpRun* runs;
+    // Number of runs.
+    int numRuns;
+    // Bit width of each value.
+    int bitWidth;
+    // Dictionary alphabet. If nullptr, the decoded values are the result.
+    const void* alphabet;
+    // Begin position for values and result.
+    int begin;
+    // End position (exclusive) for values and result.
+    int end;
+    // Starting address of the result.
+    void* result;
+  };
+
   struct MakeScatterIndices {
     // Input bits.
     const uint8_t* bits;
@@ -200,6 +233,7 @@ struct GpuDecode {
     SparseBool sparseBool;
     RleTotalLength rleTotalLength;
     Rle rle;
+    RleBitpack rleBitpack;
     MakeScatterIndices makeScatterIndices;
   } data;
 
@@ -499,6 +499,76 @@ __device__ void decodeRle(GpuDecode& plan) {
   }
 }
 
+// Returns the 'bitWidth' bits starting 'bit' bits after 'data'. Reads byte by
+// byte since the bit-packed runs have no alignment.
+__device__ inline uint64_t
+loadBits(const uint8_t* data, int64_t bit, int32_t bitWidth) {
+  auto* bytes = data + (bit >> 3);
+  int32_t shift = bit & 7;
+  int32_t numBytes = (shift + bitWidth + 7) >> 3;
+  uint64_t word = 0;
+  for (auto i = 0; i < numBytes; ++i) {
+    word |= static_cast<uint64_t>(bytes[i]) << (i * 8);
+  }
+  return (word >> shift) & ((1UL << bitWidth) - 1);
+}
+
+// Returns the index of the run of 'row', i.e. the last run with firstRow <=
+// 'row'.
+__device__ inline int32_t
+findRun(const RleBpRun* runs, int32_t numRuns, int32_t row) {
+  int32_t lo = 0, hi = numRuns;
+  while (lo < hi) {
+    int32_t i = (lo + hi) / 2;
+    if (runs[i].firstRow <= row) {
+      lo = i + 1;
+    } else {
+      hi = i;
+    }
+  }
+  return lo - 1;
+}
+
+template <typename T>
+__device__ void decodeRleBitpack(GpuDecode::RleBitpack& op) {
+  auto* input = reinterpret_cast<const uint8_t*>(op.input);
+  auto* dict = reinterpret_cast<const T*>(op.alphabet);
+  auto* result = reinterpret_cast<T*>(op.result);
+  auto bitWidth = op.bitWidth;
+  for (auto i = op.begin + threadIdx.x; i < op.end; i += blockDim.x) {
+    auto& run = op.runs[findRun(op.runs, op.numRuns, i)];
+    int64_t bit =
+        run.isRle ? 0 : static_cast<int64_t>(i - run.firstRow) * bitWidth;
+    auto value = loadBits(input + run.offset, bit, bitWidth);
+    result[i] = dict ? dict[value] : static_cast<T>(value);
+  }
+}
+
+__device__ inline void decodeRleBitpack(GpuDecode& plan) {
+  auto& op = plan.data.rleBitpack;
+  switch (op.dataType) {
+    case WaveTypeKind::TINYINT:
+      decodeRleBitpack<uint8_t>(op);
+      break;
+    case WaveTypeKind::SMALLINT:
+      decodeRleBitpack<uint16_t>(op);
+      break;
+    case WaveTypeKind::INTEGER:
+    case WaveTypeKind::REAL:
+      decodeRleBitpack<uint32_t>(op);
+      break;
+    case WaveTypeKind::BIGINT:
+    case WaveTypeKind::DOUBLE:
+      decodeRleBitpack<uint64_t>(op);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        printf("ERROR: Unsupported data type for RleBitpack\n");
+        assert(false);
+      }
+  }
+}
+
 template <int kBlockSize>
 __device__ void makeScatterIndices(GpuDecode::MakeScatterIndices& op) {
   auto indicesCount = scatterIndices<kBlockSize>(
@@ -531,6 +601,9 @@ __device__ void decodeSwitch(GpuDecode& op) {
     case DecodeStep::kRle:
       detail::decodeRle<kBlockSize>(op);
       break;
+    case DecodeStep::kRleBitpack:
+      detail::decodeRleBitpack(op);
+      break;
     case DecodeStep::kMakeScatterIndices:
       detail::makeScatterIndices<kBlockSize>(op.data.makeScatterIndices);
       break;
@@ -554,6 +627,7 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kTrivial:
     case DecodeStep::kDictionaryOnBitpack:
     case DecodeStep::kSparseBool:
+    case DecodeStep::kRleBitpack:
       return 0;
       break;
 
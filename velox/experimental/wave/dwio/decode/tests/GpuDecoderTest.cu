@@ -477,6 +477,91 @@ class GpuDecoderTest : public ::testing::Test {
     }
   }
 
+  // Encodes 'numValues' dictionary indices in the Parquet RLE/bit-packed hybrid
+  // encoding, alternating repeated runs with bit-packed groups, and decodes
+  // them through the dictionary.
+  template <typename T, int kBlockSize>
+  void testRleBitpack(int32_t bitWidth, int numValues, int numBlocks) {
+    auto dict = allocate<T>(1 << bitWidth);
+    for (auto i = 0; i < (1 << bitWidth); ++i) {
+      dict[i] = i * 3 + 1;
+    }
+    std::vector<uint8_t> encoded;
+    std::vector<RleBpRun> runs;
+    std::vector<uint32_t> expected;
+    uint32_t mask = (1u << bitWidth) - 1;
+    uint64_t seed = 0xafbe1647deba879LU;
+    int32_t valueBytes = (bitWidth + 7) / 8;
+    while (static_cast<int32_t>(expected.size()) < numValues) {
+      seed = (seed * 0x5def1) ^ (seed >> 21);
+      char header[10];
+      char* pos = header;
+      RleBpRun run;
+      run.firstRow = expected.size();
+      if (runs.size() % 2 == 0) {
+        int32_t count = 1 + seed % 300;
+        uint32_t value = (seed >> 16) & mask;
+        writeVarint<uint32_t>(count << 1, &pos);
+        encoded.insert(encoded.end(), header, pos);
+        run.offset = encoded.size();
+        run.isRle = true;
+        for (auto i = 0; i < valueBytes; ++i) {
+          encoded.push_back(value >> (i * 8));
+        }
+        expected.insert(expected.end(), count, value);
+      } else {
+        int32_t numGroups = 1 + seed % 5;
+        writeVarint<uint32_t>((numGroups << 1) | 1, &pos);
+        encoded.insert(encoded.end(), header, pos);
+        run.offset = encoded.size();
+        run.isRle = false;
+        std::vector<uint8_t> bits(numGroups * bitWidth);
+        for (auto i = 0; i < numGroups * 8; ++i) {
+          seed = (seed * 0x5def1) ^ (seed >> 21);
+          uint32_t value = seed & mask;
+          for (auto bit = 0; bit < bitWidth; ++bit) {
+            setBit(bits.data(), i * bitWidth + bit, (value >> bit) & 1);
+          }
+          expected.push_back(value);
+        }
+        encoded.insert(encoded.end(), bits.begin(), bits.end());
+      }
+      runs.push_back(run);
+    }
+    auto input = allocate<char>(encoded.size());
+    memcpy(input.get(), encoded.data(), encoded.size());
+    auto deviceRuns = allocate<RleBpRun>(runs.size());
+    memcpy(deviceRuns.get(), runs.data(), runs.size() * sizeof(RleBpRun));
+    auto result = allocate<T>(numValues);
+    int valuesPerOp = (numValues + numBlocks - 1) / numBlocks;
+    auto ops = allocate<GpuDecode>(numBlocks);
+    for (int i = 0; i < numBlocks; ++i) {
+      ops[i].step = DecodeStep::kRleBitpack;
+      auto& op = ops[i].data.rleBitpack;
+      op.dataType = WaveTypeTrait<T>::typeKind;
+      op.input = input.get();
+      op.runs = deviceRuns.get();
+      op.numRuns = runs.size();
+      op.bitWidth = bitWidth;
+      op.alphabet = dict.get();
+      op.begin = i * valuesPerOp;
+      op.end = std::min(numValues, (i + 1) * valuesPerOp);
+      op.result = result.get();
+    }
+    testCase(
+        fmt::format(
+            "rle bitpack {} bitWidth={} numValues={}",
+            sizeof(T) * 8,
+            bitWidth,
+            numValues),
+        [&] { decodeGlobal<kBlockSize>(ops.get(), numBlocks); },
+        numValues * sizeof(T),
+        3);
+    for (auto i = 0; i < numValues; ++i) {
+      ASSERT_EQ(result[i], dict[expected[i]]) << i;
+    }
+  }
+
   template <int kBlockSize>
   void testMakeScatterIndices(int numValues, int numBlocks) {
     auto bits = allocate<uint8_t>((numValues * numBlocks + 7) / 8);
@@ -588,6 +673,12 @@ TEST_F(GpuDecoderTest, rle) {
   testRle<int64_t, 256>(40'000'003, 1024);
 }
 
+TEST_F(GpuDecoderTest, rleBitpack) {
+  testRleBitpack<int32_t, 256>(1, 1'000'003, 1024);
+  testRleBitpack<int32_t, 256>(11, 4'000'037, 1024);
+  testRleBitpack<int64_t, 256>(17, 4'000'037, 1024);
+}
+
 TEST_F(GpuDecoderTest, makeScatterIndices) {
   testMakeScatterIndices<256>(40013, 1024);
 }
@@ -0,0 +1,593 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/experimental/wave/exec/HashJoin.h"
+
+#include "velox/experimental/wave/exec/ToWave.h"
+#include "velox/experimental/wave/exec/Vectors.h"
+
+DEFINE_int64(
+    velox_wave_join_max_build_bytes,
+    256 << 20,
+    "Largest GPU hash join table. Larger build sides are joined on CPU");
+
+namespace facebook::velox::wave {
+
+namespace {
+
+constexpr int64_t kMinTableCapacity = 64;
+
+// Space for the JoinTable, its operands and the rounding of allocations.
+constexpr int64_t kArenaOverhead = 1 << 20;
+
+int64_t tableCapacity(int64_t numRows) {
+  return bits::nextPowerOfTwo(std::max(2 * numRows, kMinTableCapacity));
+}
+
+bool isFixedWidth(const TypePtr& type) {
+  return type->isFixedWidth() && type->kind() != TypeKind::BOOLEAN &&
+      type->cppSizeInBytes() <= sizeof(int64_t);
+}
+
+// Returns true if the output column 'name' of a join comes from the build
+// side.
+bool isBuildColumn(const core::HashJoinNode& node, const std::string& name) {
+  return !node.sources()[0]->outputType()->containsChild(name) &&
+      node.sources()[1]->outputType()->containsChild(name);
+}
+
+vector_size_t batchSize(WaveVector& input, column_index_t keyChannel) {
+  return input.childAt(keyChannel).size();
+}
+
+RowVectorPtr toRowVector(
+    WaveVector& input,
+    column_index_t keyChannel,
+    memory::MemoryPool* pool) {
+  std::vector<VectorPtr> children(input.type()->size());
+  for (auto i = 0; i < children.size(); ++i) {
+    children[i] = input.childAt(i).toVelox(pool);
+  }
+  return std::make_shared<RowVector>(
+      pool,
+      input.type(),
+      nullptr,
+      batchSize(input, keyChannel),
+      std::move(children));
+}
+
+void checkBlockStatus(const BlockStatus* status, int32_t numBlocks) {
+  for (auto i = 0; i < numBlocks; ++i) {
+    for (auto j = 0; j < kBlockSize; ++j) {
+      VELOX_CHECK(
+          status[i].errors[j] == ErrorCode::kOk,
+          "Error {} in GPU hash join",
+          static_cast<int32_t>(status[i].errors[j]));
+    }
+  }
+}
+
+std::string registryKey(
+    const std::string& taskId,
+    const core::PlanNodeId& planNodeId) {
+  return fmt::format("{}/{}", taskId, planNodeId);
+}
+
+} // namespace
+
+JoinTableRegistry* JoinTableRegistry::getInstance() {
+  static JoinTableRegistry registry;
+  return &registry;
+}
+
+void JoinTableRegistry::acquire(
+    const std::string& taskId,
+    const core::PlanNodeId& planNodeId) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++entries_[registryKey(taskId, planNodeId)].numUsers;
+}
+
+void JoinTableRegistry::release(
+    const std::string& taskId,
+    const core::PlanNodeId& planNodeId) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(registryKey(taskId, planNodeId));
+  VELOX_CHECK(it != entries_.end(), "Releasing unknown GPU join table");
+  if (--it->second.numUsers == 0) {
+    entries_.erase(it);
+  }
+}
+
+void JoinTableRegistry::setTable(
+    const std::string& taskId,
+    const core::PlanNodeId& planNodeId,
+    std::shared_ptr<GpuJoinTable> table) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(registryKey(taskId, planNodeId));
+  VELOX_CHECK(it != entries_.end(), "Setting unknown GPU join table");
+  VELOX_CHECK_NULL(it->second.table, "GPU join table is already set");
+  it->second.table = std::move(table);
+}
+
+std::shared_ptr<GpuJoinTable> JoinTableRegistry::table(
+    const std::string& taskId,
+    const core::PlanNodeId& planNodeId) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(registryKey(taskId, planNodeId));
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  return it->second.table;
+}
+
+bool canJoinOnGpu(const core::HashJoinNode& node) {
+  if (!node.isInnerJoin() || node.filter() || node.leftKeys().size() != 1 ||
+      node.outputType()->size() == 0) {
+    return false;
+  }
+  auto& keyType = node.leftKeys()[0]->type();
+  if ((keyType->kind() != TypeKind::INTEGER &&
+       keyType->kind() != TypeKind::BIGINT) ||
+      node.rightKeys()[0]->type()->kind() != keyType->kind()) {
+    return false;
+  }
+  for (auto& type : node.outputType()->children()) {
+    if (!isFixedWidth(type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+HashBuild::HashBuild(
+    CompileState& state,
+    const core::HashJoinNode& node,
+    exec::Operator* cpuBuild)
+    : WaveOperator(state, ROW({}, {}), node.id()),
+      arena_(&state.arena()),
+      cpuBuild_(cpuBuild),
+      taskId_(cpuBuild->taskId()) {
+  VELOX_CHECK(canJoinOnGpu(node));
+  auto& buildType = node.sources()[1]->outputType();
+  keyChannel_ = exec::exprToChannel(node.rightKeys()[0].get(), buildType);
+  VELOX_CHECK_NE(keyChannel_, kConstantChannel);
+  keyType_ = fromCpuType(*buildType->childAt(keyChannel_));
+  keyWidth_ = buildType->childAt(keyChannel_)->cppSizeInBytes();
+  for (auto& name : node.outputType()->names()) {
+    if (isBuildColumn(node, name)) {
+      auto channel = buildType->getChildIdx(name);
+      buildChannels_.push_back(channel);
+      columnTypes_.push_back(buildType->childAt(channel));
+      columnWidths_.push_back(columnTypes_.back()->cppSizeInBytes());
+    }
+  }
+  JoinTableRegistry::getInstance()->acquire(taskId_, planNodeId_);
+}
+
+HashBuild::~HashBuild() {
+  JoinTableRegistry::getInstance()->release(taskId_, planNodeId_);
+}
+
+int64_t HashBuild::tableBytes(int64_t numRows) const {
+  int64_t rowBytes = 0;
+  for (auto width : columnWidths_) {
+    // One byte for the null flag.
+    rowBytes += width + 1;
+  }
+  return tableCapacity(numRows) * (keyWidth_ + sizeof(int32_t)) +
+      numRows * rowBytes;
+}
+
+void HashBuild::enqueue(WaveVectorPtr input) {
+  VELOX_CHECK(!finished_);
+  numRows_ += batchSize(*input, keyChannel_);
+  buffered_.push_back(std::move(input));
+  if (!onCpu_ &&
+      tableBytes(numRows_) > FLAGS_velox_wave_join_max_build_bytes) {
+    VLOG(1) << "Build side of " << planNodeId_
+            << " does not fit on GPU, building on CPU";
+    onCpu_ = true;
+  }
+  if (onCpu_) {
+    addCpuInput();
+  }
+}
+
+void HashBuild::addCpuInput() {
+  for (auto& input : buffered_) {
+    cpuBuild_->addInput(toRowVector(*input, keyChannel_, cpuBuild_->pool()));
+  }
+  buffered_.clear();
+}
+
+void HashBuild::flush(bool noMoreInput) {
+  if (!noMoreInput || finished_) {
+    return;
+  }
+  if (!onCpu_ && !buildTable()) {
+    VLOG(1) << "Build side of " << planNodeId_
+            << " has duplicate keys or exceeds device memory, building on CPU";
+    onCpu_ = true;
+  }
+  if (onCpu_) {
+    addCpuInput();
+  }
+  buffered_.clear();
+  // The CPU HashBuild publishes its table to the HashJoinBridge. With a GPU
+  // table, the CPU table is empty.
+  cpuBuild_->noMoreInput();
+  finished_ = true;
+}
+
+bool HashBuild::buildTable() {
+  auto gpuTable = std::make_shared<GpuJoinTable>();
+  const auto capacity = tableCapacity(numRows_);
+  // The table is charged to the device memory of the query. If it does not
+  // fit, the build side stays in host memory and the join runs on CPU.
+  try {
+    gpuTable->arena = std::make_unique<GpuArena>(
+        bits::nextPowerOfTwo(tableBytes(numRows_) + kArenaOverhead),
+        getAllocator(getDevice()),
+        arena_->pool());
+  } catch (const VeloxException& e) {
+    if (e.errorCode() != error_code::kMemCapExceeded) {
+      throw;
+    }
+    return false;
+  }
+  auto& arena = *gpuTable->arena;
+  auto& buffers = gpuTable->buffers;
+  auto* table = arena.allocate<hashjoin::JoinTable>(1, buffers.emplace_back());
+  table->keyType = keyType_;
+  table->capacity = capacity;
+  table->numRows = numRows_;
+  buffers.push_back(arena.allocateBytes(capacity * keyWidth_));
+  table->keys = buffers.back()->as<char>();
+  bzero(table->keys, capacity * keyWidth_);
+  table->rows = arena.allocate<int32_t>(capacity, buffers.emplace_back());
+  table->emptyKeyRow = -1;
+  table->numColumns = buildChannels_.size();
+  table->columns =
+      arena.allocate<Operand>(table->numColumns, buffers.emplace_back());
+  table->columnWidths =
+      arena.allocate<int32_t>(table->numColumns, buffers.emplace_back());
+  table->hasDuplicates = 0;
+  for (auto i = 0; i < table->numColumns; ++i) {
+    auto column = WaveVector::create(columnTypes_[i], arena);
+    column->resize(numRows_, true);
+    column->toOperand(&table->columns[i]);
+    table->columnWidths[i] = columnWidths_[i];
+    gpuTable->columns.push_back(std::move(column));
+  }
+
+  if (!buffered_.empty()) {
+    std::vector<WaveBufferPtr> holders;
+    auto* instructions = arena_->allocate<hashjoin::Instruction>(
+        buffered_.size(), holders.emplace_back());
+    int32_t numBlocks = 0;
+    int32_t rowBase = 0;
+    for (auto i = 0; i < buffered_.size(); ++i) {
+      auto& input = *buffered_[i];
+      auto size = batchSize(input, keyChannel_);
+      numBlocks = std::max(numBlocks, (size + kBlockSize - 1) / kBlockSize);
+      instructions[i].opCode = hashjoin::OpCode::kBuildTable;
+      auto& build = instructions[i]._.buildTable;
+      auto* operands = arena_->allocate<Operand>(
+          buildChannels_.size() + 1, holders.emplace_back());
+      build.table = table;
+      build.key = operands;
+      build.columns = operands + 1;
+      build.rowBase = rowBase;
+      input.childAt(keyChannel_).toOperand(build.key);
+      for (auto j = 0; j < buildChannels_.size(); ++j) {
+        input.childAt(buildChannels_[j]).toOperand(&build.columns[j]);
+      }
+      rowBase += size;
+    }
+    auto* programs = arena_->allocate<hashjoin::ThreadBlockProgram>(
+        numBlocks, holders.emplace_back());
+    for (auto i = 0; i < numBlocks; ++i) {
+      programs[i].numInstructions = buffered_.size();
+      programs[i].instructions = instructions;
+    }
+    auto* status =
+        arena_->allocate<BlockStatus>(numBlocks, holders.emplace_back());
+    bzero(status, numBlocks * sizeof(BlockStatus));
+    auto stream = WaveStream::streamFromReserve();
+    hashjoin::call(*stream, numBlocks, programs, status, 0);
+    stream->wait();
+    WaveStream::releaseStream(std::move(stream));
+    checkBlockStatus(status, numBlocks);
+  }
+  if (table->hasDuplicates) {
+    return false;
+  }
+  JoinTableRegistry::getInstance()->setTable(
+      taskId_, planNodeId_, std::move(gpuTable));
+  return true;
+}
+
+HashProbe::HashProbe(
+    CompileState& state,
+    const core::HashJoinNode& node,
+    exec::Operator* cpuProbe)
+    : WaveOperator(state, node.outputType(), node.id()),
+      arena_(&state.arena()),
+      cpuProbe_(cpuProbe),
+      taskId_(cpuProbe->taskId()) {
+  VELOX_CHECK(canJoinOnGpu(node));
+  auto& probeType = node.sources()[0]->outputType();
+  keyChannel_ = exec::exprToChannel(node.leftKeys()[0].get(), probeType);
+  VELOX_CHECK_NE(keyChannel_, kConstantChannel);
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    auto& name = outputType_->nameOf(i);
+    if (isBuildColumn(node, name)) {
+      buildOutputs_.push_back(i);
+    } else {
+      probeChannels_.push_back(probeType->getChildIdx(name));
+      probeOutputs_.push_back(i);
+      probeWidths_.push_back(outputType_->childAt(i)->cppSizeInBytes());
+    }
+  }
+  JoinTableRegistry::getInstance()->acquire(taskId_, planNodeId_);
+}
+
+HashProbe::~HashProbe() {
+  if (flushStream_) {
+    WaveStream::releaseStream(std::move(flushStream_));
+  }
+  JoinTableRegistry::getInstance()->release(taskId_, planNodeId_);
+}
+
+exec::BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
+  if (mode_ != Mode::kWaitForBuild) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  // The CPU HashProbe gets the table from the HashJoinBridge. This is empty
+  // if the build made a GPU table.
+  auto reason = cpuProbe_->isBlocked(future);
+  if (reason != exec::BlockingReason::kNotBlocked) {
+    return reason;
+  }
+  table_ = JoinTableRegistry::getInstance()->table(taskId_, planNodeId_);
+  mode_ = table_ ? Mode::kGpu : Mode::kCpu;
+  VLOG(1) << "Probe of " << planNodeId_ << " runs on "
+          << (table_ ? "GPU" : "CPU");
+  return exec::BlockingReason::kNotBlocked;
+}
+
+void HashProbe::flush(bool noMoreInput) {
+  if (noMoreInput) {
+    noMoreInput_ = true;
+  }
+  switch (mode_) {
+    case Mode::kWaitForBuild:
+      return;
+    case Mode::kCpu:
+      for (auto& input : buffered_) {
+        probeOnCpu(std::move(input));
+      }
+      buffered_.clear();
+      if (noMoreInput_ && !cpuNoMoreInput_) {
+        cpuNoMoreInput_ = true;
+        if (!cpuProbe_->isFinished()) {
+          cpuProbe_->noMoreInput();
+          drainCpuProbe();
+        }
+      }
+      return;
+    case Mode::kGpu:
+      if (!inputs_.empty()) {
+        if (!noMoreInput_ && !flushDone_.query()) {
+          return;
+        }
+        finishProbeOnGpu();
+      }
+      if (!buffered_.empty()) {
+        probeOnGpu();
+      }
+      return;
+  }
+}
+
+void HashProbe::probeOnGpu() {
+  if (!flushStream_) {
+    flushStream_ = WaveStream::streamFromReserve();
+  }
+  inputs_ = std::move(buffered_);
+  buffered_.clear();
+  auto* table = table_->table;
+  auto numInputs = inputs_.size();
+  auto numProbeColumns = probeChannels_.size();
+  numResults_ =
+      arena_->allocate<int32_t>(numInputs, probeMemory_.emplace_back());
+  bzero(numResults_, numInputs * sizeof(int32_t));
+  auto* probeWidths = arena_->allocate<int32_t>(
+      numProbeColumns, probeMemory_.emplace_back());
+  std::copy(probeWidths_.begin(), probeWidths_.end(), probeWidths);
+  auto* instructions = arena_->allocate<hashjoin::Instruction>(
+      numInputs, probeMemory_.emplace_back());
+  numBlocks_ = 0;
+  for (auto i = 0; i < numInputs; ++i) {
+    auto& input = *inputs_[i];
+    auto size = batchSize(input, keyChannel_);
+    numBlocks_ = std::max(numBlocks_, (size + kBlockSize - 1) / kBlockSize);
+    auto* operands = arena_->allocate<Operand>(
+        1 + 2 * numProbeColumns + buildOutputs_.size(),
+        probeMemory_.emplace_back());
+    instructions[i].opCode = hashjoin::OpCode::kProbeTable;
+    auto& probe = instructions[i]._.probeTable;
+    probe.table = table;
+    probe.key = operands;
+    probe.numProbeColumns = numProbeColumns;
+    probe.probeColumns = operands + 1;
+    probe.probeWidths = probeWidths;
+    probe.probeResults = probe.probeColumns + numProbeColumns;
+    probe.buildResults = probe.probeResults + numProbeColumns;
+    probe.numResults = numResults_ + i;
+    input.childAt(keyChannel_).toOperand(probe.key);
+    // The output has at most one row per probe row.
+    auto& result = inFlight_.emplace_back();
+    result.columns.resize(outputType_->size());
+    for (auto j = 0; j < numProbeColumns; ++j) {
+      input.childAt(probeChannels_[j]).toOperand(&probe.probeColumns[j]);
+      auto& column = result.columns[probeOutputs_[j]];
+      column = WaveVector::create(
+          outputType_->childAt(probeOutputs_[j]), *arena_);
+      column->resize(size, true);
+      column->toOperand(&probe.probeResults[j]);
+    }
+    for (auto j = 0; j < buildOutputs_.size(); ++j) {
+      auto& column = result.columns[buildOutputs_[j]];
+      column = WaveVector::create(
+          outputType_->childAt(buildOutputs_[j]), *arena_);
+      column->resize(size, true);
+      column->toOperand(&probe.buildResults[j]);
+    }
+  }
+  auto* programs = arena_->allocate<hashjoin::ThreadBlockProgram>(
+      numBlocks_, probeMemory_.emplace_back());
+  for (auto i = 0; i < numBlocks_; ++i) {
+    programs[i].numInstructions = numInputs;
+    programs[i].instructions = instructions;
+  }
+  status_ =
+      arena_->allocate<BlockStatus>(numBlocks_, probeMemory_.emplace_back());
+  bzero(status_, numBlocks_ * sizeof(BlockStatus));
+  hashjoin::call(
+      *flushStream_,
+      numBlocks_,
+      programs,
+      status_,
+      hashjoin::ProbeTable::sharedSize());
+  flushDone_.record(*flushStream_);
+}
+
+void HashProbe::finishProbeOnGpu() {
+  flushDone_.wait();
+  checkBlockStatus(status_, numBlocks_);
+  for (auto i = 0; i < inFlight_.size(); ++i) {
+    auto& result = inFlight_[i];
+    result.size = numResults_[i];
+    if (result.size == 0) {
+      continue;
+    }
+    for (auto& column : result.columns) {
+      column->resize(result.size, true);
+    }
+    results_.push_back(std::move(result));
+  }
+  inFlight_.clear();
+  inputs_.clear();
+  probeMemory_.clear();
+}
+
+void HashProbe::probeOnCpu(WaveVectorPtr input) {
+  // The CPU HashProbe takes no input after e.g. an empty build.
+  if (!cpuProbe_->needsInput()) {
+    return;
+  }
+  cpuProbe_->addInput(toRowVector(*input, keyChannel_, cpuProbe_->pool()));
+  drainCpuProbe();
+}
+
+void HashProbe::drainCpuProbe() {
+  for (;;) {
+    auto output = cpuProbe_->getOutput();
+    if (!output) {
+      if (cpuProbe_->needsInput() || cpuProbe_->isFinished()) {
+        return;
+      }
+      continue;
+    }
+    if (output->size() == 0) {
+      continue;
+    }
+    // The probe side columns may be dictionaries over the input.
+    for (auto i = 0; i < output->childrenSize(); ++i) {
+      auto& child = output->childAt(i);
+      child = BaseVector::loadedVectorShared(child);
+      BaseVector::flattenVector(child);
+    }
+    auto size = output->size();
+    results_.push_back({std::move(output), {}, size});
+  }
+}
+
+int32_t HashProbe::canAdvance() {
+  if (mode_ == Mode::kGpu) {
+    if (noMoreInput_) {
+      while (!inputs_.empty() || !buffered_.empty()) {
+        flush(true);
+      }
+    } else if (!inputs_.empty() && flushDone_.query()) {
+      finishProbeOnGpu();
+    }
+  }
+  return results_.empty() ? 0 : results_.front().size;
+}
+
+void HashProbe::schedule(WaveStream& stream, int32_t maxRows) {
+  VELOX_CHECK(!results_.empty());
+  auto result = std::move(results_.front());
+  results_.pop_front();
+  VELOX_CHECK_LE(result.size, maxRows);
+  folly::Range<Executable**> empty(nullptr, nullptr);
+  auto numBlocks = bits::roundUp(result.size, kBlockSize) / kBlockSize;
+  stream.prepareProgramLaunch(
+      id_, result.size, empty, numBlocks, true, nullptr);
+  // The output vectors are in the order of their operand ids.
+  const auto numColumns = outputType_->size();
+  std::vector<int32_t> ordinals(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    ordinals[i] = outputIds_.ordinal(defines(Value(subfields_[i]))->id);
+  }
+  if (result.vector) {
+    std::vector<const BaseVector*> sources(numColumns);
+    for (auto i = 0; i < numColumns; ++i) {
+      sources[ordinals[i]] = result.vector->childAt(i).get();
+    }
+    vectorsToDevice(
+        folly::Range(sources.data(), sources.size()), outputIds_, stream);
+    return;
+  }
+  std::vector<WaveVectorPtr> columns(numColumns);
+  auto operands = arena_->allocate<Operand>(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    columns[ordinals[i]] = std::move(result.columns[i]);
+    columns[ordinals[i]]->toOperand(&operands->as<Operand>()[ordinals[i]]);
+  }
+  Executable::startTransfer(
+      outputIds_, std::move(operands), std::move(columns), {}, stream);
+}
+
+bool HashProbe::isFinished() const {
+  return noMoreInput_ && buffered_.empty() && inputs_.empty() &&
+      results_.empty();
+}
+
+vector_size_t HashProbe::outputSize(WaveStream& stream) const {
+  vector_size_t size = 0;
+  outputIds_.forEach([&](auto id) {
+    if (auto* exe = stream.operandExecutable(id)) {
+      size = exe->output[exe->outputOperands.ordinal(id)]->size();
+    }
+  });
+  return size;
+}
+
+} // namespace facebook::velox::wave
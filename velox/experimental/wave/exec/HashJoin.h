@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <deque>
+
+#include "velox/core/PlanNode.h"
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// A JoinTable and the device memory it references. Outlives the HashBuild
+/// that makes it.
+struct GpuJoinTable {
+  // Declared first so that the buffers below are freed before.
+  std::unique_ptr<GpuArena> arena;
+  std::vector<WaveBufferPtr> buffers;
+  std::vector<WaveVectorPtr> columns;
+  hashjoin::JoinTable* table{nullptr};
+};
+
+/// Process wide registry of the GPU hash tables of the joins of running tasks.
+/// The Wave HashBuild of a join sets the table here before it finishes the
+/// build on the replaced CPU HashBuild, which then wakes up the probes through
+/// the HashJoinBridge of the join. A Wave HashProbe looks for the table here
+/// when woken up and probes on CPU if there is none.
+class JoinTableRegistry {
+ public:
+  static JoinTableRegistry* getInstance();
+
+  /// Registers a user of the table of join 'planNodeId' in 'taskId'. Each call
+  /// must be matched by a call to release().
+  void acquire(const std::string& taskId, const core::PlanNodeId& planNodeId);
+
+  /// Unregisters a user. Drops the table after the last user releases it.
+  void release(const std::string& taskId, const core::PlanNodeId& planNodeId);
+
+  void setTable(
+      const std::string& taskId,
+      const core::PlanNodeId& planNodeId,
+      std::shared_ptr<GpuJoinTable> table);
+
+  /// Returns the table of the join or nullptr if the build did not run on GPU.
+  std::shared_ptr<GpuJoinTable> table(
+      const std::string& taskId,
+      const core::PlanNodeId& planNodeId) const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<GpuJoinTable> table;
+    int32_t numUsers{0};
+  };
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, Entry> entries_;
+};
+
+/// Returns true if the join can run on GPU: an inner join without filter on
+/// one integer key and fixed width columns.
+bool canJoinOnGpu(const core::HashJoinNode& node);
+
+/// Builds a GPU hash table from the build side of a join. Replaces the CPU
+/// HashBuild, which builds the table instead if the table would be larger
+/// than FLAGS_velox_wave_join_max_build_bytes or has duplicate keys.
+class HashBuild : public WaveOperator {
+ public:
+  HashBuild(
+      CompileState& state,
+      const core::HashJoinNode& node,
+      exec::Operator* cpuBuild);
+
+  ~HashBuild() override;
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override;
+
+  void flush(bool noMoreInput) override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override {
+    VELOX_UNREACHABLE("HashBuild produces no output");
+  }
+
+  bool isFinished() const override {
+    return finished_;
+  }
+
+  vector_size_t outputSize(WaveStream&) const override {
+    return 0;
+  }
+
+  std::string toString() const override {
+    return "HashBuild";
+  }
+
+ private:
+  // Returns the size of the table for 'numRows' build rows.
+  int64_t tableBytes(int64_t numRows) const;
+
+  // Makes the table from 'buffered_'. Returns false if the build side has
+  // duplicate keys or the table exceeds the device memory of the query.
+  bool buildTable();
+
+  // Moves 'buffered_' to 'cpuBuild_'.
+  void addCpuInput();
+
+  GpuArena* arena_;
+  exec::Operator* const cpuBuild_;
+  const std::string taskId_;
+  column_index_t keyChannel_;
+  PhysicalType keyType_;
+  std::vector<column_index_t> buildChannels_;
+  std::vector<TypePtr> columnTypes_;
+  // Byte width of the key and of the columns in 'buildChannels_'.
+  int32_t keyWidth_;
+  std::vector<int32_t> columnWidths_;
+
+  std::vector<WaveVectorPtr> buffered_;
+  int64_t numRows_{0};
+  bool onCpu_{false};
+  bool finished_{false};
+};
+
+/// Probes the GPU hash table made by HashBuild. Replaces the CPU HashProbe,
+/// which does the probe instead if the build ran on CPU.
+class HashProbe : public WaveOperator {
+ public:
+  HashProbe(
+      CompileState& state,
+      const core::HashJoinNode& node,
+      exec::Operator* cpuProbe);
+
+  ~HashProbe() override;
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override;
+
+  int32_t canAdvance() override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override;
+
+  bool isFinished() const override;
+
+  vector_size_t outputSize(WaveStream& stream) const override;
+
+  std::string toString() const override {
+    return "HashProbe";
+  }
+
+ private:
+  enum class Mode { kWaitForBuild, kGpu, kCpu };
+
+  // An output batch. Either 'vector' from the CPU probe or 'columns' in
+  // the order of 'outputIds_'.
+  struct Result {
+    RowVectorPtr vector;
+    std::vector<WaveVectorPtr> columns;
+    vector_size_t size;
+  };
+
+  // Starts the probe of 'buffered_' on 'flushStream_'.
+  void probeOnGpu();
+
+  // Waits for the probe started by probeOnGpu() and adds its output to
+  // 'results_'.
+  void finishProbeOnGpu();
+
+  // Adds 'input' to 'cpuProbe_' and its output to 'results_'.
+  void probeOnCpu(WaveVectorPtr input);
+
+  void drainCpuProbe();
+
+  GpuArena* arena_;
+  exec::Operator* const cpuProbe_;
+  const std::string taskId_;
+  column_index_t keyChannel_;
+  // The probe side columns in the output and their positions in the output.
+  std::vector<column_index_t> probeChannels_;
+  std::vector<column_index_t> probeOutputs_;
+  std::vector<int32_t> probeWidths_;
+  // The positions of the build side columns in the output.
+  std::vector<column_index_t> buildOutputs_;
+
+  Mode mode_{Mode::kWaitForBuild};
+  std::shared_ptr<GpuJoinTable> table_;
+
+  std::vector<WaveVectorPtr> buffered_;
+  std::vector<WaveVectorPtr> inputs_;
+  std::vector<Result> inFlight_;
+  // Memory for the instructions of the probe in flight.
+  std::vector<WaveBufferPtr> probeMemory_;
+  int32_t* numResults_{nullptr};
+  BlockStatus* status_{nullptr};
+  int32_t numBlocks_{0};
+  std::deque<Result> results_;
+  std::unique_ptr<Stream> flushStream_;
+  Event flushDone_{true};
+
+  bool noMoreInput_{false};
+  bool cpuNoMoreInput_{false};
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+
+#include <cub/cub.cuh> // @manual
+#include "velox/experimental/wave/common/Hash.h"
+#include "velox/experimental/wave/exec/WaveCore.cuh"
+
+#ifdef NDEBUG
+#define LOG_TYPE_DISPATCH_ERROR(_kind)
+#else
+#define LOG_TYPE_DISPATCH_ERROR(_kind) \
+  printf("%s:%d: Unsupported type %d\n", __FILE__, __LINE__, _kind)
+#endif
+
+#define KEY_TYPE_DISPATCH(_func, _kindExpr, ...) \
+  [&]() {                                        \
+    auto _kind = (_kindExpr);                    \
+    switch (_kind) {                             \
+      case PhysicalType::kInt32:                 \
+        return _func<int32_t>(__VA_ARGS__);      \
+      case PhysicalType::kInt64:                 \
+        return _func<int64_t>(__VA_ARGS__);      \
+      default:                                   \
+        LOG_TYPE_DISPATCH_ERROR(_kind);          \
+        return ErrorCode::kError;                \
+    };                                           \
+  }()
+
+namespace facebook::velox::wave::hashjoin {
+
+namespace {
+
+using Scan = cub::BlockScan<int32_t, kBlockSize>;
+
+struct BlockInfo {
+  int base;
+  char* shared;
+};
+
+__device__ bool isNullAt(Operand* op, int32_t index) {
+  return op->nulls && op->nulls[index] == kNull;
+}
+
+template <typename T>
+__device__ T casKey(T* address, T compare, T val) {
+  if constexpr (sizeof(T) == 8) {
+    using ULL = unsigned long long;
+    return atomicCAS((ULL*)address, (ULL)compare, (ULL)val);
+  } else {
+    return atomicCAS(address, compare, val);
+  }
+  __builtin_unreachable();
+}
+
+__device__ void copyValue(
+    Operand* from,
+    int32_t fromIndex,
+    Operand* to,
+    int32_t toIndex,
+    int32_t width) {
+  switch (width) {
+    case 1:
+      reinterpret_cast<int8_t*>(to->base)[toIndex] =
+          value<int8_t>(from, fromIndex);
+      break;
+    case 2:
+      reinterpret_cast<int16_t*>(to->base)[toIndex] =
+          value<int16_t>(from, fromIndex);
+      break;
+    case 4:
+      reinterpret_cast<int32_t*>(to->base)[toIndex] =
+          value<int32_t>(from, fromIndex);
+      break;
+    case 8:
+      reinterpret_cast<int64_t*>(to->base)[toIndex] =
+          value<int64_t>(from, fromIndex);
+      break;
+  }
+  if (to->nulls) {
+    to->nulls[toIndex] = isNullAt(from, fromIndex) ? kNull : kNotNull;
+  }
+}
+
+template <typename T>
+__device__ ErrorCode
+insertKey(JoinTable* table, Operand* key, int32_t index, int32_t row) {
+  auto keyValue = value<T>(key, index);
+  if (keyValue == T{}) {
+    if (atomicCAS(&table->emptyKeyRow, -1, row) != -1) {
+      atomicExch(&table->hasDuplicates, 1);
+    }
+    return ErrorCode::kOk;
+  }
+  auto* keys = reinterpret_cast<T*>(table->keys);
+  auto mask = table->capacity - 1;
+  for (auto i = Hasher<T, uint32_t>()(keyValue) & mask;;
+       i = (i + 1) & mask) {
+    auto existing = casKey(&keys[i], T{}, keyValue);
+    if (existing == T{}) {
+      table->rows[i] = row;
+      return ErrorCode::kOk;
+    }
+    if (existing == keyValue) {
+      atomicExch(&table->hasDuplicates, 1);
+      return ErrorCode::kOk;
+    }
+  }
+}
+
+__device__ ErrorCode run(BlockInfo* block, BuildTable* build) {
+  auto index = block->base + threadIdx.x;
+  if (index >= build->key->size || isNullAt(build->key, index)) {
+    return ErrorCode::kOk;
+  }
+  auto* table = build->table;
+  auto row = build->rowBase + index;
+  auto ec = KEY_TYPE_DISPATCH(
+      insertKey, table->keyType.kind, table, build->key, index, row);
+  if (ec != ErrorCode::kOk) {
+    return ec;
+  }
+  for (auto i = 0; i < table->numColumns; ++i) {
+    copyValue(
+        &build->columns[i],
+        index,
+        &table->columns[i],
+        row,
+        table->columnWidths[i]);
+  }
+  return ErrorCode::kOk;
+}
+
+template <typename T>
+__device__ ErrorCode
+lookupKey(JoinTable* table, Operand* key, int32_t index, int32_t& row) {
+  auto keyValue = value<T>(key, index);
+  if (keyValue == T{}) {
+    row = table->emptyKeyRow;
+    return ErrorCode::kOk;
+  }
+  auto* keys = reinterpret_cast<const T*>(table->keys);
+  auto mask = table->capacity - 1;
+  for (auto i = Hasher<T, uint32_t>()(keyValue) & mask;;
+       i = (i + 1) & mask) {
+    if (keys[i] == keyValue) {
+      row = table->rows[i];
+      return ErrorCode::kOk;
+    }
+    if (keys[i] == T{}) {
+      row = -1;
+      return ErrorCode::kOk;
+    }
+  }
+}
+
+// All threads of the block must call this since the output positions are
+// assigned with a block wide scan.
+__device__ ErrorCode run(BlockInfo* block, ProbeTable* probe) {
+  auto* table = probe->table;
+  auto index = block->base + threadIdx.x;
+  int32_t row = -1;
+  auto ec = ErrorCode::kOk;
+  if (index < probe->key->size && !isNullAt(probe->key, index)) {
+    ec = KEY_TYPE_DISPATCH(
+        lookupKey, table->keyType.kind, table, probe->key, index, row);
+  }
+  auto* tmp = reinterpret_cast<Scan::TempStorage*>(block->shared);
+  auto* blockOffset =
+      reinterpret_cast<int32_t*>(block->shared + sizeof(Scan::TempStorage));
+  int32_t offset;
+  int32_t numMatches;
+  Scan(*tmp).ExclusiveSum(row >= 0 ? 1 : 0, offset, numMatches);
+  if (threadIdx.x == 0) {
+    *blockOffset = atomicAdd(probe->numResults, numMatches);
+  }
+  __syncthreads();
+  if (row < 0) {
+    return ec;
+  }
+  auto outIndex = *blockOffset + offset;
+  for (auto i = 0; i < probe->numProbeColumns; ++i) {
+    copyValue(
+        &probe->probeColumns[i],
+        index,
+        &probe->probeResults[i],
+        outIndex,
+        probe->probeWidths[i]);
+  }
+  for (auto i = 0; i < table->numColumns; ++i) {
+    copyValue(
+        &table->columns[i],
+        row,
+        &probe->buildResults[i],
+        outIndex,
+        table->columnWidths[i]);
+  }
+  return ec;
+}
+
+__global__ void runPrograms(
+    ThreadBlockProgram* programs,
+    BlockStatus* blockStatusArray) {
+  extern __shared__ __align__(64) char shared[];
+  BlockInfo block = {
+      .base = (int)(blockDim.x * blockIdx.x),
+      .shared = shared,
+  };
+  auto& status = blockStatusArray[blockIdx.x];
+  auto& program = programs[blockIdx.x];
+  for (auto i = 0; i < program.numInstructions; ++i) {
+    auto& instruction = program.instructions[i];
+    switch (instruction.opCode) {
+      case OpCode::kBuildTable:
+        status.errors[threadIdx.x] = run(&block, &instruction._.buildTable);
+        break;
+      case OpCode::kProbeTable:
+        status.errors[threadIdx.x] = run(&block, &instruction._.probeTable);
+        // The shared memory is reused by the next instruction.
+        __syncthreads();
+        break;
+      default:
+#ifndef NDEBUG
+        printf(
+            "%s:%d: Unsupported OpCode %d\n",
+            __FILE__,
+            __LINE__,
+            instruction.opCode);
+#endif
+        status.errors[threadIdx.x] = ErrorCode::kError;
+    }
+    if (status.errors[threadIdx.x] != ErrorCode::kOk) {
+      break;
+    }
+  }
+  assert(status.errors[threadIdx.x] == ErrorCode::kOk);
+}
+
+} // namespace
+
+int ProbeTable::sharedSize() {
+  return sizeof(Scan::TempStorage) + sizeof(int32_t);
+}
+
+void call(
+    Stream& stream,
+    int numBlocks,
+    ThreadBlockProgram* programs,
+    BlockStatus* status,
+    int sharedSize) {
+  runPrograms<<<numBlocks, kBlockSize, sharedSize, stream.stream()->stream>>>(
+      programs, status);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave::hashjoin
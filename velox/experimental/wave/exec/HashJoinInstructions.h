@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/Type.h"
+#include "velox/experimental/wave/exec/ErrorCode.h"
+
+namespace facebook::velox::wave::hashjoin {
+
+/// Device resident hash table of the build side of an inner join with one key
+/// and at most one build row per key. Open addressing over 'capacity' slots,
+/// which must be a power of two and at least twice the number of build rows.
+/// Slot i has key 'keys[i]' and the build row number 'rows[i]'. The slot is
+/// empty if the key is the default value of the key type. A build row with
+/// that key is in 'emptyKeyRow'. The dependent columns of the build side are
+/// copied into 'columns', indexed by build row number.
+struct JoinTable {
+  PhysicalType keyType;
+  int32_t capacity;
+  int32_t numRows;
+  void* keys;
+  int32_t* rows;
+  int32_t emptyKeyRow;
+  int32_t numColumns;
+  Operand* columns;
+  // Byte width of each of 'columns'.
+  int32_t* columnWidths;
+  // Set by the build if two build rows have the same key.
+  int32_t hasDuplicates;
+};
+
+/// Inserts the rows of one build side batch into 'table'. The batch starts at
+/// build row 'rowBase'. 'columns' has table->numColumns dependent columns.
+struct BuildTable {
+  JoinTable* table;
+  Operand* key;
+  Operand* columns;
+  int32_t rowBase;
+};
+
+/// Looks up the keys of one probe side batch in 'table' and appends the
+/// matching rows to 'probeResults' and 'buildResults' at positions taken from
+/// 'numResults'.
+struct ProbeTable {
+  JoinTable* table;
+  Operand* key;
+  int32_t numProbeColumns;
+  Operand* probeColumns;
+  int32_t* probeWidths;
+  Operand* probeResults;
+  Operand* buildResults;
+  int32_t* numResults;
+  static int sharedSize();
+};
+
+enum class OpCode {
+  kBuildTable,
+  kProbeTable,
+};
+
+struct Instruction {
+  OpCode opCode;
+  union {
+    BuildTable buildTable;
+    ProbeTable probeTable;
+  } _;
+};
+
+struct ThreadBlockProgram {
+  int32_t numInstructions;
+  Instruction* instructions;
+};
+
+void call(
+    Stream& stream,
+    int numBlocks,
+    ThreadBlockProgram* programs,
+    BlockStatus* status,
+    int sharedSize);
+
+} // namespace facebook::velox::wave::hashjoin
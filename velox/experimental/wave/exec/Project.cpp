@@ -49,6 +49,19 @@ void Project::schedule(WaveStream& stream, int32_t maxRows) {
   }
 }
 
+void Project::fuse(
+    CompileState& state,
+    RowTypePtr outputType,
+    std::vector<std::vector<ProgramPtr>> levels) {
+  levels_ = std::move(levels);
+  outputType_ = std::move(outputType);
+  subfields_.clear();
+  types_.clear();
+  outputIds_ = OperandSet();
+  defines_.clear();
+  definesSubfields(state, outputType_);
+}
+
 void Project::finalize(CompileState& state) {
   for (auto& level : levels_) {
     for (auto& program : level) {
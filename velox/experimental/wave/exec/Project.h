@@ -24,8 +24,11 @@ class Project : public WaveOperator {
       CompileState& state,
       RowTypePtr outputType,
       std::vector<AbstractOperand*> operands,
-      std::vector<std::vector<ProgramPtr>> levels)
-      : WaveOperator(state, outputType, ""), levels_(std::move(levels)) {}
+      std::vector<std::vector<ProgramPtr>> levels,
+      int32_t firstProgram)
+      : WaveOperator(state, outputType, ""),
+        levels_(std::move(levels)),
+        firstProgram_(firstProgram) {}
 
   bool isStreaming() const override {
     return true;
@@ -33,6 +36,19 @@ class Project : public WaveOperator {
 
   void schedule(WaveStream& stream, int32_t maxRows = 0) override;
 
+  /// Index of the first Program of 'this' in the Programs of the CompileState.
+  int32_t firstProgram() const {
+    return firstProgram_;
+  }
+
+  /// Merges a FilterProject that directly follows 'this' into 'this', so that
+  /// both run in the same kernel launches. 'levels' cover the Programs of both
+  /// and 'outputType' is the output of the merged FilterProject.
+  void fuse(
+      CompileState& state,
+      RowTypePtr outputType,
+      std::vector<std::vector<ProgramPtr>> levels);
+
   vector_size_t outputSize(WaveStream& stream) const override;
 
   void finalize(CompileState& state) override;
@@ -47,6 +63,7 @@ class Project : public WaveOperator {
 
  private:
   std::vector<std::vector<ProgramPtr>> levels_;
+  const int32_t firstProgram_;
   OperandSet computedSet_;
 };
 
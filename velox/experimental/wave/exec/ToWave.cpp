@@ -16,7 +16,10 @@
 
 #include "velox/experimental/wave/exec/ToWave.h"
 #include "velox/exec/FilterProject.h"
+#include "velox/exec/Task.h"
+#include "velox/experimental/wave/common/GpuMemoryManager.h"
 #include "velox/experimental/wave/exec/Aggregation.h"
+#include "velox/experimental/wave/exec/HashJoin.h"
 #include "velox/experimental/wave/exec/Project.h"
 #include "velox/experimental/wave/exec/TableScan.h"
 #include "velox/experimental/wave/exec/Values.h"
@@ -26,6 +29,11 @@
 
 DEFINE_int64(velox_wave_arena_unit_size, 1 << 30, "Per Driver GPU memory size");
 
+DEFINE_int64(
+    velox_wave_query_device_memory_bytes,
+    facebook::velox::memory::kMaxMemory,
+    "Device memory of each query running on GPU");
+
 namespace facebook::velox::wave {
 
 using exec::Expr;
@@ -217,7 +225,7 @@ std::vector<std::vector<ProgramPtr>> CompileState::makeLevels(
     int32_t startIndex) {
   std::vector<std::vector<ProgramPtr>> levels;
   folly::F14FastSet<Program*> toAdd;
-  for (auto i = 0; i < allPrograms_.size(); ++i) {
+  for (auto i = startIndex; i < allPrograms_.size(); ++i) {
     toAdd.insert(allPrograms_[i].get());
   }
   while (!toAdd.empty()) {
@@ -261,7 +269,14 @@ void CompileState::addFilterProject(
   auto filterProject = reinterpret_cast<exec::FilterProject*>(op);
   auto data = filterProject->exprsAndProjection();
   VELOX_CHECK(!data.hasFilter);
-  int32_t numPrograms = allPrograms_.size();
+  // Consecutive projections run in the same kernel launches. The instructions
+  // of this go into the still mutable Programs of the previous Project and the
+  // levels are made over the Programs of both.
+  auto* previous = operators_.empty()
+      ? nullptr
+      : dynamic_cast<Project*>(operators_.back().get());
+  int32_t numPrograms =
+      previous ? previous->firstProgram() : allPrograms_.size();
   auto operands = addExprSet(*data.exprs, 0, data.exprs->exprs().size());
   for (auto i = 0; i < operands.size(); ++i) {
     int32_t channel = findOutputChannel(*data.resultProjections, i);
@@ -269,8 +284,12 @@ void CompileState::addFilterProject(
     definedBy_[Value(subfield)] = operands[i];
   }
   auto levels = makeLevels(numPrograms);
-  operators_.push_back(
-      std::make_unique<Project>(*this, outputType, operands, levels));
+  if (previous) {
+    previous->fuse(*this, outputType, std::move(levels));
+    return;
+  }
+  operators_.push_back(std::make_unique<Project>(
+      *this, outputType, operands, levels, numPrograms));
 }
 
 bool CompileState::reserveMemory() {
@@ -278,8 +297,11 @@ bool CompileState::reserveMemory() {
     return true;
   }
   auto* allocator = getAllocator(getDevice());
-  arena_ =
-      std::make_unique<GpuArena>(FLAGS_velox_wave_arena_unit_size, allocator);
+  auto pool = GpuMemoryManager::getInstance()->pool(
+      driver_.driverCtx()->task->queryCtx()->queryId(),
+      FLAGS_velox_wave_query_device_memory_bytes);
+  arena_ = std::make_unique<GpuArena>(
+      FLAGS_velox_wave_arena_unit_size, allocator, std::move(pool));
   return true;
 }
 
@@ -327,6 +349,26 @@ bool CompileState::addOperator(
     operators_.push_back(std::make_unique<Aggregation>(
         *this, *node, aggregateFunctionRegistry()));
     outputType = node->outputType();
+  } else if (name == "HashBuild") {
+    auto* node = dynamic_cast<const core::HashJoinNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    VELOX_CHECK_NOT_NULL(node);
+    // The CPU HashBuild coordinates the build of multiple Drivers.
+    if (!canJoinOnGpu(*node) || driverFactory_.numDrivers != 1 ||
+        !reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<HashBuild>(*this, *node, op));
+    outputType = ROW({}, {});
+  } else if (name == "HashProbe") {
+    auto* node = dynamic_cast<const core::HashJoinNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    VELOX_CHECK_NOT_NULL(node);
+    if (!canJoinOnGpu(*node) || !reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<HashProbe>(*this, *node, op));
+    outputType = node->outputType();
   } else if (name == "TableScan") {
     if (!reserveMemory()) {
       return false;
@@ -18,6 +18,13 @@
 #include "velox/experimental/wave/exec/Instruction.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
+DEFINE_int32(
+    velox_wave_max_streams_per_pipeline,
+    4,
+    "Maximum number of batches in flight per Wave pipeline. Consecutive "
+    "batches are on different streams, so that the transfer of a batch can "
+    "overlap with the compute of the previous one");
+
 namespace facebook::velox::wave {
 
 WaveDriver::WaveDriver(
@@ -55,6 +62,9 @@ RowVectorPtr WaveDriver::getOutput() {
   VLOG(1) << "Getting output";
   for (;;) {
     startMore();
+    if (blockingReason_ != exec::BlockingReason::kNotBlocked) {
+      return nullptr;
+    }
     bool running = false;
     for (int i = pipelines_.size() - 1; i >= 0; --i) {
       if (pipelines_[i].streams.empty()) {
@@ -96,6 +106,17 @@ RowVectorPtr WaveDriver::getOutput() {
       running = true;
     }
     if (!running) {
+      if (!flushedAtEnd_) {
+        // A pipeline gets no flush from a previous pipeline that produced
+        // nothing.
+        flushedAtEnd_ = true;
+        for (auto i = 1; i < pipelines_.size(); ++i) {
+          if (pipelines_[i - 1].operators[0]->isFinished()) {
+            pipelines_[i].operators[0]->flush(true);
+          }
+        }
+        continue;
+      }
       VLOG(1) << "No more output";
       finished_ = true;
       return nullptr;
@@ -144,12 +165,20 @@ RowVectorPtr WaveDriver::makeResult(
 }
 
 void WaveDriver::startMore() {
-  for (int i = 0; i < pipelines_.size(); ++i) {
-    auto& ops = pipelines_[i].operators;
-    blockingReason_ = ops[0]->isBlocked(&blockingFuture_);
+  // A pipeline that waits for e.g. a join build blocks the pipelines that feed
+  // it too.
+  for (auto& pipeline : pipelines_) {
+    blockingReason_ = pipeline.operators[0]->isBlocked(&blockingFuture_);
     if (blockingReason_ != exec::BlockingReason::kNotBlocked) {
       return;
     }
+  }
+  for (int i = 0; i < pipelines_.size(); ++i) {
+    auto& ops = pipelines_[i].operators;
+    if (static_cast<int32_t>(pipelines_[i].streams.size()) >=
+        FLAGS_velox_wave_max_streams_per_pipeline) {
+      continue;
+    }
     if (auto rows = ops[0]->canAdvance()) {
       VLOG(1) << "Advance " << rows << " rows in pipeline " << i;
       auto stream = std::make_unique<WaveStream>(*arena_);
@@ -166,7 +195,18 @@ void WaveDriver::startMore() {
 }
 
 void WaveDriver::prefetchReturn(WaveStream& stream) {
-  // Schedule return buffers from last op to be on host side.
+  // The result columns move to host on the stream of the kernel that produces
+  // them, so that the move overlaps with the compute of the next batch and
+  // makeResult() does not fault on unified memory.
+  for (auto id : resultOrder_) {
+    auto* exe = stream.operandExecutable(id);
+    if (!exe || !exe->stream || !exe->outputOperands.contains(id)) {
+      continue;
+    }
+    if (auto* vector = exe->operandVector(id)) {
+      vector->prefetchToHost(*exe->stream);
+    }
+  }
 }
 
 LaunchControl* WaveDriver::inputControl(
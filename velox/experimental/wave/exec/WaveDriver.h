@@ -111,6 +111,9 @@ class WaveDriver : public exec::SourceOperator {
 
   bool finished_{false};
 
+  // True after the last pipelines are flushed at the end of input.
+  bool flushedAtEnd_{false};
+
   struct Pipeline {
     // Wave operators replacing 'cpuOperators_' on GPU path.
     std::vector<std::unique_ptr<WaveOperator>> operators;
@@ -96,3 +96,22 @@ TEST_F(FilterProjectTest, project) {
 
   assertProject(vectors);
 }
+
+TEST_F(FilterProjectTest, consecutiveProjects) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto vector = std::dynamic_pointer_cast<RowVector>(
+        BatchMaker::createBatch(rowType_, 100, *pool_));
+    makeNotNull(vector, 1000000000);
+    vectors.push_back(vector);
+  }
+  createDuckDbTable(vectors);
+
+  // The second projection runs in the kernels of the first.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0", "c1", "c0 + c1 AS s"})
+                  .project({"c0", "s", "s + c1"})
+                  .planNode();
+  assertQuery(plan, "SELECT c0, c0 + c1, c0 + c1 + c1 FROM tmp");
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cuda_runtime.h> // @manual
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+DECLARE_int64(velox_wave_join_max_build_bytes);
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace exec::test;
+
+class HashJoinTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    wave::registerWave();
+  }
+
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+    OperatorTestBase::SetUp();
+  }
+
+  // Joins 'probe' with 't0' as key and 'build' with 'u0' as key and checks
+  // the result against DuckDB.
+  void assertJoin(
+      const std::vector<RowVectorPtr>& probe,
+      const std::vector<RowVectorPtr>& build) {
+    createDuckDbTable("t", probe);
+    createDuckDbTable("u", build);
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan =
+        PlanBuilder(planNodeIdGenerator)
+            .values(probe)
+            .hashJoin(
+                {"t0"},
+                {"u0"},
+                PlanBuilder(planNodeIdGenerator).values(build).planNode(),
+                "",
+                {"t0", "t1", "u1"})
+            .planNode();
+    assertQuery(plan, "SELECT t0, t1, u1 FROM t, u WHERE t0 = u0");
+  }
+
+  std::vector<RowVectorPtr> makeProbe(int32_t numBatches, int32_t batchSize) {
+    std::vector<RowVectorPtr> batches;
+    for (auto i = 0; i < numBatches; ++i) {
+      batches.push_back(makeRowVector(
+          {"t0", "t1"},
+          {makeFlatVector<int64_t>(
+               batchSize, [&](auto row) { return (row * 7 + i) % 3'000; }),
+           makeFlatVector<int64_t>(
+               batchSize, [&](auto row) { return row + i * batchSize; })}));
+    }
+    return batches;
+  }
+
+  // Makes a build side with keys 0, 2, 4... and each key 'repeats' times.
+  std::vector<RowVectorPtr> makeBuild(int32_t numKeys, int32_t repeats = 1) {
+    return {makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int64_t>(
+             numKeys * repeats, [&](auto row) { return row / repeats * 2; }),
+         makeFlatVector<double>(
+             numKeys * repeats, [](auto row) { return row * 0.5; })})};
+  }
+};
+
+TEST_F(HashJoinTest, innerJoin) {
+  assertJoin(makeProbe(10, 1'000), makeBuild(1'000));
+}
+
+TEST_F(HashJoinTest, zeroKey) {
+  // 0 is the empty slot marker of the GPU table.
+  auto probe = makeRowVector(
+      {"t0", "t1"},
+      {makeFlatVector<int64_t>({0, 1, 2, 0}),
+       makeFlatVector<int64_t>({10, 11, 12, 13})});
+  assertJoin({probe}, makeBuild(10));
+}
+
+TEST_F(HashJoinTest, emptyBuild) {
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(std::vector<int64_t>{}),
+       makeFlatVector<double>(std::vector<double>{})});
+  assertJoin(makeProbe(2, 100), {build});
+}
+
+TEST_F(HashJoinTest, duplicateBuildKeys) {
+  // The GPU table has one row per key. The CPU HashBuild builds the table.
+  assertJoin(makeProbe(4, 1'000), makeBuild(500, 3));
+}
+
+TEST_F(HashJoinTest, buildTooLarge) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_wave_join_max_build_bytes = 1'000;
+  assertJoin(makeProbe(4, 1'000), makeBuild(1'000));
+}
+
+} // namespace
+} // namespace facebook::velox::wave
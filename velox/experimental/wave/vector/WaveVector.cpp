@@ -65,8 +65,9 @@ void WaveVector::resize(vector_size_t size, bool nullable) {
     } else {
       nulls_.reset();
     }
-    size_ = size;
   }
+  // Shrinking keeps the buffers.
+  size_ = size;
 }
 
 void WaveVector::toOperand(Operand* operand) const {
@@ -127,6 +128,18 @@ static VectorPtr toVeloxTyped(
       std::vector<BufferPtr>());
 }
 
+void WaveVector::prefetchToHost(Stream& stream) {
+  if (values_) {
+    stream.prefetch(nullptr, values_->as<char>(), values_->size());
+  }
+  if (nulls_) {
+    stream.prefetch(nullptr, nulls_->as<char>(), nulls_->size());
+  }
+  for (auto& child : children_) {
+    child->prefetchToHost(stream);
+  }
+}
+
 VectorPtr WaveVector::toVelox(memory::MemoryPool* pool) {
   return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
       toVeloxTyped, type_->kind(), size_, pool, type_, values_, nulls_);
@@ -105,6 +105,10 @@ class WaveVector {
   /// buffers stay live while referenced by Velox.
   VectorPtr toVelox(memory::MemoryPool* pool);
 
+  /// Enqueues a prefetch of the buffers of 'this' and its children to host on
+  /// 'stream'.
+  void prefetchToHost(Stream& stream);
+
   /// Sets 'operand' to point to the buffers of 'this'.
   void toOperand(Operand* operand) const;
 
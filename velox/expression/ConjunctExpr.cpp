@@ -183,6 +183,13 @@ void ConjunctExpr::evalSpecialForm(
 }
 
 void ConjunctExpr::maybeReorderInputs() {
+  // The inputs are ordered after the first batch and then every
+  // 'kReorderInterval' batches to avoid reordering on noise.
+  ++numBatches_;
+  const bool periodic = numBatches_ > 1;
+  if (periodic && numBatches_ % kReorderInterval != 0) {
+    return;
+  }
   bool reorder = false;
   for (auto i = 1; i < inputs_.size(); ++i) {
     if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
@@ -200,6 +207,13 @@ void ConjunctExpr::maybeReorderInputs() {
               selectivity_[right].timeToDropValue();
         });
   }
+  if (periodic) {
+    // Recent batches weigh more so that the order follows changes in the
+    // data, e.g. when a selective input stops dropping rows.
+    for (auto& selectivity : selectivity_) {
+      selectivity.decay();
+    }
+  }
 }
 
 namespace {
@@ -64,6 +64,11 @@ class ConjunctExpr : public SpecialForm {
     return selectivity_[inputOrder_[index]];
   }
 
+  /// Returns the indices of the inputs in the order of evaluation.
+  const std::vector<int32_t>& inputOrder() const {
+    return inputOrder_;
+  }
+
   std::string toSql(
       std::vector<VectorPtr>* complexConstants = nullptr) const override;
 
@@ -74,6 +79,8 @@ class ConjunctExpr : public SpecialForm {
     propagatesNulls_ = false;
   }
 
+  // Reorders the inputs by increasing time to drop a row after the first
+  // batch and periodically after that. Invoked after each batch.
   void maybeReorderInputs();
 
   void updateResult(
@@ -96,8 +103,12 @@ class ConjunctExpr : public SpecialForm {
   BufferPtr tempNulls_;
   bool reorderEnabledChecked_ = false;
   bool reorderEnabled_;
+  // Number of batches between reorderings of the inputs.
+  static constexpr uint64_t kReorderInterval = 8;
+
   std::vector<SelectivityInfo> selectivity_;
   std::vector<int32_t> inputOrder_;
+  uint64_t numBatches_{0};
 
   friend class ConjunctCallToSpecialForm;
 };
@@ -53,6 +53,16 @@ class ConstantExpr : public SpecialForm {
     return sharedConstantValue_;
   }
 
+  /// Marks 'this' as the result of folding a constant sub-expression at
+  /// compile time.
+  void setFolded() {
+    folded_ = true;
+  }
+
+  bool isFolded() const {
+    return folded_;
+  }
+
   std::string toString(bool recursive = true) const override;
 
   std::string toSql(
@@ -61,5 +71,6 @@ class ConstantExpr : public SpecialForm {
  private:
   VectorPtr sharedConstantValue_;
   bool needToSetIsAscii_;
+  bool folded_{false};
 };
 } // namespace facebook::velox::exec
@@ -330,12 +330,19 @@ class EvalCtx {
     return maxSharedSubexprResultsCached_;
   }
 
+  /// Returns the maximum number of dictionary base vectors an expression keeps
+  /// memoized results for in Expr::evalWithMemo.
+  uint32_t maxDictionaryMemoEntries() const {
+    return maxDictionaryMemoEntries_;
+  }
+
  private:
   core::ExecCtx* const execCtx_;
   ExprSet* const exprSet_;
   const RowVector* row_;
   const bool cacheEnabled_;
   const uint32_t maxSharedSubexprResultsCached_;
+  const uint32_t maxDictionaryMemoEntries_;
   bool inputFlatNoNulls_;
 
   // Corresponds 1:1 to children of 'row_'. Set to an inner vector
@@ -1082,6 +1082,7 @@ void Expr::evalEncodings(
             finalRowsHolder);
         auto* newRows = peelEncodingsResult.newRows;
         if (newRows) {
+          ++stats_.numPeeledVectors;
           VectorPtr peeledResult;
           // peelEncodings() can potentially produce an empty selectivity
           // vector if all selected values we are waiting for are nulls. So,
@@ -1198,46 +1199,43 @@ void Expr::evalWithMemo(
   VectorPtr base;
   distinctFields_[0]->evalSpecialForm(rows, context, base);
 
-  if (base.get() != baseOfDictionaryRawPtr_ ||
-      baseOfDictionaryWeakPtr_.expired()) {
-    baseOfDictionaryRepeats_ = 0;
-    baseOfDictionaryWeakPtr_ = base;
-    baseOfDictionaryRawPtr_ = base.get();
-    context.releaseVector(baseOfDictionary_);
-    context.releaseVector(dictionaryCache_);
+  auto* memo = findDictionaryMemo(base, context);
+  if (memo == nullptr) {
     evalWithNulls(rows, context, result);
     return;
   }
-  ++baseOfDictionaryRepeats_;
+  ++memo->baseOfDictionaryRepeats;
 
-  if (baseOfDictionaryRepeats_ == 1) {
+  auto& dictionaryCache = memo->dictionaryCache;
+  auto& cachedDictionaryIndices = memo->cachedDictionaryIndices;
+  if (memo->baseOfDictionaryRepeats == 1) {
     evalWithNulls(rows, context, result);
-    baseOfDictionary_ = base;
-    dictionaryCache_ = result;
-    if (!cachedDictionaryIndices_) {
-      cachedDictionaryIndices_ =
+    memo->baseOfDictionary = base;
+    dictionaryCache = result;
+    if (!cachedDictionaryIndices) {
+      cachedDictionaryIndices =
           context.execCtx()->getSelectivityVector(rows.end());
     }
-    *cachedDictionaryIndices_ = rows;
-    context.deselectErrors(*cachedDictionaryIndices_);
+    *cachedDictionaryIndices = rows;
+    context.deselectErrors(*cachedDictionaryIndices);
     return;
   }
 
-  if (cachedDictionaryIndices_) {
+  if (cachedDictionaryIndices) {
     LocalSelectivityVector cachedHolder(context, rows);
     auto cached = cachedHolder.get();
     VELOX_DCHECK(cached != nullptr);
-    cached->intersect(*cachedDictionaryIndices_);
+    cached->intersect(*cachedDictionaryIndices);
     if (cached->hasSelections()) {
       context.ensureWritable(rows, type(), result);
-      result->copy(dictionaryCache_.get(), *cached, nullptr);
+      result->copy(dictionaryCache.get(), *cached, nullptr);
     }
   }
   LocalSelectivityVector uncachedHolder(context, rows);
   auto uncached = uncachedHolder.get();
   VELOX_DCHECK(uncached != nullptr);
-  if (cachedDictionaryIndices_) {
-    uncached->deselect(*cachedDictionaryIndices_);
+  if (cachedDictionaryIndices) {
+    uncached->deselect(*cachedDictionaryIndices);
   }
   if (uncached->hasSelections()) {
     // Fix finalSelection at "rows" if uncached rows is a strict subset to
@@ -1251,32 +1249,62 @@ void Expr::evalWithMemo(
     context.exprSet()->addToMemo(this);
     auto newCacheSize = uncached->end();
 
-    // dictionaryCache_ is valid only for cachedDictionaryIndices_. Hence, a
+    // 'dictionaryCache' is valid only for 'cachedDictionaryIndices'. Hence, a
     // safe call to BaseVector::ensureWritable must include all the rows not
-    // covered by cachedDictionaryIndices_. If BaseVector::ensureWritable is
+    // covered by 'cachedDictionaryIndices'. If BaseVector::ensureWritable is
     // called only for a subset of rows not covered by
-    // cachedDictionaryIndices_, it will attempt to copy rows that are not
+    // 'cachedDictionaryIndices', it will attempt to copy rows that are not
     // valid leading to a crash.
-    LocalSelectivityVector allUncached(context, dictionaryCache_->size());
+    LocalSelectivityVector allUncached(context, dictionaryCache->size());
     allUncached.get()->setAll();
-    allUncached.get()->deselect(*cachedDictionaryIndices_);
-    context.ensureWritable(*allUncached.get(), type(), dictionaryCache_);
+    allUncached.get()->deselect(*cachedDictionaryIndices);
+    context.ensureWritable(*allUncached.get(), type(), dictionaryCache);
 
-    if (cachedDictionaryIndices_->size() < newCacheSize) {
-      cachedDictionaryIndices_->resize(newCacheSize, false);
+    if (cachedDictionaryIndices->size() < newCacheSize) {
+      cachedDictionaryIndices->resize(newCacheSize, false);
     }
 
-    cachedDictionaryIndices_->select(*uncached);
+    cachedDictionaryIndices->select(*uncached);
 
-    // Resize the dictionaryCache_ to accommodate all the necessary rows.
-    if (dictionaryCache_->size() < uncached->end()) {
-      dictionaryCache_->resize(uncached->end());
+    // Resize 'dictionaryCache' to accommodate all the necessary rows.
+    if (dictionaryCache->size() < uncached->end()) {
+      dictionaryCache->resize(uncached->end());
     }
-    dictionaryCache_->copy(result.get(), *uncached, nullptr);
+    dictionaryCache->copy(result.get(), *uncached, nullptr);
   }
   context.releaseVector(base);
 }
 
+Expr::DictionaryMemo* Expr::findDictionaryMemo(
+    const VectorPtr& base,
+    EvalCtx& context) {
+  for (auto it = dictionaryMemos_.begin(); it != dictionaryMemos_.end(); ++it) {
+    if (it->baseOfDictionaryRawPtr != base.get()) {
+      continue;
+    }
+    if (it->baseOfDictionaryWeakPtr.expired()) {
+      // A new vector at the address of a freed one.
+      dictionaryMemos_.erase(it);
+      break;
+    }
+    std::rotate(it, it + 1, dictionaryMemos_.end());
+    return &dictionaryMemos_.back();
+  }
+
+  const auto maxEntries =
+      std::max<uint32_t>(1, context.maxDictionaryMemoEntries());
+  while (dictionaryMemos_.size() >= maxEntries) {
+    auto& evicted = dictionaryMemos_.front();
+    context.releaseVector(evicted.baseOfDictionary);
+    context.releaseVector(evicted.dictionaryCache);
+    dictionaryMemos_.erase(dictionaryMemos_.begin());
+  }
+  auto& memo = dictionaryMemos_.emplace_back();
+  memo.baseOfDictionaryWeakPtr = base;
+  memo.baseOfDictionaryRawPtr = base.get();
+  return nullptr;
+}
+
 void Expr::setAllNulls(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1475,6 +1503,7 @@ bool Expr::applyFunctionWithPeeling(
   if (!peeledEncoding) {
     return false;
   }
+  ++stats_.numPeeledVectors;
   inputValues_ = std::move(peeledVectors);
   peeledVectors.clear();
 
@@ -1511,6 +1540,13 @@ void Expr::applyFunction(
     VectorPtr& result) {
   stats_.numProcessedVectors += 1;
   stats_.numProcessedRows += rows.countSelected();
+  for (const auto& input : inputValues_) {
+    ++stats_.numInputVectors;
+    if ((isFlat(*input) || input->isConstantEncoding()) &&
+        !input->mayHaveNulls()) {
+      ++stats_.numFlatNoNullsInputVectors;
+    }
+  }
   auto timer = cpuWallTimer();
 
   computeIsAsciiForInputs(vectorFunction_.get(), inputValues_, rows);
@@ -1784,6 +1820,35 @@ void addStats(
   }
 }
 
+void addProfiles(
+    const exec::Expr& expr,
+    int32_t exprIndex,
+    int32_t parent,
+    std::vector<exec::ExprProfile>& profiles,
+    std::unordered_map<const exec::Expr*, int32_t>& uniqueExprs) {
+  const int32_t index = profiles.size();
+  auto& profile = profiles.emplace_back();
+  profile.name = expr.name();
+  profile.exprIndex = exprIndex;
+  profile.parent = parent;
+  auto it = uniqueExprs.find(&expr);
+  if (it != uniqueExprs.end()) {
+    // Common sub-expression. The stats and inputs are with the first
+    // occurrence.
+    profile.commonSubexpressionOf = it->second;
+    return;
+  }
+  uniqueExprs.emplace(&expr, index);
+  if (auto* constant = dynamic_cast<const exec::ConstantExpr*>(&expr)) {
+    profile.constantFolded = constant->isFolded();
+  }
+  profile.stats = expr.stats();
+
+  for (const auto& input : expr.inputs()) {
+    addProfiles(*input, exprIndex, index, profiles, uniqueExprs);
+  }
+}
+
 std::string makeUuid() {
   return boost::lexical_cast<std::string>(boost::uuids::random_generator()());
 }
@@ -1799,10 +1864,20 @@ std::unordered_map<std::string, exec::ExprStats> ExprSet::stats() const {
   return stats;
 }
 
+std::vector<exec::ExprProfile> ExprSet::profile() const {
+  std::vector<exec::ExprProfile> profiles;
+  std::unordered_map<const exec::Expr*, int32_t> uniqueExprs;
+  for (auto i = 0; i < exprs_.size(); ++i) {
+    addProfiles(*exprs_[i], i, -1, profiles, uniqueExprs);
+  }
+  return profiles;
+}
+
 ExprSet::~ExprSet() {
   exprSetListeners().withRLock([&](auto& listeners) {
     if (!listeners.empty()) {
       auto exprStats = stats();
+      auto profiles = profile();
 
       std::vector<std::string> sqls;
       for (const auto& expr : exprs()) {
@@ -1817,7 +1892,8 @@ ExprSet::~ExprSet() {
       auto uuid = makeUuid();
       for (const auto& listener : listeners) {
         listener->onCompletion(
-            uuid, {exprStats, sqls, execCtx()->queryCtx()->queryId()});
+            uuid,
+            {exprStats, profiles, sqls, execCtx()->queryCtx()->queryId()});
       }
     }
   });
@@ -59,21 +59,66 @@ struct ExprStats {
   /// size.
   uint64_t numProcessedVectors{0};
 
+  /// Number of argument vectors passed to the function of a function call.
+  uint64_t numInputVectors{0};
+
+  /// Number of argument vectors that are flat or constant and have no nulls,
+  /// i.e. qualify for the fast paths of the functions. A low fraction of the
+  /// 'numInputVectors' means that the calls go through the generic paths for
+  /// decoded arguments.
+  uint64_t numFlatNoNullsInputVectors{0};
+
+  /// Number of batches evaluated after peeling off the dictionary or constant
+  /// encodings of the inputs.
+  uint64_t numPeeledVectors{0};
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
+    numInputVectors += other.numInputVectors;
+    numFlatNoNullsInputVectors += other.numFlatNoNullsInputVectors;
+    numPeeledVectors += other.numPeeledVectors;
   }
 
   std::string toString() const {
     return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}",
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, "
+        "numInputVectors: {}, numFlatNoNullsInputVectors: {}, "
+        "numPeeledVectors: {}",
         timing.toString(),
         numProcessedRows,
-        numProcessedVectors);
+        numProcessedVectors,
+        numInputVectors,
+        numFlatNoNullsInputVectors,
+        numPeeledVectors);
   }
 };
 
+/// Runtime statistics of one node of an expression tree. See
+/// ExprSet::profile().
+struct ExprProfile {
+  /// Name of the expression, e.g. a function name or 'and'.
+  std::string name;
+
+  /// Index of the top level expression in the ExprSet the node belongs to.
+  int32_t exprIndex;
+
+  /// Index of the profile of the parent node or -1 for a top level expression.
+  int32_t parent;
+
+  /// Index of the profile of the same node if the node is a common
+  /// sub-expression reached before. Its stats are reported there only. -1
+  /// otherwise.
+  int32_t commonSubexpressionOf{-1};
+
+  /// True if the node is a constant that replaced a constant sub-expression
+  /// at compile time.
+  bool constantFolded{false};
+
+  ExprStats stats;
+};
+
 /// Maintains a set of rows for evaluation and removes rows with
 /// nulls or errors as needed. Helps to avoid copying SelectivityVector in cases
 /// when evaluation doesn't encounter nulls or errors.
@@ -251,12 +296,7 @@ class Expr {
   }
 
   void clearMemo() {
-    baseOfDictionaryRepeats_ = 0;
-    baseOfDictionary_.reset();
-    baseOfDictionaryWeakPtr_.reset();
-    baseOfDictionaryRawPtr_ = nullptr;
-    dictionaryCache_ = nullptr;
-    cachedDictionaryIndices_ = nullptr;
+    dictionaryMemos_.clear();
   }
 
   const TypePtr& type() const {
@@ -615,28 +655,38 @@ class Expr {
   // evaluateSharedSubexpr() is called to the cached shared results.
   std::map<std::vector<const BaseVector*>, SharedResults> sharedSubexprResults_;
 
-  // Pointers to the last base vector of cachable dictionary input. Used to
-  // check if the current input's base vector is the same as the last. If it's
-  // the same, then results can be cached.
-  std::weak_ptr<BaseVector> baseOfDictionaryWeakPtr_;
-  BaseVector* baseOfDictionaryRawPtr_ = nullptr;
+  // Memoized results for one base vector of cachable dictionary input.
+  struct DictionaryMemo {
+    // Pointers to the base vector. Used to check if the current input's base
+    // vector is the same. If it's the same, then results can be cached.
+    std::weak_ptr<BaseVector> baseOfDictionaryWeakPtr;
+    BaseVector* baseOfDictionaryRawPtr = nullptr;
 
-  // This is a strong reference to the base vector and is only set if
-  // `baseOfDictionaryRepeats_` > 1. This is to ensure that the vector held is
-  // not modified and re-used in-place.
-  VectorPtr baseOfDictionary_;
+    // This is a strong reference to the base vector and is only set if
+    // 'baseOfDictionaryRepeats' > 1. This is to ensure that the vector held is
+    // not modified and re-used in-place.
+    VectorPtr baseOfDictionary;
 
-  // Number of times currently held cacheable vector is seen for a non-first
-  // time. Is reset everytime 'baseOfDictionaryRawPtr_' is different from the
-  // current input's base.
-  int baseOfDictionaryRepeats_ = 0;
+    // Number of times the base vector is seen for a non-first time.
+    int baseOfDictionaryRepeats = 0;
 
-  // Values computed for the base dictionary, 1:1 to the positions in
-  // 'baseOfDictionaryRawPtr_'.
-  VectorPtr dictionaryCache_;
+    // Values computed for the base dictionary, 1:1 to the positions in
+    // 'baseOfDictionaryRawPtr'.
+    VectorPtr dictionaryCache;
 
-  // The indices that are valid in 'dictionaryCache_'.
-  std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
+    // The indices that are valid in 'dictionaryCache'.
+    std::unique_ptr<SelectivityVector> cachedDictionaryIndices;
+  };
+
+  // Returns the memo for 'base' and makes it the most recently used one.
+  // Returns nullptr if there is none, after adding an empty memo for 'base'
+  // and evicting the least recently used memo if there are more than
+  // EvalCtx::maxDictionaryMemoEntries().
+  DictionaryMemo* findDictionaryMemo(const VectorPtr& base, EvalCtx& context);
+
+  // Memos for the most recently seen base vectors of cachable dictionary
+  // input, the most recently used last.
+  std::vector<DictionaryMemo> dictionaryMemos_;
 
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
@@ -737,6 +787,9 @@ class ExprSet {
   /// evaluated.
   std::unordered_map<std::string, exec::ExprStats> stats() const;
 
+  /// Returns the statistics of the nodes of the expression trees in pre-order.
+  std::vector<exec::ExprProfile> profile() const;
+
  protected:
   void clearSharedSubexprs();
 
@@ -799,6 +852,9 @@ struct ExprSetCompletionEvent {
   /// Aggregated runtime stats keyed on expression name (e.g. built-in
   /// expression like and, or, switch or a function name).
   std::unordered_map<std::string, exec::ExprStats> stats;
+  /// Runtime stats of each node of the expression trees. See
+  /// ExprSet::profile().
+  std::vector<exec::ExprProfile> profiles;
   /// List containing sql representation of each top level expression in ExprSet
   std::vector<std::string> sqls;
   // Query id corresponding query
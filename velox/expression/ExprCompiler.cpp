@@ -21,6 +21,7 @@
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -312,7 +313,9 @@ ExprPtr tryFoldIfConstant(const ExprPtr& expr, Scope* scope) {
       expr->eval(rows, context, result);
       auto constantVector = BaseVector::wrapInConstant(1, 0, result);
 
-      return std::make_shared<ConstantExpr>(constantVector);
+      auto folded = std::make_shared<ConstantExpr>(constantVector);
+      folded->setFolded();
+      return folded;
     }
     // Constant folding has a subtle gotcha: if folding a constant expression
     // deterministically throws, we can't throw at expression compilation time
@@ -347,6 +350,118 @@ std::vector<VectorPtr> getConstantInputs(const std::vector<ExprPtr>& exprs) {
   return constants;
 }
 
+enum class ConstantCondition { kTrue, kFalse, kNotConstant };
+
+// Returns kFalse for a constant null condition since CASE treats it as false.
+ConstantCondition toConstantCondition(const ExprPtr& expr) {
+  auto constant = std::dynamic_pointer_cast<ConstantExpr>(expr);
+  if (!constant || constant->type()->kind() != TypeKind::BOOLEAN) {
+    return ConstantCondition::kNotConstant;
+  }
+  const auto& value = constant->value();
+  if (value->isNullAt(0)) {
+    return ConstantCondition::kFalse;
+  }
+  return value->as<SimpleVector<bool>>()->valueAt(0)
+      ? ConstantCondition::kTrue
+      : ConstantCondition::kFalse;
+}
+
+bool isConstantNull(const ExprPtr& expr) {
+  auto constant = std::dynamic_pointer_cast<ConstantExpr>(expr);
+  return constant && constant->value()->isNullAt(0);
+}
+
+// Drops the branches of a SWITCH or IF with a constant false or null
+// condition and the branches after the first one with a constant true
+// condition. Returns the single remaining value or sets 'inputs' to the
+// remaining branches. Returns nullptr if nothing is dropped.
+ExprPtr simplifySwitch(
+    const TypePtr& type,
+    std::vector<ExprPtr>& inputs,
+    memory::MemoryPool* pool) {
+  const auto numCases = inputs.size() / 2;
+  std::vector<ExprPtr> remaining;
+  bool hasElse = inputs.size() % 2 == 1;
+  bool changed = false;
+  for (auto i = 0; i < numCases; ++i) {
+    auto condition = toConstantCondition(inputs[2 * i]);
+    if (condition == ConstantCondition::kFalse) {
+      changed = true;
+      continue;
+    }
+    if (condition == ConstantCondition::kTrue) {
+      // The 'then' value becomes the else clause.
+      remaining.push_back(inputs[2 * i + 1]);
+      changed = true;
+      hasElse = false;
+      break;
+    }
+    remaining.push_back(inputs[2 * i]);
+    remaining.push_back(inputs[2 * i + 1]);
+  }
+  if (!changed) {
+    return nullptr;
+  }
+  if (hasElse) {
+    remaining.push_back(inputs.back());
+  }
+  if (remaining.empty()) {
+    return std::make_shared<ConstantExpr>(
+        BaseVector::createNullConstant(type, 1, pool));
+  }
+  if (remaining.size() == 1) {
+    return *remaining[0]->type() == *type ? remaining[0] : nullptr;
+  }
+  inputs = std::move(remaining);
+  return nullptr;
+}
+
+// Drops constant null inputs of COALESCE and the inputs after the first
+// constant non-null one. Returns the single remaining input or sets 'inputs'
+// to the remaining ones. Returns nullptr if there is a choice left.
+ExprPtr simplifyCoalesce(
+    const TypePtr& type,
+    std::vector<ExprPtr>& inputs,
+    memory::MemoryPool* pool) {
+  std::vector<ExprPtr> remaining;
+  for (const auto& input : inputs) {
+    if (isConstantNull(input)) {
+      continue;
+    }
+    remaining.push_back(input);
+    if (input->is<ConstantExpr>()) {
+      break;
+    }
+  }
+  if (remaining.empty()) {
+    return std::make_shared<ConstantExpr>(
+        BaseVector::createNullConstant(type, 1, pool));
+  }
+  if (remaining.size() == 1) {
+    return *remaining[0]->type() == *type ? remaining[0] : nullptr;
+  }
+  inputs = std::move(remaining);
+  return nullptr;
+}
+
+// Simplifies a call with constant folded 'inputs'. Returns an expression
+// that replaces the call or nullptr if the call is kept. May remove inputs
+// that can never be evaluated.
+ExprPtr simplifyCall(
+    const std::string& name,
+    const TypePtr& type,
+    std::vector<ExprPtr>& inputs,
+    memory::MemoryPool* pool) {
+  if (name == "switch" || name == "if") {
+    return simplifySwitch(type, inputs, pool);
+  }
+  if (name == "coalesce") {
+    return simplifyCoalesce(type, inputs, pool);
+  }
+  return nullptr;
+}
+
 core::TypedExprPtr rewriteExpression(const core::TypedExprPtr& expr) {
   for (auto& rewrite : expressionRewrites()) {
     if (auto rewritten = rewrite(expr)) {
@@ -404,7 +519,14 @@ ExprPtr compileRewrittenExpression(
           trackCpuUsage);
     }
   } else if (auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
-    if (auto specialForm = specialFormRegistry().getSpecialForm(call->name())) {
+    ExprPtr simplified = enableConstantFolding
+        ? simplifyCall(call->name(), resultType, compiledInputs, pool)
+        : nullptr;
+    if (simplified) {
+      result = simplified;
+    } else if (
+        auto specialForm =
+            specialFormRegistry().getSpecialForm(call->name())) {
       result = specialForm->constructSpecialForm(
           resultType, std::move(compiledInputs), trackCpuUsage, config);
     } else if (
@@ -514,6 +636,9 @@ ExprPtr compileRewrittenExpression(
   auto folded = enableConstantFolding && !isConstantExpr
       ? tryFoldIfConstant(result, scope)
       : result;
+  if (config.exprFusionEnabled()) {
+    folded = FusedExpr::tryFuse(folded);
+  }
   scope->visited[expr.get()] = folded;
   return folded;
 }
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/type/Type.h"
+
+namespace facebook::velox::exec {
+
+/// Memoizes the resolution of function calls by function name and argument
+/// types, e.g. which signature of a function binds to the argument types.
+/// Lets the compilation of the expressions of every task of a query, and of
+/// identical queries, skip binding the signatures of a function again for the
+/// same argument types. The owner clears the cache when the functions it
+/// resolves change. Thread safe.
+template <typename T>
+class FunctionResolutionCache {
+ public:
+  /// Returns the result cached for 'name' and 'argTypes'. Calls 'resolve'
+  /// for the result and caches it if there is none.
+  template <typename Resolve>
+  T getOrResolve(
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes,
+      Resolve resolve) {
+    Key key{name, argTypes};
+    {
+      auto entries = entries_.rlock();
+      auto it = entries->find(key);
+      if (it != entries->end()) {
+        return it->second;
+      }
+    }
+    T result = resolve();
+    auto entries = entries_.wlock();
+    // Argument types with field names, e.g. rows, can make many distinct
+    // keys. Starts over instead of growing without bound.
+    if (entries->size() >= kMaxEntries) {
+      entries->clear();
+    }
+    entries->emplace(std::move(key), result);
+    return result;
+  }
+
+  void clear() {
+    entries_.wlock()->clear();
+  }
+
+  size_t size() const {
+    return entries_.rlock()->size();
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 10'000;
+
+  struct Key {
+    std::string name;
+    std::vector<TypePtr> argTypes;
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const {
+      size_t hash = folly::hasher<std::string>()(key.name);
+      for (const auto& type : key.argTypes) {
+        hash = folly::hash::hash_combine(hash, type->hashKind());
+      }
+      return hash;
+    }
+  };
+
+  struct KeyEqual {
+    bool operator()(const Key& left, const Key& right) const {
+      if (left.name != right.name ||
+          left.argTypes.size() != right.argTypes.size()) {
+        return false;
+      }
+      for (size_t i = 0; i < left.argTypes.size(); ++i) {
+        if (*left.argTypes[i] != *right.argTypes[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  folly::Synchronized<folly::F14FastMap<Key, T, KeyHasher, KeyEqual>>
+      entries_;
+};
+
+} // namespace facebook::velox::exec
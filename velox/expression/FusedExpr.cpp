@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/FusedExpr.h"
+
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FieldReference.h"
+
+namespace facebook::velox::exec {
+
+namespace detail {
+/// A node of a fused expression tree.
+class FusedNode {
+ public:
+  virtual ~FusedNode() = default;
+
+  /// Binds the columns of the batch being evaluated in 'context'. Returns
+  /// false if a column is not flat or may have nulls.
+  virtual bool bind(EvalCtx& context) = 0;
+};
+} // namespace detail
+
+namespace {
+
+using detail::FusedNode;
+
+// Number of rows evaluated by each node at a time. The intermediate results
+// of a few nodes fit in the L1 cache.
+constexpr vector_size_t kBlockSize = 256;
+
+template <typename T>
+class TypedNode : public FusedNode {
+ public:
+  // Returns the values for rows [begin, begin + size). The values are valid
+  // until the next call. Sets 'overflow' if an integer operation overflows.
+  virtual const T*
+  evaluate(vector_size_t begin, vector_size_t size, bool& overflow) = 0;
+};
+
+template <typename T>
+class FieldNode : public TypedNode<T> {
+ public:
+  explicit FieldNode(FieldReference* field) : field_(field) {}
+
+  bool bind(EvalCtx& context) override {
+    auto* vector = context.getField(field_->index(context))->loadedVector();
+    if (!vector->isFlatEncoding() || vector->mayHaveNulls()) {
+      return false;
+    }
+    values_ = vector->asUnchecked<FlatVector<T>>()->rawValues();
+    return true;
+  }
+
+  const T* evaluate(
+      vector_size_t begin,
+      vector_size_t /*size*/,
+      bool& /*overflow*/) override {
+    return values_ + begin;
+  }
+
+ private:
+  FieldReference* const field_;
+  const T* values_{nullptr};
+};
+
+template <typename T>
+class ConstantNode : public TypedNode<T> {
+ public:
+  explicit ConstantNode(T value) {
+    std::fill(values_.begin(), values_.end(), value);
+  }
+
+  bool bind(EvalCtx& /*context*/) override {
+    return true;
+  }
+
+  const T* evaluate(
+      vector_size_t /*begin*/,
+      vector_size_t /*size*/,
+      bool& /*overflow*/) override {
+    return values_.data();
+  }
+
+ private:
+  std::array<T, kBlockSize> values_;
+};
+
+// Applies 'Op' to the values of two nodes of type 'T'.
+template <typename T, typename TResult, typename Op>
+class CallNode : public TypedNode<TResult> {
+ public:
+  CallNode(
+      std::unique_ptr<TypedNode<T>> left,
+      std::unique_ptr<TypedNode<T>> right)
+      : left_(std::move(left)), right_(std::move(right)) {}
+
+  bool bind(EvalCtx& context) override {
+    return left_->bind(context) && right_->bind(context);
+  }
+
+  const TResult*
+  evaluate(vector_size_t begin, vector_size_t size, bool& overflow) override {
+    const auto* left = left_->evaluate(begin, size, overflow);
+    const auto* right = right_->evaluate(begin, size, overflow);
+    bool localOverflow = false;
+    for (auto i = 0; i < size; ++i) {
+      values_[i] = Op::apply(left[i], right[i], localOverflow);
+    }
+    overflow |= localOverflow;
+    return values_.data();
+  }
+
+ private:
+  const std::unique_ptr<TypedNode<T>> left_;
+  const std::unique_ptr<TypedNode<T>> right_;
+  std::array<TResult, kBlockSize> values_;
+};
+
+// The operations below match the Presto functions of the same name. Integer
+// overflow is reported to the caller, which then evaluates the interpreted
+// function to raise the error.
+struct Plus {
+  template <typename T>
+  static T apply(T a, T b, bool& overflow) {
+    if constexpr (std::is_integral_v<T>) {
+      T result;
+      overflow |= __builtin_add_overflow(a, b, &result);
+      return result;
+    } else {
+      return a + b;
+    }
+  }
+};
+
+struct Minus {
+  template <typename T>
+  static T apply(T a, T b, bool& overflow) {
+    if constexpr (std::is_integral_v<T>) {
+      T result;
+      overflow |= __builtin_sub_overflow(a, b, &result);
+      return result;
+    } else {
+      return a - b;
+    }
+  }
+};
+
+struct Multiply {
+  template <typename T>
+  static T apply(T a, T b, bool& overflow) {
+    if constexpr (std::is_integral_v<T>) {
+      T result;
+      overflow |= __builtin_mul_overflow(a, b, &result);
+      return result;
+    } else {
+      return a * b;
+    }
+  }
+};
+
+struct Divide {
+  template <typename T>
+  static T apply(T a, T b, bool& /*overflow*/)
+#if defined(__has_feature)
+#if __has_feature(__address_sanitizer__)
+      __attribute__((__no_sanitize__("float-divide-by-zero")))
+#endif
+#endif
+  {
+    static_assert(std::is_floating_point_v<T>);
+    return a / b;
+  }
+};
+
+#define VELOX_FUSED_COMPARISON(NAME, OP)              \
+  struct NAME {                                       \
+    template <typename T>                             \
+    static bool apply(T a, T b, bool& /*overflow*/) { \
+      return a OP b;                                  \
+    }                                                 \
+  };
+
+VELOX_FUSED_COMPARISON(Eq, ==)
+VELOX_FUSED_COMPARISON(Neq, !=)
+VELOX_FUSED_COMPARISON(Lt, <)
+VELOX_FUSED_COMPARISON(Lte, <=)
+VELOX_FUSED_COMPARISON(Gt, >)
+VELOX_FUSED_COMPARISON(Gte, >=)
+
+#undef VELOX_FUSED_COMPARISON
+
+template <typename T>
+bool isType(const TypePtr& type) {
+  return *type == *CppToType<T>::create();
+}
+
+// Returns the function name of 'expr' without the registration prefix, e.g.
+// 'plus' for 'presto.default.plus'.
+std::string_view functionName(const Expr& expr) {
+  std::string_view name = expr.name();
+  auto pos = name.rfind('.');
+  return pos == std::string_view::npos ? name : name.substr(pos + 1);
+}
+
+// Returns the interpreted tree of 'expr' if 'expr' is already fused.
+const ExprPtr& unwrap(const ExprPtr& expr) {
+  return expr->is<FusedExpr>() ? expr->inputs()[0] : expr;
+}
+
+bool isBinaryCall(const Expr& expr) {
+  return !expr.isSpecialForm() && expr.vectorFunction() != nullptr &&
+      expr.inputs().size() == 2;
+}
+
+template <typename T>
+std::unique_ptr<TypedNode<T>> makeNode(const ExprPtr& input, int32_t& numCalls);
+
+template <typename T, typename TResult, typename Op>
+std::unique_ptr<TypedNode<TResult>> makeCall(
+    const Expr& expr,
+    int32_t& numCalls) {
+  auto left = makeNode<T>(expr.inputs()[0], numCalls);
+  if (left == nullptr) {
+    return nullptr;
+  }
+  auto right = makeNode<T>(expr.inputs()[1], numCalls);
+  if (right == nullptr) {
+    return nullptr;
+  }
+  ++numCalls;
+  return std::make_unique<CallNode<T, TResult, Op>>(
+      std::move(left), std::move(right));
+}
+
+// Returns the fused tree for 'input' of type 'T' or nullptr if 'input' has an
+// expression that cannot be fused. Increments 'numCalls' for each function.
+template <typename T>
+std::unique_ptr<TypedNode<T>> makeNode(
+    const ExprPtr& input,
+    int32_t& numCalls) {
+  const auto& expr = unwrap(input);
+  if (!isType<T>(expr->type())) {
+    return nullptr;
+  }
+  if (auto* field = expr->as<FieldReference>()) {
+    if (!field->inputs().empty()) {
+      return nullptr;
+    }
+    return std::make_unique<FieldNode<T>>(field);
+  }
+  if (auto* constant = expr->as<ConstantExpr>()) {
+    const auto* value = constant->value()->as<SimpleVector<T>>();
+    if (value == nullptr || value->isNullAt(0)) {
+      return nullptr;
+    }
+    return std::make_unique<ConstantNode<T>>(value->valueAt(0));
+  }
+  if (!isBinaryCall(*expr)) {
+    return nullptr;
+  }
+  const auto name = functionName(*expr);
+  if (name == "plus") {
+    return makeCall<T, T, Plus>(*expr, numCalls);
+  }
+  if (name == "minus") {
+    return makeCall<T, T, Minus>(*expr, numCalls);
+  }
+  if (name == "multiply") {
+    return makeCall<T, T, Multiply>(*expr, numCalls);
+  }
+  if constexpr (std::is_floating_point_v<T>) {
+    if (name == "divide") {
+      return makeCall<T, T, Divide>(*expr, numCalls);
+    }
+  }
+  return nullptr;
+}
+
+template <typename T>
+std::unique_ptr<TypedNode<bool>> makeComparison(
+    const Expr& expr,
+    int32_t& numCalls) {
+  const auto name = functionName(expr);
+  if (name == "eq") {
+    return makeCall<T, bool, Eq>(expr, numCalls);
+  }
+  if (name == "neq") {
+    return makeCall<T, bool, Neq>(expr, numCalls);
+  }
+  if (name == "lt") {
+    return makeCall<T, bool, Lt>(expr, numCalls);
+  }
+  if (name == "lte") {
+    return makeCall<T, bool, Lte>(expr, numCalls);
+  }
+  if (name == "gt") {
+    return makeCall<T, bool, Gt>(expr, numCalls);
+  }
+  if (name == "gte") {
+    return makeCall<T, bool, Gte>(expr, numCalls);
+  }
+  return nullptr;
+}
+
+std::unique_ptr<FusedNode> makeRoot(const ExprPtr& expr, int32_t& numCalls) {
+  if (isType<int64_t>(expr->type())) {
+    return makeNode<int64_t>(expr, numCalls);
+  }
+  if (isType<double>(expr->type())) {
+    return makeNode<double>(expr, numCalls);
+  }
+  if (!isType<bool>(expr->type()) || !isBinaryCall(*expr)) {
+    return nullptr;
+  }
+  const auto& inputType = expr->inputs()[0]->type();
+  if (isType<int64_t>(inputType)) {
+    return makeComparison<int64_t>(*expr, numCalls);
+  }
+  if (isType<double>(inputType)) {
+    return makeComparison<double>(*expr, numCalls);
+  }
+  return nullptr;
+}
+} // namespace
+
+FusedExpr::FusedExpr(ExprPtr expr, std::unique_ptr<detail::FusedNode> root)
+    : SpecialForm(
+          expr->type(),
+          {expr},
+          "fused",
+          false /* supportsFlatNoNullsFastPath */,
+          false /* trackCpuUsage */),
+      root_(std::move(root)) {}
+
+FusedExpr::~FusedExpr() = default;
+
+// static
+ExprPtr FusedExpr::tryFuse(const ExprPtr& expr) {
+  if (expr->is<FusedExpr>() || !isBinaryCall(*expr)) {
+    return expr;
+  }
+  int32_t numCalls = 0;
+  auto root = makeRoot(expr, numCalls);
+  // A single call is evaluated as fast by the interpreter.
+  if (root == nullptr || numCalls < 2) {
+    return expr;
+  }
+  auto fused = std::shared_ptr<FusedExpr>(new FusedExpr(expr, std::move(root)));
+  fused->computeMetadata();
+  return fused;
+}
+
+template <typename T>
+bool FusedExpr::evalFused(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  context.ensureWritable(rows, type(), result);
+  auto* flatResult = result->asUnchecked<FlatVector<T>>();
+  flatResult->clearNulls(rows);
+  auto* root = static_cast<TypedNode<T>*>(root_.get());
+  const bool allSelected = rows.isAllSelected();
+  bool overflow = false;
+  for (auto begin = rows.begin(); begin < rows.end(); begin += kBlockSize) {
+    const auto size = std::min(kBlockSize, rows.end() - begin);
+    const auto* values = root->evaluate(begin, size, overflow);
+    if (overflow) {
+      return false;
+    }
+    if constexpr (std::is_same_v<T, bool>) {
+      bits::forEachSetBit(
+          rows.asRange().bits(), begin, begin + size, [&](auto row) {
+            flatResult->set(row, values[row - begin]);
+          });
+    } else if (allSelected) {
+      std::copy(values, values + size, flatResult->mutableRawValues() + begin);
+    } else {
+      auto* rawResult = flatResult->mutableRawValues();
+      bits::forEachSetBit(
+          rows.asRange().bits(), begin, begin + size, [&](auto row) {
+            rawResult[row] = values[row - begin];
+          });
+    }
+  }
+  return true;
+}
+
+void FusedExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  if (root_->bind(context)) {
+    bool fused;
+    if (isType<int64_t>(type())) {
+      fused = evalFused<int64_t>(rows, context, result);
+    } else if (isType<double>(type())) {
+      fused = evalFused<double>(rows, context, result);
+    } else {
+      fused = evalFused<bool>(rows, context, result);
+    }
+    if (fused) {
+      ++numFusedBatches_;
+      return;
+    }
+  }
+  inputs_[0]->eval(rows, context, result);
+}
+
+void FusedExpr::evalSpecialFormSimplified(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  inputs_[0]->evalSimplified(rows, context, result);
+}
+
+} // namespace facebook::velox::exec
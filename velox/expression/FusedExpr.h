@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+namespace detail {
+class FusedNode;
+} // namespace detail
+
+/// Evaluates a tree of arithmetic and comparison functions over BIGINT and
+/// DOUBLE columns and constants in one pass, without materializing a vector
+/// for each function call. The tree is instantiated from templates for each
+/// operation and evaluated over blocks of rows small enough for the
+/// intermediate results to stay in the L1 cache. Supports plus, minus,
+/// multiply, divide (DOUBLE only), eq, neq, lt, lte, gt and gte with Presto
+/// semantics.
+///
+/// The fused path is taken when all referenced columns are flat and have no
+/// nulls. Otherwise, or if an integer operation overflows, the rows are
+/// evaluated by the interpreted expression tree, which is the only input of
+/// this expression.
+class FusedExpr : public SpecialForm {
+ public:
+  /// Returns a FusedExpr for 'expr' if 'expr' is a call that can be fused
+  /// together with at least one of its inputs. Returns 'expr' otherwise.
+  static ExprPtr tryFuse(const ExprPtr& expr);
+
+  ~FusedExpr() override;
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  void evalSpecialFormSimplified(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  std::string toString(bool recursive = true) const override {
+    return inputs_[0]->toString(recursive);
+  }
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override {
+    return inputs_[0]->toSql(complexConstants);
+  }
+
+  /// Number of batches evaluated by the fused path.
+  uint64_t numFusedBatches() const {
+    return numFusedBatches_;
+  }
+
+ private:
+  FusedExpr(ExprPtr expr, std::unique_ptr<detail::FusedNode> root);
+
+  void computePropagatesNulls() override {
+    propagatesNulls_ = inputs_[0]->propagatesNulls();
+  }
+
+  // Evaluates 'rows' with the fused tree. Returns false if an integer
+  // operation overflows, in which case 'result' is partially written.
+  template <typename T>
+  bool evalFused(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
+  const std::unique_ptr<detail::FusedNode> root_;
+  uint64_t numFusedBatches_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -41,6 +41,15 @@ class ExprCallable : public Callable {
     return capture_->childrenSize() > signature_->size();
   }
 
+  bool hasNonConstantCapture() const override {
+    for (auto i = signature_->size(); i < capture_->childrenSize(); ++i) {
+      if (!capture_->childAt(i)->isConstantEncoding()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   void apply(
       const SelectivityVector& rows,
       const SelectivityVector* validRowsInReusedResult,
@@ -113,6 +122,8 @@ class ExprCallable : public Callable {
       if (wrapCapture) {
         values = BaseVector::wrapInDictionary(
             BufferPtr(nullptr), wrapCapture, size, values);
+      } else if (values->isConstantEncoding() && values->size() != size) {
+        values = BaseVector::wrapInConstant(size, 0, values);
       }
       allVectors.push_back(values);
     }
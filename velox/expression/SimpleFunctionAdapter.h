@@ -148,6 +148,23 @@ class SimpleFunctionAdapter : public VectorFunction {
     }() && ...);
   }
 
+  template <size_t... Is>
+  constexpr bool static allArgsBatchEligibleImpl(std::index_sequence<Is...>) {
+    return ([&]() {
+      if constexpr (isVariadicType<arg_at<Is>>::value) {
+        return false;
+      } else {
+        return isArgFlatConstantFastPathEligible<Is> &&
+            SimpleTypeTrait<arg_at<Is>>::isFixedWidth;
+      }
+    }() && ...);
+  }
+
+  /// True if the UDF provides callBatch(). Requires that the result and all
+  /// arguments are fixed-width primitives other than boolean, so that they
+  /// can be passed as ranges of flat values.
+  static constexpr bool batchCall = FUNC::udf_has_callBatch;
+
   /// When true, a fast path for each possible combination of encodings will be
   /// used for reading arguments when all arguments are flat or constant
   /// primitivies.
@@ -335,6 +352,17 @@ class SimpleFunctionAdapter : public VectorFunction {
       }
     }
 
+    if constexpr (batchCall) {
+      if (tryCallBatch(applyContext, args)) {
+        if (isResultReused) {
+          result = std::move(*reusableResult);
+        } else {
+          (*reusableResult)->clearNulls(rows);
+        }
+        return;
+      }
+    }
+
     // Enable fast all-ASCII path if all string inputs are ASCII and the
     // function provides ASCII-only path.
     if constexpr (FUNC::has_ascii) {
@@ -462,6 +490,49 @@ class SimpleFunctionAdapter : public VectorFunction {
   }
 
  private:
+  // Calls callBatch() once for all rows if all are selected and all arguments
+  // are flat without nulls. Returns false if the rows are to be evaluated one
+  // at a time, which is also the case if callBatch() throws so that errors are
+  // reported for the failing rows.
+  bool tryCallBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args) const {
+    static_assert(
+        fastPathIteration &&
+            return_type_traits::typeKind != TypeKind::BOOLEAN &&
+            allArgsBatchEligibleImpl(
+                std::make_index_sequence<FUNC::num_args>()),
+        "callBatch() requires fixed-width non-boolean primitive arguments and "
+        "result.");
+    if (!applyContext.rows->isAllSelected()) {
+      return false;
+    }
+    for (const auto& arg : args) {
+      if (!arg->isFlatEncoding() || arg->mayHaveNulls()) {
+        return false;
+      }
+    }
+    try {
+      callBatch(applyContext, args, std::make_index_sequence<FUNC::num_args>());
+    } catch (const std::exception&) {
+      return false;
+    }
+    return true;
+  }
+
+  template <size_t... Is>
+  void callBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args,
+      std::index_sequence<Is...>) const {
+    const auto size = applyContext.rows->end();
+    (*fn_).callBatch(
+        folly::Range<T*>(applyContext.result->mutableRawValues(), size),
+        folly::Range<const exec_arg_at<Is>*>(
+            args[Is]->asUnchecked<FlatVector<exec_arg_at<Is>>>()->rawValues(),
+            size)...);
+  }
+
   // This is called only when we know that all args are flat or constant and are
   // eligible for the optimization and the optimization is enabled.
   template <int32_t POSITION, typename... TReader>
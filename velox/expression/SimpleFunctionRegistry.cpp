@@ -60,6 +60,7 @@ void SimpleFunctionRegistry::registerFunctionInternal(
 
     functions.emplace_back(
         std::make_unique<const FunctionEntry>(metadata, factory));
+    resolvedFunctions_.clear();
   });
 }
 
@@ -137,62 +138,76 @@ bool physicalTypeMatches(const TypePtr& type, const TypePtr& physicalType) {
   return true;
 }
 
-} // namespace
-
-std::optional<SimpleFunctionRegistry::ResolvedSimpleFunction>
-SimpleFunctionRegistry::resolveFunction(
+// Returns the entry of the function 'name' registered in 'map' that best
+// matches 'argTypes' and its return type. Returns std::nullopt if none
+// matches.
+std::optional<std::pair<const FunctionEntry*, TypePtr>> resolveInMap(
+    const FunctionMap& map,
     const std::string& name,
-    const std::vector<TypePtr>& argTypes) const {
+    const std::vector<TypePtr>& argTypes) {
   const FunctionEntry* selectedCandidate = nullptr;
   TypePtr selectedCandidateType = nullptr;
-  registeredFunctions_.withRLock([&](const auto& map) {
-    if (const auto* signatureMap = getSignatureMap(name, map)) {
-      for (const auto& [candidateSignature, functionEntry] : *signatureMap) {
-        SignatureBinder binder(candidateSignature, argTypes);
-        if (binder.tryBind()) {
-          for (const auto& currentCandidate : functionEntry) {
-            const auto& m = currentCandidate->getMetadata();
-
-            // For variadic signatures, number of arguments in function call may
-            // be one less than number of arguments in the signature.
-            const auto numArgsToMatch =
-                std::min(argTypes.size(), m.argPhysicalTypes().size());
-
-            bool match = true;
-            for (auto i = 0; i < numArgsToMatch; ++i) {
-              if (!physicalTypeMatches(argTypes[i], m.argPhysicalTypes()[i])) {
-                match = false;
-                break;
-              }
+  if (const auto* signatureMap = getSignatureMap(name, map)) {
+    for (const auto& [candidateSignature, functionEntry] : *signatureMap) {
+      SignatureBinder binder(candidateSignature, argTypes);
+      if (binder.tryBind()) {
+        for (const auto& currentCandidate : functionEntry) {
+          const auto& m = currentCandidate->getMetadata();
+
+          // For variadic signatures, number of arguments in function call may
+          // be one less than number of arguments in the signature.
+          const auto numArgsToMatch =
+              std::min(argTypes.size(), m.argPhysicalTypes().size());
+
+          bool match = true;
+          for (auto i = 0; i < numArgsToMatch; ++i) {
+            if (!physicalTypeMatches(argTypes[i], m.argPhysicalTypes()[i])) {
+              match = false;
+              break;
             }
+          }
 
-            if (!match) {
-              continue;
-            }
+          if (!match) {
+            continue;
+          }
 
-            if (!selectedCandidate ||
-                currentCandidate->getMetadata().priority() <
-                    selectedCandidate->getMetadata().priority()) {
-              auto resultType = binder.tryResolveReturnType();
-              VELOX_CHECK_NOT_NULL(resultType);
+          if (!selectedCandidate ||
+              currentCandidate->getMetadata().priority() <
+                  selectedCandidate->getMetadata().priority()) {
+            auto resultType = binder.tryResolveReturnType();
+            VELOX_CHECK_NOT_NULL(resultType);
 
-              if (physicalTypeMatches(resultType, m.resultPhysicalType())) {
-                selectedCandidate = currentCandidate.get();
-                selectedCandidateType = resultType;
-              }
+            if (physicalTypeMatches(resultType, m.resultPhysicalType())) {
+              selectedCandidate = currentCandidate.get();
+              selectedCandidateType = resultType;
             }
           }
         }
       }
     }
-  });
+  }
 
   VELOX_DCHECK(!selectedCandidate || selectedCandidateType);
+  if (!selectedCandidate) {
+    return std::nullopt;
+  }
+  return std::make_pair(selectedCandidate, selectedCandidateType);
+}
 
-  return selectedCandidate
-      ? std::optional<ResolvedSimpleFunction>(
-            ResolvedSimpleFunction(*selectedCandidate, selectedCandidateType))
-      : std::nullopt;
+} // namespace
+
+std::optional<SimpleFunctionRegistry::ResolvedSimpleFunction>
+SimpleFunctionRegistry::resolveFunction(
+    const std::string& name,
+    const std::vector<TypePtr>& argTypes) const {
+  auto resolved = registeredFunctions_.withRLock([&](const auto& map) {
+    return resolvedFunctions_.getOrResolve(
+        name, argTypes, [&]() { return resolveInMap(map, name, argTypes); });
+  });
+  if (!resolved.has_value()) {
+    return std::nullopt;
+  }
+  return ResolvedSimpleFunction(*resolved->first, resolved->second);
 }
 
 } // namespace facebook::velox::exec
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/core/SimpleFunctionMetadata.h"
+#include "velox/expression/FunctionResolutionCache.h"
 #include "velox/expression/SignatureBinder.h"
 #include "velox/expression/SimpleFunctionAdapter.h"
 #include "velox/type/Type.h"
@@ -92,7 +93,10 @@ class SimpleFunctionRegistry {
   }
 
   void clearRegistry() {
-    registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+    registeredFunctions_.withWLock([&](auto& map) {
+      map.clear();
+      resolvedFunctions_.clear();
+    });
   }
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
@@ -148,6 +152,14 @@ class SimpleFunctionRegistry {
       const FunctionFactory& factory);
 
   folly::Synchronized<FunctionMap> registeredFunctions_;
+
+  // The function entries and return types resolved by resolveFunction(), or
+  // std::nullopt if no function matches. Read and written under a read lock
+  // of 'registeredFunctions_' and cleared under its write lock, so that the
+  // entries outlive their use here.
+  mutable FunctionResolutionCache<
+      std::optional<std::pair<const FunctionEntry*, TypePtr>>>
+      resolvedFunctions_;
 };
 
 const SimpleFunctionRegistry& simpleFunctions();
@@ -130,17 +130,23 @@ getVectorFunctionWithMetadata(
           -> std::optional<std::pair<
               std::shared_ptr<VectorFunction>,
               VectorFunctionMetadata>> {
-        for (const auto& signature : entry.signatures) {
-          exec::SignatureBinder binder(*signature, inputTypes);
-          if (binder.tryBind()) {
-            auto inputArgs = toVectorFunctionArgs(inputTypes, constantInputs);
-
-            return {
-                {entry.factory(sanitizedName, inputArgs, config),
-                 entry.metadata}};
-          }
+        const bool bound = entry.boundSignatures->getOrResolve(
+            sanitizedName, inputTypes, [&]() {
+              for (const auto& signature : entry.signatures) {
+                exec::SignatureBinder binder(*signature, inputTypes);
+                if (binder.tryBind()) {
+                  return true;
+                }
+              }
+              return false;
+            });
+        if (!bound) {
+          return std::nullopt;
         }
-        return std::nullopt;
+        auto inputArgs = toVectorFunctionArgs(inputTypes, constantInputs);
+        return {
+            {entry.factory(sanitizedName, inputArgs, config),
+             entry.metadata}};
       });
 }
 
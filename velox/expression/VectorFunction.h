@@ -20,6 +20,7 @@
 #include "velox/core/Expressions.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/FunctionMetadata.h"
+#include "velox/expression/FunctionResolutionCache.h"
 #include "velox/expression/FunctionSignature.h"
 #include "velox/vector/SelectivityVector.h"
 #include "velox/vector/SimpleVector.h"
@@ -233,6 +234,10 @@ struct VectorFunctionEntry {
   std::vector<FunctionSignaturePtr> signatures;
   VectorFunctionFactory factory;
   VectorFunctionMetadata metadata;
+  // Whether any of 'signatures' binds to the argument types. Dropped with the
+  // entry when the function is registered again.
+  std::shared_ptr<FunctionResolutionCache<bool>> boundSignatures{
+      std::make_shared<FunctionResolutionCache<bool>>()};
 };
 
 // TODO: Use folly::Singleton here
@@ -333,4 +333,71 @@ TEST_F(ExprCompilerTest, lambdaExpr) {
   ASSERT_EQ(distinctFields.size(), 2);
 }
 
+TEST_F(ExprCompilerTest, simplifyConditionals) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+
+  // The branches with constant false or null conditions are dropped.
+  auto exprSet = compile(makeTypedExpr(
+      "case when 1 > 2 then c0 when null::boolean then c1 "
+      "when c0 > 5 then c1 else c0 + 1 end",
+      rowType));
+  ASSERT_EQ(
+      "switch(gt(c0, 5:BIGINT), c1, plus(c0, 1:BIGINT))",
+      exprSet->toString());
+
+  // The first branch with a constant true condition is the result.
+  exprSet = compile(makeTypedExpr(
+      "case when c0 > 5 then c1 when 1 < 2 then c0 else c1 + 1 end", rowType));
+  ASSERT_EQ("switch(gt(c0, 5:BIGINT), c1, c0)", exprSet->toString());
+  exprSet = compile(makeTypedExpr("if(2 > 1, c0, c1)", rowType));
+  ASSERT_TRUE(dynamic_cast<const FieldReference*>(exprSet->expr(0).get()));
+  exprSet = compile(makeTypedExpr(
+      "case when 1 > 2 then c0 when null::boolean then c1 end", rowType));
+  ASSERT_TRUE(exprSet->expr(0)->isConstant());
+
+  // Coalesce stops at the first constant non-null input.
+  exprSet = compile(
+      makeTypedExpr("coalesce(c0, null::bigint, 1 + 2, c1)", rowType));
+  ASSERT_EQ("coalesce(c0, 3:BIGINT)", exprSet->toString());
+  exprSet = compile(makeTypedExpr("coalesce(null::bigint, c1)", rowType));
+  ASSERT_TRUE(dynamic_cast<const FieldReference*>(exprSet->expr(0).get()));
+
+  // Constant folding disabled keeps the expressions as is.
+  auto expression = makeTypedExpr("if(2 > 1, c0, c1)", rowType);
+  exprSet = std::make_unique<ExprSet>(
+      std::vector<core::TypedExprPtr>{expression},
+      execCtx_.get(),
+      /*enableConstantFolding=*/false);
+  ASSERT_EQ("switch(gt(2:BIGINT, 1:BIGINT), c0, c1)", exprSet->toString());
+}
+
+TEST_F(ExprCompilerTest, orOfEqualsToIn) {
+  auto rowType = ROW({"a", "b"}, {BIGINT(), VARCHAR()});
+  auto field = makeField(rowType);
+
+  auto expression = orCall(
+      orCall(
+          call("eq", {field("a"), bigint(1)}),
+          call("eq", {field("b"), varchar("x")})),
+      orCall(
+          call("eq", {bigint(7), field("a")}),
+          call("eq", {field("b"), varchar("y")})));
+  auto exprSet = compile(expression);
+  auto* expr = exprSet->expr(0).get();
+  ASSERT_EQ("or", expr->name());
+  ASSERT_EQ(2, expr->inputs().size());
+  for (auto i = 0; i < 2; ++i) {
+    ASSERT_EQ("in", expr->inputs()[i]->name());
+  }
+  ASSERT_EQ("a", expr->inputs()[0]->inputs()[0]->toString());
+  ASSERT_EQ("b", expr->inputs()[1]->inputs()[0]->toString());
+
+  // A single equality on a column is kept.
+  expression = orCall(
+      call("eq", {field("a"), bigint(1)}),
+      call("eq", {field("b"), varchar("x")}));
+  ASSERT_EQ(
+      "or(eq(a, 1:BIGINT), eq(b, x:VARCHAR))", compile(expression)->toString());
+}
+
 } // namespace facebook::velox::exec::test
@@ -153,6 +153,7 @@ TEST_F(ExprStatsTest, printWithStats) {
 struct Event {
   std::string uuid;
   std::unordered_map<std::string, exec::ExprStats> stats;
+  std::vector<exec::ExprProfile> profiles;
   std::vector<std::string> sqls;
 };
 
@@ -166,7 +167,7 @@ class TestListener : public exec::ExprSetListener {
   void onCompletion(
       const std::string& uuid,
       const exec::ExprSetCompletionEvent& event) override {
-    events_.push_back({uuid, event.stats, event.sqls});
+    events_.push_back({uuid, event.stats, event.profiles, event.sqls});
   }
 
   void onError(
@@ -457,3 +458,70 @@ TEST_F(ExprStatsTest, exceptionPreparingStatsForListener) {
   evaluate(*exprSet, makeRowVector({varbinaryData}));
   ASSERT_TRUE(exec::unregisterExprSetListener(listener));
 }
+
+TEST_F(ExprStatsTest, profile) {
+  vector_size_t size = 1'024;
+
+  std::vector<Event> events;
+  std::vector<std::string> exceptions;
+  auto listener = std::make_shared<TestListener>(events, exceptions);
+  ASSERT_TRUE(exec::registerExprSetListener(listener));
+
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      wrapInDictionary(
+          makeIndicesInReverse(size),
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 7; })),
+  });
+  {
+    auto exprSet = compileExpressions(
+        {"c0 + cast(1 + 2 as bigint)", "c1 * 2", "c0 * 3"},
+        asRowType(data->type()));
+    evaluate(*exprSet, data);
+  }
+  ASSERT_TRUE(exec::unregisterExprSetListener(listener));
+
+  ASSERT_EQ(1, events.size());
+  const auto& profiles = events.back().profiles;
+  std::vector<std::string> names;
+  for (const auto& profile : profiles) {
+    names.push_back(profile.name);
+  }
+  ASSERT_EQ(
+      std::vector<std::string>(
+          {"plus",
+           "c0",
+           "literal",
+           "multiply",
+           "c1",
+           "literal",
+           "multiply",
+           "c0",
+           "literal"}),
+      names);
+
+  // c0 + 3 on a flat input with no nulls and a folded constant.
+  const auto& plus = profiles[0];
+  ASSERT_EQ(0, plus.exprIndex);
+  ASSERT_EQ(-1, plus.parent);
+  ASSERT_EQ(size, plus.stats.numProcessedRows);
+  ASSERT_EQ(2, plus.stats.numInputVectors);
+  ASSERT_EQ(2, plus.stats.numFlatNoNullsInputVectors);
+  ASSERT_EQ(0, plus.stats.numPeeledVectors);
+  ASSERT_EQ(0, profiles[1].parent);
+  ASSERT_TRUE(profiles[2].constantFolded);
+
+  // c1 * 2 is evaluated on the peeled base vector of the dictionary.
+  const auto& multiply = profiles[3];
+  ASSERT_EQ(1, multiply.exprIndex);
+  ASSERT_EQ(-1, multiply.parent);
+  ASSERT_EQ(1, multiply.stats.numPeeledVectors);
+  ASSERT_EQ(2, multiply.stats.numFlatNoNullsInputVectors);
+  ASSERT_FALSE(profiles[5].constantFolded);
+
+  // The common sub-expression c0 is reported once.
+  ASSERT_EQ(6, profiles[7].parent);
+  ASSERT_EQ(1, profiles[7].commonSubexpressionOf);
+  ASSERT_EQ(0, profiles[7].stats.numProcessedRows);
+  ASSERT_EQ(-1, profiles[8].commonSubexpressionOf);
+}
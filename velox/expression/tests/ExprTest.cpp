@@ -29,6 +29,7 @@
 #include "velox/expression/CoalesceExpr.h"
 #include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FusedExpr.h"
 #include "velox/expression/SwitchExpr.h"
 #include "velox/functions/Udf.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
@@ -450,6 +451,34 @@ TEST_P(ParameterizedExprTest, reorder) {
   }
 }
 
+TEST_F(ExprTest, reorderAdapts) {
+  constexpr int32_t kSize = 10'000;
+  auto makeData = [&](int64_t c0, int64_t c1) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(kSize, [&](auto /*row*/) { return c0; }),
+        makeFlatVector<int64_t>(kSize, [&](auto /*row*/) { return c1; }),
+    });
+  };
+  auto exprSet = compileExpression(
+      "c0 = 0 and c1 = 0", ROW({"c0", "c1"}, {BIGINT(), BIGINT()}));
+  auto condition = exprSet->expr(0)->as<exec::ConjunctExpr>();
+  ASSERT_NE(condition, nullptr);
+
+  // 'c1 = 0' drops all rows and 'c0 = 0' none. The second input goes first.
+  auto data = makeData(0, 1);
+  for (auto i = 0; i < 4; ++i) {
+    evaluate(exprSet.get(), data);
+  }
+  ASSERT_EQ(condition->inputOrder(), std::vector<int32_t>({1, 0}));
+
+  // The selectivities are swapped. The first input goes first again.
+  data = makeData(1, 0);
+  for (auto i = 0; i < 32; ++i) {
+    evaluate(exprSet.get(), data);
+  }
+  ASSERT_EQ(condition->inputOrder(), std::vector<int32_t>({0, 1}));
+}
+
 TEST_P(ParameterizedExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -2131,6 +2160,123 @@ TEST_F(ExprTest, memo) {
   VELOX_CHECK(base.unique());
 }
 
+TEST_F(ExprTest, memoMultipleBases) {
+  // Verify that with 'max_dictionary_memo_entries' > 1, results stay memoized
+  // for several bases when batches over them alternate.
+  auto makeBase = [&]() {
+    return makeFlatVector<int64_t>(1'000, [](auto row) { return row; });
+  };
+  auto indices = makeIndices(100, [](auto row) { return row * 3; });
+  auto expectedResult =
+      makeFlatVector<bool>(100, [](auto row) { return (row * 3) % 7 == 1; });
+
+  for (const auto maxEntries : {1, 2}) {
+    SCOPED_TRACE(fmt::format("maxEntries: {}", maxEntries));
+    queryCtx_ = std::make_shared<core::QueryCtx>(
+        nullptr,
+        core::QueryConfig({{core::QueryConfig::kMaxDictionaryMemoEntries,
+                            std::to_string(maxEntries)}}));
+    execCtx_ = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx_.get());
+    auto exprSet = compileExpression("c0 % 7 = 1", ROW({"c0"}, {BIGINT()}));
+    std::vector<VectorPtr> bases = {makeBase(), makeBase()};
+
+    // The second batch over each base caches its results.
+    uint64_t expectedRows = 0;
+    for (const auto& base : bases) {
+      for (auto i = 0; i < 2; ++i) {
+        auto [result, stats] = evaluateWithStats(
+            exprSet.get(),
+            makeRowVector({wrapInDictionary(indices, 100, base)}));
+        assertEqualVectors(expectedResult, result);
+        expectedRows += 100;
+        ASSERT_EQ(stats["eq"].numProcessedRows, expectedRows);
+      }
+    }
+
+    // Batches over the first base again. With a single entry the memo of the
+    // first base was evicted and the first two batches are evaluated again.
+    for (auto i = 0; i < 3; ++i) {
+      auto [result, stats] = evaluateWithStats(
+          exprSet.get(),
+          makeRowVector({wrapInDictionary(indices, 100, bases[0])}));
+      assertEqualVectors(expectedResult, result);
+      if (maxEntries == 1 && i < 2) {
+        expectedRows += 100;
+      }
+      ASSERT_EQ(stats["eq"].numProcessedRows, expectedRows);
+    }
+  }
+}
+
+TEST_F(ExprTest, fusedArithmetic) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row - 500; }),
+      makeFlatVector<double>(1'000, [](auto row) { return row * 0.25; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 17; }),
+  });
+  auto rowType = asRowType(data->type());
+  std::vector<std::string> expressions = {
+      "c0 * 3 + c2 - 1",
+      "c1 * 2.5 / (c1 - 10.0)",
+      "c0 + c2 > c2 * 2",
+      "c1 * c1 <= c1 + 100.0",
+  };
+
+  std::vector<std::unique_ptr<exec::ExprSet>> interpreted;
+  for (const auto& text : expressions) {
+    interpreted.push_back(compileExpression(text, rowType));
+    ASSERT_FALSE(interpreted.back()->expr(0)->is<exec::FusedExpr>());
+  }
+
+  queryCtx_ = std::make_shared<core::QueryCtx>(
+      nullptr,
+      core::QueryConfig({{core::QueryConfig::kExprFusionEnabled, "true"}}));
+  execCtx_ = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx_.get());
+
+  // A single call is not fused.
+  ASSERT_FALSE(compileExpression("c0 + c2", rowType)
+                   ->expr(0)
+                   ->is<exec::FusedExpr>());
+
+  auto dataWithNulls = makeRowVector({
+      makeFlatVector<int64_t>(
+          1'000, [](auto row) { return row; }, nullEvery(7)),
+      makeFlatVector<double>(
+          1'000, [](auto row) { return row * 0.25; }, nullEvery(11)),
+      data->childAt(2),
+  });
+  for (auto i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]);
+    auto exprSet = compileExpression(expressions[i], rowType);
+    auto* fused = exprSet->expr(0)->as<exec::FusedExpr>();
+    ASSERT_NE(fused, nullptr);
+    ASSERT_EQ(exprSet->toString(), interpreted[i]->toString());
+
+    assertEqualVectors(
+        evaluate(interpreted[i].get(), data), evaluate(exprSet.get(), data));
+    ASSERT_EQ(fused->numFusedBatches(), 1);
+
+    // Inputs with nulls are evaluated by the interpreter.
+    assertEqualVectors(
+        evaluate(interpreted[i].get(), dataWithNulls),
+        evaluate(exprSet.get(), dataWithNulls));
+    ASSERT_EQ(fused->numFusedBatches(), 1);
+  }
+
+  // Integer overflow falls back to the interpreter, which raises the error.
+  auto overflow = makeRowVector({
+      makeFlatVector<int64_t>({1, std::numeric_limits<int64_t>::max()}),
+      makeFlatVector<double>({1.0, 2.0}),
+      makeFlatVector<int64_t>({2, 3}),
+  });
+  auto exprSet = compileExpression(expressions[0], rowType);
+  VELOX_ASSERT_THROW(evaluate(exprSet.get(), overflow), "overflow");
+  exprSet = compileExpression("try(c0 * 3 + c2 - 1)", rowType);
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({4, std::nullopt}),
+      evaluate(exprSet.get(), overflow));
+}
+
 // This test triggers the situation when peelEncodings() produces an empty
 // selectivity vector, which if passed to evalWithMemo() causes the latter to
 // produce null Expr::dictionaryCache_, which leads to a crash in evaluation
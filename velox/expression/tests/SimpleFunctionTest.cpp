@@ -21,6 +21,7 @@
 #include <glog/logging.h>
 #include "folly/lang/Hint.h"
 #include "gtest/gtest.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/SimpleFunctionAdapter.h"
 #include "velox/functions/Udf.h"
@@ -1244,6 +1245,78 @@ TEST_F(SimpleFunctionTest, flatNoNullsPathCallNullFree) {
   testCallNullFreeSupportFlatNotNulls<Varchar, Varchar>(false, false);
 }
 
+int32_t numBatchCalls = 0;
+
+template <typename T>
+struct BatchDivideFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  void call(int64_t& out, const int64_t& a, const int32_t& b) {
+    VELOX_USER_CHECK_NE(b, 0, "Division by zero");
+    out = a / b;
+  }
+
+  void callBatch(
+      folly::Range<int64_t*> out,
+      folly::Range<const int64_t*> a,
+      folly::Range<const int32_t*> b) {
+    ++numBatchCalls;
+    for (auto i = 0; i < out.size(); ++i) {
+      VELOX_USER_CHECK_NE(b[i], 0, "Division by zero");
+      out[i] = a[i] / b[i];
+    }
+  }
+};
+
+TEST_F(SimpleFunctionTest, callBatch) {
+  registerFunction<BatchDivideFunction, int64_t, int64_t, int32_t>(
+      {"batch_divide"});
+
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row * 7; }),
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 5 + 1; }),
+  });
+  auto expected = makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row * 7 / (row % 5 + 1); });
+  numBatchCalls = 0;
+  assertEqualVectors(expected, evaluate("batch_divide(c0, c1)", data));
+  EXPECT_EQ(1, numBatchCalls);
+
+  // Rows that are not all selected, a constant argument and nulls are
+  // evaluated one row at a time.
+  numBatchCalls = 0;
+  const auto* conditional =
+      "if(c0 % 2 = 1, batch_divide(c0, c1), cast(null as bigint))";
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          1'000,
+          [](auto row) { return row * 7 / (row % 5 + 1); },
+          [](auto row) { return row % 2 == 0; }),
+      evaluate(conditional, data));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row * 7 / 2; }),
+      evaluate("batch_divide(c0, cast(2 as integer))", data));
+  auto withNulls = makeRowVector({
+      makeNullableFlatVector<int64_t>({10, std::nullopt, 30}),
+      makeFlatVector<int32_t>({2, 3, 5}),
+  });
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({5, std::nullopt, 6}),
+      evaluate("batch_divide(c0, c1)", withNulls));
+  EXPECT_EQ(0, numBatchCalls);
+
+  // An error in callBatch() is reported for the failing rows only.
+  auto withZero = makeRowVector({
+      makeFlatVector<int64_t>({10, 20, 30}),
+      makeFlatVector<int32_t>({2, 0, 5}),
+  });
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({5, std::nullopt, 6}),
+      evaluate("try(batch_divide(c0, c1))", withZero));
+  VELOX_ASSERT_THROW(
+      evaluate("batch_divide(c0, c1)", withZero), "Division by zero");
+}
+
 template <typename T>
 struct ConstantArgumentFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
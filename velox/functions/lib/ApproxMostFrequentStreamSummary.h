@@ -47,6 +47,23 @@ struct ApproxMostFrequentStreamSummary {
   /// Add one or multiple new values to the summary.
   void insert(T value, int64_t count = 1);
 
+  /// Add 'numValues' values with their counts, e.g. the values of a batch
+  /// pre-aggregated by value or another summary. The counts of values already
+  /// tracked are added before new values replace the ones with least hits, and
+  /// the heap is rebuilt once instead of being adjusted for each value.
+  /// 'copyValue' is applied to each value that starts being tracked, e.g. to
+  /// copy strings to memory owned by the caller.
+  template <typename CopyValue>
+  void insert(
+      const T* values,
+      const int64_t* counts,
+      int numValues,
+      CopyValue copyValue);
+
+  void insert(const T* values, const int64_t* counts, int numValues) {
+    insert(values, counts, numValues, [](T value) { return value; });
+  }
+
   /// Get the top `k` frequent elements with their estimated counts, sorted from
   /// most hits to least hits.
   std::vector<std::pair<T, int64_t>> topK(int k) const;
@@ -87,9 +104,16 @@ struct ApproxMostFrequentStreamSummary {
   using RebindAlloc =
       typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
 
+  template <typename CopyValue>
+  void insertOne(T value, int64_t count, CopyValue& copyValue);
+
+  // Appends an untracked value. The caller restores the heap order.
+  void append(T value, int64_t count);
+
   int heapCompare(int i, int j) const;
   void percolateUp(int position);
   void percolateDown(int position);
+  void rebuildHeap();
 
   int capacity() const {
     return capacity_;
@@ -155,6 +179,71 @@ int ApproxMostFrequentStreamSummary<T, A>::heapCompare(int i, int j) const {
 
 template <typename T, typename A>
 void ApproxMostFrequentStreamSummary<T, A>::insert(T value, int64_t count) {
+  auto noCopy = [](T v) { return v; };
+  insertOne(value, count, noCopy);
+}
+
+template <typename T, typename A>
+template <typename CopyValue>
+void ApproxMostFrequentStreamSummary<T, A>::insert(
+    const T* values,
+    const int64_t* counts,
+    int numValues,
+    CopyValue copyValue) {
+  if (numValues * 16 < size()) {
+    // Adjusting the heap per value is cheaper than rebuilding it.
+    for (int j = 0; j < numValues; ++j) {
+      insertOne(values[j], counts[j], copyValue);
+    }
+    return;
+  }
+  bool heapChanged = false;
+  std::vector<int> untracked;
+  for (int j = 0; j < numValues; ++j) {
+    if (auto it = indices_.find(values[j]); it != indices_.end()) {
+      int i = it->second;
+      counts_[i] += counts[j];
+      generations_[i] = ++currentGeneration_;
+      heapChanged = true;
+    } else if (size() < capacity()) {
+      append(copyValue(values[j]), counts[j]);
+      heapChanged = true;
+    } else {
+      untracked.push_back(j);
+    }
+  }
+  if (heapChanged) {
+    rebuildHeap();
+  }
+  for (auto j : untracked) {
+    insertOne(values[j], counts[j], copyValue);
+  }
+}
+
+template <typename T, typename A>
+void ApproxMostFrequentStreamSummary<T, A>::append(T value, int64_t count) {
+  int i = size();
+  values_.push_back(value);
+  counts_.push_back(count);
+  generations_.push_back(++currentGeneration_);
+  indices_.emplace(value, i);
+  heapIndices_.push_back(i);
+  heap_.push_back(i);
+}
+
+template <typename T, typename A>
+void ApproxMostFrequentStreamSummary<T, A>::rebuildHeap() {
+  for (int pos = size() / 2 - 1; pos >= 0; --pos) {
+    percolateDown(pos);
+  }
+}
+
+template <typename T, typename A>
+template <typename CopyValue>
+void ApproxMostFrequentStreamSummary<T, A>::insertOne(
+    T value,
+    int64_t count,
+    CopyValue& copyValue) {
   if (auto it = indices_.find(value); it != indices_.end()) {
     // The value to be counted is currently being tracked, we just need to
     // increase the counter.
@@ -167,12 +256,7 @@ void ApproxMostFrequentStreamSummary<T, A>::insert(T value, int64_t count) {
   if (size() < capacity()) {
     // There is still room available, just insert the value.
     int i = size();
-    values_.push_back(value);
-    counts_.push_back(count);
-    generations_.push_back(++currentGeneration_);
-    indices_.emplace(value, i);
-    heapIndices_.push_back(i);
-    heap_.push_back(i);
+    append(copyValue(value), count);
     percolateUp(i);
     return;
   }
@@ -180,6 +264,7 @@ void ApproxMostFrequentStreamSummary<T, A>::insert(T value, int64_t count) {
   VELOX_DCHECK(!heap_.empty());
   int i = heap_[0];
   indices_.erase(values_[i]);
+  value = copyValue(value);
   values_[i] = value;
   counts_[i] += count;
   generations_[i] = ++currentGeneration_;
@@ -320,16 +405,16 @@ void ApproxMostFrequentStreamSummary<T, A>::mergeSerialized(const char* other) {
   auto counts = reinterpret_cast<const int64_t*>(other);
   if constexpr (std::is_same_v<T, StringView>) {
     other += sizeof(int64_t) * size;
-  }
-  for (int i = 0; i < size; ++i) {
-    auto v = values[i];
-    if constexpr (std::is_same_v<T, StringView>) {
+    std::vector<StringView> strings(values, values + size);
+    for (auto& v : strings) {
       if (!v.isInline()) {
         v = {other, static_cast<int32_t>(v.size())};
         other += v.size();
       }
     }
-    insert(v, counts[i]);
+    insert(strings.data(), counts, size);
+  } else {
+    insert(values, counts, size);
   }
 }
 
@@ -19,6 +19,7 @@
 #include <velox/common/base/Exceptions.h>
 #include <charconv>
 #include <cstring>
+#include <limits>
 #include <stdexcept>
 #include "velox/common/base/CountBits.h"
 #include "velox/external/date/date.h"
@@ -953,6 +954,189 @@ int32_t parseFromPattern(
 
 } // namespace
 
+void DateTimeFormatter::initializeFixedWidth() {
+  std::vector<FixedWidthField> fields;
+  std::string layout;
+  bool hasYear = false;
+  for (const auto& token : tokens_) {
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      // A digit in a literal would change how the general parser splits the
+      // fields.
+      for (auto c : token.literal) {
+        if (characterIsDigit(c)) {
+          return;
+        }
+      }
+      layout.append(token.literal);
+      continue;
+    }
+    size_t width;
+    switch (token.pattern.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+      case DateTimeFormatSpecifier::YEAR_OF_ERA:
+        hasYear = true;
+        width = 4;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        width = 2;
+        break;
+      default:
+        return;
+    }
+    if (token.pattern.minRepresentDigits != width) {
+      return;
+    }
+    for (const auto& field : fields) {
+      if (field.specifier == token.pattern.specifier) {
+        return;
+      }
+    }
+    fields.push_back(
+        {token.pattern.specifier,
+         static_cast<uint8_t>(layout.size()),
+         static_cast<uint8_t>(width)});
+    layout.append(width, '0');
+  }
+  // Without a year the general parser defaults the year depending on the
+  // other fields.
+  if (!hasYear || layout.size() > std::numeric_limits<uint8_t>::max()) {
+    return;
+  }
+  fixedWidthIsDigit_.assign(layout.size(), false);
+  for (const auto& field : fields) {
+    std::fill_n(
+        fixedWidthIsDigit_.begin() + field.offset, field.width, true);
+  }
+  fixedWidthFields_ = std::move(fields);
+  fixedWidthTemplate_ = std::move(layout);
+}
+
+std::optional<DateTimeResult> DateTimeFormatter::tryParseFixedWidth(
+    const std::string_view& input) const {
+  const auto size = fixedWidthTemplate_.size();
+  if (input.size() != size) {
+    return std::nullopt;
+  }
+  bool matches = true;
+  for (auto i = 0; i < size; ++i) {
+    matches &= fixedWidthIsDigit_[i] ? characterIsDigit(input[i])
+                                     : input[i] == fixedWidthTemplate_[i];
+  }
+  if (!matches) {
+    return std::nullopt;
+  }
+
+  int32_t year = 0;
+  int32_t month = 1;
+  int32_t day = 1;
+  int32_t hour = 0;
+  int32_t minute = 0;
+  int32_t second = 0;
+  for (const auto& field : fixedWidthFields_) {
+    int32_t number = 0;
+    for (auto i = field.offset; i < field.offset + field.width; ++i) {
+      number = number * 10 + (input[i] - '0');
+    }
+    switch (field.specifier) {
+      case DateTimeFormatSpecifier::YEAR_OF_ERA:
+        if (number < 1) {
+          return std::nullopt;
+        }
+        year = number;
+        break;
+      case DateTimeFormatSpecifier::YEAR:
+        year = number;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        month = number;
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        day = number;
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        hour = number;
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        minute = number;
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        second = number;
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  if (month < 1 || month > 12 || hour > 23 || minute > 59 || second > 59 ||
+      !util::isValidDate(year, month, day)) {
+    return std::nullopt;
+  }
+  int64_t daysSinceEpoch;
+  if (!util::daysSinceEpochFromDate(year, month, day, daysSinceEpoch).ok()) {
+    return std::nullopt;
+  }
+  return DateTimeResult{
+      util::fromDatetime(
+          daysSinceEpoch, util::fromTime(hour, minute, second, 0)),
+      -1};
+}
+
+int32_t DateTimeFormatter::tryFormatFixedWidth(
+    const Timestamp& timestamp,
+    char* result) const {
+  // 0001-01-01 and 10000-01-01 in seconds since epoch.
+  static constexpr int64_t kMinSeconds = -62'135'596'800;
+  static constexpr int64_t kMaxSeconds = 253'402'300'800;
+  const auto seconds = timestamp.getSeconds();
+  if (seconds < kMinSeconds || seconds >= kMaxSeconds) {
+    return 0;
+  }
+  constexpr int64_t kSecondsInDay = 86'400;
+  auto days = seconds / kSecondsInDay;
+  auto secondsInDay = seconds % kSecondsInDay;
+  if (secondsInDay < 0) {
+    --days;
+    secondsInDay += kSecondsInDay;
+  }
+  const date::year_month_day calDate{date::sys_days{date::days{days}}};
+
+  std::memcpy(result, fixedWidthTemplate_.data(), fixedWidthTemplate_.size());
+  for (const auto& field : fixedWidthFields_) {
+    int32_t number;
+    switch (field.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+      case DateTimeFormatSpecifier::YEAR_OF_ERA:
+        number = static_cast<signed>(calDate.year());
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        number = static_cast<unsigned>(calDate.month());
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        number = static_cast<unsigned>(calDate.day());
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        number = secondsInDay / 3'600;
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        number = secondsInDay / 60 % 60;
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        number = secondsInDay % 60;
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    for (auto i = field.offset + field.width - 1; i >= field.offset; --i) {
+      result[i] = '0' + number % 10;
+      number /= 10;
+    }
+  }
+  return fixedWidthTemplate_.size();
+}
+
 uint32_t DateTimeFormatter::maxResultSize(
     const date::time_zone* timezone) const {
   uint32_t size = 0;
@@ -1034,6 +1218,11 @@ int32_t DateTimeFormatter::format(
   if (timezone != nullptr) {
     t.toTimezone(*timezone);
   }
+  if (isFixedWidth()) {
+    if (const auto size = tryFormatFixedWidth(t, result)) {
+      return size;
+    }
+  }
   const auto timePoint = t.toTimePoint(allowOverflow);
   const auto daysTimePoint = date::floor<date::days>(timePoint);
 
@@ -1268,6 +1457,12 @@ int32_t DateTimeFormatter::format(
 std::optional<DateTimeResult> DateTimeFormatter::parse(
     const std::string_view& input,
     const bool failOnError) const {
+  if (isFixedWidth()) {
+    if (auto result = tryParseFixedWidth(input)) {
+      return result;
+    }
+  }
+
   Date date;
   const char* cur = input.data();
   const char* end = cur + input.size();
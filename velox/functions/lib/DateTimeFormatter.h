@@ -159,7 +159,9 @@ class DateTimeFormatter {
       : literalBuf_(std::move(literalBuf)),
         bufSize_(bufSize),
         tokens_(std::move(tokens)),
-        type_(type) {}
+        type_(type) {
+    initializeFixedWidth();
+  }
 
   const std::unique_ptr<char[]>& literalBuf() const {
     return literalBuf_;
@@ -196,11 +198,48 @@ class DateTimeFormatter {
       char* result,
       bool allowOverflow = false) const;
 
+  /// Returns true if the format only has numeric fields of fixed width and
+  /// literals, e.g. 'yyyy-MM-dd HH:mm:ss'. Such formats parse and format
+  /// through a precomputed layout instead of interpreting the tokens.
+  bool isFixedWidth() const {
+    return !fixedWidthTemplate_.empty();
+  }
+
  private:
+  // A numeric field of a fixed width format.
+  struct FixedWidthField {
+    DateTimeFormatSpecifier specifier;
+    // Offset of the first digit in the formatted string.
+    uint8_t offset;
+    uint8_t width;
+  };
+
+  // Sets up the fixed width layout if the tokens allow it.
+  void initializeFixedWidth();
+
+  // Parses 'input' of a fixed width format. Returns std::nullopt if 'input'
+  // does not match the layout or has out of range values. The caller then
+  // falls back to the general parser, which reports the error.
+  std::optional<DateTimeResult> tryParseFixedWidth(
+      const std::string_view& input) const;
+
+  // Formats 'timestamp' into 'result' for a fixed width format. Returns the
+  // size of the result or 0 if the year does not fit in the layout.
+  int32_t tryFormatFixedWidth(const Timestamp& timestamp, char* result) const;
+
   std::unique_ptr<char[]> literalBuf_;
   size_t bufSize_;
   std::vector<DateTimeToken> tokens_;
   DateTimeFormatterType type_;
+
+  // The fields of a fixed width format in pattern order.
+  std::vector<FixedWidthField> fixedWidthFields_;
+  // The formatted string of a fixed width format with all-zero fields. Empty
+  // if the format is not fixed width.
+  std::string fixedWidthTemplate_;
+  // True for each character of 'fixedWidthTemplate_' that is a digit of a
+  // field.
+  std::vector<bool> fixedWidthIsDigit_;
 };
 
 std::shared_ptr<DateTimeFormatter> buildMysqlDateTimeFormatter(
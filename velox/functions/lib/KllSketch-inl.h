@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <queue>
 #include <type_traits>
@@ -293,6 +294,48 @@ void KllSketch<T, A, C>::insert(T value) {
   doInsert(value);
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(const T* values, size_t count) {
+  if (count == 0) {
+    return;
+  }
+  VELOX_DCHECK_GT(k_, 0);
+  VELOX_DCHECK_GE(levels_.size(), 2);
+  const auto [minIt, maxIt] = std::minmax_element(values, values + count, C());
+  if (n_ == 0) {
+    minValue_ = *minIt;
+    maxValue_ = *maxIt;
+  } else {
+    minValue_ = std::min(minValue_, *minIt, C());
+    maxValue_ = std::max(maxValue_, *maxIt, C());
+  }
+  size_t i = 0;
+  while (i < count) {
+    size_t numToCopy;
+    if (items_.size() < k_ && numLevels() == 1) {
+      // Grow the single level as doInsert() does.
+      numToCopy = std::min<size_t>(k_ - items_.size(), count - i);
+      items_.insert(items_.end(), values + i, values + i + numToCopy);
+      levels_[1] += numToCopy;
+    } else {
+      if (levels_[0] == 0) {
+        // Level zero is full, compact to make space for one value.
+        items_[insertPosition()] = values[i++];
+        ++n_;
+      }
+      // Level zero is not sorted, so the order in which the values fill the
+      // free space below it does not matter.
+      numToCopy = std::min<size_t>(levels_[0], count - i);
+      levels_[0] -= numToCopy;
+      std::copy(
+          values + i, values + i + numToCopy, items_.data() + levels_[0]);
+    }
+    i += numToCopy;
+    n_ += numToCopy;
+  }
+  isLevelZeroSorted_ = false;
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::doInsert(T value) {
   VELOX_DCHECK_GT(k_, 0);
@@ -60,6 +60,11 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add 'count' values to the sketch.  Equivalent to calling insert() for
+  /// each value, but copies runs of values into the free space of level zero
+  /// at once and computes min and max in one pass over the input.
+  void insert(const T* values, size_t count);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+#include "velox/core/Expressions.h"
 #include "velox/functions/lib/string/StringImpl.h"
 
 #include <re2/re2.h>
@@ -113,6 +114,13 @@ bool re2PartialMatch(StringView str, const RE2& re) {
   return RE2::PartialMatch(toStringPiece(str), re);
 }
 
+// Returns false if 'str' does not contain 'literal'. Used to skip RE2 for
+// strings without the literal required by a pattern, see re2RequiredLiteral().
+bool mayContain(StringView str, const std::string& literal) {
+  return literal.empty() ||
+      std::string_view(str).find(literal) != std::string_view::npos;
+}
+
 bool re2Extract(
     FlatVector<StringView>& result,
     int row,
@@ -204,7 +212,8 @@ template <bool (*Fn)(StringView, const RE2&)>
 class Re2MatchConstantPattern final : public exec::VectorFunction {
  public:
   explicit Re2MatchConstantPattern(StringView pattern)
-      : re_(toStringPiece(pattern), RE2::Quiet) {}
+      : re_(toStringPiece(pattern), RE2::Quiet),
+        requiredLiteral_(re2RequiredLiteral(std::string_view(pattern))) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -223,12 +232,15 @@ class Re2MatchConstantPattern final : public exec::VectorFunction {
     }
 
     context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-      result.set(i, Fn(toSearch->valueAt<StringView>(i), re_));
+      const auto str = toSearch->valueAt<StringView>(i);
+      result.set(i, mayContain(str, requiredLiteral_) && Fn(str, re_));
     });
   }
 
  private:
   RE2 re_;
+  // A substring of all matches. Strings without it are not matched with RE2.
+  const std::string requiredLiteral_;
 };
 
 template <bool (*Fn)(StringView, const RE2&)>
@@ -805,6 +817,10 @@ class LikeWithRe2 final : public exec::VectorFunction {
     re_.emplace(
         toStringPiece(likePatternToRe2(pattern, escapeChar, validPattern_)),
         opt);
+    if (validPattern_) {
+      requiredLiteral_ =
+          likeRequiredLiteral(std::string_view(pattern), escapeChar);
+    }
   }
 
   void apply(
@@ -837,7 +853,10 @@ class LikeWithRe2 final : public exec::VectorFunction {
     if (toSearch->isIdentityMapping()) {
       auto rawStrings = toSearch->data<StringView>();
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-        result.set(i, re2FullMatch(rawStrings[i], *re_));
+        result.set(
+            i,
+            mayContain(rawStrings[i], requiredLiteral_) &&
+                re2FullMatch(rawStrings[i], *re_));
       });
       return;
     }
@@ -858,6 +877,8 @@ class LikeWithRe2 final : public exec::VectorFunction {
  private:
   std::optional<RE2> re_;
   bool validPattern_;
+  // A substring of all matches. Strings without it are not matched with RE2.
+  std::string requiredLiteral_;
 };
 
 // This function is constructed when pattern or escape are not constants.
@@ -1739,6 +1760,300 @@ PatternMetadata determinePatternKind(
   return PatternMetadata::generic();
 }
 
+namespace {
+// Returns the position after the character class that starts at 'pattern[i]'
+// or npos if the class is not terminated.
+size_t skipCharClass(std::string_view pattern, size_t i) {
+  ++i;
+  if (i < pattern.size() && pattern[i] == '^') {
+    ++i;
+  }
+  if (i < pattern.size() && pattern[i] == ']') {
+    ++i;
+  }
+  while (i < pattern.size()) {
+    if (pattern[i] == '\\') {
+      i += 2;
+    } else if (
+        pattern[i] == '[' && i + 1 < pattern.size() && pattern[i + 1] == ':') {
+      auto end = pattern.find(":]", i + 2);
+      if (end == std::string_view::npos) {
+        return std::string_view::npos;
+      }
+      i = end + 2;
+    } else if (pattern[i] == ']') {
+      return i + 1;
+    } else {
+      ++i;
+    }
+  }
+  return std::string_view::npos;
+}
+
+// Returns the position after the group that starts at 'pattern[i]' or npos if
+// the group is not terminated.
+size_t skipGroup(std::string_view pattern, size_t i) {
+  int32_t depth = 0;
+  while (i < pattern.size()) {
+    switch (pattern[i]) {
+      case '\\':
+        i += 2;
+        break;
+      case '[':
+        i = skipCharClass(pattern, i);
+        if (i == std::string_view::npos) {
+          return i;
+        }
+        break;
+      case '(':
+        ++depth;
+        ++i;
+        break;
+      case ')':
+        ++i;
+        if (--depth == 0) {
+          return i;
+        }
+        break;
+      default:
+        ++i;
+    }
+  }
+  return std::string_view::npos;
+}
+} // namespace
+
+std::string re2RequiredLiteral(std::string_view pattern) {
+  // 'run' accumulates consecutive literal characters outside of groups and
+  // classes. 'inRun' is true if the last atom is the last character of 'run'.
+  std::string longest;
+  std::string run;
+  bool inRun = false;
+  auto endRun = [&]() {
+    if (run.size() > longest.size()) {
+      longest = run;
+    }
+    run.clear();
+    inRun = false;
+  };
+
+  size_t i = 0;
+  while (i < pattern.size()) {
+    const char c = pattern[i];
+    switch (c) {
+      case '|':
+      case ')':
+        return "";
+      case '*':
+      case '?':
+      case '{':
+        // The last atom is optional or repeated.
+        if (inRun) {
+          run.pop_back();
+        }
+        endRun();
+        if (c == '{') {
+          i = pattern.find('}', i);
+          if (i == std::string_view::npos) {
+            return "";
+          }
+        }
+        ++i;
+        break;
+      case '+':
+        // The last atom stays but the next one may not follow it directly.
+        endRun();
+        ++i;
+        break;
+      case '.':
+      case '^':
+      case '$':
+        endRun();
+        ++i;
+        break;
+      case '[':
+        endRun();
+        i = skipCharClass(pattern, i);
+        if (i == std::string_view::npos) {
+          return "";
+        }
+        break;
+      case '(':
+        // Flags such as (?i) change the meaning of the rest of the pattern.
+        if (i + 1 < pattern.size() && pattern[i + 1] == '?' &&
+            pattern.substr(i + 2, 1) != ":" &&
+            pattern.substr(i + 2, 2) != "P<") {
+          return "";
+        }
+        endRun();
+        i = skipGroup(pattern, i);
+        if (i == std::string_view::npos) {
+          return "";
+        }
+        break;
+      case '\\': {
+        if (i + 1 == pattern.size()) {
+          return "";
+        }
+        const char next = pattern[i + 1];
+        if (static_cast<unsigned char>(next) >= 0x80) {
+          return "";
+        }
+        if (std::isalnum(next)) {
+          if (std::string_view("dDwWsSbBAz").find(next) ==
+              std::string_view::npos) {
+            return "";
+          }
+          endRun();
+        } else {
+          run.push_back(next);
+          inRun = true;
+        }
+        i += 2;
+        break;
+      }
+      default:
+        // A quantifier after a multi-byte character applies to all its bytes.
+        if (static_cast<unsigned char>(c) >= 0x80) {
+          endRun();
+        } else {
+          run.push_back(c);
+          inRun = true;
+        }
+        ++i;
+    }
+  }
+  endRun();
+  return longest;
+}
+
+std::string likeRequiredLiteral(
+    std::string_view pattern,
+    std::optional<char> escapeChar) {
+  std::string longest;
+  std::string run;
+  bool escaped = false;
+  for (const char c : pattern) {
+    if (!escaped && c == escapeChar) {
+      escaped = true;
+      continue;
+    }
+    if (!escaped && (c == '%' || c == '_')) {
+      if (run.size() > longest.size()) {
+        longest = run;
+      }
+      run.clear();
+    } else {
+      run.push_back(c);
+    }
+    escaped = false;
+  }
+  return run.size() > longest.size() ? run : longest;
+}
+
+namespace {
+// Collects the inputs of nested OR calls in 'expr'.
+void flattenOr(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& inputs) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call != nullptr && call->name() == "or") {
+    for (const auto& input : call->inputs()) {
+      flattenOr(input, inputs);
+    }
+  } else {
+    inputs.push_back(expr);
+  }
+}
+
+// Returns the pattern of 'expr' if 'expr' is a 'name' call with a constant
+// pattern that compiles.
+std::optional<std::string> regexpLikePattern(
+    const std::string& name,
+    const core::TypedExprPtr& expr) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call == nullptr || call->name() != name || call->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  auto constant = std::dynamic_pointer_cast<const core::ConstantTypedExpr>(
+      call->inputs()[1]);
+  if (constant == nullptr || constant->hasValueVector() ||
+      !constant->type()->isVarchar() || constant->value().isNull()) {
+    return std::nullopt;
+  }
+  auto pattern = constant->value().value<TypeKind::VARCHAR>();
+  if (!RE2(pattern, RE2::Quiet).ok()) {
+    return std::nullopt;
+  }
+  return pattern;
+}
+} // namespace
+
+core::TypedExprPtr rewriteRegexpLikeOr(
+    const std::string& name,
+    const core::TypedExprPtr& expr) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call == nullptr || call->name() != "or") {
+    return nullptr;
+  }
+  std::vector<core::TypedExprPtr> inputs;
+  flattenOr(expr, inputs);
+
+  // The combined calls followed by the other inputs.
+  std::vector<core::TypedExprPtr> newInputs;
+  std::vector<bool> used(inputs.size(), false);
+  bool combined = false;
+  for (auto i = 0; i < inputs.size(); ++i) {
+    if (used[i]) {
+      continue;
+    }
+    auto pattern = regexpLikePattern(name, inputs[i]);
+    if (!pattern.has_value()) {
+      continue;
+    }
+    const auto& string = inputs[i]->inputs()[0];
+    std::string alternation = fmt::format("(?:{})", pattern.value());
+    std::vector<int32_t> group = {i};
+    for (auto j = i + 1; j < inputs.size(); ++j) {
+      if (used[j]) {
+        continue;
+      }
+      auto other = regexpLikePattern(name, inputs[j]);
+      if (other.has_value() && *inputs[j]->inputs()[0] == *string) {
+        alternation += fmt::format("|(?:{})", other.value());
+        group.push_back(j);
+      }
+    }
+    if (group.size() < 2 || !RE2(alternation, RE2::Quiet).ok()) {
+      continue;
+    }
+    for (auto j : group) {
+      used[j] = true;
+    }
+    newInputs.push_back(std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(),
+        std::vector<core::TypedExprPtr>{
+            string,
+            std::make_shared<core::ConstantTypedExpr>(
+                VARCHAR(), variant(alternation))},
+        name));
+    combined = true;
+  }
+  if (!combined) {
+    return nullptr;
+  }
+  for (auto i = 0; i < inputs.size(); ++i) {
+    if (!used[i]) {
+      newInputs.push_back(inputs[i]);
+    }
+  }
+  if (newInputs.size() == 1) {
+    return newInputs[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(newInputs), "or");
+}
+
 std::shared_ptr<exec::VectorFunction> makeLike(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
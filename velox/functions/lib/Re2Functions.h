@@ -206,6 +206,28 @@ PatternMetadata determinePatternKind(
     std::string_view pattern,
     std::optional<char> escapeChar);
 
+/// Returns a string contained in every string that matches the RE2 'pattern'
+/// or an empty string if none is found. The analysis is conservative and gives
+/// up on alternations, flags and escapes other than character classes. Used to
+/// reject strings with a substring search before running RE2.
+std::string re2RequiredLiteral(std::string_view pattern);
+
+/// Returns the longest literal part of the LIKE 'pattern'. Every string that
+/// matches the pattern contains it.
+std::string likeRequiredLiteral(
+    std::string_view pattern,
+    std::optional<char> escapeChar);
+
+/// Rewrites an OR of 'name' calls with constant patterns over the same string,
+/// e.g. regexp_like(s, 'a.*b') or regexp_like(s, '^c'), into a single call
+/// with an alternation of the patterns: regexp_like(s, '(?:a.*b)|(?:^c)'). RE2
+/// matches all patterns in one pass over the string. Patterns that do not
+/// compile are left alone to preserve their errors. Returns nullptr if no two
+/// calls can be combined.
+core::TypedExprPtr rewriteRegexpLikeOr(
+    const std::string& name,
+    const core::TypedExprPtr& expr);
+
 std::shared_ptr<exec::VectorFunction> makeLike(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
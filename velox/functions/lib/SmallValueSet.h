@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+#include <folly/container/F14Set.h>
+
+namespace facebook::velox::functions {
+
+/// A set of values for the elements of one array at a time, reused across the
+/// rows of a batch. Up to kMaxLinearSize values are kept in an inline array
+/// that is searched linearly. This is faster than hashing for small arrays
+/// and is cleared in constant time. Larger sets move to a hash set, which is
+/// only cleared if it was used.
+template <typename T>
+class SmallValueSet {
+ public:
+  static constexpr int32_t kMaxLinearSize = 16;
+
+  /// Adds 'value'. Returns true if it was not in the set.
+  bool insert(const T& value) {
+    if (!useHashSet_) {
+      if (containsLinear(value)) {
+        return false;
+      }
+      if (numLinear_ < kMaxLinearSize) {
+        linear_[numLinear_++] = value;
+        return true;
+      }
+      hashSet_.insert(linear_.begin(), linear_.begin() + numLinear_);
+      useHashSet_ = true;
+    }
+    return hashSet_.insert(value).second;
+  }
+
+  /// Returns 1 if 'value' is in the set, 0 otherwise.
+  size_t count(const T& value) const {
+    if (useHashSet_) {
+      return hashSet_.count(value);
+    }
+    return containsLinear(value) ? 1 : 0;
+  }
+
+  void clear() {
+    if (useHashSet_) {
+      hashSet_.clear();
+      useHashSet_ = false;
+    }
+    numLinear_ = 0;
+  }
+
+ private:
+  bool containsLinear(const T& value) const {
+    return std::find(linear_.begin(), linear_.begin() + numLinear_, value) !=
+        linear_.begin() + numLinear_;
+  }
+
+  std::array<T, kMaxLinearSize> linear_;
+  int32_t numLinear_{0};
+  bool useHashSet_{false};
+  folly::F14FastSet<T> hashSet_;
+};
+
+} // namespace facebook::velox::functions
@@ -19,6 +19,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/MemoryPool.h"
 #include "velox/functions/lib/SubscriptUtil.h"
 #include "velox/type/Type.h"
@@ -43,6 +44,31 @@ struct SimpleType<TypeKind::VARCHAR> {
   using type = Varchar;
 };
 
+// Returns the position of the first of 'size' 'keys' equal to 'key' or -1 if
+// there is none. Compares a SIMD register of keys at a time for numeric
+// types.
+template <typename T>
+vector_size_t findKey(const T* keys, vector_size_t size, const T& key) {
+  vector_size_t i = 0;
+  if constexpr (std::is_arithmetic_v<T> && sizeof(T) <= sizeof(int64_t)) {
+    using Batch = xsimd::batch<T>;
+    const auto target = Batch::broadcast(key);
+    for (; i + Batch::size <= size; i += Batch::size) {
+      const auto mask =
+          simd::toBitMask(Batch::load_unaligned(keys + i) == target);
+      if (mask) {
+        return i + __builtin_ctzll(mask);
+      }
+    }
+  }
+  for (; i < size; ++i) {
+    if (keys[i] == key) {
+      return i;
+    }
+  }
+  return -1;
+}
+
 /// Decode arguments and transform result into a dictionaryVector where the
 /// dictionary maintains a mapping from a given row to the index of the input
 /// map value vector. This allows us to ensure that element_at is zero-copy.
@@ -95,6 +121,18 @@ VectorPtr applyMapTyped(
   auto rawSizes = baseMap->rawSizes();
   auto rawOffsets = baseMap->rawOffsets();
 
+  // Flat keys are searched directly in the values buffer.
+  const TKey* rawKeys = nullptr;
+  if constexpr (kind != TypeKind::BOOLEAN) {
+    if (decodedMapKeys->isIdentityMapping()) {
+      rawKeys = decodedMapKeys->data<TKey>();
+    }
+  }
+
+  // Maps in a column often have their keys in the same order. The position of
+  // the last match within its map is tried first for the next row.
+  vector_size_t lastPosition = 0;
+
   // Lambda that does the search for a key, for each row.
   auto processRow = [&](vector_size_t row, TKey searchKey) {
     size_t mapIndex = mapIndices[row];
@@ -125,6 +163,20 @@ VectorPtr applyMapTyped(
         found = true;
       }
 
+    } else if (rawKeys != nullptr) {
+      // Search map without caching.
+      vector_size_t position = -1;
+      if (lastPosition < size &&
+          rawKeys[offsetStart + lastPosition] == searchKey) {
+        position = lastPosition;
+      } else {
+        position = findKey(rawKeys + offsetStart, size, searchKey);
+      }
+      if (position >= 0) {
+        rawIndices[row] = offsetStart + position;
+        lastPosition = position;
+        found = true;
+      }
     } else {
       // Search map without caching.
       for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/AggregationHook.h"
 #include "velox/vector/DecodedVector.h"
@@ -192,6 +193,79 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Variant of updateOneGroup for integer aggregates whose update is an
+  // associative and commutative 'reduce', e.g. bitwise and, or and xor.
+  // 'reduce' takes two values or two xsimd batches of TData and returns their
+  // combination. 'initialValue' must be the identity of 'reduce'. Flat inputs
+  // are reduced a batch at a time into a local value, skipping null rows
+  // using the nulls bitmask, which is then combined into 'group'.
+  template <
+      typename TData = TResult,
+      typename Reduce,
+      typename UpdateDuplicate>
+  void reduceOneGroup(
+      char* group,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      Reduce reduce,
+      UpdateDuplicate updateDuplicateValues,
+      bool mayPushdown,
+      TData initialValue) {
+    auto updateSingleValue = [&](TData& result, TData value) {
+      result = reduce(result, value);
+    };
+    if constexpr (
+        std::is_same_v<TData, TInput> && std::is_integral_v<TData> &&
+        !std::is_same_v<TData, bool>) {
+      if (arg->isFlatEncoding()) {
+        using Batch = xsimd::batch<TData>;
+        static_assert(64 % Batch::size == 0);
+        const auto* data = arg->asUnchecked<FlatVector<TData>>()->rawValues();
+        const auto* rawNulls = arg->rawNulls();
+        const auto* rawRows = rows.asRange().bits();
+        TData result = initialValue;
+        auto batchResult = Batch::broadcast(initialValue);
+        bool hasValue = false;
+        bits::forEachWord(
+            rows.begin(), rows.end(), [&](int32_t index, uint64_t mask) {
+              auto word = rawRows[index] & mask;
+              if (rawNulls) {
+                word &= rawNulls[index];
+              }
+              hasValue |= word != 0;
+              const auto* values = data + index * 64;
+              if (word == ~0ULL) {
+                for (auto i = 0; i < 64; i += Batch::size) {
+                  batchResult =
+                      reduce(batchResult, Batch::load_unaligned(values + i));
+                }
+                return;
+              }
+              for (; word; word &= word - 1) {
+                result = reduce(result, values[__builtin_ctzll(word)]);
+              }
+            });
+        if (hasValue) {
+          alignas(Batch) TData lanes[Batch::size];
+          batchResult.store_aligned(lanes);
+          for (auto lane : lanes) {
+            result = reduce(result, lane);
+          }
+          updateNonNullValue<true, TData>(group, result, updateSingleValue);
+        }
+        return;
+      }
+    }
+    updateOneGroup<TData>(
+        group,
+        rows,
+        arg,
+        updateSingleValue,
+        updateDuplicateValues,
+        mayPushdown,
+        initialValue);
+  }
+
   template <typename THook>
   void
   pushdown(char** groups, const SelectivityVector& rows, const VectorPtr& arg) {
@@ -57,6 +57,11 @@ class ValueList {
     return size_;
   }
 
+  /// Returns the number of bytes of the non-null values.
+  int32_t bytes() const {
+    return bytes_;
+  }
+
   // Called after 'finalize()' to get access to 'data' allocation.
   HashStringAllocator::Header* dataBegin() {
     return dataBegin_;
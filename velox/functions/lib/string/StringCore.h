@@ -20,6 +20,7 @@
 #include <string_view>
 #include "folly/CPortability.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
 
 #if (ENABLE_VECTORIZATION > 0) && !defined(_DEBUG) && !defined(DEBUG)
@@ -47,13 +48,32 @@ namespace stringCore {
 /// Check if a given string is ascii
 static bool isAscii(const char* str, size_t length);
 
-FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
-  for (auto i = 0; i < length; i++) {
+/// Returns the offset of the first byte of 'str' that is not ASCII or
+/// 'length' if all bytes are ASCII. Checks one SIMD register of bytes at a
+/// time.
+FOLLY_ALWAYS_INLINE size_t findFirstNonAscii(const char* str, size_t length) {
+  using Batch = xsimd::batch<int8_t>;
+  const auto zero = Batch::broadcast(0);
+  size_t i = 0;
+  for (; i + Batch::size <= length; i += Batch::size) {
+    // Non-ASCII bytes have the sign bit set.
+    const auto mask = simd::toBitMask(
+        Batch::load_unaligned(reinterpret_cast<const int8_t*>(str + i)) <
+        zero);
+    if (mask) {
+      return i + __builtin_ctzll(mask);
+    }
+  }
+  for (; i < length; ++i) {
     if (str[i] & 0x80) {
-      return false;
+      return i;
     }
   }
-  return true;
+  return length;
+}
+
+FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
+  return findFirstNonAscii(str, length) == length;
 }
 
 /// Perform reverse for ascii string input
@@ -92,24 +112,20 @@ reverseUnicode(char* output, const char* input, size_t length) {
 /// Perform upper for ascii string input
 FOLLY_ALWAYS_INLINE static void
 upperAscii(char* output, const char* input, size_t length) {
+  // Branch free so that the loop vectorizes.
   VECTORIZE_LOOP_IF_POSSIBLE for (auto i = 0; i < length; i++) {
-    if (input[i] >= 'a' && input[i] <= 'z') {
-      output[i] = input[i] - 32;
-    } else {
-      output[i] = input[i];
-    }
+    const char c = input[i];
+    output[i] = c - ((c >= 'a' && c <= 'z') << 5);
   }
 }
 
 /// Perform lower for ascii string input
 FOLLY_ALWAYS_INLINE static void
 lowerAscii(char* output, const char* input, size_t length) {
+  // Branch free so that the loop vectorizes.
   VECTORIZE_LOOP_IF_POSSIBLE for (auto i = 0; i < length; i++) {
-    if (input[i] >= 'A' && input[i] <= 'Z') {
-      output[i] = input[i] + 32;
-    } else {
-      output[i] = input[i];
-    }
+    const char c = input[i];
+    output[i] = c + ((c >= 'A' && c <= 'Z') << 5);
   }
 }
 
@@ -222,6 +238,14 @@ lengthUnicode(const char* inputBuffer, size_t bufferLength) {
   auto currentChar = inputBuffer;
   int64_t size = 0;
   while (currentChar < buffEndAddress) {
+    // Each ASCII byte is one character.
+    const auto numAscii =
+        findFirstNonAscii(currentChar, buffEndAddress - currentChar);
+    currentChar += numAscii;
+    size += numAscii;
+    if (currentChar >= buffEndAddress) {
+      break;
+    }
     auto chrOffset = utf8proc_char_length(currentChar);
     // Skip bad byte if we get utf length < 0.
     currentChar += UNLIKELY(chrOffset < 0) ? 1 : chrOffset;
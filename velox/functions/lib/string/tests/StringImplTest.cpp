@@ -34,6 +34,7 @@ class StringImplTest : public testing::Test {
         {"abcdefg", "ABCDEFG"},
         {"ABCDEFG", "ABCDEFG"},
         {"a B c D e F g", "A B C D E F G"},
+        {"@Az[`aZ{", "@AZ[`AZ{"},
     };
   }
 
@@ -50,6 +51,7 @@ class StringImplTest : public testing::Test {
         {"ABCDEFG", "abcdefg"},
         {"abcdefg", "abcdefg"},
         {"a B c D e F g", "a b c d e f g"},
+        {"@Az[`aZ{", "@az[`az{"},
     };
   }
 
@@ -92,6 +94,33 @@ TEST_F(StringImplTest, lowerAscii) {
   }
 }
 
+TEST_F(StringImplTest, findFirstNonAscii) {
+  ASSERT_EQ(findFirstNonAscii("", 0), 0);
+  ASSERT_TRUE(isAscii("", 0));
+
+  // Lengths around the SIMD register size with a non-ASCII byte at each
+  // position.
+  for (auto length = 1; length < 100; ++length) {
+    std::string input(length, 'a');
+    ASSERT_EQ(findFirstNonAscii(input.data(), input.size()), length);
+    ASSERT_TRUE(isAscii(input.data(), input.size()));
+    for (auto i = 0; i < length; ++i) {
+      input[i] = '\xc3';
+      ASSERT_EQ(findFirstNonAscii(input.data(), input.size()), i);
+      ASSERT_FALSE(isAscii(input.data(), input.size()));
+      input[i] = 'a';
+    }
+  }
+}
+
+TEST_F(StringImplTest, mixedLength) {
+  std::string input(40, 'a');
+  input += "\u00e0\u00e1";
+  input += std::string(50, 'b');
+  input += "\U0001D437";
+  ASSERT_EQ(length</*isAscii*/ false>(input), 93);
+}
+
 TEST_F(StringImplTest, upperUnicode) {
   for (auto& testCase : getUpperUnicodeTestData()) {
     auto input = StringView(std::get<0>(testCase));
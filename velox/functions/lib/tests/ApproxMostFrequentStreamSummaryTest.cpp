@@ -184,5 +184,66 @@ TEST(ApproxMostFrequentStreamSummaryTest, mergeSerialized) {
   }
 }
 
+TEST(ApproxMostFrequentStreamSummaryTest, batchInsert) {
+  constexpr int kCardinality = 1000;
+  constexpr int K = 10;
+  std::default_random_engine gen(0);
+  ZetaDistribution dist(1.02, kCardinality);
+  for (int capacity : {kCardinality, 100}) {
+    SCOPED_TRACE(fmt::format("capacity={}", capacity));
+    ApproxMostFrequentStreamSummary<int> summary;
+    summary.setCapacity(capacity);
+    int freq[kCardinality + 1]{};
+    int numCopies = 0;
+    for (int batch = 0; batch < 100; ++batch) {
+      std::vector<int> values;
+      std::vector<int64_t> counts;
+      for (int i = 0; i < 1'000; ++i) {
+        int v = dist(gen);
+        ++freq[v];
+        auto it = std::find(values.begin(), values.end(), v);
+        if (it == values.end()) {
+          values.push_back(v);
+          counts.push_back(1);
+        } else {
+          ++counts[it - values.begin()];
+        }
+      }
+      summary.insert(
+          values.data(), counts.data(), values.size(), [&](int value) {
+            ++numCopies;
+            return value;
+          });
+    }
+    ASSERT_LE(summary.size(), capacity);
+    // Values are copied when they start being tracked.
+    if (capacity == kCardinality) {
+      ASSERT_EQ(numCopies, summary.size());
+    } else {
+      ASSERT_GE(numCopies, summary.size());
+    }
+    std::vector<std::pair<int, int64_t>> expected;
+    for (int i = 1; i <= kCardinality; ++i) {
+      if (freq[i] > 0) {
+        expected.emplace_back(i, freq[i]);
+      }
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](auto& x, auto& y) {
+      return x.second > y.second;
+    });
+    auto topK = summary.topK(K);
+    ASSERT_EQ(topK.size(), K);
+    for (int i = 0; i < K; ++i) {
+      if (capacity == kCardinality) {
+        EXPECT_EQ(topK[i].second, expected[i].second);
+        EXPECT_EQ(topK[i].second, freq[topK[i].first]);
+      } else {
+        EXPECT_GE(topK[i].second, freq[topK[i].first]);
+      }
+    }
+    EXPECT_EQ(topK[0].first, expected[0].first);
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::functions
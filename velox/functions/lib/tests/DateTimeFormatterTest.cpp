@@ -1384,6 +1384,50 @@ TEST_F(JodaDateTimeFormatterTest, parseConsecutiveSpecifiers) {
   EXPECT_THROW(parseJoda("12312", "yyH"), VeloxUserError);
 }
 
+TEST_F(JodaDateTimeFormatterTest, fixedWidth) {
+  EXPECT_TRUE(
+      buildJodaDateTimeFormatter("yyyy-MM-dd HH:mm:ss")->isFixedWidth());
+  EXPECT_TRUE(buildJodaDateTimeFormatter("yyyyMMdd")->isFixedWidth());
+  EXPECT_FALSE(buildJodaDateTimeFormatter("yyyy-M-dd")->isFixedWidth());
+  EXPECT_FALSE(buildJodaDateTimeFormatter("MM-dd")->isFixedWidth());
+  EXPECT_FALSE(buildJodaDateTimeFormatter("yyyy-MM-dd'1'")->isFixedWidth());
+  EXPECT_FALSE(
+      buildJodaDateTimeFormatter("yyyy-MM-dd HH:mm:ss.SSS")->isFixedWidth());
+
+  const auto format = "yyyy-MM-dd HH:mm:ss";
+  EXPECT_EQ(
+      util::fromTimestampString("2021-03-14 01:02:03"),
+      parseJoda("2021-03-14 01:02:03", format).timestamp);
+  EXPECT_EQ(-1, parseJoda("2021-03-14 01:02:03", format).timezoneId);
+  EXPECT_EQ(
+      util::fromTimestampString("1969-12-31 23:59:59"),
+      parseJoda("1969-12-31 23:59:59", format).timestamp);
+  // Inputs that do not match the layout go through the general parser.
+  EXPECT_EQ(
+      util::fromTimestampString("2021-03-04 01:02:03"),
+      parseJoda("2021-3-4 1:2:3", format).timestamp);
+  VELOX_ASSERT_THROW(
+      parseJoda("2021-02-29 01:02:03", format),
+      "Value 29 for dayOfMonth must be in the range [1,28] for year 2021 and month 2.");
+  EXPECT_THROW(parseJoda("2021-13-01 01:02:03", format), VeloxUserError);
+  EXPECT_THROW(parseJoda("2021-01-01 24:02:03", format), VeloxUserError);
+  EXPECT_THROW(parseJoda("2021/01/01 01:02:03", format), VeloxUserError);
+
+  auto formatter = buildJodaDateTimeFormatter(format);
+  auto* timezone = date::locate_zone("America/Los_Angeles");
+  const auto maxSize = formatter->maxResultSize(timezone);
+  for (const auto& [timestamp, expected] :
+       std::vector<std::pair<Timestamp, std::string>>{
+           {Timestamp(0, 0), "1969-12-31 16:00:00"},
+           {Timestamp(1'615'712'523, 999'999'999), "2021-03-14 01:02:03"},
+           {Timestamp(253'402'300'799, 0), "9999-12-31 15:59:59"}}) {
+    std::string result(maxSize, '\0');
+    result.resize(
+        formatter->format(timestamp, timezone, maxSize, result.data()));
+    EXPECT_EQ(expected, result);
+  }
+}
+
 TEST_F(JodaDateTimeFormatterTest, formatResultSize) {
   auto* timezone = date::locate_zone("GMT");
 
@@ -129,6 +129,26 @@ TEST_F(KllSketchTest, randomInput) {
   }
 }
 
+TEST_F(KllSketchTest, insertBatch) {
+  constexpr int N = 1e5;
+  KllSketch<double> expected(kDefaultK, {}, 0);
+  std::vector<double> values(N);
+  insertRandomData(0, N, expected, values.data());
+  // Uneven batch sizes cover batches that cross compactions.
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  for (int i = 0; i < N; i += 997) {
+    kll.insert(values.data() + i, std::min(997, N - i));
+    EXPECT_EQ(kll.totalCount(), std::min(N, i + 997));
+  }
+  expected.compact();
+  kll.compact();
+  std::vector<char> expectedData(expected.serializedByteSize());
+  expected.serialize(expectedData.data());
+  std::vector<char> data(kll.serializedByteSize());
+  kll.serialize(data.data());
+  EXPECT_EQ(expectedData, data);
+}
+
 TEST_F(KllSketchTest, merge) {
   constexpr int N = 1e4;
   constexpr int M = 1001;
@@ -1471,5 +1471,66 @@ TEST_F(Re2FunctionsTest, limit) {
   ASSERT_NO_THROW(evaluate("regexp_like(c0, c2)", data));
 }
 
+TEST_F(Re2FunctionsTest, requiredLiteral) {
+  EXPECT_EQ(re2RequiredLiteral("abc"), "abc");
+  EXPECT_EQ(re2RequiredLiteral("ab*cde"), "cde");
+  EXPECT_EQ(re2RequiredLiteral("^foo.*barbaz$"), "barbaz");
+  EXPECT_EQ(re2RequiredLiteral("x(ab|cd)yy"), "yy");
+  EXPECT_EQ(re2RequiredLiteral("a\\.b+c"), "a.b");
+  EXPECT_EQ(re2RequiredLiteral("[a-z]+\\d{2,3}ok?"), "o");
+  EXPECT_EQ(re2RequiredLiteral("abc|def"), "");
+  EXPECT_EQ(re2RequiredLiteral("(?i)abc"), "");
+  EXPECT_EQ(re2RequiredLiteral("\\x41bc"), "");
+  EXPECT_EQ(re2RequiredLiteral("[abc"), "");
+
+  EXPECT_EQ(likeRequiredLiteral("%ab_cde%f", std::nullopt), "cde");
+  EXPECT_EQ(likeRequiredLiteral("%a\\%b%", '\\'), "a%b");
+  EXPECT_EQ(likeRequiredLiteral("%_%", std::nullopt), "");
+}
+
+TEST_F(Re2FunctionsTest, regexpLikeOrRewrite) {
+  auto rowType = ROW({"c0", "c1"}, {VARCHAR(), VARCHAR()});
+  auto rewritten = rewriteRegexpLikeOr(
+      "regexp_like",
+      makeTypedExpr(
+          "regexp_like(c0, 'a+b') or c1 = 'y' or regexp_like(c1, 'x') or "
+          "regexp_like(c0, '^cd')",
+          rowType));
+  ASSERT_NE(rewritten, nullptr);
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(rewritten);
+  ASSERT_EQ(call->name(), "or");
+  ASSERT_EQ(call->inputs().size(), 3);
+  auto combined = call->inputs()[0];
+  ASSERT_EQ(
+      std::dynamic_pointer_cast<const core::ConstantTypedExpr>(
+          combined->inputs()[1])
+          ->value()
+          .value<TypeKind::VARCHAR>(),
+      "(?:a+b)|(?:^cd)");
+
+  // A pattern that does not compile keeps its own call.
+  ASSERT_EQ(
+      rewriteRegexpLikeOr(
+          "regexp_like",
+          makeTypedExpr(
+              "regexp_like(c0, '(') or regexp_like(c0, 'a')", rowType)),
+      nullptr);
+
+  // The rewrite is applied when compiling the expression.
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"xaab", "cd", "xcd", std::nullopt, "ab", "q"}),
+      makeFlatVector<std::string>({"", "", "", "", "y", "x"}),
+  });
+  auto result = evaluate(
+      "regexp_like(c0, 'a+b') or regexp_like(c0, '^cd') or "
+      "regexp_like(c1, 'x')",
+      data);
+  assertEqualVectors(
+      makeNullableFlatVector<bool>(
+          {true, true, false, std::nullopt, true, true}),
+      result);
+}
+
 } // namespace
 } // namespace facebook::velox::functions
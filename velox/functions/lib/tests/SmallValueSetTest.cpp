@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/functions/lib/SmallValueSet.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/type/StringView.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+TEST(SmallValueSetTest, insertAndCount) {
+  SmallValueSet<int64_t> set;
+  // Sizes below, at and above the linear search limit.
+  for (auto size : {1, SmallValueSet<int64_t>::kMaxLinearSize, 100}) {
+    SCOPED_TRACE(size);
+    set.clear();
+    for (auto i = 0; i < size; ++i) {
+      ASSERT_EQ(0, set.count(i * 7));
+      ASSERT_TRUE(set.insert(i * 7));
+    }
+    for (auto i = 0; i < size; ++i) {
+      ASSERT_EQ(1, set.count(i * 7));
+      ASSERT_FALSE(set.insert(i * 7));
+      ASSERT_EQ(0, set.count(i * 7 + 1));
+    }
+  }
+
+  set.clear();
+  ASSERT_EQ(0, set.count(0));
+  ASSERT_TRUE(set.insert(0));
+}
+
+TEST(SmallValueSetTest, strings) {
+  SmallValueSet<StringView> set;
+  std::vector<std::string> values;
+  for (auto i = 0; i < 40; ++i) {
+    values.push_back(fmt::format("a long string value {}", i % 20));
+  }
+  int32_t numInserted = 0;
+  for (const auto& value : values) {
+    numInserted += set.insert(StringView(value));
+  }
+  ASSERT_EQ(20, numInserted);
+  ASSERT_EQ(0, set.count(StringView("other")));
+}
+
+} // namespace
+} // namespace facebook::velox::functions
@@ -45,7 +45,7 @@ class RankFunction : public exec::WindowFunction {
 
   void apply(
       const BufferPtr& peerGroupStarts,
-      const BufferPtr& /*peerGroupEnds*/,
+      const BufferPtr& peerGroupEnds,
       const BufferPtr& /*frameStarts*/,
       const BufferPtr& /*frameEnds*/,
       const SelectivityVector& validRows,
@@ -53,9 +53,12 @@ class RankFunction : public exec::WindowFunction {
       const VectorPtr& result) override {
     int numRows = peerGroupStarts->size() / sizeof(vector_size_t);
     auto* rawPeerStarts = peerGroupStarts->as<vector_size_t>();
+    auto* rawPeerEnds = peerGroupEnds->as<vector_size_t>();
     auto rawValues = result->asFlatVector<TResult>()->mutableRawValues();
 
-    for (int i = 0; i < numRows; i++) {
+    // All the rows of a peer group have the same rank, so the rank is updated
+    // once per peer group and filled in for its rows in this output block.
+    for (int i = 0; i < numRows;) {
       auto start = rawPeerStarts[i];
       if (start != currentPeerGroupStart_) {
         currentPeerGroupStart_ = start;
@@ -69,14 +72,21 @@ class RankFunction : public exec::WindowFunction {
         previousPeerCount_ = 0;
       }
 
+      // The partition row of 'i' is 'previousPeerCount_' rows into its peer
+      // group.
+      const vector_size_t numPeers = std::min<vector_size_t>(
+          numRows - i, rawPeerEnds[i] - (start + previousPeerCount_) + 1);
+      TResult value;
       if constexpr (TRank == RankType::kPercentRank) {
-        rawValues[resultOffset + i] = (numPartitionRows_ == 1)
+        value = (numPartitionRows_ == 1)
             ? 0
             : double(rank_ - 1) / (numPartitionRows_ - 1);
       } else {
-        rawValues[resultOffset + i] = rank_;
+        value = rank_;
       }
-      previousPeerCount_ += 1;
+      std::fill_n(rawValues + resultOffset + i, numPeers, value);
+      previousPeerCount_ += numPeers;
+      i += numPeers;
     }
   }
 
@@ -109,7 +119,10 @@ void registerRankInternal(
           const core::QueryConfig& /*queryConfig*/)
           -> std::unique_ptr<exec::WindowFunction> {
         return std::make_unique<RankFunction<TRank, TResult>>(resultType);
-      });
+      },
+      // percent_rank() depends on the number of rows in the partition.
+      {.supportsStreaming = TRank != RankType::kPercentRank,
+       .ignoresFrame = true});
 }
 
 void registerRankBigint(const std::string& name) {
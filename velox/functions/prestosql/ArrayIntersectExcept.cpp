@@ -16,24 +16,20 @@
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/lib/SmallValueSet.h"
 
 namespace facebook::velox::functions {
 namespace {
 template <typename T>
 
 struct SetWithNull {
-  SetWithNull(vector_size_t initialSetSize = kInitialSetSize) {
-    set.reserve(initialSetSize);
-  }
-
   void reset() {
     set.clear();
     hasNull = false;
   }
 
-  folly::F14FastSet<T> set;
+  SmallValueSet<T> set;
   bool hasNull{false};
-  static constexpr vector_size_t kInitialSetSize{128};
 };
 // Generates a set based on the elements of an ArrayVector. Note that we take
 // rightSet as a parameter (instead of returning a new one) to reuse the
@@ -199,8 +195,7 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
             addValue = rightSet.set.count(val) == 0;
           }
           if (addValue) {
-            auto it = outputSet.set.insert(val);
-            if (it.second) {
+            if (outputSet.set.insert(val)) {
               rawNewIndices[indicesCursor++] = i;
             }
           }
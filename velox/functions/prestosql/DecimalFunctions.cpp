@@ -40,6 +40,11 @@ struct DecimalPlusFunction {
     auto bScale = getDecimalPrecisionScale(*bType).second;
     aRescale_ = computeRescaleFactor(aScale, bScale);
     bRescale_ = computeRescaleFactor(bScale, aScale);
+    // Rescale factors of short decimal results do not exceed 18 digits.
+    aShortMultiplier_ = DecimalUtil::kPowersOfTen[std::min<uint8_t>(
+        aRescale_, ShortDecimalType::kMaxPrecision)];
+    bShortMultiplier_ = DecimalUtil::kPowersOfTen[std::min<uint8_t>(
+        bRescale_, ShortDecimalType::kMaxPrecision)];
   }
 
   template <typename R, typename A, typename B>
@@ -50,6 +55,13 @@ struct DecimalPlusFunction {
 #endif
 #endif
   {
+    if constexpr (
+        std::is_same_v<R, int64_t> && std::is_same_v<A, int64_t> &&
+        std::is_same_v<B, int64_t>) {
+      if (shortRescale(a, b, out)) {
+        return;
+      }
+    }
     int128_t aRescaled;
     int128_t bRescaled;
     if (__builtin_mul_overflow(
@@ -69,8 +81,20 @@ struct DecimalPlusFunction {
     return std::max(0, toScale - fromScale);
   }
 
+  // Computes the result of short decimals in 64 bits. Returns false if that
+  // overflows, in which case the result is computed in 128 bits.
+  bool shortRescale(int64_t a, int64_t b, int64_t& out) const {
+    int64_t aRescaled;
+    int64_t bRescaled;
+    return !__builtin_mul_overflow(a, aShortMultiplier_, &aRescaled) &&
+        !__builtin_mul_overflow(b, bShortMultiplier_, &bRescaled) &&
+        !__builtin_add_overflow(aRescaled, bRescaled, &out);
+  }
+
   uint8_t aRescale_;
   uint8_t bRescale_;
+  int64_t aShortMultiplier_;
+  int64_t bShortMultiplier_;
 };
 
 template <typename TExec>
@@ -89,6 +113,11 @@ struct DecimalMinusFunction {
     auto bScale = getDecimalPrecisionScale(*bType).second;
     aRescale_ = computeRescaleFactor(aScale, bScale);
     bRescale_ = computeRescaleFactor(bScale, aScale);
+    // Rescale factors of short decimal results do not exceed 18 digits.
+    aShortMultiplier_ = DecimalUtil::kPowersOfTen[std::min<uint8_t>(
+        aRescale_, ShortDecimalType::kMaxPrecision)];
+    bShortMultiplier_ = DecimalUtil::kPowersOfTen[std::min<uint8_t>(
+        bRescale_, ShortDecimalType::kMaxPrecision)];
   }
 
   template <typename R, typename A, typename B>
@@ -99,6 +128,13 @@ struct DecimalMinusFunction {
 #endif
 #endif
   {
+    if constexpr (
+        std::is_same_v<R, int64_t> && std::is_same_v<A, int64_t> &&
+        std::is_same_v<B, int64_t>) {
+      if (shortRescale(a, b, out)) {
+        return;
+      }
+    }
     int128_t aRescaled;
     int128_t bRescaled;
     if (__builtin_mul_overflow(
@@ -118,8 +154,20 @@ struct DecimalMinusFunction {
     return std::max(0, toScale - fromScale);
   }
 
+  // Computes the result of short decimals in 64 bits. Returns false if that
+  // overflows, in which case the result is computed in 128 bits.
+  bool shortRescale(int64_t a, int64_t b, int64_t& out) const {
+    int64_t aRescaled;
+    int64_t bRescaled;
+    return !__builtin_mul_overflow(a, aShortMultiplier_, &aRescaled) &&
+        !__builtin_mul_overflow(b, bShortMultiplier_, &bRescaled) &&
+        !__builtin_sub_overflow(aRescaled, bRescaled, &out);
+  }
+
   uint8_t aRescale_;
   uint8_t bRescale_;
+  int64_t aShortMultiplier_;
+  int64_t bShortMultiplier_;
 };
 
 template <typename TExec>
@@ -128,8 +176,15 @@ struct DecimalMultiplyFunction {
 
   template <typename R, typename A, typename B>
   void call(R& out, const A& a, const B& b) {
-    out = checkedMultiply<R>(checkedMultiply<R>(R(a), R(b)), R(1));
-    DecimalUtil::valueInRange(out);
+    if constexpr (
+        std::is_same_v<R, int128_t> && std::is_same_v<A, int64_t> &&
+        std::is_same_v<B, int64_t>) {
+      // The product of two short decimals fits in the range of a long decimal.
+      out = R(a) * R(b);
+    } else {
+      out = checkedMultiply<R>(R(a), R(b));
+      DecimalUtil::valueInRange(out);
+    }
   }
 };
 
@@ -188,6 +188,11 @@ class FromUtf8Function : public exec::VectorFunction {
 
       int32_t pos = 0;
       while (pos < value.size()) {
+        pos += stringCore::findFirstNonAscii(
+            value.data() + pos, value.size() - pos);
+        if (pos >= value.size()) {
+          break;
+        }
         auto charLength =
             tryGetCharLength(value.data() + pos, value.size() - pos);
         if (charLength < 0) {
@@ -267,6 +272,13 @@ class FromUtf8Function : public exec::VectorFunction {
 
     int32_t pos = 0;
     while (pos < input.size()) {
+      const auto numAscii = stringCore::findFirstNonAscii(
+          input.data() + pos, input.size() - pos);
+      if (numAscii > 0) {
+        fixedWriter.append(std::string_view(input.data() + pos, numAscii));
+        pos += numAscii;
+        continue;
+      }
       auto charLength =
           tryGetCharLength(input.data() + pos, input.size() - pos);
       if (charLength > 0) {
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/functions/prestosql/InPredicate.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/Filter.h"
@@ -544,6 +545,10 @@ class InPredicate : public exec::VectorFunction {
           }
         }
       });
+    } else if constexpr (
+        std::is_same_v<T, int64_t> || std::is_same_v<T, int32_t> ||
+        std::is_same_v<T, int16_t>) {
+      applyBatches(rows, flatArg->rawValues(), rawResults);
     } else {
       rows.applyToSelected([&](auto row) {
         bool pass = testFunction(flatArg->valueAtFast(row));
@@ -552,11 +557,156 @@ class InPredicate : public exec::VectorFunction {
     }
   }
 
+  // Tests 'rawValues' of 'rows' a SIMD batch at a time with
+  // Filter::testValues(). Sets the bits of 'rows' in 'rawResults' and keeps
+  // the other bits.
+  template <typename T>
+  void applyBatches(
+      const SelectivityVector& rows,
+      const T* rawValues,
+      uint64_t* rawResults) const {
+    constexpr int32_t kBatchSize = xsimd::batch<T>::size;
+    const auto* selected = rows.asRange().bits();
+    const auto end = rows.end();
+    for (auto word = rows.begin() / 64; word * 64 < end; ++word) {
+      const auto wordBegin = word * 64;
+      const auto numRows = std::min<vector_size_t>(64, end - wordBegin);
+      const auto mask =
+          selected[word] & (numRows == 64 ? ~0ULL : bits::lowMask(numRows));
+      if (mask == 0) {
+        continue;
+      }
+      uint64_t pass = 0;
+      auto i = 0;
+      for (; i + kBatchSize <= numRows; i += kBatchSize) {
+        auto values = xsimd::load_unaligned(rawValues + wordBegin + i);
+        pass |= static_cast<uint64_t>(
+                    simd::toBitMask(filter_->testValues(values)))
+            << i;
+      }
+      for (; i < numRows; ++i) {
+        if (filter_->testInt64(rawValues[wordBegin + i])) {
+          pass |= 1ULL << i;
+        }
+      }
+      rawResults[word] = (rawResults[word] & ~mask) | (pass & mask);
+    }
+  }
+
   const std::unique_ptr<common::Filter> filter_;
   const bool alwaysNull_;
 };
 } // namespace
 
+namespace {
+void flattenOr(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& inputs) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call != nullptr && call->name() == "or") {
+    for (const auto& input : call->inputs()) {
+      flattenOr(input, inputs);
+    }
+  } else {
+    inputs.push_back(expr);
+  }
+}
+
+bool isInListType(const TypePtr& type) {
+  return *type == *BIGINT() || *type == *INTEGER() || *type == *SMALLINT() ||
+      *type == *TINYINT() || *type == *VARCHAR();
+}
+
+// Returns the value of the constant side of 'expr' if 'expr' is an 'eqName'
+// call of an expression and a non-null constant. Sets 'value' to the
+// non-constant side.
+std::optional<variant> equalsConstant(
+    const std::string& eqName,
+    const core::TypedExprPtr& expr,
+    core::TypedExprPtr& value) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call == nullptr || call->name() != eqName ||
+      call->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  for (auto i = 0; i < 2; ++i) {
+    auto constant = std::dynamic_pointer_cast<const core::ConstantTypedExpr>(
+        call->inputs()[i]);
+    const auto& other = call->inputs()[1 - i];
+    if (constant == nullptr || constant->hasValueVector() ||
+        constant->value().isNull() || !isInListType(constant->type()) ||
+        *other->type() != *constant->type() ||
+        std::dynamic_pointer_cast<const core::ConstantTypedExpr>(other)) {
+      continue;
+    }
+    value = other;
+    return constant->value();
+  }
+  return std::nullopt;
+}
+} // namespace
+
+core::TypedExprPtr rewriteEqualsOrToIn(
+    const std::string& eqName,
+    const core::TypedExprPtr& expr) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call == nullptr || call->name() != "or") {
+    return nullptr;
+  }
+  std::vector<core::TypedExprPtr> inputs;
+  flattenOr(expr, inputs);
+
+  std::vector<core::TypedExprPtr> values(inputs.size());
+  std::vector<std::optional<variant>> constants(inputs.size());
+  for (auto i = 0; i < inputs.size(); ++i) {
+    constants[i] = equalsConstant(eqName, inputs[i], values[i]);
+  }
+
+  // The IN calls followed by the other inputs.
+  std::vector<core::TypedExprPtr> newInputs;
+  std::vector<bool> used(inputs.size(), false);
+  for (auto i = 0; i < inputs.size(); ++i) {
+    if (used[i] || !constants[i].has_value()) {
+      continue;
+    }
+    std::vector<int32_t> group = {i};
+    for (auto j = i + 1; j < inputs.size(); ++j) {
+      if (!used[j] && constants[j].has_value() && *values[j] == *values[i]) {
+        group.push_back(j);
+      }
+    }
+    if (group.size() < 2) {
+      continue;
+    }
+    std::vector<variant> inList;
+    inList.reserve(group.size());
+    for (auto j : group) {
+      used[j] = true;
+      inList.push_back(constants[j].value());
+    }
+    newInputs.push_back(std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(),
+        std::vector<core::TypedExprPtr>{
+            values[i],
+            std::make_shared<core::ConstantTypedExpr>(
+                ARRAY(values[i]->type()), variant::array(inList))},
+        "in"));
+  }
+  if (newInputs.empty()) {
+    return nullptr;
+  }
+  for (auto i = 0; i < inputs.size(); ++i) {
+    if (!used[i]) {
+      newInputs.push_back(inputs[i]);
+    }
+  }
+  if (newInputs.size() == 1) {
+    return newInputs[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(newInputs), "or");
+}
+
 VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
     udf_in,
     InPredicate::signatures(),
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/core/Expressions.h"
 #include "velox/functions/Macros.h"
 
 namespace facebook::velox::functions {
@@ -51,4 +52,14 @@ struct GenericInPredicateFunction {
   }
 };
 
+/// Rewrites 'x = c1 OR x = c2 ...' with non-null constants 'ci' of an integer
+/// or varchar type into 'x IN (c1, c2, ...)' that tests the values with a
+/// single range, bitmask or hash table filter. Equalities on other
+/// expressions are kept as OR inputs. 'eqName' is the name of the equality
+/// function. Returns nullptr if 'expr' has no two such equalities on the same
+/// expression.
+core::TypedExprPtr rewriteEqualsOrToIn(
+    const std::string& eqName,
+    const core::TypedExprPtr& expr);
+
 } // namespace facebook::velox::functions
@@ -50,7 +50,10 @@ void checkArraySizes(
 /// Populates indices of the n-th elements of the arrays.
 /// Selects 'row' in 'arrayRows' if corresponding array has an n-th element.
 /// Sets elementIndices[row] to the index of the n-th element in the 'elements'
-/// vector.
+/// vector. For n > 0, 'arrayRows' must be the result for n - 1: an array
+/// without an (n-1)th element has no n-th element either, so only the rows
+/// still selected are visited. Entries of 'elementIndices' for unselected rows
+/// are left as they are, which are valid indices from earlier steps or 0.
 /// Returns true if at least one array has n-th element.
 bool toNthElementRows(
     const ArrayVectorPtr& arrayVector,
@@ -64,17 +67,25 @@ bool toNthElementRows(
 
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
-  arrayRows.clearAll();
-  memset(rawElementIndices, 0, elementIndices->size());
-
-  rows.applyToSelected([&](auto row) {
-    if (!rawNulls || !bits::isBitNull(rawNulls, row)) {
+  if (n == 0) {
+    arrayRows.clearAll();
+    rows.applyToSelected([&](auto row) {
+      if (!rawNulls || !bits::isBitNull(rawNulls, row)) {
+        if (n < rawSizes[row]) {
+          arrayRows.setValid(row, true);
+          rawElementIndices[row] = rawOffsets[row] + n;
+        }
+      }
+    });
+  } else {
+    arrayRows.applyToSelected([&](auto row) {
       if (n < rawSizes[row]) {
-        arrayRows.setValid(row, true);
         rawElementIndices[row] = rawOffsets[row] + n;
+      } else {
+        arrayRows.setValid(row, false);
       }
-    }
-  });
+    });
+  }
   arrayRows.updateBounds();
 
   return arrayRows.hasSelections();
@@ -171,6 +171,16 @@ template <typename T>
 struct SIMDJsonExtractScalarFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Json>* /*json*/,
+      const arg_type<Varchar>* jsonPath) {
+    if (jsonPath != nullptr) {
+      extractor_ = detail::SIMDJsonExtractor::create(*jsonPath);
+    }
+  }
+
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Json>& json,
@@ -218,7 +228,11 @@ struct SIMDJsonExtractScalarFunction {
       return simdjson::SUCCESS;
     };
 
-    SIMDJSON_TRY(simdJsonExtract(json, jsonPath, consumer));
+    if (extractor_ != nullptr) {
+      SIMDJSON_TRY(simdJsonExtract(json, *extractor_, consumer));
+    } else {
+      SIMDJSON_TRY(simdJsonExtract(json, jsonPath, consumer));
+    }
 
     if (resultStr.has_value()) {
       result.copy_from(*resultStr);
@@ -227,12 +241,25 @@ struct SIMDJsonExtractScalarFunction {
       return simdjson::NO_SUCH_FIELD;
     }
   }
+
+  // Set in initialize() if the path is constant.
+  std::unique_ptr<detail::SIMDJsonExtractor> extractor_;
 };
 
 template <typename T>
 struct SIMDJsonExtractFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Json>* /*json*/,
+      const arg_type<Varchar>* jsonPath) {
+    if (jsonPath != nullptr) {
+      extractor_ = detail::SIMDJsonExtractor::create(*jsonPath);
+    }
+  }
+
   bool call(
       out_type<Json>& result,
       const arg_type<Json>& json,
@@ -284,7 +311,11 @@ struct SIMDJsonExtractFunction {
       return simdjson::SUCCESS;
     };
 
-    SIMDJSON_TRY(simdJsonExtract(json, jsonPath, consumer));
+    if (extractor_ != nullptr) {
+      SIMDJSON_TRY(simdJsonExtract(json, *extractor_, consumer));
+    } else {
+      SIMDJSON_TRY(simdJsonExtract(json, jsonPath, consumer));
+    }
 
     if (resultSize == 0) {
       // If the path didn't map to anything in the JSON object, return null.
@@ -301,12 +332,25 @@ struct SIMDJsonExtractFunction {
     }
     return simdjson::SUCCESS;
   }
+
+  // Set in initialize() if the path is constant.
+  std::unique_ptr<detail::SIMDJsonExtractor> extractor_;
 };
 
 template <typename T>
 struct SIMDJsonSizeFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  FOLLY_ALWAYS_INLINE void initialize(
+      const std::vector<TypePtr>& /*inputTypes*/,
+      const core::QueryConfig& /*config*/,
+      const arg_type<Json>* /*json*/,
+      const arg_type<Varchar>* jsonPath) {
+    if (jsonPath != nullptr) {
+      extractor_ = detail::SIMDJsonExtractor::create(*jsonPath);
+    }
+  }
+
   FOLLY_ALWAYS_INLINE bool call(
       int64_t& result,
       const arg_type<Json>& json,
@@ -349,7 +393,11 @@ struct SIMDJsonSizeFunction {
       return simdjson::SUCCESS;
     };
 
-    SIMDJSON_TRY(simdJsonExtract(json, jsonPath, consumer));
+    if (extractor_ != nullptr) {
+      SIMDJSON_TRY(simdJsonExtract(json, *extractor_, consumer));
+    } else {
+      SIMDJSON_TRY(simdJsonExtract(json, jsonPath, consumer));
+    }
 
     if (resultCount == 0) {
       // If the path didn't map to anything in the JSON object, return null.
@@ -360,6 +408,9 @@ struct SIMDJsonSizeFunction {
 
     return simdjson::SUCCESS;
   }
+
+  // Set in initialize() if the path is constant.
+  std::unique_ptr<detail::SIMDJsonExtractor> extractor_;
 };
 
 } // namespace facebook::velox::functions
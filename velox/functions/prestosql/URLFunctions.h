@@ -18,6 +18,7 @@
 #include <boost/regex.hpp>
 #include <cctype>
 #include <optional>
+#include <string_view>
 #include "velox/functions/Macros.h"
 #include "velox/functions/lib/string/StringImpl.h"
 
@@ -25,11 +26,6 @@ namespace facebook::velox::functions {
 
 namespace {
 
-const auto kScheme = 2;
-const auto kAuthority = 3;
-const auto kPath = 5;
-const auto kQuery = 7;
-const auto kFragment = 9;
 const auto kHost = 3; // From the authority and path regex.
 const auto kPort = 4; // From the authority and path regex.
 
@@ -38,54 +34,79 @@ FOLLY_ALWAYS_INLINE StringView submatch(const boost::cmatch& match, int idx) {
   return StringView(sub.first, sub.length());
 }
 
-bool parse(const char* rawUrlData, size_t rawUrlsize, boost::cmatch& match) {
-  /// This regex is taken from RFC - 3986.
-  /// See: https://www.rfc-editor.org/rfc/rfc3986#appendix-B
-  /// The basic groups are:
-  ///      scheme    = $2
-  ///      authority = $4
-  ///      path      = $5
-  ///      query     = $7
-  ///      fragment  = $9
-  /// For example a URI like below :
-  ///  http://www.ics.uci.edu/pub/ietf/uri/#Related
-  ///
-  ///   results in the following subexpression matches:
-  ///
-  ///      $1 = http:
-  ///      $2 = http
-  ///      $3 = //www.ics.uci.edu
-  ///      $4 = www.ics.uci.edu
-  ///      $5 = /pub/ietf/uri/
-  ///      $6 = <undefined>
-  ///      $7 = <undefined>
-  ///      $8 = #Related
-  ///      $9 = Related
-  static const boost::regex kUriRegex(
-      "^(([^:\\/?#]+):)?" // scheme:
-      "(\\/\\/([^\\/?#]*))?([^?#]*)" // authority and path
-      "(\\?([^#]*))?" // ?query
-      "(#(.*))?"); // #fragment
-
-  return boost::regex_match(
-      rawUrlData, rawUrlData + rawUrlsize, match, kUriRegex);
+/// The components of a URI as matched by the regex from RFC - 3986.
+/// See: https://www.rfc-editor.org/rfc/rfc3986#appendix-B
+///
+///   ^(([^:/?#]+):)?(//([^/?#]*))?([^?#]*)(\?([^#]*))?(#(.*))?
+///
+/// For example a URI like below :
+///  http://www.ics.uci.edu/pub/ietf/uri/#Related
+///
+///   results in the following components:
+///
+///      scheme    = http
+///      authority = //www.ics.uci.edu
+///      path      = /pub/ietf/uri/
+///      query     = <undefined>
+///      fragment  = Related
+///
+/// The authority includes the leading '//'. The path is always defined,
+/// possibly empty.
+struct UrlComponents {
+  std::optional<StringView> scheme;
+  std::optional<StringView> authority;
+  StringView path;
+  std::optional<StringView> query;
+  std::optional<StringView> fragment;
+};
+
+// Returns the first position in [begin, end) that has one of 'delimiters' or
+// 'end' if there is none.
+template <char... delimiters>
+FOLLY_ALWAYS_INLINE const char* findDelimiter(
+    const char* begin,
+    const char* end) {
+  for (; begin < end; ++begin) {
+    if (((*begin == delimiters) || ...)) {
+      break;
+    }
+  }
+  return begin;
 }
 
-/// Parses the url and returns the matching subgroup if the particular sub group
-/// is matched by the call to parse call above.
-std::optional<StringView> parse(StringView rawUrl, int subGroup) {
-  boost::cmatch match;
-  if (!parse(rawUrl.data(), rawUrl.size(), match)) {
-    return std::nullopt;
+/// Splits 'rawUrl' in a single pass with the same results as the regex above.
+/// Every string matches the regex.
+UrlComponents parse(StringView rawUrl) {
+  UrlComponents components;
+  const char* begin = rawUrl.data();
+  const char* const end = begin + rawUrl.size();
+
+  const char* delimiter = findDelimiter<':', '/', '?', '#'>(begin, end);
+  if (delimiter != begin && delimiter < end && *delimiter == ':') {
+    components.scheme = StringView(begin, delimiter - begin);
+    begin = delimiter + 1;
+  }
+
+  if (end - begin >= 2 && begin[0] == '/' && begin[1] == '/') {
+    delimiter = findDelimiter<'/', '?', '#'>(begin + 2, end);
+    components.authority = StringView(begin, delimiter - begin);
+    begin = delimiter;
   }
 
-  VELOX_CHECK_LT(subGroup, match.size());
+  delimiter = findDelimiter<'?', '#'>(begin, end);
+  components.path = StringView(begin, delimiter - begin);
+  begin = delimiter;
 
-  if (match[subGroup].matched) {
-    return submatch(match, subGroup);
+  if (begin < end && *begin == '?') {
+    delimiter = findDelimiter<'#'>(begin + 1, end);
+    components.query = StringView(begin + 1, delimiter - begin - 1);
+    begin = delimiter;
   }
 
-  return std::nullopt;
+  if (begin < end) {
+    components.fragment = StringView(begin + 1, end - begin - 1);
+  }
+  return components;
 }
 
 FOLLY_ALWAYS_INLINE unsigned char toHex(unsigned char c) {
@@ -164,6 +185,13 @@ bool isValidURI(StringView input) {
   return true;
 }
 
+// Returns true if 'input' has characters that urlUnescape replaces.
+template <typename TInString>
+FOLLY_ALWAYS_INLINE bool needsUrlUnescape(const TInString& input) {
+  return std::string_view(input.data(), input.size()).find_first_of("%+") !=
+      std::string_view::npos;
+}
+
 template <typename TOutString, typename TInString>
 FOLLY_ALWAYS_INLINE void urlUnescape(
     TOutString& output,
@@ -229,7 +257,7 @@ struct UrlExtractProtocolFunction {
       return false;
     }
 
-    if (auto protocol = parse(url, kScheme)) {
+    if (auto protocol = parse(url).scheme) {
       result.setNoCopy(protocol.value());
     } else {
       result.setEmpty();
@@ -255,7 +283,7 @@ struct UrlExtractFragmentFunction {
       return false;
     }
 
-    if (auto fragment = parse(url, kFragment)) {
+    if (auto fragment = parse(url).fragment) {
       result.setNoCopy(fragment.value());
     } else {
       result.setEmpty();
@@ -281,7 +309,7 @@ struct UrlExtractHostFunction {
       return false;
     }
 
-    auto authAndPath = parse(url, kAuthority);
+    auto authAndPath = parse(url).authority;
     if (!authAndPath) {
       result.setEmpty();
       return true;
@@ -307,7 +335,7 @@ struct UrlExtractPortFunction {
       return false;
     }
 
-    auto authAndPath = parse(url, kAuthority);
+    auto authAndPath = parse(url).authority;
     if (!authAndPath) {
       return false;
     }
@@ -331,6 +359,9 @@ template <typename T>
 struct UrlExtractPathFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  // Results without escapes refer to strings in the first argument.
+  static constexpr int32_t reuse_strings_from_arg = 0;
+
   // Input is always ASCII, but result may or may not be ASCII.
 
   FOLLY_ALWAYS_INLINE bool call(
@@ -340,10 +371,12 @@ struct UrlExtractPathFunction {
       return false;
     }
 
-    auto path = parse(url, kPath);
-    VELOX_USER_CHECK(
-        path.has_value(), "Unable to determine path for URL: {}", url);
-    urlUnescape(result, path.value());
+    auto path = parse(url).path;
+    if (!needsUrlUnescape(path)) {
+      result.setNoCopy(path);
+      return true;
+    }
+    urlUnescape(result, path);
 
     return true;
   }
@@ -366,7 +399,7 @@ struct UrlExtractQueryFunction {
       return false;
     }
 
-    if (auto query = parse(url, kQuery)) {
+    if (auto query = parse(url).query) {
       result.setNoCopy(query.value());
     } else {
       result.setEmpty();
@@ -394,7 +427,7 @@ struct UrlExtractParameterFunction {
       return false;
     }
 
-    auto query = parse(url, kQuery);
+    auto query = parse(url).query;
     if (!query) {
       return false;
     }
@@ -446,9 +479,16 @@ template <typename T>
 struct UrlDecodeFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  // Results without escapes refer to strings in the first argument.
+  static constexpr int32_t reuse_strings_from_arg = 0;
+
   FOLLY_ALWAYS_INLINE void call(
       out_type<Varchar>& result,
       const arg_type<Varbinary>& input) {
+    if (!needsUrlUnescape(input)) {
+      result.setNoCopy(input);
+      return;
+    }
     urlUnescape(result, input);
   }
 };
@@ -54,6 +54,18 @@ struct HllAccumulator {
     }
   }
 
+  void append(const uint64_t* hashes, int32_t count) {
+    int32_t i = 0;
+    for (; isSparse_ && i < count; ++i) {
+      if (sparseHll_.insertHash(hashes[i])) {
+        toDense();
+      }
+    }
+    if (i < count) {
+      denseHll_.insertHashes(hashes + i, count - i);
+    }
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -269,18 +281,22 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     } else {
       decodeArguments(rows, args);
 
+      // Hashes all the values first and then updates the HLL in one batch.
+      hashes_.resize(rows.countSelected());
+      int32_t numHashes = 0;
       rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
+        if (!decodedValue_.isNullAt(row)) {
+          hashes_[numHashes++] = hashOne(decodedValue_.valueAt<T>(row));
         }
-
-        auto accumulator = value<HllAccumulator>(group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
       });
+      if (numHashes == 0) {
+        return;
+      }
+
+      auto accumulator = value<HllAccumulator>(group);
+      clearNull(group);
+      accumulator->setIndexBitLength(indexBitLength_);
+      accumulator->append(hashes_.data(), numHashes);
     }
   }
 
@@ -423,6 +439,8 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+  // Hashes of the non-null input values of one batch for a single group.
+  std::vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
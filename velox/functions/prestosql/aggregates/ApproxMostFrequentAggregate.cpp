@@ -36,6 +36,10 @@ struct Accumulator {
   void insert(T value, int64_t count = 1) {
     summary.insert(value, count);
   }
+
+  void insert(const T* values, const int64_t* counts, int numValues) {
+    summary.insert(values, counts, numValues);
+  }
 };
 
 template <>
@@ -61,6 +65,12 @@ struct Accumulator<StringView> {
     }
     summary.insert(value, count);
   }
+
+  void insert(const StringView* values, const int64_t* counts, int numValues) {
+    summary.insert(values, counts, numValues, [&](StringView value) {
+      return value.isInline() ? value : strings.append(value, *allocator);
+    });
+  }
 };
 
 template <typename T>
@@ -78,12 +88,30 @@ struct ApproxMostFrequentAggregate : exec::Aggregate {
       const std::vector<VectorPtr>& args,
       bool) override {
     decodeArguments(rows, args);
+    // Consecutive rows with the same group and value are inserted once with
+    // their count.
+    char* runGroup = nullptr;
+    T runValue{};
+    int64_t runCount = 0;
     rows.applyToSelected([&](auto row) {
-      if (!decodedValues_.isNullAt(row)) {
-        auto* accumulator = initAccumulator(groups[row]);
-        accumulator->insert(decodedValues_.valueAt<T>(row));
+      if (decodedValues_.isNullAt(row)) {
+        return;
+      }
+      auto value = decodedValues_.valueAt<T>(row);
+      if (runCount > 0 && groups[row] == runGroup && value == runValue) {
+        ++runCount;
+        return;
+      }
+      if (runCount > 0) {
+        initAccumulator(runGroup)->insert(runValue, runCount);
       }
+      runGroup = groups[row];
+      runValue = value;
+      runCount = 1;
     });
+    if (runCount > 0) {
+      initAccumulator(runGroup)->insert(runValue, runCount);
+    }
   }
 
   void addIntermediateResults(
@@ -101,11 +129,25 @@ struct ApproxMostFrequentAggregate : exec::Aggregate {
       bool) override {
     decodeArguments(rows, args);
     auto* accumulator = initAccumulator(group);
+    // Counts the distinct values of the batch before updating the summary.
+    batchIndices_.clear();
+    batchValues_.clear();
+    batchCounts_.clear();
     rows.applyToSelected([&](auto row) {
-      if (!decodedValues_.isNullAt(row)) {
-        accumulator->insert(decodedValues_.valueAt<T>(row));
+      if (decodedValues_.isNullAt(row)) {
+        return;
+      }
+      auto [it, inserted] = batchIndices_.try_emplace(
+          decodedValues_.valueAt<T>(row), batchValues_.size());
+      if (inserted) {
+        batchValues_.push_back(it->first);
+        batchCounts_.push_back(1);
+      } else {
+        ++batchCounts_[it->second];
       }
     });
+    accumulator->insert(
+        batchValues_.data(), batchCounts_.data(), batchValues_.size());
   }
 
   void addSingleGroupIntermediateResults(
@@ -299,11 +341,10 @@ struct ApproxMostFrequentAggregate : exec::Aggregate {
       }
       auto size = values->sizeAt(i);
       VELOX_DCHECK_EQ(counts->sizeAt(i), size);
-      auto vo = values->offsetAt(i);
-      auto co = counts->offsetAt(i);
-      for (int j = 0; j < size; ++j) {
-        accumulator->insert(v->valueAt(vo + j), c->valueAt(co + j));
-      }
+      accumulator->insert(
+          v->rawValues() + values->offsetAt(i),
+          c->rawValues() + counts->offsetAt(i),
+          size);
     });
   }
 
@@ -326,6 +367,11 @@ struct ApproxMostFrequentAggregate : exec::Aggregate {
 
   static constexpr int64_t kMissingArgument = -1;
   DecodedVector decodedValues_;
+  // Distinct values of the batch in addSingleGroupRawInput() with their
+  // counts, in order of first occurrence.
+  folly::F14FastMap<T, int32_t> batchIndices_;
+  std::vector<T> batchValues_;
+  std::vector<int64_t> batchCounts_;
   int64_t buckets_ = kMissingArgument;
   int64_t capacity_ = kMissingArgument;
 };
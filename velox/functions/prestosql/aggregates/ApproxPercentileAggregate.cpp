@@ -52,6 +52,10 @@ struct KllSketchAccumulator {
     sketch_.insert(value);
   }
 
+  void append(const T* values, size_t count) {
+    sketch_.insert(values, count);
+  }
+
   void append(T value, int64_t count) {
     constexpr size_t kMaxBufferSize = 4096;
     constexpr int64_t kMinCountToBuffer = 512;
@@ -377,20 +381,22 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         checkWeight(weight);
         accumulator->append(value, weight);
       });
+    } else if (
+        decodedValue_.isIdentityMapping() && !decodedValue_.mayHaveNulls() &&
+        rows.isAllSelected()) {
+      accumulator->append(
+          decodedValue_.data<T>() + rows.begin(), rows.end() - rows.begin());
     } else {
-      if (decodedValue_.mayHaveNulls()) {
-        rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
-          }
-
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      } else {
-        rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      }
+      // Gathers the non-null values to insert them into the sketch in one
+      // batch.
+      values_.resize(rows.countSelected());
+      size_t numValues = 0;
+      rows.applyToSelected([&](auto row) {
+        if (!decodedValue_.isNullAt(row)) {
+          values_[numValues++] = decodedValue_.valueAt<T>(row);
+        }
+      });
+      accumulator->append(values_.data(), numValues);
     }
   }
 
@@ -640,6 +646,8 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   DecodedVector decodedWeight_;
   DecodedVector decodedAccuracy_;
   DecodedVector decodedDigest_;
+  // Non-null input values of one batch for a single group.
+  std::vector<T> values_;
 
  private:
   template <bool kSingleGroup, bool checkIntermediateInputs>
@@ -125,6 +125,48 @@ class ArrayAggAggregate : public exec::Aggregate {
     extractValues(groups, numGroups, result);
   }
 
+  bool supportsSpillParts() const override {
+    return true;
+  }
+
+  void extractSpillParts(
+      char* group,
+      int64_t maxBytes,
+      VectorPtr& result,
+      const std::function<void()>& flush) override {
+    auto vector = result->as<ArrayVector>();
+    VELOX_CHECK(vector);
+    vector->resize(1);
+
+    auto& values = value<ArrayAccumulator>(group)->elements;
+    const vector_size_t arraySize = values.size();
+    if (arraySize == 0) {
+      vector->setNull(0, true);
+      flush();
+      return;
+    }
+
+    // Splits the values in parts of equal count, based on the average size of
+    // a value.
+    const vector_size_t partSize = std::clamp<int64_t>(
+        arraySize * maxBytes / std::max<int32_t>(1, values.bytes()),
+        1,
+        arraySize);
+    ValueListReader reader(values);
+    auto& elements = vector->elements();
+    for (vector_size_t start = 0; start < arraySize; start += partSize) {
+      const auto numValues = std::min(partSize, arraySize - start);
+      // Drops the string buffers of the previous part.
+      BaseVector::prepareForReuse(elements, numValues);
+      for (auto index = 0; index < numValues; ++index) {
+        reader.next(*elements, index);
+      }
+      vector->setNull(0, false);
+      vector->setOffsetAndSize(0, 0, numValues);
+      flush();
+    }
+  }
+
   void addRawInput(
       char** groups,
       const SelectivityVector& rows,
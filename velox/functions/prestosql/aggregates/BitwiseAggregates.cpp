@@ -49,11 +49,11 @@ class BitwiseOrAggregate : public BitwiseAggregateBase<T> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
-    SimpleNumericAggregate<T, T, T>::updateOneGroup(
+    SimpleNumericAggregate<T, T, T>::reduceOneGroup(
         group,
         rows,
         args[0],
-        [](T& result, T value) { result |= value; },
+        [](auto result, auto value) { return result | value; },
         [](T& result, T value, int /* unused */
         ) { result |= value; },
         mayPushdown,
@@ -87,11 +87,11 @@ class BitwiseAndAggregate : public BitwiseAggregateBase<T> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
-    SimpleNumericAggregate<T, T, T>::template updateOneGroup(
+    SimpleNumericAggregate<T, T, T>::reduceOneGroup(
         group,
         rows,
         args[0],
-        [](T& result, T value) { result &= value; },
+        [](auto result, auto value) { return result & value; },
         [](T& result, T value, int /* unused */
         ) { result &= value; },
         mayPushdown,
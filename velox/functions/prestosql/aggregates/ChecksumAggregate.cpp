@@ -17,6 +17,7 @@
 #define XXH_INLINE_ALL
 #include <xxhash.h>
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/expression/FunctionSignature.h"
 #include "velox/functions/prestosql/aggregates/AggregateNames.h"
@@ -149,19 +150,38 @@ class ChecksumAggregate : public exec::Aggregate {
       return;
     }
 
+    if (!rows.hasSelections()) {
+      return;
+    }
+
     auto hasher = getPrestoHasher(arg->type());
     auto hashes = getHashBuffer(rows.end(), arg->pool());
     hasher->hash(arg, rows, hashes);
-    auto rawHashes = hashes->as<int64_t>();
-
-    rows.applyToSelected([&](vector_size_t row) {
-      clearNull(group);
-      if (arg->isNullAt(row)) {
-        computeHashForNull(group);
-      } else {
-        computeHash(group, rawHashes[row]);
+    auto rawHashes = hashes->as<uint64_t>();
+
+    // The checksum is the sum of the hashes of the rows times a prime, so the
+    // hashes are summed first and multiplied once. A null row counts as a
+    // hash of 1.
+    uint64_t sum = 0;
+    if (!arg->mayHaveNulls() && rows.isAllSelected()) {
+      using Batch = xsimd::batch<uint64_t>;
+      auto batchSum = Batch::broadcast(0);
+      auto row = rows.begin();
+      for (; row + static_cast<vector_size_t>(Batch::size) <= rows.end();
+           row += Batch::size) {
+        batchSum += Batch::load_unaligned(rawHashes + row);
       }
-    });
+      sum = xsimd::reduce_add(batchSum);
+      for (; row < rows.end(); ++row) {
+        sum += rawHashes[row];
+      }
+    } else {
+      rows.applyToSelected([&](vector_size_t row) {
+        sum += arg->isNullAt(row) ? 1 : rawHashes[row];
+      });
+    }
+    clearNull(group);
+    *value<uint64_t>(group) += sum * XXH_PRIME64_1;
   }
 
   void addSingleGroupIntermediateResults(
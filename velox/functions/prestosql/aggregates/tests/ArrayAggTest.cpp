@@ -123,6 +123,32 @@ TEST_F(ArrayAggTest, groupBy) {
   testFunction("simple_array_agg", false);
 }
 
+TEST_F(ArrayAggTest, spillLargeGroups) {
+  // A few groups whose accumulators are each larger than one spill batch. The
+  // spiller writes these in several parts that are merged on read.
+  constexpr int32_t kNumGroups = 3;
+  constexpr int32_t kBatchSize = 10'000;
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            kBatchSize, [](auto row) { return row % kNumGroups; }),
+        makeFlatVector<int64_t>(
+            kBatchSize,
+            [i](auto row) { return i * kBatchSize + row; },
+            [](auto row) { return row % 17 == 0; }),
+    }));
+  }
+
+  createDuckDbTable(batches);
+  testAggregations(
+      batches,
+      {"c0"},
+      {"array_agg(c1)"},
+      {"c0", "array_sort(a0)"},
+      "SELECT c0, array_sort(array_agg(c1)) FROM tmp GROUP BY c0");
+}
+
 TEST_F(ArrayAggTest, sortedGroupBy) {
   auto testFunction = [this](const std::string& functionName) {
     auto data = makeRowVector({
@@ -116,5 +116,45 @@ TEST_F(BitwiseAggregationTest, bitwiseXor) {
       "SELECT c0 % 10, bit_xor(c1), bit_xor(c2), bit_xor(c3), bit_xor(c4) FROM tmp GROUP BY 1");
 }
 
+TEST_F(BitwiseAggregationTest, globalFlatInput) {
+  // Flat inputs of a global aggregation are reduced a batch at a time. The
+  // input has full words of rows without nulls, words with some nulls and a
+  // partial last word.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int8_t>(
+            1'000, [&](auto row) { return ~(1 << ((row + i) % 7)); }),
+        makeFlatVector<int16_t>(
+            1'000,
+            [&](auto row) { return 1 << ((row + i) % 15); },
+            [](auto row) { return row >= 200 && row % 3 == 0; }),
+        makeFlatVector<int32_t>(
+            1'000, [&](auto row) { return row * 7 + i; }, nullEvery(11)),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (row + i) * 0x123456789LL; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto& [function, duckDbFunction] :
+       std::vector<std::pair<std::string, std::string>>{
+           {"bitwise_or_agg", "bit_or"},
+           {"bitwise_and_agg", "bit_and"},
+           {"bitwise_xor_agg", "bit_xor"}}) {
+    std::vector<std::string> aggregates;
+    std::vector<std::string> duckDbAggregates;
+    for (auto i = 0; i < 4; ++i) {
+      aggregates.push_back(fmt::format("{}(c{})", function, i));
+      duckDbAggregates.push_back(fmt::format("{}(c{})", duckDbFunction, i));
+    }
+    testAggregations(
+        vectors,
+        {},
+        aggregates,
+        fmt::format("SELECT {} FROM tmp", folly::join(", ", duckDbAggregates)));
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::aggregate::test
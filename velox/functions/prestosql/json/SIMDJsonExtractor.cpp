@@ -16,6 +16,8 @@
 
 #include "velox/functions/prestosql/json/SIMDJsonExtractor.h"
 
+#include <cstring>
+
 namespace facebook::velox::functions::detail {
 /* static */ SIMDJsonExtractor& SIMDJsonExtractor::getInstance(
     folly::StringPiece path) {
@@ -42,6 +44,40 @@ namespace facebook::velox::functions::detail {
   return *it.first->second;
 }
 
+/* static */ std::unique_ptr<SIMDJsonExtractor> SIMDJsonExtractor::create(
+    folly::StringPiece path) {
+  return std::unique_ptr<SIMDJsonExtractor>(
+      new SIMDJsonExtractor(folly::trimWhitespace(path).str()));
+}
+
+namespace {
+struct ExtractionParser {
+  simdjson::ondemand::parser parser;
+  // Copy of the last parsed input. The document refers to it.
+  simdjson::padded_string json;
+  simdjson::ondemand::document document;
+  bool valid{false};
+};
+} // namespace
+
+simdjson::error_code parseForExtraction(
+    const velox::StringView& json,
+    simdjson::ondemand::document*& document) {
+  thread_local ExtractionParser state;
+  if (state.valid && state.json.size() == json.size() &&
+      std::memcmp(state.json.data(), json.data(), json.size()) == 0) {
+    state.document.rewind();
+    document = &state.document;
+    return simdjson::SUCCESS;
+  }
+  state.valid = false;
+  state.json = simdjson::padded_string(json.data(), json.size());
+  SIMDJSON_ASSIGN_OR_RAISE(state.document, state.parser.iterate(state.json));
+  state.valid = true;
+  document = &state.document;
+  return simdjson::SUCCESS;
+}
+
 bool SIMDJsonExtractor::tokenize(const std::string& path) {
   thread_local static JsonPathTokenizer tokenizer;
 
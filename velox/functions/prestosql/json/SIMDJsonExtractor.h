@@ -55,6 +55,10 @@ class SIMDJsonExtractor {
   // simdJsonExtract.
   static SIMDJsonExtractor& getInstance(folly::StringPiece path);
 
+  // Returns an extractor for 'path' owned by the caller. Used by functions
+  // with a constant path to tokenize the path once instead of for each row.
+  static std::unique_ptr<SIMDJsonExtractor> create(folly::StringPiece path);
+
  private:
   // Shouldn't instantiate directly - use getInstance().
   explicit SIMDJsonExtractor(const std::string& path) {
@@ -71,6 +75,15 @@ class SIMDJsonExtractor {
   std::vector<std::string> tokens_;
 };
 
+// Sets 'document' to the parsed 'json'. Uses a thread local parser reserved
+// for path extraction. If 'json' is equal to the input of the previous call,
+// the document of that call is rewound instead of parsing 'json' again. This
+// way several extractions from the same JSON, e.g. json_extract_scalar calls
+// with different paths over one column, index each row once.
+simdjson::error_code parseForExtraction(
+    const velox::StringView& json,
+    simdjson::ondemand::document*& document);
+
 simdjson::error_code extractObject(
     simdjson::ondemand::value& jsonObj,
     const std::string& key,
@@ -149,24 +162,32 @@ simdjson::error_code SIMDJsonExtractor::extract(
 template <typename TConsumer>
 simdjson::error_code simdJsonExtract(
     const velox::StringView& json,
-    const velox::StringView& path,
+    detail::SIMDJsonExtractor& extractor,
     TConsumer&& consumer) {
-  // If extractor fails to parse the path, this will throw a VeloxUserError, and
-  // we want to let this exception bubble up to the client.
-  auto& extractor = detail::SIMDJsonExtractor::getInstance(path);
-  simdjson::padded_string paddedJson(json.data(), json.size());
-  SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
+  simdjson::ondemand::document* jsonDoc;
+  SIMDJSON_TRY(detail::parseForExtraction(json, jsonDoc));
 
   if (extractor.isRootOnlyPath()) {
     // If the path is just to return the original object, call consumer on the
     // document.  Note, we cannot convert this to a value as this is not
     // supported if the object is a scalar.
-    return consumer(jsonDoc);
+    return consumer(*jsonDoc);
   }
-  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
+  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc->get_value());
   return extractor.extract(value, std::forward<TConsumer>(consumer));
 }
 
+template <typename TConsumer>
+simdjson::error_code simdJsonExtract(
+    const velox::StringView& json,
+    const velox::StringView& path,
+    TConsumer&& consumer) {
+  // If extractor fails to parse the path, this will throw a VeloxUserError, and
+  // we want to let this exception bubble up to the client.
+  auto& extractor = detail::SIMDJsonExtractor::getInstance(path);
+  return simdJsonExtract(json, extractor, std::forward<TConsumer>(consumer));
+}
+
 template <typename TConsumer>
 simdjson::error_code simdJsonExtract(
     const std::string& json,
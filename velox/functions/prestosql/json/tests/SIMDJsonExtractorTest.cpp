@@ -536,4 +536,50 @@ TEST_F(SIMDJsonExtractorTest, invalidJson) {
   json = "{\"foo\": [\"bar\", \"baz]}";
   EXPECT_NE(simdJsonExtract(json, "$.foo[0]", consumer), simdjson::SUCCESS);
 }
+
+TEST_F(SIMDJsonExtractorTest, constantPath) {
+  using facebook::velox::StringView;
+  using facebook::velox::functions::detail::SIMDJsonExtractor;
+
+  auto a = SIMDJsonExtractor::create("$.a");
+  auto c = SIMDJsonExtractor::create(" $.b.c ");
+  auto root = SIMDJsonExtractor::create("$");
+  ASSERT_TRUE(root->isRootOnlyPath());
+  EXPECT_THROW(SIMDJsonExtractor::create("$.a."), VeloxUserError);
+
+  std::string result;
+  auto consumer = [&result](auto& v) {
+    SIMDJSON_ASSIGN_OR_RAISE(auto jsonStr, simdjson::to_json_string(v));
+    result = jsonStr;
+    return simdjson::SUCCESS;
+  };
+  auto extract = [&](const std::string& json, SIMDJsonExtractor& extractor) {
+    result.clear();
+    EXPECT_EQ(
+        simdJsonExtract(StringView(json), extractor, consumer),
+        simdjson::SUCCESS);
+    return result;
+  };
+
+  // Several paths over the same JSON reuse its parsed document.
+  std::string json = R"({"a": 1, "b": {"c": [2, 3]}})";
+  EXPECT_EQ("1", extract(json, *a));
+  EXPECT_EQ("[2,3]", extract(json, *c));
+  EXPECT_EQ("1", extract(json, *a));
+  EXPECT_EQ(R"({"a":1,"b":{"c":[2,3]}})", extract(json, *root));
+
+  // A different JSON of the same size is parsed again.
+  std::string other = R"({"a": 4, "b": {"c": [5, 6]}})";
+  EXPECT_EQ("4", extract(other, *a));
+  EXPECT_EQ("[5,6]", extract(other, *c));
+  EXPECT_EQ("[2,3]", extract(json, *c));
+
+  // Invalid JSON fails on every extraction.
+  std::string invalid = R"({"a": 1, "b})";
+  for (auto i = 0; i < 2; ++i) {
+    EXPECT_NE(
+        simdJsonExtract(StringView(invalid), *a, consumer), simdjson::SUCCESS);
+  }
+  EXPECT_EQ("1", extract(json, *a));
+}
 } // namespace
@@ -59,6 +59,9 @@ void registerGeneralFunctions(const std::string& prefix) {
       {prefix + "cardinality"});
 
   registerAllSpecialFormGeneralFunctions();
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteEqualsOrToIn(prefix + "eq", expr);
+  });
 }
 
 } // namespace facebook::velox::functions
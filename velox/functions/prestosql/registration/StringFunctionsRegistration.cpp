@@ -118,6 +118,9 @@ void registerStringFunctions(const std::string& prefix) {
       makeRe2ExtractAll);
   exec::registerStatefulVectorFunction(
       prefix + "regexp_like", re2SearchSignatures(), makeRe2Search);
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteRegexpLikeOr(prefix + "regexp_like", expr);
+  });
 
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar>(
       {prefix + "strpos"});
@@ -230,6 +230,24 @@ TEST_F(DecimalArithmeticTest, subtract) {
       "Decimal overflow: 1 - -99999999999999999999999999999999999999");
 }
 
+TEST_F(DecimalArithmeticTest, shortResultWithRescale) {
+  // Short decimal results are computed in 64 bits.
+  auto a = makeFlatVector<int64_t>({-12345, 99, 0}, DECIMAL(10, 1));
+  auto b = makeFlatVector<int64_t>({10001, -5, -99999999}, DECIMAL(12, 4));
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>({-12334999, 98995, -99999999}, DECIMAL(14, 4)),
+      "c0 + c1",
+      {a, b});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>({-12355001, 99005, 99999999}, DECIMAL(14, 4)),
+      "c0 - c1",
+      {a, b});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>({12355001, -99005, -99999999}, DECIMAL(14, 4)),
+      "c1 - c0",
+      {a, b});
+}
+
 TEST_F(DecimalArithmeticTest, multiply) {
   auto shortFlat = makeFlatVector<int64_t>({1000, 2000}, DECIMAL(17, 3));
   // Multiply short and short, returning long.
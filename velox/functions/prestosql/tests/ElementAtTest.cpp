@@ -668,6 +668,69 @@ TEST_F(ElementAtTest, variableInputMap) {
   testVariableInputMap<StringView>(); // VARCHAR
 }
 
+TEST_F(ElementAtTest, wideMap) {
+  // Maps with 40 keys each. In 'sameOrder' every map has its keys in the same
+  // order, like a struct. In 'rotated' the keys of each map are rotated by the
+  // row number. Odd keys between 1 and 79 are present.
+  const vector_size_t kNumKeys = 40;
+  auto sizeAt = [&](vector_size_t /*row*/) { return kNumKeys; };
+  auto valueAt = [](vector_size_t idx) { return idx; };
+  auto sameOrder = makeMapVector<int64_t, int64_t>(
+      kVectorSize,
+      sizeAt,
+      [&](vector_size_t idx) { return 1 + 2 * (idx % kNumKeys); },
+      valueAt);
+  auto rotated = makeMapVector<int64_t, int64_t>(
+      kVectorSize,
+      sizeAt,
+      [&](vector_size_t idx) {
+        const auto row = idx / kNumKeys;
+        return 1 + 2 * ((idx + row) % kNumKeys);
+      },
+      valueAt);
+
+  // Position of odd 'key' in the map at 'row'.
+  auto sameOrderPosition = [&](vector_size_t row, int64_t key) {
+    return row * kNumKeys + (key - 1) / 2;
+  };
+  auto rotatedPosition = [&](vector_size_t row, int64_t key) {
+    const auto index = (key - 1) / 2;
+    return row * kNumKeys + (index - row % kNumKeys + kNumKeys) % kNumKeys;
+  };
+
+  testElementAt<int64_t>(
+      "element_at(c0, 17)", {sameOrder}, [&](vector_size_t row) {
+        return sameOrderPosition(row, 17);
+      });
+  testElementAt<int64_t>(
+      "element_at(c0, 17)", {rotated}, [&](vector_size_t row) {
+        return rotatedPosition(row, 17);
+      });
+  testElementAt<int64_t>(
+      "element_at(c0, 18)",
+      {rotated},
+      [](vector_size_t /*row*/) { return 0; },
+      [](vector_size_t /*row*/) { return true; });
+
+  // Variable keys. Even keys are missing.
+  auto keys = makeFlatVector<int64_t>(
+      kVectorSize, [](vector_size_t row) { return row % 83; });
+  auto isMissing = [](vector_size_t row) {
+    const auto key = row % 83;
+    return key % 2 == 0 || key > 79;
+  };
+  testElementAt<int64_t>(
+      "element_at(c0, c1)",
+      {sameOrder, keys},
+      [&](vector_size_t row) { return sameOrderPosition(row, row % 83); },
+      isMissing);
+  testElementAt<int64_t>(
+      "element_at(c0, c1)",
+      {rotated, keys},
+      [&](vector_size_t row) { return rotatedPosition(row, row % 83); },
+      isMissing);
+}
+
 TEST_F(ElementAtTest, timestampAsKey) {
   const auto keyVector = makeFlatVector<Timestamp>(
       {Timestamp(1991, 0),
@@ -490,6 +490,42 @@ TEST_F(InPredicateTest, reusableResult) {
   assertEqualVectors(expected, actual);
 }
 
+TEST_F(InPredicateTest, largeInListBatches) {
+  // A large IN list tested a SIMD batch at a time.
+  std::vector<std::optional<int64_t>> values;
+  for (auto i = 0; i < 2'000; ++i) {
+    values.push_back(i * 7);
+  }
+  const vector_size_t size = 1'003;
+  auto test = [&](const auto& vector) {
+    SCOPED_TRACE(vector->type()->toString());
+    auto input = makeRowVector({vector});
+    auto predicate = fmt::format("c0 IN ({})", getInList<int64_t>(values));
+
+    auto result = evaluate<SimpleVector<bool>>(predicate, input);
+    auto expected = makeFlatVector<bool>(
+        size, [](auto row) { return (row * 3) % 7 == 0; });
+    assertEqualVectors(expected, result);
+
+    // Rows that are not selected keep their previous results.
+    SelectivityVector rows(size);
+    for (auto row = 0; row < size; row += 3) {
+      rows.setValid(row, false);
+    }
+    rows.setValid(size - 1, false);
+    rows.updateBounds();
+    VectorPtr reused = makeFlatVector<bool>(size, [](auto) { return true; });
+    result = evaluate<SimpleVector<bool>>(predicate, input, rows, reused);
+    expected = makeFlatVector<bool>(size, [&](auto row) {
+      return !rows.isValid(row) || (row * 3) % 7 == 0;
+    });
+    assertEqualVectors(expected, result);
+  };
+  test(makeFlatVector<int64_t>(size, [](auto row) { return row * 3; }));
+  test(makeFlatVector<int32_t>(size, [](auto row) { return row * 3; }));
+  test(makeFlatVector<int16_t>(size, [](auto row) { return row * 3; }));
+}
+
 TEST_F(InPredicateTest, doubleWithZero) {
   // zero and negative zero, FloatingPointRange
   auto input = makeRowVector({
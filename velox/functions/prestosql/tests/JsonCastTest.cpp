@@ -1053,6 +1053,32 @@ TEST_F(JsonCastTest, toRowOfArray) {
   testCast(data, expected);
 }
 
+TEST_F(JsonCastTest, toArrayOfRow) {
+  // The field lookup of the row type is shared by all elements of all rows.
+  // Each element must see its own fields only.
+  auto data = makeFlatVector<std::string>(
+      {
+          R"([{"a": 1, "B": "x"}, {"b": "y"}])",
+          R"([{"A": 3}])",
+          R"([])",
+          R"([{"b": "z", "a": 4}, {"a": null, "b": "w"}, {}])",
+      },
+      JSON());
+
+  auto expected = makeArrayVector(
+      {0, 2, 3, 3},
+      makeRowVector(
+          {"a", "b"},
+          {
+              makeNullableFlatVector<int64_t>(
+                  {1, std::nullopt, 3, 4, std::nullopt, std::nullopt}),
+              makeNullableFlatVector<std::string>(
+                  {"x", "y", std::nullopt, "z", "w", std::nullopt}),
+          }));
+
+  testCast(data, expected);
+}
+
 TEST_F(JsonCastTest, toRowDuplicateKey) {
   std::vector<std::optional<std::string>> jsonStrings = {
       R"({"c0": 1, "c1": 1.1})",
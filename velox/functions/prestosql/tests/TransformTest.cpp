@@ -197,3 +197,40 @@ TEST_F(TransformTest, try) {
   });
   assertEqualVectors(expectedResult, result);
 }
+
+TEST_F(TransformTest, constantCapture) {
+  // Constant captures are passed to the lambda without a dictionary that maps
+  // elements to top-level rows.
+  vector_size_t size = 1'000;
+  auto input = makeRowVector({
+      makeArrayVector<int64_t>(size, modN(5), modN(7), nullEvery(11)),
+      makeConstant<int64_t>(10, size),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+  });
+
+  auto result = evaluate<ArrayVector>("transform(c0, x -> x + c1)", input);
+  auto expectedResult = makeArrayVector<int64_t>(
+      size,
+      modN(5),
+      [](vector_size_t row) { return row % 7 + 10; },
+      nullEvery(11));
+  assertEqualVectors(expectedResult, result);
+
+  // A constant and a non-constant capture.
+  result = evaluate<ArrayVector>("transform(c0, x -> x + c1 + c2)", input);
+  expectedResult = makeArrayVector<int64_t>(
+      size,
+      modN(5),
+      [](vector_size_t row) { return row % 7 + 10; },
+      nullEvery(11));
+  auto* offsets = expectedResult->rawOffsets();
+  auto* sizes = expectedResult->rawSizes();
+  auto* elements = expectedResult->elements()->asFlatVector<int64_t>();
+  for (auto row = 0; row < size; ++row) {
+    for (auto i = 0; i < sizes[row]; ++i) {
+      elements->set(
+          offsets[row] + i, elements->valueAt(offsets[row] + i) + row);
+    }
+  }
+  assertEqualVectors(expectedResult, result);
+}
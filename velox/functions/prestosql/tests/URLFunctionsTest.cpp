@@ -122,6 +122,25 @@ TEST_F(URLFunctionsTest, validateURL) {
       "",
       "",
       std::nullopt);
+  // A ':' after a '/', '?' or '#' does not end a scheme.
+  validate("a/b:c", "", "", "a/b:c", "", "", std::nullopt);
+  validate(":foo", "", "", ":foo", "", "", std::nullopt);
+  validate(
+      "mailto:user@example.com?subject=a#b",
+      "mailto",
+      "",
+      "user@example.com",
+      "b",
+      "subject=a",
+      std::nullopt);
+  validate(
+      "//example.com:81?a=b?c#d#e",
+      "",
+      "example.com",
+      "",
+      "d#e",
+      "a=b?c",
+      81);
 }
 
 TEST_F(URLFunctionsTest, extractPath) {
@@ -206,5 +225,19 @@ TEST_F(URLFunctionsTest, urlDecode) {
   EXPECT_THROW(urlDecode("http%3A%2F%2H"), VeloxUserError);
 }
 
+TEST_F(URLFunctionsTest, urlDecodeNoCopy) {
+  // Strings without escapes are returned without copying.
+  auto input = makeFlatVector<std::string>(
+      {"http://test/a/long/path", "http%3A%2F%2Ftest/a/long/path"});
+  auto result = evaluate<FlatVector<StringView>>(
+      "url_decode(c0)", makeRowVector({input}));
+  assertEqualVectors(
+      makeFlatVector<std::string>(
+          {"http://test/a/long/path", "http://test/a/long/path"}),
+      result);
+  EXPECT_EQ(input->valueAt(0).data(), result->valueAt(0).data());
+  EXPECT_NE(input->valueAt(1).data(), result->valueAt(1).data());
+}
+
 } // namespace
 } // namespace facebook::velox
@@ -629,11 +629,59 @@ simdjson::error_code appendMapKey<TypeKind::TIMESTAMP>(
   return simdjson::INCORRECT_TYPE;
 }
 
+// Per-batch state for casting JSON to a type, mirroring the type tree. For
+// ROW types this holds the lookup from lower-cased field names to field
+// indices, so that it is built once per batch instead of once per row.
+struct JsonCastSchema {
+  explicit JsonCastSchema(const Type& type) {
+    children.reserve(type.size());
+    for (auto i = 0; i < type.size(); ++i) {
+      children.emplace_back(*type.childAt(i));
+    }
+    if (type.kind() != TypeKind::ROW) {
+      return;
+    }
+    const auto& rowType = type.asRow();
+    for (const auto& name : rowType.names()) {
+      allFieldsAreAscii &=
+          functions::stringCore::isAscii(name.data(), name.size());
+    }
+    for (auto i = 0; i < rowType.size(); ++i) {
+      std::string name = rowType.nameOf(i);
+      if (allFieldsAreAscii) {
+        folly::toLowerAscii(name);
+      } else {
+        boost::algorithm::to_lower(name);
+      }
+      fieldIndices[name] = i;
+    }
+    seenFields.resize(rowType.size());
+  }
+
+  std::vector<JsonCastSchema> children;
+
+  // ROW only. True if all field names are ASCII, so that keys can be
+  // lower-cased with folly::toLowerAscii.
+  bool allFieldsAreAscii{true};
+
+  // ROW only. Lower-cased field name to field index.
+  folly::F14FastMap<std::string, int32_t> fieldIndices;
+
+  // ROW only. Scratch for the fields found in the current JSON object. A
+  // schema node is never used for two values at once, since nested values
+  // use the child nodes.
+  std::vector<bool> seenFields;
+
+  // ROW only. Scratch for the lower-cased key of the current field.
+  std::string key;
+};
+
 template <typename Input>
 struct CastFromJsonTypedImpl {
   template <TypeKind kind>
-  static simdjson::error_code apply(Input input, exec::GenericWriter& writer) {
-    return KindDispatcher<kind>::apply(input, writer);
+  static simdjson::error_code
+  apply(Input input, exec::GenericWriter& writer, JsonCastSchema& schema) {
+    return KindDispatcher<kind>::apply(input, writer, schema);
   }
 
  private:
@@ -641,7 +689,8 @@ struct CastFromJsonTypedImpl {
   // class.
   template <TypeKind kind, typename Dummy = void>
   struct KindDispatcher {
-    static simdjson::error_code apply(Input, exec::GenericWriter&) {
+    static simdjson::error_code
+    apply(Input, exec::GenericWriter&, JsonCastSchema&) {
       VELOX_NYI(
           "Casting from JSON to {} is not supported.", TypeTraits<kind>::name);
       return simdjson::error_code::UNEXPECTED_ERROR; // Make compiler happy.
@@ -652,7 +701,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::VARCHAR, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastSchema& /*schema*/) {
       SIMDJSON_ASSIGN_OR_RAISE(auto type, value.type());
       std::string_view s;
       if (isJsonType(writer.type())) {
@@ -680,7 +730,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::BOOLEAN, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastSchema& /*schema*/) {
       SIMDJSON_ASSIGN_OR_RAISE(auto type, value.type());
       auto& w = writer.castTo<bool>();
       switch (type) {
@@ -722,7 +773,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::TINYINT, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastSchema& /*schema*/) {
       return castJsonToInt<int8_t>(value, writer);
     }
   };
@@ -731,7 +783,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::SMALLINT, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastSchema& /*schema*/) {
       return castJsonToInt<int16_t>(value, writer);
     }
   };
@@ -740,7 +793,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::INTEGER, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastSchema& /*schema*/) {
       return castJsonToInt<int32_t>(value, writer);
     }
   };
@@ -749,7 +803,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::BIGINT, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastSchema& /*schema*/) {
       return castJsonToInt<int64_t>(value, writer);
     }
   };
@@ -758,7 +813,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::REAL, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastSchema& /*schema*/) {
       return castJsonToFloatingPoint<float>(value, writer);
     }
   };
@@ -767,7 +823,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::DOUBLE, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastSchema& /*schema*/) {
       return castJsonToFloatingPoint<double>(value, writer);
     }
   };
@@ -776,7 +833,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::ARRAY, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastSchema& schema) {
       auto& writerTyped = writer.castTo<Array<Any>>();
       auto& elementType = writer.type()->childAt(0);
       SIMDJSON_ASSIGN_OR_RAISE(auto array, value.get_array());
@@ -791,7 +849,8 @@ struct CastFromJsonTypedImpl {
               CastFromJsonTypedImpl<simdjson::ondemand::value>::apply,
               elementType->kind(),
               element,
-              writerTyped.add_item()));
+              writerTyped.add_item(),
+              schema.children[0]));
         }
       }
       return simdjson::SUCCESS;
@@ -802,7 +861,8 @@ struct CastFromJsonTypedImpl {
   struct KindDispatcher<TypeKind::MAP, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastSchema& schema) {
       auto& writerTyped = writer.castTo<Map<Any, Any>>();
       auto& keyType = writer.type()->childAt(0);
       auto& valueType = writer.type()->childAt(1);
@@ -823,37 +883,20 @@ struct CastFromJsonTypedImpl {
               CastFromJsonTypedImpl<simdjson::ondemand::value>::apply,
               valueType->kind(),
               field.value(),
-              std::get<1>(writers)));
+              std::get<1>(writers),
+              schema.children[1]));
         }
       }
       return simdjson::SUCCESS;
     }
   };
 
-  static folly::F14FastMap<std::string, int32_t> makeFieldIndicesMap(
-      const RowType& rowType,
-      bool allFieldsAreAscii) {
-    folly::F14FastMap<std::string, int32_t> fieldIndices;
-    const auto size = rowType.size();
-    for (auto i = 0; i < size; ++i) {
-      std::string key = rowType.nameOf(i);
-      if (allFieldsAreAscii) {
-        folly::toLowerAscii(key);
-      } else {
-        boost::algorithm::to_lower(key);
-      }
-
-      fieldIndices[key] = i;
-    }
-
-    return fieldIndices;
-  }
-
   template <typename Dummy>
   struct KindDispatcher<TypeKind::ROW, Dummy> {
     static simdjson::error_code apply(
         Input value,
-        exec::GenericWriter& writer) {
+        exec::GenericWriter& writer,
+        JsonCastSchema& schema) {
       auto& rowType = writer.type()->asRow();
       auto& writerTyped = writer.castTo<DynamicRow>();
       SIMDJSON_ASSIGN_OR_RAISE(auto type, value.type());
@@ -873,27 +916,16 @@ struct CastFromJsonTypedImpl {
                 CastFromJsonTypedImpl<simdjson::ondemand::value>::apply,
                 rowType.childAt(i)->kind(),
                 element,
-                writerTyped.get_writer_at(i)));
+                writerTyped.get_writer_at(i),
+                schema.children[i]));
           }
           ++i;
         }
       } else {
         SIMDJSON_ASSIGN_OR_RAISE(auto object, value.get_object());
-
-        // TODO Populate this mapping once, not per-row.
-        // Mapping from lower-case field names of the target RowType to their
-        // indices.
-        bool allFieldsAreAscii = true;
-        const auto size = rowType.size();
-        for (auto i = 0; i < size; ++i) {
-          const auto& name = rowType.nameOf(i);
-          allFieldsAreAscii &=
-              functions::stringCore::isAscii(name.data(), name.size());
-        }
-
-        auto fieldIndices = makeFieldIndicesMap(rowType, allFieldsAreAscii);
-
-        std::string key;
+        auto& seen = schema.seenFields;
+        std::fill(seen.begin(), seen.end(), false);
+        auto& key = schema.key;
         for (auto fieldResult : object) {
           SIMDJSON_ASSIGN_OR_RAISE(auto field, fieldResult);
           if (!field.value().is_null()) {
@@ -901,31 +933,32 @@ struct CastFromJsonTypedImpl {
 
             // boost::algorithm::to_lower is very slow. Use much faster
             // folly::toLowerAscii if possible.
-            if (allFieldsAreAscii) {
+            if (schema.allFieldsAreAscii) {
               folly::toLowerAscii(key);
             } else {
               boost::algorithm::to_lower(key);
             }
 
-            auto it = fieldIndices.find(key);
-            if (it != fieldIndices.end()) {
+            auto it = schema.fieldIndices.find(key);
+            if (it != schema.fieldIndices.end()) {
               const auto index = it->second;
 
-              VELOX_USER_CHECK_GE(index, 0, "Duplicate field: {}", key);
-              it->second = -1;
+              VELOX_USER_CHECK(!seen[index], "Duplicate field: {}", key);
+              seen[index] = true;
 
               SIMDJSON_TRY(VELOX_DYNAMIC_TYPE_DISPATCH(
                   CastFromJsonTypedImpl<simdjson::ondemand::value>::apply,
                   rowType.childAt(index)->kind(),
                   field.value(),
-                  writerTyped.get_writer_at(index)));
+                  writerTyped.get_writer_at(index),
+                  schema.children[index]));
             }
           }
         }
 
-        for (const auto& [key, index] : fieldIndices) {
-          if (index >= 0) {
-            writerTyped.set_null_at(index);
+        for (size_t i = 0; i < seen.size(); ++i) {
+          if (!seen[i]) {
+            writerTyped.set_null_at(i);
           }
         }
       }
@@ -1017,14 +1050,15 @@ struct CastFromJsonTypedImpl {
 template <TypeKind kind>
 simdjson::error_code castFromJsonOneRow(
     simdjson::padded_string_view input,
-    exec::VectorWriter<Any>& writer) {
+    exec::VectorWriter<Any>& writer,
+    JsonCastSchema& schema) {
   SIMDJSON_ASSIGN_OR_RAISE(auto doc, simdjsonParse(input));
   if (doc.is_null()) {
     writer.commitNull();
   } else {
     SIMDJSON_TRY(
         CastFromJsonTypedImpl<simdjson::ondemand::document&>::apply<kind>(
-            doc, writer.current()));
+            doc, writer.current(), schema));
     writer.commit(true);
   }
   return simdjson::SUCCESS;
@@ -1089,6 +1123,7 @@ class JsonCastOperator : public exec::CastOperator {
       maxSize = std::max(maxSize, input.size());
     });
     paddedInput_.resize(maxSize + simdjson::SIMDJSON_PADDING);
+    JsonCastSchema schema(*result.type());
     context.applyToSelectedNoThrow(rows, [&](auto row) {
       writer.setOffset(row);
       if (inputVector->isNullAt(row)) {
@@ -1099,7 +1134,8 @@ class JsonCastOperator : public exec::CastOperator {
       memcpy(paddedInput_.data(), input.data(), input.size());
       simdjson::padded_string_view paddedInput(
           paddedInput_.data(), input.size(), paddedInput_.size());
-      if (auto error = castFromJsonOneRow<kind>(paddedInput, writer)) {
+      if (auto error =
+              castFromJsonOneRow<kind>(paddedInput, writer, schema)) {
         context.setVeloxExceptionError(row, errors_[error]);
         writer.commitNull();
       }
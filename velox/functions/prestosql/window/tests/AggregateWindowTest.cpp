@@ -233,6 +233,29 @@ TEST_F(AggregateWindowTest, testDecimal) {
   testAggregate(DECIMAL(20, 5));
 }
 
+// Tests long sliding frames that are aggregated over a segment tree.
+TEST_F(AggregateWindowTest, longSlidingFrames) {
+  const vector_size_t size = 5'000;
+  auto input = {makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row / 2'100; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 7 % 101; }, nullEvery(11)),
+  })};
+
+  const std::vector<std::string> frameClauses = {
+      "rows between 300 preceding and 200 following",
+      "rows between 1000 preceding and 129 preceding",
+      "rows between 5 following and unbounded following",
+      "rows between current row and unbounded following",
+      "rows between 127 preceding and current row",
+  };
+  for (const auto& function : kAggregateFunctions) {
+    WindowTestBase::testWindowFunction(
+        input, function, {"partition by c0 order by c1"}, frameClauses);
+  }
+}
+
 TEST_F(AggregateWindowTest, integerOverflowRowsFrame) {
   auto c0 = makeFlatVector<int64_t>({-1, -1, -1, -1, -1, -1, 2, 2, 2, 2});
   auto c1 = makeFlatVector<double>({-1, -2, -3, -4, -5, -6, -7, -8, -9, -10});
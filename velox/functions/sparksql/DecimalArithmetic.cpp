@@ -380,7 +380,12 @@ class Addition {
       uint8_t rPrecision,
       uint8_t rScale,
       bool& overflow) {
-    if (rPrecision < LongDecimalType::kMaxPrecision) {
+    if constexpr (std::is_same_v<TResult, int64_t>) {
+      // A short decimal result has at most 18 digits, so are the rescaled
+      // inputs and their sum.
+      r = a * static_cast<int64_t>(velox::DecimalUtil::kPowersOfTen[aRescale]) +
+          b * static_cast<int64_t>(velox::DecimalUtil::kPowersOfTen[bRescale]);
+    } else if (rPrecision < LongDecimalType::kMaxPrecision) {
       const int128_t aRescaled = a * velox::DecimalUtil::kPowersOfTen[aRescale];
       const int128_t bRescaled = b * velox::DecimalUtil::kPowersOfTen[bRescale];
       r = TResult(aRescaled + bRescaled);
@@ -491,6 +496,10 @@ class Multiply {
     if (rPrecision < 38) {
       R result = DecimalUtil::multiply<R>(R(a), R(b), overflow);
       VELOX_DCHECK(!overflow);
+      if (aRescale + bRescale == 0) {
+        r = result;
+        return;
+      }
       r = DecimalUtil::multiply<R>(
           result,
           R(velox::DecimalUtil::kPowersOfTen[aRescale + bRescale]),
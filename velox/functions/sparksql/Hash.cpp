@@ -18,6 +18,7 @@
 #include <folly/CPortability.h>
 
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/vector/FlatVector.h"
 
@@ -26,6 +27,37 @@ namespace {
 
 const int32_t kDefaultSeed = 42;
 
+// Updates the hashes in 'rawResult' with the values of 'decoded' in 'rows'.
+// Flat inputs are read directly from their values buffer and flat INTEGER
+// inputs are hashed with HashClass::hashInt32s, which may use SIMD.
+template <typename T, typename HashClass, typename ReturnType, typename HashFn>
+void hashColumn(
+    HashClass& hash,
+    const DecodedVector& decoded,
+    const SelectivityVector& rows,
+    ReturnType* rawResult,
+    HashFn hashFn) {
+  // Boolean values are bit packed and cannot be read as an array.
+  if constexpr (!std::is_same_v<T, bool>) {
+    if (decoded.isIdentityMapping()) {
+      const auto* data = decoded.data<T>();
+      if constexpr (std::is_same_v<T, int32_t>) {
+        if (rows.isAllSelected()) {
+          hash.hashInt32s(data, rows.begin(), rows.end(), rawResult);
+          return;
+        }
+      }
+      rows.applyToSelected([&](vector_size_t row) {
+        rawResult[row] = hashFn(data[row], rawResult[row]);
+      });
+      return;
+    }
+  }
+  rows.applyToSelected([&](vector_size_t row) {
+    rawResult[row] = hashFn(decoded.valueAt<T>(row), rawResult[row]);
+  });
+}
+
 // ReturnType can be either int32_t or int64_t
 // HashClass contains the function like hashInt32
 template <typename ReturnType, typename HashClass, typename SeedType>
@@ -41,6 +73,7 @@ void applyWithType(
 
   auto& result = *resultRef->as<FlatVector<ReturnType>>();
   rows.applyToSelected([&](int row) { result.set(row, hashSeed); });
+  auto* rawResult = result.mutableRawValues();
 
   exec::LocalSelectivityVector selectedMinusNulls(context);
 
@@ -57,12 +90,12 @@ void applyWithType(
     switch (args[i]->type()->kind()) {
 // Derived from InterpretedHashFunction.hash:
 // https://github.com/apache/spark/blob/382b66e/sql/catalyst/src/main/scala/org/apache/spark/sql/catalyst/expressions/hash.scala#L532
-#define CASE(typeEnum, hashFn, inputType)                                      \
-  case TypeKind::typeEnum:                                                     \
-    selected->applyToSelected([&](int row) {                                   \
-      result.set(                                                              \
-          row, hashFn(decoded->valueAt<inputType>(row), result.valueAt(row))); \
-    });                                                                        \
+#define CASE(typeEnum, hashFn, inputType)                             \
+  case TypeKind::typeEnum:                                            \
+    hashColumn<inputType>(                                            \
+        hash, *decoded, *selected, rawResult, [&](auto value, auto h) { \
+          return hashFn(value, h);                                    \
+        });                                                           \
     break;
       CASE(BOOLEAN, hash.hashInt32, bool);
       CASE(TINYINT, hash.hashInt32, int8_t);
@@ -101,6 +134,28 @@ class Murmur3Hash final {
     return fmix(h1, 4);
   }
 
+  // Hashes the 'input' values in [begin, end) with the seeds in 'hashes' and
+  // stores the results in 'hashes'.
+  void hashInt32s(
+      const int32_t* input,
+      vector_size_t begin,
+      vector_size_t end,
+      int32_t* hashes) {
+    using Batch = xsimd::batch<uint32_t>;
+    auto row = begin;
+    for (; row + static_cast<vector_size_t>(Batch::size) <= end;
+         row += Batch::size) {
+      auto* rawHashes = reinterpret_cast<uint32_t*>(hashes + row);
+      auto k1 = mixK1(Batch::load_unaligned(
+          reinterpret_cast<const uint32_t*>(input + row)));
+      auto h1 = mixH1(Batch::load_unaligned(rawHashes), k1);
+      fmix(h1, 4).store_unaligned(rawHashes);
+    }
+    for (; row < end; ++row) {
+      hashes[row] = hashInt32(input[row], hashes[row]);
+    }
+  }
+
   uint32_t hashInt64(uint64_t input, uint32_t seed) {
     uint32_t low = input;
     uint32_t high = input >> 32;
@@ -176,6 +231,37 @@ class Murmur3Hash final {
     h1 ^= h1 >> 16;
     return h1;
   }
+
+  // Versions of the above for a batch of values.
+  using Batch = xsimd::batch<uint32_t>;
+
+  static Batch rotateLeft(Batch a, int shift) {
+    return (a << shift) | (a >> (32 - shift));
+  }
+
+  Batch mixK1(Batch k1) {
+    k1 *= Batch(0xcc9e2d51);
+    k1 = rotateLeft(k1, 15);
+    k1 *= Batch(0x1b873593);
+    return k1;
+  }
+
+  Batch mixH1(Batch h1, Batch k1) {
+    h1 ^= k1;
+    h1 = rotateLeft(h1, 13);
+    h1 = h1 * Batch(5) + Batch(0xe6546b64);
+    return h1;
+  }
+
+  Batch fmix(Batch h1, uint32_t length) {
+    h1 ^= Batch(length);
+    h1 ^= h1 >> 16;
+    h1 *= Batch(0x85ebca6b);
+    h1 ^= h1 >> 13;
+    h1 *= Batch(0xc2b2ae35);
+    h1 ^= h1 >> 16;
+    return h1;
+  }
 };
 
 class Murmur3HashFunction final : public exec::VectorFunction {
@@ -212,6 +298,16 @@ class XxHash64 final {
     return fmix(hash);
   }
 
+  void hashInt32s(
+      const int32_t* input,
+      vector_size_t begin,
+      vector_size_t end,
+      int64_t* hashes) {
+    for (auto row = begin; row < end; ++row) {
+      hashes[row] = hashInt32(input[row], hashes[row]);
+    }
+  }
+
   int64_t hashInt64(int64_t input, uint64_t seed) {
     int64_t hash = seed + PRIME64_5 + 8L;
     hash ^= bits::rotateLeft64(input * PRIME64_2, 31) * PRIME64_1;
@@ -779,6 +779,9 @@ template <typename T>
 struct TranslateFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  // Results without translation refer to strings in the first argument.
+  static constexpr int32_t reuse_strings_from_arg = 0;
+
   // ASCII input always produces ASCII result.
   static constexpr bool is_default_ascii_behavior = true;
 
@@ -850,7 +853,7 @@ struct TranslateFunction {
     }
     // No need to do the translation.
     if (unicodeDictionary_->empty()) {
-      result.append(input);
+      result.setNoCopy(input);
       return;
     }
     // Initial capacity is input size. Larger capacity can be reserved below.
@@ -887,7 +890,7 @@ struct TranslateFunction {
     }
     // No need to do the translation.
     if (asciiDictionary_->empty()) {
-      result.append(input);
+      result.setNoCopy(input);
       return;
     }
     // Result size cannot be larger than input size for all ascii input.
@@ -48,11 +48,11 @@ class BitwiseXorAggregate : public BitwiseAggregateBase<T> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
-    aggregate::SimpleNumericAggregate<T, T, T>::updateOneGroup(
+    aggregate::SimpleNumericAggregate<T, T, T>::reduceOneGroup(
         group,
         rows,
         args[0],
-        [](T& result, T value) { result ^= value; },
+        [](auto result, auto value) { return result ^ value; },
         [](T& result, T value, int n) {
           if ((n & 1) == 1) {
             result ^= value;
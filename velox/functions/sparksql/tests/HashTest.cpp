@@ -104,6 +104,39 @@ TEST_F(HashTest, StringInt32) {
   EXPECT_EQ(hash("", 0), 1143746540);
 }
 
+TEST_F(HashTest, flatAndDictionary) {
+  // Flat inputs are hashed from their values buffers, in batches for integers.
+  // The results must match those for the same values in a dictionary.
+  const vector_size_t size = 1'003;
+  auto ints = makeFlatVector<int32_t>(
+      size, [](auto row) { return row % 3 - 1; });
+  auto bigints = makeFlatVector<int64_t>(
+      size, [](auto row) { return row * 0xcafecafedeadbeef; }, nullEvery(7));
+  auto indices = makeIndices(size, [](auto row) { return row; });
+
+  auto testHash = [&](const std::string& expression) {
+    auto flatResult = evaluate(expression, makeRowVector({ints, bigints}));
+    auto dictionaryResult = evaluate(
+        expression,
+        makeRowVector({
+            wrapInDictionary(indices, size, ints),
+            wrapInDictionary(indices, size, bigints),
+        }));
+    assertEqualVectors(dictionaryResult, flatResult);
+    return flatResult;
+  };
+
+  auto result = testHash("hash(c0)");
+  auto* flatResult = result->asFlatVector<int32_t>();
+  for (auto row = 0; row < size; ++row) {
+    const int32_t expected[] = {-1604776387, 933211791, -559580957};
+    ASSERT_EQ(expected[row % 3], flatResult->valueAt(row)) << row;
+  }
+  testHash("hash(c0, c1)");
+  testHash("hash(c1, c0)");
+  testHash("xxhash64(c0, c1)");
+}
+
 TEST_F(HashTest, Double) {
   using limits = std::numeric_limits<double>;
 
@@ -519,6 +519,20 @@ TEST_F(FunctionRegistryTest, resolveFunctionsBasedOnPriority) {
   ASSERT_EQ(*result5, *REAL());
 }
 
+TEST_F(FunctionRegistryTest, resolveAfterRegistration) {
+  // Resolutions are cached. Registering a function drops the cached ones.
+  std::string func = "func_registered_later";
+  ASSERT_EQ(nullptr, resolveFunction(func, {VARCHAR(), VARCHAR()}));
+
+  registerFunction<TestFunction, int64_t, Variadic<Any>>({func});
+  ASSERT_EQ(*resolveFunction(func, {VARCHAR(), VARCHAR()}), *BIGINT());
+  ASSERT_EQ(*resolveFunction(func, {VARCHAR(), VARCHAR()}), *BIGINT());
+
+  registerFunction<TestFunction, Varchar, Varchar, Varchar>({func});
+  ASSERT_EQ(*resolveFunction(func, {VARCHAR(), VARCHAR()}), *VARCHAR());
+  ASSERT_EQ(*resolveFunction(func, {INTEGER()}), *BIGINT());
+}
+
 TEST_F(FunctionRegistryTest, resolveSpecialForms) {
   auto andResult =
       resolveFunctionOrCallableSpecialForm("and", {BOOLEAN(), BOOLEAN()});
@@ -420,6 +420,146 @@ int32_t CompactRow::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+void CompactRow::rowSizes(
+    vector_size_t offset,
+    vector_size_t size,
+    int32_t* sizes) {
+  int32_t fixedSize = rowNullBytes_;
+  for (auto field = 0; field < children_.size(); ++field) {
+    if (childIsFixedWidth_[field]) {
+      fixedSize += children_[field].valueBytes_;
+    }
+  }
+  std::fill(sizes, sizes + size, fixedSize);
+
+  std::vector<vector_size_t> indices(size);
+  for (auto i = 0; i < size; ++i) {
+    indices[i] = decoded_.index(offset + i);
+  }
+
+  for (auto field = 0; field < children_.size(); ++field) {
+    if (childIsFixedWidth_[field]) {
+      continue;
+    }
+    auto& child = children_[field];
+    auto& childDecoded = child.decoded_;
+    const bool mayHaveNulls = childDecoded.mayHaveNulls();
+    if (child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY) {
+      for (auto i = 0; i < size; ++i) {
+        if (!mayHaveNulls || !childDecoded.isNullAt(indices[i])) {
+          sizes[i] +=
+              kSizeBytes + childDecoded.valueAt<StringView>(indices[i]).size();
+        }
+      }
+      continue;
+    }
+    for (auto i = 0; i < size; ++i) {
+      if (!mayHaveNulls || !childDecoded.isNullAt(indices[i])) {
+        sizes[i] += child.variableWidthRowSize(indices[i]);
+      }
+    }
+  }
+}
+
+void CompactRow::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* offsets,
+    char* buffer) {
+  std::vector<vector_size_t> indices(size);
+  for (auto i = 0; i < size; ++i) {
+    indices[i] = decoded_.index(offset + i);
+  }
+
+  std::vector<int64_t> valueOffsets(size, rowNullBytes_);
+  for (auto field = 0; field < children_.size(); ++field) {
+    children_[field].serializeField(
+        indices.data(), size, offsets, field, valueOffsets.data(), buffer);
+  }
+}
+
+void CompactRow::serializeField(
+    const vector_size_t* indices,
+    vector_size_t size,
+    const size_t* offsets,
+    int32_t field,
+    int64_t* valueOffsets,
+    char* buffer) {
+  switch (typeKind_) {
+    case TypeKind::BOOLEAN:
+      return serializeFixedWidthField<bool>(
+          indices, size, offsets, field, valueOffsets, buffer);
+    case TypeKind::TINYINT:
+      return serializeFixedWidthField<int8_t>(
+          indices, size, offsets, field, valueOffsets, buffer);
+    case TypeKind::SMALLINT:
+      return serializeFixedWidthField<int16_t>(
+          indices, size, offsets, field, valueOffsets, buffer);
+    case TypeKind::INTEGER:
+      return serializeFixedWidthField<int32_t>(
+          indices, size, offsets, field, valueOffsets, buffer);
+    case TypeKind::BIGINT:
+      return serializeFixedWidthField<int64_t>(
+          indices, size, offsets, field, valueOffsets, buffer);
+    case TypeKind::HUGEINT:
+      return serializeFixedWidthField<int128_t>(
+          indices, size, offsets, field, valueOffsets, buffer);
+    case TypeKind::REAL:
+      return serializeFixedWidthField<float>(
+          indices, size, offsets, field, valueOffsets, buffer);
+    case TypeKind::DOUBLE:
+      return serializeFixedWidthField<double>(
+          indices, size, offsets, field, valueOffsets, buffer);
+    case TypeKind::TIMESTAMP:
+      return serializeFixedWidthField<Timestamp>(
+          indices, size, offsets, field, valueOffsets, buffer);
+    default:
+      break;
+  }
+
+  const bool mayHaveNulls = decoded_.mayHaveNulls();
+  for (auto i = 0; i < size; ++i) {
+    char* row = buffer + offsets[i];
+    if (mayHaveNulls && decoded_.isNullAt(indices[i])) {
+      bits::setBit(reinterpret_cast<uint8_t*>(row), field, true);
+      valueOffsets[i] += valueBytes_;
+    } else if (fixedWidthTypeKind_) {
+      // UNKNOWN values take no space.
+      valueOffsets[i] += valueBytes_;
+    } else {
+      valueOffsets[i] +=
+          serializeVariableWidth(indices[i], row + valueOffsets[i]);
+    }
+  }
+}
+
+template <typename T>
+void CompactRow::serializeFixedWidthField(
+    const vector_size_t* indices,
+    vector_size_t size,
+    const size_t* offsets,
+    int32_t field,
+    int64_t* valueOffsets,
+    char* buffer) {
+  const bool mayHaveNulls = decoded_.mayHaveNulls();
+  for (auto i = 0; i < size; ++i) {
+    char* row = buffer + offsets[i];
+    if (!mayHaveNulls || !decoded_.isNullAt(indices[i])) {
+      if constexpr (std::is_same_v<T, Timestamp>) {
+        const auto micros = decoded_.valueAt<Timestamp>(indices[i]).toMicros();
+        memcpy(row + valueOffsets[i], &micros, sizeof(int64_t));
+      } else {
+        const T value = decoded_.valueAt<T>(indices[i]);
+        memcpy(row + valueOffsets[i], &value, sizeof(T));
+      }
+    } else {
+      bits::setBit(reinterpret_cast<uint8_t*>(row), field, true);
+    }
+    valueOffsets[i] += valueBytes_;
+  }
+}
+
 void CompactRow::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
@@ -36,6 +36,21 @@ class CompactRow {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Writes the serialized sizes of the rows in [offset, offset + size) to
+  /// 'sizes'. Computes the sizes one field at a time for all the rows. Use
+  /// only if 'fixedRowSize' returned std::nullopt.
+  void rowSizes(vector_size_t offset, vector_size_t size, int32_t* sizes);
+
+  /// Serializes the rows in [offset, offset + size). The i-th row is written
+  /// to 'buffer + offsets[i]'. Writes one field of all the rows before moving
+  /// to the next field. 'buffer' must have sufficient capacity and set to all
+  /// zeros.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* offsets,
+      char* buffer);
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   static RowVectorPtr deserialize(
@@ -108,6 +123,26 @@ class CompactRow {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer);
 
+  /// Writes the null flags and the values at 'indices' as the 'field'th field
+  /// of the rows at 'buffer + offsets[i]'. Each value is written at
+  /// 'valueOffsets[i]' of its row, which is advanced past the value.
+  void serializeField(
+      const vector_size_t* indices,
+      vector_size_t size,
+      const size_t* offsets,
+      int32_t field,
+      int64_t* valueOffsets,
+      char* buffer);
+
+  template <typename T>
+  void serializeFixedWidthField(
+      const vector_size_t* indices,
+      vector_size_t size,
+      const size_t* offsets,
+      int32_t field,
+      int64_t* valueOffsets,
+      char* buffer);
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
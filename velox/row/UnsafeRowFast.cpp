@@ -408,4 +408,177 @@ int32_t UnsafeRowFast::serializeRow(vector_size_t index, char* buffer) {
 
   return variableWidthOffset;
 }
+
+void UnsafeRowFast::rowSizes(
+    vector_size_t offset,
+    vector_size_t size,
+    int32_t* sizes) {
+  std::fill(
+      sizes, sizes + size, rowNullBytes_ + children_.size() * kFieldWidth);
+
+  std::vector<vector_size_t> indices(size);
+  for (auto i = 0; i < size; ++i) {
+    indices[i] = decoded_.index(offset + i);
+  }
+
+  for (auto field = 0; field < children_.size(); ++field) {
+    if (childIsFixedWidth_[field]) {
+      continue;
+    }
+    auto& child = children_[field];
+    auto& childDecoded = child.decoded_;
+    const bool mayHaveNulls = childDecoded.mayHaveNulls();
+    if (child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY) {
+      for (auto i = 0; i < size; ++i) {
+        if (!mayHaveNulls || !childDecoded.isNullAt(indices[i])) {
+          sizes[i] +=
+              alignBytes(childDecoded.valueAt<StringView>(indices[i]).size());
+        }
+      }
+      continue;
+    }
+    for (auto i = 0; i < size; ++i) {
+      if (!mayHaveNulls || !childDecoded.isNullAt(indices[i])) {
+        sizes[i] += alignBytes(child.variableWidthRowSize(indices[i]));
+      }
+    }
+  }
+}
+
+void UnsafeRowFast::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* offsets,
+    char* buffer) {
+  std::vector<vector_size_t> indices(size);
+  for (auto i = 0; i < size; ++i) {
+    indices[i] = decoded_.index(offset + i);
+  }
+
+  std::vector<int64_t> variableWidthOffsets(
+      size, rowNullBytes_ + children_.size() * kFieldWidth);
+  for (auto field = 0; field < children_.size(); ++field) {
+    if (childIsFixedWidth_[field]) {
+      children_[field].serializeFixedWidthField(
+          indices.data(), size, offsets, rowNullBytes_, field, buffer);
+    } else {
+      children_[field].serializeVariableWidthField(
+          indices.data(),
+          size,
+          offsets,
+          rowNullBytes_,
+          field,
+          variableWidthOffsets.data(),
+          buffer);
+    }
+  }
+}
+
+void UnsafeRowFast::serializeFixedWidthField(
+    const vector_size_t* indices,
+    vector_size_t size,
+    const size_t* offsets,
+    size_t nullBytes,
+    int32_t field,
+    char* buffer) {
+  switch (typeKind_) {
+    case TypeKind::BOOLEAN:
+      return serializeFixedWidthFieldTyped<bool>(
+          indices, size, offsets, nullBytes, field, buffer);
+    case TypeKind::TINYINT:
+      return serializeFixedWidthFieldTyped<int8_t>(
+          indices, size, offsets, nullBytes, field, buffer);
+    case TypeKind::SMALLINT:
+      return serializeFixedWidthFieldTyped<int16_t>(
+          indices, size, offsets, nullBytes, field, buffer);
+    case TypeKind::INTEGER:
+      return serializeFixedWidthFieldTyped<int32_t>(
+          indices, size, offsets, nullBytes, field, buffer);
+    case TypeKind::BIGINT:
+      return serializeFixedWidthFieldTyped<int64_t>(
+          indices, size, offsets, nullBytes, field, buffer);
+    case TypeKind::REAL:
+      return serializeFixedWidthFieldTyped<float>(
+          indices, size, offsets, nullBytes, field, buffer);
+    case TypeKind::DOUBLE:
+      return serializeFixedWidthFieldTyped<double>(
+          indices, size, offsets, nullBytes, field, buffer);
+    case TypeKind::TIMESTAMP:
+      return serializeFixedWidthFieldTyped<Timestamp>(
+          indices, size, offsets, nullBytes, field, buffer);
+    default:
+      for (auto i = 0; i < size; ++i) {
+        char* row = buffer + offsets[i];
+        if (isNullAt(indices[i])) {
+          bits::setBit(row, field, true);
+        } else {
+          serializeFixedWidth(
+              indices[i], row + nullBytes + field * kFieldWidth);
+        }
+      }
+  }
+}
+
+template <typename T>
+void UnsafeRowFast::serializeFixedWidthFieldTyped(
+    const vector_size_t* indices,
+    vector_size_t size,
+    const size_t* offsets,
+    size_t nullBytes,
+    int32_t field,
+    char* buffer) {
+  const size_t valueOffset = nullBytes + field * kFieldWidth;
+  const bool mayHaveNulls = decoded_.mayHaveNulls();
+  for (auto i = 0; i < size; ++i) {
+    char* row = buffer + offsets[i];
+    if (mayHaveNulls && decoded_.isNullAt(indices[i])) {
+      bits::setBit(row, field, true);
+      continue;
+    }
+    if constexpr (std::is_same_v<T, Timestamp>) {
+      *reinterpret_cast<int64_t*>(row + valueOffset) =
+          decoded_.valueAt<Timestamp>(indices[i]).toMicros();
+    } else {
+      *reinterpret_cast<T*>(row + valueOffset) =
+          decoded_.valueAt<T>(indices[i]);
+    }
+  }
+}
+
+void UnsafeRowFast::serializeVariableWidthField(
+    const vector_size_t* indices,
+    vector_size_t size,
+    const size_t* offsets,
+    size_t nullBytes,
+    int32_t field,
+    int64_t* variableWidthOffsets,
+    char* buffer) {
+  const bool mayHaveNulls = decoded_.mayHaveNulls();
+  const bool isString =
+      typeKind_ == TypeKind::VARCHAR || typeKind_ == TypeKind::VARBINARY;
+  for (auto i = 0; i < size; ++i) {
+    char* row = buffer + offsets[i];
+    if (mayHaveNulls && decoded_.isNullAt(indices[i])) {
+      bits::setBit(row, field, true);
+      continue;
+    }
+    const int64_t variableWidthOffset = variableWidthOffsets[i];
+    int32_t serializedBytes;
+    if (isString) {
+      const auto value = decoded_.valueAt<StringView>(indices[i]);
+      memcpy(row + variableWidthOffset, value.data(), value.size());
+      serializedBytes = value.size();
+    } else {
+      serializedBytes =
+          serializeVariableWidth(indices[i], row + variableWidthOffset);
+    }
+
+    // Write size and offset.
+    uint64_t sizeAndOffset = variableWidthOffset << 32 | serializedBytes;
+    reinterpret_cast<uint64_t*>(row + nullBytes)[field] = sizeAndOffset;
+
+    variableWidthOffsets[i] += alignBytes(serializedBytes);
+  }
+}
 } // namespace facebook::velox::row
@@ -36,6 +36,21 @@ class UnsafeRowFast {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Writes the serialized sizes of the rows in [offset, offset + size) to
+  /// 'sizes'. Computes the sizes one field at a time for all the rows. Use
+  /// only if 'fixedRowSize' returned std::nullopt.
+  void rowSizes(vector_size_t offset, vector_size_t size, int32_t* sizes);
+
+  /// Serializes the rows in [offset, offset + size). The i-th row is written
+  /// to 'buffer + offsets[i]'. Writes one field of all the rows before moving
+  /// to the next field. 'buffer' must have sufficient capacity and set to all
+  /// zeros.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* offsets,
+      char* buffer);
+
  protected:
   explicit UnsafeRowFast(const VectorPtr& vector);
 
@@ -101,6 +116,39 @@ class UnsafeRowFast {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer);
 
+  /// Writes the null flags and the fixed-width values at 'indices' to the
+  /// 'field'th field of the rows at 'buffer + offsets[i]'. 'nullBytes' is the
+  /// size of the null flags of a row.
+  void serializeFixedWidthField(
+      const vector_size_t* indices,
+      vector_size_t size,
+      const size_t* offsets,
+      size_t nullBytes,
+      int32_t field,
+      char* buffer);
+
+  template <typename T>
+  void serializeFixedWidthFieldTyped(
+      const vector_size_t* indices,
+      vector_size_t size,
+      const size_t* offsets,
+      size_t nullBytes,
+      int32_t field,
+      char* buffer);
+
+  /// Writes the null flags, offsets, sizes and the variable-width values at
+  /// 'indices' to the 'field'th field of the rows at 'buffer + offsets[i]'.
+  /// The values are appended at 'variableWidthOffsets[i]' of each row, which
+  /// is advanced past the written value.
+  void serializeVariableWidthField(
+      const vector_size_t* indices,
+      vector_size_t size,
+      const size_t* offsets,
+      size_t nullBytes,
+      int32_t field,
+      int64_t* variableWidthOffsets,
+      char* buffer);
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
@@ -40,6 +40,16 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeUnsafeBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    UnsafeRowFast fast(data);
+    auto totalSize = serializeBatch(fast, rowType, data->size());
+    VELOX_CHECK_GT(totalSize, 0);
+  }
+
   void deserializeUnsafe(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -65,6 +75,16 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeCompactBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    CompactRow compact(data);
+    auto totalSize = serializeBatch(compact, rowType, data->size());
+    VELOX_CHECK_GT(totalSize, 0);
+  }
+
   void deserializeCompact(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -184,6 +204,30 @@ class SerializeBenchmark {
     return serialized;
   }
 
+  // Serializes all rows one column at a time. Returns the total serialized
+  // size.
+  template <typename Serializer>
+  size_t serializeBatch(
+      Serializer& serializer,
+      const RowTypePtr& rowType,
+      vector_size_t numRows) {
+    std::vector<int32_t> sizes(numRows);
+    if (auto fixedRowSize = Serializer::fixedRowSize(rowType)) {
+      std::fill(sizes.begin(), sizes.end(), fixedRowSize.value());
+    } else {
+      serializer.rowSizes(0, numRows, sizes.data());
+    }
+    std::vector<size_t> offsets(numRows);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      offsets[i] = totalSize;
+      totalSize += sizes[i];
+    }
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    serializer.serialize(0, numRows, offsets.data(), buffer->asMutable<char>());
+    return totalSize;
+  }
+
   HashStringAllocator::Position serialize(
       const RowVectorPtr& data,
       HashStringAllocator& allocator) {
@@ -205,35 +249,45 @@ class SerializeBenchmark {
       memory::memoryManager()->addLeafPool()};
 };
 
-#define SERDE_BENCHMARKS(name, rowType)      \
-  BENCHMARK(unsafe_serialize_##name) {       \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeUnsafe(rowType);      \
-  }                                          \
-                                             \
-  BENCHMARK(compact_serialize_##name) {      \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeCompact(rowType);     \
-  }                                          \
-                                             \
-  BENCHMARK(container_serialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeContainer(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(unsafe_deserialize_##name) {     \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeUnsafe(rowType);    \
-  }                                          \
-                                             \
-  BENCHMARK(compact_deserialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeCompact(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(container_deserialize_##name) {  \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeContainer(rowType); \
+#define SERDE_BENCHMARKS(name, rowType)       \
+  BENCHMARK(unsafe_serialize_##name) {        \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeUnsafe(rowType);       \
+  }                                           \
+                                              \
+  BENCHMARK(unsafe_batch_serialize_##name) {  \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeUnsafeBatch(rowType);  \
+  }                                           \
+                                              \
+  BENCHMARK(compact_serialize_##name) {       \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeCompact(rowType);      \
+  }                                           \
+                                              \
+  BENCHMARK(compact_batch_serialize_##name) { \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeCompactBatch(rowType); \
+  }                                           \
+                                              \
+  BENCHMARK(container_serialize_##name) {     \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeContainer(rowType);    \
+  }                                           \
+                                              \
+  BENCHMARK(unsafe_deserialize_##name) {      \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeUnsafe(rowType);     \
+  }                                           \
+                                              \
+  BENCHMARK(compact_deserialize_##name) {     \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeCompact(rowType);    \
+  }                                           \
+                                              \
+  BENCHMARK(container_deserialize_##name) {   \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeContainer(rowType);  \
   }
 
 SERDE_BENCHMARKS(
@@ -76,6 +76,24 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     VELOX_CHECK_EQ(offset, totalSize);
 
+    // Serializing all rows one column at a time produces the same bytes.
+    std::vector<int32_t> sizes(numRows);
+    if (auto fixedRowSize = CompactRow::fixedRowSize(rowType)) {
+      std::fill(sizes.begin(), sizes.end(), fixedRowSize.value());
+    } else {
+      row.rowSizes(0, numRows, sizes.data());
+    }
+    std::vector<size_t> offsets(numRows);
+    offset = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(sizes[i], serialized[i].size()) << "Row " << i;
+      offsets[i] = offset;
+      offset += sizes[i];
+    }
+    std::string batch(totalSize, '\0');
+    row.serialize(0, numRows, offsets.data(), batch.data());
+    ASSERT_EQ(batch, std::string_view(rawBuffer, totalSize));
+
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
   }
@@ -175,6 +175,25 @@ TEST_F(UnsafeRowFuzzTests, fast) {
 
       serialized.push_back(std::string_view(buffers_[i], rowSize));
     }
+
+    // Serializing all rows one column at a time produces the same bytes.
+    std::vector<int32_t> sizes(data->size());
+    fast.rowSizes(0, data->size(), sizes.data());
+    std::vector<size_t> offsets(data->size());
+    size_t totalSize = 0;
+    for (auto i = 0; i < data->size(); ++i) {
+      EXPECT_EQ(sizes[i], serialized[i]->size()) << i;
+      offsets[i] = totalSize;
+      totalSize += sizes[i];
+    }
+    std::string batch(totalSize, '\0');
+    fast.serialize(0, data->size(), offsets.data(), batch.data());
+    for (auto i = 0; i < data->size(); ++i) {
+      EXPECT_EQ(
+          std::string_view(batch.data() + offsets[i], sizes[i]),
+          serialized[i].value())
+          << i << ", " << data->toString(i);
+    }
     return serialized;
   });
 }
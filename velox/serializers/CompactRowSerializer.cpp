@@ -39,40 +39,54 @@ class CompactRowVectorSerializer : public IterativeVectorSerializer {
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges,
       Scratch& scratch) override {
-    size_t totalSize = 0;
+    vector_size_t numRows = 0;
+    for (const auto& range : ranges) {
+      numRows += range.size;
+    }
+    if (numRows == 0) {
+      return;
+    }
+
+    // Sizes of the rows in 'ranges' in order.
+    ScratchPtr<int32_t, 64> rowSizesHolder(scratch);
+    auto* rowSizes = rowSizesHolder.get(numRows);
     row::CompactRow row(vector);
     if (auto fixedRowSize =
             row::CompactRow::fixedRowSize(asRowType(vector->type()))) {
-      for (const auto& range : ranges) {
-        totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * range.size;
-      }
-
+      std::fill(rowSizes, rowSizes + numRows, fixedRowSize.value());
     } else {
+      vector_size_t index = 0;
       for (const auto& range : ranges) {
-        for (auto i = range.begin; i < range.begin + range.size; ++i) {
-          totalSize += row.rowSize(i) + sizeof(TRowSize);
-        }
+        row.rowSizes(range.begin, range.size, rowSizes + index);
+        index += range.size;
       }
     }
 
-    if (totalSize == 0) {
-      return;
+    // Offsets of the serialized rows in the buffer. Each row is preceded by
+    // its size.
+    ScratchPtr<size_t, 64> offsetsHolder(scratch);
+    auto* offsets = offsetsHolder.get(numRows);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      offsets[i] = totalSize + sizeof(TRowSize);
+      totalSize += sizeof(TRowSize) + rowSizes[i];
     }
 
     BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool_, 0);
     auto rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
-    size_t offset = 0;
-    for (auto& range : ranges) {
-      for (auto i = range.begin; i < range.begin + range.size; ++i) {
-        // Write row data.
-        TRowSize size = row.serialize(i, rawBuffer + offset + sizeof(TRowSize));
+    // Write row data one column at a time.
+    vector_size_t index = 0;
+    for (const auto& range : ranges) {
+      row.serialize(range.begin, range.size, offsets + index, rawBuffer);
+      index += range.size;
+    }
 
-        // Write raw size. Needs to be in big endian order.
-        *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-        offset += sizeof(TRowSize) + size;
-      }
+    // Write raw sizes. Need to be in big endian order.
+    for (auto i = 0; i < numRows; ++i) {
+      *(TRowSize*)(rawBuffer + offsets[i] - sizeof(TRowSize)) =
+          folly::Endian::big<TRowSize>(rowSizes[i]);
     }
   }
 
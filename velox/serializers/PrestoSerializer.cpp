@@ -17,11 +17,13 @@
 
 #include <optional>
 
+#include <folly/container/F14Map.h>
 #include <folly/lang/Bits.h>
 
 #include "velox/common/base/Crc.h"
 #include "velox/common/base/RawVector.h"
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/time/CpuWallTimer.h"
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DictionaryVector.h"
@@ -1307,6 +1309,11 @@ void writeInt64(OutputStream* out, int64_t value) {
   out->write(reinterpret_cast<char*>(&value), sizeof(value));
 }
 
+void writeLengthPrefixedString(OutputStream* out, std::string_view value) {
+  writeInt32(out, value.size());
+  out->write(value.data(), value.size());
+}
+
 class CountingOutputStream : public OutputStream {
  public:
   explicit CountingOutputStream() : OutputStream{nullptr} {}
@@ -1335,11 +1342,38 @@ class CountingOutputStream : public OutputStream {
   std::streampos pos_{0};
 };
 
+// Appends the written bytes to a std::string.
+class StringOutputStream : public OutputStream {
+ public:
+  explicit StringOutputStream(std::string& out)
+      : OutputStream{nullptr}, out_(out) {}
+
+  void write(const char* s, std::streamsize count) override {
+    out_.append(s, count);
+  }
+
+  std::streampos tellp() const override {
+    return out_.size();
+  }
+
+  void seekp(std::streampos /*pos*/) override {
+    VELOX_UNSUPPORTED();
+  }
+
+ private:
+  std::string& out_;
+};
+
 raw_vector<uint64_t>& threadTempNulls() {
   thread_local raw_vector<uint64_t> temp;
   return temp;
 }
 
+// Growth of the ByteOutputStreams of a VectorStream, as a percent of their
+// size. Serialization buffers live for one page, so larger ranges mean fewer
+// arena allocations and fewer IOBufs at flush at little memory cost.
+constexpr int32_t kStreamGrowthPercent = 50;
+
 // Appendable container for serialized values. To append a value at a
 // time, call appendNull or appendNonNull first. Then call appendLength if the
 // type has a length. A null value has a length of 0. Then call appendValue if
@@ -1369,6 +1403,9 @@ class VectorStream {
         nulls_(streamArena, true, true),
         lengths_(streamArena),
         values_(streamArena) {
+    nulls_.setGrowthPercent(kStreamGrowthPercent);
+    lengths_.setGrowthPercent(kStreamGrowthPercent);
+    values_.setGrowthPercent(kStreamGrowthPercent);
     if (initialNumRows == 0) {
       initializeHeader(typeToEncodingName(type), *streamArena);
       if (type_->size() > 0) {
@@ -1615,6 +1652,9 @@ class VectorStream {
 
   // Writes out the accumulated contents. Does not change the state.
   void flush(OutputStream* out) {
+    if (opts_.dictionaryEncodeStrings && flushDictionaryEncoded(out)) {
+      return;
+    }
     out->write(reinterpret_cast<char*>(header_.buffer), header_.size);
 
     if (encoding_.has_value()) {
@@ -1694,6 +1734,119 @@ class VectorStream {
     }
   }
 
+  // Writes a flat string stream as an RLE block if all values are the same
+  // or as a DICTIONARY block of its distinct values if that is smaller than
+  // the flat block. Returns false without writing anything otherwise. Does not
+  // change the state.
+  bool flushDictionaryEncoded(OutputStream* out) {
+    if ((type_->kind() != TypeKind::VARCHAR &&
+         type_->kind() != TypeKind::VARBINARY) ||
+        encoding_.has_value() || isDictionaryStream_ || isConstantStream_) {
+      return false;
+    }
+    const int32_t numRows = nullCount_ + nonNullCount_;
+    if (numRows < 2) {
+      return false;
+    }
+    std::string offsets;
+    std::string bytes;
+    std::string nulls;
+    {
+      StringOutputStream offsetsOut(offsets);
+      lengths_.flush(&offsetsOut);
+      StringOutputStream bytesOut(bytes);
+      values_.flush(&bytesOut);
+      if (nullCount_ > 0) {
+        StringOutputStream nullsOut(nulls);
+        nulls_.flush(&nullsOut);
+      }
+    }
+    VELOX_CHECK_EQ(offsets.size(), numRows * sizeof(int32_t));
+    const auto* rawOffsets = reinterpret_cast<const int32_t*>(offsets.data());
+
+    // The distinct values in first appearance order. A null is an entry at
+    // 'nullIndex'.
+    std::vector<std::string_view> distinct;
+    int32_t nullIndex = -1;
+    folly::F14FastMap<std::string_view, int32_t> indices;
+    std::vector<int32_t> rowIndices(numRows);
+    int64_t distinctBytes = 0;
+    for (int32_t row = 0; row < numRows; ++row) {
+      // Wire format nulls are most significant bit first.
+      if (!nulls.empty() && (nulls[row / 8] & (0x80 >> (row % 8)))) {
+        if (nullIndex < 0) {
+          nullIndex = distinct.size();
+          distinct.emplace_back();
+        }
+        rowIndices[row] = nullIndex;
+        continue;
+      }
+      const int32_t begin = row == 0 ? 0 : rawOffsets[row - 1];
+      const std::string_view value(
+          bytes.data() + begin, rawOffsets[row] - begin);
+      const auto [it, inserted] = indices.emplace(value, distinct.size());
+      if (inserted) {
+        distinct.push_back(value);
+        distinctBytes += value.size();
+        // The ids of a DICTIONARY block take the space of the offsets of the
+        // flat block. The dictionary adds 4 bytes of offset per distinct value
+        // and about 64 bytes of headers and instance id.
+        if (2 * distinct.size() > numRows ||
+            distinctBytes + 4 * distinct.size() + 64 >=
+                bytes.size() + nulls.size()) {
+          return false;
+        }
+      }
+      rowIndices[row] = it->second;
+    }
+
+    if (distinct.size() == 1) {
+      writeLengthPrefixedString(out, kRLE);
+      writeInt32(out, numRows);
+      writeFlatStrings(distinct, nullIndex, out);
+      return true;
+    }
+    writeLengthPrefixedString(out, kDictionary);
+    writeInt32(out, numRows);
+    writeFlatStrings(distinct, nullIndex, out);
+    out->write(
+        reinterpret_cast<const char*>(rowIndices.data()),
+        rowIndices.size() * sizeof(int32_t));
+    // 24 bytes of 'instance id'.
+    const char instanceId[24] = {};
+    out->write(instanceId, sizeof(instanceId));
+    return true;
+  }
+
+  // Writes 'values' as a flat block of 'type_'. The value at 'nullIndex' is a
+  // null if 'nullIndex' is not negative.
+  void writeFlatStrings(
+      const std::vector<std::string_view>& values,
+      int32_t nullIndex,
+      OutputStream* out) const {
+    writeLengthPrefixedString(out, typeToEncodingName(type_));
+    writeInt32(out, values.size());
+    int32_t offset = 0;
+    for (const auto& value : values) {
+      offset += value.size();
+      writeInt32(out, offset);
+    }
+    if (nullIndex < 0) {
+      char zero = 0;
+      out->write(&zero, 1);
+    } else {
+      char one = 1;
+      out->write(&one, 1);
+      std::string nullBits(bits::nbytes(values.size()), 0);
+      nullBits[nullIndex / 8] |= 0x80 >> (nullIndex % 8);
+      out->write(nullBits.data(), nullBits.size());
+    }
+    writeInt32(out, offset);
+    for (const auto& value : values) {
+      out->write(value.data(), value.size());
+    }
+  }
+
   void flushNulls(OutputStream* out) {
     if (!nullCount_) {
       char zero = 0;
@@ -4000,16 +4153,24 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
         --numCompressionToSkip_;
         ++stats_.numCompressionSkipped;
       } else {
-        auto [size, compressedSize] = flushStreams(
-            streams_,
-            numRows_,
-            *streamArena_,
-            *codec_,
-            opts_.minCompressionRatio,
-            out);
+        CpuWallTiming timing;
+        FlushSizes sizes;
+        {
+          CpuWallTimer timer(timing);
+          sizes = flushStreams(
+              streams_,
+              numRows_,
+              *streamArena_,
+              *codec_,
+              opts_.minCompressionRatio,
+              out);
+        }
+        const auto [size, compressedSize] = sizes;
         stats_.compressionInputBytes += size;
         stats_.compressedBytes += compressedSize;
-        if (compressedSize > size * opts_.minCompressionRatio) {
+        stats_.compressionCpuNanos += timing.cpuNanos;
+        if (compressedSize > size * opts_.minCompressionRatio ||
+            !savesEnoughPerCpu(size - compressedSize, timing.cpuNanos)) {
           numCompressionToSkip_ = std::min<int64_t>(
               kMaxCompressionAttemptsToSkip, 1 + stats_.numCompressionSkipped);
         }
@@ -4027,7 +4188,10 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
               stats_.compressionInputBytes, RuntimeCounter::Unit::kBytes)},
          {"compressionSkippedBytes",
           RuntimeCounter(
-              stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes)}});
+              stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes)},
+         {"compressionCpuNanos",
+          RuntimeCounter(
+              stats_.compressionCpuNanos, RuntimeCounter::Unit::kNanos)}});
     return map;
   }
 
@@ -4052,8 +4216,21 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     // Bytes for which compression was not attempted because of past
     // non-performance.
     int64_t compressionSkippedBytes{0};
+
+    // CPU time of the flushes that attempted compression.
+    int64_t compressionCpuNanos{0};
   };
 
+  // Returns true if compression that saved 'savedBytes' in 'cpuNanos' meets
+  // 'minCompressionSavedBytesPerMicro'.
+  bool savesEnoughPerCpu(int64_t savedBytes, uint64_t cpuNanos) const {
+    if (opts_.minCompressionSavedBytesPerMicro == 0) {
+      return true;
+    }
+    return savedBytes * 1'000 >=
+        opts_.minCompressionSavedBytesPerMicro * static_cast<int64_t>(cpuNanos);
+  }
+
   const SerdeOpts opts_;
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::io::Codec> codec_;
@@ -72,6 +72,19 @@ class PrestoVectorSerde : public VectorSerde {
     /// than this causes subsequent compression attempts to be skipped. The more
     /// times compression misses the target the less frequently it is tried.
     float minCompressionRatio{0.8};
+
+    /// Minimum bytes saved by compression per microsecond of CPU spent
+    /// compressing if compression is enabled. Saving less counts as a miss
+    /// like missing 'minCompressionRatio', so that codecs too slow for the
+    /// achieved size reduction back off in the same way. 0 disables the
+    /// check.
+    int64_t minCompressionSavedBytesPerMicro{0};
+
+    /// Writes VARCHAR and VARBINARY columns as DICTIONARY blocks of their
+    /// distinct values, or as RLE blocks if all values are the same, when
+    /// this makes the page smaller. The dictionary is built per page when the
+    /// page is flushed.
+    bool dictionaryEncodeStrings{false};
   };
 
   /// Adds the serialized sizes of the rows of 'vector' in 'ranges[i]' to
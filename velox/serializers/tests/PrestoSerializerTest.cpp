@@ -78,6 +78,8 @@ class PrestoSerializerTest
         serdeOptions == nullptr ? false : serdeOptions->nullsFirst;
     serializer::presto::PrestoVectorSerde::PrestoOptions paramOptions{
         useLosslessTimestamp, kind, nullsFirst};
+    paramOptions.dictionaryEncodeStrings =
+        serdeOptions != nullptr && serdeOptions->dictionaryEncodeStrings;
 
     return paramOptions;
   }
@@ -1137,6 +1139,49 @@ TEST_P(PrestoSerializerTest, dictionaryEncodingTurnedOff) {
   ASSERT_EQ(deserialized->childAt(9)->encoding(), VectorEncoding::Simple::FLAT);
 }
 
+TEST_P(PrestoSerializerTest, dictionaryEncodeStrings) {
+  const vector_size_t size = 1'000;
+  auto rows = makeRowVector({
+      // Low cardinality with nulls.
+      makeFlatVector<std::string>(
+          size,
+          [](auto row) {
+            return fmt::format("value of moderate length {}", row % 7);
+          },
+          nullEvery(11)),
+      // A single value.
+      makeFlatVector<std::string>(
+          size, [](auto) { return std::string("the same value in all rows"); }),
+      // All nulls.
+      makeAllNullFlatVector<StringView>(size),
+      // Distinct values stay flat.
+      makeFlatVector<std::string>(
+          size, [](auto row) { return fmt::format("{}", row); }),
+  });
+  auto rowType = asRowType(rows->type());
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions flatOptions;
+  std::ostringstream flatOut;
+  serialize(rows, &flatOut, &flatOptions);
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions dictionaryOptions;
+  dictionaryOptions.dictionaryEncodeStrings = true;
+  std::ostringstream dictionaryOut;
+  serialize(rows, &dictionaryOut, &dictionaryOptions);
+  ASSERT_LT(dictionaryOut.str().size(), flatOut.str().size());
+
+  auto deserialized =
+      deserialize(rowType, dictionaryOut.str(), &dictionaryOptions);
+  assertEqualVectors(rows, deserialized);
+  ASSERT_EQ(
+      deserialized->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(
+      deserialized->childAt(1)->encoding(), VectorEncoding::Simple::CONSTANT);
+  ASSERT_EQ(
+      deserialized->childAt(2)->encoding(), VectorEncoding::Simple::CONSTANT);
+  ASSERT_EQ(deserialized->childAt(3)->encoding(), VectorEncoding::Simple::FLAT);
+}
+
 TEST_P(PrestoSerializerTest, emptyVectorBatchVectorSerializer) {
   // Serialize an empty RowVector.
   auto rowVector = makeEmptyTestVector();
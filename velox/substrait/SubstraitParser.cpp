@@ -15,6 +15,7 @@
  */
 
 #include "velox/substrait/SubstraitParser.h"
+#include <folly/Synchronized.h>
 #include <string>
 #include "velox/common/base/Exceptions.h"
 #include "velox/substrait/TypeUtils.h"
@@ -22,6 +23,52 @@
 
 namespace facebook::velox::substrait {
 
+namespace {
+
+// Process-wide cache of the results of parsing Substrait function
+// specifications. Plans are converted with a new function map each time, but
+// the specifications they refer to repeat across plans, so the cache is keyed
+// by the specification instead of the function anchor.
+template <typename T>
+class FunctionSpecCache {
+ public:
+  template <typename Parse>
+  T get(const std::string& functionSpec, Parse parse) {
+    {
+      auto rlocked = cache_.rlock();
+      auto it = rlocked->find(functionSpec);
+      if (it != rlocked->end()) {
+        return it->second;
+      }
+    }
+    auto result = parse();
+    auto wlocked = cache_.wlock();
+    if (wlocked->size() >= kMaxEntries) {
+      // Bounds the memory of the cache if plans use many different functions.
+      wlocked->clear();
+    }
+    wlocked->emplace(functionSpec, result);
+    return result;
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 10'000;
+
+  folly::Synchronized<std::unordered_map<std::string, T>> cache_;
+};
+
+FunctionSpecCache<std::string>& veloxFunctionCache() {
+  static FunctionSpecCache<std::string> cache;
+  return cache;
+}
+
+FunctionSpecCache<std::vector<TypePtr>>& inputTypesCache() {
+  static FunctionSpecCache<std::vector<TypePtr>> cache;
+  return cache;
+}
+
+} // namespace
+
 TypePtr SubstraitParser::parseType(const ::substrait::Type& substraitType) {
   switch (substraitType.kind_case()) {
     case ::substrait::Type::KindCase::kBool:
@@ -155,9 +202,11 @@ const std::string& SubstraitParser::findFunctionSpec(
 std::string SubstraitParser::findVeloxFunction(
     const std::unordered_map<uint64_t, std::string>& functionMap,
     uint64_t id) const {
-  std::string funcSpec = findFunctionSpec(functionMap, id);
-  std::string_view funcName = getNameBeforeDelimiter(funcSpec, ":");
-  return mapToVeloxFunction({funcName.begin(), funcName.end()});
+  const auto& funcSpec = findFunctionSpec(functionMap, id);
+  return veloxFunctionCache().get(funcSpec, [&]() {
+    std::string_view funcName = getNameBeforeDelimiter(funcSpec, ":");
+    return mapToVeloxFunction({funcName.begin(), funcName.end()});
+  });
 }
 
 std::string SubstraitParser::mapToVeloxFunction(
@@ -204,14 +253,16 @@ std::vector<std::string> SubstraitParser::getSubFunctionTypes(
 
 std::vector<TypePtr> SubstraitParser::getInputTypes(
     const std::string& signature) {
-  std::vector<std::string> typeStrs = getSubFunctionTypes(signature);
-  std::vector<TypePtr> types;
-  types.reserve(typeStrs.size());
-  for (const auto& typeStr : typeStrs) {
-    types.emplace_back(
-        VeloxSubstraitSignature::fromSubstraitSignature(typeStr));
-  }
-  return types;
+  return inputTypesCache().get(signature, [&]() {
+    std::vector<std::string> typeStrs = getSubFunctionTypes(signature);
+    std::vector<TypePtr> types;
+    types.reserve(typeStrs.size());
+    for (const auto& typeStr : typeStrs) {
+      types.emplace_back(
+          VeloxSubstraitSignature::fromSubstraitSignature(typeStr));
+    }
+    return types;
+  });
 }
 
 } // namespace facebook::velox::substrait
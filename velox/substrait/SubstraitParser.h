@@ -70,7 +70,8 @@ class SubstraitParser {
       const std::string& substraitFunction);
 
   /// Find the Velox function name according to the function id
-  /// from a pre-constructed function map.
+  /// from a pre-constructed function map. The names are cached by function
+  /// specification across plans.
   std::string findVeloxFunction(
       const std::unordered_map<uint64_t, std::string>& functionMap,
       uint64_t id) const;
@@ -78,7 +79,8 @@ class SubstraitParser {
   /// Map the Substrait function keyword into Velox function keyword.
   std::string mapToVeloxFunction(const std::string& substraitFunction) const;
 
-  /// Get input types from Substrait function signature.
+  /// Get input types from Substrait function signature. The types are cached
+  /// by signature across plans.
   static std::vector<TypePtr> getInputTypes(const std::string& signature);
 
  private:
@@ -241,3 +241,29 @@ TEST_F(FunctionTest, getInputTypes) {
   ASSERT_EQ(types[3]->kind(), TypeKind::INTEGER);
   ASSERT_EQ(types[4]->kind(), TypeKind::DOUBLE);
 }
+
+TEST_F(FunctionTest, findVeloxFunction) {
+  // The same function specifications with different anchors, as in plans
+  // submitted one after the other.
+  const std::unordered_map<uint64_t, std::string> firstMap = {
+      {0, "add:opt_i64_i64"}, {1, "lte:fp64_fp64"}};
+  const std::unordered_map<uint64_t, std::string> secondMap = {
+      {0, "lte:fp64_fp64"}, {1, "add:opt_i64_i64"}, {2, "subtract:i32_i32"}};
+  for (auto i = 0; i < 2; ++i) {
+    ASSERT_EQ(substraitParser_->findVeloxFunction(firstMap, 0), "plus");
+    ASSERT_EQ(substraitParser_->findVeloxFunction(firstMap, 1), "lte");
+    ASSERT_EQ(substraitParser_->findVeloxFunction(secondMap, 0), "lte");
+    ASSERT_EQ(substraitParser_->findVeloxFunction(secondMap, 1), "plus");
+    ASSERT_EQ(substraitParser_->findVeloxFunction(secondMap, 2), "minus");
+  }
+  VELOX_ASSERT_THROW(
+      substraitParser_->findVeloxFunction(firstMap, 2),
+      "Could not find function id 2 in function map.");
+
+  for (auto i = 0; i < 2; ++i) {
+    auto types = SubstraitParser::getInputTypes("add:opt_i64_i64");
+    ASSERT_EQ(2, types.size());
+    ASSERT_EQ(types[0]->kind(), TypeKind::BIGINT);
+    ASSERT_EQ(types[1]->kind(), TypeKind::BIGINT);
+  }
+}
@@ -18,6 +18,8 @@
 
 #include <folly/Conv.h>
 #include <cctype>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <type_traits>
 #include "velox/common/base/Exceptions.h"
@@ -48,6 +50,71 @@ struct TruncateLegacyCastPolicy {
   static constexpr bool legacyCast = true;
 };
 
+namespace detail {
+
+// Returns true if the 8 bytes of 'chunk' are all ASCII digits.
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+      0x3333333333333333;
+}
+
+// Returns the value of the 8 ASCII digits in 'chunk', loaded from memory in
+// little endian order.
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FF;
+  // 100 + (1000000 << 32) and 1 + (10000 << 32).
+  constexpr uint64_t kMul1 = 0x000F424000000064;
+  constexpr uint64_t kMul2 = 0x0000271000000001;
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  return (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >>
+      32;
+}
+
+} // namespace detail
+
+/// Parses 'size' bytes at 'data' as an optional '-' followed by decimal
+/// digits, 8 digits at a time. Returns false if the input has any other
+/// characters or does not fit in 'T'. The caller then falls back to the
+/// general conversion, which accepts more forms and reports the error.
+template <typename T>
+bool tryParseDecimalInteger(const char* data, size_t size, T& result) {
+  static_assert(std::is_integral_v<T> && sizeof(T) <= sizeof(int64_t));
+  const bool negative = size > 0 && data[0] == '-';
+  const char* cur = data + negative;
+  const char* const end = data + size;
+  // Up to 19 digits fit in uint64_t without overflow.
+  if (cur == end || end - cur > 19) {
+    return false;
+  }
+  uint64_t value = 0;
+  for (; end - cur >= 8; cur += 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, cur, sizeof(chunk));
+    if (!detail::isEightDigits(chunk)) {
+      return false;
+    }
+    value = value * 100'000'000 + detail::parseEightDigits(chunk);
+  }
+  for (; cur < end; ++cur) {
+    const uint8_t digit = *cur - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  using UnsignedT = std::make_unsigned_t<T>;
+  const uint64_t max = std::numeric_limits<T>::max();
+  if (value > max + negative) {
+    return false;
+  }
+  result = static_cast<T>(
+      negative ? static_cast<UnsignedT>(0 - value)
+               : static_cast<UnsignedT>(value));
+  return true;
+}
+
 template <TypeKind KIND, typename = void, typename TPolicy = DefaultCastPolicy>
 struct Converter {
   template <typename T>
@@ -239,6 +306,12 @@ struct Converter<
     if constexpr (TPolicy::truncate) {
       return convertStringToInt(folly::StringPiece(v));
     } else {
+      if constexpr (sizeof(T) <= sizeof(int64_t)) {
+        T result;
+        if (tryParseDecimalInteger(v.data(), v.size(), result)) {
+          return result;
+        }
+      }
       return folly::to<T>(folly::StringPiece(v));
     }
   }
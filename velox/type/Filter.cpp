@@ -21,6 +21,7 @@
 #include <string>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::common {
@@ -94,6 +95,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +135,8 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
   };
 }
 
@@ -190,6 +196,8 @@ void Filter::registerSerDe() {
       NegatedBigintValuesUsingBitmask::create);
   registry.Register(
       "HugeintValuesUsingHashTable", HugeintValuesUsingHashTable::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register("FloatRange", AbstractRange::create);
   registry.Register("DoubleRange", AbstractRange::create);
   registry.Register("BytesRange", BytesRange::create);
@@ -462,6 +470,46 @@ bool NegatedBigintValuesUsingHashTable::testingEquals(
       nonNegated_->testingEquals(*(otherNegatedBigintValues->nonNegated_));
 }
 
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  std::string bloomFilter(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(bloomFilter.data());
+  obj["bloomFilter"] =
+      encoding::Base64::encode(bloomFilter.data(), bloomFilter.size());
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  auto nullAllowed = deserializeNullAllowed(obj);
+  auto serialized = encoding::Base64::decode(obj["bloomFilter"].asString());
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(serialized.data());
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), nullAllowed);
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloomFilter =
+      dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  if (otherBloomFilter == nullptr || !Filter::testingBaseEquals(other) ||
+      min_ != otherBloomFilter->min_ || max_ != otherBloomFilter->max_) {
+    return false;
+  }
+  const auto size = bloomFilter_->serializedSize();
+  if (size != otherBloomFilter->bloomFilter_->serializedSize()) {
+    return false;
+  }
+  std::string serialized(size, '\0');
+  std::string otherSerialized(size, '\0');
+  bloomFilter_->serialize(serialized.data());
+  otherBloomFilter->bloomFilter_->serialize(otherSerialized.data());
+  return serialized == otherSerialized;
+}
+
 folly::dynamic NegatedBigintValuesUsingBitmask::serialize() const {
   auto obj = Filter::serializeBase("NegatedBigintValuesUsingBitmask");
   obj["min"] = min_;
@@ -618,6 +666,43 @@ FilterPtr BytesValues::create(const folly::dynamic& obj) {
   return std::make_unique<BytesValues>(values, nullAllowed);
 }
 
+void BytesValues::makePerfectHash() {
+  if (values_.size() > kMaxPerfectHashValues) {
+    return;
+  }
+  std::vector<std::string> values(values_.begin(), values_.end());
+  std::vector<uint64_t> hashes;
+  hashes.reserve(values.size());
+  for (const auto& value : values) {
+    hashes.push_back(folly::hasher<std::string_view>()(value));
+  }
+  // Tries tables of up to 16x the number of values, each with the hash bits
+  // at several offsets.
+  const auto minSize = bits::nextPowerOfTwo(values.size() * 2);
+  std::vector<int8_t> table;
+  for (auto size = minSize; size <= minSize * 8; size *= 2) {
+    for (auto shift = 0; shift < 64; shift += 8) {
+      table.assign(size, -1);
+      bool collision = false;
+      for (auto i = 0; i < hashes.size(); ++i) {
+        auto& slot = table[(hashes[i] >> shift) & (size - 1)];
+        if (slot >= 0) {
+          collision = true;
+          break;
+        }
+        slot = i;
+      }
+      if (!collision) {
+        hashShift_ = shift;
+        hashMask_ = size - 1;
+        hashTable_ = std::move(table);
+        hashValues_ = std::move(values);
+        return;
+      }
+    }
+  }
+}
+
 bool BytesValues::testingEquals(const Filter& other) const {
   auto otherBytesValues = dynamic_cast<const BytesValues*>(&other);
   auto res = otherBytesValues != nullptr && Filter::testingBaseEquals(other) &&
@@ -807,6 +892,35 @@ bool BigintValuesUsingBitmask::testInt64Range(
   return !(min > max_ || max < min_);
 }
 
+BigintValuesUsingBloomFilter::BigintValuesUsingBloomFilter(
+    int64_t min,
+    int64_t max,
+    std::shared_ptr<const BloomFilter<>> bloomFilter,
+    bool nullAllowed)
+    : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+      min_(min),
+      max_(max),
+      bloomFilter_(std::move(bloomFilter)) {
+  VELOX_CHECK_LE(min_, max_, "min must not be greater than max");
+  VELOX_CHECK_NOT_NULL(bloomFilter_);
+  VELOX_CHECK(bloomFilter_->isSet(), "Bloom filter must be initialized");
+}
+
+bool BigintValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (min == max) {
+    return testInt64(min);
+  }
+
+  return !(min > max_ || max < min_);
+}
+
 BigintValuesUsingHashTable::BigintValuesUsingHashTable(
     int64_t min,
     int64_t max,
@@ -1877,6 +1991,8 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
           std::make_unique<common::BigintRange>(lower_, upper_, false));
       return combineRangesAndNegatedValues(rangeList, vals, bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -1996,6 +2112,8 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
           negatedValuesToRanges(rejectedValues),
           bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2054,6 +2172,8 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
       return mergeWith(min_, max_, other);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2147,6 +2267,8 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
       return mergeWith(min_, max_, other);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2167,6 +2289,62 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
   return createBigintValues(valuesToKeep, bothNullAllowed);
 }
 
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  // The result may pass values that fail the Bloom filter but never values
+  // that fail 'other', so that merging with an exact filter stays exact.
+  const bool bothNullAllowed = nullAllowed_ && other->testNull();
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this, false);
+    case FilterKind::kBigintRange: {
+      auto otherRange = static_cast<const BigintRange*>(other);
+      auto min = std::max(min_, otherRange->lower());
+      auto max = std::min(max_, otherRange->upper());
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      auto otherBloomFilter =
+          static_cast<const BigintValuesUsingBloomFilter*>(other);
+      auto min = std::max(min_, otherBloomFilter->min_);
+      auto max = std::min(max_, otherBloomFilter->max_);
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask: {
+      auto values = other->kind() == FilterKind::kBigintValuesUsingHashTable
+          ? static_cast<const BigintValuesUsingHashTable*>(other)->values()
+          : static_cast<const BigintValuesUsingBitmask*>(other)->values();
+      std::vector<int64_t> valuesToKeep;
+      for (auto value : values) {
+        if (testInt64(value)) {
+          valuesToKeep.push_back(value);
+        }
+      }
+      return createBigintValues(valuesToKeep, bothNullAllowed);
+    }
+    case FilterKind::kNegatedBigintRange:
+    case FilterKind::kNegatedBigintValuesUsingBitmask:
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kBigintMultiRange:
+      return other->clone(bothNullAllowed);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     const Filter* other) const {
   // Rules of NegatedBigintValuesUsingHashTable with IsNull/IsNotNull
@@ -2201,6 +2379,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingBitmask: {
       return other->mergeWith(this);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2245,6 +2425,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
       return combineNegatedBigintLists(
           values(), otherBitmask->values(), bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2318,6 +2500,8 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
       bool bothNullAllowed = nullAllowed_ && other->testNull();
       return combineRangesAndNegatedValues(ranges_, rejects, bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -24,7 +25,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +59,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -1062,6 +1066,18 @@ class BigintValuesUsingBitmask final : public Filter {
 
   bool testInt64(int64_t value) const final;
 
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t> x) const final {
+    return testValuesImpl(x);
+  }
+
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t> x) const final {
+    return testValuesImpl(x);
+  }
+
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t> x) const final {
+    return testValuesImpl(x);
+  }
+
   bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
 
   std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
@@ -1072,11 +1088,93 @@ class BigintValuesUsingBitmask final : public Filter {
   std::unique_ptr<Filter>
   mergeWith(int64_t min, int64_t max, const Filter* other) const;
 
+  // Rejects the batches with all values outside of [min_, max_] without
+  // looking at the bitmask. Tests the values one by one otherwise.
+  template <typename T>
+  xsimd::batch_bool<T> testValuesImpl(xsimd::batch<T> values) const {
+    constexpr int64_t kMin = std::numeric_limits<T>::min();
+    constexpr int64_t kMax = std::numeric_limits<T>::max();
+    if (max_ < kMin || min_ > kMax) {
+      return xsimd::batch_bool<T>(false);
+    }
+    const auto inRange =
+        (xsimd::broadcast<T>(std::max(min_, kMin)) <= values) &
+        (values <= xsimd::broadcast<T>(std::min(max_, kMax)));
+    if (xsimd::none(inRange)) {
+      return inRange;
+    }
+    return Filter::testValues(values);
+  }
+
   std::vector<bool> bitmask_;
   const int64_t min_;
   const int64_t max_;
 };
 
+/// IN-list filter for integral data types that may pass values not in the
+/// list. Implemented as a Bloom filter over the values and their range. Used
+/// for dynamic filters on join keys with too many distinct values for an exact
+/// list. Merging with an exact filter keeps the exact filter, so this filter
+/// must not be used where false positives change results.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param min Minimum value.
+  /// @param max Maximum value.
+  /// @param bloomFilter Bloom filter over folly::hasher<int64_t> of the values.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed);
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_) {}
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this);
+    }
+  }
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  bool testInt64(int64_t value) const final {
+    return value >= min_ && value <= max_ &&
+        bloomFilter_->mayContain(folly::hasher<int64_t>()(value));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const int64_t min_;
+  const int64_t max_;
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+};
+
 // NOT IN-list filter for integral data types. Implemented as a hash table. Good
 // for large number of rejected values that do not fit within a small range.
 class NegatedBigintValuesUsingHashTable final : public Filter {
@@ -1199,6 +1297,18 @@ class NegatedBigintValuesUsingBitmask final : public Filter {
     return !nonNegated_->testInt64(value);
   }
 
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t> x) const final {
+    return ~nonNegated_->testValues(x);
+  }
+
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t> x) const final {
+    return ~nonNegated_->testValues(x);
+  }
+
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t> x) const final {
+    return ~nonNegated_->testValues(x);
+  }
+
   bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
 
   std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
@@ -1858,6 +1968,7 @@ class BytesValues final : public Filter {
 
     lower_ = *std::min_element(values_.begin(), values_.end());
     upper_ = *std::max_element(values_.begin(), values_.end());
+    makePerfectHash();
   }
 
   BytesValues(const BytesValues& other, bool nullAllowed)
@@ -1865,7 +1976,11 @@ class BytesValues final : public Filter {
         lower_(other.lower_),
         upper_(other.upper_),
         values_(other.values_),
-        lengths_(other.lengths_) {}
+        lengths_(other.lengths_),
+        hashShift_(other.hashShift_),
+        hashMask_(other.hashMask_),
+        hashTable_(other.hashTable_),
+        hashValues_(other.hashValues_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1885,8 +2000,17 @@ class BytesValues final : public Filter {
   }
 
   bool testBytes(const char* value, int32_t length) const final {
-    return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+    if (!lengths_.contains(length)) {
+      return false;
+    }
+    const std::string_view view(value, length);
+    if (!hashTable_.empty()) {
+      const auto index =
+          hashTable_[(folly::hasher<std::string_view>()(view) >> hashShift_) &
+                     hashMask_];
+      return index >= 0 && hashValues_[index] == view;
+    }
+    return values_.contains(view);
   }
 
   bool testBytesRange(
@@ -1900,13 +2024,33 @@ class BytesValues final : public Filter {
     return values_;
   }
 
+  /// Returns true if the values are looked up in a collision free hash table.
+  bool hasPerfectHash() const {
+    return !hashTable_.empty();
+  }
+
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // Lists with at most this many values are tested with a perfect hash.
+  static constexpr int32_t kMaxPerfectHashValues = 32;
+
+  // Fills 'hashTable_' if there are few values and a table size and hash
+  // shift without collisions is found.
+  void makePerfectHash();
+
   std::string lower_;
   std::string upper_;
   folly::F14FastSet<std::string> values_;
   folly::F14FastSet<uint32_t> lengths_;
+
+  // Perfect hash of 'values_'. Slot '(hash(value) >> hashShift_) & hashMask_'
+  // of 'hashTable_' is the index of 'value' in 'hashValues_' or -1. Empty if
+  // there is no perfect hash.
+  int32_t hashShift_{0};
+  uint64_t hashMask_{0};
+  std::vector<int8_t> hashTable_;
+  std::vector<std::string> hashValues_;
 };
 
 /// Represents a combination of two of more range filters on integral types with
@@ -1932,6 +2076,18 @@ class BigintMultiRange final : public Filter {
 
   bool testInt64(int64_t value) const final;
 
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t> x) const final {
+    return testValuesImpl(x);
+  }
+
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t> x) const final {
+    return testValuesImpl(x);
+  }
+
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t> x) const final {
+    return testValuesImpl(x);
+  }
+
   bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
 
   std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
@@ -1953,6 +2109,22 @@ class BigintMultiRange final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // Above this many ranges, a binary search per value is cheaper than testing
+  // all ranges on the whole batch.
+  static constexpr int32_t kMaxBatchRanges = 8;
+
+  template <typename T>
+  xsimd::batch_bool<T> testValuesImpl(xsimd::batch<T> values) const {
+    if (ranges_.size() > kMaxBatchRanges) {
+      return Filter::testValues(values);
+    }
+    auto result = ranges_[0]->testValues(values);
+    for (auto i = 1; i < ranges_.size(); ++i) {
+      result = result | ranges_[i]->testValues(values);
+    }
+    return result;
+  }
+
   const std::vector<std::unique_ptr<BigintRange>> ranges_;
   std::vector<int64_t> lowerBounds_;
 };
@@ -2041,6 +2213,14 @@ class MultiRange final : public Filter {
 
   bool testFloat(float value) const final;
 
+  xsimd::batch_bool<double> testValues(xsimd::batch<double> x) const final {
+    return testFloatingPoints(x);
+  }
+
+  xsimd::batch_bool<float> testValues(xsimd::batch<float> x) const final {
+    return testFloatingPoints(x);
+  }
+
   bool testBytes(const char* value, int32_t length) const final;
 
   bool testTimestamp(Timestamp value) const final;
@@ -2067,6 +2247,16 @@ class MultiRange final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  template <typename T>
+  xsimd::batch_bool<T> testFloatingPoints(xsimd::batch<T> values) const {
+    xsimd::batch_bool<T> result(false);
+    for (const auto& filter : filters_) {
+      result = result | filter->testValues(values);
+    }
+    const auto nans = xsimd::isnan(values);
+    return nanAllowed_ ? (result & ~nans) | nans : result & ~nans;
+  }
+
   const std::vector<std::unique_ptr<Filter>> filters_;
   const bool nanAllowed_;
 };
@@ -14,8 +14,14 @@
  * limitations under the License.
  */
 #include "velox/type/Timestamp.h"
+#include <algorithm>
 #include <charconv>
 #include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 #include "velox/common/base/CountBits.h"
 #include "velox/external/date/tz.h"
 #include "velox/type/tz/TimeZoneMap.h"
@@ -34,6 +40,112 @@ inline int64_t getPrestoTZOffsetInSeconds(int16_t tzID) {
   return ((tzID <= 840) ? (tzID - 841) : (tzID - 840)) * 60;
 }
 
+// The UTC offsets of a time zone between years 1900 and 2100, precomputed
+// from the date library. Converting a timestamp in this range is a binary
+// search over a sorted array of transition times instead of a date library
+// lookup. Times outside of the range fall back to the date library.
+class TimeZoneTransitions {
+ public:
+  // 1900-01-01 and 2100-01-01 in seconds since epoch.
+  static constexpr int64_t kBegin = -2'208'988'800;
+  static constexpr int64_t kEnd = 4'102'444'800;
+
+  explicit TimeZoneTransitions(const date::time_zone& zone) {
+    int64_t seconds = kBegin;
+    while (seconds < kEnd) {
+      const auto info =
+          zone.get_info(date::sys_seconds{std::chrono::seconds(seconds)});
+      const int64_t offset = info.offset.count();
+      // Consecutive ranges may differ only in abbreviation or DST flag.
+      if (offsets_.empty() || offsets_.back() != offset) {
+        begins_.push_back(seconds);
+        offsets_.push_back(offset);
+      }
+      seconds = info.end.time_since_epoch().count();
+    }
+  }
+
+  // Returns the local time for UTC 'seconds' or std::nullopt if 'seconds' is
+  // outside of the precomputed range.
+  std::optional<int64_t> toLocal(int64_t seconds) const {
+    if (seconds < kBegin || seconds >= kEnd) {
+      return std::nullopt;
+    }
+    return seconds + offsets_[indexOf(seconds)];
+  }
+
+  // Returns the UTC time for local time 'seconds', the earliest one if
+  // 'seconds' is ambiguous. Returns std::nullopt if 'seconds' is outside of
+  // the precomputed range or does not exist in the time zone.
+  std::optional<int64_t> toSys(int64_t seconds) const {
+    if (seconds < kBegin + kMaxOffset || seconds >= kEnd - kMaxOffset) {
+      return std::nullopt;
+    }
+    // The UTC time is within kMaxOffset of the local time. Tries the ranges
+    // in that interval in ascending order of time.
+    const auto last = indexOf(seconds + kMaxOffset);
+    for (auto i = indexOf(seconds - kMaxOffset); i <= last; ++i) {
+      const auto sysSeconds = seconds - offsets_[i];
+      if (sysSeconds >= begins_[i] &&
+          (i + 1 == begins_.size() || sysSeconds < begins_[i + 1])) {
+        return sysSeconds;
+      }
+    }
+    return std::nullopt;
+  }
+
+ private:
+  // UTC offsets are within a day.
+  static constexpr int64_t kMaxOffset = 86'400;
+
+  // Returns the index of the range that contains UTC 'seconds'.
+  size_t indexOf(int64_t seconds) const {
+    return std::upper_bound(begins_.begin(), begins_.end(), seconds) -
+        begins_.begin() - 1;
+  }
+
+  // The UTC start of each range in ascending order. The first is kBegin.
+  std::vector<int64_t> begins_;
+  // The offset from UTC in seconds of each range.
+  std::vector<int64_t> offsets_;
+};
+
+// Returns the transition table of 'zone'. Tables are built on first use and
+// kept for the life of the process, like the date library time zones. The
+// last table used is remembered per thread, so that converting a column of
+// timestamps in one time zone does not lock.
+const TimeZoneTransitions& getTransitions(const date::time_zone& zone) {
+  thread_local const date::time_zone* lastZone = nullptr;
+  thread_local const TimeZoneTransitions* lastTransitions = nullptr;
+  if (&zone != lastZone) {
+    static std::mutex mutex;
+    static std::unordered_map<
+        const date::time_zone*,
+        std::unique_ptr<TimeZoneTransitions>>
+        transitions;
+    std::lock_guard<std::mutex> l(mutex);
+    auto& entry = transitions[&zone];
+    if (entry == nullptr) {
+      entry = std::make_unique<TimeZoneTransitions>(zone);
+    }
+    lastZone = &zone;
+    lastTransitions = entry.get();
+  }
+  return *lastTransitions;
+}
+
+// Returns the time zone for a PrestoDB time zone ID above 1680. Remembers the
+// last one per thread to avoid looking up the name for each value.
+const date::time_zone& locateZone(int16_t tzID) {
+  thread_local int16_t lastID = -1;
+  thread_local const date::time_zone* lastZone = nullptr;
+  if (tzID != lastID) {
+    lastZone = date::locate_zone(util::getTimeZoneName(tzID));
+    lastID = tzID;
+  }
+  return *lastZone;
+}
+
 } // namespace
 
 // static
@@ -58,6 +170,11 @@ void Timestamp::toGMT(const date::time_zone& zone) {
       kMaxSeconds,
       "Timestamp seconds out of range for time zone adjustment");
 
+  if (const auto sysSeconds = getTransitions(zone).toSys(seconds_)) {
+    seconds_ = *sysSeconds;
+    return;
+  }
+
   date::local_time<std::chrono::seconds> localTime{
       std::chrono::seconds(seconds_)};
   std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>
@@ -82,7 +199,7 @@ void Timestamp::toGMT(int16_t tzID) {
     seconds_ -= getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
-    toGMT(*date::locate_zone(util::getTimeZoneName(tzID)));
+    toGMT(locateZone(tzID));
   }
 }
 
@@ -119,6 +236,10 @@ Timestamp::toTimePoint(bool allowOverflow) const {
 }
 
 void Timestamp::toTimezone(const date::time_zone& zone) {
+  if (const auto localSeconds = getTransitions(zone).toLocal(seconds_)) {
+    seconds_ = *localSeconds;
+    return;
+  }
   auto tp = toTimePoint();
   auto epoch = zone.to_local(tp).time_since_epoch();
   // NOTE: Round down to get the seconds of the current time point.
@@ -132,7 +253,7 @@ void Timestamp::toTimezone(int16_t tzID) {
     seconds_ += getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
-    toTimezone(*date::locate_zone(util::getTimeZoneName(tzID)));
+    toTimezone(locateZone(tzID));
   }
 }
 
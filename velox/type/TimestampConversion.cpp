@@ -698,9 +698,55 @@ namespace {
       std::string(str, len));
 }
 
+// Parses the common 'YYYY-MM-DD HH:MM:SS' form, also with 'T' as separator.
+// Returns false for any other input or an invalid date or time, which then
+// goes through the general parser.
+bool tryParseFixedTimestamp(const char* str, size_t len, Timestamp& result) {
+  constexpr std::string_view kLayout = "0000-00-00 00:00:00";
+  if (len != kLayout.size() || (str[10] != ' ' && str[10] != 'T')) {
+    return false;
+  }
+  bool matches = true;
+  for (auto i = 0; i < kLayout.size(); ++i) {
+    matches &= kLayout[i] == '0' ? characterIsDigit(str[i])
+                                 : (i == 10 || str[i] == kLayout[i]);
+  }
+  if (!matches) {
+    return false;
+  }
+  auto number = [&](int32_t offset, int32_t size) {
+    int32_t value = 0;
+    for (auto i = offset; i < offset + size; ++i) {
+      value = value * 10 + (str[i] - '0');
+    }
+    return value;
+  };
+  const auto year = number(0, 4);
+  const auto month = number(5, 2);
+  const auto day = number(8, 2);
+  const auto hour = number(11, 2);
+  const auto minute = number(14, 2);
+  const auto second = number(17, 2);
+  if (year == 0 || hour >= 24 || minute >= 60 || second >= 60 ||
+      !isValidDate(year, month, day)) {
+    return false;
+  }
+  int64_t daysSinceEpoch;
+  if (!daysSinceEpochFromDate(year, month, day, daysSinceEpoch).ok()) {
+    return false;
+  }
+  result = fromDatetime(daysSinceEpoch, fromTime(hour, minute, second, 0));
+  return true;
+}
+
 } // namespace
 
 Timestamp fromTimestampString(const char* str, size_t len) {
+  Timestamp timestamp;
+  if (tryParseFixedTimestamp(str, len, timestamp)) {
+    return timestamp;
+  }
+
   size_t pos;
   int64_t daysSinceEpoch;
   int64_t microsSinceMidnight;
@@ -727,7 +773,7 @@ Timestamp fromTimestampString(const char* str, size_t len) {
   }
 
   pos += timePos;
-  auto timestamp = fromDatetime(daysSinceEpoch, microsSinceMidnight);
+  timestamp = fromDatetime(daysSinceEpoch, microsSinceMidnight);
 
   if (pos < len) {
     // Skip a "Z" at the end (as per the ISO 8601 specs).
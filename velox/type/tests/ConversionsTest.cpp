@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/type/Conversions.h"
+#include <optional>
 #include "gtest/gtest.h"
 #include "velox/common/base/VeloxException.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -582,6 +583,43 @@ TEST_F(ConversionsTest, toIntegeralTypes) {
   }
 }
 
+TEST_F(ConversionsTest, tryParseDecimalInteger) {
+  auto parse = [](const std::string& input) -> std::optional<int64_t> {
+    int64_t result;
+    if (tryParseDecimalInteger(input.data(), input.size(), result)) {
+      return result;
+    }
+    return std::nullopt;
+  };
+  EXPECT_EQ(0, parse("0"));
+  EXPECT_EQ(-7, parse("-7"));
+  EXPECT_EQ(12345678, parse("12345678"));
+  EXPECT_EQ(-123456789, parse("-123456789"));
+  EXPECT_EQ(1234567890123456789, parse("1234567890123456789"));
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(), parse("9223372036854775807"));
+  EXPECT_EQ(std::numeric_limits<int64_t>::min(), parse("-9223372036854775808"));
+  EXPECT_EQ(42, parse("00000000000000042"));
+
+  // Other forms are left to the general conversion.
+  EXPECT_EQ(std::nullopt, parse(""));
+  EXPECT_EQ(std::nullopt, parse("-"));
+  EXPECT_EQ(std::nullopt, parse("+1"));
+  EXPECT_EQ(std::nullopt, parse(" 1"));
+  EXPECT_EQ(std::nullopt, parse("1234567a"));
+  EXPECT_EQ(std::nullopt, parse("123456789:"));
+  EXPECT_EQ(std::nullopt, parse("9223372036854775808"));
+  EXPECT_EQ(std::nullopt, parse("-9223372036854775809"));
+  EXPECT_EQ(std::nullopt, parse("00000000000000000042"));
+
+  int8_t tinyint;
+  EXPECT_TRUE(tryParseDecimalInteger("-128", 4, tinyint));
+  EXPECT_EQ(-128, tinyint);
+  EXPECT_TRUE(tryParseDecimalInteger("127", 3, tinyint));
+  EXPECT_EQ(127, tinyint);
+  EXPECT_FALSE(tryParseDecimalInteger("128", 3, tinyint));
+  EXPECT_FALSE(tryParseDecimalInteger("-129", 4, tinyint));
+}
+
 TEST_F(ConversionsTest, toString) {
   // From integral types.
   {
@@ -97,6 +97,13 @@ TEST_F(FilterSerDeTest, valuesFilters) {
     for (auto nullAllowed : {false, true}) {
       testSerde(BigintValuesUsingHashTable(lower, upper, values, nullAllowed));
       testSerde(BigintValuesUsingBitmask(lower, upper, values, nullAllowed));
+      auto bloomFilter = std::make_shared<BloomFilter<>>();
+      bloomFilter->reset(values.size());
+      for (auto value : values) {
+        bloomFilter->insert(folly::hasher<int64_t>()(value));
+      }
+      testSerde(BigintValuesUsingBloomFilter(
+          lower, upper, std::move(bloomFilter), nullAllowed));
       testSerde(
           NegatedBigintValuesUsingHashTable(lower, upper, values, nullAllowed));
       testSerde(
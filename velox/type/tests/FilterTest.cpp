@@ -452,6 +452,69 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(11, 11, false));
   EXPECT_FALSE(filter->testInt64Range(-10, -5, false));
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
+
+  auto testInt64 = [&](int64_t x) { return filter->testInt64(x); };
+  {
+    int64_t n4[] = {2, 1, 1000, -1000};
+    checkSimd(filter.get(), n4, testInt64);
+    int64_t outOfRange[] = {-1, 0, 1001, INT64_MAX};
+    checkSimd(filter.get(), outOfRange, testInt64);
+    int32_t n8[] = {2, 1, 1000, -1000, 10, 100, 0, 1111};
+    checkSimd(filter.get(), n8, testInt64);
+    int16_t n16[] = {
+        2, 1, 1000, -1000, 1, 10, 0, 1111, 2, 100, 1000, -1000, 1, 1, 0, 999};
+    checkSimd(filter.get(), n16, testInt64);
+  }
+}
+
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(1'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    bloomFilter->insert(folly::hasher<int64_t>()(i * 10));
+  }
+  BigintValuesUsingBloomFilter filter(0, 9'990, bloomFilter, false);
+
+  for (auto i = 0; i < 1'000; ++i) {
+    EXPECT_TRUE(filter.testInt64(i * 10));
+  }
+  int32_t numPassed = 0;
+  for (auto i = 0; i < 1'000; ++i) {
+    numPassed += filter.testInt64(i * 10 + 1);
+  }
+  EXPECT_LT(numPassed, 100);
+  EXPECT_FALSE(filter.testNull());
+  EXPECT_FALSE(filter.testInt64(-10));
+  EXPECT_FALSE(filter.testInt64(10'000));
+
+  EXPECT_TRUE(filter.testInt64Range(5, 50, false));
+  EXPECT_TRUE(filter.testInt64Range(100, 100, false));
+  EXPECT_FALSE(filter.testInt64Range(-10, -5, false));
+  EXPECT_FALSE(filter.testInt64Range(10'000, 20'000, false));
+  EXPECT_FALSE(filter.testInt64Range(10'000, 20'000, true));
+
+  // Merging with a range narrows the range and keeps the Bloom filter.
+  BigintRange range(100, 20'000, false);
+  auto merged = filter.mergeWith(&range);
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_FALSE(merged->testInt64(90));
+  EXPECT_TRUE(merged->testInt64(100));
+  EXPECT_FALSE(merged->testInt64(10'000));
+  auto mergedBack = range.mergeWith(&filter);
+  ASSERT_TRUE(merged->testingEquals(*mergedBack));
+
+  BigintRange disjoint(10'000, 20'000, false);
+  EXPECT_EQ(filter.mergeWith(&disjoint)->kind(), FilterKind::kAlwaysFalse);
+
+  // Merging with an exact filter drops the values that fail the Bloom filter.
+  auto values = createBigintValues({-10, 10, 11, 20, 30, 20'000}, false);
+  merged = filter.mergeWith(values.get());
+  EXPECT_FALSE(merged->testInt64(-10));
+  EXPECT_TRUE(merged->testInt64(10));
+  EXPECT_TRUE(merged->testInt64(20));
+  EXPECT_TRUE(merged->testInt64(30));
+  EXPECT_FALSE(merged->testInt64(40));
+  EXPECT_FALSE(merged->testInt64(20'000));
 }
 
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
@@ -483,6 +546,17 @@ TEST(FilterTest, negatedBigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(100, 100, false));
   EXPECT_FALSE(filter->testInt64Range(6, 6, true));
 
+  auto testInt64 = [&](int64_t x) { return filter->testInt64(x); };
+  {
+    int64_t n4[] = {2, 1, 1000, -1000};
+    checkSimd(filter.get(), n4, testInt64);
+    int32_t n8[] = {2, 1, 1000, -1000, 10, 100, 0, 1111};
+    checkSimd(filter.get(), n8, testInt64);
+    int16_t n16[] = {
+        2, 1, 1000, -1000, 1, 10, 0, 1111, 2, 100, 1000, -1000, 1, 9, 0, 8};
+    checkSimd(filter.get(), n16, testInt64);
+  }
+
   auto filter_copy = filter->clone();
   EXPECT_FALSE(filter_copy->testInt64(1));
   EXPECT_FALSE(filter_copy->testInt64(10));
@@ -590,6 +664,17 @@ TEST(FilterTest, bigintMultiRange) {
   EXPECT_TRUE(filter->testInt64Range(105, 115, true));
   EXPECT_FALSE(filter->testInt64Range(15, 45, false));
   EXPECT_FALSE(filter->testInt64Range(15, 45, true));
+
+  auto testInt64 = [&](int64_t x) { return filter->testInt64(x); };
+  {
+    int64_t n4[] = {2, 11, 100, 121};
+    checkSimd(filter.get(), n4, testInt64);
+    int32_t n8[] = {0, 1, 10, 50, 99, 100, 120, 1111};
+    checkSimd(filter.get(), n8, testInt64);
+    int16_t n16[] = {
+        2, 1, 1000, -1000, 1, 10, 0, 110, 2, 100, 1000, -1000, 1, 9, 0, 8};
+    checkSimd(filter.get(), n16, testInt64);
+  }
 }
 
 TEST(FilterTest, boolValue) {
@@ -950,6 +1035,26 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, bytesValuesPerfectHash) {
+  auto test = [](int32_t numValues, bool perfectHash) {
+    SCOPED_TRACE(numValues);
+    std::vector<std::string> values;
+    for (auto i = 0; i < numValues; ++i) {
+      values.push_back(fmt::format("value-{}", i * 2));
+    }
+    auto filter = in(values);
+    ASSERT_EQ(filter->hasPerfectHash(), perfectHash);
+    auto clone = filter->clone(true);
+    for (auto i = 0; i < numValues * 2; ++i) {
+      auto value = fmt::format("value-{}", i);
+      EXPECT_EQ(filter->testBytes(value.data(), value.size()), i % 2 == 0);
+      EXPECT_EQ(clone->testBytes(value.data(), value.size()), i % 2 == 0);
+    }
+  };
+  test(5, true);
+  test(100, false);
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(
@@ -1099,6 +1204,19 @@ TEST(FilterTest, multiRangeWithNaNs) {
   EXPECT_FALSE(filter->testDouble(std::nan("nan")));
   EXPECT_FALSE(filter->testDouble(1.2));
   EXPECT_TRUE(filter->testDouble(1.3));
+
+  for (auto nanAllowed : {false, true}) {
+    filter = orFilter(
+        lessThanDouble(1.2), greaterThanDouble(1.3), false, nanAllowed);
+    double d4[] = {std::nan("nan"), 1.2, 1.25, 1.4};
+    checkSimd(
+        filter.get(), d4, [&](double x) { return filter->testDouble(x); });
+
+    filter =
+        orFilter(lessThanFloat(1.2), greaterThanFloat(1.3), false, nanAllowed);
+    float f8[] = {std::nanf("nan"), 1.2f, 1.25f, 1.4f, 1.1f, 1.3f, 0, 2};
+    checkSimd(filter.get(), f8, [&](float x) { return filter->testFloat(x); });
+  }
 }
 
 TEST(FilterTest, createBigintValues) {
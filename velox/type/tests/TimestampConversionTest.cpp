@@ -298,6 +298,23 @@ TEST(DateTimeUtilTest, fromTimestampString) {
       fromTimestampString("2020-04-23 04:23:37+09:00"));
 }
 
+TEST(DateTimeUtilTest, fromTimestampStringFixedWidth) {
+  // 'YYYY-MM-DD HH:MM:SS' inputs take a fast path. Inputs of the same width
+  // that it rejects fall back to the general parser.
+  EXPECT_EQ(
+      Timestamp(951782400, 0), fromTimestampString("2000-02-29 00:00:00"));
+  EXPECT_EQ(Timestamp(-1, 0), fromTimestampString("1969-12-31T23:59:59"));
+  EXPECT_EQ(
+      Timestamp(253402300799, 0), fromTimestampString("9999-12-31 23:59:59"));
+  EXPECT_EQ(Timestamp(60, 0), fromTimestampString("1970-01-01 00:00:60"));
+  EXPECT_EQ(Timestamp(0, 0), fromTimestampString("1970-01-01 0:0:0    "));
+  EXPECT_THROW(fromTimestampString("2001-02-29 00:00:00"), VeloxUserError);
+  EXPECT_THROW(fromTimestampString("2000-01-01 24:00:00"), VeloxUserError);
+  EXPECT_THROW(fromTimestampString("2000-01-01 00:60:00"), VeloxUserError);
+  EXPECT_THROW(fromTimestampString("2000-01-01X00:00:00"), VeloxUserError);
+  EXPECT_THROW(fromTimestampString("2000/01/01 00:00:00"), VeloxUserError);
+}
+
 TEST(DateTimeUtilTest, fromTimestampStrInvalid) {
   // Needs at least a date.
   EXPECT_THROW(fromTimestampString(""), VeloxUserError);
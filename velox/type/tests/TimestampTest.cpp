@@ -313,6 +313,44 @@ TEST(TimestampTest, outOfRange) {
       t.toTimezone(*timezone), "Timestamp is outside of supported range");
 }
 
+TEST(TimestampTest, timezoneTransitions) {
+  // Compares the conversions with the date library around DST transitions,
+  // including a zone with a 30 minute DST shift.
+  for (const auto* name :
+       {"America/Los_Angeles",
+        "Europe/London",
+        "Asia/Kolkata",
+        "Australia/Lord_Howe"}) {
+    SCOPED_TRACE(name);
+    const auto* zone = date::locate_zone(name);
+    // 2021-01-01 to 2022-01-01 in 7 minute steps.
+    for (int64_t seconds = 1'609'459'200; seconds < 1'640'995'200;
+         seconds += 7 * 60) {
+      const date::sys_seconds sysTime{std::chrono::seconds(seconds)};
+      Timestamp local(seconds, 123);
+      local.toTimezone(*zone);
+      ASSERT_EQ(
+          zone->to_local(sysTime).time_since_epoch().count(),
+          local.getSeconds());
+      ASSERT_EQ(123, local.getNanos());
+
+      const date::local_seconds localTime{std::chrono::seconds(seconds)};
+      Timestamp gmt(seconds, 0);
+      const auto info = zone->get_info(localTime);
+      if (info.result == date::local_info::nonexistent) {
+        VELOX_ASSERT_THROW(gmt.toGMT(*zone), "");
+        continue;
+      }
+      gmt.toGMT(*zone);
+      ASSERT_EQ(
+          zone->to_sys(localTime, date::choose::earliest)
+              .time_since_epoch()
+              .count(),
+          gmt.getSeconds());
+    }
+  }
+}
+
 // In debug mode, Timestamp constructor will throw exception if range check
 // fails.
 #ifdef NDEBUG
@@ -721,7 +721,16 @@ void BaseVector::copy(
     rows.applyToSelected([&](vector_size_t row) {
       const auto sourceRow = toSourceRow[row];
       VELOX_DCHECK_GT(source->size(), sourceRow);
-      ranges.push_back({sourceRow, row, 1});
+      // Consecutive rows that copy consecutive source rows make one range, so
+      // that copyRanges() works on runs instead of single rows at every level
+      // of nesting.
+      if (!ranges.empty() &&
+          ranges.back().targetIndex + ranges.back().count == row &&
+          ranges.back().sourceIndex + ranges.back().count == sourceRow) {
+        ++ranges.back().count;
+      } else {
+        ranges.push_back({sourceRow, row, 1});
+      }
     });
   }
   copyRanges(source, ranges);
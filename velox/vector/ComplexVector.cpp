@@ -586,18 +586,28 @@ void ArrayVectorBase::copyRangesImpl(
           }
         });
     outRanges.reserve(totalCount);
+    // A flat source is read through its raw buffers instead of the virtual
+    // isNullAt() and wrappedIndex() of each row.
+    const bool isFlatSource = source == leafSource;
+    const auto* sourceNulls = source->rawNulls();
+    const auto* sourceOffsets = sourceArray->rawOffsets();
+    const auto* sourceSizes = sourceArray->rawSizes();
     applyToEachRow(ranges, [&](auto targetIndex, auto sourceIndex) {
-      if (source->isNullAt(sourceIndex)) {
+      const bool isNull = isFlatSource
+          ? sourceNulls && bits::isBitNull(sourceNulls, sourceIndex)
+          : source->isNullAt(sourceIndex);
+      if (isNull) {
         setNull(targetIndex, true);
       } else {
         if (setNotNulls) {
           setNull(targetIndex, false);
         }
-        auto wrappedIndex = source->wrappedIndex(sourceIndex);
-        auto copySize = sourceArray->sizeAt(wrappedIndex);
+        auto wrappedIndex =
+            isFlatSource ? sourceIndex : source->wrappedIndex(sourceIndex);
+        auto copySize = sourceSizes[wrappedIndex];
 
         if (copySize > 0) {
-          auto copyOffset = sourceArray->offsetAt(wrappedIndex);
+          auto copyOffset = sourceOffsets[wrappedIndex];
 
           // If we're copying two adjacent ranges, merge them.  This only
           // works if they're consecutive.
@@ -16,6 +16,7 @@
 #include "velox/vector/DecodedVector.h"
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/LazyVector.h"
 
@@ -214,6 +215,11 @@ void DecodedVector::applyDictionaryWrapper(
     indices_ = copiedIndices_.data();
   }
 
+  if (!nulls_ && !newNulls) {
+    composeIndices(rows, currentIndices, newIndices);
+    return;
+  }
+
   applyToRows(rows, [&](vector_size_t row) {
     if (!nulls_ || !bits::isBitNull(nulls_, row)) {
       auto wrappedIndex = currentIndices[row];
@@ -226,6 +232,50 @@ void DecodedVector::applyDictionaryWrapper(
   });
 }
 
+void DecodedVector::composeIndices(
+    const SelectivityVector* rows,
+    const vector_size_t* currentIndices,
+    const vector_size_t* newIndices) {
+  using Batch = xsimd::batch<vector_size_t>;
+  auto* result = copiedIndices_.data();
+  // 'currentIndices' may be 'result', so each batch is loaded before it is
+  // stored.
+  auto composeRange = [&](vector_size_t begin, vector_size_t end) {
+    auto row = begin;
+    for (; row + Batch::size <= end; row += Batch::size) {
+      simd::gather(newIndices, currentIndices + row)
+          .store_unaligned(result + row);
+    }
+    for (; row < end; ++row) {
+      result[row] = newIndices[currentIndices[row]];
+    }
+  };
+  if (!rows) {
+    composeRange(0, size_);
+    return;
+  }
+  if (rows->isAllSelected()) {
+    composeRange(rows->begin(), rows->end());
+    return;
+  }
+  const auto* selected = rows->asRange().bits();
+  auto composeWord = [&](int32_t index, uint64_t mask) {
+    mask &= selected[index];
+    if (mask == ~0ULL) {
+      composeRange(index * 64, index * 64 + 64);
+      return;
+    }
+    bits::forEachSetBit(&mask, 0, 64, [&](vector_size_t bit) {
+      const auto row = index * 64 + bit;
+      result[row] = newIndices[currentIndices[row]];
+    });
+  };
+  bits::forEachWord(
+      rows->begin(), rows->end(), composeWord, [&](int32_t index) {
+        composeWord(index, ~0ULL);
+      });
+}
+
 void DecodedVector::fillInIndices() {
   if (isConstantMapping_) {
     if (size_ > zeroIndices().size() || constantIndex_ != 0) {
@@ -339,6 +339,14 @@ class DecodedVector {
       const BaseVector& dictionaryVector,
       const SelectivityVector* rows);
 
+  // Sets 'copiedIndices_[row]' to 'newIndices[currentIndices[row]]' for
+  // 'rows'. Used when neither level has nulls. Gathers a SIMD batch of indices
+  // at a time over runs of selected rows.
+  void composeIndices(
+      const SelectivityVector* rows,
+      const vector_size_t* currentIndices,
+      const vector_size_t* newIndices);
+
   void copyNulls(vector_size_t size);
 
   void fillInIndices();
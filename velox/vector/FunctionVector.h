@@ -31,6 +31,13 @@ class Callable {
 
   virtual bool hasCapture() const = 0;
 
+  /// Returns true if any captured vector is not constant. Constant captures
+  /// have the same value for all rows and need no 'wrapCapture' mapping in
+  /// apply().
+  virtual bool hasNonConstantCapture() const {
+    return hasCapture();
+  }
+
   /// Applies 'this' to 'args' for 'rows' and returns the result in
   /// '*result'.
   /// @param rows The rows that this callable applies to. It is the element rows
@@ -41,7 +48,8 @@ class Callable {
   /// passing these to the function. The typical use case of lambdas applies a
   /// function to elements of repeated types, so that the values of the
   /// arguments and captures are not aligned. This serves to align these. If
-  /// nullptr, the captures are passed as is.
+  /// nullptr, the captures are passed as is, except that constant captures are
+  /// resized to the size of 'rows'.
   /// @param validRowsInReusedResult This selectivity vector is used to store
   /// all valid rows in 'result' that can be reused between multiple Callables
   /// in a function vector. It helps preserve rows that are valid in 'result'
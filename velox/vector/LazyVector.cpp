@@ -87,10 +87,7 @@ void VectorLoader::loadInternal(
       return;
     }
   }
-  std::vector<vector_size_t> positions(rows.countSelected());
-  int index = 0;
-  rows.applyToSelected([&](vector_size_t row) { positions[index++] = row; });
-  load(positions, hook, resultSize, result);
+  load(rows.selectedRows(), hook, resultSize, result);
 }
 
 VectorPtr LazyVector::slice(vector_size_t offset, vector_size_t length) const {
@@ -16,6 +16,7 @@
 #include "velox/vector/SelectivityVector.h"
 
 #include "velox/common/base/Nulls.h"
+#include "velox/common/base/SimdUtil.h"
 
 namespace facebook::velox {
 
@@ -29,6 +30,16 @@ SelectivityVector SelectivityVector::empty(vector_size_t size) {
   return SelectivityVector{size, false};
 }
 
+const raw_vector<vector_size_t>& SelectivityVector::selectedRows() const {
+  if (!selectedRowsValid_) {
+    selectedRows_.resize(countSelected());
+    selectedRows_.resize(simd::indicesOfSetBits(
+        bits_.data(), begin_, end_, selectedRows_.data()));
+    selectedRowsValid_ = true;
+  }
+  return selectedRows_;
+}
+
 std::string SelectivityVector::toString(
     vector_size_t maxSelectedRowsToPrint) const {
   const auto selectedCnt = countSelected();
@@ -25,6 +25,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Range.h"
+#include "velox/common/base/RawVector.h"
 #include "velox/vector/TypeAliases.h"
 
 namespace facebook {
@@ -88,6 +89,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = value ? size_ : 0;
     allSelected_ = value;
+    selectedRowsValid_ = false;
   }
 
   /**
@@ -99,6 +101,7 @@ class SelectivityVector {
     VELOX_DCHECK_LT(idx, bits_.size() * sizeof(bits_[0]) * 8);
     bits::setBit(bits_.data(), idx, valid);
     allSelected_.reset();
+    selectedRowsValid_ = false;
   }
 
   /**
@@ -114,6 +117,7 @@ class SelectivityVector {
     VELOX_DCHECK_LE(end, bits_.size() * sizeof(bits_[0]) * 8);
     bits::fillBits(bits_.data(), begin, end, valid);
     allSelected_.reset();
+    selectedRowsValid_ = false;
   }
 
   /**
@@ -131,6 +135,7 @@ class SelectivityVector {
    * updateBounds() need to be called explicitly if data is modified.
    */
   MutableRange<bool> asMutableRange() {
+    selectedRowsValid_ = false;
     return MutableRange<bool>(bits_.data(), begin_, end_);
   }
 
@@ -157,6 +162,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = 0;
     allSelected_ = false;
+    selectedRowsValid_ = false;
   }
 
   /**
@@ -167,6 +173,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = size_;
     allSelected_ = true;
+    selectedRowsValid_ = false;
   }
 
   void setFromBits(const uint64_t* bits, int32_t size) {
@@ -275,6 +282,7 @@ class SelectivityVector {
    * index (noting that the range in between may contain not selected indices).
    */
   void updateBounds() {
+    selectedRowsValid_ = false;
     begin_ = bits::findFirstBit(bits_.data(), 0, size_);
     if (begin_ == -1) {
       begin_ = 0;
@@ -306,6 +314,12 @@ class SelectivityVector {
     return count;
   }
 
+  /// Returns the selected rows in ascending order. The rows are computed with
+  /// SIMD on first use and cached until 'this' is next modified, so that
+  /// operations iterating over the same rows many times or needing them as a
+  /// RowSet do not decode the bits each time.
+  const raw_vector<vector_size_t>& selectedRows() const;
+
   vector_size_t size() const {
     return size_;
   }
@@ -377,6 +391,11 @@ class SelectivityVector {
 
   mutable std::optional<bool> allSelected_;
 
+  // Cache of the selected row numbers returned by selectedRows(). Valid only
+  // if 'selectedRowsValid_' is true. Every change to 'bits_' clears the flag.
+  mutable raw_vector<vector_size_t> selectedRows_;
+  mutable bool selectedRowsValid_{false};
+
   friend class SelectivityIterator;
 };
 
@@ -280,13 +280,14 @@ class SimpleVector : public BaseVector {
       return asciiInfo.isAllAscii();
     }
     ensureIsAsciiCapacity();
-    bool isAllAscii = true;
-    rows.template applyToSelected([&](auto row) {
-      if (!isNullAt(row)) {
-        auto string = valueAt(row);
-        isAllAscii &=
-            functions::stringCore::isAscii(string.data(), string.size());
+    // Stops at the first non-ASCII row since that decides the result for all
+    // of 'rows'.
+    const bool isAllAscii = rows.template testSelected([&](auto row) {
+      if (isNullAt(row)) {
+        return true;
       }
+      auto string = valueAt(row);
+      return functions::stringCore::isAscii(string.data(), string.size());
     });
 
     // Set isAllAscii flag, it will unset if we encounter any utf.
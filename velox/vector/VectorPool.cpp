@@ -47,16 +47,46 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+bool isComplexEncoding(VectorEncoding::Simple encoding) {
+  return encoding == VectorEncoding::Simple::ARRAY ||
+      encoding == VectorEncoding::Simple::MAP ||
+      encoding == VectorEncoding::Simple::ROW;
+}
 } // namespace
 
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
   auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+  if (size <= kMaxRecycleSize) {
+    if (cacheIndex >= 0) {
+      return vectors_[cacheIndex].pop(type, size, *pool_);
+    }
+    if (auto* typePool = complexTypePool(type, false)) {
+      return typePool->pop(type, size, *pool_);
+    }
   }
   return BaseVector::create(type, size, pool_);
 }
 
+VectorPool::TypePool* VectorPool::complexTypePool(
+    const TypePtr& type,
+    bool create) {
+  if (type->kind() != TypeKind::ARRAY && type->kind() != TypeKind::MAP &&
+      type->kind() != TypeKind::ROW) {
+    return nullptr;
+  }
+  for (auto& entry : complexVectors_) {
+    if (entry.type.get() == type.get()) {
+      return &entry.vectors;
+    }
+  }
+  if (!create || complexVectors_.size() >= kMaxComplexTypes) {
+    return nullptr;
+  }
+  complexVectors_.push_back({type, {}});
+  return &complexVectors_.back().vectors;
+}
+
 bool VectorPool::release(VectorPtr& vector) {
   if (FOLLY_UNLIKELY(vector == nullptr)) {
     return false;
@@ -66,10 +96,15 @@ bool VectorPool::release(VectorPtr& vector) {
   }
 
   auto cacheIndex = toCacheIndex(vector->type());
-  if (cacheIndex < 0) {
+  if (cacheIndex >= 0) {
+    return vectors_[cacheIndex].maybePushBack(vector);
+  }
+  if (!isComplexEncoding(vector->encoding()) ||
+      vector->retainedSize() > kMaxComplexRecycleBytes) {
     return false;
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  auto* typePool = complexTypePool(vector->type(), true);
+  return typePool != nullptr && typePool->maybePushBack(vector);
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -86,8 +121,11 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
 
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
-  // values Buffer and an uninitialized or unique and mutable nulls Buffer.
-  if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
+  // values Buffer and an uninitialized or unique and mutable nulls Buffer, or
+  // an array, map or row vector with unique and mutable buffers and children.
+  const bool isComplex = isComplexEncoding(vector->encoding());
+  if (!vector->isWritable() ||
+      (!isComplex && (!vector->isFlatEncoding() || !vector->values()))) {
     return false;
   }
   if (size >= kNumPerType) {
@@ -95,6 +133,11 @@ bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   }
 
   vector->prepareForReuse();
+  if (isComplex) {
+    // prepareForReuse() empties the children. pop() resizes the vector and its
+    // children together.
+    vector->resize(0);
+  }
   vectors[size++] = std::move(vector);
   return true;
 }
@@ -23,10 +23,13 @@ namespace facebook::velox {
 /// A thread-level cache of pre-allocated flat vectors of different types.
 /// Keeps up to 10 recyclable vectors of each type. A vector is
 /// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
-/// for an unsupported type is a no-op.
+/// Singleton built-in types and array, map and row types are supported. Array,
+/// map and row vectors keep their offsets, sizes and children, including the
+/// children's string buffers, for reuse. Their types are matched by identity,
+/// which is stable across batches for the types of an expression. Decimal
+/// types, fixed-size array type and custom types are not supported. Calling
+/// 'get' for an unsupported type already returns a newly allocated vector.
+/// Calling 'release' for an unsupported type is a no-op.
 class VectorPool {
  public:
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
@@ -48,6 +51,13 @@ class VectorPool {
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
 
+  /// Max number of distinct array, map and row types to keep vectors for.
+  static constexpr int32_t kMaxComplexTypes = 8;
+
+  /// Max retained bytes of a recyclable array, map or row vector, which may
+  /// have much more memory in its children than its size suggests.
+  static constexpr uint64_t kMaxComplexRecycleBytes = 8 << 20;
+
   struct TypePool {
     int32_t size{0};
     std::array<VectorPtr, kNumPerType> vectors;
@@ -65,8 +75,21 @@ class VectorPool {
   static constexpr int32_t kNumCachedVectorTypes =
       static_cast<int32_t>(TypeKind::HUGEINT) + 1;
 
+  struct ComplexTypePool {
+    TypePtr type;
+    TypePool vectors;
+  };
+
+  /// Returns the cache of vectors of array, map or row 'type'. Adds one if
+  /// 'create' is true and there are fewer than kMaxComplexTypes. Returns
+  /// nullptr otherwise.
+  TypePool* complexTypePool(const TypePtr& type, bool create);
+
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Caches of pre-allocated array, map and row vectors.
+  std::vector<ComplexTypePool> complexVectors_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
@@ -16,6 +16,8 @@
 
 #include "velox/vector/arrow/Bridge.h"
 
+#include <numeric>
+
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CheckedArithmetic.h"
@@ -31,17 +33,33 @@ namespace facebook::velox {
 namespace {
 
 // The supported conversions use one buffer for nulls (0), one for values (1),
-// and one for offsets (2).
+// and one for offsets (2). The string view layout has a variable number of
+// buffers.
 static constexpr size_t kMaxBuffers{3};
 
+// Layout of a string in the Arrow BinaryView and Utf8View arrays. Strings of
+// up to 12 bytes are stored in place of 'prefix', 'bufferIndex' and 'offset',
+// the same way as in an inlined Velox StringView.
+struct ArrowStringView {
+  int32_t size;
+  char prefix[4];
+  int32_t bufferIndex;
+  int32_t offset;
+};
+static_assert(sizeof(ArrowStringView) == sizeof(StringView));
+
 // Structure that will hold the buffers needed by ArrowArray. This is opaquely
 // carried by ArrowArray.private_data
 class VeloxToArrowBridgeHolder {
  public:
-  VeloxToArrowBridgeHolder() {
-    for (size_t i = 0; i < kMaxBuffers; ++i) {
-      buffers_[i] = nullptr;
-    }
+  VeloxToArrowBridgeHolder()
+      : buffers_(kMaxBuffers, nullptr), bufferPtrs_(kMaxBuffers) {}
+
+  // Resizes the buffers to 'numBuffers'. Invalidates the pointer returned by
+  // getArrowBuffers().
+  void resizeBuffers(size_t numBuffers) {
+    buffers_.resize(numBuffers, nullptr);
+    bufferPtrs_.resize(numBuffers);
   }
 
   // Acquires a buffer at index `idx`.
@@ -58,7 +76,7 @@ class VeloxToArrowBridgeHolder {
   }
 
   const void** getArrowBuffers() {
-    return buffers_;
+    return buffers_.data();
   }
 
   // Allocates space for `numChildren` ArrowArray pointers.
@@ -89,11 +107,11 @@ class VeloxToArrowBridgeHolder {
 
  private:
   // Holds the pointers to the arrow buffers.
-  const void* buffers_[kMaxBuffers];
+  std::vector<const void*> buffers_;
 
   // Holds ownership over the Buffers being referenced by the buffers vector
   // above.
-  BufferPtr bufferPtrs_[kMaxBuffers];
+  std::vector<BufferPtr> bufferPtrs_;
 
   // Auxiliary buffers to hold ownership over ArrowArray children structures.
   std::vector<std::unique_ptr<ArrowArray>> childrenPtrs_;
@@ -249,9 +267,9 @@ const char* exportArrowFormatStr(
     // We always map VARCHAR and VARBINARY to the "small" version (lower case
     // format string), which uses 32 bit offsets.
     case TypeKind::VARCHAR:
-      return "u"; // utf-8 string
+      return options.exportToStringView ? "vu" : "u"; // utf-8 string
     case TypeKind::VARBINARY:
-      return "z"; // binary
+      return options.exportToStringView ? "vz" : "z"; // binary
     case TypeKind::UNKNOWN:
       return "n"; // NullType
     case TypeKind::TIMESTAMP:
@@ -548,6 +566,66 @@ VectorPtr createStringFlatVector(
       optionalNullCount(nullCount));
 }
 
+// Imports an Arrow string view array. The string buffers are wrapped without
+// copying. Only the 16 byte views are converted, as Velox refers to the
+// strings by address instead of by buffer index and offset.
+VectorPtr createStringViewFlatVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  VELOX_USER_CHECK_GE(
+      arrowArray.n_buffers,
+      3,
+      "Expecting at least three buffers as input for string view types.");
+  const auto length = arrowArray.length;
+  const auto numBuffers = arrowArray.n_buffers - 3;
+  const auto* views =
+      static_cast<const ArrowStringView*>(arrowArray.buffers[1]);
+  const auto* sizes =
+      static_cast<const int64_t*>(arrowArray.buffers[arrowArray.n_buffers - 1]);
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+
+  BufferPtr stringViews = AlignedBuffer::allocate<StringView>(length, pool);
+  auto* rawStringViews = stringViews->asMutable<StringView>();
+  for (size_t i = 0; i < length; ++i) {
+    const auto& view = views[i];
+    if ((rawNulls && bits::isBitNull(rawNulls, i)) || view.size == 0) {
+      rawStringViews[i] = StringView();
+    } else if (view.size <= StringView::kInlineSize) {
+      rawStringViews[i] = StringView(view.prefix, view.size);
+    } else {
+      VELOX_USER_CHECK_LT(
+          view.bufferIndex,
+          numBuffers,
+          "String view refers to a missing buffer.");
+      rawStringViews[i] = StringView(
+          static_cast<const char*>(arrowArray.buffers[2 + view.bufferIndex]) +
+              view.offset,
+          view.size);
+    }
+  }
+
+  std::vector<BufferPtr> stringViewBuffers;
+  stringViewBuffers.reserve(numBuffers);
+  for (auto i = 0; i < numBuffers; ++i) {
+    stringViewBuffers.emplace_back(
+        wrapInBufferView(arrowArray.buffers[2 + i], sizes[i]));
+  }
+
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      length,
+      stringViews,
+      std::move(stringViewBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 // This functions does two things: (a) sets the value of null_count, and (b)
 // the validity buffer (if there is at least one null row).
 void exportValidityBitmap(
@@ -664,6 +742,114 @@ void exportStrings(
   VELOX_DCHECK_EQ(bufSize, *rawOffsets);
 }
 
+// Exports strings in the Arrow string view layout. Inlined strings are copied
+// with their StringView. The others refer to the string buffers of 'vec' by
+// index and offset without being copied. Strings outside of these buffers,
+// e.g. the value of a ConstantVector, are copied into an extra buffer.
+void exportStringViews(
+    const FlatVector<StringView>& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  const auto& stringBuffers = vec.stringBuffers();
+  // Start addresses and indices of the string buffers in address order for
+  // finding the buffer of a string by binary search.
+  std::vector<std::pair<const char*, int32_t>> bufferStarts;
+  bufferStarts.reserve(stringBuffers.size());
+  for (auto i = 0; i < stringBuffers.size(); ++i) {
+    VELOX_CHECK_LE(
+        stringBuffers[i]->size(), std::numeric_limits<int32_t>::max());
+    bufferStarts.emplace_back(stringBuffers[i]->as<char>(), i);
+  }
+  std::sort(bufferStarts.begin(), bufferStarts.end());
+  auto findBuffer = [&](const char* data, int32_t size) -> int32_t {
+    auto it = std::upper_bound(
+        bufferStarts.begin(),
+        bufferStarts.end(),
+        std::make_pair(data, std::numeric_limits<int32_t>::max()));
+    if (it == bufferStarts.begin()) {
+      return -1;
+    }
+    --it;
+    const auto& buffer = stringBuffers[it->second];
+    if (data + size > it->first + buffer->size()) {
+      return -1;
+    }
+    return it->second;
+  };
+
+  holder.setBuffer(1, AlignedBuffer::allocate<StringView>(out.length, pool));
+  auto* rawViews = holder.getBufferAs<ArrowStringView>(1);
+  // Output positions of the strings that are not in 'stringBuffers'.
+  std::vector<vector_size_t> copied;
+  size_t copiedSize = 0;
+  // Strings of consecutive rows are usually in the same buffer.
+  int32_t lastIndex = -1;
+  vector_size_t j = 0;
+  rows.apply([&](vector_size_t i) {
+    auto& view = rawViews[j];
+    if (vec.isNullAt(i)) {
+      memset(&view, 0, sizeof(view));
+      ++j;
+      return;
+    }
+    const auto sv = vec.valueAtFast(i);
+    memcpy(&view, &sv, sizeof(view));
+    if (sv.isInline()) {
+      ++j;
+      return;
+    }
+    const auto* data = sv.data();
+    if (lastIndex < 0 ||
+        data < stringBuffers[lastIndex]->as<char>() ||
+        data + sv.size() > stringBuffers[lastIndex]->as<char>() +
+                stringBuffers[lastIndex]->size()) {
+      lastIndex = findBuffer(data, sv.size());
+    }
+    if (lastIndex < 0) {
+      copied.push_back(j);
+      copiedSize += sv.size();
+    } else {
+      view.bufferIndex = lastIndex;
+      view.offset = data - stringBuffers[lastIndex]->as<char>();
+    }
+    ++j;
+  });
+
+  std::vector<BufferPtr> variadicBuffers = stringBuffers;
+  if (!copied.empty()) {
+    VELOX_CHECK_LE(copiedSize, std::numeric_limits<int32_t>::max());
+    auto buffer = AlignedBuffer::allocate<char>(copiedSize, pool);
+    auto* rawBuffer = buffer->asMutable<char>();
+    int32_t offset = 0;
+    for (auto row : copied) {
+      auto& view = rawViews[row];
+      // The data pointer is still in place of 'bufferIndex' and 'offset'.
+      const char* data;
+      memcpy(&data, &view.bufferIndex, sizeof(data));
+      memcpy(rawBuffer + offset, data, view.size);
+      view.bufferIndex = variadicBuffers.size();
+      view.offset = offset;
+      offset += view.size;
+    }
+    variadicBuffers.push_back(std::move(buffer));
+  }
+
+  // Nulls, views, the string buffers and the sizes of the string buffers.
+  const auto numBuffers = variadicBuffers.size();
+  out.n_buffers = 3 + numBuffers;
+  holder.resizeBuffers(out.n_buffers);
+  auto sizes = AlignedBuffer::allocate<int64_t>(numBuffers, pool);
+  auto* rawSizes = sizes->asMutable<int64_t>();
+  for (auto i = 0; i < numBuffers; ++i) {
+    rawSizes[i] = variadicBuffers[i]->size();
+    holder.setBuffer(2 + i, variadicBuffers[i]);
+  }
+  holder.setBuffer(out.n_buffers - 1, sizes);
+  out.buffers = holder.getArrowBuffers();
+}
+
 void exportFlat(
     const BaseVector& vec,
     const Selection& rows,
@@ -688,8 +874,21 @@ void exportFlat(
       break;
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
-      exportStrings(
-          *vec.asUnchecked<FlatVector<StringView>>(), rows, out, pool, holder);
+      if (options.exportToStringView) {
+        exportStringViews(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      } else {
+        exportStrings(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      }
       break;
     default:
       VELOX_NYI(
@@ -924,6 +1123,22 @@ void exportConstantValue(
   exportToArrowImpl(*valuesVector, selection, options, out, pool);
 }
 
+// Sets 'out' to the int32 run ends child of an Arrow REE array.
+void exportRunEnds(BufferPtr runEnds, vector_size_t numRuns, ArrowArray& out) {
+  auto holder = std::make_unique<VeloxToArrowBridgeHolder>();
+  out.buffers = holder->getArrowBuffers();
+  out.length = numRuns;
+  out.offset = 0;
+  out.null_count = 0;
+  out.n_buffers = 2;
+  out.n_children = 0;
+  out.children = nullptr;
+  out.dictionary = nullptr;
+  holder->setBuffer(1, std::move(runEnds));
+  out.private_data = holder.release();
+  out.release = releaseArrowArray;
+}
+
 // Velox constant vectors are exported as Arrow REE containing a single run
 // equals to the vector size.
 void exportConstant(
@@ -943,26 +1158,78 @@ void exportConstant(
   out.children = holder.getChildrenArrays();
   exportConstantValue(vec, options, *holder.allocateChild(1), pool);
 
-  // Create the run ends child.
-  auto* runEnds = holder.allocateChild(0);
-  auto runEndsHolder = std::make_unique<VeloxToArrowBridgeHolder>();
-
-  runEnds->buffers = runEndsHolder->getArrowBuffers();
-  runEnds->length = 1;
-  runEnds->offset = 0;
-  runEnds->null_count = 0;
-  runEnds->n_buffers = 2;
-  runEnds->n_children = 0;
-  runEnds->children = nullptr;
-  runEnds->dictionary = nullptr;
-
   // Allocate single runs buffer with the run set as size.
   auto runsBuffer = AlignedBuffer::allocate<int32_t>(1, pool);
   runsBuffer->asMutable<int32_t>()[0] = vec.size();
-  runEndsHolder->setBuffer(1, runsBuffer);
+  exportRunEnds(runsBuffer, 1, *holder.allocateChild(0));
+}
+
+// Velox sequence vectors are exported as Arrow REE. Adjacent selected rows of
+// the same sequence form one run, so that the run ends are strictly
+// increasing as Arrow requires also for empty sequences and reordered rows.
+void exportSequence(
+    const BaseVector& vec,
+    const Selection& rows,
+    const ArrowOptions& options,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  out.n_buffers = 0;
+  out.buffers = nullptr;
+
+  out.n_children = 2;
+  holder.resizeChildren(2);
+  out.children = holder.getChildrenArrays();
 
-  runEnds->private_data = runEndsHolder.release();
-  runEnds->release = releaseArrowArray;
+  const auto& values = *vec.valueVector()->loadedVector();
+  const auto numSequences = values.size();
+  const auto* lengths = vec.wrapInfo()->as<vector_size_t>();
+  std::vector<vector_size_t> sequenceEnds(numSequences);
+  std::partial_sum(lengths, lengths + numSequences, sequenceEnds.begin());
+
+  std::vector<int32_t> runEnds;
+  // Ranges of sequences that make up the consecutive runs.
+  std::vector<std::pair<vector_size_t, vector_size_t>> ranges;
+  vector_size_t sequence = 0;
+  vector_size_t lastSequence = -1;
+  vector_size_t numRows = 0;
+  rows.apply([&](vector_size_t row) {
+    // Rows are usually visited in order, so check the current sequence first.
+    if (row >= sequenceEnds[sequence] ||
+        (sequence > 0 && row < sequenceEnds[sequence - 1])) {
+      sequence =
+          std::upper_bound(sequenceEnds.begin(), sequenceEnds.end(), row) -
+          sequenceEnds.begin();
+    }
+    ++numRows;
+    if (sequence == lastSequence) {
+      runEnds.back() = numRows;
+      return;
+    }
+    runEnds.push_back(numRows);
+    if (!ranges.empty() &&
+        ranges.back().first + ranges.back().second == sequence) {
+      ++ranges.back().second;
+    } else {
+      ranges.emplace_back(sequence, 1);
+    }
+    lastSequence = sequence;
+  });
+
+  // Selecting all the sequences in order keeps the values zero-copy.
+  Selection selection(numSequences);
+  if (ranges.size() != 1 || ranges[0].first != 0 ||
+      ranges[0].second != numSequences) {
+    selection.clearAll();
+    for (auto [offset, size] : ranges) {
+      selection.addRange(offset, size);
+    }
+  }
+  exportToArrowImpl(values, selection, options, *holder.allocateChild(1), pool);
+
+  auto runsBuffer = AlignedBuffer::allocate<int32_t>(runEnds.size(), pool);
+  std::copy(runEnds.begin(), runEnds.end(), runsBuffer->asMutable<int32_t>());
+  exportRunEnds(runsBuffer, runEnds.size(), *holder.allocateChild(0));
 }
 
 void exportToArrowImpl(
@@ -1004,6 +1271,9 @@ void exportToArrowImpl(
           ? exportFlattenedVector(vec, rows, options, out, pool, *holder)
           : exportConstant(vec, rows, options, out, pool, *holder);
       break;
+    case VectorEncoding::Simple::SEQUENCE:
+      exportSequence(vec, rows, options, out, pool, *holder);
+      break;
     default:
       VELOX_NYI("{} cannot be exported to Arrow yet.", vec.encoding());
   }
@@ -1082,6 +1352,16 @@ TypePtr importFromArrowImpl(
     case 'Z':
       return VARBINARY();
 
+    // Utf8View and BinaryView.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     case 't': // temporal types.
       if (format[1] == 's') {
         return TIMESTAMP();
@@ -1222,6 +1502,16 @@ void exportToArrow(
     }
     valuesChild->name = "values";
 
+    bridgeHolder->setChildAtIndex(
+        0, newArrowSchema("i", "run_ends"), arrowSchema);
+    bridgeHolder->setChildAtIndex(1, std::move(valuesChild), arrowSchema);
+  } else if (vec->encoding() == VectorEncoding::Simple::SEQUENCE) {
+    // Sequences are exported as REE with the sequence values as `values`.
+    arrowSchema.format = "+r";
+    arrowSchema.dictionary = nullptr;
+    auto valuesChild = newArrowSchema();
+    exportToArrow(vec->valueVector(), *valuesChild, options);
+    valuesChild->name = "values";
     bridgeHolder->setChildAtIndex(
         0, newArrowSchema("i", "run_ends"), arrowSchema);
     bridgeHolder->setChildAtIndex(1, std::move(valuesChild), arrowSchema);
@@ -1450,6 +1740,27 @@ MapVectorPtr createMapVector(
       optionalNullCount(arrowArray.null_count));
 }
 
+// Copies the dictionary indices of type T of 'arrowArray' into a buffer of
+// vector_size_t.
+template <typename T>
+BufferPtr convertIndices(
+    const ArrowArray& arrowArray,
+    memory::MemoryPool* pool) {
+  const auto* source = static_cast<const T*>(arrowArray.buffers[1]);
+  auto indices = allocateIndices(arrowArray.length, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  for (auto i = 0; i < arrowArray.length; ++i) {
+    if constexpr (sizeof(T) > sizeof(vector_size_t)) {
+      VELOX_USER_CHECK_LE(
+          source[i],
+          std::numeric_limits<vector_size_t>::max(),
+          "Dictionary index is out of range.");
+    }
+    rawIndices[i] = source[i];
+  }
+  return indices;
+}
+
 VectorPtr createDictionaryVector(
     memory::MemoryPool* pool,
     const TypePtr& indexType,
@@ -1461,12 +1772,28 @@ VectorPtr createDictionaryVector(
   VELOX_CHECK_EQ(arrowArray.n_buffers, 2);
   VELOX_CHECK_NOT_NULL(arrowArray.dictionary);
   static_assert(sizeof(vector_size_t) == sizeof(int32_t));
-  VELOX_CHECK_EQ(
-      indexType->kind(),
-      TypeKind::INTEGER,
-      "Only int32 indices are supported for arrow conversion");
-  auto indices = wrapInBufferView(
-      arrowArray.buffers[1], arrowArray.length * sizeof(vector_size_t));
+  BufferPtr indices;
+  switch (indexType->kind()) {
+    case TypeKind::INTEGER:
+      indices = wrapInBufferView(
+          arrowArray.buffers[1], arrowArray.length * sizeof(vector_size_t));
+      break;
+    // Narrower indices, e.g. from pandas categoricals, and 64 bit indices are
+    // widened or narrowed to 32 bits. The dictionary values are not copied.
+    case TypeKind::TINYINT:
+      indices = convertIndices<int8_t>(arrowArray, pool);
+      break;
+    case TypeKind::SMALLINT:
+      indices = convertIndices<int16_t>(arrowArray, pool);
+      break;
+    case TypeKind::BIGINT:
+      indices = convertIndices<int64_t>(arrowArray, pool);
+      break;
+    default:
+      VELOX_FAIL(
+          "Unsupported dictionary index type for arrow conversion: {}",
+          indexType->toString());
+  }
   auto type = importFromArrow(*arrowSchema.dictionary);
   auto wrapped = importFromArrowImpl(
       *arrowSchema.dictionary, *arrowArray.dictionary, pool, isViewer);
@@ -1477,6 +1804,22 @@ VectorPtr createDictionaryVector(
       std::move(wrapped));
 }
 
+// Sets 'indices' to the index of the run of each of the first 'length' rows
+// given the run ends of type T in 'runsArray'.
+template <typename T>
+void fillRunIndices(
+    const ArrowArray& runsArray,
+    int64_t length,
+    vector_size_t* indices) {
+  const auto* runEnds = static_cast<const T*>(runsArray.buffers[1]);
+  int64_t start = 0;
+  for (int64_t i = 0; i < runsArray.length && start < length; ++i) {
+    const auto end = std::min<int64_t>(runEnds[i], length);
+    std::fill(indices + start, indices + end, i);
+    start = std::max(start, end);
+  }
+}
+
 VectorPtr createVectorFromReeArray(
     memory::MemoryPool* pool,
     const ArrowSchema& arrowSchema,
@@ -1493,10 +1836,6 @@ VectorPtr createVectorFromReeArray(
 
   const auto& runEndSchema = *arrowSchema.children[0];
   auto runEndType = importFromArrowImpl(runEndSchema.format, runEndSchema);
-  VELOX_CHECK_EQ(
-      runEndType->kind(),
-      TypeKind::INTEGER,
-      "Only int32 run lengths are supported for REE arrow conversion.");
 
   // If there is more than one run, we turn it into a dictionary.
   if (values->size() > 1) {
@@ -1505,18 +1844,24 @@ VectorPtr createVectorFromReeArray(
 
     // REE runs cannot be null.
     VELOX_CHECK_EQ(runsArray.null_count, 0);
-
-    const auto* runsBuffer = static_cast<const int32_t*>(runsArray.buffers[1]);
-    VELOX_CHECK_NOT_NULL(runsBuffer);
+    VELOX_CHECK_NOT_NULL(runsArray.buffers[1]);
 
     auto indices = allocateIndices(arrowArray.length, pool);
     auto rawIndices = indices->asMutable<vector_size_t>();
-
-    size_t cursor = 0;
-    for (size_t i = 0; i < runsArray.length; ++i) {
-      while (cursor < runsBuffer[i]) {
-        rawIndices[cursor++] = i;
-      }
+    switch (runEndType->kind()) {
+      case TypeKind::SMALLINT:
+        fillRunIndices<int16_t>(runsArray, arrowArray.length, rawIndices);
+        break;
+      case TypeKind::INTEGER:
+        fillRunIndices<int32_t>(runsArray, arrowArray.length, rawIndices);
+        break;
+      case TypeKind::BIGINT:
+        fillRunIndices<int64_t>(runsArray, arrowArray.length, rawIndices);
+        break;
+      default:
+        VELOX_FAIL(
+            "Unsupported run end type for REE arrow conversion: {}",
+            runEndType->toString());
     }
     return BaseVector::wrapInDictionary(
         nullptr, indices, arrowArray.length, values);
@@ -1713,6 +2058,10 @@ VectorPtr importFromArrowImpl(
 
   // String data types (VARCHAR and VARBINARY).
   if (type->isVarchar() || type->isVarbinary()) {
+    if (arrowSchema.format[0] == 'v') {
+      return createStringViewFlatVector(
+          pool, type, nulls, arrowArray, wrapInBufferView);
+    }
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
         3,
@@ -36,6 +36,9 @@ struct ArrowOptions {
   bool flattenDictionary{false};
   bool flattenConstant{false};
   TimestampUnit timestampUnit = TimestampUnit::kNano;
+  // Exports VARCHAR and VARBINARY in the Utf8View and BinaryView layouts,
+  // which refer to the Velox string buffers without copying the strings.
+  bool exportToStringView{false};
 };
 
 namespace facebook::velox {
@@ -22,6 +22,7 @@
 
 #include "velox/common/base/Nulls.h"
 #include "velox/core/QueryCtx.h"
+#include "velox/vector/SequenceVector.h"
 #include "velox/vector/arrow/Bridge.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
@@ -564,6 +565,48 @@ TEST_F(ArrowBridgeArrayExportTest, flatString) {
   testFlatVector<std::string>({});
 }
 
+TEST_F(ArrowBridgeArrayExportTest, flatStringView) {
+  options_.exportToStringView = true;
+  auto vec = vectorMaker_.flatVectorNullable<std::string>({
+      "short",
+      std::nullopt,
+      "a string that is not stored inline",
+      "",
+      "another string that is not stored inline",
+  });
+  ArrowSchema schema;
+  ArrowArray data;
+  velox::exportToArrow(vec, schema, options_);
+  velox::exportToArrow(vec, data, pool_.get(), options_);
+  EXPECT_STREQ("vu", schema.format);
+
+  // Nulls, views, one string buffer shared with 'vec' and the buffer sizes.
+  const auto& stringBuffers = vec->stringBuffers();
+  ASSERT_EQ(1, stringBuffers.size());
+  ASSERT_EQ(4, data.n_buffers);
+  EXPECT_EQ(stringBuffers[0]->as<char>(), data.buffers[2]);
+  EXPECT_EQ(
+      stringBuffers[0]->size(),
+      static_cast<const int64_t*>(data.buffers[3])[0]);
+
+  auto result = importFromArrowAsViewer(schema, data, pool_.get());
+  test::assertEqualVectors(vec, result);
+  EXPECT_EQ(
+      vec->valueAt(2).data(),
+      result->asFlatVector<StringView>()->valueAt(2).data());
+  schema.release(&schema);
+  data.release(&data);
+
+  // The value of a constant is not in a string buffer and is copied.
+  auto constant = BaseVector::wrapInConstant(3, 4, vec);
+  velox::exportToArrow(constant, schema, options_);
+  velox::exportToArrow(constant, data, pool_.get(), options_);
+  result = importFromArrowAsViewer(schema, data, pool_.get());
+  test::assertEqualVectors(constant, result);
+  schema.release(&schema);
+  data.release(&data);
+}
+
 TEST_F(ArrowBridgeArrayExportTest, rowVector) {
   std::vector<std::optional<int64_t>> col1 = {1, 2, 3, 4};
   std::vector<std::optional<double>> col2 = {99.9, 88.8, 77.7, std::nullopt};
@@ -1023,6 +1066,34 @@ TEST_F(ArrowBridgeArrayExportTest, constantCrossValidate) {
   EXPECT_EQ(runEndsArray.Value(0), 100);
 }
 
+TEST_F(ArrowBridgeArrayExportTest, sequence) {
+  // The empty sequence in the middle does not produce a run.
+  auto lengths = makeBuffer<vector_size_t>({3, 0, 2, 1});
+  auto values = vectorMaker_.flatVectorNullable<int64_t>(
+      {10, 20, 30, std::nullopt});
+  auto vector = std::make_shared<SequenceVector<int64_t>>(
+      pool_.get(), 6, values, lengths);
+
+  auto array = toArrow(vector, options_, pool_.get());
+  ASSERT_OK(array->ValidateFull());
+  ASSERT_EQ(
+      *array->type(), *arrow::run_end_encoded(arrow::int32(), arrow::int64()));
+  const auto& reeArray = static_cast<const arrow::RunEndEncodedArray&>(*array);
+  EXPECT_TRUE(reeArray.run_ends()->Equals(
+      *arrow::ArrayFromJSON(arrow::int32(), "[3, 5, 6]")));
+  EXPECT_TRUE(reeArray.values()->Equals(
+      *arrow::ArrayFromJSON(arrow::int64(), "[10, 30, null]")));
+
+  ArrowSchema schema;
+  ArrowArray data;
+  velox::exportToArrow(vector, schema, options_);
+  velox::exportToArrow(vector, data, pool_.get(), options_);
+  auto result = importFromArrowAsViewer(schema, data, pool_.get());
+  test::assertEqualVectors(vector, result);
+  schema.release(&schema);
+  data.release(&data);
+}
+
 class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
  protected:
   // Used by this base test class to import Arrow data and create Velox Vector.
@@ -1541,6 +1612,23 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
       EXPECT_EQ(vec.encoding(), VectorEncoding::Simple::DICTIONARY);
       EXPECT_EQ(vec.size(), 60);
     });
+
+    // 8 bit indices are widened to 32 bits.
+    auto dictionary = arrow::ArrayFromJSON(arrow::utf8(), R"(["a", "b"])");
+    auto indices = arrow::ArrayFromJSON(arrow::int8(), "[1, 0, null, 1]");
+    ASSERT_OK_AND_ASSIGN(
+        auto int8Array,
+        arrow::DictionaryArray::FromArrays(
+            arrow::dictionary(arrow::int8(), arrow::utf8()),
+            indices,
+            dictionary));
+    VectorPtr vector;
+    toVeloxVector(*int8Array, vector);
+    EXPECT_EQ(vector->encoding(), VectorEncoding::Simple::DICTIONARY);
+    test::assertEqualVectors(
+        vectorMaker_.flatVectorNullable<StringView>(
+            {"b", "a", std::nullopt, "b"}),
+        vector);
   }
 
   void testImportREE() {
@@ -1659,6 +1747,19 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
     EXPECT_EQ(decoded.valueAt<int32_t>(32), 50);
     EXPECT_EQ(decoded.valueAt<int32_t>(33), 50);
     EXPECT_EQ(decoded.valueAt<int32_t>(61), 50);
+
+    // 64 bit run ends.
+    arrow::RunEndEncodedBuilder reeInt64(
+        pool,
+        std::make_shared<arrow::Int64Builder>(pool),
+        std::make_shared<arrow::Int32Builder>(pool),
+        run_end_encoded(arrow::int64(), arrow::int32()));
+    ASSERT_OK(reeInt64.AppendScalar(*arrow::MakeScalar<int32_t>(1), 3));
+    ASSERT_OK(reeInt64.AppendScalar(*arrow::MakeScalar<int32_t>(2), 2));
+    ASSERT_OK_AND_ASSIGN(array, reeInt64.Finish());
+    toVeloxVector(*array, vector);
+    test::assertEqualVectors(
+        vectorMaker_.flatVector<int32_t>({1, 1, 1, 2, 2}), vector);
   }
 
   void testImportFailures() {
@@ -360,6 +360,36 @@ BENCHMARK_MULTI(copyStructNonContiguous) {
   return kIter * kSize;
 }
 
+// Copies runs of 10 consecutive source rows through the row mapping of
+// BaseVector::copy(), as done when gathering selected rows.
+BENCHMARK_MULTI(copyArrayByRowMapping) {
+  folly::BenchmarkSuspender suspender;
+  std::shared_ptr<memory::MemoryPool> pool{
+      memory::memoryManager()->addLeafPool()};
+  test::VectorMaker vectorMaker{pool.get()};
+
+  const vector_size_t size = 1'000;
+  auto arrayVector = vectorMaker.arrayVector<int32_t>(
+      size,
+      [](auto row) { return row % 10; },
+      [](auto row) { return row % 23; });
+  std::vector<vector_size_t> toSourceRow(size);
+  for (auto i = 0; i < size; ++i) {
+    toSourceRow[i] = (i / 10 * 37 % (size / 10)) * 10 + i % 10;
+  }
+  SelectivityVector selected(size);
+  VectorPtr result;
+  BaseVector::ensureWritable(selected, ARRAY(INTEGER()), pool.get(), result);
+  suspender.dismiss();
+
+  constexpr int kIter = 100;
+  for (int i = 0; i < kIter; ++i) {
+    BaseVector::prepareForReuse(result, size);
+    result->copy(arrayVector.get(), selected, toSourceRow.data());
+  }
+  return kIter * size;
+}
+
 } // namespace
 } // namespace facebook::velox
 
@@ -1181,6 +1181,43 @@ TEST_F(DecodedVectorTest, emptyRowsMultiDict) {
   }
 }
 
+TEST_F(DecodedVectorTest, nestedDictionaryRowRanges) {
+  // Not a multiple of 64 or of the SIMD width.
+  constexpr vector_size_t kSize = 1'003;
+  auto base = makeFlatVector<int64_t>(kSize, [](auto row) { return row; });
+  auto inner = wrapInDictionary(
+      makeIndices(kSize, [](auto row) { return (row * 7) % kSize; }), base);
+  auto outer = wrapInDictionary(makeIndicesInReverse(kSize), inner);
+  auto expected = [&](vector_size_t row) {
+    return ((kSize - 1 - row) * 7) % kSize;
+  };
+
+  // All rows, a range with partial words at both ends and sparse rows that
+  // leave some words full and some partial.
+  SelectivityVector allRows(kSize);
+  SelectivityVector range(kSize, false);
+  range.setValidRange(5, 900, true);
+  range.updateBounds();
+  SelectivityVector sparse(kSize);
+  for (auto row = 128; row < kSize; row += 3) {
+    sparse.setValid(row, false);
+  }
+  sparse.updateBounds();
+  for (const auto* rows : {&allRows, &range, &sparse}) {
+    DecodedVector decoded(*outer, *rows);
+    EXPECT_EQ(decoded.base(), base.get());
+    rows->applyToSelected([&](auto row) {
+      EXPECT_EQ(expected(row), decoded.index(row)) << row;
+      EXPECT_EQ(expected(row), decoded.valueAt<int64_t>(row)) << row;
+    });
+  }
+
+  DecodedVector decoded(*outer);
+  for (auto row = 0; row < kSize; ++row) {
+    EXPECT_EQ(expected(row), decoded.valueAt<int64_t>(row)) << row;
+  }
+}
+
 TEST_F(DecodedVectorTest, flatNulls) {
   // Flat vector with no nulls.
   auto flatNoNulls = makeFlatVector<int64_t>(100, [](auto row) { return row; });
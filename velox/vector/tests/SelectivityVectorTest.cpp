@@ -531,6 +531,51 @@ TEST(SelectivityVectorTest, toString) {
       "147 out of 1024 rows selected between 0 and 1023: 0, 7, 14, 21, 28, 35, 42, 49, 56, 63, 70, 77, 84, 91, 98, 105, 112, 119, 126, 133, 140, 147, 154, 161, 168, 175, 182, 189, 196, 203, 210, 217, 224, 231, 238, 245, 252, 259, 266, 273, 280, 287, 294, 301, 308, 315, 322, 329, 336, 343, 350, 357, 364, 371, 378, 385, 392, 399, 406, 413, 420, 427, 434, 441, 448, 455, 462, 469, 476, 483, 490, 497, 504, 511, 518, 525, 532, 539, 546, 553, 560, 567, 574, 581, 588, 595, 602, 609, 616, 623, 630, 637, 644, 651, 658, 665, 672, 679, 686, 693, 700, 707, 714, 721, 728, 735, 742, 749, 756, 763, 770, 777, 784, 791, 798, 805, 812, 819, 826, 833, 840, 847, 854, 861, 868, 875, 882, 889, 896, 903, 910, 917, 924, 931, 938, 945, 952, 959, 966, 973, 980, 987, 994, 1001, 1008, 1015, 1022");
 }
 
+TEST(SelectivityVectorTest, selectedRows) {
+  auto expectRows = [](const SelectivityVector& rows) {
+    std::vector<vector_size_t> expected;
+    rows.applyToSelected([&](auto row) { expected.push_back(row); });
+    const auto& selected = rows.selectedRows();
+    ASSERT_EQ(
+        expected,
+        std::vector<vector_size_t>(
+            selected.data(), selected.data() + selected.size()));
+  };
+
+  SelectivityVector rows(1'000);
+  expectRows(rows);
+
+  // The cached rows are recomputed after each kind of change.
+  for (auto i = 0; i < rows.size(); i += 3) {
+    rows.setValid(i, false);
+  }
+  rows.updateBounds();
+  expectRows(rows);
+
+  rows.setValidRange(100, 700, false);
+  rows.updateBounds();
+  expectRows(rows);
+
+  SelectivityVector other(1'000, false);
+  other.setValidRange(50, 900, true);
+  other.updateBounds();
+  rows.intersect(other);
+  expectRows(rows);
+
+  rows.clearAll();
+  expectRows(rows);
+  ASSERT_TRUE(rows.selectedRows().empty());
+
+  rows.setAll();
+  expectRows(rows);
+  ASSERT_EQ(1'000, rows.selectedRows().size());
+
+  rows.resize(1'011, false);
+  rows.setValid(1'010, true);
+  rows.updateBounds();
+  expectRows(rows);
+}
+
 } // namespace test
 } // namespace velox
 } // namespace facebook
@@ -136,6 +136,65 @@ TEST_F(VectorPoolTest, vectorRecycler) {
   }
 }
 
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+
+  auto arrayType = ARRAY(VARCHAR());
+  auto vector = vectorPool.get(arrayType, 100);
+  ASSERT_EQ(100, vector->size());
+  auto* arrayVector = vector->as<ArrayVector>();
+  auto* elements = arrayVector->elements()->asFlatVector<StringView>();
+  elements->resize(200);
+  for (auto i = 0; i < 100; ++i) {
+    arrayVector->setOffsetAndSize(i, i * 2, 2);
+    elements->set(i * 2, StringView("a long string that is not inlined"));
+    elements->set(i * 2 + 1, StringView("another long string, not inlined"));
+  }
+  vector->setNull(7, true);
+  auto* rawOffsets = arrayVector->rawOffsets();
+  auto* stringBuffer = elements->stringBuffers()[0].get();
+
+  // The array vector is recycled with its offsets, elements and string
+  // buffers. The offsets, sizes and nulls are cleared.
+  auto* vectorPtr = vector.get();
+  ASSERT_TRUE(vectorPool.release(vector));
+  auto recycled = vectorPool.get(arrayType, 50);
+  ASSERT_EQ(vectorPtr, recycled.get());
+  ASSERT_EQ(50, recycled->size());
+  arrayVector = recycled->as<ArrayVector>();
+  ASSERT_EQ(rawOffsets, arrayVector->rawOffsets());
+  ASSERT_EQ(0, arrayVector->elements()->size());
+  elements = arrayVector->elements()->asFlatVector<StringView>();
+  ASSERT_EQ(1, elements->stringBuffers().size());
+  ASSERT_EQ(stringBuffer, elements->stringBuffers()[0].get());
+  for (auto i = 0; i < 50; ++i) {
+    ASSERT_FALSE(recycled->isNullAt(i));
+    ASSERT_EQ(0, arrayVector->offsetAt(i));
+    ASSERT_EQ(0, arrayVector->sizeAt(i));
+  }
+
+  // The types of complex vectors are matched by identity.
+  ASSERT_TRUE(vectorPool.release(recycled));
+  ASSERT_NE(vectorPtr, vectorPool.get(ARRAY(VARCHAR()), 50).get());
+  ASSERT_EQ(vectorPtr, vectorPool.get(arrayType, 50).get());
+
+  // The children of a row vector are resized with the row vector.
+  auto rowType = ROW({"a", "b"}, {BIGINT(), MAP(INTEGER(), DOUBLE())});
+  auto row = vectorPool.get(rowType, 100);
+  vectorPtr = row.get();
+  ASSERT_TRUE(vectorPool.release(row));
+  row = vectorPool.get(rowType, 200);
+  ASSERT_EQ(vectorPtr, row.get());
+  ASSERT_EQ(200, row->size());
+  for (const auto& child : row->as<RowVector>()->children()) {
+    ASSERT_EQ(200, child->size());
+  }
+
+  // A shared child makes the vector not recyclable.
+  auto child = row->as<RowVector>()->childAt(0);
+  ASSERT_FALSE(vectorPool.release(row));
+}
+
 TEST_F(VectorPoolTest, customTypes) {
   VectorPool vectorPool(pool());
 
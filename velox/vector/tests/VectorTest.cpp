@@ -1788,6 +1788,40 @@ TEST_F(VectorTest, copyNoRows) {
   }
 }
 
+TEST_F(VectorTest, copyArrayWithRowMapping) {
+  auto source = makeNullableArrayVector<int32_t>(
+      {{{1, 2}},
+       {{3}},
+       std::nullopt,
+       {{4, 5, 6}},
+       {{}},
+       {{7}},
+       {{8, 9}}});
+  // Runs of consecutive source rows mixed with single rows and repeats.
+  std::vector<vector_size_t> toSourceRow = {3, 4, 5, 0, 1, 2, 6, 6};
+  const vector_size_t size = toSourceRow.size();
+  SelectivityVector rows(size);
+  rows.setValid(3, false);
+  rows.updateBounds();
+
+  auto target = BaseVector::create(source->type(), size, pool());
+  target->copy(source.get(), rows, toSourceRow.data());
+  rows.applyToSelected([&](auto row) {
+    ASSERT_TRUE(target->equalValueAt(source.get(), row, toSourceRow[row]))
+        << "at " << row;
+  });
+
+  // Same with a dictionary encoded source.
+  auto dictionary =
+      wrapInDictionary(makeIndicesInReverse(source->size()), source);
+  target = BaseVector::create(source->type(), size, pool());
+  target->copy(dictionary.get(), rows, toSourceRow.data());
+  rows.applyToSelected([&](auto row) {
+    ASSERT_TRUE(target->equalValueAt(dictionary.get(), row, toSourceRow[row]))
+        << "at " << row;
+  });
+}
+
 TEST_F(VectorTest, copyAscii) {
   std::vector<std::string> stringData = {"a", "b", "c"};
   auto source = makeFlatVector(stringData);